@@ -417,6 +417,16 @@ MIRACLE_PARAMETER_FOR_INT(
     "ThreadCacheMinCachedMemoryForPurgingBytes",
     partition_alloc::kMinCachedMemoryForPurgingBytes)
 
+BASE_FEATURE(kPartitionAllocThreadCacheAutotuning,
+             "PartitionAllocThreadCacheAutotuning",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+const base::FeatureParam<bool> kThreadCacheAutotuningRendererOnlyParam{
+    &kPartitionAllocThreadCacheAutotuning, "renderer-only", true};
+
+const base::FeatureParam<TimeDelta> kThreadCacheAutotuningIntervalParam{
+    &kPartitionAllocThreadCacheAutotuning, "interval", Minutes(1)};
+
 // An apparent quarantine leak in the buffer partition unacceptably
 // bloats memory when MiraclePtr is enabled in the renderer process.
 // We believe we have found and patched the leak, but out of an
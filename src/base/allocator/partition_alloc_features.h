@@ -204,6 +204,14 @@ BASE_EXPORT BASE_DECLARE_FEATURE(
     kEnableConfigurableThreadCacheMinCachedMemoryForPurging);
 BASE_EXPORT int GetThreadCacheMinCachedMemoryForPurgingBytes();
 
+// Periodically scales the thread cache limit of each bucket according to the
+// allocation sizes sampled by the PoissonAllocationSampler in this process.
+BASE_EXPORT BASE_DECLARE_FEATURE(kPartitionAllocThreadCacheAutotuning);
+extern const BASE_EXPORT base::FeatureParam<bool>
+    kThreadCacheAutotuningRendererOnlyParam;
+extern const BASE_EXPORT base::FeatureParam<TimeDelta>
+    kThreadCacheAutotuningIntervalParam;
+
 BASE_EXPORT BASE_DECLARE_FEATURE(kPartitionAllocDisableBRPInBufferPartition);
 
 // This feature is additionally gated behind a buildflag because
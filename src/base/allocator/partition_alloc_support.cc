@@ -4,6 +4,7 @@
 
 #include "base/allocator/partition_alloc_support.h"
 
+#include <algorithm>
 #include <array>
 #include <cinttypes>
 #include <cstdint>
@@ -264,6 +265,13 @@ BASE_FEATURE(kDisableMemoryReclaimerInBackground,
              "DisableMemoryReclaimerInBackground",
              base::FEATURE_ENABLED_BY_DEFAULT);
 
+// When enabled, reclaim all free memory once, shortly after going to
+// background. This is meant for renderers, which are unlikely to allocate much
+// until they are foregrounded again.
+BASE_FEATURE(kReclaimAllMemoryInBackground,
+             "ReclaimAllMemoryInBackground",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 // static
 MemoryReclaimerSupport& MemoryReclaimerSupport::Instance() {
   static base::NoDestructor<MemoryReclaimerSupport> instance;
@@ -312,28 +320,77 @@ void MemoryReclaimerSupport::SetForegrounded(bool in_foreground) {
   in_foreground_ = in_foreground;
   if (in_foreground_) {
     MaybeScheduleTask();
+    return;
+  }
+
+  if (base::FeatureList::IsEnabled(kReclaimAllMemoryInBackground) &&
+      task_runner_ && !has_pending_background_task_) {
+    has_pending_background_task_ = true;
+    task_runner_->PostDelayedTask(
+        FROM_HERE,
+        BindOnce(&MemoryReclaimerSupport::RunBackgroundReclaim,
+                 base::Unretained(this)),
+        kBackgroundReclaimDelay);
+  }
+}
+
+void MemoryReclaimerSupport::SetHandlingInput(bool handling_input) {
+  handling_input_ = handling_input;
+  // Without an idle period in the meantime, the deferred reclaim runs at the
+  // next interval.
+  if (!handling_input_ && reclaim_deferred_) {
+    MaybeScheduleTask();
   }
 }
 
+void MemoryReclaimerSupport::OnIdlePeriodStarted() {
+  if (!reclaim_deferred_ || handling_input_) {
+    return;
+  }
+  Reclaim();
+  MaybeScheduleTask();
+}
+
 void MemoryReclaimerSupport::ResetForTesting() {
   task_runner_ = nullptr;
   has_pending_task_ = false;
+  has_pending_background_task_ = false;
   in_foreground_ = true;
+  handling_input_ = false;
+  reclaim_deferred_ = false;
 }
 
 void MemoryReclaimerSupport::Run() {
-  TRACE_EVENT0("base", "partition_alloc::MemoryReclaimer::Reclaim()");
   has_pending_task_ = false;
 
-  {
-    // Micros, since memory reclaiming should typically take at most a few ms.
-    SCOPED_UMA_HISTOGRAM_TIMER_MICROS("Memory.PartitionAlloc.MemoryReclaim");
-    ::partition_alloc::MemoryReclaimer::Instance()->ReclaimNormal();
+  if (handling_input_) {
+    // Rescheduled once input handling is over, see SetHandlingInput().
+    reclaim_deferred_ = true;
+    return;
   }
 
+  Reclaim();
   MaybeScheduleTask();
 }
 
+void MemoryReclaimerSupport::Reclaim() {
+  TRACE_EVENT0("base", "partition_alloc::MemoryReclaimer::Reclaim()");
+  reclaim_deferred_ = false;
+  // Micros, since memory reclaiming should typically take at most a few ms.
+  SCOPED_UMA_HISTOGRAM_TIMER_MICROS("Memory.PartitionAlloc.MemoryReclaim");
+  ::partition_alloc::MemoryReclaimer::Instance()->ReclaimNormal();
+}
+
+void MemoryReclaimerSupport::RunBackgroundReclaim() {
+  has_pending_background_task_ = false;
+  // Foregrounded again in the meantime.
+  if (in_foreground_) {
+    return;
+  }
+  TRACE_EVENT0("base", "partition_alloc::MemoryReclaimer::ReclaimAll()");
+  ::partition_alloc::MemoryReclaimer::Instance()->ReclaimAll();
+}
+
 // static
 TimeDelta MemoryReclaimerSupport::GetInterval() {
   TimeDelta delay = features::kPartitionAllocMemoryReclaimerInterval.Get();
@@ -360,6 +417,104 @@ void MemoryReclaimerSupport::MaybeScheduleTask(TimeDelta delay) {
       actual_delay);
 }
 
+#if PA_CONFIG(THREAD_CACHE_SUPPORTED) && \
+    PA_BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+// static
+ThreadCacheAutotuner& ThreadCacheAutotuner::Instance() {
+  static base::NoDestructor<ThreadCacheAutotuner> instance;
+  return *instance.get();
+}
+
+ThreadCacheAutotuner::ThreadCacheAutotuner() = default;
+ThreadCacheAutotuner::~ThreadCacheAutotuner() = default;
+
+void ThreadCacheAutotuner::Start(TimeDelta interval) {
+  if (started_) {
+    return;
+  }
+  started_ = true;
+  interval_ = interval;
+  // Turns on sampling if no other observer did. With the default sampling
+  // interval, this costs a few samples per MiB allocated.
+  PoissonAllocationSampler::Get()->AddSamplesObserver(this);
+  SingleThreadTaskRunner::GetCurrentDefault()->PostDelayedTask(
+      FROM_HERE, BindOnce(&ThreadCacheAutotuner::Run, Unretained(this)),
+      interval_);
+}
+
+bool ThreadCacheAutotuner::AdjustLimits() {
+  // Keep accumulating until the profile is meaningful.
+  if (sample_count_.load(std::memory_order_relaxed) < kMinSamples) {
+    return false;
+  }
+
+  sample_count_.store(0, std::memory_order_relaxed);
+  AllocationCounts allocation_counts;
+  for (size_t index = 0; index < kBucketCount; index++) {
+    allocation_counts[index] =
+        allocation_counts_[index].exchange(0, std::memory_order_relaxed);
+  }
+  Scales scales = ComputeScales(allocation_counts);
+  ::partition_alloc::ThreadCacheRegistry::Instance().SetBucketLimitScales(
+      scales.data(), scales.size());
+  return true;
+}
+
+// static
+ThreadCacheAutotuner::Scales ThreadCacheAutotuner::ComputeScales(
+    const AllocationCounts& allocation_counts) {
+  Scales scales;
+  scales.fill(1.f);
+  uint64_t total = 0;
+  for (uint64_t count : allocation_counts) {
+    total += count;
+  }
+  if (!total) {
+    return scales;
+  }
+
+  for (size_t index = 0; index < kBucketCount; index++) {
+    double share = static_cast<double>(allocation_counts[index]) / total;
+    scales[index] = std::clamp(static_cast<float>(share / kReferenceShare),
+                               kMinScale, kMaxScale);
+  }
+  return scales;
+}
+
+void ThreadCacheAutotuner::SampleAdded(
+    void* address,
+    size_t size,
+    size_t total,
+    dispatcher::AllocationSubsystem type,
+    const char* context) {
+  // Only malloc() is served by the partition which has a thread cache.
+  if (type != dispatcher::AllocationSubsystem::kAllocatorShim || !size) {
+    return;
+  }
+  partition_alloc::PartitionRoot* root =
+      allocator_shim::internal::PartitionAllocMalloc::Allocator();
+  size_t index = partition_alloc::PartitionRoot::SizeToBucketIndex(
+      root->AdjustSizeForExtrasAdd(size), root->GetBucketDistribution());
+  if (index >= kBucketCount) {
+    return;
+  }
+  // Each sample stands for |total| bytes, that is about |total / size|
+  // allocations of this size.
+  allocation_counts_[index].fetch_add(std::max<size_t>(total / size, 1),
+                                      std::memory_order_relaxed);
+  sample_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ThreadCacheAutotuner::Run() {
+  TRACE_EVENT0("memory", "ThreadCacheAutotuner::Run");
+  AdjustLimits();
+  SingleThreadTaskRunner::GetCurrentDefault()->PostDelayedTask(
+      FROM_HERE, BindOnce(&ThreadCacheAutotuner::Run, Unretained(this)),
+      interval_);
+}
+#endif  // PA_CONFIG(THREAD_CACHE_SUPPORTED) &&
+        // PA_BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+
 void StartThreadCachePeriodicPurge() {
   auto& instance = ::partition_alloc::ThreadCacheRegistry::Instance();
   TimeDelta delay =
@@ -1406,6 +1561,14 @@ void PartitionAllocSupport::ReconfigureAfterTaskRunnerInit(
 
     ::partition_alloc::ThreadCache::SetLargestCachedSize(largest_cached_size_);
   }
+
+  if (base::FeatureList::IsEnabled(
+          base::features::kPartitionAllocThreadCacheAutotuning) &&
+      (process_type == switches::kRendererProcess ||
+       !base::features::kThreadCacheAutotuningRendererOnlyParam.Get())) {
+    ThreadCacheAutotuner::Instance().Start(
+        base::features::kThreadCacheAutotuningIntervalParam.Get());
+  }
 #endif  // PA_CONFIG(THREAD_CACHE_SUPPORTED) &&
         // PA_BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
 
@@ -5,6 +5,9 @@
 #ifndef BASE_ALLOCATOR_PARTITION_ALLOC_SUPPORT_H_
 #define BASE_ALLOCATOR_PARTITION_ALLOC_SUPPORT_H_
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <string>
 
@@ -18,6 +21,11 @@
 #include "partition_alloc/partition_alloc_config.h"
 #include "partition_alloc/thread_cache.h"
 
+#if PA_CONFIG(THREAD_CACHE_SUPPORTED) && \
+    PA_BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+#include "base/sampling_heap_profiler/poisson_allocation_sampler.h"
+#endif
+
 namespace base::allocator {
 
 #if PA_BUILDFLAG(USE_STARSCAN)
@@ -119,6 +127,7 @@ class BASE_EXPORT PartitionAllocSupport {
 };
 
 BASE_EXPORT BASE_DECLARE_FEATURE(kDisableMemoryReclaimerInBackground);
+BASE_EXPORT BASE_DECLARE_FEATURE(kReclaimAllMemoryInBackground);
 
 // Visible in header for testing.
 class BASE_EXPORT MemoryReclaimerSupport {
@@ -129,22 +138,104 @@ class BASE_EXPORT MemoryReclaimerSupport {
   void Start(scoped_refptr<TaskRunner> task_runner);
   void SetForegrounded(bool in_foreground);
 
+  // Reclaiming takes the partition locks, so it should not run while the
+  // embedder handles input on the reclaiming thread. A reclaim that comes due
+  // while |handling_input| is deferred to the next idle period, or else to the
+  // end of input handling.
+  void SetHandlingInput(bool handling_input);
+  // Called by the embedder when the reclaiming thread enters an idle period.
+  // Runs the deferred reclaim, if any.
+  void OnIdlePeriodStarted();
+
   void ResetForTesting();
   bool has_pending_task_for_testing() const { return has_pending_task_; }
+  bool has_deferred_reclaim_for_testing() const { return reclaim_deferred_; }
   static TimeDelta GetInterval();
 
   // Visible for testing
   static constexpr base::TimeDelta kFirstPAPurgeOrReclaimDelay =
       base::Minutes(1);
+  // With kReclaimAllMemoryInBackground, delay between going to background and
+  // reclaiming all memory.
+  static constexpr base::TimeDelta kBackgroundReclaimDelay = base::Seconds(10);
 
  private:
   void Run();
+  void Reclaim();
+  void RunBackgroundReclaim();
   void MaybeScheduleTask(TimeDelta delay = TimeDelta());
 
   scoped_refptr<TaskRunner> task_runner_;
   bool in_foreground_ = true;
   bool has_pending_task_ = false;
+  bool has_pending_background_task_ = false;
+  bool handling_input_ = false;
+  bool reclaim_deferred_ = false;
+};
+
+#if PA_CONFIG(THREAD_CACHE_SUPPORTED) && \
+    PA_BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+// Adjusts the thread cache limit of each bucket to the allocation profile of
+// the current process, as sampled by the PoissonAllocationSampler. Buckets
+// serving a large share of the allocations cache more objects, which saves
+// trips to the central allocator and contention on its lock when objects are
+// freed on another thread. Rarely used buckets cache fewer objects, which saves
+// the memory stranded in them.
+//
+// Visible in header for testing.
+class BASE_EXPORT ThreadCacheAutotuner
+    : public PoissonAllocationSampler::SamplesObserver {
+ public:
+  static constexpr size_t kBucketCount =
+      ::partition_alloc::ThreadCache::kBucketCount;
+  // A bucket serving this share of the allocations keeps the limit given by the
+  // thread cache multiplier. Others are scaled proportionally to their share,
+  // within [kMinScale, kMaxScale].
+  static constexpr double kReferenceShare = 1. / 32;
+  static constexpr float kMinScale = 0.25f;
+  static constexpr float kMaxScale = 4.f;
+  // Limits are left unchanged until at least this many samples are collected.
+  static constexpr size_t kMinSamples = 100;
+
+  using AllocationCounts = std::array<uint64_t, kBucketCount>;
+  using Scales = std::array<float, kBucketCount>;
+
+  static ThreadCacheAutotuner& Instance();
+  ThreadCacheAutotuner();
+  ~ThreadCacheAutotuner() override;
+
+  // Starts sampling allocations, and adjusting the limits every |interval| on
+  // the current thread. Can be called several times.
+  void Start(TimeDelta interval);
+
+  // Returns the scale of each bucket's limit, given the estimated number of
+  // allocations served by each bucket.
+  static Scales ComputeScales(const AllocationCounts& allocation_counts);
+
+  // PoissonAllocationSampler::SamplesObserver:
+  void SampleAdded(void* address,
+                   size_t size,
+                   size_t total,
+                   base::allocator::dispatcher::AllocationSubsystem type,
+                   const char* context) override;
+  void SampleRemoved(void* address) override {}
+
+  // Sets the limits from the samples collected since the last call, if there
+  // are enough of them. Returns whether the limits were set.
+  bool AdjustLimits();
+
+ private:
+  void Run();
+
+  TimeDelta interval_;
+  bool started_ = false;
+
+  // Updated from the sampler's hooks, which can't allocate, hence atomics.
+  std::array<std::atomic<uint64_t>, kBucketCount> allocation_counts_{};
+  std::atomic<size_t> sample_count_{0};
 };
+#endif  // PA_CONFIG(THREAD_CACHE_SUPPORTED) &&
+        // PA_BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
 
 }  // namespace base::allocator
 
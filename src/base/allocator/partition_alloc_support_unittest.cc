@@ -360,4 +360,102 @@ TEST_F(MemoryReclaimerSupportTest, ForegroundToBackgroundAndBack) {
   EXPECT_EQ(1u, task_environment_.GetPendingMainThreadTaskCount());
 }
 
+TEST_F(MemoryReclaimerSupportTest, DeferredDuringInput) {
+  test::ScopedFeatureList feature_list{
+      base::features::kPartitionAllocMemoryReclaimer};
+  auto& instance = MemoryReclaimerSupport::Instance();
+  instance.Start(task_environment_.GetMainThreadTaskRunner());
+  instance.SetHandlingInput(true);
+  task_environment_.FastForwardBy(
+      MemoryReclaimerSupport::kFirstPAPurgeOrReclaimDelay);
+
+  // The reclaim is not run while handling input, and not reposted either.
+  EXPECT_TRUE(instance.has_deferred_reclaim_for_testing());
+  EXPECT_FALSE(instance.has_pending_task_for_testing());
+  EXPECT_EQ(0u, task_environment_.GetPendingMainThreadTaskCount());
+
+  // An idle period during input handling doesn't run it.
+  instance.OnIdlePeriodStarted();
+  EXPECT_TRUE(instance.has_deferred_reclaim_for_testing());
+
+  // It is rescheduled when input handling is over...
+  instance.SetHandlingInput(false);
+  EXPECT_TRUE(instance.has_pending_task_for_testing());
+  EXPECT_EQ(1u, task_environment_.GetPendingMainThreadTaskCount());
+
+  // ...and runs in the next idle period, without posting another task.
+  instance.OnIdlePeriodStarted();
+  EXPECT_FALSE(instance.has_deferred_reclaim_for_testing());
+  EXPECT_EQ(1u, task_environment_.GetPendingMainThreadTaskCount());
+}
+
+TEST_F(MemoryReclaimerSupportTest, ReclaimAllInBackground) {
+  test::ScopedFeatureList feature_list{kReclaimAllMemoryInBackground};
+  auto& instance = MemoryReclaimerSupport::Instance();
+  instance.Start(task_environment_.GetMainThreadTaskRunner());
+  size_t pending_tasks = task_environment_.GetPendingMainThreadTaskCount();
+
+  // A single background reclaim is posted.
+  instance.SetForegrounded(false);
+  instance.SetForegrounded(false);
+  EXPECT_EQ(pending_tasks + 1,
+            task_environment_.GetPendingMainThreadTaskCount());
+
+  task_environment_.FastForwardBy(
+      MemoryReclaimerSupport::kBackgroundReclaimDelay);
+  instance.SetForegrounded(true);
+  instance.SetForegrounded(false);
+  EXPECT_EQ(1u + instance.has_pending_task_for_testing(),
+            task_environment_.GetPendingMainThreadTaskCount());
+}
+
+#if PA_CONFIG(THREAD_CACHE_SUPPORTED) && \
+    PA_BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+TEST(ThreadCacheAutotunerTest, ComputeScales) {
+  ThreadCacheAutotuner::AllocationCounts counts{};
+  // No profile, no change.
+  for (float scale : ThreadCacheAutotuner::ComputeScales(counts)) {
+    EXPECT_EQ(1.f, scale);
+  }
+
+  // One hot bucket, one at the reference share, and the rest is cold.
+  counts[1] = 1000;
+  constexpr double kShare = ThreadCacheAutotuner::kReferenceShare;
+  counts[2] = static_cast<uint64_t>(1000 * kShare / (1 - kShare));
+  counts[3] = 1;
+  ThreadCacheAutotuner::Scales scales =
+      ThreadCacheAutotuner::ComputeScales(counts);
+  EXPECT_EQ(ThreadCacheAutotuner::kMinScale, scales[0]);
+  EXPECT_EQ(ThreadCacheAutotuner::kMaxScale, scales[1]);
+  EXPECT_NEAR(1., scales[2], 0.05);
+  EXPECT_EQ(ThreadCacheAutotuner::kMinScale, scales[3]);
+}
+
+TEST(ThreadCacheAutotunerTest, AdjustLimitsAfterEnoughSamples) {
+  ThreadCacheAutotuner autotuner;
+  // Not served by the malloc() partition, ignored.
+  for (size_t i = 0; i < ThreadCacheAutotuner::kMinSamples; i++) {
+    autotuner.SampleAdded(
+        nullptr, 32, 128 * 1024,
+        dispatcher::AllocationSubsystem::kPartitionAllocator, nullptr);
+  }
+  EXPECT_FALSE(autotuner.AdjustLimits());
+
+  for (size_t i = 0; i < ThreadCacheAutotuner::kMinSamples; i++) {
+    autotuner.SampleAdded(nullptr, 32, 128 * 1024,
+                          dispatcher::AllocationSubsystem::kAllocatorShim,
+                          nullptr);
+  }
+  EXPECT_TRUE(autotuner.AdjustLimits());
+  // Samples are consumed.
+  EXPECT_FALSE(autotuner.AdjustLimits());
+
+  ThreadCacheAutotuner::Scales scales;
+  scales.fill(1.f);
+  ::partition_alloc::ThreadCacheRegistry::Instance().SetBucketLimitScales(
+      scales.data(), scales.size());
+}
+#endif  // PA_CONFIG(THREAD_CACHE_SUPPORTED) &&
+        // PA_BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+
 }  // namespace base::allocator
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cstdint>
+#include <iterator>
 
 #include "partition_alloc/build_config.h"
 #include "partition_alloc/internal_allocator.h"
@@ -73,6 +74,8 @@ static bool g_thread_cache_key_created = false;
 }  // namespace
 
 uint8_t ThreadCache::global_limits_[ThreadCache::kBucketCount];
+float ThreadCache::global_multiplier_ = ThreadCache::kDefaultMultiplier;
+float ThreadCache::global_limit_scales_[ThreadCache::kBucketCount];
 
 // Start with the normal size, not the maximum one.
 uint16_t ThreadCache::largest_active_bucket_index_ =
@@ -233,17 +236,37 @@ void ThreadCacheRegistry::SetThreadCacheMultiplier(float multiplier) {
 
     // Setting the global limit while locked, because we need |tcache->root_|.
     ThreadCache::SetGlobalLimits(tcache->root_, multiplier);
+    PropagateGlobalLimits();
+  }
+}
 
-    while (tcache) {
-      PA_DCHECK(ThreadCache::IsValid(tcache));
-      for (int index = 0; index < ThreadCache::kBucketCount; index++) {
-        // This is racy, but we don't care if the limit is enforced later, and
-        // we really want to avoid atomic instructions on the fast path.
-        tcache->buckets_[index].limit.store(ThreadCache::global_limits_[index],
-                                            std::memory_order_relaxed);
-      }
+void ThreadCacheRegistry::SetBucketLimitScales(const float* scales,
+                                               size_t count) {
+  PA_CHECK(count == ThreadCache::kBucketCount);
+  internal::ScopedGuard scoped_locker(GetLock());
+  ThreadCache* tcache = list_head_;
+  // Same as above, the limits are computed when the first thread cache is
+  // created.
+  if (!tcache) {
+    return;
+  }
 
-      tcache = tcache->next_;
+  for (size_t index = 0; index < count; index++) {
+    PA_CHECK(scales[index] >= 0);
+    ThreadCache::global_limit_scales_[index] = scales[index];
+  }
+  ThreadCache::SetGlobalLimits(tcache->root_, ThreadCache::global_multiplier_);
+  PropagateGlobalLimits();
+}
+
+void ThreadCacheRegistry::PropagateGlobalLimits() {
+  for (ThreadCache* tcache = list_head_; tcache; tcache = tcache->next_) {
+    PA_DCHECK(ThreadCache::IsValid(tcache));
+    for (int index = 0; index < ThreadCache::kBucketCount; index++) {
+      // This is racy, but we don't care if the limit is enforced later, and
+      // we really want to avoid atomic instructions on the fast path.
+      tcache->buckets_[index].limit.store(ThreadCache::global_limits_[index],
+                                          std::memory_order_relaxed);
     }
   }
 }
@@ -407,11 +430,14 @@ void ThreadCache::Init(PartitionRoot* root) {
   internal::PartitionTlsSetOnDllProcessDetach(OnDllProcessDetach);
 #endif
 
+  std::fill(std::begin(global_limit_scales_), std::end(global_limit_scales_),
+            1.f);
   SetGlobalLimits(root, kDefaultMultiplier);
 }
 
 // static
 void ThreadCache::SetGlobalLimits(PartitionRoot* root, float multiplier) {
+  global_multiplier_ = multiplier;
   size_t initial_value =
       static_cast<size_t>(kSmallBucketBaseCount) * multiplier;
 
@@ -436,6 +462,7 @@ void ThreadCache::SetGlobalLimits(PartitionRoot* root, float multiplier) {
     } else {
       value = initial_value / 8;
     }
+    value = static_cast<size_t>(value * global_limit_scales_[index]);
 
     // Bare minimum so that malloc() / free() in a loop will not hit the central
     // allocator each time.
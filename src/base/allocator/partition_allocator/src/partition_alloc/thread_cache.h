@@ -132,6 +132,11 @@ class PA_COMPONENT_EXPORT(PARTITION_ALLOC) ThreadCacheRegistry {
   // Controls the thread cache size, by setting the multiplier to a value above
   // or below |ThreadCache::kDefaultMultiplier|.
   void SetThreadCacheMultiplier(float multiplier);
+  // Scales the limit of each bucket on top of the multiplier, so that buckets
+  // which are hot in this process cache more objects than cold ones.
+  // |scales| has |ThreadCache::kBucketCount| entries, and a scale of 1 keeps
+  // the limit given by the multiplier. Applies to all thread caches.
+  void SetBucketLimitScales(const float* scales, size_t count);
   void SetLargestActiveBucketIndex(uint16_t largest_active_bucket_index);
 
   // Controls the thread cache purging configuration.
@@ -165,6 +170,9 @@ class PA_COMPONENT_EXPORT(PARTITION_ALLOC) ThreadCacheRegistry {
   friend class tools::ThreadCacheInspector;
   friend class tools::HeapDumper;
 
+  // Copies the global limits to all thread caches.
+  void PropagateGlobalLimits() PA_EXCLUSIVE_LOCKS_REQUIRED(GetLock());
+
   // Not using base::Lock as the object's constructor must be constexpr.
   internal::Lock lock_;
   ThreadCache* list_head_ PA_GUARDED_BY(GetLock()) = nullptr;
@@ -438,6 +446,9 @@ class PA_COMPONENT_EXPORT(PARTITION_ALLOC) ThreadCache {
   static constexpr uintptr_t kTombstoneMask = ~kTombstone;
 
   static uint8_t global_limits_[kBucketCount];
+  // Inputs of the global limits, see SetGlobalLimits().
+  static float global_multiplier_;
+  static float global_limit_scales_[kBucketCount];
   // Index of the largest active bucket. Not all processes/platforms will use
   // all buckets, as using larger buckets increases the memory footprint.
   //
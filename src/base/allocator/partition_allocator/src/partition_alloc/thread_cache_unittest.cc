@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <iterator>
 #include <vector>
 
 #include "partition_alloc/build_config.h"
@@ -1038,6 +1039,52 @@ TEST_P(PartitionAllocThreadCacheTest, DynamicCountPerBucketClamping) {
   }
 }
 
+TEST_P(PartitionAllocThreadCacheTest, BucketLimitScales) {
+  auto* tcache = root()->thread_cache_for_testing();
+  size_t small_index =
+      FillThreadCacheAndReturnIndex(kSmallSize, kDefaultCountForSmallBucket);
+  size_t medium_index =
+      FillThreadCacheAndReturnIndex(kMediumSize, kDefaultCountForMediumBucket);
+  ASSERT_NE(small_index, medium_index);
+
+  float scales[ThreadCache::kBucketCount];
+  std::fill(std::begin(scales), std::end(scales), 1.f);
+  scales[small_index] = 0.5f;
+  scales[medium_index] = 2.f;
+  ThreadCacheRegistry::Instance().SetBucketLimitScales(scales,
+                                                       std::size(scales));
+  EXPECT_EQ(kDefaultCountForSmallBucket / 2,
+            tcache->bucket_for_testing(small_index)
+                .limit.load(std::memory_order_relaxed));
+  EXPECT_EQ(kDefaultCountForMediumBucket * 2,
+            tcache->bucket_for_testing(medium_index)
+                .limit.load(std::memory_order_relaxed));
+
+  // The scales apply on top of the multiplier.
+  ThreadCacheRegistry::Instance().SetThreadCacheMultiplier(
+      ThreadCache::kDefaultMultiplier / 2);
+  EXPECT_EQ(kDefaultCountForSmallBucket / 4,
+            tcache->bucket_for_testing(small_index)
+                .limit.load(std::memory_order_relaxed));
+  EXPECT_EQ(kDefaultCountForMediumBucket,
+            tcache->bucket_for_testing(medium_index)
+                .limit.load(std::memory_order_relaxed));
+
+  // Lower limits are enforced on the next deallocation.
+  FillThreadCacheAndReturnIndex(kSmallSize, 1000);
+  EXPECT_LE(tcache->bucket_for_testing(small_index).count,
+            kDefaultCountForSmallBucket / 4);
+
+  std::fill(std::begin(scales), std::end(scales), 1.f);
+  ThreadCacheRegistry::Instance().SetBucketLimitScales(scales,
+                                                       std::size(scales));
+  ThreadCacheRegistry::Instance().SetThreadCacheMultiplier(
+      ThreadCache::kDefaultMultiplier);
+  EXPECT_EQ(kDefaultCountForSmallBucket,
+            tcache->bucket_for_testing(small_index)
+                .limit.load(std::memory_order_relaxed));
+}
+
 // TODO(crbug.com/40816487): Flaky on IOS.
 #if BUILDFLAG(IS_IOS)
 #define MAYBE_DynamicCountPerBucketMultipleThreads \
@@ -0,0 +1,81 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/base64.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/base64url.h"
+#include "base/rand_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/timer/lap_timer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace base {
+namespace {
+
+// From short tokens up to the multi-megabyte blobs stored in prefs or sent
+// as data: URLs.
+constexpr size_t kInputSizes[] = {64, 4 * 1024, 4 * 1024 * 1024};
+
+template <typename Function>
+void RunTest(const std::string& name, size_t size, Function function) {
+  LapTimer timer;
+  do {
+    function();
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+
+  perf_test::PerfResultReporter reporter(name,
+                                         NumberToString(size) + "_bytes");
+  reporter.RegisterImportantMetric("throughput", "bytesPerSecond");
+  reporter.AddResult("throughput", timer.LapsPerSecond() * size);
+}
+
+TEST(Base64PerfTest, Encode) {
+  for (size_t size : kInputSizes) {
+    const std::vector<uint8_t> input = RandBytesAsVector(size);
+    RunTest("Base64Encode", size, [&] { Base64Encode(input); });
+  }
+}
+
+TEST(Base64PerfTest, Decode) {
+  for (size_t size : kInputSizes) {
+    const std::string input = Base64Encode(RandBytesAsVector(size));
+    RunTest("Base64Decode", size, [&] {
+      std::string output;
+      Base64Decode(input, &output);
+    });
+  }
+}
+
+TEST(Base64PerfTest, UrlEncode) {
+  for (size_t size : kInputSizes) {
+    const std::vector<uint8_t> input = RandBytesAsVector(size);
+    RunTest("Base64UrlEncode", size, [&] {
+      std::string output;
+      Base64UrlEncode(input, Base64UrlEncodePolicy::OMIT_PADDING, &output);
+    });
+  }
+}
+
+TEST(Base64PerfTest, UrlDecode) {
+  for (size_t size : kInputSizes) {
+    std::string input;
+    Base64UrlEncode(RandBytesAsVector(size),
+                    Base64UrlEncodePolicy::OMIT_PADDING, &input);
+    RunTest("Base64UrlDecode", size, [&] {
+      std::string output;
+      Base64UrlDecode(input, Base64UrlDecodePolicy::IGNORE_PADDING, &output);
+    });
+  }
+}
+
+}  // namespace
+}  // namespace base
@@ -60,6 +60,7 @@
 
 #include "base/allocator/dispatcher/dispatcher.h"
 #include "base/allocator/dispatcher/notification_data.h"
+#include "base/containers/flat_hash_map.h"
 #include "base/containers/flat_map.h"
 #include "base/logging.h"
 #include "base/strings/safe_sprintf.h"
@@ -160,6 +161,8 @@ void Measure(const Inserter& inserter) {
 
   RAW_LOG(INFO, "===== base::flat_map =====");
   MeasureOneContainer<base::flat_map<K, V>>(inserter);
+  RAW_LOG(INFO, "===== base::flat_hash_map =====");
+  MeasureOneContainer<base::flat_hash_map<K, V, Hasher>>(inserter);
   RAW_LOG(INFO, "===== std::map =====");
   MeasureOneContainer<std::map<K, V>>(inserter);
   RAW_LOG(INFO, "===== std::unordered_map =====");
@@ -0,0 +1,492 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// This file contains a fixed-capacity variant of the caches in lru_cache.h,
+// with the same interface as `base::HashingLRUCache` and
+// `base::HashingLRUCacheSet`. See `base::FixedHashingLRUCache` and
+// `base::FixedHashingLRUCacheSet` at the bottom of this file.
+//
+// `base::HashingLRUCache` allocates a list node and a hash map node for every
+// entry, and stores the key twice. The fixed variants allocate all of their
+// entries up front, in one array of nodes that are linked into the recency
+// list by index, and find them through an open-addressing index of 8-byte
+// entries. Nothing is allocated after construction, and the key is stored
+// once.
+//
+// Prefer them for caches that are expected to fill up, since the memory for
+// `max_size` entries is allocated even if fewer are ever inserted. They don't
+// support `NO_AUTO_EVICT`.
+
+#ifndef BASE_CONTAINERS_FIXED_LRU_CACHE_H_
+#define BASE_CONTAINERS_FIXED_LRU_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "base/compiler_specific.h"
+#include "base/containers/lru_cache.h"
+#include "base/memory/raw_ptr_exclusion.h"
+
+namespace base {
+namespace trace_event::internal {
+
+template <class FixedLruCacheType>
+size_t DoEstimateMemoryUsageForFixedLruCache(const FixedLruCacheType&);
+
+}  // namespace trace_event::internal
+
+namespace internal {
+
+// Base class for the fixed-capacity LRU cache specializations defined below.
+template <class ValueType, class GetKeyFromValue, class KeyHash, class KeyEqual>
+class FixedLRUCacheBase {
+ public:
+  using value_type = ValueType;
+  using key_type = std::remove_cvref_t<decltype(GetKeyFromValue()(
+      std::declval<const value_type&>()))>;
+  using size_type = size_t;
+
+ private:
+  // An entry of the cache. Nodes that hold a value are linked into the
+  // recency list; the others are either on the free list or past
+  // `used_nodes_`.
+  struct Node {
+    Node() {}
+    ~Node() {}
+
+    uint32_t prev;
+    uint32_t next;
+    union {
+      value_type value;
+    };
+  };
+
+  // An entry of the index, which maps keys to the nodes that hold them.
+  struct IndexEntry {
+    uint32_t node;
+    uint32_t hash;
+  };
+
+  static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+  template <bool kIsConst>
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = typename FixedLRUCacheBase::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer =
+        std::conditional_t<kIsConst, const value_type*, value_type*>;
+    using reference =
+        std::conditional_t<kIsConst, const value_type&, value_type&>;
+
+    Iterator() = default;
+    // Allow conversion from iterator to const_iterator.
+    template <bool kOtherIsConst>
+      requires(kIsConst && !kOtherIsConst)
+    Iterator(const Iterator<kOtherIsConst>& other)  // NOLINT
+        : nodes_(other.nodes_), node_(other.node_) {}
+
+    reference operator*() const { return nodes_[node_].value; }
+    pointer operator->() const { return &nodes_[node_].value; }
+
+    Iterator& operator++() {
+      node_ = nodes_[node_].next;
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator copy = *this;
+      ++*this;
+      return copy;
+    }
+    Iterator& operator--() {
+      node_ = nodes_[node_].prev;
+      return *this;
+    }
+    Iterator operator--(int) {
+      Iterator copy = *this;
+      --*this;
+      return copy;
+    }
+
+    friend bool operator==(const Iterator& lhs,
+                           const Iterator& rhs) = default;
+
+   private:
+    friend class FixedLRUCacheBase;
+    friend class Iterator<true>;
+
+    using NodeType = std::conditional_t<kIsConst, const Node, Node>;
+
+    Iterator(NodeType* nodes, uint32_t node) : nodes_(nodes), node_(node) {}
+
+    // RAW_PTR_EXCLUSION: Iterators point into the cache's node array, and are
+    // dereferenced on every lookup.
+    RAW_PTR_EXCLUSION NodeType* nodes_ = nullptr;
+    uint32_t node_ = 0;
+  };
+
+ public:
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  // The largest supported `max_size`.
+  static constexpr size_type kMaxSize = size_type{1} << 30;
+
+  // Allocates room for `max_size` items. When a new item is inserted into a
+  // full cache, the least recently used item is evicted.
+  explicit FixedLRUCacheBase(size_type max_size) : max_size_(max_size) {
+    CHECK_GT(max_size, 0u) << "Fixed LRU caches don't support NO_AUTO_EVICT";
+    CHECK_LE(max_size, kMaxSize);
+    Allocate();
+  }
+
+  // Like `base::LRUCacheBase`, fixed caches are move-only. A moved-from cache
+  // is empty and allocates again on the next `Put()`.
+  FixedLRUCacheBase(FixedLRUCacheBase&& other) noexcept
+      : nodes_(std::move(other.nodes_)),
+        index_(std::move(other.index_)),
+        index_capacity_(std::exchange(other.index_capacity_, 0)),
+        free_list_(std::exchange(other.free_list_, kNone)),
+        used_nodes_(std::exchange(other.used_nodes_, 0)),
+        size_(std::exchange(other.size_, 0)),
+        max_size_(other.max_size_),
+        hash_(std::move(other.hash_)),
+        key_equal_(std::move(other.key_equal_)) {}
+
+  FixedLRUCacheBase& operator=(FixedLRUCacheBase&& other) noexcept {
+    FixedLRUCacheBase moved(std::move(other));
+    Swap(moved);
+    return *this;
+  }
+
+  ~FixedLRUCacheBase() { DestroyValues(); }
+
+  size_type max_size() const { return max_size_; }
+
+  // Inserts an item into the list. If an existing item has the same key, it is
+  // replaced. Otherwise, if the cache is full, the least recently used item is
+  // evicted. An iterator indicating the inserted item will be returned (this
+  // will always be the front of the list).
+  // In the map variations of this container, `value_type` is a `std::pair` and
+  // it's preferred to use the `Put(k, v)` overload of this method.
+  iterator Put(value_type&& value) {
+    if (!nodes_) {
+      Allocate();
+    }
+    // `key` refers into `value` until the new item is constructed from it.
+    const key_type& key = GetKeyFromValue{}(value);
+    const uint32_t hash = HashOf(key);
+    size_t slot = FindSlot(key, hash);
+    uint32_t node = index_[slot].node;
+    if (node != kNone) {
+      // Reuse the node of the existing item. Its index entry is unchanged.
+      Unlink(node);
+      nodes_[node].value.~value_type();
+    } else {
+      if (size_ == max_size_) {
+        node = nodes_[Sentinel()].prev;
+        RemoveFromIndex(node);
+        Unlink(node);
+        nodes_[node].value.~value_type();
+        --size_;
+        // Removing from the index can shift entries into `slot`.
+        slot = FindSlot(key, hash);
+      } else {
+        node = AllocateNode();
+      }
+      index_[slot] = {node, hash};
+      ++size_;
+    }
+    new (&nodes_[node].value) value_type(std::move(value));
+    LinkFront(node);
+    return iterator(nodes_.get(), node);
+  }
+
+  // Inserts an item into the list. If an existing item has the same key, it is
+  // replaced. An iterator indicating the inserted item will be returned (this
+  // will always be the front of the list).
+  template <class K, class V>
+    requires(std::same_as<GetKeyFromValue, GetKeyFromKVPair>)
+  iterator Put(K&& key, V&& value) {
+    return Put(value_type{std::forward<K>(key), std::forward<V>(value)});
+  }
+
+  // Retrieves the contents of the given key, or end() if not found. This method
+  // has the side effect of moving the requested item to the front of the
+  // recency list.
+  iterator Get(const key_type& key) {
+    const uint32_t node = FindNode(key);
+    if (node == kNone) {
+      return end();
+    }
+    Unlink(node);
+    LinkFront(node);
+    return iterator(nodes_.get(), node);
+  }
+
+  // Retrieves the item associated with a given key and returns it via
+  // result without affecting the ordering (unlike Get()).
+  iterator Peek(const key_type& key) {
+    const uint32_t node = FindNode(key);
+    return node == kNone ? end() : iterator(nodes_.get(), node);
+  }
+
+  const_iterator Peek(const key_type& key) const {
+    const uint32_t node = FindNode(key);
+    return node == kNone ? end() : const_iterator(nodes_.get(), node);
+  }
+
+  // Exchanges the contents of |this| by the contents of the |other|.
+  void Swap(FixedLRUCacheBase& other) noexcept {
+    std::swap(nodes_, other.nodes_);
+    std::swap(index_, other.index_);
+    std::swap(index_capacity_, other.index_capacity_);
+    std::swap(free_list_, other.free_list_);
+    std::swap(used_nodes_, other.used_nodes_);
+    std::swap(size_, other.size_);
+    std::swap(max_size_, other.max_size_);
+    std::swap(hash_, other.hash_);
+    std::swap(key_equal_, other.key_equal_);
+  }
+
+  // Erases the item referenced by the given iterator. An iterator to the item
+  // following it will be returned. The iterator must be valid.
+  iterator Erase(iterator pos) {
+    const uint32_t node = pos.node_;
+    DCHECK_NE(node, Sentinel());
+    const uint32_t next = nodes_[node].next;
+    RemoveFromIndex(node);
+    Unlink(node);
+    nodes_[node].value.~value_type();
+    nodes_[node].next = free_list_;
+    free_list_ = node;
+    --size_;
+    return iterator(nodes_.get(), next);
+  }
+
+  // LRUCache entries are often processed in reverse order, so we add this
+  // convenience function (not typically defined by STL containers).
+  reverse_iterator Erase(reverse_iterator pos) {
+    // We have to actually give it the incremented iterator to delete, since
+    // the forward iterator that base() returns is actually one past the item
+    // being iterated over.
+    return reverse_iterator(Erase((++pos).base()));
+  }
+
+  // Shrinks the cache so it only holds |new_size| items. If |new_size| is
+  // bigger or equal to the current number of items, this will do nothing.
+  void ShrinkToSize(size_type new_size) {
+    for (size_type i = size(); i > new_size; i--) {
+      Erase(rbegin());
+    }
+  }
+
+  // Deletes everything from the cache. Keeps the allocation.
+  void Clear() {
+    if (!nodes_) {
+      return;
+    }
+    DestroyValues();
+    ResetLinksAndIndex();
+  }
+
+  // Returns the number of elements in the cache.
+  size_type size() const { return size_; }
+
+  // Allows iteration over the list. Forward iteration starts with the most
+  // recent item and works backwards.
+  //
+  // Like with `base::LRUCache`, you can keep iterators as you insert or delete
+  // things (as long as you don't delete the one you are pointing to, or it
+  // isn't evicted) and they will still be valid.
+  iterator begin() { return nodes_ ? ++end() : end(); }
+  const_iterator begin() const { return nodes_ ? ++end() : end(); }
+  iterator end() { return iterator(nodes_.get(), Sentinel()); }
+  const_iterator end() const {
+    return const_iterator(nodes_.get(), Sentinel());
+  }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const {
+    return const_reverse_iterator(end());
+  }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rend() const {
+    return const_reverse_iterator(begin());
+  }
+
+  bool empty() const { return size_ == 0; }
+
+ private:
+  template <class FixedLruCacheType>
+  friend size_t trace_event::internal::DoEstimateMemoryUsageForFixedLruCache(
+      const FixedLruCacheType&);
+
+  // The node at index `max_size_` doesn't hold a value. It is the head and
+  // the tail of the circular recency list, and the target of end().
+  uint32_t Sentinel() const { return static_cast<uint32_t>(max_size_); }
+
+  void Allocate() {
+    // Up to half of the index is used, so that probe sequences stay short.
+    nodes_ = std::make_unique<Node[]>(max_size_ + 1);
+    index_capacity_ = std::bit_ceil(2 * max_size_);
+    index_ = std::make_unique_for_overwrite<IndexEntry[]>(index_capacity_);
+    ResetLinksAndIndex();
+  }
+
+  void ResetLinksAndIndex() {
+    std::fill_n(index_.get(), index_capacity_, IndexEntry{kNone, 0});
+    nodes_[Sentinel()].prev = nodes_[Sentinel()].next = Sentinel();
+    free_list_ = kNone;
+    used_nodes_ = 0;
+    size_ = 0;
+  }
+
+  uint32_t AllocateNode() {
+    if (free_list_ != kNone) {
+      return std::exchange(free_list_, nodes_[free_list_].next);
+    }
+    DCHECK_LT(used_nodes_, max_size_);
+    return used_nodes_++;
+  }
+
+  void Unlink(uint32_t node) {
+    nodes_[nodes_[node].prev].next = nodes_[node].next;
+    nodes_[nodes_[node].next].prev = nodes_[node].prev;
+  }
+
+  void LinkFront(uint32_t node) {
+    const uint32_t first = nodes_[Sentinel()].next;
+    nodes_[node].prev = Sentinel();
+    nodes_[node].next = first;
+    nodes_[first].prev = node;
+    nodes_[Sentinel()].next = node;
+  }
+
+  uint32_t HashOf(const key_type& key) const {
+    // Mix the bits, so that hashers that are the identity for integers still
+    // spread keys over the index.
+    uint64_t hash = static_cast<uint64_t>(hash_(key));
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return static_cast<uint32_t>(hash);
+  }
+
+  // Returns the slot of the index entry for `key`, or of the empty slot where
+  // it would be inserted. Linear probing always finds one, since at most half
+  // of the slots are used.
+  size_t FindSlot(const key_type& key, uint32_t hash) const {
+    const size_t mask = index_capacity_ - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+      const IndexEntry& entry = index_[slot];
+      if (entry.node == kNone ||
+          (entry.hash == hash &&
+           key_equal_(GetKeyFromValue{}(nodes_[entry.node].value), key))) {
+        return slot;
+      }
+    }
+  }
+
+  uint32_t FindNode(const key_type& key) const {
+    if (size_ == 0) {
+      return kNone;
+    }
+    return index_[FindSlot(key, HashOf(key))].node;
+  }
+
+  // Removes the index entry of `node`, and shifts the entries that follow it
+  // in its probe sequence back, so that the index never holds tombstones.
+  void RemoveFromIndex(uint32_t node) {
+    const size_t mask = index_capacity_ - 1;
+    size_t slot = HashOf(GetKeyFromValue{}(nodes_[node].value)) & mask;
+    while (index_[slot].node != node) {
+      DCHECK_NE(index_[slot].node, kNone);
+      slot = (slot + 1) & mask;
+    }
+    for (size_t next = (slot + 1) & mask; index_[next].node != kNone;
+         next = (next + 1) & mask) {
+      // An entry can move back to `slot` if that doesn't put it before the
+      // slot that its probe sequence starts at.
+      const size_t home = index_[next].hash & mask;
+      if (((next - home) & mask) >= ((next - slot) & mask)) {
+        index_[slot] = index_[next];
+        slot = next;
+      }
+    }
+    index_[slot] = IndexEntry{kNone, 0};
+  }
+
+  void DestroyValues() {
+    if (!nodes_) {
+      return;
+    }
+    for (uint32_t node = nodes_[Sentinel()].next; node != Sentinel();
+         node = nodes_[node].next) {
+      nodes_[node].value.~value_type();
+    }
+  }
+
+  std::unique_ptr<Node[]> nodes_;
+  std::unique_ptr<IndexEntry[]> index_;
+  size_t index_capacity_ = 0;
+  // The head of a singly linked list, through `Node::next`, of the nodes that
+  // held an erased value. They are reused before the ones past `used_nodes_`.
+  uint32_t free_list_ = kNone;
+  uint32_t used_nodes_ = 0;
+  size_type size_ = 0;
+  size_type max_size_;
+  NO_UNIQUE_ADDRESS KeyHash hash_;
+  NO_UNIQUE_ADDRESS KeyEqual key_equal_;
+};
+
+}  // namespace internal
+
+// Implements a fixed-capacity LRU cache of `ValueType`, where each value can be
+// uniquely referenced by `KeyType`, and `KeyType` may be hashed for O(1)
+// insertion, removal, and lookup. It allocates room for `max_size` entries on
+// construction, and none afterwards. Entries can be iterated in order of
+// least-recently-used to most-recently-used by iterating from `rbegin()` to
+// `rend()`, where a "use" is defined as a call to `Put(k, v)` or `Get(k)`.
+template <class KeyType,
+          class ValueType,
+          class KeyHash = std::hash<KeyType>,
+          class KeyEqual = std::equal_to<KeyType>>
+using FixedHashingLRUCache =
+    internal::FixedLRUCacheBase<std::pair<KeyType, ValueType>,
+                                internal::GetKeyFromKVPair,
+                                KeyHash,
+                                KeyEqual>;
+
+// Implements a fixed-capacity LRU cache of `ValueType`, where each value is
+// unique, and may be hashed for O(1) insertion, removal, and lookup. It
+// allocates room for `max_size` entries on construction, and none afterwards.
+// Entries can be iterated in order of least-recently-used to
+// most-recently-used by iterating from `rbegin()` to `rend()`, where a "use" is
+// defined as a call to `Put(v)` or `Get(v)`.
+template <class ValueType,
+          class Hash = std::hash<ValueType>,
+          class Equal = std::equal_to<ValueType>>
+using FixedHashingLRUCacheSet =
+    internal::FixedLRUCacheBase<ValueType, std::identity, Hash, Equal>;
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FIXED_LRU_CACHE_H_
@@ -0,0 +1,260 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/fixed_lru_cache.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/rand_util.h"
+#include "base/tracing_buildflags.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+#if BUILDFLAG(ENABLE_BASE_TRACING)
+#include "base/trace_event/memory_usage_estimator.h"  // no-presubmit-check
+#endif  // BUILDFLAG(ENABLE_BASE_TRACING)
+
+namespace base {
+
+namespace {
+
+int cached_item_live_count = 0;
+
+struct CachedItem {
+  explicit CachedItem(int new_value) : value(new_value) {
+    cached_item_live_count++;
+  }
+
+  CachedItem(CachedItem&& other) : value(other.value) {
+    cached_item_live_count++;
+  }
+
+  ~CachedItem() { cached_item_live_count--; }
+
+  int value;
+};
+
+// Sends every key to the same index slot, so that lookups and erases have to
+// walk past other entries.
+struct CollidingHash {
+  size_t operator()(int) const { return 0; }
+};
+
+template <class Cache>
+std::vector<int> KeysMostRecentFirst(const Cache& cache) {
+  std::vector<int> keys;
+  for (const auto& item : cache) {
+    keys.push_back(item.first);
+  }
+  return keys;
+}
+
+}  // namespace
+
+TEST(FixedHashingLRUCacheTest, Basic) {
+  FixedHashingLRUCache<int, std::string> cache(3);
+  EXPECT_EQ(3u, cache.max_size());
+  EXPECT_TRUE(cache.empty());
+  EXPECT_EQ(cache.begin(), cache.end());
+  EXPECT_EQ(cache.rbegin(), cache.rend());
+  EXPECT_EQ(cache.end(), cache.Get(1));
+  EXPECT_EQ(cache.end(), cache.Peek(1));
+
+  auto inserted = cache.Put(1, "a");
+  EXPECT_EQ(cache.begin(), inserted);
+  cache.Put(2, "b");
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_EQ(1, cache.rbegin()->first);
+
+  // Get() moves the item to the front, Peek() doesn't.
+  EXPECT_EQ("a", cache.Get(1)->second);
+  EXPECT_EQ((std::vector<int>{1, 2}), KeysMostRecentFirst(cache));
+  EXPECT_EQ("b", cache.Peek(2)->second);
+  EXPECT_EQ((std::vector<int>{1, 2}), KeysMostRecentFirst(cache));
+  EXPECT_EQ("b", std::as_const(cache).Peek(2)->second);
+}
+
+TEST(FixedHashingLRUCacheTest, KeyReplacement) {
+  FixedHashingLRUCache<int, std::string> cache(3);
+  cache.Put(1, "a");
+  cache.Put(2, "b");
+  cache.Put(3, "c");
+  // Replacing an item in a full cache doesn't evict anything.
+  cache.Put(1, "d");
+  EXPECT_EQ(3u, cache.size());
+  EXPECT_EQ((std::vector<int>{1, 3, 2}), KeysMostRecentFirst(cache));
+  EXPECT_EQ("d", cache.Peek(1)->second);
+}
+
+TEST(FixedHashingLRUCacheTest, AutoEvict) {
+  const int initial_count = cached_item_live_count;
+  {
+    FixedHashingLRUCache<int, CachedItem> cache(3);
+    for (int i = 0; i < 5; ++i) {
+      cache.Put(i, CachedItem(i));
+    }
+    EXPECT_EQ(3u, cache.size());
+    EXPECT_EQ(initial_count + 3, cached_item_live_count);
+    EXPECT_EQ((std::vector<int>{4, 3, 2}), KeysMostRecentFirst(cache));
+    EXPECT_EQ(cache.end(), cache.Peek(1));
+
+    cache.Get(2);
+    cache.Put(5, CachedItem(5));
+    EXPECT_EQ((std::vector<int>{5, 2, 4}), KeysMostRecentFirst(cache));
+  }
+  EXPECT_EQ(initial_count, cached_item_live_count);
+}
+
+TEST(FixedHashingLRUCacheTest, Erase) {
+  const int initial_count = cached_item_live_count;
+  FixedHashingLRUCache<int, std::unique_ptr<CachedItem>> cache(4);
+  for (int i = 0; i < 4; ++i) {
+    cache.Put(i, std::make_unique<CachedItem>(i));
+  }
+
+  auto next = cache.Erase(cache.Peek(2));
+  EXPECT_EQ(1, next->first);
+  auto reverse_next = cache.Erase(cache.rbegin());
+  EXPECT_EQ(1, reverse_next->first);
+  EXPECT_EQ((std::vector<int>{3, 1}), KeysMostRecentFirst(cache));
+  EXPECT_EQ(initial_count + 2, cached_item_live_count);
+
+  // Erased nodes are reused.
+  cache.Put(4, std::make_unique<CachedItem>(4));
+  cache.Put(5, std::make_unique<CachedItem>(5));
+  EXPECT_EQ((std::vector<int>{5, 4, 3, 1}), KeysMostRecentFirst(cache));
+
+  cache.ShrinkToSize(1);
+  EXPECT_EQ((std::vector<int>{5}), KeysMostRecentFirst(cache));
+  cache.Clear();
+  EXPECT_TRUE(cache.empty());
+  EXPECT_EQ(initial_count, cached_item_live_count);
+  cache.Put(6, std::make_unique<CachedItem>(6));
+  EXPECT_EQ((std::vector<int>{6}), KeysMostRecentFirst(cache));
+}
+
+TEST(FixedHashingLRUCacheTest, IteratorsStayValid) {
+  FixedHashingLRUCache<int, int> cache(3);
+  auto one = cache.Put(1, 10);
+  cache.Put(2, 20);
+  cache.Get(1);
+  cache.Put(3, 30);
+  cache.Erase(cache.Peek(2));
+  EXPECT_EQ(1, one->first);
+  EXPECT_EQ(10, one->second);
+
+  // Reverse iteration walks from the least recently used item.
+  std::vector<int> keys;
+  for (auto it = cache.rbegin(); it != cache.rend(); ++it) {
+    keys.push_back(it->first);
+  }
+  EXPECT_EQ((std::vector<int>{1, 3}), keys);
+}
+
+TEST(FixedHashingLRUCacheTest, Collisions) {
+  FixedHashingLRUCache<int, int, CollidingHash> cache(16);
+  for (int i = 0; i < 16; ++i) {
+    cache.Put(i, i);
+  }
+  for (int i = 0; i < 16; i += 2) {
+    cache.Erase(cache.Peek(i));
+  }
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_EQ(i % 2 == 1, cache.Peek(i) != cache.end()) << i;
+  }
+}
+
+TEST(FixedHashingLRUCacheTest, MatchesHashingLRUCache) {
+  constexpr size_t kMaxSize = 50;
+  FixedHashingLRUCache<int, int> cache(kMaxSize);
+  HashingLRUCache<int, int> expected(kMaxSize);
+  for (int i = 0; i < 20000; ++i) {
+    const int key = RandInt(0, 200);
+    switch (RandInt(0, 3)) {
+      case 0:
+        cache.Put(key, i);
+        expected.Put(key, i);
+        break;
+      case 1: {
+        auto it = cache.Peek(key);
+        auto expected_it = expected.Peek(key);
+        ASSERT_EQ(expected_it == expected.end(), it == cache.end());
+        if (it != cache.end()) {
+          cache.Erase(it);
+          expected.Erase(expected_it);
+        }
+        break;
+      }
+      case 2:
+        EXPECT_EQ(expected.Get(key) == expected.end(),
+                  cache.Get(key) == cache.end());
+        break;
+      case 3:
+        if (RandInt(0, 100) == 0) {
+          cache.ShrinkToSize(kMaxSize / 2);
+          expected.ShrinkToSize(kMaxSize / 2);
+        }
+        break;
+    }
+  }
+  ASSERT_EQ(expected.size(), cache.size());
+  auto it = cache.begin();
+  for (const auto& [key, value] : expected) {
+    EXPECT_EQ(key, it->first);
+    EXPECT_EQ(value, it->second);
+    ++it;
+  }
+}
+
+TEST(FixedHashingLRUCacheTest, MoveAndSwap) {
+  FixedHashingLRUCache<int, std::string> cache(2);
+  cache.Put(1, "a");
+
+  FixedHashingLRUCache<int, std::string> moved(std::move(cache));
+  EXPECT_EQ("a", moved.Peek(1)->second);
+  // NOLINTNEXTLINE(bugprone-use-after-move)
+  EXPECT_TRUE(cache.empty());
+  EXPECT_EQ(cache.begin(), cache.end());
+  cache.Put(2, "b");
+  EXPECT_EQ("b", cache.Peek(2)->second);
+
+  FixedHashingLRUCache<int, std::string> other(5);
+  other.Swap(moved);
+  EXPECT_EQ(2u, other.max_size());
+  EXPECT_EQ(5u, moved.max_size());
+  EXPECT_TRUE(moved.empty());
+  EXPECT_EQ("a", other.Peek(1)->second);
+
+  other = std::move(cache);
+  EXPECT_EQ(other.end(), other.Peek(1));
+  EXPECT_EQ("b", other.Peek(2)->second);
+}
+
+TEST(FixedHashingLRUCacheSetTest, Basic) {
+  FixedHashingLRUCacheSet<std::string> cache(2);
+  cache.Put("a");
+  cache.Put("b");
+  cache.Get("a");
+  cache.Put("c");
+  EXPECT_EQ(cache.end(), cache.Peek("b"));
+  std::vector<std::string> values(cache.begin(), cache.end());
+  EXPECT_EQ((std::vector<std::string>{"c", "a"}), values);
+}
+
+#if BUILDFLAG(ENABLE_BASE_TRACING)
+TEST(FixedHashingLRUCacheTest, EstimateMemory) {
+  FixedHashingLRUCache<std::string, int> cache(10);
+
+  const std::string key(100u, 'a');
+  cache.Put(key, 1);
+
+  EXPECT_GT(trace_event::EstimateMemoryUsage(cache),
+            trace_event::EstimateMemoryUsage(key));
+}
+#endif  // BUILDFLAG(ENABLE_BASE_TRACING)
+
+}  // namespace base
@@ -0,0 +1,222 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_MAP_H_
+#define BASE_CONTAINERS_FLAT_HASH_MAP_H_
+
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "base/check.h"
+#include "base/containers/flat_hash_table.h"
+
+namespace base {
+
+namespace internal {
+
+// The flat_hash_table GetKeyFromValue template parameter of flat_hash_map.
+struct GetFirstOfPair {
+  template <class Key, class Mapped>
+  constexpr const Key& operator()(const std::pair<Key, Mapped>& p) const {
+    return p.first;
+  }
+};
+
+}  // namespace internal
+
+// flat_hash_map is an unordered map with a std::unordered_map-like interface
+// that stores its elements inline in a single open-addressing hash table. See
+// flat_hash_table.h for how it works.
+//
+// Please see //base/containers/README.md for an overview of which container
+// to select.
+//
+// PROS
+//
+//  - O(1) lookups, inserts and erases, with fewer cache misses than
+//    std::unordered_map and std::map: a lookup usually reads 16 control bytes
+//    and the one slot that matches.
+//  - One allocation for the whole table, rather than one per element.
+//  - Heterogeneous lookup when the hasher and key_equal are transparent. This
+//    is the default for std::string keys, which can be looked up with a
+//    std::string_view or a const char*.
+//
+// CONS
+//
+//  - Elements move when the table grows, so pointers and references to them
+//    are invalidated by inserts (unlike std::unordered_map).
+//  - Large elements waste the memory of the slots that are empty; the table is
+//    between 7/16 and 7/8 full. Store large values behind a std::unique_ptr, or
+//    use std::unordered_map.
+//  - Iteration order is unspecified.
+//
+// IMPORTANT NOTES
+//
+//  - Like base::flat_map, and unlike std::unordered_map, elements are
+//    std::pair<Key, Mapped> rather than std::pair<const Key, Mapped>, so that
+//    they can be moved when the table grows. Don't modify the key of an
+//    element in the map.
+//  - erase(iterator) returns nothing, and only invalidates iterators to the
+//    erased element. Use base::EraseIf() to erase elements while iterating.
+//
+// QUICK REFERENCE
+//
+// Most of the core functionality is inherited from flat_hash_table:
+//
+// Constructors:
+//   flat_hash_map();
+//   flat_hash_map(const flat_hash_map&);
+//   flat_hash_map(flat_hash_map&&);
+//   flat_hash_map(InputIterator first, InputIterator last);
+//   flat_hash_map(std::initializer_list<value_type> ilist);
+//
+// Assignment functions:
+//   flat_hash_map& operator=(const flat_hash_map&);
+//   flat_hash_map& operator=(flat_hash_map&&);
+//   flat_hash_map& operator=(initializer_list<value_type>);
+//
+// Memory management functions:
+//   void   reserve(size_t);
+//   size_t capacity() const;
+//
+// Size management functions:
+//   void   clear();
+//   size_t size() const;
+//   bool   empty() const;
+//
+// Iterator functions:
+//   iterator               begin();
+//   const_iterator         begin() const;
+//   const_iterator         cbegin() const;
+//   iterator               end();
+//   const_iterator         end() const;
+//   const_iterator         cend() const;
+//
+// Insert and accessor functions:
+//   mapped_type&         operator[](const key_type&);
+//   mapped_type&         operator[](key_type&&);
+//   mapped_type&         at(const K&);
+//   const mapped_type&   at(const K&) const;
+//   pair<iterator, bool> insert(const value_type&);
+//   pair<iterator, bool> insert(value_type&&);
+//   void                 insert(InputIterator first, InputIterator last);
+//   pair<iterator, bool> insert_or_assign(K&&, M&&);
+//   pair<iterator, bool> emplace(Args&&...);
+//   pair<iterator, bool> try_emplace(K&&, Args&&...);
+//
+// Erase functions:
+//   void erase(iterator);
+//   void erase(const_iterator);
+//   template <class K> size_t erase(const K& key);
+//
+// Search functions:
+//   template <typename K> size_t         count(const K&) const;
+//   template <typename K> iterator       find(const K&);
+//   template <typename K> const_iterator find(const K&) const;
+//   template <typename K> bool           contains(const K&) const;
+//
+// General functions:
+//   void swap(flat_hash_map&);
+//
+// Non-member operators:
+//   bool operator==(const flat_hash_map&, const flat_hash_map);
+//   bool operator!=(const flat_hash_map&, const flat_hash_map);
+//
+template <class Key,
+          class Mapped,
+          class Hash = internal::FlatHashDefaultHashT<Key>,
+          class KeyEqual = std::equal_to<>>
+class flat_hash_map : public ::base::internal::flat_hash_table<
+                          Key,
+                          std::pair<Key, Mapped>,
+                          ::base::internal::GetFirstOfPair,
+                          Hash,
+                          KeyEqual> {
+ private:
+  using table = ::base::internal::flat_hash_table<
+      Key,
+      std::pair<Key, Mapped>,
+      ::base::internal::GetFirstOfPair,
+      Hash,
+      KeyEqual>;
+
+ public:
+  using key_type = typename table::key_type;
+  using mapped_type = Mapped;
+  using value_type = typename table::value_type;
+  using reference = typename table::reference;
+  using const_reference = typename table::const_reference;
+  using size_type = typename table::size_type;
+  using difference_type = typename table::difference_type;
+  using iterator = typename table::iterator;
+  using const_iterator = typename table::const_iterator;
+
+  // --------------------------------------------------------------------------
+  // Lifetime and assignments.
+
+  using table::table;
+  using table::operator=;
+
+  // Out-of-bound calls to at() will CHECK.
+  template <class K>
+  mapped_type& at(const K& key) {
+    iterator found = table::find(key);
+    CHECK(found != table::end());
+    return found->second;
+  }
+
+  template <class K>
+  const mapped_type& at(const K& key) const {
+    const_iterator found = table::find(key);
+    CHECK(found != table::cend());
+    return found->second;
+  }
+
+  // --------------------------------------------------------------------------
+  // Map-specific insert operations.
+  //
+  // Normal insert() functions are inherited from flat_hash_table.
+
+  mapped_type& operator[](const key_type& key) {
+    return try_emplace(key).first->second;
+  }
+
+  mapped_type& operator[](key_type&& key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  template <class K, class M>
+  std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj) {
+    auto result = table::EmplaceKeyArgs(key, std::forward<K>(key),
+                                        std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  template <class K, class... Args>
+    requires(std::is_constructible_v<key_type, K &&>)
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+    return table::EmplaceKeyArgs(
+        key, std::piecewise_construct,
+        std::forward_as_tuple(std::forward<K>(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // --------------------------------------------------------------------------
+  // General operations.
+
+  void swap(flat_hash_map& other) noexcept { table::swap(other); }
+
+  friend void swap(flat_hash_map& lhs, flat_hash_map& rhs) noexcept {
+    lhs.swap(rhs);
+  }
+};
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_MAP_H_
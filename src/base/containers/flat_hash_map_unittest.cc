@@ -0,0 +1,242 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_map.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/rand_util.h"
+#include "base/test/move_only_int.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// flat_hash_map and flat_hash_set share flat_hash_table, so most of the
+// table's behavior is tested here.
+
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+namespace base {
+
+namespace {
+
+// Sends every key to the same group and control byte, so that lookups have to
+// probe past collisions and tombstones.
+struct CollidingHash {
+  size_t operator()(int) const { return 0; }
+};
+
+}  // namespace
+
+TEST(FlatHashMap, Empty) {
+  flat_hash_map<int, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_EQ(0u, map.capacity());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(map.end(), map.find(1));
+  EXPECT_EQ(0u, map.erase(1));
+}
+
+TEST(FlatHashMap, InsertFindErase) {
+  flat_hash_map<int, std::string> map;
+  EXPECT_TRUE(map.insert({1, "a"}).second);
+  EXPECT_FALSE(map.insert({1, "b"}).second);
+  EXPECT_TRUE(map.emplace(2, "c").second);
+  EXPECT_EQ(2u, map.size());
+
+  auto it = map.find(1);
+  ASSERT_NE(map.end(), it);
+  EXPECT_EQ("a", it->second);
+  EXPECT_EQ(1u, map.count(2));
+  EXPECT_EQ(0u, map.count(3));
+
+  map.erase(it);
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(1u, map.erase(2));
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(FlatHashMap, InitializerListAndEquality) {
+  flat_hash_map<int, int> map = {{1, 10}, {2, 20}, {1, 30}};
+  EXPECT_THAT(map, UnorderedElementsAre(Pair(1, 10), Pair(2, 20)));
+
+  flat_hash_map<int, int> other;
+  other[2] = 20;
+  other[1] = 10;
+  EXPECT_EQ(map, other);
+  other[1] = 11;
+  EXPECT_NE(map, other);
+}
+
+TEST(FlatHashMap, SubscriptOperator) {
+  flat_hash_map<std::string, int> map;
+  map["a"] = 1;
+  ++map["a"];
+  map[std::string("b")];
+  EXPECT_THAT(map, UnorderedElementsAre(Pair("a", 2), Pair("b", 0)));
+}
+
+TEST(FlatHashMap, At) {
+  flat_hash_map<int, int> map = {{1, 10}};
+  EXPECT_EQ(10, map.at(1));
+  std::as_const(map).at(1);
+  EXPECT_DEATH_IF_SUPPORTED(map.at(2), "");
+}
+
+TEST(FlatHashMap, InsertOrAssign) {
+  flat_hash_map<int, MoveOnlyInt> map;
+  auto result = map.insert_or_assign(1, MoveOnlyInt(10));
+  EXPECT_TRUE(result.second);
+  result = map.insert_or_assign(1, MoveOnlyInt(20));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(20, result.first->second.data());
+}
+
+TEST(FlatHashMap, TryEmplace) {
+  flat_hash_map<int, std::unique_ptr<int>> map;
+  EXPECT_TRUE(map.try_emplace(1, std::make_unique<int>(10)).second);
+  auto value = std::make_unique<int>(20);
+  // Doesn't move from the arguments if the key is already there.
+  EXPECT_FALSE(map.try_emplace(1, std::move(value)).second);
+  EXPECT_TRUE(value);
+  EXPECT_EQ(10, *map[1]);
+}
+
+TEST(FlatHashMap, HeterogeneousLookup) {
+  flat_hash_map<std::string, int> map = {{"a", 1}, {"bb", 2}};
+  const std::string_view key = "bb";
+  EXPECT_EQ(2, map.find(key)->second);
+  EXPECT_TRUE(map.contains("a"));
+  EXPECT_EQ(1u, map.count(std::string_view("a")));
+  EXPECT_EQ(1, map.at(std::string_view("a")));
+  EXPECT_EQ(1u, map.erase(key));
+  EXPECT_FALSE(map.contains(key));
+}
+
+TEST(FlatHashMap, GrowsAndKeepsElements) {
+  flat_hash_map<int, int> map;
+  for (int i = 0; i < 1000; ++i) {
+    map[i] = i * 2;
+    ASSERT_LE(map.size() * 8, map.capacity() * 7 + 16) << i;
+  }
+  EXPECT_EQ(1000u, map.size());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(i * 2, map.at(i));
+  }
+  EXPECT_FALSE(map.contains(1000));
+}
+
+TEST(FlatHashMap, Reserve) {
+  flat_hash_map<int, int> map;
+  map.reserve(100);
+  const size_t capacity = map.capacity();
+  EXPECT_GE(capacity, 100u);
+  for (int i = 0; i < 100; ++i) {
+    map[i] = i;
+  }
+  EXPECT_EQ(capacity, map.capacity());
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(capacity, map.capacity());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(FlatHashMap, CollisionsAndTombstones) {
+  flat_hash_map<int, int, CollidingHash> map;
+  for (int i = 0; i < 100; ++i) {
+    map[i] = i;
+  }
+  // Erasing from full groups leaves tombstones. The remaining elements must
+  // still be found past them.
+  for (int i = 0; i < 100; i += 2) {
+    EXPECT_EQ(1u, map.erase(i));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i % 2 == 1, map.contains(i)) << i;
+  }
+  // Churn at a constant size reuses tombstones rather than growing forever.
+  const size_t capacity = map.capacity();
+  for (int i = 100; i < 10000; ++i) {
+    map[i] = i;
+    map.erase(i - 100);
+  }
+  EXPECT_EQ(100u, map.size());
+  EXPECT_LE(map.capacity(), capacity * 2);
+}
+
+TEST(FlatHashMap, CopyAndMove) {
+  flat_hash_map<int, std::string> map;
+  for (int i = 0; i < 50; ++i) {
+    map[i] = std::string(i, 'x');
+  }
+
+  flat_hash_map<int, std::string> copy(map);
+  EXPECT_EQ(map, copy);
+
+  flat_hash_map<int, std::string> moved(std::move(copy));
+  EXPECT_EQ(map, moved);
+  EXPECT_TRUE(copy.empty());  // NOLINT(bugprone-use-after-move)
+
+  flat_hash_map<int, std::string> assigned;
+  assigned = map;
+  EXPECT_EQ(map, assigned);
+  assigned = {{1, "y"}};
+  EXPECT_THAT(assigned, UnorderedElementsAre(Pair(1, "y")));
+  assigned = std::move(moved);
+  EXPECT_EQ(map, assigned);
+
+  flat_hash_map<int, std::string> swapped;
+  swap(swapped, assigned);
+  EXPECT_EQ(map, swapped);
+  EXPECT_TRUE(assigned.empty());
+}
+
+TEST(FlatHashMap, EraseIf) {
+  flat_hash_map<int, int> map;
+  for (int i = 0; i < 100; ++i) {
+    map[i] = i;
+  }
+  EXPECT_EQ(50u, EraseIf(map, [](const auto& p) { return p.first % 2; }));
+  EXPECT_EQ(50u, map.size());
+  for (const auto& [key, value] : map) {
+    EXPECT_EQ(0, key % 2);
+  }
+}
+
+TEST(FlatHashMap, MatchesUnorderedMap) {
+  flat_hash_map<int, int> map;
+  std::unordered_map<int, int> expected;
+  for (int i = 0; i < 20000; ++i) {
+    const int key = RandInt(0, 2000);
+    switch (RandInt(0, 2)) {
+      case 0:
+        map[key] = i;
+        expected[key] = i;
+        break;
+      case 1:
+        EXPECT_EQ(expected.erase(key), map.erase(key));
+        break;
+      case 2:
+        EXPECT_EQ(expected.contains(key), map.contains(key));
+        break;
+    }
+  }
+  ASSERT_EQ(expected.size(), map.size());
+  for (const auto& [key, value] : expected) {
+    EXPECT_EQ(value, map.at(key));
+  }
+  EXPECT_EQ(expected.size(), static_cast<size_t>(std::distance(
+                                 map.begin(), map.end())));
+}
+
+}  // namespace base
@@ -0,0 +1,106 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_SET_H_
+#define BASE_CONTAINERS_FLAT_HASH_SET_H_
+
+#include <functional>
+
+#include "base/containers/flat_hash_table.h"
+
+namespace base {
+
+namespace internal {
+
+// The flat_hash_table GetKeyFromValue template parameter of flat_hash_set.
+struct FlatHashSetIdentity {
+  template <class T>
+  constexpr const T& operator()(const T& value) const {
+    return value;
+  }
+};
+
+}  // namespace internal
+
+// flat_hash_set is an unordered set with a std::unordered_set-like interface
+// that stores its elements inline in a single open-addressing hash table. See
+// flat_hash_table.h for how it works, and flat_hash_map.h for the trade-offs
+// against other sets.
+//
+// Please see //base/containers/README.md for an overview of which container
+// to select.
+//
+// IMPORTANT NOTES
+//
+//  - Elements move when the table grows, so pointers and references to them
+//    are invalidated by inserts (unlike std::unordered_set).
+//  - erase(iterator) returns nothing, and only invalidates iterators to the
+//    erased element. Use base::EraseIf() to erase elements while iterating.
+//
+// QUICK REFERENCE
+//
+// Constructors:
+//   flat_hash_set();
+//   flat_hash_set(const flat_hash_set&);
+//   flat_hash_set(flat_hash_set&&);
+//   flat_hash_set(InputIterator first, InputIterator last);
+//   flat_hash_set(std::initializer_list<value_type> ilist);
+//
+// Assignment functions:
+//   flat_hash_set& operator=(const flat_hash_set&);
+//   flat_hash_set& operator=(flat_hash_set&&);
+//   flat_hash_set& operator=(initializer_list<value_type>);
+//
+// Memory management functions:
+//   void   reserve(size_t);
+//   size_t capacity() const;
+//
+// Size management functions:
+//   void   clear();
+//   size_t size() const;
+//   bool   empty() const;
+//
+// Iterator functions:
+//   const_iterator begin() const;
+//   const_iterator cbegin() const;
+//   const_iterator end() const;
+//   const_iterator cend() const;
+//
+// Insert functions:
+//   pair<iterator, bool> insert(const value_type&);
+//   pair<iterator, bool> insert(value_type&&);
+//   void                 insert(InputIterator first, InputIterator last);
+//   pair<iterator, bool> emplace(Args&&...);
+//
+// Erase functions:
+//   void erase(const_iterator);
+//   template <class K> size_t erase(const K& key);
+//
+// Search functions:
+//   template <typename K> size_t         count(const K&) const;
+//   template <typename K> const_iterator find(const K&) const;
+//   template <typename K> bool           contains(const K&) const;
+//
+// General functions:
+//   void swap(flat_hash_set&);
+//
+// Non-member operators:
+//   bool operator==(const flat_hash_set&, const flat_hash_set);
+//   bool operator!=(const flat_hash_set&, const flat_hash_set);
+//
+// Elements can't be modified in place, so iterator is the same type as
+// const_iterator.
+template <class Key,
+          class Hash = internal::FlatHashDefaultHashT<Key>,
+          class KeyEqual = std::equal_to<>>
+using flat_hash_set =
+    ::base::internal::flat_hash_table<Key,
+                                               Key,
+                                               internal::FlatHashSetIdentity,
+                                               Hash,
+                                               KeyEqual>;
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_SET_H_
@@ -0,0 +1,76 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_set.h"
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "base/test/move_only_int.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// A flat_hash_set is an instantiation of flat_hash_table. The bulk of the
+// table's tests are in flat_hash_map_unittest.cc.
+
+using ::testing::UnorderedElementsAre;
+
+namespace base {
+
+namespace {
+
+struct MoveOnlyIntHash {
+  size_t operator()(const MoveOnlyInt& value) const {
+    return std::hash<int>()(value.data());
+  }
+};
+
+}  // namespace
+
+TEST(FlatHashSet, ElementsCantBeModified) {
+  using Set = flat_hash_set<int>;
+  static_assert(std::is_same_v<Set::iterator, Set::const_iterator>);
+  static_assert(std::is_same_v<decltype(*std::declval<Set&>().begin()),
+                               const int&>);
+}
+
+TEST(FlatHashSet, InsertFindErase) {
+  flat_hash_set<int> set = {1, 2, 3, 2};
+  EXPECT_THAT(set, UnorderedElementsAre(1, 2, 3));
+  EXPECT_FALSE(set.insert(2).second);
+  EXPECT_TRUE(set.emplace(4).second);
+  EXPECT_TRUE(set.contains(4));
+
+  set.erase(set.find(1));
+  EXPECT_EQ(1u, set.erase(2));
+  EXPECT_THAT(set, UnorderedElementsAre(3, 4));
+}
+
+TEST(FlatHashSet, MoveOnly) {
+  flat_hash_set<MoveOnlyInt, MoveOnlyIntHash> set;
+  for (int i = 0; i < 100; ++i) {
+    set.insert(MoveOnlyInt(i));
+  }
+  EXPECT_EQ(100u, set.size());
+  EXPECT_TRUE(set.contains(MoveOnlyInt(42)));
+}
+
+TEST(FlatHashSet, HeterogeneousLookup) {
+  flat_hash_set<std::string> set = {"foo", "bar"};
+  EXPECT_TRUE(set.contains(std::string_view("foo")));
+  EXPECT_TRUE(set.contains("bar"));
+  EXPECT_EQ(1u, set.erase(std::string_view("bar")));
+  EXPECT_THAT(set, UnorderedElementsAre("foo"));
+}
+
+TEST(FlatHashSet, EraseIf) {
+  flat_hash_set<int> set = {1, 2, 3, 4, 5};
+  EXPECT_EQ(2u, EraseIf(set, [](int x) { return x % 2 == 0; }));
+  EXPECT_THAT(set, UnorderedElementsAre(1, 3, 5));
+}
+
+}  // namespace base
@@ -0,0 +1,805 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifdef UNSAFE_BUFFERS_BUILD
+// TODO(crbug.com/40284755): Remove this and spanify to fix the errors.
+#pragma allow_unsafe_buffers
+#endif
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_TABLE_H_
+#define BASE_CONTAINERS_FLAT_HASH_TABLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "base/compiler_specific.h"
+#include "base/memory/raw_ptr_exclusion.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace base {
+namespace internal {
+
+// The implementation shared by base::flat_hash_map and base::flat_hash_set: an
+// open-addressing hash table in the style of Abseil's SwissTable.
+//
+// Elements are stored inline in one array of slots. A parallel array holds one
+// control byte per slot, which is either empty, deleted (a tombstone), or the
+// low 7 bits of the hash of the element in the slot. Lookups probe aligned
+// groups of 16 control bytes at a time, using SSE2 or NEON where available, so
+// most misses and hits touch one group of control bytes and at most one slot
+// that isn't the one being looked for.
+//
+// A lookup stops at the first group with an empty slot. Erasing an element
+// from a group that has no empty slot leaves a tombstone so that elements that
+// were placed in later groups can still be found; a group never gains an empty
+// slot once it has filled up, until the table is rehashed.
+
+inline constexpr int8_t kFlatHashCtrlEmpty = -128;
+inline constexpr int8_t kFlatHashCtrlDeleted = -2;
+// Marks the control bytes past the last slot. Iteration stops there.
+inline constexpr int8_t kFlatHashCtrlSentinel = -1;
+
+// A set of slots in a group, with one bit per slot (or 1 << kShift bits, of
+// which only the lowest may be set).
+template <typename T, int kShift>
+class FlatHashBitMask {
+ public:
+  explicit FlatHashBitMask(T mask) : mask_(mask) {}
+
+  bool any() const { return mask_ != 0; }
+  // Returns the index in the group of the first slot in the set.
+  size_t Lowest() const {
+    return static_cast<size_t>(std::countr_zero(mask_)) >> kShift;
+  }
+  void ClearLowest() { mask_ &= mask_ - 1; }
+
+ private:
+  T mask_;
+};
+
+// The 16 control bytes of a group.
+class FlatHashGroup {
+ public:
+  static constexpr size_t kWidth = 16;
+
+#if defined(__SSE2__)
+  using BitMask = FlatHashBitMask<uint32_t, 0>;
+
+  explicit FlatHashGroup(const int8_t* ctrl)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+  BitMask Match(int8_t h2) const {
+    return BitMask(static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(h2)))));
+  }
+  BitMask MatchEmpty() const {
+    return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(kFlatHashCtrlEmpty)))));
+  }
+  BitMask MatchEmptyOrDeleted() const {
+    return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpgt_epi8(_mm_set1_epi8(kFlatHashCtrlSentinel), ctrl_))));
+  }
+
+ private:
+  __m128i ctrl_;
+#elif defined(__ARM_NEON)
+  // NEON has no movemask instruction. Narrowing each 16-bit lane by 4 bits
+  // yields 4 bits per byte, of which the lowest is kept.
+  using BitMask = FlatHashBitMask<uint64_t, 2>;
+
+  explicit FlatHashGroup(const int8_t* ctrl) : ctrl_(vld1q_s8(ctrl)) {}
+
+  BitMask Match(int8_t h2) const {
+    return ToBitMask(vceqq_s8(ctrl_, vdupq_n_s8(h2)));
+  }
+  BitMask MatchEmpty() const {
+    return ToBitMask(vceqq_s8(ctrl_, vdupq_n_s8(kFlatHashCtrlEmpty)));
+  }
+  BitMask MatchEmptyOrDeleted() const {
+    return ToBitMask(vcltq_s8(ctrl_, vdupq_n_s8(kFlatHashCtrlSentinel)));
+  }
+
+ private:
+  static BitMask ToBitMask(uint8x16_t cmp) {
+    const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    return BitMask(vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) &
+                   0x1111111111111111ULL);
+  }
+
+  int8x16_t ctrl_;
+#else
+  using BitMask = FlatHashBitMask<uint32_t, 0>;
+
+  explicit FlatHashGroup(const int8_t* ctrl) { memcpy(ctrl_, ctrl, kWidth); }
+
+  BitMask Match(int8_t h2) const {
+    return MatchIf([h2](int8_t c) { return c == h2; });
+  }
+  BitMask MatchEmpty() const {
+    return MatchIf([](int8_t c) { return c == kFlatHashCtrlEmpty; });
+  }
+  BitMask MatchEmptyOrDeleted() const {
+    return MatchIf([](int8_t c) { return c < kFlatHashCtrlSentinel; });
+  }
+
+ private:
+  template <typename Predicate>
+  BitMask MatchIf(Predicate predicate) const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<uint32_t>(predicate(ctrl_[i])) << i;
+    }
+    return BitMask(mask);
+  }
+
+  int8_t ctrl_[kWidth];
+#endif
+};
+
+// Hashes strings through std::string_view, so that tables keyed by strings
+// can be searched with any string-like type without making a std::string.
+struct FlatHashStringHash {
+  using is_transparent = void;
+  size_t operator()(std::string_view str) const {
+    return std::hash<std::string_view>()(str);
+  }
+};
+
+template <typename Key>
+struct FlatHashDefaultHash {
+  using type = std::hash<Key>;
+};
+
+template <>
+struct FlatHashDefaultHash<std::string> {
+  using type = FlatHashStringHash;
+};
+
+template <typename Key>
+using FlatHashDefaultHashT = typename FlatHashDefaultHash<Key>::type;
+
+template <class Key,
+          class Value,
+          class GetKeyFromValue,
+          class Hash,
+          class KeyEqual>
+class flat_hash_table {
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+
+ private:
+  template <bool kIsConst>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename flat_hash_table::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer =
+        std::conditional_t<kIsConst, const value_type*, value_type*>;
+    using reference =
+        std::conditional_t<kIsConst, const value_type&, value_type&>;
+
+    Iterator() = default;
+    // Allow conversion from iterator to const_iterator.
+    template <bool kOtherIsConst>
+      requires(kIsConst && !kOtherIsConst)
+    Iterator(const Iterator<kOtherIsConst>& other)  // NOLINT
+        : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+    reference operator*() const {
+      DCHECK_GE(*ctrl_, 0);
+      return *slot_;
+    }
+    pointer operator->() const { return &**this; }
+
+    Iterator& operator++() {
+      ++ctrl_;
+      ++slot_;
+      SkipEmptyOrDeleted();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+      return lhs.ctrl_ == rhs.ctrl_;
+    }
+
+   private:
+    friend class flat_hash_table;
+    friend class Iterator<true>;
+
+    Iterator(const int8_t* ctrl, value_type* slot) : ctrl_(ctrl), slot_(slot) {
+      if (ctrl_) {
+        SkipEmptyOrDeleted();
+      }
+    }
+
+    static Iterator End(const int8_t* ctrl,
+                        value_type* slots,
+                        size_t capacity) {
+      Iterator it;
+      if (ctrl) {
+        it.ctrl_ = ctrl + capacity;
+        it.slot_ = slots + capacity;
+      }
+      return it;
+    }
+
+    void SkipEmptyOrDeleted() {
+      // The control bytes end with a sentinel, so this stops at end().
+      while (*ctrl_ < kFlatHashCtrlSentinel) {
+        ++ctrl_;
+        ++slot_;
+      }
+    }
+
+    // RAW_PTR_EXCLUSION: Iterators point into the table's allocation, and
+    // are incremented in tight loops.
+    RAW_PTR_EXCLUSION const int8_t* ctrl_ = nullptr;
+    RAW_PTR_EXCLUSION value_type* slot_ = nullptr;
+  };
+
+  static constexpr bool kIsTransparent = requires {
+    typename hasher::is_transparent;
+    typename key_equal::is_transparent;
+  };
+
+ public:
+  // Sets don't allow modifying their elements in place.
+  using iterator = std::conditional_t<std::is_same_v<key_type, value_type>,
+                                      Iterator<true>,
+                                      Iterator<false>>;
+  using const_iterator = Iterator<true>;
+
+  // --------------------------------------------------------------------------
+  // Lifetime.
+
+  flat_hash_table() = default;
+
+  template <class InputIterator>
+  flat_hash_table(InputIterator first, InputIterator last) {
+    insert(first, last);
+  }
+
+  flat_hash_table(std::initializer_list<value_type> ilist)
+      : flat_hash_table(ilist.begin(), ilist.end()) {}
+
+  flat_hash_table(const flat_hash_table& other)
+      : hash_(other.hash_), key_equal_(other.key_equal_) {
+    reserve(other.size());
+    for (const value_type& value : other) {
+      const size_t hash = HashOf(GetKeyFromValue()(value));
+      new (&slots_[PrepareInsert(hash)]) value_type(value);
+    }
+  }
+
+  flat_hash_table(flat_hash_table&& other) noexcept
+      : ctrl_(std::exchange(other.ctrl_, nullptr)),
+        slots_(std::exchange(other.slots_, nullptr)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        size_(std::exchange(other.size_, 0)),
+        growth_left_(std::exchange(other.growth_left_, 0)),
+        hash_(std::move(other.hash_)),
+        key_equal_(std::move(other.key_equal_)) {}
+
+  flat_hash_table& operator=(const flat_hash_table& other) {
+    if (this != &other) {
+      flat_hash_table copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  flat_hash_table& operator=(flat_hash_table&& other) noexcept {
+    flat_hash_table moved(std::move(other));
+    swap(moved);
+    return *this;
+  }
+
+  flat_hash_table& operator=(std::initializer_list<value_type> ilist) {
+    clear();
+    insert(ilist);
+    return *this;
+  }
+
+  ~flat_hash_table() {
+    DestroyElements();
+    Deallocate(ctrl_, capacity_);
+  }
+
+  // --------------------------------------------------------------------------
+  // Capacity.
+  //
+  // Assume that every operation invalidates iterators and references, except
+  // erase(), which only invalidates those to the erased element.
+
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  // Returns the number of slots. Up to 7/8 of them are used before the table
+  // grows.
+  size_type capacity() const { return capacity_; }
+
+  // Makes room for |new_size| elements without rehashing.
+  void reserve(size_type new_size) {
+    if (new_size > size_ + growth_left_) {
+      Resize(std::max(CapacityForSize(new_size), capacity_));
+    }
+  }
+
+  // Destroys all elements, and keeps the allocation.
+  void clear() {
+    DestroyElements();
+    size_ = 0;
+    if (capacity_) {
+      ResetCtrl(ctrl_, capacity_);
+      growth_left_ = MaxLoad(capacity_);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // Iterators.
+  //
+  // Iteration order is unspecified, and changes when the table is rehashed.
+
+  iterator begin() { return iterator(ctrl_, slots_); }
+  const_iterator begin() const { return const_iterator(ctrl_, slots_); }
+  const_iterator cbegin() const { return begin(); }
+  iterator end() { return iterator::End(ctrl_, slots_, capacity_); }
+  const_iterator end() const {
+    return const_iterator::End(ctrl_, slots_, capacity_);
+  }
+  const_iterator cend() const { return end(); }
+
+  // --------------------------------------------------------------------------
+  // Insert operations.
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return EmplaceKeyArgs(GetKeyFromValue()(value), value);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    const key_type& key = GetKeyFromValue()(value);
+    return EmplaceKeyArgs(key, std::move(value));
+  }
+
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                    typename std::iterator_traits<
+                                        InputIterator>::iterator_category>) {
+      reserve(size_ + static_cast<size_t>(std::distance(first, last)));
+    }
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  void insert(std::initializer_list<value_type> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  // Constructs the value first, so prefer insert() or try_emplace() where
+  // the key is at hand.
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  // --------------------------------------------------------------------------
+  // Erase operations.
+  //
+  // Erasing doesn't move other elements, so it only invalidates iterators
+  // and references to the erased element.
+
+  // Unlike the standard containers, returns nothing: finding the next element
+  // would make every erase as expensive as an iteration step. Use
+  // base::EraseIf() to erase while iterating.
+  void erase(const_iterator position) {
+    EraseAt(static_cast<size_t>(position.slot_ - slots_));
+  }
+  void erase(iterator position)
+    requires(!std::is_same_v<iterator, const_iterator>)
+  {
+    erase(const_iterator(position));
+  }
+
+  size_type erase(const key_type& key) { return EraseKey(key); }
+
+  template <typename K>
+    requires(kIsTransparent)
+  size_type erase(const K& key) {
+    return EraseKey(key);
+  }
+
+  // --------------------------------------------------------------------------
+  // Search operations.
+  //
+  // If both |hasher| and |key_equal| are transparent, e.g. for std::string
+  // keys with the default hasher, these also accept any type they can compare
+  // with keys.
+
+  iterator find(const key_type& key) { return IteratorAt(Find(key)); }
+  const_iterator find(const key_type& key) const {
+    return const_cast<flat_hash_table*>(this)->find(key);
+  }
+  template <typename K>
+    requires(kIsTransparent)
+  iterator find(const K& key) {
+    return IteratorAt(Find(key));
+  }
+  template <typename K>
+    requires(kIsTransparent)
+  const_iterator find(const K& key) const {
+    return const_cast<flat_hash_table*>(this)->find(key);
+  }
+
+  bool contains(const key_type& key) const { return Find(key) != kNotFound; }
+  template <typename K>
+    requires(kIsTransparent)
+  bool contains(const K& key) const {
+    return Find(key) != kNotFound;
+  }
+
+  size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+  template <typename K>
+    requires(kIsTransparent)
+  size_type count(const K& key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  // --------------------------------------------------------------------------
+  // General operations.
+
+  void swap(flat_hash_table& other) noexcept {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(hash_, other.hash_);
+    std::swap(key_equal_, other.key_equal_);
+  }
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return key_equal_; }
+
+  friend bool operator==(const flat_hash_table& lhs,
+                         const flat_hash_table& rhs) {
+    if (lhs.size() != rhs.size()) {
+      return false;
+    }
+    for (const value_type& value : lhs) {
+      auto it = rhs.find(GetKeyFromValue()(value));
+      if (it == rhs.end() || !(*it == value)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Returns the number of bytes allocated for a table with |capacity| slots.
+  // Only meant for memory usage estimation.
+  static size_t AllocationSizeForCapacity(size_t capacity) {
+    if (capacity == 0) {
+      return 0;
+    }
+    return SlotsOffset(capacity) + capacity * sizeof(value_type);
+  }
+
+ protected:
+  static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+  // Returns the index of the slot holding |key|, or kNotFound.
+  template <typename K>
+  size_t Find(const K& key) const {
+    if (size_ == 0) {
+      return kNotFound;
+    }
+    return FindWithHash(key, HashOf(key));
+  }
+
+  template <typename K>
+  size_t FindWithHash(const K& key, size_t hash) const {
+    const int8_t h2 = H2(hash);
+    const size_t group_mask = NumGroups(capacity_) - 1;
+    size_t group = H1(hash) & group_mask;
+    for (size_t probe = 1; probe <= group_mask + 1; ++probe) {
+      const size_t group_start = group * FlatHashGroup::kWidth;
+      const FlatHashGroup ctrl(ctrl_ + group_start);
+      for (auto match = ctrl.Match(h2); match.any(); match.ClearLowest()) {
+        const size_t index = group_start + match.Lowest();
+        if (key_equal_(GetKeyFromValue()(slots_[index]), key)) {
+          return index;
+        }
+      }
+      if (ctrl.MatchEmpty().any()) {
+        return kNotFound;
+      }
+      // Triangular probing visits every group once.
+      group = (group + probe) & group_mask;
+    }
+    return kNotFound;
+  }
+
+  // Constructs an element from |args| if there is none with |key|.
+  template <class K, class... Args>
+  std::pair<iterator, bool> EmplaceKeyArgs(const K& key, Args&&... args) {
+    const size_t hash = HashOf(key);
+    if (size_ != 0) {
+      const size_t index = FindWithHash(key, hash);
+      if (index != kNotFound) {
+        return {IteratorAt(index), false};
+      }
+    }
+    const size_t new_index = PrepareInsert(hash);
+    new (&slots_[new_index]) value_type(std::forward<Args>(args)...);
+    return {IteratorAt(new_index), true};
+  }
+
+  // Claims a slot for a new element with hash |hash|, which must not be in
+  // the table yet, and returns its index. The caller constructs the element.
+  size_t PrepareInsert(size_t hash) {
+    size_t index = FindInsertSlot(hash);
+    if (index == kNotFound ||
+        (ctrl_[index] == kFlatHashCtrlEmpty && growth_left_ == 0)) {
+      GrowOrReclaimTombstones();
+      index = FindInsertSlot(hash);
+      DCHECK_NE(index, kNotFound);
+    }
+    if (ctrl_[index] == kFlatHashCtrlEmpty) {
+      --growth_left_;
+    }
+    ctrl_[index] = H2(hash);
+    ++size_;
+    return index;
+  }
+
+  iterator IteratorAt(size_t index) {
+    if (index == kNotFound) {
+      return end();
+    }
+    return iterator(ctrl_ + index, slots_ + index);
+  }
+
+  template <typename K>
+  size_t HashOf(const K& key) const {
+    // Mix the bits, so that hashers that are the identity for integers still
+    // spread keys over groups and control bytes.
+    uint64_t hash = static_cast<uint64_t>(hash_(key));
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return static_cast<size_t>(hash);
+  }
+
+ private:
+  static_assert(alignof(value_type) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                "Over-aligned types are not supported");
+
+  static int8_t H2(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+  static size_t H1(size_t hash) { return hash >> 7; }
+
+  static size_t NumGroups(size_t capacity) {
+    return std::max<size_t>(1, capacity / FlatHashGroup::kWidth);
+  }
+
+  // Tables of up to one group can be filled completely, since a lookup never
+  // probes more than one group. Larger tables keep an eighth of their slots
+  // free, so that most probes stop at the first group.
+  static size_t MaxLoad(size_t capacity) {
+    return capacity < FlatHashGroup::kWidth ? capacity
+                                            : capacity - capacity / 8;
+  }
+
+  // Returns the smallest capacity that holds |size| elements. Capacities
+  // are powers of two.
+  static size_t CapacityForSize(size_t size) {
+    if (size == 0) {
+      return 0;
+    }
+    size_t capacity = std::bit_ceil(size);
+    while (MaxLoad(capacity) < size) {
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  // The control bytes of tables with less than a group of slots are padded
+  // with sentinels, so that a group can always be loaded. Larger tables have
+  // one sentinel after the last slot.
+  static size_t NumCtrlBytes(size_t capacity) {
+    return std::max(capacity + 1, FlatHashGroup::kWidth);
+  }
+
+  static size_t SlotsOffset(size_t capacity) {
+    const size_t alignment = alignof(value_type);
+    return (NumCtrlBytes(capacity) + alignment - 1) / alignment * alignment;
+  }
+
+  static void ResetCtrl(int8_t* ctrl, size_t capacity) {
+    memset(ctrl, kFlatHashCtrlEmpty, capacity);
+    memset(ctrl + capacity, kFlatHashCtrlSentinel,
+           NumCtrlBytes(capacity) - capacity);
+  }
+
+  static void Deallocate(int8_t* ctrl, size_t capacity) {
+    if (ctrl) {
+      ::operator delete(ctrl, AllocationSizeForCapacity(capacity));
+    }
+  }
+
+  // Returns the index of the first empty or deleted slot on the probe sequence
+  // of |hash|, or kNotFound if every slot is taken.
+  size_t FindInsertSlot(size_t hash) const {
+    if (capacity_ == 0) {
+      return kNotFound;
+    }
+    const size_t group_mask = NumGroups(capacity_) - 1;
+    size_t group = H1(hash) & group_mask;
+    for (size_t probe = 1; probe <= group_mask + 1; ++probe) {
+      const size_t group_start = group * FlatHashGroup::kWidth;
+      const auto free =
+          FlatHashGroup(ctrl_ + group_start).MatchEmptyOrDeleted();
+      if (free.any()) {
+        return group_start + free.Lowest();
+      }
+      group = (group + probe) & group_mask;
+    }
+    return kNotFound;
+  }
+
+  // Called when an insert would use up more than the maximum load. Rehashing
+  // at the same capacity drops tombstones, which is enough if a good part of
+  // the table is tombstones. Otherwise the table doubles, so that alternating
+  // inserts and erases don't rehash on every insert.
+  void GrowOrReclaimTombstones() {
+    if (capacity_ >= FlatHashGroup::kWidth &&
+        size_ + 1 <= MaxLoad(capacity_) * 25 / 32) {
+      Resize(capacity_);
+    } else {
+      Resize(std::max(CapacityForSize(size_ + 1), capacity_ * 2));
+    }
+  }
+
+  void Resize(size_t new_capacity) {
+    DCHECK_GE(MaxLoad(new_capacity), size_);
+    int8_t* const old_ctrl = ctrl_;
+    value_type* const old_slots = slots_;
+    const size_t old_capacity = capacity_;
+
+    ctrl_ = static_cast<int8_t*>(
+        ::operator new(AllocationSizeForCapacity(new_capacity)));
+    slots_ = reinterpret_cast<value_type*>(reinterpret_cast<char*>(ctrl_) +
+                                           SlotsOffset(new_capacity));
+    capacity_ = new_capacity;
+    growth_left_ = MaxLoad(new_capacity) - size_;
+    ResetCtrl(ctrl_, new_capacity);
+
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if (old_ctrl[i] < 0) {
+        continue;
+      }
+      const size_t hash = HashOf(GetKeyFromValue()(old_slots[i]));
+      const size_t index = FindInsertSlot(hash);
+      ctrl_[index] = H2(hash);
+      new (&slots_[index]) value_type(std::move(old_slots[i]));
+      old_slots[i].~value_type();
+    }
+    Deallocate(old_ctrl, old_capacity);
+  }
+
+  template <typename K>
+  size_type EraseKey(const K& key) {
+    const size_t index = Find(key);
+    if (index == kNotFound) {
+      return 0;
+    }
+    EraseAt(index);
+    return 1;
+  }
+
+  void EraseAt(size_t index) {
+    DCHECK_LT(index, capacity_);
+    DCHECK_GE(ctrl_[index], 0);
+    slots_[index].~value_type();
+    --size_;
+    // Lookups never probed past a group that has an empty slot, so the slot
+    // can be marked empty in that case.
+    const size_t group_start =
+        index / FlatHashGroup::kWidth * FlatHashGroup::kWidth;
+    if (FlatHashGroup(ctrl_ + group_start).MatchEmpty().any()) {
+      ctrl_[index] = kFlatHashCtrlEmpty;
+      ++growth_left_;
+    } else {
+      ctrl_[index] = kFlatHashCtrlDeleted;
+    }
+  }
+
+  void DestroyElements() {
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+      for (size_t i = 0; i < capacity_; ++i) {
+        if (ctrl_[i] >= 0) {
+          slots_[i].~value_type();
+        }
+      }
+    }
+  }
+
+  // RAW_PTR_EXCLUSION: |slots_| points into the same allocation as |ctrl_|,
+  // and both are dereferenced on every lookup.
+  RAW_PTR_EXCLUSION int8_t* ctrl_ = nullptr;
+  RAW_PTR_EXCLUSION value_type* slots_ = nullptr;
+  size_t capacity_ = 0;
+  size_t size_ = 0;
+  // The number of empty slots that inserts can still use before the table
+  // has to grow: the maximum load minus elements and tombstones.
+  size_t growth_left_ = 0;
+  NO_UNIQUE_ADDRESS hasher hash_;
+  NO_UNIQUE_ADDRESS key_equal key_equal_;
+};
+
+}  // namespace internal
+
+// Erases all elements that match predicate. It has O(capacity) complexity, and
+// doesn't move the remaining elements.
+template <class Key,
+          class Value,
+          class GetKeyFromValue,
+          class Hash,
+          class KeyEqual,
+          typename Predicate>
+size_t EraseIf(base::internal::flat_hash_table<Key,
+                                               Value,
+                                               GetKeyFromValue,
+                                               Hash,
+                                               KeyEqual>& container,
+               Predicate pred) {
+  size_t removed = 0;
+  for (auto it = container.begin(); it != container.end();) {
+    auto current = it++;
+    if (pred(*current)) {
+      container.erase(current);
+      ++removed;
+    }
+  }
+  return removed;
+}
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_TABLE_H_
@@ -0,0 +1,73 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/containers/fixed_lru_cache.h"
+#include "base/containers/lru_cache.h"
+#include "base/rand_util.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace base {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "LRUCache.";
+constexpr char kThroughput[] = "throughput";
+
+constexpr size_t kCacheSize = 1000;
+constexpr int kIterations = 1e6;
+
+// Keys are drawn from twice the cache size, so that about half of the lookups
+// miss and insert a new item, which evicts the least recently used one.
+std::vector<uint64_t> MakeKeys() {
+  std::vector<uint64_t> keys(kIterations);
+  for (uint64_t& key : keys) {
+    key = RandGenerator(2 * kCacheSize);
+  }
+  return keys;
+}
+
+template <class Cache>
+void RunGetOrPut(const char* story) {
+  const std::vector<uint64_t> keys = MakeKeys();
+  Cache cache(kCacheSize);
+  uint64_t checksum = 0;
+
+  auto before = TimeTicks::Now();
+  for (uint64_t key : keys) {
+    auto it = cache.Get(key);
+    if (it == cache.end()) {
+      it = cache.Put(key, key);
+    }
+    checksum += it->second;
+  }
+  auto after = TimeTicks::Now();
+
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kThroughput, "ns / iteration");
+  reporter.AddResult(kThroughput,
+                     static_cast<size_t>((after - before).InNanoseconds() /
+                                         kIterations));
+  EXPECT_EQ(kCacheSize, cache.size());
+  EXPECT_NE(0u, checksum);
+}
+
+}  // namespace
+
+TEST(LRUCachePerfTest, HashingLRUCacheGetOrPut) {
+  RunGetOrPut<HashingLRUCache<uint64_t, uint64_t>>("HashingLRUCacheGetOrPut");
+}
+
+TEST(LRUCachePerfTest, FixedHashingLRUCacheGetOrPut) {
+  RunGetOrPut<FixedHashingLRUCache<uint64_t, uint64_t>>(
+      "FixedHashingLRUCacheGetOrPut");
+}
+
+}  // namespace base
@@ -11,6 +11,31 @@
 
 namespace base::debug::tracer {
 
+namespace {
+
+constexpr StackTraceContainer kEmptyStackTrace = {};
+
+}  // namespace
+
+const StackTraceContainer& StackTraceTable::GetStackTrace(
+    uint32_t index) const {
+  if (index >= entries_.size()) {
+    return kEmptyStackTrace;
+  }
+
+  const Entry& entry = entries_[index];
+  const uint32_t state = entry.state.load(std::memory_order_acquire);
+  if (state == kEmpty || state == kWriting) {
+    return kEmptyStackTrace;
+  }
+
+  return entry.stack_trace;
+}
+
+size_t StackTraceTable::size() const {
+  return size_.load(std::memory_order_relaxed);
+}
+
 bool OperationRecord::IsRecording() const {
   if (is_recording_.test_and_set()) {
     return true;
@@ -32,9 +57,15 @@ size_t OperationRecord::GetSize() const {
   return size_;
 }
 
+#if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_STACK_DEDUPLICATION)
+uint32_t OperationRecord::GetStackTraceIndex() const {
+  return stack_trace_index_;
+}
+#else
 const StackTraceContainer& OperationRecord::GetStackTrace() const {
   return stack_trace_;
 }
+#endif
 
 #if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_FULL_REPORTING)
 AllocationTraceRecorderStatistics::AllocationTraceRecorderStatistics(
@@ -54,8 +85,13 @@ void AllocationTraceRecorder::OnAllocation(const void* allocated_address,
   // due to the slot already being in-use by another
   // OperationRecord::Initialize*() call from another thread.
   for (auto index = GetNextIndex();
+#if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_STACK_DEDUPLICATION)
+       !alloc_trace_buffer_[index].InitializeAllocation(
+           allocated_address, allocated_size, stack_traces_);
+#else
        !alloc_trace_buffer_[index].InitializeAllocation(allocated_address,
                                                         allocated_size);
+#endif
        index = GetNextIndex()) {
 #if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_FULL_REPORTING)
     total_number_of_collisions_.fetch_add(1, std::memory_order_relaxed);
@@ -68,7 +104,11 @@ void AllocationTraceRecorder::OnFree(const void* freed_address) {
   // the slot already being in-use by another OperationRecord::Initialize*()
   // call from another thread.
   for (auto index = GetNextIndex();
+#if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_STACK_DEDUPLICATION)
+       !alloc_trace_buffer_[index].InitializeFree(freed_address, stack_traces_);
+#else
        !alloc_trace_buffer_[index].InitializeFree(freed_address);
+#endif
        index = GetNextIndex()) {
 #if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_FULL_REPORTING)
     total_number_of_collisions_.fetch_add(1, std::memory_order_relaxed);
@@ -95,6 +135,15 @@ const OperationRecord& AllocationTraceRecorder::operator[](size_t idx) const {
   return alloc_trace_buffer_[array_index];
 }
 
+const StackTraceContainer& AllocationTraceRecorder::GetStackTrace(
+    const OperationRecord& record) const {
+#if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_STACK_DEDUPLICATION)
+  return stack_traces_.GetStackTrace(record.GetStackTraceIndex());
+#else
+  return record.GetStackTrace();
+#endif
+}
+
 AllocationTraceRecorderStatistics
 AllocationTraceRecorder::GetRecorderStatistics() const {
 #if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_FULL_REPORTING)
@@ -10,6 +10,7 @@
 #include <atomic>
 #include <bit>
 #include <cstdint>
+#include <limits>
 
 #include "base/allocator/dispatcher/notification_data.h"
 #include "base/base_export.h"
@@ -29,6 +30,10 @@ constexpr size_t kMaximumNumberOfMemoryOperationTraces = (1 << 15);
 // increase chances of having a meaningful trace of the path that caused the
 // allocation or free.
 constexpr size_t kStackTraceSize = 16;
+// Number of distinct stack traces that can be stored when stack trace
+// deduplication is enabled. This number must be a power of two to allow for
+// fast computation of modulo.
+constexpr size_t kMaximumNumberOfStackTraces = (1 << 12);
 
 // The type of an operation stored in the recorder.
 enum class OperationType {
@@ -43,6 +48,123 @@ enum class OperationType {
 
 using StackTraceContainer = std::array<const void*, kStackTraceSize>;
 
+// Captures the stack trace of the calling thread into |stack_trace|. Declared
+// ALWAYS_INLINE so the number of frames of the recorder in the trace is fixed.
+ALWAYS_INLINE void CaptureStackTrace(StackTraceContainer& stack_trace) {
+  stack_trace.fill(nullptr);
+
+#if BUILDFLAG(CAN_UNWIND_WITH_FRAME_POINTERS)
+  // Currently we limit ourselves to use TraceStackFramePointers. We know that
+  // TraceStackFramePointers has an acceptable performance impact on Android.
+  base::debug::TraceStackFramePointers(&stack_trace[0], stack_trace.size(), 0);
+#elif BUILDFLAG(IS_LINUX)
+  // Use base::debug::CollectStackTrace as an alternative for tests on Linux. We
+  // still have a check in /base/debug/debug.gni to prevent that
+  // AllocationStackTraceRecorder is enabled accidentally on Linux.
+  base::debug::CollectStackTrace(&stack_trace[0], stack_trace.size());
+#else
+#error "No supported stack tracer found."
+#endif
+}
+
+// A table holding each distinct stack trace once. Memory operations originate
+// from a comparatively small number of call sites, so records referring to
+// their stack trace by index are much smaller than records holding a copy of
+// it, and more of them fit into the same amount of memory.
+//
+// Like the recorder, the table lives in a preallocated buffer of compile time
+// constant size, see |kMaximumNumberOfStackTraces|, and must not hold any
+// references to external data since its memory image is copied into the
+// crash-handler. Entries are never removed. If the table is full, or all the
+// slots probed for a new trace are taken, the trace is dropped.
+//
+// Insertions are lock free. Two threads concurrently inserting the same new
+// trace may both add it, which wastes a slot but is otherwise harmless.
+class BASE_EXPORT StackTraceTable {
+ public:
+  // The index returned for traces which could not be stored.
+  static constexpr uint32_t kInvalidIndex =
+      std::numeric_limits<uint32_t>::max();
+
+  constexpr StackTraceTable() = default;
+
+  StackTraceTable(const StackTraceTable&) = delete;
+  StackTraceTable& operator=(const StackTraceTable&) = delete;
+
+  // Return the index of |stack_trace| in the table, adding it if it is not
+  // present yet. Returns |kInvalidIndex| if it could not be added.
+  ALWAYS_INLINE uint32_t Insert(const StackTraceContainer& stack_trace);
+
+  // Get the stack trace stored at |index|. Returns an empty trace for
+  // |kInvalidIndex|, or if the entry has not been fully written, e.g. because
+  // the process crashed while writing it.
+  const StackTraceContainer& GetStackTrace(uint32_t index) const;
+
+  // Get the number of distinct stack traces stored in the table.
+  size_t size() const;
+
+ private:
+  // Values of |Entry::state| other than the hash of the stored trace. Hashes
+  // are adjusted to never collide with these.
+  static constexpr uint32_t kEmpty = 0;
+  static constexpr uint32_t kWriting = 1;
+  // The number of slots probed for a trace before giving up.
+  static constexpr size_t kMaximumNumberOfProbes = 16;
+
+  struct Entry {
+    std::atomic<uint32_t> state = kEmpty;
+    StackTraceContainer stack_trace = {};
+  };
+
+  ALWAYS_INLINE static uint32_t Hash(const StackTraceContainer& stack_trace);
+
+  std::array<Entry, kMaximumNumberOfStackTraces> entries_ = {};
+  std::atomic<size_t> size_ = 0;
+};
+
+ALWAYS_INLINE uint32_t
+StackTraceTable::Insert(const StackTraceContainer& stack_trace) {
+  static_assert(std::has_single_bit(kMaximumNumberOfStackTraces),
+                "kMaximumNumberOfStackTraces should be a power of 2 to allow "
+                "for fast modulo operation.");
+
+  const uint32_t hash = Hash(stack_trace);
+  for (size_t probe = 0; probe < kMaximumNumberOfProbes; ++probe) {
+    const size_t index = (hash + probe) % kMaximumNumberOfStackTraces;
+    Entry& entry = entries_[index];
+
+    uint32_t state = entry.state.load(std::memory_order_acquire);
+    if (state == kEmpty) {
+      if (entry.state.compare_exchange_strong(state, kWriting,
+                                              std::memory_order_acquire,
+                                              std::memory_order_acquire)) {
+        entry.stack_trace = stack_trace;
+        entry.state.store(hash, std::memory_order_release);
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return static_cast<uint32_t>(index);
+      }
+      // Another thread took the slot first, and |state| now holds the value it
+      // stored. It may have been adding the very same trace.
+    }
+
+    if (state == hash && entry.stack_trace == stack_trace) {
+      return static_cast<uint32_t>(index);
+    }
+  }
+
+  return kInvalidIndex;
+}
+
+ALWAYS_INLINE uint32_t
+StackTraceTable::Hash(const StackTraceContainer& stack_trace) {
+  uint64_t hash = 0;
+  for (const void* frame : stack_trace) {
+    hash = (hash ^ reinterpret_cast<uintptr_t>(frame)) * 0x9E3779B97F4A7C15ull;
+  }
+  const uint32_t result = static_cast<uint32_t>(hash >> 32);
+  return result > kWriting ? result : result + kWriting + 1;
+}
+
 // The record for a single operation. A record can represent any type of
 // operation, allocation or free, but not at the same time.
 //
@@ -65,8 +187,14 @@ class BASE_EXPORT OperationRecord {
   const void* GetAddress() const;
   // Number of allocated bytes. Returns 0 for free operations.
   size_t GetSize() const;
+#if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_STACK_DEDUPLICATION)
+  // The index of the stack trace taken by the Initialize*-functions in the
+  // StackTraceTable passed to them.
+  uint32_t GetStackTraceIndex() const;
+#else
   // The stacktrace as taken by the Initialize*-functions.
   const StackTraceContainer& GetStackTrace() const;
+#endif
 
   // Initialize the record with data for another operation. Data from any
   // previous operation will be silently overwritten. These functions are
@@ -74,6 +202,20 @@ class BASE_EXPORT OperationRecord {
   //
   // Both functions return false in case no record was taken, i.e. if another
   // thread is capturing.
+#if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_STACK_DEDUPLICATION)
+  ALWAYS_INLINE bool InitializeFree(const void* freed_address,
+                                    StackTraceTable& stack_traces) {
+    return InitializeOperationRecord(freed_address, 0, OperationType::kFree,
+                                     stack_traces);
+  }
+
+  ALWAYS_INLINE bool InitializeAllocation(const void* allocated_address,
+                                          size_t allocated_size,
+                                          StackTraceTable& stack_traces) {
+    return InitializeOperationRecord(allocated_address, allocated_size,
+                                     OperationType::kAllocation, stack_traces);
+  }
+#else
   ALWAYS_INLINE bool InitializeFree(const void* freed_address) {
     return InitializeOperationRecord(freed_address, 0, OperationType::kFree);
   }
@@ -83,11 +225,22 @@ class BASE_EXPORT OperationRecord {
     return InitializeOperationRecord(allocated_address, allocated_size,
                                      OperationType::kAllocation);
   }
+#endif
 
  private:
   // Initialize a record with the given data. Return true if the record was
   // initialized successfully, false if no record was taken, i.e. if another
   // thread is capturing.
+#if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_STACK_DEDUPLICATION)
+  ALWAYS_INLINE bool InitializeOperationRecord(const void* address,
+                                               size_t size,
+                                               OperationType operation_type,
+                                               StackTraceTable& stack_traces);
+  ALWAYS_INLINE void StoreStackTrace(StackTraceTable& stack_traces);
+
+  // The index of the stack trace taken in one of the Initialize* functions.
+  uint32_t stack_trace_index_ = StackTraceTable::kInvalidIndex;
+#else
   ALWAYS_INLINE bool InitializeOperationRecord(const void* address,
                                                size_t size,
                                                OperationType operation_type);
@@ -95,6 +248,7 @@ class BASE_EXPORT OperationRecord {
 
   // The stack trace taken in one of the Initialize* functions.
   StackTraceContainer stack_trace_ = {};
+#endif
   // The number of allocated bytes.
   size_t size_ = 0;
   // The address that was allocated or freed.
@@ -122,6 +276,33 @@ class BASE_EXPORT OperationRecord {
   mutable std::atomic_flag is_recording_ = ATOMIC_FLAG_INIT;
 };
 
+#if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_STACK_DEDUPLICATION)
+ALWAYS_INLINE bool OperationRecord::InitializeOperationRecord(
+    const void* address,
+    size_t size,
+    OperationType operation_type,
+    StackTraceTable& stack_traces) {
+  if (is_recording_.test_and_set(std::memory_order_acquire)) {
+    return false;
+  }
+
+  operation_type_ = operation_type;
+  StoreStackTrace(stack_traces);
+  address_ = address;
+  size_ = size;
+
+  is_recording_.clear(std::memory_order_release);
+
+  return true;
+}
+
+ALWAYS_INLINE void OperationRecord::StoreStackTrace(
+    StackTraceTable& stack_traces) {
+  StackTraceContainer stack_trace;
+  CaptureStackTrace(stack_trace);
+  stack_trace_index_ = stack_traces.Insert(stack_trace);
+}
+#else
 ALWAYS_INLINE bool OperationRecord::InitializeOperationRecord(
     const void* address,
     size_t size,
@@ -141,22 +322,9 @@ ALWAYS_INLINE bool OperationRecord::InitializeOperationRecord(
 }
 
 ALWAYS_INLINE void OperationRecord::StoreStackTrace() {
-  stack_trace_.fill(nullptr);
-
-#if BUILDFLAG(CAN_UNWIND_WITH_FRAME_POINTERS)
-  // Currently we limit ourselves to use TraceStackFramePointers. We know that
-  // TraceStackFramePointers has an acceptable performance impact on Android.
-  base::debug::TraceStackFramePointers(&stack_trace_[0], stack_trace_.size(),
-                                       0);
-#elif BUILDFLAG(IS_LINUX)
-  // Use base::debug::CollectStackTrace as an alternative for tests on Linux. We
-  // still have a check in /base/debug/debug.gni to prevent that
-  // AllocationStackTraceRecorder is enabled accidentally on Linux.
-  base::debug::CollectStackTrace(&stack_trace_[0], stack_trace_.size());
-#else
-#error "No supported stack tracer found."
-#endif
+  CaptureStackTrace(stack_trace_);
 }
+#endif
 
 struct BASE_EXPORT AllocationTraceRecorderStatistics {
 #if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_FULL_REPORTING)
@@ -187,6 +355,9 @@ struct BASE_EXPORT AllocationTraceRecorderStatistics {
 // Therefore, records are stored in a preallocated buffer with a compile time
 // constant maximum size, see |kMaximumNumberOfMemoryOperationTraces|. Once all
 // records have been used, old records will be overwritten (fifo-style).
+// With ENABLE_ALLOCATION_TRACE_RECORDER_STACK_DEDUPLICATION, the records refer
+// to their stack trace in a StackTraceTable held by the recorder, see
+// |GetStackTrace()|.
 //
 // The recorder works in an multithreaded environment without external locking.
 // Concurrent writes are prevented by two means:
@@ -239,6 +410,9 @@ class BASE_EXPORT AllocationTraceRecorder {
   // especially the last records might be corrupted.
   const OperationRecord& operator[](size_t idx) const;
 
+  // Get the stack trace of a record returned by operator[].
+  const StackTraceContainer& GetStackTrace(const OperationRecord& record) const;
+
   constexpr size_t GetMaximumNumberOfTraces() const {
     return kMaximumNumberOfMemoryOperationTraces;
   }
@@ -260,6 +434,10 @@ class BASE_EXPORT AllocationTraceRecorder {
   // The actual container.
   std::array<OperationRecord, kMaximumNumberOfMemoryOperationTraces>
       alloc_trace_buffer_ = {};
+#if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_STACK_DEDUPLICATION)
+  // The stack traces referred to by the records.
+  StackTraceTable stack_traces_;
+#endif
   // The total number of records that have been taken so far. Note that this
   // might be greater than |kMaximumNumberOfMemoryOperationTraces| since we
   // overwrite oldest items.
@@ -18,6 +18,7 @@
 
 #include "base/allocator/dispatcher/dispatcher.h"
 #include "base/allocator/dispatcher/testing/tools.h"
+#include "base/debug/debugging_buildflags.h"
 #include "base/debug/stack_trace.h"
 #include "partition_alloc/partition_alloc_allocation_data.h"
 #include "partition_alloc/partition_alloc_config.h"
@@ -57,12 +58,16 @@ std::string MakeString(const C& data) {
   return MakeString(std::begin(data), std::end(data));
 }
 
-void AreEqual(const base::debug::tracer::OperationRecord& expected,
-              const base::debug::tracer::OperationRecord& is) {
+void AreEqual(const AllocationTraceRecorder& expected_recorder,
+              const AllocationTraceRecorder& is_recorder,
+              size_t index) {
+  const OperationRecord& expected = expected_recorder[index];
+  const OperationRecord& is = is_recorder[index];
   EXPECT_EQ(is.GetOperationType(), expected.GetOperationType());
   EXPECT_EQ(is.GetAddress(), expected.GetAddress());
   EXPECT_EQ(is.GetSize(), expected.GetSize());
-  EXPECT_THAT(is.GetStackTrace(), ContainerEq(expected.GetStackTrace()));
+  EXPECT_THAT(is_recorder.GetStackTrace(is),
+              ContainerEq(expected_recorder.GetStackTrace(expected)));
 }
 
 }  // namespace
@@ -143,7 +148,7 @@ TEST_F(AllocationTraceRecorderTest, VerifyBinaryCopy) {
 
   for (size_t index = 0; index < subject_under_test.size(); ++index) {
     SCOPED_TRACE(Message("difference detected at index ") << index);
-    AreEqual(subject_under_test[index], (*buffered_recorder)[index]);
+    AreEqual(subject_under_test, *buffered_recorder, index);
   }
 }
 
@@ -156,7 +161,7 @@ TEST_F(AllocationTraceRecorderTest, VerifySingleAllocation) {
   EXPECT_EQ(1ul, subject_under_test.size());
 
   const auto& record_data = subject_under_test[0];
-  const auto& stack_trace = record_data.GetStackTrace();
+  const auto& stack_trace = subject_under_test.GetStackTrace(record_data);
 
   EXPECT_EQ(OperationType::kAllocation, record_data.GetOperationType());
   EXPECT_EQ(&subject_under_test, record_data.GetAddress());
@@ -172,7 +177,7 @@ TEST_F(AllocationTraceRecorderTest, VerifySingleFree) {
   EXPECT_EQ(1ul, subject_under_test.size());
 
   const auto& record_data = subject_under_test[0];
-  const auto& stack_trace = record_data.GetStackTrace();
+  const auto& stack_trace = subject_under_test.GetStackTrace(record_data);
 
   EXPECT_EQ(OperationType::kFree, record_data.GetOperationType());
   EXPECT_EQ(&subject_under_test, record_data.GetAddress());
@@ -202,42 +207,42 @@ TEST_F(AllocationTraceRecorderTest, VerifyMultipleOperations) {
     ASSERT_EQ(entry.GetOperationType(), OperationType::kAllocation);
     ASSERT_EQ(entry.GetAddress(), this);
     ASSERT_EQ(entry.GetSize(), 1 * sizeof(*this));
-    ASSERT_NE(entry.GetStackTrace()[0], nullptr);
+    ASSERT_NE(subject_under_test.GetStackTrace(entry)[0], nullptr);
   }
   {
     const auto& entry = subject_under_test[1];
     ASSERT_EQ(entry.GetOperationType(), OperationType::kFree);
     ASSERT_EQ(entry.GetAddress(), (this + 2));
     ASSERT_EQ(entry.GetSize(), 0ul);
-    ASSERT_NE(entry.GetStackTrace()[0], nullptr);
+    ASSERT_NE(subject_under_test.GetStackTrace(entry)[0], nullptr);
   }
   {
     const auto& entry = subject_under_test[2];
     ASSERT_EQ(entry.GetOperationType(), OperationType::kAllocation);
     ASSERT_EQ(entry.GetAddress(), (this + 3));
     ASSERT_EQ(entry.GetSize(), 3 * sizeof(*this));
-    ASSERT_NE(entry.GetStackTrace()[0], nullptr);
+    ASSERT_NE(subject_under_test.GetStackTrace(entry)[0], nullptr);
   }
   {
     const auto& entry = subject_under_test[3];
     ASSERT_EQ(entry.GetOperationType(), OperationType::kAllocation);
     ASSERT_EQ(entry.GetAddress(), (this + 4));
     ASSERT_EQ(entry.GetSize(), 4 * sizeof(*this));
-    ASSERT_NE(entry.GetStackTrace()[0], nullptr);
+    ASSERT_NE(subject_under_test.GetStackTrace(entry)[0], nullptr);
   }
   {
     const auto& entry = subject_under_test[4];
     ASSERT_EQ(entry.GetOperationType(), OperationType::kFree);
     ASSERT_EQ(entry.GetAddress(), (this + 5));
     ASSERT_EQ(entry.GetSize(), 0ul);
-    ASSERT_NE(entry.GetStackTrace()[0], nullptr);
+    ASSERT_NE(subject_under_test.GetStackTrace(entry)[0], nullptr);
   }
   {
     const auto& entry = subject_under_test[5];
     ASSERT_EQ(entry.GetOperationType(), OperationType::kFree);
     ASSERT_EQ(entry.GetAddress(), (this + 6));
     ASSERT_EQ(entry.GetSize(), 0ul);
-    ASSERT_NE(entry.GetStackTrace()[0], nullptr);
+    ASSERT_NE(subject_under_test.GetStackTrace(entry)[0], nullptr);
   }
 }
 
@@ -266,7 +271,7 @@ TEST_F(AllocationTraceRecorderTest, VerifyOverflowOfOperations) {
         ASSERT_EQ(last_entry.GetAddress(), (this + idx));
         // No full verification intended, just a check that something has been
         // written.
-        ASSERT_NE(last_entry.GetStackTrace()[0], nullptr);
+        ASSERT_NE(subject_under_test.GetStackTrace(last_entry)[0], nullptr);
         if (is_allocation) {
           ASSERT_EQ(last_entry.GetOperationType(), OperationType::kAllocation);
           ASSERT_EQ(last_entry.GetSize(), idx);
@@ -333,6 +338,13 @@ class OperationRecordTest : public Test {
  protected:
   using ReferenceStackTrace = std::vector<const void*>;
 
+#if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_STACK_DEDUPLICATION)
+  // The table the records under test store their stack traces in. It's quite
+  // large, so we create it on heap.
+  const std::unique_ptr<StackTraceTable> stack_traces_ =
+      std::make_unique<StackTraceTable>();
+#endif
+
   ReferenceStackTrace GetReferenceTrace() {
     constexpr size_t max_trace_size = 128;
     const void* frame_pointers[max_trace_size]{nullptr};
@@ -421,14 +433,22 @@ TEST_F(OperationRecordTest, VerifyRecordAllocation) {
 
   OperationRecord subject_under_test;
 
+#if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_STACK_DEDUPLICATION)
+  ASSERT_TRUE(
+      subject_under_test.InitializeAllocation(address, size, *stack_traces_));
+  const StackTraceContainer& stack_trace =
+      stack_traces_->GetStackTrace(subject_under_test.GetStackTraceIndex());
+#else
   ASSERT_TRUE(subject_under_test.InitializeAllocation(address, size));
+  const StackTraceContainer& stack_trace = subject_under_test.GetStackTrace();
+#endif
 
   EXPECT_EQ(OperationType::kAllocation, subject_under_test.GetOperationType());
   EXPECT_EQ(address, subject_under_test.GetAddress());
   EXPECT_EQ(size, subject_under_test.GetSize());
   EXPECT_FALSE(subject_under_test.IsRecording());
 
-  VerifyStackTrace(reference_trace, subject_under_test.GetStackTrace());
+  VerifyStackTrace(reference_trace, stack_trace);
 }
 
 TEST_F(OperationRecordTest, VerifyRecordFree) {
@@ -439,14 +459,92 @@ TEST_F(OperationRecordTest, VerifyRecordFree) {
 
   OperationRecord subject_under_test;
 
+#if BUILDFLAG(ENABLE_ALLOCATION_TRACE_RECORDER_STACK_DEDUPLICATION)
+  ASSERT_TRUE(subject_under_test.InitializeFree(address, *stack_traces_));
+  const StackTraceContainer& stack_trace =
+      stack_traces_->GetStackTrace(subject_under_test.GetStackTraceIndex());
+#else
   ASSERT_TRUE(subject_under_test.InitializeFree(address));
+  const StackTraceContainer& stack_trace = subject_under_test.GetStackTrace();
+#endif
 
   EXPECT_EQ(OperationType::kFree, subject_under_test.GetOperationType());
   EXPECT_EQ(address, subject_under_test.GetAddress());
   EXPECT_EQ(size, subject_under_test.GetSize());
   EXPECT_FALSE(subject_under_test.IsRecording());
 
-  VerifyStackTrace(reference_trace, subject_under_test.GetStackTrace());
+  VerifyStackTrace(reference_trace, stack_trace);
+}
+
+class StackTraceTableTest : public Test {
+ protected:
+  StackTraceTable& GetSubjectUnderTest() const { return *subject_under_test_; }
+
+  static StackTraceContainer CreateStackTrace(uintptr_t seed) {
+    StackTraceContainer stack_trace = {};
+    for (size_t index = 0; index < 4; ++index) {
+      stack_trace[index] = reinterpret_cast<const void*>(seed * 16 + index);
+    }
+    return stack_trace;
+  }
+
+ private:
+  // Like the recorder, the table requires quite a lot of space.
+  const std::unique_ptr<StackTraceTable> subject_under_test_ =
+      std::make_unique<StackTraceTable>();
+};
+
+TEST_F(StackTraceTableTest, VerifyInsert) {
+  StackTraceTable& subject_under_test = GetSubjectUnderTest();
+  EXPECT_EQ(0ul, subject_under_test.size());
+
+  const StackTraceContainer first = CreateStackTrace(1);
+  const StackTraceContainer second = CreateStackTrace(2);
+
+  const uint32_t first_index = subject_under_test.Insert(first);
+  const uint32_t second_index = subject_under_test.Insert(second);
+  ASSERT_NE(StackTraceTable::kInvalidIndex, first_index);
+  ASSERT_NE(StackTraceTable::kInvalidIndex, second_index);
+  EXPECT_NE(first_index, second_index);
+
+  // Inserting a known trace yields the existing entry.
+  EXPECT_EQ(first_index, subject_under_test.Insert(first));
+  EXPECT_EQ(2ul, subject_under_test.size());
+
+  EXPECT_THAT(subject_under_test.GetStackTrace(first_index),
+              ContainerEq(first));
+  EXPECT_THAT(subject_under_test.GetStackTrace(second_index),
+              ContainerEq(second));
+}
+
+TEST_F(StackTraceTableTest, VerifyInvalidIndex) {
+  StackTraceTable& subject_under_test = GetSubjectUnderTest();
+  const StackTraceContainer empty_stack_trace = {};
+
+  EXPECT_THAT(
+      subject_under_test.GetStackTrace(StackTraceTable::kInvalidIndex),
+      ContainerEq(empty_stack_trace));
+  // An entry which has not been written.
+  EXPECT_THAT(subject_under_test.GetStackTrace(0),
+              ContainerEq(empty_stack_trace));
+}
+
+TEST_F(StackTraceTableTest, VerifyOverflow) {
+  StackTraceTable& subject_under_test = GetSubjectUnderTest();
+
+  // Insert more distinct traces than fit. Once the table is full, new traces
+  // are dropped, but the stored ones remain accessible.
+  for (uintptr_t seed = 1; seed <= 2 * kMaximumNumberOfStackTraces; ++seed) {
+    const StackTraceContainer stack_trace = CreateStackTrace(seed);
+    const uint32_t index = subject_under_test.Insert(stack_trace);
+    if (index != StackTraceTable::kInvalidIndex) {
+      ASSERT_THAT(subject_under_test.GetStackTrace(index),
+                  ContainerEq(stack_trace));
+    }
+  }
+
+  EXPECT_LE(subject_under_test.size(), kMaximumNumberOfStackTraces);
+  EXPECT_GT(subject_under_test.size(), kMaximumNumberOfStackTraces / 2);
 }
 
 }  // namespace base::debug::tracer
@@ -39,6 +39,12 @@ BASE_FEATURE(kEnforceNoExecutableFileHandles,
              "EnforceNoExecutableFileHandles",
              FEATURE_ENABLED_BY_DEFAULT);
 
+// Makes the C++ JSON parser skip runs of plain string contents and blanks with
+// vectorized scans instead of byte by byte.
+BASE_FEATURE(kJsonParserVectorizedScan,
+             "JsonParserVectorizedScan",
+             FEATURE_DISABLED_BY_DEFAULT);
+
 // TODO(crbug.com/40580068): Roll out this to 100% before replacing existing
 // NOTREACHED_IN_MIGRATION()s with NOTREACHED_NORETURN() as part of
 // NOTREACHED_IN_MIGRATION() migration. Note that a prerequisite for rolling out
@@ -89,6 +95,14 @@ BASE_FEATURE(kCollectAndroidFrameTimelineMetrics,
              FEATURE_DISABLED_BY_DEFAULT);
 #endif  // BUILDFLAG(IS_ANDROID)
 
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+// Runs FileProxy reads, writes and flushes with io_uring, when available,
+// rather than as blocking calls on the FileProxy's task runner.
+BASE_FEATURE(kFileProxyIoUring,
+             "FileProxyIoUring",
+             FEATURE_DISABLED_BY_DEFAULT);
+#endif
+
 void Init(EmitThreadControllerProfilerMetadata
               emit_thread_controller_profiler_metadata) {
   InitializeCpuReductionExperiment();
@@ -17,6 +17,8 @@ namespace base::features {
 // Alphabetical:
 BASE_EXPORT BASE_DECLARE_FEATURE(kEnforceNoExecutableFileHandles);
 
+BASE_EXPORT BASE_DECLARE_FEATURE(kJsonParserVectorizedScan);
+
 BASE_EXPORT BASE_DECLARE_FEATURE(kNotReachedIsFatal);
 
 BASE_EXPORT BASE_DECLARE_FEATURE(kOptimizeDataUrls);
@@ -32,6 +34,10 @@ BASE_EXPORT BASE_DECLARE_FEATURE(kPartialLowEndModeOnMidRangeDevices);
 BASE_EXPORT BASE_DECLARE_FEATURE(kCollectAndroidFrameTimelineMetrics);
 #endif
 
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+BASE_EXPORT BASE_DECLARE_FEATURE(kFileProxyIoUring);
+#endif
+
 // Policy for emitting profiler metadata from `ThreadController`.
 enum class EmitThreadControllerProfilerMetadata {
   // Always emit metadata.
@@ -16,6 +16,11 @@
 #include "base/location.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/task/task_runner.h"
+#include "build/build_config.h"
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+#include "base/files/io_uring_linux.h"
+#endif
 
 namespace {
 
@@ -43,9 +48,14 @@ class FileHelper {
                              BindOnce(&FileDeleter, std::move(file_)));
   }
 
+  // When the work runs on io_uring rather than on the task runner, the reply
+  // to run once it's done.
+  void set_reply(OnceClosure reply) { reply_ = std::move(reply); }
+
  protected:
   File file_;
   File::Error error_ = File::FILE_ERROR_FAILED;
+  OnceClosure reply_;
 
  private:
   scoped_refptr<TaskRunner> task_runner_;
@@ -81,11 +91,28 @@ class GenericFileHelper : public FileHelper {
       error_ = File::FILE_OK;
   }
 
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  // Same as Flush(), run by |io_uring|. Returns false if it couldn't be
+  // submitted.
+  bool FlushOnIoUring(IoUring* io_uring) {
+    return io_uring->Flush(
+        file_.GetPlatformFile(),
+        BindOnce(&GenericFileHelper::OnFlushed, Unretained(this)));
+  }
+#endif
+
   void Reply(FileProxy::StatusCallback callback) {
     PassFile();
     if (!callback.is_null())
       std::move(callback).Run(error_);
   }
+
+ private:
+  void OnFlushed(int result) {
+    error_ =
+        result < 0 ? File::OSErrorToFileError(-result) : File::FILE_OK;
+    std::move(reply_).Run();
+  }
 };
 
 class CreateOrOpenHelper : public FileHelper {
@@ -192,6 +219,17 @@ class ReadHelper : public FileHelper {
     error_ = File::FILE_OK;
   }
 
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  // Same as RunWork(), run by |io_uring|. Returns false if it couldn't be
+  // submitted.
+  bool RunWorkOnIoUring(IoUring* io_uring, int64_t offset) {
+    return io_uring->Read(file_.GetPlatformFile(), offset + bytes_read_,
+                          buffer_.subspan(checked_cast<size_t>(bytes_read_)),
+                          BindOnce(&ReadHelper::OnIoUringRead,
+                                   Unretained(this), io_uring, offset));
+  }
+#endif
+
   void Reply(FileProxy::ReadCallback callback) {
     PassFile();
     DCHECK(!callback.is_null());
@@ -203,6 +241,23 @@ class ReadHelper : public FileHelper {
   }
 
  private:
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  void OnIoUringRead(IoUring* io_uring, int64_t offset, int result) {
+    if (result >= 0) {
+      bytes_read_ += result;
+      error_ = File::FILE_OK;
+      // Like File::Read(), read until the buffer is full or the end of file.
+      if (result > 0 && checked_cast<size_t>(bytes_read_) < buffer_.size() &&
+          RunWorkOnIoUring(io_uring, offset)) {
+        return;
+      }
+    } else if (!bytes_read_) {
+      error_ = File::FILE_ERROR_FAILED;
+    }
+    std::move(reply_).Run();
+  }
+#endif
+
   base::HeapArray<uint8_t> buffer_;
   int bytes_read_ = 0;
 };
@@ -229,6 +284,18 @@ class WriteHelper : public FileHelper {
     error_ = File::FILE_OK;
   }
 
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  // Same as RunWork(), run by |io_uring|. Returns false if it couldn't be
+  // submitted.
+  bool RunWorkOnIoUring(IoUring* io_uring, int64_t offset) {
+    return io_uring->Write(
+        file_.GetPlatformFile(), offset + bytes_written_,
+        buffer_.subspan(checked_cast<size_t>(bytes_written_)),
+        BindOnce(&WriteHelper::OnIoUringWritten, Unretained(this), io_uring,
+                 offset));
+  }
+#endif
+
   void Reply(FileProxy::WriteCallback callback) {
     PassFile();
     if (!callback.is_null())
@@ -236,6 +303,25 @@ class WriteHelper : public FileHelper {
   }
 
  private:
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  void OnIoUringWritten(IoUring* io_uring, int64_t offset, int result) {
+    if (result >= 0) {
+      bytes_written_ += result;
+      error_ = File::FILE_OK;
+      // Like File::Write(), write until the whole buffer is written.
+      if (result > 0 &&
+          checked_cast<size_t>(bytes_written_) < buffer_.size() &&
+          RunWorkOnIoUring(io_uring, offset)) {
+        return;
+      }
+    } else if (!bytes_written_) {
+      bytes_written_ = -1;
+      error_ = File::FILE_ERROR_FAILED;
+    }
+    std::move(reply_).Run();
+  }
+#endif
+
   base::HeapArray<uint8_t> buffer_;
   int bytes_written_ = 0;
 };
@@ -321,6 +407,15 @@ bool FileProxy::Read(int64_t offset, int bytes_to_read, ReadCallback callback) {
 
   ReadHelper* helper = new ReadHelper(weak_ptr_factory_.GetWeakPtr(),
                                       std::move(file_), bytes_to_read);
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  IoUring* io_uring = IoUring::Get();
+  if (io_uring && helper->RunWorkOnIoUring(io_uring, offset)) {
+    // The read completes on this sequence, after the reply is set.
+    helper->set_reply(
+        BindOnce(&ReadHelper::Reply, Owned(helper), std::move(callback)));
+    return true;
+  }
+#endif
   return task_runner_->PostTaskAndReply(
       FROM_HERE, BindOnce(&ReadHelper::RunWork, Unretained(helper), offset),
       BindOnce(&ReadHelper::Reply, Owned(helper), std::move(callback)));
@@ -335,6 +430,15 @@ bool FileProxy::Write(int64_t offset,
   }
   WriteHelper* helper =
       new WriteHelper(weak_ptr_factory_.GetWeakPtr(), std::move(file_), data);
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  IoUring* io_uring = IoUring::Get();
+  if (io_uring && helper->RunWorkOnIoUring(io_uring, offset)) {
+    // The write completes on this sequence, after the reply is set.
+    helper->set_reply(
+        BindOnce(&WriteHelper::Reply, Owned(helper), std::move(callback)));
+    return true;
+  }
+#endif
 
   return task_runner_->PostTaskAndReply(
       FROM_HERE, BindOnce(&WriteHelper::RunWork, Unretained(helper), offset),
@@ -368,6 +472,15 @@ bool FileProxy::Flush(StatusCallback callback) {
   DCHECK(file_.IsValid());
   GenericFileHelper* helper =
       new GenericFileHelper(weak_ptr_factory_.GetWeakPtr(), std::move(file_));
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  IoUring* io_uring = IoUring::Get();
+  if (io_uring && helper->FlushOnIoUring(io_uring)) {
+    // The flush completes on this sequence, after the reply is set.
+    helper->set_reply(BindOnce(&GenericFileHelper::Reply, Owned(helper),
+                               std::move(callback)));
+    return true;
+  }
+#endif
   return task_runner_->PostTaskAndReply(
       FROM_HERE, BindOnce(&GenericFileHelper::Flush, Unretained(helper)),
       BindOnce(&GenericFileHelper::Reply, Owned(helper), std::move(callback)));
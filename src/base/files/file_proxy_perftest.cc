@@ -0,0 +1,135 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_proxy.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/functional/bind.h"
+#include "base/rand_util.h"
+#include "base/run_loop.h"
+#include "base/task/thread_pool.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "build/build_config.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+#include "base/features.h"
+#include "base/files/io_uring_linux.h"
+#include "base/test/scoped_feature_list.h"
+#endif
+
+// This file measures the throughput of small random reads through FileProxy,
+// with the reads running on the thread pool or, when available, on io_uring.
+
+namespace base {
+
+namespace {
+
+constexpr char kMetricPrefixFileProxy[] = "FileProxy.";
+constexpr char kMetricReadThroughput[] = "read_throughput";
+constexpr int kFileSize = 64 << 20;
+constexpr int kReadSize = 4096;
+constexpr int kNumReads = 20000;
+// Reads in flight at once, each on its own proxy.
+constexpr int kNumProxies = 16;
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story_name) {
+  perf_test::PerfResultReporter reporter(kMetricPrefixFileProxy, story_name);
+  reporter.RegisterImportantMetric(kMetricReadThroughput, "reads/ms");
+  return reporter;
+}
+
+class FileProxyPerfTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(dir_.CreateUniqueTempDir());
+    path_ = dir_.GetPath().AppendASCII("file");
+    File file(path_, File::FLAG_CREATE | File::FLAG_WRITE);
+    ASSERT_TRUE(file.IsValid());
+    std::vector<uint8_t> chunk(1 << 20);
+    RandBytes(chunk);
+    for (int offset = 0; offset < kFileSize; offset += chunk.size()) {
+      ASSERT_TRUE(file.WriteAndCheck(offset, chunk));
+    }
+  }
+
+  void RunReadPerfTest(const std::string& story_name) {
+    scoped_refptr<TaskRunner> task_runner =
+        ThreadPool::CreateTaskRunner({MayBlock()});
+    std::vector<std::unique_ptr<FileProxy>> proxies;
+    for (int i = 0; i < kNumProxies; ++i) {
+      proxies.push_back(std::make_unique<FileProxy>(task_runner.get()));
+      proxies.back()->SetFile(File(path_, File::FLAG_OPEN | File::FLAG_READ));
+      ASSERT_TRUE(proxies.back()->IsValid());
+    }
+
+    int reads_started = 0;
+    int reads_done = 0;
+    RunLoop run_loop;
+    RepeatingCallback<void(FileProxy*)> read;
+    read = BindLambdaForTesting([&](FileProxy* proxy) {
+      if (reads_started == kNumReads) {
+        return;
+      }
+      ++reads_started;
+      const int64_t offset =
+          RandInt(0, kFileSize / kReadSize - 1) * int64_t{kReadSize};
+      ASSERT_TRUE(proxy->Read(
+          offset, kReadSize,
+          BindLambdaForTesting([&, proxy](File::Error error,
+                                          span<const char> data) {
+            EXPECT_EQ(File::FILE_OK, error);
+            EXPECT_EQ(static_cast<size_t>(kReadSize), data.size());
+            if (++reads_done == kNumReads) {
+              run_loop.Quit();
+            } else {
+              read.Run(proxy);
+            }
+          })));
+    });
+
+    TimeTicks start_time = TimeTicks::Now();
+    for (auto& proxy : proxies) {
+      read.Run(proxy.get());
+    }
+    run_loop.Run();
+    TimeTicks end_time = TimeTicks::Now();
+
+    auto reporter = SetUpReporter(story_name);
+    reporter.AddResult(kMetricReadThroughput,
+                       kNumReads / (end_time - start_time).InMillisecondsF());
+  }
+
+ private:
+  test::TaskEnvironment task_environment_;
+  ScopedTempDir dir_;
+  FilePath path_;
+};
+
+}  // namespace
+
+TEST_F(FileProxyPerfTest, RandomReads) {
+  RunReadPerfTest("RandomReads");
+}
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+TEST_F(FileProxyPerfTest, RandomReadsIoUring) {
+  test::ScopedFeatureList feature_list(features::kFileProxyIoUring);
+  if (!IoUring::Get()) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  RunReadPerfTest("RandomReadsIoUring");
+}
+#endif
+
+}  // namespace base
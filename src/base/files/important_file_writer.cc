@@ -14,10 +14,13 @@
 #include <stdio.h>
 
 #include <algorithm>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/check.h"
+#include "base/check_op.h"
 #include "base/critical_closure.h"
 #include "base/debug/alias.h"
 #include "base/files/file.h"
@@ -26,6 +29,7 @@
 #include "base/files/important_file_writer_cleaner.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback_helpers.h"
+#include "base/json/json_writer.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/notreached.h"
@@ -41,6 +45,10 @@
 #include "build/build_config.h"
 #include "build/chromeos_buildflags.h"
 
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+#include <fcntl.h>
+#endif
+
 namespace base {
 
 namespace {
@@ -106,16 +114,171 @@ void DeleteTmpFileWithRetry(File tmp_file,
   }
 }
 
+// Closes |tmp_file|, named |tmp_file_path|, and moves it to |path|. Deletes it
+// on failure.
+bool ReplaceWithTmpFile(File tmp_file,
+                        const FilePath& tmp_file_path,
+                        const FilePath& path) {
+  File::Error replace_file_error = File::FILE_OK;
+  bool result;
+
+  // The file must be closed for ReplaceFile to do its job, which opens up a
+  // race with other software that may open the temp file (e.g., an A/V scanner
+  // doing its job without oplocks). Boost a background thread's priority on
+  // Windows and close as late as possible to improve the chances that the other
+  // software will lose the race.
+#if BUILDFLAG(IS_WIN)
+  DWORD last_error;
+  int retry_count = 0;
+  {
+    ScopedBoostPriority scoped_boost_priority(ThreadType::kDisplayCritical);
+    tmp_file.Close();
+    result = ReplaceFile(tmp_file_path, path, &replace_file_error);
+    // Save and restore the last error code so that it's not polluted by the
+    // thread priority change.
+    last_error = ::GetLastError();
+    for (/**/; !result && retry_count < kReplaceRetries; ++retry_count) {
+      // The race condition between closing the temporary file and moving it
+      // gets hit on a regular basis on some systems
+      // (https://crbug.com/1099284), so we retry a few times before giving up.
+      PlatformThread::Sleep(kReplacePauseInterval);
+      result = ReplaceFile(tmp_file_path, path, &replace_file_error);
+      last_error = ::GetLastError();
+    }
+  }
+
+  // Log how many times we had to retry the ReplaceFile operation before it
+  // succeeded. If we never succeeded then return a special value.
+  if (!result)
+    retry_count = kReplaceRetryFailure;
+  UmaHistogramExactLinear("ImportantFile.FileReplaceRetryCount", retry_count,
+                          kReplaceRetryFailure);
+#else
+  tmp_file.Close();
+  result = ReplaceFile(tmp_file_path, path, &replace_file_error);
+#endif  // BUILDFLAG(IS_WIN)
+
+  if (!result) {
+#if BUILDFLAG(IS_WIN)
+    // Restore the error code from ReplaceFile so that it will be available for
+    // the log message, otherwise failures in SetCurrentThreadType may be
+    // reported instead.
+    ::SetLastError(last_error);
+#endif
+    DPLOG(WARNING) << "Failed to replace " << path << " with " << tmp_file_path;
+    DeleteTmpFileWithRetry(File(), tmp_file_path);
+  }
+
+  return result;
+}
+
+// Writes |data| to |sink|. Doesn't write all of the data at once because this
+// can lead to kernel address-space exhaustion on 32-bit Windows (see
+// https://crbug.com/1001022 for details).
+bool WriteInChunks(StringPiece data, JSONSink& sink) {
+  constexpr size_t kMaxWriteAmount = 8 * 1024 * 1024;
+  for (size_t offset = 0; offset < data.size(); offset += kMaxWriteAmount) {
+    if (!sink.Write(data.substr(offset, kMaxWriteAmount))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
+struct ImportantFileWriter::BatchedWrite {
+  FilePath path;
+  BackgroundDataProducerCallback data_producer;
+  OnceClosure before_write_callback;
+  OnceCallback<void(bool success)> after_write_callback;
+};
+
 // static
 bool ImportantFileWriter::WriteFileAtomically(const FilePath& path,
                                               StringPiece data,
                                               StringPiece histogram_suffix) {
   // Calling the impl by way of the public WriteFileAtomically, so
   // |from_instance| is false.
-  return WriteFileAtomicallyImpl(path, data, histogram_suffix,
-                                 /*from_instance=*/false);
+  return WriteFileAtomicallyImpl(
+      path, [data](JSONSink& sink) { return WriteInChunks(data, sink); },
+      data.size(), histogram_suffix, /*from_instance=*/false);
+}
+
+// static
+bool ImportantFileWriter::WriteFilesAtomically(span<const BatchEntry> entries,
+                                               StringPiece histogram_suffix) {
+  for (const BatchEntry& entry : entries) {
+    ImportantFileWriterCleaner::AddDirectory(entry.path.DirName());
+  }
+  const std::vector<bool> results =
+      WriteFilesAtomicallyImpl(entries, histogram_suffix);
+  return std::all_of(results.begin(), results.end(),
+                     [](bool result) { return result; });
+}
+
+// static
+void ImportantFileWriter::DoScheduledWrites(
+    span<ImportantFileWriter* const> writers) {
+  std::vector<BatchedWrite> writes;
+  ImportantFileWriter* first_writer = nullptr;
+  for (ImportantFileWriter* writer : writers) {
+    if (!writer->HasPendingWrite()) {
+      continue;
+    }
+    BackgroundDataProducerCallback data_producer =
+        writer->TakeScheduledDataProducer();
+    if (!data_producer) {
+      continue;
+    }
+    writes.push_back({writer->path_, std::move(data_producer),
+                      std::move(writer->before_next_write_callback_),
+                      std::move(writer->after_next_write_callback_)});
+    writer->ClearPendingWrite();
+    if (!first_writer) {
+      first_writer = writer;
+    }
+    DCHECK_EQ(writer->task_runner_.get(), first_writer->task_runner_.get());
+  }
+  if (first_writer) {
+    first_writer->PostWriteTask(
+        BindOnce(&ProduceAndWriteBatchAtomically, std::move(writes)));
+  }
+}
+
+// static
+void ImportantFileWriter::ProduceAndWriteBatchAtomically(
+    std::vector<BatchedWrite> writes) {
+  std::vector<std::string> data;
+  std::vector<BatchedWrite*> produced_writes;
+  for (BatchedWrite& write : writes) {
+    std::optional<std::string> write_data =
+        std::move(write.data_producer).Run();
+    if (!write_data) {
+      DLOG(WARNING) << "Failed to serialize data to be saved in "
+                    << write.path.value();
+      continue;
+    }
+    data.push_back(std::move(write_data).value());
+    produced_writes.push_back(&write);
+  }
+
+  std::vector<BatchEntry> entries;
+  for (size_t i = 0; i < produced_writes.size(); ++i) {
+    if (!produced_writes[i]->before_write_callback.is_null()) {
+      std::move(produced_writes[i]->before_write_callback).Run();
+    }
+    entries.push_back({produced_writes[i]->path, data[i]});
+  }
+
+  const std::vector<bool> results =
+      WriteFilesAtomicallyImpl(entries, StringPiece());
+
+  for (size_t i = 0; i < produced_writes.size(); ++i) {
+    if (!produced_writes[i]->after_write_callback.is_null()) {
+      std::move(produced_writes[i]->after_write_callback).Run(results[i]);
+    }
+  }
 }
 
 // static
@@ -139,18 +302,44 @@ void ImportantFileWriter::ProduceAndWriteStringToFileAtomically(
   // Calling the impl by way of the private
   // ProduceAndWriteStringToFileAtomically, which originated from an
   // ImportantFileWriter instance, so |from_instance| is true.
-  const bool result = WriteFileAtomicallyImpl(path, *data, histogram_suffix,
-                                              /*from_instance=*/true);
+  const bool result = WriteFileAtomicallyImpl(
+      path, [&data](JSONSink& sink) { return WriteInChunks(*data, sink); },
+      data->size(), histogram_suffix, /*from_instance=*/true);
+
+  if (!after_write_callback.is_null())
+    std::move(after_write_callback).Run(result);
+}
+
+// static
+void ImportantFileWriter::StreamToFileAtomically(
+    const FilePath& path,
+    BackgroundDataStreamerCallback data_streamer_for_background_sequence,
+    OnceClosure before_write_callback,
+    OnceCallback<void(bool success)> after_write_callback,
+    const std::string& histogram_suffix) {
+  if (!before_write_callback.is_null())
+    std::move(before_write_callback).Run();
+
+  // The data is produced while it's written, so a serialization failure is
+  // reported like a write failure.
+  const bool result = WriteFileAtomicallyImpl(
+      path,
+      [&data_streamer_for_background_sequence](JSONSink& sink) {
+        return std::move(data_streamer_for_background_sequence).Run(sink);
+      },
+      /*data_size=*/0, histogram_suffix, /*from_instance=*/true);
 
   if (!after_write_callback.is_null())
     std::move(after_write_callback).Run(result);
 }
 
 // static
-bool ImportantFileWriter::WriteFileAtomicallyImpl(const FilePath& path,
-                                                  StringPiece data,
-                                                  StringPiece histogram_suffix,
-                                                  bool from_instance) {
+bool ImportantFileWriter::WriteFileAtomicallyImpl(
+    const FilePath& path,
+    FunctionRef<bool(JSONSink&)> write_data,
+    size_t data_size,
+    StringPiece histogram_suffix,
+    bool from_instance) {
   const TimeTicks write_start = TimeTicks::Now();
   if (!from_instance)
     ImportantFileWriterCleaner::AddDirectory(path.DirName());
@@ -173,7 +362,7 @@ bool ImportantFileWriter::WriteFileAtomicallyImpl(const FilePath& path,
     size_t data_size;
     char path[128];
   } file_info;
-  file_info.data_size = data.size();
+  file_info.data_size = data_size;
   strlcpy(file_info.path, path.value().c_str(), std::size(file_info.path));
   debug::Alias(&file_info);
 #endif
@@ -190,23 +379,12 @@ bool ImportantFileWriter::WriteFileAtomicallyImpl(const FilePath& path,
     return false;
   }
 
-  // Don't write all of the data at once because this can lead to kernel
-  // address-space exhaustion on 32-bit Windows (see https://crbug.com/1001022
-  // for details).
-  constexpr ptrdiff_t kMaxWriteAmount = 8 * 1024 * 1024;
-  int bytes_written = 0;
-  for (const char *scan = data.data(), *const end = scan + data.length();
-       scan < end; scan += bytes_written) {
-    const int write_amount =
-        static_cast<int>(std::min(kMaxWriteAmount, end - scan));
-    bytes_written = tmp_file.WriteAtCurrentPos(scan, write_amount);
-    if (bytes_written != write_amount) {
-      DPLOG(WARNING) << "Failed to write " << write_amount << " bytes to temp "
-                     << "file to update " << path
-                     << " (bytes_written=" << bytes_written << ")";
-      DeleteTmpFileWithRetry(std::move(tmp_file), tmp_file_path);
-      return false;
-    }
+  FileJSONSink sink(&tmp_file);
+  if (!write_data(sink)) {
+    DPLOG(WARNING) << "Failed to write temp file to update " << path
+                   << " (bytes_written=" << sink.bytes_written() << ")";
+    DeleteTmpFileWithRetry(std::move(tmp_file), tmp_file_path);
+    return false;
   }
 
   if (!tmp_file.Flush()) {
@@ -215,61 +393,88 @@ bool ImportantFileWriter::WriteFileAtomicallyImpl(const FilePath& path,
     return false;
   }
 
-  File::Error replace_file_error = File::FILE_OK;
-  bool result;
+  const bool result =
+      ReplaceWithTmpFile(std::move(tmp_file), tmp_file_path, path);
 
-  // The file must be closed for ReplaceFile to do its job, which opens up a
-  // race with other software that may open the temp file (e.g., an A/V scanner
-  // doing its job without oplocks). Boost a background thread's priority on
-  // Windows and close as late as possible to improve the chances that the other
-  // software will lose the race.
-#if BUILDFLAG(IS_WIN)
-  DWORD last_error;
-  int retry_count = 0;
-  {
-    ScopedBoostPriority scoped_boost_priority(ThreadType::kDisplayCritical);
-    tmp_file.Close();
-    result = ReplaceFile(tmp_file_path, path, &replace_file_error);
-    // Save and restore the last error code so that it's not polluted by the
-    // thread priority change.
-    last_error = ::GetLastError();
-    for (/**/; !result && retry_count < kReplaceRetries; ++retry_count) {
-      // The race condition between closing the temporary file and moving it
-      // gets hit on a regular basis on some systems
-      // (https://crbug.com/1099284), so we retry a few times before giving up.
-      PlatformThread::Sleep(kReplacePauseInterval);
-      result = ReplaceFile(tmp_file_path, path, &replace_file_error);
-      last_error = ::GetLastError();
+  const TimeDelta write_duration = TimeTicks::Now() - write_start;
+  UmaHistogramTimesWithSuffix("ImportantFile.WriteDuration", histogram_suffix,
+                              write_duration);
+
+  return result;
+}
+
+// static
+std::vector<bool> ImportantFileWriter::WriteFilesAtomicallyImpl(
+    span<const BatchEntry> entries,
+    StringPiece histogram_suffix) {
+  const TimeTicks write_start = TimeTicks::Now();
+  std::vector<bool> results(entries.size(), false);
+  std::vector<File> tmp_files(entries.size());
+  std::vector<FilePath> tmp_file_paths(entries.size());
+
+  // Write all the temp files first, so that the kernel can write them back to
+  // disk together rather than one flush at a time.
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const FilePath& path = entries[i].path;
+    tmp_files[i] =
+        CreateAndOpenTemporaryFileInDir(path.DirName(), &tmp_file_paths[i]);
+    if (!tmp_files[i].IsValid()) {
+      DPLOG(WARNING) << "Failed to create temporary file to update " << path;
+      continue;
+    }
+    FileJSONSink sink(&tmp_files[i]);
+    if (!WriteInChunks(entries[i].data, sink)) {
+      DPLOG(WARNING) << "Failed to write temp file to update " << path
+                     << " (bytes_written=" << sink.bytes_written() << ")";
+      DeleteTmpFileWithRetry(std::move(tmp_files[i]), tmp_file_paths[i]);
+      continue;
     }
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+    // Start the writeback without waiting for it, Flush() waits below.
+    sync_file_range(tmp_files[i].GetPlatformFile(), 0, 0,
+                    SYNC_FILE_RANGE_WRITE);
+#endif
+    results[i] = true;
   }
 
-  // Log how many times we had to retry the ReplaceFile operation before it
-  // succeeded. If we never succeeded then return a special value.
-  if (!result)
-    retry_count = kReplaceRetryFailure;
-  UmaHistogramExactLinear("ImportantFile.FileReplaceRetryCount", retry_count,
-                          kReplaceRetryFailure);
-#else
-  tmp_file.Close();
-  result = ReplaceFile(tmp_file_path, path, &replace_file_error);
-#endif  // BUILDFLAG(IS_WIN)
+  // Flush the temp files before replacing any file, so that a crash never
+  // leaves a file replaced by an incomplete one.
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (results[i] && !tmp_files[i].Flush()) {
+      DPLOG(WARNING) << "Failed to flush temp file to update "
+                     << entries[i].path;
+      DeleteTmpFileWithRetry(std::move(tmp_files[i]), tmp_file_paths[i]);
+      results[i] = false;
+    }
+  }
 
-  if (!result) {
-#if BUILDFLAG(IS_WIN)
-    // Restore the error code from ReplaceFile so that it will be available for
-    // the log message, otherwise failures in SetCurrentThreadType may be
-    // reported instead.
-    ::SetLastError(last_error);
-#endif
-    DPLOG(WARNING) << "Failed to replace " << path << " with " << tmp_file_path;
-    DeleteTmpFileWithRetry(File(), tmp_file_path);
+  std::set<FilePath> replaced_dirs;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (!results[i]) {
+      continue;
+    }
+    results[i] = ReplaceWithTmpFile(std::move(tmp_files[i]),
+                                    tmp_file_paths[i], entries[i].path);
+    if (results[i]) {
+      replaced_dirs.insert(entries[i].path.DirName());
+    }
   }
 
-  const TimeDelta write_duration = TimeTicks::Now() - write_start;
-  UmaHistogramTimesWithSuffix("ImportantFile.WriteDuration", histogram_suffix,
-                              write_duration);
+#if BUILDFLAG(IS_POSIX)
+  // Flush the directories once for all the renames, so that the new files
+  // survive a system crash.
+  for (const FilePath& dir : replaced_dirs) {
+    File dir_file(dir, File::FLAG_OPEN | File::FLAG_READ);
+    if (!dir_file.IsValid() || !dir_file.Flush()) {
+      DPLOG(WARNING) << "Failed to flush " << dir;
+    }
+  }
+#endif
 
-  return result;
+  UmaHistogramTimesWithSuffix("ImportantFile.BatchWriteDuration",
+                              histogram_suffix,
+                              TimeTicks::Now() - write_start);
+  return results;
 }
 
 ImportantFileWriter::ImportantFileWriter(
@@ -319,15 +524,28 @@ void ImportantFileWriter::WriteNow(std::string data) {
       std::move(data)));
 }
 
+void ImportantFileWriter::WriteNowWithBackgroundDataStreamer(
+    BackgroundDataStreamerCallback background_data_streamer) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  PostWriteTask(BindOnce(&StreamToFileAtomically, path_,
+                         std::move(background_data_streamer),
+                         std::move(before_next_write_callback_),
+                         std::move(after_next_write_callback_),
+                         histogram_suffix_));
+}
+
 void ImportantFileWriter::WriteNowWithBackgroundDataProducer(
     BackgroundDataProducerCallback background_data_producer) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  PostWriteTask(BindOnce(&ProduceAndWriteStringToFileAtomically, path_,
+                         std::move(background_data_producer),
+                         std::move(before_next_write_callback_),
+                         std::move(after_next_write_callback_),
+                         histogram_suffix_));
+}
 
-  auto split_task = SplitOnceCallback(
-      BindOnce(&ProduceAndWriteStringToFileAtomically, path_,
-               std::move(background_data_producer),
-               std::move(before_next_write_callback_),
-               std::move(after_next_write_callback_), histogram_suffix_));
+void ImportantFileWriter::PostWriteTask(OnceClosure write_task) {
+  auto split_task = SplitOnceCallback(std::move(write_task));
 
   if (!task_runner_->PostTask(
           FROM_HERE, MakeCriticalClosure("ImportantFileWriter::WriteNow",
@@ -371,6 +589,18 @@ void ImportantFileWriter::ScheduleWriteWithBackgroundDataSerializer(
 }
 
 void ImportantFileWriter::DoScheduledWrite() {
+  BackgroundDataProducerCallback data_producer_for_background_sequence =
+      TakeScheduledDataProducer();
+  if (!data_producer_for_background_sequence) {
+    return;
+  }
+  WriteNowWithBackgroundDataProducer(
+      std::move(data_producer_for_background_sequence));
+  DCHECK(!HasPendingWrite());
+}
+
+ImportantFileWriter::BackgroundDataProducerCallback
+ImportantFileWriter::TakeScheduledDataProducer() {
   // One of the serializers should be set.
   DCHECK(!absl::holds_alternative<absl::monostate>(serializer_));
 
@@ -384,7 +614,7 @@ void ImportantFileWriter::DoScheduledWrite() {
       DLOG(WARNING) << "Failed to serialize data to be saved in "
                     << path_.value();
       ClearPendingWrite();
-      return;
+      return BackgroundDataProducerCallback();
     }
 
     previous_data_size_ = data->size();
@@ -405,9 +635,7 @@ void ImportantFileWriter::DoScheduledWrite() {
   UmaHistogramTimesWithSuffix("ImportantFile.SerializationDuration",
                               histogram_suffix_, serialization_duration);
 
-  WriteNowWithBackgroundDataProducer(
-      std::move(data_producer_for_background_sequence));
-  DCHECK(!HasPendingWrite());
+  return data_producer_for_background_sequence;
 }
 
 void ImportantFileWriter::RegisterOnNextWriteCallbacks(
@@ -8,10 +8,13 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "base/base_export.h"
+#include "base/containers/span.h"
 #include "base/files/file_path.h"
 #include "base/functional/callback.h"
+#include "base/functional/function_ref.h"
 #include "base/memory/raw_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/strings/string_piece.h"
@@ -21,6 +24,7 @@
 
 namespace base {
 
+class JSONSink;
 class SequencedTaskRunner;
 
 // Helper for atomically writing a file to ensure that it won't be corrupted by
@@ -45,6 +49,13 @@ class BASE_EXPORT ImportantFileWriter {
   using BackgroundDataProducerCallback =
       base::OnceCallback<std::optional<std::string>()>;
 
+  // Promise-like callback that streams the serialized data into the passed
+  // sink, e.g. with WriteJsonToSink(), instead of returning it as a single
+  // string, so that the data is never held in memory in full. This callback is
+  // invoked on the sequence where I/O operations are executed. Returning false
+  // indicates an error, in which case the file is left unchanged.
+  using BackgroundDataStreamerCallback = base::OnceCallback<bool(JSONSink&)>;
+
   // Used by ScheduleSave to lazily provide the data to be saved. Allows us
   // to also batch data serializations.
   class BASE_EXPORT DataSerializer {
@@ -80,6 +91,27 @@ class BASE_EXPORT ImportantFileWriter {
                                   StringPiece data,
                                   StringPiece histogram_suffix = StringPiece());
 
+  // A file to write with WriteFilesAtomically().
+  struct BatchEntry {
+    FilePath path;
+    StringPiece data;
+  };
+
+  // Same as WriteFileAtomically() for each of |entries|, each file being
+  // replaced atomically on its own, but cheaper than writing them one by one:
+  // all the temporary files are written before any is flushed, so that their
+  // flushes overlap, and each directory is flushed once after all its files
+  // are replaced. Returns true if all of the files were written.
+  static bool WriteFilesAtomically(
+      span<const BatchEntry> entries,
+      StringPiece histogram_suffix = StringPiece());
+
+  // Does the scheduled writes of |writers| like DoScheduledWrite(), but in a
+  // single task which writes them together with WriteFilesAtomically(), e.g. to
+  // commit several files at shutdown. Writers without a scheduled write are
+  // skipped. All of the writers must use the same task runner.
+  static void DoScheduledWrites(span<ImportantFileWriter* const> writers);
+
   // Initialize the writer.
   // |path| is the name of file to write.
   // |task_runner| is the SequencedTaskRunner instance where on which we will
@@ -112,6 +144,12 @@ class BASE_EXPORT ImportantFileWriter {
   // scheduled by ScheduleWrite(), it is cancelled.
   void WriteNow(std::string data);
 
+  // Same as WriteNow() but the data is streamed to the target file by
+  // |background_data_streamer|, on the sequence where I/O operations are
+  // executed.
+  void WriteNowWithBackgroundDataStreamer(
+      BackgroundDataStreamerCallback background_data_streamer);
+
   // Schedule a save to target filename. Data will be serialized and saved
   // to disk after the commit interval. If another ScheduleWrite is issued
   // before that, only one serialization and write to disk will happen, and
@@ -164,6 +202,21 @@ class BASE_EXPORT ImportantFileWriter {
   void WriteNowWithBackgroundDataProducer(
       BackgroundDataProducerCallback background_producer);
 
+  // Posts |write_task| to |task_runner_| and clears any pending write.
+  void PostWriteTask(OnceClosure write_task);
+
+  // A scheduled write taken from a writer by DoScheduledWrites().
+  struct BatchedWrite;
+
+  // Serializes the data of the scheduled write, and returns the callback which
+  // produces it on the background sequence. Returns a null callback and clears
+  // the pending write if serialization failed.
+  BackgroundDataProducerCallback TakeScheduledDataProducer();
+
+  // Produces the data of each of |writes| and writes them all with
+  // WriteFilesAtomicallyImpl().
+  static void ProduceAndWriteBatchAtomically(std::vector<BatchedWrite> writes);
+
   // Helper function to call WriteFileAtomically() with a promise-like callback
   // producing a std::string.
   static void ProduceAndWriteStringToFileAtomically(
@@ -173,16 +226,35 @@ class BASE_EXPORT ImportantFileWriter {
       OnceCallback<void(bool success)> after_write_callback,
       const std::string& histogram_suffix);
 
-  // Writes |data| to |path|, recording histograms with an optional
-  // |histogram_suffix|. |from_instance| indicates whether the call originates
-  // from an instance of ImportantFileWriter or a direct call to
-  // WriteFileAtomically. When false, the directory containing |path| is added
-  // to the set cleaned by the ImportantFileWriterCleaner (Windows only).
+  // Helper function to call WriteFileAtomicallyImpl() with a callback
+  // streaming the data.
+  static void StreamToFileAtomically(
+      const FilePath& path,
+      BackgroundDataStreamerCallback data_streamer_for_background_sequence,
+      OnceClosure before_write_callback,
+      OnceCallback<void(bool success)> after_write_callback,
+      const std::string& histogram_suffix);
+
+  // Writes the data written by |write_data| to |path|, recording histograms
+  // with an optional |histogram_suffix|. |write_data| writes to a temporary
+  // file through the sink it's given and returns false on failure. |data_size|
+  // is the size of the data if known in advance, or 0 otherwise, for crash
+  // reports. |from_instance| indicates whether the call originates from an
+  // instance of ImportantFileWriter or a direct call to WriteFileAtomically.
+  // When false, the directory containing |path| is added to the set cleaned by
+  // the ImportantFileWriterCleaner (Windows only).
   static bool WriteFileAtomicallyImpl(const FilePath& path,
-                                      StringPiece data,
+                                      FunctionRef<bool(JSONSink&)> write_data,
+                                      size_t data_size,
                                       StringPiece histogram_suffix,
                                       bool from_instance);
 
+  // Implements WriteFilesAtomically(), returning whether each of |entries| was
+  // written.
+  static std::vector<bool> WriteFilesAtomicallyImpl(
+      span<const BatchEntry> entries,
+      StringPiece histogram_suffix);
+
   void ClearPendingWrite();
 
   // Invoked synchronously on the next write event.
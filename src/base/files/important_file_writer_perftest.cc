@@ -0,0 +1,88 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// This file measures the time to commit several files at once, as done at
+// profile shutdown, with one WriteFileAtomically() per file or with a single
+// WriteFilesAtomically().
+
+namespace base {
+
+namespace {
+
+constexpr char kMetricPrefixImportantFileWriter[] = "ImportantFileWriter.";
+constexpr char kMetricCommitTime[] = "commit_time";
+constexpr int kNumFiles = 8;
+constexpr size_t kFileSize = 32 * 1024;
+constexpr int kNumIterations = 20;
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story_name) {
+  perf_test::PerfResultReporter reporter(kMetricPrefixImportantFileWriter,
+                                         story_name);
+  reporter.RegisterImportantMetric(kMetricCommitTime, "ms");
+  return reporter;
+}
+
+class ImportantFileWriterPerfTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    for (int i = 0; i < kNumFiles; ++i) {
+      paths_.push_back(
+          temp_dir_.GetPath().AppendASCII("file" + NumberToString(i)));
+    }
+  }
+
+ protected:
+  const std::string data_ = std::string(kFileSize, 'x');
+  std::vector<FilePath> paths_;
+
+ private:
+  ScopedTempDir temp_dir_;
+};
+
+}  // namespace
+
+TEST_F(ImportantFileWriterPerfTest, CommitOneByOne) {
+  TimeTicks start_time = TimeTicks::Now();
+  for (int i = 0; i < kNumIterations; ++i) {
+    for (const FilePath& path : paths_) {
+      ASSERT_TRUE(ImportantFileWriter::WriteFileAtomically(path, data_));
+    }
+  }
+  TimeTicks end_time = TimeTicks::Now();
+
+  auto reporter = SetUpReporter("CommitOneByOne");
+  reporter.AddResult(kMetricCommitTime,
+                     (end_time - start_time).InMillisecondsF() / kNumIterations);
+}
+
+TEST_F(ImportantFileWriterPerfTest, CommitBatch) {
+  std::vector<ImportantFileWriter::BatchEntry> entries;
+  for (const FilePath& path : paths_) {
+    entries.push_back({path, data_});
+  }
+
+  TimeTicks start_time = TimeTicks::Now();
+  for (int i = 0; i < kNumIterations; ++i) {
+    ASSERT_TRUE(ImportantFileWriter::WriteFilesAtomically(entries));
+  }
+  TimeTicks end_time = TimeTicks::Now();
+
+  auto reporter = SetUpReporter("CommitBatch");
+  reporter.AddResult(kMetricCommitTime,
+                     (end_time - start_time).InMillisecondsF() / kNumIterations);
+}
+
+}  // namespace base
@@ -11,6 +11,7 @@
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/functional/bind.h"
+#include "base/json/json_writer.h"
 #include "base/location.h"
 #include "base/memory/ptr_util.h"
 #include "base/notreached.h"
@@ -227,6 +228,32 @@ TEST_F(ImportantFileWriterTest, FailedWriteWithObserver) {
   EXPECT_FALSE(PathExists(writer.path()));
 }
 
+TEST_F(ImportantFileWriterTest, WriteWithBackgroundDataStreamer) {
+  ImportantFileWriter writer(file_,
+                             SingleThreadTaskRunner::GetCurrentDefault());
+  write_callback_observer_.ObserveNextWriteCallbacks(&writer);
+  writer.WriteNowWithBackgroundDataStreamer(BindOnce([](JSONSink& sink) {
+    return sink.Write("foo") && sink.Write("bar");
+  }));
+  RunLoop().RunUntilIdle();
+
+  EXPECT_EQ(CALLED_WITH_SUCCESS,
+            write_callback_observer_.GetAndResetObservationState());
+  EXPECT_EQ("foobar", GetFileContent(writer.path()));
+
+  // A failing streamer leaves the file unchanged.
+  write_callback_observer_.ObserveNextWriteCallbacks(&writer);
+  writer.WriteNowWithBackgroundDataStreamer(BindOnce([](JSONSink& sink) {
+    EXPECT_TRUE(sink.Write("baz"));
+    return false;
+  }));
+  RunLoop().RunUntilIdle();
+
+  EXPECT_EQ(CALLED_WITH_ERROR,
+            write_callback_observer_.GetAndResetObservationState());
+  EXPECT_EQ("foobar", GetFileContent(writer.path()));
+}
+
 TEST_F(ImportantFileWriterTest, CallbackRunsOnWriterThread) {
   base::Thread file_writer_thread("ImportantFileWriter test thread");
   file_writer_thread.Start();
@@ -313,6 +340,63 @@ TEST_F(ImportantFileWriterTest, BatchingWrites) {
   EXPECT_EQ("baz", GetFileContent(writer.path()));
 }
 
+TEST_F(ImportantFileWriterTest, WriteFilesAtomically) {
+  const FilePath other_file = file_.DirName().AppendASCII("other-file");
+  const FilePath missing_dir_file =
+      file_.DirName().AppendASCII("missing").AppendASCII("file");
+  ASSERT_TRUE(WriteFile(other_file, "old"));
+
+  const ImportantFileWriter::BatchEntry entries[] = {
+      {file_, "foo"}, {missing_dir_file, "bar"}, {other_file, "baz"}};
+  // The file which can't be written doesn't prevent the others from being
+  // written.
+  EXPECT_FALSE(ImportantFileWriter::WriteFilesAtomically(entries));
+  EXPECT_EQ("foo", GetFileContent(file_));
+  EXPECT_FALSE(PathExists(missing_dir_file));
+  EXPECT_EQ("baz", GetFileContent(other_file));
+
+  EXPECT_TRUE(ImportantFileWriter::WriteFilesAtomically(
+      span(entries).first(1u)));
+}
+
+TEST_F(ImportantFileWriterTest, DoScheduledWrites) {
+  const FilePath other_file = file_.DirName().AppendASCII("other-file");
+  const FilePath idle_file = file_.DirName().AppendASCII("idle-file");
+  MockOneShotTimer timer, other_timer, idle_timer;
+  ImportantFileWriter writer(file_,
+                             SingleThreadTaskRunner::GetCurrentDefault());
+  ImportantFileWriter other_writer(other_file,
+                                   SingleThreadTaskRunner::GetCurrentDefault());
+  ImportantFileWriter idle_writer(idle_file,
+                                  SingleThreadTaskRunner::GetCurrentDefault());
+  writer.SetTimerForTesting(&timer);
+  other_writer.SetTimerForTesting(&other_timer);
+  idle_writer.SetTimerForTesting(&idle_timer);
+
+  DataSerializer foo("foo");
+  BackgroundDataSerializer bar(base::BindLambdaForTesting(
+      []() -> std::optional<std::string> { return "bar"; }));
+  writer.ScheduleWrite(&foo);
+  other_writer.ScheduleWriteWithBackgroundDataSerializer(&bar);
+  write_callback_observer_.ObserveNextWriteCallbacks(&other_writer);
+
+  ImportantFileWriter* const writers[] = {&writer, &other_writer,
+                                          &idle_writer};
+  ImportantFileWriter::DoScheduledWrites(writers);
+  EXPECT_FALSE(writer.HasPendingWrite());
+  EXPECT_FALSE(other_writer.HasPendingWrite());
+  EXPECT_EQ(NOT_CALLED, write_callback_observer_.GetAndResetObservationState());
+
+  HistogramTester histogram_tester;
+  RunLoop().RunUntilIdle();
+  EXPECT_EQ(CALLED_WITH_SUCCESS,
+            write_callback_observer_.GetAndResetObservationState());
+  EXPECT_EQ("foo", GetFileContent(file_));
+  EXPECT_EQ("bar", GetFileContent(other_file));
+  EXPECT_FALSE(PathExists(idle_file));
+  histogram_tester.ExpectTotalCount("ImportantFile.BatchWriteDuration", 1);
+}
+
 TEST_F(ImportantFileWriterTest, ScheduleWrite_FailToSerialize) {
   MockOneShotTimer timer;
   ImportantFileWriter writer(file_,
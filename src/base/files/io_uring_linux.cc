@@ -0,0 +1,247 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/io_uring_linux.h"
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "base/feature_list.h"
+#include "base/features.h"
+#include "base/functional/bind.h"
+#include "base/location.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/no_destructor.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/task/sequenced_task_runner.h"
+
+namespace base {
+
+namespace {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+              "Ring indices are accessed as atomics");
+
+// The ring head and tail indices are shared with the kernel, which updates them
+// concurrently.
+std::atomic<uint32_t>& RingIndex(void* ring, uint32_t offset) {
+  return *reinterpret_cast<std::atomic<uint32_t>*>(static_cast<uint8_t*>(ring) +
+                                                   offset);
+}
+
+int IoUringSetup(uint32_t entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int ring_fd,
+                 uint32_t to_submit,
+                 uint32_t min_complete,
+                 uint32_t flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, ring_fd, to_submit,
+                                  min_complete, flags, nullptr, 0));
+}
+
+void* MapRing(int ring_fd, size_t size, off_t offset) {
+  void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ring_fd, offset);
+  return address == MAP_FAILED ? nullptr : address;
+}
+
+}  // namespace
+
+struct IoUring::Request {
+  CompletionCallback callback;
+  scoped_refptr<SequencedTaskRunner> task_runner;
+  // Read and write use IORING_OP_READV and IORING_OP_WRITEV, which are
+  // available since Linux 5.1, with a single buffer.
+  iovec buffer;
+};
+
+// static
+IoUring* IoUring::Get() {
+  if (!FeatureList::IsEnabled(features::kFileProxyIoUring)) {
+    return nullptr;
+  }
+  static NoDestructor<IoUring> instance;
+  static const bool initialized = instance->Initialize();
+  return initialized ? instance.get() : nullptr;
+}
+
+IoUring::IoUring() = default;
+
+// Never called, the instance is leaked along with its thread.
+IoUring::~IoUring() = default;
+
+bool IoUring::Initialize() {
+  io_uring_params params = {};
+  ring_fd_ = IoUringSetup(kMaxInFlight, &params);
+  if (ring_fd_ < 0) {
+    // Not supported by the kernel, or not allowed by the sandbox.
+    return false;
+  }
+  CHECK_GE(params.cq_entries, kMaxInFlight);
+
+  size_t sq_ring_size =
+      params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  size_t cq_ring_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+  }
+  sq_ring_ = MapRing(ring_fd_, sq_ring_size, IORING_OFF_SQ_RING);
+  if (!sq_ring_) {
+    return false;
+  }
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    cq_ring_ = sq_ring_;
+  } else {
+    cq_ring_ = MapRing(ring_fd_, cq_ring_size, IORING_OFF_CQ_RING);
+    if (!cq_ring_) {
+      return false;
+    }
+  }
+  sqes_ = MapRing(ring_fd_, params.sq_entries * sizeof(io_uring_sqe),
+                  IORING_OFF_SQES);
+  if (!sqes_) {
+    return false;
+  }
+
+  uint8_t* sq_ring = static_cast<uint8_t*>(sq_ring_.get());
+  uint8_t* cq_ring = static_cast<uint8_t*>(cq_ring_.get());
+  sq_mask_ = *reinterpret_cast<uint32_t*>(sq_ring + params.sq_off.ring_mask);
+  cq_mask_ = *reinterpret_cast<uint32_t*>(cq_ring + params.cq_off.ring_mask);
+  sq_tail_offset_ = params.sq_off.tail;
+  sq_array_offset_ = params.sq_off.array;
+  cq_head_offset_ = params.cq_off.head;
+  cq_tail_offset_ = params.cq_off.tail;
+  cqes_offset_ = params.cq_off.cqes;
+
+  return PlatformThread::CreateNonJoinable(0, this);
+}
+
+bool IoUring::Read(PlatformFile file,
+                   int64_t offset,
+                   span<uint8_t> buffer,
+                   CompletionCallback callback) {
+  return Submit(IORING_OP_READV, file, offset, buffer.data(), buffer.size(),
+                0, std::move(callback));
+}
+
+bool IoUring::Write(PlatformFile file,
+                    int64_t offset,
+                    span<const uint8_t> buffer,
+                    CompletionCallback callback) {
+  // The kernel only reads from |buffer|.
+  return Submit(IORING_OP_WRITEV, file, offset,
+                const_cast<uint8_t*>(buffer.data()), buffer.size(), 0,
+                std::move(callback));
+}
+
+bool IoUring::Flush(PlatformFile file, CompletionCallback callback) {
+  return Submit(IORING_OP_FSYNC, file, 0, nullptr, 0, IORING_FSYNC_DATASYNC,
+                std::move(callback));
+}
+
+bool IoUring::Submit(uint8_t opcode,
+                     PlatformFile file,
+                     int64_t offset,
+                     void* address,
+                     size_t length,
+                     uint32_t fsync_flags,
+                     CompletionCallback callback) {
+  DCHECK(callback);
+  auto request = std::make_unique<Request>();
+  request->callback = std::move(callback);
+  request->task_runner = SequencedTaskRunner::GetCurrentDefault();
+  request->buffer = {address, length};
+
+  AutoLock auto_lock(submit_lock_);
+  if (in_flight_.fetch_add(1, std::memory_order_relaxed) >= kMaxInFlight) {
+    in_flight_.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // This is the only producer, so the tail can't change under us, and the
+  // queue can't be full given |in_flight_|.
+  std::atomic<uint32_t>& sq_tail = RingIndex(sq_ring_, sq_tail_offset_);
+  const uint32_t tail = sq_tail.load(std::memory_order_relaxed);
+  const uint32_t index = tail & sq_mask_;
+  io_uring_sqe& sqe = static_cast<io_uring_sqe*>(sqes_.get())[index];
+  memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = opcode;
+  sqe.fd = file;
+  sqe.off = static_cast<uint64_t>(offset);
+  if (opcode != IORING_OP_FSYNC) {
+    sqe.addr = reinterpret_cast<uintptr_t>(&request->buffer);
+    sqe.len = 1;
+  }
+  sqe.fsync_flags = fsync_flags;
+  sqe.user_data = reinterpret_cast<uintptr_t>(request.get());
+  reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(sq_ring_.get()) +
+                              sq_array_offset_)[index] = index;
+  sq_tail.store(tail + 1, std::memory_order_release);
+
+  int submitted = HANDLE_EINTR(IoUringEnter(ring_fd_, 1, 0, 0));
+  if (submitted != 1) {
+    // The kernel didn't consume the entry, take it back.
+    sq_tail.store(tail, std::memory_order_release);
+    in_flight_.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+  // Owned by the ring until ThreadMain() gets the completion.
+  request.release();
+  return true;
+}
+
+void IoUring::ThreadMain() {
+  PlatformThread::SetName("IoUringCompletions");
+  std::atomic<uint32_t>& cq_head = RingIndex(cq_ring_, cq_head_offset_);
+  std::atomic<uint32_t>& cq_tail = RingIndex(cq_ring_, cq_tail_offset_);
+  const io_uring_cqe* cqes = reinterpret_cast<const io_uring_cqe*>(
+      static_cast<uint8_t*>(cq_ring_.get()) + cqes_offset_);
+
+  while (true) {
+    int result = IoUringEnter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+    if (result < 0 && errno != EINTR) {
+      PCHECK(errno == EAGAIN || errno == EBUSY);
+      continue;
+    }
+
+    // This is the only consumer.
+    uint32_t head = cq_head.load(std::memory_order_relaxed);
+    const uint32_t tail = cq_tail.load(std::memory_order_acquire);
+    if (head == tail) {
+      continue;
+    }
+    {
+      // The requests below were submitted with |submit_lock_| held, so taking
+      // it orders their use after their creation in a way that tools such as
+      // TSan can see, unlike the handoff through the kernel.
+      AutoLock auto_lock(submit_lock_);
+    }
+    for (; head != tail; ++head) {
+      const io_uring_cqe& cqe = cqes[head & cq_mask_];
+      std::unique_ptr<Request> request(
+          reinterpret_cast<Request*>(static_cast<uintptr_t>(cqe.user_data)));
+      request->task_runner->PostTask(
+          FROM_HERE, BindOnce(std::move(request->callback), cqe.res));
+      in_flight_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    cq_head.store(head, std::memory_order_release);
+  }
+}
+
+}  // namespace base
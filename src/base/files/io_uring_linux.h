@@ -0,0 +1,113 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_IO_URING_LINUX_H_
+#define BASE_FILES_IO_URING_LINUX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+
+#include "base/base_export.h"
+#include "base/containers/span.h"
+#include "base/files/platform_file.h"
+#include "base/functional/callback.h"
+#include "base/memory/raw_ptr.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/platform_thread.h"
+
+namespace base {
+
+template <typename T>
+class NoDestructor;
+
+// A process-wide io_uring, which runs file I/O asynchronously in the kernel
+// instead of blocking a thread for each operation. Operations can be submitted
+// from any sequence, and their completion callback runs on that sequence. A
+// single thread waits for all completions.
+//
+// Used by FileProxy behind the FileProxyIoUring feature. Note that sandboxes
+// may not allow io_uring, so this should only be enabled in processes which are
+// known to allow it.
+class BASE_EXPORT IoUring : public PlatformThread::Delegate {
+ public:
+  // Receives the number of bytes transferred, or a negative errno value.
+  using CompletionCallback = OnceCallback<void(int result)>;
+
+  // Maximum number of operations in flight. Submissions beyond that fail.
+  static constexpr uint32_t kMaxInFlight = 128;
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  // Returns the instance, or null if the FileProxyIoUring feature is disabled
+  // or io_uring isn't available in this process.
+  static IoUring* Get();
+
+  // Each of these submits an operation on |file|, and returns true if it was
+  // submitted, in which case |callback| runs on the current sequence once the
+  // operation completes. A single read or write may transfer fewer bytes than
+  // asked for. |file| and |buffer| must remain valid until then.
+  bool Read(PlatformFile file,
+            int64_t offset,
+            span<uint8_t> buffer,
+            CompletionCallback callback);
+  bool Write(PlatformFile file,
+             int64_t offset,
+             span<const uint8_t> buffer,
+             CompletionCallback callback);
+  // Same as fdatasync().
+  bool Flush(PlatformFile file, CompletionCallback callback);
+
+ private:
+  friend class NoDestructor<IoUring>;
+
+  struct Request;
+
+  IoUring();
+  ~IoUring() override;
+
+  // Sets up the ring and starts the completion thread. Returns false if
+  // io_uring isn't available.
+  bool Initialize();
+
+  bool Submit(uint8_t opcode,
+              PlatformFile file,
+              int64_t offset,
+              void* address,
+              size_t length,
+              uint32_t fsync_flags,
+              CompletionCallback callback);
+
+  // PlatformThread::Delegate:
+  void ThreadMain() override;
+
+  int ring_fd_ = -1;
+
+  // The rings shared with the kernel, see io_uring_setup(2).
+  raw_ptr<void> sq_ring_ = nullptr;
+  raw_ptr<void> cq_ring_ = nullptr;
+  raw_ptr<void> sqes_ = nullptr;
+
+  uint32_t sq_mask_ = 0;
+  uint32_t cq_mask_ = 0;
+
+  // Offsets of the ring fields in |sq_ring_| and |cq_ring_|.
+  uint32_t sq_tail_offset_ = 0;
+  uint32_t sq_array_offset_ = 0;
+  uint32_t cq_head_offset_ = 0;
+  uint32_t cq_tail_offset_ = 0;
+  uint32_t cqes_offset_ = 0;
+
+  // Serializes submissions, as the submission queue has a single producer.
+  Lock submit_lock_;
+
+  // Bounded by kMaxInFlight, so that the completion queue never overflows.
+  std::atomic<uint32_t> in_flight_{0};
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_IO_URING_LINUX_H_
@@ -0,0 +1,131 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/io_uring_linux.h"
+
+#include <errno.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/features.h"
+#include "base/files/file.h"
+#include "base/files/file_proxy.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/memory/raw_ptr.h"
+#include "base/run_loop.h"
+#include "base/task/single_thread_task_runner.h"
+#include "base/test/bind.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/test/task_environment.h"
+#include "base/test/test_future.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+class IoUringTest : public testing::Test {
+ public:
+  void SetUp() override {
+    io_uring_ = IoUring::Get();
+    if (!io_uring_) {
+      GTEST_SKIP() << "io_uring is not available";
+    }
+    ASSERT_TRUE(dir_.CreateUniqueTempDir());
+    file_ = File(dir_.GetPath().AppendASCII("file"),
+                 File::FLAG_CREATE | File::FLAG_READ | File::FLAG_WRITE);
+    ASSERT_TRUE(file_.IsValid());
+  }
+
+ protected:
+  test::ScopedFeatureList feature_list_{features::kFileProxyIoUring};
+  test::TaskEnvironment task_environment_;
+  ScopedTempDir dir_;
+  File file_;
+  raw_ptr<IoUring> io_uring_ = nullptr;
+};
+
+TEST_F(IoUringTest, WriteFlushRead) {
+  const std::string data = "0123456789";
+
+  test::TestFuture<int> written;
+  ASSERT_TRUE(io_uring_->Write(file_.GetPlatformFile(), 5,
+                               as_bytes(span(data)), written.GetCallback()));
+  EXPECT_EQ(10, written.Get());
+
+  test::TestFuture<int> flushed;
+  ASSERT_TRUE(io_uring_->Flush(file_.GetPlatformFile(), flushed.GetCallback()));
+  EXPECT_EQ(0, flushed.Get());
+
+  std::vector<uint8_t> buffer(20);
+  test::TestFuture<int> read;
+  ASSERT_TRUE(io_uring_->Read(file_.GetPlatformFile(), 7, buffer,
+                              read.GetCallback()));
+  // Stops at the end of the file.
+  EXPECT_EQ(8, read.Get());
+  EXPECT_EQ("23456789", std::string(buffer.begin(), buffer.begin() + 8));
+}
+
+TEST_F(IoUringTest, Error) {
+  std::vector<uint8_t> buffer(4);
+  test::TestFuture<int> read;
+  ASSERT_TRUE(io_uring_->Read(-1, 0, buffer, read.GetCallback()));
+  EXPECT_EQ(-EBADF, read.Get());
+}
+
+TEST_F(IoUringTest, ManyInFlight) {
+  const std::string data(IoUring::kMaxInFlight, 'a');
+  ASSERT_TRUE(file_.WriteAndCheck(0, as_bytes(span(data))));
+
+  std::vector<std::vector<uint8_t>> buffers(IoUring::kMaxInFlight,
+                                            std::vector<uint8_t>(1));
+  size_t completed = 0;
+  RunLoop run_loop;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    // Submissions only fail when too many are in flight, which can't happen
+    // here as completions run on this thread.
+    ASSERT_TRUE(io_uring_->Read(file_.GetPlatformFile(),
+                                static_cast<int64_t>(i), buffers[i],
+                                BindLambdaForTesting([&](int result) {
+                                  EXPECT_EQ(1, result);
+                                  if (++completed == buffers.size()) {
+                                    run_loop.Quit();
+                                  }
+                                })));
+  }
+  run_loop.Run();
+  for (const auto& buffer : buffers) {
+    EXPECT_EQ('a', buffer[0]);
+  }
+}
+
+// FileProxy uses the ring when the feature is enabled, with the same results.
+TEST_F(IoUringTest, FileProxy) {
+  FileProxy proxy(SingleThreadTaskRunner::GetCurrentDefault().get());
+  proxy.SetFile(std::move(file_));
+
+  const std::string data = "hello";
+  test::TestFuture<File::Error, int> written;
+  ASSERT_TRUE(proxy.Write(0, as_bytes(span(data)), written.GetCallback()));
+  EXPECT_EQ(File::FILE_OK, written.Get<0>());
+  EXPECT_EQ(5, written.Get<1>());
+
+  test::TestFuture<File::Error> flushed;
+  ASSERT_TRUE(proxy.Flush(flushed.GetCallback()));
+  EXPECT_EQ(File::FILE_OK, flushed.Get());
+
+  test::TestFuture<File::Error, std::string> read;
+  ASSERT_TRUE(proxy.Read(
+      1, 10,
+      BindLambdaForTesting(
+          [&](File::Error error, span<const char> bytes) {
+            read.SetValue(error, std::string(bytes.begin(), bytes.end()));
+          })));
+  EXPECT_EQ(File::FILE_OK, read.Get<0>());
+  EXPECT_EQ("ello", read.Get<1>());
+  EXPECT_TRUE(proxy.IsValid());
+}
+
+}  // namespace base
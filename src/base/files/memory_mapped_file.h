@@ -62,6 +62,22 @@ class BASE_EXPORT MemoryMappedFile {
 #endif
   };
 
+  // Hints about how a range of the mapping is going to be accessed, see
+  // Advise().
+  enum class Advice {
+    // The range will be accessed soon, so the OS can start reading it in ahead
+    // of the accesses, rather than one page fault at a time.
+    kWillNeed,
+
+    // The range will be accessed in random order, so the OS shouldn't read
+    // ahead of each page fault, e.g. for lookups in a large index.
+    kRandom,
+
+    // The range will be accessed in order, so the OS can read further ahead of
+    // each page fault, e.g. to checksum it.
+    kSequential,
+  };
+
   // The default constructor sets all members to invalid/null values.
   MemoryMappedFile();
   MemoryMappedFile(const MemoryMappedFile&) = delete;
@@ -117,6 +133,13 @@ class BASE_EXPORT MemoryMappedFile {
   span<const uint8_t> bytes() const { return bytes_; }
   span<uint8_t> mutable_bytes() { return bytes_; }
 
+  // Gives |advice| to the OS about the |size| bytes at |offset| in the mapping,
+  // or about the whole mapping. This is only a hint, which doesn't change the
+  // contents of the mapping. Returns false if it couldn't be given, e.g. if it
+  // isn't supported on this platform.
+  bool Advise(Advice advice, size_t offset, size_t size) const;
+  bool Advise(Advice advice) const { return Advise(advice, 0, length()); }
+
   // Is file_ a valid file handle that points to an open, memory mapped file?
   bool IsValid() const;
 
@@ -11,8 +11,10 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include "base/check_op.h"
 #include "base/files/file_util.h"
 #include "base/logging.h"
+#include "base/memory/page_size.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
 #include "build/build_config.h"
@@ -132,6 +134,41 @@ bool MemoryMappedFile::MapFileRegionToMemory(
 }
 #endif
 
+bool MemoryMappedFile::Advise(Advice advice, size_t offset, size_t size) const {
+  CHECK_LE(offset, bytes_.size());
+  CHECK_LE(size, bytes_.size() - offset);
+#if BUILDFLAG(IS_NACL)
+  return false;
+#else
+  if (!size) {
+    return true;
+  }
+  int behavior = MADV_NORMAL;
+  switch (advice) {
+    case Advice::kWillNeed:
+      behavior = MADV_WILLNEED;
+      break;
+    case Advice::kRandom:
+      behavior = MADV_RANDOM;
+      break;
+    case Advice::kSequential:
+      behavior = MADV_SEQUENTIAL;
+      break;
+  }
+
+  // madvise() requires a page-aligned start. Rounding it down stays within the
+  // mapping, which starts on a page boundary.
+  const uintptr_t start = reinterpret_cast<uintptr_t>(bytes_.data()) + offset;
+  const uintptr_t aligned_start = start & ~(GetPageSize() - 1);
+  if (madvise(reinterpret_cast<void*>(aligned_start),
+              start - aligned_start + size, behavior)) {
+    DPLOG(ERROR) << "madvise";
+    return false;
+  }
+  return true;
+#endif
+}
+
 void MemoryMappedFile::CloseHandles() {
   ScopedBlockingCall scoped_blocking_call(FROM_HERE, BlockingType::MAY_BLOCK);
 
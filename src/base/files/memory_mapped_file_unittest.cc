@@ -18,6 +18,7 @@
 #include "base/containers/span.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/platform_test.h"
 
@@ -178,6 +179,30 @@ TEST_F(MemoryMappedFileTest, MapLargePartialRegionInTheMiddle) {
   ASSERT_TRUE(CheckBufferContents(map.bytes().first(kPartialSize), kOffset));
 }
 
+// Advice only affects how the mapping is paged in, not its contents.
+TEST_F(MemoryMappedFileTest, Advise) {
+  const size_t kFileSize = 157 * 1024;
+  const size_t kOffset = 1024 * 5 + 32;
+  const size_t kPartialSize = 16 * 1024 - 32;
+
+  CreateTemporaryTestFile(kFileSize);
+  MemoryMappedFile map;
+
+  File file(temp_file_path(), File::FLAG_OPEN | File::FLAG_READ);
+  MemoryMappedFile::Region region = {kOffset, kPartialSize};
+  ASSERT_TRUE(map.Initialize(std::move(file), region));
+#if BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_NACL)
+  // The mapping doesn't start on a page boundary.
+  EXPECT_TRUE(map.Advise(MemoryMappedFile::Advice::kSequential));
+  EXPECT_TRUE(map.Advise(MemoryMappedFile::Advice::kRandom, 100, 5000));
+#endif
+#if (BUILDFLAG(IS_POSIX) && !BUILDFLAG(IS_NACL)) || BUILDFLAG(IS_WIN)
+  EXPECT_TRUE(map.Advise(MemoryMappedFile::Advice::kWillNeed, 4096, 1));
+#endif
+  EXPECT_TRUE(map.Advise(MemoryMappedFile::Advice::kWillNeed, kPartialSize, 0));
+  ASSERT_TRUE(CheckBufferContents(map.bytes(), kOffset));
+}
+
 TEST_F(MemoryMappedFileTest, WriteableFile) {
   const size_t kFileSize = 127;
   CreateTemporaryTestFile(kFileSize);
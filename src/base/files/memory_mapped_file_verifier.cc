@@ -0,0 +1,75 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/memory_mapped_file_verifier.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/functional/bind.h"
+#include "base/location.h"
+#include "base/task/sequenced_task_runner.h"
+
+namespace base {
+
+MemoryMappedFileVerifier::MemoryMappedFileVerifier(
+    const MemoryMappedFile& file,
+    ChunkCallback chunk_callback,
+    DoneCallback done_callback,
+    size_t chunk_size)
+    : file_(file),
+      chunk_callback_(std::move(chunk_callback)),
+      done_callback_(std::move(done_callback)),
+      chunk_size_(chunk_size) {
+  DCHECK(chunk_callback_);
+  DCHECK(done_callback_);
+  DCHECK_GT(chunk_size_, 0u);
+}
+
+MemoryMappedFileVerifier::~MemoryMappedFileVerifier() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+void MemoryMappedFileVerifier::Start() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK_EQ(offset_, 0u);
+  // The chunks are read in order, and only once.
+  file_->Advise(MemoryMappedFile::Advice::kSequential);
+  PrefetchChunkAt(0);
+  SequencedTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, BindOnce(&MemoryMappedFileVerifier::VerifyNextChunk,
+                          weak_factory_.GetWeakPtr()));
+}
+
+void MemoryMappedFileVerifier::VerifyNextChunk() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  const span<const uint8_t> bytes = file_->bytes();
+  const size_t size = std::min(chunk_size_, bytes.size() - offset_);
+  PrefetchChunkAt(offset_ + size);
+  if (size && !chunk_callback_.Run(bytes.subspan(offset_, size))) {
+    std::move(done_callback_).Run(false);
+    return;
+  }
+  offset_ += size;
+  if (offset_ == bytes.size()) {
+    std::move(done_callback_).Run(true);
+    return;
+  }
+  SequencedTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE, BindOnce(&MemoryMappedFileVerifier::VerifyNextChunk,
+                          weak_factory_.GetWeakPtr()));
+}
+
+void MemoryMappedFileVerifier::PrefetchChunkAt(size_t offset) {
+  const size_t length = file_->length();
+  if (offset < length) {
+    file_->Advise(MemoryMappedFile::Advice::kWillNeed, offset,
+                  std::min(chunk_size_, length - offset));
+  }
+}
+
+}  // namespace base
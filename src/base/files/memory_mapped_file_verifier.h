@@ -0,0 +1,82 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_FILES_MEMORY_MAPPED_FILE_VERIFIER_H_
+#define BASE_FILES_MEMORY_MAPPED_FILE_VERIFIER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/base_export.h"
+#include "base/containers/span.h"
+#include "base/functional/callback.h"
+#include "base/memory/raw_ref.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+
+namespace base {
+
+class MemoryMappedFile;
+
+// Verifies the contents of a MemoryMappedFile incrementally, e.g. with a
+// checksum, rather than in a single pass at load time. The mapping is fed to a
+// callback one chunk at a time, each in its own task on the current sequence,
+// so that verifying a large mapping neither blocks the sequence nor faults the
+// whole mapping in at once. The next chunk is prefetched while the current one
+// is verified.
+//
+// If the verification isn't done when |this| is destroyed, it's abandoned and
+// the done callback never runs.
+class BASE_EXPORT MemoryMappedFileVerifier {
+ public:
+  static constexpr size_t kDefaultChunkSize = 1024 * 1024;
+
+  // Verifies the next chunk of the mapping, e.g. by adding it to a checksum,
+  // and returns false if it's found to be invalid.
+  using ChunkCallback = RepeatingCallback<bool(span<const uint8_t> chunk)>;
+
+  // Runs once all the chunks are verified, with true, or once a chunk is found
+  // to be invalid, with false. Any final check, such as comparing the checksum
+  // to the expected one, belongs there.
+  using DoneCallback = OnceCallback<void(bool valid)>;
+
+  // |file| must outlive |this|.
+  MemoryMappedFileVerifier(const MemoryMappedFile& file,
+                           ChunkCallback chunk_callback,
+                           DoneCallback done_callback,
+                           size_t chunk_size = kDefaultChunkSize);
+  MemoryMappedFileVerifier(const MemoryMappedFileVerifier&) = delete;
+  MemoryMappedFileVerifier& operator=(const MemoryMappedFileVerifier&) =
+      delete;
+  ~MemoryMappedFileVerifier();
+
+  // Starts verifying. Must be called once.
+  void Start();
+
+  // Returns true once the done callback has run.
+  bool is_done() const { return done_callback_.is_null(); }
+
+  // Returns the number of bytes verified so far.
+  size_t bytes_verified() const { return offset_; }
+
+ private:
+  void VerifyNextChunk();
+  void PrefetchChunkAt(size_t offset);
+
+  const raw_ref<const MemoryMappedFile> file_;
+  const ChunkCallback chunk_callback_;
+  DoneCallback done_callback_;
+  const size_t chunk_size_;
+
+  // Offset of the next chunk to verify.
+  size_t offset_ = 0;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  WeakPtrFactory<MemoryMappedFileVerifier> weak_factory_{this};
+};
+
+}  // namespace base
+
+#endif  // BASE_FILES_MEMORY_MAPPED_FILE_VERIFIER_H_
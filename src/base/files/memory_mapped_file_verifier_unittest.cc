@@ -0,0 +1,90 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/memory_mapped_file_verifier.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/test/bind.h"
+#include "base/test/task_environment.h"
+#include "base/test/test_future.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+class MemoryMappedFileVerifierTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    const FilePath path = temp_dir_.GetPath().AppendASCII("file");
+    ASSERT_TRUE(WriteFile(path, data_));
+    ASSERT_TRUE(file_.Initialize(path));
+  }
+
+  test::TaskEnvironment task_environment_;
+  const std::string data_ = std::string(2500, 'a') + std::string(500, 'b');
+  ScopedTempDir temp_dir_;
+  MemoryMappedFile file_;
+};
+
+TEST_F(MemoryMappedFileVerifierTest, VerifiesAllChunks) {
+  std::string verified;
+  test::TestFuture<bool> done;
+  MemoryMappedFileVerifier verifier(
+      file_, BindLambdaForTesting([&](span<const uint8_t> chunk) {
+        EXPECT_LE(chunk.size(), 1000u);
+        verified.append(chunk.begin(), chunk.end());
+        return true;
+      }),
+      done.GetCallback(), /*chunk_size=*/1000);
+  verifier.Start();
+
+  // Each chunk is verified in its own task.
+  EXPECT_TRUE(verified.empty());
+  RunLoop().RunUntilIdle();
+  EXPECT_TRUE(done.Get());
+  EXPECT_TRUE(verifier.is_done());
+  EXPECT_EQ(data_.size(), verifier.bytes_verified());
+  EXPECT_EQ(data_, verified);
+}
+
+TEST_F(MemoryMappedFileVerifierTest, StopsAtInvalidChunk) {
+  int chunks = 0;
+  test::TestFuture<bool> done;
+  MemoryMappedFileVerifier verifier(
+      file_, BindLambdaForTesting([&](span<const uint8_t> chunk) {
+        ++chunks;
+        return chunk.back() == 'a';
+      }),
+      done.GetCallback(), /*chunk_size=*/1000);
+  verifier.Start();
+  EXPECT_FALSE(done.Get());
+  EXPECT_EQ(3, chunks);
+  EXPECT_EQ(2000u, verifier.bytes_verified());
+}
+
+TEST_F(MemoryMappedFileVerifierTest, AbandonedOnDestruction) {
+  int chunks = 0;
+  auto verifier = std::make_unique<MemoryMappedFileVerifier>(
+      file_, BindLambdaForTesting([&](span<const uint8_t> chunk) {
+        ++chunks;
+        return true;
+      }),
+      BindOnce([](bool valid) { ADD_FAILURE(); }), /*chunk_size=*/1000);
+  verifier->Start();
+  verifier.reset();
+  RunLoop().RunUntilIdle();
+  EXPECT_EQ(0, chunks);
+}
+
+}  // namespace base
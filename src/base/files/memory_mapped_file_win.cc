@@ -13,6 +13,7 @@
 #include <limits>
 #include <string>
 
+#include "base/check_op.h"
 #include "base/files/file_path.h"
 #include "base/logging.h"
 #include "base/numerics/checked_math.h"
@@ -178,6 +179,24 @@ bool MemoryMappedFile::MapFileRegionToMemory(
   return true;
 }
 
+bool MemoryMappedFile::Advise(Advice advice, size_t offset, size_t size) const {
+  CHECK_LE(offset, bytes_.size());
+  CHECK_LE(size, bytes_.size() - offset);
+  if (!size) {
+    return true;
+  }
+  // Windows has no equivalent of the access pattern hints.
+  if (advice != Advice::kWillNeed) {
+    return false;
+  }
+  WIN32_MEMORY_RANGE_ENTRY range = {bytes_.subspan(offset).data(), size};
+  if (!::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0)) {
+    DPLOG(ERROR) << "PrefetchVirtualMemory";
+    return false;
+  }
+  return true;
+}
+
 void MemoryMappedFile::CloseHandles() {
   if (!bytes_.empty()) {
     ::UnmapViewOfFile(bytes_.data());
@@ -19,6 +19,7 @@
 #include "base/dcheck_is_on.h"
 #include "base/notreached.h"
 #include "base/third_party/cityhash/city.h"
+#include "base/third_party/rapidhash/rapidhash.h"
 
 // Definition in base/third_party/superfasthash/superfasthash.c. (Third-party
 // code did not come with its own header file, so declaring the function here.)
@@ -30,11 +31,13 @@ namespace base {
 namespace {
 
 size_t FastHashImpl(base::span<const uint8_t> data) {
-  // We use the updated CityHash within our namespace (not the deprecated
-  // version from third_party/smhasher).
+  // rapidhash is considerably faster than CityHash64 on both short and long
+  // inputs, but relies on 64x64->128 bit multiplications, which are slow on
+  // 32-bit platforms. Those keep using the updated CityHash within our
+  // namespace (not the deprecated version from third_party/smhasher).
   if constexpr (sizeof(size_t) > 4) {
-    return base::internal::cityhash_v111::CityHash64(
-        reinterpret_cast<const char*>(data.data()), data.size());
+    return static_cast<size_t>(
+        base::internal::rapidhash::Rapidhash(data.data(), data.size()));
   } else {
     return base::internal::cityhash_v111::CityHash32(
         reinterpret_cast<const char*>(data.data()), data.size());
@@ -31,6 +31,10 @@ void FastHash(base::span<const uint8_t> data) {
   base::FastHash(data);
 }
 
+void PersistentHash(base::span<const uint8_t> data) {
+  base::PersistentHash(data);
+}
+
 void RunTest(const char* hash_name,
              void (*hash)(base::span<const uint8_t>),
              const size_t len) {
@@ -97,4 +101,10 @@ TEST(HashPerfTest, Speed) {
   }
 }
 
+TEST(PersistentHashPerfTest, Speed) {
+  for (int shift : {1, 5, 6, 7}) {
+    RunTest("PersistentHash.", PersistentHash, 1024 * 1024U >> shift);
+  }
+}
+
 }  // namespace base
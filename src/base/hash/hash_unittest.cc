@@ -5,7 +5,9 @@
 #include "base/hash/hash.h"
 
 #include <cstdint>
+#include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "base/containers/span.h"
@@ -91,4 +93,23 @@ TEST(HashTest, FastHash) {
   EXPECT_EQ(FastHash(s), FastHash(kEmptyString));
 }
 
+TEST(HashTest, FastHashDistinguishesLengthsAndContents) {
+  // Covers the short, medium and bulk paths of the underlying hash.
+  std::string data(300, 'a');
+  std::set<size_t> hashes;
+  for (size_t length = 0; length <= data.size(); ++length) {
+    std::string_view prefix = std::string_view(data).substr(0, length);
+    hashes.insert(FastHash(prefix));
+  }
+  EXPECT_EQ(data.size() + 1, hashes.size());
+
+  // Changing any single byte changes the hash.
+  const size_t hash = FastHash(data);
+  for (size_t i = 0; i < data.size(); ++i) {
+    std::string modified = data;
+    modified[i] = 'b';
+    EXPECT_NE(hash, FastHash(modified)) << i;
+  }
+}
+
 }  // namespace base
@@ -19,6 +19,7 @@
 #include "base/feature_list.h"
 #include "base/features.h"
 #include "base/json/json_reader.h"
+#include "base/json/json_scanner.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/notreached.h"
 #include "base/numerics/safe_conversions.h"
@@ -120,6 +121,10 @@ const char JSONParser::kUnrepresentableNumber[] =
 JSONParser::JSONParser(int options, size_t max_depth)
     : options_(options),
       max_depth_(max_depth),
+      // Features can't be checked before the FeatureList is initialized.
+      vectorized_scan_(FeatureList::GetInstance() &&
+                       FeatureList::IsEnabled(
+                           features::kJsonParserVectorizedScan)),
       index_(0),
       stack_depth_(0),
       line_number_(0),
@@ -221,6 +226,15 @@ void JSONParser::StringBuilder::Append(base_icu::UChar32 point) {
   }
 }
 
+void JSONParser::StringBuilder::AppendASCIIRun(std::string_view run) {
+  if (!string_) {
+    DCHECK_EQ(run.data(), pos_ + length_);
+    length_ += run.size();
+  } else {
+    string_->append(run);
+  }
+}
+
 void JSONParser::StringBuilder::Convert() {
   if (string_)
     return;
@@ -337,6 +351,9 @@ void JSONParser::EatWhitespaceAndComments() {
       case ' ':
       case '\t':
         ConsumeChar();
+        if (vectorized_scan_) {
+          index_ = FindEndOfBlankRun(input_, index_);
+        }
         break;
       case '/':
         if (!EatComment())
@@ -550,6 +567,16 @@ bool JSONParser::ConsumeStringRaw(StringBuilder* out) {
   StringBuilder string(pos());
 
   while (std::optional<char> c = PeekChar()) {
+    if (vectorized_scan_) {
+      // Plain string contents need no decoding or line tracking.
+      const size_t run_end = FindEndOfPlainStringRun(input_, index_);
+      if (run_end != index_) {
+        string.AppendASCIIRun(input_.substr(index_, run_end - index_));
+        index_ = run_end;
+        continue;
+      }
+    }
+
     base_icu::UChar32 next_char = 0;
     if (static_cast<unsigned char>(*c) < kExtendedASCIIStart) {
       // Fast path for ASCII.
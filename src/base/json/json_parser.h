@@ -136,6 +136,10 @@ class BASE_EXPORT JSONParser {
     // converted, or by appending the UTF8 bytes for the code point.
     void Append(base_icu::UChar32 point);
 
+    // Appends |run|, a run of ASCII characters that immediately follows the
+    // characters appended so far in the input string.
+    void AppendASCIIRun(std::string_view run);
+
     // Converts the builder from its default std::string_view to a full
     // std::string, performing a copy. Once a builder is converted, it cannot be
     // made a std::string_view again.
@@ -248,6 +252,11 @@ class BASE_EXPORT JSONParser {
   // Maximum depth to parse.
   const size_t max_depth_;
 
+  // Whether runs of plain string contents and blanks are skipped with
+  // vectorized scans (see json_scanner.h) rather than byte by byte. The
+  // result and errors are the same either way.
+  const bool vectorized_scan_;
+
   // The input stream being parsed. Note: Not guaranteed to NUL-terminated.
   std::string_view input_;
 
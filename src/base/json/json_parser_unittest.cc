@@ -9,8 +9,10 @@
 #include <memory>
 #include <optional>
 
+#include "base/features.h"
 #include "base/json/json_reader.h"
 #include "base/memory/ptr_util.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/values.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -339,5 +341,48 @@ TEST_F(JSONParserTest, ErrorMessages) {
   }
 }
 
+TEST_F(JSONParserTest, VectorizedScanMatchesScalarScan) {
+  const char* const kInputs[] = {
+      "{\"a long key that spans more than one block\": "
+      "\"and a long value that spans more than one block as well\"}",
+      "[\"escapes \\\" \\u00e9 \\n in the middle of a long string\"]",
+      "[\"non-ASCII \xC3\xA9 in the middle of a long string\"]",
+      "{\n                \"indented\": [\n\t\t\t\t1,\n\t\t\t\t2\n]}",
+      "[\"a long string that is not terminated before the end of input",
+      "[\"a long string with an unescaped\nnewline in it\"]",
+      "[\"a long string with a control \x01"
+      " character in it\"]",
+      "[\"invalid UTF-8 \xC3 in a long string\"]",
+      "                                 [1,                         2,]",
+  };
+  const int kOptions[] = {
+      JSON_PARSE_RFC, JSON_PARSE_CHROMIUM_EXTENSIONS,
+      JSON_ALLOW_TRAILING_COMMAS | JSON_ALLOW_CONTROL_CHARS |
+          JSON_REPLACE_INVALID_CHARACTERS};
+
+  for (const char* input : kInputs) {
+    for (int options : kOptions) {
+      SCOPED_TRACE(testing::Message() << input << " " << options);
+      std::optional<Value> scalar_value;
+      std::string scalar_error;
+      {
+        test::ScopedFeatureList feature_list;
+        feature_list.InitAndDisableFeature(
+            features::kJsonParserVectorizedScan);
+        JSONParser parser(options);
+        scalar_value = parser.Parse(input);
+        scalar_error = parser.GetErrorMessage();
+      }
+
+      test::ScopedFeatureList feature_list(
+          features::kJsonParserVectorizedScan);
+      JSONParser parser(options);
+      std::optional<Value> value = parser.Parse(input);
+      EXPECT_EQ(scalar_value, value);
+      EXPECT_EQ(scalar_error, parser.GetErrorMessage());
+    }
+  }
+}
+
 }  // namespace internal
 }  // namespace base
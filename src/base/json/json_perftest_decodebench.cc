@@ -16,12 +16,20 @@
 // lines per input file (individual iteration times). For a single input file,
 // building and running this program before and after a particular commit can
 // work well with the 'ministat' tool: https://github.com/thorduri/ministat
+//
+// Features can be toggled with the usual --enable-features and
+// --disable-features switches, e.g. to compare the byte-by-byte and vectorized
+// scans of the C++ parser:
+// $ out/foobar/json_perftest_decodebench -a -n=10 \
+//       --enable-features=JsonParserVectorizedScan the/path/to/your/*.json
 
 #include <inttypes.h>
 #include <iomanip>
 #include <iostream>
 
+#include "base/base_switches.h"
 #include "base/command_line.h"
+#include "base/feature_list.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
@@ -36,6 +44,9 @@ int main(int argc, char* argv[]) {
 
   base::CommandLine::Init(argc, argv);
   base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
+  base::FeatureList::InitInstance(
+      command_line->GetSwitchValueASCII(base::switches::kEnableFeatures),
+      command_line->GetSwitchValueASCII(base::switches::kDisableFeatures));
   bool average = command_line->HasSwitch("a");
   int iterations = 1;
   std::string iterations_str = command_line->GetSwitchValueASCII("n");
@@ -0,0 +1,177 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifdef UNSAFE_BUFFERS_BUILD
+// TODO(crbug.com/40284755): Remove this and spanify to fix the errors.
+#pragma allow_unsafe_buffers
+#endif
+
+#include "base/json/json_scanner.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <bit>
+
+#include "base/check_op.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace base {
+namespace internal {
+
+namespace {
+
+constexpr size_t kBlockSize = 16;
+
+bool IsPlainStringByte(char c) {
+  const unsigned char byte = static_cast<unsigned char>(c);
+  return byte >= 0x20 && byte < 0x80 && c != '"' && c != '\\';
+}
+
+bool IsBlank(char c) {
+  return c == ' ' || c == '\t';
+}
+
+#if defined(__SSE2__)
+
+// Returns a bitmask of the bytes of the 16-byte block at |p| that end a run of
+// plain string contents.
+uint32_t EndOfPlainStringRunMask(const char* p) {
+  const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  // Non-ASCII bytes are negative when compared as signed, so a single compare
+  // finds them and control characters.
+  const __m128i special = _mm_or_si128(
+      _mm_cmplt_epi8(block, _mm_set1_epi8(0x20)),
+      _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('"')),
+                   _mm_cmpeq_epi8(block, _mm_set1_epi8('\\'))));
+  return static_cast<uint32_t>(_mm_movemask_epi8(special));
+}
+
+uint32_t EndOfBlankRunMask(const char* p) {
+  const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  const __m128i blank =
+      _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')),
+                   _mm_cmpeq_epi8(block, _mm_set1_epi8('\t')));
+  return ~static_cast<uint32_t>(_mm_movemask_epi8(blank)) & 0xFFFF;
+}
+
+// Returns the offset in the block of the first byte set in |mask|.
+size_t FirstByteInMask(uint32_t mask) {
+  return static_cast<size_t>(std::countr_zero(mask));
+}
+
+#elif defined(__ARM_NEON)
+
+// NEON has no movemask instruction. Narrowing each 16-bit lane by 4 bits
+// yields a 64-bit mask with 4 bits per byte instead.
+uint64_t ToNibbleMask(uint8x16_t cmp) {
+  const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+
+uint64_t EndOfPlainStringRunMask(const char* p) {
+  const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+  const uint8x16_t special =
+      vorrq_u8(vorrq_u8(vcltq_u8(block, vdupq_n_u8(0x20)),
+                        vcgeq_u8(block, vdupq_n_u8(0x80))),
+               vorrq_u8(vceqq_u8(block, vdupq_n_u8('"')),
+                        vceqq_u8(block, vdupq_n_u8('\\'))));
+  return ToNibbleMask(special);
+}
+
+uint64_t EndOfBlankRunMask(const char* p) {
+  const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+  const uint8x16_t blank = vorrq_u8(vceqq_u8(block, vdupq_n_u8(' ')),
+                                    vceqq_u8(block, vdupq_n_u8('\t')));
+  return ToNibbleMask(vmvnq_u8(blank));
+}
+
+size_t FirstByteInMask(uint64_t mask) {
+  return static_cast<size_t>(std::countr_zero(mask)) / 4;
+}
+
+#else  // !defined(__SSE2__) && !defined(__ARM_NEON)
+
+constexpr uint64_t kOnes = 0x0101010101010101ULL;
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+
+// Returns the high bit of every byte of |word| that is zero. Bytes above the
+// first zero byte may be flagged spuriously.
+uint64_t HasZeroByte(uint64_t word) {
+  return (word - kOnes) & ~word & kHighBits;
+}
+
+// Returns non-zero if any of the 16 bytes at |p| ends a run of plain string
+// contents. The exact position is found by the caller with a byte loop, which
+// is also correct on big-endian CPUs.
+uint64_t EndOfPlainStringRunMask(const char* p) {
+  uint64_t mask = 0;
+  for (size_t i = 0; i < kBlockSize; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, p + i, sizeof(word));
+    // Bytes below 0x20 (when the high bit isn't set) and bytes of 0x80 and
+    // above.
+    mask |= ((word - 0x20 * kOnes) & ~word & kHighBits) | (word & kHighBits);
+    mask |= HasZeroByte(word ^ ('"' * kOnes));
+    mask |= HasZeroByte(word ^ ('\\' * kOnes));
+  }
+  return mask;
+}
+
+uint64_t EndOfBlankRunMask(const char* p) {
+  uint64_t first_word;
+  uint64_t second_word;
+  memcpy(&first_word, p, sizeof(first_word));
+  memcpy(&second_word, p + sizeof(first_word), sizeof(second_word));
+  // Only runs of spaces are skipped a block at a time.
+  return (first_word ^ (' ' * kOnes)) | (second_word ^ (' ' * kOnes));
+}
+
+#endif
+
+}  // namespace
+
+size_t FindEndOfPlainStringRun(std::string_view input, size_t index) {
+  DCHECK_LE(index, input.size());
+  const char* const data = input.data();
+  for (; input.size() - index >= kBlockSize; index += kBlockSize) {
+    if (auto mask = EndOfPlainStringRunMask(data + index)) {
+#if defined(__SSE2__) || defined(__ARM_NEON)
+      return index + FirstByteInMask(mask);
+#else
+      break;
+#endif
+    }
+  }
+  while (index < input.size() && IsPlainStringByte(data[index])) {
+    ++index;
+  }
+  return index;
+}
+
+size_t FindEndOfBlankRun(std::string_view input, size_t index) {
+  DCHECK_LE(index, input.size());
+  const char* const data = input.data();
+  for (; input.size() - index >= kBlockSize; index += kBlockSize) {
+    if (auto mask = EndOfBlankRunMask(data + index)) {
+#if defined(__SSE2__) || defined(__ARM_NEON)
+      return index + FirstByteInMask(mask);
+#else
+      break;
+#endif
+    }
+  }
+  while (index < input.size() && IsBlank(data[index])) {
+    ++index;
+  }
+  return index;
+}
+
+}  // namespace internal
+}  // namespace base
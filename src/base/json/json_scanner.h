@@ -0,0 +1,34 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_JSON_JSON_SCANNER_H_
+#define BASE_JSON_JSON_SCANNER_H_
+
+#include <stddef.h>
+
+#include <string_view>
+
+#include "base/base_export.h"
+
+namespace base {
+namespace internal {
+
+// Vectorized scans used by JSONParser to skip over runs of bytes that need no
+// per-byte handling. They examine 16 bytes at a time with SSE2 or NEON where
+// available, and 8 bytes at a time otherwise.
+
+// Returns the index of the first byte at or after |index| in |input| that
+// ends a run of plain string contents, i.e. the first '"', '\\', ASCII control
+// character or non-ASCII byte. Returns |input.size()| if there is none.
+BASE_EXPORT size_t FindEndOfPlainStringRun(std::string_view input,
+                                           size_t index);
+
+// Returns the index of the first byte at or after |index| in |input| that is
+// neither a space nor a tab. Returns |input.size()| if there is none.
+BASE_EXPORT size_t FindEndOfBlankRun(std::string_view input, size_t index);
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_JSON_JSON_SCANNER_H_
@@ -0,0 +1,86 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/json/json_scanner.h"
+
+#include <stddef.h>
+
+#include <iterator>
+#include <string>
+
+#include "base/rand_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+size_t ScalarEndOfPlainStringRun(std::string_view input, size_t index) {
+  while (index < input.size()) {
+    const unsigned char c = static_cast<unsigned char>(input[index]);
+    if (c < 0x20 || c >= 0x80 || c == '"' || c == '\\')
+      break;
+    ++index;
+  }
+  return index;
+}
+
+size_t ScalarEndOfBlankRun(std::string_view input, size_t index) {
+  while (index < input.size() && (input[index] == ' ' || input[index] == '\t'))
+    ++index;
+  return index;
+}
+
+}  // namespace
+
+TEST(JSONScannerTest, EndOfPlainStringRun) {
+  EXPECT_EQ(0u, FindEndOfPlainStringRun("", 0));
+  EXPECT_EQ(3u, FindEndOfPlainStringRun("abc", 0));
+  EXPECT_EQ(3u, FindEndOfPlainStringRun("abc", 3));
+  EXPECT_EQ(3u, FindEndOfPlainStringRun("abc\"def", 1));
+  EXPECT_EQ(20u, FindEndOfPlainStringRun("abcdefghijklmnopqrst\\u", 0));
+  EXPECT_EQ(17u, FindEndOfPlainStringRun("abcdefghijklmnopq\n", 2));
+  EXPECT_EQ(16u, FindEndOfPlainStringRun("abcdefghijklmnop\x01", 0));
+  EXPECT_EQ(15u, FindEndOfPlainStringRun("abcdefghijklmno\xC3\xA9", 0));
+  EXPECT_EQ(32u,
+            FindEndOfPlainStringRun("abcdefghijklmnopqrstuvwxyz012345", 0));
+}
+
+TEST(JSONScannerTest, EndOfBlankRun) {
+  EXPECT_EQ(0u, FindEndOfBlankRun("", 0));
+  EXPECT_EQ(0u, FindEndOfBlankRun("a ", 0));
+  EXPECT_EQ(2u, FindEndOfBlankRun(" \t\n", 0));
+  EXPECT_EQ(20u, FindEndOfBlankRun("                    \"", 0));
+  EXPECT_EQ(18u, FindEndOfBlankRun("\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t1", 1));
+  EXPECT_EQ(32u, FindEndOfBlankRun(std::string(32, ' '), 0));
+}
+
+// Compares with a byte-by-byte scan on random inputs mixing plain and special
+// bytes, at every alignment.
+TEST(JSONScannerTest, MatchesScalarScan) {
+  constexpr char kSpecialBytes[] = {'"', '\\', '\n', '\r', '\x01', '\x1F',
+                                    '\x7F', '\x80', '\xC3', '\xFF', '\t', ' '};
+  constexpr int kNumSpecialBytes = static_cast<int>(std::size(kSpecialBytes));
+  for (int iteration = 0; iteration < 1000; ++iteration) {
+    std::string input;
+    const size_t length = RandInt(0, 70);
+    for (size_t i = 0; i < length; ++i) {
+      if (RandInt(0, 9) == 0) {
+        input.push_back(kSpecialBytes[RandInt(0, kNumSpecialBytes - 1)]);
+      } else {
+        input.push_back(RandInt(0, 1) ? 'a' : ' ');
+      }
+    }
+    for (size_t index = 0; index <= input.size(); ++index) {
+      EXPECT_EQ(ScalarEndOfPlainStringRun(input, index),
+                FindEndOfPlainStringRun(input, index));
+      EXPECT_EQ(ScalarEndOfBlankRun(input, index),
+                FindEndOfBlankRun(input, index));
+    }
+  }
+}
+
+}  // namespace internal
+}  // namespace base
@@ -0,0 +1,584 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifdef UNSAFE_BUFFERS_BUILD
+// TODO(crbug.com/40284755): Remove this and spanify to fix the errors.
+#pragma allow_unsafe_buffers
+#endif
+
+#include "base/json/json_view.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "base/check_op.h"
+#include "base/json/json_parser.h"
+#include "base/json/json_scanner.h"
+#include "base/notreached.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversion_utils.h"
+#include "base/third_party/icu/icu_utf.h"
+
+namespace base {
+
+namespace {
+
+using internal::JSONParser;
+
+const char kInputTooLarge[] = "Input too large.";
+
+// Reads the four hex digits at |input[index]|. Returns -1 if they aren't all
+// there.
+int ReadHexCodeUnit(std::string_view input, size_t index) {
+  if (input.size() - index < 4)
+    return -1;
+  int code_unit = 0;
+  for (size_t i = index; i < index + 4; ++i) {
+    if (!IsHexDigit(input[i]))
+      return -1;
+    code_unit = code_unit * 16 + HexDigitToInt(input[i]);
+  }
+  return code_unit;
+}
+
+// Decodes the escape sequence at |raw[*index]|, which is the character after
+// the backslash, and advances |*index| past it. Returns the decoded code point,
+// or std::nullopt if the sequence is invalid in RFC 8259.
+std::optional<base_icu::UChar32> DecodeEscape(std::string_view raw,
+                                              size_t* index) {
+  const char c = raw[*index];
+  ++*index;
+  switch (c) {
+    case '"':
+    case '\\':
+    case '/':
+      return c;
+    case 'b':
+      return '\b';
+    case 'f':
+      return '\f';
+    case 'n':
+      return '\n';
+    case 'r':
+      return '\r';
+    case 't':
+      return '\t';
+    case 'u':
+      break;
+    default:
+      return std::nullopt;
+  }
+
+  const int high = ReadHexCodeUnit(raw, *index);
+  if (high < 0)
+    return std::nullopt;
+  *index += 4;
+  if (!CBU16_IS_SURROGATE(high))
+    return high;
+  if (!CBU16_IS_SURROGATE_LEAD(high) || raw.substr(*index, 2) != "\\u")
+    return std::nullopt;
+  const int low = ReadHexCodeUnit(raw, *index + 2);
+  if (low < 0 || !CBU16_IS_TRAIL(low))
+    return std::nullopt;
+  *index += 6;
+  return CBU16_GET_SUPPLEMENTARY(high, low);
+}
+
+}  // namespace
+
+// Builds the tape of a JSONView in a single pass over the document.
+class JSONView::Parser {
+ public:
+  Parser(std::string_view input, size_t max_depth)
+      : input_(input), max_depth_(max_depth) {}
+  Parser(const Parser&) = delete;
+  Parser& operator=(const Parser&) = delete;
+
+  std::optional<JSONReader::Error> Parse() {
+    if (!IsValueInRangeForNumericType<uint32_t>(input_.size())) {
+      JSONReader::Error error;
+      error.message = kInputTooLarge;
+      return error;
+    }
+    // Most documents need somewhat fewer entries than one per 8 bytes.
+    tape_.reserve(input_.size() / 8 + 1);
+
+    if (input_.starts_with("\xEF\xBB\xBF"))
+      index_ = 3;
+    if (!ParseValue(0))
+      return TakeError();
+    SkipWhitespace();
+    if (index_ != input_.size()) {
+      ReportError(JSONParser::kUnexpectedDataAfterRoot, 0);
+      return TakeError();
+    }
+    return std::nullopt;
+  }
+
+  std::vector<JSONView::Entry> TakeTape() {
+    tape_.shrink_to_fit();
+    return std::move(tape_);
+  }
+
+ private:
+  std::optional<char> PeekChar() const {
+    if (index_ >= input_.size())
+      return std::nullopt;
+    return input_[index_];
+  }
+
+  void SkipWhitespace() {
+    while (index_ < input_.size()) {
+      const char c = input_[index_];
+      if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+        return;
+      ++index_;
+      index_ = internal::FindEndOfBlankRun(input_, index_);
+    }
+  }
+
+  bool ParseValue(size_t depth) {
+    std::optional<char> c = PeekChar();
+    if (!c) {
+      ReportError(JSONParser::kSyntaxError, 1);
+      return false;
+    }
+    switch (*c) {
+      case '{':
+        return ParseDict(depth);
+      case '[':
+        return ParseList(depth);
+      case '"':
+        return ParseString();
+      case 't':
+        return ParseLiteral("true", Value::Type::BOOLEAN, true);
+      case 'f':
+        return ParseLiteral("false", Value::Type::BOOLEAN, false);
+      case 'n':
+        return ParseLiteral("null", Value::Type::NONE, false);
+      default:
+        if (*c == '-' || IsAsciiDigit(*c))
+          return ParseNumber();
+        ReportError(JSONParser::kUnexpectedToken, 1);
+        return false;
+    }
+  }
+
+  // Parses a dict or list, with |parse_item| parsing one item or entry.
+  template <typename ParseItem>
+  bool ParseContainer(size_t depth,
+                      Value::Type type,
+                      char close,
+                      ParseItem parse_item) {
+    // Skip the opening bracket.
+    ++index_;
+    if (depth + 1 > max_depth_) {
+      ReportError(JSONParser::kTooMuchNesting, 0);
+      return false;
+    }
+
+    const size_t container_index = tape_.size();
+    tape_.push_back({.type = type});
+    uint32_t size = 0;
+
+    SkipWhitespace();
+    if (PeekChar() != close) {
+      while (true) {
+        if (!parse_item(depth + 1))
+          return false;
+        ++size;
+        SkipWhitespace();
+        const std::optional<char> c = PeekChar();
+        if (c == close)
+          break;
+        if (c != ',') {
+          ReportError(JSONParser::kSyntaxError, 1);
+          return false;
+        }
+        ++index_;
+        SkipWhitespace();
+        if (PeekChar() == close) {
+          ReportError(JSONParser::kTrailingComma, 1);
+          return false;
+        }
+      }
+    }
+    // Skip the closing bracket.
+    ++index_;
+
+    Entry& container = tape_[container_index];
+    container.size = size;
+    container.end = static_cast<uint32_t>(tape_.size());
+    return true;
+  }
+
+  bool ParseDict(size_t depth) {
+    return ParseContainer(depth, Value::Type::DICT, '}', [this](size_t depth) {
+      if (PeekChar() != '"') {
+        ReportError(JSONParser::kUnquotedDictionaryKey, 1);
+        return false;
+      }
+      if (!ParseString())
+        return false;
+      SkipWhitespace();
+      if (PeekChar() != ':') {
+        ReportError(JSONParser::kSyntaxError, 1);
+        return false;
+      }
+      ++index_;
+      SkipWhitespace();
+      return ParseValue(depth);
+    });
+  }
+
+  bool ParseList(size_t depth) {
+    return ParseContainer(depth, Value::Type::LIST, ']',
+                          [this](size_t depth) { return ParseValue(depth); });
+  }
+
+  // Validates the string starting at the opening quote at |index_| and adds it
+  // to the tape. Decoding is left to JSONView::DecodeString().
+  bool ParseString() {
+    ++index_;
+    const size_t start = index_;
+    bool has_escapes = false;
+    while (true) {
+      index_ = internal::FindEndOfPlainStringRun(input_, index_);
+      if (index_ == input_.size()) {
+        ReportError(JSONParser::kSyntaxError, 0);
+        return false;
+      }
+      const unsigned char c = static_cast<unsigned char>(input_[index_]);
+      if (c == '"')
+        break;
+      if (c == '\\') {
+        has_escapes = true;
+        size_t escape_index = index_ + 1;
+        if (escape_index == input_.size() ||
+            !DecodeEscape(input_, &escape_index)) {
+          ReportError(JSONParser::kInvalidEscape, 1);
+          return false;
+        }
+        index_ = escape_index;
+      } else if (c < 0x20) {
+        ReportError(JSONParser::kUnsupportedEncoding, 0);
+        return false;
+      } else {
+        base_icu::UChar32 code_point;
+        if (!ReadUnicodeCharacter(input_.data(), input_.size(), &index_,
+                                  &code_point)) {
+          ReportError(JSONParser::kUnsupportedEncoding, 1);
+          return false;
+        }
+        ++index_;
+      }
+    }
+
+    Entry entry = {.type = Value::Type::STRING, .has_escapes = has_escapes};
+    entry.string.offset = static_cast<uint32_t>(start);
+    entry.string.length = static_cast<uint32_t>(index_ - start);
+    tape_.push_back(entry);
+    // Skip the closing quote.
+    ++index_;
+    return true;
+  }
+
+  bool ParseLiteral(std::string_view literal, Value::Type type, bool value) {
+    if (input_.substr(index_, literal.size()) != literal) {
+      ReportError(JSONParser::kSyntaxError, 1);
+      return false;
+    }
+    index_ += literal.size();
+    Entry entry = {.type = type};
+    entry.bool_value = value;
+    tape_.push_back(entry);
+    return true;
+  }
+
+  // Skips a run of digits, returning how many there were.
+  size_t SkipDigits() {
+    const size_t start = index_;
+    while (index_ < input_.size() && IsAsciiDigit(input_[index_]))
+      ++index_;
+    return index_ - start;
+  }
+
+  // Parses a number with the grammar and conversions of JSONParser.
+  bool ParseNumber() {
+    const size_t start = index_;
+    if (PeekChar() == '-')
+      ++index_;
+    const size_t int_start = index_;
+    const size_t int_length = SkipDigits();
+    if (int_length == 0 || (int_length > 1 && input_[int_start] == '0')) {
+      ReportError(JSONParser::kSyntaxError, 1);
+      return false;
+    }
+    if (PeekChar() == '.') {
+      ++index_;
+      if (!SkipDigits()) {
+        ReportError(JSONParser::kSyntaxError, 1);
+        return false;
+      }
+    }
+    const std::optional<char> c = PeekChar();
+    if (c == 'e' || c == 'E') {
+      ++index_;
+      if (PeekChar() == '-' || PeekChar() == '+')
+        ++index_;
+      if (!SkipDigits()) {
+        ReportError(JSONParser::kSyntaxError, 1);
+        return false;
+      }
+    }
+
+    const std::string_view number = input_.substr(start, index_ - start);
+    Entry entry;
+    int int_value;
+    double double_value;
+    if (StringToInt(number, &int_value)) {
+      // Keep the sign of `-0`.
+      if (int_value == 0 && number.starts_with('-')) {
+        entry = {.type = Value::Type::DOUBLE};
+        entry.double_value = -0.0;
+      } else {
+        entry = {.type = Value::Type::INTEGER};
+        entry.int_value = int_value;
+      }
+    } else if (StringToDouble(number, &double_value) &&
+               std::isfinite(double_value)) {
+      entry = {.type = Value::Type::DOUBLE};
+      entry.double_value = double_value;
+    } else {
+      index_ = start;
+      ReportError(JSONParser::kUnrepresentableNumber, 1);
+      return false;
+    }
+    tape_.push_back(entry);
+    return true;
+  }
+
+  // Records an error at |index_|, adjusted by |column_adjust| to get a 1-based
+  // column. Lines are counted only when there is an error.
+  void ReportError(const char* description, int column_adjust) {
+    int line = 1;
+    size_t line_start = 0;
+    for (size_t i = 0; i < index_ && i < input_.size(); ++i) {
+      if (input_[i] == '\n' || input_[i] == '\r') {
+        // "\r\n" is a single line break.
+        if (input_[i] == '\r' || i == 0 || input_[i - 1] != '\r')
+          ++line;
+        line_start = i + 1;
+      }
+    }
+    error_.line = line;
+    error_.column =
+        std::max(1, static_cast<int>(index_ - line_start) + column_adjust);
+    error_.message = StringPrintf("Line: %i, column: %i, %s", error_.line,
+                                  error_.column, description);
+  }
+
+  JSONReader::Error TakeError() { return std::move(error_); }
+
+  const std::string_view input_;
+  const size_t max_depth_;
+  std::vector<JSONView::Entry> tape_;
+  size_t index_ = 0;
+  JSONReader::Error error_;
+};
+
+// static
+expected<JSONView, JSONReader::Error> JSONView::Parse(std::string json,
+                                                      size_t max_depth) {
+  JSONView view(std::move(json));
+  Parser parser(view.json_, max_depth);
+  if (std::optional<JSONReader::Error> error = parser.Parse())
+    return unexpected(std::move(*error));
+  view.tape_ = parser.TakeTape();
+  return view;
+}
+
+JSONView::JSONView(std::string json) : json_(std::move(json)) {}
+
+JSONView::JSONView(JSONView&&) = default;
+
+JSONView& JSONView::operator=(JSONView&&) = default;
+
+JSONView::~JSONView() = default;
+
+JSONView::Node JSONView::root() const {
+  DCHECK(!tape_.empty());
+  return Node(this, 0);
+}
+
+uint32_t JSONView::NextSibling(uint32_t index) const {
+  const Entry& entry = tape_[index];
+  if (entry.type == Value::Type::DICT || entry.type == Value::Type::LIST)
+    return entry.end;
+  return index + 1;
+}
+
+std::string_view JSONView::RawString(const Entry& entry) const {
+  DCHECK_EQ(entry.type, Value::Type::STRING);
+  return std::string_view(json_).substr(entry.string.offset,
+                                        entry.string.length);
+}
+
+std::string JSONView::DecodeString(const Entry& entry) const {
+  const std::string_view raw = RawString(entry);
+  if (!entry.has_escapes)
+    return std::string(raw);
+
+  std::string decoded;
+  decoded.reserve(raw.size());
+  size_t index = 0;
+  while (index < raw.size()) {
+    const size_t escape = raw.find('\\', index);
+    decoded.append(raw.substr(index, escape - index));
+    if (escape == std::string_view::npos)
+      break;
+    index = escape + 1;
+    // The escape sequences were validated by the parser.
+    std::optional<base_icu::UChar32> code_point = DecodeEscape(raw, &index);
+    CHECK(code_point);
+    WriteUnicodeCharacter(*code_point, &decoded);
+  }
+  return decoded;
+}
+
+bool JSONView::StringEquals(const Entry& entry, std::string_view str) const {
+  if (!entry.has_escapes)
+    return RawString(entry) == str;
+  // A decoded string is never longer than its escaped form.
+  if (str.size() > entry.string.length)
+    return false;
+  return DecodeString(entry) == str;
+}
+
+Value JSONView::BuildValue(uint32_t index) const {
+  const Entry& entry = tape_[index];
+  switch (entry.type) {
+    case Value::Type::NONE:
+      return Value();
+    case Value::Type::BOOLEAN:
+      return Value(entry.bool_value);
+    case Value::Type::INTEGER:
+      return Value(entry.int_value);
+    case Value::Type::DOUBLE:
+      return Value(entry.double_value);
+    case Value::Type::STRING:
+      return Value(DecodeString(entry));
+    case Value::Type::LIST: {
+      Value::List list;
+      list.reserve(entry.size);
+      for (uint32_t i = index + 1; i < entry.end; i = NextSibling(i))
+        list.Append(BuildValue(i));
+      return Value(std::move(list));
+    }
+    case Value::Type::DICT: {
+      Value::Dict dict;
+      for (uint32_t i = index + 1; i < entry.end;) {
+        std::string key = DecodeString(tape_[i]);
+        dict.Set(key, BuildValue(i + 1));
+        i = NextSibling(i + 1);
+      }
+      return Value(std::move(dict));
+    }
+    case Value::Type::BINARY:
+      break;
+  }
+  NOTREACHED_NORETURN();
+}
+
+JSONView::Node::Node(const JSONView* view, uint32_t index)
+    : view_(view), index_(index) {}
+
+JSONView::Node::Node(const Node&) = default;
+
+JSONView::Node& JSONView::Node::operator=(const Node&) = default;
+
+JSONView::Node::~Node() = default;
+
+Value::Type JSONView::Node::type() const {
+  return view_->tape_[index_].type;
+}
+
+std::optional<bool> JSONView::Node::GetIfBool() const {
+  if (!is_bool())
+    return std::nullopt;
+  return view_->tape_[index_].bool_value;
+}
+
+std::optional<int> JSONView::Node::GetIfInt() const {
+  if (!is_int())
+    return std::nullopt;
+  return view_->tape_[index_].int_value;
+}
+
+std::optional<double> JSONView::Node::GetIfDouble() const {
+  if (is_int())
+    return view_->tape_[index_].int_value;
+  if (!is_double())
+    return std::nullopt;
+  return view_->tape_[index_].double_value;
+}
+
+std::optional<std::string> JSONView::Node::GetIfString() const {
+  if (!is_string())
+    return std::nullopt;
+  return view_->DecodeString(view_->tape_[index_]);
+}
+
+size_t JSONView::Node::size() const {
+  if (!is_dict() && !is_list())
+    return 0;
+  return view_->tape_[index_].size;
+}
+
+std::optional<JSONView::Node> JSONView::Node::Find(std::string_view key) const {
+  if (!is_dict())
+    return std::nullopt;
+  std::optional<Node> found;
+  const uint32_t end = view_->tape_[index_].end;
+  for (uint32_t i = index_ + 1; i < end; i = view_->NextSibling(i + 1)) {
+    if (view_->StringEquals(view_->tape_[i], key))
+      found = Node(view_, i + 1);
+  }
+  return found;
+}
+
+std::optional<JSONView::Node> JSONView::Node::FindByDottedPath(
+    std::string_view path) const {
+  std::optional<Node> current = *this;
+  size_t start = 0;
+  while (current) {
+    const size_t dot = path.find('.', start);
+    if (dot == std::string_view::npos)
+      return current->Find(path.substr(start));
+    current = current->Find(path.substr(start, dot - start));
+    start = dot + 1;
+  }
+  return std::nullopt;
+}
+
+std::vector<JSONView::Node> JSONView::Node::GetListItems() const {
+  std::vector<Node> items;
+  if (!is_list())
+    return items;
+  const Entry& entry = view_->tape_[index_];
+  items.reserve(entry.size);
+  for (uint32_t i = index_ + 1; i < entry.end; i = view_->NextSibling(i))
+    items.push_back(Node(view_, i));
+  return items;
+}
+
+Value JSONView::Node::ToValue() const {
+  return view_->BuildValue(index_);
+}
+
+}  // namespace base
@@ -0,0 +1,162 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_JSON_JSON_VIEW_H_
+#define BASE_JSON_JSON_VIEW_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/json/json_common.h"
+#include "base/json/json_reader.h"
+#include "base/memory/raw_ptr.h"
+#include "base/types/expected.h"
+#include "base/values.h"
+
+namespace base {
+
+// JSONView is a read-only view of a JSON document that doesn't build a
+// base::Value tree up front. Parsing validates the document and records it as
+// a flat "tape" of 16-byte entries that refer back into the original buffer,
+// which the view owns. Strings are decoded, and base::Value subtrees built,
+// only when they are asked for.
+//
+// This is useful when a large document is parsed but only a few of its fields
+// are read:
+//
+//   ASSIGN_OR_RETURN(JSONView view, JSONView::Parse(std::move(json)));
+//   std::optional<JSONView::Node> name = view.root().FindByDottedPath(
+//       "data.user.name");
+//   if (name && name->is_string()) {
+//     Use(*name->GetIfString());
+//   }
+//
+// Input is parsed strictly according to RFC 8259, matching
+// JSONReader::Read(json, JSON_PARSE_RFC): the same documents are accepted and
+// ToValue() on the root gives the same base::Value.
+class BASE_EXPORT JSONView {
+ public:
+  // A reference to one value in the view. Nodes are cheap to copy, and are
+  // invalidated when their JSONView is moved or destroyed.
+  class BASE_EXPORT Node {
+   public:
+    Node(const Node&);
+    Node& operator=(const Node&);
+    ~Node();
+
+    Value::Type type() const;
+    bool is_none() const { return type() == Value::Type::NONE; }
+    bool is_bool() const { return type() == Value::Type::BOOLEAN; }
+    bool is_int() const { return type() == Value::Type::INTEGER; }
+    bool is_double() const { return type() == Value::Type::DOUBLE; }
+    bool is_string() const { return type() == Value::Type::STRING; }
+    bool is_dict() const { return type() == Value::Type::DICT; }
+    bool is_list() const { return type() == Value::Type::LIST; }
+
+    // These return std::nullopt if the node has a different type. As with
+    // base::Value, GetIfDouble() also converts integers. Strings are decoded
+    // on every call; strings without escape sequences are copied straight
+    // from the buffer.
+    std::optional<bool> GetIfBool() const;
+    std::optional<int> GetIfInt() const;
+    std::optional<double> GetIfDouble() const;
+    std::optional<std::string> GetIfString() const;
+
+    // Returns the number of items of a list or entries of a dict, and 0 for
+    // other types.
+    size_t size() const;
+
+    // Looks up |key| in a dict, without decoding or copying keys that have no
+    // escape sequences. If a key appears more than once, the last entry wins,
+    // as with JSONReader. Returns std::nullopt if this node isn't a dict or
+    // has no such key.
+    std::optional<Node> Find(std::string_view key) const;
+
+    // Like Find(), but follows a path of keys separated by '.'.
+    std::optional<Node> FindByDottedPath(std::string_view path) const;
+
+    // Returns the items of a list, or nothing for other types.
+    std::vector<Node> GetListItems() const;
+
+    // Builds a base::Value for this node and everything below it.
+    Value ToValue() const;
+
+   private:
+    friend class JSONView;
+
+    Node(const JSONView* view, uint32_t index);
+
+    raw_ptr<const JSONView> view_;
+    // Index of this node's entry in the tape.
+    uint32_t index_;
+  };
+
+  // Parses |json|, taking ownership of the buffer. On failure, returns the
+  // same kind of error JSONReader::ReadAndReturnValueWithError() does.
+  static expected<JSONView, JSONReader::Error> Parse(
+      std::string json,
+      size_t max_depth = internal::kAbsoluteMaxDepth);
+
+  JSONView(JSONView&&);
+  JSONView& operator=(JSONView&&);
+  ~JSONView();
+
+  // Returns the top-level value.
+  Node root() const;
+
+  // Returns the document the view refers to.
+  std::string_view json() const { return json_; }
+
+  size_t tape_size_for_testing() const { return tape_.size(); }
+
+ private:
+  class Parser;
+
+  struct Entry {
+    Value::Type type;
+    // For strings: whether the contents contain escape sequences.
+    bool has_escapes = false;
+    // For lists and dicts: the number of items or entries.
+    uint32_t size = 0;
+    union {
+      bool bool_value;
+      int int_value;
+      double double_value;
+      // For strings, including dict keys: the contents, between the quotes.
+      struct {
+        uint32_t offset;
+        uint32_t length;
+      } string;
+      // For lists and dicts: the index of the first entry after the
+      // container's last descendant.
+      uint32_t end;
+    };
+  };
+  static_assert(sizeof(Entry) == 16, "Keep the tape compact");
+
+  explicit JSONView(std::string json);
+
+  // Returns the index of the first entry after |index| and its descendants.
+  uint32_t NextSibling(uint32_t index) const;
+  std::string_view RawString(const Entry& entry) const;
+  std::string DecodeString(const Entry& entry) const;
+  // Whether the string or key at |entry| decodes to |str|.
+  bool StringEquals(const Entry& entry, std::string_view str) const;
+  Value BuildValue(uint32_t index) const;
+
+  std::string json_;
+  // Values in document order. Lists are followed by their items and dicts by
+  // alternating key and value entries.
+  std::vector<Entry> tape_;
+};
+
+}  // namespace base
+
+#endif  // BASE_JSON_JSON_VIEW_H_
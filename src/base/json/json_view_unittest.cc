@@ -0,0 +1,151 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/json/json_view.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/json/json_reader.h"
+#include "base/test/gmock_expected_support.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+TEST(JSONViewTest, MatchesJSONReader) {
+  const char* const kInputs[] = {
+      "null",
+      "true",
+      " false ",
+      "0",
+      "-0",
+      "-12",
+      "2147483648",
+      "1.5e3",
+      "[]",
+      "{}",
+      R"("plain")",
+      R"("esc\"aped\\\/\b\f\n\r\t")",
+      R"("\u00e9\ud83d\ude00")",
+      "\"\xC3\xA9t\xC3\xA9\"",
+      R"({"a": [1, 2.5, {"b": null}], "c": "d", "a": "last wins"})",
+      "[[[[\"x\"]]], {\"k\\u0041\": {}}]",
+      "{\r\n  \"list\": [true,false],\n\t\"n\": -1e-3\n}",
+  };
+  for (const char* input : kInputs) {
+    SCOPED_TRACE(input);
+    std::optional<Value> expected = JSONReader::Read(input, JSON_PARSE_RFC);
+    ASSERT_TRUE(expected);
+    ASSERT_OK_AND_ASSIGN(JSONView view, JSONView::Parse(input));
+    EXPECT_EQ(*expected, view.root().ToValue());
+  }
+}
+
+TEST(JSONViewTest, RejectsInvalidInput) {
+  const char* const kInputs[] = {
+      "",
+      " ",
+      "nul",
+      "01",
+      "1.",
+      "-",
+      "1e999",
+      "[1,]",
+      "{\"a\":1,}",
+      "[1 2]",
+      "{a: 1}",
+      "{\"a\" 1}",
+      "\"unterminated",
+      R"("\x41")",
+      R"("\v")",
+      R"("\u12")",
+      R"("\ud83d")",
+      R"("\ude00")",
+      "\"new\nline\"",
+      "\"\xC3\"",
+      "[1] 2",
+      "/* comment */ 1",
+  };
+  for (const char* input : kInputs) {
+    SCOPED_TRACE(input);
+    EXPECT_FALSE(JSONReader::Read(input, JSON_PARSE_RFC));
+    EXPECT_FALSE(JSONView::Parse(input).has_value());
+  }
+}
+
+TEST(JSONViewTest, ErrorPosition) {
+  auto result = JSONView::Parse("{\n  \"a\": 1,\n  \"b\": tru\n}");
+  ASSERT_FALSE(result.has_value());
+  EXPECT_EQ(3, result.error().line);
+  EXPECT_EQ(8, result.error().column);
+  EXPECT_EQ("Line: 3, column: 8, Syntax error.", result.error().message);
+}
+
+TEST(JSONViewTest, MaxDepth) {
+  EXPECT_TRUE(JSONView::Parse("[[1]]", 2).has_value());
+  EXPECT_FALSE(JSONView::Parse("[[[1]]]", 2).has_value());
+  EXPECT_FALSE(JSONReader::Read("[[[1]]]", JSON_PARSE_RFC, 2));
+}
+
+TEST(JSONViewTest, Find) {
+  ASSERT_OK_AND_ASSIGN(
+      JSONView view,
+      JSONView::Parse(R"({"id": 7, "data": {"user": {"name": "Ann"}},
+                          "ok": true, "ratio": 0.5, "id": 8})"));
+  const JSONView::Node root = view.root();
+  EXPECT_TRUE(root.is_dict());
+  EXPECT_EQ(5u, root.size());
+
+  std::optional<JSONView::Node> id = root.Find("id");
+  ASSERT_TRUE(id);
+  EXPECT_EQ(8, id->GetIfInt());
+  EXPECT_EQ(8.0, id->GetIfDouble());
+  EXPECT_FALSE(id->GetIfString());
+
+  std::optional<JSONView::Node> name = root.FindByDottedPath("data.user.name");
+  ASSERT_TRUE(name);
+  EXPECT_EQ("Ann", name->GetIfString());
+
+  EXPECT_EQ(true, root.Find("ok")->GetIfBool());
+  EXPECT_EQ(0.5, root.Find("ratio")->GetIfDouble());
+  EXPECT_FALSE(root.Find("ratio")->GetIfInt());
+  EXPECT_FALSE(root.Find("missing"));
+  EXPECT_FALSE(root.FindByDottedPath("data.missing.name"));
+  EXPECT_FALSE(root.FindByDottedPath("id.name"));
+  EXPECT_FALSE(id->Find("id"));
+}
+
+TEST(JSONViewTest, ListItems) {
+  ASSERT_OK_AND_ASSIGN(JSONView view,
+                       JSONView::Parse(R"([1, [2, 3], {"a": [4]}, "five"])"));
+  const JSONView::Node root = view.root();
+  EXPECT_EQ(4u, root.size());
+  std::vector<JSONView::Node> items = root.GetListItems();
+  ASSERT_EQ(4u, items.size());
+  EXPECT_EQ(1, items[0].GetIfInt());
+  EXPECT_EQ(Value(Value::List().Append(2).Append(3)), items[1].ToValue());
+  EXPECT_TRUE(items[2].is_dict());
+  EXPECT_EQ(1u, items[2].Find("a")->size());
+  EXPECT_EQ("five", items[3].GetIfString());
+  EXPECT_TRUE(items[3].GetListItems().empty());
+}
+
+TEST(JSONViewTest, TapeIsCompact) {
+  // One entry per value and per key.
+  ASSERT_OK_AND_ASSIGN(JSONView view,
+                       JSONView::Parse(R"({"a": [1, 2], "b": "long string"})"));
+  EXPECT_EQ(7u, view.tape_size_for_testing());
+}
+
+TEST(JSONViewTest, MovedViewStaysValid) {
+  // Tape entries refer to the buffer by offset, so moving a view whose
+  // document fits in the small string buffer keeps it valid.
+  ASSERT_OK_AND_ASSIGN(JSONView view, JSONView::Parse(R"({"a":"b"})"));
+  JSONView moved = std::move(view);
+  EXPECT_EQ("b", moved.root().Find("a")->GetIfString());
+}
+
+}  // namespace base
@@ -10,6 +10,8 @@
 #include <limits>
 #include <string_view>
 
+#include "base/containers/span.h"
+#include "base/files/file.h"
 #include "base/json/string_escape.h"
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
@@ -25,6 +27,28 @@ const char kPrettyPrintLineEnding[] = "\r\n";
 const char kPrettyPrintLineEnding[] = "\n";
 #endif
 
+namespace {
+
+// Size past which output is handed over to a JSONSink. Chunks can be larger
+// when a single string or number is.
+constexpr size_t kSinkChunkSize = 64 * 1024;
+
+}  // namespace
+
+FileJSONSink::FileJSONSink(File* file) : file_(file) {
+  DCHECK(file_->IsValid());
+}
+
+FileJSONSink::~FileJSONSink() = default;
+
+bool FileJSONSink::Write(std::string_view chunk) {
+  if (!file_->WriteAtCurrentPosAndCheck(as_byte_span(chunk))) {
+    return false;
+  }
+  bytes_written_ += chunk.size();
+  return true;
+}
+
 // static
 bool JSONWriter::Write(ValueView node, std::string* json, size_t max_depth) {
   return WriteWithOptions(node, 0, json, max_depth);
@@ -157,6 +181,9 @@ bool JSONWriter::BuildJSONString(const Value::Dict& node, size_t depth) {
     result &= value.Visit([this, depth = depth + 1](const auto& member) {
       return BuildJSONString(member, depth);
     });
+    if (!MaybeFlushToSink()) {
+      return false;
+    }
 
     first_value_has_been_output = true;
   }
@@ -201,6 +228,9 @@ bool JSONWriter::BuildJSONString(const Value::List& node, size_t depth) {
     result &= value.Visit([this, depth](const auto& member) {
       return BuildJSONString(member, depth);
     });
+    if (!MaybeFlushToSink()) {
+      return false;
+    }
 
     first_value_has_been_output = true;
   }
@@ -216,6 +246,25 @@ void JSONWriter::IndentLine(size_t depth) {
   json_string_->append(depth * 3U, ' ');
 }
 
+bool JSONWriter::MaybeFlushToSink() {
+  if (!sink_) {
+    return true;
+  }
+  if (json_string_->size() < kSinkChunkSize) {
+    return !sink_failed_;
+  }
+  return FlushToSink();
+}
+
+bool JSONWriter::FlushToSink() {
+  DCHECK(sink_);
+  if (!sink_failed_ && !json_string_->empty()) {
+    sink_failed_ = !sink_->Write(*json_string_);
+  }
+  json_string_->clear();
+  return !sink_failed_;
+}
+
 std::optional<std::string> WriteJson(ValueView node, size_t max_depth) {
   std::string result;
   if (!JSONWriter::Write(node, &result, max_depth)) {
@@ -235,4 +284,27 @@ std::optional<std::string> WriteJsonWithOptions(ValueView node,
   return result;
 }
 
+bool WriteJsonToSink(ValueView node,
+                     uint32_t options,
+                     JSONSink& sink,
+                     size_t max_depth) {
+  // Leave room for the element that pushes the buffer past a chunk.
+  std::string buffer;
+  buffer.reserve(kSinkChunkSize * 2);
+
+  JSONWriter writer(static_cast<int>(options), &buffer, max_depth);
+  writer.sink_ = &sink;
+  bool result = node.Visit([&writer](const auto& member) {
+    return writer.BuildJSONString(member, 0);
+  });
+  if (!result) {
+    return false;
+  }
+
+  if (options & OPTIONS_PRETTY_PRINT) {
+    buffer.append(kPrettyPrintLineEnding);
+  }
+  return writer.FlushToSink();
+}
+
 }  // namespace base
@@ -59,6 +59,49 @@ BASE_EXPORT std::optional<std::string> WriteJsonWithOptions(
     uint32_t options,
     size_t max_depth = internal::kAbsoluteMaxDepth);
 
+class File;
+
+// Receives the output of WriteJsonToSink() in chunks, so that large values can
+// be written out without first building the whole JSON string in memory.
+class BASE_EXPORT JSONSink {
+ public:
+  virtual ~JSONSink() = default;
+
+  // Consumes the next |chunk| of output. Returning false aborts the write.
+  virtual bool Write(std::string_view chunk) = 0;
+};
+
+// A JSONSink that writes to the current position of a file.
+class BASE_EXPORT FileJSONSink : public JSONSink {
+ public:
+  // |file| must be valid and outlive this sink.
+  explicit FileJSONSink(File* file);
+  FileJSONSink(const FileJSONSink&) = delete;
+  FileJSONSink& operator=(const FileJSONSink&) = delete;
+  ~FileJSONSink() override;
+
+  // JSONSink:
+  bool Write(std::string_view chunk) override;
+
+  // Number of bytes written so far.
+  size_t bytes_written() const { return bytes_written_; }
+
+ private:
+  const raw_ptr<File> file_;
+  size_t bytes_written_ = 0;
+};
+
+// Like WriteJsonWithOptions(), but writes the JSON to `sink` in chunks of a
+// bounded size as it is generated.
+//
+// Returns false if the JSON could not be generated or if `sink` failed, in
+// which case `sink` may have received part of the output.
+BASE_EXPORT bool WriteJsonToSink(
+    ValueView node,
+    uint32_t options,
+    JSONSink& sink,
+    size_t max_depth = internal::kAbsoluteMaxDepth);
+
 class BASE_EXPORT JSONWriter {
  public:
   using Options = JsonOptions;
@@ -96,6 +139,11 @@ class BASE_EXPORT JSONWriter {
                                size_t max_depth = internal::kAbsoluteMaxDepth);
 
  private:
+  friend bool WriteJsonToSink(ValueView node,
+                              uint32_t options,
+                              JSONSink& sink,
+                              size_t max_depth);
+
   JSONWriter(int options,
              std::string* json,
              size_t max_depth = internal::kAbsoluteMaxDepth);
@@ -114,6 +162,14 @@ class BASE_EXPORT JSONWriter {
   // Adds space to json_string_ for the indent level.
   void IndentLine(size_t depth);
 
+  // If writing to a sink, hands |json_string_| over to it once it has grown
+  // past a chunk. Returns false if the sink failed.
+  bool MaybeFlushToSink();
+
+  // Hands |json_string_| over to |sink_| and clears it. Returns false if the
+  // sink failed, now or earlier.
+  bool FlushToSink();
+
   bool omit_binary_values_;
   bool omit_double_type_preservation_;
   bool pretty_print_;
@@ -121,6 +177,11 @@ class BASE_EXPORT JSONWriter {
   // Where we write JSON data as we generate it.
   raw_ptr<std::string> json_string_;
 
+  // If set, |json_string_| only buffers the output until it is handed over to
+  // this sink.
+  raw_ptr<JSONSink> sink_ = nullptr;
+  bool sink_failed_ = false;
+
   // Maximum depth to write.
   const size_t max_depth_;
 
@@ -9,10 +9,15 @@
 
 #include "base/json/json_writer.h"
 
+#include <limits>
 #include <optional>
+#include <string>
+#include <vector>
 
 #include "base/containers/span.h"
 #include "base/json/json_reader.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
 #include "base/test/gmock_expected_support.h"
 #include "base/values.h"
@@ -237,4 +242,68 @@ TEST(JsonWriterTest, JSONWriterWriteWithOptionsFailure) {
       JSONWriter::OPTIONS_PRETTY_PRINT, &output_js, /*max_depth=*/1));
 }
 
+namespace {
+
+// Collects the chunks it receives, optionally failing after |max_chunks|.
+class TestJSONSink : public JSONSink {
+ public:
+  explicit TestJSONSink(size_t max_chunks = std::numeric_limits<size_t>::max())
+      : max_chunks_(max_chunks) {}
+
+  bool Write(std::string_view chunk) override {
+    if (chunks_.size() == max_chunks_) {
+      return false;
+    }
+    chunks_.emplace_back(chunk);
+    return true;
+  }
+
+  const std::vector<std::string>& chunks() const { return chunks_; }
+  std::string output() const { return base::StrCat(chunks_); }
+
+ private:
+  const size_t max_chunks_;
+  std::vector<std::string> chunks_;
+};
+
+Value::Dict MakeLargeDict() {
+  Value::Dict dict;
+  for (int i = 0; i < 500; ++i) {
+    Value::List list;
+    list.Append(std::string(1000, 'a'));
+    list.Append(i);
+    dict.Set(NumberToString(i), std::move(list));
+  }
+  return dict;
+}
+
+}  // namespace
+
+TEST(JsonWriterTest, WriteToSink) {
+  const Value::Dict dict = MakeLargeDict();
+  for (uint32_t options : {0u, static_cast<uint32_t>(OPTIONS_PRETTY_PRINT)}) {
+    TestJSONSink sink;
+    EXPECT_TRUE(WriteJsonToSink(dict, options, sink));
+    EXPECT_GT(sink.chunks().size(), 1u);
+    EXPECT_EQ(WriteJsonWithOptions(dict, options), sink.output());
+  }
+
+  TestJSONSink sink;
+  EXPECT_TRUE(WriteJsonToSink(Value(true), 0, sink));
+  EXPECT_EQ("true", sink.output());
+}
+
+TEST(JsonWriterTest, WriteToSinkFailure) {
+  // The sink fails.
+  TestJSONSink failing_sink(/*max_chunks=*/1);
+  EXPECT_FALSE(WriteJsonToSink(MakeLargeDict(), 0, failing_sink));
+  EXPECT_EQ(1u, failing_sink.chunks().size());
+
+  // The value can't be serialized.
+  TestJSONSink sink;
+  EXPECT_FALSE(WriteJsonToSink(
+      Value::Dict().Set("key", Value::Dict().Set("nested-key", Value::Dict())),
+      0, sink, /*max_depth=*/1));
+}
+
 }  // namespace base
@@ -6,6 +6,7 @@
 
 #include <atomic>
 
+#include "base/memory/memory_pressure_monitor.h"
 #include "base/observer_list.h"
 #include "base/observer_list_threadsafe.h"
 #include "base/task/sequenced_task_runner.h"
@@ -96,7 +97,59 @@ MemoryPressureListener::~MemoryPressureListener() {
   GetMemoryPressureObserver()->RemoveObserver(this);
 }
 
+// static
+TimeDelta MemoryPressureListener::GetReactionDelay(ReactionStage stage) {
+  switch (stage) {
+    case ReactionStage::kImmediate:
+      return TimeDelta();
+    case ReactionStage::kDeferred:
+      return Seconds(1);
+    case ReactionStage::kLast:
+      return Seconds(3);
+  }
+}
+
+void MemoryPressureListener::SetReactionStage(ReactionStage stage) {
+  reaction_stage_ = stage;
+}
+
 void MemoryPressureListener::Notify(MemoryPressureLevel memory_pressure_level) {
+  if (memory_pressure_level == MEMORY_PRESSURE_LEVEL_MODERATE &&
+      reaction_stage_ != ReactionStage::kImmediate) {
+    if (!deferred_callback_pending_) {
+      deferred_callback_pending_ = true;
+      SequencedTaskRunner::GetCurrentDefault()->PostDelayedTask(
+          FROM_HERE,
+          BindOnce(&MemoryPressureListener::RunDeferredCallback,
+                   weak_ptr_factory_.GetWeakPtr()),
+          GetReactionDelay(reaction_stage_));
+    }
+    return;
+  }
+
+  // A pending reaction to moderate pressure is superseded by the reaction to
+  // critical pressure.
+  if (deferred_callback_pending_) {
+    weak_ptr_factory_.InvalidateWeakPtrs();
+    deferred_callback_pending_ = false;
+  }
+  RunCallback(memory_pressure_level);
+}
+
+void MemoryPressureListener::RunDeferredCallback() {
+  DCHECK(deferred_callback_pending_);
+  deferred_callback_pending_ = false;
+
+  const MemoryPressureMonitor* monitor = MemoryPressureMonitor::Get();
+  if (monitor &&
+      monitor->GetCurrentPressureLevel() == MEMORY_PRESSURE_LEVEL_NONE) {
+    return;
+  }
+  RunCallback(MEMORY_PRESSURE_LEVEL_MODERATE);
+}
+
+void MemoryPressureListener::RunCallback(
+    MemoryPressureLevel memory_pressure_level) {
   TRACE_EVENT(
       "base", "MemoryPressureListener::Notify",
       [&](perfetto::EventContext ctx) {
@@ -13,6 +13,8 @@
 #include "base/base_export.h"
 #include "base/functional/callback.h"
 #include "base/location.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
 #include "base/tracing_buildflags.h"
 
 namespace base {
@@ -44,6 +46,10 @@ namespace base {
 //    // Stop listening.
 //    listener.reset();
 //
+// Listeners whose memory is expensive to re-create can react to moderate
+// pressure in a later stage with SetReactionStage(), so that cheap caches are
+// trimmed first and all listeners don't react at once.
+//
 class BASE_EXPORT MemoryPressureListener {
  public:
   // A Java counterpart will be generated for this enum.
@@ -72,6 +78,16 @@ class BASE_EXPORT MemoryPressureListener {
     kMaxValue = MEMORY_PRESSURE_LEVEL_CRITICAL,
   };
 
+  // The stage in which a listener reacts to moderate memory pressure. Listeners
+  // in a later stage are notified after a delay, and not at all if the pressure
+  // subsided in the meantime. Critical memory pressure is always notified
+  // immediately.
+  enum class ReactionStage {
+    kImmediate,
+    kDeferred,
+    kLast,
+  };
+
   using MemoryPressureCallback = RepeatingCallback<void(MemoryPressureLevel)>;
   using SyncMemoryPressureCallback =
       RepeatingCallback<void(MemoryPressureLevel)>;
@@ -89,6 +105,15 @@ class BASE_EXPORT MemoryPressureListener {
 
   ~MemoryPressureListener();
 
+  // Returns the delay between a moderate memory pressure notification and the
+  // reaction of the listeners in `stage`.
+  static TimeDelta GetReactionDelay(ReactionStage stage);
+
+  // Sets the stage in which this listener reacts to moderate memory pressure.
+  // Defaults to ReactionStage::kImmediate. Must be called on the sequence that
+  // created the listener.
+  void SetReactionStage(ReactionStage stage);
+
   // Intended for use by the platform specific implementation.
   static void NotifyMemoryPressure(MemoryPressureLevel memory_pressure_level);
 
@@ -106,10 +131,24 @@ class BASE_EXPORT MemoryPressureListener {
  private:
   static void DoNotifyMemoryPressure(MemoryPressureLevel memory_pressure_level);
 
+  void RunCallback(MemoryPressureLevel memory_pressure_level);
+
+  // Runs the callback for moderate pressure that was deferred according to
+  // `reaction_stage_`, unless the pressure subsided.
+  void RunDeferredCallback();
+
   MemoryPressureCallback callback_;
   SyncMemoryPressureCallback sync_memory_pressure_callback_;
 
   const base::Location creation_location_;
+
+  ReactionStage reaction_stage_ = ReactionStage::kImmediate;
+
+  // Whether a deferred callback is posted. Notifications received in the
+  // meantime are coalesced into it.
+  bool deferred_callback_pending_ = false;
+
+  WeakPtrFactory<MemoryPressureListener> weak_ptr_factory_{this};
 };
 
 }  // namespace base
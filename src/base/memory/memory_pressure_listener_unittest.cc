@@ -16,7 +16,8 @@ using MemoryPressureLevel = MemoryPressureListener::MemoryPressureLevel;
 class MemoryPressureListenerTest : public testing::Test {
  public:
   MemoryPressureListenerTest()
-      : task_environment_(test::TaskEnvironment::MainThreadType::UI) {}
+      : task_environment_(test::TaskEnvironment::MainThreadType::UI,
+                          test::TaskEnvironment::TimeSource::MOCK_TIME) {}
 
   void SetUp() override {
     listener_ = std::make_unique<MemoryPressureListener>(
@@ -29,6 +30,9 @@ class MemoryPressureListenerTest : public testing::Test {
   }
 
  protected:
+  MemoryPressureListener* listener() { return listener_.get(); }
+  test::TaskEnvironment& task_environment() { return task_environment_; }
+
   void ExpectNotification(
       void (*notification_function)(MemoryPressureLevel),
       MemoryPressureLevel level) {
@@ -45,10 +49,11 @@ class MemoryPressureListenerTest : public testing::Test {
     RunLoop().RunUntilIdle();
   }
 
- private:
   MOCK_METHOD1(OnMemoryPressure,
                void(MemoryPressureListener::MemoryPressureLevel));
 
+ private:
+
   test::TaskEnvironment task_environment_;
   std::unique_ptr<MemoryPressureListener> listener_;
 };
@@ -78,4 +83,38 @@ TEST_F(MemoryPressureListenerTest, NotifyMemoryPressure) {
                      MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_CRITICAL);
 }
 
+TEST_F(MemoryPressureListenerTest, DeferredReactionStage) {
+  listener()->SetReactionStage(
+      MemoryPressureListener::ReactionStage::kDeferred);
+  const TimeDelta delay = MemoryPressureListener::GetReactionDelay(
+      MemoryPressureListener::ReactionStage::kDeferred);
+
+  // Moderate pressure is notified after the delay of the stage, and repeated
+  // notifications in the meantime are coalesced.
+  EXPECT_CALL(*this, OnMemoryPressure(testing::_)).Times(0);
+  MemoryPressureListener::NotifyMemoryPressure(
+      MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_MODERATE);
+  MemoryPressureListener::NotifyMemoryPressure(
+      MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_MODERATE);
+  task_environment().FastForwardBy(delay / 2);
+  testing::Mock::VerifyAndClearExpectations(this);
+
+  EXPECT_CALL(*this, OnMemoryPressure(
+                         MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_MODERATE))
+      .Times(1);
+  task_environment().FastForwardBy(delay);
+  testing::Mock::VerifyAndClearExpectations(this);
+
+  // Critical pressure is notified immediately, and supersedes a pending
+  // moderate pressure notification.
+  MemoryPressureListener::NotifyMemoryPressure(
+      MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_MODERATE);
+  EXPECT_CALL(*this, OnMemoryPressure(
+                         MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_CRITICAL))
+      .Times(1);
+  MemoryPressureListener::NotifyMemoryPressure(
+      MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  task_environment().FastForwardBy(2 * delay);
+}
+
 }  // namespace base
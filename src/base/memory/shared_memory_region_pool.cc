@@ -0,0 +1,163 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/shared_memory_region_pool.h"
+
+#include <array>
+#include <bit>
+#include <utility>
+
+#include "base/check_op.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback_helpers.h"
+#include "base/location.h"
+#include "base/trace_event/base_tracing.h"
+
+namespace base {
+
+namespace {
+
+constexpr size_t kMinSizeClassLog2 = static_cast<size_t>(
+    std::countr_zero(SharedMemoryRegionPool::kMinSizeClass));
+
+}  // namespace
+
+SharedMemoryRegionPool::Handle::Handle(
+    PassKey<SharedMemoryRegionPool>,
+    UnsafeSharedMemoryRegion region,
+    WritableSharedMemoryMapping mapping,
+    scoped_refptr<SharedMemoryRegionPool> pool)
+    : region_(std::move(region)),
+      mapping_(std::move(mapping)),
+      pool_(std::move(pool)) {
+  CHECK(pool_);
+  DCHECK(region_.IsValid());
+  DCHECK(mapping_.IsValid());
+}
+
+SharedMemoryRegionPool::Handle::~Handle() {
+  pool_->ReleaseBuffer(std::move(region_), std::move(mapping_));
+}
+
+const UnsafeSharedMemoryRegion& SharedMemoryRegionPool::Handle::GetRegion()
+    const {
+  return region_;
+}
+
+const WritableSharedMemoryMapping& SharedMemoryRegionPool::Handle::GetMapping()
+    const {
+  return mapping_;
+}
+
+SharedMemoryRegionPool::SharedMemoryRegionPool(size_t max_cached_bytes)
+    : max_cached_bytes_(max_cached_bytes),
+      // The sync callback trims even on threads without a task runner. The
+      // listener is destroyed before the rest of `this`.
+      memory_pressure_listener_(
+          FROM_HERE,
+          DoNothing(),
+          BindRepeating(&SharedMemoryRegionPool::OnMemoryPressure,
+                        Unretained(this))) {
+  static_assert(std::has_single_bit(kMinSizeClass));
+  static_assert(kMaxSizeClass == kMinSizeClass << (kNumSizeClasses - 1));
+}
+
+SharedMemoryRegionPool::~SharedMemoryRegionPool() = default;
+
+// static
+size_t SharedMemoryRegionPool::GetSizeClassIndex(size_t size) {
+  if (size > kMaxSizeClass) {
+    return kNumSizeClasses;
+  }
+  if (size <= kMinSizeClass) {
+    return 0;
+  }
+  return static_cast<size_t>(std::bit_width(size - 1)) - kMinSizeClassLog2;
+}
+
+std::unique_ptr<SharedMemoryRegionPool::Handle>
+SharedMemoryRegionPool::MaybeAllocateBuffer(size_t size) {
+  const size_t index = GetSizeClassIndex(size);
+  if (index < kNumSizeClasses) {
+    AutoLock lock(lock_);
+    std::vector<CachedRegion>& bucket = buckets_[index];
+    if (!bucket.empty()) {
+      CachedRegion region = std::move(bucket.back());
+      bucket.pop_back();
+      ++stats_.reused_regions;
+      --stats_.cached_regions;
+      stats_.cached_bytes -= region.first.GetSize();
+      return std::make_unique<Handle>(PassKey<SharedMemoryRegionPool>(),
+                                      std::move(region.first),
+                                      std::move(region.second), this);
+    }
+  }
+
+  // Create the region outside of the lock, it may be slow.
+  TRACE_EVENT1("base", "SharedMemoryRegionPool::CreateRegion", "size", size);
+  const size_t region_size =
+      index < kNumSizeClasses ? kMinSizeClass << index : size;
+  auto region = UnsafeSharedMemoryRegion::Create(region_size);
+  if (!region.IsValid()) {
+    return nullptr;
+  }
+
+  WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid()) {
+    return nullptr;
+  }
+
+  {
+    AutoLock lock(lock_);
+    ++stats_.created_regions;
+  }
+  return std::make_unique<Handle>(PassKey<SharedMemoryRegionPool>(),
+                                  std::move(region), std::move(mapping), this);
+}
+
+void SharedMemoryRegionPool::Trim() {
+  std::array<std::vector<CachedRegion>, kNumSizeClasses> trimmed;
+  {
+    AutoLock lock(lock_);
+    std::swap(trimmed, buckets_);
+    stats_.dropped_regions += stats_.cached_regions;
+    stats_.cached_regions = 0;
+    stats_.cached_bytes = 0;
+  }
+  // `trimmed` unmaps and closes the regions outside of the lock.
+}
+
+SharedMemoryRegionPool::Stats SharedMemoryRegionPool::GetStats() const {
+  AutoLock lock(lock_);
+  return stats_;
+}
+
+void SharedMemoryRegionPool::ReleaseBuffer(
+    UnsafeSharedMemoryRegion region,
+    WritableSharedMemoryMapping mapping) {
+  const size_t region_size = region.GetSize();
+  const size_t index = GetSizeClassIndex(region_size);
+  AutoLock lock(lock_);
+  // Regions bigger than the largest size class are not pooled. Dropped regions
+  // are unmapped and closed with the arguments, after the lock is released.
+  if (!region.IsValid() || index == kNumSizeClasses ||
+      region_size != kMinSizeClass << index ||
+      stats_.cached_bytes + region_size > max_cached_bytes_) {
+    ++stats_.dropped_regions;
+    return;
+  }
+  buckets_[index].emplace_back(std::move(region), std::move(mapping));
+  ++stats_.cached_regions;
+  stats_.cached_bytes += region_size;
+}
+
+void SharedMemoryRegionPool::OnMemoryPressure(
+    MemoryPressureListener::MemoryPressureLevel level) {
+  if (level == MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE) {
+    return;
+  }
+  Trim();
+}
+
+}  // namespace base
@@ -0,0 +1,129 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MEMORY_SHARED_MEMORY_REGION_POOL_H_
+#define BASE_MEMORY_SHARED_MEMORY_REGION_POOL_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "base/types/pass_key.h"
+
+namespace base {
+
+// SharedMemoryRegionPool pools the UnsafeSharedMemoryRegions used to send large
+// payloads, so that a payload reuses the region, and mapping, of an earlier one
+// of a similar size instead of paying for creating and mapping a new one.
+// Unlike UnsafeSharedMemoryPool, which serves a single buffer size, regions are
+// bucketed into power-of-two size classes, so one pool serves payloads of any
+// size. It is thread-safe.
+//
+// A region goes back to the pool when its Handle is destroyed, so a sender must
+// keep the Handle until the receiver is done with the region, e.g. until the
+// reply to the message that carried it. Only writable regions can be pooled:
+// the contents of a region that was shared read-only must never change.
+//
+// Cached regions are dropped once they would exceed the pool's byte limit, and
+// all of them are dropped on memory pressure.
+class BASE_EXPORT SharedMemoryRegionPool
+    : public RefCountedThreadSafe<SharedMemoryRegionPool> {
+ public:
+  // Requests are rounded up to a power of two of at least this size.
+  static constexpr size_t kMinSizeClass = 64 * 1024;
+  // Larger requests get a region of exactly the requested size, which is not
+  // pooled.
+  static constexpr size_t kMaxSizeClass = 64 * 1024 * 1024;
+  static constexpr size_t kDefaultMaxCachedBytes = 64 * 1024 * 1024;
+
+  // Returns the region to the pool upon destruction.
+  class BASE_EXPORT Handle {
+   public:
+    Handle(PassKey<SharedMemoryRegionPool>,
+           UnsafeSharedMemoryRegion region,
+           WritableSharedMemoryMapping mapping,
+           scoped_refptr<SharedMemoryRegionPool> pool);
+    ~Handle();
+
+    Handle(const Handle&) = delete;
+    Handle& operator=(const Handle&) = delete;
+
+    // The region may be bigger than requested.
+    const UnsafeSharedMemoryRegion& GetRegion() const;
+    const WritableSharedMemoryMapping& GetMapping() const;
+
+   private:
+    UnsafeSharedMemoryRegion region_;
+    WritableSharedMemoryMapping mapping_;
+    scoped_refptr<SharedMemoryRegionPool> pool_;
+  };
+
+  struct Stats {
+    // Regions created because none of the right size class was cached.
+    size_t created_regions = 0;
+    // Requests served with a cached region.
+    size_t reused_regions = 0;
+    // Regions dropped on release or trimmed instead of cached.
+    size_t dropped_regions = 0;
+    size_t cached_regions = 0;
+    size_t cached_bytes = 0;
+  };
+
+  explicit SharedMemoryRegionPool(
+      size_t max_cached_bytes = kDefaultMaxCachedBytes);
+
+  SharedMemoryRegionPool(const SharedMemoryRegionPool&) = delete;
+  SharedMemoryRegionPool& operator=(const SharedMemoryRegionPool&) = delete;
+
+  // Returns a region of at least `size` bytes, reusing a cached one if
+  // possible. Returns null if a region could not be created or mapped.
+  std::unique_ptr<Handle> MaybeAllocateBuffer(size_t size);
+
+  // Drops all cached regions.
+  void Trim();
+
+  Stats GetStats() const;
+
+ private:
+  friend class RefCountedThreadSafe<SharedMemoryRegionPool>;
+  using CachedRegion =
+      std::pair<UnsafeSharedMemoryRegion, WritableSharedMemoryMapping>;
+
+  static constexpr size_t kNumSizeClasses = 11;
+
+  ~SharedMemoryRegionPool();
+
+  // Returns the index of the bucket for regions of `size`, or `kNumSizeClasses`
+  // if `size` is too big to be pooled.
+  static size_t GetSizeClassIndex(size_t size);
+
+  void ReleaseBuffer(UnsafeSharedMemoryRegion region,
+                     WritableSharedMemoryMapping mapping);
+
+  void OnMemoryPressure(MemoryPressureListener::MemoryPressureLevel level);
+
+  const size_t max_cached_bytes_;
+
+  mutable Lock lock_;
+  std::array<std::vector<CachedRegion>, kNumSizeClasses> buckets_
+      GUARDED_BY(lock_);
+  Stats stats_ GUARDED_BY(lock_);
+
+  // Declared last so that it is destroyed, and stops calling back, first.
+  MemoryPressureListener memory_pressure_listener_;
+};
+
+}  // namespace base
+
+#endif  // BASE_MEMORY_SHARED_MEMORY_REGION_POOL_H_
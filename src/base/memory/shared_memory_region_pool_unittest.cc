@@ -0,0 +1,105 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/memory/shared_memory_region_pool.h"
+
+#include "base/memory/memory_pressure_listener.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+constexpr size_t kMinSize = SharedMemoryRegionPool::kMinSizeClass;
+}  // namespace
+
+TEST(SharedMemoryRegionPoolTest, RoundsUpToSizeClass) {
+  auto pool = MakeRefCounted<SharedMemoryRegionPool>();
+  auto handle = pool->MaybeAllocateBuffer(1000u);
+  ASSERT_TRUE(handle);
+  EXPECT_TRUE(handle->GetMapping().IsValid());
+  EXPECT_EQ(kMinSize, handle->GetRegion().GetSize());
+
+  handle = pool->MaybeAllocateBuffer(kMinSize + 1);
+  ASSERT_TRUE(handle);
+  EXPECT_EQ(2 * kMinSize, handle->GetRegion().GetSize());
+}
+
+TEST(SharedMemoryRegionPoolTest, ReusesRegionsOfSameSizeClass) {
+  auto pool = MakeRefCounted<SharedMemoryRegionPool>();
+  auto handle = pool->MaybeAllocateBuffer(3 * kMinSize);
+  ASSERT_TRUE(handle);
+  auto id = handle->GetRegion().GetGUID();
+
+  // Return memory to the pool.
+  handle.reset();
+
+  // A smaller size class does not get the region.
+  auto small_handle = pool->MaybeAllocateBuffer(kMinSize);
+  ASSERT_TRUE(small_handle);
+  EXPECT_NE(id, small_handle->GetRegion().GetGUID());
+
+  handle = pool->MaybeAllocateBuffer(4 * kMinSize);
+  ASSERT_TRUE(handle);
+  EXPECT_EQ(id, handle->GetRegion().GetGUID());
+
+  SharedMemoryRegionPool::Stats stats = pool->GetStats();
+  EXPECT_EQ(2u, stats.created_regions);
+  EXPECT_EQ(1u, stats.reused_regions);
+  EXPECT_EQ(0u, stats.cached_regions);
+  EXPECT_EQ(0u, stats.cached_bytes);
+}
+
+TEST(SharedMemoryRegionPoolTest, DoesNotPoolOversizedRegions) {
+  auto pool = MakeRefCounted<SharedMemoryRegionPool>();
+  const size_t size = SharedMemoryRegionPool::kMaxSizeClass + 1;
+  auto handle = pool->MaybeAllocateBuffer(size);
+  ASSERT_TRUE(handle);
+  EXPECT_EQ(size, handle->GetRegion().GetSize());
+  handle.reset();
+
+  SharedMemoryRegionPool::Stats stats = pool->GetStats();
+  EXPECT_EQ(1u, stats.dropped_regions);
+  EXPECT_EQ(0u, stats.cached_regions);
+}
+
+TEST(SharedMemoryRegionPoolTest, RespectsMaxCachedBytes) {
+  auto pool = MakeRefCounted<SharedMemoryRegionPool>(2 * kMinSize);
+  auto handle1 = pool->MaybeAllocateBuffer(kMinSize);
+  auto handle2 = pool->MaybeAllocateBuffer(kMinSize);
+  auto handle3 = pool->MaybeAllocateBuffer(kMinSize);
+  ASSERT_TRUE(handle1 && handle2 && handle3);
+  handle1.reset();
+  handle2.reset();
+  handle3.reset();
+
+  SharedMemoryRegionPool::Stats stats = pool->GetStats();
+  EXPECT_EQ(2u, stats.cached_regions);
+  EXPECT_EQ(2 * kMinSize, stats.cached_bytes);
+  EXPECT_EQ(1u, stats.dropped_regions);
+}
+
+TEST(SharedMemoryRegionPoolTest, TrimsOnMemoryPressure) {
+  auto pool = MakeRefCounted<SharedMemoryRegionPool>();
+  auto handle1 = pool->MaybeAllocateBuffer(kMinSize);
+  auto handle2 = pool->MaybeAllocateBuffer(2 * kMinSize);
+  ASSERT_TRUE(handle1 && handle2);
+  handle1.reset();
+  handle2.reset();
+  EXPECT_EQ(3 * kMinSize, pool->GetStats().cached_bytes);
+
+  MemoryPressureListener::SimulatePressureNotification(
+      MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+
+  SharedMemoryRegionPool::Stats stats = pool->GetStats();
+  EXPECT_EQ(0u, stats.cached_regions);
+  EXPECT_EQ(0u, stats.cached_bytes);
+  EXPECT_EQ(2u, stats.dropped_regions);
+
+  // New requests create new regions.
+  handle1 = pool->MaybeAllocateBuffer(kMinSize);
+  ASSERT_TRUE(handle1);
+  EXPECT_EQ(3u, pool->GetStats().created_regions);
+}
+
+}  // namespace base
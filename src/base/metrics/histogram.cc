@@ -32,6 +32,7 @@
 #include "base/metrics/persistent_memory_allocator.h"
 #include "base/metrics/sample_vector.h"
 #include "base/metrics/statistics_recorder.h"
+#include "base/metrics/thread_buffered_samples.h"
 #include "base/notreached.h"
 #include "base/pickle.h"
 #include "base/ranges/algorithm.h"
@@ -503,7 +504,11 @@ void Histogram::AddCount(int value, int count) {
     NOTREACHED_IN_MIGRATION();
     return;
   }
-  unlogged_samples_->Accumulate(value, count);
+  if (UNLIKELY(flags() & kBufferSamplesPerThread)) {
+    GetThreadBuffers()->Accumulate(value, count);
+  } else {
+    unlogged_samples_->Accumulate(value, count);
+  }
 
   if (UNLIKELY(StatisticsRecorder::have_active_callbacks()))
     FindAndRunCallbacks(value);
@@ -545,6 +550,7 @@ std::unique_ptr<HistogramSamples> Histogram::SnapshotDelta() {
   // vector: this way, the next snapshot will include any concurrent updates
   // missed by the current snapshot.
 
+  FlushThreadBuffers();
   std::unique_ptr<HistogramSamples> snapshot =
       std::make_unique<SampleVector>(unlogged_samples_->id(), bucket_ranges());
   snapshot->Extract(*unlogged_samples_);
@@ -553,6 +559,13 @@ std::unique_ptr<HistogramSamples> Histogram::SnapshotDelta() {
   return snapshot;
 }
 
+bool Histogram::HasUnloggedSamples() const {
+  // SnapshotDelta() extracts everything from |unlogged_samples_|, so it is
+  // empty if nothing was recorded since.
+  FlushThreadBuffers();
+  return unlogged_samples_->HasSamples();
+}
+
 std::unique_ptr<HistogramSamples> Histogram::SnapshotFinalDelta() const {
   // |final_delta_created_| only exists when DCHECK is on.
 #if DCHECK_IS_ON()
@@ -610,7 +623,9 @@ Histogram::Histogram(const char* name,
       unlogged_samples_->id(), ranges, logged_meta, logged_counts);
 }
 
-Histogram::~Histogram() = default;
+Histogram::~Histogram() {
+  delete thread_buffers_.load(std::memory_order_relaxed);
+}
 
 const std::string Histogram::GetAsciiBucketRange(size_t i) const {
   return GetSimpleAsciiBucketRange(ranges(i));
@@ -697,12 +712,37 @@ std::unique_ptr<SampleVector> Histogram::SnapshotAllSamples() const {
 }
 
 std::unique_ptr<SampleVector> Histogram::SnapshotUnloggedSamplesImpl() const {
+  FlushThreadBuffers();
   std::unique_ptr<SampleVector> samples(
       new SampleVector(unlogged_samples_->id(), bucket_ranges()));
   samples->Add(*unlogged_samples_);
   return samples;
 }
 
+ThreadBufferedSamples* Histogram::GetThreadBuffers() {
+  ThreadBufferedSamples* buffers =
+      thread_buffers_.load(std::memory_order_acquire);
+  if (LIKELY(buffers))
+    return buffers;
+
+  auto new_buffers = std::make_unique<ThreadBufferedSamples>(
+      unlogged_samples_->id(), bucket_ranges(), unlogged_samples_.get());
+  if (thread_buffers_.compare_exchange_strong(buffers, new_buffers.get(),
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_acquire)) {
+    return new_buffers.release();
+  }
+  // Another thread created the buffers first.
+  return buffers;
+}
+
+void Histogram::FlushThreadBuffers() const {
+  ThreadBufferedSamples* buffers =
+      thread_buffers_.load(std::memory_order_acquire);
+  if (buffers)
+    buffers->Flush();
+}
+
 Value::Dict Histogram::GetParameters() const {
   Value::Dict params;
   params.Set("type", HistogramTypeToString(GetHistogramType()));
@@ -67,6 +67,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -96,6 +97,7 @@ class LinearHistogram;
 class Pickle;
 class PickleIterator;
 class SampleVector;
+class ThreadBufferedSamples;
 class SampleVectorBase;
 
 class BASE_EXPORT Histogram : public HistogramBase {
@@ -219,6 +221,7 @@ class BASE_EXPORT Histogram : public HistogramBase {
   std::unique_ptr<HistogramSamples> SnapshotUnloggedSamples() const override;
   void MarkSamplesAsLogged(const HistogramSamples& samples) final;
   std::unique_ptr<HistogramSamples> SnapshotDelta() override;
+  bool HasUnloggedSamples() const override;
   std::unique_ptr<HistogramSamples> SnapshotFinalDelta() const override;
   void AddSamples(const HistogramSamples& samples) override;
   bool AddSamplesFromPickle(base::PickleIterator* iter) override;
@@ -299,6 +302,14 @@ class BASE_EXPORT Histogram : public HistogramBase {
   // virtual dispatch from some callsites.
   std::unique_ptr<SampleVector> SnapshotUnloggedSamplesImpl() const;
 
+  // Returns the per-thread buffers used with kBufferSamplesPerThread, creating
+  // them on first use.
+  ThreadBufferedSamples* GetThreadBuffers();
+
+  // Moves the samples of the per-thread buffers, if any, into
+  // |unlogged_samples_|.
+  void FlushThreadBuffers() const;
+
   // Writes the type, min, max, and bucket count information of the histogram in
   // |params|.
   Value::Dict GetParameters() const override;
@@ -309,6 +320,11 @@ class BASE_EXPORT Histogram : public HistogramBase {
   // Accumulation of all samples that have been logged with SnapshotDelta().
   std::unique_ptr<SampleVectorBase> logged_samples_;
 
+  // Per-thread buffers of samples not yet moved into |unlogged_samples_|.
+  // Only created for histograms with the kBufferSamplesPerThread flag. Owned
+  // by this object and never reset once set.
+  std::atomic<ThreadBufferedSamples*> thread_buffers_{nullptr};
+
 #if DCHECK_IS_ON()  // Don't waste memory if it won't be used.
   // Flag to indicate if PrepareFinalDelta has been previously called. It is
   // used to DCHECK that a final delta is not created multiple times.
@@ -155,6 +155,10 @@ void HistogramBase::SerializeInfo(Pickle* pickle) const {
   SerializeInfoImpl(pickle);
 }
 
+bool HistogramBase::HasUnloggedSamples() const {
+  return true;
+}
+
 uint32_t HistogramBase::FindCorruption(const HistogramSamples& samples) const {
   // Not supported by default.
   return NO_INCONSISTENCIES;
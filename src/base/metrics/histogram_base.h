@@ -130,6 +130,15 @@ class BASE_EXPORT HistogramBase {
     // MemoryAllocator, and that loaded into the Histogram module before this
     // histogram is created.
     kIsPersistent = 0x40,
+
+    // Indicates that samples are first recorded into per-thread buffers (see
+    // ThreadBufferedSamples) rather than directly into the histogram's shared
+    // storage. This avoids cache line contention for histograms that many
+    // threads record into at a high rate, at the cost of extra memory and of
+    // some samples only reaching the storage (including persistent memory)
+    // when the histogram is snapshotted, e.g. by HistogramSnapshotManager.
+    // Only supported by Histogram and its subclasses, and SparseHistogram.
+    kBufferSamplesPerThread = 0x80,
   };
 
   // Histogram data inconsistency types.
@@ -269,6 +278,14 @@ class BASE_EXPORT HistogramBase {
   // by someone familiar with the system.
   virtual std::unique_ptr<HistogramSamples> SnapshotDelta() = 0;
 
+  // Returns false if no samples have been recorded since the previous call to
+  // SnapshotDelta() (or MarkSamplesAsLogged()), in which case the next delta
+  // would be empty and taking it can be skipped. This is much cheaper than
+  // SnapshotDelta(), which copies all the buckets. It may return true when
+  // there are no new samples, and samples recorded concurrently may be missed;
+  // they will be found by a later call.
+  virtual bool HasUnloggedSamples() const;
+
   // Calculate the change (delta) in histogram counts since the previous call
   // to SnapshotDelta() but do so without modifying any internal data as to
   // what was previous logged. After such a call, no further calls to this
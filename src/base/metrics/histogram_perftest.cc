@@ -0,0 +1,152 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/barrier_closure.h"
+#include "base/functional/callback.h"
+#include "base/memory/raw_ptr.h"
+#include "base/metrics/histogram.h"
+#include "base/metrics/histogram_base.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/sparse_histogram.h"
+#include "base/metrics/statistics_recorder.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/simple_thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// This file measures the throughput of HistogramBase::Add() when several
+// threads record into the same histogram, with and without the
+// kBufferSamplesPerThread flag.
+
+namespace base {
+
+namespace {
+
+constexpr char kMetricPrefixHistogram[] = "Histogram.";
+constexpr char kMetricAddThroughput[] = "add_throughput";
+constexpr int kNumIterations = 10000000;
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story_name) {
+  perf_test::PerfResultReporter reporter(kMetricPrefixHistogram, story_name);
+  reporter.RegisterImportantMetric(kMetricAddThroughput, "adds/ms");
+  return reporter;
+}
+
+class AddThread : public SimpleThread {
+ public:
+  // Upon entering its main function, the thread waits for |start_event| to be
+  // signaled. Then, it adds |kNumIterations| samples to |histogram|. Finally,
+  // it invokes |done_closure|.
+  AddThread(WaitableEvent* start_event,
+            HistogramBase* histogram,
+            OnceClosure done_closure)
+      : SimpleThread("AddThread"),
+        start_event_(start_event),
+        histogram_(histogram),
+        done_closure_(std::move(done_closure)) {}
+
+  // SimpleThread:
+  void Run() override {
+    start_event_->Wait();
+    for (int i = 0; i < kNumIterations; ++i) {
+      histogram_->Add(i % 64);
+    }
+    std::move(done_closure_).Run();
+  }
+
+ private:
+  const raw_ptr<WaitableEvent> start_event_;
+  const raw_ptr<HistogramBase> histogram_;
+  OnceClosure done_closure_;
+};
+
+void RunAddPerfTest(const std::string& story_name,
+                    HistogramBase* histogram,
+                    int num_threads) {
+  WaitableEvent start_event;
+  WaitableEvent end_event;
+  RepeatingClosure done_closure = BarrierClosure(
+      num_threads, BindOnce(&WaitableEvent::Signal, Unretained(&end_event)));
+
+  std::vector<std::unique_ptr<AddThread>> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(
+        std::make_unique<AddThread>(&start_event, histogram, done_closure));
+    threads.back()->Start();
+  }
+
+  TimeTicks start_time = TimeTicks::Now();
+  start_event.Signal();
+  end_event.Wait();
+  TimeTicks end_time = TimeTicks::Now();
+
+  // The snapshot flushes the per-thread buffers, if any.
+  EXPECT_EQ(num_threads * kNumIterations,
+            histogram->SnapshotSamples()->TotalCount());
+
+  auto reporter = SetUpReporter(story_name);
+  reporter.AddResult(
+      kMetricAddThroughput,
+      num_threads * kNumIterations / (end_time - start_time).InMillisecondsF());
+
+  for (auto& thread : threads) {
+    thread->Join();
+  }
+}
+
+void RunHistogramPerfTest(const std::string& story_name,
+                          int32_t flags,
+                          int num_threads) {
+  std::unique_ptr<StatisticsRecorder> recorder =
+      StatisticsRecorder::CreateTemporaryForTesting();
+  RunAddPerfTest(story_name,
+                 Histogram::FactoryGet(story_name, 1, 1000, 50, flags),
+                 num_threads);
+}
+
+void RunSparseHistogramPerfTest(const std::string& story_name,
+                                int32_t flags,
+                                int num_threads) {
+  std::unique_ptr<StatisticsRecorder> recorder =
+      StatisticsRecorder::CreateTemporaryForTesting();
+  RunAddPerfTest(story_name, SparseHistogram::FactoryGet(story_name, flags),
+                 num_threads);
+}
+
+}  // namespace
+
+TEST(HistogramPerfTest, Histogram_1Thread) {
+  RunHistogramPerfTest("Histogram_1Thread", HistogramBase::kNoFlags, 1);
+}
+
+TEST(HistogramPerfTest, Histogram_4Threads) {
+  RunHistogramPerfTest("Histogram_4Threads", HistogramBase::kNoFlags, 4);
+}
+
+TEST(HistogramPerfTest, BufferedHistogram_1Thread) {
+  RunHistogramPerfTest("BufferedHistogram_1Thread",
+                       HistogramBase::kBufferSamplesPerThread, 1);
+}
+
+TEST(HistogramPerfTest, BufferedHistogram_4Threads) {
+  RunHistogramPerfTest("BufferedHistogram_4Threads",
+                       HistogramBase::kBufferSamplesPerThread, 4);
+}
+
+TEST(HistogramPerfTest, SparseHistogram_4Threads) {
+  RunSparseHistogramPerfTest("SparseHistogram_4Threads",
+                             HistogramBase::kNoFlags, 4);
+}
+
+TEST(HistogramPerfTest, BufferedSparseHistogram_4Threads) {
+  RunSparseHistogramPerfTest("BufferedSparseHistogram_4Threads",
+                             HistogramBase::kBufferSamplesPerThread, 4);
+}
+
+}  // namespace base
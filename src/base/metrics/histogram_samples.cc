@@ -5,11 +5,14 @@
 #include "base/metrics/histogram_samples.h"
 
 #include <limits>
+#include <optional>
+#include <string>
 #include <string_view>
 #include <utility>
 
+#include "base/check_op.h"
 #include "base/compiler_specific.h"
-#include "base/memory/raw_ptr.h"
+#include "base/containers/span.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/numerics/clamped_math.h"
@@ -34,9 +37,28 @@ constexpr size_t kSizeMax = std::numeric_limits<size_t>::max();
 // handled in the code but it's worth making them as unlikely as possible.
 constexpr int32_t kDisabledSingleSample = -1;
 
-class SampleCountPickleIterator : public SampleCountIterator {
+// Appends |value| to |output| as a base-128 varint, least significant group
+// first.
+void AppendVarint(uint64_t value, std::string& output) {
+  while (value >= 0x80) {
+    output.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<char>(value));
+}
+
+// Appends |value| zigzag-encoded, so that values close to zero, positive or
+// negative, take few bytes.
+void AppendSignedVarint(int64_t value, std::string& output) {
+  AppendVarint((static_cast<uint64_t>(value) << 1) ^
+                   static_cast<uint64_t>(value >> 63),
+               output);
+}
+
+// Reads back the buckets written by HistogramSamples::Serialize().
+class SampleCountCompactIterator : public SampleCountIterator {
  public:
-  explicit SampleCountPickleIterator(PickleIterator* iter);
+  explicit SampleCountCompactIterator(span<const uint8_t> data);
 
   bool Done() const override;
   void Next() override;
@@ -44,42 +66,91 @@ class SampleCountPickleIterator : public SampleCountIterator {
            int64_t* max,
            HistogramBase::Count* count) override;
 
+  // Whether iteration stopped at malformed data, rather than at the end.
+  bool failed() const { return failed_; }
+
  private:
-  const raw_ptr<PickleIterator> iter_;
+  std::optional<uint64_t> ReadVarint();
+  std::optional<int64_t> ReadSignedVarint();
 
-  HistogramBase::Sample min_;
-  int64_t max_;
-  HistogramBase::Count count_;
-  bool is_done_;
+  span<const uint8_t> data_;
+
+  HistogramBase::Sample min_ = 0;
+  int64_t max_ = 0;
+  HistogramBase::Count count_ = 0;
+  bool is_done_ = false;
+  bool failed_ = false;
 };
 
-SampleCountPickleIterator::SampleCountPickleIterator(PickleIterator* iter)
-    : iter_(iter),
-      is_done_(false) {
+SampleCountCompactIterator::SampleCountCompactIterator(
+    span<const uint8_t> data)
+    : data_(data) {
   Next();
 }
 
-bool SampleCountPickleIterator::Done() const {
+bool SampleCountCompactIterator::Done() const {
   return is_done_;
 }
 
-void SampleCountPickleIterator::Next() {
+void SampleCountCompactIterator::Next() {
   DCHECK(!Done());
-  if (!iter_->ReadInt(&min_) || !iter_->ReadInt64(&max_) ||
-      !iter_->ReadInt(&count_)) {
+  if (data_.empty()) {
+    is_done_ = true;
+    return;
+  }
+
+  std::optional<int64_t> min_delta = ReadSignedVarint();
+  std::optional<uint64_t> width = ReadVarint();
+  std::optional<int64_t> count = ReadSignedVarint();
+  if (!min_delta || !width || !count || *width == 0) {
     is_done_ = true;
+    failed_ = true;
+    return;
   }
+
+  CheckedNumeric<int64_t> min = max_;
+  min += *min_delta;
+  CheckedNumeric<int64_t> max = min;
+  max += *width;
+  if (!min.AssignIfValid(&min_) || !max.AssignIfValid(&max_) ||
+      !IsValueInRangeForNumericType<HistogramBase::Count>(*count)) {
+    is_done_ = true;
+    failed_ = true;
+    return;
+  }
+  count_ = static_cast<HistogramBase::Count>(*count);
 }
 
-void SampleCountPickleIterator::Get(HistogramBase::Sample* min,
-                                    int64_t* max,
-                                    HistogramBase::Count* count) {
+void SampleCountCompactIterator::Get(HistogramBase::Sample* min,
+                                     int64_t* max,
+                                     HistogramBase::Count* count) {
   DCHECK(!Done());
   *min = min_;
   *max = max_;
   *count = count_;
 }
 
+std::optional<uint64_t> SampleCountCompactIterator::ReadVarint() {
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64 && !data_.empty(); shift += 7) {
+    const uint8_t byte = data_.front();
+    data_ = data_.subspan(1u);
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return value;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<int64_t> SampleCountCompactIterator::ReadSignedVarint() {
+  std::optional<uint64_t> value = ReadVarint();
+  if (!value) {
+    return std::nullopt;
+  }
+  return static_cast<int64_t>(*value >> 1) ^ -static_cast<int64_t>(*value & 1);
+}
+
 }  // namespace
 
 static_assert(sizeof(HistogramSamples::AtomicSingleSample) ==
@@ -251,10 +322,15 @@ bool HistogramSamples::AddFromPickle(PickleIterator* iter) {
   if (!iter->ReadInt64(&sum) || !iter->ReadInt(&redundant_count))
     return false;
 
+  std::optional<span<const uint8_t>> buckets = iter->ReadData();
+  if (!buckets) {
+    return false;
+  }
+
   IncreaseSumAndCount(sum, redundant_count);
 
-  SampleCountPickleIterator pickle_iter(iter);
-  return AddSubtractImpl(&pickle_iter, ADD);
+  SampleCountCompactIterator buckets_iter(*buckets);
+  return AddSubtractImpl(&buckets_iter, ADD) && !buckets_iter.failed();
 }
 
 void HistogramSamples::Subtract(const HistogramSamples& other) {
@@ -306,16 +382,21 @@ void HistogramSamples::Serialize(Pickle* pickle) const {
   pickle->WriteInt64(sum());
   pickle->WriteInt(redundant_count());
 
+  std::string buckets;
+  int64_t previous_max = 0;
   HistogramBase::Sample min;
   int64_t max;
   HistogramBase::Count count;
   for (std::unique_ptr<SampleCountIterator> it = Iterator(); !it->Done();
        it->Next()) {
     it->Get(&min, &max, &count);
-    pickle->WriteInt(min);
-    pickle->WriteInt64(max);
-    pickle->WriteInt(count);
+    DCHECK_LT(min, max);
+    AppendSignedVarint(min - previous_max, buckets);
+    AppendVarint(static_cast<uint64_t>(max - min), buckets);
+    AppendSignedVarint(count, buckets);
+    previous_max = max;
   }
+  pickle->WriteData(buckets);
 }
 
 bool HistogramSamples::AccumulateSingleSample(HistogramBase::Sample value,
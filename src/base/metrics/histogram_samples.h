@@ -149,7 +149,8 @@ class BASE_EXPORT HistogramSamples {
 
   void Add(const HistogramSamples& other);
 
-  // Add from serialized samples.
+  // Add from samples serialized by Serialize(). Returns false if the data is
+  // malformed, in which case some of the samples may have been added.
   bool AddFromPickle(PickleIterator* iter);
 
   void Subtract(const HistogramSamples& other);
@@ -183,6 +184,12 @@ class BASE_EXPORT HistogramSamples {
   // samples.
   virtual bool IsDefinitelyEmpty() const;
 
+  // Writes |sum|, |redundant_count| and the non-empty buckets to |pickle|, to
+  // be read back by AddFromPickle(). The buckets are a single blob of varints
+  // holding, for each bucket, the distance between its min and the previous
+  // bucket's max, its width and its count. Since adjacent buckets usually have
+  // small deltas, this takes a few bytes per bucket instead of 16. The format
+  // is only meant for transfer between processes of the same build.
   void Serialize(Pickle* pickle) const;
 
   // Returns ASCII representation of histograms data for histogram samples.
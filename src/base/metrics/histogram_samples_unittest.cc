@@ -5,7 +5,13 @@
 #include "base/metrics/histogram_samples.h"
 
 #include <limits>
+#include <string_view>
 
+#include "base/metrics/bucket_ranges.h"
+#include "base/metrics/histogram.h"
+#include "base/metrics/sample_map.h"
+#include "base/metrics/sample_vector.h"
+#include "base/pickle.h"
 #include "base/test/gtest_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -121,4 +127,71 @@ TEST(HistogramSamplesTest, WriteAsciiBucketGraph) {
   ASSERT_EQ(output.size(), kOutputSize + 1);
 }
 
+TEST(HistogramSamplesTest, SerializeRoundTrip) {
+  SampleMap samples(1);
+  samples.Accumulate(-1000, 3);
+  samples.Accumulate(1, 1);
+  samples.Accumulate(2, 200000);
+  samples.Accumulate(std::numeric_limits<HistogramBase::Sample>::max() - 1, 1);
+  samples.Accumulate(5, -2);
+
+  Pickle pickle;
+  samples.Serialize(&pickle);
+  SampleMap copy(1);
+  PickleIterator iter(pickle);
+  EXPECT_TRUE(copy.AddFromPickle(&iter));
+
+  EXPECT_EQ(samples.sum(), copy.sum());
+  EXPECT_EQ(samples.redundant_count(), copy.redundant_count());
+  for (HistogramBase::Sample value :
+       {-1000, 1, 2, 5,
+        std::numeric_limits<HistogramBase::Sample>::max() - 1}) {
+    EXPECT_EQ(samples.GetCount(value), copy.GetCount(value)) << value;
+  }
+}
+
+// Adjacent buckets are delta-encoded, so a full histogram takes a few bytes
+// per bucket rather than the 16 of a fixed-width encoding.
+TEST(HistogramSamplesTest, SerializeIsCompact) {
+  constexpr size_t kBucketCount = 50;
+  BucketRanges ranges(kBucketCount + 1);
+  Histogram::InitializeBucketRanges(1, 1000, &ranges);
+  SampleVector samples(1, &ranges);
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    samples.Accumulate(ranges.range(i), 1);
+  }
+
+  Pickle pickle;
+  samples.Serialize(&pickle);
+  EXPECT_LT(pickle.payload_size(), kBucketCount * 16 / 3);
+
+  SampleVector copy(1, &ranges);
+  PickleIterator iter(pickle);
+  EXPECT_TRUE(copy.AddFromPickle(&iter));
+  EXPECT_EQ(samples.sum(), copy.sum());
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    EXPECT_EQ(1, copy.GetCountAtIndex(i)) << i;
+  }
+}
+
+TEST(HistogramSamplesTest, AddFromMalformedPickle) {
+  // A truncated varint.
+  Pickle pickle;
+  pickle.WriteInt64(1);
+  pickle.WriteInt(1);
+  pickle.WriteData(std::string_view("\x02\x01\x82"));
+
+  SampleMap samples(1);
+  PickleIterator iter(pickle);
+  EXPECT_FALSE(samples.AddFromPickle(&iter));
+
+  // A bucket with no width.
+  Pickle empty_bucket;
+  empty_bucket.WriteInt64(1);
+  empty_bucket.WriteInt(1);
+  empty_bucket.WriteData(std::string_view("\x02\x00\x02"));
+  PickleIterator empty_bucket_iter(empty_bucket);
+  EXPECT_FALSE(samples.AddFromPickle(&empty_bucket_iter));
+}
+
 }  // namespace base
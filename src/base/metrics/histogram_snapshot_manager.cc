@@ -61,6 +61,11 @@ void HistogramSnapshotManager::MarkUnloggedSamplesAsLogged() {
 }
 
 void HistogramSnapshotManager::PrepareDelta(HistogramBase* histogram) {
+  // Most histograms are unchanged between two deltas, and their delta would
+  // not be recorded anyway.
+  if (!histogram->HasUnloggedSamples()) {
+    return;
+  }
   std::unique_ptr<HistogramSamples> samples = histogram->SnapshotDelta();
   PrepareSamples(histogram, *samples);
 }
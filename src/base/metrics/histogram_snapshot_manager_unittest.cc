@@ -13,6 +13,7 @@
 #include "base/metrics/histogram_delta_serialization.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/sample_vector.h"
+#include "base/metrics/sparse_histogram.h"
 #include "base/metrics/statistics_recorder.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -257,4 +258,53 @@ TEST_F(HistogramSnapshotManagerTest,
   EXPECT_EQ(histograms[0]->SnapshotUnloggedSamples()->TotalCount(), 0);
 }
 
+// Histograms with nothing recorded since the last delta are skipped.
+TEST_F(HistogramSnapshotManagerTest, PrepareDeltasSkipsUnchangedHistograms) {
+  HistogramBase* histogram = Histogram::FactoryGet(
+      kHistogramName, 1, 100, 10, HistogramBase::kNoFlags);
+  HistogramBase* sparse_histogram =
+      SparseHistogram::FactoryGet("SparseHistogram", HistogramBase::kNoFlags);
+  EXPECT_FALSE(histogram->HasUnloggedSamples());
+  EXPECT_FALSE(sparse_histogram->HasUnloggedSamples());
+
+  // A lone sample is held in the single-sample slot, not the counts.
+  histogram->Add(5);
+  sparse_histogram->Add(5);
+  EXPECT_TRUE(histogram->HasUnloggedSamples());
+  EXPECT_TRUE(sparse_histogram->HasUnloggedSamples());
+
+  StatisticsRecorder::PrepareDeltas(
+      /*include_persistent=*/false, /*flags_to_set=*/HistogramBase::kNoFlags,
+      /*required_flags=*/HistogramBase::kNoFlags, &histogram_snapshot_manager_);
+  EXPECT_EQ(2U, histogram_flattener_delta_recorder_.GetRecordedDeltaHistograms()
+                    .size());
+  EXPECT_FALSE(histogram->HasUnloggedSamples());
+  EXPECT_FALSE(sparse_histogram->HasUnloggedSamples());
+
+  // Nothing changed, so nothing is recorded.
+  histogram_flattener_delta_recorder_.Reset();
+  StatisticsRecorder::PrepareDeltas(
+      /*include_persistent=*/false, /*flags_to_set=*/HistogramBase::kNoFlags,
+      /*required_flags=*/HistogramBase::kNoFlags, &histogram_snapshot_manager_);
+  EXPECT_TRUE(histogram_flattener_delta_recorder_.GetRecordedDeltaHistograms()
+                  .empty());
+
+  // Samples in different buckets are held in the counts.
+  histogram->Add(5);
+  histogram->Add(50);
+  EXPECT_TRUE(histogram->HasUnloggedSamples());
+  EXPECT_FALSE(sparse_histogram->HasUnloggedSamples());
+
+  StatisticsRecorder::PrepareDeltas(
+      /*include_persistent=*/false, /*flags_to_set=*/HistogramBase::kNoFlags,
+      /*required_flags=*/HistogramBase::kNoFlags, &histogram_snapshot_manager_);
+  const std::vector<raw_ptr<const HistogramBase, VectorExperimental>>&
+      histograms =
+          histogram_flattener_delta_recorder_.GetRecordedDeltaHistograms();
+  ASSERT_EQ(1U, histograms.size());
+  EXPECT_EQ(histogram, histograms[0]);
+  EXPECT_EQ(GetRecordedDeltaHistogramSum(kHistogramName), 55);
+  EXPECT_FALSE(histogram->HasUnloggedSamples());
+}
+
 }  // namespace base
@@ -307,6 +307,36 @@ TEST_P(HistogramTest, FinalDeltaTest) {
   EXPECT_EQ(samples->TotalCount(), samples->redundant_count());
 }
 
+// Check that samples buffered with kBufferSamplesPerThread are seen by all the
+// snapshot methods.
+TEST_P(HistogramTest, BufferSamplesPerThread) {
+  HistogramBase* histogram =
+      Histogram::FactoryGet("BufferedHistogram", 1, 64, 8,
+                            HistogramBase::kBufferSamplesPerThread);
+  histogram->Add(1);
+  histogram->AddCount(10, 2);
+
+  std::unique_ptr<HistogramSamples> samples =
+      histogram->SnapshotUnloggedSamples();
+  EXPECT_EQ(3, samples->TotalCount());
+  EXPECT_EQ(2, samples->GetCount(10));
+  EXPECT_EQ(21, samples->sum());
+  histogram->MarkSamplesAsLogged(*samples);
+  EXPECT_EQ(0, histogram->SnapshotDelta()->TotalCount());
+
+  histogram->Add(50);
+  samples = histogram->SnapshotDelta();
+  EXPECT_EQ(1, samples->TotalCount());
+  EXPECT_EQ(1, samples->GetCount(50));
+  EXPECT_EQ(samples->TotalCount(), samples->redundant_count());
+
+  histogram->Add(2);
+  samples = histogram->SnapshotSamples();
+  EXPECT_EQ(5, samples->TotalCount());
+  EXPECT_EQ(73, samples->sum());
+  EXPECT_EQ(1, histogram->SnapshotFinalDelta()->TotalCount());
+}
+
 // Check that IsDefinitelyEmpty() works with the results of SnapshotDelta().
 TEST_P(HistogramTest, IsDefinitelyEmpty_SnapshotDelta) {
   HistogramBase* histogram = Histogram::FactoryGet("DeltaHistogram", 1, 64, 8,
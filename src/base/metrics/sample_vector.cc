@@ -210,6 +210,12 @@ Count SampleVectorBase::TotalCount() const {
   return 0;
 }
 
+bool SampleVectorBase::HasSamples() const {
+  // Samples accumulated into the counts are also added to the redundant count,
+  // but a lone single-sample is not.
+  return redundant_count() != 0 || single_sample().Load().count != 0;
+}
+
 Count SampleVectorBase::GetCountAtIndex(size_t bucket_index) const {
   DCHECK(bucket_index < counts_size());
 
@@ -53,6 +53,10 @@ class BASE_EXPORT SampleVectorBase : public HistogramSamples {
   // Get count of a specific bucket.
   HistogramBase::Count GetCountAtIndex(size_t bucket_index) const;
 
+  // Returns true if any samples have been accumulated. Unlike TotalCount(),
+  // this doesn't need to walk the counts.
+  bool HasSamples() const;
+
   // Access the bucket ranges held externally.
   const BucketRanges* bucket_ranges() const { return bucket_ranges_; }
 
@@ -14,6 +14,7 @@
 #include "base/metrics/persistent_sample_map.h"
 #include "base/metrics/sample_map.h"
 #include "base/metrics/statistics_recorder.h"
+#include "base/metrics/thread_buffered_samples.h"
 #include "base/notreached.h"
 #include "base/pickle.h"
 #include "base/strings/utf_string_conversions.h"
@@ -86,7 +87,9 @@ std::unique_ptr<HistogramBase> SparseHistogram::PersistentCreate(
   return WrapUnique(new SparseHistogram(allocator, name, meta, logged_meta));
 }
 
-SparseHistogram::~SparseHistogram() = default;
+SparseHistogram::~SparseHistogram() {
+  delete thread_buffers_.load(std::memory_order_relaxed);
+}
 
 uint64_t SparseHistogram::name_hash() const {
   return unlogged_samples_->id();
@@ -113,7 +116,9 @@ void SparseHistogram::AddCount(Sample value, int count) {
     NOTREACHED_IN_MIGRATION();
     return;
   }
-  {
+  if (UNLIKELY(flags() & kBufferSamplesPerThread)) {
+    GetThreadBuffers()->Accumulate(value, count);
+  } else {
     base::AutoLock auto_lock(lock_);
     unlogged_samples_->Accumulate(value, count);
   }
@@ -123,6 +128,7 @@ void SparseHistogram::AddCount(Sample value, int count) {
 }
 
 std::unique_ptr<HistogramSamples> SparseHistogram::SnapshotSamples() const {
+  FlushThreadBuffers();
   std::unique_ptr<SampleMap> snapshot(new SampleMap(name_hash()));
 
   base::AutoLock auto_lock(lock_);
@@ -133,6 +139,7 @@ std::unique_ptr<HistogramSamples> SparseHistogram::SnapshotSamples() const {
 
 std::unique_ptr<HistogramSamples> SparseHistogram::SnapshotUnloggedSamples()
     const {
+  FlushThreadBuffers();
   std::unique_ptr<SampleMap> snapshot(new SampleMap(name_hash()));
 
   base::AutoLock auto_lock(lock_);
@@ -152,6 +159,7 @@ void SparseHistogram::MarkSamplesAsLogged(const HistogramSamples& samples) {
 std::unique_ptr<HistogramSamples> SparseHistogram::SnapshotDelta() {
   DCHECK(!final_delta_created_);
 
+  FlushThreadBuffers();
   std::unique_ptr<SampleMap> snapshot =
       std::make_unique<SampleMap>(name_hash());
   base::AutoLock auto_lock(lock_);
@@ -160,10 +168,20 @@ std::unique_ptr<HistogramSamples> SparseHistogram::SnapshotDelta() {
   return std::move(snapshot);
 }
 
+bool SparseHistogram::HasUnloggedSamples() const {
+  // Every sample added to |unlogged_samples_| increments its redundant count,
+  // and SnapshotDelta() subtracts exactly what it extracts, so the count is
+  // zero if nothing was recorded since.
+  FlushThreadBuffers();
+  base::AutoLock auto_lock(lock_);
+  return unlogged_samples_->redundant_count() != 0;
+}
+
 std::unique_ptr<HistogramSamples> SparseHistogram::SnapshotFinalDelta() const {
   DCHECK(!final_delta_created_);
   final_delta_created_ = true;
 
+  FlushThreadBuffers();
   std::unique_ptr<SampleMap> snapshot(new SampleMap(name_hash()));
   base::AutoLock auto_lock(lock_);
   snapshot->Add(*unlogged_samples_);
@@ -238,4 +256,28 @@ Value::Dict SparseHistogram::GetParameters() const {
   return params;
 }
 
+ThreadBufferedSamples* SparseHistogram::GetThreadBuffers() {
+  ThreadBufferedSamples* buffers =
+      thread_buffers_.load(std::memory_order_acquire);
+  if (LIKELY(buffers))
+    return buffers;
+
+  auto new_buffers = std::make_unique<ThreadBufferedSamples>(
+      unlogged_samples_->id(), unlogged_samples_.get(), &lock_);
+  if (thread_buffers_.compare_exchange_strong(buffers, new_buffers.get(),
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_acquire)) {
+    return new_buffers.release();
+  }
+  // Another thread created the buffers first.
+  return buffers;
+}
+
+void SparseHistogram::FlushThreadBuffers() const {
+  ThreadBufferedSamples* buffers =
+      thread_buffers_.load(std::memory_order_acquire);
+  if (buffers)
+    buffers->Flush();
+}
+
 }  // namespace base
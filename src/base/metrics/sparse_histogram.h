@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -24,6 +25,7 @@ class HistogramSamples;
 class PersistentHistogramAllocator;
 class Pickle;
 class PickleIterator;
+class ThreadBufferedSamples;
 
 class BASE_EXPORT SparseHistogram : public HistogramBase {
  public:
@@ -58,6 +60,7 @@ class BASE_EXPORT SparseHistogram : public HistogramBase {
   std::unique_ptr<HistogramSamples> SnapshotUnloggedSamples() const override;
   void MarkSamplesAsLogged(const HistogramSamples& samples) override;
   std::unique_ptr<HistogramSamples> SnapshotDelta() override;
+  bool HasUnloggedSamples() const override;
   std::unique_ptr<HistogramSamples> SnapshotFinalDelta() const override;
   base::Value::Dict ToGraphDict() const override;
 
@@ -81,6 +84,14 @@ class BASE_EXPORT SparseHistogram : public HistogramBase {
   // Writes the type of the sparse histogram in the |params|.
   Value::Dict GetParameters() const override;
 
+  // Returns the per-thread buffers used with kBufferSamplesPerThread, creating
+  // them on first use.
+  ThreadBufferedSamples* GetThreadBuffers();
+
+  // Moves the samples of the per-thread buffers, if any, into
+  // |unlogged_samples_|. Must not be called with |lock_| held.
+  void FlushThreadBuffers() const;
+
   // For constructor calling.
   friend class SparseHistogramTest;
   friend class HistogramThreadsafeTest;
@@ -93,6 +104,11 @@ class BASE_EXPORT SparseHistogram : public HistogramBase {
 
   std::unique_ptr<HistogramSamples> unlogged_samples_;
   std::unique_ptr<HistogramSamples> logged_samples_;
+
+  // Per-thread buffers of samples not yet moved into |unlogged_samples_|.
+  // Only created for histograms with the kBufferSamplesPerThread flag. Owned
+  // by this object and never reset once set.
+  std::atomic<ThreadBufferedSamples*> thread_buffers_{nullptr};
 };
 
 }  // namespace base
@@ -220,6 +220,33 @@ TEST_P(SparseHistogramTest, IsDefinitelyEmpty_SnapshotDelta) {
   EXPECT_TRUE(histogram->SnapshotDelta()->IsDefinitelyEmpty());
 }
 
+// Check that samples buffered with kBufferSamplesPerThread are seen by all the
+// snapshot methods.
+TEST_P(SparseHistogramTest, BufferSamplesPerThread) {
+  std::unique_ptr<SparseHistogram> histogram(NewSparseHistogram("Sparse"));
+  histogram->SetFlags(HistogramBase::kBufferSamplesPerThread);
+  histogram->Add(1);
+  histogram->AddCount(1000, 2);
+
+  std::unique_ptr<HistogramSamples> samples =
+      histogram->SnapshotUnloggedSamples();
+  EXPECT_EQ(3, samples->TotalCount());
+  EXPECT_EQ(2, samples->GetCount(1000));
+  histogram->MarkSamplesAsLogged(*samples);
+  EXPECT_EQ(0, histogram->SnapshotDelta()->TotalCount());
+
+  histogram->Add(50);
+  samples = histogram->SnapshotDelta();
+  EXPECT_EQ(1, samples->TotalCount());
+  EXPECT_EQ(1, samples->GetCount(50));
+
+  histogram->Add(2);
+  samples = histogram->SnapshotSamples();
+  EXPECT_EQ(5, samples->TotalCount());
+  EXPECT_EQ(2053, samples->sum());
+  EXPECT_EQ(1, histogram->SnapshotFinalDelta()->TotalCount());
+}
+
 TEST_P(SparseHistogramTest, AddCount_LargeValuesDontOverflow) {
   std::unique_ptr<SparseHistogram> histogram(NewSparseHistogram("Sparse"));
   std::unique_ptr<HistogramSamples> snapshot(histogram->SnapshotSamples());
@@ -0,0 +1,157 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/thread_buffered_samples.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/check.h"
+#include "base/compiler_specific.h"
+#include "base/metrics/histogram_samples.h"
+#include "base/metrics/sample_map.h"
+#include "base/metrics/sample_vector.h"
+#include "base/synchronization/lock.h"
+#include "third_party/abseil-cpp/absl/base/attributes.h"
+
+namespace base {
+
+namespace {
+
+// Hands out buffer indices to threads, round-robin.
+std::atomic<uint32_t> g_next_buffer_index{0};
+
+// The buffer index of the current thread, or kNumBuffers if it hasn't been
+// assigned one yet. The same index is used for all buffered histograms.
+ABSL_CONST_INIT thread_local size_t current_thread_buffer_index =
+    ThreadBufferedSamples::kNumBuffers;
+
+size_t GetCurrentThreadBufferIndex() {
+  if (UNLIKELY(current_thread_buffer_index ==
+               ThreadBufferedSamples::kNumBuffers)) {
+    current_thread_buffer_index =
+        g_next_buffer_index.fetch_add(1, std::memory_order_relaxed) %
+        ThreadBufferedSamples::kNumBuffers;
+  }
+  return current_thread_buffer_index;
+}
+
+}  // namespace
+
+struct ThreadBufferedSamples::Buffer {
+  explicit Buffer(std::unique_ptr<HistogramSamples> samples)
+      : samples(std::move(samples)) {}
+
+  // Guards |samples| for a SparseHistogram, as SampleMap isn't thread-safe.
+  Lock lock;
+
+  std::unique_ptr<HistogramSamples> samples;
+
+  // The number of Accumulate() calls on this buffer, used to flush it every
+  // kFlushInterval calls.
+  std::atomic<uint32_t> accumulate_calls{0};
+};
+
+ThreadBufferedSamples::ThreadBufferedSamples(uint64_t id,
+                                             const BucketRanges* bucket_ranges,
+                                             HistogramSamples* samples)
+    : id_(id), bucket_ranges_(bucket_ranges), samples_(samples) {
+  DCHECK(bucket_ranges_);
+}
+
+ThreadBufferedSamples::ThreadBufferedSamples(uint64_t id,
+                                             HistogramSamples* samples,
+                                             Lock* samples_lock)
+    : id_(id), samples_(samples), samples_lock_(samples_lock) {
+  DCHECK(samples_lock_);
+}
+
+ThreadBufferedSamples::~ThreadBufferedSamples() {
+  for (std::atomic<Buffer*>& buffer : buffers_) {
+    delete buffer.load(std::memory_order_relaxed);
+  }
+}
+
+void ThreadBufferedSamples::Accumulate(HistogramBase::Sample value,
+                                       HistogramBase::Count count) {
+  Buffer& buffer = GetBuffer();
+  if (!samples_lock_) {
+    buffer.samples->Accumulate(value, count);
+    if (UNLIKELY(CountAccumulateCall(buffer))) {
+      samples_->Extract(*buffer.samples);
+    }
+    return;
+  }
+
+  // The buffer lock is only contended by threads that share the buffer, and
+  // is never held at the same time as |samples_lock_|.
+  std::unique_ptr<SampleMap> flushed;
+  {
+    AutoLock auto_lock(buffer.lock);
+    buffer.samples->Accumulate(value, count);
+    if (LIKELY(!CountAccumulateCall(buffer))) {
+      return;
+    }
+    flushed = std::make_unique<SampleMap>(id_);
+    flushed->Extract(*buffer.samples);
+  }
+  AutoLock auto_lock(*samples_lock_);
+  samples_->Add(*flushed);
+}
+
+void ThreadBufferedSamples::Flush() {
+  for (std::atomic<Buffer*>& slot : buffers_) {
+    Buffer* buffer = slot.load(std::memory_order_acquire);
+    if (buffer) {
+      FlushBuffer(*buffer);
+    }
+  }
+}
+
+// static
+bool ThreadBufferedSamples::CountAccumulateCall(Buffer& buffer) {
+  const uint32_t calls =
+      buffer.accumulate_calls.fetch_add(1, std::memory_order_relaxed) + 1;
+  return calls % kFlushInterval == 0;
+}
+
+ThreadBufferedSamples::Buffer& ThreadBufferedSamples::GetBuffer() {
+  std::atomic<Buffer*>& slot = buffers_[GetCurrentThreadBufferIndex()];
+  Buffer* buffer = slot.load(std::memory_order_acquire);
+  if (LIKELY(buffer)) {
+    return *buffer;
+  }
+
+  std::unique_ptr<HistogramSamples> samples;
+  if (bucket_ranges_) {
+    samples = std::make_unique<SampleVector>(id_, bucket_ranges_);
+  } else {
+    samples = std::make_unique<SampleMap>(id_);
+  }
+  auto new_buffer = std::make_unique<Buffer>(std::move(samples));
+  if (slot.compare_exchange_strong(buffer, new_buffer.get(),
+                                   std::memory_order_acq_rel,
+                                   std::memory_order_acquire)) {
+    return *new_buffer.release();
+  }
+  // Another thread sharing this slot created the buffer first.
+  return *buffer;
+}
+
+void ThreadBufferedSamples::FlushBuffer(Buffer& buffer) {
+  if (!samples_lock_) {
+    samples_->Extract(*buffer.samples);
+    return;
+  }
+
+  SampleMap flushed(id_);
+  {
+    AutoLock auto_lock(buffer.lock);
+    flushed.Extract(*buffer.samples);
+  }
+  AutoLock auto_lock(*samples_lock_);
+  samples_->Add(flushed);
+}
+
+}  // namespace base
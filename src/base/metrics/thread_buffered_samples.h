@@ -0,0 +1,99 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// ThreadBufferedSamples spreads the samples recorded into one histogram over
+// a set of buffers, so that threads recording into a hot histogram at the same
+// time don't all write to the same cache lines. It backs histograms that have
+// the HistogramBase::kBufferSamplesPerThread flag.
+//
+// Each thread records into one of kNumBuffers buffers, picked round-robin the
+// first time the thread records into any buffered histogram. A buffer is moved
+// into the histogram's own storage every kFlushInterval samples recorded into
+// it, and all buffers are moved when the histogram is snapshotted. Until then,
+// up to kFlushInterval - 1 samples per buffer are only visible to Flush(); in
+// particular they are not in the histogram's persistent memory, if any.
+
+#ifndef BASE_METRICS_THREAD_BUFFERED_SAMPLES_H_
+#define BASE_METRICS_THREAD_BUFFERED_SAMPLES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+
+#include "base/base_export.h"
+#include "base/memory/raw_ptr.h"
+#include "base/metrics/histogram_base.h"
+
+namespace base {
+
+class BucketRanges;
+class HistogramSamples;
+class Lock;
+
+class BASE_EXPORT ThreadBufferedSamples {
+ public:
+  static constexpr size_t kNumBuffers = 16;
+  static constexpr uint32_t kFlushInterval = 256;
+
+  // Buffers samples for a Histogram. Each buffer is a SampleVector with the
+  // given |bucket_ranges|, and |samples| must support concurrent updates
+  // through the atomic operations of SampleVectorBase.
+  ThreadBufferedSamples(uint64_t id,
+                        const BucketRanges* bucket_ranges,
+                        HistogramSamples* samples);
+
+  // Buffers samples for a SparseHistogram. Each buffer is a SampleMap guarded
+  // by its own lock, and |samples| is guarded by |samples_lock|.
+  ThreadBufferedSamples(uint64_t id,
+                        HistogramSamples* samples,
+                        Lock* samples_lock);
+
+  ThreadBufferedSamples(const ThreadBufferedSamples&) = delete;
+  ThreadBufferedSamples& operator=(const ThreadBufferedSamples&) = delete;
+
+  ~ThreadBufferedSamples();
+
+  // Records |count| samples of |value| into the calling thread's buffer.
+  // Thread-safe.
+  void Accumulate(HistogramBase::Sample value, HistogramBase::Count count);
+
+  // Moves the content of all buffers into the histogram's storage. Samples
+  // recorded concurrently are either moved or left for the next call.
+  // Thread-safe, but must not be called with |samples_lock| held.
+  void Flush();
+
+ private:
+  struct Buffer;
+
+  // Returns the calling thread's buffer, creating it if needed.
+  Buffer& GetBuffer();
+
+  // Counts an Accumulate() call on |buffer| and returns whether the buffer is
+  // due to be flushed.
+  static bool CountAccumulateCall(Buffer& buffer);
+
+  // Moves the content of |buffer| into the histogram's storage.
+  void FlushBuffer(Buffer& buffer);
+
+  const uint64_t id_;
+
+  // Null for a SparseHistogram.
+  const raw_ptr<const BucketRanges> bucket_ranges_;
+
+  const raw_ptr<HistogramSamples> samples_;
+
+  // Null for a Histogram, whose |samples_| need no lock.
+  const raw_ptr<Lock> samples_lock_;
+
+  // Lazily created buffers, owned by this object. Never reset once set, so
+  // that recording threads can use them without synchronization beyond the
+  // initial load.
+  std::array<std::atomic<Buffer*>, kNumBuffers> buffers_{};
+};
+
+}  // namespace base
+
+#endif  // BASE_METRICS_THREAD_BUFFERED_SAMPLES_H_
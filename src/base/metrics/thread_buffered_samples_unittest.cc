@@ -0,0 +1,155 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/metrics/thread_buffered_samples.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/memory/raw_ptr.h"
+#include "base/metrics/bucket_ranges.h"
+#include "base/metrics/histogram.h"
+#include "base/metrics/sample_map.h"
+#include "base/metrics/sample_vector.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/simple_thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+constexpr uint64_t kId = 1;
+
+class AccumulateDelegate : public DelegateSimpleThread::Delegate {
+ public:
+  AccumulateDelegate(ThreadBufferedSamples* buffers, int iterations)
+      : buffers_(buffers), iterations_(iterations) {}
+
+  void Run() override {
+    for (int i = 0; i < iterations_; ++i) {
+      buffers_->Accumulate(i % 10, 1);
+    }
+  }
+
+ private:
+  const raw_ptr<ThreadBufferedSamples> buffers_;
+  const int iterations_;
+};
+
+// Accumulates from |num_threads| threads at once, then flushes.
+void AccumulateOnThreads(ThreadBufferedSamples& buffers,
+                         int num_threads,
+                         int iterations) {
+  AccumulateDelegate delegate(&buffers, iterations);
+  std::vector<std::unique_ptr<DelegateSimpleThread>> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(
+        std::make_unique<DelegateSimpleThread>(&delegate, "Accumulate"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads) {
+    thread->Join();
+  }
+  buffers.Flush();
+}
+
+}  // namespace
+
+class ThreadBufferedSamplesTest : public testing::Test {
+ protected:
+  ThreadBufferedSamplesTest() : ranges_(12) {
+    Histogram::InitializeBucketRanges(1, 10, &ranges_);
+  }
+
+  BucketRanges ranges_;
+};
+
+TEST_F(ThreadBufferedSamplesTest, SampleVectorFlush) {
+  SampleVector samples(kId, &ranges_);
+  ThreadBufferedSamples buffers(kId, &ranges_, &samples);
+
+  buffers.Accumulate(1, 2);
+  buffers.Accumulate(5, 1);
+  // Nothing reaches |samples| until a flush.
+  EXPECT_EQ(0, samples.TotalCount());
+
+  buffers.Flush();
+  EXPECT_EQ(3, samples.TotalCount());
+  EXPECT_EQ(2, samples.GetCount(1));
+  EXPECT_EQ(1, samples.GetCount(5));
+  EXPECT_EQ(7, samples.sum());
+  EXPECT_EQ(samples.TotalCount(), samples.redundant_count());
+
+  // A second flush moves nothing.
+  buffers.Flush();
+  EXPECT_EQ(3, samples.TotalCount());
+}
+
+TEST_F(ThreadBufferedSamplesTest, SampleMapFlush) {
+  Lock lock;
+  SampleMap samples(kId);
+  ThreadBufferedSamples buffers(kId, &samples, &lock);
+
+  buffers.Accumulate(1000, 1);
+  buffers.Accumulate(-5, 3);
+  EXPECT_EQ(0, samples.TotalCount());
+
+  buffers.Flush();
+  EXPECT_EQ(4, samples.TotalCount());
+  EXPECT_EQ(1, samples.GetCount(1000));
+  EXPECT_EQ(3, samples.GetCount(-5));
+  EXPECT_EQ(985, samples.sum());
+}
+
+// A buffer is flushed every kFlushInterval calls, so only a bounded number of
+// samples is ever missing from the histogram's storage.
+TEST_F(ThreadBufferedSamplesTest, PeriodicFlush) {
+  SampleVector samples(kId, &ranges_);
+  ThreadBufferedSamples buffers(kId, &ranges_, &samples);
+
+  const int interval = ThreadBufferedSamples::kFlushInterval;
+  for (int i = 0; i < interval - 1; ++i) {
+    buffers.Accumulate(1, 1);
+  }
+  EXPECT_EQ(0, samples.TotalCount());
+  buffers.Accumulate(1, 1);
+  EXPECT_EQ(interval, samples.TotalCount());
+
+  Lock lock;
+  SampleMap map(kId);
+  ThreadBufferedSamples map_buffers(kId, &map, &lock);
+  for (int i = 0; i < interval; ++i) {
+    map_buffers.Accumulate(i, 1);
+  }
+  EXPECT_EQ(interval, map.TotalCount());
+}
+
+TEST_F(ThreadBufferedSamplesTest, SampleVectorMultipleThreads) {
+  constexpr int kNumThreads = ThreadBufferedSamples::kNumBuffers + 4;
+  constexpr int kIterations = 10000;
+  SampleVector samples(kId, &ranges_);
+  ThreadBufferedSamples buffers(kId, &ranges_, &samples);
+
+  AccumulateOnThreads(buffers, kNumThreads, kIterations);
+  EXPECT_EQ(kNumThreads * kIterations, samples.TotalCount());
+  EXPECT_EQ(samples.TotalCount(), samples.redundant_count());
+  EXPECT_EQ(kNumThreads * kIterations / 10, samples.GetCount(3));
+  EXPECT_EQ(kNumThreads * kIterations / 10 * 45, samples.sum());
+}
+
+TEST_F(ThreadBufferedSamplesTest, SampleMapMultipleThreads) {
+  constexpr int kNumThreads = ThreadBufferedSamples::kNumBuffers + 4;
+  constexpr int kIterations = 10000;
+  Lock lock;
+  SampleMap samples(kId);
+  ThreadBufferedSamples buffers(kId, &samples, &lock);
+
+  AccumulateOnThreads(buffers, kNumThreads, kIterations);
+  EXPECT_EQ(kNumThreads * kIterations, samples.TotalCount());
+  EXPECT_EQ(kNumThreads * kIterations / 10, samples.GetCount(3));
+  EXPECT_EQ(kNumThreads * kIterations / 10 * 45, samples.sum());
+}
+
+}  // namespace base
@@ -370,8 +370,10 @@ void Pickle::Reserve(size_t length) {
 #endif
   DCHECK_LE(write_offset_, std::numeric_limits<uint32_t>::max() - data_len);
   size_t new_size = write_offset_ + data_len;
+  // Reserving the exact size of a pickle up front must not allocate twice as
+  // much as needed, but repeated calls still grow the capacity geometrically.
   if (new_size > capacity_after_header_)
-    Resize(capacity_after_header_ * 2 + new_size);
+    Resize(std::max(capacity_after_header_ * 2, new_size));
 }
 
 bool Pickle::WriteAttachment(scoped_refptr<Attachment> attachment) {
@@ -18,6 +18,7 @@
 #include <string_view>
 
 #include "base/base_export.h"
+#include "base/bits.h"
 #include "base/check_op.h"
 #include "base/containers/span.h"
 #include "base/gtest_prod_util.h"
@@ -262,6 +263,14 @@ class BASE_EXPORT Pickle {
   // Reserve() before calling WriteFoo() multiple times.
   void Reserve(size_t additional_capacity);
 
+  // Returns the number of payload bytes used by WriteData() or WriteString() of
+  // |length| bytes, so that callers can compute the exact capacity to Reserve()
+  // for a sequence of writes. WriteString16() uses as much as WriteData() of
+  // the same number of bytes.
+  static constexpr size_t GetWriteDataSize(size_t length) {
+    return sizeof(int) + bits::AlignUp(length, sizeof(uint32_t));
+  }
+
   // Payload follows after allocation of Header (header size is customizable).
   struct Header {
     uint32_t payload_size;  // Specifies the size of the payload.
@@ -378,6 +387,7 @@ class BASE_EXPORT Pickle {
   inline void WriteBytesCommon(span<const uint8_t> data);
 
   FRIEND_TEST_ALL_PREFIXES(PickleTest, DeepCopyResize);
+  FRIEND_TEST_ALL_PREFIXES(PickleTest, ReserveExactSize);
   FRIEND_TEST_ALL_PREFIXES(PickleTest, Resize);
   FRIEND_TEST_ALL_PREFIXES(PickleTest, PeekNext);
   FRIEND_TEST_ALL_PREFIXES(PickleTest, PeekNextOverflow);
@@ -0,0 +1,116 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/pickle.h"
+
+#include <stddef.h>
+
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/timer/lap_timer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace base {
+namespace {
+
+// Roughly the shape of a pickled navigation entry: a few small fields and
+// strings, and one large page state.
+constexpr size_t kStringSizes[] = {32, 256, 16, 32 * 1024, 64, 64};
+constexpr int kNumInts = 12;
+
+size_t GetPayloadSize() {
+  size_t size = kNumInts * sizeof(int);
+  for (size_t string_size : kStringSizes) {
+    size += Pickle::GetWriteDataSize(string_size);
+  }
+  return size;
+}
+
+void WritePayload(const std::vector<std::string>& strings, Pickle& pickle) {
+  for (int i = 0; i < kNumInts; ++i) {
+    pickle.WriteInt(i);
+  }
+  for (const std::string& string : strings) {
+    pickle.WriteString(string);
+  }
+}
+
+std::vector<std::string> MakeStrings() {
+  std::vector<std::string> strings;
+  for (size_t string_size : kStringSizes) {
+    strings.emplace_back(string_size, 'x');
+  }
+  return strings;
+}
+
+template <typename Function>
+void RunTest(const std::string& name, Function function) {
+  LapTimer timer;
+  do {
+    function();
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+
+  perf_test::PerfResultReporter reporter(
+      name, NumberToString(GetPayloadSize()) + "_bytes");
+  reporter.RegisterImportantMetric("throughput", "runs/s");
+  reporter.AddResult("throughput", timer.LapsPerSecond());
+}
+
+TEST(PicklePerfTest, Write) {
+  const std::vector<std::string> strings = MakeStrings();
+  RunTest("PickleWrite", [&] {
+    Pickle pickle;
+    WritePayload(strings, pickle);
+  });
+}
+
+TEST(PicklePerfTest, WriteReserved) {
+  const std::vector<std::string> strings = MakeStrings();
+  RunTest("PickleWriteReserved", [&] {
+    Pickle pickle;
+    pickle.Reserve(GetPayloadSize());
+    WritePayload(strings, pickle);
+  });
+}
+
+TEST(PicklePerfTest, ReadString) {
+  Pickle pickle;
+  WritePayload(MakeStrings(), pickle);
+  RunTest("PickleReadString", [&] {
+    PickleIterator iter(pickle);
+    int value;
+    for (int i = 0; i < kNumInts; ++i) {
+      ASSERT_TRUE(iter.ReadInt(&value));
+    }
+    std::string string;
+    for (size_t i = 0; i < std::size(kStringSizes); ++i) {
+      ASSERT_TRUE(iter.ReadString(&string));
+    }
+  });
+}
+
+TEST(PicklePerfTest, ReadStringPiece) {
+  Pickle pickle;
+  WritePayload(MakeStrings(), pickle);
+  RunTest("PickleReadStringPiece", [&] {
+    PickleIterator iter(pickle);
+    int value;
+    for (int i = 0; i < kNumInts; ++i) {
+      ASSERT_TRUE(iter.ReadInt(&value));
+    }
+    std::string_view string;
+    for (size_t i = 0; i < std::size(kStringSizes); ++i) {
+      ASSERT_TRUE(iter.ReadStringPiece(&string));
+    }
+  });
+}
+
+}  // namespace
+}  // namespace base
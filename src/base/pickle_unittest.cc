@@ -17,6 +17,7 @@
 #include <string>
 #include <tuple>
 
+#include "base/bits.h"
 #include "base/containers/heap_array.h"
 #include "base/containers/span.h"
 #include "base/strings/utf_string_conversions.h"
@@ -567,6 +568,28 @@ TEST(PickleTest, ReadBytes) {
 
 // Checks that when a pickle is deep-copied, the result is not larger than
 // needed.
+// Checks that reserving the exact size of the writes does not over-allocate or
+// need to grow again.
+TEST(PickleTest, ReserveExactSize) {
+  const std::string value(1000, 'x');
+  const std::u16string value16(100, u'x');
+  const size_t payload_size = sizeof(int) + Pickle::GetWriteDataSize(0) +
+                              Pickle::GetWriteDataSize(value.size()) +
+                              Pickle::GetWriteDataSize(value16.size() * 2);
+
+  Pickle pickle;
+  pickle.Reserve(payload_size);
+  const size_t capacity = pickle.capacity_after_header();
+  EXPECT_EQ(bits::AlignUp(payload_size, Pickle::kPayloadUnit), capacity);
+
+  pickle.WriteInt(1);
+  pickle.WriteString(std::string());
+  pickle.WriteString(value);
+  pickle.WriteString16(value16);
+  EXPECT_EQ(payload_size, pickle.payload_size());
+  EXPECT_EQ(capacity, pickle.capacity_after_header());
+}
+
 TEST(PickleTest, DeepCopyResize) {
   Pickle pickle;
   while (pickle.capacity_after_header() != pickle.payload_size())
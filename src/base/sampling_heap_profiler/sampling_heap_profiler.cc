@@ -18,6 +18,7 @@
 #include "base/debug/stack_trace.h"
 #include "base/feature_list.h"
 #include "base/functional/bind.h"
+#include "base/hash/hash.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/no_destructor.h"
@@ -251,7 +252,8 @@ void SamplingHeapProfiler::SampleAdded(void* address,
   DCHECK(PoissonAllocationSampler::ScopedMuteThreadSamples::IsMuted());
   Sample sample(size, total, ++last_sample_ordinal_);
   sample.allocator = type;
-  CaptureNativeStack(context, &sample);
+  const void* frames[kMaxStackEntries];
+  span<const void*> stack = CaptureNativeStack(context, frames, &sample);
   AutoLock lock(mutex_);
   if (UNLIKELY(PoissonAllocationSampler::AreHookedSamplesMuted() &&
                type != AllocationSubsystem::kManualForTesting)) {
@@ -267,18 +269,24 @@ void SamplingHeapProfiler::SampleAdded(void* address,
   // the sampling heap profiler failed to observe the destruction -- possibly
   // because the sampling heap profiler was temporarily disabled. We should
   // override the old entry.
-  samples_.insert_or_assign(address, std::move(sample));
+  LiveSample live_sample{std::move(sample), AcquireStack(stack)};
+  auto [it, inserted] = samples_.try_emplace(address, std::move(live_sample));
+  if (!inserted) {
+    ReleaseStack(it->second.stack);
+    it->second = std::move(live_sample);
+  }
 }
 
-void SamplingHeapProfiler::CaptureNativeStack(const char* context,
-                                              Sample* sample) {
-  const void* stack[kMaxStackEntries];
+span<const void*> SamplingHeapProfiler::CaptureNativeStack(
+    const char* context,
+    span<const void*> frames,
+    Sample* sample) {
+  DCHECK_EQ(frames.size(), kMaxStackEntries);
   size_t frame_count;
   // One frame is reserved for the thread name.
   const void** first_frame =
-      CaptureStackTrace(stack, kMaxStackEntries - 1, &frame_count);
+      CaptureStackTrace(frames.data(), kMaxStackEntries - 1, &frame_count);
   DCHECK_LT(frame_count, kMaxStackEntries);
-  sample->stack.assign(first_frame, first_frame + frame_count);
 
   if (record_thread_names_)
     sample->thread_name = CachedThreadName();
@@ -290,16 +298,53 @@ void SamplingHeapProfiler::CaptureNativeStack(const char* context,
       context = tracker->TaskContext();
   }
   sample->context = context;
+  return frames.subspan(static_cast<size_t>(first_frame - frames.data()),
+                        frame_count);
 }
 
 const char* SamplingHeapProfiler::RecordString(const char* string) {
   return string ? *strings_.insert(string).first : nullptr;
 }
 
+size_t SamplingHeapProfiler::StackHash::operator()(
+    span<const void* const> stack) const {
+  return FastHash(as_bytes(stack));
+}
+
+bool SamplingHeapProfiler::StackEqual::operator()(
+    span<const void* const> a,
+    span<const void* const> b) const {
+  return std::ranges::equal(a, b);
+}
+
+SamplingHeapProfiler::StackTable::value_type*
+SamplingHeapProfiler::AcquireStack(span<const void* const> frames) {
+  // Look up by span first so that callsites seen before do not allocate.
+  auto it = stacks_.find(frames);
+  if (it == stacks_.end()) {
+    it = stacks_.emplace(Stack(frames.begin(), frames.end()), 0).first;
+  }
+  ++it->second;
+  return &*it;
+}
+
+void SamplingHeapProfiler::ReleaseStack(StackTable::value_type* stack) {
+  DCHECK_GT(stack->second, 0u);
+  if (stack->second > 1) {
+    --stack->second;
+    return;
+  }
+  stacks_.erase(stacks_.find(stack->first));
+}
+
 void SamplingHeapProfiler::SampleRemoved(void* address) {
   DCHECK(base::PoissonAllocationSampler::ScopedMuteThreadSamples::IsMuted());
   base::AutoLock lock(mutex_);
-  samples_.erase(address);
+  auto it = samples_.find(address);
+  if (it == samples_.end())
+    return;
+  ReleaseStack(it->second.stack);
+  samples_.erase(it);
 }
 
 std::vector<SamplingHeapProfiler::Sample> SamplingHeapProfiler::GetSamples(
@@ -312,9 +357,11 @@ std::vector<SamplingHeapProfiler::Sample> SamplingHeapProfiler::GetSamples(
   std::vector<Sample> samples;
   samples.reserve(samples_.size());
   for (auto& it : samples_) {
-    Sample& sample = it.second;
-    if (sample.ordinal > profile_id)
-      samples.push_back(sample);
+    const LiveSample& live_sample = it.second;
+    if (live_sample.sample.ordinal > profile_id) {
+      samples.push_back(live_sample.sample);
+      samples.back().stack = live_sample.stack->first;
+    }
   }
   return samples;
 }
@@ -350,6 +397,7 @@ SamplingHeapProfiler::MuteHookedSamplesForTesting() {
 
   base::AutoLock lock(mutex_);
   samples_.clear();
+  stacks_.clear();
   // Since hooked samples are muted, any samples that are waiting to take the
   // lock in SampleAdded will be discarded. Tests can now call
   // PoissonAllocationSampler::RecordAlloc with allocator type kManualForTesting
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/base_export.h"
+#include "base/containers/span.h"
 #include "base/no_destructor.h"
 #include "base/sampling_heap_profiler/poisson_allocation_sampler.h"
 #include "base/synchronization/lock.h"
@@ -128,14 +129,51 @@ class BASE_EXPORT SamplingHeapProfiler
                    const char* context) override;
   void SampleRemoved(void* address) override;
 
-  void CaptureNativeStack(const char* context, Sample* sample);
+  // Call stacks are stored once for all the live samples allocated from the
+  // same callsite, and looked up by the captured frames without copying them.
+  using Stack = std::vector<const void*>;
+  struct StackHash {
+    using is_transparent = void;
+    size_t operator()(span<const void* const> stack) const;
+  };
+  struct StackEqual {
+    using is_transparent = void;
+    bool operator()(span<const void* const> a,
+                    span<const void* const> b) const;
+  };
+  // Maps each stack to the number of live samples referencing it.
+  using StackTable = std::unordered_map<Stack, size_t, StackHash, StackEqual>;
+
+  // A live sample. Its |sample.stack| is left empty in favor of |stack|.
+  struct LiveSample {
+    Sample sample;
+    // Points into |stacks_|. Node-based containers keep it valid on rehash.
+    StackTable::value_type* stack;
+  };
+
+  // Captures the call stack into |frames| and fills in the context and thread
+  // name of |sample|. Returns the captured frames.
+  span<const void*> CaptureNativeStack(const char* context,
+                                       span<const void*> frames,
+                                       Sample* sample);
   const char* RecordString(const char* string) EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
-  // Mutex to access |samples_| and |strings_|.
+  // Returns the shared copy of |frames|, adding a reference to it.
+  StackTable::value_type* AcquireStack(span<const void* const> frames)
+      EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Drops a reference added by AcquireStack(), deleting the stack once no
+  // live samples use it.
+  void ReleaseStack(StackTable::value_type* stack)
+      EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Mutex to access |samples_|, |stacks_| and |strings_|.
   Lock mutex_;
 
   // Samples of the currently live allocations.
-  std::unordered_map<void*, Sample> samples_ GUARDED_BY(mutex_);
+  std::unordered_map<void*, LiveSample> samples_ GUARDED_BY(mutex_);
+
+  // Call stacks of the samples in |samples_|.
+  StackTable stacks_ GUARDED_BY(mutex_);
 
   // Contains pointers to static sample context strings that are never deleted.
   std::unordered_set<const char*> strings_ GUARDED_BY(mutex_);
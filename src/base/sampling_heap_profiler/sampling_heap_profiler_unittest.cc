@@ -377,4 +377,42 @@ TEST_F(SamplingHeapProfilerTest, HookedAllocatorMuted) {
   EXPECT_TRUE(collector.sample_removed);
 }
 
+
+TEST_F(SamplingHeapProfilerTest, SamplesShareCallsiteStacks) {
+  ScopedSuppressRandomnessForTesting suppress;
+  auto* profiler = SamplingHeapProfiler::Get();
+  auto mute_hooks = profiler->MuteHookedSamplesForTesting();
+  profiler->SetSamplingInterval(1024);
+  uint32_t profile_id = profiler->Start();
+  if (!profile_id) {
+    GTEST_SKIP() << "Stack unwinding is not available.";
+  }
+
+  // All three allocations are made from the same callsite.
+  auto* sampler = PoissonAllocationSampler::Get();
+  void* const kAddresses[] = {reinterpret_cast<void*>(0x1000),
+                              reinterpret_cast<void*>(0x2000),
+                              reinterpret_cast<void*>(0x3000)};
+  for (void* address : kAddresses) {
+    sampler->OnAllocation(AllocationNotificationData(
+        address, 10000, nullptr, AllocationSubsystem::kManualForTesting));
+  }
+  sampler->OnFree(FreeNotificationData(kAddresses[1],
+                                       AllocationSubsystem::kManualForTesting));
+
+  std::vector<SamplingHeapProfiler::Sample> samples =
+      profiler->GetSamples(profile_id);
+  ASSERT_EQ(2u, samples.size());
+  EXPECT_FALSE(samples[0].stack.empty());
+  EXPECT_EQ(samples[0].stack, samples[1].stack);
+
+  // Freeing the remaining samples drops the last references to the stack.
+  for (void* address : {kAddresses[0], kAddresses[2]}) {
+    sampler->OnFree(
+        FreeNotificationData(address, AllocationSubsystem::kManualForTesting));
+  }
+  EXPECT_TRUE(profiler->GetSamples(profile_id).empty());
+  profiler->Stop();
+}
+
 }  // namespace base
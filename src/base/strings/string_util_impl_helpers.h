@@ -10,6 +10,8 @@
 #ifndef BASE_STRINGS_STRING_UTIL_IMPL_HELPERS_H_
 #define BASE_STRINGS_STRING_UTIL_IMPL_HELPERS_H_
 
+#include <string.h>
+
 #include <algorithm>
 #include <optional>
 #include <string_view>
@@ -157,18 +159,18 @@ std::basic_string<CharT> CollapseWhitespaceT(
   return result;
 }
 
+// Bitmasks to detect non ASCII characters for character sizes of 8, 16 and 32
+// bits.
+inline constexpr MachineWord kNonASCIIMasks[] = {
+    0, MachineWord(0x8080808080808080ULL), MachineWord(0xFF80FF80FF80FF80ULL),
+    0, MachineWord(0xFFFFFF80FFFFFF80ULL),
+};
+
 template <class Char>
 bool DoIsStringASCII(const Char* characters, size_t length) {
-  // Bitmasks to detect non ASCII characters for character sizes of 8, 16 and 32
-  // bits.
-  constexpr MachineWord NonASCIIMasks[] = {
-      0, MachineWord(0x8080808080808080ULL), MachineWord(0xFF80FF80FF80FF80ULL),
-      0, MachineWord(0xFFFFFF80FFFFFF80ULL),
-  };
-
   if (!length)
     return true;
-  constexpr MachineWord non_ascii_bit_mask = NonASCIIMasks[sizeof(Char)];
+  constexpr MachineWord non_ascii_bit_mask = kNonASCIIMasks[sizeof(Char)];
   static_assert(non_ascii_bit_mask, "Error: Invalid Mask");
   MachineWord all_char_bits = 0;
   const Char* end = characters + length;
@@ -206,6 +208,31 @@ bool DoIsStringASCII(const Char* characters, size_t length) {
   return !(all_char_bits & non_ascii_bit_mask);
 }
 
+// Returns the number of ASCII characters at the start of `characters`. Checks a
+// machine word at a time, so that the UTF conversion and validation loops can
+// skip runs of ASCII without decoding them one code point at a time.
+template <class Char>
+size_t CountLeadingASCII(const Char* characters, size_t length) {
+  constexpr MachineWord non_ascii_bit_mask = kNonASCIIMasks[sizeof(Char)];
+  static_assert(non_ascii_bit_mask, "Error: Invalid Mask");
+  constexpr size_t chars_per_word = sizeof(MachineWord) / sizeof(Char);
+
+  size_t i = 0;
+  while (length - i >= chars_per_word) {
+    // Unaligned load; memcpy compiles to a single move.
+    MachineWord word;
+    memcpy(&word, characters + i, sizeof(word));
+    if (word & non_ascii_bit_mask)
+      break;
+    i += chars_per_word;
+  }
+  while (i < length &&
+         !(static_cast<MachineWord>(characters[i]) & non_ascii_bit_mask)) {
+    ++i;
+  }
+  return i;
+}
+
 template <bool (*Validator)(base_icu::UChar32)>
 inline bool DoIsStringUTF8(StringPiece str) {
   const uint8_t* src = reinterpret_cast<const uint8_t*>(str.data());
@@ -213,6 +240,12 @@ inline bool DoIsStringUTF8(StringPiece str) {
   size_t char_index = 0;
 
   while (char_index < src_len) {
+    // ASCII characters are valid for every validator.
+    if (src[char_index] < 0x80) {
+      char_index +=
+          CountLeadingASCII(str.data() + char_index, src_len - char_index);
+      continue;
+    }
     base_icu::UChar32 code_point;
     CBU8_NEXT(src, char_index, src_len, code_point);
     if (!Validator(code_point))
@@ -12,6 +12,7 @@
 #include <limits.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <concepts>
 #include <ostream>
 #include <string_view>
@@ -19,6 +20,7 @@
 
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
+#include "base/strings/string_util_impl_helpers.h"
 #include "base/strings/utf_ostream_operators.h"
 #include "base/strings/utf_string_conversion_utils.h"
 #include "base/third_party/icu/icu_utf.h"
@@ -100,6 +102,23 @@ void UnicodeAppendUnsafe(Char* out,
   out[(*size)++] = static_cast<Char>(code_point);
 }
 
+// AppendASCIIRun -------------------------------------------------------------
+// Copies the run of ASCII characters starting at src[*i] to dest. ASCII is
+// encoded by the same single codeunit in every encoding, so the run is copied
+// without decoding, in a loop the compiler can vectorize.
+
+template <typename SrcChar, typename DestChar>
+void AppendASCIIRun(const SrcChar* src,
+                    size_t src_len,
+                    size_t* i,
+                    DestChar* dest,
+                    size_t* dest_len) {
+  size_t run_len = internal::CountLeadingASCII(src + *i, src_len - *i);
+  std::copy_n(src + *i, run_len, dest + *dest_len);
+  *i += run_len;
+  *dest_len += run_len;
+}
+
 // DoUTFConversion ------------------------------------------------------------
 // Main driver of UTFConversion specialized for different Src encodings.
 // dest has to have enough room for the converted text.
@@ -112,6 +131,11 @@ bool DoUTFConversion(const char* src,
   bool success = true;
 
   for (size_t i = 0; i < src_len;) {
+    if (static_cast<uint8_t>(src[i]) < 0x80) {
+      AppendASCIIRun(src, src_len, &i, dest, dest_len);
+      continue;
+    }
+
     base_icu::UChar32 code_point;
     CBU8_NEXT(reinterpret_cast<const uint8_t*>(src), i, src_len, code_point);
 
@@ -146,6 +170,11 @@ bool DoUTFConversion(const char16_t* src,
   // Always have another symbol in order to avoid checking boundaries in the
   // middle of the surrogate pair.
   while (i + 1 < src_len) {
+    if (src[i] < 0x80) {
+      AppendASCIIRun(src, src_len, &i, dest, dest_len);
+      continue;
+    }
+
     base_icu::UChar32 code_point;
 
     if (CBU16_IS_LEAD(src[i]) && CBU16_IS_TRAIL(src[i + 1])) {
@@ -200,7 +229,10 @@ bool DoUTFConversion(const wchar_t* src,
 
 template <typename InputString, typename DestString>
 bool UTFConversion(const InputString& src_str, DestString* dest_str) {
-  if (IsStringASCII(src_str)) {
+  // The ASCII prefix is copied as is, so only the rest needs converting.
+  const size_t ascii_len =
+      internal::CountLeadingASCII(src_str.data(), src_str.length());
+  if (ascii_len == src_str.length()) {
     dest_str->assign(src_str.begin(), src_str.end());
     return true;
   }
@@ -212,11 +244,11 @@ bool UTFConversion(const InputString& src_str, DestString* dest_str) {
   // Empty string is ASCII => it OK to call operator[].
   auto* dest = &(*dest_str)[0];
 
-  // ICU requires 32 bit numbers.
-  size_t src_len = src_str.length();
-  size_t dest_len = 0;
+  std::copy_n(src_str.data(), ascii_len, dest);
+  size_t dest_len = ascii_len;
 
-  bool res = DoUTFConversion(src_str.data(), src_len, dest, &dest_len);
+  bool res = DoUTFConversion(src_str.data() + ascii_len,
+                             src_str.length() - ascii_len, dest, &dest_len);
 
   dest_str->resize(dest_len);
   dest_str->shrink_to_fit();
@@ -0,0 +1,83 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/strings/utf_string_conversions.h"
+
+#include <stddef.h>
+
+#include <string>
+
+#include "base/strings/string_util.h"
+#include "base/timer/lap_timer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace base {
+namespace {
+
+constexpr size_t kTextLength = 64 * 1024;
+
+// Builds about `kTextLength` UTF-8 bytes by repeating `pattern`.
+std::string RepeatPattern(const char* pattern) {
+  std::string text;
+  while (text.size() < kTextLength) {
+    text += pattern;
+  }
+  return text;
+}
+
+// The mix of text the browser converts: page titles and omnibox text are
+// mostly ASCII, with some Latin-1 and CJK titles.
+std::string AsciiText() {
+  return RepeatPattern("The quick brown fox jumps over the lazy dog. ");
+}
+
+std::string LatinText() {
+  return RepeatPattern("Le cœur déçu mais l'âme plutôt naïve, Louÿs rêva. ");
+}
+
+std::string CjkText() {
+  return RepeatPattern("网页 图片 资讯更多 » ");
+}
+
+template <typename Convert>
+void RunTest(const std::string& story, Convert convert) {
+  LapTimer timer;
+  do {
+    convert();
+    timer.NextLap();
+  } while (!timer.HasTimeLimitExpired());
+
+  perf_test::PerfResultReporter reporter("UTFStringConversions", story);
+  reporter.RegisterImportantMetric("", "runs/s");
+  reporter.AddResult("", timer.LapsPerSecond());
+}
+
+void RunConversionTests(const std::string& name, const std::string& utf8) {
+  const std::u16string utf16 = UTF8ToUTF16(utf8);
+  RunTest(name + "_UTF8ToUTF16", [&] {
+    std::u16string output;
+    UTF8ToUTF16(utf8.data(), utf8.size(), &output);
+  });
+  RunTest(name + "_UTF16ToUTF8", [&] {
+    std::string output;
+    UTF16ToUTF8(utf16.data(), utf16.size(), &output);
+  });
+  RunTest(name + "_IsStringUTF8", [&] { IsStringUTF8(utf8); });
+}
+
+TEST(UTFStringConversionsPerfTest, Ascii) {
+  RunConversionTests("Ascii", AsciiText());
+}
+
+TEST(UTFStringConversionsPerfTest, Latin) {
+  RunConversionTests("Latin", LatinText());
+}
+
+TEST(UTFStringConversionsPerfTest, Cjk) {
+  RunConversionTests("Cjk", CjkText());
+}
+
+}  // namespace
+}  // namespace base
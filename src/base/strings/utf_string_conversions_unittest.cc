@@ -6,6 +6,8 @@
 
 #include <stddef.h>
 
+#include <string>
+
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "build/build_config.h"
@@ -192,4 +194,39 @@ TEST(UTFStringConversionsTest, ConvertMultiString) {
   EXPECT_EQ(expected, UTF16ToUTF8(multistring16));
 }
 
+// ASCII runs are copied a machine word at a time, so place a non-ASCII
+// character, and an invalid sequence, at every offset around word boundaries.
+TEST(UTFStringConversionsTest, ConvertASCIIRunsAroundNonASCII) {
+  for (size_t length = 0; length <= 40; ++length) {
+    for (size_t pos = 0; pos <= length; ++pos) {
+      const std::string prefix(pos, 'a');
+      const std::string suffix(length - pos, 'z');
+      const std::u16string prefix16(pos, u'a');
+      const std::u16string suffix16(length - pos, u'z');
+
+      // U+00E9 and U+1F600, which is a surrogate pair in UTF-16.
+      std::string utf8 = prefix + "\xC3\xA9" + suffix + "\xF0\x9F\x98\x80";
+      std::u16string utf16 = prefix16 + u"\u00E9" + suffix16 + u"\U0001F600";
+      std::u16string converted16;
+      EXPECT_TRUE(UTF8ToUTF16(utf8.data(), utf8.size(), &converted16));
+      EXPECT_EQ(utf16, converted16);
+      std::string converted8;
+      EXPECT_TRUE(UTF16ToUTF8(utf16.data(), utf16.size(), &converted8));
+      EXPECT_EQ(utf8, converted8);
+      EXPECT_TRUE(IsStringUTF8(utf8));
+
+      // A stray continuation byte and a lone surrogate are replaced.
+      utf8 = prefix + "\x80" + suffix;
+      utf16 = prefix16 + u'\xD800' + suffix16;
+      const std::u16string expected16 = prefix16 + u"\uFFFD" + suffix16;
+      const std::string expected8 = prefix + "\xEF\xBF\xBD" + suffix;
+      EXPECT_FALSE(UTF8ToUTF16(utf8.data(), utf8.size(), &converted16));
+      EXPECT_EQ(expected16, converted16);
+      EXPECT_FALSE(UTF16ToUTF8(utf16.data(), utf16.size(), &converted8));
+      EXPECT_EQ(expected8, converted8);
+      EXPECT_FALSE(IsStringUTF8(utf8));
+    }
+  }
+}
+
 }  // namespace base
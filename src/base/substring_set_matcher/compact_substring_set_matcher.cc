@@ -0,0 +1,368 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/substring_set_matcher/compact_substring_set_matcher.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/check_op.h"
+#include "base/memory/ptr_util.h"
+#include "base/numerics/checked_math.h"
+#include "base/substring_set_matcher/substring_set_matcher.h"
+#include "base/trace_event/memory_usage_estimator.h"  // no-presubmit-check
+
+namespace base {
+
+namespace {
+
+// Layout of the compact tree:
+//   kHeaderSize words: kMagic, kVersion, number of nodes, number of edges.
+//   One word per node: the index of its first edge, and kHasOutputsBit.
+//   One word holding the number of edges.
+//   One word per edge: the label in the top kLabelBits bits, and the node ID
+//   (or pattern ID, for kMatchIDLabel) in the low kValueBits bits.
+//
+// The edges of a node are sorted by label. As all character labels are below
+// the special ones, the failure edge, output link and match ID come last.
+constexpr uint32_t kMagic = 0x53534d43;  // "SSMC"
+constexpr uint32_t kVersion = 1;
+constexpr size_t kHeaderSize = 4;
+constexpr size_t kNumNodesIndex = 2;
+constexpr size_t kNumEdgesIndex = 3;
+
+constexpr uint32_t kValueBits = 23;
+constexpr uint32_t kValueMask = (1u << kValueBits) - 1;
+constexpr uint32_t kHasOutputsBit = 1u << 31;
+constexpr uint32_t kOffsetMask = kHasOutputsBit - 1;
+
+// Nodes with at most this many edges are searched linearly. Wider nodes, which
+// are usually close to the root, use a binary search.
+constexpr size_t kMaxEdgesForLinearSearch = 8;
+
+uint32_t PackEdge(uint32_t label, uint32_t value) {
+  DCHECK_LE(value, kValueMask);
+  return (label << kValueBits) | value;
+}
+
+uint32_t GetLabel(uint32_t edge) {
+  return edge >> kValueBits;
+}
+
+uint32_t GetValue(uint32_t edge) {
+  return edge & kValueMask;
+}
+
+}  // namespace
+
+CompactSubstringSetMatcher::CompactSubstringSetMatcher() = default;
+CompactSubstringSetMatcher::~CompactSubstringSetMatcher() = default;
+
+// static
+std::vector<uint32_t> CompactSubstringSetMatcher::Serialize(
+    const SubstringSetMatcher& matcher) {
+  using AhoCorasickEdge = SubstringSetMatcher::AhoCorasickEdge;
+  const std::vector<SubstringSetMatcher::AhoCorasickNode>& tree =
+      matcher.tree_;
+
+  // Number the nodes in breadth-first order, visiting the children of each
+  // node in the order of their labels. |order| maps new IDs to old ones.
+  std::vector<NodeID> order;
+  std::vector<NodeID> new_ids(tree.size(), SubstringSetMatcher::kInvalidNodeID);
+  order.reserve(tree.size());
+  size_t num_edges = 0;
+  if (!tree.empty()) {
+    new_ids[SubstringSetMatcher::kRootID] = 0;
+    order.push_back(SubstringSetMatcher::kRootID);
+  }
+  std::vector<AhoCorasickEdge> children;
+  for (size_t i = 0; i < order.size(); ++i) {
+    const SubstringSetMatcher::AhoCorasickNode& node = tree[order[i]];
+    num_edges += node.num_edges();
+    children.clear();
+    for (size_t edge_idx = 0; edge_idx < node.num_edges(); ++edge_idx) {
+      const AhoCorasickEdge& edge = node.edges()[edge_idx];
+      if (edge.label < SubstringSetMatcher::kFirstSpecialLabel)
+        children.push_back(edge);
+    }
+    std::sort(children.begin(), children.end(),
+              [](const AhoCorasickEdge& a, const AhoCorasickEdge& b) {
+                return a.label < b.label;
+              });
+    for (const AhoCorasickEdge& child : children) {
+      new_ids[child.node_id] = static_cast<NodeID>(order.size());
+      order.push_back(child.node_id);
+    }
+  }
+  DCHECK_EQ(order.size(), tree.size());
+
+  // A matcher on which Build() was not called still gets a root, so that the
+  // result is always a valid tree.
+  const size_t num_nodes = std::max<size_t>(order.size(), 1u);
+
+  std::vector<uint32_t> data;
+  data.reserve(kHeaderSize + num_nodes + 1 + num_edges);
+  data.push_back(kMagic);
+  data.push_back(kVersion);
+  data.push_back(static_cast<uint32_t>(num_nodes));
+  data.push_back(static_cast<uint32_t>(num_edges));
+  data.resize(kHeaderSize + num_nodes + 1);
+
+  uint32_t edge_offset = 0;
+  for (size_t i = 0; i < order.size(); ++i) {
+    const SubstringSetMatcher::AhoCorasickNode& node = tree[order[i]];
+    data[kHeaderSize + i] =
+        edge_offset | (node.has_outputs() ? kHasOutputsBit : 0u);
+
+    const size_t first_edge = data.size();
+    for (size_t edge_idx = 0; edge_idx < node.num_edges(); ++edge_idx) {
+      const AhoCorasickEdge& edge = node.edges()[edge_idx];
+      // Match IDs are not node IDs, so they are kept as they are.
+      const uint32_t value = edge.label == SubstringSetMatcher::kMatchIDLabel
+                                 ? edge.node_id
+                                 : new_ids[edge.node_id];
+      data.push_back(PackEdge(edge.label, value));
+    }
+    std::sort(data.begin() + first_edge, data.end());
+    edge_offset += node.num_edges();
+  }
+  data[kHeaderSize + num_nodes] = edge_offset;
+  DCHECK_EQ(data.size(), kHeaderSize + num_nodes + 1 + num_edges);
+  return data;
+}
+
+// static
+MappedReadOnlyRegion CompactSubstringSetMatcher::SerializeToSharedMemory(
+    const SubstringSetMatcher& matcher) {
+  std::vector<uint32_t> data = Serialize(matcher);
+  MappedReadOnlyRegion region =
+      ReadOnlySharedMemoryRegion::Create(data.size() * sizeof(uint32_t));
+  if (!region.IsValid())
+    return {};
+  std::ranges::copy(data,
+                    region.mapping.GetMemoryAsSpan<uint32_t>().begin());
+  return region;
+}
+
+// static
+std::unique_ptr<CompactSubstringSetMatcher> CompactSubstringSetMatcher::Create(
+    std::vector<uint32_t> data) {
+  auto matcher = WrapUnique(new CompactSubstringSetMatcher());
+  matcher->buffer_ = std::move(data);
+  if (!matcher->Init(matcher->buffer_))
+    return nullptr;
+  return matcher;
+}
+
+// static
+std::unique_ptr<CompactSubstringSetMatcher> CompactSubstringSetMatcher::Create(
+    ReadOnlySharedMemoryMapping mapping) {
+  if (!mapping.IsValid())
+    return nullptr;
+  auto matcher = WrapUnique(new CompactSubstringSetMatcher());
+  matcher->mapping_ = std::move(mapping);
+  if (!matcher->Init(matcher->mapping_.GetMemoryAsSpan<uint32_t>()))
+    return nullptr;
+  return matcher;
+}
+
+bool CompactSubstringSetMatcher::Init(span<const uint32_t> data) {
+  if (data.size() < kHeaderSize || data[0] != kMagic || data[1] != kVersion)
+    return false;
+
+  const uint32_t num_nodes = data[kNumNodesIndex];
+  const uint32_t num_edges = data[kNumEdgesIndex];
+  if (num_nodes == 0 || num_nodes >= SubstringSetMatcher::kInvalidNodeID ||
+      num_edges > kOffsetMask) {
+    return false;
+  }
+  CheckedNumeric<size_t> size = kHeaderSize;
+  size += num_nodes;
+  size += 1;
+  size += num_edges;
+  // A shared memory mapping may be rounded up in size, so only the words of
+  // the tree need to be present.
+  if (!size.IsValid() || size.ValueOrDie() > data.size())
+    return false;
+
+  nodes_ = data.subspan(kHeaderSize, num_nodes + 1u);
+  edges_ = data.subspan(kHeaderSize + num_nodes + 1u, num_edges);
+  if ((nodes_[0] & kOffsetMask) != 0 || nodes_[num_nodes] != num_edges)
+    return false;
+
+  // Check every edge, so that matching can neither read out of bounds nor loop
+  // forever. Character edges must lead to a later node, and failure edges and
+  // output links to an earlier one, which holds for breadth-first numbering.
+  for (NodeID node = 0; node < num_nodes; ++node) {
+    const size_t begin = EdgesBegin(node);
+    const size_t end = EdgesEnd(node);
+    if (begin > end)
+      return false;
+
+    bool has_outputs = false;
+    uint32_t previous_label = 0;
+    for (size_t i = begin; i < end; ++i) {
+      const uint32_t label = GetLabel(edges_[i]);
+      const uint32_t value = GetValue(edges_[i]);
+      if (i != begin && label <= previous_label)
+        return false;
+      previous_label = label;
+
+      if (label < SubstringSetMatcher::kFirstSpecialLabel) {
+        if (value <= node || value >= num_nodes)
+          return false;
+      } else if (label == SubstringSetMatcher::kFailureNodeLabel) {
+        if (value >= node)
+          return false;
+      } else if (label == SubstringSetMatcher::kOutputLinkLabel) {
+        // Output links lead to nodes that end a pattern.
+        if (value >= node ||
+            GetEdge(value, SubstringSetMatcher::kMatchIDLabel) ==
+                SubstringSetMatcher::kInvalidNodeID) {
+          return false;
+        }
+        has_outputs = true;
+      } else if (label == SubstringSetMatcher::kMatchIDLabel) {
+        if (value >= SubstringSetMatcher::kInvalidNodeID)
+          return false;
+        has_outputs = true;
+      } else {
+        return false;
+      }
+    }
+    if (has_outputs != HasOutputs(node))
+      return false;
+  }
+  return true;
+}
+
+bool CompactSubstringSetMatcher::Match(
+    const std::string& text,
+    std::set<MatcherStringPattern::ID>* matches) const {
+  const size_t old_number_of_matches = matches->size();
+
+  // Handle patterns matching the empty string.
+  constexpr NodeID kRootID = SubstringSetMatcher::kRootID;
+  AccumulateMatchesForNode(kRootID, matches);
+
+  NodeID current_node = kRootID;
+  for (const char c : text) {
+    NodeID child = GetEdge(current_node, static_cast<unsigned char>(c));
+
+    // See SubstringSetMatcher::Match().
+    while (child == SubstringSetMatcher::kInvalidNodeID &&
+           current_node != kRootID) {
+      current_node = GetFailure(current_node);
+      child = GetEdge(current_node, static_cast<unsigned char>(c));
+    }
+
+    if (child != SubstringSetMatcher::kInvalidNodeID) {
+      current_node = child;
+      AccumulateMatchesForNode(current_node, matches);
+    }
+  }
+
+  return old_number_of_matches != matches->size();
+}
+
+bool CompactSubstringSetMatcher::AnyMatch(const std::string& text) const {
+  // Handle patterns matching the empty string.
+  constexpr NodeID kRootID = SubstringSetMatcher::kRootID;
+  if (HasOutputs(kRootID))
+    return true;
+
+  NodeID current_node = kRootID;
+  for (const char c : text) {
+    NodeID child = GetEdge(current_node, static_cast<unsigned char>(c));
+    while (child == SubstringSetMatcher::kInvalidNodeID &&
+           current_node != kRootID) {
+      current_node = GetFailure(current_node);
+      child = GetEdge(current_node, static_cast<unsigned char>(c));
+    }
+
+    if (child != SubstringSetMatcher::kInvalidNodeID) {
+      current_node = child;
+      if (HasOutputs(current_node))
+        return true;
+    }
+  }
+
+  return false;
+}
+
+size_t CompactSubstringSetMatcher::EstimateMemoryUsage() const {
+  return trace_event::EstimateMemoryUsage(buffer_);
+}
+
+CompactSubstringSetMatcher::NodeID CompactSubstringSetMatcher::GetEdge(
+    NodeID node,
+    uint32_t label) const {
+  const size_t begin = EdgesBegin(node);
+  const size_t end = EdgesEnd(node);
+  if (end - begin <= kMaxEdgesForLinearSearch) {
+    for (size_t i = begin; i < end; ++i) {
+      const uint32_t edge_label = GetLabel(edges_[i]);
+      if (edge_label >= label) {
+        return edge_label == label ? GetValue(edges_[i])
+                                   : SubstringSetMatcher::kInvalidNodeID;
+      }
+    }
+    return SubstringSetMatcher::kInvalidNodeID;
+  }
+
+  span<const uint32_t> edges = edges_.subspan(begin, end - begin);
+  auto it = std::lower_bound(edges.begin(), edges.end(),
+                             PackEdge(label, /*value=*/0));
+  if (it == edges.end() || GetLabel(*it) != label)
+    return SubstringSetMatcher::kInvalidNodeID;
+  return GetValue(*it);
+}
+
+CompactSubstringSetMatcher::NodeID CompactSubstringSetMatcher::GetFailure(
+    NodeID node) const {
+  // The special labels are last, so look for the failure edge from the end.
+  const size_t begin = EdgesBegin(node);
+  for (size_t i = EdgesEnd(node); i > begin; --i) {
+    const uint32_t label = GetLabel(edges_[i - 1]);
+    if (label == SubstringSetMatcher::kFailureNodeLabel)
+      return GetValue(edges_[i - 1]);
+    if (label < SubstringSetMatcher::kFailureNodeLabel)
+      break;
+  }
+  return SubstringSetMatcher::kRootID;
+}
+
+bool CompactSubstringSetMatcher::HasOutputs(NodeID node) const {
+  return nodes_[node] & kHasOutputsBit;
+}
+
+size_t CompactSubstringSetMatcher::EdgesBegin(NodeID node) const {
+  return nodes_[node] & kOffsetMask;
+}
+
+size_t CompactSubstringSetMatcher::EdgesEnd(NodeID node) const {
+  return nodes_[node + 1] & kOffsetMask;
+}
+
+void CompactSubstringSetMatcher::AccumulateMatchesForNode(
+    NodeID node,
+    std::set<MatcherStringPattern::ID>* matches) const {
+  DCHECK(matches);
+
+  if (!HasOutputs(node)) {
+    // Fast reject.
+    return;
+  }
+  NodeID match_id = GetEdge(node, SubstringSetMatcher::kMatchIDLabel);
+  if (match_id != SubstringSetMatcher::kInvalidNodeID)
+    matches->insert(match_id);
+
+  NodeID output_link = GetEdge(node, SubstringSetMatcher::kOutputLinkLabel);
+  while (output_link != SubstringSetMatcher::kInvalidNodeID) {
+    matches->insert(GetEdge(output_link, SubstringSetMatcher::kMatchIDLabel));
+    output_link = GetEdge(output_link, SubstringSetMatcher::kOutputLinkLabel);
+  }
+}
+
+}  // namespace base
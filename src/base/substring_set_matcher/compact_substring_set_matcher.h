@@ -0,0 +1,126 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_SUBSTRING_SET_MATCHER_COMPACT_SUBSTRING_SET_MATCHER_H_
+#define BASE_SUBSTRING_SET_MATCHER_COMPACT_SUBSTRING_SET_MATCHER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/containers/span.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "base/substring_set_matcher/matcher_string_pattern.h"
+
+namespace base {
+
+class SubstringSetMatcher;
+
+// An immutable copy of the Aho-Corasick tree of a SubstringSetMatcher, laid
+// out in a single flat array of 32-bit words so that it can be placed in
+// shared memory and mapped by several processes.
+//
+// The nodes are numbered in breadth-first order, so that the part of the tree
+// near the root, where matching spends most of its time, is contiguous. Each
+// node is a single word holding the offset of its edges, and the edges of all
+// nodes are packed back to back, sorted by label. There are no pointers and no
+// per-node allocations, which makes the compact tree several times smaller than
+// the one of the SubstringSetMatcher it was made from.
+//
+// The compact tree always matches with the Aho-Corasick automaton, regardless
+// of the SubstringSetMatcher::Engine the source matcher was built with.
+class BASE_EXPORT CompactSubstringSetMatcher {
+ public:
+  CompactSubstringSetMatcher(const CompactSubstringSetMatcher&) = delete;
+  CompactSubstringSetMatcher& operator=(const CompactSubstringSetMatcher&) =
+      delete;
+  ~CompactSubstringSetMatcher();
+
+  // Returns the compact form of the tree of |matcher|. |matcher| may be
+  // discarded afterwards.
+  static std::vector<uint32_t> Serialize(const SubstringSetMatcher& matcher);
+
+  // As Serialize(), but writes the compact tree into a new read-only shared
+  // memory region, which can be sent to other processes. Returns an invalid
+  // region if it could not be created.
+  static MappedReadOnlyRegion SerializeToSharedMemory(
+      const SubstringSetMatcher& matcher);
+
+  // Creates a matcher over |data|, as returned by Serialize(). Returns nullptr
+  // if |data| is not a valid compact tree.
+  static std::unique_ptr<CompactSubstringSetMatcher> Create(
+      std::vector<uint32_t> data);
+
+  // Creates a matcher over |mapping| of a region returned by
+  // SerializeToSharedMemory(). Returns nullptr if the mapping does not hold a
+  // valid compact tree. The data is checked before it is used, so |mapping|
+  // may come from a less trusted process.
+  static std::unique_ptr<CompactSubstringSetMatcher> Create(
+      ReadOnlySharedMemoryMapping mapping);
+
+  // Same as SubstringSetMatcher::Match().
+  bool Match(const std::string& text,
+             std::set<MatcherStringPattern::ID>* matches) const;
+
+  // Same as SubstringSetMatcher::AnyMatch().
+  bool AnyMatch(const std::string& text) const;
+
+  // Returns the dynamically allocated memory usage in bytes. Memory of a shared
+  // memory mapping is not included, since it is not owned by this process
+  // alone.
+  size_t EstimateMemoryUsage() const;
+
+ private:
+  using NodeID = uint32_t;
+
+  CompactSubstringSetMatcher();
+
+  // Points |nodes_| and |edges_| into |data|, after checking that |data| is a
+  // valid compact tree. Returns false if it is not.
+  bool Init(span<const uint32_t> data);
+
+  // Returns the node at the end of the edge of |node| with |label|, or the
+  // value stored with a special label. Returns kInvalidNodeID if there is no
+  // such edge.
+  NodeID GetEdge(NodeID node, uint32_t label) const;
+
+  // Returns the node that the failure edge of |node| leads to.
+  NodeID GetFailure(NodeID node) const;
+
+  // Returns true if reaching |node| during traversal creates matches.
+  bool HasOutputs(NodeID node) const;
+
+  // Returns the first and one past the last index in |edges_| of the edges of
+  // |node|.
+  size_t EdgesBegin(NodeID node) const;
+  size_t EdgesEnd(NodeID node) const;
+
+  // Adds all pattern IDs to |matches| which are a suffix of the string
+  // represented by |node|.
+  void AccumulateMatchesForNode(
+      NodeID node,
+      std::set<MatcherStringPattern::ID>* matches) const;
+
+  // Owns the data if the matcher was created from a vector.
+  std::vector<uint32_t> buffer_;
+
+  // Owns the data if the matcher was created from shared memory.
+  ReadOnlySharedMemoryMapping mapping_;
+
+  // One word per node, plus a final one holding the total number of edges.
+  span<const uint32_t> nodes_;
+
+  // The edges of all nodes, each as a label and a value packed into a word.
+  span<const uint32_t> edges_;
+};
+
+}  // namespace base
+
+#endif  // BASE_SUBSTRING_SET_MATCHER_COMPACT_SUBSTRING_SET_MATCHER_H_
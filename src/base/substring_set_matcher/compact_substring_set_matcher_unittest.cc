@@ -0,0 +1,156 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/substring_set_matcher/compact_substring_set_matcher.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/substring_set_matcher/substring_set_matcher.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// Returns patterns that share prefixes and suffixes, including the empty one.
+std::vector<MatcherStringPattern> GetPatterns() {
+  std::vector<MatcherStringPattern> patterns;
+  int id = 0;
+  patterns.emplace_back("", id++);
+  for (const char* prefix : {"ab", "abc", "bcd", "cab", "dddd"}) {
+    for (const char* suffix : {"", "a", "ba", "cab", "abcd"}) {
+      patterns.emplace_back(std::string(prefix) + suffix, id++);
+    }
+  }
+  return patterns;
+}
+
+void ExpectSameMatches(const SubstringSetMatcher& matcher,
+                       const CompactSubstringSetMatcher& compact_matcher) {
+  for (const char* text :
+       {"", "a", "ab", "xxabcabcdxx", "cabcabcab", "dddddddabcdba", "bcbcbc",
+        "xyzabxyzbcdcabdddd"}) {
+    std::set<MatcherStringPattern::ID> expected_matches;
+    std::set<MatcherStringPattern::ID> matches;
+    EXPECT_EQ(matcher.Match(text, &expected_matches),
+              compact_matcher.Match(text, &matches))
+        << text;
+    EXPECT_EQ(expected_matches, matches) << text;
+    EXPECT_EQ(matcher.AnyMatch(text), compact_matcher.AnyMatch(text)) << text;
+  }
+}
+
+}  // namespace
+
+TEST(CompactSubstringSetMatcherTest, MatchesLikeSourceMatcher) {
+  std::vector<MatcherStringPattern> patterns = GetPatterns();
+  SubstringSetMatcher matcher;
+  ASSERT_TRUE(matcher.Build(patterns));
+
+  std::unique_ptr<CompactSubstringSetMatcher> compact_matcher =
+      CompactSubstringSetMatcher::Create(
+          CompactSubstringSetMatcher::Serialize(matcher));
+  ASSERT_TRUE(compact_matcher);
+  ExpectSameMatches(matcher, *compact_matcher);
+  EXPECT_LT(compact_matcher->EstimateMemoryUsage(),
+            matcher.EstimateMemoryUsage() + sizeof(matcher));
+}
+
+TEST(CompactSubstringSetMatcherTest, NoEmptyPattern) {
+  std::vector<MatcherStringPattern> patterns = GetPatterns();
+  patterns.erase(patterns.begin());
+  SubstringSetMatcher matcher;
+  ASSERT_TRUE(matcher.Build(patterns));
+
+  std::unique_ptr<CompactSubstringSetMatcher> compact_matcher =
+      CompactSubstringSetMatcher::Create(
+          CompactSubstringSetMatcher::Serialize(matcher));
+  ASSERT_TRUE(compact_matcher);
+  ExpectSameMatches(matcher, *compact_matcher);
+}
+
+// Test a node with more edges than are searched linearly.
+TEST(CompactSubstringSetMatcherTest, LotsOfEdges) {
+  std::vector<MatcherStringPattern> patterns;
+  for (int i = 0; i < 256; ++i) {
+    std::string str;
+    str.push_back('a');
+    str.push_back(static_cast<char>(i));
+    patterns.emplace_back(str, i);
+  }
+  patterns.emplace_back("a", 256);
+
+  SubstringSetMatcher matcher;
+  ASSERT_TRUE(matcher.Build(patterns));
+  std::unique_ptr<CompactSubstringSetMatcher> compact_matcher =
+      CompactSubstringSetMatcher::Create(
+          CompactSubstringSetMatcher::Serialize(matcher));
+  ASSERT_TRUE(compact_matcher);
+
+  std::set<MatcherStringPattern::ID> matches;
+  EXPECT_TRUE(compact_matcher->Match("xa\x80y", &matches));
+  EXPECT_EQ((std::set<MatcherStringPattern::ID>{0x80, 256}), matches);
+  EXPECT_FALSE(compact_matcher->AnyMatch("xyz"));
+}
+
+TEST(CompactSubstringSetMatcherTest, EmptyMatcher) {
+  SubstringSetMatcher matcher;
+  std::unique_ptr<CompactSubstringSetMatcher> compact_matcher =
+      CompactSubstringSetMatcher::Create(
+          CompactSubstringSetMatcher::Serialize(matcher));
+  ASSERT_TRUE(compact_matcher);
+
+  std::set<MatcherStringPattern::ID> matches;
+  EXPECT_FALSE(compact_matcher->Match("abd", &matches));
+  EXPECT_TRUE(matches.empty());
+  EXPECT_FALSE(compact_matcher->AnyMatch("abd"));
+}
+
+TEST(CompactSubstringSetMatcherTest, SharedMemory) {
+  std::vector<MatcherStringPattern> patterns = GetPatterns();
+  SubstringSetMatcher matcher;
+  ASSERT_TRUE(matcher.Build(patterns));
+
+  MappedReadOnlyRegion region =
+      CompactSubstringSetMatcher::SerializeToSharedMemory(matcher);
+  ASSERT_TRUE(region.IsValid());
+
+  std::unique_ptr<CompactSubstringSetMatcher> compact_matcher =
+      CompactSubstringSetMatcher::Create(region.region.Map());
+  ASSERT_TRUE(compact_matcher);
+  ExpectSameMatches(matcher, *compact_matcher);
+  EXPECT_EQ(0u, compact_matcher->EstimateMemoryUsage());
+}
+
+TEST(CompactSubstringSetMatcherTest, RejectsInvalidData) {
+  std::vector<MatcherStringPattern> patterns = GetPatterns();
+  SubstringSetMatcher matcher;
+  ASSERT_TRUE(matcher.Build(patterns));
+  const std::vector<uint32_t> data =
+      CompactSubstringSetMatcher::Serialize(matcher);
+
+  EXPECT_FALSE(CompactSubstringSetMatcher::Create(std::vector<uint32_t>()));
+
+  // Truncated.
+  std::vector<uint32_t> truncated(data.begin(), data.end() - 1);
+  EXPECT_FALSE(CompactSubstringSetMatcher::Create(truncated));
+
+  // Bad magic.
+  std::vector<uint32_t> bad_magic = data;
+  bad_magic[0] ^= 1;
+  EXPECT_FALSE(CompactSubstringSetMatcher::Create(bad_magic));
+
+  // An edge of the last node that leads back to the root would loop forever.
+  std::vector<uint32_t> cycle = data;
+  cycle.back() = 0;
+  EXPECT_FALSE(CompactSubstringSetMatcher::Create(cycle));
+}
+
+}  // namespace base
@@ -10,6 +10,7 @@
 #include "base/substring_set_matcher/substring_set_matcher.h"
 
 #include <stddef.h>
+#include <string.h>
 
 #include <algorithm>
 #include <queue>
@@ -29,6 +30,16 @@ namespace base {
 
 namespace {
 
+// Maximum number of characters hashed into the prefilter.
+constexpr size_t kMaxPrefilterWindow = 4;
+
+// Bounds on the size of the prefilter, in log2 of the number of bits. The
+// prefilter has at least |kPrefilterBitsPerPattern| bits per pattern within
+// these bounds, so that most positions of a text miss.
+constexpr uint32_t kMinPrefilterBits = 12;
+constexpr uint32_t kMaxPrefilterBits = 23;
+constexpr size_t kPrefilterBitsPerPattern = 16;
+
 // Compare MatcherStringPattern instances based on their string patterns.
 bool ComparePatterns(const MatcherStringPattern* a,
                      const MatcherStringPattern* b) {
@@ -49,12 +60,14 @@ std::vector<const MatcherStringPattern*> GetVectorOfPointers(
 }  // namespace
 
 bool SubstringSetMatcher::Build(
-    const std::vector<MatcherStringPattern>& patterns) {
-  return Build(GetVectorOfPointers(patterns));
+    const std::vector<MatcherStringPattern>& patterns,
+    Engine engine) {
+  return Build(GetVectorOfPointers(patterns), engine);
 }
 
 bool SubstringSetMatcher::Build(
-    std::vector<const MatcherStringPattern*> patterns) {
+    std::vector<const MatcherStringPattern*> patterns,
+    Engine engine) {
   // Ensure there are no duplicate IDs and all pattern strings are distinct.
 #if DCHECK_IS_ON()
   {
@@ -89,6 +102,10 @@ bool SubstringSetMatcher::Build(
   // size was correct.
   DCHECK_EQ(tree_.size(), static_cast<size_t>(GetTreeSize(patterns)));
 
+  engine_ = engine;
+  if (engine_ == Engine::kPrefilter)
+    BuildPrefilter(patterns);
+
   is_empty_ = patterns.empty() && tree_.size() == 1u;
   return true;
 }
@@ -101,6 +118,11 @@ bool SubstringSetMatcher::Match(
     std::set<MatcherStringPattern::ID>* matches) const {
   const size_t old_number_of_matches = matches->size();
 
+  if (engine_ == Engine::kPrefilter) {
+    PrefilterMatch(text, matches);
+    return old_number_of_matches != matches->size();
+  }
+
   // Handle patterns matching the empty string.
   const AhoCorasickNode* const root = &tree_[kRootID];
   AccumulateMatchesForNode(root, matches);
@@ -133,6 +155,9 @@ bool SubstringSetMatcher::Match(
 }
 
 bool SubstringSetMatcher::AnyMatch(const std::string& text) const {
+  if (engine_ == Engine::kPrefilter)
+    return PrefilterMatch(text, nullptr);
+
   // Handle patterns matching the empty string.
   const AhoCorasickNode* const root = &tree_[kRootID];
   if (root->has_outputs()) {
@@ -169,7 +194,8 @@ bool SubstringSetMatcher::AnyMatch(const std::string& text) const {
 }
 
 size_t SubstringSetMatcher::EstimateMemoryUsage() const {
-  return base::trace_event::EstimateMemoryUsage(tree_);
+  return base::trace_event::EstimateMemoryUsage(tree_) +
+         base::trace_event::EstimateMemoryUsage(prefilter_);
 }
 
 // static
@@ -347,6 +373,96 @@ void SubstringSetMatcher::AccumulateMatchesForNode(
   }
 }
 
+void SubstringSetMatcher::BuildPrefilter(
+    const SubstringPatternVector& patterns) {
+  prefilter_window_ = 0;
+  for (const MatcherStringPattern* pattern : patterns) {
+    size_t length = pattern->pattern().size();
+    if (length != 0 && (prefilter_window_ == 0 || length < prefilter_window_))
+      prefilter_window_ = length;
+  }
+  prefilter_window_ = std::min(prefilter_window_, kMaxPrefilterWindow);
+  if (prefilter_window_ == 0)
+    return;
+
+  uint32_t bits = kMinPrefilterBits;
+  while (bits < kMaxPrefilterBits &&
+         (size_t{1} << bits) < patterns.size() * kPrefilterBitsPerPattern) {
+    ++bits;
+  }
+  prefilter_shift_ = 32 - bits;
+  prefilter_.assign((size_t{1} << bits) / 64, 0);
+
+  for (const MatcherStringPattern* pattern : patterns) {
+    if (pattern->pattern().empty())
+      continue;
+    size_t bit = GetPrefilterBit(pattern->pattern().data());
+    prefilter_[bit / 64] |= uint64_t{1} << (bit % 64);
+  }
+}
+
+size_t SubstringSetMatcher::GetPrefilterBit(const char* data) const {
+  uint32_t value = 0;
+  memcpy(&value, data, prefilter_window_);
+  // Multiplicative hashing: the top bits of the product depend on all the
+  // hashed characters.
+  return (value * 0x9E3779B1u) >> prefilter_shift_;
+}
+
+bool SubstringSetMatcher::PrefilterMatch(
+    const std::string& text,
+    std::set<MatcherStringPattern::ID>* matches) const {
+  bool found = false;
+
+  // Handle patterns matching the empty string.
+  const AhoCorasickNode* const root = &tree_[kRootID];
+  if (root->IsEndOfPattern()) {
+    if (!matches)
+      return true;
+    matches->insert(root->GetMatchID());
+    found = true;
+  }
+
+  // Every other pattern is at least |prefilter_window_| characters long.
+  if (prefilter_window_ == 0 || text.size() < prefilter_window_)
+    return found;
+
+  const char* const data = text.data();
+  const size_t last_offset = text.size() - prefilter_window_;
+  for (size_t offset = 0; offset <= last_offset; ++offset) {
+    size_t bit = GetPrefilterBit(data + offset);
+    if (!(prefilter_[bit / 64] & (uint64_t{1} << (bit % 64))))
+      continue;
+    if (MatchPatternsStartingAt(text, offset, matches)) {
+      if (!matches)
+        return true;
+      found = true;
+    }
+  }
+  return found;
+}
+
+bool SubstringSetMatcher::MatchPatternsStartingAt(
+    const std::string& text,
+    size_t offset,
+    std::set<MatcherStringPattern::ID>* matches) const {
+  bool found = false;
+  const AhoCorasickNode* node = &tree_[kRootID];
+  for (size_t i = offset; i < text.size(); ++i) {
+    NodeID child = node->GetEdge(static_cast<unsigned char>(text[i]));
+    if (child == kInvalidNodeID)
+      break;
+    node = &tree_[child];
+    if (node->IsEndOfPattern()) {
+      if (!matches)
+        return true;
+      matches->insert(node->GetMatchID());
+      found = true;
+    }
+  }
+  return found;
+}
+
 SubstringSetMatcher::AhoCorasickNode::AhoCorasickNode() {
   static_assert(kNumInlineEdges == 2, "Code below needs updating");
   edges_.inline_edges[0].label = kEmptyLabel;
@@ -34,9 +34,22 @@ class BASE_EXPORT SubstringSetMatcher {
 
   ~SubstringSetMatcher();
 
+  // The algorithm that Match() and AnyMatch() use to find patterns in a text.
+  enum class Engine {
+    // Follows the Aho-Corasick automaton for every character of the text.
+    kAhoCorasick,
+    // Looks up a hash of the next few characters of the text in a bitmap built
+    // from the start of every pattern, and only follows the trie from the
+    // positions where a pattern may start. Most positions are skipped with a
+    // single lookup, which makes it faster than kAhoCorasick for large sets of
+    // patterns, unless some of them are only one or two characters long.
+    kPrefilter,
+  };
+
   // Registers all |patterns|. Each pattern needs to have a unique ID and all
   // pattern strings must be unique. Build() should be called exactly once
-  // (before it is called, the tree is empty).
+  // (before it is called, the tree is empty). |engine| selects how texts are
+  // matched against the patterns.
   //
   // Complexity:
   //    Let n = number of patterns.
@@ -47,8 +60,10 @@ class BASE_EXPORT SubstringSetMatcher {
   // log(k) comes from our usage of std::map to store edges.
   //
   // Returns true on success (may fail if e.g. if the tree gets too many nodes).
-  bool Build(const std::vector<MatcherStringPattern>& patterns);
-  bool Build(std::vector<const MatcherStringPattern*> patterns);
+  bool Build(const std::vector<MatcherStringPattern>& patterns,
+             Engine engine = Engine::kAhoCorasick);
+  bool Build(std::vector<const MatcherStringPattern*> patterns,
+             Engine engine = Engine::kAhoCorasick);
 
   // Matches |text| against all registered MatcherStringPatterns. Stores the IDs
   // of matching patterns in |matches|. |matches| is not cleared before adding
@@ -58,6 +73,8 @@ class BASE_EXPORT SubstringSetMatcher {
   //    Let k = range of char. Generally 256.
   //    Let z = number of matches returned.
   // Complexity = O(t * logk + zlogz)
+  // With Engine::kPrefilter, each position of |text| where a pattern may start
+  // additionally costs up to the length of the longest pattern.
   bool Match(const std::string& text,
              std::set<MatcherStringPattern::ID>* matches) const;
 
@@ -75,6 +92,9 @@ class BASE_EXPORT SubstringSetMatcher {
   size_t EstimateMemoryUsage() const;
 
  private:
+  // Reads |tree_| to lay it out in a flat array.
+  friend class CompactSubstringSetMatcher;
+
   // Represents the index of the node within |tree_|. It is specifically
   // uint32_t so that we can be sure it takes up 4 bytes when stored together
   // with the 9-bit label (so 23 bits are allocated to the NodeID, even though
@@ -333,9 +353,42 @@ class BASE_EXPORT SubstringSetMatcher {
       const AhoCorasickNode* node,
       std::set<MatcherStringPattern::ID>* matches) const;
 
+  // Fills |prefilter_| with the start of every non-empty pattern.
+  void BuildPrefilter(const SubstringPatternVector& patterns);
+
+  // Returns the bit of |prefilter_| for the |prefilter_window_| characters
+  // starting at |data|.
+  size_t GetPrefilterBit(const char* data) const;
+
+  // Implements Match() and AnyMatch() for Engine::kPrefilter. Adds the IDs of
+  // the patterns found in |text| to |matches|, or returns on the first one if
+  // |matches| is null. Returns true if any pattern was found.
+  bool PrefilterMatch(const std::string& text,
+                      std::set<MatcherStringPattern::ID>* matches) const;
+
+  // Follows the trie from the root along |text| from |offset|, to find the
+  // patterns that start there. Same results as PrefilterMatch().
+  bool MatchPatternsStartingAt(
+      const std::string& text,
+      size_t offset,
+      std::set<MatcherStringPattern::ID>* matches) const;
+
   // The nodes of a Aho-Corasick tree.
   std::vector<AhoCorasickNode> tree_;
 
+  Engine engine_ = Engine::kAhoCorasick;
+
+  // Bitmap of hashes of the first |prefilter_window_| characters of every
+  // non-empty pattern. Only used with Engine::kPrefilter.
+  std::vector<uint64_t> prefilter_;
+
+  // Number of characters hashed into |prefilter_|: the length of the shortest
+  // non-empty pattern, capped to 4. Zero if there are no non-empty patterns.
+  size_t prefilter_window_ = 0;
+
+  // Shift that turns a 32-bit hash into a bit of |prefilter_|.
+  uint32_t prefilter_shift_ = 0;
+
   bool is_empty_ = true;
 };
 
@@ -10,6 +10,7 @@
 
 #include "base/containers/contains.h"
 #include "base/rand_util.h"
+#include "base/substring_set_matcher/compact_substring_set_matcher.h"
 #include "base/time/time.h"
 #include "base/timer/elapsed_timer.h"
 #include "base/trace_event/memory_usage_estimator.h"  // no-presubmit-check
@@ -30,16 +31,18 @@ std::string GetRandomString(size_t len) {
   return std::string(random_chars.begin(), random_chars.end());
 }
 
-// Tests performance of SubstringSetMatcher for 20000 random patterns of length
-// 30.
-TEST(SubstringSetMatcherPerfTest, RandomKeys) {
+// Tests performance of SubstringSetMatcher with |engine| for |num_patterns|
+// random patterns of length 30, and reports it under |story_name|. With
+// Engine::kAhoCorasick, also reports CompactSubstringSetMatcher.
+void RunRandomKeysTest(size_t num_patterns,
+                       SubstringSetMatcher::Engine engine,
+                       const std::string& story_name) {
   std::vector<MatcherStringPattern> patterns;
   std::set<std::string> pattern_strings;
 
   // Create patterns.
-  const size_t kNumPatterns = 20000;
   const size_t kPatternLen = 30;
-  for (size_t i = 0; i < kNumPatterns; i++) {
+  for (size_t i = 0; i < num_patterns; i++) {
     std::string str = GetRandomString(kPatternLen);
 
     // Ensure we don't have any duplicate pattern strings.
@@ -55,21 +58,22 @@ TEST(SubstringSetMatcherPerfTest, RandomKeys) {
   // Allocate SubstringSetMatcher on the heap so that EstimateMemoryUsage below
   // also includes its stack allocated memory.
   auto matcher = std::make_unique<SubstringSetMatcher>();
-  ASSERT_TRUE(matcher->Build(patterns));
+  ASSERT_TRUE(matcher->Build(patterns, engine));
   base::TimeDelta init_time = init_timer.Elapsed();
 
   // Match patterns against a random string of 500 characters.
   const size_t kTextLen = 500;
+  std::string text = GetRandomString(kTextLen);
   base::ElapsedTimer match_timer;
   std::set<MatcherStringPattern::ID> matches;
-  matcher->Match(GetRandomString(kTextLen), &matches);
+  matcher->Match(text, &matches);
   base::TimeDelta match_time = match_timer.Elapsed();
 
   const char* kInitializationTime = ".init_time";
   const char* kMatchTime = ".match_time";
   const char* kMemoryUsage = ".memory_usage";
   auto reporter =
-      perf_test::PerfResultReporter("SubstringSetMatcher", "RandomKeys");
+      perf_test::PerfResultReporter("SubstringSetMatcher", story_name);
   reporter.RegisterImportantMetric(kInitializationTime, "us");
   reporter.RegisterImportantMetric(kMatchTime, "us");
   reporter.RegisterImportantMetric(kMemoryUsage, "Mb");
@@ -79,6 +83,57 @@ TEST(SubstringSetMatcherPerfTest, RandomKeys) {
   reporter.AddResult(
       kMemoryUsage,
       (base::trace_event::EstimateMemoryUsage(matcher) * 1.0 / (1 << 20)));
+
+  if (engine != SubstringSetMatcher::Engine::kAhoCorasick)
+    return;
+
+  // Report the same for the compact form of the tree.
+  base::ElapsedTimer compact_init_timer;
+  std::unique_ptr<CompactSubstringSetMatcher> compact_matcher =
+      CompactSubstringSetMatcher::Create(
+          CompactSubstringSetMatcher::Serialize(*matcher));
+  ASSERT_TRUE(compact_matcher);
+  base::TimeDelta compact_init_time = compact_init_timer.Elapsed();
+
+  base::ElapsedTimer compact_match_timer;
+  std::set<MatcherStringPattern::ID> compact_matches;
+  compact_matcher->Match(text, &compact_matches);
+  base::TimeDelta compact_match_time = compact_match_timer.Elapsed();
+  EXPECT_EQ(matches, compact_matches);
+
+  auto compact_reporter = perf_test::PerfResultReporter(
+      "SubstringSetMatcher", story_name + "Compact");
+  compact_reporter.RegisterImportantMetric(kInitializationTime, "us");
+  compact_reporter.RegisterImportantMetric(kMatchTime, "us");
+  compact_reporter.RegisterImportantMetric(kMemoryUsage, "Mb");
+
+  compact_reporter.AddResult(kInitializationTime, compact_init_time);
+  compact_reporter.AddResult(kMatchTime, compact_match_time);
+  compact_reporter.AddResult(
+      kMemoryUsage,
+      (base::trace_event::EstimateMemoryUsage(compact_matcher) * 1.0 /
+       (1 << 20)));
+}
+
+// Tests performance of SubstringSetMatcher for 20000 random patterns of length
+// 30.
+TEST(SubstringSetMatcherPerfTest, RandomKeys) {
+  RunRandomKeysTest(20000, SubstringSetMatcher::Engine::kAhoCorasick,
+                    "RandomKeys");
+}
+
+TEST(SubstringSetMatcherPerfTest, RandomKeys10k) {
+  RunRandomKeysTest(10000, SubstringSetMatcher::Engine::kAhoCorasick,
+                    "RandomKeys10k");
+  RunRandomKeysTest(10000, SubstringSetMatcher::Engine::kPrefilter,
+                    "RandomKeys10kPrefilter");
+}
+
+TEST(SubstringSetMatcherPerfTest, RandomKeys100k) {
+  RunRandomKeysTest(100000, SubstringSetMatcher::Engine::kAhoCorasick,
+                    "RandomKeys100k");
+  RunRandomKeysTest(100000, SubstringSetMatcher::Engine::kPrefilter,
+                    "RandomKeys100kPrefilter");
 }
 
 }  // namespace
@@ -17,6 +17,10 @@ namespace base {
 
 namespace {
 
+constexpr SubstringSetMatcher::Engine kEngines[] = {
+    SubstringSetMatcher::Engine::kAhoCorasick,
+    SubstringSetMatcher::Engine::kPrefilter};
+
 void TestOnePattern(const std::string& test_string,
                     const std::string& pattern,
                     bool is_match) {
@@ -24,14 +28,17 @@ void TestOnePattern(const std::string& test_string,
                      (is_match ? "1" : "0") + ")";
   std::vector<MatcherStringPattern> patterns;
   patterns.emplace_back(pattern, 1);
-  SubstringSetMatcher matcher;
-  ASSERT_TRUE(matcher.Build(patterns));
-  std::set<MatcherStringPattern::ID> matches;
-  matcher.Match(test_string, &matches);
+  for (SubstringSetMatcher::Engine engine : kEngines) {
+    SubstringSetMatcher matcher;
+    ASSERT_TRUE(matcher.Build(patterns, engine));
+    std::set<MatcherStringPattern::ID> matches;
+    matcher.Match(test_string, &matches);
 
-  size_t expected_matches = (is_match ? 1 : 0);
-  EXPECT_EQ(expected_matches, matches.size()) << test;
-  EXPECT_EQ(is_match, matches.find(1) != matches.end()) << test;
+    size_t expected_matches = (is_match ? 1 : 0);
+    EXPECT_EQ(expected_matches, matches.size()) << test;
+    EXPECT_EQ(is_match, matches.find(1) != matches.end()) << test;
+    EXPECT_EQ(is_match, matcher.AnyMatch(test_string)) << test;
+  }
 }
 
 void TestTwoPatterns(const std::string& test_string,
@@ -56,15 +63,17 @@ void TestTwoPatterns(const std::string& test_string,
       patterns.push_back(&substring_pattern_2);
       patterns.push_back(&substring_pattern_1);
     }
-    SubstringSetMatcher matcher;
-    ASSERT_TRUE(matcher.Build(patterns));
-    std::set<MatcherStringPattern::ID> matches;
-    matcher.Match(test_string, &matches);
-
-    size_t expected_matches = (is_match_1 ? 1 : 0) + (is_match_2 ? 1 : 0);
-    EXPECT_EQ(expected_matches, matches.size()) << test;
-    EXPECT_EQ(is_match_1, matches.find(1) != matches.end()) << test;
-    EXPECT_EQ(is_match_2, matches.find(2) != matches.end()) << test;
+    for (SubstringSetMatcher::Engine engine : kEngines) {
+      SubstringSetMatcher matcher;
+      ASSERT_TRUE(matcher.Build(patterns, engine));
+      std::set<MatcherStringPattern::ID> matches;
+      matcher.Match(test_string, &matches);
+
+      size_t expected_matches = (is_match_1 ? 1 : 0) + (is_match_2 ? 1 : 0);
+      EXPECT_EQ(expected_matches, matches.size()) << test;
+      EXPECT_EQ(is_match_1, matches.find(1) != matches.end()) << test;
+      EXPECT_EQ(is_match_2, matches.find(2) != matches.end()) << test;
+    }
   }
 }
 
@@ -177,14 +186,49 @@ TEST(SubstringSetMatcherTest, TestMatcher3) {
     }
   }
 
-  SubstringSetMatcher matcher;
-  matcher.Build(patterns);
-  std::set<MatcherStringPattern::ID> matches;
-  matcher.Match(text, &matches);
-  EXPECT_EQ(patterns.size(), matches.size());
-  for (const MatcherStringPattern& pattern : patterns) {
-    EXPECT_TRUE(matches.find(pattern.id()) != matches.end())
-        << pattern.pattern();
+  for (SubstringSetMatcher::Engine engine : kEngines) {
+    SubstringSetMatcher matcher;
+    matcher.Build(patterns, engine);
+    std::set<MatcherStringPattern::ID> matches;
+    matcher.Match(text, &matches);
+    EXPECT_EQ(patterns.size(), matches.size());
+    for (const MatcherStringPattern& pattern : patterns) {
+      EXPECT_TRUE(matches.find(pattern.id()) != matches.end())
+          << pattern.pattern();
+    }
+  }
+}
+
+// Test that both engines find the same patterns when many patterns share
+// prefixes and suffixes, and some are shorter than the others.
+TEST(SubstringSetMatcherTest, EnginesFindSamePatterns) {
+  std::vector<MatcherStringPattern> patterns;
+  int id = 0;
+  for (const char* prefix : {"ab", "abc", "bcd", "cab", "dddd"}) {
+    for (const char* suffix : {"", "a", "ba", "cab", "abcd"}) {
+      patterns.emplace_back(std::string(prefix) + suffix, id++);
+    }
+  }
+
+  SubstringSetMatcher aho_corasick_matcher;
+  ASSERT_TRUE(aho_corasick_matcher.Build(
+      patterns, SubstringSetMatcher::Engine::kAhoCorasick));
+  SubstringSetMatcher prefilter_matcher;
+  ASSERT_TRUE(prefilter_matcher.Build(
+      patterns, SubstringSetMatcher::Engine::kPrefilter));
+
+  for (const char* text :
+       {"", "a", "ab", "xxabcabcdxx", "cabcabcab", "dddddddabcdba", "bcbcbc",
+        "xyzabxyzbcdcabdddd"}) {
+    std::set<MatcherStringPattern::ID> expected_matches;
+    std::set<MatcherStringPattern::ID> matches;
+    EXPECT_EQ(aho_corasick_matcher.Match(text, &expected_matches),
+              prefilter_matcher.Match(text, &matches))
+        << text;
+    EXPECT_EQ(expected_matches, matches) << text;
+    EXPECT_EQ(aho_corasick_matcher.AnyMatch(text),
+              prefilter_matcher.AnyMatch(text))
+        << text;
   }
 }
 
@@ -4,6 +4,7 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <atomic>
 #include <optional>
 #include <utility>
@@ -34,6 +35,8 @@ namespace {
 // - No-op + disrupted: 10 disruptive tasks are posted every 1ms.
 // - Busy wait: Work items are busy wait for 5us.
 // - Busy wait + disrupted
+// For comparison, RunSequencedTasks() posts work items as individual tasks to
+// a sequence, either one by one or in batches.
 
 constexpr char kMetricPrefixJob[] = "Job.";
 constexpr char kMetricWorkThroughput[] = "work_throughput";
@@ -52,6 +55,8 @@ constexpr char kStoryNoOpLoopAroundDisrupted[] = "noop_loop_around_disrupted";
 constexpr char kStoryBusyWaitLoopAround[] = "busy_wait_loop_around";
 constexpr char kStoryBusyWaitLoopAroundDisrupted[] =
     "busy_wait_loop_around_disrupted";
+constexpr char kStoryNoOpPostTask[] = "noop_post_task";
+constexpr char kStoryNoOpPostTasksBatch[] = "noop_post_tasks_batch";
 
 perf_test::PerfResultReporter SetUpReporter(const std::string& story_name) {
   perf_test::PerfResultReporter reporter(kMetricPrefixJob, story_name);
@@ -398,6 +403,46 @@ class JobPerfTest : public testing::Test {
                        size_t(num_work_items / job_duration.InMilliseconds()));
   }
 
+  // Process |num_work_items| no-op tasks posted to a SequencedTaskRunner.
+  // Tasks are posted with PostTasks() in batches of |batch_size| tasks, or
+  // with PostTask() one by one if |batch_size| is 1.
+  void RunSequencedTasks(const std::string& story_name,
+                         size_t num_work_items,
+                         size_t batch_size) {
+    auto task_runner =
+        ThreadPool::CreateSequencedTaskRunner({TaskPriority::USER_VISIBLE});
+    WaitableEvent complete;
+
+    const TimeTicks job_run_start = TimeTicks::Now();
+
+    for (size_t i = 0; i < num_work_items; i += batch_size) {
+      const size_t num_tasks = std::min(batch_size, num_work_items - i);
+      const bool is_last_batch = i + num_tasks == num_work_items;
+      if (batch_size == 1) {
+        task_runner->PostTask(FROM_HERE,
+                              is_last_batch ? BindOnce(&WaitableEvent::Signal,
+                                                       Unretained(&complete))
+                                            : OnceClosure(DoNothing()));
+        continue;
+      }
+      std::vector<OnceClosure> tasks;
+      tasks.reserve(num_tasks);
+      for (size_t j = 0; j + 1 < num_tasks; ++j)
+        tasks.push_back(DoNothing());
+      tasks.push_back(is_last_batch ? BindOnce(&WaitableEvent::Signal,
+                                               Unretained(&complete))
+                                    : OnceClosure(DoNothing()));
+      task_runner->PostTasks(FROM_HERE, std::move(tasks));
+    }
+
+    complete.Wait();
+    const TimeDelta job_duration = TimeTicks::Now() - job_run_start;
+
+    auto reporter = SetUpReporter(story_name);
+    reporter.AddResult(kMetricWorkThroughput,
+                       size_t(num_work_items / job_duration.InMilliseconds()));
+  }
+
  private:
   test::TaskEnvironment task_environment;
 };
@@ -474,4 +519,12 @@ TEST_F(JobPerfTest, BusyWaitDisruptedWorkLoopAround) {
                        std::move(callback), true);
 }
 
+TEST_F(JobPerfTest, NoOpPostTask) {
+  RunSequencedTasks(kStoryNoOpPostTask, 1000000, 1);
+}
+
+TEST_F(JobPerfTest, NoOpPostTasksBatch) {
+  RunSequencedTasks(kStoryNoOpPostTasksBatch, 1000000, 100);
+}
+
 }  // namespace base
@@ -49,6 +49,7 @@ bool JobDelegate::ShouldYield() {
   // ShouldYield() shouldn't be called again after returning true.
   DCHECK(!last_should_yield_);
 #endif  // DCHECK_IS_ON()
+  ++num_should_yield_calls_;
   const bool should_yield =
       task_source_->ShouldYield() ||
       (pooled_task_runner_delegate_ &&
@@ -115,6 +116,10 @@ void JobHandle::NotifyConcurrencyIncrease() {
   task_source_->NotifyConcurrencyIncrease();
 }
 
+void JobHandle::EnableAdaptiveConcurrency() {
+  task_source_->EnableAdaptiveConcurrency();
+}
+
 void JobHandle::Join() {
   DCHECK(internal::PooledTaskRunnerDelegate::MatchesCurrentDelegate(
       task_source_->delegate()));
@@ -70,11 +70,16 @@ class BASE_EXPORT JobDelegate {
   }
 
  private:
+  friend class internal::JobTaskSource;
+
   static constexpr uint8_t kInvalidTaskId = std::numeric_limits<uint8_t>::max();
 
   internal::JobTaskSource* task_source_ = nullptr;
   internal::PooledTaskRunnerDelegate* pooled_task_runner_delegate_ = nullptr;
   uint8_t task_id_ = kInvalidTaskId;
+  // Number of calls to ShouldYield(), used as the number of work items
+  // processed by the worker task when adaptive concurrency is enabled.
+  size_t num_should_yield_calls_ = 0;
 
 #if DCHECK_IS_ON()
   // Value returned by the last call to ShouldYield().
@@ -112,6 +117,16 @@ class BASE_EXPORT JobHandle {
   // of workers should be adjusted accordingly. See PostJob() for more details.
   void NotifyConcurrencyIncrease();
 
+  // Lets the scheduler cap the number of workers below the value returned by
+  // the max concurrency callback, based on the measured latency of work items
+  // and on how much CPU time workers actually get. This is meant for jobs that
+  // are CPU bound, where running more workers than there are cores available
+  // slows every worker down. The worker task must call
+  // JobDelegate::ShouldYield() once per work item. This must be called before
+  // the job is scheduled, i.e. on a handle returned by CreateJob() before any
+  // call to NotifyConcurrencyIncrease() or Join().
+  void EnableAdaptiveConcurrency();
+
   // Contributes to the job on this thread. Doesn't return until all tasks have
   // completed and max concurrency becomes 0. This also promotes this Job's
   // priority to be at least as high as the calling thread's priority. When
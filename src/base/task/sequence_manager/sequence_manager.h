@@ -20,6 +20,7 @@
 #include "base/task/sequenced_task_runner.h"
 #include "base/task/single_thread_task_runner.h"
 #include "base/time/default_tick_clock.h"
+#include "base/values.h"
 
 namespace base {
 
@@ -296,6 +297,16 @@ class BASE_EXPORT SequenceManager {
   // Returns a JSON string which describes all pending tasks.
   virtual std::string DescribeAllPendingTasks() const = 0;
 
+  // Starts aggregating the queueing delay, wall duration and thread time of a
+  // |sampling_rate| fraction of top-level tasks per posting location and task
+  // queue. This turns on queue time recording for all tasks. The aggregates are
+  // included in tracing snapshots and returned by GetTaskSiteProfile().
+  virtual void EnableTaskSiteProfiling(double sampling_rate) = 0;
+
+  // Returns the aggregates recorded since EnableTaskSiteProfiling() was called,
+  // sorted by decreasing total wall duration. Empty if profiling isn't enabled.
+  virtual Value::List GetTaskSiteProfile() const = 0;
+
   // While Now() is less than `prioritize_until` we will alternate between a
   // SequenceManager task and a yielding to the underlying sequence (e.g., the
   // message pump).
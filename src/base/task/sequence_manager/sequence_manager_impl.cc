@@ -848,6 +848,13 @@ void SequenceManagerImpl::NotifyWillProcessTask(ExecutingTask* executing_task,
   if (executing_task->task_queue->GetQuiescenceMonitored())
     main_thread_only().task_was_run_on_quiescence_monitored_queue = true;
 
+  if (main_thread_only().task_site_profiler &&
+      main_thread_only().nesting_depth == 0) {
+    executing_task->task_site_sample_start =
+        main_thread_only().task_site_profiler->MaybeStartSample(
+            time_before_task->Now());
+  }
+
   TimeRecordingPolicy recording_policy =
       ShouldRecordTaskTiming(executing_task->task_queue);
   if (recording_policy == TimeRecordingPolicy::DoRecord)
@@ -898,6 +905,20 @@ void SequenceManagerImpl::NotifyDidProcessTask(ExecutingTask* executing_task,
                                                LazyNow* time_after_task) {
   TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("sequence_manager"),
                "SequenceManagerImpl::NotifyDidProcessTaskObservers");
+  if (executing_task->task_site_sample_start) {
+    // Delayed tasks are ready at their delayed run time, immediate tasks when
+    // they're posted.
+    const Task& task = executing_task->pending_task;
+    TimeTicks ready_time;
+    if (!task.queue_time.is_null()) {
+      ready_time = task.delayed_run_time.is_null() ? task.queue_time
+                                                   : task.delayed_run_time;
+    }
+    main_thread_only().task_site_profiler->AddSample(
+        task.posted_from, executing_task->task_queue_name, ready_time,
+        *executing_task->task_site_sample_start, time_after_task->Now());
+  }
+
   if (!executing_task->task_queue->GetShouldNotifyObservers())
     return;
 
@@ -1029,6 +1050,10 @@ Value::Dict SequenceManagerImpl::AsValueWithSelectorResult(
   state.Set("wake_up_queue", main_thread_only().wake_up_queue->AsValue(now));
   state.Set("non_waking_wake_up_queue",
             main_thread_only().non_waking_wake_up_queue->AsValue(now));
+  if (main_thread_only().task_site_profiler) {
+    state.Set("task_site_profile",
+              main_thread_only().task_site_profiler->AsValue());
+  }
   return state;
 }
 
@@ -1157,6 +1182,21 @@ std::string SequenceManagerImpl::DescribeAllPendingTasks() const {
   return result;
 }
 
+void SequenceManagerImpl::EnableTaskSiteProfiling(double sampling_rate) {
+  DCHECK_CALLED_ON_VALID_THREAD(associated_thread_->thread_checker);
+  // Queueing delays are computed from the queue time of tasks.
+  SetAddQueueTimeToTasks(true);
+  main_thread_only().task_site_profiler =
+      std::make_unique<internal::TaskSiteProfiler>(sampling_rate);
+}
+
+Value::List SequenceManagerImpl::GetTaskSiteProfile() const {
+  DCHECK_CALLED_ON_VALID_THREAD(associated_thread_->thread_checker);
+  if (!main_thread_only().task_site_profiler)
+    return Value::List();
+  return main_thread_only().task_site_profiler->AsValue();
+}
+
 void SequenceManagerImpl::PrioritizeYieldingToNative(
     base::TimeTicks prioritize_until) {
   controller_->PrioritizeYieldingToNative(prioritize_until);
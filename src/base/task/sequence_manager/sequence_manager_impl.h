@@ -38,6 +38,7 @@
 #include "base/task/sequence_manager/task_queue.h"
 #include "base/task/sequence_manager/task_queue_impl.h"
 #include "base/task/sequence_manager/task_queue_selector.h"
+#include "base/task/sequence_manager/task_site_profiler.h"
 #include "base/task/sequence_manager/thread_controller.h"
 #include "base/task/sequence_manager/work_tracker.h"
 #include "base/task/sequenced_task_runner.h"
@@ -127,6 +128,8 @@ class BASE_EXPORT SequenceManagerImpl
   size_t GetPendingTaskCountForTesting() const override;
   TaskQueue::Handle CreateTaskQueue(const TaskQueue::Spec& spec) override;
   std::string DescribeAllPendingTasks() const override;
+  void EnableTaskSiteProfiling(double sampling_rate) override;
+  Value::List GetTaskSiteProfile() const override;
   void PrioritizeYieldingToNative(base::TimeTicks prioritize_until) override;
   void AddTaskObserver(TaskObserver* task_observer) override;
   void RemoveTaskObserver(TaskObserver* task_observer) override;
@@ -286,6 +289,9 @@ class BASE_EXPORT SequenceManagerImpl
     // Save task metadata to use in after running a task as |pending_task|
     // won't be available then.
     int task_type;
+    // Set if the task is sampled by the TaskSiteProfiler.
+    std::optional<internal::TaskSiteProfiler::SampleStart>
+        task_site_sample_start;
   };
 
   struct MainThreadOnly {
@@ -308,6 +314,9 @@ class BASE_EXPORT SequenceManagerImpl
 
     std::optional<base::MetricsSubSampler> metrics_subsampler;
 
+    // Set by EnableTaskSiteProfiling().
+    std::unique_ptr<internal::TaskSiteProfiler> task_site_profiler;
+
     internal::TaskQueueSelector selector;
     ObserverList<TaskObserver>::UncheckedAndDanglingUntriaged task_observers;
     ObserverList<TaskTimeObserver>::UncheckedAndDanglingUntriaged
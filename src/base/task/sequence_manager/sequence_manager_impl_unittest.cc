@@ -4954,6 +4954,48 @@ TEST_P(SequenceManagerTest, PostDelayedTaskFromOtherThread) {
   thread.Stop();
 }
 
+TEST_P(SequenceManagerTest, PostDelayedTasksFromOtherThreadLockFree) {
+  base::test::ScopedFeatureList feature_list(kLockFreeCrossThreadDelayedTasks);
+  TaskQueueImpl::InitializeFeatures();
+
+  TaskQueue::Handle main_tq = CreateTaskQueue();
+  scoped_refptr<TaskRunner> task_runner =
+      main_tq->CreateTaskRunner(kTaskTypeNone);
+
+  Thread thread("test thread");
+  thread.StartAndWaitForTesting();
+
+  std::vector<EnqueueOrder> run_order;
+  WaitableEvent tasks_posted(WaitableEvent::ResetPolicy::MANUAL,
+                             WaitableEvent::InitialState::NOT_SIGNALED);
+  thread.task_runner()->PostTask(
+      FROM_HERE,
+      BindOnce(
+          [](scoped_refptr<TaskRunner> task_runner,
+             std::vector<EnqueueOrder>* run_order,
+             WaitableEvent* tasks_posted) {
+            task_runner->PostDelayedTask(FROM_HERE,
+                                         BindOnce(&TestTask, 1, run_order),
+                                         base::Milliseconds(30));
+            task_runner->PostDelayedTask(FROM_HERE,
+                                         BindOnce(&TestTask, 2, run_order),
+                                         base::Milliseconds(10));
+            task_runner->PostDelayedTask(FROM_HERE,
+                                         BindOnce(&TestTask, 3, run_order),
+                                         base::Milliseconds(20));
+            tasks_posted->Signal();
+          },
+          std::move(task_runner), &run_order, &tasks_posted));
+  tasks_posted.Wait();
+  FastForwardUntilNoTasksRemain();
+  thread.Stop();
+
+  EXPECT_THAT(run_order, ElementsAre(2u, 3u, 1u));
+
+  feature_list.Reset();
+  TaskQueueImpl::InitializeFeatures();
+}
+
 namespace {
 
 void PostTaskA(scoped_refptr<TaskRunner> task_runner) {
@@ -4989,6 +5031,28 @@ TEST_P(SequenceManagerTest, DescribeAllPendingTasks) {
   EXPECT_THAT(description, HasSubstr("PostTaskC@"));
 }
 
+TEST_P(SequenceManagerTest, TaskSiteProfile) {
+  auto queue = CreateTaskQueue();
+  EXPECT_TRUE(sequence_manager()->GetTaskSiteProfile().empty());
+
+  sequence_manager()->EnableTaskSiteProfiling(1.0);
+  for (int i = 0; i < 3; ++i)
+    PostTaskA(queue->task_runner());
+  PostTaskB(queue->task_runner());
+  RunLoop().RunUntilIdle();
+
+  Value::List profile = sequence_manager()->GetTaskSiteProfile();
+  ASSERT_EQ(2u, profile.size());
+  int total_samples = 0;
+  for (const Value& site : profile) {
+    const Value::Dict& dict = site.GetDict();
+    EXPECT_EQ("TEST_TQ", *dict.FindString("queue"));
+    EXPECT_TRUE(dict.FindInt("queueing_delay_sample_count"));
+    total_samples += *dict.FindInt("sample_count");
+  }
+  EXPECT_EQ(4, total_samples);
+}
+
 TEST_P(SequenceManagerTest, TaskPriortyInterleaving) {
   auto queues = CreateTaskQueues(
       static_cast<size_t>(TestQueuePriority::kQueuePriorityCount));
@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "base/functional/bind.h"
 #include "base/logging.h"
@@ -18,15 +19,18 @@
 #include "base/sequence_checker.h"
 #include "base/synchronization/condition_variable.h"
 #include "base/task/sequence_manager/task_queue.h"
+#include "base/task/sequence_manager/task_queue_impl.h"
 #include "base/task/sequence_manager/test/mock_time_domain.h"
 #include "base/task/sequence_manager/test/sequence_manager_for_test.h"
 #include "base/task/sequence_manager/test/test_task_time_observer.h"
 #include "base/task/sequence_manager/thread_controller_with_message_pump_impl.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/task/task_features.h"
 #include "base/task/task_traits.h"
 #include "base/task/thread_pool.h"
 #include "base/task/thread_pool/thread_pool_impl.h"
 #include "base/task/thread_pool/thread_pool_instance.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/thread.h"
 #include "base/time/default_tick_clock.h"
 #include "build/build_config.h"
@@ -521,6 +525,77 @@ class TwoThreadTestCase : public TestCase {
   int done_count_ = 0;
 };
 
+// Posts delayed tasks from |num_threads| auxiliary threads at once, which
+// exercises the cross-thread delayed task path of the queues.
+class MultiThreadDelayedTestCase : public TestCase {
+ public:
+  MultiThreadDelayedTestCase(
+      PerfTestDelegate* delegate,
+      std::vector<scoped_refptr<TaskRunner>> task_runners,
+      size_t num_threads)
+      : TestCase(delegate),
+        task_runners_(std::move(task_runners)),
+        num_tasks_(kNumTasks) {
+    for (size_t i = 0; i < num_threads; i++) {
+      auxiliary_threads_.push_back(
+          std::make_unique<Thread>("auxillary thread"));
+      auxiliary_threads_.back()->Start();
+    }
+  }
+
+  ~MultiThreadDelayedTestCase() override {
+    for (auto& thread : auxiliary_threads_)
+      thread->Stop();
+  }
+
+ protected:
+  void Start() override {
+    done_count_ = 0;
+    task_sources_.clear();
+    for (auto& thread : auxiliary_threads_) {
+      task_sources_.push_back(std::make_unique<CrossThreadDelayedTaskSource>(
+          this, task_runners_, num_tasks_ / auxiliary_threads_.size()));
+      thread->task_runner()->PostTask(
+          FROM_HERE, base::BindOnce(&CrossThreadDelayedTaskSource::Start,
+                                    Unretained(task_sources_.back().get())));
+    }
+  }
+
+  class CrossThreadDelayedTaskSource : public CrossThreadTaskSource {
+   public:
+    CrossThreadDelayedTaskSource(
+        MultiThreadDelayedTestCase* multi_thread_test_case,
+        std::vector<scoped_refptr<TaskRunner>> task_runners,
+        size_t num_tasks)
+        : CrossThreadTaskSource(std::move(task_runners), num_tasks),
+          multi_thread_test_case_(multi_thread_test_case) {}
+
+    ~CrossThreadDelayedTaskSource() override = default;
+
+    void PostTask(unsigned int queue) override {
+      task_runners_[queue]->PostDelayedTask(FROM_HERE, task_closure_,
+                                            Milliseconds(1));
+    }
+
+    // Will be called on the main thread.
+    void SignalDone() override { multi_thread_test_case_->SignalDone(); }
+
+    raw_ptr<MultiThreadDelayedTestCase> multi_thread_test_case_;  // NOT OWNED.
+  };
+
+  void SignalDone() {
+    if (++done_count_ == auxiliary_threads_.size())
+      delegate_->SignalDone();
+  }
+
+ private:
+  const std::vector<scoped_refptr<TaskRunner>> task_runners_;
+  const size_t num_tasks_;
+  std::vector<std::unique_ptr<Thread>> auxiliary_threads_;
+  std::vector<std::unique_ptr<CrossThreadDelayedTaskSource>> task_sources_;
+  size_t done_count_ = 0u;
+};
+
 class SequenceManagerPerfTest : public testing::TestWithParam<PerfTestType> {
  public:
   SequenceManagerPerfTest() = default;
@@ -721,6 +796,37 @@ TEST_P(SequenceManagerPerfTest,
             &task_source);
 }
 
+TEST_P(SequenceManagerPerfTest, PostDelayedTasksFromFourThreads_OneQueue) {
+  if (!delegate_->VirtualTimeIsSupported()) {
+    LOG(INFO) << "Unsupported";
+    return;
+  }
+
+  MultiThreadDelayedTestCase task_source(delegate_.get(), CreateTaskRunners(1),
+                                         4);
+  Benchmark("post delayed tasks with one queue from four threads",
+            &task_source);
+}
+
+TEST_P(SequenceManagerPerfTest,
+       PostDelayedTasksFromFourThreadsLockFree_OneQueue) {
+  if (!delegate_->VirtualTimeIsSupported()) {
+    LOG(INFO) << "Unsupported";
+    return;
+  }
+
+  test::ScopedFeatureList feature_list(kLockFreeCrossThreadDelayedTasks);
+  internal::TaskQueueImpl::InitializeFeatures();
+  {
+    MultiThreadDelayedTestCase task_source(delegate_.get(),
+                                           CreateTaskRunners(1), 4);
+    Benchmark("post lock-free delayed tasks with one queue from four threads",
+              &task_source);
+  }
+  feature_list.Reset();
+  internal::TaskQueueImpl::InitializeFeatures();
+}
+
 // TODO(alexclarke): Add additional tests with different mixes of non-delayed vs
 // delayed tasks.
 
@@ -71,6 +71,10 @@ std::atomic<base::TimeDelta> g_max_precise_delay{kDefaultMaxPreciseDelay};
 // tasks are posted cross-thread, which can race with its initialization.
 std::atomic_bool g_explicit_high_resolution_timer_win{true};
 #endif  // BUILDFLAG(IS_WIN)
+// An atomic is used here because the flag is queried from other threads when
+// delayed tasks are posted cross-thread, which can race with its
+// initialization.
+std::atomic_bool g_lock_free_cross_thread_delayed_tasks{false};
 
 void RunTaskSynchronously(AssociatedThreadId* associated_thread,
                           scoped_refptr<SingleThreadTaskRunner> task_runner,
@@ -242,6 +246,9 @@ void TaskQueueImpl::InitializeFeatures() {
       FeatureList::IsEnabled(kExplicitHighResolutionTimerWin),
       std::memory_order_relaxed);
 #endif  // BUILDFLAG(IS_WIN)
+  g_lock_free_cross_thread_delayed_tasks.store(
+      FeatureList::IsEnabled(kLockFreeCrossThreadDelayedTasks),
+      std::memory_order_relaxed);
 }
 
 TaskQueueImpl::TaskQueueImpl(SequenceManagerImpl* sequence_manager,
@@ -359,6 +366,8 @@ void TaskQueueImpl::UnregisterTaskQueue() {
 
   DelayedIncomingQueue delayed_incoming_queue;
   delayed_incoming_queue.swap(&main_thread_only().delayed_incoming_queue);
+  std::vector<Task> cross_thread_delayed_tasks =
+      cross_thread_delayed_tasks_.TakeAll();
   std::unique_ptr<WorkQueue> immediate_work_queue =
       std::move(main_thread_only().immediate_work_queue);
   std::unique_ptr<WorkQueue> delayed_work_queue =
@@ -553,6 +562,23 @@ void TaskQueueImpl::PushOntoDelayedIncomingQueue(Task pending_task) {
   // TODO(altimin): Add a copy method to Task to capture metadata here.
   auto task_runner = pending_task.task_runner;
   const auto task_type = pending_task.task_type;
+
+  if (g_lock_free_cross_thread_delayed_tasks.load(std::memory_order_relaxed)) {
+    // Only the post that finds the list empty posts the task that drains it.
+    // Later posts are picked up by that task without taking
+    // |any_thread_lock_|.
+    if (cross_thread_delayed_tasks_.Push(std::move(pending_task))) {
+      PostImmediateTaskImpl(
+          PostedTask(
+              std::move(task_runner),
+              BindOnce(&TaskQueueImpl::ScheduleCrossThreadDelayedWorkTasks,
+                       Unretained(this)),
+              FROM_HERE, TimeDelta(), Nestable::kNonNestable, task_type),
+          CurrentThread::kNotMainThread);
+    }
+    return;
+  }
+
   PostImmediateTaskImpl(
       PostedTask(std::move(task_runner),
                  BindOnce(&TaskQueueImpl::ScheduleDelayedWorkTask,
@@ -584,6 +610,61 @@ void TaskQueueImpl::ScheduleDelayedWorkTask(Task pending_task) {
   TraceQueueSize();
 }
 
+void TaskQueueImpl::ScheduleCrossThreadDelayedWorkTasks() {
+  DCHECK_CALLED_ON_VALID_THREAD(associated_thread_->thread_checker);
+  for (Task& pending_task : cross_thread_delayed_tasks_.TakeAll())
+    ScheduleDelayedWorkTask(std::move(pending_task));
+}
+
+struct TaskQueueImpl::CrossThreadDelayedTaskList::Node {
+  explicit Node(Task task) : task(std::move(task)) {}
+
+  Task task;
+  // RAW_PTR_EXCLUSION: Nodes are only ever reachable through the list, which
+  // owns them, and a raw_ptr would add work to every CAS attempt of Push().
+  RAW_PTR_EXCLUSION Node* next = nullptr;
+};
+
+TaskQueueImpl::CrossThreadDelayedTaskList::CrossThreadDelayedTaskList() =
+    default;
+
+TaskQueueImpl::CrossThreadDelayedTaskList::~CrossThreadDelayedTaskList() {
+  TakeAll();
+}
+
+bool TaskQueueImpl::CrossThreadDelayedTaskList::Push(Task task) {
+  auto node = std::make_unique<Node>(std::move(task));
+  node->next = head_.load(std::memory_order_relaxed);
+  // The release ordering publishes the node's contents to TakeAll(). On
+  // failure |node->next| is updated to the current head.
+  while (!head_.compare_exchange_weak(node->next, node.get(),
+                                      std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+  }
+  return !node.release()->next;
+}
+
+std::vector<Task> TaskQueueImpl::CrossThreadDelayedTaskList::TakeAll() {
+  Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+
+  // The list is a stack, reverse it to get the tasks in push order.
+  Node* reversed = nullptr;
+  while (node) {
+    Node* next = node->next;
+    node->next = reversed;
+    reversed = node;
+    node = next;
+  }
+
+  std::vector<Task> tasks;
+  while (reversed) {
+    std::unique_ptr<Node> owned_node(reversed);
+    reversed = owned_node->next;
+    tasks.push_back(std::move(owned_node->task));
+  }
+  return tasks;
+}
+
 void TaskQueueImpl::ReloadEmptyImmediateWorkQueue() {
   DCHECK(main_thread_only().immediate_work_queue->Empty());
   main_thread_only().immediate_work_queue->TakeImmediateIncomingQueueTasks();
@@ -7,6 +7,7 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -492,6 +493,10 @@ class BASE_EXPORT TaskQueueImpl : public TaskQueue {
 
   void ScheduleDelayedWorkTask(Task pending_task);
 
+  // Moves every task of |cross_thread_delayed_tasks_| to the
+  // |delayed_incoming_queue|.
+  void ScheduleCrossThreadDelayedWorkTasks();
+
   void MoveReadyImmediateTasksToImmediateWorkQueueLocked()
       EXCLUSIVE_LOCKS_REQUIRED(any_thread_lock_);
 
@@ -598,6 +603,34 @@ class BASE_EXPORT TaskQueueImpl : public TaskQueue {
 
   AnyThread any_thread_ GUARDED_BY(any_thread_lock_);
 
+  // A lock-free multi-producer single-consumer list of tasks. Producers push
+  // onto an intrusive stack, and the consumer takes the whole stack at once.
+  class CrossThreadDelayedTaskList {
+   public:
+    CrossThreadDelayedTaskList();
+    CrossThreadDelayedTaskList(const CrossThreadDelayedTaskList&) = delete;
+    CrossThreadDelayedTaskList& operator=(const CrossThreadDelayedTaskList&) =
+        delete;
+    ~CrossThreadDelayedTaskList();
+
+    // Pushes |task| from any thread. Returns true if the list was empty, in
+    // which case the caller must make sure TakeAll() is called later.
+    bool Push(Task task);
+
+    // Removes every task from the list and returns them in push order.
+    std::vector<Task> TakeAll();
+
+   private:
+    struct Node;
+
+    std::atomic<Node*> head_{nullptr};
+  };
+
+  // Delayed tasks posted from other threads under
+  // kLockFreeCrossThreadDelayedTasks, waiting to be moved to the
+  // |delayed_incoming_queue| by ScheduleCrossThreadDelayedWorkTasks().
+  CrossThreadDelayedTaskList cross_thread_delayed_tasks_;
+
   MainThreadOnly main_thread_only_;
   MainThreadOnly& main_thread_only() {
     associated_thread_->AssertInSequenceWithCurrentThread();
@@ -0,0 +1,125 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/sequence_manager/task_site_profiler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/check_op.h"
+#include "base/ranges/algorithm.h"
+#include "base/trace_event/base_tracing.h"
+
+namespace base {
+namespace sequence_manager {
+namespace internal {
+
+TaskSiteProfiler::TaskSiteProfiler(double sampling_rate)
+    : sampling_rate_(sampling_rate) {
+  DCHECK_GE(sampling_rate_, 0.0);
+  DCHECK_LE(sampling_rate_, 1.0);
+}
+
+TaskSiteProfiler::~TaskSiteProfiler() = default;
+
+std::optional<TaskSiteProfiler::SampleStart> TaskSiteProfiler::MaybeStartSample(
+    TimeTicks start_time) {
+  if (!subsampler_.ShouldSample(sampling_rate_))
+    return std::nullopt;
+  SampleStart sample_start;
+  sample_start.start_time = start_time;
+  if (ThreadTicks::IsSupported())
+    sample_start.start_thread_time = ThreadTicks::Now();
+  return sample_start;
+}
+
+void TaskSiteProfiler::AddSample(const Location& posted_from,
+                                 QueueName queue_name,
+                                 TimeTicks ready_time,
+                                 const SampleStart& sample_start,
+                                 TimeTicks end_time) {
+  SiteKey key(posted_from, queue_name);
+  auto it = sites_.find(key);
+  if (it == sites_.end()) {
+    if (sites_.size() >= kMaxSites) {
+      ++num_dropped_samples_;
+      return;
+    }
+    it = sites_.emplace(std::move(key), SiteStats()).first;
+  }
+
+  SiteStats& stats = it->second;
+  ++stats.sample_count;
+  stats.total_wall_duration += end_time - sample_start.start_time;
+  if (!ready_time.is_null()) {
+    // Delayed tasks can run slightly before their delayed run time when
+    // leeway is applied; these don't count as delayed.
+    const TimeDelta queueing_delay =
+        std::max(sample_start.start_time - ready_time, TimeDelta());
+    ++stats.queueing_delay_sample_count;
+    stats.total_queueing_delay += queueing_delay;
+    stats.max_queueing_delay =
+        std::max(stats.max_queueing_delay, queueing_delay);
+  }
+  if (sample_start.start_thread_time) {
+    ++stats.thread_duration_sample_count;
+    stats.total_thread_duration +=
+        ThreadTicks::Now() - *sample_start.start_thread_time;
+  }
+}
+
+const TaskSiteProfiler::SiteStats* TaskSiteProfiler::GetStats(
+    const Location& posted_from,
+    QueueName queue_name) const {
+  auto it = sites_.find(SiteKey(posted_from, queue_name));
+  return it == sites_.end() ? nullptr : &it->second;
+}
+
+Value::List TaskSiteProfiler::AsValue() const {
+  std::vector<const decltype(sites_)::value_type*> sorted_sites;
+  sorted_sites.reserve(sites_.size());
+  for (const auto& site : sites_)
+    sorted_sites.push_back(&site);
+  ranges::stable_sort(sorted_sites, [](const auto* a, const auto* b) {
+    return a->second.total_wall_duration > b->second.total_wall_duration;
+  });
+
+  Value::List list;
+  for (const auto* site : sorted_sites) {
+    const SiteStats& stats = site->second;
+    Value::Dict dict;
+    dict.Set("posted_from", site->first.first.ToString());
+    dict.Set("queue",
+             perfetto::protos::pbzero::SequenceManagerTask::QueueName_Name(
+                 site->first.second));
+    dict.Set("sample_count", static_cast<int>(stats.sample_count));
+    dict.Set("total_wall_duration_ms",
+             stats.total_wall_duration.InMillisecondsF());
+    if (stats.queueing_delay_sample_count) {
+      dict.Set("queueing_delay_sample_count",
+               static_cast<int>(stats.queueing_delay_sample_count));
+      dict.Set("total_queueing_delay_ms",
+               stats.total_queueing_delay.InMillisecondsF());
+      dict.Set("max_queueing_delay_ms",
+               stats.max_queueing_delay.InMillisecondsF());
+    }
+    if (stats.thread_duration_sample_count) {
+      dict.Set("thread_duration_sample_count",
+               static_cast<int>(stats.thread_duration_sample_count));
+      dict.Set("total_thread_duration_ms",
+               stats.total_thread_duration.InMillisecondsF());
+    }
+    list.Append(std::move(dict));
+  }
+  if (num_dropped_samples_) {
+    Value::Dict dict;
+    dict.Set("dropped_sample_count", static_cast<int>(num_dropped_samples_));
+    list.Append(std::move(dict));
+  }
+  return list;
+}
+
+}  // namespace internal
+}  // namespace sequence_manager
+}  // namespace base
@@ -0,0 +1,97 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TASK_SEQUENCE_MANAGER_TASK_SITE_PROFILER_H_
+#define BASE_TASK_SEQUENCE_MANAGER_TASK_SITE_PROFILER_H_
+
+#include <stddef.h>
+
+#include <optional>
+#include <utility>
+
+#include "base/base_export.h"
+#include "base/containers/flat_map.h"
+#include "base/location.h"
+#include "base/rand_util.h"
+#include "base/task/sequence_manager/task_queue.h"
+#include "base/time/time.h"
+#include "base/values.h"
+
+namespace base {
+namespace sequence_manager {
+namespace internal {
+
+// Aggregates the queueing delay, wall duration and thread CPU time of a
+// sampled subset of tasks per posting location and task queue, to find the
+// task sites that keep a thread busy or starve it. The table is bounded by
+// kMaxSites entries; samples of sites past that are only counted.
+//
+// This class is main-thread-only.
+class BASE_EXPORT TaskSiteProfiler {
+ public:
+  static constexpr size_t kMaxSites = 256;
+
+  struct SiteStats {
+    size_t sample_count = 0;
+    // Queueing delays are only aggregated for tasks that have a queue time.
+    size_t queueing_delay_sample_count = 0;
+    TimeDelta total_queueing_delay;
+    TimeDelta max_queueing_delay;
+    TimeDelta total_wall_duration;
+    // Thread durations are only aggregated when ThreadTicks are supported.
+    size_t thread_duration_sample_count = 0;
+    TimeDelta total_thread_duration;
+  };
+
+  // Measurements taken before a sampled task runs.
+  struct SampleStart {
+    TimeTicks start_time;
+    std::optional<ThreadTicks> start_thread_time;
+  };
+
+  // |sampling_rate| is the probability, in [0, 1], of sampling a task.
+  explicit TaskSiteProfiler(double sampling_rate);
+  TaskSiteProfiler(const TaskSiteProfiler&) = delete;
+  TaskSiteProfiler& operator=(const TaskSiteProfiler&) = delete;
+  ~TaskSiteProfiler();
+
+  // Returns whether the task about to run should be sampled, and if so the
+  // measurements to pass back to AddSample() once it ran.
+  std::optional<SampleStart> MaybeStartSample(TimeTicks start_time);
+
+  // Records a sampled task posted from |posted_from| to a queue named
+  // |queue_name|. |ready_time| is the time at which the task could first have
+  // run, or a null TimeTicks if unknown.
+  void AddSample(const Location& posted_from,
+                 QueueName queue_name,
+                 TimeTicks ready_time,
+                 const SampleStart& sample_start,
+                 TimeTicks end_time);
+
+  // Returns the statistics recorded for the given site, or nullptr.
+  const SiteStats* GetStats(const Location& posted_from,
+                            QueueName queue_name) const;
+
+  size_t num_sites() const { return sites_.size(); }
+  // Number of samples whose site couldn't be added to the full table.
+  size_t num_dropped_samples() const { return num_dropped_samples_; }
+
+  // Returns the table, sorted by decreasing total wall duration, for tracing
+  // and debugging.
+  Value::List AsValue() const;
+
+ private:
+  using SiteKey = std::pair<Location, QueueName>;
+
+  const double sampling_rate_;
+  MetricsSubSampler subsampler_;
+  flat_map<SiteKey, SiteStats> sites_;
+  size_t num_dropped_samples_ = 0;
+};
+
+}  // namespace internal
+}  // namespace sequence_manager
+}  // namespace base
+
+#endif  // BASE_TASK_SEQUENCE_MANAGER_TASK_SITE_PROFILER_H_
@@ -0,0 +1,135 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/sequence_manager/task_site_profiler.h"
+
+#include <stdint.h>
+
+#include <optional>
+
+#include "base/location.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace sequence_manager {
+namespace internal {
+
+namespace {
+
+using SampleStart = TaskSiteProfiler::SampleStart;
+
+// Locations are compared by program counter, so each line gets its own.
+Location LocationWithLine(int line) {
+  return Location::CreateForTesting(
+      "Function", "file.cc", line,
+      reinterpret_cast<const void*>(static_cast<uintptr_t>(line + 1)));
+}
+
+SampleStart MakeSampleStart(TimeTicks start_time) {
+  SampleStart sample_start;
+  sample_start.start_time = start_time;
+  return sample_start;
+}
+
+}  // namespace
+
+TEST(TaskSiteProfilerTest, SamplingRate) {
+  TaskSiteProfiler never_sample(0.0);
+  EXPECT_FALSE(never_sample.MaybeStartSample(TimeTicks::Now()));
+
+  TaskSiteProfiler always_sample(1.0);
+  const TimeTicks now = TimeTicks::Now();
+  std::optional<SampleStart> sample_start = always_sample.MaybeStartSample(now);
+  ASSERT_TRUE(sample_start);
+  EXPECT_EQ(now, sample_start->start_time);
+  EXPECT_EQ(ThreadTicks::IsSupported(),
+            sample_start->start_thread_time.has_value());
+}
+
+TEST(TaskSiteProfilerTest, AggregatesPerSite) {
+  TaskSiteProfiler profiler(1.0);
+  const Location location = LocationWithLine(1);
+  const TimeTicks start = TimeTicks() + Seconds(1);
+
+  profiler.AddSample(location, QueueName::TEST_TQ, start - Milliseconds(4),
+                     MakeSampleStart(start), start + Milliseconds(2));
+  profiler.AddSample(location, QueueName::TEST_TQ, start - Milliseconds(2),
+                     MakeSampleStart(start), start + Milliseconds(6));
+  // Same location, different queue.
+  profiler.AddSample(location, QueueName::TEST2_TQ, start,
+                     MakeSampleStart(start), start + Milliseconds(1));
+  EXPECT_EQ(2u, profiler.num_sites());
+
+  const TaskSiteProfiler::SiteStats* stats =
+      profiler.GetStats(location, QueueName::TEST_TQ);
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(2u, stats->sample_count);
+  EXPECT_EQ(2u, stats->queueing_delay_sample_count);
+  EXPECT_EQ(Milliseconds(6), stats->total_queueing_delay);
+  EXPECT_EQ(Milliseconds(4), stats->max_queueing_delay);
+  EXPECT_EQ(Milliseconds(8), stats->total_wall_duration);
+  EXPECT_EQ(0u, stats->thread_duration_sample_count);
+
+  EXPECT_FALSE(profiler.GetStats(LocationWithLine(2), QueueName::TEST_TQ));
+}
+
+TEST(TaskSiteProfilerTest, UnknownAndEarlyReadyTime) {
+  TaskSiteProfiler profiler(1.0);
+  const Location location = LocationWithLine(1);
+  const TimeTicks start = TimeTicks() + Seconds(1);
+
+  // No queue time.
+  profiler.AddSample(location, QueueName::TEST_TQ, TimeTicks(),
+                     MakeSampleStart(start), start + Milliseconds(1));
+  // A delayed task that ran before its delayed run time.
+  profiler.AddSample(location, QueueName::TEST_TQ, start + Milliseconds(1),
+                     MakeSampleStart(start), start + Milliseconds(1));
+
+  const TaskSiteProfiler::SiteStats* stats =
+      profiler.GetStats(location, QueueName::TEST_TQ);
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(2u, stats->sample_count);
+  EXPECT_EQ(1u, stats->queueing_delay_sample_count);
+  EXPECT_EQ(TimeDelta(), stats->total_queueing_delay);
+}
+
+TEST(TaskSiteProfilerTest, BoundedNumberOfSites) {
+  TaskSiteProfiler profiler(1.0);
+  const TimeTicks start = TimeTicks() + Seconds(1);
+  for (size_t i = 0; i <= TaskSiteProfiler::kMaxSites; ++i) {
+    profiler.AddSample(LocationWithLine(static_cast<int>(i)),
+                       QueueName::TEST_TQ, start, MakeSampleStart(start),
+                       start);
+  }
+  EXPECT_EQ(TaskSiteProfiler::kMaxSites, profiler.num_sites());
+  EXPECT_EQ(1u, profiler.num_dropped_samples());
+
+  // Existing sites are still recorded.
+  profiler.AddSample(LocationWithLine(0), QueueName::TEST_TQ, start,
+                     MakeSampleStart(start), start);
+  EXPECT_EQ(2u,
+            profiler.GetStats(LocationWithLine(0), QueueName::TEST_TQ)
+                ->sample_count);
+  EXPECT_EQ(1u, profiler.num_dropped_samples());
+}
+
+TEST(TaskSiteProfilerTest, AsValueIsSortedByWallDuration) {
+  TaskSiteProfiler profiler(1.0);
+  const TimeTicks start = TimeTicks() + Seconds(1);
+  profiler.AddSample(LocationWithLine(1), QueueName::TEST_TQ, start,
+                     MakeSampleStart(start), start + Milliseconds(1));
+  profiler.AddSample(LocationWithLine(2), QueueName::TEST_TQ, start,
+                     MakeSampleStart(start), start + Milliseconds(5));
+
+  Value::List value = profiler.AsValue();
+  ASSERT_EQ(2u, value.size());
+  EXPECT_EQ(5.0, *value[0].GetDict().FindDouble("total_wall_duration_ms"));
+  EXPECT_EQ(1.0, *value[1].GetDict().FindDouble("total_wall_duration_ms"));
+  EXPECT_EQ("TEST_TQ", *value[0].GetDict().FindString("queue"));
+}
+
+}  // namespace internal
+}  // namespace sequence_manager
+}  // namespace base
@@ -76,6 +76,11 @@ BASE_EXPORT BASE_DECLARE_FEATURE(kMaxDelayedStarvationTasks);
 extern const BASE_EXPORT base::FeatureParam<int>
     kMaxDelayedStarvationTasksParam;
 
+// Under this feature, delayed tasks posted to a SequenceManager task queue from
+// another thread are pushed onto a lock-free list that a single task on the
+// queue's thread drains, instead of each being posted as an immediate task.
+BASE_EXPORT BASE_DECLARE_FEATURE(kLockFreeCrossThreadDelayedTasks);
+
 // Feature to use ThreadGroupSemaphore instead of ThreadGroupImpl.
 BASE_EXPORT BASE_DECLARE_FEATURE(kThreadGroupSemaphore);
 extern const BASE_EXPORT base::FeatureParam<int> kMaxNumWorkersCreated;
@@ -19,6 +19,14 @@ bool TaskRunner::PostTask(const Location& from_here, OnceClosure task) {
   return PostDelayedTask(from_here, std::move(task), base::TimeDelta());
 }
 
+bool TaskRunner::PostTasks(const Location& from_here,
+                           std::vector<OnceClosure> tasks) {
+  bool all_tasks_posted = true;
+  for (OnceClosure& task : tasks)
+    all_tasks_posted &= PostTask(from_here, std::move(task));
+  return all_tasks_posted;
+}
+
 bool TaskRunner::PostTaskAndReply(const Location& from_here,
                                   OnceClosure task,
                                   OnceClosure reply) {
@@ -7,6 +7,8 @@
 
 #include <stddef.h>
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/check.h"
 #include "base/functional/bind.h"
@@ -67,6 +69,13 @@ class BASE_EXPORT TaskRunner
   // Equivalent to PostDelayedTask(from_here, task, 0).
   bool PostTask(const Location& from_here, OnceClosure task);
 
+  // Posts each of |tasks| as if by calling PostTask() on them in order.
+  // Implementations may enqueue the whole batch at once, which is cheaper than
+  // posting the tasks one by one. Returns true if all tasks may be run at some
+  // point in the future, and false if any of them definitely will not be run.
+  virtual bool PostTasks(const Location& from_here,
+                         std::vector<OnceClosure> tasks);
+
   // Like PostTask, but tries to run the posted task only after |delay_ms|
   // has passed. Implementations should use a tick clock, rather than wall-
   // clock time, to implement |delay|.
@@ -0,0 +1,96 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/thread_pool/job_concurrency_controller.h"
+
+#include <algorithm>
+
+#include "base/check_op.h"
+#include "base/trace_event/base_tracing.h"
+
+namespace base {
+namespace internal {
+
+JobConcurrencyController::JobConcurrencyController(size_t initial_limit,
+                                                   size_t max_limit)
+    : max_limit_(max_limit),
+      limit_(std::clamp<size_t>(initial_limit, 1, max_limit)) {
+  DCHECK_GE(max_limit_, 1u);
+}
+
+JobConcurrencyController::~JobConcurrencyController() = default;
+
+bool JobConcurrencyController::ReportWorkerRun(const WorkerRun& run) {
+  CheckedAutoLock auto_lock(lock_);
+  ++num_runs_;
+  if (run.worker_count >= limit())
+    ++num_saturated_runs_;
+  num_items_ += run.num_items;
+  wall_duration_ += run.wall_duration;
+  if (run.cpu_duration)
+    cpu_duration_ += *run.cpu_duration;
+  else
+    has_cpu_duration_ = false;
+
+  if (num_runs_ < kRunsPerWindow)
+    return false;
+
+  const size_t previous_limit = limit();
+  const size_t new_limit = ComputeLimit();
+  limit_.store(new_limit, std::memory_order_relaxed);
+
+  num_runs_ = 0;
+  num_saturated_runs_ = 0;
+  num_items_ = 0;
+  wall_duration_ = TimeDelta();
+  cpu_duration_ = TimeDelta();
+  has_cpu_duration_ = true;
+  return new_limit > previous_limit;
+}
+
+size_t JobConcurrencyController::ComputeLimit() {
+  const size_t limit = this->limit();
+  // Worker tasks that never call ShouldYield() count as a single item.
+  const TimeDelta item_latency =
+      wall_duration_ / std::max(num_items_, num_runs_);
+  const double cpu_utilization =
+      has_cpu_duration_ && wall_duration_.is_positive()
+          ? cpu_duration_ / wall_duration_
+          : 1.0;
+  if (windows_before_retrying_raise_ > 0)
+    --windows_before_retrying_raise_;
+
+  size_t new_limit = limit;
+  const char* decision = "keep";
+  if (cpu_utilization < kMinCpuUtilization && limit > 1) {
+    new_limit = limit - 1;
+    decision = "lower_cpu_contention";
+  } else if (latency_before_raise_ &&
+             item_latency >
+                 *latency_before_raise_ * (1.0 + kMaxLatencyRegression) &&
+             limit > 1) {
+    new_limit = limit - 1;
+    decision = "lower_latency_regression";
+    windows_before_retrying_raise_ = kWindowsBeforeRetryingRaise;
+  } else if (num_saturated_runs_ * 2 >= num_runs_ && limit < max_limit_ &&
+             windows_before_retrying_raise_ == 0) {
+    new_limit = limit + 1;
+    decision = "raise";
+  }
+
+  // The latency measured right before a raise is only compared against the
+  // window that immediately follows it.
+  if (new_limit > limit)
+    latency_before_raise_ = item_latency;
+  else
+    latency_before_raise_.reset();
+
+  TRACE_EVENT_INSTANT("base", "Job.AdaptiveConcurrency", "decision", decision,
+                      "limit", new_limit, "cpu_utilization", cpu_utilization,
+                      "item_latency_us", item_latency.InMicrosecondsF());
+  return new_limit;
+}
+
+}  // namespace internal
+}  // namespace base
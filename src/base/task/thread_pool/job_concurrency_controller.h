@@ -0,0 +1,95 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TASK_THREAD_POOL_JOB_CONCURRENCY_CONTROLLER_H_
+#define BASE_TASK_THREAD_POOL_JOB_CONCURRENCY_CONTROLLER_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <optional>
+
+#include "base/base_export.h"
+#include "base/task/common/checked_lock.h"
+#include "base/thread_annotations.h"
+#include "base/time/time.h"
+
+namespace base {
+namespace internal {
+
+// Tunes the number of workers of a Job that has adaptive concurrency enabled
+// (see JobHandle::EnableAdaptiveConcurrency()). Each worker task reports how
+// long it ran, how much of that time its thread spent on a CPU and how many
+// work items it processed. Reports are aggregated over windows of
+// kRunsPerWindow worker runs, at the end of which the limit is:
+//   - Lowered if workers got less than kMinCpuUtilization of their wall time
+//     on a CPU, which means that they're contending for cores.
+//   - Lowered if the latency per work item regressed by more than
+//     kMaxLatencyRegression since the limit was last raised.
+//   - Raised if workers were running at the limit most of the time.
+// Each decision is traced as a "Job.AdaptiveConcurrency" event.
+//
+// This class is thread-safe.
+class BASE_EXPORT JobConcurrencyController {
+ public:
+  static constexpr size_t kRunsPerWindow = 16;
+  static constexpr double kMinCpuUtilization = 0.6;
+  static constexpr double kMaxLatencyRegression = 0.25;
+  // Number of windows after a latency regression during which the limit isn't
+  // raised again.
+  static constexpr int kWindowsBeforeRetryingRaise = 8;
+
+  struct WorkerRun {
+    TimeDelta wall_duration;
+    // Thread CPU time of the run, or nullopt if ThreadTicks aren't supported.
+    std::optional<TimeDelta> cpu_duration;
+    // Number of work items processed, as counted by JobDelegate::ShouldYield()
+    // calls.
+    size_t num_items = 0;
+    // Number of workers running the Job when the run started, including this
+    // one.
+    size_t worker_count = 0;
+  };
+
+  // |initial_limit| is clamped to [1, |max_limit|].
+  JobConcurrencyController(size_t initial_limit, size_t max_limit);
+  JobConcurrencyController(const JobConcurrencyController&) = delete;
+  JobConcurrencyController& operator=(const JobConcurrencyController&) =
+      delete;
+  ~JobConcurrencyController();
+
+  // Returns the current maximum number of workers.
+  size_t limit() const { return limit_.load(std::memory_order_relaxed); }
+
+  // Records |run|. Returns true if the limit was raised as a result, in which
+  // case the caller must notify the Job of the concurrency increase.
+  bool ReportWorkerRun(const WorkerRun& run);
+
+ private:
+  // Returns the new limit given the samples of the window that just ended.
+  size_t ComputeLimit() EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  const size_t max_limit_;
+  std::atomic<size_t> limit_;
+
+  CheckedLock lock_;
+
+  // Aggregates of the current window.
+  size_t num_runs_ GUARDED_BY(lock_) = 0;
+  size_t num_saturated_runs_ GUARDED_BY(lock_) = 0;
+  size_t num_items_ GUARDED_BY(lock_) = 0;
+  TimeDelta wall_duration_ GUARDED_BY(lock_);
+  TimeDelta cpu_duration_ GUARDED_BY(lock_);
+  bool has_cpu_duration_ GUARDED_BY(lock_) = true;
+
+  // Latency per item measured right before the limit was last raised, reset
+  // once the window following the raise is evaluated.
+  std::optional<TimeDelta> latency_before_raise_ GUARDED_BY(lock_);
+  int windows_before_retrying_raise_ GUARDED_BY(lock_) = 0;
+};
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_TASK_THREAD_POOL_JOB_CONCURRENCY_CONTROLLER_H_
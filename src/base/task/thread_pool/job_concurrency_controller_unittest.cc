@@ -0,0 +1,117 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/thread_pool/job_concurrency_controller.h"
+
+#include <optional>
+
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+using WorkerRun = JobConcurrencyController::WorkerRun;
+
+WorkerRun MakeRun(size_t worker_count,
+                  TimeDelta item_latency,
+                  std::optional<double> cpu_utilization = 1.0) {
+  constexpr size_t kNumItems = 10;
+  WorkerRun run;
+  run.wall_duration = item_latency * kNumItems;
+  if (cpu_utilization)
+    run.cpu_duration = run.wall_duration * *cpu_utilization;
+  run.num_items = kNumItems;
+  run.worker_count = worker_count;
+  return run;
+}
+
+// Reports a full window of |run| and returns the result of the last report.
+bool ReportWindow(JobConcurrencyController& controller, const WorkerRun& run) {
+  bool limit_raised = false;
+  for (size_t i = 0; i < JobConcurrencyController::kRunsPerWindow; ++i)
+    limit_raised = controller.ReportWorkerRun(run);
+  return limit_raised;
+}
+
+}  // namespace
+
+TEST(ThreadPoolJobConcurrencyControllerTest, InitialLimitIsClamped) {
+  EXPECT_EQ(1U, JobConcurrencyController(0, 4).limit());
+  EXPECT_EQ(3U, JobConcurrencyController(3, 4).limit());
+  EXPECT_EQ(4U, JobConcurrencyController(100, 4).limit());
+}
+
+TEST(ThreadPoolJobConcurrencyControllerTest, LimitChangesOnlyAtEndOfWindow) {
+  JobConcurrencyController controller(2, 4);
+  for (size_t i = 0; i + 1 < JobConcurrencyController::kRunsPerWindow; ++i)
+    EXPECT_FALSE(controller.ReportWorkerRun(MakeRun(2, Milliseconds(1))));
+  EXPECT_EQ(2U, controller.limit());
+  EXPECT_TRUE(controller.ReportWorkerRun(MakeRun(2, Milliseconds(1))));
+  EXPECT_EQ(3U, controller.limit());
+}
+
+TEST(ThreadPoolJobConcurrencyControllerTest, RaisesLimitUpToMax) {
+  JobConcurrencyController controller(2, 3);
+  EXPECT_TRUE(ReportWindow(controller, MakeRun(2, Milliseconds(1))));
+  EXPECT_EQ(3U, controller.limit());
+  EXPECT_FALSE(ReportWindow(controller, MakeRun(3, Milliseconds(1))));
+  EXPECT_EQ(3U, controller.limit());
+}
+
+TEST(ThreadPoolJobConcurrencyControllerTest, KeepsLimitWhenNotSaturated) {
+  JobConcurrencyController controller(4, 8);
+  EXPECT_FALSE(ReportWindow(controller, MakeRun(1, Milliseconds(1))));
+  EXPECT_EQ(4U, controller.limit());
+}
+
+TEST(ThreadPoolJobConcurrencyControllerTest, LowersLimitOnCpuContention) {
+  JobConcurrencyController controller(4, 8);
+  EXPECT_FALSE(ReportWindow(controller, MakeRun(4, Milliseconds(1), 0.3)));
+  EXPECT_EQ(3U, controller.limit());
+
+  // Never goes below one worker.
+  for (int i = 0; i < 5; ++i)
+    ReportWindow(controller, MakeRun(4, Milliseconds(1), 0.3));
+  EXPECT_EQ(1U, controller.limit());
+}
+
+TEST(ThreadPoolJobConcurrencyControllerTest, IgnoresMissingCpuTime) {
+  JobConcurrencyController controller(2, 4);
+  EXPECT_TRUE(
+      ReportWindow(controller, MakeRun(2, Milliseconds(1), std::nullopt)));
+  EXPECT_EQ(3U, controller.limit());
+}
+
+TEST(ThreadPoolJobConcurrencyControllerTest, LowersLimitOnLatencyRegression) {
+  JobConcurrencyController controller(2, 8);
+  EXPECT_TRUE(ReportWindow(controller, MakeRun(2, Milliseconds(1))));
+  EXPECT_EQ(3U, controller.limit());
+
+  // Per-item latency doubled after adding a worker.
+  EXPECT_FALSE(ReportWindow(controller, MakeRun(3, Milliseconds(2))));
+  EXPECT_EQ(2U, controller.limit());
+
+  // The limit isn't raised again for a while.
+  for (int i = 0; i < JobConcurrencyController::kWindowsBeforeRetryingRaise - 1;
+       ++i) {
+    EXPECT_FALSE(ReportWindow(controller, MakeRun(2, Milliseconds(1))));
+    EXPECT_EQ(2U, controller.limit());
+  }
+  EXPECT_TRUE(ReportWindow(controller, MakeRun(2, Milliseconds(1))));
+  EXPECT_EQ(3U, controller.limit());
+}
+
+TEST(ThreadPoolJobConcurrencyControllerTest, KeepsRaiseWithoutRegression) {
+  JobConcurrencyController controller(2, 8);
+  EXPECT_TRUE(ReportWindow(controller, MakeRun(2, Milliseconds(1))));
+  // A small latency increase isn't a regression.
+  EXPECT_TRUE(ReportWindow(controller, MakeRun(3, Microseconds(1100))));
+  EXPECT_EQ(4U, controller.limit());
+}
+
+}  // namespace internal
+}  // namespace base
@@ -5,6 +5,8 @@
 #include "base/task/thread_pool/job_task_source.h"
 
 #include <bit>
+#include <memory>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -14,6 +16,7 @@
 #include "base/memory/ptr_util.h"
 #include "base/notreached.h"
 #include "base/task/common/checked_lock.h"
+#include "base/system/sys_info.h"
 #include "base/task/task_features.h"
 #include "base/task/thread_pool/pooled_task_runner_delegate.h"
 #include "base/threading/thread_restrictions.h"
@@ -99,7 +102,7 @@ JobTaskSource::JobTaskSource(const Location& from_here,
             CheckedLock::AssertNoLockHeldOnCurrentThread();
             // Each worker task has its own delegate with associated state.
             JobDelegate job_delegate{self, self->delegate_};
-            self->worker_task_.Run(&job_delegate);
+            self->RunWorkerTask(&job_delegate);
           },
           base::Unretained(this))),
       task_metadata_(from_here),
@@ -147,7 +150,7 @@ bool JobTaskSource::WillJoin() {
 
 bool JobTaskSource::RunJoinTask() {
   JobDelegate job_delegate{this, nullptr};
-  worker_task_.Run(&job_delegate);
+  RunWorkerTask(&job_delegate);
 
   // It is safe to read |state_| without a lock since this variable is atomic
   // and the call to GetMaxConcurrency() is used for a best effort early exit.
@@ -166,6 +169,37 @@ bool JobTaskSource::RunJoinTask() {
   return WaitForParticipationOpportunity();
 }
 
+void JobTaskSource::EnableAdaptiveConcurrency() {
+  DCHECK(!concurrency_controller_);
+  DCHECK_EQ(GetWorkerCount(), 0U);
+  // Start with one worker per core, and let the controller lower the limit if
+  // workers contend for cores.
+  concurrency_controller_ = std::make_unique<JobConcurrencyController>(
+      static_cast<size_t>(SysInfo::NumberOfProcessors()), kMaxWorkersPerJob);
+}
+
+void JobTaskSource::RunWorkerTask(JobDelegate* job_delegate) {
+  if (!concurrency_controller_) {
+    worker_task_.Run(job_delegate);
+    return;
+  }
+
+  JobConcurrencyController::WorkerRun run;
+  run.worker_count = GetWorkerCount();
+  const TimeTicks start_time = TimeTicks::Now();
+  const std::optional<ThreadTicks> start_thread_time =
+      ThreadTicks::IsSupported() ? std::make_optional(ThreadTicks::Now())
+                                 : std::nullopt;
+  worker_task_.Run(job_delegate);
+  run.wall_duration = TimeTicks::Now() - start_time;
+  if (start_thread_time)
+    run.cpu_duration = ThreadTicks::Now() - *start_thread_time;
+  run.num_items = job_delegate->num_should_yield_calls_;
+
+  if (concurrency_controller_->ReportWorkerRun(run))
+    NotifyConcurrencyIncrease();
+}
+
 void JobTaskSource::Cancel(TaskSource::Transaction* transaction) {
   // Sets the kCanceledMask bit on |state_| so that further calls to
   // WillRunTask() never succeed. std::memory_order_relaxed without a lock is
@@ -305,8 +339,10 @@ size_t JobTaskSource::GetMaxConcurrency() const {
 }
 
 size_t JobTaskSource::GetMaxConcurrency(size_t worker_count) const {
-  return std::min(max_concurrency_callback_.Run(worker_count),
-                  kMaxWorkersPerJob);
+  const size_t max_workers = concurrency_controller_
+                                 ? concurrency_controller_->limit()
+                                 : kMaxWorkersPerJob;
+  return std::min(max_concurrency_callback_.Run(worker_count), max_workers);
 }
 
 uint8_t JobTaskSource::AcquireTaskId() {
@@ -9,6 +9,7 @@
 
 #include <atomic>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <utility>
 
@@ -20,6 +21,7 @@
 #include "base/task/common/task_annotator.h"
 #include "base/task/post_job.h"
 #include "base/task/task_traits.h"
+#include "base/task/thread_pool/job_concurrency_controller.h"
 #include "base/task/thread_pool/task.h"
 #include "base/task/thread_pool/task_source.h"
 #include "base/task/thread_pool/task_source_sort_key.h"
@@ -68,6 +70,10 @@ class BASE_EXPORT JobTaskSource : public TaskSource {
   // WillJoin() or RunJoinTask() previously returned true.
   bool RunJoinTask();
 
+  // Caps the max concurrency with a JobConcurrencyController. Must be called
+  // before this JobTaskSource is first enqueued or joined.
+  void EnableAdaptiveConcurrency();
+
   // Cancels this JobTaskSource, causing all workers to yield and WillRunTask()
   // to return RunStatus::kDisallowed.
   void Cancel(TaskSource::Transaction* transaction = nullptr);
@@ -193,6 +199,10 @@ class BASE_EXPORT JobTaskSource : public TaskSource {
 
   size_t GetMaxConcurrency(size_t worker_count) const;
 
+  // Runs |worker_task_|, reporting the run to |concurrency_controller_| if
+  // adaptive concurrency is enabled.
+  void RunWorkerTask(JobDelegate* job_delegate);
+
   // TaskSource:
   RunStatus WillRunTask() override;
   Task TakeTask(TaskSource::Transaction* transaction) override;
@@ -219,6 +229,9 @@ class BASE_EXPORT JobTaskSource : public TaskSource {
 
   RepeatingCallback<size_t(size_t)> max_concurrency_callback_;
 
+  // Set by EnableAdaptiveConcurrency(), before any worker runs.
+  std::unique_ptr<JobConcurrencyController> concurrency_controller_;
+
   // Worker task set by the job owner.
   RepeatingCallback<void(JobDelegate*)> worker_task_;
   // Task returned from TakeTask(), that calls |worker_task_| internally.
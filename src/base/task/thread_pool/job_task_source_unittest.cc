@@ -4,10 +4,13 @@
 
 #include "base/task/thread_pool/job_task_source.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "base/functional/callback_helpers.h"
 #include "base/memory/ptr_util.h"
+#include "base/system/sys_info.h"
 #include "base/task/thread_pool/pooled_task_runner_delegate.h"
 #include "base/task/thread_pool/test_utils.h"
 #include "base/test/bind.h"
@@ -27,6 +30,8 @@ class MockPooledTaskRunnerDelegate : public PooledTaskRunnerDelegate {
  public:
   MOCK_METHOD2(PostTaskWithSequence,
                bool(Task task, scoped_refptr<Sequence> sequence));
+  MOCK_METHOD2(PostTasksWithSequence,
+               bool(std::vector<Task> tasks, scoped_refptr<Sequence> sequence));
   MOCK_METHOD1(ShouldYield, bool(const TaskSource* task_source));
   MOCK_METHOD1(EnqueueJobTaskSource,
                bool(scoped_refptr<JobTaskSource> task_source));
@@ -260,6 +265,28 @@ TEST_F(ThreadPoolJobTaskSourceTest, RunJoinTask) {
   EXPECT_FALSE(task_source->RunJoinTask());
 }
 
+// Verify that adaptive concurrency caps max concurrency to the controller's
+// limit, which starts at one worker per core.
+TEST_F(ThreadPoolJobTaskSourceTest, AdaptiveConcurrency) {
+  auto job_task = base::MakeRefCounted<test::MockJobTask>(
+      DoNothing(), /* num_tasks_to_run */ 100);
+  scoped_refptr<JobTaskSource> task_source =
+      job_task->GetJobTaskSource(FROM_HERE, {}, &pooled_task_runner_delegate_);
+  const size_t max_concurrency = task_source->GetMaxConcurrency();
+
+  task_source->EnableAdaptiveConcurrency();
+  EXPECT_EQ(std::min(max_concurrency,
+                     static_cast<size_t>(SysInfo::NumberOfProcessors())),
+            task_source->GetMaxConcurrency());
+
+  // Worker tasks still run when joining.
+  EXPECT_TRUE(task_source->WillJoin());
+  EXPECT_TRUE(task_source->RunJoinTask());
+  EXPECT_EQ(99U, job_task->GetMaxConcurrency(0));
+  task_source->Cancel();
+  EXPECT_FALSE(task_source->RunJoinTask());
+}
+
 // Verify that |worker_count| excludes the (inactive) returning thread calling
 // max_concurrency_callback.
 TEST_F(ThreadPoolJobTaskSourceTest, RunTaskWorkerCount) {
@@ -22,6 +22,29 @@ PooledSequencedTaskRunner::PooledSequencedTaskRunner(
 
 PooledSequencedTaskRunner::~PooledSequencedTaskRunner() = default;
 
+bool PooledSequencedTaskRunner::PostTasks(const Location& from_here,
+                                          std::vector<OnceClosure> closures) {
+  if (!PooledTaskRunnerDelegate::MatchesCurrentDelegate(
+          pooled_task_runner_delegate_)) {
+    return false;
+  }
+  if (closures.empty())
+    return true;
+
+  const TimeTicks queue_time = TimeTicks::Now();
+  const TimeDelta leeway = MessagePump::GetLeewayIgnoringThreadOverride();
+  std::vector<Task> tasks;
+  tasks.reserve(closures.size());
+  for (OnceClosure& closure : closures) {
+    tasks.emplace_back(from_here, std::move(closure), queue_time, TimeDelta(),
+                       leeway);
+  }
+
+  // Post the tasks as part of |sequence_|.
+  return pooled_task_runner_delegate_->PostTasksWithSequence(std::move(tasks),
+                                                             sequence_);
+}
+
 bool PooledSequencedTaskRunner::PostDelayedTask(const Location& from_here,
                                                 OnceClosure closure,
                                                 TimeDelta delay) {
@@ -5,6 +5,8 @@
 #ifndef BASE_TASK_THREAD_POOL_POOLED_SEQUENCED_TASK_RUNNER_H_
 #define BASE_TASK_THREAD_POOL_POOLED_SEQUENCED_TASK_RUNNER_H_
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/functional/callback_forward.h"
 #include "base/location.h"
@@ -31,6 +33,9 @@ class BASE_EXPORT PooledSequencedTaskRunner
       delete;
 
   // UpdateableSequencedTaskRunner:
+  bool PostTasks(const Location& from_here,
+                 std::vector<OnceClosure> closures) override;
+
   bool PostDelayedTask(const Location& from_here,
                        OnceClosure closure,
                        TimeDelta delay) override;
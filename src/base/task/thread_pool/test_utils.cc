@@ -5,6 +5,7 @@
 #include "base/task/thread_pool/test_utils.h"
 
 #include <utility>
+#include <vector>
 
 #include "base/check.h"
 #include "base/debug/leak_annotations.h"
@@ -198,6 +199,15 @@ bool MockPooledTaskRunnerDelegate::PostTaskWithSequence(
   return true;
 }
 
+bool MockPooledTaskRunnerDelegate::PostTasksWithSequence(
+    std::vector<Task> tasks,
+    scoped_refptr<Sequence> sequence) {
+  bool all_tasks_posted = true;
+  for (Task& task : tasks)
+    all_tasks_posted &= PostTaskWithSequence(std::move(task), sequence);
+  return all_tasks_posted;
+}
+
 void MockPooledTaskRunnerDelegate::PostTaskWithSequenceNow(
     Task task,
     scoped_refptr<Sequence> sequence) {
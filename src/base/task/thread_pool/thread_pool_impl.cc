@@ -9,6 +9,7 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "base/base_switches.h"
 #include "base/command_line.h"
@@ -467,6 +468,37 @@ bool ThreadPoolImpl::PostTaskWithSequenceNow(Task task,
   return true;
 }
 
+bool ThreadPoolImpl::PostTasksWithSequenceNow(
+    std::vector<Task> tasks,
+    scoped_refptr<Sequence> sequence) {
+  auto transaction = sequence->BeginTransaction();
+  const bool sequence_should_be_queued = transaction.WillPushImmediateTask();
+  RegisteredTaskSource task_source;
+  if (sequence_should_be_queued) {
+    task_source = task_tracker_->RegisterTaskSource(sequence);
+    // We shouldn't push |tasks| if we're not allowed to queue |task_source|.
+    if (!task_source)
+      return false;
+  }
+  const TaskPriority priority = transaction.traits().priority();
+  bool all_tasks_posted = true;
+  for (Task& task : tasks) {
+    if (!task_tracker_->WillPostTaskNow(task, priority)) {
+      all_tasks_posted = false;
+      continue;
+    }
+    transaction.PushImmediateTask(std::move(task));
+  }
+  // The sequence is enqueued once for the whole batch, so that workers are
+  // woken up at most once.
+  if (task_source) {
+    const TaskTraits traits = transaction.traits();
+    GetThreadGroupForTraits(traits)->PushTaskSourceAndWakeUpWorkers(
+        {std::move(task_source), std::move(transaction)});
+  }
+  return all_tasks_posted;
+}
+
 bool ThreadPoolImpl::PostTaskWithSequence(Task task,
                                           scoped_refptr<Sequence> sequence) {
   // Use CHECK instead of DCHECK to crash earlier. See http://crbug.com/711167
@@ -504,6 +536,38 @@ bool ThreadPoolImpl::PostTaskWithSequence(Task task,
   return true;
 }
 
+bool ThreadPoolImpl::PostTasksWithSequence(std::vector<Task> tasks,
+                                           scoped_refptr<Sequence> sequence) {
+  DCHECK(sequence);
+
+  bool all_tasks_posted = true;
+  std::vector<Task> accepted_tasks;
+  accepted_tasks.reserve(tasks.size());
+  for (Task& task : tasks) {
+    // Use CHECK instead of DCHECK to crash earlier. See http://crbug.com/711167
+    // for details.
+    CHECK(task.task);
+    DCHECK(task.delayed_run_time.is_null());
+
+    if (!task_tracker_->WillPostTask(&task, sequence->shutdown_behavior())) {
+      // `task`'s destructor may run sequence-affine code, so it must be leaked
+      // when `WillPostTask` returns false.
+      auto leak = std::make_unique<Task>(std::move(task));
+      ANNOTATE_LEAKING_OBJECT_PTR(leak.get());
+      leak.release();
+      all_tasks_posted = false;
+      continue;
+    }
+    accepted_tasks.push_back(std::move(task));
+  }
+
+  if (accepted_tasks.empty())
+    return all_tasks_posted;
+  return PostTasksWithSequenceNow(std::move(accepted_tasks),
+                                  std::move(sequence)) &&
+         all_tasks_posted;
+}
+
 bool ThreadPoolImpl::ShouldYield(const TaskSource* task_source) {
   const TaskPriority priority = task_source->priority_racy();
   auto* const thread_group =
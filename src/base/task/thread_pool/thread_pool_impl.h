@@ -8,6 +8,7 @@
 #include <memory>
 #include <optional>
 #include <string_view>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/dcheck_is_on.h"
@@ -167,9 +168,17 @@ class BASE_EXPORT ThreadPoolImpl : public ThreadPoolInstance,
   // TaskTracker::WillPostTask() and after |task|'s delayed run time.
   bool PostTaskWithSequenceNow(Task task, scoped_refptr<Sequence> sequence);
 
+  // Posts immediate |tasks| to be executed by the appropriate thread group as
+  // part of |sequence|, enqueuing |sequence| at most once. This must only be
+  // called after |tasks| have gone through TaskTracker::WillPostTask().
+  bool PostTasksWithSequenceNow(std::vector<Task> tasks,
+                                scoped_refptr<Sequence> sequence);
+
   // PooledTaskRunnerDelegate:
   bool PostTaskWithSequence(Task task,
                             scoped_refptr<Sequence> sequence) override;
+  bool PostTasksWithSequence(std::vector<Task> tasks,
+                             scoped_refptr<Sequence> sequence) override;
   bool ShouldYield(const TaskSource* task_source) override;
 
   const std::string histogram_label_;
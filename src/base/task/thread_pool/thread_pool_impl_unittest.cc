@@ -17,6 +17,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/atomic_ref_count.h"
 #include "base/base_switches.h"
 #include "base/cfi_buildflags.h"
 #include "base/containers/span.h"
@@ -870,6 +871,45 @@ TEST_P(ThreadPoolImplTest, SequencedRunsTasksInCurrentSequence) {
   task_ran.Wait();
 }
 
+// Verify that tasks posted as a batch to a SequencedTaskRunner all run, in
+// posting order, and that a batch posted to a parallel TaskRunner all runs.
+TEST_P(ThreadPoolImplTest, PostTasksBatch) {
+  StartThreadPool();
+  constexpr size_t kNumTasks = 100;
+
+  auto sequenced_task_runner = thread_pool_->CreateSequencedTaskRunner({});
+  std::vector<size_t> run_order;
+  TestWaitableEvent sequenced_tasks_ran;
+  std::vector<OnceClosure> sequenced_tasks;
+  for (size_t i = 0; i < kNumTasks; ++i) {
+    sequenced_tasks.push_back(BindLambdaForTesting([&, i] {
+      run_order.push_back(i);
+      if (i + 1 == kNumTasks)
+        sequenced_tasks_ran.Signal();
+    }));
+  }
+  EXPECT_TRUE(
+      sequenced_task_runner->PostTasks(FROM_HERE, std::move(sequenced_tasks)));
+  sequenced_tasks_ran.Wait();
+  ASSERT_EQ(kNumTasks, run_order.size());
+  for (size_t i = 0; i < kNumTasks; ++i)
+    EXPECT_EQ(i, run_order[i]);
+
+  auto parallel_task_runner = thread_pool_->CreateTaskRunner({});
+  AtomicRefCount remaining_tasks(kNumTasks);
+  TestWaitableEvent parallel_tasks_ran;
+  std::vector<OnceClosure> parallel_tasks;
+  for (size_t i = 0; i < kNumTasks; ++i) {
+    parallel_tasks.push_back(BindLambdaForTesting([&] {
+      if (!remaining_tasks.Decrement())
+        parallel_tasks_ran.Signal();
+    }));
+  }
+  EXPECT_TRUE(
+      parallel_task_runner->PostTasks(FROM_HERE, std::move(parallel_tasks)));
+  parallel_tasks_ran.Wait();
+}
+
 // Verify that the RunsTasksInCurrentSequence() method of a
 // SingleThreadTaskRunner returns false when called from a task that isn't part
 // of the sequence.
@@ -0,0 +1,189 @@
+/*
+ * rapidhash - Very fast, high quality, platform-independent hashing algorithm.
+ * Copyright (C) 2024 Nicolas De Carli
+ *
+ * Based on 'wyhash', by Wang Yi <godspeed_china@yeah.net>
+ *
+ * BSD 2-Clause License (https://www.opensource.org/licenses/bsd-license.php)
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above
+ *      copyright notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * You can contact the author at:
+ *   - rapidhash source repository: https://github.com/Nicoshev/rapidhash
+ */
+
+#ifndef BASE_THIRD_PARTY_RAPIDHASH_RAPIDHASH_H_
+#define BASE_THIRD_PARTY_RAPIDHASH_RAPIDHASH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define RAPIDHASH_LIKELY(x) __builtin_expect(x, 1)
+#define RAPIDHASH_UNLIKELY(x) __builtin_expect(x, 0)
+#else
+#define RAPIDHASH_LIKELY(x) (x)
+#define RAPIDHASH_UNLIKELY(x) (x)
+#endif
+
+namespace base::internal::rapidhash {
+
+// Default seed.
+inline constexpr uint64_t kRapidSeed = 0xbdd89aa982704029ull;
+
+// Default secret parameters.
+inline constexpr uint64_t kRapidSecret[3] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull};
+
+// 64*64 -> 128 bit multiply. Stores the low 64 bits of the product in `*a`
+// and the high 64 bits in `*b`.
+inline void RapidMum(uint64_t* a, uint64_t* b) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t r = *a;
+  r *= *b;
+  *a = static_cast<uint64_t>(r);
+  *b = static_cast<uint64_t>(r >> 64);
+#else
+  uint64_t ha = *a >> 32, hb = *b >> 32;
+  uint64_t la = static_cast<uint32_t>(*a), lb = static_cast<uint32_t>(*b);
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  uint64_t t = rl + (rm0 << 32);
+  uint64_t c = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+  *a = lo;
+  *b = hi;
+#endif
+}
+
+// Multiplies and xors the high and low halves of the product.
+inline uint64_t RapidMix(uint64_t a, uint64_t b) {
+  RapidMum(&a, &b);
+  return a ^ b;
+}
+
+// Reads are little-endian on all the platforms Chromium supports. The hash is
+// not meant to be stable across platforms anyway.
+inline uint64_t RapidRead64(const uint8_t* p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t RapidRead32(const uint8_t* p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+// Reads 1, 2 or 3 bytes.
+inline uint64_t RapidReadSmall(const uint8_t* p, size_t k) {
+  return (static_cast<uint64_t>(p[0]) << 56) |
+         (static_cast<uint64_t>(p[k >> 1]) << 32) | p[k - 1];
+}
+
+inline uint64_t RapidhashInternal(const void* key,
+                                  size_t len,
+                                  uint64_t seed,
+                                  const uint64_t* secret) {
+  const uint8_t* p = static_cast<const uint8_t*>(key);
+  seed ^= RapidMix(seed ^ secret[0], secret[1]) ^ len;
+  uint64_t a, b;
+  if (RAPIDHASH_LIKELY(len <= 16)) {
+    if (RAPIDHASH_LIKELY(len >= 4)) {
+      const uint8_t* plast = p + len - 4;
+      a = (RapidRead32(p) << 32) | RapidRead32(plast);
+      const uint64_t delta = ((len & 24) >> (len >> 3));
+      b = ((RapidRead32(p + delta) << 32) | RapidRead32(plast - delta));
+    } else if (RAPIDHASH_LIKELY(len > 0)) {
+      a = RapidReadSmall(p, len);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t i = len;
+    if (RAPIDHASH_UNLIKELY(i > 48)) {
+      uint64_t see1 = seed, see2 = seed;
+      while (RAPIDHASH_LIKELY(i >= 96)) {
+        seed = RapidMix(RapidRead64(p) ^ secret[0], RapidRead64(p + 8) ^ seed);
+        see1 = RapidMix(RapidRead64(p + 16) ^ secret[1],
+                        RapidRead64(p + 24) ^ see1);
+        see2 = RapidMix(RapidRead64(p + 32) ^ secret[2],
+                        RapidRead64(p + 40) ^ see2);
+        seed = RapidMix(RapidRead64(p + 48) ^ secret[0],
+                        RapidRead64(p + 56) ^ seed);
+        see1 = RapidMix(RapidRead64(p + 64) ^ secret[1],
+                        RapidRead64(p + 72) ^ see1);
+        see2 = RapidMix(RapidRead64(p + 80) ^ secret[2],
+                        RapidRead64(p + 88) ^ see2);
+        p += 96;
+        i -= 96;
+      }
+      if (RAPIDHASH_UNLIKELY(i >= 48)) {
+        seed = RapidMix(RapidRead64(p) ^ secret[0], RapidRead64(p + 8) ^ seed);
+        see1 = RapidMix(RapidRead64(p + 16) ^ secret[1],
+                        RapidRead64(p + 24) ^ see1);
+        see2 = RapidMix(RapidRead64(p + 32) ^ secret[2],
+                        RapidRead64(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      }
+      seed ^= see1 ^ see2;
+    }
+    if (i > 16) {
+      seed = RapidMix(RapidRead64(p) ^ secret[2],
+                      RapidRead64(p + 8) ^ seed ^ secret[1]);
+      if (i > 32) {
+        seed = RapidMix(RapidRead64(p + 16) ^ secret[2],
+                        RapidRead64(p + 24) ^ seed);
+      }
+    }
+    a = RapidRead64(p + i - 16);
+    b = RapidRead64(p + i - 8);
+  }
+  a ^= secret[1];
+  b ^= seed;
+  RapidMum(&a, &b);
+  return RapidMix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+// Returns a 64-bit hash of the `len` bytes at `key`, using `seed`.
+inline uint64_t RapidhashWithSeed(const void* key, size_t len, uint64_t seed) {
+  return RapidhashInternal(key, len, seed, kRapidSecret);
+}
+
+// Returns a 64-bit hash of the `len` bytes at `key`.
+inline uint64_t Rapidhash(const void* key, size_t len) {
+  return RapidhashWithSeed(key, len, kRapidSeed);
+}
+
+}  // namespace base::internal::rapidhash
+
+#undef RAPIDHASH_LIKELY
+#undef RAPIDHASH_UNLIKELY
+
+#endif  // BASE_THIRD_PARTY_RAPIDHASH_RAPIDHASH_H_
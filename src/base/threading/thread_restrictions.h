@@ -416,6 +416,7 @@ class ObfuscatedFileUtil;
 namespace syncer {
 class GetLocalChangesRequest;
 class HttpBridge;
+class ModelTypeWorker;
 }  // namespace syncer
 namespace tracing {
 class FuchsiaPerfettoProducerConnector;
@@ -805,6 +806,7 @@ class BASE_EXPORT [[maybe_unused, nodiscard]] ScopedAllowBaseSyncPrimitives {
   friend class storage::ObfuscatedFileUtil;
   friend class syncer::HttpBridge;
   friend class syncer::GetLocalChangesRequest;
+  friend class syncer::ModelTypeWorker;
   friend class updater::SystemctlLauncherScopedAllowBaseSyncPrimitives;
 
   // Usage that should be fixed:
@@ -29,6 +29,9 @@
 
 #include "base/base_export.h"
 #include "base/containers/circular_deque.h"
+#include "base/containers/fixed_lru_cache.h"
+#include "base/containers/flat_hash_map.h"
+#include "base/containers/flat_hash_set.h"
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/containers/linked_list.h"
@@ -190,6 +193,12 @@ size_t EstimateMemoryUsage(const base::flat_set<T, C>& set);
 template <class K, class V, class C>
 size_t EstimateMemoryUsage(const base::flat_map<K, V, C>& map);
 
+template <class T, class H, class E>
+size_t EstimateMemoryUsage(const base::flat_hash_set<T, H, E>& set);
+
+template <class K, class V, class H, class E>
+size_t EstimateMemoryUsage(const base::flat_hash_map<K, V, H, E>& map);
+
 template <class K, class V, class C>
 size_t EstimateMemoryUsage(const base::LRUCache<K, V, C>& lru);
 
@@ -202,6 +211,12 @@ size_t EstimateMemoryUsage(const base::LRUCacheSet<V, C>& lru);
 template <class V, class C>
 size_t EstimateMemoryUsage(const base::HashingLRUCacheSet<V, C>& lru);
 
+template <class K, class V, class H, class E>
+size_t EstimateMemoryUsage(const base::FixedHashingLRUCache<K, V, H, E>& lru);
+
+template <class V, class H, class E>
+size_t EstimateMemoryUsage(const base::FixedHashingLRUCacheSet<V, H, E>& lru);
+
 // TODO(dskiba):
 //   std::forward_list
 
@@ -476,6 +491,17 @@ size_t DoEstimateMemoryUsageForLruCache(const LruCacheType& lru_cache) {
          EstimateMemoryUsage(lru_cache.index_);
 }
 
+template <class FixedLruCacheType>
+size_t DoEstimateMemoryUsageForFixedLruCache(
+    const FixedLruCacheType& lru_cache) {
+  size_t allocated = 0;
+  if (lru_cache.nodes_) {
+    allocated = sizeof(lru_cache.nodes_[0]) * (lru_cache.max_size() + 1) +
+                sizeof(lru_cache.index_[0]) * lru_cache.index_capacity_;
+  }
+  return allocated + EstimateIterableMemoryUsage(lru_cache);
+}
+
 }  // namespace internal
 
 template <class V>
@@ -614,6 +640,21 @@ size_t EstimateMemoryUsage(const base::flat_map<K, V, C>& map) {
   return sizeof(value_type) * map.capacity() + EstimateIterableMemoryUsage(map);
 }
 
+// The control bytes and the slots of flat hash containers share one
+// allocation.
+
+template <class T, class H, class E>
+size_t EstimateMemoryUsage(const base::flat_hash_set<T, H, E>& set) {
+  return set.AllocationSizeForCapacity(set.capacity()) +
+         EstimateIterableMemoryUsage(set);
+}
+
+template <class K, class V, class H, class E>
+size_t EstimateMemoryUsage(const base::flat_hash_map<K, V, H, E>& map) {
+  return map.AllocationSizeForCapacity(map.capacity()) +
+         EstimateIterableMemoryUsage(map);
+}
+
 template <class K, class V, class C>
 size_t EstimateMemoryUsage(const LRUCache<K, V, C>& lru_cache) {
   return internal::DoEstimateMemoryUsageForLruCache(lru_cache);
@@ -634,6 +675,18 @@ size_t EstimateMemoryUsage(const HashingLRUCacheSet<V, C>& lru_cache) {
   return internal::DoEstimateMemoryUsageForLruCache(lru_cache);
 }
 
+template <class K, class V, class H, class E>
+size_t EstimateMemoryUsage(
+    const FixedHashingLRUCache<K, V, H, E>& lru_cache) {
+  return internal::DoEstimateMemoryUsageForFixedLruCache(lru_cache);
+}
+
+template <class V, class H, class E>
+size_t EstimateMemoryUsage(
+    const FixedHashingLRUCacheSet<V, H, E>& lru_cache) {
+  return internal::DoEstimateMemoryUsageForFixedLruCache(lru_cache);
+}
+
 }  // namespace trace_event
 }  // namespace base
 
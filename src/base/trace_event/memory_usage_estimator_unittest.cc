@@ -250,6 +250,16 @@ TEST(EstimateMemoryUsageTest, UnorderedMultiMap) {
   EXPECT_EQ_32_64(515540u, 531580u, EstimateMemoryUsage(map));
 }
 
+TEST(EstimateMemoryUsageTest, FlatHashMap) {
+  base::flat_hash_map<Data, short, Data::Hasher> map;
+  for (int i = 0; i != 1000; ++i) {
+    map.insert({Data(i), static_cast<short>(i)});
+  }
+  // 2048 slots and their control bytes.
+  EXPECT_EQ(2048u, map.capacity());
+  EXPECT_EQ_32_64(517936u, 534324u, EstimateMemoryUsage(map));
+}
+
 TEST(EstimateMemoryUsageTest, Deque) {
   std::deque<Data> deque;
 
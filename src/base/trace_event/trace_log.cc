@@ -325,6 +325,13 @@ void OnAddLegacyTraceEvent(TraceEvent* trace_event,
       write_args);
 }
 
+// Whether the current thread can hold a ThreadLocalEventBuffer, see
+// TraceLog::InitializeThreadLocalEventBufferIfSupported().
+bool CurrentThreadSupportsLocalEventBuffer() {
+  return !thread_blocks_message_loop && CurrentThread::IsSet() &&
+         SingleThreadTaskRunner::HasCurrentDefault();
+}
+
 void OnUpdateLegacyTraceEventDuration(
     const unsigned char* category_group_enabled,
     const char* name,
@@ -663,8 +670,7 @@ void TraceLog::InitializeThreadLocalEventBufferIfSupported() {
   // - to handle the final flush.
   // For a thread without a message loop or if the message loop may be blocked,
   // the trace events will be added into the main buffer directly.
-  if (thread_blocks_message_loop || !CurrentThread::IsSet() ||
-      !SingleThreadTaskRunner::HasCurrentDefault()) {
+  if (!CurrentThreadSupportsLocalEventBuffer()) {
     return;
   }
   HEAP_PROFILER_SCOPED_IGNORE;
@@ -1538,29 +1544,34 @@ TraceEventHandle TraceLog::AddTraceEventWithThreadIdAndTimestamps(
 
   TimeTicks offset_event_timestamp = OffsetTimestamp(timestamp);
 
-  ThreadLocalEventBuffer* event_buffer = nullptr;
-  if (*category_group_enabled & RECORDING_MODE) {
-    // |thread_local_event_buffer| can be null if the current thread doesn't
-    // have a message loop or the message loop is blocked.
-    InitializeThreadLocalEventBufferIfSupported();
-    event_buffer = thread_local_event_buffer;
-  }
-
   if (*category_group_enabled & RECORDING_MODE) {
     auto trace_event_override =
         add_trace_event_override_.load(std::memory_order_relaxed);
     if (trace_event_override) {
+      // The event never reaches |logged_events_|, so don't create a
+      // ThreadLocalEventBuffer for it: that would cost an allocation, a
+      // memory dump provider and a |lock_| acquisition per thread for a chunk
+      // that stays empty.
       TraceEvent new_trace_event(
           thread_id, offset_event_timestamp, thread_timestamp, phase,
           category_group_enabled, name, scope, id, bind_id, args, flags);
 
-      trace_event_override(&new_trace_event,
-                           /*thread_will_flush=*/event_buffer != nullptr,
-                           &handle);
+      trace_event_override(
+          &new_trace_event,
+          /*thread_will_flush=*/CurrentThreadSupportsLocalEventBuffer(),
+          &handle);
       return handle;
     }
   }
 
+  ThreadLocalEventBuffer* event_buffer = nullptr;
+  if (*category_group_enabled & RECORDING_MODE) {
+    // |thread_local_event_buffer| can be null if the current thread doesn't
+    // have a message loop or the message loop is blocked.
+    InitializeThreadLocalEventBufferIfSupported();
+    event_buffer = thread_local_event_buffer;
+  }
+
   std::string console_message;
 
   // If enabled for recording, the event should be added only if one of the
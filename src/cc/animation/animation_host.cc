@@ -5,11 +5,13 @@
 #include "cc/animation/animation_host.h"
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <utility>
 
 #include "base/auto_reset.h"
 #include "base/containers/contains.h"
+#include "base/containers/span.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback.h"
 #include "base/memory/ptr_util.h"
@@ -538,22 +540,56 @@ bool AnimationHost::TickAnimations(base::TimeTicks monotonic_time,
 
   TRACE_EVENT_INSTANT0("cc", "NeedsTickAnimations", TRACE_EVENT_SCOPE_THREAD);
 
+  // Hand each timeline only the contiguous batch of ticking animations that
+  // belong to it, rather than having every timeline scan all of them, which
+  // costs # of timelines * # of ticking animations per frame. With a single
+  // timeline the ticking list is already one batch.
+  base::span<const scoped_refptr<Animation>> ticking_animations(
+      ticking_animations_.Read(*this));
+  AnimationsList sorted_ticking_animations;
+  if (id_to_timeline_map_.Read(*this).size() > 1) {
+    sorted_ticking_animations = ticking_animations_.Read(*this);
+    // A stable sort keeps the tick order of animations within a timeline.
+    std::stable_sort(sorted_ticking_animations.begin(),
+                     sorted_ticking_animations.end(),
+                     [](const scoped_refptr<Animation>& a,
+                        const scoped_refptr<Animation>& b) {
+                       return std::less<AnimationTimeline*>()(
+                           a->animation_timeline(), b->animation_timeline());
+                     });
+    ticking_animations = sorted_ticking_animations;
+  }
+
   bool animated = false;
-  std::vector<AnimationTimeline*> scroll_timelines;
-  for (auto& kv : id_to_timeline_map_.Read(*this)) {
-    AnimationTimeline* timeline = kv.second.get();
+  std::vector<std::pair<AnimationTimeline*,
+                        base::span<const scoped_refptr<Animation>>>>
+      scroll_timeline_batches;
+  while (!ticking_animations.empty()) {
+    AnimationTimeline* timeline = ticking_animations[0]->animation_timeline();
+    size_t batch_size = 1;
+    while (batch_size < ticking_animations.size() &&
+           ticking_animations[batch_size]->animation_timeline() == timeline) {
+      ++batch_size;
+    }
+    base::span<const scoped_refptr<Animation>> batch =
+        ticking_animations.first(batch_size);
+    ticking_animations = ticking_animations.subspan(batch_size);
+
+    if (!timeline) {
+      continue;
+    }
     if (timeline->IsScrollTimeline()) {
-      scroll_timelines.push_back(timeline);
+      scroll_timeline_batches.emplace_back(timeline, batch);
     } else {
-      animated |= timeline->TickTimeLinkedAnimations(
-          ticking_animations_.Read(*this), monotonic_time, !is_active_tree);
+      animated |= timeline->TickTimeLinkedAnimations(batch, monotonic_time,
+                                                     !is_active_tree);
     }
   }
   // Tick the scroll-linked animations last, since a smooth scroll (time-linked)
   // might update the scroll offset.
-  for (auto* timeline : scroll_timelines) {
-    animated |= timeline->TickScrollLinkedAnimations(
-        ticking_animations_.Read(*this), scroll_tree, is_active_tree);
+  for (auto& [timeline, batch] : scroll_timeline_batches) {
+    animated |= timeline->TickScrollLinkedAnimations(batch, scroll_tree,
+                                                     is_active_tree);
   }
 
   // TODO(majidvp): At the moment we call this for both active and pending
@@ -5,17 +5,26 @@
 #include "base/memory/raw_ptr.h"
 #include "cc/animation/animation_host.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "base/task/single_thread_task_runner.h"
+#include "base/time/time.h"
 #include "base/timer/lap_timer.h"
 #include "cc/animation/animation.h"
 #include "cc/animation/animation_id_provider.h"
 #include "cc/animation/animation_timeline.h"
+#include "cc/test/animation_test_common.h"
+#include "cc/test/animation_timelines_test_common.h"
 #include "cc/test/fake_impl_task_runner_provider.h"
 #include "cc/test/fake_layer_tree_host.h"
 #include "cc/test/fake_layer_tree_host_client.h"
 #include "cc/test/fake_layer_tree_host_impl.h"
 #include "cc/test/stub_layer_tree_host_single_thread_client.h"
 #include "cc/test/test_task_graph_runner.h"
+#include "cc/trees/property_tree.h"
+#include "cc/trees/target_property.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_result_reporter.h"
 
@@ -165,4 +174,90 @@ TEST_F(AnimationHostPerfTest, Push1000TimelinesPropertiesTo) {
   DoTest("Push1000TimelinesPropertiesTo");
 }
 
+// Measures ticking a large number of running impl-side animations, the per
+// frame cost of compositor-driven animations.
+class AnimationHostTickPerfTest : public testing::Test {
+ protected:
+  AnimationHostTickPerfTest() : client_(ThreadInstance::kImpl) {}
+
+  AnimationHost* host() { return client_.host(); }
+
+  // Creates |num_animations| animations spread round-robin over
+  // |num_timelines| document timelines, each animating |property| on its own
+  // element for longer than the test runs.
+  void CreateAnimations(int num_animations,
+                        int num_timelines,
+                        TargetProperty::Type property) {
+    std::vector<scoped_refptr<AnimationTimeline>> timelines;
+    for (int i = 0; i < num_timelines; ++i) {
+      timelines.push_back(
+          AnimationTimeline::Create(AnimationIdProvider::NextTimelineId()));
+      host()->AddAnimationTimeline(timelines.back());
+    }
+
+    constexpr double kDuration = 1000000;
+    for (int i = 0; i < num_animations; ++i) {
+      ElementId element_id(i + 1);
+      client_.RegisterElementId(element_id, ElementListType::ACTIVE);
+
+      scoped_refptr<Animation> animation =
+          Animation::Create(AnimationIdProvider::NextAnimationId());
+      timelines[i % num_timelines]->AttachAnimation(animation);
+      animation->AttachElement(element_id);
+      if (property == TargetProperty::OPACITY) {
+        AddOpacityTransitionToAnimation(animation.get(), kDuration, 0.f, 1.f,
+                                        /*use_timing_function=*/true);
+      } else {
+        AddAnimatedTransformToAnimation(animation.get(), kDuration, 100, 100);
+      }
+    }
+    EXPECT_EQ(static_cast<size_t>(num_animations),
+              host()->ticking_animations_for_testing().size());
+
+    // Start the keyframe models so that the timed loop only measures ticking
+    // running animations.
+    std::unique_ptr<MutatorEvents> events = host()->CreateEvents();
+    Tick();
+    host()->UpdateAnimationState(true, events.get());
+  }
+
+  void DoTest(const std::string& test_name) {
+    timer_.Reset();
+    do {
+      Tick();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PerfResultReporter reporter("tick_animations", test_name);
+    reporter.RegisterImportantMetric("", "runs/s");
+    reporter.AddResult("", timer_.LapsPerSecond());
+  }
+
+ private:
+  void Tick() {
+    time_ += base::Milliseconds(16);
+    host()->TickAnimations(time_, scroll_tree_, /*is_active_tree=*/true);
+  }
+
+  TestHostClient client_;
+  ScrollTree scroll_tree_;
+  base::TimeTicks time_ = base::TimeTicks() + base::Seconds(1);
+  base::LapTimer timer_;
+};
+
+TEST_F(AnimationHostTickPerfTest, Tick10000OpacityAnimations) {
+  CreateAnimations(10000, 1, TargetProperty::OPACITY);
+  DoTest("Tick10000OpacityAnimations");
+}
+
+TEST_F(AnimationHostTickPerfTest, Tick10000TransformAnimations) {
+  CreateAnimations(10000, 1, TargetProperty::TRANSFORM);
+  DoTest("Tick10000TransformAnimations");
+}
+
+TEST_F(AnimationHostTickPerfTest, Tick10000AnimationsOn100Timelines) {
+  CreateAnimations(10000, 100, TargetProperty::OPACITY);
+  DoTest("Tick10000AnimationsOn100Timelines");
+}
+
 }  // namespace cc
@@ -5,6 +5,7 @@
 #include "cc/animation/animation_host.h"
 
 #include <limits>
+#include <vector>
 
 #include "base/memory/ptr_util.h"
 #include "base/test/scoped_feature_list.h"
@@ -606,5 +607,32 @@ TEST_F(AnimationHostTest, ScrollTimelineOffsetUpdatedByScrollAnimation) {
   EXPECT_NEAR(tick_time, 0.2 * duration, 1e-6);
 }
 
+// Every ticking animation is ticked exactly once by its own timeline, even when
+// the ticking list interleaves animations from several timelines.
+TEST_F(AnimationHostTest, TickAnimationsOnInterleavedTimelines) {
+  scoped_refptr<AnimationTimeline> timeline1 =
+      AnimationTimeline::Create(AnimationIdProvider::NextTimelineId());
+  scoped_refptr<AnimationTimeline> timeline2 =
+      AnimationTimeline::Create(AnimationIdProvider::NextTimelineId());
+  host_impl_->AddAnimationTimeline(timeline1);
+  host_impl_->AddAnimationTimeline(timeline2);
+
+  std::vector<scoped_refptr<MockAnimation>> animations;
+  for (int i = 0; i < 6; ++i) {
+    animations.push_back(base::WrapRefCounted(
+        new MockAnimation(AnimationIdProvider::NextAnimationId())));
+    (i % 2 ? timeline2 : timeline1)->AttachAnimation(animations.back());
+    host_impl_->AddToTicking(animations.back());
+    EXPECT_CALL(*animations.back(), Tick(_)).WillOnce(Return(true));
+  }
+
+  ScrollTree scroll_tree;
+  EXPECT_TRUE(host_impl_->TickAnimations(base::TimeTicks(), scroll_tree,
+                                         /*is_active_tree=*/false));
+  for (auto& animation : animations) {
+    Mock::VerifyAndClearExpectations(animation.get());
+  }
+}
+
 }  // namespace
 }  // namespace cc
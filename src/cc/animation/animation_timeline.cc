@@ -88,7 +88,7 @@ void AnimationTimeline::ClearAnimations() {
 }
 
 bool AnimationTimeline::TickTimeLinkedAnimations(
-    const std::vector<scoped_refptr<Animation>>& ticking_animations,
+    base::span<const scoped_refptr<Animation>> ticking_animations,
     base::TimeTicks monotonic_time,
     bool tick_finished) {
   DCHECK(!IsScrollTimeline());
@@ -115,7 +115,7 @@ bool AnimationTimeline::TickTimeLinkedAnimations(
 }
 
 bool AnimationTimeline::TickScrollLinkedAnimations(
-    const std::vector<scoped_refptr<Animation>>& ticking_animations,
+    base::span<const scoped_refptr<Animation>> ticking_animations,
     const ScrollTree& scroll_tree,
     bool is_active_tree) {
   return false;
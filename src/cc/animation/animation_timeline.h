@@ -9,6 +9,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "base/containers/span.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/ref_counted.h"
 #include "cc/animation/animation_export.h"
@@ -63,11 +64,11 @@ class CC_ANIMATION_EXPORT AnimationTimeline
     return !id_to_animation_map_.Read(*this).empty();
   }
   bool TickTimeLinkedAnimations(
-      const std::vector<scoped_refptr<Animation>>& ticking_animations,
+      base::span<const scoped_refptr<Animation>> ticking_animations,
       base::TimeTicks monotonic_time,
       bool tick_finished);
   virtual bool TickScrollLinkedAnimations(
-      const std::vector<scoped_refptr<Animation>>& ticking_animations,
+      base::span<const scoped_refptr<Animation>> ticking_animations,
       const ScrollTree& scroll_tree,
       bool is_active_tree);
 
@@ -160,7 +160,7 @@ void ScrollTimeline::ActivateTimeline() {
 }
 
 bool ScrollTimeline::TickScrollLinkedAnimations(
-    const std::vector<scoped_refptr<Animation>>& ticking_animations,
+    base::span<const scoped_refptr<Animation>> ticking_animations,
     const ScrollTree& scroll_tree,
     bool is_active_tree) {
   std::optional<base::TimeTicks> tick_time =
@@ -169,12 +169,6 @@ bool ScrollTimeline::TickScrollLinkedAnimations(
     return false;
 
   bool animated = false;
-  // This potentially iterates over all ticking animations multiple
-  // times (# of ScrollTimeline * # of ticking_animations_).
-  // The alternative we have considered here was to maintain a
-  // ticking_animations_ list for each timeline but at the moment we
-  // have opted to avoid this complexity in favor of simpler but less
-  // efficient solution.
   for (auto& animation : ticking_animations) {
     if (animation->animation_timeline() != this)
       continue;
@@ -121,7 +121,7 @@ class CC_ANIMATION_EXPORT ScrollTimeline : public AnimationTimeline {
   void ActivateTimeline() override;
 
   bool TickScrollLinkedAnimations(
-      const std::vector<scoped_refptr<Animation>>& ticking_animations,
+      base::span<const scoped_refptr<Animation>> ticking_animations,
       const ScrollTree& scroll_tree,
       bool is_active_tree) override;
 
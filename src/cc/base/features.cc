@@ -211,4 +211,43 @@ BASE_FEATURE(kDontAlwaysPushPictureLayerImpls,
              "DontAlwaysPushPictureLayerImpls",
              base::FEATURE_DISABLED_BY_DEFAULT);
 
+BASE_FEATURE(kSharedSoftwareImageDecodeCache,
+             "SharedSoftwareImageDecodeCache",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+BASE_FEATURE(kParallelRasterTileQueueConstruction,
+             "ParallelRasterTileQueueConstruction",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+BASE_FEATURE(kPredictiveCheckerImageDecodes,
+             "PredictiveCheckerImageDecodes",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+const base::FeatureParam<double> kPredictiveCheckerImageDecodeBudgetRatio{
+    &kPredictiveCheckerImageDecodes, "budget_ratio", 0.25};
+
+BASE_FEATURE(kSchedulerStageLatencyRecording,
+             "SchedulerStageLatencyRecording",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+BASE_FEATURE(kPaintOpBufferStoragePool,
+             "PaintOpBufferStoragePool",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+BASE_FEATURE(kBatchedGpuImageUploads,
+             "BatchedGpuImageUploads",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+BASE_FEATURE(kSharedStagingBufferPool,
+             "SharedStagingBufferPool",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+BASE_FEATURE(kJankAttribution,
+             "JankAttribution",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+BASE_FEATURE(kSlimSkipFramesWithoutDamage,
+             "SlimSkipFramesWithoutDamage",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 }  // namespace features
@@ -200,6 +200,57 @@ CC_BASE_EXPORT extern const base::FeatureParam<double>
 // tree Activation. See crbug.com/40335690.
 CC_BASE_EXPORT BASE_DECLARE_FEATURE(kDontAlwaysPushPictureLayerImpls);
 
+// When enabled, unlocked software image decodes evicted from a
+// SoftwareImageDecodeCache, including those left behind when the cache is
+// destroyed on navigation, are kept in a process-wide pool and adopted by later
+// caches instead of being decoded again.
+CC_BASE_EXPORT BASE_DECLARE_FEATURE(kSharedSoftwareImageDecodeCache);
+
+// When enabled, RasterTilePriorityQueueAll builds the per-layer
+// TilingSetRasterQueueAll instances of pages with many picture layers on the
+// thread pool instead of serially on the compositor thread.
+CC_BASE_EXPORT BASE_DECLARE_FEATURE(kParallelRasterTileQueueConstruction);
+
+// When enabled, while the user is scrolling, the TileManager queues decodes for
+// checker-imaged content on pre-paint tiles it could not schedule yet, so that
+// the images are decoded before those tiles are rasterized. The decodes
+// queued per PrepareTiles are limited to
+// |kPredictiveCheckerImageDecodeBudgetRatio| of the image decode cache budget.
+CC_BASE_EXPORT BASE_DECLARE_FEATURE(kPredictiveCheckerImageDecodes);
+CC_BASE_EXPORT extern const base::FeatureParam<double>
+    kPredictiveCheckerImageDecodeBudgetRatio;
+
+// When enabled, the Scheduler records the latency of each compositor pipeline
+// stage (BeginMainFrame, commit, raster, activation, draw and submit) into a
+// FrameStageLatencyRecorder, which traces them and reports a subsample to UMA.
+CC_BASE_EXPORT BASE_DECLARE_FEATURE(kSchedulerStageLatencyRecording);
+
+// When enabled, PaintOpBuffers recorded while the LayerTreeHost updates a main
+// frame grow into data blocks recycled through a PaintOpBufferStoragePool,
+// which is emptied after commit, instead of fresh heap allocations.
+CC_BASE_EXPORT BASE_DECLARE_FEATURE(kPaintOpBufferStoragePool);
+
+// When enabled, the first GpuImageDecodeCache upload task to run also uploads
+// the other images of the raster frame whose decodes are done, so uploads are
+// issued back to back under one context lock acquisition.
+CC_BASE_EXPORT BASE_DECLARE_FEATURE(kBatchedGpuImageUploads);
+
+// When enabled, OneCopyRasterBufferProviders that share a worker context and
+// compositor thread also share one StagingBufferPool, so a new compositor
+// starts with the staging buffers the others have already allocated.
+CC_BASE_EXPORT BASE_DECLARE_FEATURE(kSharedStagingBufferPool);
+
+// When enabled, each dropped or late frame is attributed to its slowest
+// compositor pipeline stage and to the longest task that ran on the compositor
+// thread while it was in flight. See JankAttributionTracker.
+CC_BASE_EXPORT BASE_DECLARE_FEATURE(kJankAttribution);
+
+// When enabled, the slim compositor does not submit a CompositorFrame whose
+// root render pass has no damage and that carries no copy requests,
+// presentation callbacks or UI resource changes. Viz keeps showing the
+// previous frame, which is identical, and is sent DidNotProduceFrame instead.
+CC_BASE_EXPORT BASE_DECLARE_FEATURE(kSlimSkipFramesWithoutDamage);
+
 }  // namespace features
 
 #endif  // CC_BASE_FEATURES_H_
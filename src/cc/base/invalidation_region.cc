@@ -4,7 +4,10 @@
 
 #include "cc/base/invalidation_region.h"
 
+#include <algorithm>
+
 #include "base/metrics/histogram.h"
+#include "cc/base/rect_batch.h"
 
 namespace {
 
@@ -35,6 +38,22 @@ void InvalidationRegion::Union(const gfx::Rect& rect) {
     pending_rects_.push_back(rect);
 }
 
+void InvalidationRegion::Union(base::span<const gfx::Rect> rects) {
+  size_t room = kMaxInvalidationRectCount -
+                std::min<size_t>(pending_rects_.size(),
+                                 kMaxInvalidationRectCount);
+  size_t num_to_append = std::min(room, rects.size());
+  pending_rects_.insert(pending_rects_.end(), rects.begin(),
+                        rects.begin() + num_to_append);
+
+  // Rects past the limit are folded into the first pending rect, as in the
+  // single rect version.
+  if (num_to_append < rects.size()) {
+    pending_rects_[0].Union(
+        ComputeRectBatchBounds(rects.subspan(num_to_append)));
+  }
+}
+
 void InvalidationRegion::FinalizePendingRects() {
   if (pending_rects_.empty())
     return;
@@ -42,12 +61,10 @@ void InvalidationRegion::FinalizePendingRects() {
   if (region_.GetRegionComplexity() + pending_rects_.size() >
       kMaxInvalidationRectCount) {
     gfx::Rect pending_bounds = region_.bounds();
-    for (auto& rect : pending_rects_)
-      pending_bounds.Union(rect);
+    pending_bounds.Union(ComputeRectBatchBounds(pending_rects_));
     region_ = pending_bounds;
   } else {
-    for (auto& rect : pending_rects_)
-      region_.Union(rect);
+    region_.Union(pending_rects_);
   }
 
   pending_rects_.clear();
@@ -7,6 +7,7 @@
 
 #include <vector>
 
+#include "base/containers/span.h"
 #include "cc/base/base_export.h"
 #include "cc/base/region.h"
 #include "ui/gfx/geometry/rect.h"
@@ -24,6 +25,8 @@ class CC_BASE_EXPORT InvalidationRegion {
   void Swap(Region* region);
   void Clear();
   void Union(const gfx::Rect& rect);
+  // Equivalent to calling Union() with each rect in turn.
+  void Union(base::span<const gfx::Rect> rects);
   bool IsEmpty() const { return pending_rects_.empty() && region_.IsEmpty(); }
 
  private:
@@ -0,0 +1,175 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/base/rect_batch.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "base/compiler_specific.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#define CC_RECT_BATCH_USE_SSE2 1
+#elif defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#define CC_RECT_BATCH_USE_NEON 1
+#endif
+
+namespace cc {
+
+namespace {
+
+// The vector paths load a gfx::Rect as the four ints x, y, width, height.
+static_assert(sizeof(gfx::Rect) == 4 * sizeof(int32_t),
+              "gfx::Rect must be four packed ints");
+
+#if defined(CC_RECT_BATCH_USE_SSE2)
+
+// Returns (x, y, -right, -bottom) for |rect|, so that containment and bounds
+// reduce to a lane-wise comparison or minimum.
+ALWAYS_INLINE __m128i LoadNegatedEdges(const gfx::Rect& rect) {
+  const __m128i xywh =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(&rect));
+  // (x, y, x + w, y + h).
+  const __m128i edges = _mm_add_epi32(xywh, _mm_slli_si128(xywh, 8));
+  const __m128i far_lanes = _mm_set_epi32(-1, -1, 0, 0);
+  // Negate the two far edges: (v ^ m) - m is -v where m is all ones.
+  return _mm_sub_epi32(_mm_xor_si128(edges, far_lanes), far_lanes);
+}
+
+ALWAYS_INLINE bool IsEmpty(const gfx::Rect& rect) {
+  const __m128i xywh =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(&rect));
+  const __m128i positive = _mm_cmpgt_epi32(xywh, _mm_setzero_si128());
+  // Width and height are in lanes 2 and 3.
+  return (_mm_movemask_ps(_mm_castsi128_ps(positive)) & 0xC) != 0xC;
+}
+
+ALWAYS_INLINE __m128i Min(__m128i a, __m128i b) {
+  const __m128i a_greater = _mm_cmpgt_epi32(a, b);
+  return _mm_or_si128(_mm_and_si128(a_greater, b),
+                      _mm_andnot_si128(a_greater, a));
+}
+
+#elif defined(CC_RECT_BATCH_USE_NEON)
+
+ALWAYS_INLINE int32x4_t LoadNegatedEdges(const gfx::Rect& rect) {
+  const int32x4_t xywh = vld1q_s32(reinterpret_cast<const int32_t*>(&rect));
+  const int32x4_t zero = vdupq_n_s32(0);
+  // (x, y, x + w, y + h).
+  const int32x4_t edges =
+      vaddq_s32(xywh, vcombine_s32(vget_low_s32(zero), vget_low_s32(xywh)));
+  const int32_t signs[4] = {1, 1, -1, -1};
+  return vmulq_s32(edges, vld1q_s32(signs));
+}
+
+ALWAYS_INLINE bool IsEmpty(const gfx::Rect& rect) {
+  const int32x4_t xywh = vld1q_s32(reinterpret_cast<const int32_t*>(&rect));
+  const int32x2_t wh = vget_high_s32(xywh);
+  // All ones in a lane where the size is not positive.
+  const uint32x2_t not_positive = vcle_s32(wh, vdup_n_s32(0));
+  return vmaxv_u32(not_positive) != 0;
+}
+
+#endif
+
+}  // namespace
+
+gfx::Rect ComputeRectBatchBounds(base::span<const gfx::Rect> rects) {
+#if defined(CC_RECT_BATCH_USE_SSE2)
+  __m128i min_edges = _mm_set1_epi32(std::numeric_limits<int32_t>::max());
+  bool has_rect = false;
+  for (const gfx::Rect& rect : rects) {
+    if (IsEmpty(rect)) {
+      continue;
+    }
+    min_edges = Min(min_edges, LoadNegatedEdges(rect));
+    has_rect = true;
+  }
+  if (!has_rect) {
+    return gfx::Rect();
+  }
+  alignas(16) int32_t edges[4];
+  _mm_store_si128(reinterpret_cast<__m128i*>(edges), min_edges);
+  return gfx::Rect::LTRB(edges[0], edges[1], -edges[2], -edges[3]);
+#elif defined(CC_RECT_BATCH_USE_NEON)
+  int32x4_t min_edges = vdupq_n_s32(std::numeric_limits<int32_t>::max());
+  bool has_rect = false;
+  for (const gfx::Rect& rect : rects) {
+    if (IsEmpty(rect)) {
+      continue;
+    }
+    min_edges = vminq_s32(min_edges, LoadNegatedEdges(rect));
+    has_rect = true;
+  }
+  if (!has_rect) {
+    return gfx::Rect();
+  }
+  int32_t edges[4];
+  vst1q_s32(edges, min_edges);
+  return gfx::Rect::LTRB(edges[0], edges[1], -edges[2], -edges[3]);
+#else
+  gfx::Rect bounds;
+  for (const gfx::Rect& rect : rects) {
+    bounds.Union(rect);
+  }
+  return bounds;
+#endif
+}
+
+size_t FindFirstRectNotContainedIn(base::span<const gfx::Rect> rects,
+                                   const gfx::Rect& container,
+                                   size_t start) {
+  if (container.IsEmpty()) {
+    for (size_t i = start; i < rects.size(); ++i) {
+      if (!rects[i].IsEmpty()) {
+        return i;
+      }
+    }
+    return rects.size();
+  }
+
+#if defined(CC_RECT_BATCH_USE_SSE2)
+  const __m128i container_edges = LoadNegatedEdges(container);
+  for (size_t i = start; i < rects.size(); ++i) {
+    if (IsEmpty(rects[i])) {
+      continue;
+    }
+    // Contained if no edge of the rect lies outside the container, i.e. no
+    // lane of the container is greater than the rect.
+    const __m128i outside =
+        _mm_cmpgt_epi32(container_edges, LoadNegatedEdges(rects[i]));
+    if (_mm_movemask_epi8(outside)) {
+      return i;
+    }
+  }
+  return rects.size();
+#elif defined(CC_RECT_BATCH_USE_NEON)
+  const int32x4_t container_edges = LoadNegatedEdges(container);
+  for (size_t i = start; i < rects.size(); ++i) {
+    if (IsEmpty(rects[i])) {
+      continue;
+    }
+    const uint32x4_t outside =
+        vcgtq_s32(container_edges, LoadNegatedEdges(rects[i]));
+    if (vmaxvq_u32(outside)) {
+      return i;
+    }
+  }
+  return rects.size();
+#else
+  for (size_t i = start; i < rects.size(); ++i) {
+    if (!rects[i].IsEmpty() && !container.Contains(rects[i])) {
+      return i;
+    }
+  }
+  return rects.size();
+#endif
+}
+
+}  // namespace cc
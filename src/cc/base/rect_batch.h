@@ -0,0 +1,34 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_BASE_RECT_BATCH_H_
+#define CC_BASE_RECT_BATCH_H_
+
+#include <stddef.h>
+
+#include "base/containers/span.h"
+#include "cc/base/base_export.h"
+#include "ui/gfx/geometry/rect.h"
+
+namespace cc {
+
+// Helpers for operating on many rects at once, used by the batch Union()
+// paths of Region, SimpleEnclosedRegion and InvalidationRegion. On x86 (SSE2)
+// and ARM64 (NEON) these process one rect per vector register; other
+// platforms use a scalar loop with the same results.
+
+// Returns the union of the bounds of all non-empty rects in |rects|.
+CC_BASE_EXPORT gfx::Rect ComputeRectBatchBounds(
+    base::span<const gfx::Rect> rects);
+
+// Returns the index of the first rect at or after |start| which is neither
+// empty nor contained in |container|, or |rects.size()| if there is none.
+CC_BASE_EXPORT size_t FindFirstRectNotContainedIn(
+    base::span<const gfx::Rect> rects,
+    const gfx::Rect& container,
+    size_t start = 0u);
+
+}  // namespace cc
+
+#endif  // CC_BASE_RECT_BATCH_H_
@@ -0,0 +1,65 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/base/rect_batch.h"
+
+#include <limits>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace cc {
+namespace {
+
+TEST(RectBatchTest, BoundsOfEmptyBatch) {
+  EXPECT_TRUE(ComputeRectBatchBounds(std::vector<gfx::Rect>()).IsEmpty());
+  std::vector<gfx::Rect> empty_rects = {gfx::Rect(), gfx::Rect(5, 5, 0, 3),
+                                        gfx::Rect(-5, -5, 3, 0)};
+  EXPECT_TRUE(ComputeRectBatchBounds(empty_rects).IsEmpty());
+}
+
+TEST(RectBatchTest, Bounds) {
+  std::vector<gfx::Rect> rects = {gfx::Rect(10, 10, 5, 5),
+                                  gfx::Rect(-3, 20, 2, 2),
+                                  gfx::Rect(100, 100, 0, 0),
+                                  gfx::Rect(7, -8, 1, 100)};
+  gfx::Rect expected;
+  for (const auto& rect : rects) {
+    expected.Union(rect);
+  }
+  EXPECT_EQ(expected, ComputeRectBatchBounds(rects));
+  EXPECT_EQ(gfx::Rect(-3, -8, 18, 100), ComputeRectBatchBounds(rects));
+}
+
+TEST(RectBatchTest, BoundsLargeCoordinates) {
+  constexpr int kMax = std::numeric_limits<int>::max();
+  std::vector<gfx::Rect> rects = {gfx::Rect(kMax - 10, kMax - 10, 10, 10),
+                                  gfx::Rect(-kMax, -kMax, 1, 1)};
+  gfx::Rect expected;
+  for (const auto& rect : rects) {
+    expected.Union(rect);
+  }
+  EXPECT_EQ(expected, ComputeRectBatchBounds(rects));
+}
+
+TEST(RectBatchTest, FindFirstRectNotContainedIn) {
+  gfx::Rect container(0, 0, 10, 10);
+  std::vector<gfx::Rect> rects = {
+      gfx::Rect(0, 0, 10, 10), gfx::Rect(20, 20, 0, 0), gfx::Rect(2, 2, 2, 2),
+      gfx::Rect(9, 9, 2, 1),   gfx::Rect(-1, 0, 1, 1),  gfx::Rect(5, 5, 1, 1)};
+  EXPECT_EQ(3u, FindFirstRectNotContainedIn(rects, container));
+  EXPECT_EQ(4u, FindFirstRectNotContainedIn(rects, container, 4));
+  EXPECT_EQ(rects.size(), FindFirstRectNotContainedIn(rects, container, 5));
+  EXPECT_EQ(rects.size(),
+            FindFirstRectNotContainedIn(rects, container, rects.size()));
+}
+
+TEST(RectBatchTest, FindFirstRectNotContainedInEmptyContainer) {
+  std::vector<gfx::Rect> rects = {gfx::Rect(), gfx::Rect(1, 1, 0, 1),
+                                  gfx::Rect(1, 1, 1, 1)};
+  EXPECT_EQ(2u, FindFirstRectNotContainedIn(rects, gfx::Rect()));
+}
+
+}  // namespace
+}  // namespace cc
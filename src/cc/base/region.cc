@@ -6,9 +6,11 @@
 
 #include <stddef.h>
 #include <utility>
+#include <vector>
 
 #include "base/no_destructor.h"
 #include "base/trace_event/traced_value.h"
+#include "cc/base/rect_batch.h"
 #include "cc/base/simple_enclosed_region.h"
 #include "ui/gfx/geometry/vector2d.h"
 
@@ -114,6 +116,44 @@ void Region::Union(const Region& region) {
   skregion_.op(region.skregion_, SkRegion::kUnion_Op);
 }
 
+void Region::Union(base::span<const gfx::Rect> rects) {
+  if (rects.empty()) {
+    return;
+  }
+
+  // Nothing to do if every rect is already covered.
+  if (skregion_.isRect()) {
+    gfx::Rect current = bounds();
+    if (FindFirstRectNotContainedIn(rects, current) == rects.size()) {
+      return;
+    }
+  }
+
+  // Unioning rects one at a time into an already complex region costs
+  // O(complexity) per rect. Merging pairwise keeps the intermediate regions
+  // small, so the total cost is closer to O(n log n).
+  std::vector<SkRegion> pending;
+  pending.reserve(rects.size());
+  for (const gfx::Rect& rect : rects) {
+    if (!rect.IsEmpty()) {
+      pending.emplace_back(gfx::RectToSkIRect(rect));
+    }
+  }
+  while (pending.size() > 1) {
+    size_t merged = 0;
+    for (size_t i = 0; i < pending.size(); i += 2) {
+      if (i + 1 < pending.size()) {
+        pending[i].op(pending[i + 1], SkRegion::kUnion_Op);
+      }
+      pending[merged++].swap(pending[i]);
+    }
+    pending.resize(merged);
+  }
+  if (!pending.empty()) {
+    skregion_.op(pending.front(), SkRegion::kUnion_Op);
+  }
+}
+
 void Region::Intersect(const gfx::Rect& rect) {
   skregion_.op(gfx::RectToSkIRect(rect), SkRegion::kIntersect_Op);
 }
@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 
+#include "base/containers/span.h"
 #include "cc/base/base_export.h"
 #include "third_party/skia/include/core/SkRegion.h"
 #include "ui/gfx/geometry/rect.h"
@@ -63,6 +64,10 @@ class CC_BASE_EXPORT Region {
   void Subtract(const SimpleEnclosedRegion& region);
   void Union(const gfx::Rect& rect);
   void Union(const Region& region);
+  // Equivalent to calling Union() with each rect in turn, but cheaper for
+  // large batches since the rects are merged pairwise before being merged
+  // into this region.
+  void Union(base::span<const gfx::Rect> rects);
   void Intersect(const gfx::Rect& rect);
   void Intersect(const Region& region);
 
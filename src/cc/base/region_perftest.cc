@@ -0,0 +1,165 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "base/timer/lap_timer.h"
+#include "cc/base/invalidation_region.h"
+#include "cc/base/region.h"
+#include "cc/base/simple_enclosed_region.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace cc {
+namespace {
+
+static const int kTimeLimitMillis = 2000;
+static const int kWarmupRuns = 5;
+static const int kTimeCheckInterval = 10;
+
+// Compares unioning many small invalidation-like rects one at a time with the
+// batch Union() paths.
+class RegionPerfTest : public testing::Test {
+ public:
+  RegionPerfTest()
+      : timer_(kWarmupRuns,
+               base::Milliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {}
+
+  void RunRegionUnionTest(const std::string& test_name, int rect_count) {
+    std::vector<gfx::Rect> rects = BuildRects(rect_count);
+
+    timer_.Reset();
+    do {
+      Region region;
+      for (const auto& rect : rects) {
+        region.Union(rect);
+      }
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+    SetUpReporter(test_name).AddResult("_region_union", timer_.LapsPerSecond());
+
+    timer_.Reset();
+    do {
+      Region region;
+      region.Union(rects);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+    SetUpReporter(test_name).AddResult("_region_union_batch",
+                                       timer_.LapsPerSecond());
+  }
+
+  void RunSimpleEnclosedRegionUnionTest(const std::string& test_name,
+                                        int rect_count) {
+    std::vector<gfx::Rect> rects = BuildRects(rect_count);
+    // Most rects fall inside an existing occluder, as during occlusion
+    // tracking of a large opaque layer.
+    const gfx::Rect occluder(0, 0, 1000, 1000);
+
+    timer_.Reset();
+    do {
+      SimpleEnclosedRegion region(occluder);
+      for (const auto& rect : rects) {
+        region.Union(rect);
+      }
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+    SetUpReporter(test_name).AddResult("_simple_enclosed_region_union",
+                                       timer_.LapsPerSecond());
+
+    timer_.Reset();
+    do {
+      SimpleEnclosedRegion region(occluder);
+      region.Union(rects);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+    SetUpReporter(test_name).AddResult("_simple_enclosed_region_union_batch",
+                                       timer_.LapsPerSecond());
+  }
+
+  void RunInvalidationRegionTest(const std::string& test_name,
+                                 int rect_count) {
+    std::vector<gfx::Rect> rects = BuildRects(rect_count);
+
+    timer_.Reset();
+    do {
+      InvalidationRegion invalidation;
+      for (const auto& rect : rects) {
+        invalidation.Union(rect);
+      }
+      Region region;
+      invalidation.Swap(&region);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+    SetUpReporter(test_name).AddResult("_invalidation_region",
+                                       timer_.LapsPerSecond());
+
+    timer_.Reset();
+    do {
+      InvalidationRegion invalidation;
+      invalidation.Union(rects);
+      Region region;
+      invalidation.Swap(&region);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+    SetUpReporter(test_name).AddResult("_invalidation_region_batch",
+                                       timer_.LapsPerSecond());
+  }
+
+ private:
+  // Small, non-overlapping rects on a grid with gaps, which keeps the
+  // resulting region complex.
+  std::vector<gfx::Rect> BuildRects(int count) {
+    std::vector<gfx::Rect> result;
+    int width = std::sqrt(count);
+    int x = 0;
+    int y = 0;
+    for (int i = 0; i < count; ++i) {
+      result.push_back(gfx::Rect(x * 3, y * 3, 2, 2));
+      if (++x > width) {
+        x = 0;
+        ++y;
+      }
+    }
+    return result;
+  }
+
+  perf_test::PerfResultReporter SetUpReporter(const std::string& story_name) {
+    perf_test::PerfResultReporter reporter("region", story_name);
+    reporter.RegisterImportantMetric("_region_union", "runs/s");
+    reporter.RegisterImportantMetric("_region_union_batch", "runs/s");
+    reporter.RegisterImportantMetric("_simple_enclosed_region_union",
+                                     "runs/s");
+    reporter.RegisterImportantMetric("_simple_enclosed_region_union_batch",
+                                     "runs/s");
+    reporter.RegisterImportantMetric("_invalidation_region", "runs/s");
+    reporter.RegisterImportantMetric("_invalidation_region_batch", "runs/s");
+    return reporter;
+  }
+
+  base::LapTimer timer_;
+};
+
+TEST_F(RegionPerfTest, RegionUnion) {
+  RunRegionUnionTest("100", 100);
+  RunRegionUnionTest("1000", 1000);
+  RunRegionUnionTest("5000", 5000);
+}
+
+TEST_F(RegionPerfTest, SimpleEnclosedRegionUnion) {
+  RunSimpleEnclosedRegionUnionTest("100", 100);
+  RunSimpleEnclosedRegionUnionTest("1000", 1000);
+  RunSimpleEnclosedRegionUnionTest("10000", 10000);
+}
+
+TEST_F(RegionPerfTest, InvalidationRegion) {
+  RunInvalidationRegionTest("100", 100);
+  RunInvalidationRegionTest("256", 256);
+  RunInvalidationRegionTest("1000", 1000);
+}
+
+}  // namespace
+}  // namespace cc
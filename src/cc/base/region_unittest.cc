@@ -4,6 +4,8 @@
 
 #include "cc/base/region.h"
 
+#include <vector>
+
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace cc {
@@ -450,5 +452,47 @@ TEST(RegionSwap, Swap) {
   EXPECT_EQ(r2.ToString(), r3.ToString());
 }
 
+TEST(RegionTest, UnionBatchMatchesSequentialUnion) {
+  std::vector<gfx::Rect> rects;
+  for (int i = 0; i < 37; ++i) {
+    rects.emplace_back((i * 7) % 50, (i * 13) % 40, i % 5 + 1, i % 3 + 1);
+  }
+  // Empty rects must be ignored.
+  rects.emplace_back(10, 10, 0, 5);
+  rects.emplace_back(200, 200, 5, 0);
+
+  Region sequential(gfx::Rect(20, 20, 30, 30));
+  for (const auto& rect : rects) {
+    sequential.Union(rect);
+  }
+
+  Region batch(gfx::Rect(20, 20, 30, 30));
+  batch.Union(rects);
+  EXPECT_EQ(sequential, batch);
+}
+
+TEST(RegionTest, UnionBatchContainedRects) {
+  Region r(gfx::Rect(0, 0, 100, 100));
+  std::vector<gfx::Rect> rects = {gfx::Rect(0, 0, 100, 100),
+                                  gfx::Rect(10, 10, 5, 5),
+                                  gfx::Rect(99, 99, 1, 1)};
+  r.Union(rects);
+  EXPECT_EQ(Region(gfx::Rect(0, 0, 100, 100)), r);
+
+  rects.emplace_back(99, 99, 2, 1);
+  r.Union(rects);
+  Region expected(gfx::Rect(0, 0, 100, 100));
+  expected.Union(gfx::Rect(99, 99, 2, 1));
+  EXPECT_EQ(expected, r);
+}
+
+TEST(RegionTest, UnionBatchEmpty) {
+  Region r;
+  r.Union(std::vector<gfx::Rect>());
+  EXPECT_TRUE(r.IsEmpty());
+  r.Union(std::vector<gfx::Rect>{gfx::Rect(), gfx::Rect(5, 5, 0, 0)});
+  EXPECT_TRUE(r.IsEmpty());
+}
+
 }  // namespace
 }  // namespace cc
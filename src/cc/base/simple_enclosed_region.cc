@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include "base/check_op.h"
+#include "cc/base/rect_batch.h"
 #include "cc/base/region.h"
 #include "ui/gfx/geometry/rect.h"
 
@@ -143,6 +144,16 @@ void SimpleEnclosedRegion::Union(const gfx::Rect& new_rect) {
     rect_ = adjusted_new_rect;
 }
 
+void SimpleEnclosedRegion::Union(base::span<const gfx::Rect> new_rects) {
+  // The result depends on the order of the rects, so they are still added one
+  // at a time; only the rects which would be no-ops are skipped in bulk.
+  size_t i = FindFirstRectNotContainedIn(new_rects, rect_);
+  while (i < new_rects.size()) {
+    Union(new_rects[i]);
+    i = FindFirstRectNotContainedIn(new_rects, rect_, i + 1);
+  }
+}
+
 gfx::Rect SimpleEnclosedRegion::GetRect(size_t i) const {
   DCHECK_LT(i, GetRegionComplexity());
   return rect_;
@@ -9,6 +9,7 @@
 
 #include <string>
 
+#include "base/containers/span.h"
 #include "cc/base/base_export.h"
 #include "ui/gfx/geometry/rect.h"
 
@@ -64,6 +65,9 @@ class CC_BASE_EXPORT SimpleEnclosedRegion {
   void Union(const SimpleEnclosedRegion& new_region) {
     Union(new_region.rect_);
   }
+  // Equivalent to calling Union() with each rect in turn. Runs of rects that
+  // are already contained in the region are skipped in bulk.
+  void Union(base::span<const gfx::Rect> new_rects);
   void Intersect(const gfx::Rect& in_rect) { return rect_.Intersect(in_rect); }
   void Intersect(const SimpleEnclosedRegion& in_region) {
     Intersect(in_region.rect_);
@@ -315,6 +315,26 @@ TEST(SimpleEnclosedRegionTest, GetRect) {
   EXPECT_EQ(gfx::Rect(1, 2, 12, 13), r.GetRect(0));
 }
 
+TEST(SimpleEnclosedRegionTest, UnionBatchMatchesSequentialUnion) {
+  std::vector<gfx::Rect> rects;
+  for (int i = 0; i < 50; ++i) {
+    rects.emplace_back((i * 11) % 60, (i * 17) % 45, i % 9 + 1, i % 7 + 1);
+  }
+  rects.emplace_back(0, 0, 0, 0);
+  rects.emplace_back(-20, -20, 100, 100);
+  rects.emplace_back(5, 5, 10, 10);
+  rects.emplace_back(80, -20, 30, 100);
+
+  SimpleEnclosedRegion sequential;
+  for (const auto& rect : rects) {
+    sequential.Union(rect);
+  }
+
+  SimpleEnclosedRegion batch;
+  batch.Union(rects);
+  EXPECT_EQ(sequential, batch);
+}
+
 TEST(SimpleEnclosedRegionTest, Union) {
   SimpleEnclosedRegion r;
   EXPECT_TRUE(ExpectRegionEq(gfx::Rect(), r));
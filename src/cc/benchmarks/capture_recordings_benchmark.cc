@@ -0,0 +1,76 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/benchmarks/capture_recordings_benchmark.h"
+
+#include <string>
+#include <utility>
+
+#include "cc/debug/picture_debug_util.h"
+#include "cc/layers/content_layer_client.h"
+#include "cc/layers/layer.h"
+#include "cc/layers/picture_layer.h"
+#include "cc/paint/display_item_list.h"
+#include "cc/trees/layer_tree_host.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/skia_conversions.h"
+
+namespace cc {
+
+CaptureRecordingsBenchmark::CaptureRecordingsBenchmark(
+    base::Value::Dict settings,
+    DoneCallback callback)
+    : MicroBenchmark(std::move(callback)) {}
+
+CaptureRecordingsBenchmark::~CaptureRecordingsBenchmark() = default;
+
+void CaptureRecordingsBenchmark::DidUpdateLayers(
+    LayerTreeHost* layer_tree_host) {
+  for (auto* layer : *layer_tree_host)
+    layer->RunMicroBenchmark(this);
+
+  base::Value::Dict result;
+  result.Set("layers", std::move(layers_));
+  NotifyDone(std::move(result));
+}
+
+void CaptureRecordingsBenchmark::RunOnLayer(PictureLayer* layer) {
+  if (!layer->draws_content())
+    return;
+
+  scoped_refptr<DisplayItemList> display_list =
+      layer->client()->PaintContentsToDisplayList();
+  gfx::Rect bounds =
+      display_list->bounds().value_or(gfx::Rect(layer->bounds()));
+  if (bounds.IsEmpty())
+    return;
+
+  // Record through PaintOp playback rather than serializing the PaintOps, so
+  // that lazily generated images are decoded and embedded in the SKP, and the
+  // capture can be replayed without the transfer cache.
+  SkPictureRecorder recorder;
+  SkCanvas* canvas = recorder.beginRecording(gfx::RectToSkRect(bounds));
+  canvas->translate(-bounds.x(), -bounds.y());
+  canvas->clipRect(gfx::RectToSkRect(bounds));
+  display_list->Raster(canvas);
+  sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+  std::string b64_picture;
+  PictureDebugUtil::SerializeAsBase64(picture.get(), &b64_picture);
+
+  base::Value::Dict entry;
+  entry.Set("layer_id", layer->id());
+  entry.Set("layer_rect", base::Value::List()
+                              .Append(bounds.x())
+                              .Append(bounds.y())
+                              .Append(bounds.width())
+                              .Append(bounds.height()));
+  entry.Set("skp64", std::move(b64_picture));
+  layers_.Append(std::move(entry));
+}
+
+}  // namespace cc
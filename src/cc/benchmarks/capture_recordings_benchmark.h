@@ -0,0 +1,37 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_BENCHMARKS_CAPTURE_RECORDINGS_BENCHMARK_H_
+#define CC_BENCHMARKS_CAPTURE_RECORDINGS_BENCHMARK_H_
+
+#include "base/values.h"
+#include "cc/benchmarks/micro_benchmark.h"
+
+namespace cc {
+
+class LayerTreeHost;
+class PictureLayer;
+
+// Captures the recording of every picture layer that draws content, so that
+// raster can be replayed and compared offline. Each recording is returned as
+// a base64 SkPicture (SKP) with its images encoded inline, along with the
+// layer's id and the rect it covers:
+//   {"layers": [{"layer_id": 5, "layer_rect": [x, y, w, h], "skp64": "..."}]}
+class CC_EXPORT CaptureRecordingsBenchmark : public MicroBenchmark {
+ public:
+  CaptureRecordingsBenchmark(base::Value::Dict settings,
+                             DoneCallback callback);
+  ~CaptureRecordingsBenchmark() override;
+
+  // MicroBenchmark:
+  void DidUpdateLayers(LayerTreeHost* layer_tree_host) override;
+  void RunOnLayer(PictureLayer* layer) override;
+
+ private:
+  base::Value::List layers_;
+};
+
+}  // namespace cc
+
+#endif  // CC_BENCHMARKS_CAPTURE_RECORDINGS_BENCHMARK_H_
@@ -12,7 +12,9 @@
 #include "base/ranges/algorithm.h"
 #include "base/task/single_thread_task_runner.h"
 #include "base/values.h"
+#include "cc/benchmarks/capture_recordings_benchmark.h"
 #include "cc/benchmarks/invalidation_benchmark.h"
+#include "cc/benchmarks/raster_pipeline_benchmark.h"
 #include "cc/benchmarks/rasterize_and_record_benchmark.h"
 #include "cc/benchmarks/unittest_only_benchmark.h"
 #include "cc/trees/layer_tree_host.h"
@@ -28,12 +30,18 @@ std::unique_ptr<MicroBenchmark> CreateBenchmark(
     const std::string& name,
     base::Value::Dict settings,
     MicroBenchmark::DoneCallback callback) {
-  if (name == "invalidation_benchmark") {
+  if (name == "capture_recordings_benchmark") {
+    return std::make_unique<CaptureRecordingsBenchmark>(std::move(settings),
+                                                        std::move(callback));
+  } else if (name == "invalidation_benchmark") {
     return std::make_unique<InvalidationBenchmark>(std::move(settings),
                                                    std::move(callback));
   } else if (name == "rasterize_and_record_benchmark") {
     return std::make_unique<RasterizeAndRecordBenchmark>(std::move(settings),
                                                          std::move(callback));
+  } else if (name == "raster_pipeline_benchmark") {
+    return std::make_unique<RasterPipelineBenchmark>(std::move(settings),
+                                                     std::move(callback));
   } else if (name == "unittest_only_benchmark") {
     return std::make_unique<UnittestOnlyBenchmark>(std::move(settings),
                                                    std::move(callback));
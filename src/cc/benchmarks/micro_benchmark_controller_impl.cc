@@ -36,6 +36,37 @@ void MicroBenchmarkControllerImpl::DidCompleteCommit() {
   CleanUpFinishedBenchmarks();
 }
 
+void MicroBenchmarkControllerImpl::WillPrepareTiles() {
+  for (const auto& benchmark : benchmarks_)
+    benchmark->WillPrepareTiles(host_);
+}
+
+void MicroBenchmarkControllerImpl::DidPrepareTiles() {
+  for (const auto& benchmark : benchmarks_)
+    benchmark->DidPrepareTiles(host_);
+
+  CleanUpFinishedBenchmarks();
+}
+
+void MicroBenchmarkControllerImpl::DidNotifyReadyToActivate() {
+  for (const auto& benchmark : benchmarks_)
+    benchmark->DidNotifyReadyToActivate(host_);
+
+  CleanUpFinishedBenchmarks();
+}
+
+void MicroBenchmarkControllerImpl::WillActivateSyncTree() {
+  for (const auto& benchmark : benchmarks_)
+    benchmark->WillActivateSyncTree(host_);
+}
+
+void MicroBenchmarkControllerImpl::DidActivateSyncTree() {
+  for (const auto& benchmark : benchmarks_)
+    benchmark->DidActivateSyncTree(host_);
+
+  CleanUpFinishedBenchmarks();
+}
+
 void MicroBenchmarkControllerImpl::CleanUpFinishedBenchmarks() {
   std::erase_if(benchmarks_,
                 [](const std::unique_ptr<MicroBenchmarkImpl>& benchmark) {
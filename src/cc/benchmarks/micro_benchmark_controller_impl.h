@@ -25,6 +25,11 @@ class CC_EXPORT MicroBenchmarkControllerImpl {
       delete;
 
   void DidCompleteCommit();
+  void WillPrepareTiles();
+  void DidPrepareTiles();
+  void DidNotifyReadyToActivate();
+  void WillActivateSyncTree();
+  void DidActivateSyncTree();
 
   void ScheduleRun(std::unique_ptr<MicroBenchmarkImpl> benchmark);
 
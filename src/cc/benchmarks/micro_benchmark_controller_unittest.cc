@@ -4,23 +4,34 @@
 
 #include "cc/benchmarks/micro_benchmark_controller.h"
 
+#include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "base/base64.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback.h"
 #include "base/functional/callback_helpers.h"
 #include "base/memory/ptr_util.h"
 #include "base/run_loop.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/test/bind.h"
 #include "cc/animation/animation_host.h"
 #include "cc/benchmarks/micro_benchmark.h"
 #include "cc/layers/layer.h"
+#include "cc/paint/paint_flags.h"
+#include "cc/test/fake_content_layer_client.h"
 #include "cc/test/fake_impl_task_runner_provider.h"
 #include "cc/test/fake_layer_tree_host.h"
 #include "cc/test/fake_layer_tree_host_impl.h"
+#include "cc/test/fake_picture_layer.h"
 #include "cc/test/fake_proxy.h"
 #include "cc/test/test_task_graph_runner.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkPicture.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/size.h"
 
 namespace cc {
 namespace {
@@ -144,6 +155,64 @@ TEST_F(MicroBenchmarkControllerTest, BenchmarkImplRan) {
   EXPECT_EQ(1, run_count);
 }
 
+TEST_F(MicroBenchmarkControllerTest, RasterPipelineBenchmarkRan) {
+  std::optional<base::Value::Dict> results;
+  int id = layer_tree_host_->ScheduleMicroBenchmark(
+      "raster_pipeline_benchmark", base::Value::Dict(),
+      base::BindLambdaForTesting(
+          [&](base::Value::Dict value) { results = std::move(value); }));
+  EXPECT_GT(id, 0);
+
+  layer_tree_host_impl_->CreatePendingTree();
+  for (auto& benchmark : layer_tree_host_->GetMicroBenchmarkController()
+                             ->CreateImplBenchmarks()) {
+    layer_tree_host_impl_->ScheduleMicroBenchmark(std::move(benchmark));
+  }
+  layer_tree_host_impl_->CommitComplete();
+  layer_tree_host_impl_->NotifyReadyToActivate();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(results);
+
+  layer_tree_host_impl_->ActivateSyncTree();
+  base::RunLoop().RunUntilIdle();
+  ASSERT_TRUE(results);
+  EXPECT_TRUE(results->FindDouble("raster_time_ms"));
+  EXPECT_TRUE(results->FindDouble("activation_time_ms"));
+  EXPECT_TRUE(results->FindDouble("tile_memory_bytes"));
+  EXPECT_FALSE(results->Find("error"));
+}
+
+TEST_F(MicroBenchmarkControllerTest, CaptureRecordingsBenchmarkRan) {
+  FakeContentLayerClient client;
+  client.set_bounds(gfx::Size(100, 50));
+  client.add_draw_rect(gfx::Rect(10, 10, 20, 20), PaintFlags());
+  scoped_refptr<FakePictureLayer> layer = FakePictureLayer::Create(&client);
+  layer->SetBounds(gfx::Size(100, 50));
+  layer->SetIsDrawable(true);
+  layer_tree_host_->root_layer()->AddChild(layer);
+
+  std::optional<base::Value::Dict> results;
+  int id = layer_tree_host_->ScheduleMicroBenchmark(
+      "capture_recordings_benchmark", base::Value::Dict(),
+      base::BindLambdaForTesting(
+          [&](base::Value::Dict value) { results = std::move(value); }));
+  EXPECT_GT(id, 0);
+
+  layer_tree_host_->UpdateLayers();
+  ASSERT_TRUE(results);
+  const base::Value::List* layers = results->FindList("layers");
+  ASSERT_TRUE(layers);
+  ASSERT_EQ(1u, layers->size());
+  const base::Value::Dict& entry = (*layers)[0].GetDict();
+  EXPECT_EQ(layer->id(), entry.FindInt("layer_id"));
+
+  const std::string* skp64 = entry.FindString("skp64");
+  ASSERT_TRUE(skp64);
+  std::optional<std::vector<uint8_t>> skp = base::Base64Decode(*skp64);
+  ASSERT_TRUE(skp);
+  EXPECT_TRUE(SkPicture::MakeFromData(skp->data(), skp->size()));
+}
+
 TEST_F(MicroBenchmarkControllerTest, SendMessage) {
   // Send valid message to invalid benchmark (id = 0)
   base::Value::Dict message;
@@ -29,6 +29,16 @@ bool MicroBenchmarkImpl::IsDone() const {
 
 void MicroBenchmarkImpl::DidCompleteCommit(LayerTreeHostImpl* host) {}
 
+void MicroBenchmarkImpl::WillPrepareTiles(LayerTreeHostImpl* host) {}
+
+void MicroBenchmarkImpl::DidPrepareTiles(LayerTreeHostImpl* host) {}
+
+void MicroBenchmarkImpl::DidNotifyReadyToActivate(LayerTreeHostImpl* host) {}
+
+void MicroBenchmarkImpl::WillActivateSyncTree(LayerTreeHostImpl* host) {}
+
+void MicroBenchmarkImpl::DidActivateSyncTree(LayerTreeHostImpl* host) {}
+
 void MicroBenchmarkImpl::NotifyDone(base::Value::Dict result) {
   origin_task_runner_->PostTask(
       FROM_HERE, base::BindOnce(std::move(callback_), std::move(result)));
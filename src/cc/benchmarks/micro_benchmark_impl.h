@@ -31,6 +31,14 @@ class CC_EXPORT MicroBenchmarkImpl {
   bool IsDone() const;
   virtual void DidCompleteCommit(LayerTreeHostImpl* host);
 
+  // Called around the stages that follow a commit to the pending tree, so that
+  // benchmarks can time the raster pipeline end to end.
+  virtual void WillPrepareTiles(LayerTreeHostImpl* host);
+  virtual void DidPrepareTiles(LayerTreeHostImpl* host);
+  virtual void DidNotifyReadyToActivate(LayerTreeHostImpl* host);
+  virtual void WillActivateSyncTree(LayerTreeHostImpl* host);
+  virtual void DidActivateSyncTree(LayerTreeHostImpl* host);
+
   virtual void RunOnLayer(LayerImpl* layer);
   virtual void RunOnLayer(PictureLayerImpl* layer);
 
@@ -0,0 +1,35 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/benchmarks/raster_pipeline_benchmark.h"
+
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "cc/benchmarks/raster_pipeline_benchmark_impl.h"
+
+namespace cc {
+
+RasterPipelineBenchmark::RasterPipelineBenchmark(base::Value::Dict settings,
+                                                 DoneCallback callback)
+    : MicroBenchmark(std::move(callback)) {}
+
+RasterPipelineBenchmark::~RasterPipelineBenchmark() {
+  weak_ptr_factory_.InvalidateWeakPtrs();
+}
+
+void RasterPipelineBenchmark::RecordImplResults(base::Value::Dict results) {
+  NotifyDone(std::move(results));
+}
+
+std::unique_ptr<MicroBenchmarkImpl>
+RasterPipelineBenchmark::CreateBenchmarkImpl(
+    scoped_refptr<base::SingleThreadTaskRunner> origin_task_runner) {
+  return std::make_unique<RasterPipelineBenchmarkImpl>(
+      origin_task_runner,
+      base::BindOnce(&RasterPipelineBenchmark::RecordImplResults,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+}  // namespace cc
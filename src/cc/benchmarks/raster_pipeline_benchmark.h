@@ -0,0 +1,38 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_BENCHMARKS_RASTER_PIPELINE_BENCHMARK_H_
+#define CC_BENCHMARKS_RASTER_PIPELINE_BENCHMARK_H_
+
+#include <memory>
+
+#include "base/memory/weak_ptr.h"
+#include "base/task/single_thread_task_runner.h"
+#include "base/values.h"
+#include "cc/benchmarks/micro_benchmark.h"
+
+namespace cc {
+
+// Times one full PrepareTiles -> raster -> activation cycle of the commit that
+// follows scheduling the benchmark, as it happens in the compositor rather
+// than by rastering on the side. Results are reported by
+// RasterPipelineBenchmarkImpl.
+class CC_EXPORT RasterPipelineBenchmark : public MicroBenchmark {
+ public:
+  RasterPipelineBenchmark(base::Value::Dict settings, DoneCallback callback);
+  ~RasterPipelineBenchmark() override;
+
+ protected:
+  std::unique_ptr<MicroBenchmarkImpl> CreateBenchmarkImpl(
+      scoped_refptr<base::SingleThreadTaskRunner> origin_task_runner) override;
+
+ private:
+  void RecordImplResults(base::Value::Dict results);
+
+  base::WeakPtrFactory<RasterPipelineBenchmark> weak_ptr_factory_{this};
+};
+
+}  // namespace cc
+
+#endif  // CC_BENCHMARKS_RASTER_PIPELINE_BENCHMARK_H_
@@ -0,0 +1,113 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/benchmarks/raster_pipeline_benchmark_impl.h"
+
+#include <utility>
+
+#include "base/task/single_thread_task_runner.h"
+#include "base/values.h"
+#include "cc/resources/resource_pool.h"
+#include "cc/trees/layer_tree_host_impl.h"
+
+namespace cc {
+
+// static
+RasterPipelineBenchmarkImpl::Timestamp
+RasterPipelineBenchmarkImpl::Timestamp::Now() {
+  return {base::TimeTicks::Now(), base::ThreadTicks::IsSupported()
+                                      ? base::ThreadTicks::Now()
+                                      : base::ThreadTicks()};
+}
+
+RasterPipelineBenchmarkImpl::RasterPipelineBenchmarkImpl(
+    scoped_refptr<base::SingleThreadTaskRunner> origin_task_runner,
+    DoneCallback callback)
+    : MicroBenchmarkImpl(std::move(callback), origin_task_runner) {}
+
+RasterPipelineBenchmarkImpl::~RasterPipelineBenchmarkImpl() = default;
+
+void RasterPipelineBenchmarkImpl::DidCompleteCommit(LayerTreeHostImpl* host) {
+  if (stage_ != Stage::kWaitingForCommit)
+    return;
+
+  // Without a pending tree there is no activation to wait for, and tiles are
+  // rastered straight for the active tree.
+  if (!host->pending_tree()) {
+    base::Value::Dict result;
+    result.Set("error", "Commits go straight to the active tree.");
+    NotifyDone(std::move(result));
+    return;
+  }
+
+  commit_time_ = Timestamp::Now();
+  stage_ = Stage::kRastering;
+}
+
+void RasterPipelineBenchmarkImpl::WillPrepareTiles(LayerTreeHostImpl* host) {
+  if (stage_ != Stage::kRastering)
+    return;
+  prepare_tiles_start_ = Timestamp::Now();
+}
+
+void RasterPipelineBenchmarkImpl::DidPrepareTiles(LayerTreeHostImpl* host) {
+  if (stage_ != Stage::kRastering)
+    return;
+
+  Timestamp now = Timestamp::Now();
+  prepare_tiles_time_ += now.wall - prepare_tiles_start_.wall;
+  prepare_tiles_cpu_time_ += now.thread - prepare_tiles_start_.thread;
+  if (prepare_tiles_count_++ == 0)
+    raster_start_ = now.wall;
+}
+
+void RasterPipelineBenchmarkImpl::DidNotifyReadyToActivate(
+    LayerTreeHostImpl* host) {
+  if (stage_ != Stage::kRastering)
+    return;
+
+  // The tree can be ready to activate without PrepareTiles having run at all,
+  // if there was nothing that needed raster.
+  if (prepare_tiles_count_ > 0)
+    raster_time_ = base::TimeTicks::Now() - raster_start_;
+
+  if (ResourcePool* resource_pool = host->resource_pool()) {
+    tile_memory_bytes_ = resource_pool->memory_usage_bytes();
+    tile_resource_count_ = resource_pool->resource_count();
+  }
+  stage_ = Stage::kWaitingForActivation;
+}
+
+void RasterPipelineBenchmarkImpl::WillActivateSyncTree(
+    LayerTreeHostImpl* host) {
+  if (stage_ != Stage::kWaitingForActivation)
+    return;
+  activation_start_ = Timestamp::Now();
+  stage_ = Stage::kActivating;
+}
+
+void RasterPipelineBenchmarkImpl::DidActivateSyncTree(LayerTreeHostImpl* host) {
+  if (stage_ != Stage::kActivating)
+    return;
+
+  Timestamp now = Timestamp::Now();
+  base::Value::Dict result;
+  result.Set("prepare_tiles_count", prepare_tiles_count_);
+  result.Set("prepare_tiles_time_ms", prepare_tiles_time_.InMillisecondsF());
+  result.Set("raster_time_ms", raster_time_.InMillisecondsF());
+  result.Set("activation_time_ms",
+             (now.wall - activation_start_.wall).InMillisecondsF());
+  result.Set("total_time_ms", (now.wall - commit_time_.wall).InMillisecondsF());
+  if (base::ThreadTicks::IsSupported()) {
+    result.Set("prepare_tiles_cpu_time_ms",
+               prepare_tiles_cpu_time_.InMillisecondsF());
+    result.Set("activation_cpu_time_ms",
+               (now.thread - activation_start_.thread).InMillisecondsF());
+  }
+  result.Set("tile_memory_bytes", static_cast<double>(tile_memory_bytes_));
+  result.Set("tile_resource_count", static_cast<int>(tile_resource_count_));
+  NotifyDone(std::move(result));
+}
+
+}  // namespace cc
@@ -0,0 +1,81 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_BENCHMARKS_RASTER_PIPELINE_BENCHMARK_IMPL_H_
+#define CC_BENCHMARKS_RASTER_PIPELINE_BENCHMARK_IMPL_H_
+
+#include <stddef.h>
+
+#include "base/memory/scoped_refptr.h"
+#include "base/time/time.h"
+#include "cc/benchmarks/micro_benchmark_impl.h"
+
+namespace base {
+class SingleThreadTaskRunner;
+}  // namespace base
+
+namespace cc {
+
+class LayerTreeHostImpl;
+
+// Follows the first commit to the pending tree through PrepareTiles, raster
+// and activation, and reports how long each stage took along with the tile
+// memory in use once the tree is ready to activate.
+//
+// Raster runs on worker threads (and, with GPU raster, in the GPU process), so
+// it is reported as the wall time from the end of the first PrepareTiles to
+// ready-to-activate. PrepareTiles and activation run on the compositor thread
+// and also report thread CPU time where the platform supports it.
+class CC_EXPORT RasterPipelineBenchmarkImpl : public MicroBenchmarkImpl {
+ public:
+  RasterPipelineBenchmarkImpl(
+      scoped_refptr<base::SingleThreadTaskRunner> origin_task_runner,
+      DoneCallback callback);
+  ~RasterPipelineBenchmarkImpl() override;
+
+  // MicroBenchmarkImpl:
+  void DidCompleteCommit(LayerTreeHostImpl* host) override;
+  void WillPrepareTiles(LayerTreeHostImpl* host) override;
+  void DidPrepareTiles(LayerTreeHostImpl* host) override;
+  void DidNotifyReadyToActivate(LayerTreeHostImpl* host) override;
+  void WillActivateSyncTree(LayerTreeHostImpl* host) override;
+  void DidActivateSyncTree(LayerTreeHostImpl* host) override;
+
+ private:
+  enum class Stage {
+    kWaitingForCommit,
+    kRastering,
+    kWaitingForActivation,
+    kActivating,
+  };
+
+  // A point in both wall and compositor thread CPU time.
+  struct Timestamp {
+    static Timestamp Now();
+
+    base::TimeTicks wall;
+    base::ThreadTicks thread;
+  };
+
+  Stage stage_ = Stage::kWaitingForCommit;
+
+  Timestamp commit_time_;
+  Timestamp prepare_tiles_start_;
+  Timestamp activation_start_;
+
+  // Only the first PrepareTiles after the commit starts raster, but the
+  // scheduler may prepare tiles again before the tree is ready to activate.
+  int prepare_tiles_count_ = 0;
+  base::TimeDelta prepare_tiles_time_;
+  base::TimeDelta prepare_tiles_cpu_time_;
+  base::TimeTicks raster_start_;
+  base::TimeDelta raster_time_;
+
+  size_t tile_memory_bytes_ = 0;
+  size_t tile_resource_count_ = 0;
+};
+
+}  // namespace cc
+
+#endif  // CC_BENCHMARKS_RASTER_PIPELINE_BENCHMARK_IMPL_H_
@@ -43,7 +43,8 @@ RenderingStats::RenderingStats()
       approximated_visible_content_area(0),
       checkerboarded_visible_content_area(0),
       checkerboarded_no_recording_content_area(0),
-      checkerboarded_needs_raster_content_area(0) {}
+      checkerboarded_needs_raster_content_area(0),
+      tiles_skipped_due_to_occlusion(0) {}
 
 RenderingStats::RenderingStats(const RenderingStats& other) = default;
 
@@ -63,6 +64,8 @@ RenderingStats::AsTraceableData() const {
                           checkerboarded_no_recording_content_area);
   record_data->SetInteger("checkerboarded_needs_raster_content_area",
                           checkerboarded_needs_raster_content_area);
+  record_data->SetInteger("tiles_skipped_due_to_occlusion",
+                          tiles_skipped_due_to_occlusion);
   draw_duration.AddToTracedValue("draw_duration_ms", record_data.get());
 
   draw_duration_estimate.AddToTracedValue("draw_duration_estimate_ms",
@@ -46,6 +46,9 @@ struct CC_DEBUG_EXPORT RenderingStats {
   int64_t checkerboarded_visible_content_area;
   int64_t checkerboarded_no_recording_content_area;
   int64_t checkerboarded_needs_raster_content_area;
+  // Tiles that needed raster but were not rastered because they were occluded,
+  // summed over every PrepareTiles.
+  int64_t tiles_skipped_due_to_occlusion;
 
   TimeDeltaList draw_duration;
   TimeDeltaList draw_duration_estimate;
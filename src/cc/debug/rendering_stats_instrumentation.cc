@@ -81,6 +81,15 @@ void RenderingStatsInstrumentation::AddCheckerboardedNeedsRasterContentArea(
   impl_thread_rendering_stats_.checkerboarded_needs_raster_content_area += area;
 }
 
+void RenderingStatsInstrumentation::AddTilesSkippedDueToOcclusion(
+    int64_t count) {
+  if (!record_rendering_stats_)
+    return;
+
+  base::AutoLock scoped_lock(lock_);
+  impl_thread_rendering_stats_.tiles_skipped_due_to_occlusion += count;
+}
+
 void RenderingStatsInstrumentation::AddDrawDuration(
     base::TimeDelta draw_duration,
     base::TimeDelta draw_duration_estimate) {
@@ -44,6 +44,7 @@ class CC_DEBUG_EXPORT RenderingStatsInstrumentation {
   void AddCheckerboardedVisibleContentArea(int64_t area);
   void AddCheckerboardedNoRecordingContentArea(int64_t area);
   void AddCheckerboardedNeedsRasterContentArea(int64_t area);
+  void AddTilesSkippedDueToOcclusion(int64_t count);
   void AddDrawDuration(base::TimeDelta draw_duration,
                        base::TimeDelta draw_duration_estimate);
   void AddBeginMainFrameToCommitDuration(
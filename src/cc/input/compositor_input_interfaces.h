@@ -18,6 +18,7 @@ struct BeginFrameArgs;
 }
 
 namespace gfx {
+class PointF;
 class Vector2dF;
 }
 
@@ -131,6 +132,11 @@ class CompositorDelegateForInput {
   virtual bool IsInHighLatencyMode() const = 0;
   virtual void WillScrollContent(ElementId element_id) = 0;
   virtual void DidScrollContent(ElementId element_id, bool animated) = 0;
+  // Called with the scroll offset at which the fling of the scroller
+  // `element_id` is predicted to end, so that the tiles along the way can be
+  // prioritized, and with a null `element_id` once the fling is over.
+  virtual void SetPredictedFlingEnd(ElementId element_id,
+                                    const gfx::PointF& scroll_offset) = 0;
   virtual float DeviceScaleFactor() const = 0;
   virtual float PageScaleFactor() const = 0;
   virtual gfx::Size VisualDeviceViewportSize() const = 0;
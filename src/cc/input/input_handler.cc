@@ -8,13 +8,16 @@
 #include <vector>
 
 #include "base/feature_list.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/notreached.h"
+#include "base/strings/strcat.h"
 #include "build/build_config.h"
 #include "cc/base/features.h"
 #include "cc/input/browser_controls_offset_manager.h"
 #include "cc/input/scroll_elasticity_helper.h"
 #include "cc/input/scroll_utils.h"
 #include "cc/input/scrollbar_controller.h"
+#include "cc/input/snap_fling_curve.h"
 #include "cc/input/snap_selection_strategy.h"
 #include "cc/layers/viewport.h"
 #include "cc/trees/compositor_commit_data.h"
@@ -35,6 +38,19 @@ namespace {
 
 enum SlowScrollMetricThread { MAIN_THREAD, CC_THREAD };
 
+const char* GetScrollInputTypeHistogramSuffix(ui::ScrollInputType input_type) {
+  switch (input_type) {
+    case ui::ScrollInputType::kWheel:
+      return "Wheel";
+    case ui::ScrollInputType::kTouchscreen:
+      return "Touchscreen";
+    case ui::ScrollInputType::kScrollbar:
+      return "Scrollbar";
+    case ui::ScrollInputType::kAutoscroll:
+      return "Autoscroll";
+  }
+}
+
 }  // namespace
 
 InputHandlerCommitData::InputHandlerCommitData() = default;
@@ -322,6 +338,11 @@ InputHandlerScrollResult InputHandler::ScrollUpdate(
 
   compositor_delegate_->WillScrollContent(scroll_node.element_id);
 
+  if (scroll_state->is_in_inertial_phase() && !fling_end_predicted_) {
+    PredictFlingEnd(scroll_node, gfx::Vector2dF(scroll_state->delta_x(),
+                                                scroll_state->delta_y()));
+  }
+
   float initial_top_controls_offset = compositor_delegate_->GetImplDeprecated()
                                           .browser_controls_manager()
                                           ->ControlsTopOffset();
@@ -496,6 +517,12 @@ void InputHandler::RecordScrollBegin(
   compositor_delegate_->GetImplDeprecated()
       .frame_trackers()
       .StartScrollSequence(tracker_type, scrolling_thread);
+
+  // The share of scrolls that fall back to, or wait on, the main thread.
+  base::UmaHistogramEnumeration(
+      base::StrCat({"Renderer4.ScrollBeginThreadState.",
+                    GetScrollInputTypeHistogramSuffix(input_type)}),
+      scroll_start_state);
 }
 
 void InputHandler::RecordScrollEnd(ui::ScrollInputType input_type) {
@@ -871,6 +898,25 @@ double InputHandler::PredictViewportBoundsDelta(
       ->PredictViewportBoundsDelta(current_bounds_delta, scroll_distance);
 }
 
+void InputHandler::PredictFlingEnd(const ScrollNode& scroll_node,
+                                   const gfx::Vector2dF& first_fling_delta) {
+  float scale_factor = ActiveTree().page_scale_factor_for_scroll();
+  gfx::Vector2dF displacement = gfx::ScaleVector2d(
+      SnapFlingCurve::EstimateDisplacement(first_fling_delta),
+      1.f / scale_factor);
+  ScrollTree& scroll_tree = GetScrollTree();
+  gfx::PointF end_offset = scroll_tree.ClampScrollOffsetToLimits(
+      scroll_tree.current_scroll_offset(scroll_node.element_id) + displacement,
+      scroll_node);
+  SetPredictedFlingEnd(scroll_node.element_id, end_offset);
+}
+
+void InputHandler::SetPredictedFlingEnd(ElementId element_id,
+                                        const gfx::PointF& scroll_offset) {
+  fling_end_predicted_ = true;
+  compositor_delegate_->SetPredictedFlingEnd(element_id, scroll_offset);
+}
+
 bool InputHandler::GetSnapFlingInfoAndSetAnimatingSnapTarget(
     const gfx::Vector2dF& current_delta,
     const gfx::Vector2dF& natural_displacement_in_viewport,
@@ -938,6 +984,8 @@ bool InputHandler::GetSnapFlingInfoAndSetAnimatingSnapTarget(
 
   scroll_animating_snap_target_ids_ = snap.target_element_ids;
   snap_fling_state_ = kSnapFling;
+  // The snap target is where the fling will end.
+  SetPredictedFlingEnd(scroll_node->element_id, snap.position);
   return true;
 }
 
@@ -1996,6 +2044,10 @@ void InputHandler::ClearCurrentlyScrollingNode() {
   latched_scroll_type_.reset();
   last_scroll_update_state_.reset();
   last_scroll_begin_state_.reset();
+  if (fling_end_predicted_) {
+    SetPredictedFlingEnd(ElementId(), gfx::PointF());
+    fling_end_predicted_ = false;
+  }
   compositor_delegate_->DidEndScroll();
 }
 
@@ -658,6 +658,14 @@ class CC_EXPORT InputHandler : public InputDelegateForCompositor {
       const gfx::PointF& current_offset,
       SnapReason snap_reason) const;
 
+  // Tells the compositor where a fling of `scroll_node` is predicted to end,
+  // given the delta of the fling's first inertial scroll update in viewport
+  // pixels, so that it can prioritize the tiles along the way.
+  void PredictFlingEnd(const ScrollNode& scroll_node,
+                       const gfx::Vector2dF& first_fling_delta);
+  void SetPredictedFlingEnd(ElementId element_id,
+                            const gfx::PointF& scroll_offset);
+
   // The input handler is owned by the delegate so their lifetimes are tied
   // together.
   const raw_ref<CompositorDelegateForInput> compositor_delegate_;
@@ -704,6 +712,10 @@ class CC_EXPORT InputHandler : public InputDelegateForCompositor {
   std::optional<gfx::RangeF> fling_snap_constrain_x_;
   std::optional<gfx::RangeF> fling_snap_constrain_y_;
 
+  // Whether the end of the current fling has been predicted. Reset when the
+  // scroll gesture ends.
+  bool fling_end_predicted_ = false;
+
   // A set of elements that scroll-snapped to a new target since the last
   // begin main frame. The snap target ids of these elements will be sent to
   // the main thread in the next begin main frame.
@@ -645,6 +645,9 @@ bool PictureLayerImpl::UpdateTiles() {
           ? draw_properties().occlusion_in_content_space
           : *kEmptyOcclusion;
 
+  tilings_->set_predicted_fling_displacement(
+      layer_tree_impl()->PredictedFlingDisplacement(transform_tree_index()));
+
   // Pass |occlusion_in_content_space| for |occlusion_in_layer_space| since
   // they are the same space in picture layer, as contents scale is always 1.
   bool updated = tilings_->UpdateTilePriorities(
@@ -2048,9 +2051,7 @@ PictureLayerImpl::InvalidateRegionForImages(
     const auto& rects = raster_source_->GetDisplayItemList()
                             ->discardable_image_map()
                             .GetRectsForImage(image_id);
-    for (const auto& r : rects) {
-      image_invalidation.Union(r);
-    }
+    image_invalidation.Union(rects);
   }
   Region invalidation;
   image_invalidation.Swap(&invalidation);
@@ -4439,6 +4439,9 @@ TEST_F(OcclusionTrackingPictureLayerImplTest,
     queue->Pop();
   }
   EXPECT_EQ(20, unoccluded_tile_count);
+  EXPECT_EQ(5u, pending_layer()
+                    ->picture_layer_tiling_set()
+                    ->CountOccludedTilesNeedingRaster());
 
   // Full occlusion.
   layer1->SetOffsetToTransformParent(gfx::Vector2dF());
@@ -4463,6 +4466,9 @@ TEST_F(OcclusionTrackingPictureLayerImplTest,
     queue->Pop();
   }
   EXPECT_EQ(unoccluded_tile_count, 0);
+  EXPECT_EQ(25u, pending_layer()
+                     ->picture_layer_tiling_set()
+                     ->CountOccludedTilesNeedingRaster());
 }
 
 TEST_F(OcclusionTrackingPictureLayerImplTest,
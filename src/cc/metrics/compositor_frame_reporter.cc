@@ -32,6 +32,7 @@
 #include "cc/metrics/event_latency_tracker.h"
 #include "cc/metrics/event_metrics.h"
 #include "cc/metrics/frame_sequence_tracker.h"
+#include "cc/metrics/jank_attribution_tracker.h"
 #include "cc/metrics/latency_ukm_reporter.h"
 #include "services/tracing/public/cpp/perfetto/macros.h"
 #include "third_party/perfetto/protos/perfetto/trace/track_event/chrome_frame_reporter.pbzero.h"
@@ -994,6 +995,14 @@ void CompositorFrameReporter::TerminateReporter() {
       global_trackers_.dropped_frame_counter->AddGoodFrame();
   }
   global_trackers_.dropped_frame_counter->OnEndFrame(args_, frame_info);
+
+  if (global_trackers_.jank_attribution_tracker &&
+      (frame_info.IsDroppedAffectingSmoothness() ||
+       TestReportType(FrameReportType::kMissedDeadlineFrame))) {
+    global_trackers_.jank_attribution_tracker->AttributeFrame(
+        args_.frame_time, frame_termination_time_,
+        TestReportType(FrameReportType::kDroppedFrame), stage_history_);
+  }
 }
 
 void CompositorFrameReporter::EndCurrentStage(base::TimeTicks end_time) {
@@ -38,6 +38,7 @@ namespace cc {
 class DroppedFrameCounter;
 class EventLatencyTracker;
 class FrameSequenceTrackerCollection;
+class JankAttributionTracker;
 class LatencyUkmReporter;
 
 struct GlobalMetricsTrackers {
@@ -54,6 +55,7 @@ struct GlobalMetricsTrackers {
   RAW_PTR_EXCLUSION ScrollJankDroppedFrameTracker*
       scroll_jank_dropped_frame_tracker = nullptr;
   RAW_PTR_EXCLUSION ScrollJankUkmReporter* scroll_jank_ukm_reporter = nullptr;
+  RAW_PTR_EXCLUSION JankAttributionTracker* jank_attribution_tracker = nullptr;
 };
 
 // This is used for tracing and reporting the duration of pipeline stages within
@@ -7,9 +7,12 @@
 #include <utility>
 
 #include "base/debug/dump_without_crashing.h"
+#include "base/feature_list.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/task/current_thread.h"
 #include "base/trace_event/trace_event.h"
 #include "base/trace_event/trace_id_helper.h"
+#include "cc/base/features.h"
 #include "cc/metrics/compositor_frame_reporter.h"
 #include "cc/metrics/dropped_frame_counter.h"
 #include "cc/metrics/event_latency_tracing_recorder.h"
@@ -65,6 +68,16 @@ CompositorFrameReportingController::CompositorFrameReportingController(
   global_trackers_.predictor_jank_tracker = predictor_jank_tracker_.get();
   global_trackers_.scroll_jank_dropped_frame_tracker =
       scroll_jank_dropped_frame_tracker_.get();
+
+  if (base::FeatureList::IsEnabled(features::kJankAttribution)) {
+    jank_attribution_tracker_ = std::make_unique<JankAttributionTracker>();
+    global_trackers_.jank_attribution_tracker = jank_attribution_tracker_.get();
+    if (base::CurrentThread::IsSet()) {
+      base::CurrentThread::Get()->AddTaskObserver(
+          jank_attribution_tracker_.get());
+      jank_attribution_tracker_observes_tasks_ = true;
+    }
+  }
 }
 
 CompositorFrameReportingController::~CompositorFrameReportingController() {
@@ -82,6 +95,19 @@ CompositorFrameReportingController::~CompositorFrameReportingController() {
 
   predictor_jank_tracker_->set_scroll_jank_ukm_reporter(nullptr);
   scroll_jank_dropped_frame_tracker_->set_scroll_jank_ukm_reporter(nullptr);
+
+  if (jank_attribution_tracker_observes_tasks_) {
+    base::CurrentThread::Get()->RemoveTaskObserver(
+        jank_attribution_tracker_.get());
+  }
+}
+
+void CompositorFrameReportingController::set_tick_clock(
+    const base::TickClock* tick_clock) {
+  DCHECK(tick_clock);
+  tick_clock_ = tick_clock;
+  if (jank_attribution_tracker_)
+    jank_attribution_tracker_->set_tick_clock(tick_clock);
 }
 
 void CompositorFrameReportingController::SetVisible(bool visible) {
@@ -17,6 +17,7 @@
 #include "cc/metrics/compositor_frame_reporter.h"
 #include "cc/metrics/event_metrics.h"
 #include "cc/metrics/frame_sequence_metrics.h"
+#include "cc/metrics/jank_attribution_tracker.h"
 #include "cc/metrics/predictor_jank_tracker.h"
 #include "cc/metrics/scroll_jank_dropped_frame_tracker.h"
 
@@ -93,10 +94,7 @@ class CC_EXPORT CompositorFrameReportingController {
       FrameInfo::SmoothEffectDrivingThread thread_type,
       bool affects_smoothness);
 
-  void set_tick_clock(const base::TickClock* tick_clock) {
-    DCHECK(tick_clock);
-    tick_clock_ = tick_clock;
-  }
+  void set_tick_clock(const base::TickClock* tick_clock);
 
   std::unique_ptr<CompositorFrameReporter>* reporters() { return reporters_; }
 
@@ -204,6 +202,10 @@ class CC_EXPORT CompositorFrameReportingController {
   std::unique_ptr<ScrollJankDroppedFrameTracker>
       scroll_jank_dropped_frame_tracker_;
   std::unique_ptr<ScrollJankUkmReporter> scroll_jank_ukm_reporter_;
+  // Only set if features::kJankAttribution is enabled. Observes the tasks of
+  // the thread this is created on, if it has a CurrentThread.
+  std::unique_ptr<JankAttributionTracker> jank_attribution_tracker_;
+  bool jank_attribution_tracker_observes_tasks_ = false;
 
   std::unique_ptr<CompositorFrameReporter>
       reporters_[PipelineStage::kNumPipelineStages];
@@ -0,0 +1,106 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/metrics/jank_attribution_tracker.h"
+
+#include <string>
+
+#include "base/metrics/histogram_functions.h"
+#include "base/metrics/metrics_hashes.h"
+#include "base/pending_task.h"
+#include "base/trace_event/typed_macros.h"
+
+namespace cc {
+
+JankAttributionTracker::JankAttributionTracker() = default;
+
+JankAttributionTracker::~JankAttributionTracker() = default;
+
+void JankAttributionTracker::AttributeFrame(
+    base::TimeTicks frame_time,
+    base::TimeTicks termination_time,
+    bool dropped,
+    const std::vector<CompositorFrameReporter::StageData>& stages) {
+  Attribution attribution;
+  attribution.frame_time = frame_time;
+  attribution.dropped = dropped;
+  for (const auto& stage : stages) {
+    if (stage.stage_type == StageType::kTotalLatency)
+      continue;
+    base::TimeDelta duration = stage.end_time - stage.start_time;
+    if (duration > attribution.stage_duration) {
+      attribution.stage = stage.stage_type;
+      attribution.stage_duration = duration;
+    }
+  }
+  // Without any stage that took time there is nothing to attribute the frame
+  // to, e.g. if it was dropped before BeginImplFrame ended.
+  if (attribution.stage_duration.is_zero())
+    return;
+
+  for (const LongTask& task : long_tasks_) {
+    if (task.start_time >= termination_time ||
+        task.start_time + task.duration <= frame_time) {
+      continue;
+    }
+    if (!attribution.task || task.duration > attribution.task->duration)
+      attribution.task = task;
+  }
+
+  if (attributions_.size() == kMaxAttributions)
+    attributions_.pop_front();
+  attributions_.push_back(attribution);
+  ReportAttribution(attribution);
+}
+
+void JankAttributionTracker::WillProcessTask(
+    const base::PendingTask& pending_task,
+    bool was_blocked_or_low_priority) {
+  current_task_start_time_ = tick_clock_->NowTicks();
+}
+
+void JankAttributionTracker::DidProcessTask(
+    const base::PendingTask& pending_task) {
+  // The tracker may start observing in the middle of a task.
+  if (current_task_start_time_.is_null())
+    return;
+
+  base::TimeDelta duration = tick_clock_->NowTicks() - current_task_start_time_;
+  if (duration >= kLongTaskThreshold) {
+    if (long_tasks_.size() == kMaxLongTasks)
+      long_tasks_.pop_front();
+    long_tasks_.push_back(
+        {pending_task.posted_from, current_task_start_time_, duration});
+  }
+  current_task_start_time_ = base::TimeTicks();
+}
+
+void JankAttributionTracker::ReportAttribution(
+    const Attribution& attribution) {
+  const char* stage_name =
+      CompositorFrameReporter::GetStageName(attribution.stage);
+  TRACE_EVENT_INSTANT(
+      "cc,benchmark", "JankAttribution", "frame_time", attribution.frame_time,
+      "dropped", attribution.dropped, "stage", stage_name, "stage_duration_us",
+      attribution.stage_duration.InMicroseconds(), "task_posted_from",
+      attribution.task ? attribution.task->posted_from.ToString()
+                       : std::string(),
+      "task_duration_us",
+      attribution.task ? attribution.task->duration.InMicroseconds() : 0);
+
+  base::UmaHistogramEnumeration("CompositorLatency.JankAttribution.Stage",
+                                attribution.stage, StageType::kStageTypeCount);
+  base::UmaHistogramBoolean("CompositorLatency.JankAttribution.HasLongTask",
+                            attribution.task.has_value());
+  if (attribution.task) {
+    // Sparse, keyed by the hash of the posting location, so that the top
+    // offenders stand out.
+    base::UmaHistogramSparse(
+        "CompositorLatency.JankAttribution.LongTask",
+        static_cast<int>(base::HashMetricNameAs32Bits(
+            attribution.task->posted_from.ToString())));
+  }
+}
+
+}  // namespace cc
@@ -0,0 +1,102 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_METRICS_JANK_ATTRIBUTION_TRACKER_H_
+#define CC_METRICS_JANK_ATTRIBUTION_TRACKER_H_
+
+#include <stddef.h>
+
+#include <optional>
+#include <vector>
+
+#include "base/containers/circular_deque.h"
+#include "base/location.h"
+#include "base/memory/raw_ptr.h"
+#include "base/task/task_observer.h"
+#include "base/time/default_tick_clock.h"
+#include "base/time/time.h"
+#include "cc/cc_export.h"
+#include "cc/metrics/compositor_frame_reporter.h"
+
+namespace cc {
+
+// JankAttributionTracker joins the compositor pipeline stages of each dropped
+// or late frame with the tasks that ran on the compositor thread while it was
+// in flight. It attributes the frame to the stage that took the longest, and
+// to the longest task (by the location it was posted from) that overlapped the
+// frame, if any task was long enough to matter.
+//
+// Attributions are kept in a bounded buffer, emitted as trace events so that
+// they are included in background traces, and reported to UMA so that the top
+// offenders can be found in aggregate.
+//
+// The tracker is a base::TaskObserver of the thread it is created on. Only
+// tasks longer than kLongTaskThreshold are kept, in a bounded buffer, so it is
+// cheap enough to keep enabled for every frame.
+class CC_EXPORT JankAttributionTracker : public base::TaskObserver {
+ public:
+  using StageType = CompositorFrameReporter::StageType;
+
+  struct LongTask {
+    base::Location posted_from;
+    base::TimeTicks start_time;
+    base::TimeDelta duration;
+  };
+
+  struct Attribution {
+    base::TimeTicks frame_time;
+    // False if the frame was presented, but missed its deadline.
+    bool dropped = false;
+    StageType stage = StageType::kTotalLatency;
+    base::TimeDelta stage_duration;
+    // The longest long task that overlapped the frame, if any.
+    std::optional<LongTask> task;
+  };
+
+  static constexpr base::TimeDelta kLongTaskThreshold = base::Milliseconds(4);
+  static constexpr size_t kMaxLongTasks = 32;
+  static constexpr size_t kMaxAttributions = 64;
+
+  JankAttributionTracker();
+  JankAttributionTracker(const JankAttributionTracker&) = delete;
+  JankAttributionTracker& operator=(const JankAttributionTracker&) = delete;
+  ~JankAttributionTracker() override;
+
+  // Attributes the frame that began at `frame_time` and was terminated at
+  // `termination_time` after going through `stages`.
+  void AttributeFrame(
+      base::TimeTicks frame_time,
+      base::TimeTicks termination_time,
+      bool dropped,
+      const std::vector<CompositorFrameReporter::StageData>& stages);
+
+  // Returns the most recent attributions, oldest first.
+  const base::circular_deque<Attribution>& attributions() const {
+    return attributions_;
+  }
+
+  // base::TaskObserver:
+  void WillProcessTask(const base::PendingTask& pending_task,
+                       bool was_blocked_or_low_priority) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+  void set_tick_clock(const base::TickClock* tick_clock) {
+    DCHECK(tick_clock);
+    tick_clock_ = tick_clock;
+  }
+
+ private:
+  void ReportAttribution(const Attribution& attribution);
+
+  raw_ptr<const base::TickClock> tick_clock_ =
+      base::DefaultTickClock::GetInstance();
+
+  base::TimeTicks current_task_start_time_;
+  base::circular_deque<LongTask> long_tasks_;
+  base::circular_deque<Attribution> attributions_;
+};
+
+}  // namespace cc
+
+#endif  // CC_METRICS_JANK_ATTRIBUTION_TRACKER_H_
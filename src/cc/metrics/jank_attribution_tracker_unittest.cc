@@ -0,0 +1,113 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/metrics/jank_attribution_tracker.h"
+
+#include <vector>
+
+#include "base/functional/callback_helpers.h"
+#include "base/location.h"
+#include "base/pending_task.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/simple_test_tick_clock.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace cc {
+namespace {
+
+using StageType = CompositorFrameReporter::StageType;
+using StageData = CompositorFrameReporter::StageData;
+
+class JankAttributionTrackerTest : public testing::Test {
+ public:
+  JankAttributionTrackerTest() {
+    test_tick_clock_.SetNowTicks(base::TimeTicks() + base::Seconds(1));
+    tracker_.set_tick_clock(&test_tick_clock_);
+  }
+
+  // Runs a task posted from `posted_from` that takes `duration`.
+  void RunTask(const base::Location& posted_from, base::TimeDelta duration) {
+    base::PendingTask task(posted_from, base::DoNothing());
+    tracker_.WillProcessTask(task, /*was_blocked_or_low_priority=*/false);
+    test_tick_clock_.Advance(duration);
+    tracker_.DidProcessTask(task);
+  }
+
+  base::TimeTicks Now() const { return test_tick_clock_.NowTicks(); }
+
+ protected:
+  base::SimpleTestTickClock test_tick_clock_;
+  JankAttributionTracker tracker_;
+};
+
+TEST_F(JankAttributionTrackerTest, AttributesToSlowestStageAndLongestTask) {
+  base::HistogramTester histogram_tester;
+  const base::TimeTicks frame_time = Now();
+  RunTask(FROM_HERE, base::Milliseconds(1));
+  const base::Location long_task_location = FROM_HERE;
+  RunTask(long_task_location, base::Milliseconds(12));
+  RunTask(FROM_HERE, base::Milliseconds(5));
+
+  std::vector<StageData> stages = {
+      {StageType::kBeginImplFrameToSendBeginMainFrame, frame_time,
+       frame_time + base::Milliseconds(2)},
+      {StageType::kEndActivateToSubmitCompositorFrame,
+       frame_time + base::Milliseconds(2), frame_time + base::Milliseconds(20)},
+      {StageType::kTotalLatency, frame_time,
+       frame_time + base::Milliseconds(20)},
+  };
+  tracker_.AttributeFrame(frame_time, Now(), /*dropped=*/true, stages);
+
+  ASSERT_EQ(1u, tracker_.attributions().size());
+  const auto& attribution = tracker_.attributions().back();
+  EXPECT_TRUE(attribution.dropped);
+  EXPECT_EQ(StageType::kEndActivateToSubmitCompositorFrame, attribution.stage);
+  EXPECT_EQ(base::Milliseconds(18), attribution.stage_duration);
+  ASSERT_TRUE(attribution.task);
+  EXPECT_EQ(long_task_location, attribution.task->posted_from);
+  EXPECT_EQ(base::Milliseconds(12), attribution.task->duration);
+
+  histogram_tester.ExpectUniqueSample(
+      "CompositorLatency.JankAttribution.Stage",
+      StageType::kEndActivateToSubmitCompositorFrame, 1);
+  histogram_tester.ExpectUniqueSample(
+      "CompositorLatency.JankAttribution.HasLongTask", true, 1);
+  histogram_tester.ExpectTotalCount(
+      "CompositorLatency.JankAttribution.LongTask", 1);
+}
+
+TEST_F(JankAttributionTrackerTest, IgnoresTasksOutsideTheFrame) {
+  RunTask(FROM_HERE, base::Milliseconds(10));
+  const base::TimeTicks frame_time = Now();
+  test_tick_clock_.Advance(base::Milliseconds(16));
+  const base::TimeTicks termination_time = Now();
+  RunTask(FROM_HERE, base::Milliseconds(10));
+
+  std::vector<StageData> stages = {
+      {StageType::kSendBeginMainFrameToCommit, frame_time, termination_time}};
+  tracker_.AttributeFrame(frame_time, termination_time, /*dropped=*/false,
+                          stages);
+
+  ASSERT_EQ(1u, tracker_.attributions().size());
+  const auto& attribution = tracker_.attributions().back();
+  EXPECT_FALSE(attribution.dropped);
+  EXPECT_EQ(StageType::kSendBeginMainFrameToCommit, attribution.stage);
+  EXPECT_FALSE(attribution.task);
+}
+
+TEST_F(JankAttributionTrackerTest, BuffersAreBounded) {
+  for (size_t i = 0; i < JankAttributionTracker::kMaxAttributions + 10; ++i) {
+    const base::TimeTicks frame_time = Now();
+    RunTask(FROM_HERE, base::Milliseconds(5));
+    tracker_.AttributeFrame(
+        frame_time, Now(), /*dropped=*/true,
+        {{StageType::kActivation, frame_time, Now()}});
+  }
+  EXPECT_EQ(JankAttributionTracker::kMaxAttributions,
+            tracker_.attributions().size());
+}
+
+}  // namespace
+}  // namespace cc
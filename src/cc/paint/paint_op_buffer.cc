@@ -14,6 +14,7 @@
 #include "cc/paint/paint_image_builder.h"
 #include "cc/paint/paint_op.h"
 #include "cc/paint/paint_op_buffer_iterator.h"
+#include "cc/paint/paint_op_buffer_storage_pool.h"
 #include "cc/paint/paint_op_reader.h"
 #include "cc/paint/paint_op_writer.h"
 #include "cc/paint/paint_record.h"
@@ -68,6 +69,11 @@ PaintOpBuffer::SerializeOptions& PaintOpBuffer::SerializeOptions::operator=(
     const SerializeOptions&) = default;
 PaintOpBuffer::SerializeOptions::~SerializeOptions() = default;
 
+static_assert(PaintOpBuffer::kInitialBufferSize ==
+              PaintOpBufferStoragePool::kMinBlockSize);
+static_assert(PaintOpBuffer::kPaintOpAlign ==
+              PaintOpBufferStoragePool::kBlockAlignment);
+
 PaintOpBuffer::PaintOpBuffer() = default;
 
 PaintOpBuffer::PaintOpBuffer(PaintOpBuffer&& other) {
@@ -76,9 +82,11 @@ PaintOpBuffer::PaintOpBuffer(PaintOpBuffer&& other) {
 
 PaintOpBuffer::~PaintOpBuffer() {
   DestroyOps();
+  FreeBufferData(std::move(data_), reserved_);
 }
 
 PaintOpBuffer& PaintOpBuffer::operator=(PaintOpBuffer&& other) {
+  FreeBufferData(std::move(data_), reserved_);
   data_ = std::move(other.data_);
   DCHECK(!other.data_);
   used_ = other.used_;
@@ -310,8 +318,7 @@ PaintOpBuffer::BufferDataPtr PaintOpBuffer::ReallocBuffer(size_t new_size) {
   DCHECK_GE(new_size, used_);
   DCHECK(is_mutable());
 
-  std::unique_ptr<char, base::AlignedFreeDeleter> new_data(
-      static_cast<char*>(base::AlignedAlloc(new_size, kPaintOpAlign)));
+  BufferDataPtr new_data = AllocateBufferData(new_size);
   if (data_)
     memcpy(new_data.get(), data_.get(), used_);
   BufferDataPtr old_data = std::move(data_);
@@ -327,18 +334,38 @@ void* PaintOpBuffer::AllocatePaintOpSlowPath(uint16_t aligned_size) {
   DCHECK_GT(required_size, reserved_) << "Should not have hit the slow path";
   // Start reserved_ at kInitialBufferSize and then double.
   // ShrinkToFit() can make this smaller afterwards.
+  const size_t old_reserved = reserved_;
   size_t new_size = reserved_ ? reserved_ : kInitialBufferSize;
   while (required_size > new_size) {
     new_size *= 2;
   }
-  ReallocBuffer(new_size);
+  FreeBufferData(ReallocBuffer(new_size), old_reserved);
   DCHECK_LE(required_size, reserved_);
 
   return AllocatePaintOp(aligned_size);
 }
 
 void PaintOpBuffer::ShrinkToFit() {
-  ReallocIfNeededToFit();
+  const size_t old_reserved = reserved_;
+  FreeBufferData(ReallocIfNeededToFit(), old_reserved);
+}
+
+// static
+PaintOpBuffer::BufferDataPtr PaintOpBuffer::AllocateBufferData(size_t size) {
+  PaintOpBufferStoragePool* pool = PaintOpBufferStoragePool::GetCurrent();
+  if (pool && PaintOpBufferStoragePool::IsPooledSize(size))
+    return pool->Allocate(size);
+  return BufferDataPtr(
+      static_cast<char*>(base::AlignedAlloc(size, kPaintOpAlign)));
+}
+
+// static
+void PaintOpBuffer::FreeBufferData(BufferDataPtr data, size_t size) {
+  if (!data)
+    return;
+  PaintOpBufferStoragePool* pool = PaintOpBufferStoragePool::GetCurrent();
+  if (pool && PaintOpBufferStoragePool::IsPooledSize(size))
+    pool->Release(std::move(data), size);
 }
 
 PaintOpBuffer::BufferDataPtr PaintOpBuffer::ReallocIfNeededToFit() {
@@ -355,6 +355,11 @@ class CC_PAINT_EXPORT PaintOpBuffer : public SkRefCnt {
   // allocated a new buffer, or nullptr.
   BufferDataPtr ReallocIfNeededToFit();
 
+  // Allocate and free data buffers of `size` bytes, recycling them through the
+  // PaintOpBufferStoragePool installed on the current thread if there is one.
+  static BufferDataPtr AllocateBufferData(size_t size);
+  static void FreeBufferData(BufferDataPtr data, size_t size);
+
   // Returns the allocated op.
   void* AllocatePaintOp(uint16_t aligned_size) {
     DCHECK(is_mutable());
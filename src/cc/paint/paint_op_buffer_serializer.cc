@@ -445,6 +445,9 @@ size_t SimpleBufferSerializer::SerializeToMemoryImpl(
 
   written_ += bytes;
   DCHECK_GE(total_, written_);
+  if (record_op_end_offsets_) {
+    op_end_offsets_.push_back(written_);
+  }
   return bytes;
 }
 
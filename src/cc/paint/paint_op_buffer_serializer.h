@@ -142,6 +142,13 @@ class CC_PAINT_EXPORT SimpleBufferSerializer : public PaintOpBufferSerializer {
 
   size_t written() const { return written_; }
 
+  // When enabled, records the end offset of every serialized op so that the
+  // output can be split into op aligned spans, e.g. by PaintOpSpanCache.
+  void set_record_op_end_offsets(bool record) {
+    record_op_end_offsets_ = record;
+  }
+  const std::vector<size_t>& op_end_offsets() const { return op_end_offsets_; }
+
  private:
   size_t SerializeToMemoryImpl(const PaintOp& op,
                                const PaintOp::SerializeOptions& options,
@@ -163,6 +170,9 @@ class CC_PAINT_EXPORT SimpleBufferSerializer : public PaintOpBufferSerializer {
   void* memory_;
   const size_t total_;
   size_t written_ = 0u;
+
+  bool record_op_end_offsets_ = false;
+  std::vector<size_t> op_end_offsets_;
 };
 
 }  // namespace cc
@@ -0,0 +1,91 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/paint/paint_op_buffer_storage_pool.h"
+
+#include <bit>
+#include <utility>
+
+#include "base/check_op.h"
+#include "third_party/abseil-cpp/absl/base/attributes.h"
+
+namespace cc {
+
+namespace {
+
+ABSL_CONST_INIT thread_local PaintOpBufferStoragePool* current_pool = nullptr;
+
+}  // namespace
+
+PaintOpBufferStoragePool::ScopedUse::ScopedUse(
+    PaintOpBufferStoragePool* pool)
+    : pool_(pool), previous_pool_(std::exchange(current_pool, pool)) {
+  DCHECK(pool_);
+}
+
+PaintOpBufferStoragePool::ScopedUse::~ScopedUse() {
+  DCHECK_EQ(current_pool, pool_);
+  current_pool = previous_pool_;
+}
+
+PaintOpBufferStoragePool::PaintOpBufferStoragePool() = default;
+
+PaintOpBufferStoragePool::~PaintOpBufferStoragePool() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK_NE(current_pool, this);
+}
+
+// static
+PaintOpBufferStoragePool* PaintOpBufferStoragePool::GetCurrent() {
+  return current_pool;
+}
+
+// static
+bool PaintOpBufferStoragePool::IsPooledSize(size_t size) {
+  return size >= kMinBlockSize && size <= kMaxBlockSize &&
+         std::has_single_bit(size);
+}
+
+// static
+size_t PaintOpBufferStoragePool::SizeClassIndex(size_t size) {
+  DCHECK(IsPooledSize(size));
+  return static_cast<size_t>(std::countr_zero(size) -
+                             std::countr_zero(kMinBlockSize));
+}
+
+PaintOpBufferStoragePool::BlockPtr PaintOpBufferStoragePool::Allocate(
+    size_t size) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  std::vector<BlockPtr>& free_blocks = free_blocks_[SizeClassIndex(size)];
+  if (free_blocks.empty()) {
+    ++heap_allocation_count_;
+    return BlockPtr(
+        static_cast<char*>(base::AlignedAlloc(size, kBlockAlignment)));
+  }
+
+  ++recycled_allocation_count_;
+  BlockPtr block = std::move(free_blocks.back());
+  free_blocks.pop_back();
+  pooled_bytes_ -= size;
+  return block;
+}
+
+void PaintOpBufferStoragePool::Release(BlockPtr block, size_t size) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK(block);
+  if (pooled_bytes_ + size > kMaxPooledBytes)
+    return;
+
+  free_blocks_[SizeClassIndex(size)].push_back(std::move(block));
+  pooled_bytes_ += size;
+}
+
+void PaintOpBufferStoragePool::Clear() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  for (auto& free_blocks : free_blocks_)
+    free_blocks.clear();
+  pooled_bytes_ = 0u;
+}
+
+}  // namespace cc
@@ -0,0 +1,108 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_PAINT_PAINT_OP_BUFFER_STORAGE_POOL_H_
+#define CC_PAINT_PAINT_OP_BUFFER_STORAGE_POOL_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "base/memory/aligned_memory.h"
+#include "base/memory/raw_ptr.h"
+#include "base/threading/thread_checker.h"
+#include "cc/paint/paint_export.h"
+
+namespace cc {
+
+// PaintOpBufferStoragePool recycles the data blocks PaintOpBuffer grows into
+// while recording. A recording starts with a small block and doubles it as ops
+// are appended, and the final PaintRecord is shrunk to fit, so every recording
+// otherwise makes several short lived heap allocations. While a pool is
+// installed on a thread with a ScopedUse, blocks of the power of two sizes
+// PaintOpBuffer grows through are taken from and returned to the pool instead
+// of the heap.
+//
+// The owner is expected to install the pool around a batch of recordings
+// (e.g. the paint of a main frame) and to Clear() it once they are committed,
+// which frees all recycled blocks at once. The pool is bounded by
+// kMaxPooledBytes, beyond which released blocks are freed immediately.
+class CC_PAINT_EXPORT PaintOpBufferStoragePool {
+ public:
+  // Matches PaintOpBuffer::kInitialBufferSize.
+  static constexpr size_t kMinBlockSize = 4096;
+  static constexpr size_t kMaxBlockSize = 256 * 1024;
+  static constexpr size_t kMaxPooledBytes = 4 * 1024 * 1024;
+  // Matches PaintOpBuffer::kPaintOpAlign.
+  static constexpr size_t kBlockAlignment = 8;
+
+  using BlockPtr = std::unique_ptr<char, base::AlignedFreeDeleter>;
+
+  // Installs |pool| as the pool used by PaintOpBuffers on the current thread
+  // for the lifetime of this object, restoring the previously installed pool
+  // when destroyed.
+  class CC_PAINT_EXPORT ScopedUse {
+   public:
+    explicit ScopedUse(PaintOpBufferStoragePool* pool);
+    ScopedUse(const ScopedUse&) = delete;
+    ScopedUse& operator=(const ScopedUse&) = delete;
+    ~ScopedUse();
+
+   private:
+    const raw_ptr<PaintOpBufferStoragePool> pool_;
+    const raw_ptr<PaintOpBufferStoragePool> previous_pool_;
+  };
+
+  PaintOpBufferStoragePool();
+  PaintOpBufferStoragePool(const PaintOpBufferStoragePool&) = delete;
+  PaintOpBufferStoragePool& operator=(const PaintOpBufferStoragePool&) =
+      delete;
+  ~PaintOpBufferStoragePool();
+
+  // Returns the pool installed on the current thread, or nullptr.
+  static PaintOpBufferStoragePool* GetCurrent();
+
+  // Returns true if blocks of |size| bytes are recycled by the pool.
+  static bool IsPooledSize(size_t size);
+
+  // Returns a block of |size| bytes aligned to kBlockAlignment, recycling a
+  // previously released block if one is available. |size| must be a pooled
+  // size.
+  BlockPtr Allocate(size_t size);
+
+  // Takes back |block|, which must be |size| bytes large and aligned to
+  // kBlockAlignment. |size| must be a pooled size.
+  void Release(BlockPtr block, size_t size);
+
+  // Frees every recycled block.
+  void Clear();
+
+  size_t pooled_bytes() const { return pooled_bytes_; }
+  // The number of Allocate() calls that fell back to the heap, and that were
+  // satisfied by a recycled block.
+  size_t heap_allocation_count() const { return heap_allocation_count_; }
+  size_t recycled_allocation_count() const {
+    return recycled_allocation_count_;
+  }
+
+ private:
+  // Block sizes are kMinBlockSize << index.
+  static constexpr size_t kNumSizeClasses = 7;
+  static_assert((kMinBlockSize << (kNumSizeClasses - 1)) == kMaxBlockSize);
+
+  static size_t SizeClassIndex(size_t size);
+
+  std::array<std::vector<BlockPtr>, kNumSizeClasses> free_blocks_;
+  size_t pooled_bytes_ = 0u;
+  size_t heap_allocation_count_ = 0u;
+  size_t recycled_allocation_count_ = 0u;
+
+  THREAD_CHECKER(thread_checker_);
+};
+
+}  // namespace cc
+
+#endif  // CC_PAINT_PAINT_OP_BUFFER_STORAGE_POOL_H_
@@ -0,0 +1,128 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/paint/paint_op_buffer_storage_pool.h"
+
+#include <utility>
+#include <vector>
+
+#include "cc/paint/paint_flags.h"
+#include "cc/paint/paint_op.h"
+#include "cc/paint/paint_op_buffer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace cc {
+namespace {
+
+constexpr size_t kMinBlockSize = PaintOpBufferStoragePool::kMinBlockSize;
+
+// Pushes ops until |buffer| has grown past |bytes|.
+void GrowBuffer(PaintOpBuffer& buffer, size_t bytes) {
+  PaintFlags flags;
+  while (buffer.paint_ops_size() <= bytes)
+    buffer.push<DrawRectOp>(SkRect::MakeWH(1, 1), flags);
+}
+
+TEST(PaintOpBufferStoragePoolTest, PooledSizes) {
+  EXPECT_FALSE(PaintOpBufferStoragePool::IsPooledSize(kMinBlockSize / 2));
+  EXPECT_TRUE(PaintOpBufferStoragePool::IsPooledSize(kMinBlockSize));
+  EXPECT_FALSE(PaintOpBufferStoragePool::IsPooledSize(kMinBlockSize + 8));
+  EXPECT_TRUE(PaintOpBufferStoragePool::IsPooledSize(kMinBlockSize * 4));
+  EXPECT_TRUE(PaintOpBufferStoragePool::IsPooledSize(
+      PaintOpBufferStoragePool::kMaxBlockSize));
+  EXPECT_FALSE(PaintOpBufferStoragePool::IsPooledSize(
+      PaintOpBufferStoragePool::kMaxBlockSize * 2));
+}
+
+TEST(PaintOpBufferStoragePoolTest, RecyclesBlocks) {
+  PaintOpBufferStoragePool pool;
+  PaintOpBufferStoragePool::BlockPtr block = pool.Allocate(kMinBlockSize);
+  ASSERT_TRUE(block);
+  char* const address = block.get();
+  EXPECT_EQ(1u, pool.heap_allocation_count());
+
+  pool.Release(std::move(block), kMinBlockSize);
+  EXPECT_EQ(kMinBlockSize, pool.pooled_bytes());
+
+  // A block of a different size class is not recycled.
+  block = pool.Allocate(kMinBlockSize * 2);
+  EXPECT_EQ(2u, pool.heap_allocation_count());
+  EXPECT_EQ(0u, pool.recycled_allocation_count());
+  pool.Release(std::move(block), kMinBlockSize * 2);
+
+  block = pool.Allocate(kMinBlockSize);
+  EXPECT_EQ(address, block.get());
+  EXPECT_EQ(1u, pool.recycled_allocation_count());
+  EXPECT_EQ(kMinBlockSize * 2, pool.pooled_bytes());
+
+  pool.Clear();
+  EXPECT_EQ(0u, pool.pooled_bytes());
+}
+
+TEST(PaintOpBufferStoragePoolTest, BoundedByMaxPooledBytes) {
+  PaintOpBufferStoragePool pool;
+  constexpr size_t kBlockSize = PaintOpBufferStoragePool::kMaxBlockSize;
+  constexpr size_t kMaxBlocks =
+      PaintOpBufferStoragePool::kMaxPooledBytes / kBlockSize;
+  for (size_t i = 0; i < kMaxBlocks + 1; ++i)
+    pool.Release(pool.Allocate(kBlockSize), kBlockSize);
+  EXPECT_EQ(kBlockSize, pool.pooled_bytes());
+
+  std::vector<PaintOpBufferStoragePool::BlockPtr> blocks;
+  for (size_t i = 0; i < kMaxBlocks + 1; ++i)
+    blocks.push_back(pool.Allocate(kBlockSize));
+  for (auto& block : blocks)
+    pool.Release(std::move(block), kBlockSize);
+  EXPECT_EQ(PaintOpBufferStoragePool::kMaxPooledBytes, pool.pooled_bytes());
+}
+
+TEST(PaintOpBufferStoragePoolTest, PaintOpBufferUsesCurrentPool) {
+  PaintOpBufferStoragePool pool;
+  {
+    PaintOpBufferStoragePool::ScopedUse use_pool(&pool);
+    EXPECT_EQ(&pool, PaintOpBufferStoragePool::GetCurrent());
+
+    {
+      PaintOpBuffer buffer;
+      GrowBuffer(buffer, kMinBlockSize);
+      // Growing past the initial block returned it to the pool.
+      EXPECT_EQ(2u, pool.heap_allocation_count());
+      EXPECT_EQ(kMinBlockSize, pool.pooled_bytes());
+    }
+    EXPECT_EQ(kMinBlockSize * 3, pool.pooled_bytes());
+
+    PaintOpBuffer buffer;
+    GrowBuffer(buffer, kMinBlockSize);
+    EXPECT_EQ(2u, pool.heap_allocation_count());
+    EXPECT_EQ(2u, pool.recycled_allocation_count());
+
+    // The record is shrunk to fit and the recording buffer keeps its block.
+    PaintRecord record = buffer.ReleaseAsRecord();
+    EXPECT_EQ(kMinBlockSize, pool.pooled_bytes());
+  }
+  EXPECT_FALSE(PaintOpBufferStoragePool::GetCurrent());
+  EXPECT_EQ(kMinBlockSize * 3, pool.pooled_bytes());
+
+  // Buffers freed without a pool installed don't return their blocks.
+  {
+    PaintOpBuffer buffer;
+    GrowBuffer(buffer, kMinBlockSize);
+  }
+  EXPECT_EQ(kMinBlockSize * 3, pool.pooled_bytes());
+}
+
+TEST(PaintOpBufferStoragePoolTest, NestedScopes) {
+  PaintOpBufferStoragePool outer_pool;
+  PaintOpBufferStoragePool inner_pool;
+  PaintOpBufferStoragePool::ScopedUse use_outer_pool(&outer_pool);
+  {
+    PaintOpBufferStoragePool::ScopedUse use_inner_pool(&inner_pool);
+    EXPECT_EQ(&inner_pool, PaintOpBufferStoragePool::GetCurrent());
+  }
+  EXPECT_EQ(&outer_pool, PaintOpBufferStoragePool::GetCurrent());
+}
+
+}  // namespace
+}  // namespace cc
@@ -2,7 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include "base/test/launcher/unit_test_launcher.h"
 #include "base/test/test_suite.h"
@@ -10,6 +12,8 @@
 #include "cc/paint/draw_looper.h"
 #include "cc/paint/paint_op_buffer.h"
 #include "cc/paint/paint_op_buffer_serializer.h"
+#include "cc/paint/paint_op_buffer_storage_pool.h"
+#include "cc/paint/paint_op_span_cache.h"
 #include "cc/paint/paint_op_writer.h"
 #include "cc/paint/paint_shader.h"
 #include "cc/test/test_options_provider.h"
@@ -93,6 +97,95 @@ class PaintOpPerfTest : public testing::Test {
     reporter.AddResult("", timer_.LapsPerSecond());
   }
 
+  // Serializes |buffers| in turn as successive commits of the same tile and
+  // reports how many serialized bytes were unchanged from the previous commit
+  // according to PaintOpSpanCache.
+  void RunDeltaTest(const std::string& name,
+                    const std::vector<PaintOpBuffer>& buffers) {
+    TestOptionsProvider test_options_provider;
+    PaintOpSpanCache span_cache;
+    PaintOpBufferSerializer::Preamble preamble;
+    constexpr uint64_t kTileKey = 1u;
+
+    size_t commit = 0u;
+    timer_.Reset();
+    do {
+      SimpleBufferSerializer serializer(
+          serialized_data_.get(), kMaxSerializedBufferBytes,
+          test_options_provider.serialize_options());
+      serializer.set_record_op_end_offsets(true);
+      serializer.Serialize(buffers[commit++ % buffers.size()], nullptr,
+                           preamble);
+      CHECK_GT(serializer.written(), 0u);
+      span_cache.Update(
+          kTileKey,
+          base::span<const char>(serialized_data_.get(), serializer.written()),
+          serializer.op_end_offsets());
+      test_options_provider.client_paint_cache()->PurgeAll();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PerfResultReporter reporter(name, " delta");
+    reporter.RegisterImportantMetric("_serialize", "runs/s");
+    reporter.RegisterImportantMetric("_bytes_saved_per_commit", "bytes");
+    reporter.RegisterImportantMetric("_bytes_saved_ratio", "%");
+    reporter.AddResult("_serialize", timer_.LapsPerSecond());
+    reporter.AddResult(
+        "_bytes_saved_per_commit",
+        static_cast<double>(span_cache.total_saved_bytes()) / commit);
+    reporter.AddResult("_bytes_saved_ratio",
+                       100.0 * span_cache.total_saved_bytes() /
+                           span_cache.total_bytes());
+  }
+
+  // Records |num_recordings| small PaintRecords per lap, as the paint of a
+  // frame with many small layers would, optionally recycling their storage
+  // through a PaintOpBufferStoragePool that is emptied after every lap. The
+  // allocation counts cover the blocks buffers grow through, not the exact
+  // size copy made by ReleaseAsRecord().
+  void RunRecordTest(const std::string& name,
+                     size_t num_recordings,
+                     size_t ops_per_recording,
+                     bool use_storage_pool) {
+    PaintOpBufferStoragePool pool;
+    std::optional<PaintOpBufferStoragePool::ScopedUse> use_pool;
+    if (use_storage_pool)
+      use_pool.emplace(&pool);
+
+    PaintFlags flags;
+    std::vector<PaintRecord> records;
+    records.reserve(num_recordings);
+    size_t laps = 0u;
+    timer_.Reset();
+    do {
+      for (size_t i = 0; i < num_recordings; ++i) {
+        PaintOpBuffer buffer;
+        for (size_t j = 0; j < ops_per_recording; ++j)
+          buffer.push<DrawRectOp>(SkRect::MakeXYWH(j, i, 1, 1), flags);
+        records.push_back(buffer.ReleaseAsRecord());
+      }
+      // Simulates the recordings being replaced after commit.
+      records.clear();
+      pool.Clear();
+      ++laps;
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PerfResultReporter reporter(name, " record");
+    reporter.RegisterImportantMetric("", "runs/s");
+    reporter.AddResult("", timer_.LapsPerSecond());
+    if (use_storage_pool) {
+      const double recordings = static_cast<double>(laps * num_recordings);
+      reporter.RegisterImportantMetric("_heap_allocs_per_recording", "count");
+      reporter.RegisterImportantMetric("_recycled_allocs_per_recording",
+                                       "count");
+      reporter.AddResult("_heap_allocs_per_recording",
+                         pool.heap_allocation_count() / recordings);
+      reporter.AddResult("_recycled_allocs_per_recording",
+                         pool.recycled_allocation_count() / recordings);
+    }
+  }
+
  protected:
   base::LapTimer timer_;
   std::unique_ptr<char, base::AlignedFreeDeleter> serialized_data_;
@@ -117,6 +210,34 @@ TEST_F(PaintOpPerfTest, DrawOps) {
   RunTest("draw", buffer);
 }
 
+// Drawing ops where a single op moves on every commit, similar to a small
+// animation in a large recording.
+TEST_F(PaintOpPerfTest, AnimatedDrawOpsDelta) {
+  constexpr size_t kNumCommits = 10;
+  constexpr size_t kNumOps = 500;
+  PaintFlags flags;
+  std::vector<PaintOpBuffer> buffers(kNumCommits);
+  for (size_t commit = 0; commit < kNumCommits; ++commit) {
+    for (size_t i = 0; i < kNumOps; ++i) {
+      float offset = i == kNumOps / 2 ? static_cast<float>(commit) : 0.f;
+      buffers[commit].push<DrawRectOp>(
+          SkRect::MakeXYWH(i % 50 + offset, i / 50, 1, 1), flags);
+    }
+  }
+  RunDeltaTest("animated_draw", buffers);
+}
+
+// Many small recordings, each growing past the initial buffer size.
+TEST_F(PaintOpPerfTest, RecordSmallBuffers) {
+  RunRecordTest("small_buffers", /*num_recordings=*/1000,
+                /*ops_per_recording=*/100, /*use_storage_pool=*/false);
+}
+
+TEST_F(PaintOpPerfTest, RecordSmallBuffersStoragePool) {
+  RunRecordTest("small_buffers_storage_pool", /*num_recordings=*/1000,
+                /*ops_per_recording=*/100, /*use_storage_pool=*/true);
+}
+
 // Ops with worst case flags.
 TEST_F(PaintOpPerfTest, ManyFlagsOps) {
   PaintOpBuffer buffer;
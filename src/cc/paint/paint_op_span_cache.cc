@@ -0,0 +1,94 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/paint/paint_op_span_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/check_op.h"
+#include "base/hash/hash.h"
+
+namespace cc {
+
+PaintOpSpanCache::Delta::Delta() = default;
+PaintOpSpanCache::Delta::Delta(Delta&&) = default;
+PaintOpSpanCache::Delta::~Delta() = default;
+PaintOpSpanCache::Delta& PaintOpSpanCache::Delta::operator=(Delta&&) = default;
+
+PaintOpSpanCache::PaintOpSpanCache(size_t max_entries, size_t ops_per_span)
+    : ops_per_span_(ops_per_span), entries_(max_entries) {
+  DCHECK_GT(ops_per_span_, 0u);
+}
+
+PaintOpSpanCache::~PaintOpSpanCache() = default;
+
+PaintOpSpanCache::Delta PaintOpSpanCache::Update(
+    uint64_t key,
+    base::span<const char> data,
+    base::span<const size_t> op_end_offsets) {
+  Delta delta;
+  delta.total_bytes = data.size();
+
+  auto it = entries_.Get(key);
+  const SpanHashes* previous_hashes =
+      it != entries_.end() ? &it->second : nullptr;
+
+  SpanHashes hashes;
+  hashes.reserve(op_end_offsets.size() / ops_per_span_ + 1);
+
+  size_t span_begin = 0u;
+  for (size_t i = 0; i < op_end_offsets.size(); i += ops_per_span_) {
+    size_t last_op = std::min(i + ops_per_span_, op_end_offsets.size()) - 1;
+    size_t span_end = op_end_offsets[last_op];
+    DCHECK_GE(span_end, span_begin);
+    DCHECK_LE(span_end, data.size());
+
+    Span span;
+    span.offset = span_begin;
+    span.size = span_end - span_begin;
+    span.hash = base::FastHash(
+        base::as_bytes(data.subspan(span.offset, span.size)));
+    hashes.push_back(span.hash);
+
+    if (previous_hashes &&
+        std::binary_search(previous_hashes->begin(), previous_hashes->end(),
+                           span.hash)) {
+      delta.saved_bytes += span.size;
+    } else {
+      delta.changed_spans.push_back(span);
+    }
+    span_begin = span_end;
+  }
+
+  // Bytes after the last recorded op (if any) are always re-emitted.
+  if (span_begin < data.size()) {
+    Span tail;
+    tail.offset = span_begin;
+    tail.size = data.size() - span_begin;
+    tail.hash =
+        base::FastHash(base::as_bytes(data.subspan(tail.offset, tail.size)));
+    delta.changed_spans.push_back(tail);
+  }
+
+  std::sort(hashes.begin(), hashes.end());
+  entries_.Put(key, std::move(hashes));
+
+  total_bytes_ += delta.total_bytes;
+  total_saved_bytes_ += delta.saved_bytes;
+  return delta;
+}
+
+void PaintOpSpanCache::Purge(uint64_t key) {
+  auto it = entries_.Peek(key);
+  if (it != entries_.end()) {
+    entries_.Erase(it);
+  }
+}
+
+void PaintOpSpanCache::PurgeAll() {
+  entries_.Clear();
+}
+
+}  // namespace cc
@@ -0,0 +1,104 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_PAINT_PAINT_OP_SPAN_CACHE_H_
+#define CC_PAINT_PAINT_OP_SPAN_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/containers/lru_cache.h"
+#include "base/containers/span.h"
+#include "cc/paint/paint_export.h"
+
+namespace cc {
+
+// For out-of-process raster, every tile of a DisplayItemList is serialized and
+// sent to the GPU process on every commit, even when only a small part of the
+// recording changed.
+//
+// PaintOpSpanCache remembers what was serialized for a tile the last time it
+// was rastered. The serialized output is split into spans of consecutive
+// PaintOps, and each span is identified by a hash of its bytes. When the tile
+// is serialized again, spans whose bytes were already sent for that tile are
+// reported as unchanged, so that a transport which keeps prior chunks on the
+// service side only needs to re-emit the changed spans. Spans are matched by
+// content rather than position, so inserting or removing ops only invalidates
+// the spans that actually contain different bytes.
+//
+// Like ClientPaintCache, this class is a client side mirror of state that is
+// assumed to be retained by the receiver; callers must Purge() a key whenever
+// the receiver drops the corresponding chunks.
+//
+// This class is not thread-safe.
+class CC_PAINT_EXPORT PaintOpSpanCache {
+ public:
+  static constexpr size_t kDefaultMaxEntries = 256u;
+  static constexpr size_t kDefaultOpsPerSpan = 16u;
+
+  // A range of serialized bytes covering one or more whole PaintOps.
+  struct Span {
+    size_t offset = 0u;
+    size_t size = 0u;
+    size_t hash = 0u;
+  };
+
+  struct Delta {
+    Delta();
+    Delta(const Delta&) = delete;
+    Delta(Delta&&);
+    ~Delta();
+
+    Delta& operator=(const Delta&) = delete;
+    Delta& operator=(Delta&&);
+
+    // Spans whose contents were not part of the previous serialization for
+    // the key, in output order. These must be re-emitted.
+    std::vector<Span> changed_spans;
+    // Total bytes of the new serialization.
+    size_t total_bytes = 0u;
+    // Bytes covered by unchanged spans.
+    size_t saved_bytes = 0u;
+  };
+
+  explicit PaintOpSpanCache(size_t max_entries = kDefaultMaxEntries,
+                            size_t ops_per_span = kDefaultOpsPerSpan);
+  PaintOpSpanCache(const PaintOpSpanCache&) = delete;
+  PaintOpSpanCache& operator=(const PaintOpSpanCache&) = delete;
+  ~PaintOpSpanCache();
+
+  // Compares the serialized |data| for |key| against the previous
+  // serialization for |key| and records |data| as the new state.
+  // |op_end_offsets| holds the end offset in |data| of every serialized op, in
+  // increasing order, as recorded by SimpleBufferSerializer.
+  Delta Update(uint64_t key,
+               base::span<const char> data,
+               base::span<const size_t> op_end_offsets);
+
+  // Forgets the state for |key|, e.g. when the receiver discarded its chunks.
+  void Purge(uint64_t key);
+  void PurgeAll();
+
+  size_t size() const { return entries_.size(); }
+
+  // Totals over every Update() call.
+  size_t total_bytes() const { return total_bytes_; }
+  size_t total_saved_bytes() const { return total_saved_bytes_; }
+
+ private:
+  // Hashes of the spans sent for a key, sorted for lookup.
+  using SpanHashes = std::vector<size_t>;
+
+  const size_t ops_per_span_;
+  base::LRUCache<uint64_t, SpanHashes> entries_;
+
+  size_t total_bytes_ = 0u;
+  size_t total_saved_bytes_ = 0u;
+};
+
+}  // namespace cc
+
+#endif  // CC_PAINT_PAINT_OP_SPAN_CACHE_H_
@@ -0,0 +1,122 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/paint/paint_op_span_cache.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace cc {
+namespace {
+
+constexpr size_t kOpsPerSpan = 2u;
+constexpr uint64_t kKey = 1u;
+
+// Builds serialized data out of fixed size fake ops, one character per op.
+class FakeSerialization {
+ public:
+  static constexpr size_t kOpSize = 8u;
+
+  explicit FakeSerialization(const std::string& ops) {
+    for (char op : ops) {
+      data_.append(kOpSize, op);
+      op_end_offsets_.push_back(data_.size());
+    }
+  }
+
+  base::span<const char> data() const { return data_; }
+  base::span<const size_t> op_end_offsets() const { return op_end_offsets_; }
+
+ private:
+  std::string data_;
+  std::vector<size_t> op_end_offsets_;
+};
+
+TEST(PaintOpSpanCacheTest, FirstUpdateChangesEverything) {
+  PaintOpSpanCache cache(PaintOpSpanCache::kDefaultMaxEntries, kOpsPerSpan);
+  FakeSerialization serialization("abcde");
+
+  PaintOpSpanCache::Delta delta = cache.Update(
+      kKey, serialization.data(), serialization.op_end_offsets());
+  EXPECT_EQ(delta.total_bytes, 5 * FakeSerialization::kOpSize);
+  EXPECT_EQ(delta.saved_bytes, 0u);
+  ASSERT_EQ(delta.changed_spans.size(), 3u);
+  EXPECT_EQ(delta.changed_spans[0].offset, 0u);
+  EXPECT_EQ(delta.changed_spans[0].size, 2 * FakeSerialization::kOpSize);
+  EXPECT_EQ(delta.changed_spans[2].offset, 4 * FakeSerialization::kOpSize);
+  EXPECT_EQ(delta.changed_spans[2].size, FakeSerialization::kOpSize);
+}
+
+TEST(PaintOpSpanCacheTest, UnchangedSpansAreSaved) {
+  PaintOpSpanCache cache(PaintOpSpanCache::kDefaultMaxEntries, kOpsPerSpan);
+  FakeSerialization first("abcdef");
+  cache.Update(kKey, first.data(), first.op_end_offsets());
+
+  // Only the middle span changed.
+  FakeSerialization second("abXdef");
+  PaintOpSpanCache::Delta delta =
+      cache.Update(kKey, second.data(), second.op_end_offsets());
+  EXPECT_EQ(delta.saved_bytes, 4 * FakeSerialization::kOpSize);
+  ASSERT_EQ(delta.changed_spans.size(), 1u);
+  EXPECT_EQ(delta.changed_spans[0].offset, 2 * FakeSerialization::kOpSize);
+  EXPECT_EQ(cache.total_saved_bytes(), 4 * FakeSerialization::kOpSize);
+  EXPECT_EQ(cache.total_bytes(), 12 * FakeSerialization::kOpSize);
+}
+
+TEST(PaintOpSpanCacheTest, SpansMatchByContent) {
+  PaintOpSpanCache cache(PaintOpSpanCache::kDefaultMaxEntries, kOpsPerSpan);
+  FakeSerialization first("abcd");
+  cache.Update(kKey, first.data(), first.op_end_offsets());
+
+  // The previous spans moved but were sent before.
+  FakeSerialization second("XYabcd");
+  PaintOpSpanCache::Delta delta =
+      cache.Update(kKey, second.data(), second.op_end_offsets());
+  EXPECT_EQ(delta.saved_bytes, 4 * FakeSerialization::kOpSize);
+  ASSERT_EQ(delta.changed_spans.size(), 1u);
+  EXPECT_EQ(delta.changed_spans[0].offset, 0u);
+}
+
+TEST(PaintOpSpanCacheTest, KeysAreIndependent) {
+  PaintOpSpanCache cache(PaintOpSpanCache::kDefaultMaxEntries, kOpsPerSpan);
+  FakeSerialization serialization("abcd");
+  cache.Update(kKey, serialization.data(), serialization.op_end_offsets());
+
+  PaintOpSpanCache::Delta delta = cache.Update(
+      kKey + 1, serialization.data(), serialization.op_end_offsets());
+  EXPECT_EQ(delta.saved_bytes, 0u);
+  EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(PaintOpSpanCacheTest, Purge) {
+  PaintOpSpanCache cache(PaintOpSpanCache::kDefaultMaxEntries, kOpsPerSpan);
+  FakeSerialization serialization("abcd");
+  cache.Update(kKey, serialization.data(), serialization.op_end_offsets());
+  cache.Purge(kKey);
+  EXPECT_EQ(cache.size(), 0u);
+
+  PaintOpSpanCache::Delta delta = cache.Update(
+      kKey, serialization.data(), serialization.op_end_offsets());
+  EXPECT_EQ(delta.saved_bytes, 0u);
+
+  cache.PurgeAll();
+  EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(PaintOpSpanCacheTest, EvictsLeastRecentlyUsedKey) {
+  PaintOpSpanCache cache(/*max_entries=*/1u, kOpsPerSpan);
+  FakeSerialization serialization("abcd");
+  cache.Update(kKey, serialization.data(), serialization.op_end_offsets());
+  cache.Update(kKey + 1, serialization.data(), serialization.op_end_offsets());
+  EXPECT_EQ(cache.size(), 1u);
+
+  PaintOpSpanCache::Delta delta = cache.Update(
+      kKey, serialization.data(), serialization.op_end_offsets());
+  EXPECT_EQ(delta.saved_bytes, 0u);
+}
+
+}  // namespace
+}  // namespace cc
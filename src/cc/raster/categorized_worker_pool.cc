@@ -36,6 +36,17 @@ BASE_FEATURE(kUseCompositorJob,
              "UseCompositorJob",
              base::FEATURE_ENABLED_BY_DEFAULT);
 
+// Uses CategorizedWorkerPoolWorkStealing for the compositor worker pool. Takes
+// precedence over kUseCompositorJob.
+BASE_FEATURE(kUseWorkStealingCompositorWorkers,
+             "UseWorkStealingCompositorWorkers",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+// Upper bound on the number of tasks a work stealing worker moves from the
+// shared work queue into its deque at once. Also bounds how many completed
+// tasks a worker holds before reporting them.
+constexpr size_t kMaxTasksPerBatch = 4;
+
 // Task categories running at normal thread priority.
 constexpr TaskCategory kNormalThreadPriorityCategories[] = {
     TASK_CATEGORY_NONCONCURRENT_FOREGROUND, TASK_CATEGORY_FOREGROUND,
@@ -85,6 +96,35 @@ class CategorizedWorkerPoolThread : public base::SimpleThread {
   scoped_refptr<base::SingleThreadTaskRunner> background_task_runner_;
 };
 
+// A thread which forwards to CategorizedWorkerPoolWorkStealing::Run.
+class WorkStealingWorkerThread : public base::SimpleThread {
+ public:
+  WorkStealingWorkerThread(const std::string& name_prefix,
+                           const Options& options,
+                           CategorizedWorkerPoolWorkStealing* pool,
+                           int worker_index,
+                           std::vector<TaskCategory> categories,
+                           base::ConditionVariable* has_ready_to_run_tasks_cv)
+      : SimpleThread(name_prefix, options),
+        pool_(pool),
+        worker_index_(worker_index),
+        categories_(categories),
+        has_ready_to_run_tasks_cv_(has_ready_to_run_tasks_cv) {}
+
+  // base::SimpleThread:
+  void BeforeRun() override { pool_->ThreadWillRun(tid()); }
+
+  void Run() override {
+    pool_->Run(worker_index_, categories_, has_ready_to_run_tasks_cv_);
+  }
+
+ private:
+  const raw_ptr<CategorizedWorkerPoolWorkStealing> pool_;
+  const int worker_index_;
+  const std::vector<TaskCategory> categories_;
+  const raw_ptr<base::ConditionVariable> has_ready_to_run_tasks_cv_;
+};
+
 scoped_refptr<CategorizedWorkerPool>& GetWorkerPool() {
   static base::NoDestructor<scoped_refptr<CategorizedWorkerPool>> worker_pool;
   return *worker_pool;
@@ -671,6 +711,351 @@ size_t CategorizedWorkerPoolJob::GetMaxJobConcurrency(
   return num_foreground_tasks + num_background_tasks;
 }
 
+CategorizedWorkerPoolWorkStealing::WorkerQueue::WorkerQueue() = default;
+CategorizedWorkerPoolWorkStealing::WorkerQueue::~WorkerQueue() = default;
+
+CategorizedWorkerPoolWorkStealing::CategorizedWorkerPoolWorkStealing(
+    Delegate* delegate)
+    : delegate_(delegate),
+      has_task_for_normal_priority_thread_cv_(&lock_),
+      has_task_for_background_priority_thread_cv_(&lock_),
+      shutdown_(false) {
+  has_task_for_normal_priority_thread_cv_.declare_only_used_while_idle();
+  has_task_for_background_priority_thread_cv_.declare_only_used_while_idle();
+}
+
+CategorizedWorkerPoolWorkStealing::~CategorizedWorkerPoolWorkStealing() =
+    default;
+
+void CategorizedWorkerPoolWorkStealing::Start(int max_concurrency_foreground) {
+  DCHECK(threads_.empty());
+  DCHECK(worker_queues_.empty());
+
+  const size_t num_threads = max_concurrency_foreground + 1;
+  threads_.reserve(num_threads);
+
+  // The deques must all exist before any thread starts, since any worker may
+  // steal from any other.
+  worker_queues_.reserve(max_concurrency_foreground);
+  for (int i = 0; i < max_concurrency_foreground; i++) {
+    worker_queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+
+  std::vector<TaskCategory> normal_thread_prio_categories(
+      std::begin(kNormalThreadPriorityCategories),
+      std::end(kNormalThreadPriorityCategories));
+
+  for (int i = 0; i < max_concurrency_foreground; i++) {
+    auto thread = std::make_unique<WorkStealingWorkerThread>(
+        base::StringPrintf("CompositorTileWorker%d", i + 1),
+        base::SimpleThread::Options(), this, i, normal_thread_prio_categories,
+        &has_task_for_normal_priority_thread_cv_);
+    thread->StartAsync();
+    threads_.push_back(std::move(thread));
+  }
+
+  // The background priority thread runs one task at a time, so it neither
+  // owns a deque nor steals foreground work onto a background thread.
+  std::vector<TaskCategory> background_thread_prio_categories{
+      std::begin(kBackgroundThreadPriorityCategories),
+      std::end(kBackgroundThreadPriorityCategories)};
+
+  base::SimpleThread::Options thread_options;
+// TODO(crbug.com/40226019): Figure out whether !IS_MAC can be lifted here.
+#if !BUILDFLAG(IS_MAC)
+  thread_options.thread_type = base::ThreadType::kBackground;
+#endif
+
+  auto thread = std::make_unique<WorkStealingWorkerThread>(
+      "CompositorTileWorkerBackground", thread_options, this,
+      /*worker_index=*/-1, background_thread_prio_categories,
+      &has_task_for_background_priority_thread_cv_);
+  thread->StartAsync();
+  threads_.push_back(std::move(thread));
+
+  DCHECK_EQ(num_threads, threads_.size());
+}
+
+void CategorizedWorkerPoolWorkStealing::Shutdown() {
+  {
+    base::ScopedAllowBaseSyncPrimitivesOutsideBlockingScope allow_wait;
+    WaitForTasksToFinishRunning(namespace_token_);
+  }
+
+  CollectCompletedTasks(namespace_token_, &completed_tasks_);
+  {
+    base::AutoLock lock(lock_);
+
+    DCHECK(!work_queue_.HasReadyToRunTasks());
+    DCHECK(!work_queue_.HasAnyNamespaces());
+
+    DCHECK(!shutdown_);
+    shutdown_ = true;
+
+    has_task_for_normal_priority_thread_cv_.Broadcast();
+    has_task_for_background_priority_thread_cv_.Broadcast();
+  }
+  while (!threads_.empty()) {
+    threads_.back()->Join();
+    threads_.pop_back();
+  }
+  worker_queues_.clear();
+}
+
+void CategorizedWorkerPoolWorkStealing::ThreadWillRun(
+    base::PlatformThreadId tid) {
+  if (delegate_) {
+    delegate_->NotifyThreadWillRun(tid);
+  }
+}
+
+// Overridden from base::TaskRunner:
+bool CategorizedWorkerPoolWorkStealing::PostDelayedTask(
+    const base::Location& from_here,
+    base::OnceClosure task,
+    base::TimeDelta delay) {
+  base::AutoLock lock(lock_);
+
+  // Remove completed tasks.
+  DCHECK(completed_tasks_.empty());
+  CollectCompletedTasksWithLockAcquired(namespace_token_, &completed_tasks_);
+
+  std::erase_if(tasks_, [this](const scoped_refptr<Task>& e)
+                            EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+                              return base::Contains(this->completed_tasks_, e);
+                            });
+
+  tasks_.push_back(base::MakeRefCounted<ClosureTask>(std::move(task)));
+  graph_.Reset();
+  for (const auto& graph_task : tasks_) {
+    // Delayed tasks are assigned FOREGROUND category, ensuring that they run as
+    // soon as possible once their delay has expired.
+    graph_.nodes.push_back(
+        TaskGraph::Node(graph_task.get(), TASK_CATEGORY_FOREGROUND,
+                        0u /* priority */, 0u /* dependencies */));
+  }
+
+  DCHECK(!shutdown_);
+  work_queue_.ScheduleTasks(namespace_token_, &graph_);
+  SignalHasReadyToRunTasksWithLockAcquired();
+  completed_tasks_.clear();
+  return true;
+}
+
+void CategorizedWorkerPoolWorkStealing::ScheduleTasks(NamespaceToken token,
+                                                      TaskGraph* graph) {
+  TRACE_EVENT2("disabled-by-default-cc.debug",
+               "CategorizedWorkerPool::ScheduleTasks", "num_nodes",
+               graph->nodes.size(), "num_edges", graph->edges.size());
+  DCHECK(token.IsValid());
+  DCHECK(!TaskGraphWorkQueue::DependencyMismatch(graph));
+
+  base::AutoLock lock(lock_);
+  DCHECK(!shutdown_);
+  work_queue_.ScheduleTasks(token, graph);
+
+  // There may be more work available, so wake up another worker thread.
+  SignalHasReadyToRunTasksWithLockAcquired();
+}
+
+void CategorizedWorkerPoolWorkStealing::Run(
+    int worker_index,
+    const std::vector<TaskCategory>& categories,
+    base::ConditionVariable* has_ready_to_run_tasks_cv) {
+  // Tasks which finished running but have not been reported to |work_queue_|
+  // yet. They still count as running, so dependents and waiting origin threads
+  // only observe them once reported.
+  std::vector<TaskGraphWorkQueue::PrioritizedTask> completed_tasks;
+  completed_tasks.reserve(kMaxTasksPerBatch);
+
+  while (true) {
+    if (completed_tasks.size() >= kMaxTasksPerBatch) {
+      base::AutoLock lock(lock_);
+      CompleteTasksWithLockAcquired(&completed_tasks);
+    }
+
+    std::optional<TaskGraphWorkQueue::PrioritizedTask> prioritized_task =
+        TakeLocalTask(worker_index);
+
+    if (!prioritized_task) {
+      base::AutoLock lock(lock_);
+      CompleteTasksWithLockAcquired(&completed_tasks);
+      prioritized_task =
+          GetNextTaskToRunWithLockAcquired(worker_index, categories);
+      if (!prioritized_task) {
+        // We are no longer running tasks, which may allow another category to
+        // start running. Signal other worker threads.
+        SignalHasReadyToRunTasksWithLockAcquired();
+
+        // Make sure the END of the last trace event emitted before going idle
+        // is flushed to perfetto.
+        // TODO(crbug.com/40657156): Remove this once fixed.
+        PERFETTO_INTERNAL_ADD_EMPTY_EVENT();
+
+        // Exit when shutdown is set and no more tasks are pending.
+        if (shutdown_) {
+          break;
+        }
+
+        // Wait for more tasks.
+        has_ready_to_run_tasks_cv->Wait();
+        continue;
+      }
+    }
+
+    TRACE_EVENT(
+        "toplevel", "TaskGraphRunner::RunTask",
+        perfetto::Flow::Global(prioritized_task->task->trace_task_id()),
+        [&](perfetto::EventContext ctx) {
+          ctx.event<perfetto::protos::pbzero::ChromeTrackEvent>()
+              ->set_chrome_raster_task()
+              ->set_source_frame_number(prioritized_task->task->frame_number());
+        });
+
+    prioritized_task->task->RunOnWorkerThread();
+    completed_tasks.push_back(std::move(*prioritized_task));
+  }
+}
+
+void CategorizedWorkerPoolWorkStealing::FlushForTesting() {
+  base::AutoLock lock(lock_);
+
+  while (!work_queue_.HasFinishedRunningTasksInAllNamespaces()) {
+    has_namespaces_with_finished_running_tasks_cv_.Wait();
+  }
+}
+
+std::optional<TaskGraphWorkQueue::PrioritizedTask>
+CategorizedWorkerPoolWorkStealing::TakeLocalTask(int worker_index) {
+  if (worker_index < 0) {
+    return std::nullopt;
+  }
+
+  {
+    WorkerQueue* own_queue = worker_queues_[worker_index].get();
+    base::AutoLock queue_lock(own_queue->lock);
+    if (!own_queue->tasks.empty()) {
+      TaskGraphWorkQueue::PrioritizedTask task =
+          std::move(own_queue->tasks.front());
+      own_queue->tasks.pop_front();
+      return task;
+    }
+  }
+
+  // Steal the lowest priority task of a victim, leaving the tasks the victim
+  // would run next in place. Start with the next worker so that thieves spread
+  // out over victims.
+  const size_t num_queues = worker_queues_.size();
+  for (size_t i = 1; i < num_queues; ++i) {
+    WorkerQueue* victim_queue =
+        worker_queues_[(worker_index + i) % num_queues].get();
+    base::AutoLock queue_lock(victim_queue->lock);
+    if (!victim_queue->tasks.empty()) {
+      TaskGraphWorkQueue::PrioritizedTask task =
+          std::move(victim_queue->tasks.back());
+      victim_queue->tasks.pop_back();
+      return task;
+    }
+  }
+  return std::nullopt;
+}
+
+void CategorizedWorkerPoolWorkStealing::CompleteTasksWithLockAcquired(
+    std::vector<TaskGraphWorkQueue::PrioritizedTask>* completed_tasks) {
+  lock_.AssertAcquired();
+
+  bool has_finished_namespace = false;
+  for (auto& completed_task : *completed_tasks) {
+    auto* task_namespace = completed_task.task_namespace.get();
+    work_queue_.CompleteTask(std::move(completed_task));
+    has_finished_namespace |=
+        work_queue_.HasFinishedRunningTasksInNamespace(task_namespace);
+  }
+  completed_tasks->clear();
+
+  // If a namespace has finished running all tasks, wake up origin threads.
+  // WaitForTasksToFinishRunning() forwards the signal to other waiters.
+  if (has_finished_namespace) {
+    has_namespaces_with_finished_running_tasks_cv_.Signal();
+  }
+}
+
+std::optional<TaskGraphWorkQueue::PrioritizedTask>
+CategorizedWorkerPoolWorkStealing::GetNextTaskToRunWithLockAcquired(
+    int worker_index,
+    const std::vector<TaskCategory>& categories) {
+  lock_.AssertAcquired();
+
+  for (const auto& category : categories) {
+    if (!ShouldRunTaskForCategoryWithLockAcquired(category)) {
+      continue;
+    }
+
+    size_t batch_size = 1;
+    if (worker_index >= 0 && category == TASK_CATEGORY_FOREGROUND) {
+      batch_size = GetBatchSizeWithLockAcquired();
+    }
+
+    auto prioritized_task = work_queue_.GetNextTaskToRun(category);
+
+    // Work queue order is preserved in the deque, so the owner runs the batch
+    // in priority order.
+    size_t num_batched_tasks = 0;
+    if (batch_size > 1) {
+      WorkerQueue* own_queue = worker_queues_[worker_index].get();
+      base::AutoLock queue_lock(own_queue->lock);
+      while (num_batched_tasks + 1 < batch_size &&
+             work_queue_.HasReadyToRunTasksForCategory(category)) {
+        own_queue->tasks.push_back(work_queue_.GetNextTaskToRun(category));
+        ++num_batched_tasks;
+      }
+    }
+
+    // Wake up idle workers so they can steal the batched tasks.
+    for (size_t i = 0; i < num_batched_tasks; ++i) {
+      has_task_for_normal_priority_thread_cv_.Signal();
+    }
+
+    // There may be more work available, so wake up another worker thread.
+    SignalHasReadyToRunTasksWithLockAcquired();
+    return prioritized_task;
+  }
+  return std::nullopt;
+}
+
+size_t CategorizedWorkerPoolWorkStealing::GetBatchSizeWithLockAcquired()
+    const {
+  lock_.AssertAcquired();
+
+  // Take an even share of the ready tasks so that no worker starts with an
+  // empty deque while another holds a full one.
+  const size_t num_ready_tasks =
+      work_queue_.NumReadyTasksForCategory(TASK_CATEGORY_FOREGROUND);
+  return std::clamp<size_t>(num_ready_tasks / worker_queues_.size(), 1u,
+                            kMaxTasksPerBatch);
+}
+
+void CategorizedWorkerPoolWorkStealing::
+    SignalHasReadyToRunTasksWithLockAcquired() {
+  lock_.AssertAcquired();
+
+  for (TaskCategory category : kNormalThreadPriorityCategories) {
+    if (ShouldRunTaskForCategoryWithLockAcquired(category)) {
+      has_task_for_normal_priority_thread_cv_.Signal();
+      return;
+    }
+  }
+
+  // Due to the early return in the previous loop, this only runs when there are
+  // no tasks to run on normal priority threads.
+  for (TaskCategory category : kBackgroundThreadPriorityCategories) {
+    if (ShouldRunTaskForCategoryWithLockAcquired(category)) {
+      has_task_for_background_priority_thread_cv_.Signal();
+      return;
+    }
+  }
+}
+
 CategorizedWorkerPool* CategorizedWorkerPool::GetOrCreate(Delegate* delegate) {
   if (GetWorkerPool()) {
     return GetWorkerPool().get();
@@ -688,11 +1073,16 @@ CategorizedWorkerPool* CategorizedWorkerPool::GetOrCreate(Delegate* delegate) {
     CHECK_GT(num_raster_threads, 0);
   }
 
-  scoped_refptr<CategorizedWorkerPool> categorized_worker_pool =
-      base::FeatureList::IsEnabled(kUseCompositorJob)
-          ? scoped_refptr<CategorizedWorkerPool>(new CategorizedWorkerPoolJob())
-          : scoped_refptr<CategorizedWorkerPool>(
-                new CategorizedWorkerPoolImpl(delegate));
+  scoped_refptr<CategorizedWorkerPool> categorized_worker_pool;
+  if (base::FeatureList::IsEnabled(kUseWorkStealingCompositorWorkers)) {
+    categorized_worker_pool = base::MakeRefCounted<
+        CategorizedWorkerPoolWorkStealing>(delegate);
+  } else if (base::FeatureList::IsEnabled(kUseCompositorJob)) {
+    categorized_worker_pool = base::MakeRefCounted<CategorizedWorkerPoolJob>();
+  } else {
+    categorized_worker_pool =
+        base::MakeRefCounted<CategorizedWorkerPoolImpl>(delegate);
+  }
   categorized_worker_pool->Start(num_raster_threads);
   GetWorkerPool() = std::move(categorized_worker_pool);
   return GetWorkerPool().get();
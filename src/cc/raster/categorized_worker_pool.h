@@ -9,6 +9,7 @@
 #include <optional>
 #include <vector>
 
+#include "base/containers/circular_deque.h"
 #include "base/containers/span.h"
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
@@ -228,6 +229,100 @@ class CC_EXPORT CategorizedWorkerPoolJob : public CategorizedWorkerPool {
   base::JobHandle foreground_job_handle_;
 };
 
+// A CategorizedWorkerPool which gives every normal priority worker thread its
+// own deque of tasks. Workers move batches of ready TASK_CATEGORY_FOREGROUND
+// tasks out of the shared TaskGraphWorkQueue into their deque and report
+// completions back in batches, so the shared |lock_| is taken once per batch
+// instead of once per task. A worker whose deque is empty steals from the back
+// of another worker's deque before going back to the shared queue.
+//
+// Tasks pulled into a deque are considered running by the TaskGraphWorkQueue,
+// so TaskCategory concurrency rules (one background task at a time, background
+// tasks yield to foreground tasks, one nonconcurrent task at a time) and
+// dependency ordering are preserved. Categories other than
+// TASK_CATEGORY_FOREGROUND are never batched.
+class CC_EXPORT CategorizedWorkerPoolWorkStealing
+    : public CategorizedWorkerPool {
+ public:
+  explicit CategorizedWorkerPoolWorkStealing(Delegate* delegate = nullptr);
+
+  void ThreadWillRun(base::PlatformThreadId tid);
+
+  // Overridden from base::TaskRunner:
+  bool PostDelayedTask(const base::Location& from_here,
+                       base::OnceClosure task,
+                       base::TimeDelta delay) override;
+
+  // Overridden from TaskGraphRunner:
+  void ScheduleTasks(NamespaceToken token, TaskGraph* graph) override;
+
+  // Runs tasks from the provided categories until shutdown. |worker_index| is
+  // the index of the calling thread's deque, or -1 for threads which neither
+  // own a deque nor steal (the background priority thread).
+  void Run(int worker_index,
+           const std::vector<TaskCategory>& categories,
+           base::ConditionVariable* has_ready_to_run_tasks_cv);
+
+  // Overridden from CategorizedWorkerPool:
+  void FlushForTesting() override;
+  void Start(int max_concurrency_foreground) override;
+  void Shutdown() override;
+
+ private:
+  // Per-worker deque. The owner pops from the front, thieves from the back.
+  struct WorkerQueue {
+    WorkerQueue();
+    ~WorkerQueue();
+
+    base::Lock lock;
+    base::circular_deque<TaskGraphWorkQueue::PrioritizedTask> tasks
+        GUARDED_BY(lock);
+  };
+
+  ~CategorizedWorkerPoolWorkStealing() override;
+
+  // Pops the next task from the deque of |worker_index|, or steals one from
+  // another worker. Does not acquire |lock_|.
+  std::optional<TaskGraphWorkQueue::PrioritizedTask> TakeLocalTask(
+      int worker_index);
+
+  // Completes |completed_tasks| and clears the vector.
+  void CompleteTasksWithLockAcquired(
+      std::vector<TaskGraphWorkQueue::PrioritizedTask>* completed_tasks)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Returns the next task to run for |categories| from the shared work queue.
+  // If |worker_index| owns a deque, also moves a batch of ready foreground
+  // tasks into it.
+  std::optional<TaskGraphWorkQueue::PrioritizedTask>
+  GetNextTaskToRunWithLockAcquired(int worker_index,
+                                   const std::vector<TaskCategory>& categories)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Returns the number of tasks to move into a worker deque at once.
+  size_t GetBatchSizeWithLockAcquired() const EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Helper function which signals worker threads if tasks are ready to run.
+  void SignalHasReadyToRunTasksWithLockAcquired()
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  const raw_ptr<Delegate> delegate_;
+
+  // The actual threads where work is done.
+  std::vector<std::unique_ptr<base::SimpleThread>> threads_;
+
+  // One deque per normal priority thread. Sized in Start() and not resized
+  // until Shutdown() has joined all threads.
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+
+  // Condition variables for foreground and background threads.
+  base::ConditionVariable has_task_for_normal_priority_thread_cv_;
+  base::ConditionVariable has_task_for_background_priority_thread_cv_;
+
+  // Set during shutdown. Tells Run() to return when no more tasks are pending.
+  bool shutdown_ GUARDED_BY(lock_);
+};
+
 }  // namespace cc
 
 #endif  // CC_RASTER_CATEGORIZED_WORKER_POOL_H_
@@ -201,6 +201,10 @@ INSTANTIATE_TYPED_TEST_SUITE_P(
     CategorizedWorkerPoolJob,
     TaskRunnerTest,
     cc::CategorizedWorkerPoolTestDelegate<cc::CategorizedWorkerPoolJob>);
+INSTANTIATE_TYPED_TEST_SUITE_P(CategorizedWorkerPoolWorkStealing,
+                               TaskRunnerTest,
+                               cc::CategorizedWorkerPoolTestDelegate<
+                                   cc::CategorizedWorkerPoolWorkStealing>);
 
 INSTANTIATE_TYPED_TEST_SUITE_P(CategorizedWorkerPoolImpl,
                                SequencedTaskRunnerTest,
@@ -210,6 +214,10 @@ INSTANTIATE_TYPED_TEST_SUITE_P(CategorizedWorkerPoolJob,
                                SequencedTaskRunnerTest,
                                cc::CategorizedWorkerPoolSequencedTestDelegate<
                                    cc::CategorizedWorkerPoolJob>);
+INSTANTIATE_TYPED_TEST_SUITE_P(CategorizedWorkerPoolWorkStealing,
+                               SequencedTaskRunnerTest,
+                               cc::CategorizedWorkerPoolSequencedTestDelegate<
+                                   cc::CategorizedWorkerPoolWorkStealing>);
 
 }  // namespace base
 
@@ -257,6 +265,26 @@ INSTANTIATE_TYPED_TEST_SUITE_P(
     CategorizedWorkerPoolJob_1_5_Threads,
     TaskGraphRunnerTest,
     CategorizedWorkerPoolJobTaskGraphRunnerTestDelegate_1_5);
+using CategorizedWorkerPoolWorkStealingTaskGraphRunnerTestDelegate_1_5 =
+    ::testing::Types<CategorizedWorkerPoolTaskGraphRunnerTestDelegate<
+                         CategorizedWorkerPoolWorkStealing,
+                         1>,
+                     CategorizedWorkerPoolTaskGraphRunnerTestDelegate<
+                         CategorizedWorkerPoolWorkStealing,
+                         2>,
+                     CategorizedWorkerPoolTaskGraphRunnerTestDelegate<
+                         CategorizedWorkerPoolWorkStealing,
+                         3>,
+                     CategorizedWorkerPoolTaskGraphRunnerTestDelegate<
+                         CategorizedWorkerPoolWorkStealing,
+                         4>,
+                     CategorizedWorkerPoolTaskGraphRunnerTestDelegate<
+                         CategorizedWorkerPoolWorkStealing,
+                         5>>;
+INSTANTIATE_TYPED_TEST_SUITE_P(
+    CategorizedWorkerPoolWorkStealing_1_5_Threads,
+    TaskGraphRunnerTest,
+    CategorizedWorkerPoolWorkStealingTaskGraphRunnerTestDelegate_1_5);
 
 // Single threaded tests.
 using CategorizedWorkerPoolImplTaskGraphRunnerTestDelegate =
@@ -273,5 +301,13 @@ INSTANTIATE_TYPED_TEST_SUITE_P(
     CategorizedWorkerPoolJob,
     SingleThreadTaskGraphRunnerTest,
     CategorizedWorkerPoolJobTaskGraphRunnerTestDelegate);
+using CategorizedWorkerPoolWorkStealingTaskGraphRunnerTestDelegate =
+    CategorizedWorkerPoolTaskGraphRunnerTestDelegate<
+        CategorizedWorkerPoolWorkStealing,
+        1>;
+INSTANTIATE_TYPED_TEST_SUITE_P(
+    CategorizedWorkerPoolWorkStealing,
+    SingleThreadTaskGraphRunnerTest,
+    CategorizedWorkerPoolWorkStealingTaskGraphRunnerTestDelegate);
 
 }  // namespace cc
@@ -11,6 +11,7 @@
 #include <utility>
 
 #include "base/debug/alias.h"
+#include "base/feature_list.h"
 #include "base/memory/raw_ptr.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/task/sequenced_task_runner.h"
@@ -161,10 +162,15 @@ OneCopyRasterBufferProvider::OneCopyRasterBufferProvider(
       bytes_scheduled_since_last_flush_(0),
       tile_format_(raster_caps.tile_format),
       tile_overlay_candidate_(raster_caps.tile_overlay_candidate),
-      staging_pool_(std::move(task_runner),
-                    worker_context_provider,
-                    use_partial_raster,
-                    max_staging_buffer_usage_in_bytes) {
+      staging_pool_(
+          base::FeatureList::IsEnabled(features::kSharedStagingBufferPool)
+              ? StagingBufferPool::GetOrCreateShared(
+                    std::move(task_runner), worker_context_provider,
+                    use_partial_raster, max_staging_buffer_usage_in_bytes)
+              : base::MakeRefCounted<StagingBufferPool>(
+                    std::move(task_runner), worker_context_provider,
+                    use_partial_raster, max_staging_buffer_usage_in_bytes)),
+      staging_pool_client_id_(staging_pool_->GenerateClientId()) {
   DCHECK(compositor_context_provider);
   DCHECK(worker_context_provider);
   DCHECK(!tile_format_.IsCompressed());
@@ -207,6 +213,11 @@ viz::SharedImageFormat OneCopyRasterBufferProvider::GetFormat() const {
   return tile_format_;
 }
 
+bool OneCopyRasterBufferProvider::SupportsReducedMemoryTileFormats() const {
+  // Tiles are played back into memory, which dithers 16-bit formats.
+  return true;
+}
+
 bool OneCopyRasterBufferProvider::IsResourcePremultiplied() const {
   // TODO(ericrk): Handle unpremultiply/dither in one-copy case as well.
   // https://crbug.com/789153
@@ -267,7 +278,9 @@ void OneCopyRasterBufferProvider::SetShutdownEvent(
 }
 
 void OneCopyRasterBufferProvider::Shutdown() {
-  staging_pool_.Shutdown();
+  // A shared pool keeps its buffers for the providers still using it.
+  if (staging_pool_->HasOneRef())
+    staging_pool_->Shutdown();
 }
 
 gpu::SyncToken OneCopyRasterBufferProvider::PlaybackAndCopyOnWorkerThread(
@@ -286,8 +299,9 @@ gpu::SyncToken OneCopyRasterBufferProvider::PlaybackAndCopyOnWorkerThread(
     uint64_t new_content_id,
     bool& should_destroy_shared_image) {
   std::unique_ptr<StagingBuffer> staging_buffer =
-      staging_pool_.AcquireStagingBuffer(resource_size, format,
-                                         previous_content_id);
+      staging_pool_->AcquireStagingBuffer(resource_size, format,
+                                          previous_content_id,
+                                          staging_pool_client_id_);
   DCHECK(staging_buffer->size.width() >= raster_full_rect.width() &&
          staging_buffer->size.height() >= raster_full_rect.height());
 
@@ -311,7 +325,7 @@ gpu::SyncToken OneCopyRasterBufferProvider::PlaybackAndCopyOnWorkerThread(
     should_destroy_shared_image = true;
   }
 
-  staging_pool_.ReleaseStagingBuffer(std::move(staging_buffer));
+  staging_pool_->ReleaseStagingBuffer(std::move(staging_buffer));
   return sync_token_after_upload;
 }
 
@@ -57,6 +57,7 @@ class CC_EXPORT OneCopyRasterBufferProvider : public RasterBufferProvider {
   viz::SharedImageFormat GetFormat() const override;
   bool IsResourcePremultiplied() const override;
   bool CanPartialRasterIntoProvidedResource() const override;
+  bool SupportsReducedMemoryTileFormats() const override;
   bool IsResourceReadyToDraw(
       const ResourcePool::InUsePoolResource& resource) override;
   uint64_t SetReadyToDrawCallback(
@@ -164,7 +165,8 @@ class CC_EXPORT OneCopyRasterBufferProvider : public RasterBufferProvider {
   const viz::SharedImageFormat tile_format_;
   const bool tile_overlay_candidate_;
 
-  StagingBufferPool staging_pool_;
+  const scoped_refptr<StagingBufferPool> staging_pool_;
+  const uint32_t staging_pool_client_id_;
 };
 
 }  // namespace cc
@@ -34,6 +34,7 @@ namespace {
 
 bool IsSupportedPlaybackToMemoryFormat(viz::SharedImageFormat format) {
   return (format == viz::SinglePlaneFormat::kRGBA_4444) ||
+         (format == viz::SinglePlaneFormat::kRGB_565) ||
          (format == viz::SinglePlaneFormat::kRGBA_8888) ||
          (format == viz::SinglePlaneFormat::kBGRA_8888) ||
          (format == viz::SinglePlaneFormat::kRGBA_F16);
@@ -94,7 +95,12 @@ void RasterBufferProvider::PlaybackToMemory(
     return;
   }
 
-  if (format == viz::SinglePlaneFormat::kRGBA_4444) {
+  if ((format == viz::SinglePlaneFormat::kRGBA_4444) ||
+      (format == viz::SinglePlaneFormat::kRGB_565)) {
+    // kRGB_565 tiles are rastered at 8 bits per channel so that the
+    // conversion below can dither them.
+    if (format == viz::SinglePlaneFormat::kRGB_565)
+      info = info.makeColorType(kN32_SkColorType);
     sk_sp<SkSurface> surface = SkSurfaces::Raster(info, &surface_props);
     // TODO(reveman): Improve partial raster support by reducing the size of
     // playback rect passed to PlaybackToCanvas. crbug.com/519070
@@ -106,6 +112,9 @@ void RasterBufferProvider::PlaybackToMemory(
                  "RasterBufferProvider::PlaybackToMemory::ConvertRGBA4444");
     SkImageInfo dst_info =
         info.makeColorType(ToClosestSkColorType(gpu_compositing, format));
+    // kRGB_565 has no alpha and is only used for opaque tiles.
+    if (format == viz::SinglePlaneFormat::kRGB_565)
+      dst_info = dst_info.makeAlphaType(kOpaque_SkAlphaType);
     auto dst_canvas =
         SkCanvas::MakeRasterDirect(dst_info, memory, stride, &surface_props);
     DCHECK(dst_canvas);
@@ -69,6 +69,10 @@ class CC_EXPORT RasterBufferProvider {
   // the Resource provided in AcquireBufferForRaster.
   virtual bool CanPartialRasterIntoProvidedResource() const = 0;
 
+  // Returns true if resources acquired with the dithered 16-bit formats
+  // kRGBA_4444 and kRGB_565 can be rastered into, in addition to GetFormat().
+  virtual bool SupportsReducedMemoryTileFormats() const { return false; }
+
   // Returns true if the indicated resource is ready to draw.
   virtual bool IsResourceReadyToDraw(
       const ResourcePool::InUsePoolResource& resource) = 0;
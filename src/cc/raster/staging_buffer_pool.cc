@@ -7,9 +7,11 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/containers/contains.h"
 #include "base/functional/bind.h"
+#include "base/no_destructor.h"
 #include "base/ranges/algorithm.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/sequenced_task_runner.h"
@@ -69,6 +71,28 @@ void WaitForQueryResult(gpu::raster::RasterInterface* ri, GLuint query_id) {
   ri->GetQueryObjectuivEXT(query_id, GL_QUERY_RESULT_EXT, &result);
 }
 
+// A pool returned by StagingBufferPool::GetOrCreateShared(), along with the
+// arguments it was created with.
+struct SharedPoolEntry {
+  raw_ptr<base::SequencedTaskRunner> task_runner;
+  raw_ptr<viz::RasterContextProvider> worker_context_provider;
+  bool use_partial_raster;
+  int max_staging_buffer_usage_in_bytes;
+  raw_ptr<StagingBufferPool> pool;
+};
+
+base::Lock& GetSharedPoolsLock() {
+  static base::NoDestructor<base::Lock> lock;
+  return *lock;
+}
+
+// Shared pools remove themselves from this list when they are destroyed.
+std::vector<SharedPoolEntry>& GetSharedPools()
+    EXCLUSIVE_LOCKS_REQUIRED(GetSharedPoolsLock()) {
+  static base::NoDestructor<std::vector<SharedPoolEntry>> pools;
+  return *pools;
+}
+
 }  // namespace
 
 StagingBuffer::StagingBuffer(const gfx::Size& size,
@@ -128,6 +152,50 @@ StagingBufferPool::StagingBufferPool(
 StagingBufferPool::~StagingBufferPool() {
   base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
       this);
+
+  if (is_shared_) {
+    base::AutoLock lock(GetSharedPoolsLock());
+    std::erase_if(GetSharedPools(), [this](const SharedPoolEntry& entry) {
+      return entry.pool == this;
+    });
+  }
+}
+
+// static
+scoped_refptr<StagingBufferPool> StagingBufferPool::GetOrCreateShared(
+    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    viz::RasterContextProvider* worker_context_provider,
+    bool use_partial_raster,
+    int max_staging_buffer_usage_in_bytes) {
+  DCHECK(task_runner->RunsTasksInCurrentSequence());
+
+  // A shared pool is only created and destroyed on its task runner, so the
+  // pool found here can't be getting destroyed concurrently.
+  base::AutoLock lock(GetSharedPoolsLock());
+  std::vector<SharedPoolEntry>& pools = GetSharedPools();
+  auto it = base::ranges::find_if(pools, [&](const SharedPoolEntry& entry) {
+    return entry.task_runner == task_runner.get() &&
+           entry.worker_context_provider == worker_context_provider &&
+           entry.use_partial_raster == use_partial_raster &&
+           entry.max_staging_buffer_usage_in_bytes ==
+               max_staging_buffer_usage_in_bytes;
+  });
+  if (it != pools.end())
+    return base::WrapRefCounted(it->pool.get());
+
+  base::SequencedTaskRunner* task_runner_ptr = task_runner.get();
+  auto pool = base::MakeRefCounted<StagingBufferPool>(
+      std::move(task_runner), worker_context_provider, use_partial_raster,
+      max_staging_buffer_usage_in_bytes);
+  pool->is_shared_ = true;
+  pools.push_back({task_runner_ptr, worker_context_provider, use_partial_raster,
+                   max_staging_buffer_usage_in_bytes, pool.get()});
+  return pool;
+}
+
+uint32_t StagingBufferPool::GenerateClientId() {
+  base::AutoLock lock(lock_);
+  return next_client_id_++;
 }
 
 void StagingBufferPool::Shutdown() {
@@ -209,7 +277,8 @@ void StagingBufferPool::MarkStagingBufferAsBusy(
 std::unique_ptr<StagingBuffer> StagingBufferPool::AcquireStagingBuffer(
     const gfx::Size& size,
     viz::SharedImageFormat format,
-    uint64_t previous_content_id) {
+    uint64_t previous_content_id,
+    uint32_t client_id) {
   base::AutoLock lock(lock_);
 
   std::unique_ptr<StagingBuffer> staging_buffer;
@@ -258,8 +327,13 @@ std::unique_ptr<StagingBuffer> StagingBufferPool::AcquireStagingBuffer(
 
   // Find a staging buffer that allows us to perform partial raster if possible.
   if (use_partial_raster_ && previous_content_id) {
-    StagingBufferDeque::iterator it = base::ranges::find(
-        free_buffers_, previous_content_id, &StagingBuffer::content_id);
+    StagingBufferDeque::iterator it = base::ranges::find_if(
+        free_buffers_,
+        [previous_content_id,
+         client_id](const std::unique_ptr<StagingBuffer>& buffer) {
+          return buffer->content_id == previous_content_id &&
+                 buffer->client_id == client_id;
+        });
     if (it != free_buffers_.end()) {
       staging_buffer = std::move(*it);
       free_buffers_.erase(it);
@@ -298,6 +372,7 @@ std::unique_ptr<StagingBuffer> StagingBufferPool::AcquireStagingBuffer(
     free_buffers_.pop_front();
   }
 
+  staging_buffer->client_id = client_id;
   return staging_buffer;
 }
 
@@ -13,6 +13,7 @@
 #include "base/containers/circular_deque.h"
 #include "base/memory/memory_pressure_listener.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/synchronization/lock.h"
 #include "base/task/sequenced_task_runner.h"
@@ -69,35 +70,61 @@ struct StagingBuffer {
   // retrieve staging buffer with known content for reuse for partial raster.
   uint64_t content_id = 0;
 
+  // Id of the pool client that last acquired this staging buffer. Content ids
+  // are only unique per client.
+  uint32_t client_id = 0;
+
   // Whether the underlying buffer is shared memory or GPU native.
   bool is_shared_memory = false;
 };
 
 class CC_EXPORT StagingBufferPool final
-    : public base::trace_event::MemoryDumpProvider {
+    : public base::RefCountedThreadSafe<StagingBufferPool>,
+      public base::trace_event::MemoryDumpProvider {
  public:
   StagingBufferPool(scoped_refptr<base::SequencedTaskRunner> task_runner,
                     viz::RasterContextProvider* worker_context_provider,
                     bool use_partial_raster,
                     int max_staging_buffer_usage_in_bytes);
   StagingBufferPool(const StagingBufferPool&) = delete;
-  ~StagingBufferPool() final;
 
   StagingBufferPool& operator=(const StagingBufferPool&) = delete;
 
+  // Returns the pool shared by every client that passes the same arguments,
+  // creating it if there is none. This lets the compositors of a process that
+  // share a worker context recycle each other's staging buffers, bounded by a
+  // single |max_staging_buffer_usage_in_bytes|. Must be called on
+  // |task_runner|, and the returned pool must be released on it.
+  static scoped_refptr<StagingBufferPool> GetOrCreateShared(
+      scoped_refptr<base::SequencedTaskRunner> task_runner,
+      viz::RasterContextProvider* worker_context_provider,
+      bool use_partial_raster,
+      int max_staging_buffer_usage_in_bytes);
+
+  // Returns a new id identifying a client of this pool in
+  // AcquireStagingBuffer().
+  uint32_t GenerateClientId();
+
   void Shutdown();
 
   // Overridden from base::trace_event::MemoryDumpProvider:
   bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
                     base::trace_event::ProcessMemoryDump* pmd) override;
 
+  // Only staging buffers last acquired by |client_id| are reused for partial
+  // raster of |previous_content_id|.
   std::unique_ptr<StagingBuffer> AcquireStagingBuffer(
       const gfx::Size& size,
       viz::SharedImageFormat format,
-      uint64_t previous_content_id);
+      uint64_t previous_content_id,
+      uint32_t client_id);
   void ReleaseStagingBuffer(std::unique_ptr<StagingBuffer> staging_buffer);
 
  private:
+  friend class base::RefCountedThreadSafe<StagingBufferPool>;
+
+  ~StagingBufferPool() final;
+
   void AddStagingBuffer(const StagingBuffer* staging_buffer,
                         viz::SharedImageFormat format)
       EXCLUSIVE_LOCKS_REQUIRED(lock_);
@@ -125,6 +152,8 @@ class CC_EXPORT StagingBufferPool final
   scoped_refptr<base::SequencedTaskRunner> task_runner_;
   const raw_ptr<viz::RasterContextProvider> worker_context_provider_;
   const bool use_partial_raster_;
+  // Set for pools returned by GetOrCreateShared().
+  bool is_shared_ = false;
 
   mutable base::Lock lock_;
   // |lock_| must be acquired when accessing the following members.
@@ -141,6 +170,7 @@ class CC_EXPORT StagingBufferPool final
   const base::TimeDelta staging_buffer_expiration_delay_ GUARDED_BY(lock_);
   bool reduce_memory_usage_pending_ GUARDED_BY(lock_);
   base::RepeatingClosure reduce_memory_usage_callback_ GUARDED_BY(lock_);
+  uint32_t next_client_id_ GUARDED_BY(lock_) = 1u;
 
   std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
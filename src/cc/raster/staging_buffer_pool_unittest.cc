@@ -18,7 +18,7 @@ TEST(StagingBufferPoolTest, ShutdownImmediatelyAfterCreation) {
   int max_staging_buffer_usage_in_bytes = 1024;
   auto task_runner = base::SingleThreadTaskRunner::GetCurrentDefault();
   // Create a StagingBufferPool and immediately shut it down.
-  auto pool = std::make_unique<StagingBufferPool>(
+  auto pool = base::MakeRefCounted<StagingBufferPool>(
       task_runner.get(), context_provider.get(), use_partial_raster,
       max_staging_buffer_usage_in_bytes);
   pool->Shutdown();
@@ -44,4 +44,33 @@ TEST(StagingBufferPoolTest, ShutdownImmediatelyAfterCreation) {
   // No crash.
 }
 
+TEST(StagingBufferPoolTest, SharedPoolIsReusedByMatchingClients) {
+  auto context_provider = viz::TestContextProvider::CreateWorker();
+  auto other_context_provider = viz::TestContextProvider::CreateWorker();
+  auto task_runner = base::SingleThreadTaskRunner::GetCurrentDefault();
+  const int max_staging_buffer_usage_in_bytes = 1024;
+
+  scoped_refptr<StagingBufferPool> pool = StagingBufferPool::GetOrCreateShared(
+      task_runner, context_provider.get(), /*use_partial_raster=*/false,
+      max_staging_buffer_usage_in_bytes);
+  EXPECT_EQ(pool, StagingBufferPool::GetOrCreateShared(
+                      task_runner, context_provider.get(),
+                      /*use_partial_raster=*/false,
+                      max_staging_buffer_usage_in_bytes));
+  EXPECT_NE(pool, StagingBufferPool::GetOrCreateShared(
+                      task_runner, other_context_provider.get(),
+                      /*use_partial_raster=*/false,
+                      max_staging_buffer_usage_in_bytes));
+  EXPECT_NE(pool, StagingBufferPool::GetOrCreateShared(
+                      task_runner, context_provider.get(),
+                      /*use_partial_raster=*/true,
+                      max_staging_buffer_usage_in_bytes));
+  EXPECT_TRUE(pool->HasOneRef());
+
+  // Every client of the shared pool gets its own id.
+  EXPECT_NE(pool->GenerateClientId(), pool->GenerateClientId());
+
+  pool->Shutdown();
+}
+
 }  // namespace cc
@@ -9,10 +9,13 @@
 #include <vector>
 
 #include "base/memory/ptr_util.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/time/time.h"
 #include "base/timer/lap_timer.h"
 #include "cc/base/completion_event.h"
+#include "cc/raster/categorized_worker_pool.h"
 #include "cc/raster/synchronous_task_graph_runner.h"
+#include "cc/raster/task_category.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_result_reporter.h"
 
@@ -40,6 +43,31 @@ class PerfTaskImpl : public Task {
   ~PerfTaskImpl() override = default;
 };
 
+// Task which keeps a worker busy for a short amount of time, roughly the cost
+// of a small raster task, so that workers compete for the work queue.
+class BusyTaskImpl : public Task {
+ public:
+  typedef std::vector<scoped_refptr<BusyTaskImpl>> Vector;
+
+  explicit BusyTaskImpl(base::TimeDelta duration) : duration_(duration) {}
+  BusyTaskImpl(const BusyTaskImpl&) = delete;
+  BusyTaskImpl& operator=(const BusyTaskImpl&) = delete;
+
+  // Overridden from Task:
+  void RunOnWorkerThread() override {
+    base::TimeTicks end = base::TimeTicks::Now() + duration_;
+    while (base::TimeTicks::Now() < end) {
+    }
+  }
+
+  void Reset() { state().Reset(); }
+
+ private:
+  ~BusyTaskImpl() override = default;
+
+  const base::TimeDelta duration_;
+};
+
 class TaskGraphRunnerPerfTest : public testing::Test {
  public:
   TaskGraphRunnerPerfTest()
@@ -277,6 +305,100 @@ class TaskGraphRunnerPerfTest : public testing::Test {
   base::LapTimer timer_;
 };
 
+enum class WorkerPoolType { kImpl, kWorkStealing };
+
+// Measures how many graphs of independent foreground tasks per second a
+// threaded CategorizedWorkerPool gets through when many workers contend for
+// the same work queue.
+class CategorizedWorkerPoolPerfTest
+    : public testing::TestWithParam<WorkerPoolType> {
+ public:
+  CategorizedWorkerPoolPerfTest()
+      : timer_(kWarmupRuns,
+               base::Milliseconds(kTimeLimitMillis),
+               kTimeCheckInterval) {}
+
+  // Overridden from testing::Test:
+  void SetUp() override {
+    switch (GetParam()) {
+      case WorkerPoolType::kImpl:
+        worker_pool_ = base::MakeRefCounted<CategorizedWorkerPoolImpl>();
+        break;
+      case WorkerPoolType::kWorkStealing:
+        worker_pool_ =
+            base::MakeRefCounted<CategorizedWorkerPoolWorkStealing>();
+        break;
+    }
+    worker_pool_->Start(kNumWorkerThreads);
+    namespace_token_ = worker_pool_->GenerateNamespaceToken();
+  }
+  void TearDown() override {
+    Task::Vector completed_tasks;
+    worker_pool_->CollectCompletedTasks(namespace_token_, &completed_tasks);
+    worker_pool_->Shutdown();
+    worker_pool_ = nullptr;
+  }
+
+  void RunContendedExecuteTasksTest(const std::string& test_name,
+                                    int num_tasks,
+                                    base::TimeDelta task_duration) {
+    BusyTaskImpl::Vector tasks;
+    for (int i = 0; i < num_tasks; ++i) {
+      tasks.push_back(base::MakeRefCounted<BusyTaskImpl>(task_duration));
+    }
+
+    TaskGraph graph;
+    Task::Vector completed_tasks;
+
+    timer_.Reset();
+    do {
+      graph.Reset();
+      for (auto& task : tasks) {
+        task->Reset();
+        graph.nodes.emplace_back(task, TASK_CATEGORY_FOREGROUND, 0u, 0u);
+      }
+      worker_pool_->ScheduleTasks(namespace_token_, &graph);
+      worker_pool_->WaitForTasksToFinishRunning(namespace_token_);
+      worker_pool_->CollectCompletedTasks(namespace_token_, &completed_tasks);
+      DCHECK_EQ(tasks.size(), completed_tasks.size());
+      completed_tasks.clear();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PerfResultReporter reporter("", test_name);
+    reporter.RegisterImportantMetric(MetricName(), "runs/s");
+    reporter.AddResult(MetricName(), timer_.LapsPerSecond());
+  }
+
+ private:
+  static constexpr int kNumWorkerThreads = 8;
+
+  static std::string MetricName() {
+    switch (GetParam()) {
+      case WorkerPoolType::kImpl:
+        return "contended_execute_tasks_categorized_worker_pool";
+      case WorkerPoolType::kWorkStealing:
+        return "contended_execute_tasks_work_stealing_worker_pool";
+    }
+  }
+
+  scoped_refptr<CategorizedWorkerPool> worker_pool_;
+  NamespaceToken namespace_token_;
+  base::LapTimer timer_;
+};
+
+TEST_P(CategorizedWorkerPoolPerfTest, ContendedExecuteTasks) {
+  RunContendedExecuteTasksTest("64_tasks_0us", 64, base::TimeDelta());
+  RunContendedExecuteTasksTest("256_tasks_0us", 256, base::TimeDelta());
+  RunContendedExecuteTasksTest("256_tasks_5us", 256, base::Microseconds(5));
+  RunContendedExecuteTasksTest("1024_tasks_5us", 1024, base::Microseconds(5));
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         CategorizedWorkerPoolPerfTest,
+                         testing::Values(WorkerPoolType::kImpl,
+                                         WorkerPoolType::kWorkStealing));
+
 TEST_F(TaskGraphRunnerPerfTest, BuildTaskGraph) {
   RunBuildTaskGraphTest("0_1_0", 0, 1, 0);
   RunBuildTaskGraphTest("0_32_0", 0, 32, 0);
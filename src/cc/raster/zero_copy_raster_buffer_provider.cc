@@ -201,6 +201,11 @@ viz::SharedImageFormat ZeroCopyRasterBufferProvider::GetFormat() const {
   return tile_format_;
 }
 
+bool ZeroCopyRasterBufferProvider::SupportsReducedMemoryTileFormats() const {
+  // Tiles are played back into memory, which dithers 16-bit formats.
+  return true;
+}
+
 bool ZeroCopyRasterBufferProvider::IsResourcePremultiplied() const {
   return true;
 }
@@ -0,0 +1,143 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/scheduler/frame_stage_latency_recorder.h"
+
+#include "base/check_op.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/notreached.h"
+#include "base/trace_event/trace_id_helper.h"
+#include "base/trace_event/typed_macros.h"
+#include "third_party/perfetto/include/perfetto/tracing/track.h"
+
+namespace cc {
+
+namespace {
+
+// Only a small fraction of the samples is reported to UMA, as stages are
+// recorded several times per frame.
+constexpr double kHistogramSamplingFrequency = 0.01;
+
+constexpr base::TimeDelta kHistogramMin = base::Microseconds(1);
+constexpr base::TimeDelta kHistogramMax = base::Milliseconds(350);
+constexpr size_t kHistogramBucketCount = 50;
+
+const char* StageToHistogramName(FrameStageLatencyRecorder::Stage stage) {
+  using Stage = FrameStageLatencyRecorder::Stage;
+  switch (stage) {
+    case Stage::kBeginMainFrame:
+      return "Compositing.Scheduler.StageLatency.BeginMainFrame";
+    case Stage::kCommit:
+      return "Compositing.Scheduler.StageLatency.Commit";
+    case Stage::kRasterWait:
+      return "Compositing.Scheduler.StageLatency.RasterWait";
+    case Stage::kActivation:
+      return "Compositing.Scheduler.StageLatency.Activation";
+    case Stage::kDraw:
+      return "Compositing.Scheduler.StageLatency.Draw";
+    case Stage::kSubmit:
+      return "Compositing.Scheduler.StageLatency.Submit";
+  }
+  NOTREACHED();
+}
+
+}  // namespace
+
+FrameStageLatencyRecorder::FrameStageLatencyRecorder() = default;
+
+FrameStageLatencyRecorder::~FrameStageLatencyRecorder() = default;
+
+// static
+const char* FrameStageLatencyRecorder::StageToString(Stage stage) {
+  switch (stage) {
+    case Stage::kBeginMainFrame:
+      return "BeginMainFrame";
+    case Stage::kCommit:
+      return "Commit";
+    case Stage::kRasterWait:
+      return "RasterWait";
+    case Stage::kActivation:
+      return "Activation";
+    case Stage::kDraw:
+      return "Draw";
+    case Stage::kSubmit:
+      return "Submit";
+  }
+  NOTREACHED();
+}
+
+void FrameStageLatencyRecorder::StageStarted(Stage stage,
+                                             base::TimeTicks now) {
+  DCHECK(!now.is_null());
+  stage_start_times_[static_cast<size_t>(stage)] = now;
+}
+
+void FrameStageLatencyRecorder::StageEnded(Stage stage, base::TimeTicks now) {
+  base::TimeTicks& start_time = stage_start_times_[static_cast<size_t>(stage)];
+  if (start_time.is_null())
+    return;
+
+  DCHECK_GE(now, start_time);
+  Sample sample;
+  sample.stage = stage;
+  sample.start_time = start_time;
+  sample.duration = now - start_time;
+  start_time = base::TimeTicks();
+
+  AddSample(sample);
+  ReportSample(sample);
+}
+
+void FrameStageLatencyRecorder::StageAborted(Stage stage) {
+  stage_start_times_[static_cast<size_t>(stage)] = base::TimeTicks();
+}
+
+bool FrameStageLatencyRecorder::IsStageInProgress(Stage stage) const {
+  return !stage_start_times_[static_cast<size_t>(stage)].is_null();
+}
+
+void FrameStageLatencyRecorder::Reset() {
+  stage_start_times_.fill(base::TimeTicks());
+  next_sample_index_ = 0u;
+  num_samples_ = 0u;
+}
+
+std::vector<FrameStageLatencyRecorder::Sample>
+FrameStageLatencyRecorder::GetSamples() const {
+  std::vector<Sample> samples;
+  samples.reserve(num_samples_);
+  size_t index =
+      (next_sample_index_ + kMaxSamples - num_samples_) % kMaxSamples;
+  for (size_t i = 0; i < num_samples_; ++i) {
+    samples.push_back(samples_[index]);
+    index = (index + 1) % kMaxSamples;
+  }
+  return samples;
+}
+
+void FrameStageLatencyRecorder::AddSample(const Sample& sample) {
+  samples_[next_sample_index_] = sample;
+  next_sample_index_ = (next_sample_index_ + 1) % kMaxSamples;
+  if (num_samples_ < kMaxSamples)
+    ++num_samples_;
+}
+
+void FrameStageLatencyRecorder::ReportSample(const Sample& sample) {
+  const char* stage_name = StageToString(sample.stage);
+  // Stages overlap, so each sample gets its own track.
+  const auto trace_track =
+      perfetto::Track(base::trace_event::GetNextGlobalTraceId());
+  TRACE_EVENT_BEGIN("cc,benchmark", perfetto::StaticString(stage_name),
+                    trace_track, sample.start_time);
+  TRACE_EVENT_END("cc,benchmark", trace_track,
+                  sample.start_time + sample.duration);
+
+  if (metrics_subsampler_.ShouldSample(kHistogramSamplingFrequency)) {
+    base::UmaHistogramCustomMicrosecondsTimes(
+        StageToHistogramName(sample.stage), sample.duration, kHistogramMin,
+        kHistogramMax, kHistogramBucketCount);
+  }
+}
+
+}  // namespace cc
@@ -0,0 +1,98 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_SCHEDULER_FRAME_STAGE_LATENCY_RECORDER_H_
+#define CC_SCHEDULER_FRAME_STAGE_LATENCY_RECORDER_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <vector>
+
+#include "base/rand_util.h"
+#include "base/time/time.h"
+#include "cc/cc_export.h"
+
+namespace cc {
+
+// FrameStageLatencyRecorder keeps the latencies of the most recent stages of
+// the compositor pipeline, as observed by the Scheduler when it drives the
+// SchedulerStateMachine through its actions. Each completed stage is stored in
+// a fixed size ring buffer, emitted as an async trace event and, subsampled,
+// reported to UMA. Recording a stage does not allocate, so this is cheap
+// enough to keep enabled for every frame.
+//
+// Stages of different frames overlap (the main thread may be producing frame
+// N + 1 while frame N is drawn), so each stage is tracked independently of the
+// others rather than as part of a per-frame record.
+class CC_EXPORT FrameStageLatencyRecorder {
+ public:
+  enum class Stage {
+    // From sending BeginMainFrame until the main thread is ready to commit.
+    kBeginMainFrame,
+    // The blocking commit on the impl thread.
+    kCommit,
+    // From the end of commit (or an impl-side invalidation) until the pending
+    // tree is ready to activate.
+    kRasterWait,
+    kActivation,
+    kDraw,
+    // From submitting a CompositorFrame until it is acked.
+    kSubmit,
+    kLast = kSubmit,
+  };
+  static constexpr size_t kNumStages = static_cast<size_t>(Stage::kLast) + 1;
+
+  struct Sample {
+    Stage stage = Stage::kBeginMainFrame;
+    base::TimeTicks start_time;
+    base::TimeDelta duration;
+  };
+
+  static constexpr size_t kMaxSamples = 128;
+
+  FrameStageLatencyRecorder();
+  FrameStageLatencyRecorder(const FrameStageLatencyRecorder&) = delete;
+  FrameStageLatencyRecorder& operator=(const FrameStageLatencyRecorder&) =
+      delete;
+  ~FrameStageLatencyRecorder();
+
+  static const char* StageToString(Stage stage);
+
+  // Marks the start of |stage|. Starting a stage that is already in progress
+  // restarts it.
+  void StageStarted(Stage stage, base::TimeTicks now);
+  // Records a sample for |stage| if it is in progress, and does nothing
+  // otherwise.
+  void StageEnded(Stage stage, base::TimeTicks now);
+  // Drops an in progress |stage| without recording it, e.g. if BeginMainFrame
+  // was aborted.
+  void StageAborted(Stage stage);
+
+  bool IsStageInProgress(Stage stage) const;
+
+  // Drops in progress stages and all recorded samples.
+  void Reset();
+
+  // Returns the recorded samples, oldest first.
+  std::vector<Sample> GetSamples() const;
+  size_t num_samples() const { return num_samples_; }
+
+ private:
+  void AddSample(const Sample& sample);
+  void ReportSample(const Sample& sample);
+
+  std::array<base::TimeTicks, kNumStages> stage_start_times_;
+
+  std::array<Sample, kMaxSamples> samples_;
+  // Index at which the next sample is written.
+  size_t next_sample_index_ = 0u;
+  size_t num_samples_ = 0u;
+
+  base::MetricsSubSampler metrics_subsampler_;
+};
+
+}  // namespace cc
+
+#endif  // CC_SCHEDULER_FRAME_STAGE_LATENCY_RECORDER_H_
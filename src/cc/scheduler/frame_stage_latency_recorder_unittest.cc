@@ -0,0 +1,86 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/scheduler/frame_stage_latency_recorder.h"
+
+#include <vector>
+
+#include "base/test/metrics/histogram_tester.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace cc {
+namespace {
+
+using Stage = FrameStageLatencyRecorder::Stage;
+
+TEST(FrameStageLatencyRecorderTest, RecordsEndedStages) {
+  FrameStageLatencyRecorder recorder;
+  const base::TimeTicks start = base::TimeTicks() + base::Seconds(1);
+
+  recorder.StageStarted(Stage::kBeginMainFrame, start);
+  recorder.StageStarted(Stage::kSubmit, start + base::Milliseconds(1));
+  EXPECT_TRUE(recorder.IsStageInProgress(Stage::kBeginMainFrame));
+  recorder.StageEnded(Stage::kBeginMainFrame, start + base::Milliseconds(5));
+  EXPECT_FALSE(recorder.IsStageInProgress(Stage::kBeginMainFrame));
+  recorder.StageEnded(Stage::kSubmit, start + base::Milliseconds(3));
+
+  std::vector<FrameStageLatencyRecorder::Sample> samples =
+      recorder.GetSamples();
+  ASSERT_EQ(2u, samples.size());
+  EXPECT_EQ(Stage::kBeginMainFrame, samples[0].stage);
+  EXPECT_EQ(start, samples[0].start_time);
+  EXPECT_EQ(base::Milliseconds(5), samples[0].duration);
+  EXPECT_EQ(Stage::kSubmit, samples[1].stage);
+  EXPECT_EQ(base::Milliseconds(2), samples[1].duration);
+}
+
+TEST(FrameStageLatencyRecorderTest, IgnoresStagesNotInProgress) {
+  FrameStageLatencyRecorder recorder;
+  const base::TimeTicks start = base::TimeTicks() + base::Seconds(1);
+
+  recorder.StageEnded(Stage::kDraw, start);
+  recorder.StageStarted(Stage::kBeginMainFrame, start);
+  recorder.StageAborted(Stage::kBeginMainFrame);
+  recorder.StageEnded(Stage::kBeginMainFrame, start + base::Milliseconds(1));
+  EXPECT_EQ(0u, recorder.num_samples());
+}
+
+TEST(FrameStageLatencyRecorderTest, KeepsMostRecentSamples) {
+  FrameStageLatencyRecorder recorder;
+  const base::TimeTicks start = base::TimeTicks() + base::Seconds(1);
+  const size_t num_frames = FrameStageLatencyRecorder::kMaxSamples + 10;
+
+  for (size_t i = 0; i < num_frames; ++i) {
+    recorder.StageStarted(Stage::kDraw, start);
+    recorder.StageEnded(Stage::kDraw, start + base::Microseconds(i));
+  }
+
+  std::vector<FrameStageLatencyRecorder::Sample> samples =
+      recorder.GetSamples();
+  ASSERT_EQ(FrameStageLatencyRecorder::kMaxSamples, samples.size());
+  EXPECT_EQ(base::Microseconds(10), samples.front().duration);
+  EXPECT_EQ(base::Microseconds(num_frames - 1), samples.back().duration);
+
+  recorder.Reset();
+  EXPECT_EQ(0u, recorder.num_samples());
+  EXPECT_TRUE(recorder.GetSamples().empty());
+}
+
+TEST(FrameStageLatencyRecorderTest, ReportsHistograms) {
+  base::MetricsSubSampler::ScopedAlwaysSampleForTesting no_subsampling;
+  base::HistogramTester histogram_tester;
+  FrameStageLatencyRecorder recorder;
+  const base::TimeTicks start = base::TimeTicks() + base::Seconds(1);
+
+  recorder.StageStarted(Stage::kActivation, start);
+  recorder.StageEnded(Stage::kActivation, start + base::Milliseconds(2));
+  histogram_tester.ExpectTotalCount(
+      "Compositing.Scheduler.StageLatency.Activation", 1);
+  histogram_tester.ExpectTotalCount("Compositing.Scheduler.StageLatency.Draw",
+                                    0);
+}
+
+}  // namespace
+}  // namespace cc
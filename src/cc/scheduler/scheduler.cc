@@ -72,6 +72,9 @@ Scheduler::Scheduler(
 
   begin_impl_frame_deadline_timer_.SetTaskRunner(task_runner);
 
+  if (base::FeatureList::IsEnabled(features::kSchedulerStageLatencyRecording))
+    stage_latency_recorder_ = std::make_unique<FrameStageLatencyRecorder>();
+
   // We want to handle animate_only BeginFrames.
   wants_animate_only_begin_frames_ = true;
 
@@ -117,8 +120,10 @@ void Scheduler::SetCanDraw(bool can_draw) {
 }
 
 void Scheduler::NotifyReadyToActivate() {
-  if (state_machine_.NotifyReadyToActivate())
+  if (state_machine_.NotifyReadyToActivate()) {
     compositor_timing_history_->ReadyToActivate();
+    RecordStageEnded(FrameStageLatencyRecorder::Stage::kRasterWait);
+  }
 
   ProcessScheduledActions();
 }
@@ -188,6 +193,7 @@ void Scheduler::DidSubmitCompositorFrame(SubmitInfo& submit_info) {
         last_activate_origin_frame_args_.frame_id);
   }
   state_machine_.DidSubmitCompositorFrame();
+  RecordStageStarted(FrameStageLatencyRecorder::Stage::kSubmit);
 
   // There is no need to call ProcessScheduledActions here because
   // submitting a CompositorFrame should not trigger any new actions.
@@ -199,6 +205,7 @@ void Scheduler::DidSubmitCompositorFrame(SubmitInfo& submit_info) {
 void Scheduler::DidReceiveCompositorFrameAck() {
   DCHECK_GT(state_machine_.pending_submit_frames(), 0);
   state_machine_.DidReceiveCompositorFrameAck();
+  RecordStageEnded(FrameStageLatencyRecorder::Stage::kSubmit);
   ProcessScheduledActions();
 }
 
@@ -218,6 +225,7 @@ void Scheduler::NotifyReadyToCommit(
     compositor_frame_reporting_controller_->NotifyReadyToCommit(
         std::move(details));
     state_machine_.NotifyReadyToCommit();
+    RecordStageEnded(FrameStageLatencyRecorder::Stage::kBeginMainFrame);
     next_commit_origin_frame_args_ = last_dispatched_begin_main_frame_args_;
   }
   ProcessScheduledActions();
@@ -233,6 +241,7 @@ void Scheduler::BeginMainFrameAborted(CommitEarlyOutReason reason) {
                                                                   reason);
 
     state_machine_.BeginMainFrameAborted(reason);
+    RecordStageAborted(FrameStageLatencyRecorder::Stage::kBeginMainFrame);
   }
   ProcessScheduledActions();
 }
@@ -257,6 +266,7 @@ void Scheduler::DidLoseLayerTreeFrameSink() {
   {
     TRACE_EVENT0("cc", "Scheduler::DidLoseLayerTreeFrameSink");
     state_machine_.DidLoseLayerTreeFrameSink();
+    RecordStageAborted(FrameStageLatencyRecorder::Stage::kSubmit);
     UpdateCompositorTimingHistoryRecordingEnabled();
   }
   ProcessScheduledActions();
@@ -828,7 +838,9 @@ void Scheduler::DrawIfPossible() {
   base::AutoReset<bool> mark_inside(&inside_scheduled_action_, true);
   compositor_timing_history_->WillDraw();
   state_machine_.WillDraw();
+  RecordStageStarted(FrameStageLatencyRecorder::Stage::kDraw);
   DrawResult result = client_->ScheduledActionDrawIfPossible();
+  RecordStageEnded(FrameStageLatencyRecorder::Stage::kDraw);
   state_machine_.DidDraw(result);
   compositor_timing_history_->DidDraw();
 }
@@ -848,7 +860,9 @@ void Scheduler::DrawForced() {
   }
   compositor_timing_history_->WillDraw();
   state_machine_.WillDraw();
+  RecordStageStarted(FrameStageLatencyRecorder::Stage::kDraw);
   DrawResult result = client_->ScheduledActionDrawForced();
+  RecordStageEnded(FrameStageLatencyRecorder::Stage::kDraw);
   state_machine_.DidDraw(result);
   compositor_timing_history_->DidDraw();
 }
@@ -908,6 +922,7 @@ void Scheduler::ProcessScheduledActions() {
         compositor_frame_reporting_controller_->WillBeginMainFrame(
             begin_main_frame_args_);
         state_machine_.WillSendBeginMainFrame();
+        RecordStageStarted(FrameStageLatencyRecorder::Stage::kBeginMainFrame);
         client_->ScheduledActionSendBeginMainFrame(begin_main_frame_args_);
         last_dispatched_begin_main_frame_args_ = begin_main_frame_args_;
         break;
@@ -926,10 +941,14 @@ void Scheduler::ProcessScheduledActions() {
         state_machine_.WillCommit(/*commit_had_no_updates=*/false);
         compositor_timing_history_->WillCommit();
         compositor_frame_reporting_controller_->WillCommit();
+        RecordStageStarted(FrameStageLatencyRecorder::Stage::kCommit);
         client_->ScheduledActionCommit();
+        RecordStageEnded(FrameStageLatencyRecorder::Stage::kCommit);
         compositor_timing_history_->DidCommit();
         compositor_frame_reporting_controller_->DidCommit();
         state_machine_.DidCommit();
+        if (!settings_.commit_to_active_tree)
+          RecordStageStarted(FrameStageLatencyRecorder::Stage::kRasterWait);
         last_commit_origin_frame_args_ = next_commit_origin_frame_args_;
         break;
       case SchedulerStateMachine::Action::POST_COMMIT:
@@ -940,7 +959,12 @@ void Scheduler::ProcessScheduledActions() {
         compositor_timing_history_->WillActivate();
         compositor_frame_reporting_controller_->WillActivate();
         state_machine_.WillActivate();
+        // Activation may be forced before the tree is ready, in which case the
+        // raster wait ends here instead of in NotifyReadyToActivate().
+        RecordStageEnded(FrameStageLatencyRecorder::Stage::kRasterWait);
+        RecordStageStarted(FrameStageLatencyRecorder::Stage::kActivation);
         client_->ScheduledActionActivateSyncTree();
+        RecordStageEnded(FrameStageLatencyRecorder::Stage::kActivation);
         compositor_timing_history_->DidActivate();
         compositor_frame_reporting_controller_->DidActivate();
         last_activate_origin_frame_args_ = last_commit_origin_frame_args_;
@@ -950,6 +974,7 @@ void Scheduler::ProcessScheduledActions() {
         compositor_timing_history_->WillInvalidateOnImplSide();
         compositor_frame_reporting_controller_->WillInvalidateOnImplSide();
         client_->ScheduledActionPerformImplSideInvalidation();
+        RecordStageStarted(FrameStageLatencyRecorder::Stage::kRasterWait);
         break;
       case SchedulerStateMachine::Action::DRAW_IF_POSSIBLE:
         DrawIfPossible();
@@ -1042,7 +1067,27 @@ viz::BeginFrameAck Scheduler::CurrentBeginFrameAckForActiveTree() const {
 void Scheduler::ClearHistory() {
   // Ensure we reset decisions based on history from the previous navigation.
   compositor_timing_history_->ClearHistory();
+  if (stage_latency_recorder_)
+    stage_latency_recorder_->Reset();
   ProcessScheduledActions();
 }
 
+void Scheduler::RecordStageStarted(FrameStageLatencyRecorder::Stage stage) {
+  if (stage_latency_recorder_)
+    stage_latency_recorder_->StageStarted(stage, Now());
+}
+
+void Scheduler::RecordStageEnded(FrameStageLatencyRecorder::Stage stage) {
+  // Avoid calling Now() for stages that were never started.
+  if (stage_latency_recorder_ &&
+      stage_latency_recorder_->IsStageInProgress(stage)) {
+    stage_latency_recorder_->StageEnded(stage, Now());
+  }
+}
+
+void Scheduler::RecordStageAborted(FrameStageLatencyRecorder::Stage stage) {
+  if (stage_latency_recorder_)
+    stage_latency_recorder_->StageAborted(stage);
+}
+
 }  // namespace cc
@@ -18,6 +18,7 @@
 #include "cc/metrics/submit_info.h"
 #include "cc/scheduler/begin_frame_tracker.h"
 #include "cc/scheduler/draw_result.h"
+#include "cc/scheduler/frame_stage_latency_recorder.h"
 #include "cc/scheduler/scheduler_settings.h"
 #include "cc/scheduler/scheduler_state_machine.h"
 #include "cc/tiles/tile_priority.h"
@@ -284,6 +285,11 @@ class CC_EXPORT Scheduler : public viz::BeginFrameObserverBase {
 
   size_t CommitDurationSampleCountForTesting() const;
 
+  // Null unless features::kSchedulerStageLatencyRecording is enabled.
+  const FrameStageLatencyRecorder* stage_latency_recorder() const {
+    return stage_latency_recorder_.get();
+  }
+
  protected:
   // Virtual for testing.
   virtual base::TimeTicks Now() const;
@@ -305,6 +311,8 @@ class CC_EXPORT Scheduler : public viz::BeginFrameObserverBase {
   raw_ptr<CompositorFrameReportingController, AcrossTasksDanglingUntriaged>
       compositor_frame_reporting_controller_;
 
+  std::unique_ptr<FrameStageLatencyRecorder> stage_latency_recorder_;
+
   // What the latest deadline was, and when it was scheduled.
   base::TimeTicks deadline_;
   base::TimeTicks deadline_scheduled_at_;
@@ -399,6 +407,10 @@ class CC_EXPORT Scheduler : public viz::BeginFrameObserverBase {
   void PollToAdvanceCommitState();
   void BeginMainFrameAnimateAndLayoutOnly(const viz::BeginFrameArgs& args);
 
+  void RecordStageStarted(FrameStageLatencyRecorder::Stage stage);
+  void RecordStageEnded(FrameStageLatencyRecorder::Stage stage);
+  void RecordStageAborted(FrameStageLatencyRecorder::Stage stage);
+
   bool IsInsideAction(SchedulerStateMachine::Action action) {
     return inside_action_ == action;
   }
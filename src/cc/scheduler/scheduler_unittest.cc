@@ -19,10 +19,12 @@
 #include "base/notreached.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/run_loop.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/test_mock_time_task_runner.h"
 #include "base/time/time.h"
 #include "base/time/time_override.h"
 #include "base/trace_event/trace_event.h"
+#include "cc/base/features.h"
 #include "cc/metrics/begin_main_frame_metrics.h"
 #include "cc/metrics/event_metrics.h"
 #include "cc/test/fake_compositor_frame_reporting_controller.h"
@@ -711,6 +713,59 @@ TEST_F(SchedulerTest, RequestCommit) {
   client_->Reset();
 }
 
+TEST_F(SchedulerTest, RecordsStageLatencies) {
+  using Stage = FrameStageLatencyRecorder::Stage;
+  base::test::ScopedFeatureList feature_list(
+      features::kSchedulerStageLatencyRecording);
+  SetUpScheduler(EXTERNAL_BFS);
+  ASSERT_TRUE(scheduler_->stage_latency_recorder());
+  client_->SetAutomaticSubmitCompositorFrameAck(false);
+  // Skip the samples of the first commit done during set up.
+  const size_t first_sample =
+      scheduler_->stage_latency_recorder()->num_samples();
+
+  scheduler_->SetNeedsBeginMainFrame();
+  EXPECT_SCOPED(AdvanceFrame());
+  EXPECT_ACTIONS("AddObserver(this)", "WillBeginImplFrame",
+                 "ScheduledActionSendBeginMainFrame");
+  client_->Reset();
+
+  task_runner_->AdvanceMockTickClock(base::Milliseconds(4));
+  scheduler_->NotifyBeginMainFrameStarted(task_runner_->NowTicks());
+  scheduler_->NotifyReadyToCommit(nullptr);
+  EXPECT_ACTIONS("ScheduledActionCommit", "ScheduledActionPostCommit");
+  client_->Reset();
+
+  task_runner_->AdvanceMockTickClock(base::Milliseconds(3));
+  scheduler_->NotifyReadyToActivate();
+  EXPECT_ACTIONS("ScheduledActionActivateSyncTree");
+  client_->Reset();
+
+  EXPECT_SCOPED(AdvanceFrame());
+  task_runner_->RunPendingTasks();  // Run posted deadline.
+  EXPECT_ACTIONS("WillBeginImplFrame", "ScheduledActionDrawIfPossible");
+  client_->Reset();
+
+  task_runner_->AdvanceMockTickClock(base::Milliseconds(2));
+  scheduler_->DidReceiveCompositorFrameAck();
+
+  // The mock clock does not advance inside the commit, activation and draw
+  // actions.
+  std::vector<FrameStageLatencyRecorder::Sample> samples =
+      scheduler_->stage_latency_recorder()->GetSamples();
+  ASSERT_EQ(first_sample + 6u, samples.size());
+  samples.erase(samples.begin(), samples.begin() + first_sample);
+  EXPECT_EQ(Stage::kBeginMainFrame, samples[0].stage);
+  EXPECT_EQ(base::Milliseconds(4), samples[0].duration);
+  EXPECT_EQ(Stage::kCommit, samples[1].stage);
+  EXPECT_EQ(Stage::kRasterWait, samples[2].stage);
+  EXPECT_EQ(base::Milliseconds(3), samples[2].duration);
+  EXPECT_EQ(Stage::kActivation, samples[3].stage);
+  EXPECT_EQ(Stage::kDraw, samples[4].stage);
+  EXPECT_EQ(Stage::kSubmit, samples[5].stage);
+  EXPECT_EQ(base::Milliseconds(2), samples[5].duration);
+}
+
 TEST_F(SchedulerTest, RequestCommitAfterSetDeferBeginMainFrame) {
   SetUpScheduler(EXTERNAL_BFS);
 
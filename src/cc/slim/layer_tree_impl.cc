@@ -10,10 +10,12 @@
 
 #include "base/auto_reset.h"
 #include "base/containers/adapters.h"
+#include "base/feature_list.h"
 #include "base/metrics/histogram.h"
 #include "base/ranges/algorithm.h"
 #include "base/trace_event/trace_event.h"
 #include "base/trace_event/typed_macros.h"
+#include "cc/base/features.h"
 #include "cc/base/histograms.h"
 #include "cc/base/region.h"
 #include "cc/slim/frame_data.h"
@@ -150,6 +152,7 @@ void LayerTreeImpl::RequestSuccessfulPresentationTimeForNextFrame(
 }
 
 void LayerTreeImpl::set_display_transform_hint(gfx::OverlayTransform hint) {
+  display_transform_hint_changed_ |= display_transform_hint_ != hint;
   display_transform_hint_ = hint;
 }
 
@@ -293,10 +296,10 @@ bool LayerTreeImpl::BeginFrame(
     return false;
   }
 
-  GenerateCompositorFrame(args, out_frame, out_resource_ids,
-                          out_hit_test_region_list);
+  bool has_frame = GenerateCompositorFrame(args, out_frame, out_resource_ids,
+                                           out_hit_test_region_list);
   UpdateNeedsBeginFrame();
-  return true;
+  return has_frame;
 }
 
 void LayerTreeImpl::DidReceiveCompositorFrameAck() {
@@ -433,7 +436,7 @@ bool LayerTreeImpl::NeedsBeginFrames() const {
          num_begin_frames_with_no_draw_ < num_unneeded_begin_frame_before_stop_;
 }
 
-void LayerTreeImpl::GenerateCompositorFrame(
+bool LayerTreeImpl::GenerateCompositorFrame(
     const viz::BeginFrameArgs& args,
     viz::CompositorFrame& out_frame,
     base::flat_set<viz::ResourceId>& out_resource_ids,
@@ -447,8 +450,14 @@ void LayerTreeImpl::GenerateCompositorFrame(
                            StepName::STEP_GENERATE_COMPOSITOR_FRAME);
       });
 
+  // Damage is only tracked relative to a previous frame. It is reset whenever
+  // viz may not have that frame, e.g. on a new frame sink or surface.
+  const bool has_previous_frame = !damage_from_previous_frame_.empty();
+
+  bool has_ui_resource_requests = false;
   for (auto& resource_request :
        ui_resource_manager_.TakeUIResourcesRequests()) {
+    has_ui_resource_requests = true;
     switch (resource_request.GetType()) {
       case cc::UIResourceRequest::Type::kCreate:
         frame_sink_->UploadUIResource(resource_request.GetId(),
@@ -527,6 +536,21 @@ void LayerTreeImpl::GenerateCompositorFrame(
   damage_from_previous_frame_ = std::move(frame_data.current_frame_damage);
   frame_data.current_frame_damage.clear();
 
+  // Nothing drawn has changed, so this frame would be identical to the one viz
+  // already has. Skip building the rest of it and serializing its quads.
+  // UI resources may have been replaced under an unchanged id, so frames that
+  // upload or delete resources are always submitted.
+  if (has_previous_frame && render_pass->damage_rect.IsEmpty() &&
+      copy_requests_for_next_frame_.empty() &&
+      presentation_callback_for_next_frame_.empty() &&
+      success_callback_for_next_frame_.empty() && !has_ui_resource_requests &&
+      !display_transform_hint_changed_ &&
+      base::FeatureList::IsEnabled(features::kSlimSkipFramesWithoutDamage)) {
+    TRACE_EVENT_INSTANT0("cc", "EarlyOut_NoDamage", TRACE_EVENT_SCOPE_THREAD);
+    return false;
+  }
+  display_transform_hint_changed_ = false;
+
   render_pass->copy_requests = std::move(copy_requests_for_next_frame_);
   copy_requests_for_next_frame_.clear();
   out_frame.render_pass_list.push_back(std::move(render_pass));
@@ -560,6 +584,7 @@ void LayerTreeImpl::GenerateCompositorFrame(
         std::move(presentation_callback_for_next_frame_),
         std::move(success_callback_for_next_frame_));
   }
+  return true;
 }
 
 void LayerTreeImpl::Draw(Layer& layer,
@@ -141,7 +141,9 @@ class COMPONENT_EXPORT(CC_SLIM) LayerTreeImpl : public LayerTree,
   void SetNeedsDraw();
   bool NeedsDraw() const;
   bool NeedsBeginFrames() const;
-  void GenerateCompositorFrame(
+  // Returns false if the frame does not need to be submitted because it would
+  // be identical to the previous one.
+  bool GenerateCompositorFrame(
       const viz::BeginFrameArgs& args,
       viz::CompositorFrame& out_frame,
       base::flat_set<viz::ResourceId>& out_resource_ids,
@@ -213,6 +215,8 @@ class COMPONENT_EXPORT(CC_SLIM) LayerTreeImpl : public LayerTree,
   SurfaceRangesAndCounts referenced_surfaces_;
   viz::FrameTokenGenerator next_frame_token_;
   gfx::OverlayTransform display_transform_hint_ = gfx::OVERLAY_TRANSFORM_NONE;
+  // Whether `display_transform_hint_` changed since the last submitted frame.
+  bool display_transform_hint_changed_ = false;
 
   std::vector<std::unique_ptr<viz::CopyOutputRequest>>
       copy_requests_for_next_frame_;
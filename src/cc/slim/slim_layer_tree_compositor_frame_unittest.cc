@@ -8,8 +8,10 @@
 #include "base/functional/callback_helpers.h"
 #include "base/memory/weak_ptr.h"
 #include "base/test/bind.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/time/time.h"
 #include "base/unguessable_token.h"
+#include "cc/base/features.h"
 #include "cc/base/region.h"
 #include "cc/paint/filter_operation.h"
 #include "cc/paint/filter_operations.h"
@@ -73,8 +75,7 @@ class SlimLayerTreeCompositorFrameTest : public testing::Test {
     DCHECK(local_surface_id_.is_valid());
   }
 
-  viz::CompositorFrame ProduceFrame(
-      std::optional<viz::HitTestRegionList>* out_list = nullptr) {
+  void IssueBeginFrame() {
     layer_tree_->SetNeedsAnimate();
     EXPECT_TRUE(layer_tree_->NeedsBeginFrames());
     base::TimeTicks frame_time = base::TimeTicks::Now();
@@ -86,6 +87,11 @@ class SlimLayerTreeCompositorFrameTest : public testing::Test {
     frame_sink_->OnBeginFrame(begin_frame_args, std::move(next_timing_details_),
                               /*frame_ack=*/false, {});
     next_timing_details_.clear();
+  }
+
+  viz::CompositorFrame ProduceFrame(
+      std::optional<viz::HitTestRegionList>* out_list = nullptr) {
+    IssueBeginFrame();
     viz::CompositorFrame frame = frame_sink_->TakeLastFrame();
     if (out_list) {
       *out_list = frame_sink_->GetLastHitTestRegionList();
@@ -2279,6 +2285,57 @@ TEST_F(SlimLayerTreeCompositorFrameTest,
   }
 }
 
+TEST_F(SlimLayerTreeCompositorFrameTest, SkipFramesWithoutDamage) {
+  base::test::ScopedFeatureList feature_list(
+      features::kSlimSkipFramesWithoutDamage);
+  auto root_layer = CreateSolidColorLayer(viewport_.size(), SkColors::kGray);
+  layer_tree_->SetRoot(root_layer);
+
+  ProduceFrame();
+  EXPECT_TRUE(frame_sink_->GetDidSubmitAndReset());
+
+  // Nothing changed, so viz is told no frame was produced instead.
+  IssueBeginFrame();
+  EXPECT_FALSE(frame_sink_->GetDidSubmitAndReset());
+  EXPECT_TRUE(frame_sink_->GetDidNotProduceFrameAndReset());
+
+  // Damage is still relative to the last submitted frame.
+  root_layer->SetBackgroundColor(SkColors::kRed);
+  {
+    viz::CompositorFrame frame = ProduceFrame();
+    EXPECT_TRUE(frame_sink_->GetDidSubmitAndReset());
+    ASSERT_EQ(frame.render_pass_list.size(), 1u);
+    EXPECT_EQ(frame.render_pass_list.back()->damage_rect, viewport_);
+  }
+
+  // Presentation callbacks need a frame token, even without damage.
+  layer_tree_->RequestPresentationTimeForNextFrame(base::DoNothing());
+  ProduceFrame();
+  EXPECT_TRUE(frame_sink_->GetDidSubmitAndReset());
+
+  // So do copy requests.
+  layer_tree_->RequestCopyOfOutput(std::make_unique<viz::CopyOutputRequest>(
+      viz::CopyOutputRequest::ResultFormat::RGBA,
+      viz::CopyOutputRequest::ResultDestination::kSystemMemory,
+      base::DoNothing()));
+  ProduceFrame();
+  EXPECT_TRUE(frame_sink_->GetDidSubmitAndReset());
+
+  // A new surface has to receive a frame.
+  IncrementLocalSurfaceId();
+  layer_tree_->SetViewportRectAndScale(
+      viewport_, /*device_scale_factor=*/1.0f, local_surface_id_);
+  {
+    viz::CompositorFrame frame = ProduceFrame();
+    EXPECT_TRUE(frame_sink_->GetDidSubmitAndReset());
+    ASSERT_EQ(frame.render_pass_list.size(), 1u);
+    EXPECT_EQ(frame.render_pass_list.back()->damage_rect, viewport_);
+  }
+
+  IssueBeginFrame();
+  EXPECT_FALSE(frame_sink_->GetDidSubmitAndReset());
+}
+
 }  // namespace
 
 }  // namespace cc::slim
@@ -206,6 +206,7 @@ void CheckerImageTracker::ClearTracker(bool can_clear_decode_policy_tracking) {
   // If the external inputs for deciding the decode policy for an image change,
   // they should be accompanied with an invalidation during paint.
   image_id_to_decode_.clear();
+  predicted_decode_images_.clear();
 
   if (can_clear_decode_policy_tracking) {
     decoding_mode_map_.clear();
@@ -397,8 +398,10 @@ void CheckerImageTracker::ScheduleNextImageDecode() {
     return;
 
   DrawImage draw_image;
+  DecodeType decode_type = DecodeType::kRaster;
   while (!image_decode_queue_.empty()) {
     auto candidate = std::move(image_decode_queue_.front().paint_image);
+    decode_type = image_decode_queue_.front().type;
     image_decode_queue_.erase(image_decode_queue_.begin());
 
     // Once an image has been decoded, it can still be present in the decode
@@ -439,6 +442,30 @@ void CheckerImageTracker::ScheduleNextImageDecode() {
 
   image_id_to_decode_.emplace(image_id, std::make_unique<ScopedDecodeHolder>(
                                             image_controller_, request_id));
+  if (decode_type == DecodeType::kPredictedRaster)
+    predicted_decode_images_.insert(image_id);
+}
+
+void CheckerImageTracker::DidScheduleRasterWithImages(
+    const std::vector<DrawImage>& sync_decoded_images,
+    const std::vector<PaintImage>& checkered_images) {
+  if (predicted_decode_images_.empty())
+    return;
+
+  for (const auto& draw_image : sync_decoded_images) {
+    if (predicted_decode_images_.erase(draw_image.paint_image().stable_id())) {
+      UMA_HISTOGRAM_BOOLEAN(
+          "Compositing.Renderer.CheckerImaging.PredictedDecodeAvoidedChecker",
+          true);
+    }
+  }
+  for (const auto& paint_image : checkered_images) {
+    if (predicted_decode_images_.erase(paint_image.stable_id())) {
+      UMA_HISTOGRAM_BOOLEAN(
+          "Compositing.Renderer.CheckerImaging.PredictedDecodeAvoidedChecker",
+          false);
+    }
+  }
 }
 
 void CheckerImageTracker::UpdateImageDecodingHints(
@@ -41,9 +41,13 @@ class CC_EXPORT CheckerImageTracker {
   enum DecodeType : int {
     // Priority for images on tiles being rasterized (visible or pre-paint).
     kRaster = 0,
+    // Priority for images on pre-paint tiles that could not be scheduled for
+    // raster yet but are expected to be needed soon while scrolling. Decoding
+    // these ahead of raster avoids showing them checkered.
+    kPredictedRaster = 1,
     // Lowest priority for images on tiles in pre-decode region. These are tiles
     // which are beyond the pre-paint region, but have their images decoded.
-    kPreDecode = 1,
+    kPreDecode = 2,
 
     kLast = kPreDecode
   };
@@ -106,6 +110,14 @@ class CC_EXPORT CheckerImageTracker {
       base::flat_map<PaintImage::Id, PaintImage::DecodingMode>
           decoding_mode_map);
 
+  // Called when a raster task is created for a tile using the given images.
+  // For images whose decode was started by a kPredictedRaster request, records
+  // whether the decode finished in time for the image to be rasterized without
+  // checkering.
+  void DidScheduleRasterWithImages(
+      const std::vector<DrawImage>& sync_decoded_images,
+      const std::vector<PaintImage>& checkered_images);
+
   bool has_locked_decodes_for_testing() const {
     return !image_id_to_decode_.empty();
   }
@@ -212,6 +224,10 @@ class CC_EXPORT CheckerImageTracker {
 
   base::flat_map<PaintImage::Id, PaintImage::DecodingMode> decoding_mode_map_;
 
+  // Images whose decode was scheduled for a kPredictedRaster request and that
+  // have not been rasterized since.
+  PaintImageIdFlatSet predicted_decode_images_;
+
   base::WeakPtrFactory<CheckerImageTracker> weak_factory_{this};
 };
 
@@ -10,6 +10,7 @@
 
 #include "base/functional/bind.h"
 #include "base/run_loop.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/task/single_thread_task_runner.h"
 #include "cc/paint/paint_image_builder.h"
 #include "cc/test/paint_image_matchers.h"
@@ -545,6 +546,43 @@ TEST_F(CheckerImageTrackerTest, RespectsDecodePriority) {
               ImagesAreSame({image1, image2, image3, image4}));
 }
 
+TEST_F(CheckerImageTrackerTest, PredictedRasterDecodes) {
+  SetUpTracker(true);
+  checker_image_tracker_->SetNoDecodesAllowed();
+
+  DrawImage image1 = CreateImage(ImageType::CHECKERABLE);
+  DrawImage image2 = CreateImage(ImageType::CHECKERABLE);
+  DrawImage image3 = CreateImage(ImageType::CHECKERABLE);
+  CheckerImageTracker::ImageDecodeQueue image_decode_queue =
+      BuildImageDecodeQueue({image1, image2, image3}, WhichTree::PENDING_TREE);
+  ASSERT_EQ(image_decode_queue.size(), 3u);
+  image_decode_queue[1].type =
+      CheckerImageTracker::DecodeType::kPredictedRaster;
+  image_decode_queue[2].type = CheckerImageTracker::DecodeType::kPreDecode;
+  checker_image_tracker_->ScheduleImageDecodeQueue(image_decode_queue);
+
+  // Predicted decodes run after raster decodes, but before pre-decodes.
+  checker_image_tracker_->SetMaxDecodePriorityAllowed(
+      CheckerImageTracker::DecodeType::kRaster);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_THAT(image_controller_.decoded_images(), ImagesAreSame({image1}));
+
+  checker_image_tracker_->SetMaxDecodePriorityAllowed(
+      CheckerImageTracker::DecodeType::kPredictedRaster);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_THAT(image_controller_.decoded_images(),
+              ImagesAreSame({image1, image2}));
+
+  // Only rasterizing an image decoded for a predicted request is recorded, and
+  // only once.
+  base::HistogramTester histogram_tester;
+  checker_image_tracker_->DidScheduleRasterWithImages({image1, image2}, {});
+  checker_image_tracker_->DidScheduleRasterWithImages({image2}, {});
+  histogram_tester.ExpectUniqueSample(
+      "Compositing.Renderer.CheckerImaging.PredictedDecodeAvoidedChecker", true,
+      1);
+}
+
 TEST_F(CheckerImageTrackerTest, UseSrcRectForSize) {
   SetUpTracker(true);
 
@@ -1193,6 +1193,8 @@ GpuImageDecodeCache::GpuImageDecodeCache(
       persistent_cache_(PersistentCache::NO_AUTO_EVICT),
       max_working_set_bytes_(max_working_set_bytes),
       max_working_set_items_(kMaxItemsInWorkingSet),
+      batch_uploads_(
+          base::FeatureList::IsEnabled(features::kBatchedGpuImageUploads)),
       dark_mode_filter_(dark_mode_filter) {
   if (base::SequencedTaskRunner::HasCurrentDefault()) {
     task_runner_ = base::SequencedTaskRunner::GetCurrentDefault();
@@ -1342,6 +1344,7 @@ ImageDecodeCache::TaskResult GpuImageDecodeCache::GetTaskForImageAndRefInternal(
                                    task_type),
           tracing_info);
       image_data->upload.task_map[client_id] = task;
+      AddPendingBatchedUpload(draw_image, cache_key);
     }
     DCHECK(task);
     return TaskResult(task,
@@ -1420,6 +1423,7 @@ ImageDecodeCache::TaskResult GpuImageDecodeCache::GetTaskForImageAndRefInternal(
                                  task_type),
         tracing_info);
     image_data->upload.task_map[client_id] = task;
+    AddPendingBatchedUpload(draw_image, cache_key);
   } else {
     task = GetImageDecodeTaskAndRef(client_id, draw_image, tracing_info,
                                     task_type);
@@ -1962,6 +1966,8 @@ void GpuImageDecodeCache::UploadImageInTask(const DrawImage& draw_image) {
     DecodeImageAndGenerateDarkModeFilterIfNecessary(draw_image, image_data,
                                                     TaskType::kInRaster);
   UploadImageIfNecessary(draw_image, image_data);
+  pending_batched_uploads_.erase(cache_key);
+  UploadPendingBatchedImages();
 }
 
 void GpuImageDecodeCache::OnImageDecodeTaskCompleted(
@@ -1998,6 +2004,7 @@ void GpuImageDecodeCache::OnImageUploadTaskCompleted(
   ImageData* image_data = GetImageDataForDrawImage(draw_image, cache_key);
   DCHECK(image_data);
   image_data->upload.task_map.clear();
+  pending_batched_uploads_.erase(cache_key);
 
   // While the upload task is active, we keep a ref on both the image it will be
   // populating, as well as the decode it needs to populate it. Release these
@@ -2615,6 +2622,51 @@ void GpuImageDecodeCache::UploadImageIfNecessary(const DrawImage& draw_image,
   }
 }
 
+void GpuImageDecodeCache::AddPendingBatchedUpload(
+    const DrawImage& draw_image,
+    const InUseCacheKey& cache_key) {
+  if (batch_uploads_)
+    pending_batched_uploads_.emplace(cache_key, draw_image);
+}
+
+void GpuImageDecodeCache::UploadPendingBatchedImages() {
+  if (pending_batched_uploads_.empty())
+    return;
+
+  TRACE_EVENT1("cc", "GpuImageDecodeCache::UploadPendingBatchedImages",
+               "pending", pending_batched_uploads_.size());
+  // Bounds how long a single upload task holds the context lock.
+  constexpr size_t kMaxBatchedUploadBytes = 8 * 1024 * 1024;
+  size_t batched_bytes = 0u;
+  for (auto it = pending_batched_uploads_.begin();
+       it != pending_batched_uploads_.end();) {
+    const DrawImage& draw_image = it->second;
+    ImageData* image_data = GetImageDataForDrawImage(draw_image, it->first);
+    // Only images whose decode is done and locked can be uploaded ahead of
+    // their task. Hardware decodes and bitmap backed images are decoded as part
+    // of the upload task itself, so leave those to it. The pending upload task
+    // holds refs on both the decode and the upload until it completes.
+    if (!image_data || image_data->HasUploadedData() ||
+        image_data->decode.decode_failure || image_data->is_bitmap_backed ||
+        image_data->decode.do_hardware_accelerated_decode() ||
+        !image_data->decode.is_locked()) {
+      ++it;
+      continue;
+    }
+    const size_t image_bytes = image_data->GetTotalSize();
+    if (batched_bytes + image_bytes > kMaxBatchedUploadBytes) {
+      ++it;
+      continue;
+    }
+
+    DCHECK_GT(image_data->upload.ref_count, 0u);
+    UploadImageIfNecessary(draw_image, image_data);
+    batched_bytes += image_bytes;
+    ++batched_upload_count_;
+    it = pending_batched_uploads_.erase(it);
+  }
+}
+
 void GpuImageDecodeCache::UploadImageIfNecessary_TransferCache_HardwareDecode(
     const DrawImage& draw_image,
     ImageData* image_data,
@@ -255,6 +255,11 @@ class CC_EXPORT GpuImageDecodeCache
   bool AcquireContextLockForTesting();
   void ReleaseContextLockForTesting();
 
+  size_t batched_upload_count_for_testing() const {
+    base::AutoLock locker(lock_);
+    return batched_upload_count_;
+  }
+
  private:
   enum class DecodedDataMode { kGpu, kCpu, kTransferCache };
   using ImageTaskMap = base::flat_map<ClientId, scoped_refptr<TileTask>>;
@@ -814,6 +819,17 @@ class CC_EXPORT GpuImageDecodeCache
                               ImageData* image_data)
       EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
+  // Adds |draw_image| to |pending_batched_uploads_| if upload batching is
+  // enabled.
+  void AddPendingBatchedUpload(const DrawImage& draw_image,
+                               const InUseCacheKey& cache_key)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Uploads the images in |pending_batched_uploads_| whose decodes have
+  // already completed, so that their own upload tasks find them uploaded.
+  // Requires that the |context_| lock be held when calling.
+  void UploadPendingBatchedImages() EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // Implementation of UploadImageIfNecessary for each sub-case.
   void UploadImageIfNecessary_TransferCache_HardwareDecode(
       const DrawImage& draw_image,
@@ -961,6 +977,16 @@ class CC_EXPORT GpuImageDecodeCache
   size_t working_set_items_ GUARDED_BY(lock_) = 0;
   bool aggressively_freeing_resources_ GUARDED_BY(lock_) = false;
 
+  // Images with an upload task that has not completed yet. When
+  // features::kBatchedGpuImageUploads is enabled, the first upload task to run
+  // also uploads the images in here whose decodes are done, issuing the
+  // uploads of a raster frame back to back under a single context lock instead
+  // of one task at a time.
+  const bool batch_uploads_;
+  std::unordered_map<InUseCacheKey, DrawImage, InUseCacheKeyHash>
+      pending_batched_uploads_ GUARDED_BY(lock_);
+  size_t batched_upload_count_ GUARDED_BY(lock_) = 0u;
+
   // This field is not a raw_ptr<> because of incompatibilities with tracing
   // (TRACE_EVENT*), perfetto::TracedDictionary::Add and gmock/EXPECT_THAT.
   RAW_PTR_EXCLUSION RasterDarkModeFilter* const dark_mode_filter_;
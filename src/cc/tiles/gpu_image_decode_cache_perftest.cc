@@ -3,12 +3,16 @@
 // found in the LICENSE file.
 
 #include <memory>
+#include <string>
 #include <vector>
 
+#include "base/test/scoped_feature_list.h"
 #include "base/timer/lap_timer.h"
+#include "cc/base/features.h"
 #include "cc/paint/draw_image.h"
 #include "cc/paint/paint_image_builder.h"
 #include "cc/raster/tile_task.h"
+#include "cc/test/test_tile_task_runner.h"
 #include "cc/tiles/gpu_image_decode_cache.h"
 #include "components/viz/test/test_in_process_context_provider.h"
 #include "gpu/command_buffer/client/raster_interface.h"
@@ -96,6 +100,47 @@ class GpuImageDecodeCachePerfTest
     }
   }
 
+  // Decodes and uploads |num_images| new images per lap the way a raster frame
+  // of an image gallery would: all decode tasks run before the upload tasks.
+  void RunUploadTest(const std::string& metric_suffix, size_t num_images) {
+    const uint32_t client_id = cache_->GenerateClientId();
+    std::vector<DrawImage> images;
+    std::vector<scoped_refptr<TileTask>> tasks;
+    timer_.Reset();
+    do {
+      for (size_t i = 0; i < num_images; ++i) {
+        images.emplace_back(
+            PaintImageBuilder::WithDefault()
+                .set_id(PaintImage::GetNextId())
+                .set_image(CreateImage(256, 256),
+                           PaintImage::GetNextContentId())
+                .TakePaintImage(),
+            false, SkIRect::MakeWH(256, 256),
+            PaintFlags::FilterQuality::kMedium,
+            CreateMatrix(SkSize::Make(0.6f, 0.6f)), 0u, TargetColorParams());
+        ImageDecodeCache::TaskResult result = cache_->GetTaskForImageAndRef(
+            client_id, images.back(), ImageDecodeCache::TracingInfo());
+        CHECK(result.task);
+        tasks.push_back(std::move(result.task));
+      }
+      for (auto& task : tasks) {
+        for (auto& dependency : task->dependencies())
+          TestTileTaskRunner::ProcessTask(dependency.get());
+      }
+      for (auto& task : tasks)
+        TestTileTaskRunner::ProcessTask(task.get());
+      for (const auto& image : images)
+        cache_->UnrefImage(image);
+      tasks.clear();
+      images.clear();
+      cache_->ClearCache();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PerfResultReporter reporter = SetUpReporter(metric_suffix);
+    reporter.AddResult(metric_suffix, timer_.LapsPerSecond());
+  }
+
   perf_test::PerfResultReporter SetUpReporter(
       const std::string& metric_suffix) {
     perf_test::PerfResultReporter reporter("gpu_image_decode_cache",
@@ -166,6 +211,20 @@ TEST_P(GpuImageDecodeCachePerfTestNoSw, DecodeWithMips) {
   reporter.AddResult("_with_mips", timer_.LapsPerSecond());
 }
 
+TEST_P(GpuImageDecodeCachePerfTestNoSw, UploadManyImages) {
+  RunUploadTest("_upload_many_images", /*num_images=*/32);
+}
+
+TEST_P(GpuImageDecodeCachePerfTestNoSw, UploadManyImagesBatched) {
+  base::test::ScopedFeatureList feature_list(
+      features::kBatchedGpuImageUploads);
+  // The cache reads the feature on construction.
+  cache_ = std::make_unique<GpuImageDecodeCache>(
+      context_provider_.get(), UseTransferCache(), kRGBA_8888_SkColorType,
+      kCacheSize, MaxTextureSize(), nullptr);
+  RunUploadTest("_upload_many_images_batched", /*num_images=*/32);
+}
+
 TEST_P(GpuImageDecodeCachePerfTest, AcquireExistingImages) {
   timer_.Reset();
   DrawImage image(
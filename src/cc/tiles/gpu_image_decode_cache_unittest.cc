@@ -1090,6 +1090,55 @@ TEST_P(GpuImageDecodeCacheTest, GetTaskForImageDifferentImage) {
   cache->UnrefImage(second_draw_image);
 }
 
+TEST_P(GpuImageDecodeCacheTest, BatchedUploadsUploadDecodedImages) {
+  base::test::ScopedFeatureList feature_list(
+      features::kBatchedGpuImageUploads);
+  auto cache = CreateCache();
+  const uint32_t client_id = cache->GenerateClientId();
+
+  DrawImage first_draw_image = CreateDrawImageInternal(
+      CreatePaintImageInternal(GetNormalImageSize()),
+      CreateMatrix(SkSize::Make(0.5f, 0.5f)));
+  ImageDecodeCache::TaskResult first_result = cache->GetTaskForImageAndRef(
+      client_id, first_draw_image, ImageDecodeCache::TracingInfo());
+  ASSERT_TRUE(first_result.task);
+
+  DrawImage second_draw_image = CreateDrawImageInternal(
+      CreatePaintImageInternal(GetNormalImageSize()),
+      CreateMatrix(SkSize::Make(0.25f, 0.25f)));
+  ImageDecodeCache::TaskResult second_result = cache->GetTaskForImageAndRef(
+      client_id, second_draw_image, ImageDecodeCache::TracingInfo());
+  ASSERT_TRUE(second_result.task);
+
+  DrawImage third_draw_image = CreateDrawImageInternal(
+      CreatePaintImageInternal(GetNormalImageSize()),
+      CreateMatrix(SkSize::Make(0.25f, 0.25f)));
+  ImageDecodeCache::TaskResult third_result = cache->GetTaskForImageAndRef(
+      client_id, third_draw_image, ImageDecodeCache::TracingInfo());
+  ASSERT_TRUE(third_result.task);
+
+  // The second image is decoded by the time the first upload runs, so it is
+  // uploaded along with it. The third one isn't decoded yet.
+  TestTileTaskRunner::ProcessTask(first_result.task->dependencies()[0].get());
+  TestTileTaskRunner::ProcessTask(second_result.task->dependencies()[0].get());
+  TestTileTaskRunner::ProcessTask(first_result.task.get());
+  EXPECT_EQ(1u, cache->batched_upload_count_for_testing());
+
+  TestTileTaskRunner::ProcessTask(third_result.task->dependencies()[0].get());
+  TestTileTaskRunner::ProcessTask(second_result.task.get());
+  TestTileTaskRunner::ProcessTask(third_result.task.get());
+  EXPECT_EQ(2u, cache->batched_upload_count_for_testing());
+
+  DecodedDrawImage decoded_draw_image =
+      EnsureImageBacked(cache->GetDecodedImageForDraw(second_draw_image));
+  EXPECT_TRUE(decoded_draw_image.image());
+  cache->DrawWithImageFinished(second_draw_image, decoded_draw_image);
+
+  cache->UnrefImage(first_draw_image);
+  cache->UnrefImage(second_draw_image);
+  cache->UnrefImage(third_draw_image);
+}
+
 TEST_P(GpuImageDecodeCacheTest, GetTaskForImageLargerScale) {
   auto cache = CreateCache();
   const uint32_t client_id = cache->GenerateClientId();
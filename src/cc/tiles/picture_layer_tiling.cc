@@ -754,6 +754,22 @@ bool PictureLayerTiling::IsTileOccludedOnCurrentTree(const Tile* tile) const {
   return current_occlusion_in_layer_space_.IsOccluded(tile_query_rect);
 }
 
+size_t PictureLayerTiling::CountOccludedTilesNeedingRaster() const {
+  if (!current_occlusion_in_layer_space_.HasOcclusion())
+    return 0u;
+
+  // Tiles outside of the visible rect are never considered occluded.
+  size_t count = 0u;
+  for (TilingData::Iterator iter(&tiling_data_, current_visible_rect_,
+                                 /*include_borders=*/false);
+       iter; ++iter) {
+    const Tile* tile = TileAt(iter.index_x(), iter.index_y());
+    if (tile && tile->draw_info().NeedsRaster() && IsTileOccluded(tile))
+      ++count;
+  }
+  return count;
+}
+
 bool PictureLayerTiling::ShouldDecodeCheckeredImagesForTile(
     const Tile* tile) const {
   // If this is the pending tree and the tile is not occluded, any checkered
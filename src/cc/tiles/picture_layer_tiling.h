@@ -189,6 +189,10 @@ class CC_EXPORT PictureLayerTiling {
     all_tiles_done_ = all_tiles_done;
   }
 
+  // Returns the number of tiles that need raster but that the raster queue
+  // skips because they are occluded.
+  size_t CountOccludedTilesNeedingRaster() const;
+
   bool can_use_lcd_text() const { return can_use_lcd_text_; }
 
   WhichTree tree() const { return tree_; }
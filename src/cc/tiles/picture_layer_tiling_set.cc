@@ -20,6 +20,7 @@
 #include "base/trace_event/trace_event.h"
 #include "cc/raster/raster_source.h"
 #include "ui/gfx/geometry/rect_conversions.h"
+#include "ui/gfx/geometry/vector2d_conversions.h"
 
 namespace cc {
 
@@ -510,6 +511,14 @@ void PictureLayerTilingSet::UpdatePriorityRects(
   skewport_in_layer_space_ =
       ComputeSkewport(visible_rect_in_layer_space_,
                       current_frame_time_in_seconds, ideal_contents_scale);
+  if (!predicted_fling_displacement_.IsZero() &&
+      !visible_rect_in_layer_space_.IsEmpty()) {
+    gfx::Rect fling_end_rect =
+        visible_rect_in_layer_space_ +
+        gfx::ToRoundedVector2d(predicted_fling_displacement_);
+    skewport_in_layer_space_.Union(fling_end_rect);
+    skewport_in_layer_space_.Intersect(eventually_rect_in_layer_space_);
+  }
   DCHECK(skewport_in_layer_space_.Contains(visible_rect_in_layer_space_));
   DCHECK(eventually_rect_in_layer_space_.Contains(skewport_in_layer_space_));
 
@@ -737,6 +746,13 @@ size_t PictureLayerTilingSet::GPUMemoryUsageInBytes() const {
   return amount;
 }
 
+size_t PictureLayerTilingSet::CountOccludedTilesNeedingRaster() const {
+  size_t count = 0;
+  for (const auto& tiling : tilings_)
+    count += tiling->CountOccludedTilesNeedingRaster();
+  return count;
+}
+
 PictureLayerTilingSet::TilingRange PictureLayerTilingSet::GetTilingRange(
     TilingRangeType type) const {
   // Doesn't seem to be the case right now but if it ever becomes a performance
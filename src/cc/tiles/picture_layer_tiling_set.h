@@ -17,6 +17,7 @@
 #include "cc/base/region.h"
 #include "cc/tiles/picture_layer_tiling.h"
 #include "ui/gfx/geometry/size.h"
+#include "ui/gfx/geometry/vector2d_f.h"
 
 namespace base {
 namespace trace_event {
@@ -130,6 +131,13 @@ class CC_EXPORT PictureLayerTilingSet {
   // Remove all tiles; keep all tilings.
   void RemoveAllTiles();
 
+  // Sets how far, in layer space, the visible rect is predicted to move before
+  // the fling in progress ends. The skewport is extended to cover the way
+  // there, since those tiles are needed soon whatever the current velocity.
+  void set_predicted_fling_displacement(const gfx::Vector2dF& displacement) {
+    predicted_fling_displacement_ = displacement;
+  }
+
   // Update the rects and priorities for tiles based on the given information.
   // Returns true if PrepareTiles is required.
   bool UpdateTilePriorities(const gfx::Rect& required_rect_in_layer_space,
@@ -195,6 +203,9 @@ class CC_EXPORT PictureLayerTilingSet {
 
   void AsValueInto(base::trace_event::TracedValue* array) const;
   size_t GPUMemoryUsageInBytes() const;
+  // Sum of PictureLayerTiling::CountOccludedTilesNeedingRaster() over all
+  // tilings.
+  size_t CountOccludedTilesNeedingRaster() const;
 
   TilingRange GetTilingRange(TilingRangeType type) const;
 
@@ -275,6 +286,7 @@ class CC_EXPORT PictureLayerTilingSet {
   gfx::Rect skewport_in_layer_space_;
   gfx::Rect soon_border_rect_in_layer_space_;
   gfx::Rect eventually_rect_in_layer_space_;
+  gfx::Vector2dF predicted_fling_displacement_;
 
   friend class Iterator;
 };
@@ -630,6 +630,45 @@ TEST(PictureLayerTilingSetTest, SkewportLimits) {
   EXPECT_TRUE(move_skewport_far.Contains(gfx::Rect(0, 5000, 100, 100)));
 }
 
+TEST(PictureLayerTilingSetTest, SkewportCoversPredictedFlingEnd) {
+  FakePictureLayerTilingClient client;
+
+  gfx::Rect viewport(0, 0, 100, 100);
+  gfx::Size layer_bounds(200, 2000);
+
+  client.SetTileSize(gfx::Size(100, 100));
+  LayerTreeSettings settings;
+  settings.skewport_extrapolation_limit_in_screen_pixels = 75;
+  settings.tiling_interest_area_padding = 1000;
+
+  scoped_refptr<FakeRasterSource> raster_source =
+      FakeRasterSource::CreateFilled(layer_bounds);
+  std::unique_ptr<TestablePictureLayerTilingSet> tiling_set =
+      CreateTilingSetWithSettings(&client, settings);
+  tiling_set->AddTiling(gfx::AxisTransform2d(), raster_source);
+  const PictureLayerTiling* tiling = tiling_set->tiling_at(0);
+
+  tiling_set->UpdateTilePriorities(viewport, 1.f, 1.0, Occlusion(), true);
+
+  // Move viewport down 50 pixels in 0.5 seconds. The skewport is limited to
+  // 75 pixels past the viewport.
+  tiling_set->UpdateTilePriorities(gfx::Rect(0, 50, 100, 100), 1.f, 1.5,
+                                   Occlusion(), true);
+  EXPECT_EQ(gfx::Rect(0, 50, 100, 175), tiling->current_skewport_rect());
+
+  // The fling is predicted to end 500 pixels further down.
+  tiling_set->set_predicted_fling_displacement(gfx::Vector2dF(0, 500));
+  tiling_set->UpdateTilePriorities(gfx::Rect(0, 100, 100, 100), 1.f, 2.0,
+                                   Occlusion(), true);
+  EXPECT_EQ(gfx::Rect(0, 100, 100, 600), tiling->current_skewport_rect());
+
+  // The skewport never extends past the eventually rect.
+  tiling_set->set_predicted_fling_displacement(gfx::Vector2dF(0, 5000));
+  tiling_set->UpdateTilePriorities(gfx::Rect(0, 150, 100, 100), 1.f, 2.5,
+                                   Occlusion(), true);
+  EXPECT_EQ(gfx::Rect(0, 150, 100, 1100), tiling->current_skewport_rect());
+}
+
 TEST(PictureLayerTilingSetTest, ComputeSkewportExtremeCases) {
   FakePictureLayerTilingClient client;
 
@@ -4,10 +4,18 @@
 
 #include "cc/tiles/raster_tile_priority_queue_all.h"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 
+#include "base/feature_list.h"
+#include "base/functional/bind.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/raw_ref.h"
 #include "base/notreached.h"
+#include "base/task/post_job.h"
+#include "base/task/thread_pool/thread_pool_instance.h"
+#include "base/trace_event/trace_event.h"
 #include "cc/base/features.h"
 #include "cc/tiles/tiling_set_raster_queue_all.h"
 
@@ -61,25 +69,116 @@ class RasterOrderComparator {
   TreePriority tree_priority_;
 };
 
+// Below this many layers the cost of posting a job outweighs the work saved.
+constexpr size_t kMinLayersForParallelConstruction = 32;
+// Number of layers each job worker claims at a time.
+constexpr size_t kLayersPerParallelChunk = 8;
+
+std::unique_ptr<TilingSetRasterQueueAll> CreateTilingSetRasterQueue(
+    PictureLayerImpl* layer,
+    TreePriority tree_priority) {
+  if (!layer->HasValidTilePriorities())
+    return nullptr;
+
+  PictureLayerTilingSet* tiling_set = layer->picture_layer_tiling_set();
+  bool prioritize_low_res = tree_priority == SMOOTHNESS_TAKES_PRIORITY;
+  std::unique_ptr<TilingSetRasterQueueAll> tiling_set_queue =
+      std::make_unique<TilingSetRasterQueueAll>(
+          tiling_set, prioritize_low_res,
+          layer->contributes_to_drawn_render_surface());
+  // Queues will only contain non empty tiling sets.
+  if (tiling_set_queue->IsEmpty())
+    return nullptr;
+  return tiling_set_queue;
+}
+
+// Builds the per-layer queues of a single tree on the thread pool, with the
+// calling thread participating. Every layer's queue only reads and updates
+// state owned by that layer's tilings (and, for the active tree, reads the
+// pending twin, which is not being built concurrently), so layers of the same
+// tree can be processed independently. Results are written to the slot of the
+// corresponding layer, which keeps the final order identical to the serial
+// path.
+class ParallelTilingSetRasterQueueBuilder {
+ public:
+  ParallelTilingSetRasterQueueBuilder(
+      const std::vector<raw_ptr<PictureLayerImpl, VectorExperimental>>& layers,
+      TreePriority tree_priority,
+      std::vector<std::unique_ptr<TilingSetRasterQueueAll>>* results)
+      : layers_(layers), tree_priority_(tree_priority), results_(results) {
+    results_->resize(layers_->size());
+  }
+  ParallelTilingSetRasterQueueBuilder(
+      const ParallelTilingSetRasterQueueBuilder&) = delete;
+  ParallelTilingSetRasterQueueBuilder& operator=(
+      const ParallelTilingSetRasterQueueBuilder&) = delete;
+
+  void Run() {
+    base::PostJob(
+        FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+        base::BindRepeating(&ParallelTilingSetRasterQueueBuilder::RunChunks,
+                            base::Unretained(this)),
+        base::BindRepeating(
+            &ParallelTilingSetRasterQueueBuilder::GetMaxConcurrency,
+            base::Unretained(this)))
+        .Join();
+  }
+
+ private:
+  void RunChunks(base::JobDelegate* delegate) {
+    TRACE_EVENT0("cc", "ParallelTilingSetRasterQueueBuilder::RunChunks");
+    const size_t num_layers = layers_->size();
+    while (!delegate->ShouldYield()) {
+      size_t begin = next_layer_.fetch_add(kLayersPerParallelChunk,
+                                           std::memory_order_relaxed);
+      if (begin >= num_layers)
+        return;
+      size_t end = std::min(begin + kLayersPerParallelChunk, num_layers);
+      for (size_t i = begin; i < end; ++i) {
+        (*results_)[i] =
+            CreateTilingSetRasterQueue((*layers_)[i], tree_priority_);
+      }
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const {
+    size_t next_layer = next_layer_.load(std::memory_order_relaxed);
+    size_t num_layers = layers_->size();
+    if (next_layer >= num_layers)
+      return 0;
+    return (num_layers - next_layer + kLayersPerParallelChunk - 1) /
+           kLayersPerParallelChunk;
+  }
+
+  const raw_ref<
+      const std::vector<raw_ptr<PictureLayerImpl, VectorExperimental>>>
+      layers_;
+  const TreePriority tree_priority_;
+  const raw_ptr<std::vector<std::unique_ptr<TilingSetRasterQueueAll>>>
+      results_;
+  std::atomic<size_t> next_layer_{0};
+};
+
 void CreateTilingSetRasterQueues(
     const std::vector<raw_ptr<PictureLayerImpl, VectorExperimental>>& layers,
     TreePriority tree_priority,
     std::vector<std::unique_ptr<TilingSetRasterQueueAll>>* queues) {
   DCHECK(queues->empty());
 
-  for (PictureLayerImpl* layer : layers) {
-    if (!layer->HasValidTilePriorities())
-      continue;
-
-    PictureLayerTilingSet* tiling_set = layer->picture_layer_tiling_set();
-    bool prioritize_low_res = tree_priority == SMOOTHNESS_TAKES_PRIORITY;
-    std::unique_ptr<TilingSetRasterQueueAll> tiling_set_queue =
-        std::make_unique<TilingSetRasterQueueAll>(
-            tiling_set, prioritize_low_res,
-            layer->contributes_to_drawn_render_surface());
-    // Queues will only contain non empty tiling sets.
-    if (!tiling_set_queue->IsEmpty())
-      queues->push_back(std::move(tiling_set_queue));
+  if (layers.size() >= kMinLayersForParallelConstruction &&
+      base::ThreadPoolInstance::Get() &&
+      base::FeatureList::IsEnabled(
+          features::kParallelRasterTileQueueConstruction)) {
+    ParallelTilingSetRasterQueueBuilder(layers, tree_priority, queues).Run();
+    // Drop the slots of layers that produced no queue, preserving layer order.
+    std::erase(*queues, nullptr);
+  } else {
+    for (PictureLayerImpl* layer : layers) {
+      std::unique_ptr<TilingSetRasterQueueAll> tiling_set_queue =
+          CreateTilingSetRasterQueue(layer, tree_priority);
+      if (tiling_set_queue)
+        queues->push_back(std::move(tiling_set_queue));
+    }
   }
   std::make_heap(queues->begin(), queues->end(),
                  RasterOrderComparator(tree_priority));
@@ -0,0 +1,160 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/tiles/shared_decoded_image_cache.h"
+
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/location.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/trace_event/trace_event.h"
+
+namespace cc {
+
+SharedDecodedImageCache::SharedDecodedImageCache(size_t max_entries,
+                                                 size_t max_bytes)
+    : max_entries_(max_entries),
+      max_bytes_(max_bytes),
+      entries_(EntryLRUCache::NO_AUTO_EVICT) {}
+
+SharedDecodedImageCache::~SharedDecodedImageCache() {
+  Clear();
+}
+
+// static
+SharedDecodedImageCache* SharedDecodedImageCache::GetInstance() {
+  static base::NoDestructor<SharedDecodedImageCache> instance(
+      kDefaultMaxEntries, kDefaultMaxBytes);
+  return instance.get();
+}
+
+void SharedDecodedImageCache::EnsureMemoryPressureListener() {
+  if (!base::SequencedTaskRunner::HasCurrentDefault())
+    return;
+
+  base::AutoLock hold(lock_);
+  if (memory_pressure_listener_)
+    return;
+  memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+      FROM_HERE, base::BindRepeating(&SharedDecodedImageCache::OnMemoryPressure,
+                                     base::Unretained(this)));
+}
+
+void SharedDecodedImageCache::Put(const CacheKey& key,
+                                  std::unique_ptr<CacheEntry> entry) {
+  DCHECK(entry);
+  DCHECK(!entry->is_locked);
+  DCHECK(!entry->is_budgeted);
+  DCHECK_EQ(entry->ref_count, 0);
+  if (!entry->memory || entry->decode_failed)
+    return;
+
+  const size_t entry_bytes = entry->image_info().computeMinByteSize();
+  if (entry_bytes > max_bytes_)
+    return;
+
+  TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("cc.debug"),
+               "SharedDecodedImageCache::Put", "key", key.ToString());
+  base::AutoLock hold(lock_);
+  auto existing_it = entries_.Peek(key);
+  if (existing_it != entries_.end())
+    Erase(existing_it);
+
+  entries_.Put(key, std::move(entry));
+  current_bytes_ += entry_bytes;
+  EvictUntilWithinLimits(max_entries_, max_bytes_);
+}
+
+std::unique_ptr<SharedDecodedImageCache::CacheEntry>
+SharedDecodedImageCache::Take(const CacheKey& key, SkColorType color_type) {
+  std::unique_ptr<CacheEntry> entry;
+  {
+    base::AutoLock hold(lock_);
+    auto it = entries_.Peek(key);
+    if (it == entries_.end()) {
+      ++misses_;
+      return nullptr;
+    }
+    entry = std::move(it->second);
+    current_bytes_ -= entry->image_info().computeMinByteSize();
+    entries_.Erase(it);
+  }
+
+  // The decode may have been produced for a cache with a different output
+  // color type, in which case it can't be adopted as is. The key would not
+  // have matched for any other difference in the decode parameters.
+  // Lock() drops the memory if it was purged while unlocked.
+  if (entry->image_info().colorType() != color_type || !entry->Lock()) {
+    base::AutoLock hold(lock_);
+    ++misses_;
+    return nullptr;
+  }
+
+  TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("cc.debug"),
+               "SharedDecodedImageCache::Take hit", "key", key.ToString());
+  base::AutoLock hold(lock_);
+  ++hits_;
+  return entry;
+}
+
+void SharedDecodedImageCache::Clear() {
+  base::AutoLock hold(lock_);
+  EvictUntilWithinLimits(0u, 0u);
+}
+
+size_t SharedDecodedImageCache::GetNumEntriesForTesting() {
+  base::AutoLock hold(lock_);
+  return entries_.size();
+}
+
+size_t SharedDecodedImageCache::GetBytesForTesting() {
+  base::AutoLock hold(lock_);
+  return current_bytes_.ValueOrDie();
+}
+
+size_t SharedDecodedImageCache::hits_for_testing() {
+  base::AutoLock hold(lock_);
+  return hits_;
+}
+
+size_t SharedDecodedImageCache::misses_for_testing() {
+  base::AutoLock hold(lock_);
+  return misses_;
+}
+
+void SharedDecodedImageCache::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  base::AutoLock hold(lock_);
+  switch (level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      EvictUntilWithinLimits(entries_.size() / 2,
+                             current_bytes_.ValueOrDie() / 2);
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      EvictUntilWithinLimits(0u, 0u);
+      break;
+  }
+}
+
+void SharedDecodedImageCache::EvictUntilWithinLimits(size_t max_entries,
+                                                     size_t max_bytes) {
+  auto it = entries_.rbegin();
+  while (it != entries_.rend() &&
+         (entries_.size() > max_entries ||
+          current_bytes_.ValueOrDie() > max_bytes)) {
+    current_bytes_ -= it->second->image_info().computeMinByteSize();
+    it = entries_.Erase(it);
+  }
+}
+
+SharedDecodedImageCache::EntryLRUCache::iterator SharedDecodedImageCache::Erase(
+    EntryLRUCache::iterator it) {
+  current_bytes_ -= it->second->image_info().computeMinByteSize();
+  return entries_.Erase(it);
+}
+
+}  // namespace cc
@@ -0,0 +1,101 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_TILES_SHARED_DECODED_IMAGE_CACHE_H_
+#define CC_TILES_SHARED_DECODED_IMAGE_CACHE_H_
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "base/containers/lru_cache.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/no_destructor.h"
+#include "base/numerics/safe_math.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "cc/cc_export.h"
+#include "cc/tiles/software_image_decode_cache_utils.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
+
+namespace cc {
+
+// SharedDecodedImageCache is a process-wide pool of unlocked software decodes
+// that outlives individual SoftwareImageDecodeCache instances. When a
+// SoftwareImageDecodeCache evicts an unreferenced decode (or is destroyed, as
+// happens when a LayerTreeHost is torn down on navigation), it donates the
+// still-valid discardable memory here instead of freeing it. A subsequent cache
+// that needs the same CacheKey can then adopt the memory rather than decoding
+// again.
+//
+// Entries are kept unlocked, so the discardable memory system remains free to
+// purge them. The pool itself is bounded by both entry count and bytes and is
+// trimmed on memory pressure. All methods are thread safe.
+class CC_EXPORT SharedDecodedImageCache {
+ public:
+  using CacheKey = SoftwareImageDecodeCacheUtils::CacheKey;
+  using CacheKeyHash = SoftwareImageDecodeCacheUtils::CacheKeyHash;
+  using CacheEntry = SoftwareImageDecodeCacheUtils::CacheEntry;
+
+  static constexpr size_t kDefaultMaxEntries = 256;
+  static constexpr size_t kDefaultMaxBytes = 64 * 1024 * 1024;
+
+  SharedDecodedImageCache(size_t max_entries, size_t max_bytes);
+  SharedDecodedImageCache(const SharedDecodedImageCache&) = delete;
+  SharedDecodedImageCache& operator=(const SharedDecodedImageCache&) = delete;
+  ~SharedDecodedImageCache();
+
+  static SharedDecodedImageCache* GetInstance();
+
+  // Starts listening for memory pressure signals. This must be called on a
+  // sequence with a current default task runner; calls after the first are
+  // no-ops.
+  void EnsureMemoryPressureListener();
+
+  // Takes ownership of the unlocked memory held by |entry|. |entry| must not be
+  // locked, budgeted or referenced. Entries without memory or for failed
+  // decodes are dropped.
+  void Put(const CacheKey& key, std::unique_ptr<CacheEntry> entry);
+
+  // Removes the entry for |key| and returns it in a locked state if it was
+  // decoded to |color_type| and its memory could still be locked. Returns
+  // nullptr otherwise.
+  std::unique_ptr<CacheEntry> Take(const CacheKey& key, SkColorType color_type);
+
+  // Drops every entry in the pool.
+  void Clear();
+
+  size_t GetNumEntriesForTesting();
+  size_t GetBytesForTesting();
+  size_t hits_for_testing();
+  size_t misses_for_testing();
+
+ private:
+  friend class base::NoDestructor<SharedDecodedImageCache>;
+
+  using EntryLRUCache = base::
+      HashingLRUCache<CacheKey, std::unique_ptr<CacheEntry>, CacheKeyHash>;
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+  void EvictUntilWithinLimits(size_t max_entries, size_t max_bytes)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  EntryLRUCache::iterator Erase(EntryLRUCache::iterator it)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  const size_t max_entries_;
+  const size_t max_bytes_;
+
+  base::Lock lock_;
+  EntryLRUCache entries_ GUARDED_BY(lock_);
+  base::CheckedNumeric<size_t> current_bytes_ GUARDED_BY(lock_) = 0u;
+  size_t hits_ GUARDED_BY(lock_) = 0u;
+  size_t misses_ GUARDED_BY(lock_) = 0u;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_
+      GUARDED_BY(lock_);
+};
+
+}  // namespace cc
+
+#endif  // CC_TILES_SHARED_DECODED_IMAGE_CACHE_H_
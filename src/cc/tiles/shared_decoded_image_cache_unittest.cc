@@ -0,0 +1,154 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/tiles/shared_decoded_image_cache.h"
+
+#include <memory>
+
+#include "cc/paint/draw_image.h"
+#include "cc/test/skia_common.h"
+#include "cc/tiles/software_image_decode_cache.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkM44.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+namespace cc {
+namespace {
+
+constexpr size_t kLockedMemoryLimitBytes = 128 * 1024 * 1024;
+
+DrawImage CreateDrawImage(const PaintImage& paint_image) {
+  return DrawImage(paint_image, false,
+                   SkIRect::MakeWH(paint_image.width(), paint_image.height()),
+                   PaintFlags::FilterQuality::kLow, SkM44(),
+                   PaintImage::kDefaultFrameIndex, TargetColorParams());
+}
+
+std::unique_ptr<SoftwareImageDecodeCache> CreateCache(
+    SharedDecodedImageCache* shared_cache,
+    SkColorType color_type = kN32_SkColorType) {
+  return std::make_unique<SoftwareImageDecodeCache>(
+      color_type, kLockedMemoryLimitBytes, shared_cache);
+}
+
+void DrawOnce(SoftwareImageDecodeCache* cache, const DrawImage& draw_image) {
+  DecodedDrawImage decoded_draw_image =
+      cache->GetDecodedImageForDraw(draw_image);
+  EXPECT_TRUE(decoded_draw_image.image());
+  cache->DrawWithImageFinished(draw_image, decoded_draw_image);
+}
+
+TEST(SharedDecodedImageCacheTest, DecodesSurviveCacheDestruction) {
+  SharedDecodedImageCache shared_cache(
+      SharedDecodedImageCache::kDefaultMaxEntries,
+      SharedDecodedImageCache::kDefaultMaxBytes);
+  DrawImage draw_image =
+      CreateDrawImage(CreateDiscardablePaintImage(gfx::Size(100, 100)));
+
+  auto cache = CreateCache(&shared_cache);
+  DrawOnce(cache.get(), draw_image);
+  EXPECT_EQ(0u, shared_cache.GetNumEntriesForTesting());
+  cache.reset();
+  EXPECT_EQ(1u, shared_cache.GetNumEntriesForTesting());
+  EXPECT_EQ(100u * 100u * 4u, shared_cache.GetBytesForTesting());
+
+  // A new cache adopts the decode instead of decoding again.
+  cache = CreateCache(&shared_cache);
+  DrawOnce(cache.get(), draw_image);
+  EXPECT_EQ(1u, shared_cache.hits_for_testing());
+  EXPECT_EQ(0u, shared_cache.GetNumEntriesForTesting());
+  EXPECT_EQ(0u, shared_cache.GetBytesForTesting());
+  cache.reset();
+}
+
+TEST(SharedDecodedImageCacheTest, MissForUnknownImage) {
+  SharedDecodedImageCache shared_cache(
+      SharedDecodedImageCache::kDefaultMaxEntries,
+      SharedDecodedImageCache::kDefaultMaxBytes);
+  auto cache = CreateCache(&shared_cache);
+  DrawOnce(cache.get(), CreateDrawImage(CreateDiscardablePaintImage(
+                            gfx::Size(100, 100))));
+  EXPECT_EQ(0u, shared_cache.hits_for_testing());
+  EXPECT_EQ(1u, shared_cache.misses_for_testing());
+}
+
+TEST(SharedDecodedImageCacheTest, EvictsLeastRecentlyDonated) {
+  SharedDecodedImageCache shared_cache(
+      /*max_entries=*/2, SharedDecodedImageCache::kDefaultMaxBytes);
+  DrawImage draw_images[] = {
+      CreateDrawImage(CreateDiscardablePaintImage(gfx::Size(100, 100))),
+      CreateDrawImage(CreateDiscardablePaintImage(gfx::Size(100, 100))),
+      CreateDrawImage(CreateDiscardablePaintImage(gfx::Size(100, 100)))};
+
+  for (const auto& draw_image : draw_images) {
+    auto cache = CreateCache(&shared_cache);
+    DrawOnce(cache.get(), draw_image);
+  }
+  EXPECT_EQ(2u, shared_cache.GetNumEntriesForTesting());
+
+  // The first decode was evicted.
+  auto cache = CreateCache(&shared_cache);
+  DrawOnce(cache.get(), draw_images[0]);
+  EXPECT_EQ(0u, shared_cache.hits_for_testing());
+  DrawOnce(cache.get(), draw_images[2]);
+  EXPECT_EQ(1u, shared_cache.hits_for_testing());
+}
+
+TEST(SharedDecodedImageCacheTest, RespectsByteLimit) {
+  SharedDecodedImageCache shared_cache(
+      SharedDecodedImageCache::kDefaultMaxEntries,
+      /*max_bytes=*/100 * 100 * 4);
+  auto cache = CreateCache(&shared_cache);
+  DrawOnce(cache.get(), CreateDrawImage(CreateDiscardablePaintImage(
+                            gfx::Size(100, 100))));
+  DrawOnce(cache.get(), CreateDrawImage(CreateDiscardablePaintImage(
+                            gfx::Size(100, 100))));
+  DrawOnce(cache.get(), CreateDrawImage(CreateDiscardablePaintImage(
+                            gfx::Size(200, 200))));
+  cache.reset();
+  EXPECT_EQ(1u, shared_cache.GetNumEntriesForTesting());
+  EXPECT_LE(shared_cache.GetBytesForTesting(), 100u * 100u * 4u);
+}
+
+TEST(SharedDecodedImageCacheTest, ClearCacheDoesNotDonate) {
+  SharedDecodedImageCache shared_cache(
+      SharedDecodedImageCache::kDefaultMaxEntries,
+      SharedDecodedImageCache::kDefaultMaxBytes);
+  DrawImage draw_image =
+      CreateDrawImage(CreateDiscardablePaintImage(gfx::Size(100, 100)));
+
+  auto cache = CreateCache(&shared_cache);
+  DrawOnce(cache.get(), draw_image);
+  cache.reset();
+  EXPECT_EQ(1u, shared_cache.GetNumEntriesForTesting());
+
+  cache = CreateCache(&shared_cache);
+  DrawOnce(cache.get(),
+           CreateDrawImage(CreateDiscardablePaintImage(gfx::Size(100, 100))));
+  cache->ClearCache();
+  EXPECT_EQ(0u, shared_cache.GetNumEntriesForTesting());
+  EXPECT_EQ(0u, cache->GetNumCacheEntriesForTesting());
+}
+
+TEST(SharedDecodedImageCacheTest, ColorTypeMismatchIsMiss) {
+  SharedDecodedImageCache shared_cache(
+      SharedDecodedImageCache::kDefaultMaxEntries,
+      SharedDecodedImageCache::kDefaultMaxBytes);
+  DrawImage draw_image =
+      CreateDrawImage(CreateDiscardablePaintImage(gfx::Size(100, 100)));
+
+  auto cache = CreateCache(&shared_cache);
+  DrawOnce(cache.get(), draw_image);
+  cache.reset();
+  ASSERT_EQ(1u, shared_cache.GetNumEntriesForTesting());
+
+  cache = CreateCache(&shared_cache, kARGB_4444_SkColorType);
+  cache->GetDecodedImageForDraw(draw_image);
+  cache->UnrefImage(draw_image);
+  EXPECT_EQ(0u, shared_cache.hits_for_testing());
+  cache.reset();
+}
+
+}  // namespace
+}  // namespace cc
@@ -26,6 +26,7 @@
 #include "cc/base/histograms.h"
 #include "cc/raster/tile_task.h"
 #include "cc/tiles/mipmap_util.h"
+#include "cc/tiles/shared_decoded_image_cache.h"
 #include "components/miracle_parameter/common/public/miracle_parameter.h"
 #include "ui/gfx/geometry/skia_conversions.h"
 
@@ -163,12 +164,27 @@ PaintFlags::FilterQuality GetDecodedFilterQuality(
 SoftwareImageDecodeCache::SoftwareImageDecodeCache(
     SkColorType color_type,
     size_t locked_memory_limit_bytes)
+    : SoftwareImageDecodeCache(
+          color_type,
+          locked_memory_limit_bytes,
+          base::FeatureList::IsEnabled(
+              features::kSharedSoftwareImageDecodeCache)
+              ? SharedDecodedImageCache::GetInstance()
+              : nullptr) {}
+
+SoftwareImageDecodeCache::SoftwareImageDecodeCache(
+    SkColorType color_type,
+    size_t locked_memory_limit_bytes,
+    SharedDecodedImageCache* shared_cache)
     : decoded_images_(ImageLRUCache::NO_AUTO_EVICT),
       locked_images_budget_(locked_memory_limit_bytes),
       color_type_(color_type),
       generator_client_id_(PaintImage::GetNextGeneratorClientId()),
-      max_items_in_cache_(GetNormalMaxItemsInCacheForSoftware()) {
+      max_items_in_cache_(GetNormalMaxItemsInCacheForSoftware()),
+      shared_cache_(shared_cache) {
   DCHECK_NE(generator_client_id_, PaintImage::kDefaultGeneratorClientId);
+  if (shared_cache_)
+    shared_cache_->EnsureMemoryPressureListener();
   // In certain cases, SingleThreadTaskRunner::CurrentDefaultHandle isn't set
   // (Android Webview).  Don't register a dump provider in these cases.
   if (base::SingleThreadTaskRunner::HasCurrentDefault()) {
@@ -182,6 +198,13 @@ SoftwareImageDecodeCache::~SoftwareImageDecodeCache() {
   // It is safe to unregister, even if we didn't register in the constructor.
   base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
       this);
+
+  // Hand the remaining decodes to the shared cache so that the next cache
+  // (e.g. the one created for the next page) can reuse them.
+  if (shared_cache_) {
+    base::AutoLock lock(lock_);
+    ReduceCacheUsageUntilWithinLimit(0, /*donate_to_shared_cache=*/true);
+  }
 }
 
 ImageDecodeCache::TaskResult SoftwareImageDecodeCache::GetTaskForImageAndRef(
@@ -328,7 +351,8 @@ void SoftwareImageDecodeCache::UnrefImage(const CacheKey& key) {
     if (entry->is_locked)
       entry->Unlock();
 
-    ReduceCacheUsageUntilWithinLimit(max_items_in_cache_);
+    ReduceCacheUsageUntilWithinLimit(max_items_in_cache_,
+                                     /*donate_to_shared_cache=*/true);
   }
 }
 
@@ -379,6 +403,17 @@ SoftwareImageDecodeCache::DecodeImageIfNecessary(const CacheKey& key,
       return TaskProcessingResult::kLockOnly;
   }
 
+  // Another cache may have left a decode for this key behind.
+  if (shared_cache_) {
+    std::unique_ptr<CacheEntry> shared_entry = shared_cache_->Take(
+        key, GetColorTypeForPaintImage(key.target_color_params(), paint_image));
+    if (shared_entry) {
+      shared_entry->MoveImageMemoryTo(entry);
+      DCHECK(entry->is_locked);
+      return TaskProcessingResult::kLockOnly;
+    }
+  }
+
   std::unique_ptr<CacheEntry> local_cache_entry;
   // If we can use the original decode, we'll definitely need a decode.
   if (key.type() == CacheKey::kOriginal) {
@@ -625,7 +660,9 @@ void SoftwareImageDecodeCache::DrawWithImageFinished(
   UnrefImage(image);
 }
 
-void SoftwareImageDecodeCache::ReduceCacheUsageUntilWithinLimit(size_t limit) {
+void SoftwareImageDecodeCache::ReduceCacheUsageUntilWithinLimit(
+    size_t limit,
+    bool donate_to_shared_cache) {
   TRACE_EVENT0("cc",
                "SoftwareImageDecodeCache::ReduceCacheUsageUntilWithinLimit");
   for (auto it = decoded_images_.rbegin();
@@ -643,18 +680,33 @@ void SoftwareImageDecodeCache::ReduceCacheUsageUntilWithinLimit(size_t limit) {
     if (vector_it->second.empty())
       frame_key_to_image_keys_.erase(vector_it);
 
+    CacheEntry* entry = it->second.get();
+    if (donate_to_shared_cache && shared_cache_ && entry->memory &&
+        !entry->decode_failed) {
+      DCHECK(!entry->is_locked);
+      auto shared_entry = std::make_unique<CacheEntry>();
+      entry->MoveImageMemoryTo(shared_entry.get());
+      shared_cache_->Put(key, std::move(shared_entry));
+    }
+
     it = decoded_images_.Erase(it);
   }
 }
 
 void SoftwareImageDecodeCache::ReduceCacheUsage() {
   base::AutoLock lock(lock_);
-  ReduceCacheUsageUntilWithinLimit(max_items_in_cache_);
+  ReduceCacheUsageUntilWithinLimit(max_items_in_cache_,
+                                   /*donate_to_shared_cache=*/true);
 }
 
 void SoftwareImageDecodeCache::ClearCache() {
+  // This is also the out-of-memory callback for decodes, so release the memory
+  // rather than handing it to the shared cache, and drop what the shared cache
+  // holds as well.
   base::AutoLock lock(lock_);
-  ReduceCacheUsageUntilWithinLimit(0);
+  ReduceCacheUsageUntilWithinLimit(0, /*donate_to_shared_cache=*/false);
+  if (shared_cache_)
+    shared_cache_->Clear();
 }
 
 size_t SoftwareImageDecodeCache::GetMaximumMemoryLimitBytes() const {
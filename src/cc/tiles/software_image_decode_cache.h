@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "base/containers/lru_cache.h"
+#include "base/memory/raw_ptr.h"
 #include "base/numerics/safe_math.h"
 #include "base/thread_annotations.h"
 #include "base/trace_event/memory_dump_provider.h"
@@ -22,6 +23,8 @@
 
 namespace cc {
 
+class SharedDecodedImageCache;
+
 class CC_EXPORT SoftwareImageDecodeCache
     : public ImageDecodeCache,
       public base::trace_event::MemoryDumpProvider {
@@ -38,6 +41,11 @@ class CC_EXPORT SoftwareImageDecodeCache
 
   SoftwareImageDecodeCache(SkColorType color_type,
                            size_t locked_memory_limit_bytes);
+  // |shared_cache| may be null, in which case evicted decodes are freed rather
+  // than shared with other caches.
+  SoftwareImageDecodeCache(SkColorType color_type,
+                           size_t locked_memory_limit_bytes,
+                           SharedDecodedImageCache* shared_cache);
   ~SoftwareImageDecodeCache() override;
 
   // ImageDecodeCache overrides.
@@ -112,8 +120,11 @@ class CC_EXPORT SoftwareImageDecodeCache
       EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   // Removes unlocked decoded images until the number of decoded images is
-  // reduced within the given limit.
-  void ReduceCacheUsageUntilWithinLimit(size_t limit)
+  // reduced within the given limit. If |donate_to_shared_cache| is true, the
+  // memory of evicted decodes is handed to |shared_cache_| instead of being
+  // freed.
+  void ReduceCacheUsageUntilWithinLimit(size_t limit,
+                                        bool donate_to_shared_cache)
       EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   // Helper method to get the different tasks. Note that this should be used as
@@ -163,6 +174,10 @@ class CC_EXPORT SoftwareImageDecodeCache
   const PaintImage::GeneratorClientId generator_client_id_;
 
   const size_t max_items_in_cache_;
+
+  // Process-wide pool of unlocked decodes that is shared across caches. Null
+  // unless features::kSharedSoftwareImageDecodeCache is enabled.
+  const raw_ptr<SharedDecodedImageCache> shared_cache_;
 };
 
 }  // namespace cc
@@ -2,12 +2,16 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "base/timer/lap_timer.h"
 #include "cc/paint/draw_image.h"
 #include "cc/paint/paint_image_builder.h"
 #include "cc/raster/tile_task.h"
+#include "cc/test/skia_common.h"
+#include "cc/tiles/shared_decoded_image_cache.h"
 #include "cc/tiles/software_image_decode_cache.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_result_reporter.h"
@@ -90,6 +94,48 @@ class SoftwareImageDecodeCachePerfTest : public testing::Test {
     reporter.AddResult("", timer_.LapsPerSecond());
   }
 
+  // Simulates a sequence of navigations that draw the same set of lazy images:
+  // each lap creates a new cache, draws every image once and destroys the
+  // cache again.
+  void RunCrossNavigation(bool use_shared_cache,
+                          const std::string& story_name) {
+    std::vector<DrawImage> images;
+    for (int i = 0; i < 32; ++i) {
+      PaintImage paint_image = CreateDiscardablePaintImage(gfx::Size(256, 256));
+      images.emplace_back(
+          paint_image, false,
+          SkIRect::MakeWH(paint_image.width(), paint_image.height()),
+          PaintFlags::FilterQuality::kLow, CreateMatrix(SkSize::Make(1.f, 1.f)),
+          PaintImage::kDefaultFrameIndex, TargetColorParams());
+    }
+
+    SharedDecodedImageCache shared_cache(
+        SharedDecodedImageCache::kDefaultMaxEntries,
+        SharedDecodedImageCache::kDefaultMaxBytes);
+    timer_.Reset();
+    do {
+      auto cache = std::make_unique<SoftwareImageDecodeCache>(
+          kN32_SkColorType, 128 * 1024 * 1024,
+          use_shared_cache ? &shared_cache : nullptr);
+      for (auto& image : images) {
+        DecodedDrawImage decoded_image = cache->GetDecodedImageForDraw(image);
+        cache->DrawWithImageFinished(image, decoded_image);
+      }
+      cache.reset();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PerfResultReporter reporter("software_image_decode_cache",
+                                           story_name);
+    reporter.RegisterImportantMetric("_navigations", "runs/s");
+    reporter.RegisterImportantMetric("_shared_hit_rate", "%");
+    reporter.AddResult("_navigations", timer_.LapsPerSecond());
+    const size_t hits = shared_cache.hits_for_testing();
+    const size_t lookups = hits + shared_cache.misses_for_testing();
+    reporter.AddResult("_shared_hit_rate",
+                       lookups ? 100.0 * hits / lookups : 0.0);
+  }
+
  private:
   base::LapTimer timer_;
 };
@@ -98,5 +144,13 @@ TEST_F(SoftwareImageDecodeCachePerfTest, FromDrawImage) {
   RunFromImage();
 }
 
+TEST_F(SoftwareImageDecodeCachePerfTest, CrossNavigation) {
+  RunCrossNavigation(/*use_shared_cache=*/false, "cross_navigation");
+}
+
+TEST_F(SoftwareImageDecodeCachePerfTest, CrossNavigationSharedCache) {
+  RunCrossNavigation(/*use_shared_cache=*/true, "cross_navigation_shared");
+}
+
 }  // namespace
 }  // namespace cc
@@ -32,6 +32,7 @@ class SoftwareImageDecodeCacheUtils {
  private:
   // The following should only be accessed by the software image cache.
   friend class SoftwareImageDecodeCache;
+  friend class SharedDecodedImageCache;
 
   // CacheKey is a class that gets a cache key out of a given draw
   // image. That is, this key uniquely identifies an image in the cache. Note
@@ -142,6 +143,7 @@ class SoftwareImageDecodeCacheUtils {
       return image_;
     }
     const SkSize& src_rect_offset() const { return src_rect_offset_; }
+    const SkImageInfo& image_info() const { return image_info_; }
 
     bool Lock();
     void Unlock();
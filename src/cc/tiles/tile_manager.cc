@@ -12,6 +12,7 @@
 #include <string>
 
 #include "base/containers/contains.h"
+#include "base/containers/flat_set.h"
 #include "base/feature_list.h"
 #include "base/functional/bind.h"
 #include "base/json/json_writer.h"
@@ -21,6 +22,7 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/notreached.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/numerics/safe_math.h"
 #include "base/ranges/algorithm.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/task/sequenced_task_runner.h"
@@ -959,7 +961,7 @@ TileManager::PrioritizedWorkToSchedule TileManager::AssignGpuMemoryToTiles() {
     MemoryUsage memory_required_by_tile_to_be_scheduled;
     if (!tile->raster_task_.get()) {
       memory_required_by_tile_to_be_scheduled = MemoryUsage::FromConfig(
-          tile->desired_texture_size(), DetermineFormat(tile));
+          tile->desired_texture_size(), DetermineFormat(prioritized_tile));
     }
 
     bool tile_is_needed_now = priority.priority_bin == TilePriority::NOW;
@@ -1062,6 +1064,18 @@ TileManager::PrioritizedWorkToSchedule TileManager::AssignGpuMemoryToTiles() {
     }
   }
 
+  // While scrolling, the tilings' skewports extend the pre-paint region in the
+  // direction of the scroll, so the pre-paint tiles left in the queue are the
+  // ones expected to scroll into view next. Decode their checker-imaged
+  // content ahead of raster.
+  if (had_enough_memory_to_schedule_tiles_needed_now &&
+      global_state_.tree_priority == SMOOTHNESS_TAKES_PRIORITY &&
+      base::FeatureList::IsEnabled(features::kPredictiveCheckerImageDecodes)) {
+    AddPredictedCheckeredImagesToDecodeQueue(
+        raster_priority_queue.get(),
+        &work_to_schedule.checker_image_decode_queue);
+  }
+
   did_oom_on_last_assign_ = !had_enough_memory_to_schedule_tiles_needed_now;
   // Since this is recorded once per frame, subsample these metrics.
   if (metrics_sub_sampler_.ShouldSample(0.01)) {
@@ -1187,6 +1201,61 @@ void TileManager::AddCheckeredImagesToDecodeQueue(
   }
 }
 
+void TileManager::AddPredictedCheckeredImagesToDecodeQueue(
+    RasterTilePriorityQueue* raster_priority_queue,
+    CheckerImageTracker::ImageDecodeQueue* image_decode_queue) {
+  TRACE_EVENT0("cc", "TileManager::AddPredictedCheckeredImagesToDecodeQueue");
+  size_t remaining_budget = base::saturated_cast<size_t>(
+      image_controller_.image_cache_max_limit_bytes() *
+      features::kPredictiveCheckerImageDecodeBudgetRatio.Get());
+
+  base::flat_set<PaintImage::Id> queued_images;
+  for (; !raster_priority_queue->IsEmpty() && remaining_budget > 0;
+       raster_priority_queue->Pop()) {
+    const PrioritizedTile& prioritized_tile = raster_priority_queue->Top();
+    if (prioritized_tile.priority().priority_bin > TilePriority::SOON)
+      break;
+
+    // Images are not drawn into low resolution tiles.
+    if (prioritized_tile.priority().resolution == LOW_RESOLUTION)
+      continue;
+
+    Tile* tile = prioritized_tile.tile();
+    const auto target_color_params = client_->GetTargetColorParams(
+        GetContentColorUsageForPrioritizedTile(prioritized_tile));
+    std::vector<const DrawImage*> images_in_tile;
+    prioritized_tile.raster_source()->GetDiscardableImagesInRect(
+        tile->enclosing_layer_rect(), &images_in_tile);
+    WhichTree tree = tile->tiling()->tree();
+    for (const auto* original_draw_image : images_in_tile) {
+      const PaintImage& paint_image = original_draw_image->paint_image();
+      if (base::Contains(queued_images, paint_image.stable_id()))
+        continue;
+
+      size_t frame_index = client_->GetFrameIndexForImage(paint_image, tree);
+      DrawImage draw_image(*original_draw_image, tile->contents_scale_key(),
+                           frame_index, target_color_params);
+      if (!checker_image_tracker_.ShouldCheckerImage(draw_image, tree))
+        continue;
+
+      base::CheckedNumeric<size_t> checked_image_bytes = 4u;
+      checked_image_bytes *= paint_image.width();
+      checked_image_bytes *= paint_image.height();
+      size_t image_bytes = checked_image_bytes.ValueOrDefault(
+          std::numeric_limits<size_t>::max());
+      if (image_bytes > remaining_budget) {
+        remaining_budget = 0u;
+        break;
+      }
+      remaining_budget -= image_bytes;
+      queued_images.insert(paint_image.stable_id());
+      image_decode_queue->emplace_back(
+          draw_image.paint_image(),
+          CheckerImageTracker::DecodeType::kPredictedRaster);
+    }
+  }
+}
+
 void TileManager::ScheduleTasks(PrioritizedWorkToSchedule work_to_schedule) {
   const std::vector<PrioritizedTile>& tiles_that_need_to_be_rasterized =
       work_to_schedule.tiles_to_raster;
@@ -1385,7 +1454,7 @@ scoped_refptr<TileTask> TileManager::CreateRasterTask(
   //
   // TODO(crbug.com/40128725): Once we have access to the display's buffer
   // format via gfx::DisplayColorSpaces, we should also do this for HBD images.
-  auto format = DetermineFormat(tile);
+  auto format = DetermineFormat(prioritized_tile);
   if (target_color_params.color_space.IsHDR() &&
       GetContentColorUsageForPrioritizedTile(prioritized_tile) ==
           gfx::ContentColorUsage::kHDR) {
@@ -1444,6 +1513,8 @@ scoped_refptr<TileTask> TileManager::CreateRasterTask(
         prioritized_tile, target_color_params, &sync_decoded_images,
         &checkered_images, partial_tile_decode ? &invalidated_rect : nullptr,
         &image_id_to_current_frame_index);
+    checker_image_tracker_.DidScheduleRasterWithImages(sync_decoded_images,
+                                                       checkered_images);
   }
 
   // Get the tasks for the required images.
@@ -1766,7 +1837,9 @@ void TileManager::IssueSignals() {
   } else if (!notify_ready_to_activate_pending &&
              !notify_ready_to_draw_pending) {
     checker_image_tracker_.SetMaxDecodePriorityAllowed(
-        CheckerImageTracker::DecodeType::kRaster);
+        base::FeatureList::IsEnabled(features::kPredictiveCheckerImageDecodes)
+            ? CheckerImageTracker::DecodeType::kPredictedRaster
+            : CheckerImageTracker::DecodeType::kRaster);
   }
 }
 
@@ -1878,8 +1951,38 @@ void TileManager::NeedsInvalidationForCheckerImagedTiles() {
   client_->RequestImplSideInvalidationForCheckerImagedTiles();
 }
 
-viz::SharedImageFormat TileManager::DetermineFormat(const Tile* tile) const {
-  return raster_buffer_provider_->GetFormat();
+viz::SharedImageFormat TileManager::DetermineFormat(
+    const PrioritizedTile& prioritized_tile) const {
+  const viz::SharedImageFormat format = raster_buffer_provider_->GetFormat();
+  if (!tile_manager_settings_.use_reduced_memory_prepaint_tiles ||
+      !raster_buffer_provider_->SupportsReducedMemoryTileFormats()) {
+    return format;
+  }
+  if (format != viz::SinglePlaneFormat::kRGBA_8888 &&
+      format != viz::SinglePlaneFormat::kBGRA_8888) {
+    return format;
+  }
+
+  // Only offscreen prepaint is reduced, so that content the user is looking at
+  // keeps full precision.
+  const Tile* tile = prioritized_tile.tile();
+  if (!tile->is_prepaint() ||
+      prioritized_tile.priority().priority_bin == TilePriority::NOW) {
+    return format;
+  }
+  // Animated images get re-rastered as they animate, and the banding from
+  // dithering is most visible on them.
+  const scoped_refptr<DisplayItemList>& display_list =
+      prioritized_tile.raster_source()->GetDisplayItemList();
+  if (display_list) {
+    const auto& animated_images =
+        display_list->discardable_image_map().animated_images_metadata();
+    if (!animated_images.empty())
+      return format;
+  }
+
+  return tile->is_opaque() ? viz::SinglePlaneFormat::kRGB_565
+                           : viz::SinglePlaneFormat::kRGBA_4444;
 }
 
 std::unique_ptr<base::trace_event::ConvertableToTraceFormat>
@@ -427,7 +427,8 @@ class CC_EXPORT TileManager : CheckerImageTrackerClient,
   void MarkTilesOutOfMemory(
       std::unique_ptr<RasterTilePriorityQueue> queue) const;
 
-  viz::SharedImageFormat DetermineFormat(const Tile* tile) const;
+  viz::SharedImageFormat DetermineFormat(
+      const PrioritizedTile& prioritized_tile) const;
 
   void DidFinishRunningTileTasksRequiredForActivation();
   void DidFinishRunningTileTasksRequiredForDraw();
@@ -450,6 +451,12 @@ class CC_EXPORT TileManager : CheckerImageTrackerClient,
       const TargetColorParams& target_color_params,
       CheckerImageTracker::DecodeType decode_type,
       CheckerImageTracker::ImageDecodeQueue* image_decode_queue);
+  // Adds kPredictedRaster decodes for the checker-imaged content of the
+  // remaining pre-paint tiles in |raster_priority_queue|, within the
+  // predictive decode budget.
+  void AddPredictedCheckeredImagesToDecodeQueue(
+      RasterTilePriorityQueue* raster_priority_queue,
+      CheckerImageTracker::ImageDecodeQueue* image_decode_queue);
 
   std::unique_ptr<base::trace_event::ConvertableToTraceFormat>
   ScheduledTasksStateAsValue() const;
@@ -6,9 +6,11 @@
 #include <stdint.h>
 
 #include "base/lazy_instance.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/location.h"
 #include "base/time/time.h"
 #include "base/timer/lap_timer.h"
+#include "cc/base/features.h"
 #include "cc/raster/raster_buffer.h"
 #include "cc/test/fake_impl_task_runner_provider.h"
 #include "cc/test/fake_layer_tree_frame_sink.h"
@@ -306,6 +308,18 @@ TEST_F(TileManagerPerfTest, RasterTileQueueConstruct) {
   RunRasterQueueConstructTest("50", 50);
 }
 
+TEST_F(TileManagerPerfTest, RasterTileQueueConstructManyLayers) {
+  RunRasterQueueConstructTest("serial_200", 200);
+  RunRasterQueueConstructTest("serial_500", 500);
+}
+
+TEST_F(TileManagerPerfTest, ParallelRasterTileQueueConstructManyLayers) {
+  base::test::ScopedFeatureList feature_list(
+      features::kParallelRasterTileQueueConstruction);
+  RunRasterQueueConstructTest("parallel_200", 200);
+  RunRasterQueueConstructTest("parallel_500", 500);
+}
+
 TEST_F(TileManagerPerfTest, RasterTileQueueConstructAndIterate) {
   RunRasterQueueConstructAndIterateTest("2_16", 2, 16);
   RunRasterQueueConstructAndIterateTest("2_32", 2, 32);
@@ -14,6 +14,12 @@ struct CC_EXPORT TileManagerSettings {
   bool enable_checker_imaging = false;
   size_t min_image_bytes_to_checker = 1 * 1024 * 1024;
   bool needs_notify_ready_to_draw = true;
+  // Rasters offscreen prepaint tiles without animated content into dithered
+  // 16-bit resources (kRGB_565 when opaque, kRGBA_4444 otherwise), halving
+  // their memory so that more prepaint fits in the same budget. Only used
+  // when the raster buffer provider supports those formats. Tiles keep their
+  // format until they are rastered again.
+  bool use_reduced_memory_prepaint_tiles = false;
 };
 
 }  // namespace cc
@@ -1294,6 +1294,50 @@ TEST_F(TileManagerTilePriorityQueueTest, RasterTilePriorityQueueEmptyLayers) {
   EXPECT_EQ(16u, tile_count);
 }
 
+TEST_F(TileManagerTilePriorityQueueTest,
+       ParallelRasterTilePriorityQueueMatchesSerialOrder) {
+  const gfx::Size layer_bounds(1000, 1000);
+  host_impl()->active_tree()->SetDeviceViewportRect(gfx::Rect(layer_bounds));
+  SetupDefaultTrees(layer_bounds);
+
+  scoped_refptr<FakeRasterSource> raster_source =
+      FakeRasterSource::CreateFilled(layer_bounds);
+  std::vector<FakePictureLayerImpl*> layers = {pending_layer()};
+  for (int i = 0; i < 63; ++i) {
+    auto* pending_child_layer = AddLayer<FakePictureLayerImpl>(
+        host_impl()->pending_tree(), raster_source);
+    pending_child_layer->SetBounds(layer_bounds);
+    pending_child_layer->SetDrawsContent(true);
+    CopyProperties(pending_layer(), pending_child_layer);
+    layers.push_back(pending_child_layer);
+  }
+  host_impl()->pending_tree()->set_needs_update_draw_properties();
+  UpdateDrawProperties(host_impl()->pending_tree());
+  for (FakePictureLayerImpl* layer : layers)
+    layer->CreateAllTiles();
+
+  auto collect_tiles = [this](TreePriority tree_priority) {
+    std::vector<Tile*> tiles;
+    std::unique_ptr<RasterTilePriorityQueue> queue(
+        host_impl()->BuildRasterQueue(tree_priority,
+                                      RasterTilePriorityQueue::Type::ALL));
+    for (; !queue->IsEmpty(); queue->Pop())
+      tiles.push_back(queue->Top().tile());
+    return tiles;
+  };
+
+  for (TreePriority tree_priority :
+       {SAME_PRIORITY_FOR_BOTH_TREES, SMOOTHNESS_TAKES_PRIORITY,
+        NEW_CONTENT_TAKES_PRIORITY}) {
+    std::vector<Tile*> serial_tiles = collect_tiles(tree_priority);
+    EXPECT_FALSE(serial_tiles.empty());
+
+    base::test::ScopedFeatureList feature_list(
+        features::kParallelRasterTileQueueConstruction);
+    EXPECT_EQ(serial_tiles, collect_tiles(tree_priority));
+  }
+}
+
 TEST_F(TileManagerTilePriorityQueueTest, EvictionTilePriorityQueueEmptyLayers) {
   const gfx::Size layer_bounds(1000, 1000);
   host_impl()->active_tree()->SetDeviceViewportRect(gfx::Rect(layer_bounds));
@@ -2490,6 +2534,81 @@ TEST_F(TileManagerTest, PartialRasterSuccessfullyDisabled) {
   RunPartialRasterCheck(TakeHostImpl(), false /* partial_raster_enabled */);
 }
 
+// FakeRasterBufferProviderImpl that supports reduced memory tile formats and
+// records the format of the resources it rasters into.
+class RecordFormatRasterBufferProvider : public FakeRasterBufferProviderImpl {
+ public:
+  // RasterBufferProvider methods.
+  std::unique_ptr<RasterBuffer> AcquireBufferForRaster(
+      const ResourcePool::InUsePoolResource& resource,
+      uint64_t resource_content_id,
+      uint64_t previous_content_id,
+      bool depends_on_at_raster_decodes,
+      bool depends_on_hardware_accelerated_jpeg_candidates,
+      bool depends_on_hardware_accelerated_webp_candidates) override {
+    formats_.push_back(resource.format());
+    return nullptr;
+  }
+  bool SupportsReducedMemoryTileFormats() const override { return true; }
+
+  const std::vector<viz::SharedImageFormat>& formats() const {
+    return formats_;
+  }
+
+ private:
+  std::vector<viz::SharedImageFormat> formats_;
+};
+
+class ReducedMemoryPrepaintTileManagerTest : public TileManagerTest {
+ public:
+  LayerTreeSettings CreateSettings() override {
+    auto settings = TileManagerTest::CreateSettings();
+    settings.use_reduced_memory_prepaint_tiles = true;
+    return settings;
+  }
+};
+
+TEST_F(ReducedMemoryPrepaintTileManagerTest, OffscreenPrepaintTilesAreReduced) {
+  host_impl()->tile_manager()->SetTileTaskManagerForTesting(
+      std::make_unique<FakeTileTaskManagerImpl>());
+  RecordFormatRasterBufferProvider raster_buffer_provider;
+  host_impl()->tile_manager()->SetRasterBufferProviderForTesting(
+      &raster_buffer_provider);
+
+  constexpr gfx::Size kLayerBounds(1000, 500);
+  auto recording_source = FakeRecordingSource::Create(kLayerBounds);
+  recording_source->set_fill_with_nonsolid_color(true);
+  recording_source->Rerecord();
+
+  constexpr gfx::Size kTileSize(500, 500);
+  Region invalidation((gfx::Rect(kLayerBounds)));
+  SetupPendingTree(recording_source->CreateRasterSource(), kTileSize,
+                   invalidation);
+
+  // Only the left tile is visible, the right one is prepaint.
+  PictureLayerTiling* pending_tiling =
+      pending_layer()->picture_layer_tiling_set()->tiling_at(0);
+  pending_tiling->set_resolution(HIGH_RESOLUTION);
+  pending_tiling->CreateAllTilesForTesting();
+  pending_tiling->SetTilePriorityRectsForTesting(
+      gfx::Rect(kTileSize),      // Visible rect.
+      gfx::Rect(kTileSize),      // Skewport rect.
+      gfx::Rect(kTileSize),      // Soon rect.
+      gfx::Rect(kLayerBounds));  // Eventually rect.
+
+  host_impl()->tile_manager()->PrepareTiles(host_impl()->global_tile_state());
+
+  ASSERT_EQ(2u, raster_buffer_provider.formats().size());
+  EXPECT_EQ(viz::SinglePlaneFormat::kRGBA_8888,
+            raster_buffer_provider.formats()[0]);
+  EXPECT_EQ(viz::SinglePlaneFormat::kRGBA_4444,
+            raster_buffer_provider.formats()[1]);
+
+  // Free our host_impl before the raster buffer provider we passed it, as it
+  // will use that class in clean up.
+  TakeHostImpl();
+}
+
 class InvalidResourceRasterBufferProvider
     : public FakeRasterBufferProviderImpl {
  public:
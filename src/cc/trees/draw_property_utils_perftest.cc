@@ -47,12 +47,20 @@ class DrawPropertyUtilsPerfTest : public LayerTreeTest {
     ASSERT_TRUE(base::ReadFileToString(json_file, &json_));
   }
 
+  // Instead of reading a file, builds a tree of |num_layers| layers arranged
+  // in chains of |chain_depth| nested, transformed layers.
+  void UseSyntheticTree(int num_layers, int chain_depth) {
+    synthetic_num_layers_ = num_layers;
+    synthetic_chain_depth_ = chain_depth;
+  }
+
   void SetupTree() override {
     gfx::Size viewport = gfx::Size(720, 1038);
     layer_tree_host()->SetViewportRectAndScale(gfx::Rect(viewport), 1.f,
                                                viz::LocalSurfaceId());
     scoped_refptr<Layer> root =
-        ParseTreeFromJson(json_, &content_layer_client_);
+        synthetic_num_layers_ ? BuildSyntheticTree(viewport)
+                              : ParseTreeFromJson(json_, &content_layer_client_);
     ASSERT_TRUE(root.get());
     layer_tree_host()->SetRootLayer(root);
     content_layer_client_.set_bounds(viewport);
@@ -74,6 +82,31 @@ class DrawPropertyUtilsPerfTest : public LayerTreeTest {
   base::LapTimer timer_;
   std::string json_;
   std::unique_ptr<perf_test::PerfResultReporter> reporter_;
+
+ private:
+  scoped_refptr<Layer> BuildSyntheticTree(const gfx::Size& viewport) {
+    scoped_refptr<Layer> root = Layer::Create();
+    root->SetBounds(viewport);
+    Layer* parent = root.get();
+    for (int i = 0; i < synthetic_num_layers_; ++i) {
+      if (i % synthetic_chain_depth_ == 0)
+        parent = root.get();
+      scoped_refptr<Layer> layer = Layer::Create();
+      layer->SetBounds(gfx::Size(100, 100));
+      layer->SetIsDrawable(true);
+      gfx::Transform transform;
+      transform.Translate(i % 7, i % 11);
+      if (i % 3 == 0)
+        transform.Scale(0.99f, 0.99f);
+      layer->SetTransform(transform);
+      parent->AddChild(layer);
+      parent = layer.get();
+    }
+    return root;
+  }
+
+  int synthetic_num_layers_ = 0;
+  int synthetic_chain_depth_ = 1;
 };
 
 class CalcDrawPropsTest : public DrawPropertyUtilsPerfTest {
@@ -114,6 +147,12 @@ TEST_F(CalcDrawPropsTest, TouchRegionLight) {
   RunCalcDrawProps();
 }
 
+TEST_F(CalcDrawPropsTest, TenThousandLayers) {
+  SetUpReporter("10000_layers");
+  UseSyntheticTree(/*num_layers=*/10000, /*chain_depth=*/10);
+  RunCalcDrawProps();
+}
+
 TEST_F(CalcDrawPropsTest, TouchRegionHeavy) {
   SetUpReporter("touch_region_heavy");
   ReadTestFile("touch_region_heavy");
@@ -44,6 +44,7 @@
 #include "cc/layers/layer.h"
 #include "cc/layers/painted_scrollbar_layer.h"
 #include "cc/metrics/ukm_smoothness_data.h"
+#include "cc/paint/paint_op_buffer_storage_pool.h"
 #include "cc/paint/paint_worklet_layer_painter.h"
 #include "cc/resources/ui_resource_manager.h"
 #include "cc/tiles/raster_dark_mode_filter.h"
@@ -160,6 +161,11 @@ LayerTreeHost::LayerTreeHost(InitParams params, CompositorMode mode)
 
   rendering_stats_instrumentation_->set_record_rendering_stats(
       pending_commit_state_->debug_state.RecordRenderingStats());
+
+  if (base::FeatureList::IsEnabled(features::kPaintOpBufferStoragePool)) {
+    paint_op_buffer_storage_pool_ =
+        std::make_unique<PaintOpBufferStoragePool>();
+  }
 }
 
 bool LayerTreeHost::IsMobileOptimized() const {
@@ -373,7 +379,12 @@ const LayerTreeDebugState& LayerTreeHost::GetDebugState() const {
 
 void LayerTreeHost::RequestMainFrameUpdate(bool report_metrics) {
   DCHECK(IsMainThread());
-  client_->UpdateLayerTreeHost();
+  {
+    std::optional<PaintOpBufferStoragePool::ScopedUse> use_storage_pool;
+    if (paint_op_buffer_storage_pool_)
+      use_storage_pool.emplace(paint_op_buffer_storage_pool_.get());
+    client_->UpdateLayerTreeHost();
+  }
   if (report_metrics)
     pending_commit_state()->begin_main_frame_metrics =
         client_->GetBeginMainFrameMetrics();
@@ -489,6 +500,8 @@ void LayerTreeHost::CommitComplete(int source_frame_number,
     WaitForCommitCompletion(/* for_protected_sequence */ false);
   client_->DidCommit(source_frame_number, commit_timestamps.start,
                      commit_timestamps.finish);
+  if (paint_op_buffer_storage_pool_)
+    paint_op_buffer_storage_pool_->Clear();
   if (did_complete_scale_animation_) {
     client_->DidCompletePageScaleAnimation(source_frame_number);
     did_complete_scale_animation_ = false;
@@ -828,7 +841,13 @@ bool LayerTreeHost::UpdateLayers() {
   base::ElapsedTimer timer;
 
   client_->WillUpdateLayers();
-  bool result = DoUpdateLayers();
+  bool result;
+  {
+    std::optional<PaintOpBufferStoragePool::ScopedUse> use_storage_pool;
+    if (paint_op_buffer_storage_pool_)
+      use_storage_pool.emplace(paint_op_buffer_storage_pool_.get());
+    result = DoUpdateLayers();
+  }
   client_->DidUpdateLayers();
   micro_benchmark_controller_.DidUpdateLayers();
 
@@ -77,6 +77,7 @@ class LayerTreeHostSingleThreadClient;
 class LayerTreeMutator;
 class MutatorEvents;
 class MutatorHost;
+class PaintOpBufferStoragePool;
 class PaintWorkletLayerPainter;
 class RasterDarkModeFilter;
 class RenderFrameMetadataObserver;
@@ -999,6 +1000,11 @@ class CC_EXPORT LayerTreeHost : public MutatorHostClient {
 
   std::unique_ptr<UIResourceManager> ui_resource_manager_;
 
+  // Recycles PaintOpBuffer storage across the recordings made while updating
+  // a main frame. Emptied once the frame is committed. Null unless
+  // features::kPaintOpBufferStoragePool is enabled.
+  std::unique_ptr<PaintOpBufferStoragePool> paint_op_buffer_storage_pool_;
+
   raw_ptr<LayerTreeHostClient> client_;
   raw_ptr<LayerTreeHostSchedulingClient> scheduling_client_;
   std::unique_ptr<Proxy> proxy_;
@@ -56,6 +56,7 @@
 #include "cc/layers/effect_tree_layer_list_iterator.h"
 #include "cc/layers/heads_up_display_layer_impl.h"
 #include "cc/layers/layer_impl.h"
+#include "cc/layers/picture_layer_impl.h"
 #include "cc/layers/render_surface_impl.h"
 #include "cc/layers/surface_layer_impl.h"
 #include "cc/layers/viewport.h"
@@ -1050,9 +1051,28 @@ bool LayerTreeHostImpl::PrepareTiles() {
     return false;
 
   client_->WillPrepareTiles();
+  micro_benchmark_controller_.WillPrepareTiles();
   bool did_prepare_tiles = tile_manager_.PrepareTiles(global_tile_state_);
+  if (did_prepare_tiles &&
+      rendering_stats_instrumentation_->record_rendering_stats()) {
+    // Occluded tiles never make it into the raster queue, so count them here.
+    size_t occluded_tiles = 0u;
+    for (PictureLayerImpl* layer : active_tree_->picture_layers()) {
+      occluded_tiles +=
+          layer->picture_layer_tiling_set()->CountOccludedTilesNeedingRaster();
+    }
+    if (pending_tree_) {
+      for (PictureLayerImpl* layer : pending_tree_->picture_layers()) {
+        occluded_tiles += layer->picture_layer_tiling_set()
+                              ->CountOccludedTilesNeedingRaster();
+      }
+    }
+    rendering_stats_instrumentation_->AddTilesSkippedDueToOcclusion(
+        base::checked_cast<int64_t>(occluded_tiles));
+  }
   if (did_prepare_tiles)
     tile_priorities_dirty_ = false;
+  micro_benchmark_controller_.DidPrepareTiles();
   client_->DidPrepareTiles();
   return did_prepare_tiles;
 }
@@ -2003,6 +2023,7 @@ void LayerTreeHostImpl::NotifyReadyToActivate() {
   // than wait for the TileManager to actually raster the content!
   if (!pending_tree_fully_painted_)
     return;
+  micro_benchmark_controller_.DidNotifyReadyToActivate();
   client_->NotifyReadyToActivate();
 }
 
@@ -3385,6 +3406,7 @@ void LayerTreeHostImpl::PushScrollbarOpacitiesFromActiveToPending() {
 
 void LayerTreeHostImpl::ActivateSyncTree() {
   TRACE_EVENT0("cc,benchmark", "LayerTreeHostImpl::ActivateSyncTree()");
+  micro_benchmark_controller_.WillActivateSyncTree();
   if (pending_tree_) {
     TRACE_EVENT_NESTABLE_ASYNC_END1(
         "cc", "PendingTree:waiting", TRACE_ID_LOCAL(pending_tree_.get()),
@@ -3498,6 +3520,7 @@ void LayerTreeHostImpl::ActivateSyncTree() {
 
   client_->OnCanDrawStateChanged(CanDraw());
   client_->DidActivateSyncTree();
+  micro_benchmark_controller_.DidActivateSyncTree();
   if (!tree_activation_callback_.is_null())
     tree_activation_callback_.Run();
 
@@ -4173,6 +4196,13 @@ void LayerTreeHostImpl::DidScrollContent(ElementId element_id, bool animated) {
   }
 }
 
+void LayerTreeHostImpl::SetPredictedFlingEnd(
+    ElementId element_id,
+    const gfx::PointF& scroll_offset) {
+  predicted_fling_end_element_id_ = element_id;
+  predicted_fling_end_scroll_offset_ = scroll_offset;
+}
+
 float LayerTreeHostImpl::DeviceScaleFactor() const {
   return active_tree_->device_scale_factor();
 }
@@ -71,6 +71,7 @@
 #include "components/viz/common/surfaces/region_capture_bounds.h"
 #include "components/viz/common/surfaces/surface_id.h"
 #include "components/viz/common/surfaces/surface_range.h"
+#include "ui/gfx/geometry/point_f.h"
 #include "ui/gfx/geometry/rect.h"
 
 namespace gfx {
@@ -377,6 +378,8 @@ class CC_EXPORT LayerTreeHostImpl : public TileManagerClient,
   bool IsInHighLatencyMode() const override;
   void WillScrollContent(ElementId element_id) override;
   void DidScrollContent(ElementId element_id, bool animated) override;
+  void SetPredictedFlingEnd(ElementId element_id,
+                            const gfx::PointF& scroll_offset) override;
   float DeviceScaleFactor() const override;
   float PageScaleFactor() const override;
   gfx::Size VisualDeviceViewportSize() const override;
@@ -686,6 +689,14 @@ class CC_EXPORT LayerTreeHostImpl : public TileManagerClient,
   ActivelyScrollingType GetActivelyScrollingType() const;
   bool IsCurrentScrollMainRepainted() const;
   bool ScrollAffectsScrollHandler() const;
+  // The scroller of the fling in progress, or null if there is none, and the
+  // scroll offset at which the fling is predicted to end.
+  ElementId predicted_fling_end_element_id() const {
+    return predicted_fling_end_element_id_;
+  }
+  const gfx::PointF& predicted_fling_end_scroll_offset() const {
+    return predicted_fling_end_scroll_offset_;
+  }
   bool CurrentScrollCheckerboardsDueToNoRecording() const {
     return current_scroll_did_checkerboard_large_area_;
   }
@@ -1061,6 +1072,11 @@ class CC_EXPORT LayerTreeHostImpl : public TileManagerClient,
   // need not be bound so this should be null-checked before dereferencing.
   std::unique_ptr<InputDelegateForCompositor> input_delegate_;
 
+  // Set by the InputHandler while a fling is in progress. Used to prioritize
+  // the tiles between the current scroll offset and the end of the fling.
+  ElementId predicted_fling_end_element_id_;
+  gfx::PointF predicted_fling_end_scroll_offset_;
+
   const LayerTreeSettings settings_;
 
   // This is set to true only if:
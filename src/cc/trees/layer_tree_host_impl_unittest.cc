@@ -34,6 +34,7 @@
 #include "cc/input/page_scale_animation.h"
 #include "cc/input/scroll_utils.h"
 #include "cc/input/scrollbar_controller.h"
+#include "cc/input/snap_fling_curve.h"
 #include "cc/layers/append_quads_data.h"
 #include "cc/layers/layer_impl.h"
 #include "cc/layers/nine_patch_thumb_scrollbar_layer_impl.h"
@@ -19159,6 +19160,11 @@ TEST_F(LayerTreeHostImplTest, FlingSnapStrategyCurrentOffset) {
   // Expect to snap to snap_area_2.
   EXPECT_EQ(handler.snap_strategy_for_testing()->intended_position(),
             target_offset);
+  // The fling is predicted to end at the snap position.
+  EXPECT_EQ(snapping_layer->element_id(),
+            host_impl_->predicted_fling_end_element_id());
+  EXPECT_POINTF_EQ(gfx::PointF(0, 1200),
+                   host_impl_->predicted_fling_end_scroll_offset());
 
   // Do an inertial phase scroll update.
   auto scroll_update_state =
@@ -19174,6 +19180,73 @@ TEST_F(LayerTreeHostImplTest, FlingSnapStrategyCurrentOffset) {
             target_offset);
 }
 
+TEST_F(LayerTreeHostImplTest, PredictedFlingEnd) {
+  gfx::Size viewport_size(100, 100);
+  gfx::Size content_size(100, 5000);
+
+  SetupViewportLayersInnerScrolls(viewport_size, viewport_size);
+  LayerImpl* scrolling_layer = AddScrollableLayer(
+      OuterViewportScrollLayer(), viewport_size, content_size);
+  DrawFrame();
+
+  auto& handler = GetInputHandler();
+  gfx::Point position(50, 50);
+  ui::ScrollInputType type = ui::ScrollInputType::kTouchscreen;
+
+  handler.ScrollBegin(BeginState(position, gfx::Vector2dF(0, 10), type).get(),
+                      type);
+  handler.ScrollUpdate(
+      UpdateState(position, gfx::Vector2dF(0, 10), type).get());
+  EXPECT_FALSE(host_impl_->predicted_fling_end_element_id());
+
+  // The end of the fling is predicted from its first inertial update.
+  gfx::Vector2dF fling_delta(0, 20);
+  auto scroll_update_state = UpdateState(position, fling_delta, type);
+  scroll_update_state->set_is_in_inertial_phase(true);
+  handler.ScrollUpdate(scroll_update_state.get());
+  EXPECT_EQ(scrolling_layer->element_id(),
+            host_impl_->predicted_fling_end_element_id());
+  gfx::PointF fling_end = host_impl_->predicted_fling_end_scroll_offset();
+  EXPECT_POINTF_EQ(
+      gfx::PointF(0, 10) + SnapFlingCurve::EstimateDisplacement(fling_delta),
+      fling_end);
+
+  // Only the contents of the flinging scroller are predicted to move.
+  EXPECT_VECTOR2DF_EQ(fling_end - CurrentScrollOffset(scrolling_layer),
+                      host_impl_->active_tree()->PredictedFlingDisplacement(
+                          scrolling_layer->transform_tree_index()));
+  EXPECT_VECTOR2DF_EQ(gfx::Vector2dF(),
+                      host_impl_->active_tree()->PredictedFlingDisplacement(
+                          root_layer()->transform_tree_index()));
+
+  handler.ScrollEnd();
+  EXPECT_FALSE(host_impl_->predicted_fling_end_element_id());
+  EXPECT_VECTOR2DF_EQ(gfx::Vector2dF(),
+                      host_impl_->active_tree()->PredictedFlingDisplacement(
+                          scrolling_layer->transform_tree_index()));
+}
+
+TEST_F(LayerTreeHostImplTest, RecordScrollBeginThreadState) {
+  SetupViewportLayersInnerScrolls(gfx::Size(100, 100), gfx::Size(100, 1000));
+  DrawFrame();
+  base::HistogramTester histogram_tester;
+
+  auto& handler = GetInputHandler();
+  handler.RecordScrollBegin(ui::ScrollInputType::kWheel,
+                            ScrollBeginThreadState::kScrollingOnMain);
+  handler.RecordScrollEnd(ui::ScrollInputType::kWheel);
+  handler.RecordScrollBegin(ui::ScrollInputType::kTouchscreen,
+                            ScrollBeginThreadState::kScrollingOnCompositor);
+  handler.RecordScrollEnd(ui::ScrollInputType::kTouchscreen);
+
+  histogram_tester.ExpectUniqueSample("Renderer4.ScrollBeginThreadState.Wheel",
+                                      ScrollBeginThreadState::kScrollingOnMain,
+                                      1);
+  histogram_tester.ExpectUniqueSample(
+      "Renderer4.ScrollBeginThreadState.Touchscreen",
+      ScrollBeginThreadState::kScrollingOnCompositor, 1);
+}
+
 namespace {
 
 class FakeLayerImpl : public LayerImpl {
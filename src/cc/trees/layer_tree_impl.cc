@@ -61,6 +61,7 @@
 #include "ui/gfx/geometry/point_conversions.h"
 #include "ui/gfx/geometry/rect_conversions.h"
 #include "ui/gfx/geometry/size_conversions.h"
+#include "ui/gfx/geometry/transform.h"
 #include "ui/gfx/geometry/vector2d_conversions.h"
 
 namespace cc {
@@ -2855,6 +2856,41 @@ bool LayerTreeImpl::SmoothnessTakesPriority() const {
   return host_impl_->GetTreePriority() == SMOOTHNESS_TAKES_PRIORITY;
 }
 
+gfx::Vector2dF LayerTreeImpl::PredictedFlingDisplacement(
+    int transform_id) const {
+  ElementId element_id = host_impl_->predicted_fling_end_element_id();
+  if (!element_id) {
+    return gfx::Vector2dF();
+  }
+  const ScrollTree& scroll_tree = property_trees()->scroll_tree();
+  const ScrollNode* scroll_node = scroll_tree.FindNodeFromElementId(element_id);
+  if (!scroll_node) {
+    return gfx::Vector2dF();
+  }
+
+  // Only the scroller's contents move with the fling.
+  const TransformTree& transform_tree = property_trees()->transform_tree();
+  const TransformNode* node = transform_tree.Node(transform_id);
+  while (node && node->id != scroll_node->transform_id) {
+    node = transform_tree.parent(node);
+  }
+  if (!node) {
+    return gfx::Vector2dF();
+  }
+
+  gfx::Vector2dF displacement =
+      host_impl_->predicted_fling_end_scroll_offset() -
+      scroll_tree.current_scroll_offset(element_id);
+  if (displacement.IsZero()) {
+    return gfx::Vector2dF();
+  }
+  gfx::Transform scroller_to_layer = transform_tree.FromScreen(transform_id);
+  scroller_to_layer.PreConcat(
+      transform_tree.ToScreen(scroll_node->transform_id));
+  return scroller_to_layer.MapPoint(gfx::PointF() + displacement) -
+         scroller_to_layer.MapPoint(gfx::PointF());
+}
+
 VideoFrameControllerClient* LayerTreeImpl::GetVideoFrameControllerClient()
     const {
   return host_impl_;
@@ -157,6 +157,11 @@ class CC_EXPORT LayerTreeImpl {
   bool create_low_res_tiling() const;
   bool RequiresHighResToDraw() const;
   bool SmoothnessTakesPriority() const;
+  // Returns how far the visible rect of a layer with the transform node
+  // `transform_id` is predicted to move, in the layer's space, before the fling
+  // in progress ends. Zero if there is no fling or the layer does not scroll
+  // with the flinging scroller.
+  gfx::Vector2dF PredictedFlingDisplacement(int transform_id) const;
   VideoFrameControllerClient* GetVideoFrameControllerClient() const;
   MutatorHost* mutator_host() const { return host_impl_->mutator_host(); }
   void UpdateImageDecodingHints(
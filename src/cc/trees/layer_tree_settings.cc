@@ -50,6 +50,8 @@ TileManagerSettings LayerTreeSettings::ToTileManagerSettings() const {
   tile_manager_settings.min_image_bytes_to_checker = min_image_bytes_to_checker;
   tile_manager_settings.needs_notify_ready_to_draw =
       commit_to_active_tree | wait_for_all_pipeline_stages_before_draw;
+  tile_manager_settings.use_reduced_memory_prepaint_tiles =
+      use_reduced_memory_prepaint_tiles;
   return tile_manager_settings;
 }
 
@@ -91,6 +91,8 @@ class CC_EXPORT LayerTreeSettings {
   bool enable_elastic_overscroll = false;
   size_t scheduled_raster_task_limit = 32;
   bool use_occlusion_for_tile_prioritization = false;
+  // See TileManagerSettings::use_reduced_memory_prepaint_tiles.
+  bool use_reduced_memory_prepaint_tiles = false;
   bool use_layer_lists = false;
   int max_staging_buffer_usage_in_bytes = 32 * 1024 * 1024;
   ManagedMemoryPolicy memory_policy;
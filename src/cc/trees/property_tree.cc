@@ -77,7 +77,7 @@ TransformTree::TransformTree(PropertyTrees* property_trees)
       page_scale_factor_(1.f),
       device_scale_factor_(1.f),
       device_transform_scale_factor_(1.f) {
-  cached_data_.push_back(TransformCachedNodeData());
+  AppendCachedNodeData();
 }
 
 TransformTree::~TransformTree() = default;
@@ -134,9 +134,9 @@ template class PropertyTree<ScrollNode>;
 
 int TransformTree::Insert(const TransformNode& tree_node, int parent_id) {
   int node_id = PropertyTree<TransformNode>::Insert(tree_node, parent_id);
-  DCHECK_EQ(node_id, static_cast<int>(cached_data_.size()));
+  DCHECK_EQ(node_id, static_cast<int>(to_screen_.size()));
 
-  cached_data_.push_back(TransformCachedNodeData());
+  AppendCachedNodeData();
   return node_id;
 }
 
@@ -147,8 +147,10 @@ void TransformTree::clear() {
   device_scale_factor_ = 1.f;
   device_transform_scale_factor_ = 1.f;
   nodes_affected_by_outer_viewport_bounds_delta_.clear();
-  cached_data_.clear();
-  cached_data_.push_back(TransformCachedNodeData());
+  to_screen_.clear();
+  from_screen_.clear();
+  is_showing_backface_.clear();
+  AppendCachedNodeData();
   sticky_position_data_.clear();
   anchor_position_scroll_data_.clear();
 
@@ -708,10 +710,10 @@ void TransformTree::UpdateSnapping(TransformNode* node) {
   // rounded, then what we're after is the scroll delta X, where ST * X = ST'.
   // I.e., we want a transform that will realize our snap. It follows that
   // X = ST^-1 * ST'. We cache ST and ST^-1 to make this more efficient.
-  DCHECK_LT(node->id, static_cast<int>(cached_data_.size()));
-  gfx::Transform& to_screen = cached_data_[node->id].to_screen;
+  DCHECK_LT(node->id, static_cast<int>(to_screen_.size()));
+  gfx::Transform& to_screen = to_screen_[node->id];
   to_screen.Round2dTranslationComponents();
-  gfx::Transform& from_screen = cached_data_[node->id].from_screen;
+  gfx::Transform& from_screen = from_screen_[node->id];
   gfx::Transform delta = from_screen;
   delta *= to_screen;
 
@@ -826,25 +828,36 @@ bool TransformTree::HasNodesAffectedByOuterViewportBoundsDelta() const {
 }
 
 const gfx::Transform& TransformTree::FromScreen(int node_id) const {
-  DCHECK(static_cast<int>(cached_data_.size()) > node_id);
-  return cached_data_[node_id].from_screen;
+  DCHECK(static_cast<int>(from_screen_.size()) > node_id);
+  return from_screen_[node_id];
 }
 
 void TransformTree::SetFromScreen(int node_id,
                                   const gfx::Transform& transform) {
-  DCHECK(static_cast<int>(cached_data_.size()) > node_id);
-  cached_data_[node_id].from_screen = transform;
+  DCHECK(static_cast<int>(from_screen_.size()) > node_id);
+  from_screen_[node_id] = transform;
 }
 
 const gfx::Transform& TransformTree::ToScreen(int node_id) const {
-  DCHECK(static_cast<int>(cached_data_.size()) > node_id);
-  return cached_data_[node_id].to_screen;
+  DCHECK(static_cast<int>(to_screen_.size()) > node_id);
+  return to_screen_[node_id];
 }
 
 void TransformTree::SetToScreen(int node_id, const gfx::Transform& transform) {
-  DCHECK(static_cast<int>(cached_data_.size()) > node_id);
-  cached_data_[node_id].to_screen = transform;
-  cached_data_[node_id].is_showing_backface = transform.IsBackFaceVisible();
+  DCHECK(static_cast<int>(to_screen_.size()) > node_id);
+  to_screen_[node_id] = transform;
+  is_showing_backface_[node_id] = transform.IsBackFaceVisible();
+}
+
+bool TransformTree::IsShowingBackface(int node_id) const {
+  DCHECK(static_cast<int>(is_showing_backface_.size()) > node_id);
+  return is_showing_backface_[node_id];
+}
+
+void TransformTree::AppendCachedNodeData() {
+  to_screen_.emplace_back();
+  from_screen_.emplace_back();
+  is_showing_backface_.push_back(false);
 }
 
 #if DCHECK_IS_ON()
@@ -856,7 +869,8 @@ bool TransformTree::operator==(const TransformTree& other) const {
              other.device_transform_scale_factor() &&
          nodes_affected_by_outer_viewport_bounds_delta_ ==
              other.nodes_affected_by_outer_viewport_bounds_delta() &&
-         cached_data_ == other.cached_data();
+         to_screen_ == other.to_screen_ && from_screen_ == other.from_screen_ &&
+         is_showing_backface_ == other.is_showing_backface_;
 }
 #endif
 
@@ -979,10 +993,8 @@ void EffectTree::UpdateBackfaceVisibility(EffectNode* node,
     node->hidden_by_backface_visibility = false;
     return;
   }
-  node->hidden_by_backface_visibility = property_trees()
-                                            ->transform_tree()
-                                            .cached_data()[node->transform_id]
-                                            .is_showing_backface;
+  node->hidden_by_backface_visibility =
+      property_trees()->transform_tree().IsShowingBackface(node->transform_id);
 }
 
 void EffectTree::UpdateHasMaskingChild(EffectNode* node,
@@ -162,7 +162,7 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
   // These C++ special member functions cannot be implicit inline because
   // they are exported by CC_EXPORT. They will be instantiated in every
   // compilation units that included this header, and compilation can fail
-  // because TransformCachedNodeData may be incomplete.
+  // because StickyPositionNodeData may be incomplete.
   TransformTree(const TransformTree&) = delete;
   ~TransformTree();
   TransformTree& operator=(const TransformTree&);
@@ -252,9 +252,8 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
   int ContentTargetId(int node_id) const;
   void SetContentTargetId(int node_id, int content_target_id);
 
-  const std::vector<TransformCachedNodeData>& cached_data() const {
-    return cached_data_;
-  }
+  // Whether the back face of the node's to_screen transform is visible.
+  bool IsShowingBackface(int node_id) const;
 
   void UndoOverscroll(const TransformNode* node,
                       gfx::Vector2dF& position_adjustment,
@@ -287,6 +286,8 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
   // |anc_id|.
   bool IsDescendant(int desc_id, int anc_id) const;
 
+  void AppendCachedNodeData();
+
   StickyPositionNodeData* MutableStickyPositionData(int node_id);
   gfx::Vector2dF StickyPositionOffset(TransformNode* node);
   gfx::Vector2dF AnchorPositionOffset(TransformNode* node,
@@ -312,7 +313,14 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
   float device_scale_factor_;
   float device_transform_scale_factor_;
   std::vector<int> nodes_affected_by_outer_viewport_bounds_delta_;
-  std::vector<TransformCachedNodeData> cached_data_;
+  // Per-node cached screen space data, indexed by node id. This is kept as
+  // separate arrays rather than a vector of structs because draw property
+  // computation mostly reads |to_screen_| while walking the tree, and
+  // interleaving it with the rarely read |from_screen_| would double the cache
+  // lines touched per node.
+  std::vector<gfx::Transform> to_screen_;
+  std::vector<gfx::Transform> from_screen_;
+  std::vector<bool> is_showing_backface_;
   std::vector<StickyPositionNodeData> sticky_position_data_;
   std::vector<AnchorPositionScrollData> anchor_position_scroll_data_;
 };
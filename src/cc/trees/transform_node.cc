@@ -35,11 +35,4 @@ void TransformNode::AsValueInto(base::trace_event::TracedValue* value) const {
   MathUtil::AddToTracedValue("snap_amount", snap_amount, value);
 }
 
-TransformCachedNodeData::TransformCachedNodeData() = default;
-TransformCachedNodeData::TransformCachedNodeData(
-    const TransformCachedNodeData& other) = default;
-TransformCachedNodeData::~TransformCachedNodeData() = default;
-bool TransformCachedNodeData::operator==(
-    const TransformCachedNodeData& other) const = default;
-
 }  // namespace cc
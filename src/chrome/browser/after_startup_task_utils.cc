@@ -4,16 +4,22 @@
 
 #include "chrome/browser/after_startup_task_utils.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "base/containers/circular_deque.h"
+#include "base/feature_list.h"
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
 #include "base/process/process.h"
 #include "base/synchronization/atomic_flag.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
 #include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
 #include "build/chromeos_buildflags.h"
+#include "chrome/browser/browser_features.h"
 #include "chrome/browser/ui/browser_finder.h"
 #include "components/performance_manager/performance_manager_impl.h"
 #include "components/performance_manager/public/graph/graph.h"
@@ -43,8 +49,12 @@ struct AfterStartupTask {
   const base::Location from_here;
   const scoped_refptr<base::SequencedTaskRunner> task_runner;
   base::OnceClosure task;
+  const base::TimeTicks queued_time = base::TimeTicks::Now();
 };
 
+// Whether the queued tasks are being released. Only accessed on the UI thread.
+bool g_release_in_progress = false;
+
 // The flag may be read on any thread, but must only be set on the UI thread.
 base::AtomicFlag& GetStartupCompleteFlag() {
   static base::NoDestructor<base::AtomicFlag> startup_complete_flag;
@@ -65,6 +75,10 @@ bool IsBrowserStartupComplete() {
 void RunTask(std::unique_ptr<AfterStartupTask> queued_task) {
   // We're careful to delete the caller's |task| on the target runner's thread.
   DCHECK(queued_task->task_runner->RunsTasksInCurrentSequence());
+  TRACE_EVENT1("startup", "AfterStartupTask", "posted_from",
+               queued_task->from_here.ToString());
+  UMA_HISTOGRAM_LONG_TIMES("Startup.AfterStartupTask.QueuedTime",
+                           base::TimeTicks::Now() - queued_task->queued_time);
   std::move(queued_task->task).Run();
 }
 
@@ -101,11 +115,40 @@ void QueueTask(std::unique_ptr<AfterStartupTask> queued_task) {
   GetAfterStartupTasks().push_back(queued_task.release());
 }
 
+// Schedules up to `batch_size` queued tasks, oldest first. If tasks remain,
+// the next batch is released from a BEST_EFFORT task so that higher priority
+// work on the UI thread runs in between. Startup is only flagged as complete
+// once the queue is empty, so that tasks posted in the meantime are queued
+// behind the ones being released and keep their order.
+void ReleaseAfterStartupTasks(size_t batch_size,
+                              base::TimeTicks release_start_time) {
+  DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  base::circular_deque<AfterStartupTask*>& tasks = GetAfterStartupTasks();
+  for (size_t i = 0; i < batch_size && !tasks.empty(); ++i) {
+    ScheduleTask(base::WrapUnique(tasks.front()));
+    tasks.pop_front();
+  }
+
+  if (!tasks.empty()) {
+    content::GetUIThreadTaskRunner({base::TaskPriority::BEST_EFFORT})
+        ->PostTask(FROM_HERE, base::BindOnce(&ReleaseAfterStartupTasks,
+                                             batch_size, release_start_time));
+    return;
+  }
+
+  UMA_HISTOGRAM_MEDIUM_TIMES("Startup.AfterStartupTask.ReleaseDuration",
+                             base::TimeTicks::Now() - release_start_time);
+  GetStartupCompleteFlag().Set();
+  tasks.shrink_to_fit();
+  g_release_in_progress = false;
+}
+
 void SetBrowserStartupIsComplete() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
 
-  if (IsBrowserStartupComplete())
+  if (IsBrowserStartupComplete() || g_release_in_progress)
     return;
+  g_release_in_progress = true;
 
   size_t browser_count = 0;
 #if !BUILDFLAG(IS_ANDROID)
@@ -113,7 +156,6 @@ void SetBrowserStartupIsComplete() {
 #endif  // !BUILDFLAG(IS_ANDROID)
   TRACE_EVENT_INSTANT1("startup", "Startup.StartupComplete",
                        TRACE_EVENT_SCOPE_GLOBAL, "BrowserCount", browser_count);
-  GetStartupCompleteFlag().Set();
 #if BUILDFLAG(IS_MAC) || BUILDFLAG(IS_WIN) || BUILDFLAG(IS_LINUX) || \
     BUILDFLAG(IS_CHROMEOS)
   // Process::Current().CreationTime() is not available on all platforms.
@@ -127,11 +169,13 @@ void SetBrowserStartupIsComplete() {
         // BUILDFLAG(IS_CHROMEOS)
   UMA_HISTOGRAM_COUNTS_10000("Startup.AfterStartupTaskCount",
                              GetAfterStartupTasks().size());
-  for (AfterStartupTask* queued_task : GetAfterStartupTasks()) {
-    ScheduleTask(base::WrapUnique(queued_task));
+
+  size_t batch_size = std::numeric_limits<size_t>::max();
+  if (base::FeatureList::IsEnabled(features::kProgressiveAfterStartupTasks)) {
+    batch_size = std::max(
+        1, features::kProgressiveAfterStartupTasksBatchSize.Get());
   }
-  GetAfterStartupTasks().clear();
-  GetAfterStartupTasks().shrink_to_fit();
+  ReleaseAfterStartupTasks(batch_size, base::TimeTicks::Now());
 }
 
 // Observes the first visible page load and sets the startup complete
@@ -24,7 +24,9 @@ class AfterStartupTaskUtils {
   AfterStartupTaskUtils(const AfterStartupTaskUtils&) = delete;
   AfterStartupTaskUtils& operator=(const AfterStartupTaskUtils&) = delete;
 
-  // Observes startup and when complete runs tasks that have accrued.
+  // Observes startup and when complete runs tasks that have accrued. With
+  // features::kProgressiveAfterStartupTasks, the accrued tasks are released in
+  // batches and startup is only reported complete once all were released.
   static void StartMonitoringStartup();
 
   // Queues `task` to run on `destination_runner` after startup is complete.
@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/functional/bind.h"
 #include "base/functional/callback_helpers.h"
@@ -14,6 +15,8 @@
 #include "base/task/sequenced_task_runner.h"
 #include "base/task/thread_pool.h"
 #include "base/test/bind.h"
+#include "base/test/scoped_feature_list.h"
+#include "chrome/browser/browser_features.h"
 #include "content/public/browser/browser_task_traits.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/browser_task_environment.h"
@@ -208,3 +211,33 @@ TEST_F(AfterStartupTaskTest, PostTask) {
   EXPECT_EQ(2, background_sequence_->ran_task_count());
   EXPECT_EQ(2, ui_thread_->ran_task_count());
 }
+
+TEST_F(AfterStartupTaskTest, ProgressiveRelease) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeatureWithParameters(
+      features::kProgressiveAfterStartupTasks, {{"batch_size", "2"}});
+
+  std::vector<int> ran_tasks;
+  auto record_task = [&](int id) {
+    return base::BindLambdaForTesting([&ran_tasks, id]() {
+      ran_tasks.push_back(id);
+    });
+  };
+  for (int i = 0; i < 5; ++i) {
+    AfterStartupTaskUtils::PostTask(FROM_HERE, ui_thread_, record_task(i));
+  }
+
+  // Only the first batch is posted when startup completes, and startup is not
+  // reported complete until all the queued tasks were released.
+  AfterStartupTaskUtils::SetBrowserStartupIsCompleteForTesting();
+  EXPECT_EQ(2, ui_thread_->posted_task_count());
+  EXPECT_FALSE(AfterStartupTaskUtils::IsBrowserStartupComplete());
+
+  // Tasks posted while releasing are queued behind the released ones.
+  AfterStartupTaskUtils::PostTask(FROM_HERE, ui_thread_, record_task(5));
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(AfterStartupTaskUtils::IsBrowserStartupComplete());
+  EXPECT_EQ(6, ui_thread_->ran_task_count());
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4, 5}), ran_tasks);
+}
@@ -291,6 +291,24 @@ BASE_FEATURE(kPrerenderDSEHoldback,
              "PrerenderDSEHoldback",
              base::FEATURE_DISABLED_BY_DEFAULT);
 
+// Handles the command lines handed off by other browser processes through the
+// process singleton at user-blocking priority on the UI thread, ahead of the
+// startup work already queued there.
+BASE_FEATURE(kProcessSingletonPriorityHandoff,
+             "ProcessSingletonPriorityHandoff",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+// Releases the tasks deferred by AfterStartupTaskUtils in batches of
+// kProgressiveAfterStartupTasksBatchSize, yielding to higher priority work on
+// the UI thread between batches, instead of all at once when startup
+// completes.
+BASE_FEATURE(kProgressiveAfterStartupTasks,
+             "ProgressiveAfterStartupTasks",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+const base::FeatureParam<int> kProgressiveAfterStartupTasksBatchSize{
+    &kProgressiveAfterStartupTasks, "batch_size", 10};
+
 // Enables executing the browser commands sent by the NTP promos.
 BASE_FEATURE(kPromoBrowserCommands,
              "PromoBrowserCommands",
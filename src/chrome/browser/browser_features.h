@@ -122,6 +122,9 @@ BASE_DECLARE_FEATURE(kPlatformKeysAesEncryption);
 #endif  // BUILDFLAG(IS_CHROMEOS)
 
 BASE_DECLARE_FEATURE(kPrerenderDSEHoldback);
+BASE_DECLARE_FEATURE(kProcessSingletonPriorityHandoff);
+BASE_DECLARE_FEATURE(kProgressiveAfterStartupTasks);
+extern const base::FeatureParam<int> kProgressiveAfterStartupTasksBatchSize;
 BASE_DECLARE_FEATURE(kPromoBrowserCommands);
 extern const char kBrowserCommandIdParam[];
 
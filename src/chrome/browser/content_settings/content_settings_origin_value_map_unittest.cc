@@ -6,6 +6,7 @@
 
 #include <memory>
 
+#include "base/memory/scoped_refptr.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/time/time.h"
 #include "base/values.h"
@@ -113,6 +114,51 @@ TEST_P(OriginValueMapTest, GetRule) {
                                  ContentSettingsType::POPUPS));
 }
 
+TEST_P(OriginValueMapTest, GetSnapshot) {
+  content_settings::OriginValueMap map;
+  const GURL url("http://www.google.com");
+  EXPECT_EQ(nullptr, map.GetSnapshot(ContentSettingsType::COOKIES));
+
+  {
+    base::AutoLock lock(map.GetLock());
+    map.SetValue(ContentSettingsPattern::FromString("[*.]google.com"),
+                 ContentSettingsPattern::Wildcard(),
+                 ContentSettingsType::COOKIES, base::Value(1), {});
+  }
+  scoped_refptr<const content_settings::OriginValueMap::Snapshot> snapshot =
+      map.GetSnapshot(ContentSettingsType::COOKIES);
+  ASSERT_TRUE(snapshot);
+  EXPECT_EQ(snapshot, map.GetSnapshot(ContentSettingsType::COOKIES));
+  EXPECT_EQ(nullptr, map.GetSnapshot(ContentSettingsType::POPUPS));
+
+  auto rule = snapshot->GetRule(url, url);
+  ASSERT_TRUE(rule);
+  EXPECT_EQ(base::Value(1), rule->value);
+  EXPECT_EQ(nullptr, snapshot->GetRule(GURL("http://www.youtube.com"), url));
+
+  // A snapshot keeps the rules it was taken with, and the next one reflects
+  // the changes.
+  {
+    base::AutoLock lock(map.GetLock());
+    map.SetValue(ContentSettingsPattern::FromString("[*.]google.com"),
+                 ContentSettingsPattern::Wildcard(),
+                 ContentSettingsType::COOKIES, base::Value(2), {});
+  }
+  EXPECT_EQ(base::Value(1), snapshot->GetRule(url, url)->value);
+  scoped_refptr<const content_settings::OriginValueMap::Snapshot>
+      new_snapshot = map.GetSnapshot(ContentSettingsType::COOKIES);
+  ASSERT_TRUE(new_snapshot);
+  EXPECT_NE(snapshot, new_snapshot);
+  EXPECT_EQ(base::Value(2), new_snapshot->GetRule(url, url)->value);
+
+  {
+    base::AutoLock lock(map.GetLock());
+    map.clear();
+  }
+  EXPECT_EQ(nullptr, map.GetSnapshot(ContentSettingsType::COOKIES));
+  EXPECT_EQ(base::Value(2), new_snapshot->GetRule(url, url)->value);
+}
+
 TEST_P(OriginValueMapTest, GetRuleIterator) {
   content_settings::OriginValueMap map;
   auto pattern = ContentSettingsPattern::FromString;
@@ -5,10 +5,12 @@
 #include "chrome/browser/extensions/user_script_listener.h"
 
 #include <memory>
+#include <vector>
 
 #include "base/functional/bind.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/extensions/chrome_content_browser_client_extensions_part.h"
+#include "chrome/browser/extensions/user_script_url_matcher.h"
 #include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/profiles/profile_manager.h"
 #include "content/public/browser/navigation_handle.h"
@@ -71,6 +73,10 @@ struct UserScriptListener::ProfileData {
 
   // A list of URL patterns that have will have user scripts applied to them.
   URLPatterns url_patterns;
+
+  // Matches navigations against |url_patterns|. Built on first use and reset
+  // whenever |url_patterns| changes.
+  std::unique_ptr<UserScriptURLMatcher> url_matcher;
 };
 
 UserScriptListener::UserScriptListener() {
@@ -132,15 +138,16 @@ bool UserScriptListener::ShouldDelayRequest(const GURL& url) {
   if (user_scripts_ready_)
     return false;
 
-  for (ProfileDataMap::const_iterator pt = profile_data_.begin();
-       pt != profile_data_.end(); ++pt) {
-    for (auto it = pt->second.url_patterns.begin();
-         it != pt->second.url_patterns.end(); ++it) {
-      if ((*it).MatchesURL(url)) {
-        // One of the user scripts wants to inject into this request, but the
-        // script isn't ready yet. Delay the request.
-        return true;
-      }
+  for (auto& [context, data] : profile_data_) {
+    if (!data.url_matcher) {
+      data.url_matcher = std::make_unique<UserScriptURLMatcher>(
+          std::vector<URLPattern>(data.url_patterns.begin(),
+                                  data.url_patterns.end()));
+    }
+    if (data.url_matcher->MatchesURL(url)) {
+      // One of the user scripts wants to inject into this request, but the
+      // script isn't ready yet. Delay the request.
+      return true;
     }
   }
 
@@ -188,12 +195,15 @@ void UserScriptListener::AppendNewURLPatterns(content::BrowserContext* context,
 
   data.url_patterns.insert(data.url_patterns.end(),
                            new_patterns.begin(), new_patterns.end());
+  data.url_matcher.reset();
 }
 
 void UserScriptListener::ReplaceURLPatterns(content::BrowserContext* context,
                                             const URLPatterns& patterns) {
   DCHECK_EQ(1U, profile_data_.count(context));
-  profile_data_[context].url_patterns = patterns;
+  ProfileData& data = profile_data_[context];
+  data.url_patterns = patterns;
+  data.url_matcher.reset();
 }
 
 void UserScriptListener::CollectURLPatterns(content::BrowserContext* context,
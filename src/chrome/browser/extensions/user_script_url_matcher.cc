@@ -0,0 +1,107 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/extensions/user_script_url_matcher.h"
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+
+#include "base/ranges/algorithm.h"
+#include "url/gurl.h"
+
+namespace extensions {
+
+namespace {
+
+// URLPattern ignores a trailing dot in hosts.
+std::string_view StripTrailingDot(std::string_view host) {
+  if (!host.empty() && host.back() == '.') {
+    host.remove_suffix(1);
+  }
+  return host;
+}
+
+void AppendPatterns(
+    const std::map<std::string, std::vector<size_t>, std::less<>>& map,
+    std::string_view host,
+    std::vector<size_t>* candidates) {
+  auto it = map.find(host);
+  if (it != map.end()) {
+    candidates->insert(candidates->end(), it->second.begin(),
+                       it->second.end());
+  }
+}
+
+}  // namespace
+
+UserScriptURLMatcher::UserScriptURLMatcher(std::vector<URLPattern> patterns)
+    : patterns_(std::move(patterns)) {
+  for (size_t i = 0; i < patterns_.size(); ++i) {
+    const URLPattern& pattern = patterns_[i];
+    std::string host(StripTrailingDot(pattern.host()));
+    if (host.empty()) {
+      unindexed_patterns_.push_back(i);
+    } else if (pattern.match_subdomains()) {
+      domain_patterns_[std::move(host)].push_back(i);
+    } else {
+      host_patterns_[std::move(host)].push_back(i);
+    }
+  }
+}
+
+UserScriptURLMatcher::~UserScriptURLMatcher() = default;
+
+bool UserScriptURLMatcher::MatchesURL(const GURL& url) const {
+  return base::ranges::any_of(GetCandidatePatterns(url), [&](size_t index) {
+    return patterns_[index].MatchesURL(url);
+  });
+}
+
+std::vector<size_t> UserScriptURLMatcher::GetMatchingPatterns(
+    const GURL& url) const {
+  std::vector<size_t> matches = GetCandidatePatterns(url);
+  std::erase_if(matches, [&](size_t index) {
+    return !patterns_[index].MatchesURL(url);
+  });
+  return matches;
+}
+
+std::vector<size_t> UserScriptURLMatcher::GetCandidatePatterns(
+    const GURL& url) const {
+  std::vector<size_t> candidates;
+  if (!url.is_valid()) {
+    return candidates;
+  }
+
+  // Patterns are matched against the inner URL of filesystem: URLs, and IP
+  // addresses have more than one spelling. Check every pattern for those.
+  if (url.inner_url() || url.HostIsIPAddress()) {
+    candidates.resize(patterns_.size());
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      candidates[i] = i;
+    }
+    return candidates;
+  }
+
+  candidates = unindexed_patterns_;
+  std::string_view host = StripTrailingDot(url.host_piece());
+  if (!host.empty()) {
+    AppendPatterns(host_patterns_, host, &candidates);
+    // The host itself and every domain it is a subdomain of.
+    for (std::string_view domain = host;;) {
+      AppendPatterns(domain_patterns_, domain, &candidates);
+      size_t dot = domain.find('.');
+      if (dot == std::string_view::npos) {
+        break;
+      }
+      domain.remove_prefix(dot + 1);
+    }
+  }
+
+  base::ranges::sort(candidates);
+  return candidates;
+}
+
+}  // namespace extensions
@@ -0,0 +1,62 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CHROME_BROWSER_EXTENSIONS_USER_SCRIPT_URL_MATCHER_H_
+#define CHROME_BROWSER_EXTENSIONS_USER_SCRIPT_URL_MATCHER_H_
+
+#include <stddef.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "extensions/common/url_pattern.h"
+
+class GURL;
+
+namespace extensions {
+
+// Matches URLs against the URL patterns of the user scripts of all extensions
+// at once. The patterns are indexed by host when the matcher is built, so that
+// matching a URL only evaluates the patterns for its host, the domains it is a
+// subdomain of, and the patterns that match any host. Build a new matcher when
+// the set of patterns changes.
+class UserScriptURLMatcher {
+ public:
+  explicit UserScriptURLMatcher(std::vector<URLPattern> patterns);
+
+  UserScriptURLMatcher(const UserScriptURLMatcher&) = delete;
+  UserScriptURLMatcher& operator=(const UserScriptURLMatcher&) = delete;
+
+  ~UserScriptURLMatcher();
+
+  // Returns true if any of the patterns matches `url`.
+  bool MatchesURL(const GURL& url) const;
+
+  // Returns the indices of the patterns that match `url`, in increasing order.
+  std::vector<size_t> GetMatchingPatterns(const GURL& url) const;
+
+  size_t size() const { return patterns_.size(); }
+
+ private:
+  // Returns the sorted indices of the patterns that may match `url`, which
+  // must then be checked with URLPattern::MatchesURL().
+  std::vector<size_t> GetCandidatePatterns(const GURL& url) const;
+
+  std::vector<URLPattern> patterns_;
+
+  // Patterns that only match their own host, keyed by that host.
+  std::map<std::string, std::vector<size_t>, std::less<>> host_patterns_;
+
+  // Patterns that also match the subdomains of their host, keyed by that host.
+  std::map<std::string, std::vector<size_t>, std::less<>> domain_patterns_;
+
+  // Patterns without a host, which are checked against every URL.
+  std::vector<size_t> unindexed_patterns_;
+};
+
+}  // namespace extensions
+
+#endif  // CHROME_BROWSER_EXTENSIONS_USER_SCRIPT_URL_MATCHER_H_
@@ -0,0 +1,100 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/extensions/user_script_url_matcher.h"
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace extensions {
+
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+constexpr const char* kPatterns[] = {
+    "https://www.example.com/*",    // 0
+    "*://*.example.com/foo*",       // 1
+    "<all_urls>",                   // 2
+    "http://google.com/*",          // 3
+    "*://*.co.uk/*",                // 4
+    "file:///*",                    // 5
+    "https://*/*",                  // 6
+    "http://127.0.0.1/*",           // 7
+    "https://example.com./bar",     // 8
+};
+
+std::vector<URLPattern> CreatePatterns(bool include_all_urls) {
+  std::vector<URLPattern> patterns;
+  for (const char* pattern : kPatterns) {
+    patterns.emplace_back(URLPattern::SCHEME_ALL, pattern);
+    if (!include_all_urls && patterns.back().match_all_urls()) {
+      // Keep the indices stable with a pattern that never matches.
+      patterns.back() = URLPattern(URLPattern::SCHEME_ALL,
+                                   "https://unused.invalid/");
+    }
+  }
+  return patterns;
+}
+
+}  // namespace
+
+TEST(UserScriptURLMatcherTest, GetMatchingPatterns) {
+  UserScriptURLMatcher matcher(CreatePatterns(/*include_all_urls=*/false));
+  EXPECT_THAT(matcher.GetMatchingPatterns(GURL("https://www.example.com/")),
+              ElementsAre(0, 6));
+  EXPECT_THAT(
+      matcher.GetMatchingPatterns(GURL("http://a.b.example.com/foobar")),
+      ElementsAre(1));
+  EXPECT_THAT(matcher.GetMatchingPatterns(GURL("http://example.com/foo")),
+              ElementsAre(1));
+  EXPECT_THAT(matcher.GetMatchingPatterns(GURL("http://google.com/x")),
+              ElementsAre(3));
+  EXPECT_THAT(matcher.GetMatchingPatterns(GURL("http://mail.google.com/")),
+              IsEmpty());
+  EXPECT_THAT(matcher.GetMatchingPatterns(GURL("http://news.bbc.co.uk/")),
+              ElementsAre(4));
+  EXPECT_THAT(matcher.GetMatchingPatterns(GURL("file:///tmp/a.html")),
+              ElementsAre(5));
+  EXPECT_THAT(matcher.GetMatchingPatterns(GURL("http://127.0.0.1/")),
+              ElementsAre(7));
+  EXPECT_THAT(matcher.GetMatchingPatterns(GURL("https://example.com/bar")),
+              ElementsAre(6, 8));
+  EXPECT_THAT(matcher.GetMatchingPatterns(GURL("chrome://settings/")),
+              IsEmpty());
+  EXPECT_FALSE(matcher.MatchesURL(GURL("http://other.org/")));
+  EXPECT_TRUE(matcher.MatchesURL(GURL("https://other.org/")));
+}
+
+// The index must agree with matching every pattern on its own.
+TEST(UserScriptURLMatcherTest, AgreesWithURLPattern) {
+  for (bool include_all_urls : {false, true}) {
+    std::vector<URLPattern> patterns = CreatePatterns(include_all_urls);
+    UserScriptURLMatcher matcher(patterns);
+    for (const char* spec :
+         {"https://www.example.com/foo", "http://example.com./foo",
+          "https://EXAMPLE.com/bar", "http://sub.google.com/",
+          "https://co.uk/", "file:///etc/passwd", "http://127.0.0.1:8080/",
+          "http://[::1]/", "filesystem:https://www.example.com/temporary/a",
+          "about:blank", "data:text/plain,a", "not a url"}) {
+      const GURL url(spec);
+      std::vector<size_t> expected;
+      for (size_t i = 0; i < patterns.size(); ++i) {
+        if (patterns[i].MatchesURL(url)) {
+          expected.push_back(i);
+        }
+      }
+      EXPECT_EQ(expected, matcher.GetMatchingPatterns(url)) << spec;
+      EXPECT_EQ(!expected.empty(), matcher.MatchesURL(url)) << spec;
+    }
+  }
+}
+
+}  // namespace extensions
@@ -10,6 +10,7 @@
 
 #include "base/functional/bind.h"
 #include "base/memory/ptr_util.h"
+#include "base/no_destructor.h"
 #include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
 #include "chrome/browser/font_pref_change_notifier_factory.h"
@@ -21,6 +22,58 @@
 // Identifies the user data on the profile.
 const char kFontFamilyCacheKey[] = "FontFamilyCacheKey";
 
+namespace {
+
+// The names of the font family prefs of every known font family map and
+// script. The names are the same for every profile, so they are computed once
+// and shared by all the caches instead of being formatted on every miss.
+class FontPrefNameIndex {
+ public:
+  static const FontPrefNameIndex& Get() {
+    static const base::NoDestructor<FontPrefNameIndex> index;
+    return *index;
+  }
+
+  FontPrefNameIndex(const FontPrefNameIndex&) = delete;
+  FontPrefNameIndex& operator=(const FontPrefNameIndex&) = delete;
+
+  // Returns null if |map_name| or |script| is not known. Key comparison uses
+  // pointer equality.
+  const std::string* Find(const char* map_name, const char* script) const {
+    auto it = names_.find(map_name);
+    if (it == names_.end())
+      return nullptr;
+    auto it2 = it->second.find(script);
+    return it2 == it->second.end() ? nullptr : &it2->second;
+  }
+
+ private:
+  friend class base::NoDestructor<FontPrefNameIndex>;
+
+  FontPrefNameIndex() {
+    const char* const kMapNames[] = {
+        prefs::kWebKitStandardFontFamilyMap,
+        prefs::kWebKitFixedFontFamilyMap,
+        prefs::kWebKitSerifFontFamilyMap,
+        prefs::kWebKitSansSerifFontFamilyMap,
+        prefs::kWebKitCursiveFontFamilyMap,
+        prefs::kWebKitFantasyFontFamilyMap,
+        prefs::kWebKitMathFontFamilyMap,
+    };
+    for (const char* map_name : kMapNames) {
+      std::unordered_map<const char*, std::string>& names = names_[map_name];
+      for (const char* script : prefs::kWebKitScriptsForFontFamilyMaps)
+        names[script] = base::StringPrintf("%s.%s", map_name, script);
+    }
+  }
+
+  std::unordered_map<const char*,
+                     std::unordered_map<const char*, std::string>>
+      names_;
+};
+
+}  // namespace
+
 FontFamilyCache::FontFamilyCache(Profile* profile)
     : prefs_(profile->GetPrefs()) {
   font_change_registrar_.Register(
@@ -60,8 +113,12 @@ void FontFamilyCache::FillFontFamilyMap(
 
 std::u16string FontFamilyCache::FetchFont(const char* script,
                                           const char* map_name) {
-  std::string pref_name = base::StringPrintf("%s.%s", map_name, script);
-  std::string font = prefs_->GetString(pref_name.c_str());
+  const std::string* pref_name =
+      FontPrefNameIndex::Get().Find(map_name, script);
+  std::string font =
+      pref_name ? prefs_->GetString(*pref_name)
+                : prefs_->GetString(
+                      base::StringPrintf("%s.%s", map_name, script));
   std::u16string font16 = base::UTF8ToUTF16(font);
 
   // Lazily constructs the map if it doesn't already exist.
@@ -18,6 +18,7 @@ class PrefService;
 class Profile;
 
 FORWARD_DECLARE_TEST(FontFamilyCacheTest, Caching);
+FORWARD_DECLARE_TEST(FontFamilyCacheTest, KnownScript);
 
 // Caches font family preferences associated with a PrefService. This class
 // relies on the assumption that each concatenation of map_name + '.' + script
@@ -52,6 +53,7 @@ class FontFamilyCache : public base::SupportsUserData::Data {
 
  private:
   FRIEND_TEST_ALL_PREFIXES(::FontFamilyCacheTest, Caching);
+  FRIEND_TEST_ALL_PREFIXES(::FontFamilyCacheTest, KnownScript);
 
   // Map from script to font.
   // Key comparison uses pointer equality.
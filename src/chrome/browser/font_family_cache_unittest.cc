@@ -5,6 +5,7 @@
 #include "chrome/browser/font_family_cache.h"
 
 #include "base/strings/utf_string_conversions.h"
+#include "chrome/common/pref_names.h"
 #include "chrome/test/base/testing_profile.h"
 #include "components/sync_preferences/testing_pref_service_syncable.h"
 #include "content/public/test/browser_task_environment.h"
@@ -77,3 +78,23 @@ TEST(FontFamilyCacheTest, Caching) {
   EXPECT_EQ(font2, result);
   EXPECT_EQ(2, cache.fetch_font_count_);
 }
+
+// Tests that the fonts of the known font family maps and scripts are read from
+// the right preference.
+TEST(FontFamilyCacheTest, KnownScript) {
+  content::BrowserTaskEnvironment task_environment_;
+  TestingProfile profile;
+  TestingFontFamilyCache cache(&profile);
+  sync_preferences::TestingPrefServiceSyncable* prefs =
+      profile.GetTestingPrefService();
+
+  const char* map_name = prefs::kWebKitCursiveFontFamilyMap;
+  const char* script = prefs::kWebKitScriptsForFontFamilyMaps[0];
+  std::string pref_name = std::string(map_name) + '.' + script;
+  if (!prefs->FindPreference(pref_name))
+    prefs->registry()->RegisterStringPref(pref_name, std::string());
+  prefs->SetString(pref_name, "font 1");
+
+  EXPECT_EQ(u"font 1", cache.FetchAndCacheFont(script, map_name));
+  EXPECT_EQ(1, cache.fetch_font_count_);
+}
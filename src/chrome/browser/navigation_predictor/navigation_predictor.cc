@@ -5,17 +5,23 @@
 #include "chrome/browser/navigation_predictor/navigation_predictor.h"
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "base/check_op.h"
 #include "base/command_line.h"
 #include "base/hash/hash.h"
 #include "base/metrics/field_trial_params.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/rand_util.h"
 #include "base/ranges/algorithm.h"
 #include "base/system/sys_info.h"
 #include "base/time/default_tick_clock.h"
+#include "chrome/browser/navigation_predictor/navigation_predictor_features.h"
 #include "chrome/browser/navigation_predictor/navigation_predictor_keyed_service.h"
 #include "chrome/browser/navigation_predictor/navigation_predictor_keyed_service_factory.h"
 #include "chrome/browser/navigation_predictor/preloading_model_keyed_service.h"
@@ -41,6 +47,14 @@ namespace {
 // The maximum number of clicks to track in a single navigation.
 constexpr size_t kMaxClicksTracked = 10;
 
+// The hover dwell time after which the dwell doesn't make a click more likely.
+constexpr base::TimeDelta kViewportScoringSaturatingDwellTime =
+    base::Milliseconds(300);
+
+// The mouse velocity, in pixels per second, below which the pointer is
+// considered to be settling on the anchor it hovers.
+constexpr double kViewportScoringSettlingMouseVelocity = 100.0;
+
 bool IsPrerendering(content::RenderFrameHost& render_frame_host) {
   return render_frame_host.GetLifecycleState() ==
          content::RenderFrameHost::LifecycleState::kPrerendering;
@@ -173,6 +187,7 @@ NavigationPredictor::NavigationPredictor(
 
 NavigationPredictor::~NavigationPredictor() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  RecordViewportAnchorScoringMetrics();
 }
 
 void NavigationPredictor::Create(
@@ -454,6 +469,7 @@ void NavigationPredictor::SetTaskRunnerForTesting(
     scoped_refptr<base::SingleThreadTaskRunner> task_runner,
     const base::TickClock* clock) {
   ml_model_execution_timer_.SetTaskRunner(task_runner);
+  viewport_scoring_timer_.SetTaskRunner(task_runner);
   clock_ = clock;
   navigation_start_ = NowTicks();
 }
@@ -480,6 +496,13 @@ void NavigationPredictor::ReportAnchorElementClick(
 
   navigation_start_to_click_ = click->navigation_start_to_click;
 
+  // Count the clicks on anchors preloaded by ScoreAnchorsInViewport().
+  auto preloaded_it = viewport_preloaded_urls_.find(
+      base::FastHash(click->target_url.GetWithoutRef().spec()));
+  if (preloaded_it != viewport_preloaded_urls_.end()) {
+    preloaded_it->second = true;
+  }
+
   clicked_count_++;
   if (clicked_count_ > kMaxClicksTracked)
     return;
@@ -569,6 +592,12 @@ void NavigationPredictor::ReportAnchorElementsLeftViewport(
   auto& user_interactions =
       GetNavigationPredictorMetricsDocumentData().GetUserInteractionsData();
   for (const auto& element : elements) {
+    auto anchor_it = anchors_.find(AnchorId(element->anchor_id));
+    if (anchor_it != anchors_.end()) {
+      anchor_it->second.entered_viewport_timestamp.reset();
+      anchor_it->second.hovered_since.reset();
+    }
+
     auto index_it =
         tracked_anchor_id_to_index_.find(AnchorId(element->anchor_id));
     if (index_it == tracked_anchor_id_to_index_.end()) {
@@ -589,6 +618,11 @@ void NavigationPredictor::ReportAnchorElementPointerDataOnHoverTimerFired(
     return;
   }
 
+  auto anchor_it = anchors_.find(AnchorId(msg->anchor_id));
+  if (anchor_it != anchors_.end()) {
+    anchor_it->second.mouse_velocity = msg->pointer_data->mouse_velocity;
+  }
+
   auto& user_interactions =
       GetNavigationPredictorMetricsDocumentData().GetUserInteractionsData();
   auto index_it = tracked_anchor_id_to_index_.find(AnchorId(msg->anchor_id));
@@ -603,6 +637,11 @@ void NavigationPredictor::ReportAnchorElementPointerDataOnHoverTimerFired(
 
 void NavigationPredictor::ReportAnchorElementPointerOver(
     blink::mojom::AnchorElementPointerOverPtr pointer_over_event) {
+  auto anchor_it = anchors_.find(AnchorId(pointer_over_event->anchor_id));
+  if (anchor_it != anchors_.end()) {
+    anchor_it->second.hovered_since = NowTicks();
+  }
+
   auto& user_interactions =
       GetNavigationPredictorMetricsDocumentData().GetUserInteractionsData();
   auto index_it =
@@ -622,6 +661,12 @@ void NavigationPredictor::ReportAnchorElementPointerOver(
 
 void NavigationPredictor::ReportAnchorElementPointerOut(
     blink::mojom::AnchorElementPointerOutPtr hover_event) {
+  auto anchor_it = anchors_.find(AnchorId(hover_event->anchor_id));
+  if (anchor_it != anchors_.end()) {
+    anchor_it->second.hovered_since.reset();
+    anchor_it->second.mouse_velocity.reset();
+  }
+
   auto& navigation_predictor_metrics_data =
       GetNavigationPredictorMetricsDocumentData();
   auto& user_interactions =
@@ -709,7 +754,9 @@ void NavigationPredictor::ReportAnchorElementsEnteredViewport(
       // zero width/height, etc.
       continue;
     }
-    const AnchorElementData& anchor = anchor_it->second;
+    AnchorElementData& anchor = anchor_it->second;
+    anchor.entered_viewport_timestamp = NowTicks();
+    MaybeStartViewportAnchorScoring();
     // Collect the target URL if it is new, without ref (# fragment).
     if (IsTargetURLTheSameAsDocument(anchor)) {
       // Ignore anchors pointing to the same document.
@@ -756,3 +803,133 @@ bool NavigationPredictor::IsTargetURLTheSameAsDocument(
   return render_frame_host().GetLastCommittedURL().EqualsIgnoringRef(
       anchor.target_url);
 }
+
+void NavigationPredictor::MaybeStartViewportAnchorScoring() {
+  if (!base::FeatureList::IsEnabled(
+          features::kNavigationPredictorViewportAnchorScoring) ||
+      viewport_scoring_timer_.IsRunning()) {
+    return;
+  }
+  // Unretained is safe because the timer is owned by `this`.
+  viewport_scoring_timer_.Start(
+      FROM_HERE,
+      features::kNavigationPredictorViewportAnchorScoringInterval.Get(),
+      base::BindRepeating(&NavigationPredictor::ScoreAnchorsInViewport,
+                          base::Unretained(this)));
+}
+
+void NavigationPredictor::ScoreAnchorsInViewport() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  const size_t budget = base::saturated_cast<size_t>(
+      features::kNavigationPredictorViewportAnchorPreloadBudget.Get());
+  if (viewport_preloaded_urls_.size() >= budget) {
+    viewport_scoring_timer_.Stop();
+    return;
+  }
+
+  Profile* profile =
+      Profile::FromBrowserContext(render_frame_host().GetBrowserContext());
+  if (prefetch::IsSomePreloadingEnabled(*profile->GetPrefs()) !=
+      content::PreloadingEligibility::kEligible) {
+    return;
+  }
+
+  const base::TimeTicks now = NowTicks();
+  bool has_anchors_in_viewport = false;
+  std::vector<std::pair<double, const AnchorElementData*>> candidates;
+  for (const auto& [anchor_id, anchor] : anchors_) {
+    if (!anchor.entered_viewport_timestamp.has_value()) {
+      continue;
+    }
+    has_anchors_in_viewport = true;
+    if (IsTargetURLTheSameAsDocument(anchor) ||
+        viewport_preloaded_urls_.contains(
+            base::FastHash(anchor.target_url.GetWithoutRef().spec()))) {
+      continue;
+    }
+    candidates.emplace_back(GetViewportAnchorClickProbability(anchor, now),
+                            &anchor);
+  }
+  if (!has_anchors_in_viewport) {
+    // Scoring restarts when an anchor enters the viewport again.
+    viewport_scoring_timer_.Stop();
+    return;
+  }
+
+  // The more of the budget is used, the more confident the prediction has to
+  // be, so that the last preloads go to the most likely clicks.
+  const double min_probability =
+      features::kNavigationPredictorViewportAnchorMinProbability.Get();
+  const double used_budget =
+      static_cast<double>(viewport_preloaded_urls_.size()) / budget;
+  const double threshold =
+      min_probability + (1.0 - min_probability) * used_budget;
+  const size_t top_k = std::min(
+      candidates.size(),
+      base::saturated_cast<size_t>(
+          features::kNavigationPredictorViewportAnchorTopK.Get()));
+  std::partial_sort(
+      candidates.begin(), candidates.begin() + top_k, candidates.end(),
+      [](const auto& a, const auto& b) { return a.first > b.first; });
+  for (size_t i = 0; i < top_k; ++i) {
+    const auto& [probability, anchor] = candidates[i];
+    if (probability < threshold || viewport_preloaded_urls_.size() >= budget) {
+      break;
+    }
+    GURL target_url = anchor->target_url.GetWithoutRef();
+    if (!viewport_preloaded_urls_
+             .emplace(base::FastHash(target_url.spec()), false)
+             .second) {
+      continue;
+    }
+    // The score is handed to the same preloading heuristics as the scores of
+    // the ML model.
+    OnPreloadingHeuristicsModelDone(std::move(target_url),
+                                    static_cast<float>(probability));
+  }
+}
+
+double NavigationPredictor::GetViewportAnchorClickProbability(
+    const AnchorElementData& anchor,
+    base::TimeTicks now) const {
+  // A logistic model with hand-tuned weights: large anchors near the top of
+  // the page are more likely to be clicked, and hovering over an anchor, for
+  // long and with a slowing pointer, makes a click very likely.
+  double logit = -4.0;
+  logit += 2.0 * std::min(anchor.ratio_area / 10.0, 1.0);
+  logit += 1.0 - std::clamp(anchor.ratio_distance_root_top, 0.0f, 1.0f);
+  if (anchor.contains_image) {
+    logit += 0.5;
+  }
+  if (anchor.is_same_host) {
+    logit += 0.5;
+  }
+  if (anchor.hovered_since.has_value()) {
+    logit += 3.0 * std::min((now - anchor.hovered_since.value()) /
+                                kViewportScoringSaturatingDwellTime,
+                            1.0);
+    if (anchor.mouse_velocity.has_value() &&
+        anchor.mouse_velocity.value() < kViewportScoringSettlingMouseVelocity) {
+      logit += 1.0;
+    }
+  }
+  return 1.0 / (1.0 + std::exp(-logit));
+}
+
+void NavigationPredictor::RecordViewportAnchorScoringMetrics() const {
+  if (viewport_preloaded_urls_.empty()) {
+    return;
+  }
+  const int preloads = static_cast<int>(viewport_preloaded_urls_.size());
+  const int hits = static_cast<int>(base::ranges::count_if(
+      viewport_preloaded_urls_,
+      [](const auto& entry) { return entry.second; }));
+  base::UmaHistogramCounts100(
+      "NavigationPredictor.ViewportAnchorScoring.PreloadCount", preloads);
+  base::UmaHistogramPercentage(
+      "NavigationPredictor.ViewportAnchorScoring.HitRate",
+      100 * hits / preloads);
+  base::UmaHistogramCounts100(
+      "NavigationPredictor.ViewportAnchorScoring.WastedPreloadCount",
+      preloads - hits);
+}
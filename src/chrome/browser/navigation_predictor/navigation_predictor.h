@@ -5,6 +5,8 @@
 #ifndef CHROME_BROWSER_NAVIGATION_PREDICTOR_NAVIGATION_PREDICTOR_H_
 #define CHROME_BROWSER_NAVIGATION_PREDICTOR_NAVIGATION_PREDICTOR_H_
 
+#include <map>
+#include <optional>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -15,6 +17,7 @@
 #include "base/task/single_thread_task_runner.h"
 #include "base/time/tick_clock.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "chrome/browser/navigation_predictor/preloading_model_keyed_service.h"
 #include "chrome/browser/page_load_metrics/observers/page_anchors_metrics_observer.h"
 #include "content/public/browser/document_service.h"
@@ -135,6 +138,23 @@ class NavigationPredictor
 
   bool IsTargetURLTheSameAsDocument(const AnchorElementData& anchor);
 
+  // Starts scoring the anchors in the viewport periodically, if enabled and
+  // not already running.
+  void MaybeStartViewportAnchorScoring();
+
+  // Scores the anchors in the viewport and preloads the most likely to be
+  // clicked ones, within the preload budget of the page.
+  void ScoreAnchorsInViewport();
+
+  // Returns the estimated probability that `anchor` is clicked next, based on
+  // its position and size and on the pointer movements over it.
+  double GetViewportAnchorClickProbability(const AnchorElementData& anchor,
+                                           base::TimeTicks now) const;
+
+  // Records how many of the anchors preloaded by ScoreAnchorsInViewport() were
+  // clicked.
+  void RecordViewportAnchorScoringMetrics() const;
+
   base::TimeTicks NowTicks() const { return clock_->NowTicks(); }
 
   // A count of clicks to prevent reporting more than 10 clicks to UKM.
@@ -166,6 +186,11 @@ class NavigationPredictor
     base::TimeTicks first_report_timestamp;
     std::optional<base::TimeTicks> pointer_over_timestamp;
     size_t pointer_hovering_over_count = 0u;
+
+    // Following fields are used for scoring the anchors in the viewport.
+    std::optional<base::TimeTicks> entered_viewport_timestamp;
+    std::optional<base::TimeTicks> hovered_since;
+    std::optional<double> mouse_velocity;
   };
   std::unordered_map<AnchorId, AnchorElementData, typename AnchorId::Hasher>
       anchors_;
@@ -207,6 +232,13 @@ class NavigationPredictor
 
   base::OneShotTimer ml_model_execution_timer_;
 
+  // Runs ScoreAnchorsInViewport() while anchors are in the viewport.
+  base::RepeatingTimer viewport_scoring_timer_;
+
+  // Hashes of the URLs preloaded by ScoreAnchorsInViewport(), mapped to
+  // whether the user clicked on an anchor to them.
+  std::map<size_t, bool> viewport_preloaded_urls_;
+
   ModelScoreCallbackForTesting model_score_callback_;
 
   SEQUENCE_CHECKER(sequence_checker_);
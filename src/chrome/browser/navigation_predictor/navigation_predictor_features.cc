@@ -23,4 +23,25 @@ BASE_FEATURE(kNavigationPredictorEnablePreconnectOnSameDocumentNavigations,
              "NavigationPredictorEnablePreconnectOnSameDocumentNavigations",
              base::FEATURE_DISABLED_BY_DEFAULT);
 
+// Continuously scores the anchors in the viewport using their position and the
+// pointer movements over them, and preloads the most likely ones.
+BASE_FEATURE(kNavigationPredictorViewportAnchorScoring,
+             "NavigationPredictorViewportAnchorScoring",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+const base::FeatureParam<base::TimeDelta>
+    kNavigationPredictorViewportAnchorScoringInterval{
+        &kNavigationPredictorViewportAnchorScoring, "scoring_interval",
+        base::Milliseconds(500)};
+
+const base::FeatureParam<int> kNavigationPredictorViewportAnchorTopK{
+    &kNavigationPredictorViewportAnchorScoring, "top_k", 2};
+
+const base::FeatureParam<double>
+    kNavigationPredictorViewportAnchorMinProbability{
+        &kNavigationPredictorViewportAnchorScoring, "min_probability", 0.5};
+
+const base::FeatureParam<int> kNavigationPredictorViewportAnchorPreloadBudget{
+    &kNavigationPredictorViewportAnchorScoring, "preload_budget", 5};
+
 }  // namespace features
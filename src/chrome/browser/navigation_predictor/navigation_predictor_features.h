@@ -6,6 +6,8 @@
 #define CHROME_BROWSER_NAVIGATION_PREDICTOR_NAVIGATION_PREDICTOR_FEATURES_H_
 
 #include "base/feature_list.h"
+#include "base/metrics/field_trial_params.h"
+#include "base/time/time.h"
 
 namespace features {
 
@@ -14,6 +16,20 @@ namespace features {
 BASE_DECLARE_FEATURE(kNavigationPredictorPreconnectHoldback);
 BASE_DECLARE_FEATURE(
     kNavigationPredictorEnablePreconnectOnSameDocumentNavigations);
+BASE_DECLARE_FEATURE(kNavigationPredictorViewportAnchorScoring);
+
+// How often the anchors in the viewport are scored.
+extern const base::FeatureParam<base::TimeDelta>
+    kNavigationPredictorViewportAnchorScoringInterval;
+// The maximum number of anchors that are preloaded after each scoring.
+extern const base::FeatureParam<int> kNavigationPredictorViewportAnchorTopK;
+// The click probability above which an anchor is preloaded when none of the
+// budget is used.
+extern const base::FeatureParam<double>
+    kNavigationPredictorViewportAnchorMinProbability;
+// The maximum number of anchors preloaded per page.
+extern const base::FeatureParam<int>
+    kNavigationPredictorViewportAnchorPreloadBudget;
 
 }  // namespace features
 
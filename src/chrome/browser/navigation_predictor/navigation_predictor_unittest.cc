@@ -16,6 +16,7 @@
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/test/test_mock_time_task_runner.h"
+#include "chrome/browser/navigation_predictor/navigation_predictor_features.h"
 #include "chrome/browser/page_load_metrics/observers/page_anchors_metrics_observer.h"
 #include "chrome/test/base/chrome_render_view_host_test_harness.h"
 #include "components/ukm/test_ukm_recorder.h"
@@ -1362,6 +1363,78 @@ TEST_F(NavigationPredictorUserInteractionsTest,
   EXPECT_FALSE(did_ml_score_called);
 }
 
+class NavigationPredictorViewportAnchorScoringTest
+    : public NavigationPredictorUserInteractionsTest {
+ protected:
+  void SetUp() override {
+    NavigationPredictorUserInteractionsTest::SetUp();
+    viewport_scoring_feature_list_.InitAndEnableFeatureWithParameters(
+        features::kNavigationPredictorViewportAnchorScoring,
+        {{"scoring_interval", "500ms"},
+         {"top_k", "1"},
+         {"min_probability", "0.5"},
+         {"preload_budget", "2"}});
+  }
+
+ private:
+  base::test::ScopedFeatureList viewport_scoring_feature_list_;
+};
+
+TEST_F(NavigationPredictorViewportAnchorScoringTest, PreloadsHoveredAnchor) {
+  base::HistogramTester histogram_tester;
+  mojo::Remote<blink::mojom::AnchorElementMetricsHost> predictor_service;
+  auto* predictor_service_host = MockNavigationPredictorForTesting::Create(
+      main_rfh(), predictor_service.BindNewPipeAndPassReceiver());
+  predictor_service_host->SetTaskRunnerForTesting(
+      task_runner(), task_runner()->GetMockTickClock());
+
+  auto anchor_id = ReportNewAnchorElementWithDetails(
+      predictor_service.get(),
+      /*ratio_area=*/0.2,
+      /*ratio_distance_top_to_visible_top=*/0.0,
+      /*ratio_distance_root_top=*/0.0,
+      /*is_in_iframe=*/false,
+      /*contains_image=*/false,
+      /*is_same_host=*/true,
+      /*is_url_incremented_by_one=*/false,
+      /*has_text_sibling=*/false,
+      /*font_size_px=*/15,
+      /*font_weight=*/400);
+  std::optional<float> preload_score;
+  predictor_service_host->SetOnPreloadingHeuristicsModelDoneCallback(
+      base::BindLambdaForTesting(
+          [&](PreloadingModelKeyedService::Result result) {
+            preload_score = result;
+          }));
+
+  // An anchor that is only visible isn't likely enough to be clicked.
+  ReportAnchorElementEnteredViewport(predictor_service.get(), anchor_id,
+                                     base::Milliseconds(100));
+  task_runner()->FastForwardBy(base::Milliseconds(500));
+  EXPECT_FALSE(preload_score.has_value());
+
+  // Dwelling on the anchor makes it likely enough to be preloaded.
+  ReportAnchorElementPointerOver(predictor_service.get(), anchor_id,
+                                 base::Milliseconds(600));
+  task_runner()->FastForwardBy(base::Milliseconds(500));
+  ASSERT_TRUE(preload_score.has_value());
+  EXPECT_GT(preload_score.value(), 0.5f);
+
+  ReportAnchorElementClick(predictor_service.get(), anchor_id,
+                           GURL("https://google.com"),
+                           base::Milliseconds(1200));
+
+  // The metrics are recorded when the predictor is destroyed.
+  predictor_service.reset();
+  base::RunLoop().RunUntilIdle();
+  histogram_tester.ExpectUniqueSample(
+      "NavigationPredictor.ViewportAnchorScoring.PreloadCount", 1, 1);
+  histogram_tester.ExpectUniqueSample(
+      "NavigationPredictor.ViewportAnchorScoring.HitRate", 100, 1);
+  histogram_tester.ExpectUniqueSample(
+      "NavigationPredictor.ViewportAnchorScoring.WastedPreloadCount", 0, 1);
+}
+
 TEST_F(NavigationPredictorTest, RemoveAnchorElement) {
   mojo::Remote<blink::mojom::AnchorElementMetricsHost> predictor_service;
   auto* predictor_service_host = MockNavigationPredictorForTesting::Create(
@@ -10,6 +10,8 @@
 
 #if BUILDFLAG(IS_CHROMEOS_ASH)
 #include "chrome/browser/performance_manager/mechanisms/working_set_trimmer_chromeos.h"
+#elif BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_ANDROID)
+#include "chrome/browser/performance_manager/mechanisms/working_set_trimmer_linux.h"
 #endif
 
 namespace performance_manager {
@@ -33,6 +35,8 @@ class NoOpWorkingSetTrimmer : public WorkingSetTrimmer {
 WorkingSetTrimmer* WorkingSetTrimmer::GetInstance() {
 #if BUILDFLAG(IS_CHROMEOS_ASH)
   static base::NoDestructor<WorkingSetTrimmerChromeOS> trimmer;
+#elif BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_ANDROID)
+  static base::NoDestructor<WorkingSetTrimmerLinux> trimmer;
 #else
   static base::NoDestructor<NoOpWorkingSetTrimmer> trimmer;
 #endif
@@ -0,0 +1,152 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/performance_manager/mechanisms/working_set_trimmer_linux.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/debug/proc_maps_linux.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_file.h"
+#include "base/functional/bind.h"
+#include "base/logging.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/strings/string_util.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/thread_pool.h"
+#include "components/performance_manager/public/graph/process_node.h"
+
+#if !defined(__NR_pidfd_open)
+#define __NR_pidfd_open 434
+#endif
+
+#if !defined(__NR_process_madvise)
+#define __NR_process_madvise 440
+#endif
+
+#if !defined(MADV_PAGEOUT)
+#define MADV_PAGEOUT 21
+#endif
+
+namespace performance_manager {
+namespace mechanism {
+namespace {
+
+// The maximum number of ranges that can be passed to a single
+// process_madvise() call.
+constexpr size_t kMaxRangesPerCall = IOV_MAX;
+
+base::ScopedFD PidfdOpen(base::ProcessId pid) {
+  return base::ScopedFD(
+      HANDLE_EINTR(syscall(__NR_pidfd_open, pid, /*flags=*/0)));
+}
+
+ssize_t ProcessMadvise(int pidfd, const struct iovec* ranges, size_t count) {
+  return syscall(__NR_process_madvise, pidfd, ranges, count, MADV_PAGEOUT,
+                 /*flags=*/0);
+}
+
+// process_madvise() was added in Linux 5.10, which supports MADV_PAGEOUT. An
+// empty call on the browser process tells whether the kernel has both.
+bool KernelSupportsProcessMadvise() {
+  base::ScopedFD pidfd = PidfdOpen(getpid());
+  if (!pidfd.is_valid()) {
+    return false;
+  }
+  return ProcessMadvise(pidfd.get(), nullptr, 0) == 0;
+}
+
+// Returns true if |region| holds private anonymous memory, which is the only
+// memory that can't be dropped and read back from a file. Android names some
+// anonymous regions "[anon:...]".
+bool IsPrivateAnonymousRegion(const base::debug::MappedMemoryRegion& region) {
+  constexpr uint8_t kPrivateWritable =
+      base::debug::MappedMemoryRegion::WRITE |
+      base::debug::MappedMemoryRegion::PRIVATE;
+  if ((region.permissions & kPrivateWritable) != kPrivateWritable) {
+    return false;
+  }
+  return region.path.empty() || region.path == "[heap]" ||
+         base::StartsWith(region.path, "[anon:");
+}
+
+}  // namespace
+
+WorkingSetTrimmerLinux::WorkingSetTrimmerLinux() = default;
+WorkingSetTrimmerLinux::~WorkingSetTrimmerLinux() = default;
+
+bool WorkingSetTrimmerLinux::PlatformSupportsWorkingSetTrim() {
+  static const bool kPlatformSupported = KernelSupportsProcessMadvise();
+  return kPlatformSupported;
+}
+
+void WorkingSetTrimmerLinux::TrimWorkingSet(const ProcessNode* process_node) {
+  if (!PlatformSupportsWorkingSetTrim() ||
+      !process_node->GetProcess().IsValid()) {
+    return;
+  }
+  // Reading procfs and reclaiming the memory can take a while, do it off the
+  // Performance Manager sequence.
+  base::ThreadPool::PostTask(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&WorkingSetTrimmerLinux::PageOutAnonymousMemory,
+                     process_node->GetProcessId()));
+}
+
+// static
+void WorkingSetTrimmerLinux::PageOutAnonymousMemory(base::ProcessId pid) {
+  // Open the pidfd before reading the maps, so that the ranges aren't paged
+  // out of another process if the pid is reused in the meantime.
+  base::ScopedFD pidfd = PidfdOpen(pid);
+  if (!pidfd.is_valid()) {
+    // We won't log an error if the process is already dead.
+    PLOG_IF(ERROR, errno != ESRCH) << "pidfd_open failed for " << pid;
+    return;
+  }
+
+  std::string proc_maps;
+  std::vector<base::debug::MappedMemoryRegion> regions;
+  if (!base::ReadFileToString(
+          base::FilePath(base::StringPrintf("/proc/%d/maps", pid)),
+          &proc_maps) ||
+      !base::debug::ParseProcMaps(proc_maps, &regions)) {
+    return;
+  }
+
+  std::vector<struct iovec> ranges;
+  for (const auto& region : regions) {
+    if (IsPrivateAnonymousRegion(region)) {
+      ranges.push_back({reinterpret_cast<void*>(region.start),
+                        region.end - region.start});
+    }
+  }
+
+  for (size_t offset = 0; offset < ranges.size();
+       offset += kMaxRangesPerCall) {
+    const size_t count = std::min(kMaxRangesPerCall, ranges.size() - offset);
+    if (ProcessMadvise(pidfd.get(), &ranges[offset], count) < 0) {
+      // Regions can be unmapped while they're being paged out, which is
+      // harmless. The browser may also lack the permission to reclaim the
+      // memory of another process, in which case there's nothing to report.
+      PLOG_IF(ERROR, errno != ESRCH && errno != ENOMEM && errno != EPERM)
+          << "process_madvise failed for " << pid;
+      return;
+    }
+  }
+}
+
+}  // namespace mechanism
+}  // namespace performance_manager
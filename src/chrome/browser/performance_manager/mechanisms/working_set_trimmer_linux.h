@@ -0,0 +1,48 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CHROME_BROWSER_PERFORMANCE_MANAGER_MECHANISMS_WORKING_SET_TRIMMER_LINUX_H_
+#define CHROME_BROWSER_PERFORMANCE_MANAGER_MECHANISMS_WORKING_SET_TRIMMER_LINUX_H_
+
+#include "base/no_destructor.h"
+#include "base/process/process_handle.h"
+#include "chrome/browser/performance_manager/mechanisms/working_set_trimmer.h"
+
+namespace performance_manager {
+namespace mechanism {
+
+// WorkingSetTrimmerLinux is the platform specific implementation of a working
+// set trimmer for Linux and Android. It asks the kernel to page out the private
+// anonymous memory of a process with process_madvise(MADV_PAGEOUT), which
+// compresses it into zram or swaps it out, without losing any of it. This class
+// should not be used directly it should be used via the
+// WorkingSetTrimmer::GetInstance() method.
+class WorkingSetTrimmerLinux : public WorkingSetTrimmer {
+ public:
+  WorkingSetTrimmerLinux(const WorkingSetTrimmerLinux&) = delete;
+  WorkingSetTrimmerLinux& operator=(const WorkingSetTrimmerLinux&) = delete;
+
+  ~WorkingSetTrimmerLinux() override;
+
+  // WorkingSetTrimmer implementation:
+  bool PlatformSupportsWorkingSetTrim() override;
+  void TrimWorkingSet(const ProcessNode* process_node) override;
+
+ private:
+  friend class base::NoDestructor<WorkingSetTrimmerLinux>;
+
+  // Pages out the private anonymous memory of the process with ProcessId
+  // |pid|. This blocks on procfs reads and on the kernel reclaiming the memory.
+  static void PageOutAnonymousMemory(base::ProcessId pid);
+
+  // The constructor is made private to prevent instantiation of this class
+  // directly, it should always be retrieved via
+  // WorkingSetTrimmer::GetInstance().
+  WorkingSetTrimmerLinux();
+};
+
+}  // namespace mechanism
+}  // namespace performance_manager
+
+#endif  // CHROME_BROWSER_PERFORMANCE_MANAGER_MECHANISMS_WORKING_SET_TRIMMER_LINUX_H_
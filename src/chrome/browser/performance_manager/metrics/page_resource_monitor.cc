@@ -25,8 +25,10 @@
 #include "base/strings/strcat.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/system/sys_info.h"
+#include "base/task/thread_pool.h"
 #include "base/time/time.h"
 #include "base/timer/timer.h"
+#include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
 #include "components/performance_manager/public/features.h"
 #include "components/performance_manager/public/graph/page_node.h"
@@ -37,8 +39,16 @@
 #include "services/metrics/public/cpp/ukm_recorder.h"
 #include "services/metrics/public/cpp/ukm_source_id.h"
 
+#if BUILDFLAG(IS_WIN) || BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS)
+#include "components/power_metrics/energy_metrics_provider.h"
+#endif
+
 namespace performance_manager::metrics {
 
+BASE_FEATURE(kPageEnergyEstimation,
+             "PageEnergyEstimation",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 namespace {
 
 using system_cpu::CpuProbe;
@@ -114,8 +124,46 @@ bool IsCPUInterventionEvaluationLoggingEnabled() {
 #endif
 }
 
+bool IsPageEnergyEstimationEnabled() {
+#if BUILDFLAG(IS_WIN) || BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS)
+  return base::FeatureList::IsEnabled(kPageEnergyEstimation);
+#else
+  return false;
+#endif
+}
+
 }  // namespace
 
+#if BUILDFLAG(IS_WIN) || BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS)
+class PageResourceMonitor::EnergySampler {
+ public:
+  EnergySampler()
+      : provider_(power_metrics::EnergyMetricsProvider::Create()) {}
+  ~EnergySampler() = default;
+
+  std::optional<uint64_t> Sample() {
+    if (!provider_) {
+      return std::nullopt;
+    }
+    std::optional<power_metrics::EnergyMetricsProvider::EnergyMetrics>
+        metrics = provider_->CaptureMetrics();
+    if (!metrics.has_value()) {
+      return std::nullopt;
+    }
+    return metrics->package_nanojoules;
+  }
+
+ private:
+  std::unique_ptr<power_metrics::EnergyMetricsProvider> provider_;
+};
+#else
+// Energy counters are not available on this platform.
+class PageResourceMonitor::EnergySampler {
+ public:
+  std::optional<uint64_t> Sample() { return std::nullopt; }
+};
+#endif
+
 class PageResourceMonitor::CPUResultConverter {
  public:
   // A callback that's invoked with the converted results.
@@ -152,9 +200,21 @@ PageResourceMonitor::PageResourceMonitor(bool enable_system_cpu_probe)
   query_observation_.Observe(&resource_query_);
   resource_query_.Start(kCollectionDelay);
   std::unique_ptr<CpuProbe> system_cpu_probe;
-  if (enable_system_cpu_probe && IsCPUInterventionEvaluationLoggingEnabled()) {
+  if (enable_system_cpu_probe && (IsCPUInterventionEvaluationLoggingEnabled() ||
+                                  IsPageEnergyEstimationEnabled())) {
     system_cpu_probe = CpuProbe::Create();
   }
+  // Energy is attributed by share of system CPU, so it needs the probe too.
+  if (system_cpu_probe && IsPageEnergyEstimationEnabled()) {
+    energy_sampler_ = base::SequenceBound<EnergySampler>(
+        base::ThreadPool::CreateSequencedTaskRunner(
+            {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+             base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN}));
+    energy_sampler_.AsyncCall(&EnergySampler::Sample)
+        .Then(base::BindOnce(&PageResourceMonitor::OnEnergySample,
+                             weak_factory_.GetWeakPtr(),
+                             base::TimeTicks::Now()));
+  }
   cpu_result_converter_ =
       std::make_unique<CPUResultConverter>(std::move(system_cpu_probe));
 }
@@ -164,6 +224,12 @@ PageResourceMonitor::~PageResourceMonitor() = default;
 void PageResourceMonitor::OnResourceUsageUpdated(
     const QueryResultMap& results) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (energy_sampler_) {
+    energy_sampler_.AsyncCall(&EnergySampler::Sample)
+        .Then(base::BindOnce(&PageResourceMonitor::OnEnergySample,
+                             weak_factory_.GetWeakPtr(),
+                             base::TimeTicks::Now()));
+  }
   cpu_result_converter_->OnResourceUsageUpdated(
       base::BindOnce(&PageResourceMonitor::OnPageResourceUsageResult,
                      weak_factory_.GetWeakPtr(), results),
@@ -225,6 +291,12 @@ void PageResourceMonitor::OnPageResourceUsageResult(
     ukm.Record(ukm::UkmRecorder::Get());
   }
 
+  // The energy interval is sampled alongside the CPU interval, so it covers
+  // about the same period.
+  if (system_cpu.has_value() && last_interval_package_nanojoules_.has_value()) {
+    RecordPageEnergyEstimates(page_cpu_usage, *system_cpu, now);
+  }
+
   time_of_last_resource_usage_ = now;
 
   if (IsCPUInterventionEvaluationLoggingEnabled()) {
@@ -461,6 +533,64 @@ void PageResourceMonitor::LogCPUInterventionMetrics(
   }
 }
 
+void PageResourceMonitor::OnEnergySample(
+    base::TimeTicks time,
+    std::optional<uint64_t> package_nanojoules) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  last_interval_package_nanojoules_.reset();
+  // The counter is monotonic, so a decrease means it was reset.
+  if (package_nanojoules.has_value() && last_package_nanojoules_.has_value() &&
+      *package_nanojoules >= *last_package_nanojoules_) {
+    last_interval_package_nanojoules_ =
+        *package_nanojoules - *last_package_nanojoules_;
+    last_energy_interval_ = time - time_of_last_energy_sample_;
+  }
+  last_package_nanojoules_ = package_nanojoules;
+  time_of_last_energy_sample_ = time;
+}
+
+void PageResourceMonitor::RecordPageEnergyEstimates(
+    const PageCPUUsageMap& page_cpu_usage,
+    const CpuSample& system_cpu,
+    base::TimeTicks now) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  CHECK(last_interval_package_nanojoules_.has_value());
+  // Both are in the [0.0, number of cores] range.
+  const double system_cpu_usage =
+      system_cpu.cpu_utilization * base::SysInfo::NumberOfProcessors();
+  if (system_cpu_usage <= 0 || !last_energy_interval_.is_positive()) {
+    return;
+  }
+
+  double total_tab_nanojoules = 0;
+  double background_tab_nanojoules = 0;
+  for (const auto& [page_context, cpu_usage] : page_cpu_usage) {
+    const PageNode* page_node = PageNodeFromContext(page_context);
+    if (!page_node) {
+      // Page was deleted while waiting for system CPU.
+      continue;
+    }
+    const double nanojoules = std::min(cpu_usage / system_cpu_usage, 1.0) *
+                              *last_interval_package_nanojoules_;
+    total_tab_nanojoules += nanojoules;
+    if (GetBackgroundStateForMeasurementPeriod(
+            page_node, now - time_of_last_resource_usage_) !=
+        PageMeasurementBackgroundState::kForeground) {
+      background_tab_nanojoules += nanojoules;
+    }
+    // Nanojoules per second are nanowatts, traced as milliwatts.
+    TRACE_COUNTER_ID1(TRACE_DISABLED_BY_DEFAULT("system_power"),
+                      "Estimated Tab Power (mW)", page_node->GetUkmSourceID(),
+                      nanojoules / 1e6 / last_energy_interval_.InSecondsF());
+  }
+
+  if (total_tab_nanojoules > 0) {
+    base::UmaHistogramPercentage(
+        "PerformanceManager.PageEnergy.BackgroundTabShare",
+        100 * background_tab_nanojoules / total_tab_nanojoules);
+  }
+}
+
 PageResourceMonitor::CPUResultConverter::CPUResultConverter(
     std::unique_ptr<CpuProbe> system_cpu_probe)
     : system_cpu_probe_(std::move(system_cpu_probe)),
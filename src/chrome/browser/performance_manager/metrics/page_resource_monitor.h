@@ -5,13 +5,17 @@
 #ifndef CHROME_BROWSER_PERFORMANCE_MANAGER_METRICS_PAGE_RESOURCE_MONITOR_H_
 #define CHROME_BROWSER_PERFORMANCE_MANAGER_METRICS_PAGE_RESOURCE_MONITOR_H_
 
+#include <stdint.h>
+
 #include <map>
 #include <memory>
 #include <optional>
 
+#include "base/feature_list.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "base/threading/sequence_bound.h"
 #include "base/time/time.h"
 #include "base/timer/timer.h"
 #include "components/performance_manager/public/graph/graph.h"
@@ -22,6 +26,11 @@
 
 namespace performance_manager::metrics {
 
+// When enabled, the system's package energy is split between tabs by their
+// share of the system CPU usage, and traced per tab. Only supported where
+// power_metrics::EnergyMetricsProvider is.
+BASE_DECLARE_FEATURE(kPageEnergyEstimation);
+
 // Periodically reports tab resource usage via UKM.
 class PageResourceMonitor : public resource_attribution::QueryResultObserver,
                             public GraphOwnedDefaultImpl {
@@ -114,6 +123,21 @@ class PageResourceMonitor : public resource_attribution::QueryResultObserver,
       const base::TimeTicks now,
       CPUInterventionSuffix histogram_suffix);
 
+  // Reads the package energy counter on a sequence that allows blocking.
+  class EnergySampler;
+
+  // Invoked with the counter read by `energy_sampler_`, or nullopt if it could
+  // not be read.
+  void OnEnergySample(base::TimeTicks time,
+                      std::optional<uint64_t> package_nanojoules);
+
+  // Attributes the package energy used over the last energy sampling interval
+  // to each tab in proportion to its share of `system_cpu`, and emits the
+  // resulting power estimates as per-tab trace counters.
+  void RecordPageEnergyEstimates(const PageCPUUsageMap& page_cpu_usage,
+                                 const system_cpu::CpuSample& system_cpu,
+                                 base::TimeTicks now);
+
   SEQUENCE_CHECKER(sequence_checker_);
 
   // Repeating query that triggers OnResourceUsageUpdated on a timer.
@@ -141,6 +165,22 @@ class PageResourceMonitor : public resource_attribution::QueryResultObserver,
   std::unique_ptr<CPUResultConverter> delayed_cpu_result_converter_
       GUARDED_BY_CONTEXT(sequence_checker_);
 
+  // Null unless kPageEnergyEstimation is enabled.
+  base::SequenceBound<EnergySampler> energy_sampler_
+      GUARDED_BY_CONTEXT(sequence_checker_);
+
+  // The last package energy counter read, and when it was read.
+  std::optional<uint64_t> last_package_nanojoules_
+      GUARDED_BY_CONTEXT(sequence_checker_);
+  base::TimeTicks time_of_last_energy_sample_
+      GUARDED_BY_CONTEXT(sequence_checker_);
+
+  // Package energy used between the last two energy samples, and the time
+  // between them.
+  std::optional<uint64_t> last_interval_package_nanojoules_
+      GUARDED_BY_CONTEXT(sequence_checker_);
+  base::TimeDelta last_energy_interval_ GUARDED_BY_CONTEXT(sequence_checker_);
+
   // Graph being monitored.
   raw_ptr<Graph> graph_ GUARDED_BY_CONTEXT(sequence_checker_) = nullptr;
 
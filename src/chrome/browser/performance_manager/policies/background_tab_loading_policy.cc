@@ -4,14 +4,18 @@
 
 #include "chrome/browser/performance_manager/policies/background_tab_loading_policy.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "base/containers/contains.h"
+#include "base/feature_list.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/system/sys_info.h"
 #include "base/time/time.h"
+#include "chrome/browser/browser_process.h"
 #include "chrome/browser/performance_manager/mechanisms/page_loader.h"
 #include "chrome/browser/performance_manager/policies/background_tab_loading_policy_helpers.h"
+#include "chrome/browser/performance_manager/policies/policy_features.h"
 #include "chrome/browser/profiles/profile.h"
 #include "components/performance_manager/graph/page_node_impl.h"
 #include "components/performance_manager/public/decorators/site_data_recorder.h"
@@ -19,9 +23,12 @@
 #include "components/performance_manager/public/graph/policies/background_tab_loading_policy.h"
 #include "components/performance_manager/public/performance_manager.h"
 #include "components/performance_manager/public/persistence/site_data/site_data_reader.h"
+#include "components/site_engagement/content/site_engagement_service.h"
+#include "components/system_cpu/cpu_probe.h"
 #include "content/public/browser/permission_controller.h"
 #include "content/public/browser/web_contents.h"
 #include "content/public/common/url_constants.h"
+#include "services/network/public/cpp/network_quality_tracker.h"
 #include "third_party/blink/public/common/permissions/permission_utils.h"
 
 namespace performance_manager {
@@ -49,9 +56,11 @@ constexpr uint32_t BackgroundTabLoadingPolicy::kCoresPerSimultaneousTabLoad;
 
 BackgroundTabLoadingPolicy::PageNodeAndNotificationPermission::
     PageNodeAndNotificationPermission(base::WeakPtr<PageNode> page_node,
-                                      bool has_notification_permission)
+                                      bool has_notification_permission,
+                                      double site_engagement)
     : page_node(std::move(page_node)),
-      has_notification_permission(has_notification_permission) {}
+      has_notification_permission(has_notification_permission),
+      site_engagement(site_engagement) {}
 
 BackgroundTabLoadingPolicy::PageNodeAndNotificationPermission::
     PageNodeAndNotificationPermission(
@@ -65,6 +74,9 @@ void ScheduleLoadForRestoredTabs(
     std::vector<content::WebContents*> web_contents_vector) {
   DCHECK(!web_contents_vector.empty());
 
+  const bool dynamic_concurrency_enabled = base::FeatureList::IsEnabled(
+      features::kBackgroundTabLoadingDynamicConcurrency);
+
   std::vector<BackgroundTabLoadingPolicy::PageNodeAndNotificationPermission>
       page_node_and_notification_permission_vector;
   page_node_and_notification_permission_vector.reserve(
@@ -86,26 +98,56 @@ void ScheduleLoadForRestoredTabs(
                 url::Origin::Create(content->GetLastCommittedURL()))
             .status == blink::mojom::PermissionStatus::GRANTED;
 
+    double site_engagement = 0.0;
+    site_engagement::SiteEngagementService* engagement_service =
+        dynamic_concurrency_enabled
+            ? site_engagement::SiteEngagementService::Get(
+                  content->GetBrowserContext())
+            : nullptr;
+    if (engagement_service) {
+      site_engagement = std::clamp(
+          engagement_service->GetScore(content->GetLastCommittedURL()) /
+              site_engagement::SiteEngagementService::GetMaxPoints(),
+          0.0, 1.0);
+    }
+
     BackgroundTabLoadingPolicy::PageNodeAndNotificationPermission
         page_node_and_notification_permission(
             PerformanceManager::GetPrimaryPageNodeForWebContents(content),
-            has_notifications_permission);
+            has_notifications_permission, site_engagement);
 
     page_node_and_notification_permission_vector.push_back(
         page_node_and_notification_permission);
   }
+
+  // The network quality tracker lives on the UI thread, so its estimate is
+  // read here and passed to the policy along with the tabs.
+  std::optional<int32_t> downstream_kbps;
+  if (dynamic_concurrency_enabled &&
+      g_browser_process->network_quality_tracker()) {
+    const int32_t kbps = g_browser_process->network_quality_tracker()
+                             ->GetDownstreamThroughputKbps();
+    // The tracker reports a non-positive value when there is no estimate.
+    if (kbps > 0)
+      downstream_kbps = kbps;
+  }
+
   performance_manager::PerformanceManager::CallOnGraph(
       FROM_HERE,
       base::BindOnce(
           [](std::vector<
                  BackgroundTabLoadingPolicy::PageNodeAndNotificationPermission>
                  page_node_and_notification_permission_vector,
+             std::optional<int32_t> downstream_kbps,
              performance_manager::Graph* graph) {
-            BackgroundTabLoadingPolicy::GetInstance()
-                ->ScheduleLoadForRestoredTabs(
-                    std::move(page_node_and_notification_permission_vector));
+            BackgroundTabLoadingPolicy* policy =
+                BackgroundTabLoadingPolicy::GetInstance();
+            policy->SetDownstreamThroughputKbps(downstream_kbps);
+            policy->ScheduleLoadForRestoredTabs(
+                std::move(page_node_and_notification_permission_vector));
           },
-          std::move(page_node_and_notification_permission_vector)));
+          std::move(page_node_and_notification_permission_vector),
+          downstream_kbps));
 }
 
 BackgroundTabLoadingPolicy::BackgroundTabLoadingPolicy(
@@ -115,8 +157,18 @@ BackgroundTabLoadingPolicy::BackgroundTabLoadingPolicy(
       page_loader_(std::make_unique<mechanism::PageLoader>()) {
   DCHECK(!g_background_tab_loading_policy);
   g_background_tab_loading_policy = this;
+  // With dynamic concurrency, more tabs may load simultaneously on machines
+  // with enough cores since the loads are throttled by the system load.
+  const size_t max_simultaneous_tab_loads =
+      base::FeatureList::IsEnabled(
+          features::kBackgroundTabLoadingDynamicConcurrency)
+          ? std::max<size_t>(
+                kMinSimultaneousTabLoads,
+                base::saturated_cast<size_t>(
+                    features::kBackgroundTabLoadingMaxSimultaneousLoads.Get()))
+          : kMaxSimultaneousTabLoads;
   max_simultaneous_tab_loads_ = CalculateMaxSimultaneousTabLoads(
-      kMinSimultaneousTabLoads, kMaxSimultaneousTabLoads,
+      kMinSimultaneousTabLoads, max_simultaneous_tab_loads,
       kCoresPerSimultaneousTabLoad, base::SysInfo::NumberOfProcessors());
 }
 
@@ -133,6 +185,7 @@ void BackgroundTabLoadingPolicy::OnPassedToGraph(Graph* graph) {
 }
 
 void BackgroundTabLoadingPolicy::OnTakenFromGraph(Graph* graph) {
+  StopCpuSampling();
   graph->GetNodeDataDescriberRegistry()->UnregisterDescriber(this);
   graph->RemoveSystemNodeObserver(this);
   graph->RemovePageNodeObserver(this);
@@ -234,8 +287,10 @@ void BackgroundTabLoadingPolicy::ScheduleLoadForRestoredTabs(
 
     // Put the page in the queue for loading.
     page_nodes_to_load_.push_back(std::make_unique<PageNodeToLoadData>(
-        page_node, /* has_notification_permission=*/page_node_and_permission
-                       .has_notification_permission));
+        page_node,
+        /* has_notification_permission=*/page_node_and_permission
+            .has_notification_permission,
+        /* site_engagement=*/page_node_and_permission.site_engagement));
   }
 
   // Asynchronously determine whether pages added to `page_nodes_to_load_` are
@@ -248,10 +303,17 @@ void BackgroundTabLoadingPolicy::ScheduleLoadForRestoredTabs(
     SetUsedInBackgroundAsync(page_nodes_to_load_[i].get());
   }
 
+  MaybeStartCpuSampling();
+
   // All restored tabs may be loaded.
   UpdateHasRestoredTabsToLoad();
 }
 
+void BackgroundTabLoadingPolicy::SetDownstreamThroughputKbps(
+    std::optional<int32_t> downstream_kbps) {
+  downstream_kbps_ = downstream_kbps;
+}
+
 void BackgroundTabLoadingPolicy::SetMockLoaderForTesting(
     std::unique_ptr<mechanism::PageLoader> loader) {
   page_loader_ = std::move(loader);
@@ -267,6 +329,12 @@ void BackgroundTabLoadingPolicy::SetFreeMemoryForTesting(
   free_memory_mb_for_testing_ = free_memory_mb;
 }
 
+void BackgroundTabLoadingPolicy::SetCpuProbeForTesting(
+    std::unique_ptr<system_cpu::CpuProbe> cpu_probe) {
+  StopCpuSampling();
+  cpu_probe_ = std::move(cpu_probe);
+}
+
 void BackgroundTabLoadingPolicy::ResetPolicyForTesting() {
   tab_loads_started_ = 0;
 }
@@ -277,9 +345,11 @@ BackgroundTabLoadingPolicy* BackgroundTabLoadingPolicy::GetInstance() {
 
 BackgroundTabLoadingPolicy::PageNodeToLoadData::PageNodeToLoadData(
     PageNode* page_node,
-    bool has_notification_permission)
+    bool has_notification_permission,
+    double site_engagement)
     : page_node(page_node),
-      has_notification_permission(has_notification_permission) {}
+      has_notification_permission(has_notification_permission),
+      site_engagement(site_engagement) {}
 
 BackgroundTabLoadingPolicy::PageNodeToLoadData::~PageNodeToLoadData() = default;
 
@@ -312,6 +382,8 @@ base::Value::Dict BackgroundTabLoadingPolicy::DescribeSystemNodeData(
   base::Value::Dict dict;
   dict.Set("max_simultaneous_tab_loads",
            base::saturated_cast<int>(max_simultaneous_tab_loads_));
+  dict.Set("simultaneous_tab_loads_limit",
+           base::saturated_cast<int>(GetSimultaneousTabLoadsLimit()));
   dict.Set("tab_loads_started", base::saturated_cast<int>(tab_loads_started_));
   dict.Set("tabs_scored", base::saturated_cast<int>(tabs_scored_));
   return dict;
@@ -417,10 +489,21 @@ void BackgroundTabLoadingPolicy::ScoreTab(
 
   // Refine the score using the age of the tab. More recently used tabs have
   // higher scores.
-  score += CalculateAgeScore(
+  float age_score = CalculateAgeScore(
       page_node_to_load_data->page_node->GetTimeSinceLastVisibilityChange()
           .InSecondsF());
 
+  // With dynamic concurrency, the tabs on sites that the user engages with the
+  // most are also more likely to be needed soon. Average the two scores, which
+  // keeps the result below 1 so that it doesn't change the category.
+  if (base::FeatureList::IsEnabled(
+          features::kBackgroundTabLoadingDynamicConcurrency)) {
+    age_score = (age_score + std::min(page_node_to_load_data->site_engagement,
+                                      0.999)) /
+                2;
+  }
+  score += age_score;
+
   ++tabs_scored_;
   page_node_to_load_data->score = score;
 }
@@ -507,9 +590,10 @@ size_t BackgroundTabLoadingPolicy::GetMaxNewTabLoads() const {
       page_nodes_load_initiated_.size() + page_nodes_loading_.size();
 
   // Determine the number of free loading slots available.
+  const size_t simultaneous_tab_loads_limit = GetSimultaneousTabLoadsLimit();
   size_t page_nodes_to_load = 0;
-  if (loading_tab_count < max_simultaneous_tab_loads_)
-    page_nodes_to_load = max_simultaneous_tab_loads_ - loading_tab_count;
+  if (loading_tab_count < simultaneous_tab_loads_limit)
+    page_nodes_to_load = simultaneous_tab_loads_limit - loading_tab_count;
 
   // Cap the number of loads by the actual number of tabs remaining.
   page_nodes_to_load = std::min(page_nodes_to_load, page_nodes_to_load_.size());
@@ -517,6 +601,66 @@ size_t BackgroundTabLoadingPolicy::GetMaxNewTabLoads() const {
   return page_nodes_to_load;
 }
 
+size_t BackgroundTabLoadingPolicy::GetSimultaneousTabLoadsLimit() const {
+  if (!base::FeatureList::IsEnabled(
+          features::kBackgroundTabLoadingDynamicConcurrency)) {
+    return max_simultaneous_tab_loads_;
+  }
+  return CalculateDynamicSimultaneousTabLoads(
+      max_simultaneous_tab_loads_, downstream_kbps_,
+      base::saturated_cast<size_t>(
+          features::kBackgroundTabLoadingKbpsPerLoad.Get()),
+      GetFreePhysicalMemoryMib(), kDesiredAmountOfFreeMemoryMb,
+      base::saturated_cast<size_t>(
+          features::kBackgroundTabLoadingMemoryMbPerLoad.Get()),
+      cpu_utilization_,
+      features::kBackgroundTabLoadingHighCpuUtilization.Get());
+}
+
+void BackgroundTabLoadingPolicy::MaybeStartCpuSampling() {
+  if (!base::FeatureList::IsEnabled(
+          features::kBackgroundTabLoadingDynamicConcurrency) ||
+      cpu_sample_timer_.IsRunning()) {
+    return;
+  }
+  if (!cpu_probe_) {
+    cpu_probe_ = system_cpu::CpuProbe::Create();
+    if (!cpu_probe_)
+      return;
+  }
+  cpu_probe_->StartSampling();
+  // Unretained is safe because the timer is owned by `this`.
+  cpu_sample_timer_.Start(
+      FROM_HERE, features::kBackgroundTabLoadingCpuSampleInterval.Get(),
+      base::BindRepeating(&BackgroundTabLoadingPolicy::RequestCpuSample,
+                          base::Unretained(this)));
+}
+
+void BackgroundTabLoadingPolicy::StopCpuSampling() {
+  cpu_sample_timer_.Stop();
+  cpu_utilization_.reset();
+}
+
+void BackgroundTabLoadingPolicy::RequestCpuSample() {
+  DCHECK(cpu_probe_);
+  cpu_probe_->RequestSample(
+      base::BindOnce(&BackgroundTabLoadingPolicy::OnCpuSample,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void BackgroundTabLoadingPolicy::OnCpuSample(
+    std::optional<system_cpu::CpuSample> sample) {
+  // Ignore samples that arrive after all restored tabs are loaded.
+  if (!cpu_sample_timer_.IsRunning())
+    return;
+  if (!sample.has_value())
+    return;
+  cpu_utilization_ = sample->cpu_utilization;
+
+  // A lower CPU load may free loading slots.
+  MaybeLoadSomeTabs();
+}
+
 void BackgroundTabLoadingPolicy::LoadNextTab() {
   DCHECK(!page_nodes_to_load_.empty());
   DCHECK_EQ(tabs_scored_, page_nodes_to_load_.size());
@@ -595,6 +739,7 @@ void BackgroundTabLoadingPolicy::UpdateHasRestoredTabsToLoad() {
   if (HasRestoredTabsToLoad())
     return;
   has_restored_tabs_to_load_ = false;
+  StopCpuSampling();
   all_restored_tabs_loaded_callback_.Run();
 }
 
@@ -5,17 +5,25 @@
 #ifndef CHROME_BROWSER_PERFORMANCE_MANAGER_POLICIES_BACKGROUND_TAB_LOADING_POLICY_H_
 #define CHROME_BROWSER_PERFORMANCE_MANAGER_POLICIES_BACKGROUND_TAB_LOADING_POLICY_H_
 
+#include <memory>
+#include <optional>
 #include <vector>
 
 #include "base/gtest_prod_util.h"
 #include "base/memory/memory_pressure_listener.h"
 #include "base/memory/raw_ptr.h"
+#include "base/timer/timer.h"
+#include "components/system_cpu/cpu_sample.h"
 #include "components/performance_manager/public/graph/graph.h"
 #include "components/performance_manager/public/graph/node_data_describer.h"
 #include "components/performance_manager/public/graph/page_node.h"
 #include "components/performance_manager/public/graph/system_node.h"
 #include "url/gurl.h"
 
+namespace system_cpu {
+class CpuProbe;
+}  // namespace system_cpu
+
 namespace performance_manager {
 
 namespace mechanism {
@@ -58,7 +66,8 @@ class BackgroundTabLoadingPolicy : public GraphOwned,
   // Holds information about a PageNode to load by this policy.
   struct PageNodeAndNotificationPermission {
     PageNodeAndNotificationPermission(base::WeakPtr<PageNode> page_node,
-                                      bool has_notification_permission);
+                                      bool has_notification_permission,
+                                      double site_engagement = 0.0);
     PageNodeAndNotificationPermission(
         const PageNodeAndNotificationPermission&
             page_node_and_notification_permission);
@@ -66,6 +75,10 @@ class BackgroundTabLoadingPolicy : public GraphOwned,
 
     base::WeakPtr<PageNode> page_node;
     bool has_notification_permission;
+
+    // The site engagement score of the page's URL, scaled to [0, 1]. Only used
+    // when kBackgroundTabLoadingDynamicConcurrency is enabled.
+    double site_engagement;
   };
 
   // Schedules the PageNodes in |page_node_and_permission_vector| to be loaded
@@ -74,9 +87,15 @@ class BackgroundTabLoadingPolicy : public GraphOwned,
       std::vector<PageNodeAndNotificationPermission>
           page_node_and_permission_vector);
 
+  // Sets the downstream throughput of the network, or nullopt if it's unknown.
+  // Used to limit the number of simultaneous tab loads when
+  // kBackgroundTabLoadingDynamicConcurrency is enabled.
+  void SetDownstreamThroughputKbps(std::optional<int32_t> downstream_kbps);
+
   void SetMockLoaderForTesting(std::unique_ptr<mechanism::PageLoader> loader);
   void SetMaxSimultaneousLoadsForTesting(size_t loading_slots);
   void SetFreeMemoryForTesting(size_t free_memory_mb);
+  void SetCpuProbeForTesting(std::unique_ptr<system_cpu::CpuProbe> cpu_probe);
   void ResetPolicyForTesting();
 
   // Returns the instance of BackgroundTabLoadingPolicy within the graph.
@@ -88,8 +107,9 @@ class BackgroundTabLoadingPolicy : public GraphOwned,
   // Holds a handful of data about a tab which is used to prioritize it during
   // session restore.
   struct PageNodeToLoadData {
-    explicit PageNodeToLoadData(PageNode* page_node,
-                                bool has_notification_permission);
+    PageNodeToLoadData(PageNode* page_node,
+                       bool has_notification_permission,
+                       double site_engagement);
     PageNodeToLoadData(const PageNodeToLoadData&) = delete;
     ~PageNodeToLoadData();
     PageNodeToLoadData& operator=(const PageNodeToLoadData&) = delete;
@@ -103,6 +123,9 @@ class BackgroundTabLoadingPolicy : public GraphOwned,
     // Whether the tab has the notification permission.
     const bool has_notification_permission;
 
+    // The site engagement score of the tab, in [0, 1].
+    const double site_engagement;
+
     // Whether the tab updates its title or favicon when backgrounded.
     // Initialized to nullopt and set asynchronously with the proper value from
     // the sites database.
@@ -167,6 +190,23 @@ class BackgroundTabLoadingPolicy : public GraphOwned,
   // avoid exceeding the number of loading slots.
   size_t GetMaxNewTabLoads() const;
 
+  // Returns the number of tabs that can load simultaneously. This is
+  // `max_simultaneous_tab_loads_`, reduced according to the network, memory
+  // and CPU load when kBackgroundTabLoadingDynamicConcurrency is enabled.
+  size_t GetSimultaneousTabLoadsLimit() const;
+
+  // Starts and stops sampling the system CPU utilization while restored tabs
+  // are loading, when kBackgroundTabLoadingDynamicConcurrency is enabled.
+  void MaybeStartCpuSampling();
+  void StopCpuSampling();
+
+  // Requests a CPU sample from `cpu_probe_`.
+  void RequestCpuSample();
+
+  // Receives a sample requested by RequestCpuSample() and loads more tabs if
+  // the CPU load allows it.
+  void OnCpuSample(std::optional<system_cpu::CpuSample> sample);
+
   // Loads the next tab. This should only be called if there is a next tab to
   // load. This will always start loading a next tab even if the number of
   // simultaneously loading tabs is exceeded.
@@ -234,6 +274,19 @@ class BackgroundTabLoadingPolicy : public GraphOwned,
   // Used to overwrite the amount of free memory available on the system.
   size_t free_memory_mb_for_testing_ = 0;
 
+  // The last known downstream throughput of the network.
+  std::optional<int32_t> downstream_kbps_;
+
+  // Samples the system CPU utilization every
+  // kBackgroundTabLoadingCpuSampleInterval while restored tabs are loading.
+  // Created lazily, and null if the CPU can't be sampled on this system.
+  std::unique_ptr<system_cpu::CpuProbe> cpu_probe_;
+  base::RepeatingTimer cpu_sample_timer_;
+
+  // The last system CPU utilization, in [0, 1], while restored tabs are
+  // loading.
+  std::optional<double> cpu_utilization_;
+
   // The minimum total number of restored tabs to load.
   static constexpr uint32_t kMinTabsToLoad = 4;
 
@@ -40,6 +40,44 @@ size_t CalculateMaxSimultaneousTabLoads(size_t lower_bound,
   return loads;
 }
 
+size_t CalculateDynamicSimultaneousTabLoads(
+    size_t max_loads,
+    std::optional<int32_t> downstream_kbps,
+    size_t kbps_per_load,
+    size_t free_memory_mb,
+    size_t desired_free_memory_mb,
+    size_t memory_mb_per_load,
+    std::optional<double> cpu_utilization,
+    double high_cpu_utilization) {
+  size_t loads = max_loads;
+
+  if (downstream_kbps.has_value() && downstream_kbps.value() >= 0 &&
+      kbps_per_load != 0) {
+    loads = std::min(
+        loads, static_cast<size_t>(downstream_kbps.value()) / kbps_per_load);
+  }
+
+  if (memory_mb_per_load != 0) {
+    const size_t spare_memory_mb = free_memory_mb > desired_free_memory_mb
+                                       ? free_memory_mb - desired_free_memory_mb
+                                       : 0;
+    loads = std::min(loads, spare_memory_mb / memory_mb_per_load);
+  }
+
+  // Halve the loads when the CPU is half as busy as the high threshold, and
+  // load a single tab at a time above it, so that the restored tabs don't
+  // compete with the foreground tab for the CPU.
+  if (cpu_utilization.has_value()) {
+    if (cpu_utilization.value() >= high_cpu_utilization) {
+      loads = std::min<size_t>(loads, 1);
+    } else if (cpu_utilization.value() >= high_cpu_utilization / 2) {
+      loads = std::min(loads, max_loads / 2);
+    }
+  }
+
+  return std::max<size_t>(loads, 1);
+}
+
 float CalculateAgeScore(double last_visibility_change_seconds) {
   // TODO(crbug.com/40121561): Determine via an experiment whether tabs could
   // simply be sorted by descending order of last visibility, instead of using
@@ -6,6 +6,9 @@
 #define CHROME_BROWSER_PERFORMANCE_MANAGER_POLICIES_BACKGROUND_TAB_LOADING_POLICY_HELPERS_H_
 
 #include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
 
 namespace performance_manager {
 
@@ -18,6 +21,23 @@ size_t CalculateMaxSimultaneousTabLoads(size_t lower_bound,
                                         size_t cores_per_load,
                                         size_t num_cores);
 
+// Helper function for BackgroundTabLoadingPolicy to reduce the number of tabs
+// that can load simultaneously, `max_loads`, to what the system can currently
+// sustain. Each load needs `kbps_per_load` of `downstream_kbps` and
+// `memory_mb_per_load` of the memory above `desired_free_memory_mb`, and fewer
+// tabs are loaded as `cpu_utilization` approaches `high_cpu_utilization`.
+// Signals that are unknown (nullopt) or whose cost is zero don't limit the
+// loads. Always returns at least 1 so that the session restore makes progress.
+size_t CalculateDynamicSimultaneousTabLoads(
+    size_t max_loads,
+    std::optional<int32_t> downstream_kbps,
+    size_t kbps_per_load,
+    size_t free_memory_mb,
+    size_t desired_free_memory_mb,
+    size_t memory_mb_per_load,
+    std::optional<double> cpu_utilization,
+    double high_cpu_utilization);
+
 // Calculates a score for the "age" of the tab. This is a value between 0
 // (inclusive) and 1 (exclusive), where higher values are attributed to newer
 // tabs.
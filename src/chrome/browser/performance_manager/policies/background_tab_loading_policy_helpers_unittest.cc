@@ -53,6 +53,59 @@ TEST_F(BackgroundTabLoadingPolicyHelpersTest,
                                        0 /* cores_per_load */, 4 /* cores */));
 }
 
+TEST_F(BackgroundTabLoadingPolicyHelpersTest,
+       CalculateDynamicSimultaneousTabLoads) {
+  // Without any constraint, the maximum is returned.
+  EXPECT_EQ(8u, CalculateDynamicSimultaneousTabLoads(
+                    8 /* max_loads */, std::nullopt /* downstream_kbps */,
+                    2000 /* kbps_per_load */, 10000 /* free_memory_mb */,
+                    150 /* desired_free_memory_mb */,
+                    250 /* memory_mb_per_load */,
+                    std::nullopt /* cpu_utilization */,
+                    0.8 /* high_cpu_utilization */));
+
+  // The network throughput limits the loads.
+  EXPECT_EQ(3u, CalculateDynamicSimultaneousTabLoads(
+                    8 /* max_loads */, 6500 /* downstream_kbps */,
+                    2000 /* kbps_per_load */, 10000 /* free_memory_mb */,
+                    150 /* desired_free_memory_mb */,
+                    250 /* memory_mb_per_load */,
+                    std::nullopt /* cpu_utilization */,
+                    0.8 /* high_cpu_utilization */));
+
+  // The free memory above the desired amount limits the loads.
+  EXPECT_EQ(2u, CalculateDynamicSimultaneousTabLoads(
+                    8 /* max_loads */, std::nullopt /* downstream_kbps */,
+                    2000 /* kbps_per_load */, 700 /* free_memory_mb */,
+                    150 /* desired_free_memory_mb */,
+                    250 /* memory_mb_per_load */,
+                    std::nullopt /* cpu_utilization */,
+                    0.8 /* high_cpu_utilization */));
+
+  // A moderately busy CPU halves the loads, and a busy CPU allows a single
+  // load.
+  EXPECT_EQ(4u, CalculateDynamicSimultaneousTabLoads(
+                    8 /* max_loads */, std::nullopt /* downstream_kbps */,
+                    2000 /* kbps_per_load */, 10000 /* free_memory_mb */,
+                    150 /* desired_free_memory_mb */,
+                    250 /* memory_mb_per_load */, 0.5 /* cpu_utilization */,
+                    0.8 /* high_cpu_utilization */));
+  EXPECT_EQ(1u, CalculateDynamicSimultaneousTabLoads(
+                    8 /* max_loads */, std::nullopt /* downstream_kbps */,
+                    2000 /* kbps_per_load */, 10000 /* free_memory_mb */,
+                    150 /* desired_free_memory_mb */,
+                    250 /* memory_mb_per_load */, 0.9 /* cpu_utilization */,
+                    0.8 /* high_cpu_utilization */));
+
+  // At least one tab is always loaded.
+  EXPECT_EQ(1u, CalculateDynamicSimultaneousTabLoads(
+                    8 /* max_loads */, 100 /* downstream_kbps */,
+                    2000 /* kbps_per_load */, 100 /* free_memory_mb */,
+                    150 /* desired_free_memory_mb */,
+                    250 /* memory_mb_per_load */, 1.0 /* cpu_utilization */,
+                    0.8 /* high_cpu_utilization */));
+}
+
 TEST_F(BackgroundTabLoadingPolicyHelpersTest, CalculateAgeScore) {
   // Generate a bunch of random tab age data.
   std::vector<std::pair<base::TimeDelta, float>> tab_age_score;
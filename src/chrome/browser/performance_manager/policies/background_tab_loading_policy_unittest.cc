@@ -10,12 +10,16 @@
 
 #include "base/functional/bind.h"
 #include "base/memory/raw_ptr.h"
+#include "base/test/scoped_feature_list.h"
 #include "chrome/browser/performance_manager/mechanisms/page_loader.h"
+#include "chrome/browser/performance_manager/policies/policy_features.h"
 #include "components/performance_manager/graph/graph_impl.h"
 #include "components/performance_manager/graph/page_node_impl.h"
 #include "components/performance_manager/public/persistence/site_data/site_data_reader.h"
 #include "components/performance_manager/test_support/graph_test_harness.h"
 #include "components/performance_manager/test_support/persistence/test_site_data_reader.h"
+#include "components/system_cpu/cpu_sample.h"
+#include "components/system_cpu/pressure_test_support.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -576,6 +580,81 @@ TEST_F(BackgroundTabLoadingPolicyTest, OnMemoryPressure) {
   page_node_impl->SetLoadingState(PageNode::LoadingState::kLoadedIdle);
 }
 
+class BackgroundTabLoadingPolicyDynamicConcurrencyTest
+    : public BackgroundTabLoadingPolicyTest {
+ public:
+  BackgroundTabLoadingPolicyDynamicConcurrencyTest() {
+    scoped_feature_list_.InitAndEnableFeature(
+        features::kBackgroundTabLoadingDynamicConcurrency);
+  }
+
+  void SetUp() override {
+    BackgroundTabLoadingPolicyTest::SetUp();
+
+    auto cpu_probe = std::make_unique<system_cpu::FakeCpuProbe>();
+    cpu_probe_ = cpu_probe.get();
+    policy()->SetCpuProbeForTesting(std::move(cpu_probe));
+
+    // Leave enough free memory to not limit the loads.
+    policy()->SetFreeMemoryForTesting(10000);
+  }
+
+ protected:
+  system_cpu::FakeCpuProbe* cpu_probe() { return cpu_probe_; }
+
+ private:
+  base::test::ScopedFeatureList scoped_feature_list_;
+  raw_ptr<system_cpu::FakeCpuProbe, DanglingUntriaged> cpu_probe_;
+};
+
+TEST_F(BackgroundTabLoadingPolicyDynamicConcurrencyTest,
+       LoadsLimitedByNetworkAndCpu) {
+  std::vector<
+      performance_manager::TestNodeWrapper<performance_manager::PageNodeImpl>>
+      page_nodes;
+  std::vector<PageNodeAndNotificationPermission> to_load;
+
+  // The tabs have the same age, so they are ordered by decreasing site
+  // engagement.
+  for (double site_engagement : {0.9, 0.6, 0.3, 0.0}) {
+    page_nodes.push_back(CreateNode<performance_manager::PageNodeImpl>());
+    to_load.emplace_back(page_nodes.back().get()->GetWeakPtr(), false,
+                         site_engagement);
+
+    // Mark the PageNode as a tab as this is a requirement to pass it to
+    // ScheduleLoadForRestoredTabs().
+    page_nodes.back()->SetType(PageType::kTab);
+  }
+
+  // The network throughput allows 2 of the 4 loading slots to be used.
+  policy()->SetDownstreamThroughputKbps(
+      2 * features::kBackgroundTabLoadingKbpsPerLoad.Get());
+  cpu_probe()->SetLastSample(system_cpu::CpuSample{0.9});
+
+  EXPECT_CALL(*loader(), LoadPageNode(to_load[0].page_node.get()));
+  EXPECT_CALL(*loader(), LoadPageNode(to_load[1].page_node.get()));
+  policy()->ScheduleLoadForRestoredTabs(to_load);
+  task_env().RunUntilIdle();
+  ::testing::Mock::VerifyAndClear(loader());
+
+  // Once the network isn't a constraint, the busy CPU allows a single load, so
+  // no tab loads when the first one finishes.
+  policy()->SetDownstreamThroughputKbps(std::nullopt);
+  task_env().FastForwardBy(
+      features::kBackgroundTabLoadingCpuSampleInterval.Get());
+  page_nodes[0]->SetLoadingState(PageNode::LoadingState::kLoading);
+  page_nodes[0]->SetLoadingState(PageNode::LoadingState::kLoadedIdle);
+  ::testing::Mock::VerifyAndClear(loader());
+
+  // The remaining tabs load when the CPU becomes idle.
+  cpu_probe()->SetLastSample(system_cpu::CpuSample{0.1});
+  EXPECT_CALL(*loader(), LoadPageNode(to_load[2].page_node.get()));
+  EXPECT_CALL(*loader(), LoadPageNode(to_load[3].page_node.get()));
+  task_env().FastForwardBy(
+      features::kBackgroundTabLoadingCpuSampleInterval.Get());
+  ::testing::Mock::VerifyAndClear(loader());
+}
+
 }  // namespace policies
 
 }  // namespace performance_manager
@@ -5,10 +5,16 @@
 #include "chrome/browser/performance_manager/policies/memory_saver_mode_policy.h"
 
 #include "base/containers/contains.h"
+#include "base/feature_list.h"
 #include "base/notreached.h"
+#include "chrome/browser/performance_manager/mechanisms/working_set_trimmer.h"
 #include "chrome/browser/performance_manager/policies/page_discarding_helper.h"
+#include "chrome/browser/performance_manager/policies/policy_features.h"
 #include "components/performance_manager/public/decorators/tab_page_decorator.h"
 #include "components/performance_manager/public/features.h"
+#include "components/performance_manager/public/graph/frame_node.h"
+#include "components/performance_manager/public/graph/graph_operations.h"
+#include "components/performance_manager/public/graph/process_node.h"
 #include "components/performance_manager/public/user_tuning/prefs.h"
 #include "components/performance_manager/public/user_tuning/tab_revisit_tracker.h"
 
@@ -17,9 +23,23 @@ namespace performance_manager::policies {
 namespace {
 MemorySaverModePolicy* g_memory_saver_mode_policy = nullptr;
 using user_tuning::prefs::MemorySaverModeAggressiveness;
+
+// Returns true if all the frames hosted in |process_node| belong to pages that
+// aren't visible, so that reclaiming its memory doesn't slow down a visible
+// page.
+bool HostsOnlyNonVisiblePages(const ProcessNode* process_node) {
+  for (const FrameNode* frame_node : process_node->GetFrameNodes()) {
+    if (frame_node->GetPageNode()->IsVisible()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
-MemorySaverModePolicy::MemorySaverModePolicy() {
+MemorySaverModePolicy::MemorySaverModePolicy()
+    : working_set_trimmer_(mechanism::WorkingSetTrimmer::GetInstance()) {
   DCHECK(!g_memory_saver_mode_policy);
   g_memory_saver_mode_policy = this;
 }
@@ -46,6 +66,7 @@ void MemorySaverModePolicy::OnIsVisibleChanged(const PageNode* page_node) {
   // gracefully.
   if (page_node->IsVisible()) {
     RemoveActiveTimer(tab_handle);
+    compressed_tabs_.erase(tab_handle);
   } else {
     StartDiscardTimerIfEnabled(tab_handle,
                                GetTimeBeforeDiscardForCurrentMode());
@@ -68,6 +89,7 @@ void MemorySaverModePolicy::OnTabAdded(
 void MemorySaverModePolicy::OnBeforeTabRemoved(
     TabPageDecorator::TabHandle* tab_handle) {
   RemoveActiveTimer(tab_handle);
+  compressed_tabs_.erase(tab_handle);
 }
 
 void MemorySaverModePolicy::OnPassedToGraph(Graph* graph) {
@@ -82,7 +104,8 @@ void MemorySaverModePolicy::OnTakenFromGraph(Graph* graph) {
   // otherwise there's no guarantee PageNode pointers are still valid when
   // timers fire. To avoid possibly having callbacks manipulate invalid PageNode
   // pointers, clear all the existing timers before unregistering the observer.
-  active_discard_timers_.clear();
+  RemoveAllActiveTimers();
+  compressed_tabs_.clear();
 
   // Decorator destruction ordered is not defined, so only unregister from
   // `TabPageDecorator` if it's still present.
@@ -101,7 +124,7 @@ void MemorySaverModePolicy::OnMemorySaverModeChanged(bool enabled) {
     DCHECK(active_discard_timers_.empty());
     StartAllDiscardTimers();
   } else {
-    active_discard_timers_.clear();
+    RemoveAllActiveTimers();
   }
 }
 
@@ -112,7 +135,7 @@ base::TimeDelta MemorySaverModePolicy::GetTimeBeforeDiscardForTesting() const {
 void MemorySaverModePolicy::SetMode(MemorySaverModeAggressiveness mode) {
   mode_ = mode;
   if (high_efficiency_mode_enabled_) {
-    active_discard_timers_.clear();
+    RemoveAllActiveTimers();
     StartAllDiscardTimers();
   }
 }
@@ -121,6 +144,17 @@ bool MemorySaverModePolicy::IsMemorySaverDiscardingEnabled() const {
   return high_efficiency_mode_enabled_;
 }
 
+void MemorySaverModePolicy::SetWorkingSetTrimmerForTesting(
+    mechanism::WorkingSetTrimmer* working_set_trimmer) {
+  working_set_trimmer_ = working_set_trimmer;
+}
+
+bool MemorySaverModePolicy::IsTabCompressedForTesting(
+    const PageNode* page_node) const {
+  return base::Contains(compressed_tabs_,
+                        TabPageDecorator::FromPageNode(page_node));
+}
+
 void MemorySaverModePolicy::StartAllDiscardTimers() {
   for (const PageNode* page_node : graph_->GetAllPageNodes()) {
     TabPageDecorator::TabHandle* tab_handle =
@@ -160,14 +194,70 @@ void MemorySaverModePolicy::StartDiscardTimerIfEnabled(
         base::BindOnce(&MemorySaverModePolicy::DiscardPageTimerCallback,
                        base::Unretained(this), tab_handle,
                        base::LiveTicks::Now(), time_before_discard));
+
+    StartCompressTimerIfEnabled(tab_handle, time_before_discard);
   }
 }
 
 void MemorySaverModePolicy::RemoveActiveTimer(
     const TabPageDecorator::TabHandle* tab_handle) {
-  // If there's a discard timer already running for this page, erase it from the
-  // map which will stop the timer when it is destroyed.
+  // If there's a discard or compress timer already running for this page, erase
+  // it from the map which will stop the timer when it is destroyed.
   active_discard_timers_.erase(tab_handle);
+  active_compress_timers_.erase(tab_handle);
+}
+
+void MemorySaverModePolicy::RemoveAllActiveTimers() {
+  active_discard_timers_.clear();
+  active_compress_timers_.clear();
+}
+
+void MemorySaverModePolicy::StartCompressTimerIfEnabled(
+    const TabPageDecorator::TabHandle* tab_handle,
+    base::TimeDelta time_before_discard) {
+  if (!base::FeatureList::IsEnabled(
+          features::kMemorySaverCompressTabsBeforeDiscard) ||
+      !working_set_trimmer_->PlatformSupportsWorkingSetTrim() ||
+      base::Contains(compressed_tabs_, tab_handle)) {
+    return;
+  }
+
+  // Compressing the tab is only worth it if it happens long enough before the
+  // discard for the tab to have a chance of being activated in between.
+  const base::TimeDelta time_before_compress =
+      features::kMemorySaverTimeBeforeCompress.Get();
+  if (time_before_compress >= time_before_discard) {
+    return;
+  }
+
+  active_compress_timers_[tab_handle].Start(
+      FROM_HERE, time_before_compress,
+      base::BindOnce(&MemorySaverModePolicy::CompressPageTimerCallback,
+                     base::Unretained(this), tab_handle));
+}
+
+void MemorySaverModePolicy::CompressPageTimerCallback(
+    const TabPageDecorator::TabHandle* tab_handle) {
+  // As with discards, the `tab_handle` is guaranteed to still be valid here.
+  active_compress_timers_.erase(tab_handle);
+
+  // Only compress the tabs that could be discarded, the others are protected
+  // for a reason (e.g. they're playing audio) that compressing them could get
+  // in the way of.
+  const PageNode* page_node = tab_handle->page_node();
+  if (PageDiscardingHelper::GetFromGraph(graph_)->CanDiscard(
+          page_node, PageDiscardingHelper::DiscardReason::PROACTIVE) !=
+      PageDiscardingHelper::CanDiscardResult::kEligible) {
+    return;
+  }
+
+  for (const ProcessNode* process_node :
+       GraphOperations::GetAssociatedProcessNodes(page_node)) {
+    if (HostsOnlyNonVisiblePages(process_node)) {
+      working_set_trimmer_->TrimWorkingSet(process_node);
+    }
+  }
+  compressed_tabs_.insert(tab_handle);
 }
 
 void MemorySaverModePolicy::DiscardPageTimerCallback(
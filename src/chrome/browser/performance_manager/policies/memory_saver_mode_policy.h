@@ -7,6 +7,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 
 #include "base/timer/timer.h"
 #include "components/performance_manager/public/decorators/tab_page_decorator.h"
@@ -14,11 +15,20 @@
 #include "components/performance_manager/public/graph/page_node.h"
 #include "components/performance_manager/public/user_tuning/prefs.h"
 
+namespace performance_manager::mechanism {
+class WorkingSetTrimmer;
+}  // namespace performance_manager::mechanism
+
 namespace performance_manager::policies {
 
 // This policy is responsible for discarding tabs after they have been
 // backgrounded for a certain amount of time, when Memory Saver Mode is
 // enabled by the user.
+//
+// With kMemorySaverCompressTabsBeforeDiscard, tabs go through an intermediate
+// compressed state before they are discarded: the memory of their renderers is
+// reclaimed into compressed memory or swap, which is cheaper to bring back
+// than a reload if the tab is activated again.
 class MemorySaverModePolicy : public GraphOwned,
                                  public PageNode::ObserverDefaultImpl,
                                  public TabPageObserverDefaultImpl {
@@ -47,11 +57,20 @@ class MemorySaverModePolicy : public GraphOwned,
   // get the state of the mode from the Performance Manager sequence.
   bool IsMemorySaverDiscardingEnabled() const;
 
+  void SetWorkingSetTrimmerForTesting(
+      mechanism::WorkingSetTrimmer* working_set_trimmer);
+  bool IsTabCompressedForTesting(const PageNode* page_node) const;
+
  private:
   void StartAllDiscardTimers();
   void StartDiscardTimerIfEnabled(const TabPageDecorator::TabHandle* tab_handle,
                                   base::TimeDelta time_before_discard);
   void RemoveActiveTimer(const TabPageDecorator::TabHandle* tab_handle);
+  void RemoveAllActiveTimers();
+  void StartCompressTimerIfEnabled(
+      const TabPageDecorator::TabHandle* tab_handle,
+      base::TimeDelta time_before_discard);
+  void CompressPageTimerCallback(const TabPageDecorator::TabHandle* tab_handle);
   void DiscardPageTimerCallback(const TabPageDecorator::TabHandle* tab_handle,
                                 base::LiveTicks posted_at,
                                 base::TimeDelta requested_time_before_discard);
@@ -63,6 +82,13 @@ class MemorySaverModePolicy : public GraphOwned,
 
   std::map<const TabPageDecorator::TabHandle*, base::OneShotTimer>
       active_discard_timers_;
+  std::map<const TabPageDecorator::TabHandle*, base::OneShotTimer>
+      active_compress_timers_;
+
+  // The tabs whose renderers were compressed since they were last visible.
+  std::set<const TabPageDecorator::TabHandle*> compressed_tabs_;
+
+  raw_ptr<mechanism::WorkingSetTrimmer> working_set_trimmer_;
   user_tuning::prefs::MemorySaverModeAggressiveness mode_ =
       user_tuning::prefs::MemorySaverModeAggressiveness::kMedium;
 
@@ -4,9 +4,13 @@
 
 #include "chrome/browser/performance_manager/policies/memory_saver_mode_policy.h"
 
+#include <vector>
+
 #include "base/test/scoped_feature_list.h"
 #include "base/test/task_environment.h"
 #include "base/time/time.h"
+#include "chrome/browser/performance_manager/mechanisms/working_set_trimmer.h"
+#include "chrome/browser/performance_manager/policies/policy_features.h"
 #include "chrome/browser/performance_manager/test_support/page_discarding_utils.h"
 #include "components/performance_manager/public/decorators/tab_connectedness_decorator.h"
 #include "components/performance_manager/public/decorators/tab_page_decorator.h"
@@ -14,6 +18,7 @@
 #include "components/performance_manager/public/user_tuning/prefs.h"
 #include "components/performance_manager/public/user_tuning/tab_revisit_tracker.h"
 #include "components/prefs/testing_pref_service.h"
+#include "testing/gmock/include/gmock/gmock.h"
 
 namespace performance_manager::policies {
 
@@ -23,6 +28,25 @@ namespace {
 constexpr base::TimeDelta AGGRESSIVE_TIMEOUT = base::Hours(2);
 constexpr base::TimeDelta MEDIUM_TIMEOUT = base::Hours(4);
 constexpr base::TimeDelta CONSERVATIVE_TIMEOUT = base::Hours(6);
+
+class FakeWorkingSetTrimmer : public mechanism::WorkingSetTrimmer {
+ public:
+  FakeWorkingSetTrimmer() = default;
+  ~FakeWorkingSetTrimmer() override = default;
+
+  // mechanism::WorkingSetTrimmer:
+  bool PlatformSupportsWorkingSetTrim() override { return true; }
+  void TrimWorkingSet(const ProcessNode* process_node) override {
+    trimmed_processes_.push_back(process_node);
+  }
+
+  const std::vector<const ProcessNode*>& trimmed_processes() const {
+    return trimmed_processes_;
+  }
+
+ private:
+  std::vector<const ProcessNode*> trimmed_processes_;
+};
 }  // namespace
 
 class TestTabRevisitTracker : public TabRevisitTracker {
@@ -100,6 +124,9 @@ class MemorySaverModeTest : public testing::GraphTestHarnessWithMockDiscarder {
 
   TestTabRevisitTracker* tab_revisit_tracker() { return tab_revisit_tracker_; }
 
+  // Outlives the policy, which is destroyed in TearDown().
+  FakeWorkingSetTrimmer working_set_trimmer_;
+
  private:
   raw_ptr<MemorySaverModePolicy, DanglingUntriaged> policy_;
 
@@ -342,4 +369,64 @@ TEST_F(MemorySaverModeTest, DontDiscardIfAboveMaxNumRevisits) {
   ::testing::Mock::VerifyAndClearExpectations(discarder());
 }
 
+TEST_F(MemorySaverModeTest, CompressBeforeDiscard) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(
+      features::kMemorySaverCompressTabsBeforeDiscard);
+  policy()->SetWorkingSetTrimmerForTesting(&working_set_trimmer_);
+
+  page_node()->SetType(PageType::kTab);
+  page_node()->SetIsVisible(true);
+  policy()->OnMemorySaverModeChanged(true);
+  page_node()->SetIsVisible(false);
+
+  const base::TimeDelta time_before_compress =
+      features::kMemorySaverTimeBeforeCompress.Get();
+  task_env().FastForwardBy(time_before_compress);
+  EXPECT_TRUE(policy()->IsTabCompressedForTesting(page_node()));
+  EXPECT_THAT(working_set_trimmer_.trimmed_processes(),
+              ::testing::ElementsAre(process_node()));
+
+  // The tab is still discarded once it has been in background long enough.
+  EXPECT_CALL(*discarder(), DiscardPageNodeImpl(page_node()))
+      .WillOnce(::testing::Return(true));
+  task_env().FastForwardBy(policy()->GetTimeBeforeDiscardForTesting() -
+                           time_before_compress);
+  ::testing::Mock::VerifyAndClearExpectations(discarder());
+}
+
+TEST_F(MemorySaverModeTest, NoCompressIfVisibleAgain) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(
+      features::kMemorySaverCompressTabsBeforeDiscard);
+  policy()->SetWorkingSetTrimmerForTesting(&working_set_trimmer_);
+
+  page_node()->SetType(PageType::kTab);
+  page_node()->SetIsVisible(true);
+  policy()->OnMemorySaverModeChanged(true);
+  page_node()->SetIsVisible(false);
+
+  task_env().FastForwardBy(features::kMemorySaverTimeBeforeCompress.Get() / 2);
+  page_node()->SetIsVisible(true);
+  task_env().FastForwardBy(policy()->GetTimeBeforeDiscardForTesting());
+  EXPECT_FALSE(policy()->IsTabCompressedForTesting(page_node()));
+  EXPECT_TRUE(working_set_trimmer_.trimmed_processes().empty());
+  ::testing::Mock::VerifyAndClearExpectations(discarder());
+}
+
+TEST_F(MemorySaverModeTest, NoCompressIfFeatureDisabled) {
+  policy()->SetWorkingSetTrimmerForTesting(&working_set_trimmer_);
+
+  page_node()->SetType(PageType::kTab);
+  page_node()->SetIsVisible(true);
+  policy()->OnMemorySaverModeChanged(true);
+
+  EXPECT_CALL(*discarder(), DiscardPageNodeImpl(page_node()))
+      .WillOnce(::testing::Return(true));
+  page_node()->SetIsVisible(false);
+  task_env().FastForwardBy(policy()->GetTimeBeforeDiscardForTesting());
+  ::testing::Mock::VerifyAndClearExpectations(discarder());
+  EXPECT_TRUE(working_set_trimmer_.trimmed_processes().empty());
+}
+
 }  // namespace performance_manager::policies
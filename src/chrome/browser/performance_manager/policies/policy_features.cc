@@ -17,6 +17,62 @@
 namespace performance_manager {
 namespace features {
 
+BASE_FEATURE(kPredictiveTabDiscarding,
+             "PredictiveTabDiscarding",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+const base::FeatureParam<double> kPredictiveDiscardingThreshold = {
+    &kPredictiveTabDiscarding, "Threshold", 0.2};
+
+const base::FeatureParam<int> kPredictiveDiscardingMaxTabsPerRound = {
+    &kPredictiveTabDiscarding, "MaxTabsPerRound", 2};
+
+const base::FeatureParam<base::TimeDelta>
+    kPredictiveDiscardingMinRoundInterval = {&kPredictiveTabDiscarding,
+                                             "MinRoundInterval",
+                                             base::Minutes(1)};
+
+const base::FeatureParam<double> kPredictiveDiscardingBias = {
+    &kPredictiveTabDiscarding, "Bias", 1.0};
+
+const base::FeatureParam<double> kPredictiveDiscardingBackgroundTimeWeight = {
+    &kPredictiveTabDiscarding, "BackgroundTimeWeight", -0.8};
+
+const base::FeatureParam<double> kPredictiveDiscardingRevisitsWeight = {
+    &kPredictiveTabDiscarding, "RevisitsWeight", 0.9};
+
+const base::FeatureParam<double> kPredictiveDiscardingActiveTimeWeight = {
+    &kPredictiveTabDiscarding, "ActiveTimeWeight", 0.3};
+
+BASE_FEATURE(kMemorySaverCompressTabsBeforeDiscard,
+             "MemorySaverCompressTabsBeforeDiscard",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+const base::FeatureParam<base::TimeDelta> kMemorySaverTimeBeforeCompress = {
+    &kMemorySaverCompressTabsBeforeDiscard, "TimeBeforeCompress",
+    base::Minutes(30)};
+
+BASE_FEATURE(kBackgroundTabLoadingDynamicConcurrency,
+             "BackgroundTabLoadingDynamicConcurrency",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+const base::FeatureParam<int> kBackgroundTabLoadingMaxSimultaneousLoads = {
+    &kBackgroundTabLoadingDynamicConcurrency, "MaxSimultaneousLoads", 8};
+
+const base::FeatureParam<int> kBackgroundTabLoadingKbpsPerLoad = {
+    &kBackgroundTabLoadingDynamicConcurrency, "KbpsPerLoad", 2000};
+
+const base::FeatureParam<int> kBackgroundTabLoadingMemoryMbPerLoad = {
+    &kBackgroundTabLoadingDynamicConcurrency, "MemoryMbPerLoad", 250};
+
+const base::FeatureParam<double> kBackgroundTabLoadingHighCpuUtilization = {
+    &kBackgroundTabLoadingDynamicConcurrency, "HighCpuUtilization", 0.8};
+
+const base::FeatureParam<base::TimeDelta>
+    kBackgroundTabLoadingCpuSampleInterval = {
+        &kBackgroundTabLoadingDynamicConcurrency, "CpuSampleInterval",
+        base::Seconds(1)};
+
 #if BUILDFLAG(IS_CHROMEOS_ASH)
 
 BASE_FEATURE(kTrimOnMemoryPressure,
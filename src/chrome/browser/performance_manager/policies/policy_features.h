@@ -19,6 +19,65 @@
 namespace performance_manager {
 namespace features {
 
+// Discards the background tabs that are predicted to be unlikely to be
+// activated again soon under moderate memory pressure, before it becomes
+// critical.
+BASE_DECLARE_FEATURE(kPredictiveTabDiscarding);
+
+// Tabs whose predicted reactivation probability is below this threshold can be
+// discarded by kPredictiveTabDiscarding.
+extern const base::FeatureParam<double> kPredictiveDiscardingThreshold;
+
+// The maximum number of tabs discarded each time kPredictiveTabDiscarding
+// runs, and the minimum time between two runs while the pressure lasts.
+extern const base::FeatureParam<int> kPredictiveDiscardingMaxTabsPerRound;
+extern const base::FeatureParam<base::TimeDelta>
+    kPredictiveDiscardingMinRoundInterval;
+
+// The weights of the logistic model that predicts whether a tab is activated
+// again soon: a bias, and the weights of the log of one plus the minutes in
+// background, of one plus the number of revisits, and of one plus the minutes
+// active.
+extern const base::FeatureParam<double> kPredictiveDiscardingBias;
+extern const base::FeatureParam<double>
+    kPredictiveDiscardingBackgroundTimeWeight;
+extern const base::FeatureParam<double> kPredictiveDiscardingRevisitsWeight;
+extern const base::FeatureParam<double> kPredictiveDiscardingActiveTimeWeight;
+
+// Memory Saver Mode reclaims the memory of background tabs into compressed
+// memory or swap some time before it discards them. Unlike a discard, this
+// doesn't cost a reload if the tab is activated again.
+BASE_DECLARE_FEATURE(kMemorySaverCompressTabsBeforeDiscard);
+
+// How long a tab stays in background before it is compressed by
+// kMemorySaverCompressTabsBeforeDiscard. Tabs are only compressed if this is
+// shorter than the time before they are discarded.
+extern const base::FeatureParam<base::TimeDelta> kMemorySaverTimeBeforeCompress;
+
+// Background tab loading during session restore adapts the number of tabs
+// loaded simultaneously to the network throughput, free memory and CPU load,
+// and loads the tabs on sites with the most user engagement first.
+BASE_DECLARE_FEATURE(kBackgroundTabLoadingDynamicConcurrency);
+
+// The maximum number of tabs loaded simultaneously by
+// kBackgroundTabLoadingDynamicConcurrency on machines with enough cores.
+extern const base::FeatureParam<int> kBackgroundTabLoadingMaxSimultaneousLoads;
+
+// The downstream throughput, in kbps, and the free memory, in MiB, that each
+// simultaneous tab load needs.
+extern const base::FeatureParam<int> kBackgroundTabLoadingKbpsPerLoad;
+extern const base::FeatureParam<int> kBackgroundTabLoadingMemoryMbPerLoad;
+
+// The system CPU utilization, in [0, 1], above which a single tab is loaded at
+// a time.
+extern const base::FeatureParam<double>
+    kBackgroundTabLoadingHighCpuUtilization;
+
+// How often the system CPU utilization is sampled while restored tabs are
+// loading.
+extern const base::FeatureParam<base::TimeDelta>
+    kBackgroundTabLoadingCpuSampleInterval;
+
 #if BUILDFLAG(IS_CHROMEOS_ASH)
 
 // The trim on Memory Pressure feature will trim a process nodes working set
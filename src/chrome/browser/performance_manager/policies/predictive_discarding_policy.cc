@@ -0,0 +1,233 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/performance_manager/policies/predictive_discarding_policy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "base/containers/contains.h"
+#include "base/feature_list.h"
+#include "base/functional/bind.h"
+#include "base/metrics/histogram_functions.h"
+#include "chrome/browser/performance_manager/policies/page_discarding_helper.h"
+#include "chrome/browser/performance_manager/policies/policy_features.h"
+#include "components/performance_manager/public/decorators/tab_page_decorator.h"
+#include "components/performance_manager/public/user_tuning/tab_revisit_tracker.h"
+
+namespace performance_manager::policies {
+
+namespace {
+
+using MemoryPressureLevel = base::MemoryPressureListener::MemoryPressureLevel;
+
+double Log1p(base::TimeDelta time) {
+  return std::log1p(std::max(time.InMinutesF(), 0.0));
+}
+
+}  // namespace
+
+PredictiveDiscardingPolicy::PredictiveDiscardingPolicy() = default;
+PredictiveDiscardingPolicy::~PredictiveDiscardingPolicy() = default;
+
+// static
+double PredictiveDiscardingPolicy::PredictReactivationProbability(
+    const TabFeatures& features) {
+  const double logit =
+      features::kPredictiveDiscardingBias.Get() +
+      features::kPredictiveDiscardingBackgroundTimeWeight.Get() *
+          Log1p(features.time_in_background) +
+      features::kPredictiveDiscardingRevisitsWeight.Get() *
+          std::log1p(static_cast<double>(std::max<int64_t>(
+              features.num_revisits, 0))) +
+      features::kPredictiveDiscardingActiveTimeWeight.Get() *
+          Log1p(features.total_time_active);
+  return 1.0 / (1.0 + std::exp(-logit));
+}
+
+void PredictiveDiscardingPolicy::OnPassedToGraph(Graph* graph) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  graph_ = graph;
+  graph->AddSystemNodeObserver(this);
+  graph->AddPageNodeObserver(this);
+  graph->GetRegisteredObjectAs<TabPageDecorator>()->AddObserver(this);
+  DCHECK(PageDiscardingHelper::GetFromGraph(graph_))
+      << "A PageDiscardingHelper instance should be registered against the "
+         "graph in order to use this policy.";
+}
+
+void PredictiveDiscardingPolicy::OnTakenFromGraph(Graph* graph) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  pending_discards_.clear();
+  discarded_tabs_.clear();
+
+  // Decorator destruction order is not defined, so only unregister from
+  // `TabPageDecorator` if it's still present.
+  auto* tab_page_decorator = graph->GetRegisteredObjectAs<TabPageDecorator>();
+  if (tab_page_decorator) {
+    tab_page_decorator->RemoveObserver(this);
+  }
+  graph->RemovePageNodeObserver(this);
+  graph->RemoveSystemNodeObserver(this);
+  graph_ = nullptr;
+}
+
+void PredictiveDiscardingPolicy::OnMemoryPressure(
+    MemoryPressureLevel new_level) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  switch (new_level) {
+    case MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_NONE:
+      if (discarded_since_no_pressure_) {
+        // If the pressure didn't become critical after the discards, they
+        // likely spared the user from urgent discards and renderer kills.
+        base::UmaHistogramBoolean(
+            "Discarding.Predictive.ReachedCriticalPressureAfterDiscards",
+            critical_since_no_pressure_);
+      }
+      discarded_since_no_pressure_ = false;
+      critical_since_no_pressure_ = false;
+      return;
+    case MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      // Critical pressure is handled by UrgentPageDiscardingPolicy.
+      critical_since_no_pressure_ = true;
+      return;
+    case MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_MODERATE:
+      break;
+  }
+
+  // The feature state is checked here instead of at policy creation time so
+  // that only clients that experience memory pressure are enrolled in the
+  // experiment.
+  if (!base::FeatureList::IsEnabled(features::kPredictiveTabDiscarding)) {
+    return;
+  }
+
+  // The Memory Pressure Monitor sends notifications at regular interval while
+  // the pressure lasts, space out the discards to give them time to relieve
+  // it.
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (!pending_discards_.empty() ||
+      (!last_discard_round_time_.is_null() &&
+       now - last_discard_round_time_ <
+           features::kPredictiveDiscardingMinRoundInterval.Get())) {
+    return;
+  }
+  last_discard_round_time_ = now;
+
+  DiscardTabsUnlikelyToBeReactivated();
+}
+
+void PredictiveDiscardingPolicy::OnIsVisibleChanged(const PageNode* page_node) {
+  if (!page_node->IsVisible()) {
+    return;
+  }
+  TabPageDecorator::TabHandle* tab_handle =
+      TabPageDecorator::FromPageNode(page_node);
+  if (!tab_handle) {
+    return;
+  }
+  auto it = discarded_tabs_.find(tab_handle);
+  if (it == discarded_tabs_.end()) {
+    return;
+  }
+
+  // The discard cost a reload. The sooner it happens, the less memory the
+  // discard saved for it.
+  base::UmaHistogramEnumeration("Discarding.Predictive.DiscardOutcome",
+                                DiscardOutcome::kReactivated);
+  base::UmaHistogramCustomTimes(
+      "Discarding.Predictive.TimeToReactivation",
+      base::TimeTicks::Now() - it->second, base::Seconds(1), base::Hours(48),
+      100);
+  discarded_tabs_.erase(it);
+}
+
+void PredictiveDiscardingPolicy::OnBeforeTabRemoved(
+    TabPageDecorator::TabHandle* tab_handle) {
+  pending_discards_.erase(tab_handle);
+  if (discarded_tabs_.erase(tab_handle)) {
+    base::UmaHistogramEnumeration("Discarding.Predictive.DiscardOutcome",
+                                  DiscardOutcome::kClosed);
+  }
+}
+
+void PredictiveDiscardingPolicy::DiscardTabsUnlikelyToBeReactivated() {
+  PageDiscardingHelper* helper = PageDiscardingHelper::GetFromGraph(graph_);
+  const double threshold = features::kPredictiveDiscardingThreshold.Get();
+
+  std::vector<std::pair<double, const TabPageDecorator::TabHandle*>>
+      candidates;
+  for (const PageNode* page_node : graph_->GetAllPageNodes()) {
+    const TabPageDecorator::TabHandle* tab_handle =
+        TabPageDecorator::FromPageNode(page_node);
+    if (!tab_handle || base::Contains(discarded_tabs_, tab_handle) ||
+        helper->CanDiscard(page_node,
+                           PageDiscardingHelper::DiscardReason::PROACTIVE) !=
+            PageDiscardingHelper::CanDiscardResult::kEligible) {
+      continue;
+    }
+    const double probability =
+        PredictReactivationProbability(GetTabFeatures(tab_handle));
+    if (probability < threshold) {
+      candidates.emplace_back(probability, tab_handle);
+    }
+  }
+
+  const size_t max_discards = static_cast<size_t>(
+      std::max(features::kPredictiveDiscardingMaxTabsPerRound.Get(), 0));
+  if (candidates.size() > max_discards) {
+    std::partial_sort(candidates.begin(), candidates.begin() + max_discards,
+                      candidates.end());
+    candidates.resize(max_discards);
+  }
+
+  base::UmaHistogramCounts100("Discarding.Predictive.TabsDiscardedPerRound",
+                              candidates.size());
+  if (candidates.empty()) {
+    return;
+  }
+  discarded_since_no_pressure_ = true;
+
+  for (const auto& [probability, tab_handle] : candidates) {
+    pending_discards_.insert(tab_handle);
+    helper->ImmediatelyDiscardMultiplePages(
+        {tab_handle->page_node()},
+        PageDiscardingHelper::DiscardReason::PROACTIVE,
+        base::BindOnce(&PredictiveDiscardingPolicy::OnDiscardAttempted,
+                       weak_factory_.GetWeakPtr(), tab_handle));
+  }
+}
+
+PredictiveDiscardingPolicy::TabFeatures
+PredictiveDiscardingPolicy::GetTabFeatures(
+    const TabPageDecorator::TabHandle* tab_handle) const {
+  TabRevisitTracker* revisit_tracker =
+      graph_->GetRegisteredObjectAs<TabRevisitTracker>();
+  CHECK(revisit_tracker);
+  TabRevisitTracker::StateBundle state =
+      revisit_tracker->GetStateForTabHandle(tab_handle);
+
+  TabFeatures features;
+  features.time_in_background =
+      state.last_active_time
+          ? base::TimeTicks::Now() - state.last_active_time.value()
+          : tab_handle->page_node()->GetTimeSinceLastVisibilityChange();
+  features.num_revisits = state.num_revisits;
+  features.total_time_active = state.total_time_active;
+  return features;
+}
+
+void PredictiveDiscardingPolicy::OnDiscardAttempted(
+    const TabPageDecorator::TabHandle* tab_handle,
+    bool success) {
+  // The tab may have been closed while it was being discarded.
+  if (pending_discards_.erase(tab_handle) && success) {
+    discarded_tabs_[tab_handle] = base::TimeTicks::Now();
+  }
+}
+
+}  // namespace performance_manager::policies
@@ -0,0 +1,121 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CHROME_BROWSER_PERFORMANCE_MANAGER_POLICIES_PREDICTIVE_DISCARDING_POLICY_H_
+#define CHROME_BROWSER_PERFORMANCE_MANAGER_POLICIES_PREDICTIVE_DISCARDING_POLICY_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <set>
+
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "components/performance_manager/public/decorators/tab_page_decorator.h"
+#include "components/performance_manager/public/graph/graph.h"
+#include "components/performance_manager/public/graph/page_node.h"
+#include "components/performance_manager/public/graph/system_node.h"
+
+namespace performance_manager::policies {
+
+// Discards the background tabs that are the least likely to be activated again
+// soon when the system reaches moderate memory pressure, so that memory is
+// freed before the pressure becomes critical and tabs are discarded urgently
+// or renderers are killed.
+//
+// The probability that a tab is activated again soon is predicted from the
+// revisit history kept by TabRevisitTracker, with a logistic model whose
+// weights are field trial params so that they can be trained offline.
+class PredictiveDiscardingPolicy : public GraphOwned,
+                                   public SystemNode::ObserverDefaultImpl,
+                                   public PageNode::ObserverDefaultImpl,
+                                   public TabPageObserverDefaultImpl {
+ public:
+  // The signals about a tab that the model uses.
+  struct TabFeatures {
+    // Time since the tab was last active.
+    base::TimeDelta time_in_background;
+    // Number of times the tab was activated after it was first backgrounded.
+    int64_t num_revisits = 0;
+    // Total time the tab was active.
+    base::TimeDelta total_time_active;
+  };
+
+  // Outcome of a discard made by this policy. These values are persisted to
+  // logs. Entries should not be renumbered and numeric values should never be
+  // reused.
+  enum class DiscardOutcome {
+    // The tab was activated again, and had to be reloaded.
+    kReactivated = 0,
+    // The tab was closed without being activated again.
+    kClosed = 1,
+    kMaxValue = kClosed,
+  };
+
+  PredictiveDiscardingPolicy();
+  ~PredictiveDiscardingPolicy() override;
+  PredictiveDiscardingPolicy(const PredictiveDiscardingPolicy& other) = delete;
+  PredictiveDiscardingPolicy& operator=(const PredictiveDiscardingPolicy&) =
+      delete;
+
+  // Returns the predicted probability, in [0, 1], that a tab with `features`
+  // is activated again soon.
+  static double PredictReactivationProbability(const TabFeatures& features);
+
+  // GraphOwned:
+  void OnPassedToGraph(Graph* graph) override;
+  void OnTakenFromGraph(Graph* graph) override;
+
+ private:
+  // SystemNode::ObserverDefaultImpl:
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel new_level) override;
+
+  // PageNode::ObserverDefaultImpl:
+  void OnIsVisibleChanged(const PageNode* page_node) override;
+
+  // TabPageObserverDefaultImpl:
+  void OnBeforeTabRemoved(TabPageDecorator::TabHandle* tab_handle) override;
+
+  // Discards the eligible background tabs whose predicted reactivation
+  // probability is below the threshold, starting with the least likely one.
+  void DiscardTabsUnlikelyToBeReactivated();
+
+  TabFeatures GetTabFeatures(
+      const TabPageDecorator::TabHandle* tab_handle) const;
+
+  // Called when the discard of `tab_handle` has been attempted.
+  void OnDiscardAttempted(const TabPageDecorator::TabHandle* tab_handle,
+                          bool success);
+
+  // The tabs that this policy is discarding.
+  std::set<const TabPageDecorator::TabHandle*> pending_discards_;
+
+  // The tabs discarded by this policy that weren't activated or closed since,
+  // with the time of their discard.
+  std::map<const TabPageDecorator::TabHandle*, base::TimeTicks> discarded_tabs_;
+
+  // The time of the last round of discards, to space them out while the
+  // pressure lasts.
+  base::TimeTicks last_discard_round_time_;
+
+  // Whether tabs were discarded since the pressure was last back to none, and
+  // whether the pressure became critical since then. These tell whether the
+  // discards kept the system out of critical pressure.
+  bool discarded_since_no_pressure_ = false;
+  bool critical_since_no_pressure_ = false;
+
+  raw_ptr<Graph> graph_ = nullptr;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<PredictiveDiscardingPolicy> weak_factory_{this};
+};
+
+}  // namespace performance_manager::policies
+
+#endif  // CHROME_BROWSER_PERFORMANCE_MANAGER_POLICIES_PREDICTIVE_DISCARDING_POLICY_H_
@@ -0,0 +1,185 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/performance_manager/policies/predictive_discarding_policy.h"
+
+#include <map>
+#include <memory>
+
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/raw_ptr.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/time/time.h"
+#include "chrome/browser/performance_manager/policies/policy_features.h"
+#include "chrome/browser/performance_manager/test_support/page_discarding_utils.h"
+#include "components/performance_manager/public/decorators/tab_connectedness_decorator.h"
+#include "components/performance_manager/public/decorators/tab_page_decorator.h"
+#include "components/performance_manager/public/user_tuning/tab_revisit_tracker.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace performance_manager::policies {
+
+namespace {
+
+using MemoryPressureLevel = base::MemoryPressureListener::MemoryPressureLevel;
+using TabFeatures = PredictiveDiscardingPolicy::TabFeatures;
+
+class FakeTabRevisitTracker : public TabRevisitTracker {
+ public:
+  void SetStateBundle(const TabPageDecorator::TabHandle* tab_handle,
+                      StateBundle bundle) {
+    state_bundles_[tab_handle] = bundle;
+  }
+
+ private:
+  StateBundle GetStateForTabHandle(
+      const TabPageDecorator::TabHandle* tab_handle) override {
+    auto it = state_bundles_.find(tab_handle);
+    if (it != state_bundles_.end()) {
+      return it->second;
+    }
+    return {};
+  }
+
+  std::map<const TabPageDecorator::TabHandle*, TabRevisitTracker::StateBundle>
+      state_bundles_;
+};
+
+}  // namespace
+
+class PredictiveDiscardingPolicyTest
+    : public testing::GraphTestHarnessWithMockDiscarder {
+ public:
+  void SetUp() override {
+    feature_list_.InitAndEnableFeature(features::kPredictiveTabDiscarding);
+    testing::GraphTestHarnessWithMockDiscarder::SetUp();
+
+    graph()->PassToGraph(std::make_unique<TabPageDecorator>());
+    graph()->PassToGraph(std::make_unique<TabConnectednessDecorator>());
+    auto tab_revisit_tracker = std::make_unique<FakeTabRevisitTracker>();
+    tab_revisit_tracker_ = tab_revisit_tracker.get();
+    graph()->PassToGraph(std::move(tab_revisit_tracker));
+
+    auto policy = std::make_unique<PredictiveDiscardingPolicy>();
+    policy_ = policy.get();
+    graph()->PassToGraph(std::move(policy));
+
+    page_node()->SetType(PageType::kTab);
+  }
+
+  void TearDown() override {
+    graph()->TakeFromGraph(policy_);
+    testing::GraphTestHarnessWithMockDiscarder::TearDown();
+  }
+
+ protected:
+  // Makes the page look like a tab that was last active `time_in_background`
+  // ago and was revisited `num_revisits` times.
+  void SetTabHistory(base::TimeDelta time_in_background, int64_t num_revisits) {
+    TabRevisitTracker::StateBundle state;
+    state.state = TabRevisitTracker::State::kBackground;
+    state.last_active_time = base::TimeTicks::Now() - time_in_background;
+    state.num_revisits = num_revisits;
+    state.total_time_active = base::Minutes(1);
+    tab_revisit_tracker_->SetStateBundle(
+        TabPageDecorator::FromPageNode(page_node()), state);
+  }
+
+  void SendMemoryPressure(MemoryPressureLevel level) {
+    system_node()->OnMemoryPressureForTesting(level);
+    task_env().RunUntilIdle();
+  }
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+  raw_ptr<FakeTabRevisitTracker, DanglingUntriaged> tab_revisit_tracker_;
+  raw_ptr<PredictiveDiscardingPolicy, DanglingUntriaged> policy_;
+};
+
+TEST_F(PredictiveDiscardingPolicyTest, PredictReactivationProbability) {
+  TabFeatures recent{.time_in_background = base::Minutes(5),
+                     .num_revisits = 2,
+                     .total_time_active = base::Minutes(10)};
+  TabFeatures old = recent;
+  old.time_in_background = base::Hours(5);
+  TabFeatures revisited = old;
+  revisited.num_revisits = 30;
+
+  const double recent_probability =
+      PredictiveDiscardingPolicy::PredictReactivationProbability(recent);
+  const double old_probability =
+      PredictiveDiscardingPolicy::PredictReactivationProbability(old);
+  const double revisited_probability =
+      PredictiveDiscardingPolicy::PredictReactivationProbability(revisited);
+  EXPECT_GT(recent_probability, old_probability);
+  EXPECT_GT(revisited_probability, old_probability);
+  EXPECT_GE(old_probability, 0.0);
+  EXPECT_LE(recent_probability, 1.0);
+}
+
+TEST_F(PredictiveDiscardingPolicyTest, DiscardUnlikelyTabOnModeratePressure) {
+  base::HistogramTester histogram_tester;
+  SetTabHistory(base::Hours(5), /*num_revisits=*/0);
+
+  EXPECT_CALL(*discarder(), DiscardPageNodeImpl(page_node()))
+      .WillOnce(::testing::Return(true));
+  SendMemoryPressure(MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_MODERATE);
+  ::testing::Mock::VerifyAndClearExpectations(discarder());
+  histogram_tester.ExpectUniqueSample(
+      "Discarding.Predictive.TabsDiscardedPerRound", 1, 1);
+
+  // The pressure goes away without becoming critical.
+  SendMemoryPressure(MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_NONE);
+  histogram_tester.ExpectUniqueSample(
+      "Discarding.Predictive.ReachedCriticalPressureAfterDiscards", false, 1);
+
+  // Activating the tab again costs a reload.
+  task_env().FastForwardBy(base::Minutes(3));
+  page_node()->SetIsVisible(true);
+  histogram_tester.ExpectUniqueSample(
+      "Discarding.Predictive.DiscardOutcome",
+      PredictiveDiscardingPolicy::DiscardOutcome::kReactivated, 1);
+  histogram_tester.ExpectUniqueTimeSample(
+      "Discarding.Predictive.TimeToReactivation", base::Minutes(3), 1);
+}
+
+TEST_F(PredictiveDiscardingPolicyTest, KeepTabLikelyToBeReactivated) {
+  SetTabHistory(base::Minutes(1), /*num_revisits=*/50);
+
+  // The mock discarder fails the test if the tab is discarded.
+  SendMemoryPressure(MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_MODERATE);
+  ::testing::Mock::VerifyAndClearExpectations(discarder());
+}
+
+TEST_F(PredictiveDiscardingPolicyTest, NoDiscardOnCriticalPressure) {
+  SetTabHistory(base::Hours(5), /*num_revisits=*/0);
+
+  // Critical pressure is left to UrgentPageDiscardingPolicy.
+  SendMemoryPressure(MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  ::testing::Mock::VerifyAndClearExpectations(discarder());
+}
+
+TEST_F(PredictiveDiscardingPolicyTest, SpaceOutDiscardRounds) {
+  SetTabHistory(base::Hours(5), /*num_revisits=*/0);
+
+  EXPECT_CALL(*discarder(), DiscardPageNodeImpl(page_node()))
+      .WillOnce(::testing::Return(false));
+  SendMemoryPressure(MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_MODERATE);
+  ::testing::Mock::VerifyAndClearExpectations(discarder());
+
+  // The next notification comes too soon after the first round.
+  PageDiscardingHelper::RemovesDiscardAttemptMarkerForTesting(page_node());
+  SendMemoryPressure(MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_MODERATE);
+  ::testing::Mock::VerifyAndClearExpectations(discarder());
+
+  task_env().FastForwardBy(
+      features::kPredictiveDiscardingMinRoundInterval.Get());
+  EXPECT_CALL(*discarder(), DiscardPageNodeImpl(page_node()))
+      .WillOnce(::testing::Return(true));
+  SendMemoryPressure(MemoryPressureLevel::MEMORY_PRESSURE_LEVEL_MODERATE);
+  ::testing::Mock::VerifyAndClearExpectations(discarder());
+}
+
+}  // namespace performance_manager::policies
@@ -783,6 +783,37 @@ std::vector<GURL> PredictFetchedSubresourceUrls(const LcppStat& stat) {
   return subresource_urls;
 }
 
+std::vector<GURL> PredictConfidentSubresourceUrls(const LcppStat& stat,
+                                                  double min_confidence,
+                                                  size_t max_count) {
+  const LcppStringFrequencyStatData& data = stat.fetched_subresource_url_stat();
+  double total_frequency = data.other_bucket_frequency();
+  for (const auto& [subresource_url, frequency] : data.main_buckets()) {
+    total_frequency += frequency;
+  }
+  std::vector<GURL> subresource_urls;
+  if (total_frequency <= 0 || max_count == 0) {
+    return subresource_urls;
+  }
+
+  for (const auto& [frequency, subresource_url] :
+       ConvertToFrequencyStringPair(data)) {
+    // The frequencies are reverse sorted by `ConvertToFrequencyStringPair`.
+    if (frequency / total_frequency < min_confidence) {
+      break;
+    }
+    GURL parsed_url(subresource_url);
+    if (!parsed_url.is_valid() || !parsed_url.SchemeIsHTTPOrHTTPS()) {
+      continue;
+    }
+    subresource_urls.push_back(std::move(parsed_url));
+    if (subresource_urls.size() >= max_count) {
+      break;
+    }
+  }
+  return subresource_urls;
+}
+
 std::vector<GURL> PredictUnusedPreloads(const LcppStat& stat) {
   const double frequency_threshold =
       blink::features::kLCPPDeferUnusedPreloadFrequencyThreshold.Get();
@@ -5,6 +5,8 @@
 #ifndef CHROME_BROWSER_PREDICTORS_LCP_CRITICAL_PATH_PREDICTOR_LCP_CRITICAL_PATH_PREDICTOR_UTIL_H_
 #define CHROME_BROWSER_PREDICTORS_LCP_CRITICAL_PATH_PREDICTOR_LCP_CRITICAL_PATH_PREDICTOR_UTIL_H_
 
+#include <stddef.h>
+
 #include <optional>
 
 #include "chrome/browser/predictors/loading_predictor_config.h"
@@ -49,6 +51,14 @@ std::vector<GURL> PredictPreconnectableOrigins(const LcppStat& stat);
 // vector.
 std::vector<GURL> PredictFetchedSubresourceUrls(const LcppStat& stat);
 
+// Returns at most `max_count` subresource URLs from past loads for a given
+// `stat` whose confidence, i.e. the share of the recorded frequency that they
+// hold, is at least `min_confidence`. The returned URLs are ordered by
+// descending frequency.
+std::vector<GURL> PredictConfidentSubresourceUrls(const LcppStat& stat,
+                                                  double min_confidence,
+                                                  size_t max_count);
+
 // Returns possible unused preload URLs from past loads for a given `stat`.
 // The returned URLs are ordered by descending frequency (the most
 // frequent one comes first). If there is no data, it returns an empty
@@ -666,6 +666,42 @@ TEST(PredictFetchedSubresourceUrls, FilterUrls) {
             PredictFetchedSubresourceUrls(lcpp_stat));
 }
 
+TEST(PredictConfidentSubresourceUrls, Empty) {
+  EXPECT_EQ(std::vector<GURL>(), PredictConfidentSubresourceUrls({}, 0.5, 10));
+}
+
+TEST(PredictConfidentSubresourceUrls, Threshold) {
+  LcppStat lcpp_stat;
+  auto* data = lcpp_stat.mutable_fetched_subresource_url_stat();
+  auto* buckets = data->mutable_main_buckets();
+  buckets->insert({"https://example.com/a.js", 8});
+  buckets->insert({"https://example.com/b.css", 6});
+  buckets->insert({"https://example.com/c.jpeg", 4});
+  // Not an URL.
+  buckets->insert({"d.js", 7});
+  data->set_other_bucket_frequency(5);
+  // The confidences are a: 8/30, d: 7/30, b: 6/30 and c: 4/30.
+  EXPECT_EQ(std::vector<GURL>({GURL("https://example.com/a.js"),
+                               GURL("https://example.com/b.css")}),
+            PredictConfidentSubresourceUrls(lcpp_stat, 0.2, 10));
+  EXPECT_EQ(std::vector<GURL>(),
+            PredictConfidentSubresourceUrls(lcpp_stat, 0.3, 10));
+}
+
+TEST(PredictConfidentSubresourceUrls, MaxCount) {
+  LcppStat lcpp_stat;
+  auto* buckets =
+      lcpp_stat.mutable_fetched_subresource_url_stat()->mutable_main_buckets();
+  buckets->insert({"https://example.com/a.js", 3});
+  buckets->insert({"https://example.com/b.js", 2});
+  buckets->insert({"https://example.com/c.js", 1});
+  EXPECT_EQ(std::vector<GURL>({GURL("https://example.com/a.js"),
+                               GURL("https://example.com/b.js")}),
+            PredictConfidentSubresourceUrls(lcpp_stat, 0.0, 2));
+  EXPECT_EQ(std::vector<GURL>(),
+            PredictConfidentSubresourceUrls(lcpp_stat, 0.0, 0));
+}
+
 TEST(PredictPreconnectableOrigins, Empty) {
   base::test::ScopedFeatureList feature_list;
   feature_list.InitWithFeaturesAndParameters(
@@ -5,9 +5,11 @@
 #include "chrome/browser/predictors/loading_predictor.h"
 
 #include <algorithm>
+#include <set>
 #include <vector>
 
 #include "base/metrics/histogram_functions.h"
+#include "base/numerics/safe_conversions.h"
 #include "build/build_config.h"
 #include "chrome/browser/after_startup_task_utils.h"
 #include "chrome/browser/predictors/lcp_critical_path_predictor/lcp_critical_path_predictor_util.h"
@@ -261,6 +263,45 @@ bool LoadingPredictor::PrepareForPageLoad(
     }
   }
 
+  // Prefetch the subresources that past loads of the page fetched with a high
+  // enough confidence. The type of the subresources isn't learned, so they are
+  // only prefetched when all types are allowed.
+  if (base::FeatureList::IsEnabled(
+          features::kLoadingPredictorPrefetchLearnedSubresources) &&
+      base::FeatureList::IsEnabled(features::kLoadingPredictorPrefetch) &&
+      features::kLoadingPredictorPrefetchSubresourceType.Get() ==
+          features::PrefetchSubresourceType::kAll) {
+    std::optional<LcppStat> lcpp_stat =
+        resource_prefetch_predictor()->GetLcppStat(url);
+    if (lcpp_stat) {
+      auto network_anonymization_key =
+          net::NetworkAnonymizationKey::CreateSameSite(
+              net::SchemefulSite(url::Origin::Create(url)));
+      std::set<GURL> already_prefetched;
+      for (const PrefetchRequest& request : prediction.prefetch_requests) {
+        already_prefetched.insert(request.url);
+      }
+      const double min_confidence =
+          features::kLoadingPredictorPrefetchLearnedSubresourcesMinConfidence
+              .Get();
+      const size_t max_count = base::saturated_cast<size_t>(
+          features::kLoadingPredictorPrefetchLearnedSubresourcesMaxCount.Get());
+      size_t count = 0;
+      for (const GURL& subresource_url : PredictConfidentSubresourceUrls(
+               *lcpp_stat, min_confidence, max_count)) {
+        if (!already_prefetched.insert(subresource_url).second) {
+          continue;
+        }
+        prediction.prefetch_requests.emplace_back(
+            subresource_url, network_anonymization_key,
+            network::mojom::RequestDestination::kEmpty);
+        ++count;
+      }
+      base::UmaHistogramCounts100(
+          "LoadingPredictor.LearnedSubresourcePrefetchCount", count);
+    }
+  }
+
   // Return early if we do not have any requests.
   if (prediction.requests.empty() && prediction.prefetch_requests.empty())
     return false;
@@ -272,6 +313,50 @@ bool LoadingPredictor::PrepareForPageLoad(
   return has_local_preconnect_prediction || preconnect_prediction;
 }
 
+void LoadingPredictor::PrepareForSessionRestore(
+    const std::vector<GURL>& urls) {
+  if (shutdown_ || !IsPreconnectAllowed(profile_)) {
+    return;
+  }
+
+  const size_t max_preconnects = base::saturated_cast<size_t>(
+      features::kLoadingPredictorSessionRestoreWarmUpMaxPreconnects.Get());
+  const size_t max_preresolves = base::saturated_cast<size_t>(
+      features::kLoadingPredictorSessionRestoreWarmUpMaxPreresolves.Get());
+  size_t preconnect_count = 0;
+  size_t preresolve_count = 0;
+  std::set<url::Origin> warmed_up_origins;
+  for (const GURL& url : urls) {
+    if (preconnect_count >= max_preconnects &&
+        preresolve_count >= max_preresolves) {
+      break;
+    }
+    if (!url.is_valid() || !url.SchemeIsHTTPOrHTTPS()) {
+      continue;
+    }
+    // Tabs of the same origin share the warmed up connections.
+    const url::Origin origin = url::Origin::Create(url);
+    if (!warmed_up_origins.insert(origin).second) {
+      continue;
+    }
+    if (preconnect_count < max_preconnects) {
+      // The hint stays active until the restored navigation starts, so that
+      // the navigation doesn't preconnect to the same origins again.
+      PrepareForPageLoad(url, HintOrigin::SESSION_RESTORE);
+      ++preconnect_count;
+    } else if (preresolve_count < max_preresolves) {
+      preconnect_manager()->StartPreresolveHost(
+          url, net::NetworkAnonymizationKey::CreateSameSite(
+                   net::SchemefulSite(origin)));
+      ++preresolve_count;
+    }
+  }
+  base::UmaHistogramCounts100("LoadingPredictor.SessionRestore.PreconnectCount",
+                              preconnect_count);
+  base::UmaHistogramCounts100("LoadingPredictor.SessionRestore.PreresolveCount",
+                              preresolve_count);
+}
+
 void LoadingPredictor::CancelPageLoadHint(const GURL& url) {
   if (shutdown_)
     return;
@@ -66,6 +66,12 @@ class LoadingPredictor : public KeyedService,
       bool preconnectable = false,
       std::optional<PreconnectPrediction> preconnect_prediction = std::nullopt);
 
+  // Warms up connections for tabs restored from the previous session, before
+  // their navigations start. |urls| are in the order the tabs will be loaded.
+  // The first distinct origins get the same preconnects as a navigation to
+  // them would, the following ones only have their hosts preresolved.
+  void PrepareForSessionRestore(const std::vector<GURL>& urls);
+
   // Indicates that a page load hint is no longer active.
   void CancelPageLoadHint(const GURL& url);
 
@@ -50,6 +50,9 @@ enum class HintOrigin {
 
   // Triggered by New Tab Page.
   NEW_TAB_PAGE,
+
+  // Triggered by session restore, before the restored tabs start loading.
+  SESSION_RESTORE,
 };
 
 // Gets the string that can be used to record histograms for the hint origin.
@@ -4,9 +4,11 @@
 
 #include "chrome/browser/predictors/loading_predictor_factory.h"
 
+#include "base/feature_list.h"
 #include "chrome/browser/history/history_service_factory.h"
 #include "chrome/browser/predictors/loading_predictor.h"
 #include "chrome/browser/predictors/predictor_database_factory.h"
+#include "chrome/browser/predictors/predictors_features.h"
 #include "chrome/browser/profiles/profile.h"
 
 namespace predictors {
@@ -46,7 +48,20 @@ LoadingPredictorFactory::BuildServiceInstanceForBrowserContext(
   if (!IsLoadingPredictorEnabled(profile))
     return nullptr;
 
-  return std::make_unique<LoadingPredictor>(LoadingPredictorConfig(), profile);
+  auto loading_predictor =
+      std::make_unique<LoadingPredictor>(LoadingPredictorConfig(), profile);
+  // Start reading the predictor database right away, so that the predictions
+  // are available by the time the first navigation starts.
+  if (base::FeatureList::IsEnabled(
+          features::kLoadingPredictorEagerInitialization)) {
+    loading_predictor->StartInitialization();
+  }
+  return loading_predictor;
+}
+
+bool LoadingPredictorFactory::ServiceIsCreatedWithBrowserContext() const {
+  return base::FeatureList::IsEnabled(
+      features::kLoadingPredictorEagerInitialization);
 }
 
 }  // namespace predictors
@@ -28,7 +28,9 @@
 #include "components/optimization_guide/proto/hints.pb.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/navigation_handle_timing.h"
 #include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/restore_type.h"
 #include "services/metrics/public/cpp/ukm_source_id.h"
 #include "services/network/public/mojom/fetch_api.mojom.h"
 #include "third_party/blink/public/common/features.h"
@@ -106,6 +108,20 @@ bool IsHandledNavigation(content::NavigationHandle* navigation_handle) {
          navigation_handle->GetURL().SchemeIsHTTPOrHTTPS();
 }
 
+// Records how long the loads of tabs restored from the previous session wait
+// for their first response, which warming up their connections shortens.
+void RecordRestoredNavigationTimeToFirstByte(
+    content::NavigationHandle* navigation_handle) {
+  const base::TimeTicks first_response_start_time =
+      navigation_handle->GetNavigationHandleTiming().first_response_start_time;
+  if (first_response_start_time.is_null())
+    return;
+
+  base::UmaHistogramTimes(
+      "LoadingPredictor.SessionRestore.NavigationStartToFirstResponseStart",
+      first_response_start_time - navigation_handle->NavigationStart());
+}
+
 network::mojom::RequestDestination GetDestination(
     optimization_guide::proto::ResourceType type) {
   switch (type) {
@@ -445,6 +461,10 @@ void LoadingPredictorTabHelper::DidFinishNavigation(
   if (!navigation_handle->HasCommitted())
     return;
   page_data->has_committed_ = true;
+  if (navigation_handle->GetRestoreType() == content::RestoreType::kRestored &&
+      !navigation_handle->IsErrorPage()) {
+    RecordRestoredNavigationTimeToFirstByte(navigation_handle);
+  }
   PageData::TransferFromNavigationHandleToDocument(
       *navigation_handle, *navigation_handle->GetRenderFrameHost());
 }
@@ -12,7 +12,9 @@
 
 #include "base/memory/raw_ptr.h"
 #include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_feature_list.h"
 #include "chrome/browser/predictors/loading_test_util.h"
+#include "chrome/browser/predictors/predictors_features.h"
 #include "chrome/browser/preloading/preloading_prefs.h"
 #include "chrome/common/pref_names.h"
 #include "chrome/test/base/testing_profile.h"
@@ -628,4 +630,33 @@ TEST_F(LoadingPredictorPreconnectTest,
                                              preconnect_data));
 }
 
+// Checks that session restore preconnects to the first restored origins and
+// only preresolves the following ones.
+TEST_F(LoadingPredictorPreconnectTest, TestPrepareForSessionRestore) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeatureWithParameters(
+      features::kLoadingPredictorSessionRestoreWarmUp,
+      {{"max_preconnects", "1"}, {"max_preresolves", "1"}});
+  base::HistogramTester histogram_tester;
+  const GURL preconnect_url(kUrl);
+  const GURL preresolve_url("https://www.example.com/");
+  EXPECT_CALL(*mock_preconnect_manager_, StartProxy(preconnect_url, _));
+  EXPECT_CALL(*mock_preconnect_manager_,
+              StartPreresolveHost(
+                  preresolve_url,
+                  CreateNetworkanonymization_key(preresolve_url)));
+
+  // kUrl2 has the same origin as kUrl, kUrl3 can't be preconnected to and the
+  // last URL is over the limits.
+  predictor_->PrepareForSessionRestore({preconnect_url, GURL(kUrl2),
+                                        GURL(kUrl3), preresolve_url,
+                                        GURL("https://www.chromium.org/")});
+  EXPECT_EQ(1u, predictor_->active_hints_for_testing().size());
+  EXPECT_TRUE(predictor_->active_hints_for_testing().contains(preconnect_url));
+  histogram_tester.ExpectUniqueSample(
+      "LoadingPredictor.SessionRestore.PreconnectCount", 1, 1);
+  histogram_tester.ExpectUniqueSample(
+      "LoadingPredictor.SessionRestore.PreresolveCount", 1, 1);
+}
+
 }  // namespace predictors
@@ -134,6 +134,16 @@ void ReportPreconnectAccuracy(
     UMA_HISTOGRAM_PERCENTAGE(
         internal::kLoadingPredictorPreconnectHitsPercentage,
         preconnect_hits_percentage);
+    // The hits percentage is the precision of the issued preconnects, this is
+    // their recall: the share of the origins used by the page that were
+    // preconnected to.
+    if (!requests.empty()) {
+      size_t preconnect_recall_percentage =
+          (100 * preconnect_hits_count) / requests.size();
+      UMA_HISTOGRAM_PERCENTAGE(
+          internal::kLoadingPredictorPreconnectRecallPercentage,
+          preconnect_recall_percentage);
+    }
   }
 
   UMA_HISTOGRAM_PERCENTAGE(internal::kLoadingPredictorPreresolveHitsPercentage,
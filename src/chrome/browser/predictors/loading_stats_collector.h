@@ -38,6 +38,8 @@ constexpr char kLoadingPredictorPreresolveHitsPercentage[] =
     "LoadingPredictor.PreresolveHitsPercentage";
 constexpr char kLoadingPredictorPreconnectHitsPercentage[] =
     "LoadingPredictor.PreconnectHitsPercentage";
+constexpr char kLoadingPredictorPreconnectRecallPercentage[] =
+    "LoadingPredictor.PreconnectRecallPercentage";
 constexpr char kLoadingPredictorPreresolveCount[] =
     "LoadingPredictor.PreresolveCount";
 constexpr char kLoadingPredictorPreconnectCount[] =
@@ -608,6 +608,9 @@ TEST_F(LoadingStatsCollectorTest, TestPreconnectHistograms) {
       internal::kLoadingPredictorPreresolveHitsPercentage, 50, 1);
   histogram_tester_->ExpectUniqueSample(
       internal::kLoadingPredictorPreconnectHitsPercentage, 50, 1);
+  // One of the four origins used by the page was preconnected to.
+  histogram_tester_->ExpectUniqueSample(
+      internal::kLoadingPredictorPreconnectRecallPercentage, 25, 1);
   histogram_tester_->ExpectUniqueSample(
       internal::kLoadingPredictorPreresolveCount, 4, 1);
   histogram_tester_->ExpectUniqueSample(
@@ -700,6 +703,8 @@ TEST_F(LoadingStatsCollectorTest, TestPreconnectHistogramsPreresolvesOnly) {
   // Can't really report a hits percentage if there were no events.
   histogram_tester_->ExpectTotalCount(
       internal::kLoadingPredictorPreconnectHitsPercentage, 0);
+  histogram_tester_->ExpectTotalCount(
+      internal::kLoadingPredictorPreconnectRecallPercentage, 0);
   histogram_tester_->ExpectUniqueSample(
       internal::kLoadingPredictorPreresolveCount, 4, 1);
   histogram_tester_->ExpectUniqueSample(
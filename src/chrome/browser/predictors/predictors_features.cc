@@ -81,6 +81,42 @@ const base::FeatureParam<PrefetchSubresourceType>
         &kLoadingPredictorPrefetch, "subresource_type",
         PrefetchSubresourceType::kAll, &kPrefetchSubresourceTypeParamOptions};
 
+// Modifies loading predictor so that it also prefetches the subresources that
+// past loads of the page fetched most of the time, as learned locally.
+BASE_FEATURE(kLoadingPredictorPrefetchLearnedSubresources,
+             "LoadingPredictorPrefetchLearnedSubresources",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+const base::FeatureParam<double>
+    kLoadingPredictorPrefetchLearnedSubresourcesMinConfidence{
+        &kLoadingPredictorPrefetchLearnedSubresources, "min_confidence", 0.7};
+
+const base::FeatureParam<int>
+    kLoadingPredictorPrefetchLearnedSubresourcesMaxCount{
+        &kLoadingPredictorPrefetchLearnedSubresources, "max_count", 10};
+
+// Loads the predictor database when the profile is created instead of on the
+// first navigation, so that the first navigations after startup already have
+// predictions.
+BASE_FEATURE(kLoadingPredictorEagerInitialization,
+             "LoadingPredictorEagerInitialization",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+// Preconnects to the origins the tabs restored from the previous session are
+// predicted to use, in the order the tabs are loaded, instead of waiting for
+// each restored navigation to start.
+BASE_FEATURE(kLoadingPredictorSessionRestoreWarmUp,
+             "LoadingPredictorSessionRestoreWarmUp",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+const base::FeatureParam<int>
+    kLoadingPredictorSessionRestoreWarmUpMaxPreconnects{
+        &kLoadingPredictorSessionRestoreWarmUp, "max_preconnects", 4};
+
+const base::FeatureParam<int>
+    kLoadingPredictorSessionRestoreWarmUpMaxPreresolves{
+        &kLoadingPredictorSessionRestoreWarmUp, "max_preresolves", 16};
+
 BASE_FEATURE(kLoadingPredictorInflightPredictiveActions,
              "kLoadingPredictorInflightPredictiveActions",
              base::FEATURE_ENABLED_BY_DEFAULT);
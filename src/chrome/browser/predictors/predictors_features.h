@@ -36,6 +36,31 @@ BASE_DECLARE_FEATURE(kLoadingPredictorInflightPredictiveActions);
 
 BASE_DECLARE_FEATURE(kLoadingPredictorPrefetchUseReadAndDiscardBody);
 
+BASE_DECLARE_FEATURE(kLoadingPredictorPrefetchLearnedSubresources);
+
+// The minimum share of past loads of a page that fetched a subresource for the
+// subresource to be prefetched.
+extern const base::FeatureParam<double>
+    kLoadingPredictorPrefetchLearnedSubresourcesMinConfidence;
+
+// The maximum number of learned subresources prefetched for a navigation.
+extern const base::FeatureParam<int>
+    kLoadingPredictorPrefetchLearnedSubresourcesMaxCount;
+
+BASE_DECLARE_FEATURE(kLoadingPredictorEagerInitialization);
+
+BASE_DECLARE_FEATURE(kLoadingPredictorSessionRestoreWarmUp);
+
+// The maximum number of restored tabs whose predicted origins are preconnected
+// before their navigations start.
+extern const base::FeatureParam<int>
+    kLoadingPredictorSessionRestoreWarmUpMaxPreconnects;
+
+// The maximum number of further restored tabs whose hosts are only
+// preresolved.
+extern const base::FeatureParam<int>
+    kLoadingPredictorSessionRestoreWarmUpMaxPreresolves;
+
 // Returns whether local predictions should be used to make preconnect
 // predictions.
 bool ShouldUseLocalPredictions();
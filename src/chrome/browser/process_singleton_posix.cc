@@ -59,6 +59,7 @@
 #include "base/base_paths.h"
 #include "base/command_line.h"
 #include "base/containers/unique_ptr_adapters.h"
+#include "base/feature_list.h"
 #include "base/files/file_descriptor_watcher_posix.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
@@ -86,6 +87,7 @@
 #include "base/timer/timer.h"
 #include "build/build_config.h"
 #include "build/chromeos_buildflags.h"
+#include "chrome/browser/browser_features.h"
 #include "chrome/browser/process_singleton_internal.h"
 #include "chrome/common/chrome_constants.h"
 #include "chrome/common/process_singleton_lock_posix.h"
@@ -500,6 +502,19 @@ bool ReplaceOldSingletonLock(const base::FilePath& symlink_content,
 }
 #endif  // BUILDFLAG(IS_MAC)
 
+// Returns the task runner that messages from other processes are handled on.
+// Must be called on the UI thread.
+scoped_refptr<base::SingleThreadTaskRunner> GetMessageTaskRunner() {
+  // A message is the user asking to open something, so don't queue it behind
+  // the startup work already posted to the UI thread.
+  if (base::FeatureList::IsEnabled(
+          features::kProcessSingletonPriorityHandoff) &&
+      BrowserThread::CurrentlyOn(BrowserThread::UI)) {
+    return content::GetUIThreadTaskRunner({base::TaskPriority::USER_BLOCKING});
+  }
+  return base::SingleThreadTaskRunner::GetCurrentDefault();
+}
+
 }  // namespace
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -520,7 +535,8 @@ class ProcessSingleton::LinuxWatcher
         : parent_(parent),
           ui_task_runner_(ui_task_runner),
           fd_(fd),
-          bytes_read_(0) {
+          bytes_read_(0),
+          accept_time_(base::TimeTicks::Now()) {
       DCHECK_CURRENTLY_ON(BrowserThread::IO);
       // Wait for reads.
       fd_watch_controller_ = base::FileDescriptorWatcher::WatchReadable(
@@ -570,13 +586,15 @@ class ProcessSingleton::LinuxWatcher
     // reads.
     size_t bytes_read_;
 
+    // When the connection was accepted.
+    const base::TimeTicks accept_time_;
+
     base::OneShotTimer timer_;
   };
 
   // We expect to only be constructed on the UI thread.
   explicit LinuxWatcher(ProcessSingleton* parent)
-      : ui_task_runner_(base::SingleThreadTaskRunner::GetCurrentDefault()),
-        parent_(parent) {}
+      : ui_task_runner_(GetMessageTaskRunner()), parent_(parent) {}
 
   LinuxWatcher(const LinuxWatcher&) = delete;
   LinuxWatcher& operator=(const LinuxWatcher&) = delete;
@@ -587,9 +605,11 @@ class ProcessSingleton::LinuxWatcher
 
   // This method determines if we should use the same process and if we should,
   // opens a new browser tab.  This runs on the UI thread.
-  // |reader| is for sending back ACK message.
+  // |reader| is for sending back ACK message. |accept_time| is when the
+  // connection the message was read from was accepted.
   void HandleMessage(const std::string& current_dir,
                      const std::vector<std::string>& argv,
+                     base::TimeTicks accept_time,
                      SocketReader* reader);
 
   // Called when the ProcessSingleton that owns this class is about to be
@@ -650,12 +670,18 @@ void ProcessSingleton::LinuxWatcher::StartListening(int socket) {
 
 void ProcessSingleton::LinuxWatcher::HandleMessage(
     const std::string& current_dir, const std::vector<std::string>& argv,
+    base::TimeTicks accept_time,
     SocketReader* reader) {
   DCHECK(ui_task_runner_->BelongsToCurrentThread());
   DCHECK(reader);
+  UMA_HISTOGRAM_MEDIUM_TIMES("Chrome.ProcessSingleton.MessageQueueTime",
+                             base::TimeTicks::Now() - accept_time);
 
   if (parent_ && parent_->notification_callback_.Run(
                      base::CommandLine(argv), base::FilePath(current_dir))) {
+    // The notification callback has started any navigations by now.
+    UMA_HISTOGRAM_MEDIUM_TIMES("Chrome.ProcessSingleton.TimeToHandleMessage",
+                               base::TimeTicks::Now() - accept_time);
     // Send back "ACK" message to prevent the client process from starting up.
     reader->FinishWithACK(kACKToken, std::size(kACKToken) - 1);
   } else {
@@ -736,7 +762,8 @@ void ProcessSingleton::LinuxWatcher::SocketReader::
   // Return to the UI thread to handle opening a new browser tab.
   ui_task_runner_->PostTask(
       FROM_HERE, base::BindOnce(&ProcessSingleton::LinuxWatcher::HandleMessage,
-                                parent_, current_dir, tokens, this));
+                                parent_, current_dir, tokens, accept_time_,
+                                this));
   fd_watch_controller_.reset();
 
   // LinuxWatcher::HandleMessage() is in charge of destroying this SocketReader
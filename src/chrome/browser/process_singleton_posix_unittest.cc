@@ -283,6 +283,19 @@ TEST_F(ProcessSingletonPosixTest, NotifyOtherProcessSuccess) {
   CheckNotified();
 }
 
+// Test that the time taken to hand off the command line is recorded before
+// the ACK is sent back.
+TEST_F(ProcessSingletonPosixTest, NotifyOtherProcessRecordsHandoffTime) {
+  base::HistogramTester histogram_tester;
+  CreateProcessSingletonOnThread();
+  EXPECT_EQ(ProcessSingleton::PROCESS_NOTIFIED, NotifyOtherProcess(true));
+  CheckNotified();
+  histogram_tester.ExpectTotalCount("Chrome.ProcessSingleton.MessageQueueTime",
+                                    1);
+  histogram_tester.ExpectTotalCount(
+      "Chrome.ProcessSingleton.TimeToHandleMessage", 1);
+}
+
 // Test failure case of NotifyOtherProcess().
 TEST_F(ProcessSingletonPosixTest, NotifyOtherProcessFailure) {
   base::HistogramTester histogram_tester;
@@ -54,6 +54,7 @@ using base::ASCIIToUTF16;
 using base::Time;
 using SiteSearchPolicyConflictType =
     TemplateURLService::SiteSearchPolicyConflictType;
+using testing::ElementsAre;
 using testing::NotNull;
 
 namespace {
@@ -1262,6 +1263,56 @@ TEST_P(TemplateURLServiceTest, RepairSearchEnginesWithManagedDefault) {
   ExpectSimilar(expected_managed_default.get(), actual_managed_default);
 }
 
+TEST_P(TemplateURLServiceTest, AddMatchingKeywords) {
+  test_util()->VerifyLoad();
+  TemplateURL* ab = AddKeywordWithDate("name1", "ab", "http://ab/{searchTerms}",
+                                       std::string(), std::string(),
+                                       std::string(), true, "UTF-8");
+  TemplateURL* abc = AddKeywordWithDate("name2", "abc", "http://abc/",
+                                        std::string(), std::string(),
+                                        std::string(), true, "UTF-8");
+  AddKeywordWithDate("name3", "a", "http://a/{searchTerms}", std::string(),
+                     std::string(), std::string(), true, "UTF-8");
+  AddKeywordWithDate("name4", "b", "http://b/{searchTerms}", std::string(),
+                     std::string(), std::string(), true, "UTF-8");
+
+  TemplateURLService::TemplateURLVector matches;
+  model()->AddMatchingKeywords(u"ab", false, &matches);
+  EXPECT_THAT(matches, ElementsAre(ab, abc));
+
+  // `abc` does not support replacement.
+  matches.clear();
+  model()->AddMatchingKeywords(u"ab", true, &matches);
+  EXPECT_THAT(matches, ElementsAre(ab));
+
+  matches.clear();
+  model()->AddMatchingKeywords(u"abcd", false, &matches);
+  EXPECT_TRUE(matches.empty());
+}
+
+TEST_P(TemplateURLServiceTest, AddMatchingKeywordsBeforeLoad) {
+  // The managed default search provider is known before the keywords table
+  // is loaded.
+  std::unique_ptr<TemplateURLData> managed = CreateTestSearchEngine();
+  SetManagedDefaultSearchPreferences(*managed, true, test_util()->profile());
+  ASSERT_FALSE(model()->loaded());
+
+  TemplateURLService::TemplateURLVector matches;
+  model()->AddMatchingKeywords(u"test", true, &matches);
+  ASSERT_EQ(1u, matches.size());
+  EXPECT_EQ(u"test.com", matches[0]->keyword());
+
+  matches.clear();
+  model()->AddMatchingKeywords(u"other", true, &matches);
+  EXPECT_TRUE(matches.empty());
+
+  test_util()->VerifyLoad();
+  matches.clear();
+  model()->AddMatchingKeywords(u"test", true, &matches);
+  ASSERT_EQ(1u, matches.size());
+  EXPECT_EQ(model()->GetDefaultSearchProvider(), matches[0]);
+}
+
 // Checks that RepairPrepopulatedEngines correctly updates sync guid for default
 // search. Repair is considered a user action and new DSE must be synced to
 // other devices as well. Otherwise previous user selected engine will arrive on
@@ -6,9 +6,15 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <utility>
 
+#include "base/feature_list.h"
 #include "base/metrics/field_trial.h"
+#include "chrome/browser/predictors/loading_predictor.h"
+#include "chrome/browser/predictors/loading_predictor_factory.h"
+#include "chrome/browser/predictors/predictors_features.h"
+#include "chrome/browser/profiles/profile.h"
 #include "chrome/browser/sessions/session_restore_stats_collector.h"
 #include "chrome/browser/sessions/tab_loader.h"
 #include "chrome/common/url_constants.h"
@@ -17,6 +23,8 @@
 #include "components/performance_manager/public/graph/policies/background_tab_loading_policy.h"
 #include "components/tab_groups/tab_group_id.h"
 #include "components/tab_groups/tab_group_visual_data.h"
+#include "content/public/browser/navigation_controller.h"
+#include "content/public/browser/navigation_entry.h"
 #include "content/public/browser/web_contents.h"
 
 namespace {
@@ -40,6 +48,42 @@ bool IsInternalPage(const GURL& url) {
   return false;
 }
 
+// Starts connecting to the origins of the restored tabs, in the order they are
+// going to be loaded, so that the connections are ready when they start
+// loading.
+void WarmUpConnections(
+    const std::vector<SessionRestoreDelegate::RestoredTab>& tabs) {
+  // All the tabs of a restore belong to the same profile.
+  predictors::LoadingPredictor* loading_predictor =
+      predictors::LoadingPredictorFactory::GetForProfile(
+          Profile::FromBrowserContext(tabs[0].contents()->GetBrowserContext()));
+  if (!loading_predictor)
+    return;
+
+  // The active tabs start loading right away, TabLoader loads the others in
+  // the RestoredTab order.
+  std::vector<SessionRestoreDelegate::RestoredTab> sorted_tabs(tabs);
+  std::stable_sort(sorted_tabs.begin(), sorted_tabs.end(),
+                   [](const SessionRestoreDelegate::RestoredTab& left,
+                      const SessionRestoreDelegate::RestoredTab& right) {
+                     if (left.is_active() != right.is_active())
+                       return left.is_active();
+                     return left < right;
+                   });
+
+  std::vector<GURL> urls;
+  urls.reserve(sorted_tabs.size());
+  for (const auto& restored_tab : sorted_tabs) {
+    // The restored tabs haven't loaded yet, their URL is the one of the
+    // restored navigation entry.
+    content::NavigationEntry* entry =
+        restored_tab.contents()->GetController().GetLastCommittedEntry();
+    if (entry)
+      urls.push_back(entry->GetURL());
+  }
+  loading_predictor->PrepareForSessionRestore(urls);
+}
+
 }  // namespace
 
 SessionRestoreDelegate::RestoredTab::RestoredTab(
@@ -85,6 +129,11 @@ void SessionRestoreDelegate::RestoreTabs(
   if (tabs.empty())
     return;
 
+  if (base::FeatureList::IsEnabled(
+          predictors::features::kLoadingPredictorSessionRestoreWarmUp)) {
+    WarmUpConnections(tabs);
+  }
+
   // Restore the favicon for all tabs. Any tab may end up being deferred due
   // to memory pressure so it's best to have some visual indication of its
   // contents.
@@ -21,6 +21,7 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/synchronization/atomic_flag.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/platform_thread.h"
 #include "base/time/time.h"
 #include "build/build_config.h"
@@ -46,6 +47,7 @@
 #include "components/sessions/content/session_tab_helper.h"
 #include "components/sessions/core/serialized_navigation_entry_test_helper.h"
 #include "components/sessions/core/session_command.h"
+#include "components/sessions/core/session_service_commands.h"
 #include "components/sessions/core/session_types.h"
 #include "components/tab_groups/tab_group_color.h"
 #include "components/tab_groups/tab_group_id.h"
@@ -677,6 +679,61 @@ TEST_F(SessionServiceTest, PruneFromMiddle) {
             tab->navigations[2].virtual_url());
 }
 
+TEST_F(SessionServiceTest, DeferTabNavigationDecoding) {
+  base::test::ScopedFeatureList feature_list(
+      sessions::kDeferTabNavigationDecoding);
+  const std::string base_url("http://google.com/");
+  SessionID tab_id = SessionID::NewUnique();
+  SessionID tab2_id = SessionID::NewUnique();
+
+  helper_.PrepareTabInWindow(window_id, tab_id, 0, true);
+
+  // Add 5 navigations, with the 4th selected.
+  for (int i = 0; i < 5; ++i) {
+    SerializedNavigationEntry nav = ContentTestHelper::CreateNavigation(
+        base_url + base::NumberToString(i), "a");
+    nav.set_index(i);
+    UpdateNavigation(window_id, tab_id, nav, (i == 3));
+  }
+
+  // Replace the last navigation, and prune two navigations starting from the
+  // second.
+  SerializedNavigationEntry replacement = ContentTestHelper::CreateNavigation(
+      base_url + base::NumberToString(5), "b");
+  replacement.set_index(4);
+  UpdateNavigation(window_id, tab_id, replacement, false);
+  helper_.SetAvailableRange(tab_id, std::pair<int, int>(0, 4));
+  helper_.service()->TabNavigationPathPruned(window_id, tab_id, 1 /* index */,
+                                             2 /* count */);
+
+  // The navigations of a closed tab aren't restored.
+  helper_.PrepareTabInWindow(window_id, tab2_id, 1, false);
+  UpdateNavigation(window_id, tab2_id,
+                   ContentTestHelper::CreateNavigation(base_url, "c"), true);
+  service()->TabClosed(window_id, tab2_id);
+
+  // Read back in.
+  std::vector<std::unique_ptr<sessions::SessionWindow>> windows;
+  ReadWindows(&windows, nullptr);
+
+  ASSERT_EQ(1U, windows.size());
+  ASSERT_EQ(1U, windows[0]->tabs.size());
+
+  // The navigations are deserialized with the indices they have after the
+  // pruning.
+  sessions::SessionTab* tab = windows[0]->tabs[0].get();
+  ASSERT_EQ(1, tab->current_navigation_index);
+  ASSERT_EQ(3U, tab->navigations.size());
+  EXPECT_EQ(GURL(base_url + base::NumberToString(0)),
+            tab->navigations[0].virtual_url());
+  EXPECT_EQ(GURL(base_url + base::NumberToString(3)),
+            tab->navigations[1].virtual_url());
+  EXPECT_EQ(1, tab->navigations[1].index());
+  EXPECT_EQ(replacement.virtual_url(), tab->navigations[2].virtual_url());
+  EXPECT_EQ(replacement.title(), tab->navigations[2].title());
+  EXPECT_EQ(2, tab->navigations[2].index());
+}
+
 // Tests possible computations of available ranges.
 TEST_F(SessionServiceTest, AvailableRanges) {
   const std::string base_url("http://google.com/");
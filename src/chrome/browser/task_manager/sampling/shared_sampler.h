@@ -5,6 +5,7 @@
 #ifndef CHROME_BROWSER_TASK_MANAGER_SAMPLING_SHARED_SAMPLER_H_
 #define CHROME_BROWSER_TASK_MANAGER_SAMPLING_SHARED_SAMPLER_H_
 
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
@@ -31,7 +32,9 @@ struct ProcessDataSnapshot;
 // This exists because on Windows it is much faster to collect a group of
 // process metrics for all processes all at once using NtQuerySystemInformation
 // than to query the same data for for each process individually and because
-// some types like Idle Wakeups can only be collected this way.
+// some types like Idle Wakeups can only be collected this way. On Linux and
+// ChromeOS it reads the CPU usage of all processes in a single worker thread
+// task per refresh, instead of one task and one UI thread reply per process.
 class SharedSampler : public base::RefCountedThreadSafe<SharedSampler> {
  public:
   explicit SharedSampler(
@@ -45,6 +48,9 @@ class SharedSampler : public base::RefCountedThreadSafe<SharedSampler> {
     int64_t hard_faults_per_second;
     int idle_wakeups_per_second;
     base::Time start_time;
+    // CPU usage in percent of a single core since the previous refresh. Only
+    // set when REFRESH_TYPE_CPU is supported, and NaN on the first refresh.
+    double cpu_usage = std::numeric_limits<double>::quiet_NaN();
   };
   using OnSamplingCompleteCallback =
       base::RepeatingCallback<void(std::optional<SamplingResult>)>;
@@ -131,6 +137,39 @@ class SharedSampler : public base::RefCountedThreadSafe<SharedSampler> {
   // the refresh tasks onto serially.
   scoped_refptr<base::SequencedTaskRunner> blocking_pool_runner_;
 
+  // To assert we're running on the correct thread.
+  SEQUENCE_CHECKER(worker_pool_sequenced_checker_);
+#elif BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS)
+  // CPU time of a process at the previous refresh.
+  struct CpuSample {
+    base::TimeDelta cpu_time;
+    base::TimeTicks sample_time;
+  };
+  typedef std::map<base::ProcessId, SamplingResult> AllSamplingResults;
+
+  // Posted on the worker thread to read the stats of all of `process_ids` in
+  // one pass.
+  AllSamplingResults RefreshOnWorkerThread(
+      std::vector<base::ProcessId> process_ids);
+
+  // Called on UI thread when the refresh is done.
+  void OnRefreshDone(AllSamplingResults sampling_results);
+
+  // Accumulates callbacks passed from TaskGroup objects passed via
+  // RegisterCallbacks calls.
+  CallbacksMap callbacks_map_;
+
+  // Refresh flags passed via Refresh.
+  int64_t refresh_flags_ = 0;
+
+  // CPU time of every process sampled at the previous refresh, used to
+  // calculate the CPU usage. Only accessed on the worker thread.
+  std::map<base::ProcessId, CpuSample> previous_samples_;
+
+  // The specific blocking pool SequencedTaskRunner that will be used to post
+  // the refresh tasks onto serially.
+  scoped_refptr<base::SequencedTaskRunner> blocking_pool_runner_;
+
   // To assert we're running on the correct thread.
   SEQUENCE_CHECKER(worker_pool_sequenced_checker_);
 #endif  // BUILDFLAG(IS_WIN)
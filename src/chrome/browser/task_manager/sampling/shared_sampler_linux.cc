@@ -0,0 +1,199 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/task_manager/sampling/shared_sampler.h"
+
+#include <stdint.h>
+#include <unistd.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "chrome/browser/task_manager/task_manager_observer.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace task_manager {
+
+namespace {
+
+// Indices of the utime and stime fields of /proc/<pid>/stat, counting from the
+// state field that follows the parenthesized command name.
+constexpr size_t kUtimeIndex = 11;
+constexpr size_t kStimeIndex = 12;
+
+// Reads the CPU time used by the process `process_id` from /proc/<pid>/stat.
+// A single read gives both the user and the system time.
+std::optional<base::TimeDelta> ReadCpuTime(base::ProcessId process_id) {
+  std::string stat;
+  if (!base::ReadFileToString(
+          base::FilePath(base::StringPrintf("/proc/%d/stat", process_id)),
+          &stat)) {
+    return std::nullopt;
+  }
+
+  // The command name can contain spaces and parentheses, skip past the last
+  // closing parenthesis.
+  const size_t name_end = stat.rfind(')');
+  if (name_end == std::string::npos) {
+    return std::nullopt;
+  }
+  const std::vector<std::string_view> fields =
+      base::SplitStringPiece(std::string_view(stat).substr(name_end + 1), " ",
+                             base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
+  uint64_t utime = 0;
+  uint64_t stime = 0;
+  if (fields.size() <= kStimeIndex ||
+      !base::StringToUint64(fields[kUtimeIndex], &utime) ||
+      !base::StringToUint64(fields[kStimeIndex], &stime)) {
+    return std::nullopt;
+  }
+
+  static const long kClockTicksPerSecond = sysconf(_SC_CLK_TCK);
+  if (kClockTicksPerSecond <= 0) {
+    return std::nullopt;
+  }
+  return base::Microseconds(static_cast<int64_t>(
+      (utime + stime) * base::Time::kMicrosecondsPerSecond /
+      kClockTicksPerSecond));
+}
+
+}  // namespace
+
+SharedSampler::SharedSampler(
+    const scoped_refptr<base::SequencedTaskRunner>& blocking_pool_runner)
+    : blocking_pool_runner_(blocking_pool_runner) {
+  DCHECK(blocking_pool_runner.get());
+
+  // This object will be created on the UI thread, however the sequenced checker
+  // will be used to assert we're running the expensive operations on one of the
+  // blocking pool threads.
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DETACH_FROM_SEQUENCE(worker_pool_sequenced_checker_);
+}
+
+SharedSampler::~SharedSampler() {}
+
+int64_t SharedSampler::GetSupportedFlags() const {
+  return REFRESH_TYPE_CPU | REFRESH_TYPE_CPU_TIME;
+}
+
+void SharedSampler::RegisterCallback(
+    base::ProcessId process_id,
+    OnSamplingCompleteCallback on_sampling_complete) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  if (process_id == 0)
+    return;
+
+  bool result =
+      callbacks_map_.emplace(process_id, std::move(on_sampling_complete))
+          .second;
+  DCHECK(result);
+}
+
+void SharedSampler::UnregisterCallback(base::ProcessId process_id) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  if (process_id == 0)
+    return;
+
+  // The previous sample of the process is dropped by the next refresh.
+  callbacks_map_.erase(process_id);
+}
+
+void SharedSampler::Refresh(base::ProcessId process_id, int64_t refresh_flags) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK_NE(0, refresh_flags & GetSupportedFlags());
+
+  if (process_id == 0)
+    return;
+
+  DCHECK(callbacks_map_.find(process_id) != callbacks_map_.end());
+
+  // Every TaskGroup calls Refresh() in a refresh cycle, but all processes are
+  // sampled by the first call. See SharedSampler::Refresh() in
+  // shared_sampler_win.cc for the case where a cycle starts before the
+  // previous one is done.
+  if (refresh_flags_ == 0) {
+    std::vector<base::ProcessId> process_ids;
+    process_ids.reserve(callbacks_map_.size());
+    for (const auto& callback_entry : callbacks_map_)
+      process_ids.push_back(callback_entry.first);
+
+    blocking_pool_runner_->PostTaskAndReplyWithResult(
+        FROM_HERE,
+        base::BindOnce(&SharedSampler::RefreshOnWorkerThread, this,
+                       std::move(process_ids)),
+        base::BindOnce(&SharedSampler::OnRefreshDone, this));
+  }
+
+  refresh_flags_ |= refresh_flags;
+}
+
+SharedSampler::AllSamplingResults SharedSampler::RefreshOnWorkerThread(
+    std::vector<base::ProcessId> process_ids) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(worker_pool_sequenced_checker_);
+
+  AllSamplingResults results;
+  std::map<base::ProcessId, CpuSample> samples;
+  for (base::ProcessId process_id : process_ids) {
+    const base::TimeTicks sample_time = base::TimeTicks::Now();
+    std::optional<base::TimeDelta> cpu_time = ReadCpuTime(process_id);
+    if (!cpu_time)
+      continue;
+
+    SamplingResult& result = results[process_id];
+    result.cpu_time = cpu_time.value();
+    result.hard_faults_per_second = 0;
+    result.idle_wakeups_per_second = -1;
+
+    // Like TaskGroupSampler, report NaN until there are two samples to
+    // compare.
+    auto previous = previous_samples_.find(process_id);
+    if (previous != previous_samples_.end() &&
+        sample_time > previous->second.sample_time &&
+        cpu_time.value() >= previous->second.cpu_time) {
+      result.cpu_usage =
+          100.0 * (cpu_time.value() - previous->second.cpu_time) /
+          (sample_time - previous->second.sample_time);
+    }
+    samples[process_id] = {cpu_time.value(), sample_time};
+  }
+
+  // Only keep the processes that are still in the task manager, so that a
+  // reused pid doesn't get a usage computed from another process' sample.
+  previous_samples_ = std::move(samples);
+  return results;
+}
+
+void SharedSampler::OnRefreshDone(AllSamplingResults sampling_results) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  DCHECK_NE(0, refresh_flags_);
+
+  for (const auto& callback_entry : callbacks_map_) {
+    auto it = sampling_results.find(callback_entry.first);
+    // A TaskGroup added after the refresh was posted, or whose process exited,
+    // gets no result.
+    if (it == sampling_results.end()) {
+      callback_entry.second.Run(std::nullopt);
+    } else {
+      callback_entry.second.Run(std::move(it->second));
+    }
+  }
+
+  // Reset refresh_flags_ to trigger RefreshOnWorkerThread next time Refresh
+  // is called.
+  refresh_flags_ = 0;
+}
+
+}  // namespace task_manager
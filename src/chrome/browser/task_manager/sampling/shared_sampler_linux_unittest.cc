@@ -0,0 +1,91 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/task_manager/sampling/shared_sampler.h"
+
+#include <cmath>
+#include <optional>
+
+#include "base/functional/bind.h"
+#include "base/functional/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/process/process_handle.h"
+#include "base/run_loop.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/time/time.h"
+#include "chrome/browser/task_manager/task_manager_observer.h"
+#include "content/public/test/browser_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace task_manager {
+
+// This test class drives SharedSampler in a way similar to the real
+// implementation in TaskManagerImpl and TaskGroup.
+class SharedSamplerTest : public testing::Test {
+ public:
+  SharedSamplerTest()
+      : blocking_pool_runner_(
+            base::ThreadPool::CreateSequencedTaskRunner({base::MayBlock()})),
+        shared_sampler_(new SharedSampler(blocking_pool_runner_)) {
+    shared_sampler_->RegisterCallback(
+        base::GetCurrentProcId(),
+        base::BindRepeating(&SharedSamplerTest::OnSamplerRefreshDone,
+                            base::Unretained(this)));
+  }
+
+  SharedSamplerTest(const SharedSamplerTest&) = delete;
+  SharedSamplerTest& operator=(const SharedSamplerTest&) = delete;
+  ~SharedSamplerTest() override {}
+
+ protected:
+  const std::optional<SharedSampler::SamplingResult>& result() const {
+    return result_;
+  }
+
+  void RefreshAndWait(int64_t refresh_flags) {
+    base::RunLoop run_loop;
+    quit_closure_ = run_loop.QuitClosure();
+    shared_sampler_->Refresh(base::GetCurrentProcId(), refresh_flags);
+    run_loop.Run();
+  }
+
+ private:
+  void OnSamplerRefreshDone(
+      std::optional<SharedSampler::SamplingResult> results) {
+    result_ = std::move(results);
+    std::move(quit_closure_).Run();
+  }
+
+  base::OnceClosure quit_closure_;
+  std::optional<SharedSampler::SamplingResult> result_;
+
+  content::BrowserTaskEnvironment task_environment_;
+  scoped_refptr<base::SequencedTaskRunner> blocking_pool_runner_;
+  scoped_refptr<SharedSampler> shared_sampler_;
+};
+
+// Tests that the CPU usage of a process can be obtained from SharedSampler.
+TEST_F(SharedSamplerTest, CpuUsage) {
+  RefreshAndWait(REFRESH_TYPE_CPU | REFRESH_TYPE_CPU_TIME);
+  ASSERT_TRUE(result().has_value());
+
+  // The usage is a delta between two refreshes, so the first refresh has no
+  // value, like in TaskGroupSampler.
+  EXPECT_TRUE(std::isnan(result()->cpu_usage));
+  const base::TimeDelta first_cpu_time = result()->cpu_time;
+
+  // Burn some CPU.
+  const base::TimeTicks end = base::TimeTicks::Now() + base::Milliseconds(50);
+  while (base::TimeTicks::Now() < end) {
+  }
+
+  RefreshAndWait(REFRESH_TYPE_CPU | REFRESH_TYPE_CPU_TIME);
+  ASSERT_TRUE(result().has_value());
+  EXPECT_FALSE(std::isnan(result()->cpu_usage));
+  EXPECT_GE(result()->cpu_usage, 0.0);
+  EXPECT_GE(result()->cpu_time, first_cpu_time);
+}
+
+}  // namespace task_manager
@@ -239,7 +239,7 @@ void TaskGroup::Refresh(const gpu::VideoMemoryUsageStats& gpu_memory_stats,
 
   // 5- Refresh resources via SharedSampler if the current platform
   // implementation supports that. The actual work is done on the worker thread.
-  // At the moment this is supported only on OS_WIN.
+  // At the moment this is supported only on Windows, Linux and ChromeOS.
   if (shared_refresh_flags != 0) {
     shared_sampler_->Refresh(process_id_, shared_refresh_flags);
     refresh_flags &= ~shared_refresh_flags;
@@ -367,16 +367,25 @@ void TaskGroup::OnSamplerRefreshDone(
   // sentinel values.
   // TODO(wez): Migrate the TaskGroup fields to Optional<> so we can remove
   // the need for all this sentinel-handling logic.
+  const int64_t shared_flags = shared_sampler_->GetSupportedFlags();
   if (results) {
+    if (shared_flags & REFRESH_TYPE_CPU)
+      platform_independent_cpu_usage_ = results->cpu_usage;
     cpu_time_ = results->cpu_time;
-    idle_wakeups_per_second_ = results->idle_wakeups_per_second;
+    if (shared_flags & REFRESH_TYPE_IDLE_WAKEUPS)
+      idle_wakeups_per_second_ = results->idle_wakeups_per_second;
 #if BUILDFLAG(IS_WIN)
     hard_faults_per_second_ = results->hard_faults_per_second;
 #endif
     start_time_ = results->start_time;
   } else {
+    if (shared_flags & REFRESH_TYPE_CPU) {
+      platform_independent_cpu_usage_ =
+          std::numeric_limits<double>::quiet_NaN();
+    }
     cpu_time_ = base::TimeDelta();
-    idle_wakeups_per_second_ = -1;
+    if (shared_flags & REFRESH_TYPE_IDLE_WAKEUPS)
+      idle_wakeups_per_second_ = -1;
 #if BUILDFLAG(IS_WIN)
     hard_faults_per_second_ = 0;
 #endif
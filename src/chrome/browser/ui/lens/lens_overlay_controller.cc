@@ -10,6 +10,7 @@
 #include "base/system/sys_info.h"
 #include "base/task/bind_post_task.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
 #include "chrome/browser/lens/core/mojom/overlay_object.mojom.h"
 #include "chrome/browser/lens/core/mojom/text.mojom.h"
 #include "chrome/browser/search/search.h"
@@ -78,6 +79,18 @@ constexpr base::TimeDelta kFadeoutAnimationTimeout = base::Milliseconds(300);
 // The url query param key for the search query.
 inline constexpr char kTextQueryParameterKey[] = "q";
 
+// Encodes the full resolution screenshot for the WebUI. Returns null if
+// encoding fails. This is slow for large screens, so it runs on the thread
+// pool.
+scoped_refptr<base::RefCountedBytes> EncodeScreenshot(const SkBitmap& bitmap,
+                                                      int quality) {
+  scoped_refptr<base::RefCountedBytes> data;
+  if (!lens::EncodeImage(bitmap, quality, &data)) {
+    return nullptr;
+  }
+  return data;
+}
+
 // When a WebUIController for lens overlay is created, we need a mechanism to
 // glue that instance to the LensOverlayController that spawned it. This class
 // is that glue. The lifetime of this instance is scoped to the lifetime of the
@@ -785,10 +798,26 @@ void LensOverlayController::DidCaptureScreenshot(int attempt_id,
   }
 
   // Encode the screenshot so we can transform it into a data URI for the WebUI.
-  scoped_refptr<base::RefCountedBytes> data;
-  if (!lens::EncodeImage(
-          bitmap, lens::features::GetLensOverlayScreenshotRenderQuality(),
-          &data)) {
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+      base::BindOnce(&EncodeScreenshot, bitmap,
+                     lens::features::GetLensOverlayScreenshotRenderQuality()),
+      base::BindOnce(&LensOverlayController::DidEncodeScreenshot,
+                     weak_factory_.GetWeakPtr(), attempt_id, bitmap));
+}
+
+void LensOverlayController::DidEncodeScreenshot(
+    int attempt_id,
+    const SkBitmap& bitmap,
+    scoped_refptr<base::RefCountedBytes> data) {
+  // The overlay may have been closed, or a new screenshot captured, while
+  // encoding.
+  if (state_ == State::kOff || IsOverlayClosing() ||
+      screenshot_attempt_id_ != attempt_id) {
+    return;
+  }
+
+  if (!data) {
     // TODO(b/334185985): Handle case when screenshot data URI encoding fails.
     CloseUIAsync(
         lens::LensOverlayDismissalSource::kErrorScreenshotEncodingFailed);
@@ -6,6 +6,7 @@
 #define CHROME_BROWSER_UI_LENS_LENS_OVERLAY_CONTROLLER_H_
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "base/scoped_observation.h"
 #include "chrome/browser/lens/core/mojom/lens.mojom.h"
@@ -444,6 +445,13 @@ class LensOverlayController : public LensSearchboxClient,
   // attempt.
   void DidCaptureScreenshot(int attempt_id, const SkBitmap& bitmap);
 
+  // Called once the screenshot captured by attempt `attempt_id` has been
+  // encoded for the WebUI on the thread pool. `data` is null if encoding
+  // failed.
+  void DidEncodeScreenshot(int attempt_id,
+                           const SkBitmap& bitmap,
+                           scoped_refptr<base::RefCountedBytes> data);
+
   // Called when the UI needs to create the overlay widget.
   void ShowOverlayWidget();
 
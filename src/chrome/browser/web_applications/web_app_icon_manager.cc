@@ -15,6 +15,7 @@
 
 #include "base/check.h"
 #include "base/check_op.h"
+#include "base/barrier_callback.h"
 #include "base/containers/adapters.h"
 #include "base/containers/extend.h"
 #include "base/containers/flat_tree.h"
@@ -376,6 +377,102 @@ TypedResult<std::map<SquareSizePx, SkBitmap>> ReadIconAndResizeBlocking(
   return result;
 }
 
+struct EncodedIcon {
+  webapps::AppId app_id;
+  SquareSizePx size_px = 0;
+  std::string data;
+};
+
+// Performs blocking I/O. May be called on another thread.
+// Only reads the files, so that the CPU-bound decoding can run in parallel.
+TypedResult<std::vector<EncodedIcon>> ReadIconFilesBlocking(
+    scoped_refptr<FileUtilsWrapper> utils,
+    const base::FilePath& web_apps_directory,
+    const std::vector<IconId>& icon_ids) {
+  TRACE_EVENT0("ui", "web_app_icon_manager::ReadIconFilesBlocking");
+  TypedResult<std::vector<EncodedIcon>> result;
+  result.value.reserve(icon_ids.size());
+
+  for (const IconId& icon_id : icon_ids) {
+    base::FilePath icon_file = GetIconFileName(web_apps_directory, icon_id);
+    EncodedIcon icon{.app_id = icon_id.app_id, .size_px = icon_id.size};
+    if (!utils->ReadFileToString(icon_file, &icon.data)) {
+      result.error_log.push_back(CreateError(
+          {"Could not read icon file: ", icon_file.AsUTF8Unsafe()}));
+      continue;
+    }
+    result.value.push_back(std::move(icon));
+  }
+
+  return result;
+}
+
+// Does not perform I/O, so may run on any thread pool worker.
+// Returns an empty SkBitmap if the icon could not be decoded.
+TypedResult<std::pair<webapps::AppId, SkBitmap>> DecodeAndResizeIcon(
+    EncodedIcon icon,
+    SquareSizePx target_icon_size_px) {
+  TRACE_EVENT0("ui", "web_app_icon_manager::DecodeAndResizeIcon");
+  TypedResult<std::pair<webapps::AppId, SkBitmap>> result;
+  result.value.first = std::move(icon.app_id);
+
+  SkBitmap bitmap;
+  if (!gfx::PNGCodec::Decode(
+          reinterpret_cast<const unsigned char*>(icon.data.data()),
+          icon.data.size(), &bitmap)) {
+    result.error_log.push_back(CreateError(
+        {"Could not decode icon data for app: ", result.value.first}));
+    return result;
+  }
+
+  if (icon.size_px != target_icon_size_px) {
+    bitmap = skia::ImageOperations::Resize(
+        bitmap, skia::ImageOperations::RESIZE_BEST, target_icon_size_px,
+        target_icon_size_px);
+  }
+  result.value.second = std::move(bitmap);
+  return result;
+}
+
+void OnIconsDecodedAndResized(
+    base::WeakPtr<WebAppIconManager> manager,
+    WebAppIconManager::ReadIconsForAppsCallback callback,
+    std::vector<TypedResult<std::pair<webapps::AppId, SkBitmap>>> results) {
+  TypedResult<base::flat_map<webapps::AppId, SkBitmap>> result;
+  std::vector<std::pair<webapps::AppId, SkBitmap>> icons;
+  icons.reserve(results.size());
+  for (auto& icon_result : results) {
+    base::Extend(result.error_log, std::move(icon_result.error_log));
+    if (!icon_result.value.second.empty()) {
+      icons.push_back(std::move(icon_result.value));
+    }
+  }
+  result.value = base::flat_map<webapps::AppId, SkBitmap>(std::move(icons));
+  LogErrorsCallCallback(std::move(manager), std::move(callback),
+                        std::move(result));
+}
+
+// Decodes and resizes `icons` in parallel and delivers them all at once.
+void DecodeAndResizeIconsInParallel(
+    base::WeakPtr<WebAppIconManager> manager,
+    SquareSizePx target_icon_size_px,
+    WebAppIconManager::ReadIconsForAppsCallback callback,
+    std::vector<EncodedIcon> icons) {
+  TRACE_EVENT1("ui", "web_app_icon_manager::DecodeAndResizeIconsInParallel",
+               "count", icons.size());
+  auto barrier =
+      base::BarrierCallback<TypedResult<std::pair<webapps::AppId, SkBitmap>>>(
+          icons.size(), base::BindOnce(&OnIconsDecodedAndResized, manager,
+                                       std::move(callback)));
+  for (EncodedIcon& icon : icons) {
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(&DecodeAndResizeIcon, std::move(icon),
+                       target_icon_size_px),
+        barrier);
+  }
+}
+
 // Performs blocking I/O. May be called on another thread.
 TypedResult<std::map<SquareSizePx, SkBitmap>> ReadIconsBlocking(
     scoped_refptr<FileUtilsWrapper> utils,
@@ -1335,6 +1432,42 @@ void WebAppIconManager::ReadIconAndResize(const webapps::AppId& app_id,
                      GetWeakPtr(), std::move(callback)));
 }
 
+void WebAppIconManager::ReadIconsAndResizeForApps(
+    const std::vector<webapps::AppId>& app_ids,
+    IconPurpose purpose,
+    SquareSizePx desired_icon_size,
+    ReadIconsForAppsCallback callback) {
+  TRACE_EVENT0("ui", "WebAppIconManager::ReadIconsAndResizeForApps");
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+
+  std::vector<IconId> icon_ids;
+  for (const webapps::AppId& app_id : app_ids) {
+    std::optional<IconSizeAndPurpose> best_icon =
+        FindIconMatchBigger(app_id, {purpose}, desired_icon_size);
+    if (!best_icon) {
+      best_icon = FindIconMatchSmaller(app_id, {purpose}, desired_icon_size);
+    }
+    if (best_icon) {
+      icon_ids.emplace_back(app_id, best_icon->purpose, best_icon->size_px);
+    }
+  }
+
+  if (icon_ids.empty()) {
+    std::move(callback).Run(base::flat_map<webapps::AppId, SkBitmap>());
+    return;
+  }
+
+  // Reading stays on |icon_task_runner_| to be ordered with writes.
+  icon_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(ReadIconFilesBlocking, provider_->file_utils(),
+                     web_apps_directory_, std::move(icon_ids)),
+      base::BindOnce(
+          &LogErrorsCallCallback<std::vector<EncodedIcon>>, GetWeakPtr(),
+          base::BindOnce(&DecodeAndResizeIconsInParallel, GetWeakPtr(),
+                         desired_icon_size, std::move(callback))));
+}
+
 void WebAppIconManager::ReadFavicons(const webapps::AppId& app_id,
                                      IconPurpose purpose,
                                      ReadImageSkiaCallback callback) {
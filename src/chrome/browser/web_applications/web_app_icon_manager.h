@@ -196,6 +196,17 @@ class WebAppIconManager : public WebAppInstallManagerObserver {
                          SquareSizePx desired_icon_size,
                          ReadIconsCallback callback);
 
+  using ReadIconsForAppsCallback = base::OnceCallback<void(
+      base::flat_map<webapps::AppId, SkBitmap> icon_bitmaps)>;
+  // Like ReadIconAndResize(), for many apps at once, such as when a launcher
+  // surface opens. The icon files are read in one task, then decoded and
+  // resized in parallel on the thread pool, and |callback| is called once with
+  // the icons of all the apps that have one.
+  void ReadIconsAndResizeForApps(const std::vector<webapps::AppId>& app_ids,
+                                 IconPurpose purpose,
+                                 SquareSizePx desired_icon_size,
+                                 ReadIconsForAppsCallback callback);
+
   // Reads multiple densities of the icon for each supported UI scale factor.
   // See ui/base/resource/resource_scale_factor.h. Returns null image in
   // `callback` if no icons found for all supported UI scale factors (matches
@@ -1393,6 +1393,51 @@ TEST_F(WebAppIconManagerTest, ReadIconAndResize_Failure) {
   }
 }
 
+TEST_F(WebAppIconManagerTest, ReadIconsAndResizeForApps) {
+  const std::vector<int> sizes_px{icon_size::k32, icon_size::k256};
+  const std::vector<SkColor> colors{SK_ColorBLUE, SK_ColorYELLOW};
+
+  auto web_app1 = test::CreateWebApp(GURL("https://example.com/"));
+  const webapps::AppId app_id1 = web_app1->app_id();
+  IconManagerWriteGeneratedIcons(icon_manager(), app_id1,
+                                 {{IconPurpose::ANY, sizes_px, colors}});
+  web_app1->SetDownloadedIconSizes(IconPurpose::ANY, sizes_px);
+  AddAppToRegistry(std::move(web_app1));
+
+  auto web_app2 = test::CreateWebApp(GURL("https://example.org/"));
+  const webapps::AppId app_id2 = web_app2->app_id();
+  IconManagerWriteGeneratedIcons(icon_manager(), app_id2,
+                                 {{IconPurpose::ANY, {icon_size::k32},
+                                   {SK_ColorGREEN}}});
+  web_app2->SetDownloadedIconSizes(IconPurpose::ANY, {icon_size::k32});
+  AddAppToRegistry(std::move(web_app2));
+
+  // The icon files of this app are missing.
+  auto web_app3 = test::CreateWebApp(GURL("https://example.net/"));
+  const webapps::AppId app_id3 = web_app3->app_id();
+  web_app3->SetDownloadedIconSizes(IconPurpose::ANY, sizes_px);
+  AddAppToRegistry(std::move(web_app3));
+
+  const webapps::AppId unknown_app_id =
+      GenerateAppId(/*manifest_id=*/std::nullopt, GURL("https://example.edu/"));
+
+  base::RunLoop run_loop;
+  icon_manager().ReadIconsAndResizeForApps(
+      {app_id1, app_id2, app_id3, unknown_app_id}, IconPurpose::ANY,
+      icon_size::k64,
+      base::BindLambdaForTesting(
+          [&](base::flat_map<webapps::AppId, SkBitmap> icon_bitmaps) {
+            ASSERT_EQ(2u, icon_bitmaps.size());
+            // Prefers shrinking over enlarging.
+            EXPECT_EQ(icon_size::k64, icon_bitmaps[app_id1].width());
+            EXPECT_EQ(SK_ColorYELLOW, icon_bitmaps[app_id1].getColor(0, 0));
+            EXPECT_EQ(icon_size::k64, icon_bitmaps[app_id2].width());
+            EXPECT_EQ(SK_ColorGREEN, icon_bitmaps[app_id2].getColor(0, 0));
+            run_loop.Quit();
+          }));
+  run_loop.Run();
+}
+
 TEST_F(WebAppIconManagerTest, CacheExistingAppFavicon) {
   auto web_app = test::CreateWebApp();
   const webapps::AppId app_id = web_app->app_id();
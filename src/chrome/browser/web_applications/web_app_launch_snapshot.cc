@@ -0,0 +1,181 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/web_applications/web_app_launch_snapshot.h"
+
+#include <utility>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/pickle.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/task_traits.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_event.h"
+#include "chrome/browser/web_applications/web_app.h"
+#include "chrome/browser/web_applications/web_app_registrar.h"
+
+namespace web_app {
+
+namespace {
+
+// Bump this whenever the format changes. Snapshots of other versions are
+// ignored, and replaced once the registry is loaded.
+constexpr int kSnapshotVersion = 1;
+
+constexpr base::FilePath::CharType kSnapshotFileName[] =
+    FILE_PATH_LITERAL("Launch Snapshot");
+
+template <typename Enum>
+bool ReadEnum(base::PickleIterator& iter, Enum* result) {
+  int value;
+  if (!iter.ReadInt(&value) || value < static_cast<int>(Enum::kMinValue) ||
+      value > static_cast<int>(Enum::kMaxValue)) {
+    return false;
+  }
+  *result = static_cast<Enum>(value);
+  return true;
+}
+
+// Performs blocking I/O. May be called on another thread.
+std::optional<WebAppLaunchSnapshot> ReadSnapshotBlocking(
+    const base::FilePath& path) {
+  TRACE_EVENT0("ui", "web_app::ReadSnapshotBlocking");
+  std::optional<std::vector<uint8_t>> data = base::ReadFileToBytes(path);
+  if (!data) {
+    return std::nullopt;
+  }
+  std::optional<WebAppLaunchSnapshot> snapshot =
+      WebAppLaunchSnapshot::Deserialize(*data);
+  base::UmaHistogramBoolean("WebApp.LaunchSnapshot.ReadResult",
+                            snapshot.has_value());
+  return snapshot;
+}
+
+}  // namespace
+
+WebAppLaunchSnapshot::WebAppLaunchSnapshot() = default;
+
+WebAppLaunchSnapshot::WebAppLaunchSnapshot(WebAppLaunchSnapshot&&) = default;
+
+WebAppLaunchSnapshot& WebAppLaunchSnapshot::operator=(WebAppLaunchSnapshot&&) =
+    default;
+
+WebAppLaunchSnapshot::~WebAppLaunchSnapshot() = default;
+
+// static
+std::optional<WebAppLaunchSnapshot> WebAppLaunchSnapshot::Deserialize(
+    base::span<const uint8_t> data) {
+  base::Pickle pickle = base::Pickle::WithUnownedBuffer(data);
+  base::PickleIterator iter(pickle);
+
+  int version;
+  int count;
+  if (!iter.ReadInt(&version) || version != kSnapshotVersion ||
+      !iter.ReadInt(&count) || count < 0) {
+    return std::nullopt;
+  }
+
+  std::vector<std::pair<webapps::AppId, Entry>> entries;
+  for (int i = 0; i < count; ++i) {
+    webapps::AppId app_id;
+    std::string start_url;
+    std::string scope;
+    Entry entry;
+    if (!iter.ReadString(&app_id) || !iter.ReadString(&start_url) ||
+        !iter.ReadString(&scope) || !ReadEnum(iter, &entry.display_mode) ||
+        !ReadEnum(iter, &entry.user_display_mode)) {
+      return std::nullopt;
+    }
+    entry.start_url = GURL(start_url);
+    entry.scope = GURL(scope);
+    if (!entry.start_url.is_valid()) {
+      return std::nullopt;
+    }
+    entries.emplace_back(std::move(app_id), std::move(entry));
+  }
+
+  WebAppLaunchSnapshot snapshot;
+  snapshot.entries_ =
+      base::flat_map<webapps::AppId, Entry>(std::move(entries));
+  return snapshot;
+}
+
+std::string WebAppLaunchSnapshot::Serialize() const {
+  base::Pickle pickle;
+  pickle.WriteInt(kSnapshotVersion);
+  pickle.WriteInt(static_cast<int>(entries_.size()));
+  for (const auto& [app_id, entry] : entries_) {
+    pickle.WriteString(app_id);
+    pickle.WriteString(entry.start_url.possibly_invalid_spec());
+    pickle.WriteString(entry.scope.possibly_invalid_spec());
+    pickle.WriteInt(static_cast<int>(entry.display_mode));
+    pickle.WriteInt(static_cast<int>(entry.user_display_mode));
+  }
+  return std::string(pickle.data_as_char(), pickle.size());
+}
+
+void WebAppLaunchSnapshot::AddApp(const WebApp& web_app) {
+  entries_.insert_or_assign(
+      web_app.app_id(),
+      Entry{.start_url = web_app.start_url(),
+            .scope = web_app.scope(),
+            .display_mode = web_app.display_mode(),
+            .user_display_mode = web_app.user_display_mode()});
+}
+
+const WebAppLaunchSnapshot::Entry* WebAppLaunchSnapshot::GetEntry(
+    const webapps::AppId& app_id) const {
+  auto it = entries_.find(app_id);
+  return it == entries_.end() ? nullptr : &it->second;
+}
+
+WebAppLaunchSnapshotStore::WebAppLaunchSnapshotStore(
+    const base::FilePath& web_apps_directory,
+    const WebAppRegistrar& registrar)
+    : registrar_(registrar),
+      task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_BLOCKING,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN})),
+      writer_(web_apps_directory.Append(kSnapshotFileName), task_runner_) {}
+
+WebAppLaunchSnapshotStore::~WebAppLaunchSnapshotStore() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (writer_.HasPendingWrite()) {
+    writer_.DoScheduledWrite();
+  }
+}
+
+void WebAppLaunchSnapshotStore::Load() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&ReadSnapshotBlocking, writer_.path()),
+      base::BindOnce(&WebAppLaunchSnapshotStore::OnLoaded,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+void WebAppLaunchSnapshotStore::ScheduleWrite() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  writer_.ScheduleWrite(this);
+}
+
+std::optional<std::string> WebAppLaunchSnapshotStore::SerializeData() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  TRACE_EVENT0("ui", "WebAppLaunchSnapshotStore::SerializeData");
+  WebAppLaunchSnapshot snapshot;
+  for (const WebApp& web_app : registrar_->GetApps()) {
+    snapshot.AddApp(web_app);
+  }
+  return snapshot.Serialize();
+}
+
+void WebAppLaunchSnapshotStore::OnLoaded(
+    std::optional<WebAppLaunchSnapshot> snapshot) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  snapshot_ = std::move(snapshot);
+}
+
+}  // namespace web_app
@@ -0,0 +1,115 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CHROME_BROWSER_WEB_APPLICATIONS_WEB_APP_LAUNCH_SNAPSHOT_H_
+#define CHROME_BROWSER_WEB_APPLICATIONS_WEB_APP_LAUNCH_SNAPSHOT_H_
+
+#include <optional>
+#include <string>
+
+#include "base/containers/flat_map.h"
+#include "base/containers/span.h"
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/memory/raw_ref.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "chrome/browser/web_applications/mojom/user_display_mode.mojom-shared.h"
+#include "chrome/browser/web_applications/web_app_constants.h"
+#include "components/webapps/common/web_app_id.h"
+#include "url/gurl.h"
+
+namespace base {
+class SequencedTaskRunner;
+}  // namespace base
+
+namespace web_app {
+
+class WebApp;
+class WebAppRegistrar;
+
+// A compact copy of just the fields needed to launch the installed web apps.
+// Unlike the registry, which is only ready once every app has been read from
+// the database and fully deserialized, the snapshot is small enough to be read
+// as soon as the profile is created.
+class WebAppLaunchSnapshot {
+ public:
+  struct Entry {
+    GURL start_url;
+    GURL scope;
+    DisplayMode display_mode = DisplayMode::kUndefined;
+    mojom::UserDisplayMode user_display_mode =
+        mojom::UserDisplayMode::kStandalone;
+
+    bool operator==(const Entry& other) const = default;
+  };
+
+  WebAppLaunchSnapshot();
+  WebAppLaunchSnapshot(WebAppLaunchSnapshot&&);
+  WebAppLaunchSnapshot& operator=(WebAppLaunchSnapshot&&);
+  ~WebAppLaunchSnapshot();
+
+  // Returns null if the data is malformed or was written by an incompatible
+  // version.
+  static std::optional<WebAppLaunchSnapshot> Deserialize(
+      base::span<const uint8_t> data);
+  std::string Serialize() const;
+
+  void AddApp(const WebApp& web_app);
+
+  // Returns null if `app_id` is not in the snapshot.
+  const Entry* GetEntry(const webapps::AppId& app_id) const;
+
+  const base::flat_map<webapps::AppId, Entry>& entries() const {
+    return entries_;
+  }
+
+ private:
+  base::flat_map<webapps::AppId, Entry> entries_;
+};
+
+// Reads the WebAppLaunchSnapshot written by the previous session, and writes
+// a new one from the registrar whenever the registry is written.
+class WebAppLaunchSnapshotStore
+    : public base::ImportantFileWriter::DataSerializer {
+ public:
+  WebAppLaunchSnapshotStore(const base::FilePath& web_apps_directory,
+                            const WebAppRegistrar& registrar);
+  WebAppLaunchSnapshotStore(const WebAppLaunchSnapshotStore&) = delete;
+  WebAppLaunchSnapshotStore& operator=(const WebAppLaunchSnapshotStore&) =
+      delete;
+  ~WebAppLaunchSnapshotStore() override;
+
+  // Starts reading the snapshot from disk.
+  void Load();
+
+  // Returns the snapshot read by Load(), or null if it has not been read yet or
+  // there is none.
+  const WebAppLaunchSnapshot* snapshot() const {
+    return snapshot_ ? &*snapshot_ : nullptr;
+  }
+
+  // Schedules writing a snapshot of the registrar's apps. Writes are batched.
+  void ScheduleWrite();
+
+  // base::ImportantFileWriter::DataSerializer:
+  std::optional<std::string> SerializeData() override;
+
+ private:
+  void OnLoaded(std::optional<WebAppLaunchSnapshot> snapshot);
+
+  const raw_ref<const WebAppRegistrar> registrar_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  base::ImportantFileWriter writer_;
+  std::optional<WebAppLaunchSnapshot> snapshot_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<WebAppLaunchSnapshotStore> weak_ptr_factory_{this};
+};
+
+}  // namespace web_app
+
+#endif  // CHROME_BROWSER_WEB_APPLICATIONS_WEB_APP_LAUNCH_SNAPSHOT_H_
@@ -0,0 +1,73 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "chrome/browser/web_applications/web_app_launch_snapshot.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "base/containers/span.h"
+#include "chrome/browser/web_applications/mojom/user_display_mode.mojom.h"
+#include "chrome/browser/web_applications/test/web_app_test_utils.h"
+#include "chrome/browser/web_applications/web_app.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace web_app {
+namespace {
+
+std::optional<WebAppLaunchSnapshot> Deserialize(const std::string& data) {
+  return WebAppLaunchSnapshot::Deserialize(base::as_byte_span(data));
+}
+
+TEST(WebAppLaunchSnapshotTest, RoundTrip) {
+  std::unique_ptr<WebApp> app1 =
+      test::CreateWebApp(GURL("https://example.com/app/start"));
+  app1->SetScope(GURL("https://example.com/app/"));
+  app1->SetDisplayMode(DisplayMode::kStandalone);
+  app1->SetUserDisplayMode(mojom::UserDisplayMode::kTabbed);
+  std::unique_ptr<WebApp> app2 =
+      test::CreateWebApp(GURL("https://example.org/"));
+  app2->SetDisplayMode(DisplayMode::kMinimalUi);
+  app2->SetUserDisplayMode(mojom::UserDisplayMode::kBrowser);
+
+  WebAppLaunchSnapshot snapshot;
+  snapshot.AddApp(*app1);
+  snapshot.AddApp(*app2);
+
+  std::optional<WebAppLaunchSnapshot> read =
+      Deserialize(snapshot.Serialize());
+  ASSERT_TRUE(read);
+  EXPECT_EQ(snapshot.entries(), read->entries());
+
+  const WebAppLaunchSnapshot::Entry* entry = read->GetEntry(app1->app_id());
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(GURL("https://example.com/app/start"), entry->start_url);
+  EXPECT_EQ(GURL("https://example.com/app/"), entry->scope);
+  EXPECT_EQ(DisplayMode::kStandalone, entry->display_mode);
+  EXPECT_EQ(mojom::UserDisplayMode::kTabbed, entry->user_display_mode);
+
+  EXPECT_FALSE(read->GetEntry("unknown"));
+}
+
+TEST(WebAppLaunchSnapshotTest, Empty) {
+  std::optional<WebAppLaunchSnapshot> read =
+      Deserialize(WebAppLaunchSnapshot().Serialize());
+  ASSERT_TRUE(read);
+  EXPECT_TRUE(read->entries().empty());
+}
+
+TEST(WebAppLaunchSnapshotTest, RejectsMalformedData) {
+  WebAppLaunchSnapshot snapshot;
+  snapshot.AddApp(*test::CreateWebApp());
+  const std::string data = snapshot.Serialize();
+
+  EXPECT_FALSE(Deserialize(""));
+  EXPECT_FALSE(Deserialize("garbage"));
+  EXPECT_FALSE(Deserialize(data.substr(0, data.size() - 1)));
+}
+
+}  // namespace
+}  // namespace web_app
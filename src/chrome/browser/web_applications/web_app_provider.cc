@@ -12,6 +12,7 @@
 
 #include "base/check.h"
 #include "base/check_is_test.h"
+#include "base/feature_list.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback_forward.h"
 #include "base/functional/callback_helpers.h"
@@ -45,6 +46,7 @@
 #include "chrome/browser/web_applications/web_app_icon_manager.h"
 #include "chrome/browser/web_applications/web_app_install_finalizer.h"
 #include "chrome/browser/web_applications/web_app_install_manager.h"
+#include "chrome/browser/web_applications/web_app_launch_snapshot.h"
 #include "chrome/browser/web_applications/web_app_origin_association_manager.h"
 #include "chrome/browser/web_applications/web_app_provider_factory.h"
 #include "chrome/browser/web_applications/web_app_registrar.h"
@@ -53,6 +55,7 @@
 #include "chrome/browser/web_applications/web_app_ui_manager.h"
 #include "chrome/browser/web_applications/web_app_utils.h"
 #include "chrome/browser/web_applications/web_contents/web_contents_manager.h"
+#include "chrome/common/chrome_features.h"
 #include "components/webapps/common/web_app_id.h"
 #include "content/public/browser/web_contents.h"
 
@@ -308,6 +311,13 @@ void WebAppProvider::Shutdown() {
   is_registry_ready_ = false;
 }
 
+const WebAppLaunchSnapshot* WebAppProvider::launch_snapshot() const {
+  if (is_registry_ready_ || !launch_snapshot_store_) {
+    return nullptr;
+  }
+  return launch_snapshot_store_->snapshot();
+}
+
 base::WeakPtr<WebAppProvider> WebAppProvider::AsWeakPtr() {
   return weak_ptr_factory_.GetWeakPtr();
 }
@@ -341,6 +351,14 @@ void WebAppProvider::CreateSubsystems(Profile* profile) {
   registrar_ = std::make_unique<WebAppRegistrarMutable>(profile);
   sync_bridge_ = std::make_unique<WebAppSyncBridge>(registrar_.get());
 
+  // Read the launch snapshot as early as possible, while the database is still
+  // to be opened.
+  if (base::FeatureList::IsEnabled(features::kWebAppLaunchSnapshot)) {
+    launch_snapshot_store_ = std::make_unique<WebAppLaunchSnapshotStore>(
+        GetWebAppsRootDirectory(profile), *registrar_);
+    launch_snapshot_store_->Load();
+  }
+
   file_utils_ = base::MakeRefCounted<FileUtilsWrapper>();
 
   icon_manager_ = std::make_unique<WebAppIconManager>(profile);
@@ -381,6 +399,11 @@ void WebAppProvider::ConnectSubsystems() {
   // with SetProvider().
   sync_bridge_->SetSubsystems(database_factory_.get(), command_manager_.get(),
                               command_scheduler_.get(), install_manager_.get());
+  if (launch_snapshot_store_) {
+    sync_bridge_->SetRegistryWrittenCallback(
+        base::BindRepeating(&WebAppLaunchSnapshotStore::ScheduleWrite,
+                            base::Unretained(launch_snapshot_store_.get())));
+  }
 
   base::PassKey<WebAppProvider> pass_key;
   icon_manager_->SetProvider(pass_key, *this);
@@ -433,6 +456,10 @@ void WebAppProvider::OnSyncBridgeReady() {
       concurrent.CreateClosure();
 #endif  // BUILDFLAG(IS_CHROMEOS)
 
+  if (launch_snapshot_store_) {
+    launch_snapshot_store_->ScheduleWrite();
+  }
+
   registrar_->Start();
   install_finalizer_->Start();
   icon_manager_->Start();
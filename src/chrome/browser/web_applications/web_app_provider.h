@@ -40,6 +40,8 @@ class WebAppCommandScheduler;
 class WebAppIconManager;
 class WebAppInstallFinalizer;
 class WebAppInstallManager;
+class WebAppLaunchSnapshot;
+class WebAppLaunchSnapshotStore;
 class WebAppOriginAssociationManager;
 class WebAppPolicyManager;
 class WebAppRegistrar;
@@ -210,6 +212,11 @@ class WebAppProvider : public KeyedService {
   // Returns whether the app registry is ready.
   bool is_registry_ready() const { return is_registry_ready_; }
 
+  // Returns the launch fields of the apps that were installed in the previous
+  // session, for use before the registry is ready. Returns null once the
+  // registry is ready, or if the snapshot has not been read (yet).
+  const WebAppLaunchSnapshot* launch_snapshot() const;
+
   base::WeakPtr<WebAppProvider> AsWeakPtr();
 
   // Returns a nullptr in the default implementation
@@ -232,6 +239,7 @@ class WebAppProvider : public KeyedService {
   std::unique_ptr<AbstractWebAppDatabaseFactory> database_factory_;
   std::unique_ptr<WebAppRegistrarMutable> registrar_;
   std::unique_ptr<WebAppSyncBridge> sync_bridge_;
+  std::unique_ptr<WebAppLaunchSnapshotStore> launch_snapshot_store_;
   std::unique_ptr<PreinstalledWebAppManager> preinstalled_web_app_manager_;
   std::unique_ptr<WebAppIconManager> icon_manager_;
   std::unique_ptr<WebAppTranslationManager> translation_manager_;
@@ -221,6 +221,11 @@ void WebAppSyncBridge::SetSubsystems(
   install_manager_ = install_manager;
 }
 
+void WebAppSyncBridge::SetRegistryWrittenCallback(
+    base::RepeatingClosure callback) {
+  registry_written_callback_ = std::move(callback);
+}
+
 [[nodiscard]] ScopedRegistryUpdate WebAppSyncBridge::BeginUpdate(
     CommitCallback callback) {
   DCHECK(database_->is_opened());
@@ -609,6 +614,8 @@ void WebAppSyncBridge::EnsureAppsHaveUserDisplayModeForCurrentPlatform() {
 void WebAppSyncBridge::OnDataWritten(CommitCallback callback, bool success) {
   if (!success)
     DLOG(ERROR) << "WebAppSyncBridge commit failed";
+  else if (registry_written_callback_)
+    registry_written_callback_.Run();
 
   base::UmaHistogramBoolean("WebApp.Database.WriteResult", success);
   std::move(callback).Run(success);
@@ -118,6 +118,10 @@ class WebAppSyncBridge : public syncer::ModelTypeSyncBridge {
                      WebAppCommandScheduler* command_scheduler_,
                      WebAppInstallManager* install_manager_);
 
+  // Runs |callback| after each successful write of the registry to the
+  // database.
+  void SetRegistryWrittenCallback(base::RepeatingClosure callback);
+
   using CommitCallback = base::OnceCallback<void(bool success)>;
   using RepeatingInstallCallback =
       base::RepeatingCallback<void(const webapps::AppId& app_id,
@@ -307,6 +311,8 @@ class WebAppSyncBridge : public syncer::ModelTypeSyncBridge {
 
   base::OneShotEvent on_sync_connected_;
 
+  base::RepeatingClosure registry_written_callback_;
+
   bool is_in_update_ = false;
   bool disable_checks_for_testing_ = false;
 
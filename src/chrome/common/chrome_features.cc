@@ -1526,6 +1526,13 @@ BASE_FEATURE(kWebAppDedupeInstallUrls,
              "WebAppDedupeInstallUrls",
              base::FEATURE_ENABLED_BY_DEFAULT);
 
+// Keeps a compact snapshot of the fields needed to launch the installed web
+// apps on disk, so that it is available early in startup while the full
+// registry is still being loaded from the database.
+BASE_FEATURE(kWebAppLaunchSnapshot,
+             "WebAppLaunchSnapshot",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 BASE_FEATURE(kWebAppManifestIconUpdating,
              "WebAppManifestIconUpdating",
              base::FEATURE_DISABLED_BY_DEFAULT);
@@ -20,12 +20,15 @@
 #include "base/metrics/histogram_functions.h"
 #include "base/ranges/algorithm.h"
 #include "base/rust_buildflags.h"
+#include "base/strings/strcat.h"
 #include "base/strings/string_split.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/task/thread_pool.h"
 #include "base/time/time.h"
 #include "base/timer/elapsed_timer.h"
 #include "base/trace_event/trace_event.h"
 #include "net/base/load_flags.h"
+#include "net/base/net_errors.h"
 #include "net/http/http_status_code.h"
 #include "services/data_decoder/public/cpp/data_decoder.h"
 #include "services/network/public/cpp/resource_request.h"
@@ -41,6 +44,10 @@ namespace {
 
 const unsigned int kRetriesCountOnNetworkChange = 1;
 
+// The maximum number of responses kept in the response cache of each
+// APIRequestHelper.
+const size_t kMaxCachedResponses = 32;
+
 BASE_FEATURE(kUseWootzRustJSONSanitizer,
              "UseWootzRustJSONSanitizer",
              base::FEATURE_ENABLED_BY_DEFAULT);
@@ -65,6 +72,39 @@ void ParseJsonUsingRust(
           std::move(callback)));
 }
 
+// Returns the suffix of the JSON parse latency histograms for a body of
+// `size` bytes, so that the two parsers are compared for similar payloads.
+std::string_view GetJsonSizeSuffix(size_t size) {
+  if (size < 16 * 1024) {
+    return "Small";
+  }
+  if (size < 256 * 1024) {
+    return "Medium";
+  }
+  return "Large";
+}
+
+// Wraps `callback` to record the time from now until the parse result is
+// delivered back to the calling sequence, which includes the thread hop or
+// the IPC to the data decoder service.
+base::OnceCallback<void(ValueOrError)> RecordParseJsonLatency(
+    bool in_process,
+    size_t size,
+    base::OnceCallback<void(ValueOrError)> callback) {
+  return base::BindOnce(
+      [](const std::string& histogram_name, base::TimeTicks start_time,
+         base::OnceCallback<void(ValueOrError)> callback,
+         ValueOrError result) {
+        base::UmaHistogramTimes(histogram_name,
+                                base::TimeTicks::Now() - start_time);
+        std::move(callback).Run(std::move(result));
+      },
+      base::StrCat({"Wootz.APIRequestHelper.ParseJsonLatency.",
+                    in_process ? "InProcess." : "DataDecoder.",
+                    GetJsonSizeSuffix(size)}),
+      base::TimeTicks::Now(), std::move(callback));
+}
+
 scoped_refptr<base::SequencedTaskRunner> MakeDecoderTaskRunner() {
   return base::ThreadPool::CreateSequencedTaskRunner(
       {base::TaskPriority::USER_VISIBLE,
@@ -136,7 +176,15 @@ bool APIRequestResult::operator==(const APIRequestResult& other) const {
     return std::tie(v.response_code_, v.value_body_, v.headers_, v.error_code_,
                     v.final_url_);
   };
-  return tied(*this) == tied(other);
+  auto json_view_text =
+      [](const APIRequestResult& v) -> std::optional<std::string_view> {
+    if (!v.json_view_body_) {
+      return std::nullopt;
+    }
+    return v.json_view_body_->json();
+  };
+  return tied(*this) == tied(other) &&
+         json_view_text(*this) == json_view_text(other);
 }
 
 bool APIRequestResult::operator!=(const APIRequestResult& other) const {
@@ -151,6 +199,13 @@ bool APIRequestResult::IsResponseCodeValid() const {
   return response_code_ >= 100 && response_code_ <= 599;
 }
 
+APIRequestResult APIRequestResult::Clone() const {
+  CHECK(!json_view_body_);
+  CHECK(!body_consumed_);
+  return APIRequestResult(response_code_, value_body_.Clone(), headers_,
+                          error_code_, final_url_);
+}
+
 base::Value APIRequestResult::TakeBody() {
   CHECK(!body_consumed_);
   body_consumed_ = true;
@@ -178,6 +233,18 @@ APIRequestHelper::APIRequestHelper(
 
 APIRequestHelper::~APIRequestHelper() = default;
 
+APIRequestHelper::QueuedRequest::QueuedRequest() = default;
+APIRequestHelper::QueuedRequest::QueuedRequest(QueuedRequest&&) = default;
+APIRequestHelper::QueuedRequest& APIRequestHelper::QueuedRequest::operator=(
+    QueuedRequest&&) = default;
+APIRequestHelper::QueuedRequest::~QueuedRequest() = default;
+
+APIRequestHelper::HostRequests::HostRequests() = default;
+APIRequestHelper::HostRequests::HostRequests(HostRequests&&) = default;
+APIRequestHelper::HostRequests& APIRequestHelper::HostRequests::operator=(
+    HostRequests&&) = default;
+APIRequestHelper::HostRequests::~HostRequests() = default;
+
 APIRequestHelper::Ticket APIRequestHelper::Request(
     const std::string& method,
     const GURL& url,
@@ -187,25 +254,172 @@ APIRequestHelper::Ticket APIRequestHelper::Request(
     const base::flat_map<std::string, std::string>& headers,
     const APIRequestOptions& request_options,
     ResponseConversionCallback conversion_callback) {
+  const bool is_shareable =
+      !request_options.deliver_json_view && !conversion_callback;
+  const bool use_cache = is_shareable &&
+                         request_options.response_cache_ttl.has_value() &&
+                         (method.empty() || method == "GET") && payload.empty();
+  const bool coalesce =
+      is_shareable && request_options.coalesce_identical_requests;
+  RequestKey key(method, url, payload, headers);
+
+  // Requests that get their result from the cache or from another request
+  // still get a handler, so that the ticket can be cancelled, but its loader
+  // isn't started.
+  if (use_cache) {
+    if (std::optional<APIRequestResult> cached_result =
+            GetCachedResponse(key)) {
+      auto iter = CreateRequestURLLoaderHandler(
+          method, url, payload, payload_content_type, request_options, headers,
+          std::move(callback));
+      base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+          FROM_HERE,
+          base::BindOnce(&APIRequestHelper::URLLoaderHandler::SendResult,
+                         iter->get()->GetWeakPtr(),
+                         std::move(cached_result.value())));
+      return iter;
+    }
+  }
+  if (coalesce) {
+    auto in_progress = coalesced_requests_.find(key);
+    if (in_progress != coalesced_requests_.end()) {
+      auto iter = CreateRequestURLLoaderHandler(
+          method, url, payload, payload_content_type, request_options, headers,
+          std::move(callback));
+      in_progress->second.push_back(iter->get()->GetWeakPtr());
+      coalesced_request_count_++;
+      base::UmaHistogramBoolean("Wootz.APIRequestHelper.CoalescedRequest",
+                                true);
+      return iter;
+    }
+    base::UmaHistogramBoolean("Wootz.APIRequestHelper.CoalescedRequest",
+                              false);
+  }
+  if (use_cache || coalesce) {
+    callback = base::BindOnce(&APIRequestHelper::OnShareableRequestComplete,
+                              weak_ptr_factory_.GetWeakPtr(), key, coalesce,
+                              use_cache ? request_options.response_cache_ttl
+                                        : std::nullopt,
+                              std::move(callback));
+  }
+
   auto iter = CreateRequestURLLoaderHandler(
       method, url, payload, payload_content_type, request_options, headers,
       std::move(callback));
   auto* handler = iter->get();
+  handler->deliver_json_view_ = request_options.deliver_json_view;
+  if (coalesce) {
+    coalesced_requests_.emplace(key,
+                                std::vector<base::WeakPtr<URLLoaderHandler>>());
+    handler->coalescing_key_ = std::move(key);
+  }
+
+  StartOrQueueRequest(
+      handler, url, request_options.priority,
+      base::BindOnce(&APIRequestHelper::StartDownload,
+                     weak_ptr_factory_.GetWeakPtr(), handler->GetWeakPtr(),
+                     request_options.max_body_size,
+                     std::move(conversion_callback)));
+  return iter;
+}
 
-  if (request_options.max_body_size == -1u) {
+void APIRequestHelper::StartDownload(
+    base::WeakPtr<URLLoaderHandler> handler,
+    size_t max_body_size,
+    ResponseConversionCallback conversion_callback) {
+  if (!handler) {
+    return;
+  }
+  if (max_body_size == -1u) {
     handler->url_loader_->DownloadToStringOfUnboundedSizeUntilCrashAndDie(
         url_loader_factory_.get(),
         base::BindOnce(&APIRequestHelper::URLLoaderHandler::OnResponse,
-                       handler->GetWeakPtr(), std::move(conversion_callback)));
+                       handler, std::move(conversion_callback)));
   } else {
     handler->url_loader_->DownloadToString(
         url_loader_factory_.get(),
         base::BindOnce(&APIRequestHelper::URLLoaderHandler::OnResponse,
-                       handler->GetWeakPtr(), std::move(conversion_callback)),
-        request_options.max_body_size);
+                       handler, std::move(conversion_callback)),
+        max_body_size);
   }
+}
 
-  return iter;
+void APIRequestHelper::SetMaxConcurrentRequestsPerHost(size_t max_requests) {
+  max_requests_per_host_ = max_requests;
+  std::vector<std::string> hosts;
+  for (const auto& [host, requests] : host_requests_) {
+    hosts.push_back(host);
+  }
+  for (const auto& host : hosts) {
+    StartQueuedRequests(host);
+  }
+}
+
+void APIRequestHelper::StartOrQueueRequest(URLLoaderHandler* handler,
+                                           const GURL& url,
+                                           net::RequestPriority priority,
+                                           base::OnceClosure start) {
+  if (!max_requests_per_host_ || !url.has_host()) {
+    std::move(start).Run();
+    return;
+  }
+  QueuedRequest request;
+  request.handler = handler->GetWeakPtr();
+  request.priority = priority;
+  request.queue_time = base::TimeTicks::Now();
+  request.start = std::move(start);
+  host_requests_[url.host()].queue.emplace(
+      std::make_pair(-static_cast<int>(priority),
+                     next_queue_sequence_number_++),
+      std::move(request));
+  StartQueuedRequests(url.host());
+}
+
+void APIRequestHelper::OnRequestFinished(URLLoaderHandler* handler) {
+  if (!handler->limited_host_) {
+    return;
+  }
+  const std::string host = std::move(handler->limited_host_.value());
+  handler->limited_host_.reset();
+  auto it = host_requests_.find(host);
+  CHECK(it != host_requests_.end());
+  CHECK_GT(it->second.running_count, 0u);
+  it->second.running_count--;
+  StartQueuedRequests(host);
+}
+
+void APIRequestHelper::StartQueuedRequests(const std::string& host) {
+  auto it = host_requests_.find(host);
+  if (it == host_requests_.end()) {
+    return;
+  }
+  HostRequests& requests = it->second;
+  std::vector<base::OnceClosure> starts;
+  while (!requests.queue.empty() &&
+         (!max_requests_per_host_ ||
+          requests.running_count < max_requests_per_host_)) {
+    QueuedRequest request = std::move(requests.queue.begin()->second);
+    requests.queue.erase(requests.queue.begin());
+    // The request was cancelled while queued.
+    if (!request.handler) {
+      continue;
+    }
+    request.handler->limited_host_ = host;
+    requests.running_count++;
+    base::UmaHistogramTimes(
+        base::StrCat({"Wootz.APIRequestHelper.QueueWaitTime.",
+                      net::RequestPriorityToString(request.priority)}),
+        base::TimeTicks::Now() - request.queue_time);
+    starts.push_back(std::move(request.start));
+  }
+  if (!requests.running_count && requests.queue.empty()) {
+    host_requests_.erase(it);
+  }
+  // Starting the requests doesn't run any callback, but is done after
+  // updating the queue anyway.
+  for (auto& start : starts) {
+    std::move(start).Run();
+  }
 }
 
 APIRequestHelper::Ticket APIRequestHelper::RequestSSE(
@@ -250,18 +464,102 @@ APIRequestHelper::Ticket APIRequestHelper::RequestSSE(
 void APIRequestHelper::DeleteAndSendResult(Ticket iter,
                                            ResultCallback callback,
                                            APIRequestResult result) {
-  Cancel(iter);
+  OnRequestFinished(iter->get());
+  url_loaders_.erase(iter);
   std::move(callback).Run(std::move(result));
 }
 
 void APIRequestHelper::Cancel(const Ticket& ticket) {
+  // The requests that were coalesced with a cancelled request are aborted.
+  if (const std::optional<RequestKey>& key = ticket->get()->coalescing_key_) {
+    auto coalesced = coalesced_requests_.find(key.value());
+    if (coalesced != coalesced_requests_.end()) {
+      for (const auto& handler : coalesced->second) {
+        base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+            FROM_HERE,
+            base::BindOnce(&APIRequestHelper::URLLoaderHandler::SendResult,
+                           handler,
+                           APIRequestResult(-1, base::Value(), {},
+                                            net::ERR_ABORTED,
+                                            std::get<GURL>(key.value()))));
+      }
+      coalesced_requests_.erase(coalesced);
+    }
+  }
+  OnRequestFinished(ticket->get());
   url_loaders_.erase(ticket);
 }
 
 void APIRequestHelper::CancelAll() {
+  coalesced_requests_.clear();
+  host_requests_.clear();
   url_loaders_.clear();
 }
 
+std::optional<APIRequestResult> APIRequestHelper::GetCachedResponse(
+    const RequestKey& key) {
+  auto it = response_cache_.find(key);
+  if (it != response_cache_.end() &&
+      it->second.expiry_time <= base::TimeTicks::Now()) {
+    response_cache_.erase(it);
+    it = response_cache_.end();
+  }
+  const bool is_hit = it != response_cache_.end();
+  base::UmaHistogramBoolean("Wootz.APIRequestHelper.ResponseCacheHit", is_hit);
+  if (!is_hit) {
+    response_cache_miss_count_++;
+    return std::nullopt;
+  }
+  response_cache_hit_count_++;
+  return it->second.result.Clone();
+}
+
+void APIRequestHelper::AddCachedResponse(const RequestKey& key,
+                                         const APIRequestResult& result,
+                                         base::TimeDelta ttl) {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  std::erase_if(response_cache_, [now](const auto& entry) {
+    return entry.second.expiry_time <= now;
+  });
+  // Make room by dropping the response that expires first.
+  if (response_cache_.size() >= kMaxCachedResponses &&
+      !response_cache_.contains(key)) {
+    response_cache_.erase(base::ranges::min_element(
+        response_cache_, {},
+        [](const auto& entry) { return entry.second.expiry_time; }));
+  }
+  response_cache_.insert_or_assign(key,
+                                   CachedResponse{result.Clone(), now + ttl});
+}
+
+void APIRequestHelper::OnShareableRequestComplete(
+    RequestKey key,
+    bool coalesced,
+    std::optional<base::TimeDelta> cache_ttl,
+    ResultCallback callback,
+    APIRequestResult result) {
+  std::vector<base::WeakPtr<URLLoaderHandler>> coalesced_handlers;
+  if (coalesced) {
+    auto it = coalesced_requests_.find(key);
+    if (it != coalesced_requests_.end()) {
+      coalesced_handlers = std::move(it->second);
+      coalesced_requests_.erase(it);
+    }
+  }
+  if (cache_ttl && result.error_code() == net::OK &&
+      result.Is2XXResponseCode()) {
+    AddCachedResponse(key, result, cache_ttl.value());
+  }
+
+  // Any callback may delete `this`, which invalidates the handlers.
+  for (const auto& handler : coalesced_handlers) {
+    if (handler) {
+      handler->SendResult(result.Clone());
+    }
+  }
+  std::move(callback).Run(std::move(result));
+}
+
 APIRequestHelper::Ticket APIRequestHelper::CreateURLLoaderHandler(
     const std::string& method,
     const GURL& url,
@@ -270,9 +568,11 @@ APIRequestHelper::Ticket APIRequestHelper::CreateURLLoaderHandler(
     bool auto_retry_on_network_change,
     bool enable_cache,
     bool allow_http_error_result,
+    net::RequestPriority priority,
     const base::flat_map<std::string, std::string>& headers) {
   auto request = std::make_unique<network::ResourceRequest>();
   request->url = url;
+  request->priority = priority;
   request->load_flags = net::LOAD_DO_NOT_SAVE_COOKIES;
   if (!enable_cache) {
     request->load_flags =
@@ -331,12 +631,16 @@ APIRequestHelper::Ticket APIRequestHelper::CreateRequestURLLoaderHandler(
   auto iter = CreateURLLoaderHandler(
       method, url, payload, payload_content_type,
       request_options.auto_retry_on_network_change,
-      request_options.enable_cache, true /* allow_http_error_result*/, headers);
+      request_options.enable_cache, true /* allow_http_error_result*/,
+      request_options.priority, headers);
   auto* handler = iter->get();
 
   handler->result_callback_ = base::BindOnce(
       &APIRequestHelper::DeleteAndSendResult, weak_ptr_factory_.GetWeakPtr(),
       iter, std::move(result_callback));
+  handler->parse_json_in_process_ = request_options.parse_json_in_process;
+  handler->batch_sse_events_ = request_options.batch_sse_events;
+  handler->raw_sse_data_ = request_options.raw_sse_data;
   if (request_options.timeout) {
     handler->url_loader_->SetTimeoutDuration(request_options.timeout.value());
   }
@@ -381,16 +685,32 @@ APIRequestHelper::URLLoaderHandler::GetWeakPtr() {
 void APIRequestHelper::URLLoaderHandler::send_sse_data_for_testing(
     std::string_view string_piece,
     bool is_sse,
-    DataReceivedCallback callback) {
+    DataReceivedCallback callback,
+    bool is_complete_response) {
   is_sse_ = is_sse;
   data_received_callback_ = std::move(callback);
   OnDataReceived(string_piece, base::BindOnce([]() {}));
+  if (is_complete_response && is_sse_ && !sse_partial_line_.empty()) {
+    ParseSSE("\n");
+  }
+}
+
+void APIRequestHelper::URLLoaderHandler::set_request_options_for_testing(
+    const APIRequestOptions& request_options) {
+  parse_json_in_process_ = request_options.parse_json_in_process;
+  batch_sse_events_ = request_options.batch_sse_events;
+  raw_sse_data_ = request_options.raw_sse_data;
 }
 
 void APIRequestHelper::URLLoaderHandler::ParseJsonImpl(
     std::string json,
     base::OnceCallback<void(ValueOrError)> callback) {
-  if (base::FeatureList::IsEnabled(kUseWootzRustJSONSanitizer)) {
+  const bool in_process =
+      parse_json_in_process_ ||
+      base::FeatureList::IsEnabled(kUseWootzRustJSONSanitizer);
+  callback =
+      RecordParseJsonLatency(in_process, json.size(), std::move(callback));
+  if (in_process) {
     ParseJsonUsingRust(std::move(json), std::move(callback), task_runner_);
     return;
   }
@@ -429,6 +749,15 @@ void APIRequestHelper::URLLoaderHandler::OnComplete(bool success) {
   VLOG(1) << "[[" << __func__ << "]]"
           << " Response completed\n";
 
+  // The stream may not end with a line break. Raw events are delivered
+  // synchronously, and the consumer may cancel the request when receiving one.
+  if (is_sse_ && !sse_partial_line_.empty()) {
+    auto weak_this = weak_ptr_factory_.GetWeakPtr();
+    ParseSSE("\n");
+    if (!weak_this) {
+      return;
+    }
+  }
   request_is_finished_ = true;
 
   // Delete now or when decoding operations are complete
@@ -437,6 +766,8 @@ void APIRequestHelper::URLLoaderHandler::OnComplete(bool success) {
 
 void APIRequestHelper::URLLoaderHandler::OnRetry(
     base::OnceClosure start_retry) {
+  // The retried response starts from scratch.
+  sse_partial_line_.clear();
   std::move(start_retry).Run();
   // We assume that a consumer of APIRequestHelper doesn't
   // care about discarding partial responses received so far
@@ -472,12 +803,32 @@ void APIRequestHelper::URLLoaderHandler::OnResponse(
     raw_body = converted_body.value();
   }
 
+  if (deliver_json_view_) {
+    task_runner_->PostTaskAndReplyWithResult(
+        FROM_HERE,
+        base::BindOnce(
+            [](std::string json) {
+              TRACE_EVENT0("wootz", "APIRequestHelper_ParseJsonView");
+              return base::JSONView::Parse(std::move(json));
+            },
+            std::move(raw_body)),
+        base::BindOnce(
+            &APIRequestHelper::URLLoaderHandler::OnParseJsonViewResponse,
+            GetWeakPtr(), std::move(result)));
+    return;
+  }
+
   ParseJsonImpl(
       std::move(raw_body),
       base::BindOnce(&APIRequestHelper::URLLoaderHandler::OnParseJsonResponse,
                      GetWeakPtr(), std::move(result)));
 }
 
+void APIRequestHelper::URLLoaderHandler::SendResult(APIRequestResult result) {
+  DCHECK(result_callback_);
+  std::move(result_callback_).Run(std::move(result));
+}
+
 void APIRequestHelper::URLLoaderHandler::OnParseJsonResponse(
     APIRequestResult result,
     ValueOrError result_value) {
@@ -510,6 +861,28 @@ void APIRequestHelper::URLLoaderHandler::OnParseJsonResponse(
   std::move(result_callback_).Run(std::move(result));
 }
 
+void APIRequestHelper::URLLoaderHandler::OnParseJsonViewResponse(
+    APIRequestResult result,
+    base::expected<base::JSONView, base::JSONReader::Error> view) {
+  TRACE_EVENT1("wootz", "APIRequestHelper_ProcessJsonViewResultOnUI", "url",
+               result.final_url().spec());
+  if (!view.has_value()) {
+    VLOG(1) << "Response validation error:" << view.error().message;
+    std::move(result_callback_).Run(std::move(result));
+    return;
+  }
+  const base::JSONView::Node root = view->root();
+  if (!root.is_dict() && !root.is_list()) {
+    VLOG(1) << "Response validation error: Invalid top-level type";
+    std::move(result_callback_).Run(std::move(result));
+    return;
+  }
+
+  VLOG(2) << "Response validation successful";
+  result.json_view_body_ = std::move(view).value();
+  std::move(result_callback_).Run(std::move(result));
+}
+
 void APIRequestHelper::URLLoaderHandler::MaybeSendResult() {
   // Verify that counting hasn't gone wrong - it should never be less than 0.
   DCHECK_LE(0, current_decoding_operation_count_);
@@ -534,58 +907,146 @@ void APIRequestHelper::URLLoaderHandler::ParseSSE(
     std::string_view string_piece) {
   // New chunks should only be received before the request is completed
   DCHECK(!request_is_finished_);
-  // We split the string into multiple chunks because there are cases where
-  // multiple chunks are received in a single call.
-  std::vector<std::string_view> stream_data = base::SplitStringPiece(
-      string_piece, "\r\n", base::KEEP_WHITESPACE, base::SPLIT_WANT_NONEMPTY);
-
-  // Remove SSE events that don't look like JSON - could be string or [DONE]
-  // message.
-  // TODO(@nullhook): Parse both JSON and string values. The below currently
-  // only identifies JSON values.
-  static constexpr char kDataPrefix[] = "data: {";
-  std::erase_if(stream_data, [](std::string_view item) {
-    DVLOG(3) << "Received chunk: " << item;
-    if (!base::StartsWith(item, kDataPrefix)) {
+  // There are cases where multiple lines are received in a single chunk, and
+  // where a line is split across chunks. Lines are viewed in place in the
+  // chunk, only the line that continues from the previous chunk is copied.
+  static constexpr char kLineBreaks[] = "\r\n";
+  std::vector<std::string_view> lines;
+  std::string continued_line;
+  size_t line_start = 0;
+  if (!sse_partial_line_.empty()) {
+    const size_t line_end = string_piece.find_first_of(kLineBreaks);
+    if (line_end == std::string_view::npos) {
+      sse_partial_line_.append(string_piece);
+      return;
+    }
+    continued_line = std::move(sse_partial_line_);
+    sse_partial_line_.clear();
+    continued_line.append(string_piece.substr(0, line_end));
+    lines.push_back(continued_line);
+    line_start = line_end;
+  }
+  while (line_start < string_piece.size()) {
+    const size_t line_end =
+        string_piece.find_first_of(kLineBreaks, line_start);
+    if (line_end == std::string_view::npos) {
+      sse_partial_line_ = std::string(string_piece.substr(line_start));
+      break;
+    }
+    if (line_end > line_start) {
+      lines.push_back(string_piece.substr(line_start, line_end - line_start));
+    }
+    line_start = line_end + 1;
+  }
+
+  DispatchSSEEvents(lines);
+}
+
+void APIRequestHelper::URLLoaderHandler::DispatchSSEEvents(
+    const std::vector<std::string_view>& lines) {
+  static constexpr char kDataPrefix[] = "data:";
+  std::vector<std::string_view> payloads;
+  for (std::string_view line : lines) {
+    DVLOG(3) << "Received chunk: " << line;
+    if (!base::StartsWith(line, kDataPrefix)) {
       // This is useful to log in case an API starts
       // coming back with unknown data type in some
       // scenarios.
       VLOG(1) << "Data did not start with SSE prefix";
-      return true;
+      continue;
     }
-    return false;
-  });
+    std::string_view payload = line.substr(strlen(kDataPrefix));
+    // A single space after the field name isn't part of the value.
+    if (base::StartsWith(payload, " ")) {
+      payload.remove_prefix(1);
+    }
+    // Unless raw payloads are requested, remove SSE events that don't look
+    // like JSON - could be string or [DONE] message.
+    // TODO(@nullhook): Parse both JSON and string values. The below currently
+    // only identifies JSON values.
+    if (!raw_sse_data_ && !base::StartsWith(payload, "{")) {
+      continue;
+    }
+    payloads.push_back(payload);
+  }
+  if (payloads.empty()) {
+    return;
+  }
+  DCHECK(data_received_callback_);
+
+  if (raw_sse_data_) {
+    TRACE_EVENT0("wootz", "APIRequestHelper_ParseSSECallback");
+    ScopedPerfTracker tracker("Wootz.APIRequestHelper.ParseSSECallback");
+    if (batch_sse_events_) {
+      base::Value::List batch;
+      for (std::string_view payload : payloads) {
+        batch.Append(payload);
+      }
+      data_received_callback_.Run(base::Value(std::move(batch)));
+      return;
+    }
+    // Running the callback may delete `this`.
+    auto weak_this = weak_ptr_factory_.GetWeakPtr();
+    for (std::string_view payload : payloads) {
+      data_received_callback_.Run(base::Value(payload));
+      if (!weak_this) {
+        return;
+      }
+    }
+    return;
+  }
+
+  if (batch_sse_events_) {
+    base::UmaHistogramCounts100("Wootz.APIRequestHelper.SSEEventsPerBatch",
+                                payloads.size());
+    // Decode all the events of the chunk in a single operation, as the items
+    // of a JSON array.
+    std::string json = "[";
+    for (size_t i = 0; i < payloads.size(); ++i) {
+      base::StrAppend(&json, {i ? "," : "", payloads[i]});
+    }
+    json += "]";
+    current_decoding_operation_count_++;
+    ParseJsonImpl(
+        std::move(json),
+        base::BindOnce(&APIRequestHelper::URLLoaderHandler::OnSSEDataParsed,
+                       weak_ptr_factory_.GetWeakPtr(), payloads.size()));
+    return;
+  }
 
   // Keep track of number of in-progress data decoding operations
   // so that we can know if any are still in-progress when the request
   // completes.
-  current_decoding_operation_count_ += stream_data.size();
-
-  for (const auto& data : stream_data) {
-    auto json = data.substr(strlen(kDataPrefix) - 1);
-    auto on_json_parsed =
-        [](base::WeakPtr<APIRequestHelper::URLLoaderHandler> handler,
-           ValueOrError result) {
-          DVLOG(2) << "Chunk parsed";
-          if (!handler) {
-            return;
-          }
-          TRACE_EVENT0("wootz", "APIRequestHelper_ParseSSECallback");
-          ScopedPerfTracker tracker("Wootz.APIRequestHelper.ParseSSECallback");
-          handler->current_decoding_operation_count_--;
-          DCHECK(handler->data_received_callback_);
-          handler->data_received_callback_.Run(std::move(result));
-          // Parsing is potentially the last operation for |URLLoaderHandler|.
-          handler->MaybeSendResult();
-        };
+  current_decoding_operation_count_ += payloads.size();
 
+  for (std::string_view payload : payloads) {
     DVLOG(2) << "Going to call ParseJsonImpl";
-    ParseJsonImpl(std::string(json),
-                  base::BindOnce(std::move(on_json_parsed),
-                                 weak_ptr_factory_.GetWeakPtr()));
+    ParseJsonImpl(
+        std::string(payload),
+        base::BindOnce(&APIRequestHelper::URLLoaderHandler::OnSSEDataParsed,
+                       weak_ptr_factory_.GetWeakPtr(), size_t{1}));
   }
 }
 
+void APIRequestHelper::URLLoaderHandler::OnSSEDataParsed(
+    size_t event_count,
+    ValueOrError result) {
+  DVLOG(2) << "Chunk parsed";
+  TRACE_EVENT0("wootz", "APIRequestHelper_ParseSSECallback");
+  ScopedPerfTracker tracker("Wootz.APIRequestHelper.ParseSSECallback");
+  current_decoding_operation_count_--;
+  DCHECK(data_received_callback_);
+  // A batch is parsed as an array with an item per event. An event that isn't
+  // a single JSON value would change the number of items.
+  if (batch_sse_events_ && result.has_value() &&
+      (!result->is_list() || result->GetList().size() != event_count)) {
+    result = base::unexpected("Malformed server-sent event in batch");
+  }
+  data_received_callback_.Run(std::move(result));
+  // Parsing is potentially the last operation for |URLLoaderHandler|.
+  MaybeSendResult();
+}
+
 void APIRequestHelper::SetUrlLoaderFactoryForTesting(
     scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory) {
   url_loader_factory_ = std::move(url_loader_factory);
@@ -6,20 +6,29 @@
 #ifndef WOOTZ_COMPONENTS_API_REQUEST_HELPER_API_REQUEST_HELPER_H_
 #define WOOTZ_COMPONENTS_API_REQUEST_HELPER_API_REQUEST_HELPER_H_
 
+#include <stdint.h>
+
 #include <list>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/files/file_path.h"
 #include "base/functional/callback.h"
 #include "base/functional/callback_forward.h"
 #include "base/functional/callback_helpers.h"
+#include "base/json/json_view.h"
+#include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
 #include "base/types/expected.h"
 #include "base/values.h"
+#include "net/base/request_priority.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 #include "services/network/public/cpp/simple_url_loader.h"
 #include "services/network/public/cpp/simple_url_loader_stream_consumer.h"
@@ -55,6 +64,11 @@ class APIRequestResult {
   bool Is2XXResponseCode() const;
   bool IsResponseCodeValid() const;
 
+  // Returns a copy of the result. Can't be used on a result delivered as a
+  // base::JSONView.
+  // Note: don't clone large responses.
+  APIRequestResult Clone() const;
+
   // HTTP response code.
   int response_code() const { return response_code_; }
 
@@ -65,6 +79,13 @@ class APIRequestResult {
   // Note: don't clone large responses, use TakeBody() instead.
   const base::Value& value_body() const { return value_body_; }
 
+  // Returns the validated response as a read-only base::JSONView if the
+  // request was made with APIRequestOptions::deliver_json_view, and nullptr
+  // otherwise. value_body() is empty in that case.
+  const base::JSONView* json_view_body() const {
+    return json_view_body_ ? &json_view_body_.value() : nullptr;
+  }
+
   // Serialize the sanitized response and returns it as string.
   // Note: use TakeBody()/value_body() instead where possible.
   std::string SerializeBodyToString() const;
@@ -84,6 +105,7 @@ class APIRequestResult {
 
   int response_code_ = -1;
   base::Value value_body_;
+  std::optional<base::JSONView> json_view_body_;
   base::flat_map<std::string, std::string> headers_;
   int error_code_ = -1;
   GURL final_url_;
@@ -95,6 +117,39 @@ struct APIRequestOptions {
   bool enable_cache = false;
   size_t max_body_size = -1u;
   std::optional<base::TimeDelta> timeout;
+  // Deliver the response of Request() as APIRequestResult::json_view_body()
+  // instead of a base::Value. The response is validated and indexed by
+  // base::JSONView on the decoder sequence, and only the parts the consumer
+  // reads are ever decoded. Has no effect on RequestSSE().
+  bool deliver_json_view = false;
+  // Parse JSON responses with the Rust JSON reader on a ThreadPool worker of
+  // this process instead of sending them to the data decoder service, even if
+  // the UseWootzRustJSONSanitizer feature is disabled. This saves the IPC and
+  // the serialization of the parsed value, which dominate for small bodies.
+  bool parse_json_in_process = false;
+  // Deliver all the server-sent events completed by a received chunk to
+  // RequestSSE()'s DataReceivedCallback at once, as a list of values, and
+  // decode their JSON in a single operation. Has no effect on Request().
+  bool batch_sse_events = false;
+  // Deliver the payload of each server-sent `data:` event as a string without
+  // decoding it, including non-JSON payloads such as `[DONE]`. Has no effect on
+  // Request().
+  bool raw_sse_data = false;
+  // Let a Request() share the network request of an identical Request() that
+  // is still in progress, i.e. one with the same method, URL, payload and
+  // headers that also set this option. Each caller gets its own copy of the
+  // result. The options of the request that was issued first apply. Has no
+  // effect with deliver_json_view or a ResponseConversionCallback.
+  bool coalesce_identical_requests = false;
+  // If set, successful responses to GET Request()s without a payload are kept
+  // for this long, and a later Request() that sets this option for the same
+  // URL and headers gets a copy of the result without a network request. Has
+  // no effect with deliver_json_view or a ResponseConversionCallback.
+  std::optional<base::TimeDelta> response_cache_ttl;
+  // The priority of the network request. Also orders the Request()s that wait
+  // for a host at the limit set by SetMaxConcurrentRequestsPerHost(), so
+  // user-visible requests should use a higher priority than background ones.
+  net::RequestPriority priority = net::IDLE;
 };
 
 using ValueOrError = base::expected<base::Value, std::string>;
@@ -114,6 +169,12 @@ class APIRequestHelper {
   using ResponseConversionCallback =
       base::OnceCallback<std::optional<std::string>(
           const std::string& raw_response)>;
+  // Identifies the Request()s that can share a network request, see
+  // APIRequestOptions::coalesce_identical_requests.
+  using RequestKey = std::tuple<std::string,
+                                GURL,
+                                std::string,
+                                base::flat_map<std::string, std::string>>;
 
   class URLLoaderHandler : public network::SimpleURLLoaderStreamConsumer {
    public:
@@ -127,9 +188,14 @@ class APIRequestHelper {
     void SetResultCallback(ResultCallback result_callback);
     base::WeakPtr<URLLoaderHandler> GetWeakPtr();
 
+    // Feeds `string_piece` as received data. Unless `is_complete_response` is
+    // false, it is a whole response and its last line is complete.
     void send_sse_data_for_testing(std::string_view string_piece,
                                    bool is_sse,
-                                   DataReceivedCallback callback);
+                                   DataReceivedCallback callback,
+                                   bool is_complete_response = true);
+    void set_request_options_for_testing(
+        const APIRequestOptions& request_options);
 
    private:
     friend class APIRequestHelper;
@@ -141,7 +207,12 @@ class APIRequestHelper {
     // If Cancel is needed even if url or data operations are in progress,
     // then call |APIRequestHelper::Cancel|.
     void MaybeSendResult();
+    // Splits `string_piece` into lines, and dispatches the `data:` events of
+    // the complete ones. A line that doesn't end in the chunk is kept in
+    // `sse_partial_line_` until a following chunk completes it.
     void ParseSSE(std::string_view string_piece);
+    void DispatchSSEEvents(const std::vector<std::string_view>& lines);
+    void OnSSEDataParsed(size_t event_count, ValueOrError result);
 
     // network::SimpleURLLoaderStreamConsumer implementation:
     void OnDataReceived(std::string_view string_piece,
@@ -156,6 +227,13 @@ class APIRequestHelper {
     // Decode one shot responses
     void OnParseJsonResponse(APIRequestResult result,
                              ValueOrError result_value);
+    void OnParseJsonViewResponse(
+        APIRequestResult result,
+        base::expected<base::JSONView, base::JSONReader::Error> view);
+
+    // Completes a request that got its result from another request or from
+    // the response cache.
+    void SendResult(APIRequestResult result);
 
     std::unique_ptr<network::SimpleURLLoader> url_loader_;
     raw_ptr<APIRequestHelper> api_request_helper_;
@@ -166,6 +244,19 @@ class APIRequestHelper {
     ResponseConversionCallback conversion_callback_;
 
     bool is_sse_ = false;
+    // Whether one shot responses are delivered as a base::JSONView.
+    bool deliver_json_view_ = false;
+    // Whether JSON is parsed on `task_runner_` instead of by `data_decoder_`.
+    bool parse_json_in_process_ = false;
+    bool batch_sse_events_ = false;
+    bool raw_sse_data_ = false;
+    // The beginning of an event stream line that the last chunk didn't end.
+    std::string sse_partial_line_;
+    // Set if other requests are coalesced with this one while it's in
+    // progress.
+    std::optional<RequestKey> coalescing_key_;
+    // Set while the request counts toward the concurrency limit of the host.
+    std::optional<std::string> limited_host_;
 
     // To ensure ordered processing of stream chunks, we create our own
     // instance of DataDecoder per request. This avoids the issue
@@ -238,6 +329,21 @@ class APIRequestHelper {
   void SetUrlLoaderFactoryForTesting(
       scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory);
 
+  // The number of Request()s that used the response cache and found, or
+  // didn't find, a response in it.
+  size_t response_cache_hit_count() const { return response_cache_hit_count_; }
+  size_t response_cache_miss_count() const {
+    return response_cache_miss_count_;
+  }
+  // The number of Request()s that shared the network request of another one.
+  size_t coalesced_request_count() const { return coalesced_request_count_; }
+
+  // Limits the number of Request()s to the same host that are in progress at
+  // once. The requests over the limit are queued, and start by priority, then
+  // in the order they were made. 0, the default, means no limit. Doesn't apply
+  // to RequestSSE().
+  void SetMaxConcurrentRequestsPerHost(size_t max_requests);
+
  private:
   APIRequestHelper(const APIRequestHelper&) = delete;
   APIRequestHelper& operator=(const APIRequestHelper&) = delete;
@@ -250,6 +356,7 @@ class APIRequestHelper {
       bool auto_retry_on_network_change,
       bool enable_cache,
       bool allow_http_error_result,
+      net::RequestPriority priority,
       const base::flat_map<std::string, std::string>& headers);
 
   // TODO(petemill): When Download has been removed, we don't need two versions
@@ -267,10 +374,77 @@ class APIRequestHelper {
                            ResultCallback callback,
                            APIRequestResult result);
 
+  // Runs `start` now if the host of `url` is under the concurrency limit, or
+  // when a request to the host finishes otherwise.
+  void StartOrQueueRequest(URLLoaderHandler* handler,
+                           const GURL& url,
+                           net::RequestPriority priority,
+                           base::OnceClosure start);
+  void StartDownload(base::WeakPtr<URLLoaderHandler> handler,
+                     size_t max_body_size,
+                     ResponseConversionCallback conversion_callback);
+  // Releases the slot of `handler` in the concurrency limit of its host, and
+  // starts the queued requests that fit.
+  void OnRequestFinished(URLLoaderHandler* handler);
+  void StartQueuedRequests(const std::string& host);
+
+  // Returns a copy of the cached response for `key`, if it hasn't expired.
+  std::optional<APIRequestResult> GetCachedResponse(const RequestKey& key);
+  void AddCachedResponse(const RequestKey& key,
+                         const APIRequestResult& result,
+                         base::TimeDelta ttl);
+
+  // Called with the result of a request that other requests may have been
+  // coalesced with, or whose response may be cached.
+  void OnShareableRequestComplete(RequestKey key,
+                                  bool coalesced,
+                                  std::optional<base::TimeDelta> cache_ttl,
+                                  ResultCallback callback,
+                                  APIRequestResult result);
+
   net::NetworkTrafficAnnotationTag annotation_tag_;
   URLLoaderHandlerList url_loaders_;
   scoped_refptr<network::SharedURLLoaderFactory> url_loader_factory_;
   const scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  // The requests that are coalesced with each in-progress request.
+  std::map<RequestKey, std::vector<base::WeakPtr<URLLoaderHandler>>>
+      coalesced_requests_;
+
+  struct CachedResponse {
+    APIRequestResult result;
+    base::TimeTicks expiry_time;
+  };
+  std::map<RequestKey, CachedResponse> response_cache_;
+  size_t response_cache_hit_count_ = 0;
+  size_t response_cache_miss_count_ = 0;
+  size_t coalesced_request_count_ = 0;
+
+  struct QueuedRequest {
+    QueuedRequest();
+    QueuedRequest(QueuedRequest&&);
+    QueuedRequest& operator=(QueuedRequest&&);
+    ~QueuedRequest();
+
+    base::WeakPtr<URLLoaderHandler> handler;
+    net::RequestPriority priority = net::IDLE;
+    base::TimeTicks queue_time;
+    base::OnceClosure start;
+  };
+  struct HostRequests {
+    HostRequests();
+    HostRequests(HostRequests&&);
+    HostRequests& operator=(HostRequests&&);
+    ~HostRequests();
+
+    size_t running_count = 0;
+    // Ordered by decreasing priority, then by the order of the requests.
+    std::map<std::pair<int, uint64_t>, QueuedRequest> queue;
+  };
+  size_t max_requests_per_host_ = 0;
+  std::map<std::string, HostRequests> host_requests_;
+  uint64_t next_queue_sequence_number_ = 0;
+
   base::WeakPtrFactory<APIRequestHelper> weak_ptr_factory_{this};
 };
 
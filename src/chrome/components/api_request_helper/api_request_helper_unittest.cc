@@ -7,21 +7,31 @@
 
 #include <memory>
 #include <optional>
+#include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "base/functional/callback.h"
+#include "base/functional/callback_helpers.h"
+#include "base/run_loop.h"
+#include "base/strings/strcat.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/mock_callback.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/task_environment.h"
 #include "base/test/values_test_util.h"
 #include "base/values.h"
 #include "net/base/load_flags.h"
+#include "net/base/net_errors.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 #include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
 #include "services/data_decoder/public/cpp/test_support/in_process_data_decoder.h"
 #include "services/network/public/cpp/weak_wrapper_shared_url_loader_factory.h"
 #include "services/network/test/test_url_loader_factory.h"
+#include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 using base::test::ParseJson;
@@ -41,6 +51,17 @@ std::optional<std::string> ConversionCallback(
   EXPECT_EQ(expected_raw_response, raw_response);
   return converted_response;
 }
+
+// Returns a JSON array of `count` small objects.
+std::string MakeJsonArray(size_t count) {
+  std::string json = "[";
+  for (size_t i = 0; i < count; ++i) {
+    base::StrAppend(&json, {i ? "," : "", "{\"id\":", base::NumberToString(i),
+                            ",\"name\":\"item\"}"});
+  }
+  json += "]";
+  return json;
+}
 }  // namespace
 
 class ApiRequestHelperUnitTest : public testing::Test {
@@ -66,6 +87,7 @@ class ApiRequestHelperUnitTest : public testing::Test {
     url_loader_factory_.SetInterceptor(base::BindLambdaForTesting(
         [&, expected_method, expected_url, content_to_respond,
          enable_cache](const network::ResourceRequest& request) {
+          network_request_count_++;
           url_loader_factory_.ClearResponses();
           EXPECT_EQ(request.url, expected_url);
           EXPECT_EQ(request.method, expected_method);
@@ -110,6 +132,22 @@ class ApiRequestHelperUnitTest : public testing::Test {
                                                        std::move(callback));
   }
 
+  // Sends a chunk of an event stream, which may end in the middle of a line.
+  void SendChunkSSE(std::string_view string_piece,
+                    APIRequestHelper::DataReceivedCallback callback) {
+    loader_wrapper_handler_->send_sse_data_for_testing(
+        string_piece, true, std::move(callback),
+        /*is_complete_response=*/false);
+  }
+
+  network::TestURLLoaderFactory& url_loader_factory() {
+    return url_loader_factory_;
+  }
+
+  void SetSSEOptions(const APIRequestOptions& request_options) {
+    loader_wrapper_handler_->set_request_options_for_testing(request_options);
+  }
+
   void SendMessageSSE(std::string_view string_piece,
                       APIRequestHelper::DataReceivedCallback callback) {
     loader_wrapper_handler_->send_sse_data_for_testing(string_piece, false,
@@ -118,7 +156,10 @@ class ApiRequestHelperUnitTest : public testing::Test {
 
  protected:
   std::unique_ptr<APIRequestHelper> api_request_helper_;
-  base::test::TaskEnvironment task_environment_;
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  // The number of requests that reached the network.
+  int network_request_count_ = 0;
 
  private:
   network::TestURLLoaderFactory url_loader_factory_;
@@ -200,6 +241,45 @@ TEST_F(ApiRequestHelperUnitTest, EnableCache) {
               base::NullCallback(), true);
 }
 
+TEST_F(ApiRequestHelperUnitTest, DeliverJsonView) {
+  GURL network_url("http://localhost/");
+  SetInterceptor("POST", network_url,
+                 "{\"id\":1,\"result\":{\"name\":\"a\\u0062c\"}}", false);
+  APIRequestOptions options;
+  options.deliver_json_view = true;
+
+  base::RunLoop run_loop;
+  api_request_helper_->Request(
+      "POST", network_url, "", "application/json",
+      base::BindLambdaForTesting([&](APIRequestResult result) {
+        run_loop.Quit();
+        EXPECT_TRUE(result.value_body().is_none());
+        const base::JSONView* view = result.json_view_body();
+        ASSERT_TRUE(view);
+        EXPECT_EQ(1, view->root().Find("id")->GetIfInt());
+        EXPECT_EQ("abc",
+                  view->root().FindByDottedPath("result.name")->GetIfString());
+      }),
+      {}, options);
+  run_loop.Run();
+
+  // Invalid JSON and top-level values other than dicts and lists are rejected
+  // as they are without the option.
+  for (const char* response : {"{", "0", "{\"a\":1,}"}) {
+    SetInterceptor("POST", network_url, response, false);
+    base::RunLoop invalid_run_loop;
+    api_request_helper_->Request(
+        "POST", network_url, "", "application/json",
+        base::BindLambdaForTesting([&](APIRequestResult result) {
+          EXPECT_FALSE(result.json_view_body());
+          EXPECT_TRUE(result.value_body().is_none());
+          invalid_run_loop.Quit();
+        }),
+        {}, options);
+    invalid_run_loop.Run();
+  }
+}
+
 TEST_F(ApiRequestHelperUnitTest, URLLoaderHandlerParsing) {
   base::RunLoop run_loop;
   SendMessageSSE("data: [DONE]",
@@ -252,4 +332,238 @@ TEST_F(ApiRequestHelperUnitTest, SSEJsonParsing) {
   task_environment_.RunUntilIdle();
 }
 
+TEST_F(ApiRequestHelperUnitTest, ParseJsonInProcess) {
+  // Use the data decoder service unless the request opts into in-process
+  // parsing.
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitFromCommandLine("", "UseWootzRustJSONSanitizer");
+
+  GURL network_url("http://localhost/");
+  // Bodies of about 1KB, 64KB and 1MB, one for each histogram size class.
+  const struct {
+    size_t count;
+    const char* suffix;
+  } kPayloads[] = {{40, "Small"}, {2500, "Medium"}, {40000, "Large"}};
+  for (const auto& payload : kPayloads) {
+    const std::string json = MakeJsonArray(payload.count);
+    base::Value results[2];
+    for (bool in_process : {false, true}) {
+      base::HistogramTester histogram_tester;
+      SetInterceptor("POST", network_url, json, false);
+      APIRequestOptions options;
+      options.parse_json_in_process = in_process;
+
+      base::RunLoop run_loop;
+      api_request_helper_->Request(
+          "POST", network_url, "", "application/json",
+          base::BindLambdaForTesting([&](APIRequestResult result) {
+            results[in_process] = result.value_body().Clone();
+            run_loop.Quit();
+          }),
+          {}, options);
+      run_loop.Run();
+
+      histogram_tester.ExpectTotalCount(
+          base::StrCat({"Wootz.APIRequestHelper.ParseJsonLatency.",
+                        in_process ? "InProcess." : "DataDecoder.",
+                        payload.suffix}),
+          1);
+      histogram_tester.ExpectTotalCount(
+          base::StrCat({"Wootz.APIRequestHelper.ParseJsonLatency.",
+                        in_process ? "DataDecoder." : "InProcess.",
+                        payload.suffix}),
+          0);
+    }
+
+    // Both parsers give the same result.
+    ASSERT_TRUE(results[0].is_list());
+    EXPECT_EQ(payload.count, results[0].GetList().size());
+    EXPECT_EQ(results[0], results[1]);
+  }
+}
+
+TEST_F(ApiRequestHelperUnitTest, SSEEventSpanningChunks) {
+  std::vector<ValueOrError> results;
+  auto callback = base::BindLambdaForTesting(
+      [&](ValueOrError result) { results.push_back(std::move(result)); });
+
+  // The first line isn't dispatched before it is complete.
+  SendChunkSSE("data: {\"a\"", callback);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(results.empty());
+  SendChunkSSE(":1", callback);
+  task_environment_.RunUntilIdle();
+  EXPECT_TRUE(results.empty());
+
+  SendChunkSSE("}\r\ndata: {\"b\":2}\r\ndata: {\"c\"", callback);
+  task_environment_.RunUntilIdle();
+  ASSERT_EQ(2u, results.size());
+  EXPECT_EQ(1, results[0]->GetDict().FindInt("a"));
+  EXPECT_EQ(2, results[1]->GetDict().FindInt("b"));
+
+  // The end of the response completes the last line.
+  SendMessageSSEJSON(":3}", callback);
+  task_environment_.RunUntilIdle();
+  ASSERT_EQ(3u, results.size());
+  EXPECT_EQ(3, results[2]->GetDict().FindInt("c"));
+}
+
+TEST_F(ApiRequestHelperUnitTest, SSEBatchedEvents) {
+  APIRequestOptions options;
+  options.batch_sse_events = true;
+  SetSSEOptions(options);
+
+  std::vector<ValueOrError> results;
+  auto callback = base::BindLambdaForTesting(
+      [&](ValueOrError result) { results.push_back(std::move(result)); });
+  SendChunkSSE("data: {\"a\":1}\n\ndata: {\"a\":2}\ndata: [DONE]\ndata: {",
+               callback);
+  task_environment_.RunUntilIdle();
+  ASSERT_EQ(1u, results.size());
+  ASSERT_TRUE(results[0].has_value());
+  EXPECT_EQ(ParseJson("[{\"a\":1},{\"a\":2}]"), *results[0]);
+
+  // An event that isn't a single JSON value fails the batch.
+  results.clear();
+  SendMessageSSEJSON("\"a\":3},{\"b\":4}", callback);
+  task_environment_.RunUntilIdle();
+  ASSERT_EQ(1u, results.size());
+  EXPECT_FALSE(results[0].has_value());
+}
+
+TEST_F(ApiRequestHelperUnitTest, SSERawData) {
+  APIRequestOptions options;
+  options.raw_sse_data = true;
+  SetSSEOptions(options);
+
+  // Raw payloads are delivered without decoding.
+  std::vector<ValueOrError> results;
+  auto callback = base::BindLambdaForTesting(
+      [&](ValueOrError result) { results.push_back(std::move(result)); });
+  SendMessageSSEJSON("data: {\"a\":1}\ndata:[DONE]", callback);
+  ASSERT_EQ(2u, results.size());
+  EXPECT_EQ("{\"a\":1}", results[0]->GetString());
+  EXPECT_EQ("[DONE]", results[1]->GetString());
+
+  options.batch_sse_events = true;
+  SetSSEOptions(options);
+  results.clear();
+  SendMessageSSEJSON("data: one\r\ndata: two\r\n", callback);
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ(ParseJson("[\"one\",\"two\"]"), *results[0]);
+}
+
+TEST_F(ApiRequestHelperUnitTest, CoalesceIdenticalRequests) {
+  GURL network_url("http://localhost/");
+  SetInterceptor("GET", network_url, "{\"a\":1}", false);
+  APIRequestOptions options;
+  options.coalesce_identical_requests = true;
+
+  std::vector<APIRequestResult> results;
+  auto callback = base::BindLambdaForTesting(
+      [&](APIRequestResult result) { results.push_back(std::move(result)); });
+  api_request_helper_->Request("GET", network_url, "", "", callback, {},
+                               options);
+  api_request_helper_->Request("GET", network_url, "", "", callback, {},
+                               options);
+  // Requests with other headers aren't coalesced.
+  api_request_helper_->Request("GET", network_url, "", "", callback,
+                               {{"x-test", "1"}}, options);
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(2, network_request_count_);
+  EXPECT_EQ(1u, api_request_helper_->coalesced_request_count());
+  ASSERT_EQ(3u, results.size());
+  for (const auto& result : results) {
+    EXPECT_EQ(ParseJson("{\"a\":1}"), result.value_body());
+  }
+
+  // Requests that were coalesced with a cancelled request are aborted.
+  results.clear();
+  auto ticket = api_request_helper_->Request("GET", network_url, "", "",
+                                             callback, {}, options);
+  api_request_helper_->Request("GET", network_url, "", "", callback, {},
+                               options);
+  api_request_helper_->Cancel(ticket);
+  task_environment_.RunUntilIdle();
+  ASSERT_EQ(1u, results.size());
+  EXPECT_EQ(net::ERR_ABORTED, results[0].error_code());
+}
+
+TEST_F(ApiRequestHelperUnitTest, ResponseCache) {
+  GURL network_url("http://localhost/");
+  SetInterceptor("GET", network_url, "{\"a\":1}", false);
+  APIRequestOptions options;
+  options.response_cache_ttl = base::Minutes(1);
+
+  auto request = [&]() {
+    APIRequestResult request_result;
+    base::RunLoop run_loop;
+    api_request_helper_->Request(
+        "GET", network_url, "", "",
+        base::BindLambdaForTesting([&](APIRequestResult result) {
+          request_result = std::move(result);
+          run_loop.Quit();
+        }),
+        {}, options);
+    run_loop.Run();
+    return request_result;
+  };
+
+  EXPECT_EQ(ParseJson("{\"a\":1}"), request().value_body());
+  EXPECT_EQ(1, network_request_count_);
+  EXPECT_EQ(0u, api_request_helper_->response_cache_hit_count());
+  EXPECT_EQ(1u, api_request_helper_->response_cache_miss_count());
+
+  // The second request is answered from the cache.
+  APIRequestResult cached_result = request();
+  EXPECT_EQ(ParseJson("{\"a\":1}"), cached_result.value_body());
+  EXPECT_EQ(200, cached_result.response_code());
+  EXPECT_EQ(1, network_request_count_);
+  EXPECT_EQ(1u, api_request_helper_->response_cache_hit_count());
+
+  // The response expires after the TTL.
+  task_environment_.FastForwardBy(base::Minutes(1));
+  request();
+  EXPECT_EQ(2, network_request_count_);
+  EXPECT_EQ(2u, api_request_helper_->response_cache_miss_count());
+}
+
+TEST_F(ApiRequestHelperUnitTest, PerHostConcurrencyLimit) {
+  api_request_helper_->SetMaxConcurrentRequestsPerHost(1);
+  std::vector<std::string> network_requests;
+  url_loader_factory().SetInterceptor(
+      base::BindLambdaForTesting([&](const network::ResourceRequest& request) {
+        network_requests.push_back(request.url.spec());
+        EXPECT_EQ(request.url.path() == "/visible" ? net::HIGHEST : net::IDLE,
+                  request.priority);
+        url_loader_factory().AddResponse(request.url.spec(), "{}");
+      }));
+
+  base::HistogramTester histogram_tester;
+  auto request = [&](const std::string& url, net::RequestPriority priority) {
+    APIRequestOptions options;
+    options.priority = priority;
+    return api_request_helper_->Request("GET", GURL(url), "", "",
+                                        base::DoNothing(), {}, options);
+  };
+  request("http://a.test/poll1", net::IDLE);
+  request("http://a.test/poll2", net::IDLE);
+  auto cancelled = request("http://a.test/poll3", net::IDLE);
+  request("http://a.test/visible", net::HIGHEST);
+  // Other hosts have their own limit.
+  request("http://b.test/poll1", net::IDLE);
+  api_request_helper_->Cancel(cancelled);
+  task_environment_.RunUntilIdle();
+
+  // The user-visible request jumps ahead of the queued background request.
+  EXPECT_THAT(network_requests,
+              testing::ElementsAre("http://a.test/poll1", "http://b.test/poll1",
+                                   "http://a.test/visible",
+                                   "http://a.test/poll2"));
+  histogram_tester.ExpectTotalCount(
+      "Wootz.APIRequestHelper.QueueWaitTime.IDLE", 3);
+  histogram_tester.ExpectTotalCount(
+      "Wootz.APIRequestHelper.QueueWaitTime.HIGHEST", 1);
+}
+
 }  // namespace api_request_helper
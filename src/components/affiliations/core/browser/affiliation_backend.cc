@@ -364,7 +364,7 @@ void AffiliationBackend::OnFetchSucceeded(
 
   // A subsequent fetch may be needed if any additional
   // GetAffiliationsAndBranding() requests came in while the current fetch was
-  // in flight.
+  // in flight, or if not all facets fit into the current fetch.
   for (const auto& facet_manager_pair : facet_managers_) {
     if (facet_manager_pair.second->DoesRequireFetch()) {
       throttler_->SignalNetworkRequestNeeded();
@@ -376,13 +376,21 @@ void AffiliationBackend::OnFetchSucceeded(
 void AffiliationBackend::OnFetchFailed(AffiliationFetcherInterface* fetcher) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
+  std::vector<FacetURI> requested_facet_uris =
+      fetcher_->GetRequestedFacetURIs();
   fetcher_.reset();
   throttler_->InformOfNetworkRequestComplete(false);
 
+  // Notify the facets of the failed request to finish single attempt fetches.
+  // Facets that did not fit into the request have not been attempted yet.
+  for (const FacetURI& facet_uri : requested_facet_uris) {
+    auto facet_manager_it = facet_managers_.find(facet_uri);
+    if (facet_manager_it != facet_managers_.end())
+      facet_manager_it->second->OnFetchFailed();
+  }
+
   // Trigger a retry if a fetch is still needed.
   for (const auto& facet_manager_pair : facet_managers_) {
-    // Notify all fetchers about failure to finish single attempt fetches.
-    facet_manager_pair.second->OnFetchFailed();
     if (facet_manager_pair.second->DoesRequireFetch()) {
       throttler_->SignalNetworkRequestNeeded();
       return;
@@ -402,6 +410,8 @@ bool AffiliationBackend::OnCanSendNetworkRequest() {
   DCHECK(!fetcher_);
   std::vector<FacetURI> requested_facet_uris;
   for (const auto& facet_manager_pair : facet_managers_) {
+    if (requested_facet_uris.size() == kMaxFacetsPerFetch)
+      break;
     if (facet_manager_pair.second->DoesRequireFetch())
       requested_facet_uris.push_back(facet_manager_pair.first);
   }
@@ -61,6 +61,11 @@ class AffiliationBackend : public FacetManagerHost,
  public:
   using StrategyOnCacheMiss = AffiliationService::StrategyOnCacheMiss;
 
+  // The maximum number of facets looked up by a single network request. When
+  // more facets need to be fetched, e.g. on the first sync of a large password
+  // store, they are looked up by consecutive requests.
+  static constexpr size_t kMaxFacetsPerFetch = 100;
+
   // Constructs an instance that will use |url_loader_factory| for all
   // network requests, use |task_runner| for asynchronous tasks, and will rely
   // on |time_source| and |time_tick_source| to tell the current time/ticks.
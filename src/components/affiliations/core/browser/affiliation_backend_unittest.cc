@@ -14,6 +14,7 @@
 #include "base/memory/raw_ptr.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_refptr.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/test/mock_callback.h"
 #include "base/test/task_environment.h"
 #include "base/test/test_mock_time_task_runner.h"
@@ -553,6 +554,35 @@ TEST_F(AffiliationBackendTest, RetryIsMadeOnFailedFetch) {
   EXPECT_EQ(0u, backend_facet_manager_count());
 }
 
+TEST_F(AffiliationBackendTest, LargeFetchesAreSplitIntoBatches) {
+  const base::Time keep_fresh_until =
+      backend_task_runner()->Now() + GetShortTestPeriod();
+  for (size_t i = 0; i <= AffiliationBackend::kMaxFacetsPerFetch; ++i) {
+    FacetURI facet_uri = FacetURI::FromCanonicalSpec(
+        "https://" + base::NumberToString(i) + ".example.net");
+    fake_affiliation_api()->AddTestEquivalenceClass({Facet(facet_uri)});
+    Prefetch(facet_uri, keep_fresh_until);
+  }
+
+  ASSERT_NO_FATAL_FAILURE(ExpectNeedForFetchAndLetItBeSent());
+  EXPECT_EQ(AffiliationBackend::kMaxFacetsPerFetch,
+            fake_affiliation_api()->GetNextRequestedFacets().size());
+  mock_fetch_throttler()->ExpectInformOfNetworkRequestComplete(true);
+  fake_affiliation_api()->ServeNextRequest();
+  testing::Mock::VerifyAndClearExpectations(mock_fetch_throttler());
+
+  // The facet that did not fit into the first fetch is looked up next.
+  ASSERT_NO_FATAL_FAILURE(ExpectNeedForFetchAndLetItBeSent());
+  EXPECT_EQ(1u, fake_affiliation_api()->GetNextRequestedFacets().size());
+  mock_fetch_throttler()->ExpectInformOfNetworkRequestComplete(true);
+  fake_affiliation_api()->ServeNextRequest();
+  testing::Mock::VerifyAndClearExpectations(mock_fetch_throttler());
+
+  ASSERT_NO_FATAL_FAILURE(ExpectNoFetchNeeded());
+  EXPECT_EQ(AffiliationBackend::kMaxFacetsPerFetch + 1,
+            GetNumOfEquivalenceClassInDatabase());
+}
+
 // The Prefetch() request expires before fetching corresponding affiliation
 // information would be allowed. The fetch should be abandoned.
 TEST_F(AffiliationBackendTest, FetchIsNoLongerNeededOnceAllowed) {
@@ -70,6 +70,7 @@ namespace {
 }
 
 allocation_recorder::MemoryOperation ConvertSingleRecord(
+    const base::debug::tracer::AllocationTraceRecorder& recorder,
     const base::debug::tracer::OperationRecord& src_record) {
   allocation_recorder::MemoryOperation data;
 
@@ -79,7 +80,8 @@ allocation_recorder::MemoryOperation ConvertSingleRecord(
       base::debug::tracer::OperationType::kAllocation) {
     data.set_size(src_record.GetSize());
   }
-  *(data.mutable_stack_trace()) = ConvertCallStack(src_record.GetStackTrace());
+  *(data.mutable_stack_trace()) =
+      ConvertCallStack(recorder.GetStackTrace(src_record));
 
   return data;
 }
@@ -91,7 +93,7 @@ ConvertMemoryOperations(
 
   for (size_t operation_index = 0; operation_index < recorder.size();
        ++operation_index) {
-    data.Add(ConvertSingleRecord(recorder[operation_index]));
+    data.Add(ConvertSingleRecord(recorder, recorder[operation_index]));
   }
 
   return data;
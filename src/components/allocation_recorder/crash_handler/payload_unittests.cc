@@ -40,8 +40,12 @@ void CreateFakeAllocationData(AllocationTraceRecorder& recorder,
 }
 
 void VerifyAllocationEntriesAreEqual(
+    const base::debug::tracer::AllocationTraceRecorder& recorder,
     const base::debug::tracer::OperationRecord& source_entry,
     const ::allocation_recorder::MemoryOperation& report_entry) {
+  const base::debug::tracer::StackTraceContainer& source_stack_trace =
+      recorder.GetStackTrace(source_entry);
+
   EXPECT_EQ(reinterpret_cast<uint64_t>(source_entry.GetAddress()),
             report_entry.address());
 
@@ -69,7 +73,7 @@ void VerifyAllocationEntriesAreEqual(
 
   ASSERT_TRUE(report_entry.has_stack_trace());
   ASSERT_LE(std::ssize(report_entry.stack_trace().frames()),
-            std::ssize(source_entry.GetStackTrace()));
+            std::ssize(source_stack_trace));
 
   const auto& report_frames = report_entry.stack_trace().frames();
   std::vector<const void*> converted_frames;
@@ -81,11 +85,11 @@ void VerifyAllocationEntriesAreEqual(
 
   const auto [converted_call_stack_mismatch, source_call_stack_mismatch] =
       std::mismatch(std::begin(converted_frames), std::end(converted_frames),
-                    std::begin(source_entry.GetStackTrace()));
+                    std::begin(source_stack_trace));
 
   ASSERT_EQ(converted_call_stack_mismatch, std::end(converted_frames));
   EXPECT_TRUE(std::all_of(source_call_stack_mismatch,
-                          std::end(source_entry.GetStackTrace()),
+                          std::end(source_stack_trace),
                           [](const void* ptr) { return ptr == nullptr; }));
 }
 
@@ -135,7 +139,7 @@ TEST_F(CreatePayloadWithMemoryOperationReportTest, Verify) {
     const auto& converted_entry =
         payload.operation_report().memory_operations().at(entry_index);
 
-    VerifyAllocationEntriesAreEqual(source_entry, converted_entry);
+    VerifyAllocationEntriesAreEqual(recorder, source_entry, converted_entry);
   }
 }
 
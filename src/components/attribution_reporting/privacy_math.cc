@@ -7,6 +7,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <functional>
 #include <iterator>
@@ -196,23 +197,47 @@ void GetReportsFromIndexRecursive(TriggerSpecs::Iterator it,
   NOTREACHED_IN_MIGRATION();
 }
 
-absl::uint128 GetNumStatesCached(const TriggerSpecs& specs,
-                                 int max_reports,
-                                 internal::StateMap& map) {
+absl::uint128 GetNumStatesImpl(const TriggerSpecs& specs, int max_reports) {
   if (specs.empty() || max_reports == 0) {
     return 1;
   }
 
-  auto it = specs.begin();
-  size_t num_windows = (*it).second.event_report_windows().end_times().size();
-
-  // Optimized fast-path.
-  if (specs.SingleSharedSpec()) {
-    return internal::GetNumberOfStarsAndBarsSequences(
-        /*num_stars=*/max_reports,
-        /*num_bars=*/specs.size() * num_windows);
+  // Every trigger data currently allows up to `max_reports` reports (see the
+  // TODO in `GetNumStatesRecursive()`), so the per-type limits never bind and
+  // the recurrence above reduces to distributing at most `max_reports` reports
+  // among all windows of all trigger data. That is a stars and bars sequence
+  // with one bar per window, whether or not the specs are shared.
+  size_t num_bars = 0;
+  for (auto [trigger_data, spec] : specs) {
+    num_bars += spec.event_report_windows().end_times().size();
   }
-  return GetNumStatesRecursive(it, max_reports, num_windows, max_reports, map);
+  return internal::GetNumberOfStarsAndBarsSequences(
+      /*num_stars=*/max_reports, /*num_bars=*/num_bars);
+}
+
+// Bounds of the precomputed binomial coefficients. With at most 20 reports,
+// 5 windows, and 32 trigger data values, the stars and bars sequences need
+// (n choose k) for n up to 180 and k up to 20.
+constexpr int kMaxPrecomputedBinomialN = 180;
+constexpr int kMaxPrecomputedBinomialK = 20;
+
+using BinomialTable =
+    std::array<std::array<absl::uint128, kMaxPrecomputedBinomialK + 1>,
+               kMaxPrecomputedBinomialN + 1>;
+
+// Returns Pascal's triangle up to the bounds above, computed once.
+const BinomialTable& GetBinomialTable() {
+  static const BinomialTable table = [] {
+    BinomialTable t{};
+    for (int n = 0; n <= kMaxPrecomputedBinomialN; ++n) {
+      t[n][0] = 1;
+      for (int k = 1; k <= std::min(n, kMaxPrecomputedBinomialK); ++k) {
+        t[n][k] = t[n - 1][k - 1] + t[n - 1][k];
+      }
+    }
+    return t;
+  }();
+  return table;
 }
 
 }  // namespace
@@ -254,8 +279,7 @@ double GetRandomizedResponseRate(absl::uint128 num_states, double epsilon) {
 
 absl::uint128 GetNumStates(const TriggerSpecs& specs,
                            MaxEventLevelReports max_reports) {
-  internal::StateMap map;
-  return GetNumStatesCached(specs, max_reports, map);
+  return GetNumStatesImpl(specs, max_reports);
 }
 
 base::expected<RandomizedResponseData, RandomizedResponseError>
@@ -310,6 +334,10 @@ absl::uint128 BinomialCoefficient(int n, int k) {
     k = n - k;
   }
 
+  if (n <= kMaxPrecomputedBinomialN && k <= kMaxPrecomputedBinomialK) {
+    return GetBinomialTable()[n][k];
+  }
+
   // (n choose k) = n (n -1) ... (n - (k - 1)) / k!
   // = mul((n + 1 - i) / i), i from 1 -> k.
   //
@@ -530,7 +558,7 @@ DoRandomizedResponseWithCache(const TriggerSpecs& specs,
                               StateMap& map,
                               absl::uint128 max_trigger_state_cardinality,
                               double max_channel_capacity) {
-  const absl::uint128 num_states = GetNumStatesCached(specs, max_reports, map);
+  const absl::uint128 num_states = GetNumStatesImpl(specs, max_reports);
   if (num_states > max_trigger_state_cardinality) {
     return base::unexpected(
         RandomizedResponseError::kExceedsTriggerStateCardinalityLimit);
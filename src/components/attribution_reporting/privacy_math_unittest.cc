@@ -74,6 +74,22 @@ TEST(PrivacyMathTest, BinomialCoefficient) {
   }
 }
 
+// Coefficients inside the precomputed table must agree with the ones computed
+// outside of it.
+TEST(PrivacyMathTest, BinomialCoefficient_PrecomputedBounds) {
+  EXPECT_EQ(internal::BinomialCoefficient(180, 20),
+            absl::MakeUint128(/*high=*/9494472u,
+                              /*low=*/10758590974061625903u));
+  EXPECT_EQ(internal::BinomialCoefficient(181, 20),
+            internal::BinomialCoefficient(180, 20) +
+                internal::BinomialCoefficient(180, 19));
+  EXPECT_EQ(internal::BinomialCoefficient(60, 21),
+            internal::BinomialCoefficient(59, 21) +
+                internal::BinomialCoefficient(59, 20));
+  EXPECT_EQ(internal::BinomialCoefficient(180, 160),
+            internal::BinomialCoefficient(180, 20));
+}
+
 TEST(PrivacyMathTest, GetKCombinationAtIndex) {
   // Test cases vetted via an equivalent calculator:
   // https://planetcalc.com/8592/
@@ -557,8 +573,7 @@ const struct {
 
 TEST(PrivacyMathTest, GetNumStates) {
   for (const auto& test_case : kNumStateTestCases) {
-    // Test both single spec and multi-spec variants to ensure both code paths
-    // (optimized and non) get exercised.
+    // Test both single spec and multi-spec variants, which must agree.
     auto specs = SpecsFromWindowList(test_case.windows_per_type,
                                      /*collapse_into_single_spec=*/true);
     EXPECT_EQ(test_case.expected_num_states,
@@ -9,8 +9,10 @@
 #include <utility>
 #include <vector>
 
+#include "base/feature_list.h"
 #include "base/functional/bind.h"
 #include "base/memory/weak_ptr.h"
+#include "base/ranges/algorithm.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "components/autofill/core/browser/autofill_experiments.h"
@@ -35,6 +37,10 @@ namespace {
 // text input element in a form.
 const int kMaxAutocompleteMenuItems = 6;
 
+// Limits on the memory of the in-memory indices of Autocomplete entries.
+const size_t kMaxIndexedFieldNames = 20;
+const size_t kMaxIndexedEntriesPerFieldName = 500;
+
 // Returns true if the field has a meaningful name.
 // An input field name 'field_2' bears no semantic meaning and there is a chance
 // that a different website or different form uses the same field name for a
@@ -62,10 +68,12 @@ AutocompleteHistoryManager::AutocompleteHistoryManager()
            {AUTOFILL_CLEANUP_RESULT,
             base::BindRepeating(
                 &AutocompleteHistoryManager::OnAutofillCleanupReturned,
-                base::Unretained(this))}}) {}
+                base::Unretained(this))}}),
+      indices_(kMaxIndexedFieldNames) {}
 
 AutocompleteHistoryManager::~AutocompleteHistoryManager() {
   CancelAllPendingQueries();
+  InvalidateAllIndices();
 }
 
 bool AutocompleteHistoryManager::OnGetSingleFieldSuggestions(
@@ -88,6 +96,14 @@ bool AutocompleteHistoryManager::OnGetSingleFieldSuggestions(
     return true;
   }
 
+  if (const AutocompleteSuggestionIndex* index =
+          GetOrLoadIndex(field.name())) {
+    SendSuggestions(index->GetEntries(field.value()),
+                    QueryHandler(field.global_id(), field.value(),
+                                 std::move(on_suggestions_returned)));
+    return true;
+  }
+
   if (profile_database_) {
     auto query_handle = profile_database_->GetFormValuesForElementName(
         field.name(), field.value(), kMaxAutocompleteMenuItems, this);
@@ -116,6 +132,10 @@ void AutocompleteHistoryManager::OnWillSubmitFormWithFields(
   }
   if (!autocomplete_saveable_fields.empty() && profile_database_.get()) {
     profile_database_->AddFormFields(autocomplete_saveable_fields);
+    // The use counts of the values change, which may change their ranking.
+    for (const FormFieldData& field : autocomplete_saveable_fields) {
+      InvalidateIndex(field.name());
+    }
   }
 }
 
@@ -134,6 +154,14 @@ void AutocompleteHistoryManager::OnRemoveCurrentSingleFieldSuggestion(
     SuggestionType type) {
   if (profile_database_)
     profile_database_->RemoveFormValueForElementName(field_name, value);
+
+  if (auto it = indices_.Peek(field_name);
+      it != indices_.end() && it->second) {
+    it->second->Remove(value);
+  } else {
+    // A pending load would still return the removed value.
+    InvalidateIndex(field_name);
+  }
 }
 
 void AutocompleteHistoryManager::OnSingleFieldSuggestionSelected(
@@ -159,6 +187,9 @@ void AutocompleteHistoryManager::Init(
     scoped_refptr<AutofillWebDataService> profile_database,
     PrefService* pref_service,
     bool is_off_the_record) {
+  InvalidateAllIndices();
+  profile_database_observation_.Reset();
+
   profile_database_ = profile_database;
   pref_service_ = pref_service;
   is_off_the_record_ = is_off_the_record;
@@ -168,6 +199,14 @@ void AutocompleteHistoryManager::Init(
     return;
   }
 
+  // Off the record, the entries are not indexed, because the entries saved by
+  // the manager of the original profile are not observed.
+  if (base::FeatureList::IsEnabled(
+          features::kAutofillAutocompleteSuggestionIndex) &&
+      !is_off_the_record_) {
+    profile_database_observation_.Observe(profile_database_.get());
+  }
+
   // No need to run the retention policy in OTR.
   if (!is_off_the_record_) {
     // Upon successful cleanup, the last cleaned-up major version is being
@@ -204,6 +243,17 @@ void AutocompleteHistoryManager::OnWebDataServiceRequestDone(
   request_callbacks_iter->second.Run(current_handle, std::move(result));
 }
 
+void AutocompleteHistoryManager::OnAutofillChangedBySync(
+    syncer::ModelType model_type) {
+  if (model_type == syncer::AUTOFILL) {
+    InvalidateAllIndices();
+  }
+}
+
+void AutocompleteHistoryManager::OnAutocompleteEntriesWillBeRemoved() {
+  InvalidateAllIndices();
+}
+
 AutocompleteHistoryManager::QueryHandler::QueryHandler(
     FieldGlobalId field_id,
     std::u16string prefix,
@@ -249,12 +299,85 @@ void AutocompleteHistoryManager::CancelAllPendingQueries() {
   pending_queries_.clear();
 }
 
+const AutocompleteSuggestionIndex* AutocompleteHistoryManager::GetOrLoadIndex(
+    const std::u16string& name) {
+  if (!profile_database_observation_.IsObserving()) {
+    return nullptr;
+  }
+  if (auto it = indices_.Get(name); it != indices_.end()) {
+    return it->second ? &*it->second : nullptr;
+  }
+  if (base::ranges::none_of(pending_index_loads_, [&](const auto& load) {
+        return load.second == name;
+      })) {
+    // The entries are sorted by decreasing use count. One more entry than
+    // indexed is requested to recognize names with too many entries.
+    WebDataServiceBase::Handle handle =
+        profile_database_->GetFormValuesForElementName(
+            name, /*prefix=*/u"", kMaxIndexedEntriesPerFieldName + 1, this);
+    pending_index_loads_.emplace(handle, name);
+  }
+  return nullptr;
+}
+
+void AutocompleteHistoryManager::InvalidateIndex(const std::u16string& name) {
+  if (auto it = indices_.Peek(name); it != indices_.end()) {
+    indices_.Erase(it);
+  }
+  for (auto it = pending_index_loads_.begin();
+       it != pending_index_loads_.end();) {
+    if (it->second == name) {
+      profile_database_->CancelRequest(it->first);
+      it = pending_index_loads_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void AutocompleteHistoryManager::InvalidateAllIndices() {
+  indices_.Clear();
+  if (profile_database_) {
+    for (const auto& [handle, name] : pending_index_loads_) {
+      profile_database_->CancelRequest(handle);
+    }
+  }
+  pending_index_loads_.clear();
+}
+
+bool AutocompleteHistoryManager::MaybeCreateIndex(
+    WebDataServiceBase::Handle current_handle,
+    const WDTypedResult& result) {
+  auto load = pending_index_loads_.find(current_handle);
+  if (load == pending_index_loads_.end()) {
+    return false;
+  }
+  std::u16string name = std::move(load->second);
+  pending_index_loads_.erase(load);
+
+  std::vector<AutocompleteEntry> entries =
+      static_cast<const WDResult<std::vector<AutocompleteEntry>>&>(result)
+          .GetValue();
+  if (entries.size() > kMaxIndexedEntriesPerFieldName) {
+    indices_.Put(std::move(name), std::nullopt);
+  } else {
+    indices_.Put(std::move(name),
+                 AutocompleteSuggestionIndex(std::move(entries),
+                                             kMaxAutocompleteMenuItems));
+  }
+  return true;
+}
+
 void AutocompleteHistoryManager::OnAutofillValuesReturned(
     WebDataServiceBase::Handle current_handle,
     std::unique_ptr<WDTypedResult> result) {
   DCHECK(result);
   DCHECK_EQ(AUTOFILL_VALUE_RESULT, result->GetType());
 
+  if (MaybeCreateIndex(current_handle, *result)) {
+    return;
+  }
+
   auto pending_queries_iter = pending_queries_.find(current_handle);
   if (pending_queries_iter == pending_queries_.end()) {
     // There's no handler for this query, hence nothing to do.
@@ -280,6 +403,9 @@ void AutocompleteHistoryManager::OnAutofillCleanupReturned(
   DCHECK(result);
   DCHECK_EQ(AUTOFILL_CLEANUP_RESULT, result->GetType());
 
+  // Expired entries were removed.
+  InvalidateAllIndices();
+
   // Cleanup was successful, update the latest run milestone.
   pref_service_->SetInteger(prefs::kAutocompleteLastVersionRetentionPolicy,
                             CHROME_VERSION_MAJOR);
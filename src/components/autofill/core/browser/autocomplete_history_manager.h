@@ -6,15 +6,20 @@
 #define COMPONENTS_AUTOFILL_CORE_BROWSER_AUTOCOMPLETE_HISTORY_MANAGER_H_
 
 #include <map>
+#include <optional>
 #include <vector>
 
+#include "base/containers/lru_cache.h"
 #include "base/functional/callback.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/raw_ptr.h"
+#include "base/scoped_observation.h"
+#include "components/autofill/core/browser/autocomplete_suggestion_index.h"
 #include "components/autofill/core/browser/single_field_form_filler.h"
 #include "components/autofill/core/browser/ui/suggestion.h"
 #include "components/autofill/core/browser/webdata/autocomplete/autocomplete_entry.h"
 #include "components/autofill/core/browser/webdata/autofill_webdata_service.h"
+#include "components/autofill/core/browser/webdata/autofill_webdata_service_observer.h"
 #include "components/autofill/core/common/form_data.h"
 #include "components/autofill/core/common/unique_ids.h"
 #include "components/keyed_service/core/keyed_service.h"
@@ -29,9 +34,11 @@ struct SuggestionsContext;
 // Per-profile Autocomplete history manager. Handles receiving form data
 // from the renderers and the storing and retrieving of form data
 // through WebDataServiceBase.
-class AutocompleteHistoryManager : public SingleFieldFormFiller,
-                                   public KeyedService,
-                                   public WebDataServiceConsumer {
+class AutocompleteHistoryManager
+    : public SingleFieldFormFiller,
+      public KeyedService,
+      public WebDataServiceConsumer,
+      public AutofillWebDataServiceObserverOnUISequence {
  public:
   AutocompleteHistoryManager();
 
@@ -69,6 +76,10 @@ class AutocompleteHistoryManager : public SingleFieldFormFiller,
       WebDataServiceBase::Handle h,
       std::unique_ptr<WDTypedResult> result) override;
 
+  // AutofillWebDataServiceObserverOnUISequence implementation.
+  void OnAutofillChangedBySync(syncer::ModelType model_type) override;
+  void OnAutocompleteEntriesWillBeRemoved() override;
+
  private:
   friend class AutocompleteHistoryManagerTest;
 
@@ -101,6 +112,21 @@ class AutocompleteHistoryManager : public SingleFieldFormFiller,
   // Cancels all outstanding queries and clears out the |pending_queries_| map.
   void CancelAllPendingQueries();
 
+  // Returns the index of the entries of the field `name`, or nullptr if there
+  // is none. In the latter case, starts loading the index if possible.
+  const AutocompleteSuggestionIndex* GetOrLoadIndex(const std::u16string& name);
+
+  // Drops the index of the field `name` and cancels loading it.
+  void InvalidateIndex(const std::u16string& name);
+
+  // Drops all indices and cancels loading them.
+  void InvalidateAllIndices();
+
+  // Creates the index of a field from the `result` of the load request
+  // `current_handle`, if that is a load request.
+  bool MaybeCreateIndex(WebDataServiceBase::Handle current_handle,
+                        const WDTypedResult& result);
+
   // Function handling WebDataService responses of type AUTOFILL_VALUE_RESULT.
   // |current_handle| is the DB query handle, and is used to retrieve the
   // handler associated with that query.
@@ -147,6 +173,20 @@ class AutocompleteHistoryManager : public SingleFieldFormFiller,
 
   // Whether the service is associated with an off-the-record browser context.
   bool is_off_the_record_ = false;
+
+  // If features::kAutofillAutocompleteSuggestionIndex is enabled, the indices
+  // of the Autocomplete entries of recently queried field names. Names with
+  // too many entries are mapped to nullopt and queried from the database.
+  base::LRUCache<std::u16string, std::optional<AutocompleteSuggestionIndex>>
+      indices_;
+
+  // The field names whose indices are being loaded, by query handle.
+  std::map<WebDataServiceBase::Handle, std::u16string> pending_index_loads_;
+
+  // Keeps the `indices_` in sync with changes that this class doesn't make.
+  base::ScopedObservation<AutofillWebDataService,
+                          AutofillWebDataServiceObserverOnUISequence>
+      profile_database_observation_{this};
 };
 
 }  // namespace autofill
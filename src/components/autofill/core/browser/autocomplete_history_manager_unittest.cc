@@ -45,6 +45,7 @@ using MockSuggestionsReturnedCallback =
     base::MockCallback<SingleFieldFormFiller::OnSuggestionsReturnedCallback>;
 using test::CreateTestFormField;
 using ::testing::_;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 using ::testing::Field;
 using ::testing::Return;
@@ -903,4 +904,92 @@ TEST_F(AutocompleteHistoryManagerTest, EmptyResult_DoesNotCrash) {
       1, std::move(empty_unique_ptr));
 }
 
+// Tests that with an index of the entries, the entries of a field name are
+// loaded once and the suggestions for later keystrokes are returned
+// synchronously.
+TEST_F(AutocompleteHistoryManagerTest, SuggestionIndex_AnswersSynchronously) {
+  base::test::ScopedFeatureList feature_list(
+      features::kAutofillAutocompleteSuggestionIndex);
+  autocomplete_manager_->Init(web_data_service_, prefs_.get(), false);
+  int mocked_load_id = 100;
+  int mocked_db_query_id = 101;
+  std::vector<AutocompleteEntry> entries = {
+      GetAutocompleteEntry(test_field_.name(), u"SomePrefixOne"),
+      GetAutocompleteEntry(test_field_.name(), u"Other"),
+      GetAutocompleteEntry(test_field_.name(), u"someprefixtwo")};
+
+  // The first request loads the index and queries the database as usual.
+  EXPECT_CALL(*web_data_service_,
+              GetFormValuesForElementName(test_field_.name(), std::u16string(),
+                                          _, autocomplete_manager_.get()))
+      .WillOnce(Return(mocked_load_id));
+  EXPECT_CALL(*web_data_service_, GetFormValuesForElementName(
+                                      test_field_.name(), test_field_.value(),
+                                      _, autocomplete_manager_.get()))
+      .WillOnce(Return(mocked_db_query_id));
+  EXPECT_TRUE(autocomplete_manager_->OnGetSingleFieldSuggestions(
+      test_field_, autofill_client_, base::DoNothing(), SuggestionsContext()));
+  autocomplete_manager_->OnWebDataServiceRequestDone(
+      mocked_load_id, GetMockedDbResults(entries));
+  autocomplete_manager_->OnWebDataServiceRequestDone(
+      mocked_db_query_id, GetMockedDbResults({entries[0], entries[2]}));
+
+  // Later requests don't query the database.
+  test_field_.set_value(u"somep");
+  auto has_main_text = [](const std::u16string& value) {
+    return Field(&Suggestion::main_text,
+                 Suggestion::Text(value, Suggestion::Text::IsPrimary(true)));
+  };
+  MockSuggestionsReturnedCallback mock_callback;
+  EXPECT_CALL(mock_callback,
+              Run(test_field_.global_id(),
+                  ElementsAre(has_main_text(u"SomePrefixOne"),
+                              has_main_text(u"someprefixtwo"))));
+  EXPECT_TRUE(autocomplete_manager_->OnGetSingleFieldSuggestions(
+      test_field_, autofill_client_, mock_callback.Get(),
+      SuggestionsContext()));
+}
+
+// Tests that the index of the entries is kept in sync with removals.
+TEST_F(AutocompleteHistoryManagerTest, SuggestionIndex_SyncedWithRemovals) {
+  base::test::ScopedFeatureList feature_list(
+      features::kAutofillAutocompleteSuggestionIndex);
+  autocomplete_manager_->Init(web_data_service_, prefs_.get(), false);
+  int mocked_load_id = 100;
+  EXPECT_CALL(*web_data_service_,
+              GetFormValuesForElementName(test_field_.name(), std::u16string(),
+                                          _, autocomplete_manager_.get()))
+      .WillOnce(Return(mocked_load_id))
+      .WillOnce(Return(mocked_load_id + 1));
+  EXPECT_CALL(*web_data_service_, GetFormValuesForElementName(
+                                      test_field_.name(), test_field_.value(),
+                                      _, autocomplete_manager_.get()))
+      .WillRepeatedly(Return(0));
+  EXPECT_TRUE(autocomplete_manager_->OnGetSingleFieldSuggestions(
+      test_field_, autofill_client_, base::DoNothing(), SuggestionsContext()));
+  autocomplete_manager_->OnWebDataServiceRequestDone(
+      mocked_load_id,
+      GetMockedDbResults(
+          {GetAutocompleteEntry(test_field_.name(), u"SomePrefixOne")}));
+
+  // Removing the suggestion removes it from the index.
+  EXPECT_CALL(*web_data_service_,
+              RemoveFormValueForElementName(test_field_.name(),
+                                            std::u16string(u"SomePrefixOne")));
+  autocomplete_manager_->OnRemoveCurrentSingleFieldSuggestion(
+      test_field_.name(), u"SomePrefixOne", SuggestionType::kAutocompleteEntry);
+  MockSuggestionsReturnedCallback mock_callback;
+  EXPECT_CALL(mock_callback, Run(test_field_.global_id(),
+                                 testing::Truly(IsEmptySuggestionVector)));
+  EXPECT_TRUE(autocomplete_manager_->OnGetSingleFieldSuggestions(
+      test_field_, autofill_client_, mock_callback.Get(),
+      SuggestionsContext()));
+
+  // Clearing browsing data drops the index, so it is loaded again.
+  autocomplete_manager_->OnAutocompleteEntriesWillBeRemoved();
+  EXPECT_TRUE(autocomplete_manager_->OnGetSingleFieldSuggestions(
+      test_field_, autofill_client_, base::DoNothing(), SuggestionsContext()));
+  autocomplete_manager_->CancelPendingQueries();
+}
+
 }  // namespace autofill
@@ -0,0 +1,130 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/autofill/core/browser/autocomplete_suggestion_index.h"
+
+#include <utility>
+
+#include "base/containers/contains.h"
+#include "base/i18n/case_conversion.h"
+#include "base/ranges/algorithm.h"
+
+namespace autofill {
+
+AutocompleteSuggestionIndex::Node::Node() = default;
+AutocompleteSuggestionIndex::Node::Node(Node&&) = default;
+AutocompleteSuggestionIndex::Node& AutocompleteSuggestionIndex::Node::operator=(
+    Node&&) = default;
+AutocompleteSuggestionIndex::Node::~Node() = default;
+
+AutocompleteSuggestionIndex::AutocompleteSuggestionIndex(
+    std::vector<AutocompleteEntry> entries,
+    size_t max_results)
+    : max_results_(max_results) {
+  nodes_.emplace_back();
+  entries_.reserve(entries.size());
+  for (AutocompleteEntry& entry : entries) {
+    Add(std::move(entry));
+  }
+}
+
+AutocompleteSuggestionIndex::AutocompleteSuggestionIndex(
+    AutocompleteSuggestionIndex&&) = default;
+AutocompleteSuggestionIndex& AutocompleteSuggestionIndex::operator=(
+    AutocompleteSuggestionIndex&&) = default;
+
+AutocompleteSuggestionIndex::~AutocompleteSuggestionIndex() = default;
+
+std::vector<AutocompleteEntry> AutocompleteSuggestionIndex::GetEntries(
+    const std::u16string& prefix) const {
+  std::u16string lower_prefix = base::i18n::ToLower(prefix);
+  std::vector<uint32_t> path = FindPath(lower_prefix);
+  if (path.size() != lower_prefix.size() + 1) {
+    return {};
+  }
+  std::vector<AutocompleteEntry> result;
+  for (uint32_t id : nodes_[path.back()].best_entries) {
+    result.push_back(*entries_[id]);
+  }
+  return result;
+}
+
+void AutocompleteSuggestionIndex::Add(AutocompleteEntry entry) {
+  // The new entry has the largest id, so appending keeps the lists sorted.
+  const uint32_t id = entries_.size();
+  uint32_t node = 0;
+  for (char16_t c : base::i18n::ToLower(entry.key().value())) {
+    if (nodes_[node].best_entries.size() < max_results_) {
+      nodes_[node].best_entries.push_back(id);
+    }
+    auto it = nodes_[node].children.find(c);
+    if (it != nodes_[node].children.end()) {
+      node = it->second;
+      continue;
+    }
+    uint32_t child = nodes_.size();
+    nodes_.emplace_back();
+    nodes_[node].children.emplace(c, child);
+    node = child;
+  }
+  if (nodes_[node].best_entries.size() < max_results_) {
+    nodes_[node].best_entries.push_back(id);
+  }
+  nodes_[node].entries.push_back(id);
+  entries_.push_back(std::move(entry));
+}
+
+void AutocompleteSuggestionIndex::Remove(const std::u16string& value) {
+  std::u16string lower_value = base::i18n::ToLower(value);
+  std::vector<uint32_t> path = FindPath(lower_value);
+  if (path.size() != lower_value.size() + 1) {
+    return;
+  }
+  std::vector<uint32_t>& node_entries = nodes_[path.back()].entries;
+  auto it = base::ranges::find_if(node_entries, [&](uint32_t id) {
+    return entries_[id]->key().value() == value;
+  });
+  if (it == node_entries.end()) {
+    return;
+  }
+  const uint32_t id = *it;
+  node_entries.erase(it);
+  entries_[id].reset();
+  // Bottom-up, so that the children are up to date when a node is updated.
+  for (auto node = path.rbegin(); node != path.rend(); ++node) {
+    if (base::Contains(nodes_[*node].best_entries, id)) {
+      UpdateBestEntries(*node);
+    }
+  }
+}
+
+std::vector<uint32_t> AutocompleteSuggestionIndex::FindPath(
+    const std::u16string& lower_value) const {
+  std::vector<uint32_t> path = {0};
+  for (char16_t c : lower_value) {
+    auto it = nodes_[path.back()].children.find(c);
+    if (it == nodes_[path.back()].children.end()) {
+      break;
+    }
+    path.push_back(it->second);
+  }
+  return path;
+}
+
+void AutocompleteSuggestionIndex::UpdateBestEntries(uint32_t node) {
+  // The best entries of the children are the best of their subtrees, so the
+  // best entries of `node` are among them.
+  std::vector<uint32_t> candidates = nodes_[node].entries;
+  for (const auto& [c, child] : nodes_[node].children) {
+    candidates.insert(candidates.end(), nodes_[child].best_entries.begin(),
+                      nodes_[child].best_entries.end());
+  }
+  base::ranges::sort(candidates);
+  if (candidates.size() > max_results_) {
+    candidates.resize(max_results_);
+  }
+  nodes_[node].best_entries = std::move(candidates);
+}
+
+}  // namespace autofill
@@ -0,0 +1,82 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_AUTOFILL_CORE_BROWSER_AUTOCOMPLETE_SUGGESTION_INDEX_H_
+#define COMPONENTS_AUTOFILL_CORE_BROWSER_AUTOCOMPLETE_SUGGESTION_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "components/autofill/core/browser/webdata/autocomplete/autocomplete_entry.h"
+
+namespace autofill {
+
+// An in-memory index of the Autocomplete entries of a single field name, which
+// answers the same queries as AutocompleteTable::GetFormValuesForElementName()
+// synchronously.
+//
+// The entries are stored in a trie of their lower case values. Every node of
+// the trie knows the best ranked entries below it, so a lookup only walks the
+// prefix.
+class AutocompleteSuggestionIndex {
+ public:
+  // `entries` must be sorted by decreasing rank, i.e., by decreasing use count
+  // as returned by the database. Lookups return at most `max_results` entries.
+  AutocompleteSuggestionIndex(std::vector<AutocompleteEntry> entries,
+                              size_t max_results);
+
+  AutocompleteSuggestionIndex(const AutocompleteSuggestionIndex&) = delete;
+  AutocompleteSuggestionIndex& operator=(const AutocompleteSuggestionIndex&) =
+      delete;
+  AutocompleteSuggestionIndex(AutocompleteSuggestionIndex&&);
+  AutocompleteSuggestionIndex& operator=(AutocompleteSuggestionIndex&&);
+
+  ~AutocompleteSuggestionIndex();
+
+  // Returns the best ranked entries whose values start with `prefix`, ignoring
+  // case, by decreasing rank.
+  std::vector<AutocompleteEntry> GetEntries(const std::u16string& prefix) const;
+
+  // Removes the entry with exactly the `value`, if any.
+  void Remove(const std::u16string& value);
+
+ private:
+  struct Node {
+    Node();
+    Node(Node&&);
+    Node& operator=(Node&&);
+    ~Node();
+
+    base::flat_map<char16_t, uint32_t> children;
+    // The entries whose lower case value ends at this node.
+    std::vector<uint32_t> entries;
+    // The `max_results_` best ranked entries at or below this node, sorted.
+    std::vector<uint32_t> best_entries;
+  };
+
+  // Adds an entry that ranks below all existing entries.
+  void Add(AutocompleteEntry entry);
+
+  // Returns the path of nodes from the root that spells `lower_value`, which
+  // is shorter if it leaves the trie.
+  std::vector<uint32_t> FindPath(const std::u16string& lower_value) const;
+
+  // Recomputes the `best_entries` of `node` from its subtree.
+  void UpdateBestEntries(uint32_t node);
+
+  // Indexed by entry id, which is the rank. Removed entries are nullopt.
+  std::vector<std::optional<AutocompleteEntry>> entries_;
+  // The nodes of the trie. The root is at index 0.
+  std::vector<Node> nodes_;
+  size_t max_results_;
+};
+
+}  // namespace autofill
+
+#endif  // COMPONENTS_AUTOFILL_CORE_BROWSER_AUTOCOMPLETE_SUGGESTION_INDEX_H_
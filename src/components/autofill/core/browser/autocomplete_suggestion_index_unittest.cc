@@ -0,0 +1,75 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/autofill/core/browser/autocomplete_suggestion_index.h"
+
+#include <string>
+#include <vector>
+
+#include "base/time/time.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace autofill {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+// Returns an index of entries with the `values`, ranked in the given order.
+AutocompleteSuggestionIndex CreateIndex(
+    const std::vector<std::u16string>& values) {
+  std::vector<AutocompleteEntry> entries;
+  for (const std::u16string& value : values) {
+    entries.emplace_back(AutocompleteKey(u"name", value), base::Time(),
+                         base::Time());
+  }
+  return AutocompleteSuggestionIndex(std::move(entries), /*max_results=*/3);
+}
+
+std::vector<std::u16string> GetValues(const AutocompleteSuggestionIndex& index,
+                                      const std::u16string& prefix) {
+  std::vector<std::u16string> values;
+  for (const AutocompleteEntry& entry : index.GetEntries(prefix)) {
+    values.push_back(entry.key().value());
+  }
+  return values;
+}
+
+TEST(AutocompleteSuggestionIndexTest, ReturnsBestRankedEntriesWithPrefix) {
+  AutocompleteSuggestionIndex index = CreateIndex(
+      {u"Bob", u"alice", u"Alfred", u"Albert", u"al", u"Alan", u"bobby"});
+  EXPECT_THAT(GetValues(index, u"al"),
+              ElementsAre(u"alice", u"Alfred", u"Albert"));
+  EXPECT_THAT(GetValues(index, u"ALB"), ElementsAre(u"Albert"));
+  EXPECT_THAT(GetValues(index, u"bob"), ElementsAre(u"Bob", u"bobby"));
+  EXPECT_THAT(GetValues(index, u""), ElementsAre(u"Bob", u"alice", u"Alfred"));
+  EXPECT_THAT(GetValues(index, u"alberta"), IsEmpty());
+  EXPECT_THAT(GetValues(index, u"x"), IsEmpty());
+}
+
+TEST(AutocompleteSuggestionIndexTest, Remove) {
+  AutocompleteSuggestionIndex index =
+      CreateIndex({u"alice", u"Alfred", u"Albert", u"al", u"Alan"});
+
+  // Removal is case sensitive.
+  index.Remove(u"Alice");
+  EXPECT_THAT(GetValues(index, u"al"),
+              ElementsAre(u"alice", u"Alfred", u"Albert"));
+
+  index.Remove(u"alice");
+  EXPECT_THAT(GetValues(index, u"al"),
+              ElementsAre(u"Alfred", u"Albert", u"al"));
+  EXPECT_THAT(GetValues(index, u"ali"), IsEmpty());
+
+  index.Remove(u"al");
+  EXPECT_THAT(GetValues(index, u"al"),
+              ElementsAre(u"Alfred", u"Albert", u"Alan"));
+  index.Remove(u"unknown");
+  EXPECT_THAT(GetValues(index, u""),
+              ElementsAre(u"Alfred", u"Albert", u"Alan"));
+}
+
+}  // namespace
+}  // namespace autofill
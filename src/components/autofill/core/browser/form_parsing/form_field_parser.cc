@@ -13,6 +13,7 @@
 #include "base/auto_reset.h"
 #include "base/containers/flat_map.h"
 #include "base/memory/raw_ptr.h"
+#include "base/notreached.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
 #include "components/autofill/core/browser/autofill_field.h"
@@ -62,6 +63,52 @@ AutofillRegexCache& GetAutofillRegexCache() {
   return *cache;
 }
 
+// Returns the label against which the patterns are matched.
+// TODO(crbug.com/40741721): Remove once shared labels are launched.
+const std::u16string& GetLabelToMatch(const ParsingContext& context,
+                                      const AutofillField& field) {
+  return context.autofill_enable_support_for_parsing_with_shared_labels
+             ? field.parseable_label()
+             : field.label();
+}
+
+// Returns the prefilter literals in `input`, memoized in `context`.
+const PrefilterLiteralMatches& FindPrefilterLiterals(
+    ParsingContext& context,
+    std::u16string_view input) {
+  auto it = context.prefilter_matches.find(input);
+  if (it == context.prefilter_matches.end()) {
+    it = context.prefilter_matches
+             .emplace(input, GetPrefilterLiteralMatcher().FindAll(input))
+             .first;
+  }
+  return it->second;
+}
+
+// Returns false if `prefilter` rules out that FormFieldParser::Match() finds
+// its regex in the `attribute` of `field`.
+bool PrefilterMayMatch(ParsingContext& context,
+                       const AutofillField& field,
+                       MatchAttribute attribute,
+                       const RegexPrefilter& prefilter) {
+  if (prefilter.literal_ids.empty()) {
+    return true;
+  }
+  switch (attribute) {
+    case MatchAttribute::kLabel:
+      // Labels and placeholders are matched against the same regexes.
+      return prefilter.MayMatch(FindPrefilterLiterals(
+                 context, GetLabelToMatch(context, field))) ||
+             (context.autofill_always_parse_placeholders &&
+              prefilter.MayMatch(
+                  FindPrefilterLiterals(context, field.placeholder())));
+    case MatchAttribute::kName:
+      return prefilter.MayMatch(
+          FindPrefilterLiterals(context, field.parseable_name()));
+  }
+  NOTREACHED();
+}
+
 }  // namespace
 
 RegexMatchesCache::RegexMatchesCache(int capacity) : cache_(capacity) {}
@@ -129,7 +176,18 @@ bool FormFieldParser::MatchesRegexWithCache(
 // static
 void FormFieldParser::ParseFormFields(
     ParsingContext& context,
-    const std::vector<std::unique_ptr<AutofillField>>& fields,
+    base::span<const std::unique_ptr<AutofillField>> fields,
+    bool is_form_tag,
+    FieldCandidatesMap& field_candidates) {
+  ParseFormFieldsPartially(context, fields, is_form_tag, field_candidates);
+  ClearCandidatesIfHeuristicsDidNotFindEnoughFields(
+      context, fields, field_candidates, is_form_tag);
+}
+
+// static
+void FormFieldParser::ParseFormFieldsPartially(
+    ParsingContext& context,
+    base::span<const std::unique_ptr<AutofillField>> fields,
     bool is_form_tag,
     FieldCandidatesMap& field_candidates) {
   std::vector<raw_ptr<AutofillField, VectorExperimental>> processed_fields =
@@ -187,15 +245,12 @@ void FormFieldParser::ParseFormFields(
 
   // Single fields pass.
   ParseSingleFieldForms(context, fields, is_form_tag, field_candidates);
-
-  ClearCandidatesIfHeuristicsDidNotFindEnoughFields(
-      context, fields, field_candidates, is_form_tag);
 }
 
 // static
 void FormFieldParser::ClearCandidatesIfHeuristicsDidNotFindEnoughFields(
     ParsingContext& context,
-    const std::vector<std::unique_ptr<AutofillField>>& fields,
+    base::span<const std::unique_ptr<AutofillField>> fields,
     FieldCandidatesMap& field_candidates,
     bool is_form_tag) {
   // Set to count distinct field types.
@@ -296,7 +351,7 @@ void FormFieldParser::ClearCandidatesIfHeuristicsDidNotFindEnoughFields(
 
 void FormFieldParser::ParseSingleFieldForms(
     ParsingContext& context,
-    const std::vector<std::unique_ptr<AutofillField>>& fields,
+    base::span<const std::unique_ptr<AutofillField>> fields,
     bool is_form_tag,
     FieldCandidatesMap& field_candidates) {
   std::vector<raw_ptr<AutofillField, VectorExperimental>> processed_fields =
@@ -319,7 +374,7 @@ void FormFieldParser::ParseSingleFieldForms(
 
 void FormFieldParser::ParseStandaloneCVCFields(
     ParsingContext& context,
-    const std::vector<std::unique_ptr<AutofillField>>& fields,
+    base::span<const std::unique_ptr<AutofillField>> fields,
     FieldCandidatesMap& field_candidates) {
   std::vector<raw_ptr<AutofillField, VectorExperimental>> processed_fields =
       RemoveCheckableFields(fields);
@@ -329,7 +384,7 @@ void FormFieldParser::ParseStandaloneCVCFields(
 
 void FormFieldParser::ParseStandaloneEmailFields(
     ParsingContext& context,
-    const std::vector<std::unique_ptr<AutofillField>>& fields,
+    base::span<const std::unique_ptr<AutofillField>> fields,
     FieldCandidatesMap& field_candidates) {
   std::vector<raw_ptr<AutofillField, VectorExperimental>> processed_fields =
       RemoveCheckableFields(fields);
@@ -368,11 +423,29 @@ bool FormFieldParser::FieldMatchesMatchPatternRef(
     }
 
     DenseSet<MatchAttribute> reduced_attributes = match_params.attributes;
+    if (context.autofill_enable_regex_prefilters) {
+      // Remove the attributes in which the positive pattern cannot match.
+      for (MatchAttribute attribute : match_params.attributes) {
+        if (!PrefilterMayMatch(context, field, attribute,
+                               pattern_ref.prefilters().positive)) {
+          reduced_attributes.erase(attribute);
+        }
+      }
+      if (reduced_attributes.empty()) {
+        continue;
+      }
+    }
     if (!IsEmpty(pattern.negative_pattern)) {
       // For each attribute that is active for the current pattern, test if it
       // matches the negative pattern. If so, remove it from the attributes that
       // are considered for positive matching.
       for (MatchAttribute attribute : match_params.attributes) {
+        if (!reduced_attributes.contains(attribute) ||
+            (context.autofill_enable_regex_prefilters &&
+             !PrefilterMayMatch(context, field, attribute,
+                                pattern_ref.prefilters().negative))) {
+          continue;
+        }
         if (Match(context, &field, pattern.negative_pattern, {attribute},
                   regex_name)) {
           reduced_attributes.erase(attribute);
@@ -558,7 +631,7 @@ void FormFieldParser::AddClassification(const AutofillField* field,
 // static
 std::vector<raw_ptr<AutofillField, VectorExperimental>>
 FormFieldParser::RemoveCheckableFields(
-    const std::vector<std::unique_ptr<AutofillField>>& fields) {
+    base::span<const std::unique_ptr<AutofillField>> fields) {
   // Set up a working copy of the fields to be processed.
   std::vector<raw_ptr<AutofillField, VectorExperimental>> processed_fields;
   for (const auto& field : fields) {
@@ -590,11 +663,7 @@ bool FormFieldParser::Match(ParsingContext& context,
       context.log_manager && context.log_manager->IsLoggingActive() ? &matches
                                                                     : nullptr;
 
-  // TODO(crbug.com/40741721): Remove once shared labels are launched.
-  const std::u16string& label =
-      context.autofill_enable_support_for_parsing_with_shared_labels
-          ? field->parseable_label()
-          : field->label();
+  const std::u16string& label = GetLabelToMatch(context, *field);
 
   const std::u16string& name = field->parseable_name();
 
@@ -5,6 +5,8 @@
 #ifndef COMPONENTS_AUTOFILL_CORE_BROWSER_FORM_PARSING_FORM_FIELD_PARSER_H_
 #define COMPONENTS_AUTOFILL_CORE_BROWSER_FORM_PARSING_FORM_FIELD_PARSER_H_
 
+#include <functional>
+#include <map>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -22,6 +24,7 @@
 #include "components/autofill/core/browser/form_parsing/autofill_parsing_utils.h"
 #include "components/autofill/core/browser/form_parsing/field_candidates.h"
 #include "components/autofill/core/browser/form_parsing/regex_patterns.h"
+#include "components/autofill/core/browser/form_parsing/regex_prefilter.h"
 #include "components/autofill/core/common/autofill_features.h"
 #include "components/autofill/core/common/form_field_data.h"
 #include "components/autofill/core/common/language_code.h"
@@ -114,8 +117,14 @@ struct ParsingContext {
           features::kAutofillEnableSupportForParsingWithSharedLabels)};
   const bool autofill_always_parse_placeholders{
       base::FeatureList::IsEnabled(features::kAutofillAlwaysParsePlaceholders)};
+  const bool autofill_enable_regex_prefilters{base::FeatureList::IsEnabled(
+      features::kAutofillEnableRegexPrefilters)};
 
   std::optional<RegexMatchesCache> matches_cache;
+  // The prefilter literals found in the labels, names and placeholders of the
+  // fields, by string.
+  std::map<std::u16string, PrefilterLiteralMatches, std::less<>>
+      prefilter_matches;
   raw_ref<AutofillRegexCache> regex_cache;
 
   raw_ptr<LogManager> log_manager;
@@ -136,7 +145,17 @@ class FormFieldParser {
   // |field_candidates|.
   static void ParseFormFields(
       ParsingContext& context,
-      const std::vector<std::unique_ptr<AutofillField>>& fields,
+      base::span<const std::unique_ptr<AutofillField>> fields,
+      bool is_form_tag,
+      FieldCandidatesMap& field_candidates);
+
+  // Like ParseFormFields(), but for a subrange `fields` of a form whose other
+  // fields keep their previous classifications. Therefore, the candidates are
+  // not cleared if only few types were found in `fields`; the caller needs to
+  // check kMinRequiredFieldsForHeuristics for the whole form.
+  static void ParseFormFieldsPartially(
+      ParsingContext& context,
+      base::span<const std::unique_ptr<AutofillField>> fields,
       bool is_form_tag,
       FieldCandidatesMap& field_candidates);
 
@@ -145,7 +164,7 @@ class FormFieldParser {
   // used as the key into |field_candidates|.
   static void ParseSingleFieldForms(
       ParsingContext& context,
-      const std::vector<std::unique_ptr<AutofillField>>& fields,
+      base::span<const std::unique_ptr<AutofillField>> fields,
       bool is_form_tag,
       FieldCandidatesMap& field_candidates);
 
@@ -157,7 +176,7 @@ class FormFieldParser {
   // in the form, which is why its parsing logic is extracted to its own method.
   static void ParseStandaloneCVCFields(
       ParsingContext& context,
-      const std::vector<std::unique_ptr<AutofillField>>& fields,
+      base::span<const std::unique_ptr<AutofillField>> fields,
       FieldCandidatesMap& field_candidates);
 
   // Search for standalone email fields inside `fields`. Used because email
@@ -166,7 +185,7 @@ class FormFieldParser {
   // enabled.
   static void ParseStandaloneEmailFields(
       ParsingContext& context,
-      const std::vector<std::unique_ptr<AutofillField>>& fields,
+      base::span<const std::unique_ptr<AutofillField>> fields,
       FieldCandidatesMap& field_candidates);
 
   // Returns true if `field` matches one of the the passed `patterns`.
@@ -317,7 +336,7 @@ class FormFieldParser {
   //   email address).
   static void ClearCandidatesIfHeuristicsDidNotFindEnoughFields(
       ParsingContext& context,
-      const std::vector<std::unique_ptr<AutofillField>>& fields,
+      base::span<const std::unique_ptr<AutofillField>> fields,
       FieldCandidatesMap& field_candidates,
       bool is_form_tag);
 
@@ -346,7 +365,7 @@ class FormFieldParser {
   // detection.
   static std::vector<raw_ptr<AutofillField, VectorExperimental>>
   RemoveCheckableFields(
-      const std::vector<std::unique_ptr<AutofillField>>& fields);
+      base::span<const std::unique_ptr<AutofillField>> fields);
 
   // Matches the regular expression |pattern| against the components of
   // |field| as specified in |match_type|.
@@ -0,0 +1,110 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/autofill/core/browser/form_parsing/form_field_parser.h"
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/timer/elapsed_timer.h"
+#include "components/autofill/core/browser/autofill_field.h"
+#include "components/autofill/core/common/autofill_features.h"
+#include "components/autofill/core/common/form_field_data.h"
+#include "components/autofill/core/common/unique_ids.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace autofill {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "FormFieldParser.";
+constexpr char kMetricParse[] = "parse";
+
+// Forms of travel and checkout pages, with repeated sections of passengers.
+constexpr size_t kFieldCount = 400;
+
+// Labels and names of the fields, which are repeated with a suffix.
+constexpr struct {
+  const char* label;
+  const char* name;
+} kFields[] = {
+    {"Title", "title"},
+    {"First name", "first_name"},
+    {"Last name", "last_name"},
+    {"Date of birth", "dob"},
+    {"Passport number", "passport"},
+    {"Nationality", "nationality"},
+    {"Frequent flyer number", "ffn"},
+    {"Email address", "email"},
+    {"Mobile phone", "phone"},
+    {"Street address", "address1"},
+    {"Apartment, suite, etc.", "address2"},
+    {"City", "city"},
+    {"ZIP / Postal code", "zip"},
+    {"Country", "country"},
+    {"Seat preference", "seat"},
+    {"Meal preference", "meal"},
+    {"Special assistance", "assistance"},
+    {"Promo code", "promo"},
+};
+
+}  // namespace
+
+class FormFieldParserPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    for (size_t i = 0; i < kFieldCount; ++i) {
+      const auto& field = kFields[i % std::size(kFields)];
+      const std::string suffix = base::NumberToString(i / std::size(kFields));
+      FormFieldData field_data;
+      field_data.set_form_control_type(FormControlType::kInputText);
+      field_data.set_label(base::UTF8ToUTF16(field.label));
+      field_data.set_name(base::UTF8ToUTF16(field.name + ("_" + suffix)));
+      field_data.set_renderer_id(FieldRendererId(i + 1));
+      fields_.push_back(std::make_unique<AutofillField>(field_data));
+    }
+  }
+
+  // Parses `fields_` and reports how long it took under `story`.
+  void RunStory(const std::string& story) {
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricParse, "ms");
+
+    constexpr int kIterations = 10;
+    base::ElapsedTimer timer;
+    size_t classified_fields = 0;
+    for (int i = 0; i < kIterations; ++i) {
+      // A new context per iteration, as for every form in production.
+      ParsingContext context(GeoIpCountryCode("US"), LanguageCode("en"),
+                             PatternSource::kLegacy);
+      FieldCandidatesMap field_candidates;
+      FormFieldParser::ParseFormFields(context, fields_, /*is_form_tag=*/true,
+                                       field_candidates);
+      classified_fields += field_candidates.size();
+    }
+    EXPECT_GT(classified_fields, 0u);
+    reporter.AddResult(kMetricParse,
+                       timer.Elapsed().InMillisecondsF() / kIterations);
+  }
+
+  std::vector<std::unique_ptr<AutofillField>> fields_;
+};
+
+TEST_F(FormFieldParserPerfTest, LargeForm) {
+  RunStory("LargeForm");
+}
+
+TEST_F(FormFieldParserPerfTest, LargeFormRegexPrefilters) {
+  base::test::ScopedFeatureList feature_list(
+      features::kAutofillEnableRegexPrefilters);
+  RunStory("LargeFormRegexPrefilters");
+}
+
+}  // namespace autofill
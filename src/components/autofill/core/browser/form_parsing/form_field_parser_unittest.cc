@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <map>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -193,6 +194,36 @@ TEST_P(FormFieldParserTest, TestParseableLabels) {
   }
 }
 
+// Tests that the regex prefilters only skip regexes that don't match.
+TEST_P(FormFieldParserTest, RegexPrefiltersDoNotChangeClassifications) {
+  AddTextFormFieldData("firstname", "First name", NAME_FIRST);
+  AddTextFormFieldData("lastname", "Last name", NAME_LAST);
+  AddTextFormFieldData("email", "E-mail", EMAIL_ADDRESS);
+  AddTextFormFieldData("address1", "Stra\u00DFe", ADDRESS_HOME_LINE1);
+  AddTextFormFieldData("address2", "Apt / Suite", ADDRESS_HOME_LINE2);
+  AddTextFormFieldData("city", "City", ADDRESS_HOME_CITY);
+  AddTextFormFieldData("zip", "ZIP code", ADDRESS_HOME_ZIP);
+  AddTextFormFieldData("phone", "Phone", PHONE_HOME_WHOLE_NUMBER);
+  AddTextFormFieldData("ccnumber", "Card number", CREDIT_CARD_NUMBER);
+  AddTextFormFieldData("f1", "Comments", UNKNOWN_TYPE);
+
+  auto classify = [&](bool enable_prefilters) {
+    base::test::ScopedFeatureList feature_list;
+    feature_list.InitWithFeatureState(features::kAutofillEnableRegexPrefilters,
+                                      enable_prefilters);
+    field_candidates_map_.clear();
+    ParseFormFields();
+    std::map<FieldGlobalId, FieldType> types;
+    for (const auto& [id, candidates] : field_candidates_map_) {
+      types[id] = candidates.BestHeuristicType();
+    }
+    return types;
+  };
+  std::map<FieldGlobalId, FieldType> types_without_prefilters = classify(false);
+  EXPECT_FALSE(types_without_prefilters.empty());
+  EXPECT_EQ(types_without_prefilters, classify(true));
+}
+
 // Tests that `ParseSingleFieldForms` is called as part of `ParseFormFields`.
 TEST_P(FormFieldParserTest, ParseSingleFieldFormsInsideParseFormField) {
   AddTextFormFieldData(
@@ -5,6 +5,7 @@
 #include "components/autofill/core/browser/form_parsing/regex_patterns.h"
 
 #include "base/check.h"
+#include "base/no_destructor.h"
 #include "base/notreached.h"
 #include "components/autofill/core/browser/form_parsing/regex_patterns_inl.h"
 #include "components/autofill/core/browser/heuristic_source.h"
@@ -93,6 +94,16 @@ MatchingPattern MatchPatternRef::operator*() const {
   };
 }
 
+const MatchingPatternPrefilters& MatchPatternRef::prefilters() const {
+  return kPatternPrefilters[index()];
+}
+
+const PrefilterLiteralMatcher& GetPrefilterLiteralMatcher() {
+  static const base::NoDestructor<PrefilterLiteralMatcher> matcher(
+      kPrefilterLiterals);
+  return *matcher;
+}
+
 bool AreMatchingPatternsEqual(PatternSource a,
                               PatternSource b,
                               LanguageCode language_code) {
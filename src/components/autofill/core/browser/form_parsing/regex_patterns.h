@@ -12,6 +12,7 @@
 #include "components/autofill/core/browser/field_types.h"
 #include "components/autofill/core/browser/form_parsing/autofill_parsing_utils.h"
 #include "components/autofill/core/browser/form_parsing/buildflags.h"
+#include "components/autofill/core/browser/form_parsing/regex_prefilter.h"
 #include "components/autofill/core/common/language_code.h"
 
 namespace autofill {
@@ -21,6 +22,9 @@ class MatchPatternRef {
  public:
   MatchingPattern operator*() const;
 
+  // Returns the prefilters of the pattern's regexes.
+  const MatchingPatternPrefilters& prefilters() const;
+
  private:
   // Internally, a MatchPatternRef is represented as
   // - an index into the `kPatterns` array generated by
@@ -114,6 +118,9 @@ base::span<const MatchPatternRef> GetMatchPatterns(
     std::optional<LanguageCode> language_code,
     PatternSource pattern_source);
 
+// Returns the matcher of the literals of the RegexPrefilters of all patterns.
+const PrefilterLiteralMatcher& GetPrefilterLiteralMatcher();
+
 // Returns true iff there at least one pattern for some PatternSource and
 // pattern name.
 bool IsSupportedLanguageCode(LanguageCode language_code);
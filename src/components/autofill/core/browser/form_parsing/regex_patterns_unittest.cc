@@ -292,6 +292,25 @@ TEST_P(RegexPatternsTestWithSamples, TestPositiveAndNegativeCases) {
   }
 }
 
+// Tests that the prefilters of the patterns don't rule out the samples that the
+// patterns match.
+TEST_P(RegexPatternsTestWithSamples, PrefiltersAcceptMatchingSamples) {
+  PatternTestCase test_case = GetParam();
+  for (const std::string& sample : test_case.positive_samples) {
+    PrefilterLiteralMatches matches =
+        GetPrefilterLiteralMatcher().FindAll(base::UTF8ToUTF16(sample));
+    for (MatchPatternRef pattern_ref : GetMatchPatterns(
+             test_case.pattern_name, LanguageCode(test_case.language),
+             test_case.pattern_source)) {
+      if (::testing::Value(sample, Matches((*pattern_ref).positive_pattern))) {
+        EXPECT_TRUE(pattern_ref.prefilters().positive.MayMatch(matches))
+            << "sample=" << sample << ","
+            << "pattern=" << base::UTF16ToUTF8((*pattern_ref).positive_pattern);
+      }
+    }
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     RegexPatternsTest,
     RegexPatternsTestWithSamples,
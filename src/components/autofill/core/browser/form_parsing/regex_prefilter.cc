@@ -0,0 +1,106 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/autofill/core/browser/form_parsing/regex_prefilter.h"
+
+#include <algorithm>
+
+#include "base/check_op.h"
+#include "base/containers/queue.h"
+#include "base/ranges/algorithm.h"
+#include "base/strings/string_util.h"
+
+namespace autofill {
+
+bool RegexPrefilter::MayMatch(const PrefilterLiteralMatches& matches) const {
+  if (literal_ids.empty() || !matches) {
+    return true;
+  }
+  return base::ranges::any_of(*matches, [this](PrefilterLiteralId id) {
+    return base::ranges::binary_search(literal_ids, id);
+  });
+}
+
+PrefilterLiteralMatcher::Node::Node() = default;
+PrefilterLiteralMatcher::Node::Node(Node&&) = default;
+PrefilterLiteralMatcher::Node& PrefilterLiteralMatcher::Node::operator=(
+    Node&&) = default;
+PrefilterLiteralMatcher::Node::~Node() = default;
+
+PrefilterLiteralMatcher::PrefilterLiteralMatcher(
+    base::span<const std::string_view> literals) {
+  CHECK_LE(literals.size(), 1u << 16);
+  // Build the trie of the literals.
+  nodes_.emplace_back();
+  for (size_t id = 0; id < literals.size(); ++id) {
+    uint32_t node = 0;
+    for (char c : literals[id]) {
+      c = base::ToLowerASCII(c);
+      auto it = nodes_[node].children.find(c);
+      if (it != nodes_[node].children.end()) {
+        node = it->second;
+        continue;
+      }
+      uint32_t child = nodes_.size();
+      nodes_.emplace_back();
+      nodes_[node].children.emplace(c, child);
+      node = child;
+    }
+    nodes_[node].literal = static_cast<PrefilterLiteralId>(id);
+  }
+
+  // Compute the failure and output links in breadth-first order, so that the
+  // links of shorter strings are known.
+  base::queue<uint32_t> queue;
+  for (const auto& [c, child] : nodes_[0].children) {
+    queue.push(child);
+  }
+  while (!queue.empty()) {
+    uint32_t node = queue.front();
+    queue.pop();
+    for (const auto& [c, child] : nodes_[node].children) {
+      uint32_t failure = Next(nodes_[node].failure, c);
+      nodes_[child].failure = failure;
+      nodes_[child].output =
+          nodes_[failure].literal ? failure : nodes_[failure].output;
+      queue.push(child);
+    }
+  }
+}
+
+PrefilterLiteralMatcher::~PrefilterLiteralMatcher() = default;
+
+PrefilterLiteralMatches PrefilterLiteralMatcher::FindAll(
+    std::u16string_view input) const {
+  std::vector<PrefilterLiteralId> matches;
+  uint32_t node = 0;
+  for (char16_t c : input) {
+    if (c > 0x7F) {
+      return std::nullopt;
+    }
+    node = Next(node, base::ToLowerASCII(static_cast<char>(c)));
+    for (uint32_t n = nodes_[node].literal ? node : nodes_[node].output; n;
+         n = nodes_[n].output) {
+      matches.push_back(*nodes_[n].literal);
+    }
+  }
+  base::ranges::sort(matches);
+  matches.erase(base::ranges::unique(matches), matches.end());
+  return matches;
+}
+
+uint32_t PrefilterLiteralMatcher::Next(uint32_t node, char c) const {
+  while (true) {
+    auto it = nodes_[node].children.find(c);
+    if (it != nodes_[node].children.end()) {
+      return it->second;
+    }
+    if (node == 0) {
+      return 0;
+    }
+    node = nodes_[node].failure;
+  }
+}
+
+}  // namespace autofill
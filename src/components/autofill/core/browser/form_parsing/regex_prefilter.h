@@ -0,0 +1,88 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_AUTOFILL_CORE_BROWSER_FORM_PARSING_REGEX_PREFILTER_H_
+#define COMPONENTS_AUTOFILL_CORE_BROWSER_FORM_PARSING_REGEX_PREFILTER_H_
+
+#include <stdint.h>
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "base/containers/flat_map.h"
+#include "base/containers/span.h"
+
+namespace autofill {
+
+// Identifies a literal of a PrefilterLiteralMatcher by its index.
+using PrefilterLiteralId = uint16_t;
+
+// The sorted ids of the literals that a PrefilterLiteralMatcher found in a
+// string, or nullopt if the string can't be prefiltered.
+using PrefilterLiteralMatches = std::optional<std::vector<PrefilterLiteralId>>;
+
+// A necessary condition for a regex to match a string, which is computed ahead
+// of time by transpile_regex_patterns.py: the string must contain one of the
+// literals of the prefilter. This allows skipping most regex evaluations,
+// because all literals can be searched at once by a PrefilterLiteralMatcher.
+struct RegexPrefilter {
+  // Returns false if the regex cannot match a string in which `matches` were
+  // found.
+  bool MayMatch(const PrefilterLiteralMatches& matches) const;
+
+  // The sorted ids of the literals. If empty, the regex may match any string.
+  base::span<const PrefilterLiteralId> literal_ids;
+};
+
+// The prefilters of the regexes of a MatchingPattern.
+struct MatchingPatternPrefilters {
+  RegexPrefilter positive;
+  RegexPrefilter negative;
+};
+
+// Finds all occurrences of a set of lower case ASCII literals in a string in a
+// single pass, using an Aho-Corasick automaton.
+class PrefilterLiteralMatcher {
+ public:
+  explicit PrefilterLiteralMatcher(base::span<const std::string_view> literals);
+
+  PrefilterLiteralMatcher(const PrefilterLiteralMatcher&) = delete;
+  PrefilterLiteralMatcher& operator=(const PrefilterLiteralMatcher&) = delete;
+
+  ~PrefilterLiteralMatcher();
+
+  // Returns the ids of the literals that occur in `input`, ignoring ASCII case.
+  // Regexes are matched case-insensitively, which lets some non-ASCII
+  // characters match ASCII ones (e.g., the Kelvin sign matches "k"). Therefore,
+  // returns nullopt if `input` contains non-ASCII characters.
+  PrefilterLiteralMatches FindAll(std::u16string_view input) const;
+
+ private:
+  struct Node {
+    Node();
+    Node(Node&&);
+    Node& operator=(Node&&);
+    ~Node();
+
+    // The trie edges.
+    base::flat_map<char, uint32_t> children;
+    // The node of the longest proper suffix of this node's string in the trie.
+    uint32_t failure = 0;
+    // The nearest node on the failure chain at which a literal ends, or 0.
+    uint32_t output = 0;
+    // The literal that ends at this node, if any.
+    std::optional<PrefilterLiteralId> literal;
+  };
+
+  // Returns the node reached from `node` by `c`, following failure links.
+  uint32_t Next(uint32_t node, char c) const;
+
+  // The nodes of the automaton. The root is at index 0.
+  std::vector<Node> nodes_;
+};
+
+}  // namespace autofill
+
+#endif  // COMPONENTS_AUTOFILL_CORE_BROWSER_FORM_PARSING_REGEX_PREFILTER_H_
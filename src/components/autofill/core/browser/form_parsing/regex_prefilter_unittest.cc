@@ -0,0 +1,59 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/autofill/core/browser/form_parsing/regex_prefilter.h"
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace autofill {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Optional;
+
+constexpr std::string_view kLiterals[] = {"he", "she", "his", "hers", "mail"};
+
+TEST(PrefilterLiteralMatcherTest, FindsOverlappingLiterals) {
+  PrefilterLiteralMatcher matcher(kLiterals);
+  EXPECT_THAT(matcher.FindAll(u"ushers"), Optional(ElementsAre(0, 1, 3)));
+  EXPECT_THAT(matcher.FindAll(u"this"), Optional(ElementsAre(2)));
+  EXPECT_THAT(matcher.FindAll(u"e-mail address"), Optional(ElementsAre(4)));
+  EXPECT_THAT(matcher.FindAll(u"phone"), Optional(IsEmpty()));
+  EXPECT_THAT(matcher.FindAll(u""), Optional(IsEmpty()));
+}
+
+TEST(PrefilterLiteralMatcherTest, IgnoresAsciiCase) {
+  PrefilterLiteralMatcher matcher(kLiterals);
+  EXPECT_THAT(matcher.FindAll(u"E-MAIL"), Optional(ElementsAre(4)));
+  EXPECT_THAT(matcher.FindAll(u"HiS"), Optional(ElementsAre(2)));
+}
+
+// Non-ASCII characters may match ASCII characters in case-insensitive regexes.
+TEST(PrefilterLiteralMatcherTest, DoesNotPrefilterNonAscii) {
+  PrefilterLiteralMatcher matcher(kLiterals);
+  // U+212A is the Kelvin sign.
+  EXPECT_EQ(matcher.FindAll(u"e-mai\u212A"), std::nullopt);
+  EXPECT_EQ(matcher.FindAll(u"Straße"), std::nullopt);
+}
+
+TEST(RegexPrefilterTest, MayMatch) {
+  constexpr PrefilterLiteralId kIds[] = {1, 4};
+  RegexPrefilter prefilter{kIds};
+  EXPECT_TRUE(prefilter.MayMatch(std::vector<PrefilterLiteralId>{0, 4}));
+  EXPECT_FALSE(prefilter.MayMatch(std::vector<PrefilterLiteralId>{0, 2}));
+  EXPECT_FALSE(prefilter.MayMatch(std::vector<PrefilterLiteralId>{}));
+  EXPECT_TRUE(prefilter.MayMatch(std::nullopt));
+
+  // Without literals, any string may match.
+  EXPECT_TRUE(RegexPrefilter{}.MayMatch(std::vector<PrefilterLiteralId>{}));
+}
+
+}  // namespace
+}  // namespace autofill
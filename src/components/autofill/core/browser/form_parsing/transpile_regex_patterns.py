@@ -83,6 +83,252 @@ def generate_matching_pattern_equals(name_to_lang_to_id_to_patternrefs,
   yield '  return false;'
   yield '}'
 
+# Stores a `key` in `dictionary` and assigns it a natural number.
+#
+# For example, after memoize("foo", d) and memoize("bar", d),
+# d = {"foo": 0, "bar": 1}. This is useful to generate a C++ array
+# {"foo", "bar"} and referring to these elements by their indices
+# 0 and 1.
+def memoize(key, dictionary):
+  if key not in dictionary:
+    dictionary[key] = len(dictionary)
+  return dictionary[key]
+
+# Raised by _RegexParser for regex syntax that it does not support.
+class _UnsupportedRegexError(Exception):
+  pass
+
+# A recursive descent parser that computes a prefilter of an ICU regex: a set
+# of lower case ASCII literals such that the regex can only match a string, in
+# the case-insensitive mode used by autofill, if the string contains one of the
+# literals. `None` stands for the absence of a prefilter.
+#
+# The parser is conservative: regex syntax that it doesn't know raises an
+# _UnsupportedRegexError, for which no prefilter is generated. It only needs to
+# understand the syntax used in the JSON files.
+class _RegexParser:
+  def __init__(self, regex):
+    self.regex = regex
+    self.pos = 0
+
+  def peek(self):
+    return self.regex[self.pos] if self.pos < len(self.regex) else None
+
+  def consume(self, expected):
+    if not self.regex.startswith(expected, self.pos):
+      raise _UnsupportedRegexError(self.regex)
+    self.pos += len(expected)
+
+  # Returns the prefilter that is the most selective among `prefilters`.
+  @staticmethod
+  def best(prefilters):
+    prefilters = [p for p in prefilters if p is not None]
+    if not prefilters:
+      return None
+    return max(prefilters,
+               key=lambda p: (min(len(l) for l in p), -len(p)))
+
+  # Parses `a|b|...` until the end of the regex or of the enclosing group.
+  def parse_alternation(self):
+    branches = [self.parse_concatenation()]
+    while self.peek() == '|':
+      self.pos += 1
+      branches.append(self.parse_concatenation())
+    if any(branch is None for branch in branches):
+      return None
+    return frozenset().union(*branches)
+
+  # Parses a sequence of quantified atoms. Consecutive literal characters form
+  # a literal that the matched string must contain.
+  def parse_concatenation(self):
+    candidates = []
+    run = ''
+    while self.peek() is not None and self.peek() not in '|)':
+      char, prefilter, zero_width = self.parse_atom()
+      min_count = self.parse_quantifier()
+      if zero_width:
+        continue
+      if char is not None and min_count is None:
+        run += char
+        continue
+      if char is not None and min_count > 0:
+        run += char
+      if run:
+        candidates.append(frozenset([run]))
+        run = ''
+      if char is None and (min_count is None or min_count > 0):
+        candidates.append(prefilter)
+    if run:
+      candidates.append(frozenset([run]))
+    return self.best(candidates)
+
+  # Parses an atom and returns a tuple (char, prefilter, zero_width), where
+  # `char` is the lower case character if the atom is an ASCII literal.
+  def parse_atom(self):
+    c = self.peek()
+    if c == '(':
+      for lookaround in ['(?=', '(?!', '(?<=', '(?<!']:
+        if self.regex.startswith(lookaround, self.pos):
+          self.pos += len(lookaround)
+          self.parse_alternation()
+          self.consume(')')
+          return None, None, True
+      if self.regex.startswith('(?:', self.pos):
+        self.pos += 3
+      elif self.regex.startswith('(?', self.pos):
+        raise _UnsupportedRegexError(self.regex)
+      else:
+        self.pos += 1
+      prefilter = self.parse_alternation()
+      self.consume(')')
+      return None, prefilter, False
+    if c == '[':
+      self.skip_character_class()
+      return None, None, False
+    if c in ['^', '$']:
+      self.pos += 1
+      return None, None, True
+    if c == '.':
+      self.pos += 1
+      return None, None, False
+    if c == '\\':
+      return self.parse_escape()
+    if c in '*+?{}]':
+      raise _UnsupportedRegexError(self.regex)
+    self.pos += 1
+    if not c.isascii() or not c.isprintable():
+      return None, None, False
+    return c.lower(), None, False
+
+  def parse_escape(self):
+    self.consume('\\')
+    c = self.peek()
+    if c is None:
+      raise _UnsupportedRegexError(self.regex)
+    self.pos += 1
+    if c in 'bBAzZG':
+      return None, None, True
+    if c in 'sSdDwWhHvVtnrfae':
+      return None, None, False
+    if c in 'pP':
+      if self.peek() == '{':
+        end = self.regex.find('}', self.pos)
+        if end < 0:
+          raise _UnsupportedRegexError(self.regex)
+        self.pos = end + 1
+      else:
+        self.pos += 1
+      return None, None, False
+    if c.isascii() and not c.isalnum():
+      return c, None, False
+    raise _UnsupportedRegexError(self.regex)
+
+  # Skips a possibly nested character class like `[^a-z[:digit:]]`.
+  def skip_character_class(self):
+    self.consume('[')
+    if self.peek() == '^':
+      self.pos += 1
+    if self.peek() == ']':
+      raise _UnsupportedRegexError(self.regex)
+    depth = 1
+    while depth > 0:
+      c = self.peek()
+      if c is None:
+        raise _UnsupportedRegexError(self.regex)
+      if c == '\\':
+        self.pos += 1
+      elif c == '[':
+        depth += 1
+      elif c == ']':
+        depth -= 1
+      self.pos += 1
+
+  # Parses an optional quantifier and returns its minimum count, or None if
+  # there is no quantifier.
+  def parse_quantifier(self):
+    c = self.peek()
+    if c in ['?', '*', '+']:
+      self.pos += 1
+      min_count = 1 if c == '+' else 0
+    elif c == '{':
+      match = re.compile(r'\{(\d+)(,\d*)?\}').match(self.regex, self.pos)
+      if not match:
+        raise _UnsupportedRegexError(self.regex)
+      self.pos = match.end()
+      min_count = int(match.group(1))
+    else:
+      return None
+    # Lazy and possessive quantifiers.
+    if self.peek() in ['?', '+']:
+      self.pos += 1
+    return min_count
+
+# Returns the sorted literals of the prefilter of `regex`, see _RegexParser, or
+# None if no useful prefilter is known. Literals that contain another literal
+# of the prefilter are redundant and omitted.
+def compute_prefilter_literals(regex):
+  if not regex:
+    return None
+  parser = _RegexParser(regex)
+  try:
+    prefilter = parser.parse_alternation()
+    if parser.pos != len(regex):
+      return None
+  except _UnsupportedRegexError:
+    return None
+  # Single characters occur in too many strings to be worth it.
+  if prefilter is None or min(len(l) for l in prefilter) < 2:
+    return None
+  return sorted(l for l in prefilter
+                if not any(o != l and o in l for o in prefilter))
+
+
+# Generates the prefilters of the regexes of `patterns` (see _RegexParser):
+#
+# - kPrefilterLiterals is an array of the literals of all prefilters.
+# - kPrefilter__<index> contains the sorted indices of the literals of a
+#   prefilter in kPrefilterLiterals.
+# - kPatternPrefilters contains the prefilters of the positive and negative
+#   regexes of the patterns, at the patterns' indices in kPatterns.
+def generate_prefilters(patterns):
+  literal_to_id = {}
+  prefilter_to_index = {}
+
+  # Returns a C++ RegexPrefilter expression for `regex`.
+  def prefilter_expr(regex):
+    literals = compute_prefilter_literals(regex)
+    if literals is None:
+      return 'RegexPrefilter{}'
+    ids = tuple(sorted(memoize(l, literal_to_id) for l in literals))
+    return f'RegexPrefilter{{kPrefilter__{memoize(ids, prefilter_to_index)}}}'
+
+  pattern_prefilters = [
+      (prefilter_expr(p['positive_pattern']),
+       prefilter_expr(p['negative_pattern'])) for p in patterns
+  ]
+  if len(literal_to_id) > 2**16:
+    raise Exception('Too many prefilter literals for PrefilterLiteralId')
+
+  yield '// The literals of the prefilters of the patterns\' regexes.'
+  yield ('constexpr std::array<std::string_view, '
+         f'{len(literal_to_id)}> kPrefilterLiterals {{{{')
+  for literal, id in sorted(literal_to_id.items(), key=lambda item: item[1]):
+    yield f'/*[{id}]=*/{json.dumps(literal)},'
+  yield '}};'
+  yield ''
+  for ids, index in sorted(
+      prefilter_to_index.items(), key=lambda item: item[1]):
+    yield (f'constexpr PrefilterLiteralId kPrefilter__{index}[] {{' +
+           ', '.join(str(id) for id in ids) + '};')
+  yield ''
+  yield '// The prefilters of the patterns, at the same indices as kPatterns.'
+  yield 'constexpr MatchingPatternPrefilters kPatternPrefilters[] {'
+  for index, (positive, negative) in enumerate(pattern_prefilters):
+    yield (f'/*[{index}]=*/{{.positive = {positive}, '
+           f'.negative = {negative}}},')
+  yield '};'
+  yield ''
+
 # Generates a set of C++ constexpr constants to facilitate lookup of a set of
 # MatchingPatterns by a given tuple (pattern name, language code).
 #
@@ -111,17 +357,6 @@ def generate_matching_pattern_equals(name_to_lang_to_id_to_patternrefs,
 # lookup pattern name -> language code -> span of MatchPatternRefs, but it's
 # significantly simpler.
 def generate_cpp_constants(id_to_name_to_lang_to_patterns):
-  # Stores a `key` in `dictionary` and assigns it a natural number.
-  #
-  # For example, after memoize("foo", d) and memoize("bar", d),
-  # d = {"foo": 0, "bar": 1}. This is useful to generate a C++ array
-  # {"foo", "bar"} and referring to these elements by their indices
-  # 0 and 1.
-  def memoize(key, dictionary):
-    if key not in dictionary:
-      dictionary[key] = len(dictionary)
-    return dictionary[key]
-
   # Maps a Python Boolean to a C++ Boolean literal.
   def python_bool_to_cpp(b):
     return 'true' if b else 'false'
@@ -235,6 +470,7 @@ def generate_cpp_constants(id_to_name_to_lang_to_patterns):
   # - a map from names and languages and IDs to the their MatchingPatterns,
   #   represented as list of tuples (is_supplementary, pattern_index).
   pattern_to_index = {}
+  index_to_pattern = {}
   name_to_lang_to_id_to_patternrefs = defaultdict(
       lambda: defaultdict(lambda: defaultdict(list)))
   for id, name_to_lang_to_patterns in id_to_name_to_lang_to_patterns.items():
@@ -247,6 +483,7 @@ def generate_cpp_constants(id_to_name_to_lang_to_patterns):
                               pattern['supplementary'])
           pattern_index = memoize(
               json_to_cpp_pattern(pattern), pattern_to_index)
+          index_to_pattern.setdefault(pattern_index, pattern)
           patternrefs.append((is_supplementary, pattern_index))
 
   # Generate the C++ constants.
@@ -262,6 +499,9 @@ def generate_cpp_constants(id_to_name_to_lang_to_patterns):
   yield '};'
   yield ''
 
+  yield from generate_prefilters(
+      [index_to_pattern[i] for i in range(len(index_to_pattern))])
+
   min_pattern_id = min(id_to_name_to_lang_to_patterns.keys())
   max_pattern_id = max(id_to_name_to_lang_to_patterns.keys())
 
@@ -355,6 +595,7 @@ def generate_cpp_lines(id_to_name_to_lang_to_patterns):
 #include "base/types/cxx23_to_underlying.h"
 
 #include "components/autofill/core/browser/form_parsing/regex_patterns.h"
+#include "components/autofill/core/browser/form_parsing/regex_prefilter.h"
 #include "components/autofill/core/common/dense_set.h"
 #include "components/autofill/core/browser/form_parsing/autofill_parsing_utils.h"
 
@@ -20,6 +20,7 @@
 #include "base/command_line.h"
 #include "base/containers/contains.h"
 #include "base/containers/fixed_flat_map.h"
+#include "base/containers/span.h"
 #include "base/feature_list.h"
 #include "base/i18n/case_conversion.h"
 #include "base/logging.h"
@@ -111,6 +112,18 @@ std::string ServerTypesToString(const AutofillField* field) {
   return "[" + buffer.str() + "]";
 }
 
+// Returns whether the attributes of `a` and `b` that the parsers look at are
+// equal.
+bool HaveSameParsingInputs(const AutofillField& a, const AutofillField& b) {
+  return a.label() == b.label() && a.parseable_label() == b.parseable_label() &&
+         a.parseable_name() == b.parseable_name() &&
+         a.placeholder() == b.placeholder() &&
+         a.aria_description() == b.aria_description() &&
+         a.form_control_type() == b.form_control_type() &&
+         a.max_length() == b.max_length() && a.options() == b.options() &&
+         a.role() == b.role() && a.check_status() == b.check_status();
+}
+
 }  // namespace
 
 FormStructure::FormStructure(const FormData& form)
@@ -200,9 +213,13 @@ void FormStructure::DetermineHeuristicTypes(
   std::optional<FieldCandidatesMap> active_predictions;
   if (std::optional<PatternSource> pattern_source = GetActivePatternSource()) {
     context.pattern_source = *pattern_source;
-    active_predictions = ParseFieldTypesWithPatterns(context);
+    active_predictions = ParseFieldTypesIncrementally(context);
+    if (!active_predictions) {
+      active_predictions = ParseFieldTypesWithPatterns(context);
+    }
     AssignBestFieldTypes(*active_predictions, *pattern_source);
   }
+  cached_heuristic_types_.clear();
   DetermineNonActiveHeuristicTypes(std::move(active_predictions), context);
 
   UpdateAutofillCount();
@@ -466,6 +483,9 @@ void FormStructure::RetrieveFromCache(const FormStructure& cached_form,
     return match;
   };
 
+  // The cached field of each field of this form, or nullptr.
+  std::vector<const AutofillField*> matching_cached_fields;
+  matching_cached_fields.reserve(fields_.size());
   for (auto& field : *this) {
     const AutofillField* cached_field = find_field_by_id(field->global_id());
 
@@ -477,6 +497,8 @@ void FormStructure::RetrieveFromCache(const FormStructure& cached_form,
           find_field_with_unique_field_signature(field->GetFieldSignature());
     }
 
+    matching_cached_fields.push_back(cached_field);
+
     // Skip fields that we could not find.
     if (!cached_field)
       continue;
@@ -572,6 +594,11 @@ void FormStructure::RetrieveFromCache(const FormStructure& cached_form,
     field->set_field_log_events(cached_field->field_log_events());
   }
 
+  if (reason == RetrieveFromCacheReason::kFormParsing &&
+      base::FeatureList::IsEnabled(features::kAutofillIncrementalFormParsing)) {
+    RetrieveHeuristicTypesFromCache(cached_form, matching_cached_fields);
+  }
+
   UpdateAutofillCount();
 
   // Update form parsed timestamp
@@ -586,6 +613,59 @@ void FormStructure::RetrieveFromCache(const FormStructure& cached_form,
   form_signature_ = cached_form.form_signature_;
 }
 
+void FormStructure::RetrieveHeuristicTypesFromCache(
+    const FormStructure& cached_form,
+    const std::vector<const AutofillField*>& matching_cached_fields) {
+  cached_heuristic_types_.clear();
+  HeuristicSource source = GetActiveHeuristicSource();
+  if (!HeuristicSourceToPatternSource(source) ||
+      !cached_form.ShouldRunHeuristics()) {
+    return;
+  }
+  // If the cached form had too few fillable types, its candidates were cleared
+  // and the heuristic types don't tell how the fields were classified.
+  FieldTypeSet fillable_types;
+  for (const auto& field : cached_form) {
+    if (IsFillableFieldType(field->heuristic_type(source))) {
+      fillable_types.insert(field->heuristic_type(source));
+    }
+  }
+  if (fillable_types.size() < kMinRequiredFieldsForHeuristics) {
+    return;
+  }
+
+  std::map<const AutofillField*, size_t> cached_field_indices;
+  for (size_t i = 0; i < cached_form.field_count(); ++i) {
+    cached_field_indices[cached_form.field(i)] = i;
+  }
+  // Returns whether the fields at `i` and `i + 1` are neighbors in the cached
+  // form as well.
+  auto are_cached_neighbors = [&](size_t i) {
+    return matching_cached_fields[i] && matching_cached_fields[i + 1] &&
+           cached_field_indices[matching_cached_fields[i]] + 1 ==
+               cached_field_indices[matching_cached_fields[i + 1]];
+  };
+
+  // The parsers look at the neighbors of a field, so a field is only unchanged
+  // if its neighbors are the same as well.
+  cached_heuristic_types_.resize(fields_.size());
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    const AutofillField* cached_field = matching_cached_fields[i];
+    if (!cached_field || !HaveSameParsingInputs(*fields_[i], *cached_field)) {
+      continue;
+    }
+    size_t cached_index = cached_field_indices[cached_field];
+    bool same_predecessor =
+        i == 0 ? cached_index == 0 : are_cached_neighbors(i - 1);
+    bool same_successor = i + 1 == fields_.size()
+                              ? cached_index + 1 == cached_form.field_count()
+                              : are_cached_neighbors(i);
+    if (same_predecessor && same_successor) {
+      cached_heuristic_types_[i] = cached_field->heuristic_type(source);
+    }
+  }
+}
+
 void FormStructure::LogDetermineHeuristicTypesMetrics() {
   developer_engagement_metrics_ = 0;
   if (IsAutofillable()) {
@@ -673,6 +753,90 @@ FieldCandidatesMap FormStructure::ParseFieldTypesWithPatterns(
   return field_type_map;
 }
 
+std::optional<FieldCandidatesMap> FormStructure::ParseFieldTypesIncrementally(
+    ParsingContext& context) const {
+  if (cached_heuristic_types_.size() != fields_.size() ||
+      !ShouldRunHeuristics()) {
+    return std::nullopt;
+  }
+  const size_t neighborhood_size = std::max(
+      0, features::kAutofillIncrementalFormParsingNeighborhoodSizeParam.Get());
+
+  // The changed fields and their neighbors are classified again.
+  std::vector<bool> is_reparsed(fields_.size());
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    if (!cached_heuristic_types_[i]) {
+      std::fill(is_reparsed.begin() + (i - std::min(i, neighborhood_size)),
+                is_reparsed.begin() +
+                    std::min(fields_.size(), i + neighborhood_size + 1),
+                true);
+    }
+  }
+
+  FieldCandidatesMap field_type_map;
+  size_t parsed_fields = 0;
+  size_t reused_fields = 0;
+  for (size_t begin = 0; begin < fields_.size();) {
+    if (!is_reparsed[begin]) {
+      // Previous types are reused as the only candidate, so that they remain
+      // the best heuristic types.
+      if (*cached_heuristic_types_[begin] != NO_SERVER_DATA) {
+        field_type_map[fields_[begin]->global_id()].AddFieldCandidate(
+            *cached_heuristic_types_[begin], 1.0f);
+      }
+      ++reused_fields;
+      ++begin;
+      continue;
+    }
+    size_t end = begin;
+    while (end < fields_.size() && is_reparsed[end]) {
+      ++end;
+    }
+    // The parsers also see `neighborhood_size` fields of context on each side,
+    // but only the predictions for [begin, end) are used.
+    size_t window_begin = begin - std::min(begin, neighborhood_size);
+    size_t window_end = std::min(fields_.size(), end + neighborhood_size);
+    base::span<const std::unique_ptr<AutofillField>> window =
+        base::span(fields_).subspan(window_begin, window_end - window_begin);
+    FieldCandidatesMap window_type_map;
+    FormFieldParser::ParseFormFieldsPartially(
+        context, window, is_form_element(), window_type_map);
+    parsed_fields += window.size();
+    for (size_t i = begin; i < end; ++i) {
+      auto it = window_type_map.find(fields_[i]->global_id());
+      if (it != window_type_map.end()) {
+        field_type_map.insert(std::move(*it));
+      }
+    }
+    begin = end;
+  }
+
+  // The parsers apply some rules to the whole form, which are only checked
+  // here. If they might apply, the whole form is parsed again.
+  FieldTypeSet fillable_types;
+  bool has_form_wide_rules = false;
+  for (const auto& [field_id, candidates] : field_type_map) {
+    FieldType type = candidates.BestHeuristicType();
+    if (IsFillableFieldType(type)) {
+      fillable_types.insert(type);
+    }
+    // Standalone CVC fields depend on all other fields of the form.
+    has_form_wide_rules |= type == CREDIT_CARD_STANDALONE_VERIFICATION_CODE;
+  }
+  has_form_wide_rules |=
+      fillable_types.size() < kMinRequiredFieldsForHeuristics;
+  UMA_HISTOGRAM_BOOLEAN("Autofill.IncrementalFormParsing.FellBackToFullParse",
+                        has_form_wide_rules);
+  if (has_form_wide_rules) {
+    return std::nullopt;
+  }
+  UMA_HISTOGRAM_COUNTS_1000("Autofill.IncrementalFormParsing.ReparsedFields",
+                            parsed_fields);
+  UMA_HISTOGRAM_COUNTS_1000("Autofill.IncrementalFormParsing.ReusedFields",
+                            reused_fields);
+  return field_type_map;
+}
+
 void FormStructure::AssignBestFieldTypes(
     const FieldCandidatesMap& field_type_map,
     PatternSource pattern_source) {
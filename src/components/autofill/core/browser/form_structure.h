@@ -155,6 +155,9 @@ class FormStructure {
     //
     // - Also server predictions are preserved (while heuristic predictions
     //   are discarded because they will be generated during the parsing).
+    //   If features::kAutofillIncrementalFormParsing is enabled, the heuristic
+    //   types of unchanged fields are kept for DetermineHeuristicTypes() to
+    //   avoid parsing them again.
     kFormParsing,
 
     // kFormImport refers to the process of importing address profiles / credit
@@ -186,6 +189,14 @@ class FormStructure {
   void RetrieveFromCache(const FormStructure& cached_form,
                          RetrieveFromCacheReason reason);
 
+  // Remembers the active heuristic types of the fields that are unchanged
+  // since the `cached_form` in `cached_heuristic_types_`.
+  // `matching_cached_fields` contains the field of the `cached_form` for each
+  // field of `*this`, or nullptr.
+  void RetrieveHeuristicTypesFromCache(
+      const FormStructure& cached_form,
+      const std::vector<const AutofillField*>& matching_cached_fields);
+
   void LogDetermineHeuristicTypesMetrics();
 
   // Sets each field's `html_type` and `html_mode` based on the field's
@@ -389,6 +400,13 @@ class FormStructure {
   // `AssignBestFieldTypes()` to do so.
   FieldCandidatesMap ParseFieldTypesWithPatterns(ParsingContext& context) const;
 
+  // Like `ParseFieldTypesWithPatterns()`, but only classifies the fields that
+  // changed since the cached form and their neighbors. The other fields keep
+  // their `cached_heuristic_types_`. Returns nullopt if there are no cached
+  // types or if the whole form needs to be parsed.
+  std::optional<FieldCandidatesMap> ParseFieldTypesIncrementally(
+      ParsingContext& context) const;
+
   // Assigns the best heuristic types from the `field_type_map` to the heuristic
   // types of the corresponding fields for the `pattern_source`.
   void AssignBestFieldTypes(const FieldCandidatesMap& field_type_map,
@@ -536,6 +554,11 @@ class FormStructure {
   // small period of time.
   // Only used for voting-purposes.
   FormAssociations form_associations_;
+
+  // The active heuristic types of the fields, by index, if the fields are
+  // unchanged since the form was last parsed. Set by RetrieveFromCache() and
+  // consumed by DetermineHeuristicTypes().
+  std::vector<std::optional<FieldType>> cached_heuristic_types_;
 };
 
 LogBuffer& operator<<(LogBuffer& buffer, const FormStructure& form);
@@ -20,6 +20,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/unguessable_token.h"
 #include "build/build_config.h"
@@ -2497,4 +2498,48 @@ TEST_F(FormStructureTestImpl, SingleFieldEmailHeuristicsEnabled) {
   }
 }
 
+// Tests that incremental parsing of a changed form reuses the types of the
+// unchanged fields and results in the same types as parsing the whole form.
+TEST_F(FormStructureTestImpl, IncrementalParsingMatchesFullParsing) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeatureWithParameters(
+      features::kAutofillIncrementalFormParsing, {{"neighborhood_size", "1"}});
+  FormData form = test::GetFormData(
+      {.fields = {{.role = NAME_FIRST},
+                  {.role = NAME_LAST},
+                  {.role = EMAIL_ADDRESS},
+                  {.role = PHONE_HOME_WHOLE_NUMBER},
+                  {.role = ADDRESS_HOME_LINE1},
+                  {.role = ADDRESS_HOME_CITY},
+                  {.role = ADDRESS_HOME_ZIP}}});
+  FormStructure cached_form(form);
+  cached_form.DetermineHeuristicTypes(GeoIpCountryCode(""), nullptr, nullptr);
+
+  form.fields[2].set_label(u"Company");
+  form.fields[2].set_name(u"company");
+  FormStructure full_form(form);
+  full_form.DetermineHeuristicTypes(GeoIpCountryCode(""), nullptr, nullptr);
+
+  base::HistogramTester histogram_tester;
+  FormStructure incremental_form(form);
+  incremental_form.RetrieveFromCache(
+      cached_form, FormStructure::RetrieveFromCacheReason::kFormParsing);
+  incremental_form.DetermineHeuristicTypes(GeoIpCountryCode(""), nullptr,
+                                           nullptr);
+
+  EXPECT_EQ(COMPANY_NAME, incremental_form.field(2)->heuristic_type());
+  for (size_t i = 0; i < form.fields.size(); ++i) {
+    EXPECT_EQ(full_form.field(i)->heuristic_type(),
+              incremental_form.field(i)->heuristic_type());
+  }
+  // The changed field and its two neighbors are parsed with another neighbor
+  // on each side as context.
+  histogram_tester.ExpectUniqueSample(
+      "Autofill.IncrementalFormParsing.FellBackToFullParse", false, 1);
+  histogram_tester.ExpectUniqueSample(
+      "Autofill.IncrementalFormParsing.ReparsedFields", 5, 1);
+  histogram_tester.ExpectUniqueSample(
+      "Autofill.IncrementalFormParsing.ReusedFields", 4, 1);
+}
+
 }  // namespace autofill
@@ -88,6 +88,9 @@ void AutofillWebDataService::RemoveFormElementsAddedBetween(
       base::BindOnce(
           &AutofillWebDataBackendImpl::RemoveFormElementsAddedBetween,
           autofill_backend_, delete_begin, delete_end));
+  DCHECK(ui_task_runner_->RunsTasksInCurrentSequence());
+  for (auto& ui_observer : ui_observer_list_)
+    ui_observer.OnAutocompleteEntriesWillBeRemoved();
 }
 
 void AutofillWebDataService::RemoveFormValueForElementName(
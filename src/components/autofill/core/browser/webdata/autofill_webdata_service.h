@@ -70,8 +70,8 @@ class AutofillWebDataService : public WebDataServiceBase {
   // Removes form elements recorded for Autocomplete from the database.
   void RemoveFormElementsAddedBetween(const base::Time& delete_begin,
                                       const base::Time& delete_end);
-  void RemoveFormValueForElementName(const std::u16string& name,
-                                     const std::u16string& value);
+  virtual void RemoveFormValueForElementName(const std::u16string& name,
+                                             const std::u16string& value);
 
   // Schedules a task to add an Autofill profile to the web database.
   void AddAutofillProfile(const AutofillProfile& profile);
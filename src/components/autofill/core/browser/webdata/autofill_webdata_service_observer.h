@@ -42,6 +42,10 @@ class AutofillWebDataServiceObserverOnUISequence {
   // Sync. Can be called multiple times for the same `model_type`.
   virtual void OnAutofillChangedBySync(syncer::ModelType model_type) {}
 
+  // Called on UI sequence when the removal of the Autocomplete entries of a
+  // time range is scheduled, e.g., because the user clears browsing data.
+  virtual void OnAutocompleteEntriesWillBeRemoved() {}
+
  protected:
   virtual ~AutofillWebDataServiceObserverOnUISequence() {}
 };
@@ -29,6 +29,10 @@ class MockAutofillWebDataService : public AutofillWebDataService {
                int limit,
                WebDataServiceConsumer* consumer),
               (override));
+  MOCK_METHOD(void,
+              RemoveFormValueForElementName,
+              (const std::u16string& name, const std::u16string& value),
+              (override));
   MOCK_METHOD(WebDataServiceBase::Handle,
               RemoveExpiredAutocompleteEntries,
               (WebDataServiceConsumer * consumer),
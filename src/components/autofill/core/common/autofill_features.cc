@@ -688,6 +688,31 @@ const base::FeatureParam<int>
     kAutofillEnableCacheForRegexMatchingCacheSizeParam{
         &kAutofillEnableCacheForRegexMatching, "cache_size", 1000};
 
+// When enabled, regexes of the parsing patterns are only evaluated on strings
+// that contain one of the literals that the regex requires. All literals are
+// searched in a single pass over the string.
+BASE_FEATURE(kAutofillEnableRegexPrefilters,
+             "AutofillEnableRegexPrefilters",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+// When enabled, a form that is parsed again because it changed keeps the
+// heuristic types of the fields that didn't change, and only the changed fields
+// and their neighbors are parsed again. The number of neighbors on each side is
+// controlled by kAutofillIncrementalFormParsingNeighborhoodSizeParam.
+BASE_FEATURE(kAutofillIncrementalFormParsing,
+             "AutofillIncrementalFormParsing",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+const base::FeatureParam<int>
+    kAutofillIncrementalFormParsingNeighborhoodSizeParam{
+        &kAutofillIncrementalFormParsing, "neighborhood_size", 8};
+
+// When enabled, the AutocompleteHistoryManager loads the Autocomplete entries
+// of a field name into memory once and computes the suggestions for every
+// keystroke synchronously, instead of querying the database each time.
+BASE_FEATURE(kAutofillAutocompleteSuggestionIndex,
+             "AutofillAutocompleteSuggestionIndex",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 // When enabled, various deduplication related metrics are logged on startup
 // and on import.
 // TODO(b/325452461): Remove once rolled out.
@@ -0,0 +1,214 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/bookmarks/browser/bookmark_binary_serializer.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <utility>
+
+#include "base/containers/span.h"
+#include "base/pickle.h"
+
+namespace bookmarks {
+
+namespace {
+
+// Starts the file, so that it can't be mistaken for JSON. The last byte is
+// the version of the format.
+constexpr char kMagic[] = {'\0', 'B', 'K', 'M', 'K', 'B', 'I', 1};
+
+// Deeper values are rejected, to bound the recursion on corrupt files.
+constexpr int kMaxDepth = 200;
+
+// The tags of the value types. Persisted to disk; don't renumber.
+enum class Tag : uint8_t {
+  kNone = 0,
+  kBool = 1,
+  kInt = 2,
+  kDouble = 3,
+  kString = 4,
+  kBinary = 5,
+  kDict = 6,
+  kList = 7,
+};
+
+void WriteValue(const base::Value& value, base::Pickle& pickle);
+
+void WriteDict(const base::Value::Dict& dict, base::Pickle& pickle) {
+  pickle.WriteUInt32(static_cast<uint32_t>(dict.size()));
+  for (const auto [key, value] : dict) {
+    pickle.WriteString(key);
+    WriteValue(value, pickle);
+  }
+}
+
+void WriteValue(const base::Value& value, base::Pickle& pickle) {
+  switch (value.type()) {
+    case base::Value::Type::NONE:
+      pickle.WriteUInt16(static_cast<uint16_t>(Tag::kNone));
+      return;
+    case base::Value::Type::BOOLEAN:
+      pickle.WriteUInt16(static_cast<uint16_t>(Tag::kBool));
+      pickle.WriteBool(value.GetBool());
+      return;
+    case base::Value::Type::INTEGER:
+      pickle.WriteUInt16(static_cast<uint16_t>(Tag::kInt));
+      pickle.WriteInt(value.GetInt());
+      return;
+    case base::Value::Type::DOUBLE:
+      pickle.WriteUInt16(static_cast<uint16_t>(Tag::kDouble));
+      pickle.WriteDouble(value.GetDouble());
+      return;
+    case base::Value::Type::STRING:
+      pickle.WriteUInt16(static_cast<uint16_t>(Tag::kString));
+      pickle.WriteString(value.GetString());
+      return;
+    case base::Value::Type::BINARY:
+      pickle.WriteUInt16(static_cast<uint16_t>(Tag::kBinary));
+      pickle.WriteData(value.GetBlob());
+      return;
+    case base::Value::Type::DICT:
+      pickle.WriteUInt16(static_cast<uint16_t>(Tag::kDict));
+      WriteDict(value.GetDict(), pickle);
+      return;
+    case base::Value::Type::LIST:
+      pickle.WriteUInt16(static_cast<uint16_t>(Tag::kList));
+      pickle.WriteUInt32(static_cast<uint32_t>(value.GetList().size()));
+      for (const base::Value& item : value.GetList()) {
+        WriteValue(item, pickle);
+      }
+      return;
+  }
+}
+
+std::optional<base::Value> ReadValue(base::PickleIterator& iterator,
+                                     int depth);
+
+std::optional<base::Value::Dict> ReadDict(base::PickleIterator& iterator,
+                                          int depth) {
+  uint32_t size = 0;
+  if (!iterator.ReadUInt32(&size)) {
+    return std::nullopt;
+  }
+  base::Value::Dict dict;
+  for (uint32_t i = 0; i < size; ++i) {
+    std::string key;
+    if (!iterator.ReadString(&key)) {
+      return std::nullopt;
+    }
+    std::optional<base::Value> value = ReadValue(iterator, depth + 1);
+    if (!value) {
+      return std::nullopt;
+    }
+    dict.Set(key, std::move(*value));
+  }
+  return dict;
+}
+
+std::optional<base::Value> ReadValue(base::PickleIterator& iterator,
+                                     int depth) {
+  uint16_t tag = 0;
+  if (depth > kMaxDepth || !iterator.ReadUInt16(&tag)) {
+    return std::nullopt;
+  }
+  switch (static_cast<Tag>(tag)) {
+    case Tag::kNone:
+      return base::Value();
+    case Tag::kBool: {
+      bool value = false;
+      if (!iterator.ReadBool(&value)) {
+        return std::nullopt;
+      }
+      return base::Value(value);
+    }
+    case Tag::kInt: {
+      int value = 0;
+      if (!iterator.ReadInt(&value)) {
+        return std::nullopt;
+      }
+      return base::Value(value);
+    }
+    case Tag::kDouble: {
+      double value = 0;
+      if (!iterator.ReadDouble(&value)) {
+        return std::nullopt;
+      }
+      return base::Value(value);
+    }
+    case Tag::kString: {
+      std::string value;
+      if (!iterator.ReadString(&value)) {
+        return std::nullopt;
+      }
+      return base::Value(std::move(value));
+    }
+    case Tag::kBinary: {
+      const char* data = nullptr;
+      size_t length = 0;
+      if (!iterator.ReadData(&data, &length)) {
+        return std::nullopt;
+      }
+      return base::Value(base::as_bytes(base::make_span(data, length)));
+    }
+    case Tag::kDict: {
+      std::optional<base::Value::Dict> dict = ReadDict(iterator, depth);
+      if (!dict) {
+        return std::nullopt;
+      }
+      return base::Value(std::move(*dict));
+    }
+    case Tag::kList: {
+      uint32_t size = 0;
+      if (!iterator.ReadUInt32(&size)) {
+        return std::nullopt;
+      }
+      base::Value::List list;
+      for (uint32_t i = 0; i < size; ++i) {
+        std::optional<base::Value> item = ReadValue(iterator, depth + 1);
+        if (!item) {
+          return std::nullopt;
+        }
+        list.Append(std::move(*item));
+      }
+      return base::Value(std::move(list));
+    }
+  }
+  // An unknown tag.
+  return std::nullopt;
+}
+
+}  // namespace
+
+bool IsBinaryBookmarksData(std::string_view data) {
+  return data.starts_with(std::string_view(kMagic, sizeof(kMagic)));
+}
+
+std::string SerializeBookmarksToBinary(const base::Value::Dict& value) {
+  base::Pickle pickle;
+  WriteDict(value, pickle);
+  std::string output(kMagic, sizeof(kMagic));
+  output.append(reinterpret_cast<const char*>(pickle.data()), pickle.size());
+  return output;
+}
+
+std::optional<base::Value::Dict> DeserializeBookmarksFromBinary(
+    std::string_view data) {
+  if (!IsBinaryBookmarksData(data)) {
+    return std::nullopt;
+  }
+  data.remove_prefix(sizeof(kMagic));
+  base::Pickle pickle =
+      base::Pickle::WithUnownedBuffer(base::as_byte_span(data));
+  base::PickleIterator iterator(pickle);
+  std::optional<base::Value::Dict> value = ReadDict(iterator, /*depth=*/0);
+  // Trailing bytes are as suspect as missing ones.
+  if (!value || !iterator.ReachedEnd()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+}  // namespace bookmarks
@@ -0,0 +1,36 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_BOOKMARKS_BROWSER_BOOKMARK_BINARY_SERIALIZER_H_
+#define COMPONENTS_BOOKMARKS_BROWSER_BOOKMARK_BINARY_SERIALIZER_H_
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "base/values.h"
+
+namespace bookmarks {
+
+// A compact binary encoding of the values produced by `BookmarkCodec`, used
+// instead of JSON for the bookmarks file with `kBookmarkStorageBinaryFormat`.
+// The values are written in a `base::Pickle` after a magic prefix, with their
+// types as tags and without the indentation, quoting and escaping of JSON.
+// Loading accepts both formats, so that the file stays readable when the
+// feature is disabled again.
+
+// Returns whether `data` starts with the prefix of the binary format.
+bool IsBinaryBookmarksData(std::string_view data);
+
+// Encodes `value` in the binary format.
+std::string SerializeBookmarksToBinary(const base::Value::Dict& value);
+
+// Decodes `data` previously encoded with `SerializeBookmarksToBinary()`.
+// Returns nullopt if `data` is truncated or otherwise malformed.
+std::optional<base::Value::Dict> DeserializeBookmarksFromBinary(
+    std::string_view data);
+
+}  // namespace bookmarks
+
+#endif  // COMPONENTS_BOOKMARKS_BROWSER_BOOKMARK_BINARY_SERIALIZER_H_
@@ -0,0 +1,89 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/bookmarks/browser/bookmark_binary_serializer.h"
+
+#include <optional>
+#include <string>
+
+#include "base/json/json_writer.h"
+#include "base/values.h"
+#include "components/bookmarks/browser/bookmark_codec.h"
+#include "components/bookmarks/browser/bookmark_model.h"
+#include "components/bookmarks/test/test_bookmark_client.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace bookmarks {
+
+namespace {
+
+base::Value::Dict EncodeModel(const BookmarkModel& model) {
+  BookmarkCodec codec;
+  return codec.Encode(model.bookmark_bar_node(), model.other_node(),
+                      model.mobile_node(), "sync metadata");
+}
+
+TEST(BookmarkBinarySerializerTest, RoundTripsCodecOutput) {
+  std::unique_ptr<BookmarkModel> model = TestBookmarkClient::CreateModel();
+  const BookmarkNode* folder =
+      model->AddFolder(model->bookmark_bar_node(), 0, u"Folder é");
+  const BookmarkNode* url =
+      model->AddURL(folder, 0, u"Title", GURL("http://url1.com"));
+  model->SetNodeMetaInfo(url, "key", "value");
+  model->AddURL(model->other_node(), 0, u"", GURL("http://url2.com"));
+
+  const base::Value::Dict value = EncodeModel(*model);
+  const std::string data = SerializeBookmarksToBinary(value);
+  EXPECT_TRUE(IsBinaryBookmarksData(data));
+
+  std::optional<base::Value::Dict> decoded =
+      DeserializeBookmarksFromBinary(data);
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(value, *decoded);
+
+  // The binary format is more compact than the JSON format.
+  std::string json;
+  ASSERT_TRUE(base::JSONWriter::WriteWithOptions(
+      value, base::JSONWriter::OPTIONS_PRETTY_PRINT, &json));
+  EXPECT_FALSE(IsBinaryBookmarksData(json));
+  EXPECT_LT(data.size(), json.size());
+}
+
+TEST(BookmarkBinarySerializerTest, RoundTripsAllTypes) {
+  base::Value::Dict value;
+  value.Set("none", base::Value());
+  value.Set("bool", true);
+  value.Set("int", -7);
+  value.Set("double", 0.5);
+  value.Set("string", "string");
+  value.Set("binary", base::Value(base::Value::BlobStorage({1, 2, 3})));
+  value.Set("list", base::Value::List().Append(1).Append(
+                        base::Value::Dict().Set("nested", "")));
+
+  std::optional<base::Value::Dict> decoded =
+      DeserializeBookmarksFromBinary(SerializeBookmarksToBinary(value));
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(value, *decoded);
+}
+
+TEST(BookmarkBinarySerializerTest, RejectsMalformedData) {
+  base::Value::Dict value;
+  value.Set("string", "string");
+  value.Set("list", base::Value::List().Append(1).Append(2));
+  const std::string data = SerializeBookmarksToBinary(value);
+
+  EXPECT_FALSE(DeserializeBookmarksFromBinary("{}").has_value());
+  EXPECT_FALSE(DeserializeBookmarksFromBinary("").has_value());
+  for (size_t size = 0; size < data.size(); ++size) {
+    EXPECT_FALSE(
+        DeserializeBookmarksFromBinary(data.substr(0, size)).has_value())
+        << size;
+  }
+  EXPECT_FALSE(DeserializeBookmarksFromBinary(data + "x").has_value());
+}
+
+}  // namespace
+
+}  // namespace bookmarks
@@ -4,6 +4,7 @@
 
 #include "components/bookmarks/browser/bookmark_load_details.h"
 
+#include "base/feature_list.h"
 #include "base/uuid.h"
 #include "components/bookmarks/browser/bookmark_uuids.h"
 #include "components/bookmarks/browser/titled_url_index.h"
@@ -104,6 +105,8 @@ void BookmarkLoadDetails::AddManagedNode(
 }
 
 void BookmarkLoadDetails::CreateIndices() {
+  const bool add_to_titled_url_index =
+      !base::FeatureList::IsEnabled(kTitledUrlIndexIncrementalBuild);
   local_or_syncable_uuid_index_.insert(root_node_.get());
   static_assert(kNumDefaultTopLevelPermanentFolders == 3u,
                 "The code below assumes three permanent nodes");
@@ -112,9 +115,11 @@ void BookmarkLoadDetails::CreateIndices() {
         child.get() == account_other_folder_node_ ||
         child.get() == account_mobile_folder_node_) {
       // Use a dedicated index for account folders and desdendants.
-      AddNodeToIndexRecursive(child.get(), account_uuid_index_);
+      AddNodeToIndexRecursive(child.get(), account_uuid_index_,
+                              add_to_titled_url_index);
     } else {
-      AddNodeToIndexRecursive(child.get(), local_or_syncable_uuid_index_);
+      AddNodeToIndexRecursive(child.get(), local_or_syncable_uuid_index_,
+                              add_to_titled_url_index);
     }
   }
 
@@ -134,17 +139,21 @@ const BookmarkNode* BookmarkLoadDetails::RootNodeForTest() const {
   return url_index_ ? url_index_->root() : root_node_.get();
 }
 
-void BookmarkLoadDetails::AddNodeToIndexRecursive(BookmarkNode* node,
-                                                  UuidIndex& uuid_index) {
+void BookmarkLoadDetails::AddNodeToIndexRecursive(
+    BookmarkNode* node,
+    UuidIndex& uuid_index,
+    bool add_to_titled_url_index) {
   uuid_index.insert(node);
   if (node->is_url()) {
-    if (node->url().is_valid()) {
+    if (add_to_titled_url_index && node->url().is_valid()) {
       titled_url_index_->Add(node);
     }
   } else {
-    titled_url_index_->AddPath(node);
+    if (add_to_titled_url_index) {
+      titled_url_index_->AddPath(node);
+    }
     for (const auto& child : node->children()) {
-      AddNodeToIndexRecursive(child.get(), uuid_index);
+      AddNodeToIndexRecursive(child.get(), uuid_index, add_to_titled_url_index);
     }
   }
 }
@@ -124,6 +124,9 @@ class BookmarkLoadDetails {
   // before this function.
   void AddManagedNode(std::unique_ptr<BookmarkPermanentNode> managed_node);
 
+  // Creates the UUID and URL indices, and the title index unless
+  // `kTitledUrlIndexIncrementalBuild` is enabled, in which case `BookmarkModel`
+  // builds it after loading.
   void CreateIndices();
 
   void ResetPermanentNodePointers();
@@ -137,7 +140,10 @@ class BookmarkLoadDetails {
 
  private:
   // Adds node to the various indices, recursing through all children as well.
-  void AddNodeToIndexRecursive(BookmarkNode* node, UuidIndex& uuid_index);
+  // The title index is skipped unless `add_to_titled_url_index`.
+  void AddNodeToIndexRecursive(BookmarkNode* node,
+                               UuidIndex& uuid_index,
+                               bool add_to_titled_url_index);
 
   std::unique_ptr<BookmarkNode> root_node_;
   std::unique_ptr<TitledUrlIndex> titled_url_index_;
@@ -12,17 +12,22 @@
 
 #include "base/check.h"
 #include "base/check_op.h"
+#include "base/containers/adapters.h"
 #include "base/containers/contains.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/feature_list.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback_helpers.h"
 #include "base/i18n/string_compare.h"
 #include "base/memory/raw_ptr.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/notreached.h"
 #include "base/observer_list.h"
 #include "base/strings/string_util.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/task/thread_pool.h"
+#include "base/timer/elapsed_timer.h"
 #include "base/uuid.h"
 #include "components/bookmarks/browser/bookmark_load_details.h"
 #include "components/bookmarks/browser/bookmark_model_observer.h"
@@ -153,6 +158,7 @@ BookmarkModel::~BookmarkModel() {
   // `TitledUrlIndex` owns  a `TypedCountSorter` that keeps a raw_ptr to the
   // client. So titled_url_index_ must be reset first.
   titled_url_index_.reset();
+  titled_url_index_pending_nodes_.clear();
 
   // ChromeBookmarkClient indirectly observes the model. The client should thus
   // be reset before the observer list.
@@ -663,6 +669,7 @@ void BookmarkModel::SetTitle(const BookmarkNode* node,
   // The title index doesn't support changing the title, instead we remove then
   // add it back. Only do this for URL nodes. A directory node can have its
   // title changed but should be excluded from the index.
+  FinishBuildingTitledUrlIndex();
   if (node->is_url()) {
     titled_url_index_->Remove(node);
   } else {
@@ -704,6 +711,7 @@ void BookmarkModel::SetURL(const BookmarkNode* node,
 
   // The title index doesn't support changing the URL, instead we remove then
   // add it back.
+  FinishBuildingTitledUrlIndex();
   titled_url_index_->Remove(mutable_node);
   url_index_->SetUrl(mutable_node, url);
   titled_url_index_->Add(mutable_node);
@@ -1125,6 +1133,18 @@ std::vector<TitledUrlMatch> BookmarkModel::GetBookmarksMatching(
     return {};
   }
 
+  if (!titled_url_index_pending_nodes_.empty()) {
+    // The index is still being built, scan the bookmarks instead.
+    std::vector<const TitledUrlNode*> nodes;
+    for (const BookmarkNode* node : titled_url_index_pending_nodes_) {
+      if (node->is_url() && node->url().is_valid()) {
+        nodes.push_back(node);
+      }
+    }
+    return titled_url_index_->GetResultsMatchingByScan(
+        query, nodes, max_count_hint, matching_algorithm);
+  }
+
   return titled_url_index_->GetResultsMatching(query, max_count_hint,
                                                matching_algorithm);
 }
@@ -1260,6 +1280,26 @@ void BookmarkModel::DoneLoading(std::unique_ptr<BookmarkLoadDetails> details) {
 
   titled_url_index_->SetNodeSorter(
       std::make_unique<TypedCountSorter>(client_.get()));
+  if (base::FeatureList::IsEnabled(kTitledUrlIndexIncrementalBuild)) {
+    // The loader left the index empty. Collect the nodes in the order loading
+    // adds them, depth first.
+    std::vector<const BookmarkNode*> stack;
+    for (const auto& child : base::Reversed(root_->children())) {
+      stack.push_back(child.get());
+    }
+    while (!stack.empty()) {
+      const BookmarkNode* node = stack.back();
+      stack.pop_back();
+      titled_url_index_pending_nodes_.push_back(node);
+      for (const auto& child : base::Reversed(node->children())) {
+        stack.push_back(child.get());
+      }
+    }
+    titled_url_index_build_start_time_ = base::TimeTicks::Now();
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(&BookmarkModel::BuildTitledUrlIndexSlice,
+                                  AsWeakPtr()));
+  }
   // Sorting the permanent nodes has to happen on the main thread, so we do it
   // here, after loading completes.
   root_->SortChildren(VisibilityComparator(client_.get()));
@@ -1336,10 +1376,65 @@ BookmarkNode* BookmarkModel::AddNode(
   return node_ptr;
 }
 
+void BookmarkModel::BuildTitledUrlIndexSlice() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // Each slice is short enough not to delay input on the model's sequence.
+  constexpr base::TimeDelta kSliceBudget = base::Milliseconds(5);
+  if (titled_url_index_pending_nodes_.empty()) {
+    return;
+  }
+
+  base::ElapsedTimer timer;
+  while (titled_url_index_added_node_count_ <
+             titled_url_index_pending_nodes_.size() &&
+         timer.Elapsed() < kSliceBudget) {
+    AddNodeToTitledUrlIndex(
+        titled_url_index_pending_nodes_[titled_url_index_added_node_count_++]);
+  }
+  if (titled_url_index_added_node_count_ <
+      titled_url_index_pending_nodes_.size()) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(&BookmarkModel::BuildTitledUrlIndexSlice,
+                                  AsWeakPtr()));
+    return;
+  }
+  FinishBuildingTitledUrlIndex();
+}
+
+void BookmarkModel::FinishBuildingTitledUrlIndex() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (titled_url_index_pending_nodes_.empty()) {
+    return;
+  }
+
+  while (titled_url_index_added_node_count_ <
+         titled_url_index_pending_nodes_.size()) {
+    AddNodeToTitledUrlIndex(
+        titled_url_index_pending_nodes_[titled_url_index_added_node_count_++]);
+  }
+  titled_url_index_pending_nodes_.clear();
+  titled_url_index_pending_nodes_.shrink_to_fit();
+  titled_url_index_added_node_count_ = 0;
+  base::UmaHistogramMediumTimes(
+      "Bookmarks.TitledUrlIndex.IncrementalBuildTime",
+      base::TimeTicks::Now() - titled_url_index_build_start_time_);
+}
+
+void BookmarkModel::AddNodeToTitledUrlIndex(const BookmarkNode* node) {
+  if (node->is_url()) {
+    if (node->url().is_valid()) {
+      titled_url_index_->Add(node);
+    }
+  } else {
+    titled_url_index_->AddPath(node);
+  }
+}
+
 void BookmarkModel::AddNodeToIndicesRecursive(
     const BookmarkNode* node,
     NodeTypeForUuidLookup type_for_uuid_lookup) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  FinishBuildingTitledUrlIndex();
 
   bool uuid_is_unique = uuid_index_[type_for_uuid_lookup].insert(node).second;
   DUMP_WILL_BE_CHECK(uuid_is_unique);
@@ -1400,6 +1495,7 @@ void BookmarkModel::RemoveNodeFromIndicesRecursive(
   DCHECK(loaded_);
   DCHECK(!is_permanent_node(node));
 
+  FinishBuildingTitledUrlIndex();
   if (node->is_url()) {
     titled_url_index_->Remove(node);
   } else {
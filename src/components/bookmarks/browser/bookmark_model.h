@@ -24,6 +24,7 @@
 #include "base/observer_list.h"
 #include "base/sequence_checker.h"
 #include "base/supports_user_data.h"
+#include "base/time/time.h"
 #include "base/uuid.h"
 #include "components/bookmarks/browser/bookmark_client.h"
 #include "components/bookmarks/browser/bookmark_node.h"
@@ -535,6 +536,19 @@ class BookmarkModel : public CoreBookmarkModel,
                         bool added_by_user,
                         NodeTypeForUuidLookup type_for_uuid_lookup);
 
+  // Adds the next few nodes of `titled_url_index_pending_nodes_` to
+  // `titled_url_index_`, and schedules the next slice if nodes remain. See
+  // `kTitledUrlIndexIncrementalBuild`.
+  void BuildTitledUrlIndexSlice();
+
+  // Adds all the pending nodes to `titled_url_index_`. Must be called before
+  // the nodes change, as pending nodes may otherwise be deleted, or be indexed
+  // twice.
+  void FinishBuildingTitledUrlIndex();
+
+  // Adds `node`, but not its children, to `titled_url_index_`, as loading does.
+  void AddNodeToTitledUrlIndex(const BookmarkNode* node);
+
   // Adds `node` to all lookups indices and recursively invokes this for all
   // children.
   void AddNodeToIndicesRecursive(const BookmarkNode* node,
@@ -662,6 +676,13 @@ class BookmarkModel : public CoreBookmarkModel,
 
   std::unique_ptr<TitledUrlIndex> titled_url_index_;
 
+  // With `kTitledUrlIndexIncrementalBuild`, the nodes loaded in tree order,
+  // and how many of them were added to `titled_url_index_` so far. Empty once
+  // they all were.
+  std::vector<raw_ptr<const BookmarkNode>> titled_url_index_pending_nodes_;
+  size_t titled_url_index_added_node_count_ = 0;
+  base::TimeTicks titled_url_index_build_start_time_;
+
   // All nodes indexed by UUID. An independent index exists for each value in
   // NodeTypeForUuidLookup, because UUID uniqueness is guaranteed only within
   // the scope of each NodeTypeForUuidLookup value.
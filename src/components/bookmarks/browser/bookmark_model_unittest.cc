@@ -39,6 +39,7 @@
 #include "components/bookmarks/browser/bookmark_undo_provider.h"
 #include "components/bookmarks/browser/bookmark_utils.h"
 #include "components/bookmarks/browser/bookmark_uuids.h"
+#include "components/bookmarks/browser/titled_url_index.h"
 #include "components/bookmarks/browser/titled_url_match.h"
 #include "components/bookmarks/browser/url_and_title.h"
 #include "components/bookmarks/common/bookmark_features.h"
@@ -2221,6 +2222,84 @@ TEST(BookmarkModelLoadTest, NodesPopulatedOnLoad) {
                                     1);
 }
 
+TEST(BookmarkModelLoadTest, TitledUrlIndexBuiltIncrementally) {
+  base::test::ScopedFeatureList features{kTitledUrlIndexIncrementalBuild};
+  base::ScopedTempDir tmp_dir;
+  ASSERT_TRUE(tmp_dir.CreateUniqueTempDir());
+  base::test::TaskEnvironment task_environment{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  auto model =
+      std::make_unique<BookmarkModel>(std::make_unique<TestBookmarkClient>());
+  model->Load(tmp_dir.GetPath());
+  test::WaitForBookmarkModelToLoad(model.get());
+
+  const BookmarkNode* folder =
+      model->AddFolder(model->bookmark_bar_node(), 0, u"Folder");
+  model->AddURL(folder, 0, u"Foo", GURL("http://foo.com"));
+  model->AddURL(model->other_node(), 0, u"Bar", GURL("http://bar.com"));
+  task_environment.FastForwardUntilNoTasksRemain();
+
+  base::HistogramTester histogram_tester;
+  model =
+      std::make_unique<BookmarkModel>(std::make_unique<TestBookmarkClient>());
+  model->Load(tmp_dir.GetPath());
+  test::WaitForBookmarkModelToLoad(model.get());
+
+  // Matches are found whether the index is built yet or not, including those
+  // of the folder titles.
+  auto matches = model->GetBookmarksMatching(
+      u"folder foo", /*max_count=*/10,
+      query_parser::MatchingAlgorithm::DEFAULT);
+  ASSERT_EQ(1u, matches.size());
+  EXPECT_EQ(GURL("http://foo.com"), matches[0].node->GetTitledUrlNodeUrl());
+
+  task_environment.FastForwardUntilNoTasksRemain();
+  histogram_tester.ExpectTotalCount(
+      "Bookmarks.TitledUrlIndex.IncrementalBuildTime", 1);
+  matches = model->GetBookmarksMatching(
+      u"folder foo", /*max_count=*/10,
+      query_parser::MatchingAlgorithm::DEFAULT);
+  ASSERT_EQ(1u, matches.size());
+  EXPECT_EQ(GURL("http://foo.com"), matches[0].node->GetTitledUrlNodeUrl());
+  matches = model->GetBookmarksMatching(
+      u"bar", /*max_count=*/10, query_parser::MatchingAlgorithm::DEFAULT);
+  EXPECT_EQ(1u, matches.size());
+}
+
+TEST(BookmarkModelLoadTest, TitledUrlIndexBuildFinishedOnChange) {
+  base::test::ScopedFeatureList features{kTitledUrlIndexIncrementalBuild};
+  base::ScopedTempDir tmp_dir;
+  ASSERT_TRUE(tmp_dir.CreateUniqueTempDir());
+  base::test::TaskEnvironment task_environment{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  auto model =
+      std::make_unique<BookmarkModel>(std::make_unique<TestBookmarkClient>());
+  model->Load(tmp_dir.GetPath());
+  test::WaitForBookmarkModelToLoad(model.get());
+  model->AddURL(model->bookmark_bar_node(), 0, u"Foo", GURL("http://foo.com"));
+  task_environment.FastForwardUntilNoTasksRemain();
+
+  base::HistogramTester histogram_tester;
+  model =
+      std::make_unique<BookmarkModel>(std::make_unique<TestBookmarkClient>());
+  model->Load(tmp_dir.GetPath());
+  test::WaitForBookmarkModelToLoad(model.get());
+
+  // Removing a node adds the rest of the loaded nodes to the index first.
+  model->Remove(model->bookmark_bar_node()->children()[0].get(),
+                metrics::BookmarkEditSource::kOther, FROM_HERE);
+  histogram_tester.ExpectTotalCount(
+      "Bookmarks.TitledUrlIndex.IncrementalBuildTime", 1);
+  EXPECT_TRUE(model
+                  ->GetBookmarksMatching(
+                      u"foo", /*max_count=*/10,
+                      query_parser::MatchingAlgorithm::DEFAULT)
+                  .empty());
+  task_environment.FastForwardUntilNoTasksRemain();
+  histogram_tester.ExpectTotalCount(
+      "Bookmarks.TitledUrlIndex.IncrementalBuildTime", 1);
+}
+
 TEST(BookmarkModelLoadTest, NodesPopulatedIncludingAccountNodesOnLoad) {
   base::test::ScopedFeatureList features{
       syncer::kEnableBookmarkFoldersForAccountStorage};
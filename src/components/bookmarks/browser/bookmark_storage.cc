@@ -20,6 +20,7 @@
 #include "base/task/task_traits.h"
 #include "base/task/thread_pool.h"
 #include "base/uuid.h"
+#include "components/bookmarks/browser/bookmark_binary_serializer.h"
 #include "components/bookmarks/browser/bookmark_codec.h"
 #include "components/bookmarks/browser/bookmark_model.h"
 #include "components/bookmarks/browser/bookmark_node.h"
@@ -81,6 +82,10 @@ bool ShouldSaveBackupFile(
 
 }  // namespace
 
+BASE_FEATURE(kBookmarkStorageBinaryFormat,
+             "BookmarkStorageBinaryFormat",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 // static
 constexpr base::TimeDelta BookmarkStorage::kSaveDelay;
 
@@ -124,6 +129,15 @@ BookmarkStorage::GetSerializedDataProducerForBackgroundSequence() {
   base::Value::Dict value =
       EncodeModelToDict(model_, permanent_node_selection_);
 
+  if (base::FeatureList::IsEnabled(kBookmarkStorageBinaryFormat)) {
+    return base::BindOnce(
+        [](base::Value::Dict value) -> std::optional<std::string> {
+          // This runs on the background sequence.
+          return SerializeBookmarksToBinary(value);
+        },
+        std::move(value));
+  }
+
   return base::BindOnce(
       [](base::Value::Dict value) -> std::optional<std::string> {
         // This runs on the background sequence.
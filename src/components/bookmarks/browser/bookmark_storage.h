@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include "base/feature_list.h"
 #include "base/files/file_path.h"
 #include "base/files/important_file_writer.h"
 #include "base/functional/callback_forward.h"
@@ -25,6 +26,11 @@ namespace bookmarks {
 
 class BookmarkModel;
 
+// If enabled, bookmarks are saved in the compact binary format of
+// bookmark_binary_serializer.h instead of pretty-printed JSON. Loading reads
+// both formats regardless.
+BASE_DECLARE_FEATURE(kBookmarkStorageBinaryFormat);
+
 // BookmarkStorage handles writing bookmark model to disk (as opposed to
 // ModelLoader which takes care of loading).
 //
@@ -15,6 +15,7 @@
 #include "base/test/task_environment.h"
 #include "base/test/test_file_util.h"
 #include "base/time/time.h"
+#include "components/bookmarks/browser/bookmark_binary_serializer.h"
 #include "components/bookmarks/browser/bookmark_model.h"
 #include "components/bookmarks/test/test_bookmark_client.h"
 #include "components/sync/base/features.h"
@@ -81,6 +82,30 @@ TEST(BookmarkStorageTest, ShouldSaveFileToDiskAfterDelay) {
       "Bookmarks.Storage.TimeSinceLastScheduledSave", 1);
 }
 
+TEST(BookmarkStorageTest, ShouldSaveBinaryFormat) {
+  base::test::ScopedFeatureList features{kBookmarkStorageBinaryFormat};
+  std::unique_ptr<BookmarkModel> model = CreateModelWithOneBookmark();
+
+  const base::FilePath bookmarks_file_path =
+      GetTestBookmarksFileNameInNewTempDir();
+
+  base::test::TaskEnvironment task_environment{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  BookmarkStorage storage(model.get(),
+                          BookmarkStorage::kSelectLocalOrSyncableNodes,
+                          bookmarks_file_path);
+  storage.ScheduleSave();
+  task_environment.FastForwardUntilNoTasksRemain();
+
+  std::string file_content;
+  ASSERT_TRUE(base::ReadFileToString(bookmarks_file_path, &file_content));
+  EXPECT_TRUE(IsBinaryBookmarksData(file_content));
+  std::optional<base::Value::Dict> value =
+      DeserializeBookmarksFromBinary(file_content);
+  ASSERT_TRUE(value.has_value());
+  EXPECT_NE(nullptr, value->FindDict("roots"));
+}
+
 TEST(BookmarkStorageTest, ShouldSaveFileDespiteShutdownWhileScheduled) {
   std::unique_ptr<BookmarkModel> model = CreateModelWithOneBookmark();
 
@@ -9,12 +9,12 @@
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
-#include "base/json/json_file_value_serializer.h"
 #include "base/json/json_reader.h"
 #include "base/numerics/clamped_math.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/task/task_traits.h"
 #include "base/task/thread_pool.h"
+#include "components/bookmarks/browser/bookmark_binary_serializer.h"
 #include "components/bookmarks/browser/bookmark_codec.h"
 #include "components/bookmarks/browser/bookmark_load_details.h"
 #include "components/bookmarks/browser/titled_url_index.h"
@@ -26,16 +26,24 @@ namespace bookmarks {
 
 namespace {
 
-// Loads and deserializes a JSON file determined by `file_path` and returns it
-// in the form of a dictionary, or nullopt if something fails.
+// Loads and deserializes a file determined by `file_path` and returns it in
+// the form of a dictionary, or nullopt if something fails. The file may be
+// JSON, or in the binary format of bookmark_binary_serializer.h.
 std::optional<base::Value::Dict> LoadFileToDict(
     const base::FilePath& file_path) {
+  std::string contents;
+  if (!base::ReadFileToString(file_path, &contents)) {
+    return std::nullopt;
+  }
+
+  if (IsBinaryBookmarksData(contents)) {
+    return DeserializeBookmarksFromBinary(contents);
+  }
+
   // Titles may end up containing invalid utf and we shouldn't throw away
   // all bookmarks if some titles have invalid utf.
-  JSONFileValueDeserializer deserializer(file_path,
-                                         base::JSON_REPLACE_INVALID_CHARACTERS);
-  std::unique_ptr<base::Value> root = deserializer.Deserialize(
-      /*error_code=*/nullptr, /*error_message=*/nullptr);
+  std::optional<base::Value> root =
+      base::JSONReader::Read(contents, base::JSON_REPLACE_INVALID_CHARACTERS);
   if (!root || !root->is_dict()) {
     // The bookmark file exists but was not deserialized properly.
     return std::nullopt;
@@ -8,10 +8,13 @@
 
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/json/json_reader.h"
 #include "base/path_service.h"
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/task_environment.h"
+#include "base/test/test_file_util.h"
 #include "base/test/test_future.h"
+#include "components/bookmarks/browser/bookmark_binary_serializer.h"
 #include "components/bookmarks/browser/bookmark_client.h"
 #include "components/bookmarks/browser/bookmark_load_details.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -93,6 +96,38 @@ TEST(ModelLoaderTest, LoadNonEmptyModel) {
                                     /*expected_count=*/0);
 }
 
+TEST(ModelLoaderTest, LoadNonEmptyModelInBinaryFormat) {
+  base::test::TaskEnvironment task_environment;
+  std::string json;
+  ASSERT_TRUE(base::ReadFileToString(
+      GetTestDataDir().AppendASCII("bookmarks/model_with_sync_metadata_1.json"),
+      &json));
+  std::optional<base::Value::Dict> value = base::JSONReader::ReadDict(json);
+  ASSERT_TRUE(value.has_value());
+  const base::FilePath test_file =
+      base::CreateUniqueTempDirectoryScopedToTest().AppendASCII("Bookmarks");
+  ASSERT_TRUE(base::WriteFile(test_file, SerializeBookmarksToBinary(*value)));
+
+  base::test::TestFuture<std::unique_ptr<BookmarkLoadDetails>> details_future;
+  scoped_refptr<ModelLoader> loader = ModelLoader::Create(
+      /*local_or_syncable_file_path=*/test_file,
+      /*account_file_path=*/base::FilePath(),
+      /*loaded_account_bookmarks_file_as_local_or_syncable_bookmarks_for_uma=*/
+      false,
+      /*load_managed_node_callback=*/LoadManagedNodeCallback(),
+      details_future.GetCallback());
+
+  const std::unique_ptr<BookmarkLoadDetails>& details = details_future.Get();
+  ASSERT_NE(nullptr, details);
+
+  // The checksum of the JSON file still matches.
+  EXPECT_FALSE(details->required_recovery());
+  EXPECT_EQ(11, details->max_id());
+  EXPECT_EQ(1u, details->bb_node()->children().size());
+  EXPECT_EQ("dummy-sync-metadata-1",
+            details->local_or_syncable_sync_metadata_str());
+}
+
 TEST(ModelLoaderTest, LoadNonEmptyAccountBookmarksAsLocalOrSyncable) {
   base::HistogramTester histogram_tester;
   base::test::TaskEnvironment task_environment;
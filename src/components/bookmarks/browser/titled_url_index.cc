@@ -11,6 +11,8 @@
 #include <unordered_set>
 #include <utility>
 
+#include "base/check_op.h"
+#include "base/feature_list.h"
 #include "base/i18n/case_conversion.h"
 #include "base/i18n/unicodestring.h"
 #include "base/logging.h"
@@ -30,16 +32,37 @@ namespace bookmarks {
 
 namespace {
 
+constexpr size_t kTrigramLength = 3;
+
 // Return true if `prefix` is a prefix of `string`.
 bool IsPrefix(const std::u16string& prefix, const std::u16string& string) {
   return prefix.size() <= string.size() &&
          prefix.compare(0, prefix.size(), string, 0, prefix.size()) == 0;
 }
 
+// `ExtractQueryWords()` splits on symbols like '@'. That's usually good; e.g.
+// it allows 'xyz@gmail' to match 'xyz gmail'. But for inputs starting with
+// '@', like '@h', the user's more likely wants to enter the history scope
+// search than to select a 'https://google.com' bookmark.
+bool IsScopeQuery(const std::u16string& query,
+                  const std::vector<std::u16string>& terms) {
+  return query.starts_with('@') && query.size() >= 2 && terms[0].size() >= 1 &&
+         query[1] == terms[0][0];
+}
+
 }  // namespace
 
+BASE_FEATURE(kTitledUrlIndexTrigrams,
+             "TitledUrlIndexTrigrams",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+BASE_FEATURE(kTitledUrlIndexIncrementalBuild,
+             "TitledUrlIndexIncrementalBuild",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 TitledUrlIndex::TitledUrlIndex(std::unique_ptr<TitledUrlNodeSorter> sorter)
-    : sorter_(std::move(sorter)) {}
+    : use_trigram_index_(base::FeatureList::IsEnabled(kTitledUrlIndexTrigrams)),
+      sorter_(std::move(sorter)) {}
 
 TitledUrlIndex::~TitledUrlIndex() = default;
 
@@ -82,18 +105,9 @@ std::vector<TitledUrlMatch> TitledUrlIndex::GetResultsMatching(
     query_parser::MatchingAlgorithm matching_algorithm) {
   const std::u16string query = Normalize(input_query);
   std::vector<std::u16string> terms = ExtractQueryWords(query);
-  if (terms.empty())
+  if (terms.empty() || IsScopeQuery(query, terms))
     return {};
 
-  // `ExtractQueryWords()` splits on symbols like '@'. That's usually good; e.g.
-  // it allows 'xyz@gmail' to match 'xyz gmail'. But for inputs starting with
-  // '@', like '@h', the user's more likely wants to enter the history scope
-  // search than to select a 'https://google.com' bookmark.
-  if (query.starts_with('@') && query.size() >= 2 && terms[0].size() >= 1 &&
-      query[1] == terms[0][0]) {
-    return {};
-  }
-
   // `matches` shouldn't exclude nodes that don't match every query term, as the
   // query terms may match in the ancestors. `MatchTitledUrlNodeWithQuery()`
   // below will filter out nodes that neither match nor ancestor-match every
@@ -119,6 +133,36 @@ std::vector<TitledUrlMatch> TitledUrlIndex::GetResultsMatching(
                                       max_count);
 }
 
+std::vector<TitledUrlMatch> TitledUrlIndex::GetResultsMatchingByScan(
+    const std::u16string& input_query,
+    const std::vector<const TitledUrlNode*>& nodes,
+    size_t max_count,
+    query_parser::MatchingAlgorithm matching_algorithm) {
+  const std::u16string query = Normalize(input_query);
+  std::vector<std::u16string> terms = ExtractQueryWords(query);
+  if (terms.empty() || IsScopeQuery(query, terms))
+    return {};
+
+  query_parser::QueryNodeVector query_nodes;
+  query_parser::QueryParser::ParseQueryNodes(query, matching_algorithm,
+                                             &query_nodes);
+
+  // Only the nodes that match are sorted, and matched again for the positions
+  // of the matches in the sorted order.
+  TitledUrlNodes matching_nodes;
+  for (const TitledUrlNode* node : nodes) {
+    if (MatchTitledUrlNodeWithQuery(node, query_nodes, terms))
+      matching_nodes.push_back(node);
+  }
+  if (matching_nodes.empty())
+    return {};
+
+  TitledUrlNodes sorted_nodes;
+  SortMatches(TitledUrlNodeSet(std::move(matching_nodes)), &sorted_nodes);
+  return MatchTitledUrlNodesWithQuery(sorted_nodes, query_nodes, terms,
+                                      max_count);
+}
+
 // static
 std::u16string TitledUrlIndex::Normalize(std::u16string_view text) {
   UErrorCode status = U_ZERO_ERROR;
@@ -378,6 +422,9 @@ TitledUrlIndex::TitledUrlNodes TitledUrlIndex::RetrieveNodesMatchingTerm(
     return TitledUrlNodes(i->second.begin(), i->second.end());
   }
 
+  if (use_trigram_index_ && term.size() >= kTrigramLength)
+    return RetrieveNodesMatchingTrigrams(term);
+
   // Loop through index adding all entries that start with term to
   // |prefix_matches|.
   TitledUrlNodes prefix_matches;
@@ -389,6 +436,34 @@ TitledUrlIndex::TitledUrlNodes TitledUrlIndex::RetrieveNodesMatchingTerm(
   return prefix_matches;
 }
 
+TitledUrlIndex::TitledUrlNodes TitledUrlIndex::RetrieveNodesMatchingTrigrams(
+    const std::u16string& term) const {
+  DCHECK_GE(term.size(), kTrigramLength);
+  std::vector<const TitledUrlNodeSet*> trigram_nodes;
+  for (size_t i = 0; i + kTrigramLength <= term.size(); ++i) {
+    auto it = trigram_index_.find(MakeTrigram(term, i));
+    if (it == trigram_index_.end())
+      return {};
+    trigram_nodes.push_back(&it->second);
+  }
+
+  // Intersect starting from the fewest nodes, which bounds the lookups.
+  auto fewest = base::ranges::min_element(
+      trigram_nodes, {}, [](const TitledUrlNodeSet* nodes) {
+        return nodes->size();
+      });
+  TitledUrlNodes matches;
+  for (const TitledUrlNode* node : **fewest) {
+    if (base::ranges::all_of(trigram_nodes,
+                             [&](const TitledUrlNodeSet* nodes) {
+                               return nodes->contains(node);
+                             })) {
+      matches.push_back(node);
+    }
+  }
+  return matches;
+}
+
 bool TitledUrlIndex::DoesTermMatchPath(
     const std::u16string& term,
     query_parser::MatchingAlgorithm matching_algorithm) const {
@@ -435,6 +510,10 @@ std::vector<std::u16string> TitledUrlIndex::ExtractIndexTerms(
 void TitledUrlIndex::RegisterNode(const std::u16string& term,
                                   const TitledUrlNode* node) {
   index_[term].insert(node);
+  if (!use_trigram_index_)
+    return;
+  for (size_t i = 0; i + kTrigramLength <= term.size(); ++i)
+    trigram_index_[MakeTrigram(term, i)].insert(node);
 }
 
 void TitledUrlIndex::UnregisterNode(const std::u16string& term,
@@ -448,6 +527,27 @@ void TitledUrlIndex::UnregisterNode(const std::u16string& term,
   i->second.erase(node);
   if (i->second.empty())
     index_.erase(i);
+
+  if (!use_trigram_index_)
+    return;
+  for (size_t j = 0; j + kTrigramLength <= term.size(); ++j) {
+    auto trigram = trigram_index_.find(MakeTrigram(term, j));
+    if (trigram == trigram_index_.end())
+      continue;
+    trigram->second.erase(node);
+    if (trigram->second.empty())
+      trigram_index_.erase(trigram);
+  }
+}
+
+// static
+TitledUrlIndex::Trigram TitledUrlIndex::MakeTrigram(const std::u16string& term,
+                                                    size_t position) {
+  DCHECK_LE(position + kTrigramLength, term.size());
+  Trigram trigram = position == 0 ? 1 : 0;
+  for (size_t i = position; i < position + kTrigramLength; ++i)
+    trigram = (trigram << 16) | term[i];
+  return trigram;
 }
 
 }  // namespace bookmarks
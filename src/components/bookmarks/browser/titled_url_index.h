@@ -6,6 +6,7 @@
 #define COMPONENTS_BOOKMARKS_BROWSER_TITLED_URL_INDEX_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <map>
 #include <memory>
@@ -27,11 +28,24 @@ class TitledUrlNode;
 
 struct TitledUrlMatch;
 
+// If enabled, `TitledUrlIndex` also indexes the trigrams of each term, and
+// retrieves the nodes prefix matching terms of 3 or more characters by
+// intersecting the nodes of their trigrams, instead of unioning the nodes of
+// every term with the prefix.
+BASE_DECLARE_FEATURE(kTitledUrlIndexTrigrams);
+
+// If enabled, `BookmarkModel` reports the bookmarks loaded before their
+// `TitledUrlIndex` is built, and builds it in slices on the model's sequence.
+// Until it's done, searches scan the bookmarks with
+// `GetResultsMatchingByScan()`.
+BASE_DECLARE_FEATURE(kTitledUrlIndexIncrementalBuild);
+
 // TitledUrlIndex maintains an index of paired titles and URLs for quick lookup.
 //
 // TitledUrlIndex maintains the index (index_) as a map of sets. The map (type
 // Index) maps from a lower case string to the set (type TitledUrlNodeSet) of
-// TitledUrlNodes that contain that string in their title or URL.
+// TitledUrlNodes that contain that string in their title or URL. With
+// `kTitledUrlIndexTrigrams`, it also maintains `trigram_index_`, see below.
 class TitledUrlIndex {
  public:
   using TitledUrlNodeSet =
@@ -71,6 +85,15 @@ class TitledUrlIndex {
       size_t max_count,
       query_parser::MatchingAlgorithm matching_algorithm);
 
+  // Like `GetResultsMatching()`, but matches each of `nodes`, which don't need
+  // to be in the index, instead of looking up the index. This is much slower,
+  // for when the index isn't built yet.
+  std::vector<TitledUrlMatch> GetResultsMatchingByScan(
+      const std::u16string& query,
+      const std::vector<const TitledUrlNode*>& nodes,
+      size_t max_count,
+      query_parser::MatchingAlgorithm matching_algorithm);
+
   // Returns a normalized version of the UTF16 string `text`.  If it fails to
   // normalize the string, returns `text` itself as a best-effort.
   static std::u16string Normalize(std::u16string_view text);
@@ -81,6 +104,10 @@ class TitledUrlIndex {
   using TitledUrlNodes =
       std::vector<raw_ptr<const TitledUrlNode, CtnExperimental>>;
   using Index = std::map<std::u16string, TitledUrlNodeSet>;
+  // 3 UTF-16 code units, and whether they start a term, packed by
+  // `MakeTrigram()`.
+  using Trigram = uint64_t;
+  using TrigramIndex = std::map<Trigram, TitledUrlNodeSet>;
 
   // Constructs |sorted_nodes| by copying the matches in |matches| and sorting
   // them.
@@ -124,6 +151,15 @@ class TitledUrlIndex {
       const std::u16string& term,
       query_parser::MatchingAlgorithm matching_algorithm) const;
 
+  // Returns the nodes with a term starting with the trigram at the start of
+  // `term`, and with every other trigram of `term` in some term. This includes
+  // every node with a term prefixed by `term`, along with a few false positives
+  // where the trigrams come from different terms, which the matching in
+  // `MatchTitledUrlNodeWithQuery()` filters out. `term` must have at least 3
+  // characters.
+  TitledUrlNodes RetrieveNodesMatchingTrigrams(
+      const std::u16string& term) const;
+
   // Return true if `term` matches any path. in `path_index_`.
   bool DoesTermMatchPath(
       const std::u16string& term,
@@ -143,6 +179,9 @@ class TitledUrlIndex {
   // Removes |node| from |index_|.
   void UnregisterNode(const std::u16string& term, const TitledUrlNode* node);
 
+  // Returns the trigram of `term` at `position`.
+  static Trigram MakeTrigram(const std::u16string& term, size_t position);
+
   // A map of terms and the nodes containing those terms in their titles or
   // URLs. E.g., given 2 bookmarks titled 'x y x' and 'x z', `index` would
   // contain: `{ x: set[node1, node2], y: set[node1], z: set[node2] }`.
@@ -159,6 +198,17 @@ class TitledUrlIndex {
   // much fewer nodes.
   std::map<std::u16string, size_t> path_index_;
 
+  // Whether `kTitledUrlIndexTrigrams` is enabled.
+  const bool use_trigram_index_;
+  // A map of the trigrams of the terms in `index_` and the nodes containing
+  // terms with those trigrams. E.g., given 2 bookmarks titled 'abcd' and
+  // 'bcd', `trigram_index_` would contain:
+  // `{ ^abc: set[node1], bcd: set[node1], ^bcd: set[node2] }`, where '^' marks
+  // the trigrams starting a term. A node stays in the set of a trigram for as
+  // long as it's indexed, even if several of its terms have the trigram, as
+  // nodes are always removed along with all of their terms.
+  TrigramIndex trigram_index_;
+
   std::unique_ptr<TitledUrlNodeSorter> sorter_;
 };
 
@@ -0,0 +1,130 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/bookmarks/browser/titled_url_index.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/rand_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/timer/elapsed_timer.h"
+#include "components/bookmarks/browser/titled_url_match.h"
+#include "components/bookmarks/browser/titled_url_node.h"
+#include "components/query_parser/query_parser.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+namespace bookmarks {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "TitledUrlIndex.";
+constexpr char kMetricBuild[] = "build";
+constexpr char kMetricLookup[] = "lookup";
+
+constexpr size_t kBookmarkCount = 50000;
+// Words are drawn from a vocabulary skewed toward the first words, so that
+// some terms match many bookmarks, and most match few.
+constexpr int kVocabularySize = 20000;
+constexpr size_t kWordsPerTitle = 5;
+
+std::string RandomWord() {
+  const int rank = base::RandInt(0, kVocabularySize - 1);
+  return "word" + base::NumberToString(rank * rank / kVocabularySize);
+}
+
+class PerfTitledUrlNode : public TitledUrlNode {
+ public:
+  PerfTitledUrlNode(const std::u16string& title, const GURL& url)
+      : title_(title), url_(url) {}
+
+  const std::u16string& GetTitledUrlNodeTitle() const override {
+    return title_;
+  }
+  const GURL& GetTitledUrlNodeUrl() const override { return url_; }
+  std::vector<std::u16string_view> GetTitledUrlNodeAncestorTitles()
+      const override {
+    return {};
+  }
+
+ private:
+  std::u16string title_;
+  GURL url_;
+};
+
+}  // namespace
+
+class TitledUrlIndexPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    for (size_t i = 0; i < kBookmarkCount; ++i) {
+      std::string title;
+      std::string path;
+      for (size_t j = 0; j < kWordsPerTitle; ++j) {
+        title += " " + RandomWord();
+        path += "/" + RandomWord();
+      }
+      nodes_.push_back(std::make_unique<PerfTitledUrlNode>(
+          base::UTF8ToUTF16(title),
+          GURL("https://site" + base::NumberToString(i % 1000) + ".com" +
+               path)));
+    }
+  }
+
+  // Builds an index of `nodes_` and reports how long it took, and how long
+  // the lookups took, under `story`.
+  void RunStory(const std::string& story) {
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricBuild, "ms");
+    reporter.RegisterImportantMetric(kMetricLookup, "us");
+
+    base::ElapsedTimer build_timer;
+    TitledUrlIndex index;
+    for (const auto& node : nodes_) {
+      index.Add(node.get());
+    }
+    reporter.AddResult(kMetricBuild, build_timer.Elapsed().InMillisecondsF());
+
+    // Prefixes of common words, which match many terms, and of rarer ones.
+    const std::vector<std::u16string> queries = {
+        u"wor", u"word1", u"word12 site", u"word199 word2 https",
+        u"word19999"};
+    constexpr int kIterations = 20;
+    base::ElapsedTimer lookup_timer;
+    size_t matches = 0;
+    for (int i = 0; i < kIterations; ++i) {
+      for (const std::u16string& query : queries) {
+        matches += index
+                       .GetResultsMatching(
+                           query, 50, query_parser::MatchingAlgorithm::DEFAULT)
+                       .size();
+      }
+    }
+    EXPECT_GT(matches, 0u);
+    reporter.AddResult(kMetricLookup,
+                       lookup_timer.Elapsed().InMicrosecondsF() /
+                           (kIterations * queries.size()));
+  }
+
+  std::vector<std::unique_ptr<PerfTitledUrlNode>> nodes_;
+};
+
+TEST_F(TitledUrlIndexPerfTest, SyntheticBookmarks) {
+  RunStory("SyntheticBookmarks");
+}
+
+TEST_F(TitledUrlIndexPerfTest, SyntheticBookmarksTrigrams) {
+  base::test::ScopedFeatureList feature_list(kTitledUrlIndexTrigrams);
+  RunStory("SyntheticBookmarksTrigrams");
+}
+
+}  // namespace bookmarks
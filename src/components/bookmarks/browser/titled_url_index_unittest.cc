@@ -106,6 +106,8 @@ class TitledUrlIndexFake : public TitledUrlIndex {
     return MatchTitledUrlNodeWithQuery(&node, query_nodes, query_terms)
         .has_value();
   }
+
+  size_t trigram_count() const { return trigram_index_.size(); }
 };
 
 namespace {
@@ -711,6 +713,51 @@ TEST_F(TitledUrlIndexTest, RetrieveNodesMatchingAllTerms) {
   };
 }
 
+TEST_F(TitledUrlIndexTest, RetrieveNodesMatchingAllTerms_Trigrams) {
+  base::test::ScopedFeatureList feature_list(kTitledUrlIndexTrigrams);
+  ResetNodes();
+  TitledUrlNode* node =
+      AddNode("term1 term2 other xyz ab", GURL("http://foo.com")).first;
+  TitledUrlNode* split_node =
+      AddNode("abcx xbce", GURL("http://bar.com")).first;
+
+  struct TestData {
+    const std::string query;
+    const std::vector<TitledUrlNode*> retrieved;
+  } data[] = {{"term other", {node}},
+              // Should not match midword.
+              {"term ther", {}},
+              {"erm", {}},
+              // Short input terms should only return exact matches.
+              {"xy", {}},
+              {"ab", {node}},
+              {"abc", {split_node}},
+              // The trigrams of a term may come from different node terms.
+              {"abce", {split_node}},
+              {"abcd", {}}};
+
+  for (const TestData& test_data : data) {
+    SCOPED_TRACE("Query: " + test_data.query);
+    std::vector<std::u16string> terms =
+        base::SplitString(base::UTF8ToUTF16(test_data.query), u" ",
+                          base::TRIM_WHITESPACE, base::SPLIT_WANT_ALL);
+    auto matches = index()->RetrieveNodesMatchingAllTerms(
+        terms, query_parser::MatchingAlgorithm::DEFAULT);
+    EXPECT_EQ(matches.size(), test_data.retrieved.size());
+    for (TitledUrlNode* retrieved : test_data.retrieved)
+      EXPECT_TRUE(matches.contains(retrieved));
+  }
+
+  // The node retrieved from the trigrams of different terms doesn't match.
+  EXPECT_TRUE(GetResultsMatching("abce", 10).empty());
+  EXPECT_EQ(GetResultsMatching("abc", 10).size(), 1u);
+
+  index()->Remove(node);
+  index()->Remove(split_node);
+  EXPECT_TRUE(GetResultsMatching("abc", 10).empty());
+  EXPECT_EQ(index()->trigram_count(), 0u);
+}
+
 TEST_F(TitledUrlIndexTest, RetrieveNodesMatchingAnyTerms_PathMatch) {
   ResetNodes();
   AddNode("term1 term2 other xyz ab", GURL("http://foo.com"));
@@ -10,6 +10,7 @@
 #include "base/containers/contains.h"
 #include "base/dcheck_is_on.h"
 #include "base/files/file_util.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/ranges/algorithm.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
@@ -35,6 +36,9 @@ const int32_t kNoneCategoryId = -2;
 // This should be compared with the version provided the model metadata.
 const int32_t kMeaninglessPrefixV2MinVersion = 2;
 
+// The maximum number of model annotations kept in memory.
+const size_t kMaxCachedModelAnnotations = 1000;
+
 const base::FilePath::CharType kOverrideListBasePath[] =
     FILE_PATH_LITERAL("override_list.pb.gz");
 
@@ -158,7 +162,8 @@ AnnotatorImpl::AnnotatorImpl(
           background_task_runner,
           optimization_guide::proto::OPTIMIZATION_TARGET_PAGE_TOPICS_V2,
           model_metadata),
-      background_task_runner_(background_task_runner) {
+      background_task_runner_(background_task_runner),
+      model_annotation_cache_(kMaxCachedModelAnnotations) {
   // Unloading the model is done via custom logic in this class.
   SetShouldUnloadModelOnComplete(false);
 }
@@ -314,22 +319,34 @@ void AnnotatorImpl::AnnotateSingleInput(
     }
   }
 
+  auto cached = model_annotation_cache_.Get(processed_input);
+  base::UmaHistogramBoolean("BrowsingTopics.Annotator.UsedCachedAnnotation",
+                            cached != model_annotation_cache_.end());
+  if (cached != model_annotation_cache_.end()) {
+    annotation->topics = cached->second;
+    std::move(single_input_done_signal).Run();
+    // |annotation| may have been destroyed, do not use it past here.
+    return;
+  }
+
   ExecuteModelWithInput(
       base::BindOnce(
           &AnnotatorImpl::PostprocessCategoriesToBatchAnnotationResult,
           weak_ptr_factory_.GetWeakPtr(), std::move(single_input_done_signal),
-          annotation),
+          annotation, processed_input),
       processed_input);
 }
 
 void AnnotatorImpl::PostprocessCategoriesToBatchAnnotationResult(
     base::OnceClosure single_input_done_signal,
     Annotation* annotation,
+    const std::string& processed_input,
     const std::optional<std::vector<tflite::task::core::Category>>& output) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   if (output) {
     annotation->topics = ExtractCategoriesFromModelOutput(*output).value_or(
         std::vector<int32_t>{});
+    model_annotation_cache_.Put(processed_input, annotation->topics);
   }
 
   std::move(single_input_done_signal).Run();
@@ -472,6 +489,9 @@ void AnnotatorImpl::OnModelUpdated(
     return;
   }
 
+  // Annotations from the previous model, if any, no longer apply.
+  model_annotation_cache_.Clear();
+
   if (!model_info.has_value() || !model_info->GetModelMetadata()) {
     return;
   }
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "base/callback_list.h"
+#include "base/containers/lru_cache.h"
 #include "base/files/file_path.h"
 #include "base/functional/callback.h"
 #include "base/memory/weak_ptr.h"
@@ -100,7 +101,8 @@ class AnnotatorImpl : public Annotator,
   std::string PreprocessHost(const std::string& host) const;
 
   // Runs a single input through the ML model, setting the result in
-  // |annotation|.
+  // |annotation|. Inputs annotated by the current model before are served from
+  // |model_annotation_cache_|.
   void AnnotateSingleInput(base::OnceClosure single_input_done_signal,
                            Annotation* annotation);
 
@@ -115,6 +117,7 @@ class AnnotatorImpl : public Annotator,
   void PostprocessCategoriesToBatchAnnotationResult(
       base::OnceClosure single_input_done_signal,
       Annotation* annotation,
+      const std::string& processed_input,
       const std::optional<std::vector<tflite::task::core::Category>>& output);
 
   // Used to read the override list file on a background thread.
@@ -131,6 +134,13 @@ class AnnotatorImpl : public Annotator,
   std::optional<std::unordered_map<std::string, std::vector<int32_t>>>
       override_list_;
 
+  // The topics the model produced for recently annotated inputs, keyed by the
+  // preprocessed host. Topics are calculated from mostly the same hosts every
+  // epoch, so this avoids running the model on them again. Cleared whenever the
+  // model is updated. Used on the UI thread.
+  base::HashingLRUCache<std::string, std::vector<int32_t>>
+      model_annotation_cache_;
+
   // The version of topics model provided by the server in the model metadata
   // which specifies the expected functionality of execution not contained
   // within the model itself (e.g., preprocessing/post processing).
@@ -76,13 +76,19 @@ class TestAnnotatorImpl : public AnnotatorImpl {
   void ExecuteModelWithInput(ExecutionCallback callback,
                              const std::string& input) override {
     inputs_.push_back(input);
-    std::move(callback).Run(std::nullopt);
+    std::move(callback).Run(model_output_);
   }
 
   const std::vector<std::string>& inputs() const { return inputs_; }
 
+  void set_model_output(
+      std::optional<std::vector<tflite::task::core::Category>> model_output) {
+    model_output_ = std::move(model_output);
+  }
+
  private:
   std::vector<std::string> inputs_;
+  std::optional<std::vector<tflite::task::core::Category>> model_output_;
 };
 
 class BrowsingTopicsAnnotatorImplTest : public testing::Test {
@@ -298,6 +304,64 @@ TEST_F(BrowsingTopicsAnnotatorImplTest, NoneCategoryBelowMinWeight) {
   EXPECT_THAT(*categories, testing::UnorderedElementsAre(1, 2));
 }
 
+TEST_F(BrowsingTopicsAnnotatorImplTest, ModelAnnotationsAreCached) {
+  base::HistogramTester histogram_tester;
+
+  optimization_guide::proto::PageTopicsModelMetadata model_metadata;
+  model_metadata.set_version(123);
+  model_metadata.set_taxonomy_version(kTaxonomyVersionV2);
+  auto* category_params = model_metadata.mutable_output_postprocessing_params()
+                              ->mutable_category_params();
+  category_params->set_max_categories(4);
+  category_params->set_min_none_weight(0.8);
+  category_params->set_min_category_weight(0.01);
+  category_params->set_min_normalized_weight_within_top_n(0.1);
+
+  optimization_guide::proto::Any any_metadata;
+  any_metadata.set_type_url(
+      "type.googleapis.com/com.foo.PageTopicsModelMetadata");
+  model_metadata.SerializeToString(any_metadata.mutable_value());
+  SendModelToAnnotator(any_metadata);
+
+  annotator()->set_model_output(
+      std::vector<tflite::task::core::Category>{{"1", 0.5}, {"2", 0.4}});
+
+  auto annotate = [&](const std::vector<std::string>& hosts) {
+    std::vector<Annotation> result;
+    // The callback is run synchronously in this test.
+    annotator()->BatchAnnotate(
+        base::BindOnce(
+            [](std::vector<Annotation>* result_out,
+               const std::vector<Annotation>& annotations) {
+              *result_out = annotations;
+            },
+            &result),
+        hosts);
+    return result;
+  };
+
+  std::vector<Annotation> annotations = annotate({"foo.com"});
+  ASSERT_EQ(annotations.size(), 1U);
+  EXPECT_THAT(annotations[0].topics, testing::UnorderedElementsAre(1, 2));
+
+  // "foo.com" is served from the cache, also under a meaningless prefix.
+  annotations = annotate({"www.foo.com", "bar.com"});
+  ASSERT_EQ(annotations.size(), 2U);
+  EXPECT_THAT(annotations[0].topics, testing::UnorderedElementsAre(1, 2));
+  EXPECT_THAT(annotations[1].topics, testing::UnorderedElementsAre(1, 2));
+  EXPECT_THAT(annotator()->inputs(), testing::ElementsAre("foo com", "bar com"));
+  histogram_tester.ExpectBucketCount(
+      "BrowsingTopics.Annotator.UsedCachedAnnotation", true, 1);
+  histogram_tester.ExpectBucketCount(
+      "BrowsingTopics.Annotator.UsedCachedAnnotation", false, 2);
+
+  // A new model clears the cache.
+  SendModelToAnnotator(any_metadata);
+  annotate({"foo.com"});
+  EXPECT_THAT(annotator()->inputs(),
+              testing::ElementsAre("foo com", "bar com", "foo com"));
+}
+
 TEST_F(BrowsingTopicsAnnotatorImplTest, HostPreprocessingV1) {
   std::vector<std::pair<std::string, std::string>> tests = {
       {"www.chromium.org", "chromium org"},
@@ -207,7 +207,7 @@ CastStreamingSession::ReceiverSessionClient::InitializeAudioConsumer(
                           base::Unretained(client_)),
       base::BindRepeating(&base::OneShotTimer::Reset,
                           base::Unretained(&data_timeout_timer_)),
-      std::move(decoder_buffer_factory));
+      std::move(decoder_buffer_factory), "Audio");
 
   return data_pipe_consumer;
 }
@@ -249,7 +249,7 @@ CastStreamingSession::ReceiverSessionClient::InitializeVideoConsumer(
                           base::Unretained(client_)),
       base::BindRepeating(&base::OneShotTimer::Reset,
                           base::Unretained(&data_timeout_timer_)),
-      std::move(decoder_buffer_factory));
+      std::move(decoder_buffer_factory), "Video");
 
   return data_pipe_consumer;
 }
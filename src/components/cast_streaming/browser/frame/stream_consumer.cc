@@ -5,10 +5,13 @@
 #include "components/cast_streaming/browser/frame/stream_consumer.h"
 
 #include <algorithm>
+#include <chrono>
 
 #include "base/containers/span.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/strings/strcat.h"
 #include "base/task/sequenced_task_runner.h"
 #include "components/cast_streaming/browser/common/decoder_buffer_factory.h"
 #include "components/cast_streaming/common/public/features.h"
@@ -18,6 +21,18 @@
 
 namespace cast_streaming {
 
+namespace {
+
+// openscreen::Clock is backed by base::TimeTicks.
+base::TimeTicks ToTimeTicks(openscreen::Clock::time_point time_point) {
+  const std::chrono::microseconds since_origin =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          time_point.time_since_epoch());
+  return base::TimeTicks() + base::Microseconds(since_origin.count());
+}
+
+}  // namespace
+
 StreamConsumer::BufferDataWrapper::~BufferDataWrapper() = default;
 
 base::span<uint8_t> StreamConsumer::BufferDataWrapper::Get() {
@@ -61,7 +76,8 @@ StreamConsumer::StreamConsumer(
     mojo::ScopedDataPipeProducerHandle data_pipe,
     FrameReceivedCB frame_received_cb,
     base::RepeatingClosure on_new_frame,
-    std::unique_ptr<DecoderBufferFactory> decoder_buffer_factory)
+    std::unique_ptr<DecoderBufferFactory> decoder_buffer_factory,
+    std::string_view stream_name)
     : receiver_(receiver),
       data_pipe_(std::move(data_pipe)),
       frame_received_cb_(std::move(frame_received_cb)),
@@ -69,7 +85,12 @@ StreamConsumer::StreamConsumer(
                     mojo::SimpleWatcher::ArmingPolicy::MANUAL,
                     base::SequencedTaskRunner::GetCurrentDefault()),
       on_new_frame_(std::move(on_new_frame)),
-      decoder_buffer_factory_(std::move(decoder_buffer_factory)) {
+      decoder_buffer_factory_(std::move(decoder_buffer_factory)),
+      latency_histogram_name_(
+          base::StrCat({"CastStreaming.Receiver.", stream_name,
+                        ".CaptureToReceiveLatency"})),
+      jitter_histogram_name_(
+          base::StrCat({"CastStreaming.Receiver.", stream_name, ".Jitter"})) {
   DCHECK(receiver_);
   DCHECK(decoder_buffer_factory_);
 
@@ -193,6 +214,7 @@ void StreamConsumer::MaybeSendNextFrame() {
   // At this point, the frame is known to be "good".
   skip_until_frame_id_ = 0;
   no_frames_available_cb_.Reset();
+  RecordFrameLatency(encoded_frame);
 
   // Write the frame's data to Mojo.
   span = data_wrapper_.Get();
@@ -219,4 +241,26 @@ void StreamConsumer::MaybeSendNextFrame() {
   }
 }
 
+void StreamConsumer::RecordFrameLatency(
+    const openscreen::cast::EncodedFrame& encoded_frame) {
+  const base::TimeTicks reference_time =
+      ToTimeTicks(encoded_frame.reference_time);
+  if (reference_time.is_null()) {
+    return;
+  }
+  const base::TimeTicks now = base::TimeTicks::Now();
+  base::UmaHistogramTimes(latency_histogram_name_, now - reference_time);
+
+  // The difference between the time between arrivals and the time between
+  // captures. Frames that arrive at an even pace have none.
+  if (!last_arrival_time_.is_null()) {
+    base::UmaHistogramTimes(
+        jitter_histogram_name_,
+        ((now - last_arrival_time_) - (reference_time - last_reference_time_))
+            .magnitude());
+  }
+  last_reference_time_ = reference_time;
+  last_arrival_time_ = now;
+}
+
 }  // namespace cast_streaming
@@ -5,6 +5,9 @@
 #ifndef COMPONENTS_CAST_STREAMING_BROWSER_FRAME_STREAM_CONSUMER_H_
 #define COMPONENTS_CAST_STREAMING_BROWSER_FRAME_STREAM_CONSUMER_H_
 
+#include <string>
+#include <string_view>
+
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "base/time/time.h"
@@ -34,12 +37,14 @@ class StreamConsumer final : public openscreen::cast::Receiver::Consumer {
   // |receiver| sends frames to this object. It must outlive this object.
   // |frame_received_cb| is called on every new frame, after a new frame has
   // been written to |data_pipe|. On error, |data_pipe| will be closed.
-  // On every new frame, |on_new_frame| will be called.
+  // On every new frame, |on_new_frame| will be called. |stream_name| is used
+  // in the names of the latency histograms, e.g. "Audio" or "Video".
   StreamConsumer(openscreen::cast::Receiver* receiver,
                  mojo::ScopedDataPipeProducerHandle data_pipe,
                  FrameReceivedCB frame_received_cb,
                  base::RepeatingClosure on_new_frame,
-                 std::unique_ptr<DecoderBufferFactory> decoder_buffer_factory);
+                 std::unique_ptr<DecoderBufferFactory> decoder_buffer_factory,
+                 std::string_view stream_name);
   ~StreamConsumer() override;
 
   StreamConsumer(const StreamConsumer&) = delete;
@@ -99,6 +104,10 @@ class StreamConsumer final : public openscreen::cast::Receiver::Consumer {
 
   bool WriteBufferToDataPipe();
 
+  // Records how long |encoded_frame| took to get here from its capture on the
+  // sender, and how much that varies between frames.
+  void RecordFrameLatency(const openscreen::cast::EncodedFrame& encoded_frame);
+
   // openscreen::cast::Receiver::Consumer implementation.
   void OnFramesReady(int next_frame_buffer_size) override;
 
@@ -124,6 +133,14 @@ class StreamConsumer final : public openscreen::cast::Receiver::Consumer {
 
   // Factory to use for creating DecoderBuffers.
   std::unique_ptr<DecoderBufferFactory> decoder_buffer_factory_;
+
+  const std::string latency_histogram_name_;
+  const std::string jitter_histogram_name_;
+
+  // The capture and arrival times of the last frame sent, used to compute
+  // jitter.
+  base::TimeTicks last_reference_time_;
+  base::TimeTicks last_arrival_time_;
 };
 
 }  // namespace cast_streaming
@@ -0,0 +1,85 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/timer/elapsed_timer.h"
+#include "components/cbor/reader.h"
+#include "components/cbor/values.h"
+#include "components/cbor/writer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace cbor {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "CBOR.";
+constexpr char kMetricRead[] = "read";
+constexpr char kMetricWrite[] = "write";
+
+constexpr int kIterations = 100;
+
+// Returns a map shaped like a large attestation object: string keys with byte
+// string and nested map values.
+Value CreatePayload(size_t num_entries, size_t bytes_per_entry) {
+  Value::MapValue map;
+  for (size_t i = 0; i < num_entries; ++i) {
+    Value::MapValue entry;
+    entry.emplace(Value(1), Value(static_cast<int64_t>(i)));
+    entry.emplace(Value("data"),
+                  Value(std::vector<uint8_t>(bytes_per_entry, i & 0xff)));
+    entry.emplace(Value("name"), Value(std::string(bytes_per_entry, 'x')));
+    map.emplace(Value("entry" + base::NumberToString(i)),
+                Value(std::move(entry)));
+  }
+  return Value(std::move(map));
+}
+
+void RunStory(const std::string& story,
+              size_t num_entries,
+              size_t bytes_per_entry) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+  reporter.RegisterImportantMetric(kMetricRead, "ms");
+  reporter.RegisterImportantMetric(kMetricWrite, "ms");
+
+  const Value payload = CreatePayload(num_entries, bytes_per_entry);
+  std::optional<std::vector<uint8_t>> encoded = Writer::Write(payload);
+  ASSERT_TRUE(encoded);
+
+  base::ElapsedTimer read_timer;
+  for (int i = 0; i < kIterations; ++i) {
+    ASSERT_TRUE(Reader::Read(*encoded));
+  }
+  reporter.AddResult(kMetricRead,
+                     read_timer.Elapsed().InMillisecondsF() / kIterations);
+
+  // Reuses one buffer, as a caller encoding many values would.
+  std::vector<uint8_t> output;
+  Writer::Config config;
+  base::ElapsedTimer write_timer;
+  for (int i = 0; i < kIterations; ++i) {
+    output.clear();
+    ASSERT_TRUE(Writer::WriteTo(payload, &output, config));
+  }
+  reporter.AddResult(kMetricWrite,
+                     write_timer.Elapsed().InMillisecondsF() / kIterations);
+}
+
+}  // namespace
+
+TEST(CBORPerfTest, ManySmallEntries) {
+  RunStory("ManySmallEntries", /*num_entries=*/2000, /*bytes_per_entry=*/16);
+}
+
+TEST(CBORPerfTest, FewLargeEntries) {
+  RunStory("FewLargeEntries", /*num_entries=*/16, /*bytes_per_entry=*/65536);
+}
+
+}  // namespace cbor
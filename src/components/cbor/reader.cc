@@ -6,12 +6,16 @@
 
 #include <math.h>
 
+#include <algorithm>
 #include <limits>
 #include <map>
+#include <string_view>
 #include <utility>
+#include <vector>
 
 #include "base/bit_cast.h"
 #include "base/check_op.h"
+#include "base/containers/flat_tree.h"
 #include "base/notreached.h"
 #include "base/numerics/checked_math.h"
 #include "base/numerics/safe_conversions.h"
@@ -322,9 +326,11 @@ std::optional<Value> Reader::ReadStringContent(
     return std::nullopt;
   }
 
-  std::string cbor_string(bytes->begin(), bytes->end());
+  // Validate in place so that the bytes are only copied into the Value.
+  const std::string_view cbor_string(
+      reinterpret_cast<const char*>(bytes->data()), bytes->size());
   if (base::IsStringUTF8(cbor_string)) {
-    return Value(std::move(cbor_string));
+    return Value(cbor_string);
   }
 
   if (config.allow_invalid_utf8) {
@@ -343,8 +349,7 @@ std::optional<Value> Reader::ReadByteStringContent(
     return std::nullopt;
   }
 
-  std::vector<uint8_t> cbor_byte_string(bytes->begin(), bytes->end());
-  return Value(std::move(cbor_byte_string));
+  return Value(*bytes);
 }
 
 std::optional<Value> Reader::ReadArrayContent(
@@ -354,6 +359,9 @@ std::optional<Value> Reader::ReadArrayContent(
   const uint64_t length = header.value;
 
   Value::ArrayValue cbor_array;
+  // Every element takes at least one byte, which bounds the reservation for
+  // untrusted lengths.
+  cbor_array.reserve(std::min<uint64_t>(length, num_bytes_remaining()));
   for (uint64_t i = 0; i < length; ++i) {
     std::optional<Value> cbor_element =
         DecodeCompleteDataItem(config, max_nesting_level - 1);
@@ -371,7 +379,16 @@ std::optional<Value> Reader::ReadMapContent(
     int max_nesting_level) {
   const uint64_t length = header.value;
 
+  // Canonical maps arrive sorted, so their entries are collected in order and
+  // adopted by the flat map without sorting or copying keys. Only maps that
+  // may be out of order are sorted through a std::map.
+  std::vector<std::pair<Value, Value>> sorted_entries;
   std::map<Value, Value, Value::Less> cbor_map;
+  if (!config.allow_and_canonicalize_out_of_order_keys) {
+    // Every entry takes at least two bytes.
+    sorted_entries.reserve(
+        std::min<uint64_t>(length, num_bytes_remaining() / 2));
+  }
   for (uint64_t i = 0; i < length; ++i) {
     std::optional<Value> key =
         DecodeCompleteDataItem(config, max_nesting_level - 1);
@@ -394,23 +411,33 @@ std::optional<Value> Reader::ReadMapContent(
         error_code_ = DecoderError::INCORRECT_MAP_KEY_TYPE;
         return std::nullopt;
     }
-    if (IsDuplicateKey(key.value(), cbor_map))
-      return std::nullopt;
 
-    if (!config.allow_and_canonicalize_out_of_order_keys &&
-        !IsKeyInOrder(key.value(), cbor_map)) {
-      return std::nullopt;
+    if (!config.allow_and_canonicalize_out_of_order_keys) {
+      if (!IsKeyAfter(key.value(), sorted_entries)) {
+        return std::nullopt;
+      }
+      sorted_entries.emplace_back(std::move(key.value()),
+                                  std::move(value.value()));
+      continue;
     }
 
+    if (IsDuplicateKey(key.value(), cbor_map))
+      return std::nullopt;
     cbor_map.emplace(std::move(key.value()), std::move(value.value()));
   }
 
+  if (!config.allow_and_canonicalize_out_of_order_keys) {
+    return Value(
+        Value::MapValue(base::sorted_unique, std::move(sorted_entries)));
+  }
+
   Value::MapValue map;
   map.reserve(cbor_map.size());
-  // TODO(crbug.com/40205788): when Chromium switches to C++17, this code can be
-  // optimized using std::map::extract().
-  for (auto& it : cbor_map)
-    map.emplace_hint(map.end(), it.first.Clone(), std::move(it.second));
+  while (!cbor_map.empty()) {
+    auto node = cbor_map.extract(cbor_map.begin());
+    map.emplace_hint(map.end(), std::move(node.key()),
+                     std::move(node.mapped()));
+  }
   return Value(std::move(map));
 }
 
@@ -444,19 +471,27 @@ bool Reader::IsEncodingMinimal(uint8_t additional_bytes, uint64_t uint_data) {
   return true;
 }
 
-bool Reader::IsKeyInOrder(const Value& new_key,
-                          const std::map<Value, Value, Value::Less>& map) {
-  if (map.empty()) {
+bool Reader::IsKeyAfter(
+    const Value& new_key,
+    const std::vector<std::pair<Value, Value>>& sorted_entries) {
+  if (sorted_entries.empty()) {
     return true;
   }
 
-  const auto& max_current_key = map.rbegin()->first;
-  const auto less = map.key_comp();
-  if (!less(max_current_key, new_key)) {
-    error_code_ = DecoderError::OUT_OF_ORDER_KEY;
-    return false;
+  const Value::Less less;
+  if (less(sorted_entries.back().first, new_key)) {
+    return true;
   }
-  return true;
+  // A key that is out of order may still duplicate an earlier key, which
+  // takes precedence as the error.
+  auto it = std::lower_bound(
+      sorted_entries.begin(), sorted_entries.end(), new_key,
+      [&less](const std::pair<Value, Value>& entry, const Value& key) {
+        return less(entry.first, key);
+      });
+  error_code_ = less(new_key, it->first) ? DecoderError::OUT_OF_ORDER_KEY
+                                         : DecoderError::DUPLICATE_KEY;
+  return false;
 }
 
 bool Reader::IsDuplicateKey(const Value& new_key,
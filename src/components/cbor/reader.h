@@ -9,6 +9,8 @@
 
 #include <map>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "base/containers/span.h"
 #include "base/memory/raw_ptr.h"
@@ -206,8 +208,10 @@ class CBOR_EXPORT Reader {
                                       int max_nesting_level);
   std::optional<uint8_t> ReadByte();
   std::optional<base::span<const uint8_t>> ReadBytes(uint64_t num_bytes);
-  bool IsKeyInOrder(const Value& new_key,
-                    const std::map<Value, Value, Value::Less>& map);
+  // Check if `new_key` sorts after all keys in `sorted_entries`, which also
+  // rules out duplicates.
+  bool IsKeyAfter(const Value& new_key,
+                  const std::vector<std::pair<Value, Value>>& sorted_entries);
   // Check if `new_key` is a duplicate of a key that already exists in the
   // `map`.
   bool IsDuplicateKey(const Value& new_key,
@@ -23,14 +23,26 @@ Writer::~Writer() {}
 std::optional<std::vector<uint8_t>> Writer::Write(const Value& node,
                                                   const Config& config) {
   std::vector<uint8_t> cbor;
-  Writer writer(&cbor);
-  if (!writer.EncodeCBOR(node, config.max_nesting_level,
-                         config.allow_invalid_utf8_for_testing)) {
+  if (!WriteTo(node, &cbor, config)) {
     return std::nullopt;
   }
   return cbor;
 }
 
+// static
+bool Writer::WriteTo(const Value& node,
+                     std::vector<uint8_t>* output,
+                     const Config& config) {
+  const size_t original_size = output->size();
+  Writer writer(output);
+  if (!writer.EncodeCBOR(node, config.max_nesting_level,
+                         config.allow_invalid_utf8_for_testing)) {
+    output->resize(original_size);
+    return false;
+  }
+  return true;
+}
+
 // static
 std::optional<std::vector<uint8_t>> Writer::Write(const Value& node,
                                                   size_t max_nesting_level) {
@@ -89,6 +89,14 @@ class CBOR_EXPORT Writer {
   static std::optional<std::vector<uint8_t>> Write(const Value& node,
                                                    const Config& config);
 
+  // Appends the CBOR byte string representation of |node| to |output|, so
+  // that several values can be encoded into one caller-owned buffer without
+  // intermediate vectors. Returns false and leaves |output| unchanged if the
+  // nesting depth of |node| is greater than |config.max_nesting_level|.
+  static bool WriteTo(const Value& node,
+                      std::vector<uint8_t>* output,
+                      const Config& config);
+
  private:
   explicit Writer(std::vector<uint8_t>* cbor);
 
@@ -523,4 +523,24 @@ TEST(CBORWriterTest, OverlyNestedCBOR) {
   EXPECT_FALSE(Writer::Write(Value(map), 4).has_value());
 }
 
+// Testing WriteTo() appends to the caller's buffer and leaves it unchanged on
+// failure.
+TEST(CBORWriterTest, WriteToAppends) {
+  Value::ArrayValue array;
+  array.push_back(Value(1));
+  array.push_back(Value("a"));
+  Value::ArrayValue nested_array;
+  nested_array.push_back(Value(array));
+
+  std::vector<uint8_t> output = {0xff};
+  Writer::Config config;
+  EXPECT_TRUE(Writer::WriteTo(Value(1), &output, config));
+  EXPECT_TRUE(Writer::WriteTo(Value(array), &output, config));
+  EXPECT_THAT(output, testing::ElementsAre(0xff, 0x01, 0x82, 0x01, 0x61, 'a'));
+
+  config.max_nesting_level = 1;
+  EXPECT_FALSE(Writer::WriteTo(Value(nested_array), &output, config));
+  EXPECT_THAT(output, testing::ElementsAre(0xff, 0x01, 0x82, 0x01, 0x61, 'a'));
+}
+
 }  // namespace cbor
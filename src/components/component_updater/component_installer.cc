@@ -19,6 +19,7 @@
 #include "base/functional/callback.h"
 #include "base/location.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/path_service.h"
 #include "base/ranges/algorithm.h"
 #include "base/sequence_checker.h"
@@ -26,6 +27,7 @@
 #include "base/task/sequenced_task_runner.h"
 #include "base/task/task_traits.h"
 #include "base/task/thread_pool.h"
+#include "base/timer/elapsed_timer.h"
 #include "base/values.h"
 #include "base/version.h"
 #include "build/build_config.h"
@@ -213,6 +215,7 @@ void ComponentInstaller::Install(
     std::unique_ptr<InstallParams> /*install_params*/,
     ProgressCallback /*progress_callback*/,
     Callback callback) {
+  base::ElapsedTimer timer;
   base::Value::Dict manifest;
   base::Version version;
   base::FilePath install_path;
@@ -224,6 +227,9 @@ void ComponentInstaller::Install(
                                 base::BindOnce(std::move(callback), result));
     return;
   }
+  // The time spent installing an unpacked component, which is part of
+  // ComponentUpdater.UpdateCompleteTime along with downloading and unpacking.
+  UMA_HISTOGRAM_MEDIUM_TIMES("ComponentUpdater.InstallTime", timer.Elapsed());
 
   current_version_ = version;
   current_install_dir_ = install_path;
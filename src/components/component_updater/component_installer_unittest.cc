@@ -28,6 +28,7 @@
 #include "base/task/bind_post_task.h"
 #include "base/task/sequenced_task_runner.h"
 #include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_path_override.h"
 #include "base/test/task_environment.h"
 #include "base/values.h"
@@ -452,6 +453,7 @@ TEST_F(ComponentInstallerTest, InstallerRegister_CheckSequence) {
 
 // Tests that the unpack path is removed when the install succeeded.
 TEST_F(ComponentInstallerTest, UnpackPathInstallSuccess) {
+  base::HistogramTester histogram_tester;
   auto installer = base::MakeRefCounted<ComponentInstaller>(
       std::make_unique<MockInstallerPolicy>());
 
@@ -476,12 +478,14 @@ TEST_F(ComponentInstallerTest, UnpackPathInstallSuccess) {
   task_environment_.RunUntilIdle();
 
   EXPECT_FALSE(base::PathExists(unpack_path));
+  histogram_tester.ExpectTotalCount("ComponentUpdater.InstallTime", 1);
   EXPECT_CALL(update_client(), Stop()).Times(1);
   EXPECT_CALL(scheduler(), Stop()).Times(1);
 }
 
 // Tests that the unpack path is removed when the install failed.
 TEST_F(ComponentInstallerTest, UnpackPathInstallError) {
+  base::HistogramTester histogram_tester;
   auto installer = base::MakeRefCounted<ComponentInstaller>(
       std::make_unique<MockInstallerPolicy>());
 
@@ -508,6 +512,7 @@ TEST_F(ComponentInstallerTest, UnpackPathInstallError) {
   task_environment_.RunUntilIdle();
 
   EXPECT_FALSE(base::PathExists(unpack_path));
+  histogram_tester.ExpectTotalCount("ComponentUpdater.InstallTime", 0);
   EXPECT_CALL(update_client(), Stop()).Times(1);
   EXPECT_CALL(scheduler(), Stop()).Times(1);
 }
@@ -6,7 +6,10 @@
 
 #include <utility>
 
+#include "base/containers/span.h"
+#include "base/hash/hash.h"
 #include "base/json/json_writer.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/time/time.h"
 #include "base/values.h"
@@ -39,6 +42,28 @@ std::string ToFaviconTypeString(blink::mojom::FaviconIconType type) {
   return "invalid";
 }
 
+// Returns a hash of `data`'s text, bounds and children, used to tell whether
+// updated content differs from what was last forwarded.
+size_t HashContent(const ContentCaptureData& data) {
+  size_t hash = base::HashInts(
+      base::FastHash(base::as_byte_span(data.value)),
+      base::HashInts(base::HashInts(data.bounds.x(), data.bounds.y()),
+                     base::HashInts(data.bounds.width(),
+                                    data.bounds.height())));
+  for (const ContentCaptureData& child : data.children) {
+    hash = base::HashInts(hash, HashContent(child));
+  }
+  return hash;
+}
+
+size_t GetTextBytes(const ContentCaptureData& data) {
+  size_t bytes = data.value.size() * sizeof(char16_t);
+  for (const ContentCaptureData& child : data.children) {
+    bytes += GetTextBytes(child);
+  }
+  return bytes;
+}
+
 }  // namespace
 
 // static
@@ -115,6 +140,7 @@ void ContentCaptureReceiver::DidCaptureContent(const ContentCaptureData& data,
   // be reset once activity is resumed, URL is needed to rebuild session.
   ContentCaptureFrame frame(frame_content_capture_data_);
   frame.children = data.children;
+  RecordForwardedContent(frame.children);
   provider->DidCaptureContent(this, frame);
 }
 
@@ -126,7 +152,20 @@ void ContentCaptureReceiver::DidUpdateContent(const ContentCaptureData& data) {
 
   // We can't avoid copy the data here because frame needs to be replaced.
   ContentCaptureFrame frame(frame_content_capture_data_);
-  frame.children = data.children;
+  frame.children.clear();
+  // The renderer may resend content that didn't change, only forward the
+  // content that differs from what the consumers have.
+  for (const ContentCaptureData& child : data.children) {
+    auto it = forwarded_content_hashes_.find(child.id);
+    if (it == forwarded_content_hashes_.end() ||
+        it->second != HashContent(child)) {
+      frame.children.push_back(child);
+    }
+  }
+  if (frame.children.empty()) {
+    return;
+  }
+  RecordForwardedContent(frame.children);
   provider->DidUpdateContent(this, frame);
 }
 
@@ -136,6 +175,9 @@ void ContentCaptureReceiver::DidRemoveContent(
   auto* provider = GetOnscreenContentProvider(rfh_);
   if (!provider)
     return;
+  for (int64_t id : data) {
+    forwarded_content_hashes_.erase(id);
+  }
   provider->DidRemoveContent(this, data);
 }
 
@@ -171,6 +213,12 @@ void ContentCaptureReceiver::RemoveSession() {
   if (auto* provider = GetOnscreenContentProvider(rfh_)) {
     provider->DidRemoveSession(this);
     has_session_ = false;
+    if (forwarded_text_bytes_) {
+      base::UmaHistogramCounts10M("ContentCapture.ForwardedTextBytesPerSession",
+                                  forwarded_text_bytes_);
+    }
+    forwarded_content_hashes_.clear();
+    forwarded_text_bytes_ = 0;
     // We can't reset the frame_content_capture_data_ here, because it could be
     // used by GetFrameContentCaptureDataLastSeen(), has_session_ is used to
     // check if new session shall be created as needed.
@@ -221,6 +269,14 @@ void ContentCaptureReceiver::UpdateFaviconURL(
   provider->DidUpdateFavicon(this);
 }
 
+void ContentCaptureReceiver::RecordForwardedContent(
+    const std::vector<ContentCaptureData>& content) {
+  for (const ContentCaptureData& child : content) {
+    forwarded_content_hashes_[child.id] = HashContent(child);
+    forwarded_text_bytes_ += GetTextBytes(child);
+  }
+}
+
 void ContentCaptureReceiver::RetrieveFaviconURL() {
   if (!rfh()->IsActive() || !rfh()->IsInPrimaryMainFrame() ||
       disable_get_favicon_from_web_contents_for_testing()) {
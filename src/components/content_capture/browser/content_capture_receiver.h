@@ -5,6 +5,7 @@
 #ifndef COMPONENTS_CONTENT_CAPTURE_BROWSER_CONTENT_CAPTURE_RECEIVER_H_
 #define COMPONENTS_CONTENT_CAPTURE_BROWSER_CONTENT_CAPTURE_RECEIVER_H_
 
+#include <unordered_map>
 #include <vector>
 
 #include "base/cancelable_callback.h"
@@ -82,6 +83,9 @@ class ContentCaptureReceiver : public mojom::ContentCaptureReceiver {
 
   void NotifyTitleUpdate();
 
+  // Remembers `content` as forwarded to the consumers.
+  void RecordForwardedContent(const std::vector<ContentCaptureData>& content);
+
   const mojo::AssociatedRemote<mojom::ContentCaptureSender>&
   GetContentCaptureSender();
 
@@ -104,6 +108,12 @@ class ContentCaptureReceiver : public mojom::ContentCaptureReceiver {
   // |frame_content_capture_data_| required by child frame.
   bool has_session_ = false;
 
+  // The hash of each top-level content forwarded in the current session, keyed
+  // by content id, used to drop updates that don't change anything.
+  std::unordered_map<int64_t, size_t> forwarded_content_hashes_;
+  // The size of the text forwarded in the current session, for metrics.
+  size_t forwarded_text_bytes_ = 0;
+
   // The TaskRunner for |notify_title_update_callback_| task. It is also used by
   // test to replace with TestMockTimeTaskRunner.
   scoped_refptr<base::SingleThreadTaskRunner> title_update_task_runner_;
@@ -227,6 +227,20 @@ TEST_P(ContentCaptureReceiverTest, MAYBE_DidUpdateContent) {
             consumer()->updated_data());
 }
 
+TEST_P(ContentCaptureReceiverTest, DidUpdateContentSkipsUnchangedContent) {
+  main_frame_sender()->DidCaptureContent(helper()->test_data(),
+                                         true /* first_data */);
+
+  // Resending the captured content doesn't notify the consumer.
+  main_frame_sender()->DidUpdateContent(helper()->test_data());
+  EXPECT_EQ(ContentCaptureFrame(), consumer()->updated_data());
+
+  main_frame_sender()->DidUpdateContent(helper()->test_data_change());
+  EXPECT_EQ(GetExpectedTestData(helper()->test_data_change(),
+                                GetFrameId(true /* main_frame */)),
+            consumer()->updated_data());
+}
+
 TEST_P(ContentCaptureReceiverTest, DidRemoveSession) {
   main_frame_sender()->DidCaptureContent(helper()->test_data(),
                                          true /* first_data */);
@@ -11,6 +11,7 @@
 #include "base/check_op.h"
 #include "base/compiler_specific.h"
 #include "base/feature_list.h"
+#include "base/functional/function_ref.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/synchronization/lock.h"
 #include "base/time/default_clock.h"
@@ -60,8 +61,63 @@ class RuleIteratorImpl : public RuleIterator {
   base::AutoReset<bool> iterating_;
 };
 
+// Returns the rule with highest precedence in |rules| that matches both urls
+// and passes |filter|, or nullptr. Since the rules are stored in the order of
+// decreasing precedence, the most specific match is found first.
+const RuleEntry* FindRule(const Rules& rules,
+                          const GURL& primary_url,
+                          const GURL& secondary_url,
+                          base::Clock* clock,
+                          base::FunctionRef<bool(const RuleEntry&)> filter) {
+  for (const auto& entry : rules) {
+    if (entry.first.primary_pattern.Matches(primary_url) &&
+        entry.first.secondary_pattern.Matches(secondary_url) &&
+        (base::FeatureList::IsEnabled(
+             content_settings::features::kActiveContentSettingExpiry) ||
+         !entry.second.metadata.IsExpired(clock)) &&
+        filter(entry)) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+bool AcceptAll(const RuleEntry&) {
+  return true;
+}
+
+std::unique_ptr<Rule> CreateRule(const RuleEntry& entry) {
+  return std::make_unique<Rule>(
+      entry.first.primary_pattern, entry.first.secondary_pattern,
+      entry.second.value.Clone(), entry.second.metadata);
+}
+
 }  // namespace
 
+OriginValueMap::Snapshot::Snapshot(base::Clock* clock) : clock_(clock) {}
+
+OriginValueMap::Snapshot::~Snapshot() = default;
+
+std::unique_ptr<Rule> OriginValueMap::Snapshot::GetRule(
+    const GURL& primary_url,
+    const GURL& secondary_url) const {
+  return GetRule(primary_url, secondary_url, &AcceptAll);
+}
+
+std::unique_ptr<Rule> OriginValueMap::Snapshot::GetRule(
+    const GURL& primary_url,
+    const GURL& secondary_url,
+    base::FunctionRef<bool(const RuleEntry&)> filter) const {
+  const RuleEntry* result = nullptr;
+  if (const auto* index = absl::get_if<HostIndexedContentSettings>(&rules_)) {
+    result = index->Find(primary_url, secondary_url, filter);
+  } else {
+    result = FindRule(absl::get<Rules>(rules_), primary_url, secondary_url,
+                      clock_, filter);
+  }
+  return result ? CreateRule(*result) : nullptr;
+}
+
 std::unique_ptr<RuleIterator> OriginValueMap::GetRuleIterator(
     ContentSettingsType content_type) const NO_THREAD_SAFETY_ANALYSIS {
   // We access |entries_| here, so we need to lock |auto_lock| first. The lock
@@ -109,28 +165,71 @@ std::unique_ptr<Rule> OriginValueMap::GetRule(
     if (it == entry_map().end()) {
       return nullptr;
     }
+    result =
+        FindRule(it->second, primary_url, secondary_url, clock_, &AcceptAll);
+  }
+  return result ? CreateRule(*result) : nullptr;
+}
 
-    // Iterate the entries in until a match is found. Since the rules are
-    // stored in the order of decreasing precedence, the most specific match
-    // is found first.
-    for (const auto& entry : it->second) {
-      if (entry.first.primary_pattern.Matches(primary_url) &&
-          entry.first.secondary_pattern.Matches(secondary_url) &&
-          (base::FeatureList::IsEnabled(
-               content_settings::features::kActiveContentSettingExpiry) ||
-           !entry.second.metadata.IsExpired(clock_))) {
-        result = &entry;
-        break;
-      }
+scoped_refptr<const OriginValueMap::Snapshot> OriginValueMap::GetSnapshot(
+    ContentSettingsType content_type) const {
+  {
+    base::AutoLock snapshot_lock(snapshot_lock_);
+    auto it = snapshots_.find(content_type);
+    if (it != snapshots_.end()) {
+      return it->second;
     }
   }
-  if (result) {
-    return std::make_unique<Rule>(
-        result->first.primary_pattern, result->first.secondary_pattern,
-        result->second.value.Clone(), result->second.metadata);
+
+  // The rules are copied while holding |lock_|, so no writer can invalidate
+  // the snapshot before it is published.
+  base::AutoLock lock(lock_);
+  scoped_refptr<const Snapshot> snapshot = CreateSnapshot(content_type);
+  base::AutoLock snapshot_lock(snapshot_lock_);
+  snapshots_[content_type] = snapshot;
+  return snapshot;
+}
+
+scoped_refptr<const OriginValueMap::Snapshot> OriginValueMap::CreateSnapshot(
+    ContentSettingsType content_type) const {
+  CHECK(!iterating_);
+  auto snapshot = base::WrapRefCounted(new Snapshot(clock_));
+  if (base::FeatureList::IsEnabled(features::kIndexedHostContentSettingsMap)) {
+    auto it = entry_index().find(content_type);
+    if (it == entry_index().end()) {
+      return nullptr;
+    }
+    HostIndexedContentSettings index(clock_);
+    for (const RuleEntry& entry : it->second) {
+      index.SetValue(entry.first.primary_pattern,
+                     entry.first.secondary_pattern, entry.second.value.Clone(),
+                     entry.second.metadata);
+    }
+    snapshot->rules_.emplace<HostIndexedContentSettings>(std::move(index));
+  } else {
+    auto it = entry_map().find(content_type);
+    if (it == entry_map().end()) {
+      return nullptr;
+    }
+    Rules rules;
+    for (const auto& [patterns, value_entry] : it->second) {
+      ValueEntry& copy = rules[patterns];
+      copy.value = value_entry.value.Clone();
+      copy.metadata = value_entry.metadata;
+    }
+    snapshot->rules_.emplace<Rules>(std::move(rules));
   }
+  return snapshot;
+}
 
-  return nullptr;
+void OriginValueMap::InvalidateSnapshot(ContentSettingsType content_type) {
+  base::AutoLock snapshot_lock(snapshot_lock_);
+  snapshots_.erase(content_type);
+}
+
+void OriginValueMap::InvalidateSnapshots() {
+  base::AutoLock snapshot_lock(snapshot_lock_);
+  snapshots_.clear();
 }
 
 size_t OriginValueMap::size() const {
@@ -222,9 +321,11 @@ bool OriginValueMap::SetValue(
   CHECK_NE(ContentSettingsType::DEFAULT, content_type);
 
   if (base::FeatureList::IsEnabled(features::kIndexedHostContentSettingsMap)) {
-    return get_index(content_type)
-        .SetValue(primary_pattern, secondary_pattern, std::move(value),
-                  metadata);
+    if (!get_index(content_type)
+             .SetValue(primary_pattern, secondary_pattern, std::move(value),
+                       metadata)) {
+      return false;
+    }
   } else {
     SortedPatternPair patterns(primary_pattern, secondary_pattern);
     ValueEntry* entry = &entry_map()[content_type][patterns];
@@ -233,8 +334,9 @@ bool OriginValueMap::SetValue(
     }
     entry->value = std::move(value);
     entry->metadata = metadata;
-    return true;
   }
+  InvalidateSnapshot(content_type);
+  return true;
 }
 
 bool OriginValueMap::DeleteValue(
@@ -251,6 +353,9 @@ bool OriginValueMap::DeleteValue(
     if (it->second.empty()) {
       entry_index().erase(it);
     }
+    if (result) {
+      InvalidateSnapshot(content_type);
+    }
     return result;
   } else {
     SortedPatternPair patterns(primary_pattern, secondary_pattern);
@@ -262,6 +367,9 @@ bool OriginValueMap::DeleteValue(
     if (it->second.empty()) {
       entry_map().erase(it);
     }
+    if (result) {
+      InvalidateSnapshot(content_type);
+    }
     return result;
   }
 }
@@ -273,25 +381,28 @@ void OriginValueMap::DeleteValues(ContentSettingsType content_type) {
   } else {
     entry_map().erase(content_type);
   }
+  InvalidateSnapshot(content_type);
 }
 
 void OriginValueMap::clear() {
   CHECK(!iterating_);
   // Delete all owned value objects.
   if (base::FeatureList::IsEnabled(features::kIndexedHostContentSettingsMap)) {
-    return entry_index().clear();
+    entry_index().clear();
   } else {
     entry_map().clear();
   }
+  InvalidateSnapshots();
 }
 
 void OriginValueMap::SetClockForTesting(base::Clock* clock) {
+  base::AutoLock lock(lock_);
   clock_ = clock;
   if (base::FeatureList::IsEnabled(features::kIndexedHostContentSettingsMap)) {
-    base::AutoLock lock(lock_);
     for (auto& index : entry_index()) {
       index.second.SetClockForTesting(clock);  // IN-TEST
     }
   }
+  InvalidateSnapshots();
 }
 }  // namespace content_settings
@@ -10,7 +10,10 @@
 #include <map>
 #include <memory>
 
+#include "base/functional/function_ref.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/synchronization/lock.h"
 #include "base/thread_annotations.h"
 #include "base/time/time.h"
@@ -44,8 +47,41 @@ namespace content_settings {
 // complexity around ensuring the lock is held while iterating,
 // |GetRuleIterator| should only be called while the lock is not held, as the
 // Iterator itself will hold the lock until it's destroyed.
+//
+// Readers that only look up rules can use |GetSnapshot| instead, which holds
+// locks just long enough to take a reference to an immutable copy of the rules,
+// and search that copy without blocking other readers or writers.
 class OriginValueMap {
  public:
+  // An immutable copy of the rules of one content type. It can be searched on
+  // any thread without holding a lock, and stays valid after the map changes.
+  class Snapshot : public base::RefCountedThreadSafe<Snapshot> {
+   public:
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    // Returns the matching Rule with highest precedence or nullptr if no Rule
+    // matched.
+    std::unique_ptr<Rule> GetRule(const GURL& primary_url,
+                                  const GURL& secondary_url) const;
+
+    // Like GetRule(), but skips the rules for which |filter| returns false.
+    std::unique_ptr<Rule> GetRule(
+        const GURL& primary_url,
+        const GURL& secondary_url,
+        base::FunctionRef<bool(const RuleEntry&)> filter) const;
+
+   private:
+    friend class OriginValueMap;
+    friend class base::RefCountedThreadSafe<Snapshot>;
+
+    explicit Snapshot(base::Clock* clock);
+    ~Snapshot();
+
+    absl::variant<Rules, HostIndexedContentSettings> rules_;
+    raw_ptr<base::Clock> clock_;
+  };
+
   base::Lock& GetLock() const LOCK_RETURNED(lock_) { return lock_; }
 
   bool empty() const EXCLUSIVE_LOCKS_REQUIRED(lock_) { return size() == 0u; }
@@ -71,6 +107,12 @@ class OriginValueMap {
                                 ContentSettingsType content_type) const
       EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
+  // Returns a snapshot of the rules for |content_type|, or nullptr if there are
+  // none. The snapshot is copied from the map on the first call after the
+  // rules changed, and shared by the calls after that.
+  scoped_refptr<const Snapshot> GetSnapshot(
+      ContentSettingsType content_type) const LOCKS_EXCLUDED(lock_);
+
   OriginValueMap();
   explicit OriginValueMap(base::Clock* clock);
 
@@ -139,12 +181,32 @@ class OriginValueMap {
     return it->second;
   }
 
+  // Copies the rules for |content_type| into a new snapshot, or returns
+  // nullptr if there are none.
+  scoped_refptr<const Snapshot> CreateSnapshot(
+      ContentSettingsType content_type) const EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Drops the snapshot of |content_type|, or of all types, after the rules
+  // changed.
+  void InvalidateSnapshot(ContentSettingsType content_type)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_) LOCKS_EXCLUDED(snapshot_lock_);
+  void InvalidateSnapshots() EXCLUSIVE_LOCKS_REQUIRED(lock_)
+      LOCKS_EXCLUDED(snapshot_lock_);
+
   mutable bool iterating_ = false;
   mutable base::Lock lock_;
   // This member is an EntryIndex when kIndexedHostContentSettingsMap is enabled
   // and an EntryMap otherwise.
   absl::variant<EntryMap, EntryIndex> entries_ GUARDED_BY(lock_);
 
+  // Guards |snapshots_|. It is always acquired after |lock_|, and only held
+  // to read or replace a pointer, so readers barely contend on it.
+  mutable base::Lock snapshot_lock_ ACQUIRED_AFTER(lock_);
+  // The current snapshot of each content type that was read since its rules
+  // last changed. A null value means that the type has no rules.
+  mutable std::map<ContentSettingsType, scoped_refptr<const Snapshot>>
+      snapshots_ GUARDED_BY(snapshot_lock_);
+
   raw_ptr<base::Clock> clock_;
 };
 
@@ -71,6 +71,17 @@ std::unique_ptr<Rule> PartitionedOriginValueMap::GetRule(
   return it->second.GetRule(primary_url, secondary_url, content_type);
 }
 
+scoped_refptr<const OriginValueMap::Snapshot>
+PartitionedOriginValueMap::GetSnapshot(
+    ContentSettingsType content_type,
+    const PartitionKey& partition_key) const {
+  auto it = partitions_.find(partition_key);
+  if (it == partitions_.end()) {
+    return nullptr;
+  }
+  return it->second.GetSnapshot(content_type);
+}
+
 size_t PartitionedOriginValueMap::size() const {
   size_t size = 0;
   for (const auto& [key, partition] : partitions_) {
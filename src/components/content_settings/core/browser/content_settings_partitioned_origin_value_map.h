@@ -9,6 +9,7 @@
 #include <memory>
 
 #include "base/memory/raw_ptr.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/synchronization/lock.h"
 #include "base/thread_annotations.h"
 #include "components/content_settings/core/browser/content_settings_origin_value_map.h"
@@ -63,6 +64,12 @@ class PartitionedOriginValueMap {
                                 const PartitionKey& partition_key) const
       EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
+  // Returns a snapshot of the rules for |content_type| and |partition_key|, or
+  // nullptr if there are none. See OriginValueMap::GetSnapshot.
+  scoped_refptr<const OriginValueMap::Snapshot> GetSnapshot(
+      ContentSettingsType content_type,
+      const PartitionKey& partition_key) const EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   PartitionedOriginValueMap();
 
   PartitionedOriginValueMap(
@@ -13,6 +13,7 @@
 #include "base/functional/bind.h"
 #include "base/json/json_reader.h"
 #include "base/logging.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/values.h"
 #include "components/content_settings/core/browser/content_settings_info.h"
@@ -362,8 +363,9 @@ std::unique_ptr<content_settings::Rule> PolicyProvider::GetRule(
     ContentSettingsType content_type,
     bool off_the_record,
     const content_settings::PartitionKey& partition_key) const {
-  base::AutoLock auto_lock(value_map_.GetLock());
-  return value_map_.GetRule(primary_url, secondary_url, content_type);
+  scoped_refptr<const OriginValueMap::Snapshot> snapshot =
+      value_map_.GetSnapshot(content_type);
+  return snapshot ? snapshot->GetRule(primary_url, secondary_url) : nullptr;
 }
 
 void PolicyProvider::GetContentSettingsFromPreferences() {
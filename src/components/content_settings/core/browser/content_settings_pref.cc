@@ -13,6 +13,7 @@
 #include "base/functional/bind.h"
 #include "base/json/values_util.h"
 #include "base/logging.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
@@ -21,6 +22,7 @@
 #include "base/time/time.h"
 #include "base/values.h"
 #include "components/content_settings/core/browser/content_settings_info.h"
+#include "components/content_settings/core/browser/content_settings_origin_value_map.h"
 #include "components/content_settings/core/browser/content_settings_registry.h"
 #include "components/content_settings/core/browser/content_settings_rule.h"
 #include "components/content_settings/core/browser/content_settings_utils.h"
@@ -204,14 +206,27 @@ std::unique_ptr<Rule> ContentSettingsPref::GetRule(
     const GURL& secondary_url,
     bool off_the_record,
     const PartitionKey& partition_key) const {
-  if (off_the_record) {
-    base::AutoLock auto_lock(off_the_record_value_map_.GetLock());
-    return off_the_record_value_map_.GetRule(primary_url, secondary_url,
-                                             content_type_, partition_key);
+  return GetRule(primary_url, secondary_url, off_the_record, partition_key,
+                 [](const RuleEntry&) { return true; });
+}
+
+std::unique_ptr<Rule> ContentSettingsPref::GetRule(
+    const GURL& primary_url,
+    const GURL& secondary_url,
+    bool off_the_record,
+    const PartitionKey& partition_key,
+    base::FunctionRef<bool(const RuleEntry&)> filter) const {
+  const PartitionedOriginValueMap& value_map =
+      off_the_record ? off_the_record_value_map_ : value_map_;
+  scoped_refptr<const OriginValueMap::Snapshot> snapshot;
+  {
+    base::AutoLock auto_lock(value_map.GetLock());
+    snapshot = value_map.GetSnapshot(content_type_, partition_key);
   }
-  base::AutoLock auto_lock(value_map_.GetLock());
-  return value_map_.GetRule(primary_url, secondary_url, content_type_,
-                            partition_key);
+  // The snapshot is searched without holding any lock, so that concurrent
+  // lookups and writes don't wait for each other.
+  return snapshot ? snapshot->GetRule(primary_url, secondary_url, filter)
+                  : nullptr;
 }
 
 void ContentSettingsPref::SetWebsiteSetting(
@@ -10,6 +10,7 @@
 #include <string>
 
 #include "base/functional/callback.h"
+#include "base/functional/function_ref.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/raw_ref.h"
 #include "base/synchronization/lock.h"
@@ -20,6 +21,7 @@
 #include "components/content_settings/core/browser/content_settings_provider.h"
 #include "components/content_settings/core/common/content_settings_partition_key.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
+#include "components/content_settings/core/common/content_settings_rules.h"
 #include "components/content_settings/core/common/content_settings_types.h"
 
 class PrefService;
@@ -70,6 +72,14 @@ class ContentSettingsPref {
                                 bool off_the_record,
                                 const PartitionKey& partition_key) const;
 
+  // Like GetRule(), but skips the rules for which |filter| returns false.
+  std::unique_ptr<Rule> GetRule(
+      const GURL& primary_url,
+      const GURL& secondary_url,
+      bool off_the_record,
+      const PartitionKey& partition_key,
+      base::FunctionRef<bool(const RuleEntry&)> filter) const;
+
   void SetWebsiteSetting(const ContentSettingsPattern& primary_pattern,
                          const ContentSettingsPattern& secondary_pattern,
                          base::Value value,
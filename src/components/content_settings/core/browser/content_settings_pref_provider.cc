@@ -307,17 +307,41 @@ bool PrefProvider::UpdateSetting(ContentSettingsType content_type,
   return false;
 }
 
+bool PrefProvider::UpdateSettingForUrls(
+    ContentSettingsType content_type,
+    const GURL& primary_url,
+    const GURL& secondary_url,
+    base::FunctionRef<bool(const RuleEntry&)> is_match,
+    base::FunctionRef<bool(Rule&)> perform_update,
+    const PartitionKey& partition_key) {
+  if (!supports_type(content_type)) {
+    return false;
+  }
+
+  std::unique_ptr<Rule> rule = GetPref(content_type)
+                                   ->GetRule(primary_url, secondary_url,
+                                             off_the_record_,
+                                             PartitionKey::WipGetDefault(),
+                                             is_match);
+  if (!rule || !perform_update(*rule)) {
+    return false;
+  }
+  GetPref(content_type)
+      ->SetWebsiteSetting(std::move(rule->primary_pattern),
+                          std::move(rule->secondary_pattern),
+                          std::move(rule->value), std::move(rule->metadata),
+                          partition_key);
+  return true;
+}
+
 bool PrefProvider::UpdateLastUsedTime(const GURL& primary_url,
                                       const GURL& secondary_url,
                                       ContentSettingsType content_type,
                                       const base::Time time,
                                       const PartitionKey& partition_key) {
-  return UpdateSetting(
-      content_type,
-      [&](const Rule& rule) -> bool {
-        return rule.primary_pattern.Matches(primary_url) &&
-               rule.secondary_pattern.Matches(secondary_url);
-      },
+  return UpdateSettingForUrls(
+      content_type, primary_url, secondary_url,
+      [](const RuleEntry&) -> bool { return true; },
       [&](Rule& rule) -> bool {
         rule.metadata.set_last_used(time);
         return true;
@@ -350,14 +374,12 @@ std::optional<base::TimeDelta> PrefProvider::RenewContentSetting(
     std::optional<ContentSetting> setting_to_match,
     const PartitionKey& partition_key) {
   std::optional<base::TimeDelta> delta_to_expiration;
-  UpdateSetting(
-      content_type,
-      [&](const Rule& rule) -> bool {
-        return rule.primary_pattern.Matches(primary_url) &&
-               rule.secondary_pattern.Matches(secondary_url) &&
-               (!setting_to_match.has_value() ||
-                setting_to_match.value() ==
-                    content_settings::ValueToContentSetting(rule.value));
+  UpdateSettingForUrls(
+      content_type, primary_url, secondary_url,
+      [&](const RuleEntry& entry) -> bool {
+        return !setting_to_match.has_value() ||
+               setting_to_match.value() ==
+                   content_settings::ValueToContentSetting(entry.second.value);
       },
       [&](Rule& rule) -> bool {
         // Only settings whose lifetimes are non-zero can be
@@ -10,10 +10,12 @@
 #include <map>
 #include <memory>
 
+#include "base/functional/function_ref.h"
 #include "base/memory/raw_ptr.h"
 #include "components/content_settings/core/browser/content_settings_utils.h"
 #include "components/content_settings/core/browser/user_modifiable_provider.h"
 #include "components/content_settings/core/common/content_settings_partition_key.h"
+#include "components/content_settings/core/common/content_settings_rules.h"
 #include "components/prefs/pref_change_registrar.h"
 
 class PrefService;
@@ -114,6 +116,17 @@ class PrefProvider : public UserModifiableProvider {
                      base::FunctionRef<bool(Rule&)> perform_update,
                      const PartitionKey& partition_key);
 
+  // Like UpdateSetting(), but only considers the settings that apply to
+  // `primary_url` and `secondary_url`, which are looked up in the host index
+  // instead of scanning all the settings of `content_type`.
+  bool UpdateSettingForUrls(
+      ContentSettingsType content_type,
+      const GURL& primary_url,
+      const GURL& secondary_url,
+      base::FunctionRef<bool(const RuleEntry&)> is_match,
+      base::FunctionRef<bool(Rule&)> perform_update,
+      const PartitionKey& partition_key);
+
   // Clean up the obsolete preferences from the user's profile.
   void DiscardOrMigrateObsoletePreferences();
 
@@ -13,6 +13,7 @@
 
 #include "base/check_op.h"
 #include "base/feature_list.h"
+#include "base/functional/function_ref.h"
 #include "base/notreached.h"
 #include "base/time/clock.h"
 #include "base/time/default_clock.h"
@@ -61,16 +62,20 @@ bool EraseValue(HostIndexedContentSettings::HostToContentSettings& index,
   return result;
 }
 
+using EntryFilter = base::FunctionRef<bool(const RuleEntry&)>;
+
 const RuleEntry* FindContentSetting(const GURL& primary_url,
                                     const GURL& secondary_url,
                                     const Rules& settings,
-                                    base::Clock* clock) {
+                                    base::Clock* clock,
+                                    EntryFilter filter) {
   const auto it = base::ranges::find_if(settings, [&](const auto& entry) {
     return entry.first.primary_pattern.Matches(primary_url) &&
            entry.first.secondary_pattern.Matches(secondary_url) &&
            (base::FeatureList::IsEnabled(
                 content_settings::features::kActiveContentSettingExpiry) ||
-            !entry.second.metadata.IsExpired(clock));
+            !entry.second.metadata.IsExpired(clock)) &&
+           filter(entry);
   });
   return it == settings.end() ? nullptr : &*it;
 }
@@ -81,7 +86,8 @@ const RuleEntry* FindInHostToContentSettings(
     const HostIndexedContentSettings::HostToContentSettings&
         indexed_content_setting,
     std::string_view host,
-    base::Clock* clock) {
+    base::Clock* clock,
+    EntryFilter filter) {
   if (host.empty() || indexed_content_setting.empty()) {
     return nullptr;
   }
@@ -94,7 +100,8 @@ const RuleEntry* FindInHostToContentSettings(
     auto it = indexed_content_setting.find(host);
     if (it != indexed_content_setting.end()) {
       auto* result =
-          FindContentSetting(primary_url, secondary_url, it->second, clock);
+          FindContentSetting(primary_url, secondary_url, it->second, clock,
+                             filter);
       if (result) {
         return result;
       }
@@ -105,7 +112,8 @@ const RuleEntry* FindInHostToContentSettings(
       auto it = indexed_content_setting.find(subdomain);
       if (it != indexed_content_setting.end()) {
         auto* result =
-            FindContentSetting(primary_url, secondary_url, it->second, clock);
+            FindContentSetting(primary_url, secondary_url, it->second, clock,
+                               filter);
         if (result) {
           return result;
         }
@@ -299,20 +307,29 @@ HostIndexedContentSettings::Iterator HostIndexedContentSettings::end() const {
 const RuleEntry* HostIndexedContentSettings::Find(
     const GURL& primary_url,
     const GURL& secondary_url) const {
+  return Find(primary_url, secondary_url,
+              [](const RuleEntry&) { return true; });
+}
+
+const RuleEntry* HostIndexedContentSettings::Find(
+    const GURL& primary_url,
+    const GURL& secondary_url,
+    base::FunctionRef<bool(const RuleEntry&)> filter) const {
   const RuleEntry* found = FindInHostToContentSettings(
       primary_url, secondary_url, primary_host_indexed_,
-      primary_url.host_piece(), clock_);
+      primary_url.host_piece(), clock_, filter);
   if (found) {
     return found;
   }
   found = FindInHostToContentSettings(primary_url, secondary_url,
                                       secondary_host_indexed_,
-                                      secondary_url.host_piece(), clock_);
+                                      secondary_url.host_piece(), clock_,
+                                      filter);
   if (found) {
     return found;
   }
   return FindContentSetting(primary_url, secondary_url, wildcard_settings_,
-                            clock_);
+                            clock_, filter);
 }
 
 bool HostIndexedContentSettings::SetValue(
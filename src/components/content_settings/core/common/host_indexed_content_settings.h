@@ -8,6 +8,7 @@
 #include <iterator>
 #include <optional>
 
+#include "base/functional/function_ref.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/raw_ref.h"
 #include "components/content_settings/core/common/content_settings.h"
@@ -117,6 +118,13 @@ class HostIndexedContentSettings {
   const RuleEntry* Find(const GURL& primary_url,
                         const GURL& secondary_url) const;
 
+  // Like Find(), but skips the entries for which |filter| returns false. Only
+  // the entries that match both urls are passed to |filter|.
+  const RuleEntry* Find(
+      const GURL& primary_url,
+      const GURL& secondary_url,
+      base::FunctionRef<bool(const RuleEntry&)> filter) const;
+
   // Add the setting to the index.
   // Returns true if something changed.
   bool SetValue(const ContentSettingsPattern& primary_pattern,
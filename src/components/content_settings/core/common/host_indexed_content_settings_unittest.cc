@@ -6,6 +6,7 @@
 
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "components/content_settings/core/common/content_settings.h"
 #include "components/content_settings/core/common/content_settings_pattern.h"
@@ -200,6 +201,44 @@ TEST_F(HostIndexedContentSettingsTest, ExactDomainMatchFound) {
   EXPECT_THAT(ToVector(index), testing::ContainerEq(test_settings));
 }
 
+TEST_F(HostIndexedContentSettingsTest, FindWithFilter) {
+  GURL test_primary_url("https://www.example.com/");
+  GURL test_secondary_url("http://toplevel.com");
+  ContentSettingsForOneType test_settings = {
+      CreateSetting("https://www.example.com/*", "*", CONTENT_SETTING_ALLOW),
+      CreateSetting("[*.]example.com", "*", CONTENT_SETTING_BLOCK),
+      CreateSetting("*", "[*.]toplevel.com", CONTENT_SETTING_ASK),
+      CreateSetting("*", "*", CONTENT_SETTING_SESSION_ONLY),
+  };
+  HostIndexedContentSettings index = FromVector(test_settings);
+
+  // Matching entries are passed to the filter in the order of precedence, and
+  // the first one it accepts is returned.
+  std::vector<ContentSetting> visited;
+  EXPECT_EQ(index.Find(test_primary_url, test_secondary_url,
+                       [&](const RuleEntry& entry) {
+                         visited.push_back(
+                             ValueToContentSetting(entry.second.value));
+                         return false;
+                       }),
+            nullptr);
+  EXPECT_THAT(visited,
+              testing::ElementsAre(CONTENT_SETTING_ALLOW, CONTENT_SETTING_BLOCK,
+                                   CONTENT_SETTING_ASK,
+                                   CONTENT_SETTING_SESSION_ONLY));
+
+  for (ContentSetting setting :
+       {CONTENT_SETTING_BLOCK, CONTENT_SETTING_ASK,
+        CONTENT_SETTING_SESSION_ONLY}) {
+    const RuleEntry* found = index.Find(
+        test_primary_url, test_secondary_url, [&](const RuleEntry& entry) {
+          return ValueToContentSetting(entry.second.value) == setting;
+        });
+    ASSERT_TRUE(found);
+    EXPECT_EQ(ValueToContentSetting(found->second.value), setting);
+  }
+}
+
 TEST_F(HostIndexedContentSettingsTest, NotFirstDomainMatchFound) {
   GURL test_primary_url("https://www.example.com/");
   GURL test_secondary_url("http://toplevel.com");
@@ -14,11 +14,12 @@
 #include <utility>
 
 #include "base/base64.h"
+#include "base/check_op.h"
 #include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback.h"
-#include "base/numerics/safe_conversions.h"
+#include "base/notreached.h"
 #include "base/strings/string_number_conversions.h"
 #include "components/crx_file/crx3.pb.h"
 #include "components/crx_file/crx_file.h"
@@ -47,72 +48,192 @@ constexpr uint8_t kPublisherTestKeyHash[] = {
 constexpr uint8_t kEocd[] = {'P', 'K', 0x05, 0x06};
 constexpr uint8_t kEocd64[] = {'P', 'K', 0x06, 0x07};
 
-using VerifierCollection =
-    std::vector<std::unique_ptr<crypto::SignatureVerifier>>;
 using RepeatedProof = google::protobuf::RepeatedPtrField<AsymmetricKeyProof>;
 
-int ReadAndHashBuffer(uint8_t* buffer,
-                      int length,
-                      base::File* file,
-                      crypto::SecureHash* hash) {
-  static_assert(sizeof(char) == sizeof(uint8_t), "Unsupported char size.");
-  int read = file->ReadAtCurrentPos(reinterpret_cast<char*>(buffer), length);
-  if (read > 0)
-    hash->Update(buffer, read);
-  return read;
-}
+constexpr size_t kUInt32Size = 4;
 
-// Returns UINT32_MAX in the case of an unexpected EOF or read error, else
-// returns the read uint32.
-uint32_t ReadAndHashLittleEndianUInt32(base::File* file,
-                                       crypto::SecureHash* hash) {
-  uint8_t buffer[4] = {};
-  if (ReadAndHashBuffer(buffer, 4, file, hash) != 4)
-    return UINT32_MAX;
+uint32_t ReadLittleEndianUInt32(base::span<const uint8_t> buffer) {
+  DCHECK_EQ(buffer.size(), kUInt32Size);
   return buffer[3] << 24 | buffer[2] << 16 | buffer[1] << 8 | buffer[0];
 }
 
-// Read to the end of the file, updating the hash and all verifiers.
-bool ReadHashAndVerifyArchive(base::File* file,
-                              crypto::SecureHash* hash,
-                              const VerifierCollection& verifiers) {
+}  // namespace
+
+VerifierResult Verify(
+    const base::FilePath& crx_path,
+    const VerifierFormat& format,
+    const std::vector<std::vector<uint8_t>>& required_key_hashes,
+    const std::vector<uint8_t>& required_file_hash,
+    std::string* public_key,
+    std::string* crx_id,
+    std::vector<uint8_t>* compressed_verified_contents) {
+  base::File file(crx_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+  if (!file.IsValid())
+    return VerifierResult::ERROR_FILE_NOT_READABLE;
+
+  StreamingVerifier verifier(format, required_key_hashes, required_file_hash);
+  static_assert(sizeof(char) == sizeof(uint8_t), "Unsupported char size.");
   uint8_t buffer[1 << 12] = {};
-  size_t len = 0;
-  while ((len = ReadAndHashBuffer(buffer, std::size(buffer), file, hash)) > 0) {
-    for (auto& verifier : verifiers)
-      verifier->VerifyUpdate(base::make_span(buffer, len));
+  int read = 0;
+  while ((read = file.ReadAtCurrentPos(reinterpret_cast<char*>(buffer),
+                                       std::size(buffer))) > 0) {
+    if (!verifier.Update(base::make_span(buffer, static_cast<size_t>(read))))
+      break;
   }
-  for (auto& verifier : verifiers) {
-    if (!verifier->VerifyFinal())
+  if (read < 0)
+    return VerifierResult::ERROR_FILE_NOT_READABLE;
+  return verifier.Finish(public_key, crx_id, compressed_verified_contents);
+}
+
+StreamingVerifier::StreamingVerifier(
+    const VerifierFormat& format,
+    const std::vector<std::vector<uint8_t>>& required_key_hashes,
+    const std::vector<uint8_t>& required_file_hash)
+    : format_(format),
+      required_key_hashes_(required_key_hashes),
+      required_file_hash_(required_file_hash),
+      file_hash_(crypto::SecureHash::Create(crypto::SecureHash::SHA256)) {}
+
+StreamingVerifier::~StreamingVerifier() = default;
+
+bool StreamingVerifier::Update(base::span<const uint8_t> data) {
+  if (error_)
+    return false;
+  file_hash_->Update(data.data(), data.size());
+
+  // Buffer the fixed-size fields and the header until each is complete.
+  while (!data.empty() && state_ != State::kArchive) {
+    const size_t length =
+        std::min(FieldSize() - buffer_.size(), data.size());
+    buffer_.insert(buffer_.end(), data.begin(), data.begin() + length);
+    data = data.subspan(length);
+    if (buffer_.size() == FieldSize())
+      OnFieldComplete();
+    if (error_)
       return false;
   }
-  return len == 0;
+
+  // Anything left is [archive], which all signatures cover.
+  if (!data.empty()) {
+    for (auto& verifier : verifiers_)
+      verifier->VerifyUpdate(data);
+  }
+  return true;
+}
+
+VerifierResult StreamingVerifier::Finish(
+    std::string* public_key,
+    std::string* crx_id,
+    std::vector<uint8_t>* compressed_verified_contents) {
+  if (compressed_verified_contents && compressed_verified_contents_)
+    *compressed_verified_contents = *compressed_verified_contents_;
+
+  // The Crx ended before its header did.
+  if (!error_ && state_ != State::kArchive)
+    error_ = VerifierResult::ERROR_HEADER_INVALID;
+  if (error_)
+    return *error_;
+
+  for (auto& verifier : verifiers_) {
+    if (!verifier->VerifyFinal())
+      return VerifierResult::ERROR_SIGNATURE_VERIFICATION_FAILED;
+  }
+
+  // Finalize file hash.
+  uint8_t final_hash[crypto::kSHA256Length] = {};
+  file_hash_->Finish(final_hash, sizeof(final_hash));
+  if (!required_file_hash_.empty()) {
+    if (required_file_hash_.size() != crypto::kSHA256Length)
+      return VerifierResult::ERROR_EXPECTED_HASH_INVALID;
+    if (!crypto::SecureMemEqual(final_hash, required_file_hash_.data(),
+                                crypto::kSHA256Length))
+      return VerifierResult::ERROR_FILE_HASH_FAILED;
+  }
+
+  // All is well. Set the out-params and return.
+  if (public_key)
+    *public_key = base::Base64Encode(public_key_bytes_);
+  if (crx_id)
+    *crx_id = crx_id_;
+  return diff_ ? VerifierResult::OK_DELTA : VerifierResult::OK_FULL;
+}
+
+size_t StreamingVerifier::FieldSize() const {
+  switch (state_) {
+    case State::kMagic:
+      return kCrxFileHeaderMagicSize;
+    case State::kVersion:
+    case State::kHeaderSize:
+      return kUInt32Size;
+    case State::kHeader:
+      return header_size_;
+    case State::kArchive:
+      return 0;
+  }
+  NOTREACHED();
+}
+
+void StreamingVerifier::OnFieldComplete() {
+  switch (state_) {
+    case State::kMagic:
+      // Magic number.
+      if (!memcmp(buffer_.data(), kCrxDiffFileHeaderMagic,
+                  kCrxFileHeaderMagicSize)) {
+        diff_ = true;
+      } else if (memcmp(buffer_.data(), kCrxFileHeaderMagic,
+                        kCrxFileHeaderMagicSize)) {
+        error_ = VerifierResult::ERROR_HEADER_INVALID;
+        return;
+      }
+      state_ = State::kVersion;
+      break;
+    case State::kVersion:
+      // Version number.
+      if (ReadLittleEndianUInt32(buffer_) != 3) {
+        error_ = VerifierResult::ERROR_HEADER_INVALID;
+        return;
+      }
+      state_ = State::kHeaderSize;
+      break;
+    case State::kHeaderSize:
+      // The remaining contents of a Crx3 file are
+      // [header-size][header][archive]. The header is buffered as it arrives
+      // rather than allocated up front, so a bogus size costs nothing.
+      header_size_ = ReadLittleEndianUInt32(buffer_);
+      if (header_size_ >= INT_MAX) {
+        error_ = VerifierResult::ERROR_HEADER_INVALID;
+        return;
+      }
+      state_ = State::kHeader;
+      if (header_size_ == 0) {
+        buffer_.clear();
+        OnFieldComplete();
+        return;
+      }
+      break;
+    case State::kHeader: {
+      const VerifierResult result = ProcessHeader();
+      if (result != VerifierResult::OK_FULL) {
+        error_ = result;
+        return;
+      }
+      state_ = State::kArchive;
+      // Release the header's memory.
+      std::vector<uint8_t>().swap(buffer_);
+      return;
+    }
+    case State::kArchive:
+      NOTREACHED();
+  }
+  buffer_.clear();
 }
 
-// The remaining contents of a Crx3 file are [header-size][header][archive].
 // [header] is an encoded protocol buffer and contains both a signed and
 // unsigned section. The unsigned section contains a set of key/signature pairs,
 // and the signed section is the encoding of another protocol buffer. All
 // signatures cover [prefix][signed-header-size][signed-header][archive].
-VerifierResult VerifyCrx3(
-    base::File* file,
-    crypto::SecureHash* hash,
-    const std::vector<std::vector<uint8_t>>& required_key_hashes,
-    std::string* public_key,
-    std::string* crx_id,
-    std::vector<uint8_t>* compressed_verified_contents,
-    bool require_publisher_key,
-    bool accept_publisher_test_key) {
-  // Parse [header-size] and [header].
-  int header_size =
-      base::saturated_cast<int>(ReadAndHashLittleEndianUInt32(file, hash));
-  if (header_size == INT_MAX)
-    return VerifierResult::ERROR_HEADER_INVALID;
-  std::vector<uint8_t> header_bytes(header_size);
-  if (ReadAndHashBuffer(header_bytes.data(), header_size, file, hash) !=
-      header_size) {
-    return VerifierResult::ERROR_HEADER_INVALID;
-  }
+VerifierResult StreamingVerifier::ProcessHeader() {
+  const std::vector<uint8_t>& header_bytes = buffer_;
 
   // If the header contains a ZIP EOCD or EOCD64 token, unzipping may not work
   // correctly.
@@ -126,14 +247,14 @@ VerifierResult VerifyCrx3(
   }
 
   CrxFileHeader header;
-  if (!header.ParseFromArray(header_bytes.data(), header_size))
+  if (!header.ParseFromArray(header_bytes.data(), header_bytes.size()))
     return VerifierResult::ERROR_HEADER_INVALID;
 
   // Parse [verified_contents].
-  if (header.has_verified_contents() && compressed_verified_contents) {
+  if (header.has_verified_contents()) {
     const std::string& header_verified_contents(header.verified_contents());
-    compressed_verified_contents->assign(header_verified_contents.begin(),
-                                         header_verified_contents.end());
+    compressed_verified_contents_.emplace(header_verified_contents.begin(),
+                                          header_verified_contents.end());
   }
 
   // Parse [signed-header].
@@ -154,23 +275,27 @@ VerifierResult VerifyCrx3(
       static_cast<uint8_t>(signed_header_size >> 24)};
 
   // Create a set of all required key hashes.
-  std::set<std::vector<uint8_t>> required_key_set(required_key_hashes.begin(),
-                                                  required_key_hashes.end());
+  std::set<std::vector<uint8_t>> required_key_set(
+      required_key_hashes_.begin(), required_key_hashes_.end());
 
   using ProofFetcher = const RepeatedProof& (CrxFileHeader::*)() const;
   ProofFetcher rsa = &CrxFileHeader::sha256_with_rsa;
   ProofFetcher ecdsa = &CrxFileHeader::sha256_with_ecdsa;
 
   std::string public_key_bytes;
-  VerifierCollection verifiers;
-  verifiers.reserve(header.sha256_with_rsa_size() +
-                    header.sha256_with_ecdsa_size());
+  verifiers_.reserve(header.sha256_with_rsa_size() +
+                     header.sha256_with_ecdsa_size());
   const std::vector<
       std::pair<ProofFetcher, crypto::SignatureVerifier::SignatureAlgorithm>>
       proof_types = {
           std::make_pair(rsa, crypto::SignatureVerifier::RSA_PKCS1_SHA256),
           std::make_pair(ecdsa, crypto::SignatureVerifier::ECDSA_SHA256)};
 
+  const bool require_publisher_key =
+      format_ == VerifierFormat::CRX3_WITH_PUBLISHER_PROOF ||
+      format_ == VerifierFormat::CRX3_WITH_TEST_PUBLISHER_PROOF;
+  const bool accept_publisher_test_key =
+      format_ == VerifierFormat::CRX3_WITH_TEST_PUBLISHER_PROOF;
   std::vector<uint8_t> publisher_key(std::begin(kPublisherKeyHash),
                                      std::end(kPublisherKeyHash));
   std::optional<std::vector<uint8_t>> publisher_test_key;
@@ -207,7 +332,7 @@ VerifierResult VerifyCrx3(
       v->VerifyUpdate(base::as_bytes(base::make_span(kSignatureContext)));
       v->VerifyUpdate(header_size_octets);
       v->VerifyUpdate(base::as_bytes(base::make_span(signed_header_data_str)));
-      verifiers.push_back(std::move(v));
+      verifiers_.push_back(std::move(v));
     }
   }
   if (public_key_bytes.empty() || !required_key_set.empty())
@@ -216,81 +341,9 @@ VerifierResult VerifyCrx3(
   if (require_publisher_key && !found_publisher_key)
     return VerifierResult::ERROR_REQUIRED_PROOF_MISSING;
 
-  // Update and finalize the verifiers with [archive].
-  if (!ReadHashAndVerifyArchive(file, hash, verifiers))
-    return VerifierResult::ERROR_SIGNATURE_VERIFICATION_FAILED;
-
-  *public_key = base::Base64Encode(public_key_bytes);
-  *crx_id = declared_crx_id;
+  public_key_bytes_ = std::move(public_key_bytes);
+  crx_id_ = declared_crx_id;
   return VerifierResult::OK_FULL;
 }
 
-}  // namespace
-
-VerifierResult Verify(
-    const base::FilePath& crx_path,
-    const VerifierFormat& format,
-    const std::vector<std::vector<uint8_t>>& required_key_hashes,
-    const std::vector<uint8_t>& required_file_hash,
-    std::string* public_key,
-    std::string* crx_id,
-    std::vector<uint8_t>* compressed_verified_contents) {
-  std::string public_key_local;
-  std::string crx_id_local;
-  base::File file(crx_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
-  if (!file.IsValid())
-    return VerifierResult::ERROR_FILE_NOT_READABLE;
-
-  std::unique_ptr<crypto::SecureHash> file_hash =
-      crypto::SecureHash::Create(crypto::SecureHash::SHA256);
-
-  // Magic number.
-  bool diff = false;
-  char buffer[kCrxFileHeaderMagicSize] = {};
-  if (file.ReadAtCurrentPos(buffer, kCrxFileHeaderMagicSize) !=
-      kCrxFileHeaderMagicSize)
-    return VerifierResult::ERROR_HEADER_INVALID;
-  if (!strncmp(buffer, kCrxDiffFileHeaderMagic, kCrxFileHeaderMagicSize))
-    diff = true;
-  else if (strncmp(buffer, kCrxFileHeaderMagic, kCrxFileHeaderMagicSize))
-    return VerifierResult::ERROR_HEADER_INVALID;
-  file_hash->Update(buffer, sizeof(buffer));
-
-  // Version number.
-  const uint32_t version =
-      ReadAndHashLittleEndianUInt32(&file, file_hash.get());
-  VerifierResult result;
-  if (version == 3) {
-    bool require_publisher_key =
-        format == VerifierFormat::CRX3_WITH_PUBLISHER_PROOF ||
-        format == VerifierFormat::CRX3_WITH_TEST_PUBLISHER_PROOF;
-    result = VerifyCrx3(
-        &file, file_hash.get(), required_key_hashes, &public_key_local,
-        &crx_id_local, compressed_verified_contents, require_publisher_key,
-        format == VerifierFormat::CRX3_WITH_TEST_PUBLISHER_PROOF);
-  } else {
-    result = VerifierResult::ERROR_HEADER_INVALID;
-  }
-  if (result != VerifierResult::OK_FULL)
-    return result;
-
-  // Finalize file hash.
-  uint8_t final_hash[crypto::kSHA256Length] = {};
-  file_hash->Finish(final_hash, sizeof(final_hash));
-  if (!required_file_hash.empty()) {
-    if (required_file_hash.size() != crypto::kSHA256Length)
-      return VerifierResult::ERROR_EXPECTED_HASH_INVALID;
-    if (!crypto::SecureMemEqual(final_hash, required_file_hash.data(),
-                                crypto::kSHA256Length))
-      return VerifierResult::ERROR_FILE_HASH_FAILED;
-  }
-
-  // All is well. Set the out-params and return.
-  if (public_key)
-    *public_key = public_key_local;
-  if (crx_id)
-    *crx_id = crx_id_local;
-  return diff ? VerifierResult::OK_DELTA : VerifierResult::OK_FULL;
-}
-
 }  // namespace crx_file
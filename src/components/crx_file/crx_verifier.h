@@ -6,13 +6,23 @@
 #define COMPONENTS_CRX_FILE_CRX_VERIFIER_H_
 
 #include <stdint.h>
+
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "base/containers/span.h"
+
 namespace base {
 class FilePath;
 }  // namespace base
 
+namespace crypto {
+class SecureHash;
+class SignatureVerifier;
+}  // namespace crypto
+
 namespace crx_file {
 
 enum class VerifierFormat {
@@ -53,6 +63,74 @@ VerifierResult Verify(
     std::string* crx_id,
     std::vector<uint8_t>* compressed_verified_contents);
 
+// Verifies a Crx as its bytes arrive, for example from the network, applying
+// the same checks as Verify(). The header is validated as soon as it has been
+// received and the archive is hashed and checked against the signatures as it
+// streams by, so a downloaded Crx does not need to be read back from disk to
+// be verified.
+class StreamingVerifier {
+ public:
+  StreamingVerifier(
+      const VerifierFormat& format,
+      const std::vector<std::vector<uint8_t>>& required_key_hashes,
+      const std::vector<uint8_t>& required_file_hash);
+
+  StreamingVerifier(const StreamingVerifier&) = delete;
+  StreamingVerifier& operator=(const StreamingVerifier&) = delete;
+
+  ~StreamingVerifier();
+
+  // Processes the next |data| of the Crx. Returns false as soon as the Crx is
+  // known to be invalid, after which further data is ignored and Finish()
+  // returns the error.
+  bool Update(base::span<const uint8_t> data);
+
+  // Completes the verification once all of the Crx has been passed to Update()
+  // and returns the result. The out-params are updated as by Verify().
+  VerifierResult Finish(std::string* public_key,
+                        std::string* crx_id,
+                        std::vector<uint8_t>* compressed_verified_contents);
+
+ private:
+  enum class State {
+    kMagic,
+    kVersion,
+    kHeaderSize,
+    kHeader,
+    kArchive,
+  };
+
+  // Returns the number of bytes of the field read in |state_|.
+  size_t FieldSize() const;
+
+  // Handles the field read in |state_|, which is in |buffer_|, and advances to
+  // the next state.
+  void OnFieldComplete();
+
+  // Parses the Crx3 header in |buffer_| and initializes |verifiers_|.
+  VerifierResult ProcessHeader();
+
+  const VerifierFormat format_;
+  const std::vector<std::vector<uint8_t>> required_key_hashes_;
+  const std::vector<uint8_t> required_file_hash_;
+
+  State state_ = State::kMagic;
+  std::optional<VerifierResult> error_;
+  bool diff_ = false;
+  uint32_t header_size_ = 0;
+
+  // The bytes received so far of the field read in |state_|.
+  std::vector<uint8_t> buffer_;
+
+  std::unique_ptr<crypto::SecureHash> file_hash_;
+  std::vector<std::unique_ptr<crypto::SignatureVerifier>> verifiers_;
+
+  // Set once the header has been parsed.
+  std::string public_key_bytes_;
+  std::string crx_id_;
+  std::optional<std::vector<uint8_t>> compressed_verified_contents_;
+};
+
 }  // namespace crx_file
 
 #endif  // COMPONENTS_CRX_FILE_CRX_VERIFIER_H_
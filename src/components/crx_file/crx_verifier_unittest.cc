@@ -3,8 +3,14 @@
 // found in the LICENSE file.
 
 #include "components/crx_file/crx_verifier.h"
+
+#include <algorithm>
+#include <optional>
+
 #include "base/base_paths.h"
+#include "base/containers/span.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/path_service.h"
 #include "base/strings/string_number_conversions.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -21,6 +27,30 @@ base::FilePath TestFile(const std::string& file) {
       .AppendASCII(file);
 }
 
+// Verifies |file| with a StreamingVerifier, passing it |chunk_size| bytes at a
+// time.
+crx_file::VerifierResult StreamingVerify(
+    const std::string& file,
+    size_t chunk_size,
+    crx_file::VerifierFormat format,
+    std::string* public_key,
+    std::string* crx_id,
+    std::vector<uint8_t>* compressed_verified_contents) {
+  std::optional<std::vector<uint8_t>> bytes =
+      base::ReadFileToBytes(TestFile(file));
+  EXPECT_TRUE(bytes);
+  crx_file::StreamingVerifier verifier(format, /*required_key_hashes=*/{},
+                                       /*required_file_hash=*/{});
+  base::span<const uint8_t> remaining(*bytes);
+  while (!remaining.empty()) {
+    const size_t length = std::min(chunk_size, remaining.size());
+    if (!verifier.Update(remaining.first(length)))
+      break;
+    remaining = remaining.subspan(length);
+  }
+  return verifier.Finish(public_key, crx_id, compressed_verified_contents);
+}
+
 constexpr char kOjjHash[] = "ojjgnpkioondelmggbekfhllhdaimnho";
 constexpr char kOjjKey[] =
     "MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEA230uN7vYDEhdDlb4/"
@@ -262,4 +292,82 @@ TEST_F(CrxVerifierTest, ChecksCompressedVerifiedContentsEmpty) {
   EXPECT_TRUE(compressed_verified_contents.empty());
 }
 
+// The streaming verifier must agree with Verify() however the Crx is split.
+TEST_F(CrxVerifierTest, StreamingMatchesFile) {
+  for (size_t chunk_size : {1u, 7u, 4096u, 1u << 20}) {
+    std::string public_key = "UNSET";
+    std::string crx_id = "UNSET";
+    EXPECT_EQ(VerifierResult::OK_FULL,
+              StreamingVerify("valid_no_publisher.crx3", chunk_size,
+                              VerifierFormat::CRX3, &public_key, &crx_id,
+                              /*compressed_verified_contents=*/nullptr))
+        << chunk_size;
+    EXPECT_EQ(std::string(kOjjHash), crx_id);
+    EXPECT_EQ(std::string(kOjjKey), public_key);
+
+    public_key = "UNSET";
+    crx_id = "UNSET";
+    EXPECT_EQ(VerifierResult::OK_FULL,
+              StreamingVerify("valid_test_publisher.crx3", chunk_size,
+                              VerifierFormat::CRX3_WITH_TEST_PUBLISHER_PROOF,
+                              &public_key, &crx_id,
+                              /*compressed_verified_contents=*/nullptr))
+        << chunk_size;
+    EXPECT_EQ(std::string(kJlnHash), crx_id);
+    EXPECT_EQ(std::string(kJlnKey), public_key);
+
+    EXPECT_EQ(VerifierResult::ERROR_REQUIRED_PROOF_MISSING,
+              StreamingVerify("valid_no_publisher.crx3", chunk_size,
+                              VerifierFormat::CRX3_WITH_PUBLISHER_PROOF,
+                              nullptr, nullptr,
+                              /*compressed_verified_contents=*/nullptr))
+        << chunk_size;
+    EXPECT_EQ(VerifierResult::ERROR_HEADER_INVALID,
+              StreamingVerify("valid.crx2", chunk_size, VerifierFormat::CRX3,
+                              nullptr, nullptr,
+                              /*compressed_verified_contents=*/nullptr))
+        << chunk_size;
+  }
+}
+
+// An invalid header is reported as soon as it has been received, and a Crx
+// that ends early or has a modified archive is rejected.
+TEST_F(CrxVerifierTest, StreamingRejectsInvalidCrx) {
+  std::optional<std::vector<uint8_t>> bytes =
+      base::ReadFileToBytes(TestFile("valid_no_publisher.crx3"));
+  ASSERT_TRUE(bytes);
+  const base::span<const uint8_t> crx(*bytes);
+
+  {
+    StreamingVerifier verifier(VerifierFormat::CRX3, {}, {});
+    const uint8_t bad_magic[] = {'C', 'r', '2', '4'};
+    EXPECT_FALSE(verifier.Update(bad_magic));
+    EXPECT_FALSE(verifier.Update(crx.subspan(4)));
+    EXPECT_EQ(VerifierResult::ERROR_HEADER_INVALID,
+              verifier.Finish(nullptr, nullptr, nullptr));
+  }
+  {
+    // Ends within the header.
+    StreamingVerifier verifier(VerifierFormat::CRX3, {}, {});
+    EXPECT_TRUE(verifier.Update(crx.first(20)));
+    EXPECT_EQ(VerifierResult::ERROR_HEADER_INVALID,
+              verifier.Finish(nullptr, nullptr, nullptr));
+  }
+  {
+    // Ends within the archive.
+    StreamingVerifier verifier(VerifierFormat::CRX3, {}, {});
+    EXPECT_TRUE(verifier.Update(crx.first(crx.size() - 1)));
+    EXPECT_EQ(VerifierResult::ERROR_SIGNATURE_VERIFICATION_FAILED,
+              verifier.Finish(nullptr, nullptr, nullptr));
+  }
+  {
+    std::vector<uint8_t> modified(crx.begin(), crx.end());
+    modified.back() ^= 1;
+    StreamingVerifier verifier(VerifierFormat::CRX3, {}, {});
+    EXPECT_TRUE(verifier.Update(modified));
+    EXPECT_EQ(VerifierResult::ERROR_SIGNATURE_VERIFICATION_FAILED,
+              verifier.Finish(nullptr, nullptr, nullptr));
+  }
+}
+
 }  // namespace crx_file
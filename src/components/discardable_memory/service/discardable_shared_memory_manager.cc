@@ -18,6 +18,7 @@
 #include "base/functional/callback.h"
 #include "base/memory/discardable_memory.h"
 #include "base/memory/shared_memory_tracker.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/numerics/safe_math.h"
 #include "base/process/memory.h"
 #include "base/strings/string_number_conversions.h"
@@ -44,6 +45,17 @@
 #endif
 
 namespace discardable_memory {
+
+BASE_FEATURE(kDiscardableMemoryClientBudgets,
+             "DiscardableMemoryClientBudgets",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+const base::FeatureParam<int> kDiscardableMemoryForegroundClientBudgetPercent{
+    &kDiscardableMemoryClientBudgets, "foreground_budget_percent", 50};
+
+const base::FeatureParam<int> kDiscardableMemoryBackgroundClientBudgetPercent{
+    &kDiscardableMemoryClientBudgets, "background_budget_percent", 10};
+
 namespace {
 
 const int kInvalidUniqueClientID = -1;
@@ -221,8 +233,9 @@ DiscardableSharedMemoryManager* g_instance = nullptr;
 }  // namespace
 
 DiscardableSharedMemoryManager::MemorySegment::MemorySegment(
-    std::unique_ptr<base::DiscardableSharedMemory> memory)
-    : memory_(std::move(memory)) {}
+    std::unique_ptr<base::DiscardableSharedMemory> memory,
+    int client_id)
+    : memory_(std::move(memory)), client_id_(client_id) {}
 
 DiscardableSharedMemoryManager::MemorySegment::~MemorySegment() = default;
 
@@ -308,7 +321,7 @@ DiscardableSharedMemoryManager* DiscardableSharedMemoryManager::Get() {
   return g_instance;
 }
 
-void DiscardableSharedMemoryManager::Bind(
+int DiscardableSharedMemoryManager::Bind(
     mojo::PendingReceiver<mojom::DiscardableSharedMemoryManager> receiver) {
   DCHECK(!mojo_thread_message_loop_ ||
          mojo_thread_message_loop_ == base::CurrentThread::Get());
@@ -320,10 +333,12 @@ void DiscardableSharedMemoryManager::Bind(
         base::SingleThreadTaskRunner::GetCurrentDefault();
   }
 
+  const int client_id = next_client_id_++;
   mojo::MakeSelfOwnedReceiver(
       std::make_unique<MojoDiscardableSharedMemoryManagerImpl>(
-          next_client_id_++, mojo_thread_weak_ptr_factory_.GetWeakPtr()),
+          client_id, mojo_thread_weak_ptr_factory_.GetWeakPtr()),
       std::move(receiver));
+  return client_id;
 }
 
 std::unique_ptr<base::DiscardableMemory>
@@ -414,6 +429,8 @@ void DiscardableSharedMemoryManager::ClientDeletedDiscardableSharedMemory(
 void DiscardableSharedMemoryManager::ClientRemoved(int client_id) {
   base::AutoLock lock(lock_);
 
+  client_priorities_.erase(client_id);
+
   auto it = clients_.find(client_id);
   if (it == clients_.end())
     return;
@@ -421,14 +438,26 @@ void DiscardableSharedMemoryManager::ClientRemoved(int client_id) {
   size_t bytes_allocated_before_releasing_memory = bytes_allocated_;
 
   for (auto& segment_it : it->second)
-    ReleaseMemory(segment_it.second->memory());
+    ReleaseMemory(segment_it.second.get());
 
   clients_.erase(it);
+  client_bytes_allocated_.erase(client_id);
 
   if (bytes_allocated_ != bytes_allocated_before_releasing_memory)
     BytesAllocatedChanged(bytes_allocated_);
 }
 
+void DiscardableSharedMemoryManager::SetClientPriority(
+    int client_id,
+    ClientPriority priority) {
+  base::AutoLock lock(lock_);
+
+  if (priority == ClientPriority::kForeground)
+    client_priorities_.erase(client_id);
+  else
+    client_priorities_[client_id] = priority;
+}
+
 void DiscardableSharedMemoryManager::SetMemoryLimit(size_t limit) {
   base::AutoLock lock(lock_);
 
@@ -503,13 +532,15 @@ void DiscardableSharedMemoryManager::AllocateLockedDiscardableSharedMemory(
   }
 
   bytes_allocated_ = checked_bytes_allocated.ValueOrDie();
+  client_bytes_allocated_[client_id] += memory->mapped_size();
   BytesAllocatedChanged(bytes_allocated_);
 
   *shared_memory_region = memory->DuplicateRegion();
   // Close file descriptor to avoid running out.
   memory->Close();
 
-  scoped_refptr<MemorySegment> segment(new MemorySegment(std::move(memory)));
+  scoped_refptr<MemorySegment> segment(
+      new MemorySegment(std::move(memory), client_id));
   client_segments[id] = segment.get();
   segments_.push_back(segment.get());
   std::push_heap(segments_.begin(), segments_.end(), CompareMemoryUsageTime);
@@ -533,7 +564,7 @@ void DiscardableSharedMemoryManager::DeletedDiscardableSharedMemory(
 
   size_t bytes_allocated_before_releasing_memory = bytes_allocated_;
 
-  ReleaseMemory(segment_it->second->memory());
+  ReleaseMemory(segment_it->second.get());
 
   client_segments.erase(segment_it);
 
@@ -586,6 +617,12 @@ void DiscardableSharedMemoryManager::ReduceMemoryUsageUntilWithinLimit(
 
   lock_.AssertAcquired();
   size_t bytes_allocated_before_purging = bytes_allocated_;
+
+  // Spare the foreground clients that stay within their budget for as long as
+  // possible, so that one client can't push out the segments of the others.
+  if (base::FeatureList::IsEnabled(kDiscardableMemoryClientBudgets))
+    PurgeLowPrioritySegmentsUntilWithinLimit(limit, current_time);
+
   while (!segments_.empty()) {
     if (bytes_allocated_ <= limit)
       break;
@@ -605,8 +642,8 @@ void DiscardableSharedMemoryManager::ReduceMemoryUsageUntilWithinLimit(
       continue;
 
     // Attempt to purge LRU segment. When successful, released the memory.
-    if (segment->memory()->Purge(current_time)) {
-      ReleaseMemory(segment->memory());
+    if (PurgeSegment(segment.get(), current_time,
+                     PurgeReason::kLeastRecentlyUsed)) {
       continue;
     }
 
@@ -620,14 +657,114 @@ void DiscardableSharedMemoryManager::ReduceMemoryUsageUntilWithinLimit(
     BytesAllocatedChanged(bytes_allocated_);
 }
 
-void DiscardableSharedMemoryManager::ReleaseMemory(
-    base::DiscardableSharedMemory* memory) {
+void DiscardableSharedMemoryManager::PurgeLowPrioritySegmentsUntilWithinLimit(
+    size_t limit,
+    base::Time current_time) {
   lock_.AssertAcquired();
 
+  if (bytes_allocated_ <= limit)
+    return;
+
+  // |segments_| is a heap, so visit a copy of it sorted from the least to the
+  // most recently used segment.
+  MemorySegmentVector candidates(segments_);
+  std::sort(candidates.begin(), candidates.end(),
+            [](const scoped_refptr<MemorySegment>& a,
+               const scoped_refptr<MemorySegment>& b) {
+              return a->memory()->last_known_usage() <
+                     b->memory()->last_known_usage();
+            });
+
+  bool purge_attempted = false;
+  for (PurgeReason reason :
+       {PurgeReason::kClientOverBudget, PurgeReason::kBackgroundClient}) {
+    for (const scoped_refptr<MemorySegment>& segment : candidates) {
+      if (bytes_allocated_ <= limit)
+        break;
+
+      // Skip the segments that were already released, or that are known to be
+      // in use.
+      if (!segment->memory()->mapped_size() ||
+          segment->memory()->last_known_usage() >= current_time) {
+        continue;
+      }
+
+      const bool is_candidate =
+          reason == PurgeReason::kClientOverBudget
+              ? IsClientOverBudget(segment->client_id())
+              : GetClientPriority(segment->client_id()) ==
+                    ClientPriority::kBackground;
+      if (!is_candidate)
+        continue;
+
+      PurgeSegment(segment.get(), current_time, reason);
+      purge_attempted = true;
+    }
+  }
+
+  // Purging updates the usage time of segments, which orders the heap.
+  if (purge_attempted)
+    std::make_heap(segments_.begin(), segments_.end(), CompareMemoryUsageTime);
+}
+
+bool DiscardableSharedMemoryManager::PurgeSegment(MemorySegment* segment,
+                                                  base::Time current_time,
+                                                  PurgeReason reason) {
+  lock_.AssertAcquired();
+
+  if (!segment->memory()->Purge(current_time))
+    return false;
+
+  base::UmaHistogramEnumeration("Memory.Discardable.PurgeReason", reason);
+  base::UmaHistogramBoolean(
+      "Memory.Discardable.PurgeVictimIsForeground",
+      GetClientPriority(segment->client_id()) == ClientPriority::kForeground);
+  base::UmaHistogramMemoryKB("Memory.Discardable.PurgeVictimSize",
+                             segment->memory()->mapped_size() / 1024);
+
+  ReleaseMemory(segment);
+  return true;
+}
+
+DiscardableSharedMemoryManager::ClientPriority
+DiscardableSharedMemoryManager::GetClientPriority(int client_id) const {
+  lock_.AssertAcquired();
+
+  auto it = client_priorities_.find(client_id);
+  return it == client_priorities_.end() ? ClientPriority::kForeground
+                                        : it->second;
+}
+
+bool DiscardableSharedMemoryManager::IsClientOverBudget(int client_id) const {
+  lock_.AssertAcquired();
+
+  auto it = client_bytes_allocated_.find(client_id);
+  if (it == client_bytes_allocated_.end())
+    return false;
+
+  const int budget_percent =
+      GetClientPriority(client_id) == ClientPriority::kForeground
+          ? kDiscardableMemoryForegroundClientBudgetPercent.Get()
+          : kDiscardableMemoryBackgroundClientBudgetPercent.Get();
+  const size_t budget =
+      memory_limit_ / 100 * static_cast<size_t>(std::max(budget_percent, 0));
+  return it->second > budget;
+}
+
+void DiscardableSharedMemoryManager::ReleaseMemory(MemorySegment* segment) {
+  lock_.AssertAcquired();
+
+  base::DiscardableSharedMemory* memory = segment->memory();
   size_t size = memory->mapped_size();
   DCHECK_GE(bytes_allocated_, size);
   bytes_allocated_ -= size;
 
+  auto client_bytes_it = client_bytes_allocated_.find(segment->client_id());
+  if (client_bytes_it != client_bytes_allocated_.end()) {
+    DCHECK_GE(client_bytes_it->second, size);
+    client_bytes_it->second -= size;
+  }
+
   // This will unmap the memory segment and drop our reference. The result
   // is that the memory will be released to the OS if the client is no longer
   // referencing it.
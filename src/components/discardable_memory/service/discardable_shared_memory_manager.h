@@ -16,6 +16,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "base/feature_list.h"
 #include "base/format_macros.h"
 #include "base/functional/callback.h"
 #include "base/memory/discardable_memory_allocator.h"
@@ -24,6 +25,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/memory/unsafe_shared_memory_region.h"
 #include "base/memory/weak_ptr.h"
+#include "base/metrics/field_trial_params.h"
 #include "base/process/process_handle.h"
 #include "base/synchronization/lock.h"
 #include "base/task/current_thread.h"
@@ -45,6 +47,21 @@ namespace {
 class TestDiscardableSharedMemoryManager;
 }  // namespace
 
+// When enabled, each client gets a soft budget that is a share of the memory
+// limit, depending on its priority. When memory usage must be reduced, the
+// segments of clients over their budget are purged first, then the segments
+// of background clients, and only then the least recently used segments of
+// foreground clients.
+DISCARDABLE_MEMORY_EXPORT BASE_DECLARE_FEATURE(
+    kDiscardableMemoryClientBudgets);
+
+// The soft budgets of foreground and background clients, in percent of the
+// memory limit.
+DISCARDABLE_MEMORY_EXPORT extern const base::FeatureParam<int>
+    kDiscardableMemoryForegroundClientBudgetPercent;
+DISCARDABLE_MEMORY_EXPORT extern const base::FeatureParam<int>
+    kDiscardableMemoryBackgroundClientBudgetPercent;
+
 // Implementation of DiscardableMemoryAllocator that allocates and manages
 // discardable memory segments for the process which hosts this class, and
 // for remote processes which request discardable memory from this class via
@@ -55,6 +72,23 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryManager
       public base::trace_event::MemoryDumpProvider,
       public base::CurrentThread::DestructionObserver {
  public:
+  // The priority of a client, usually derived from the visibility of the
+  // renderer it hosts. Clients are foreground until told otherwise.
+  enum class ClientPriority {
+    kForeground,
+    kBackground,
+  };
+
+  // The reason why a segment was purged to reduce memory usage. These values
+  // are persisted to logs. Entries should not be renumbered and numeric values
+  // should never be reused.
+  enum class PurgeReason {
+    kClientOverBudget = 0,
+    kBackgroundClient = 1,
+    kLeastRecentlyUsed = 2,
+    kMaxValue = kLeastRecentlyUsed,
+  };
+
   DiscardableSharedMemoryManager();
 
   DiscardableSharedMemoryManager(const DiscardableSharedMemoryManager&) =
@@ -69,8 +103,10 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryManager
   // created in the current process.
   static DiscardableSharedMemoryManager* Get();
 
-  // Bind the manager to a mojo interface receiver.
-  void Bind(
+  // Bind the manager to a mojo interface receiver. Returns the id of the
+  // client associated with |receiver|, which can be passed to
+  // SetClientPriority().
+  int Bind(
       mojo::PendingReceiver<mojom::DiscardableSharedMemoryManager> receiver);
 
   // Overridden from base::DiscardableMemoryAllocator:
@@ -98,6 +134,11 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryManager
   // allocated for client to the OS.
   void ClientRemoved(int client_id);
 
+  // Sets the priority of the client associated with |client_id|, which
+  // determines its soft budget and the order in which its segments are purged
+  // when kDiscardableMemoryClientBudgets is enabled.
+  void SetClientPriority(int client_id, ClientPriority priority);
+
   // The maximum number of bytes of memory that may be allocated. This will
   // cause memory usage to be reduced if currently above |limit|.
   void SetMemoryLimit(size_t limit);
@@ -117,12 +158,14 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryManager
 
   class MemorySegment : public base::RefCountedThreadSafe<MemorySegment> {
    public:
-    MemorySegment(std::unique_ptr<base::DiscardableSharedMemory> memory);
+    MemorySegment(std::unique_ptr<base::DiscardableSharedMemory> memory,
+                  int client_id);
 
     MemorySegment(const MemorySegment&) = delete;
     MemorySegment& operator=(const MemorySegment&) = delete;
 
     base::DiscardableSharedMemory* memory() const { return memory_.get(); }
+    int client_id() const { return client_id_; }
 
    private:
     friend class base::RefCountedThreadSafe<MemorySegment>;
@@ -130,6 +173,7 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryManager
     ~MemorySegment();
 
     std::unique_ptr<base::DiscardableSharedMemory> memory_;
+    const int client_id_;
   };
 
   static bool CompareMemoryUsageTime(const scoped_refptr<MemorySegment>& a,
@@ -154,8 +198,19 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryManager
       EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void ReduceMemoryUsageUntilWithinLimit(size_t limit)
       EXCLUSIVE_LOCKS_REQUIRED(lock_);
-  void ReleaseMemory(base::DiscardableSharedMemory* memory)
+  // Purges the least recently used segments of clients that are over their
+  // soft budget, then of background clients, until usage is within |limit|.
+  void PurgeLowPrioritySegmentsUntilWithinLimit(size_t limit,
+                                                base::Time current_time)
+      EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Attempts to purge |segment|, and releases its memory on success.
+  bool PurgeSegment(MemorySegment* segment,
+                    base::Time current_time,
+                    PurgeReason reason) EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  ClientPriority GetClientPriority(int client_id) const
       EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  bool IsClientOverBudget(int client_id) const EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void ReleaseMemory(MemorySegment* segment) EXCLUSIVE_LOCKS_REQUIRED(lock_);
   void BytesAllocatedChanged(size_t new_bytes_allocated) const;
 
   // Virtual for tests.
@@ -180,6 +235,9 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryManager
   // a heap. The LRU memory segment always first.
   using MemorySegmentVector = std::vector<scoped_refptr<MemorySegment>>;
   MemorySegmentVector segments_ GUARDED_BY(lock_);
+  // Clients that aren't in |client_priorities_| are foreground.
+  std::unordered_map<int, ClientPriority> client_priorities_ GUARDED_BY(lock_);
+  std::unordered_map<int, size_t> client_bytes_allocated_ GUARDED_BY(lock_);
   size_t default_memory_limit_ GUARDED_BY(lock_);
   size_t memory_limit_ GUARDED_BY(lock_);
   size_t bytes_allocated_ GUARDED_BY(lock_);
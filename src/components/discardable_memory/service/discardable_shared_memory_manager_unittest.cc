@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "base/memory/raw_ptr.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/task_environment.h"
 #include "base/threading/simple_thread.h"
 #include "base/time/time.h"
@@ -266,6 +267,100 @@ TEST_F(DiscardableSharedMemoryManagerTest, OnMemoryPressure) {
             manager_->on_memory_pressure_call_count());
 }
 
+class DiscardableSharedMemoryManagerClientBudgetsTest
+    : public DiscardableSharedMemoryManagerTest {
+ protected:
+  DiscardableSharedMemoryManagerClientBudgetsTest() {
+    scoped_feature_list_.InitAndEnableFeatureWithParameters(
+        kDiscardableMemoryClientBudgets,
+        {{"foreground_budget_percent", "60"},
+         {"background_budget_percent", "10"}});
+  }
+
+  // Allocates a segment of |size| bytes for |client_id| and unlocks it at
+  // |usage_time|.
+  std::unique_ptr<TestDiscardableSharedMemory> AllocateUnlockedSegment(
+      int client_id,
+      int32_t id,
+      size_t size,
+      base::Time usage_time) {
+    base::UnsafeSharedMemoryRegion shared_region;
+    manager_->AllocateLockedDiscardableSharedMemoryForClient(
+        client_id, size, id, &shared_region);
+    EXPECT_TRUE(shared_region.IsValid());
+
+    auto memory =
+        std::make_unique<TestDiscardableSharedMemory>(std::move(shared_region));
+    EXPECT_TRUE(memory->Map(size));
+    memory->SetNow(usage_time);
+    memory->Unlock(0, 0);
+    return memory;
+  }
+
+ private:
+  base::test::ScopedFeatureList scoped_feature_list_;
+};
+
+TEST_F(DiscardableSharedMemoryManagerClientBudgetsTest,
+       BackgroundClientPurgedFirst) {
+  const int kDataSize = 1024;
+  const int kForegroundClientId1 = 1;
+  const int kForegroundClientId2 = 2;
+  const int kBackgroundClientId = 3;
+  manager_->SetClientPriority(
+      kBackgroundClientId,
+      DiscardableSharedMemoryManager::ClientPriority::kBackground);
+
+  // The segments of the foreground clients are the least recently used.
+  std::unique_ptr<TestDiscardableSharedMemory> foreground_memory1 =
+      AllocateUnlockedSegment(kForegroundClientId1, 1, kDataSize,
+                              base::Time::FromSecondsSinceUnixEpoch(1));
+  std::unique_ptr<TestDiscardableSharedMemory> foreground_memory2 =
+      AllocateUnlockedSegment(kForegroundClientId2, 2, kDataSize,
+                              base::Time::FromSecondsSinceUnixEpoch(2));
+  std::unique_ptr<TestDiscardableSharedMemory> background_memory =
+      AllocateUnlockedSegment(kBackgroundClientId, 3, kDataSize,
+                              base::Time::FromSecondsSinceUnixEpoch(3));
+
+  // Enough memory for two allocations.
+  manager_->SetNow(base::Time::FromSecondsSinceUnixEpoch(4));
+  manager_->SetMemoryLimit(2 * foreground_memory1->mapped_size());
+
+  // The segment of the background client is purged instead of the least
+  // recently used one.
+  EXPECT_TRUE(foreground_memory1->IsMemoryResident());
+  EXPECT_TRUE(foreground_memory2->IsMemoryResident());
+  EXPECT_FALSE(background_memory->IsMemoryResident());
+}
+
+TEST_F(DiscardableSharedMemoryManagerClientBudgetsTest,
+       ClientOverBudgetPurgedFirst) {
+  const int kDataSize = 1024;
+  const int kLargeClientId = 1;
+  const int kSmallClientId = 2;
+
+  // The segment of the client within its budget is the least recently used.
+  std::unique_ptr<TestDiscardableSharedMemory> small_client_memory =
+      AllocateUnlockedSegment(kSmallClientId, 1, kDataSize,
+                              base::Time::FromSecondsSinceUnixEpoch(1));
+  std::unique_ptr<TestDiscardableSharedMemory> large_client_memory1 =
+      AllocateUnlockedSegment(kLargeClientId, 2, kDataSize,
+                              base::Time::FromSecondsSinceUnixEpoch(2));
+  std::unique_ptr<TestDiscardableSharedMemory> large_client_memory2 =
+      AllocateUnlockedSegment(kLargeClientId, 3, kDataSize,
+                              base::Time::FromSecondsSinceUnixEpoch(3));
+
+  // Enough memory for two allocations, so that the budget of each client is a
+  // bit more than one allocation.
+  manager_->SetNow(base::Time::FromSecondsSinceUnixEpoch(4));
+  manager_->SetMemoryLimit(2 * small_client_memory->mapped_size());
+
+  // The least recently used segment of the client over its budget is purged.
+  EXPECT_TRUE(small_client_memory->IsMemoryResident());
+  EXPECT_FALSE(large_client_memory1->IsMemoryResident());
+  EXPECT_TRUE(large_client_memory2->IsMemoryResident());
+}
+
 class DiscardableSharedMemoryManagerScheduleEnforceMemoryPolicyTest
     : public testing::Test {
  protected:
@@ -8,9 +8,11 @@
 
 #include "base/functional/bind.h"
 #include "base/location.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/observer_list.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/timer/elapsed_timer.h"
 #include "base/values.h"
 #include "components/dom_distiller/content/browser/distillability_driver.h"
 #include "components/dom_distiller/content/browser/distiller_javascript_utils.h"
@@ -28,8 +30,12 @@ namespace {
 void OnExtractFeaturesJsResult(const DistillablePageDetector* detector,
                                base::OnceCallback<void(bool)> callback,
                                base::Value result) {
-  std::move(callback).Run(
-      detector->Classify(CalculateDerivedFeaturesFromJSON(&result)));
+  base::ElapsedTimer timer;
+  bool is_distillable =
+      detector->Classify(CalculateDerivedFeaturesFromJSON(&result));
+  base::UmaHistogramMicrosecondsTimes("DomDistiller.Time.ClassifyPage",
+                                      timer.Elapsed());
+  std::move(callback).Run(is_distillable);
 }
 
 }  // namespace
@@ -5,9 +5,13 @@
 #include "components/dom_distiller/core/distillable_page_detector.h"
 
 #include <stddef.h>
+
+#include <algorithm>
+#include <cmath>
 #include <utility>
 
 #include "base/check.h"
+#include "base/ranges/algorithm.h"
 #include "components/grit/components_resources.h"
 #include "ui/base/resource/resource_bundle.h"
 
@@ -48,6 +52,21 @@ DistillablePageDetector::DistillablePageDetector(
     CHECK(stump.feature_number() >= 0);
     CHECK(stump.feature_number() < proto_->num_features());
     threshold_ += stump.weight() / 2.0;
+    stump_order_.push_back(i);
+  }
+
+  base::ranges::stable_sort(stump_order_, [this](int a, int b) {
+    return std::abs(proto_->stump(a).weight()) >
+           std::abs(proto_->stump(b).weight());
+  });
+  remaining_positive_weight_.resize(stump_order_.size() + 1, 0.0);
+  remaining_negative_weight_.resize(stump_order_.size() + 1, 0.0);
+  for (size_t i = stump_order_.size(); i > 0; --i) {
+    const double weight = proto_->stump(stump_order_[i - 1]).weight();
+    remaining_positive_weight_[i - 1] =
+        remaining_positive_weight_[i] + std::max(weight, 0.0);
+    remaining_negative_weight_[i - 1] =
+        remaining_negative_weight_[i] + std::min(weight, 0.0);
   }
 }
 
@@ -55,7 +74,23 @@ DistillablePageDetector::~DistillablePageDetector() = default;
 
 bool DistillablePageDetector::Classify(
     const std::vector<double>& features) const {
-  return Score(features) > threshold_;
+  if (features.size() != size_t(proto_->num_features())) {
+    return Score(features) > threshold_;
+  }
+  double score = 0.0;
+  for (size_t i = 0; i < stump_order_.size(); ++i) {
+    if (score + remaining_negative_weight_[i] > threshold_) {
+      return true;
+    }
+    if (score + remaining_positive_weight_[i] <= threshold_) {
+      return false;
+    }
+    const StumpProto& stump = proto_->stump(stump_order_[i]);
+    if (features[stump.feature_number()] > stump.split()) {
+      score += stump.weight();
+    }
+  }
+  return score > threshold_;
 }
 
 double DistillablePageDetector::Score(
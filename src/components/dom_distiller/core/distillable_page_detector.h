@@ -24,7 +24,8 @@ class DistillablePageDetector {
   ~DistillablePageDetector();
 
   // Returns true if the model classifies the vector of features as a
-  // distillable page.
+  // distillable page. Evaluates the heaviest stumps first and stops as soon as
+  // the remaining stumps can no longer change the result.
   bool Classify(const std::vector<double>& features) const;
 
   double Score(const std::vector<double>& features) const;
@@ -36,6 +37,12 @@ class DistillablePageDetector {
  private:
   std::unique_ptr<AdaBoostProto> proto_;
   double threshold_;
+  // Stump indices by decreasing absolute weight.
+  std::vector<int> stump_order_;
+  // The sums of the positive and negative weights of the stumps from the i-th
+  // one in |stump_order_| to the end, i.e. the range the score can still move.
+  std::vector<double> remaining_positive_weight_;
+  std::vector<double> remaining_negative_weight_;
 };
 
 }  // namespace dom_distiller
@@ -90,6 +90,29 @@ TEST(DomDistillerDistillablePageDetectorTest, TestScoreAndClassify) {
   EXPECT_TRUE(detector->Classify(features));
 }
 
+TEST(DomDistillerDistillablePageDetectorTest, TestClassifyMatchesScore) {
+  std::unique_ptr<DistillablePageDetector> detector =
+      Builder()
+          .Stump(0, 1.0, 1.0)
+          .Stump(0, -2.0, 2.0)
+          .Stump(1, 0.0, 0.5)
+          .Stump(2, 1.0, -3.0)
+          .Stump(1, 2.0, 0.25)
+          .Build();
+  // Classify() may stop early, so check it against the full score for every
+  // combination of stump outcomes.
+  const double kValues[] = {-3.0, 0.5, 1.5, 3.0};
+  for (double f0 : kValues) {
+    for (double f1 : kValues) {
+      for (double f2 : kValues) {
+        std::vector<double> features = {f0, f1, f2};
+        EXPECT_EQ(detector->Score(features) > detector->GetThreshold(),
+                  detector->Classify(features));
+      }
+    }
+  }
+}
+
 TEST(DomDistillerDistillablePageDetectorTest, TestScoreWrongNumberFeatures) {
   std::unique_ptr<DistillablePageDetector> detector =
       Builder().Stump(0, 1.0, 1.0).Stump(0, 1.4, 2.0).Build();
@@ -100,6 +123,7 @@ TEST(DomDistillerDistillablePageDetectorTest, TestScoreWrongNumberFeatures) {
   features.push_back(-3.0);
   features.push_back(1.0);
   EXPECT_DOUBLE_EQ(0.0, detector->Score(features));
+  EXPECT_FALSE(detector->Classify(features));
 }
 
 }  // namespace dom_distiller
@@ -14,7 +14,6 @@
 #include "base/functional/bind.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_functions.h"
-#include "base/numerics/safe_conversions.h"
 #include "base/pickle.h"
 #include "base/strings/stringprintf.h"
 #include "base/threading/thread_restrictions.h"
@@ -157,6 +156,12 @@ DownloadInterruptReason BaseFile::AppendDataToFile(const char* data,
 DownloadInterruptReason BaseFile::WriteDataToFile(int64_t offset,
                                                   const char* data,
                                                   size_t data_len) {
+  return WriteDataToFile(offset, {base::span<const char>(data, data_len)});
+}
+
+DownloadInterruptReason BaseFile::WriteDataToFile(
+    int64_t offset,
+    const std::vector<base::span<const char>>& buffers) {
   // NOTE(benwells): The above DCHECK won't be present in release builds,
   // so we log any occurences to see how common this error is in the wild.
   if (detached_)
@@ -167,6 +172,10 @@ DownloadInterruptReason BaseFile::WriteDataToFile(int64_t offset,
                               DOWNLOAD_INTERRUPT_REASON_FILE_FAILED);
   }
 
+  size_t data_len = 0;
+  for (const auto& buffer : buffers)
+    data_len += buffer.size();
+
   // TODO(phajdan.jr): get rid of this check.
   if (data_len == 0)
     return DOWNLOAD_INTERRUPT_REASON_NONE;
@@ -183,32 +192,20 @@ DownloadInterruptReason BaseFile::WriteDataToFile(int64_t offset,
   }
 
   // Writes to the file.
-  int64_t len = base::saturated_cast<int64_t>(data_len);
-  const char* current_data = data;
-  int64_t current_offset = offset;
-  while (len > 0) {
-    // |write_result| may be less than |len|, and return an error on the next
-    // write call when the disk is unavaliable.
-    int write_result = file_.Write(current_offset, current_data, len);
-    DCHECK_NE(0, write_result);
-
-    // Report errors on file writes.
-    if (write_result < 0)
-      return LogSystemError("Write", logging::GetLastSystemErrorCode());
-
-    // Update status.
-    DCHECK_LE(write_result, len);
-    len -= write_result;
-    current_data += write_result;
-    current_offset += write_result;
-    bytes_so_far_ += write_result;
-  }
+  int64_t bytes_written = 0;
+  DownloadInterruptReason reason =
+      WriteBuffersToFile(offset, buffers, &bytes_written);
+  bytes_so_far_ += bytes_written;
+  if (reason != DOWNLOAD_INTERRUPT_REASON_NONE)
+    return reason;
 
   CONDITIONAL_TRACE(NESTABLE_ASYNC_END1("download", "DownloadFileWrite",
                                         download_id_, "bytes", data_len));
 
-  if (secure_hash_)
-    secure_hash_->Update(data, data_len);
+  if (secure_hash_) {
+    for (const auto& buffer : buffers)
+      secure_hash_->Update(buffer.data(), buffer.size());
+  }
 
   return DOWNLOAD_INTERRUPT_REASON_NONE;
 }
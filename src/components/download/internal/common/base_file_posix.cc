@@ -5,12 +5,113 @@
 #include "components/download/public/common/base_file.h"
 
 #include <errno.h>
+#include <fcntl.h>
+
+#include <algorithm>
 
 #include "base/files/file_util.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/threading/scoped_blocking_call.h"
+#include "build/build_config.h"
 #include "components/download/public/common/download_interrupt_reasons.h"
 
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+#include <limits.h>
+#include <sys/uio.h>
+#endif
+
 namespace download {
 
+DownloadInterruptReason BaseFile::WriteBuffersToFile(
+    int64_t offset,
+    const std::vector<base::span<const char>>& buffers,
+    int64_t* bytes_written) {
+  *bytes_written = 0;
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  std::vector<struct iovec> iovecs;
+  iovecs.reserve(buffers.size());
+  for (const auto& buffer : buffers) {
+    if (!buffer.empty())
+      iovecs.push_back({const_cast<char*>(buffer.data()), buffer.size()});
+  }
+
+  size_t index = 0;
+  while (index < iovecs.size()) {
+    // |write_result| may be less than the data left, and return an error on
+    // the next write call when the disk is unavaliable.
+    int iovec_count =
+        static_cast<int>(std::min<size_t>(iovecs.size() - index, IOV_MAX));
+    ssize_t write_result =
+        HANDLE_EINTR(pwritev(file_.GetPlatformFile(), &iovecs[index],
+                             iovec_count, offset + *bytes_written));
+    DCHECK_NE(0, write_result);
+
+    // Report errors on file writes.
+    if (write_result < 0)
+      return LogSystemError("Write", errno);
+
+    *bytes_written += write_result;
+
+    // Skip the data that has been written.
+    size_t remaining = static_cast<size_t>(write_result);
+    while (index < iovecs.size() && remaining >= iovecs[index].iov_len) {
+      remaining -= iovecs[index].iov_len;
+      ++index;
+    }
+    if (remaining > 0) {
+      iovecs[index].iov_base =
+          static_cast<char*>(iovecs[index].iov_base) + remaining;
+      iovecs[index].iov_len -= remaining;
+    }
+  }
+#else
+  for (const auto& buffer : buffers) {
+    int64_t len = base::saturated_cast<int64_t>(buffer.size());
+    const char* current_data = buffer.data();
+    while (len > 0) {
+      int write_result =
+          file_.Write(offset + *bytes_written, current_data, len);
+      DCHECK_NE(0, write_result);
+
+      // Report errors on file writes.
+      if (write_result < 0)
+        return LogSystemError("Write", errno);
+
+      DCHECK_LE(write_result, len);
+      len -= write_result;
+      current_data += write_result;
+      *bytes_written += write_result;
+    }
+  }
+#endif
+  return DOWNLOAD_INTERRUPT_REASON_NONE;
+}
+
+bool BaseFile::Preallocate(int64_t total_bytes) {
+  if (!file_.IsValid() || total_bytes <= bytes_so_far_)
+    return false;
+
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  // Keep the file length, Open() relies on it to find the data written so far.
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  return HANDLE_EINTR(fallocate(file_.GetPlatformFile(), FALLOC_FL_KEEP_SIZE,
+                                0, static_cast<off_t>(total_bytes))) == 0;
+#elif BUILDFLAG(IS_APPLE)
+  int64_t file_length = file_.GetLength();
+  if (file_length < 0 || total_bytes <= file_length)
+    return false;
+  fstore_t params = {F_ALLOCATEALL, F_PEOFPOSMODE, 0,
+                     static_cast<off_t>(total_bytes - file_length), 0};
+  return fcntl(file_.GetPlatformFile(), F_PREALLOCATE, &params) != -1;
+#else
+  return false;
+#endif
+}
+
 DownloadInterruptReason BaseFile::MoveFileAndAdjustPermissions(
     const base::FilePath& new_path) {
   // Similarly, on Unix, we're moving a temp file created with permissions 600
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/files/file.h"
 #include "base/files/file_util.h"
@@ -291,6 +292,33 @@ TEST_F(BaseFileTest, MultipleWrites) {
   ExpectHashValue(kHashOfTestData1To3, base_file_->Finish());
 }
 
+// Write several buffers to the file at once.
+TEST_F(BaseFileTest, WriteMultipleBuffers) {
+  ASSERT_TRUE(InitializeFile());
+  std::vector<base::span<const char>> buffers = {
+      base::span<const char>(kTestData1, kTestDataLength1),
+      base::span<const char>(kTestData2, kTestDataLength2),
+      base::span<const char>(kTestData3, kTestDataLength3)};
+  EXPECT_EQ(DOWNLOAD_INTERRUPT_REASON_NONE,
+            base_file_->WriteDataToFile(0, buffers));
+  set_expected_data(std::string(kTestData1) + kTestData2 + kTestData3);
+  ExpectHashValue(kHashOfTestData1To3, base_file_->Finish());
+}
+
+// Reserving disk space for the file doesn't change its length.
+TEST_F(BaseFileTest, PreallocateKeepsFileLength) {
+  ASSERT_TRUE(InitializeFile());
+  ASSERT_TRUE(AppendDataToFile(kTestData1));
+  base_file_->Preallocate(1024 * 1024);
+
+  int64_t file_size = 0;
+  ASSERT_TRUE(base::GetFileSize(base_file_->full_path(), &file_size));
+  EXPECT_EQ(kTestDataLength1, file_size);
+
+  ASSERT_TRUE(AppendDataToFile(kTestData2));
+  base_file_->Finish();
+}
+
 // Write data to the file multiple times, interrupt it, and continue using
 // another file.  Calculate the resulting combined sha256 hash.
 TEST_F(BaseFileTest, MultipleWritesInterruptedWithHash) {
@@ -13,6 +13,7 @@
 #include <wrl/client.h>
 #include <wrl/implements.h>
 
+#include "base/numerics/safe_conversions.h"
 #include "base/threading/scoped_blocking_call.h"
 #include "base/win/com_init_util.h"
 #include "components/download/public/common/download_interrupt_reasons_utils.h"
@@ -237,6 +238,48 @@ class FileOperationProgressSink
 
 }  // namespace
 
+DownloadInterruptReason BaseFile::WriteBuffersToFile(
+    int64_t offset,
+    const std::vector<base::span<const char>>& buffers,
+    int64_t* bytes_written) {
+  *bytes_written = 0;
+  for (const auto& buffer : buffers) {
+    int64_t len = base::saturated_cast<int64_t>(buffer.size());
+    const char* current_data = buffer.data();
+    while (len > 0) {
+      // |write_result| may be less than |len|, and return an error on the next
+      // write call when the disk is unavaliable.
+      int write_result =
+          file_.Write(offset + *bytes_written, current_data, len);
+      DCHECK_NE(0, write_result);
+
+      // Report errors on file writes.
+      if (write_result < 0)
+        return LogSystemError("Write", logging::GetLastSystemErrorCode());
+
+      DCHECK_LE(write_result, len);
+      len -= write_result;
+      current_data += write_result;
+      *bytes_written += write_result;
+    }
+  }
+  return DOWNLOAD_INTERRUPT_REASON_NONE;
+}
+
+bool BaseFile::Preallocate(int64_t total_bytes) {
+  if (!file_.IsValid() || total_bytes <= bytes_so_far_)
+    return false;
+
+  base::ScopedBlockingCall scoped_blocking_call(FROM_HERE,
+                                                base::BlockingType::MAY_BLOCK);
+  // Setting the allocation size doesn't move the end of the file.
+  FILE_ALLOCATION_INFO allocation_info;
+  allocation_info.AllocationSize.QuadPart = total_bytes;
+  return ::SetFileInformationByHandle(file_.GetPlatformFile(),
+                                      FileAllocationInfo, &allocation_info,
+                                      sizeof(allocation_info)) != 0;
+}
+
 // Renames a file using IFileOperation::MoveItem() to ensure that the target
 // file gets the correct default security descriptor in the new path.
 // Returns a network error, or net::OK for success.
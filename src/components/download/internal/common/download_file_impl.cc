@@ -41,6 +41,11 @@ namespace {
 const int kUpdatePeriodMs = 500;
 const int kMaxTimeBlockingFileThreadMs = 1000;
 
+// Limits on the data from a stream that is queued to be written to the file at
+// once.
+const size_t kMaxBytesPerWrite = 4 * 1024 * 1024;
+const size_t kMaxBuffersPerWrite = 64;
+
 // These constants control the default retry behavior for failing renames. Each
 // retry is performed after a delay that is twice the previous delay. The
 // initial delay is specified by kInitialRenameRetryDelayMs.
@@ -100,6 +105,10 @@ DownloadFileImpl::SourceStream::SourceStream(
 
 DownloadFileImpl::SourceStream::~SourceStream() = default;
 
+DownloadFileImpl::PendingWrites::PendingWrites() = default;
+
+DownloadFileImpl::PendingWrites::~PendingWrites() = default;
+
 void DownloadFileImpl::SourceStream::Initialize() {
   input_stream_->Initialize();
 }
@@ -247,6 +256,10 @@ void DownloadFileImpl::Initialize(
   }
   download_start_ = base::TimeTicks::Now();
 
+  // Reserve disk space for the whole file if its size is known.
+  if (save_info_->total_bytes > 0)
+    file_.Preallocate(save_info_->total_bytes);
+
   // Primarily to make reset to zero in restart visible to owner.
   SendUpdate();
 
@@ -579,6 +592,7 @@ void DownloadFileImpl::StreamActive(SourceStream* source_stream,
   size_t bytes_to_validate = 0;
   size_t bytes_to_write = 0;
   bool should_terminate = false;
+  PendingWrites pending_writes;
   InputStream::StreamState state(InputStream::EMPTY);
   DownloadInterruptReason reason = DOWNLOAD_INTERRUPT_REASON_NONE;
   base::TimeDelta delta(base::Milliseconds(kMaxTimeBlockingFileThreadMs));
@@ -595,26 +609,37 @@ void DownloadFileImpl::StreamActive(SourceStream* source_stream,
             CalculateBytesToWrite(source_stream, incoming_data_size,
                                   &bytes_to_validate, &bytes_to_write);
         DCHECK_GE(incoming_data_size, bytes_to_write);
+        bytes_seen_ += bytes_to_write;
+        total_incoming_data_size += incoming_data_size;
+        if (bytes_to_validate == 0 && bytes_to_write > 0) {
+          // Queue the data, it is written along with the next buffers.
+          if (pending_writes.buffers.empty()) {
+            pending_writes.offset =
+                source_stream->offset() + source_stream->bytes_read();
+            pending_writes.prev_bytes_written = source_stream->bytes_written();
+          }
+          pending_writes.buffers.push_back(incoming_data);
+          pending_writes.data.emplace_back(incoming_data->data(),
+                                           bytes_to_write);
+          pending_writes.bytes += bytes_to_write;
+          source_stream->OnBytesConsumed(incoming_data_size, bytes_to_write);
+          if (pending_writes.bytes >= kMaxBytesPerWrite ||
+              pending_writes.buffers.size() >= kMaxBuffersPerWrite) {
+            reason = FlushPendingWrites(source_stream, &pending_writes);
+          }
+          break;
+        }
+        reason = FlushPendingWrites(source_stream, &pending_writes);
+        if (reason != DOWNLOAD_INTERRUPT_REASON_NONE)
+          break;
         reason = ValidateAndWriteDataToFile(
             source_stream->offset() + source_stream->bytes_read(),
             incoming_data->data(), bytes_to_validate, bytes_to_write);
-        bytes_seen_ += bytes_to_write;
-        total_incoming_data_size += incoming_data_size;
         if (reason == DOWNLOAD_INTERRUPT_REASON_NONE) {
           int64_t prev_bytes_written = source_stream->bytes_written();
           source_stream->OnBytesConsumed(incoming_data_size, bytes_to_write);
-          if (!IsSparseFile())
-            break;
-          // If the write operation creates a new slice, add it to the
-          // |received_slices_| and update all the entries in
-          // |source_streams_|.
-          if (bytes_to_write > 0 && prev_bytes_written == 0) {
-            AddNewSlice(source_stream->starting_file_write_offset(),
-                        bytes_to_write);
-          } else {
-            received_slices_[source_stream->index()].received_bytes +=
-                bytes_to_write;
-          }
+          OnBytesWrittenToFile(source_stream, prev_bytes_written,
+                               bytes_to_write);
         }
       } break;
       case InputStream::WAIT_FOR_COMPLETION:
@@ -632,6 +657,9 @@ void DownloadFileImpl::StreamActive(SourceStream* source_stream,
            reason == DOWNLOAD_INTERRUPT_REASON_NONE && now - start <= delta &&
            !should_terminate);
 
+  if (reason == DOWNLOAD_INTERRUPT_REASON_NONE)
+    reason = FlushPendingWrites(source_stream, &pending_writes);
+
   // If we're stopping to yield the thread, post a task so we come back.
   if (state == InputStream::HAS_DATA && now - start > delta &&
       !should_terminate) {
@@ -656,6 +684,40 @@ void DownloadFileImpl::StreamActive(SourceStream* source_stream,
                        total_incoming_data_size, "num_buffers", num_buffers);
 }
 
+DownloadInterruptReason DownloadFileImpl::FlushPendingWrites(
+    SourceStream* source_stream,
+    PendingWrites* pending_writes) {
+  if (pending_writes->buffers.empty())
+    return DOWNLOAD_INTERRUPT_REASON_NONE;
+
+  WillWriteToDisk(pending_writes->bytes);
+  DownloadInterruptReason reason =
+      file_.WriteDataToFile(pending_writes->offset, pending_writes->data);
+  if (reason == DOWNLOAD_INTERRUPT_REASON_NONE) {
+    OnBytesWrittenToFile(source_stream, pending_writes->prev_bytes_written,
+                         pending_writes->bytes);
+  }
+
+  pending_writes->bytes = 0;
+  pending_writes->buffers.clear();
+  pending_writes->data.clear();
+  return reason;
+}
+
+void DownloadFileImpl::OnBytesWrittenToFile(SourceStream* source_stream,
+                                            int64_t prev_bytes_written,
+                                            size_t bytes_written) {
+  if (!IsSparseFile())
+    return;
+  // If the write operation creates a new slice, add it to the
+  // |received_slices_| and update all the entries in |source_streams_|.
+  if (bytes_written > 0 && prev_bytes_written == 0) {
+    AddNewSlice(source_stream->starting_file_write_offset(), bytes_written);
+  } else {
+    received_slices_[source_stream->index()].received_bytes += bytes_written;
+  }
+}
+
 void DownloadFileImpl::OnStreamCompleted(SourceStream* source_stream) {
   DownloadInterruptReason reason = HandleStreamCompletionStatus(source_stream);
   SendUpdate();
@@ -582,6 +582,10 @@ void InProgressDownloadManager::StartDownloadWithItem(
   std::unique_ptr<DownloadFile> download_file;
   if (info->result == DOWNLOAD_INTERRUPT_REASON_NONE) {
     DCHECK(stream);
+    if (info->total_bytes > 0 && !info->save_info->IsArbitraryRangeRequest()) {
+      info->save_info->total_bytes =
+          info->save_info->offset + info->total_bytes;
+    }
     download_file.reset(file_factory_->CreateFile(
         std::move(info->save_info), default_download_directory,
         std::move(stream), download->GetId(), duplicate_download_file_path,
@@ -5,6 +5,7 @@
 #include "components/download/internal/common/parallel_download_job.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "base/functional/bind.h"
 #include "base/metrics/histogram_macros.h"
@@ -37,7 +38,9 @@ ParallelDownloadJob::ParallelDownloadJob(
       url_loader_factory_provider_(std::move(url_loader_factory_provider)),
       wake_lock_provider_binder_(std::move(wake_lock_provider_binder)) {}
 
-ParallelDownloadJob::~ParallelDownloadJob() = default;
+ParallelDownloadJob::~ParallelDownloadJob() {
+  RecordParallelDownloadSpeedup();
+}
 
 void ParallelDownloadJob::OnDownloadFileInitialized(
     DownloadFile::InitializeCallback callback,
@@ -52,6 +55,7 @@ void ParallelDownloadJob::OnDownloadFileInitialized(
 void ParallelDownloadJob::Cancel(bool user_cancel) {
   is_canceled_ = true;
   DownloadJobImpl::Cancel(user_cancel);
+  slice_split_timer_.Stop();
 
   if (!requests_sent_) {
     timer_.Stop();
@@ -64,6 +68,7 @@ void ParallelDownloadJob::Cancel(bool user_cancel) {
 
 void ParallelDownloadJob::Pause() {
   DownloadJobImpl::Pause();
+  slice_split_timer_.Stop();
 
   if (!requests_sent_) {
     timer_.Stop();
@@ -88,6 +93,7 @@ void ParallelDownloadJob::Resume(bool resume_request) {
 
   for (auto& worker : workers_)
     worker.second->Resume();
+  StartSliceSplitTimer();
 }
 
 int ParallelDownloadJob::GetParallelRequestCount() const {
@@ -102,6 +108,10 @@ int ParallelDownloadJob::GetMinRemainingTimeInSeconds() const {
   return GetParallelRequestRemainingTimeConfig().InSeconds();
 }
 
+base::TimeDelta ParallelDownloadJob::GetSliceSplitInterval() const {
+  return GetSliceSplitIntervalConfig();
+}
+
 void ParallelDownloadJob::CancelRequestWithOffset(int64_t offset) {
   if (initial_request_offset_ == offset) {
     DownloadJobImpl::Cancel(false);
@@ -202,6 +212,95 @@ void ParallelDownloadJob::BuildParallelRequests() {
   ForkSubRequests(slices_to_download);
 
   requests_sent_ = true;
+  initial_bytes_per_second_ = download_item_->CurrentSpeed();
+  StartSliceSplitTimer();
+}
+
+void ParallelDownloadJob::StartSliceSplitTimer() {
+  base::TimeDelta interval = GetSliceSplitInterval();
+  if (!interval.is_positive() || slice_split_timer_.IsRunning())
+    return;
+
+  last_measure_time_ = base::TimeTicks::Now();
+  slice_split_timer_.Start(FROM_HERE, interval, this,
+                           &ParallelDownloadJob::MaybeSplitSlowestSlice);
+}
+
+void ParallelDownloadJob::MaybeSplitSlowestSlice() {
+  if (is_canceled_ ||
+      download_item_->GetState() != DownloadItem::DownloadState::IN_PROGRESS) {
+    slice_split_timer_.Stop();
+    return;
+  }
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  const DownloadItem::ReceivedSlices& received_slices =
+      download_item_->GetReceivedSlices();
+  std::map<int64_t, int64_t> bytes_per_second;
+  for (const auto& slice : received_slices) {
+    if (slice.finished)
+      continue;
+
+    int64_t& last_received_bytes = last_received_bytes_[slice.offset];
+    int64_t new_bytes =
+        std::max<int64_t>(slice.received_bytes - last_received_bytes, 0);
+    last_received_bytes = slice.received_bytes;
+    measured_bytes_ += new_bytes;
+
+    RateEstimator& estimator = slice_rate_estimators_[slice.offset];
+    estimator.Increment(
+        static_cast<uint32_t>(std::min<int64_t>(
+            new_bytes, std::numeric_limits<uint32_t>::max())),
+        now);
+    bytes_per_second[slice.offset] = estimator.GetCountPerSecond(now);
+  }
+  measured_time_ += now - last_measure_time_;
+  last_measure_time_ = now;
+
+  // Requests that haven't reached their first byte yet, e.g. one that just took
+  // over part of a slow request's range, will soon be streaming as well.
+  int pending_requests = 0;
+  for (const auto& worker : workers_) {
+    int64_t offset = worker.first;
+    bool reached = std::any_of(
+        received_slices.begin(), received_slices.end(),
+        [offset](const DownloadItem::ReceivedSlice& slice) {
+          return slice.offset <= offset &&
+                 offset <= slice.offset + slice.received_bytes;
+        });
+    if (!reached)
+      pending_requests++;
+  }
+
+  int64_t total_bytes = download_item_->GetTotalBytes();
+  if (total_bytes <= 0)
+    return;
+
+  std::optional<int64_t> split_offset = FindOffsetToSplitSlowestSlice(
+      received_slices, bytes_per_second, total_bytes,
+      GetParallelRequestCount() - pending_requests, GetMinSliceSize());
+  if (!split_offset || workers_.find(*split_offset) != workers_.end())
+    return;
+
+  VLOG(kDownloadJobVerboseLevel)
+      << "Splitting the range of a slow request at offset " << *split_offset;
+  CreateRequest(*split_offset);
+  slice_split_count_++;
+}
+
+void ParallelDownloadJob::RecordParallelDownloadSpeedup() {
+  if (!requests_sent_ || initial_bytes_per_second_ <= 0 ||
+      !measured_time_.is_positive()) {
+    return;
+  }
+
+  int64_t bytes_per_second = measured_bytes_ / measured_time_.InSecondsF();
+  UMA_HISTOGRAM_COUNTS_10000(
+      "Download.ParallelDownload.SpeedupPercentage",
+      static_cast<int>(std::min<int64_t>(
+          bytes_per_second * 100 / initial_bytes_per_second_, 10000)));
+  UMA_HISTOGRAM_COUNTS_100("Download.ParallelDownload.SliceSplitCount",
+                           slice_split_count_);
 }
 
 void ParallelDownloadJob::ForkSubRequests(
@@ -5,6 +5,7 @@
 #ifndef COMPONENTS_DOWNLOAD_INTERNAL_COMMON_PARALLEL_DOWNLOAD_JOB_H_
 #define COMPONENTS_DOWNLOAD_INTERNAL_COMMON_PARALLEL_DOWNLOAD_JOB_H_
 
+#include <map>
 #include <memory>
 #include <unordered_map>
 
@@ -15,6 +16,7 @@
 #include "components/download/public/common/download_export.h"
 #include "components/download/public/common/download_job_factory.h"
 #include "components/download/public/common/parallel_download_configs.h"
+#include "components/download/public/common/rate_estimator.h"
 #include "components/download/public/common/url_loader_factory_provider.h"
 
 namespace download {
@@ -55,6 +57,7 @@ class COMPONENTS_DOWNLOAD_EXPORT ParallelDownloadJob
   virtual int GetParallelRequestCount() const;
   virtual int64_t GetMinSliceSize() const;
   virtual int GetMinRemainingTimeInSeconds() const;
+  virtual base::TimeDelta GetSliceSplitInterval() const;
 
   using WorkerMap =
       std::unordered_map<int64_t, std::unique_ptr<DownloadWorker>>;
@@ -84,6 +87,17 @@ class COMPONENTS_DOWNLOAD_EXPORT ParallelDownloadJob
   // The first slice represents the original request.
   void ForkSubRequests(const DownloadItem::ReceivedSlices& slices_to_download);
 
+  // Start measuring the throughput of each stream, if splitting slices is
+  // enabled.
+  void StartSliceSplitTimer();
+
+  // Update the throughput of each stream, and hand half of the range left to
+  // the slowest stream to a new request once another request is done.
+  void MaybeSplitSlowestSlice();
+
+  // Record how much faster the parallel requests were than the initial one.
+  void RecordParallelDownloadSpeedup();
+
   // Create one range request, virtual for testing. Range request will start
   // from |offset| and will be half open.
   virtual void CreateRequest(int64_t offset);
@@ -105,6 +119,27 @@ class COMPONENTS_DOWNLOAD_EXPORT ParallelDownloadJob
   // Used to send parallel requests after a delay based on Finch config.
   base::OneShotTimer timer_;
 
+  // Used to periodically measure the throughput of each stream.
+  base::RepeatingTimer slice_split_timer_;
+
+  // Throughput of each stream, keyed by the offset of the slice it writes.
+  std::map<int64_t, RateEstimator> slice_rate_estimators_;
+
+  // Received bytes of each slice when the throughput was last measured.
+  std::map<int64_t, int64_t> last_received_bytes_;
+
+  // Throughput of the initial request when parallel requests were sent.
+  int64_t initial_bytes_per_second_ = 0;
+
+  // Bytes received by all streams, and the time spent receiving them, while
+  // the throughput was being measured.
+  int64_t measured_bytes_ = 0;
+  base::TimeDelta measured_time_;
+  base::TimeTicks last_measure_time_;
+
+  // Number of requests created to take over part of a slow request's range.
+  int slice_split_count_ = 0;
+
   // If we have sent parallel requests.
   bool requests_sent_;
 
@@ -147,6 +147,8 @@ class ParallelDownloadJobTest : public testing::Test {
 
   void BuildParallelRequests() { job_->BuildParallelRequests(); }
 
+  void MaybeSplitSlowestSlice() { job_->MaybeSplitSlowestSlice(); }
+
   void set_received_slices(const DownloadItem::ReceivedSlices& slices) {
     received_slices_ = slices;
   }
@@ -407,6 +409,29 @@ TEST_F(ParallelDownloadJobTest, RemainingContentWillFinishSoon) {
   DestroyParallelJob();
 }
 
+// Test that the range left to the slowest request is taken over by a new
+// request once another request is done.
+TEST_F(ParallelDownloadJobTest, SplitSlowestSliceWhenRequestDone) {
+  // Original request: Range:0-32. Task 1: Range:33-65. Task 2: Range:66-.
+  CreateParallelJob(0, 100, DownloadItem::ReceivedSlices(), 3, 1, 10);
+  BuildParallelRequests();
+  EXPECT_EQ(2u, job_->workers().size());
+
+  // The original request is done, and task 1 is slower than task 2.
+  set_received_slices({DownloadItem::ReceivedSlice(0, 33, true),
+                       DownloadItem::ReceivedSlice(33, 10),
+                       DownloadItem::ReceivedSlice(66, 30)});
+  MaybeSplitSlowestSlice();
+  EXPECT_EQ(3u, job_->workers().size());
+  VerifyWorker(54, 0);
+
+  // Don't split again until the new request starts to write data.
+  MaybeSplitSlowestSlice();
+  EXPECT_EQ(3u, job_->workers().size());
+
+  DestroyParallelJob();
+}
+
 // Test that parallel request is not created until download file is initialized.
 TEST_F(ParallelDownloadJobTest, ParallelRequestNotCreatedUntilFileInitialized) {
   auto save_info = std::make_unique<DownloadSaveInfo>();
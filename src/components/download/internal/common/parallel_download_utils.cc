@@ -157,6 +157,48 @@ std::vector<DownloadItem::ReceivedSlice> FindSlicesForRemainingContent(
   return new_slices;
 }
 
+std::optional<int64_t> FindOffsetToSplitSlowestSlice(
+    const DownloadItem::ReceivedSlices& received_slices,
+    const std::map<int64_t, int64_t>& bytes_per_second,
+    int64_t total_bytes,
+    int request_count,
+    int64_t min_slice_size) {
+  int active_streams = 0;
+  std::optional<int64_t> split_offset;
+  int64_t slowest_bytes_per_second = 0;
+  int64_t slowest_remaining_bytes = 0;
+  for (auto it = received_slices.begin(); it != received_slices.end(); ++it) {
+    auto next = std::next(it);
+    int64_t range_end =
+        next == received_slices.end() ? total_bytes : next->offset;
+    int64_t start = it->offset + it->received_bytes;
+    int64_t remaining_bytes = range_end - start;
+    if (it->finished || remaining_bytes <= 0)
+      continue;
+    active_streams++;
+
+    auto rate = bytes_per_second.find(it->offset);
+    if (rate == bytes_per_second.end() ||
+        remaining_bytes / 2 < std::max<int64_t>(min_slice_size, 1)) {
+      continue;
+    }
+
+    // Prefer the slowest stream, and the one with the most data left among
+    // streams that are equally slow.
+    if (!split_offset || rate->second < slowest_bytes_per_second ||
+        (rate->second == slowest_bytes_per_second &&
+         remaining_bytes > slowest_remaining_bytes)) {
+      split_offset = start + remaining_bytes / 2;
+      slowest_bytes_per_second = rate->second;
+      slowest_remaining_bytes = remaining_bytes;
+    }
+  }
+
+  if (active_streams >= request_count)
+    return std::nullopt;
+  return split_offset;
+}
+
 int64_t GetMinSliceSizeConfig() {
   std::string finch_value = base::GetFieldTrialParamValueByFeature(
       features::kParallelDownloading, kMinSliceSizeFinchKey);
@@ -192,6 +234,15 @@ base::TimeDelta GetParallelRequestRemainingTimeConfig() {
              : base::Seconds(kDefaultRemainingTimeInSeconds);
 }
 
+base::TimeDelta GetSliceSplitIntervalConfig() {
+  std::string finch_value = base::GetFieldTrialParamValueByFeature(
+      features::kParallelDownloading, kSliceSplitIntervalFinchKey);
+  int64_t time_ms = 0;
+  return base::StringToInt64(finch_value, &time_ms) && time_ms > 0
+             ? base::Milliseconds(time_ms)
+             : base::TimeDelta();
+}
+
 int64_t GetMaxContiguousDataBlockSizeFromBeginning(
     const DownloadItem::ReceivedSlices& slices) {
   auto iter = slices.begin();
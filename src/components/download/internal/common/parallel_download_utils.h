@@ -5,6 +5,8 @@
 #ifndef COMPONENTS_DOWNLOAD_INTERNAL_COMMON_PARALLEL_DOWNLOAD_UTILS_H_
 #define COMPONENTS_DOWNLOAD_INTERNAL_COMMON_PARALLEL_DOWNLOAD_UTILS_H_
 
+#include <map>
+#include <optional>
 #include <vector>
 
 #include "components/download/public/common/download_export.h"
@@ -44,6 +46,20 @@ FindSlicesForRemainingContent(int64_t current_offset,
                               int request_count,
                               int64_t min_slice_size);
 
+// Returns the offset at which a new request should take over the second half
+// of the range left to the slowest stream, or nullopt if there is none to
+// split. `bytes_per_second` has the throughput of each stream, keyed by the
+// offset of the slice in `received_slices` that it writes. A stream's range
+// ends at the next slice, or at `total_bytes` if it writes the last slice.
+// Ranges are only split while fewer than `request_count` streams have data
+// left to download, and if each half has at least `min_slice_size` bytes.
+COMPONENTS_DOWNLOAD_EXPORT std::optional<int64_t> FindOffsetToSplitSlowestSlice(
+    const DownloadItem::ReceivedSlices& received_slices,
+    const std::map<int64_t, int64_t>& bytes_per_second,
+    int64_t total_bytes,
+    int request_count,
+    int64_t min_slice_size);
+
 // Finch configuration utilities.
 //
 // Get the minimum slice size to use parallel download from finch configuration.
@@ -62,6 +78,10 @@ COMPONENTS_DOWNLOAD_EXPORT base::TimeDelta GetParallelRequestDelayConfig();
 COMPONENTS_DOWNLOAD_EXPORT base::TimeDelta
 GetParallelRequestRemainingTimeConfig();
 
+// Get the interval at which to look for the range of a slow request to split,
+// or zero if ranges aren't split.
+COMPONENTS_DOWNLOAD_EXPORT base::TimeDelta GetSliceSplitIntervalConfig();
+
 // Given an ordered array of slices, get the maximum size of a contiguous data
 // block that starts from offset 0. If the first slice doesn't start from offset
 // 0, return 0.
@@ -313,6 +313,39 @@ TEST_F(ParallelDownloadUtilsTest, FindSlicesForRemainingContentMinSliceSize) {
   EXPECT_EQ(DownloadItem::ReceivedSlice(66, 0), slices[2]);
 }
 
+// Ensure the range left to the slowest stream is split in half.
+TEST_F(ParallelDownloadUtilsTest, FindOffsetToSplitSlowestSlice) {
+  // Three streams writing [0, 100), [100, 200) and [200, 300). The first one
+  // is done, the third one is slower than the second one.
+  DownloadItem::ReceivedSlices slices = {
+      DownloadItem::ReceivedSlice(0, 100, true),
+      DownloadItem::ReceivedSlice(100, 20),
+      DownloadItem::ReceivedSlice(200, 40)};
+  std::map<int64_t, int64_t> bytes_per_second = {{100, 20}, {200, 10}};
+  EXPECT_EQ(270, FindOffsetToSplitSlowestSlice(slices, bytes_per_second, 300,
+                                               3, 10));
+
+  // Enough streams are still downloading data.
+  EXPECT_FALSE(FindOffsetToSplitSlowestSlice(slices, bytes_per_second, 300, 2,
+                                             10));
+
+  // The slowest stream has too little data left, take over the other one.
+  EXPECT_EQ(160, FindOffsetToSplitSlowestSlice(slices, bytes_per_second, 300,
+                                               3, 31));
+  EXPECT_FALSE(FindOffsetToSplitSlowestSlice(slices, bytes_per_second, 300, 3,
+                                             41));
+
+  // A stream that has reached the next slice doesn't count as downloading.
+  slices[1].received_bytes = 100;
+  EXPECT_EQ(270, FindOffsetToSplitSlowestSlice(slices, bytes_per_second, 300,
+                                               2, 10));
+
+  // Streams without a measured throughput are never split.
+  bytes_per_second.erase(200);
+  EXPECT_FALSE(FindOffsetToSplitSlowestSlice(slices, bytes_per_second, 300, 2,
+                                             10));
+}
+
 TEST_F(ParallelDownloadUtilsTest, GetMaxContiguousDataBlockSizeFromBeginning) {
   std::vector<DownloadItem::ReceivedSlice> slices;
   slices.emplace_back(500, 500);
@@ -335,7 +368,8 @@ TEST_F(ParallelDownloadUtilsTest, FinchConfigEnabled) {
       {kMinSliceSizeFinchKey, "1234"},
       {kParallelRequestCountFinchKey, "6"},
       {kParallelRequestDelayFinchKey, "2000"},
-      {kParallelRequestRemainingTimeFinchKey, "3"}};
+      {kParallelRequestRemainingTimeFinchKey, "3"},
+      {kSliceSplitIntervalFinchKey, "500"}};
   feature_list.InitAndEnableFeatureWithParameters(
       features::kParallelDownloading, params);
   EXPECT_TRUE(IsParallelDownloadEnabled());
@@ -343,6 +377,7 @@ TEST_F(ParallelDownloadUtilsTest, FinchConfigEnabled) {
   EXPECT_EQ(GetParallelRequestCountConfig(), 6);
   EXPECT_EQ(GetParallelRequestDelayConfig(), base::Seconds(2));
   EXPECT_EQ(GetParallelRequestRemainingTimeConfig(), base::Seconds(3));
+  EXPECT_EQ(GetSliceSplitIntervalConfig(), base::Milliseconds(500));
 }
 
 // Test to verify the disable experiment group will actually disable the
@@ -389,6 +424,7 @@ TEST_F(ParallelDownloadUtilsTest, FinchConfigDisabledWithParameter) {
     // no impact.
     EXPECT_TRUE(IsParallelDownloadEnabled());
     EXPECT_EQ(GetMinSliceSizeConfig(), 4321);
+    EXPECT_TRUE(GetSliceSplitIntervalConfig().is_zero());
   }
 }
 
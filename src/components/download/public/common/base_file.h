@@ -10,8 +10,10 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/check.h"
+#include "base/containers/span.h"
 #include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/functional/callback.h"
@@ -127,6 +129,18 @@ class COMPONENTS_DOWNLOAD_EXPORT BaseFile {
                                           const char* data,
                                           size_t data_len);
 
+  // Write several chunks of data to the file, one after another starting at
+  // |offset|, using as few system calls as possible. Returns a
+  // DownloadInterruptReason indicating the result of the operation.
+  DownloadInterruptReason WriteDataToFile(
+      int64_t offset,
+      const std::vector<base::span<const char>>& buffers);
+
+  // Reserve disk space for a file of |total_bytes| bytes without changing its
+  // length, so that large files don't get fragmented as they are written.
+  // Returns false if no space is reserved, the file can still be written then.
+  bool Preallocate(int64_t total_bytes);
+
   // Validates that the content starting from |offset| matches that of |data|
   // with the given length.
   bool ValidateDataInFile(int64_t offset, const char* data, size_t data_len);
@@ -235,6 +249,14 @@ class COMPONENTS_DOWNLOAD_EXPORT BaseFile {
   DownloadInterruptReason MoveFileAndAdjustPermissions(
       const base::FilePath& new_path);
 
+  // Platform specific method that writes |buffers| to |file_| one after
+  // another starting at |offset|. |bytes_written| is set to the number of
+  // bytes written, including when the write fails partway.
+  DownloadInterruptReason WriteBuffersToFile(
+      int64_t offset,
+      const std::vector<base::span<const char>>& buffers,
+      int64_t* bytes_written);
+
   // Split out from CurrentSpeed to enable testing.
   int64_t CurrentSpeedAtTime(base::TimeTicks current_time) const;
 
@@ -248,6 +248,22 @@ class COMPONENTS_DOWNLOAD_EXPORT DownloadFileImpl : public DownloadFile {
     RenameCompletionCallback completion_callback;
   };
 
+  // Data read from a stream that only needs to be written to the file, queued
+  // so that consecutive buffers are written together.
+  struct PendingWrites {
+    PendingWrites();
+    ~PendingWrites();
+
+    // Offset in the file to write the data to.
+    int64_t offset = 0;
+    // Bytes written by the stream before the first queued buffer.
+    int64_t prev_bytes_written = 0;
+    // Total bytes queued.
+    size_t bytes = 0;
+    std::vector<scoped_refptr<net::IOBuffer>> buffers;
+    std::vector<base::span<const char>> data;
+  };
+
   // Rename file_ based on |parameters|.
   void RenameWithRetryInternal(std::unique_ptr<RenameParameters> parameters);
 
@@ -273,6 +289,17 @@ class COMPONENTS_DOWNLOAD_EXPORT DownloadFileImpl : public DownloadFile {
                              size_t* bytes_to_validate,
                              size_t* bytes_to_write);
 
+  // Write the data queued in |pending_writes| from |source_stream| to the file,
+  // and clear the queue.
+  DownloadInterruptReason FlushPendingWrites(SourceStream* source_stream,
+                                             PendingWrites* pending_writes);
+
+  // Update |received_slices_| after |source_stream| wrote |bytes_written| bytes
+  // to the file, having written |prev_bytes_written| bytes before.
+  void OnBytesWrittenToFile(SourceStream* source_stream,
+                            int64_t prev_bytes_written,
+                            size_t bytes_written);
+
   // Called when a new SourceStream object is added.
   void OnSourceStreamAdded(SourceStream* source_stream);
 
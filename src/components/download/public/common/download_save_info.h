@@ -74,6 +74,10 @@ struct COMPONENTS_DOWNLOAD_EXPORT DownloadSaveInfo {
   // used for validation purpose, and will not be written to disk.
   int64_t file_offset = -1;
 
+  // The expected size of the whole file, or 0 if unknown. Used to reserve disk
+  // space for the file before writing to it.
+  int64_t total_bytes = 0;
+
   // The state of the hash. If specified, this hash state must indicate the
   // state of the partial file for the first |offset| bytes.
   std::unique_ptr<crypto::SecureHash> hash_state;
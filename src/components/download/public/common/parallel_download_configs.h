@@ -29,6 +29,11 @@ constexpr char kParallelRequestDelayFinchKey[] = "parallel_request_delay";
 constexpr char kParallelRequestRemainingTimeFinchKey[] =
     "parallel_request_remaining_time";
 
+// Finch parameter key value for the interval in milliseconds at which the
+// throughput of the parallel requests is measured, to split the range left to
+// the slowest one when another request is done. Disabled if not positive.
+constexpr char kSliceSplitIntervalFinchKey[] = "slice_split_interval";
+
 }  //  namespace download
 
 #endif  // COMPONENTS_DOWNLOAD_PUBLIC_COMMON_PARALLEL_DOWNLOAD_CONFIGS_H_
@@ -4,6 +4,9 @@
 
 #include "components/favicon/core/favicon_backend.h"
 
+#include <map>
+#include <utility>
+
 #include "base/containers/contains.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
@@ -28,6 +31,14 @@ namespace {
 // The amount of time before we re-fetch the favicon.
 constexpr base::TimeDelta kFaviconRefetchDelta = base::Days(7);
 
+// The number of GetFaviconsForUrl() results kept by the cache. The history page
+// shows about a hundred favicons at once.
+constexpr size_t kCacheSize = 512;
+
+// Only the results for favicons up to this size are cached, which keeps the
+// cache to a few megabytes at most.
+constexpr int kMaxCachedEdgeSize = 64;
+
 bool IsFaviconBitmapExpired(base::Time last_updated) {
   return (base::Time::Now() - last_updated) > kFaviconRefetchDelta;
 }
@@ -53,6 +64,10 @@ bool AreIconTypesEquivalent(favicon_base::IconType type_a,
 
 }  // namespace
 
+BASE_FEATURE(kFaviconBackendCache,
+             "FaviconBackendCache",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 // static
 std::unique_ptr<FaviconBackend> FaviconBackend::Create(
     const base::FilePath& path,
@@ -85,6 +100,7 @@ void FaviconBackend::Commit() {
 
 void FaviconBackend::TrimMemory() {
   db_->TrimMemory();
+  cache_.Clear();
 }
 
 favicon_base::FaviconRawBitmapResult FaviconBackend::GetLargestFaviconForUrl(
@@ -181,16 +197,79 @@ FaviconBackend::GetFaviconsForUrl(const GURL& page_url,
                                   const std::vector<int>& desired_sizes,
                                   bool fallback_to_host) {
   TRACE_EVENT0("browser", "FaviconBackend::GetFaviconsForURL");
-  std::vector<favicon_base::FaviconRawBitmapResult> bitmap_results =
-      GetFaviconsFromDB(page_url, icon_types, desired_sizes, fallback_to_host);
+  const bool cacheable = IsCacheable(desired_sizes);
+  CacheKey key(page_url, icon_types, desired_sizes, fallback_to_host);
+  if (cacheable) {
+    const std::vector<favicon_base::FaviconRawBitmapResult>* cached_results =
+        FindInCache(key);
+    UMA_HISTOGRAM_BOOLEAN("Favicons.Backend.CacheHit", !!cached_results);
+    if (cached_results) {
+      return *cached_results;
+    }
+  }
 
-  if (desired_sizes.size() == 1 && !bitmap_results.empty()) {
-    bitmap_results.assign(1, favicon_base::ResizeFaviconBitmapResult(
-                                 desired_sizes[0], bitmap_results));
+  std::vector<IconMapping> icon_mappings;
+  db_->GetIconMappingsForPageURL(page_url, icon_types, &icon_mappings);
+  std::vector<favicon_base::FaviconRawBitmapResult> bitmap_results =
+      GetFaviconsFromDB(page_url, std::move(icon_mappings), icon_types,
+                        desired_sizes, fallback_to_host);
+  if (cacheable) {
+    cache_.Put(std::move(key), bitmap_results);
   }
   return bitmap_results;
 }
 
+std::vector<std::vector<favicon_base::FaviconRawBitmapResult>>
+FaviconBackend::GetFaviconsForUrls(const std::vector<GURL>& page_urls,
+                                   const favicon_base::IconTypeSet& icon_types,
+                                   const std::vector<int>& desired_sizes,
+                                   bool fallback_to_host) {
+  TRACE_EVENT0("browser", "FaviconBackend::GetFaviconsForURLs");
+  const bool cacheable = IsCacheable(desired_sizes);
+  std::vector<std::vector<favicon_base::FaviconRawBitmapResult>> results(
+      page_urls.size());
+
+  // Look up the mappings of the pages that aren't cached in one go.
+  std::vector<size_t> uncached_indices;
+  std::vector<GURL> uncached_page_urls;
+  for (size_t i = 0; i < page_urls.size(); ++i) {
+    if (cacheable) {
+      const std::vector<favicon_base::FaviconRawBitmapResult>* cached_results =
+          FindInCache(CacheKey(page_urls[i], icon_types, desired_sizes,
+                               fallback_to_host));
+      UMA_HISTOGRAM_BOOLEAN("Favicons.Backend.CacheHit", !!cached_results);
+      if (cached_results) {
+        results[i] = *cached_results;
+        continue;
+      }
+    }
+    uncached_indices.push_back(i);
+    uncached_page_urls.push_back(page_urls[i]);
+  }
+  if (uncached_page_urls.empty()) {
+    return results;
+  }
+
+  std::map<GURL, std::vector<IconMapping>> mappings_per_page =
+      db_->GetIconMappingsForPageURLs(uncached_page_urls, icon_types);
+  for (size_t i : uncached_indices) {
+    const GURL& page_url = page_urls[i];
+    std::vector<IconMapping> icon_mappings;
+    if (auto it = mappings_per_page.find(page_url);
+        it != mappings_per_page.end()) {
+      icon_mappings = it->second;
+    }
+    results[i] = GetFaviconsFromDB(page_url, std::move(icon_mappings),
+                                   icon_types, desired_sizes, fallback_to_host);
+    if (cacheable) {
+      cache_.Put(
+          CacheKey(page_url, icon_types, desired_sizes, fallback_to_host),
+          results[i]);
+    }
+  }
+  return results;
+}
+
 std::vector<favicon_base::FaviconRawBitmapResult>
 FaviconBackend::GetFaviconForId(favicon_base::FaviconID favicon_id,
                                 int desired_size) {
@@ -547,12 +626,40 @@ SetFaviconsResult FaviconBackend::SetFavicons(
 
 FaviconBackend::FaviconBackend(std::unique_ptr<FaviconDatabase> db,
                                FaviconBackendDelegate* delegate)
-    : db_(std::move(db)), delegate_(delegate) {
+    : db_(std::move(db)), delegate_(delegate), cache_(kCacheSize) {
   DCHECK(delegate);
   DCHECK(db_);
   db_->BeginTransaction();
 }
 
+// static
+bool FaviconBackend::IsCacheable(const std::vector<int>& desired_sizes) {
+  if (!base::FeatureList::IsEnabled(kFaviconBackendCache) ||
+      desired_sizes.empty()) {
+    return false;
+  }
+  // A size of 0 asks for the largest bitmap.
+  for (int desired_size : desired_sizes) {
+    if (desired_size <= 0 || desired_size > kMaxCachedEdgeSize) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const std::vector<favicon_base::FaviconRawBitmapResult>*
+FaviconBackend::FindInCache(const CacheKey& key) {
+  // Every write to the database may change the results, so the cache only
+  // lasts until the next one.
+  if (cache_change_count_ != db_->change_count()) {
+    cache_.Clear();
+    cache_change_count_ = db_->change_count();
+    return nullptr;
+  }
+  auto it = cache_.Get(key);
+  return it == cache_.end() ? nullptr : &it->second;
+}
+
 bool FaviconBackend::SetFaviconBitmaps(favicon_base::FaviconID icon_id,
                                        const std::vector<SkBitmap>& bitmaps,
                                        FaviconBitmapType type) {
@@ -627,13 +734,10 @@ bool FaviconBackend::IsFaviconBitmapDataEqual(
 
 std::vector<favicon_base::FaviconRawBitmapResult>
 FaviconBackend::GetFaviconsFromDB(const GURL& page_url,
+                                  std::vector<IconMapping> icon_mappings,
                                   const favicon_base::IconTypeSet& icon_types,
                                   const std::vector<int>& desired_sizes,
                                   bool fallback_to_host) {
-  // Get FaviconIDs for `page_url` and one of `icon_types`.
-  std::vector<IconMapping> icon_mappings;
-  db_->GetIconMappingsForPageURL(page_url, icon_types, &icon_mappings);
-
   if (icon_mappings.empty() && fallback_to_host &&
       page_url.SchemeIsHTTPOrHTTPS()) {
     // We didn't find any matches, and the caller requested falling back to the
@@ -653,7 +757,13 @@ FaviconBackend::GetFaviconsFromDB(const GURL& page_url,
   for (size_t i = 0; i < icon_mappings.size(); ++i)
     favicon_ids.push_back(icon_mappings[i].icon_id);
 
-  return GetFaviconBitmapResultsForBestMatch(favicon_ids, desired_sizes);
+  std::vector<favicon_base::FaviconRawBitmapResult> bitmap_results =
+      GetFaviconBitmapResultsForBestMatch(favicon_ids, desired_sizes);
+  if (desired_sizes.size() == 1 && !bitmap_results.empty()) {
+    bitmap_results.assign(1, favicon_base::ResizeFaviconBitmapResult(
+                                 desired_sizes[0], bitmap_results));
+  }
+  return bitmap_results;
 }
 
 std::vector<favicon_base::FaviconRawBitmapResult>
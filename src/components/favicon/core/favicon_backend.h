@@ -5,11 +5,16 @@
 #ifndef COMPONENTS_FAVICON_CORE_FAVICON_BACKEND_H_
 #define COMPONENTS_FAVICON_CORE_FAVICON_BACKEND_H_
 
+#include <stdint.h>
+
 #include <memory>
 #include <set>
+#include <tuple>
 #include <vector>
 
 #include "base/containers/flat_set.h"
+#include "base/containers/lru_cache.h"
+#include "base/feature_list.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/ref_counted.h"
 #include "components/favicon/core/favicon_types.h"
@@ -31,6 +36,10 @@ static const size_t kMaxFaviconBitmapsPerIconURL = 8;
 class FaviconBackendDelegate;
 class FaviconDatabase;
 
+// If enabled, FaviconBackend keeps the results of recent GetFaviconsForUrl()
+// calls for small sizes in memory, until the database changes.
+BASE_DECLARE_FEATURE(kFaviconBackendCache);
+
 // FaviconBackend owns and interacts with FaviconDatabase to maintain favicons.
 // FaviconDatabase provides a thin veneer on top of sqlite for reading/writing
 // favicons. FaviconBackend provides the logic for querying and updating the
@@ -69,6 +78,15 @@ class FaviconBackend {
       const std::vector<int>& desired_sizes,
       bool fallback_to_host);
 
+  // Like GetFaviconsForUrl() for each of `page_urls`, in the same order, but
+  // looks up the icon mappings of all the pages at once. For the many favicons
+  // of the history page and the like.
+  std::vector<std::vector<favicon_base::FaviconRawBitmapResult>>
+  GetFaviconsForUrls(const std::vector<GURL>& page_urls,
+                     const favicon_base::IconTypeSet& icon_types,
+                     const std::vector<int>& desired_sizes,
+                     bool fallback_to_host);
+
   // See function of same name in HistoryService for details.
   std::vector<favicon_base::FaviconRawBitmapResult> GetFaviconForId(
       favicon_base::FaviconID favicon_id,
@@ -143,9 +161,25 @@ class FaviconBackend {
   void TouchOnDemandFavicon(const GURL& icon_url);
 
  private:
+  // The arguments of a GetFaviconsForUrl() call: the page URL, icon types,
+  // desired sizes and whether to fall back to the host.
+  using CacheKey =
+      std::tuple<GURL, favicon_base::IconTypeSet, std::vector<int>, bool>;
+  using Cache =
+      base::LRUCache<CacheKey,
+                     std::vector<favicon_base::FaviconRawBitmapResult>>;
+
   FaviconBackend(std::unique_ptr<FaviconDatabase> db,
                  FaviconBackendDelegate* delegate);
 
+  // Returns whether the results for `desired_sizes` may be cached.
+  static bool IsCacheable(const std::vector<int>& desired_sizes);
+
+  // Returns the cached results for `key`, or null if there are none. Empties
+  // `cache_` first if the database changed since it was filled.
+  const std::vector<favicon_base::FaviconRawBitmapResult>* FindInCache(
+      const CacheKey& key);
+
   // Set the favicon bitmaps of `type` for `icon_id`.
   // For each entry in `bitmaps`, if a favicon bitmap already exists at the
   // entry's pixel size, replace the favicon bitmap's data with the entry's
@@ -174,8 +208,11 @@ class FaviconBackend {
   // used to search the favicon database if an exact match cannot be found.
   // See the comment for GetFaviconResultsForBestMatch() for more details on
   // how `favicon_bitmap_results` is constructed.
+  // `icon_mappings` are the mappings of `page_url` for `icon_types`. The
+  // results are resized as for GetFaviconsForUrl().
   std::vector<favicon_base::FaviconRawBitmapResult> GetFaviconsFromDB(
       const GURL& page_url,
+      std::vector<IconMapping> icon_mappings,
       const favicon_base::IconTypeSet& icon_types,
       const std::vector<int>& desired_sizes,
       bool fallback_to_host);
@@ -220,6 +257,11 @@ class FaviconBackend {
 
   std::unique_ptr<FaviconDatabase> db_;
   raw_ptr<FaviconBackendDelegate> delegate_;
+
+  // With `kFaviconBackendCache`, the results of recent GetFaviconsForUrl()
+  // calls, as of `cache_change_count_`, the change count of `db_`.
+  Cache cache_;
+  uint64_t cache_change_count_ = 0;
 };
 
 }  // namespace favicon
@@ -9,6 +9,8 @@
 
 #include "base/containers/lru_cache.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/task_environment.h"
 #include "components/favicon/core/favicon_backend_delegate.h"
 #include "components/favicon/core/favicon_database.h"
@@ -1288,4 +1290,93 @@ TEST_F(FaviconBackendTest, FaviconCacheWillNotLoadCrossOrigin) {
       backend_->db()->GetIconMappingsForPageURL(page_url2, &icon_mappings));
 }
 
+// Test that the results of GetFaviconsForUrl() are cached until the database
+// changes.
+TEST_F(FaviconBackendTest, GetFaviconsForUrlCached) {
+  base::test::ScopedFeatureList feature_list(kFaviconBackendCache);
+  base::HistogramTester histogram_tester;
+  GURL page_url("http://www.google.com");
+  GURL icon_url("http://www.google.com/favicon.ico");
+  SetFavicons({page_url}, IconType::kFavicon, icon_url,
+              {gfx::test::CreateBitmap(kSmallEdgeSize, SK_ColorBLUE)});
+
+  std::vector<favicon_base::FaviconRawBitmapResult> results =
+      backend_->GetFaviconsForUrl(page_url, {IconType::kFavicon},
+                                  {kSmallEdgeSize},
+                                  /*fallback_to_host=*/false);
+  ASSERT_EQ(1u, results.size());
+  EXPECT_TRUE(BitmapColorEqual(SK_ColorBLUE, results[0].bitmap_data));
+  results = backend_->GetFaviconsForUrl(page_url, {IconType::kFavicon},
+                                        {kSmallEdgeSize},
+                                        /*fallback_to_host=*/false);
+  ASSERT_EQ(1u, results.size());
+  EXPECT_TRUE(BitmapColorEqual(SK_ColorBLUE, results[0].bitmap_data));
+  histogram_tester.ExpectBucketCount("Favicons.Backend.CacheHit", false, 1);
+  histogram_tester.ExpectBucketCount("Favicons.Backend.CacheHit", true, 1);
+
+  // Changing the favicon invalidates the cached results.
+  SetFavicons({page_url}, IconType::kFavicon, icon_url,
+              {gfx::test::CreateBitmap(kSmallEdgeSize, SK_ColorRED)});
+  results = backend_->GetFaviconsForUrl(page_url, {IconType::kFavicon},
+                                        {kSmallEdgeSize},
+                                        /*fallback_to_host=*/false);
+  ASSERT_EQ(1u, results.size());
+  EXPECT_TRUE(BitmapColorEqual(SK_ColorRED, results[0].bitmap_data));
+  histogram_tester.ExpectBucketCount("Favicons.Backend.CacheHit", false, 2);
+
+  // So does deleting it through the database.
+  backend_->db()->DeleteIconMappings(page_url);
+  EXPECT_TRUE(backend_
+                  ->GetFaviconsForUrl(page_url, {IconType::kFavicon},
+                                      {kSmallEdgeSize},
+                                      /*fallback_to_host=*/false)
+                  .empty());
+
+  // The largest size isn't cached.
+  backend_->GetFaviconsForUrl(page_url, {IconType::kFavicon}, {0},
+                              /*fallback_to_host=*/false);
+  histogram_tester.ExpectTotalCount("Favicons.Backend.CacheHit", 4);
+}
+
+// Test that GetFaviconsForUrls() returns the same results as
+// GetFaviconsForUrl() for each page, in order.
+TEST_F(FaviconBackendTest, GetFaviconsForUrls) {
+  GURL page_url1("http://www.google.com/1");
+  GURL page_url2("http://www.google.com/2");
+  GURL page_url3("http://www.google.ca");
+  GURL icon_url1("http://www.google.com/favicon.ico");
+  GURL icon_url2("http://www.google.com/touch.png");
+  SetFavicons({page_url1}, IconType::kFavicon, icon_url1,
+              {gfx::test::CreateBitmap(kSmallEdgeSize, SK_ColorBLUE)});
+  SetFavicons({page_url2}, IconType::kTouchIcon, icon_url2,
+              {gfx::test::CreateBitmap(kLargeEdgeSize, SK_ColorRED)});
+
+  std::vector<GURL> page_urls = {page_url3, page_url2, page_url1, page_url2};
+  std::vector<std::vector<favicon_base::FaviconRawBitmapResult>> results =
+      backend_->GetFaviconsForUrls(
+          page_urls, {IconType::kFavicon, IconType::kTouchIcon},
+          {kSmallEdgeSize}, /*fallback_to_host=*/false);
+  ASSERT_EQ(4u, results.size());
+  EXPECT_TRUE(results[0].empty());
+  ASSERT_EQ(1u, results[1].size());
+  EXPECT_EQ(icon_url2, results[1][0].icon_url);
+  EXPECT_EQ(kSmallSize, results[1][0].pixel_size);
+  ASSERT_EQ(1u, results[2].size());
+  EXPECT_EQ(icon_url1, results[2][0].icon_url);
+  EXPECT_TRUE(BitmapColorEqual(SK_ColorBLUE, results[2][0].bitmap_data));
+  ASSERT_EQ(1u, results[3].size());
+  EXPECT_EQ(icon_url2, results[3][0].icon_url);
+
+  // Only the requested icon types are returned, and the host fallback applies
+  // to each page.
+  results = backend_->GetFaviconsForUrls(
+      {page_url2, GURL("http://www.google.com/3")}, {IconType::kFavicon},
+      {kSmallEdgeSize}, /*fallback_to_host=*/true);
+  ASSERT_EQ(2u, results.size());
+  ASSERT_EQ(1u, results[0].size());
+  EXPECT_EQ(icon_url1, results[0][0].icon_url);
+  ASSERT_EQ(1u, results[1].size());
+  EXPECT_EQ(icon_url1, results[1][0].icon_url);
+}
+
 }  // namespace favicon
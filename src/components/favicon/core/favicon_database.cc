@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <bit>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
@@ -18,7 +19,9 @@
 #include "base/logging.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
 #include "base/rand_util.h"
+#include "base/strings/strcat.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/time/time.h"
@@ -287,6 +290,7 @@ void FaviconDatabase::CommitTransaction() {
 }
 
 void FaviconDatabase::RollbackTransaction() {
+  ++change_count_;
   db_.RollbackTransaction();
 }
 
@@ -427,6 +431,7 @@ FaviconBitmapID FaviconDatabase::AddFaviconBitmap(
     FaviconBitmapType type,
     base::Time time,
     const gfx::Size& pixel_size) {
+  ++change_count_;
   DCHECK(icon_id);
 
   sql::Statement statement(db_.GetCachedStatement(
@@ -463,6 +468,7 @@ bool FaviconDatabase::SetFaviconBitmap(
     FaviconBitmapID bitmap_id,
     scoped_refptr<base::RefCountedMemory> bitmap_data,
     base::Time time) {
+  ++change_count_;
   DCHECK(bitmap_id);
   // By updating last_updated timestamp, we assume the icon is of type ON_VISIT.
   // If it is ON_DEMAND, reset last_requested to 0 and thus silently change the
@@ -485,6 +491,7 @@ bool FaviconDatabase::SetFaviconBitmap(
 
 bool FaviconDatabase::SetFaviconBitmapLastUpdateTime(FaviconBitmapID bitmap_id,
                                                      base::Time time) {
+  ++change_count_;
   DCHECK(bitmap_id);
   // By updating last_updated timestamp, we assume the icon is of type ON_VISIT.
   // If it is ON_DEMAND, reset last_requested to 0 and thus silently change the
@@ -501,6 +508,7 @@ bool FaviconDatabase::SetFaviconBitmapLastUpdateTime(FaviconBitmapID bitmap_id,
 
 bool FaviconDatabase::SetFaviconsOutOfDateBetween(base::Time begin,
                                                   base::Time end) {
+  ++change_count_;
   if (end.is_null())
     end = base::Time::Max();
   sql::Statement statement(
@@ -514,6 +522,7 @@ bool FaviconDatabase::SetFaviconsOutOfDateBetween(base::Time begin,
 
 bool FaviconDatabase::TouchOnDemandFavicon(const GURL& icon_url,
                                            base::Time time) {
+  ++change_count_;
   // Look up the icon ids for the url.
   sql::Statement id_statement(db_.GetCachedStatement(
       SQL_FROM_HERE, "SELECT id FROM favicons WHERE url=?"));
@@ -542,6 +551,7 @@ bool FaviconDatabase::TouchOnDemandFavicon(const GURL& icon_url,
 }
 
 bool FaviconDatabase::DeleteFaviconBitmap(FaviconBitmapID bitmap_id) {
+  ++change_count_;
   sql::Statement statement(db_.GetCachedStatement(
       SQL_FROM_HERE, "DELETE FROM favicon_bitmaps WHERE id=?"));
   statement.BindInt64(0, bitmap_id);
@@ -549,6 +559,7 @@ bool FaviconDatabase::DeleteFaviconBitmap(FaviconBitmapID bitmap_id) {
 }
 
 bool FaviconDatabase::SetFaviconOutOfDate(favicon_base::FaviconID icon_id) {
+  ++change_count_;
   sql::Statement statement(db_.GetCachedStatement(
       SQL_FROM_HERE,
       "UPDATE favicon_bitmaps SET last_updated=? WHERE icon_id=?"));
@@ -641,6 +652,7 @@ bool FaviconDatabase::GetFaviconHeader(favicon_base::FaviconID icon_id,
 favicon_base::FaviconID FaviconDatabase::AddFavicon(
     const GURL& icon_url,
     favicon_base::IconType icon_type) {
+  ++change_count_;
   sql::Statement statement(db_.GetCachedStatement(
       SQL_FROM_HERE, "INSERT INTO favicons (url, icon_type) VALUES (?, ?)"));
   statement.BindString(0, database_utils::GurlToDatabaseUrl(icon_url));
@@ -658,6 +670,7 @@ favicon_base::FaviconID FaviconDatabase::AddFavicon(
     FaviconBitmapType type,
     base::Time time,
     const gfx::Size& pixel_size) {
+  ++change_count_;
   favicon_base::FaviconID icon_id = AddFavicon(icon_url, icon_type);
   if (!icon_id || !AddFaviconBitmap(icon_id, icon_data, type, time, pixel_size))
     return 0;
@@ -666,6 +679,7 @@ favicon_base::FaviconID FaviconDatabase::AddFavicon(
 }
 
 bool FaviconDatabase::DeleteFavicon(favicon_base::FaviconID id) {
+  ++change_count_;
   sql::Statement statement;
   statement.Assign(db_.GetCachedStatement(SQL_FROM_HERE,
                                           "DELETE FROM favicons WHERE id = ?"));
@@ -727,6 +741,68 @@ bool FaviconDatabase::GetIconMappingsForPageURL(
   return result;
 }
 
+std::map<GURL, std::vector<IconMapping>>
+FaviconDatabase::GetIconMappingsForPageURLs(
+    const std::vector<GURL>& page_urls,
+    const favicon_base::IconTypeSet& required_icon_types) {
+  // The pages are looked up this many at a time, with a cached statement. The
+  // last batch is padded with its last page.
+  constexpr size_t kPagesPerQuery = 32;
+  static const base::NoDestructor<std::string> kSql([] {
+    std::vector<std::string_view> placeholders(kPagesPerQuery, "?");
+    return base::StrCat({"SELECT icon_mapping.id, icon_mapping.icon_id, "
+                         "favicons.icon_type, favicons.url, "
+                         "icon_mapping.page_url "
+                         "FROM icon_mapping "
+                         "INNER JOIN favicons "
+                         "ON icon_mapping.icon_id = favicons.id "
+                         "WHERE icon_mapping.page_url IN (",
+                         base::JoinString(placeholders, ","),
+                         ") "
+                         "ORDER BY favicons.icon_type DESC"});
+  }());
+
+  // The database URLs of the pages, and the pages with each.
+  std::map<std::string, std::vector<GURL>> pages_per_database_url;
+  for (const GURL& page_url : page_urls) {
+    pages_per_database_url[database_utils::GurlToDatabaseUrl(page_url)]
+        .push_back(page_url);
+  }
+
+  std::map<GURL, std::vector<IconMapping>> mappings_per_page;
+  auto it = pages_per_database_url.begin();
+  while (it != pages_per_database_url.end()) {
+    sql::Statement statement(
+        db_.GetCachedStatement(SQL_FROM_HERE, kSql->c_str()));
+    const std::string* last_database_url = nullptr;
+    for (size_t i = 0; i < kPagesPerQuery; ++i) {
+      if (it != pages_per_database_url.end()) {
+        last_database_url = &it->first;
+        ++it;
+      }
+      statement.BindString(i, *last_database_url);
+    }
+
+    while (statement.Step()) {
+      const favicon_base::IconType icon_type =
+          FaviconDatabase::FromPersistedIconType(statement.ColumnInt(2));
+      if (required_icon_types.count(icon_type) == 0) {
+        continue;
+      }
+      const auto pages = pages_per_database_url.find(statement.ColumnString(4));
+      if (pages == pages_per_database_url.end()) {
+        continue;
+      }
+      for (const GURL& page_url : pages->second) {
+        IconMapping icon_mapping;
+        FillIconMapping(page_url, statement, &icon_mapping);
+        mappings_per_page[page_url].push_back(std::move(icon_mapping));
+      }
+    }
+  }
+  return mappings_per_page;
+}
+
 std::optional<GURL> FaviconDatabase::FindFirstPageURLForHost(
     const GURL& url,
     const favicon_base::IconTypeSet& required_icon_types) {
@@ -767,6 +843,7 @@ std::optional<GURL> FaviconDatabase::FindFirstPageURLForHost(
 
 IconMappingID FaviconDatabase::AddIconMapping(const GURL& page_url,
                                               favicon_base::FaviconID icon_id) {
+  ++change_count_;
   static const char kSql[] =
       "INSERT INTO icon_mapping (page_url, icon_id) VALUES (?, ?)";
   sql::Statement statement(db_.GetCachedStatement(SQL_FROM_HERE, kSql));
@@ -780,6 +857,7 @@ IconMappingID FaviconDatabase::AddIconMapping(const GURL& page_url,
 }
 
 bool FaviconDatabase::DeleteIconMappings(const GURL& page_url) {
+  ++change_count_;
   sql::Statement statement(db_.GetCachedStatement(
       SQL_FROM_HERE, "DELETE FROM icon_mapping WHERE page_url = ?"));
   statement.BindString(0, database_utils::GurlToDatabaseUrl(page_url));
@@ -789,6 +867,7 @@ bool FaviconDatabase::DeleteIconMappings(const GURL& page_url) {
 
 bool FaviconDatabase::DeleteIconMappingsForFaviconId(
     favicon_base::FaviconID id) {
+  ++change_count_;
   // This is called rarely during history expiration cleanup and hence not
   // worth caching.
   sql::Statement statement(
@@ -798,6 +877,7 @@ bool FaviconDatabase::DeleteIconMappingsForFaviconId(
 }
 
 bool FaviconDatabase::DeleteIconMapping(IconMappingID mapping_id) {
+  ++change_count_;
   sql::Statement statement(db_.GetCachedStatement(
       SQL_FROM_HERE, "DELETE FROM icon_mapping WHERE id=?"));
   statement.BindInt64(0, mapping_id);
@@ -848,6 +928,7 @@ bool FaviconDatabase::InitIconMappingEnumerator(
 
 bool FaviconDatabase::RetainDataForPageUrls(
     const std::vector<GURL>& urls_to_keep) {
+  ++change_count_;
   sql::Transaction transaction(&db_);
   if (!transaction.Begin())
     return false;
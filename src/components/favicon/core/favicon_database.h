@@ -5,6 +5,9 @@
 #ifndef COMPONENTS_FAVICON_CORE_FAVICON_DATABASE_H_
 #define COMPONENTS_FAVICON_CORE_FAVICON_DATABASE_H_
 
+#include <stdint.h>
+
+#include <map>
 #include <optional>
 #include <vector>
 
@@ -61,6 +64,10 @@ class FaviconDatabase {
   // Release all non-essential memory associated with this database connection.
   void TrimMemory();
 
+  // Changes whenever the database may have changed, including by rolling back a
+  // transaction. Used to tell whether data read before is still current.
+  uint64_t change_count() const { return change_count_; }
+
   // Get all on-demand favicon bitmaps that have been last requested prior to
   // `threshold`.
   std::map<favicon_base::FaviconID, IconMappingsForExpiry>
@@ -212,6 +219,13 @@ class FaviconDatabase {
   bool GetIconMappingsForPageURL(const GURL& page_url,
                                  std::vector<IconMapping>* mapping_data);
 
+  // Returns the icon mappings of each of `page_urls` with one of
+  // `required_icon_types`, like the function above, with a handful of queries
+  // instead of one per page. Pages without such mappings have no entry.
+  std::map<GURL, std::vector<IconMapping>> GetIconMappingsForPageURLs(
+      const std::vector<GURL>& page_urls,
+      const favicon_base::IconTypeSet& required_icon_types);
+
   // Given `url`, returns the `page_url` page mapped to an icon with
   // `required_icon_types`, where `page_url` has host = url.host(). This allows
   // for icons to be retrieved when a full URL is not available. For example,
@@ -326,6 +340,9 @@ class FaviconDatabase {
 
   sql::Database db_;
   sql::MetaTable meta_table_;
+
+  // The number of calls to the functions that may change the database.
+  uint64_t change_count_ = 0;
 };
 
 }  // namespace favicon
@@ -157,12 +157,20 @@ void StreamModel::Update(
       update_request->stream_data.set_root_event_id(
           stream_data_.root_event_id());
 
-      // Note: We might be overwriting some shared-states unnecessarily.
       StoreUpdate store_update;
       store_update.stream_type = stream_type_;
       store_update.overwrite_stream_data = has_clear_all;
       store_update.update_request =
           std::make_unique<StreamModelUpdateRequest>(*update_request);
+      if (!has_clear_all) {
+        // Only write the shared states that are new. The model keeps the
+        // first version of a shared state, which is already stored.
+        std::erase_if(store_update.update_request->shared_states,
+                      [&](const feedstore::StreamSharedState& shared_state) {
+                        return shared_states_.contains(
+                            ContentIdString(shared_state.content_id()));
+                      });
+      }
       store_update.sequence_number = next_structure_sequence_number_++;
       store_observer_->OnStoreChange(std::move(store_update));
       break;
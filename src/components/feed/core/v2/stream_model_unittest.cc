@@ -13,6 +13,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "components/feed/core/proto/v2/store.pb.h"
 #include "components/feed/core/proto/v2/wire/content_id.pb.h"
+#include "components/feed/core/v2/proto_util.h"
 #include "components/feed/core/v2/protocol_translator.h"
 #include "components/feed/core/v2/test/stream_builder.h"
 #include "components/feed/core/v2/types.h"
@@ -468,6 +469,33 @@ TEST(StreamModelTest, SharedStateUpdatesKeepOriginal) {
                    ->update_request->stream_data.shared_state_ids_size());
 }
 
+TEST(StreamModelTest, LoadMoreStoresOnlyNewSharedStates) {
+  StreamModel::Context model_context;
+  StreamModel model(&model_context, LoggingParameters());
+  TestStoreObserver store_observer(&model);
+  model.Update(MakeTypicalInitialModelState());
+  store_observer.Clear();
+
+  // The next page repeats the initial shared state.
+  std::unique_ptr<StreamModelUpdateRequest> next_page =
+      MakeTypicalNextPageState(
+          2, kTestTimeEpoch, true, true, true,
+          StreamModelUpdateRequest::Source::kNetworkLoadMore);
+  next_page->shared_states.push_back(MakeSharedState(0));
+  const size_t next_page_shared_states = next_page->shared_states.size();
+  model.Update(std::move(next_page));
+
+  ASSERT_TRUE(store_observer.GetUpdate());
+  const std::vector<feedstore::StreamSharedState>& stored_shared_states =
+      store_observer.GetUpdate()->update_request->shared_states;
+  EXPECT_EQ(next_page_shared_states - 1, stored_shared_states.size());
+  for (const feedstore::StreamSharedState& shared_state :
+       stored_shared_states) {
+    EXPECT_FALSE(Equal(MakeSharedState(0).content_id(),
+                       shared_state.content_id()));
+  }
+}
+
 TEST(StreamModelTest, ClearAllErasesSharedStates) {
   StreamModel::Context model_context;
   StreamModel model(&model_context, LoggingParameters());
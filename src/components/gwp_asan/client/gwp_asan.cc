@@ -313,10 +313,15 @@ GWP_ASAN_EXPORT std::optional<AllocatorSettings> GetAllocatorSettingsImpl(
   if (!alloc_sampling_freq)
     return std::nullopt;
 
-  return AllocatorSettings{static_cast<size_t>(max_allocations.value()),
-                           static_cast<size_t>(max_metadata.value()),
-                           static_cast<size_t>(total_pages.value()),
-                           alloc_sampling_freq};
+  // Adaptive sampling is off unless a positive budget is configured.
+  const int target_samples_per_second = GetFieldTrialParamByFeatureAsInt(
+      feature, "TargetSamplesPerSecond", 0);
+
+  return AllocatorSettings{
+      static_cast<size_t>(max_allocations.value()),
+      static_cast<size_t>(max_metadata.value()),
+      static_cast<size_t>(total_pages.value()), alloc_sampling_freq,
+      static_cast<size_t>(std::max(target_samples_per_second, 0))};
 }
 
 // Exported for testing.
@@ -21,6 +21,8 @@ struct AllocatorSettings {
   size_t num_metadata;
   size_t total_pages;
   size_t sampling_frequency;
+  // Sampling is adjusted towards this many samples per second if non-zero.
+  size_t target_samples_per_second = 0;
 };
 
 }  // namespace internal
@@ -294,7 +294,8 @@ void InstallMallocHooks(const AllocatorSettings& settings,
   gpa = new GuardedPageAllocator();
   gpa->Init(settings, std::move(callback), false);
   malloc_crash_key.Set(gpa->GetCrashKey());
-  sampling_state.Init(settings.sampling_frequency);
+  sampling_state.Init(settings.sampling_frequency,
+                      settings.target_samples_per_second);
   allocator_shim::InsertAllocatorDispatch(&g_allocator_dispatch);
 }
 
@@ -81,7 +81,8 @@ void InstallPartitionAllocHooks(
   gpa = new GuardedPageAllocator();
   gpa->Init(settings, std::move(callback), true);
   pa_crash_key.Set(gpa->GetCrashKey());
-  sampling_state.Init(settings.sampling_frequency);
+  sampling_state.Init(settings.sampling_frequency,
+                      settings.target_samples_per_second);
   // TODO(vtsyrklevich): Allow SetOverrideHooks to be passed in so we can hook
   // PDFium's PartitionAlloc fork.
   partition_alloc::PartitionAllocHooks::SetOverrideHooks(
@@ -6,11 +6,16 @@
 #define COMPONENTS_GWP_ASAN_CLIENT_SAMPLING_STATE_H_
 
 #include <stddef.h>  // for size_t
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <random>
 
 #include "base/check_op.h"
 #include "base/compiler_specific.h"
+#include "base/time/time.h"
 #include "components/gwp_asan/client/thread_local_random_bit_generator.h"
 #include "components/gwp_asan/client/thread_local_state.h"
 #include "third_party/boringssl/src/include/openssl/rand.h"
@@ -28,6 +33,12 @@ enum ParentAllocator {
 // Class that encapsulates the current sampling state. Sampling is performed
 // using a counter stored in thread-local storage.
 //
+// If a target number of samples per second is given, the sampling probability
+// is adjusted once per second towards that rate on the slow path, which only
+// runs once per sample. To keep the cost bounded under allocation bursts it is
+// never raised above 4x the initial probability, and each adjustment at most
+// halves or doubles it.
+//
 // This class is templated so that a thread-local global it contains is not
 // shared between different instances (used by shims for different allocators.)
 template <ParentAllocator PA>
@@ -37,9 +48,14 @@ class SamplingState : ThreadLocalState<SamplingState<PA>> {
 
   constexpr SamplingState() = default;
 
-  void Init(size_t sampling_frequency) {
+  // If |target_samples_per_second| is 0 the sampling probability is fixed.
+  void Init(size_t sampling_frequency, size_t target_samples_per_second = 0) {
     DCHECK_GT(sampling_frequency, 0U);
-    sampling_probability_ = 1.0 / sampling_frequency;
+    initial_sampling_probability_ = 1.0 / sampling_frequency;
+    sampling_probability_.store(initial_sampling_probability_,
+                                std::memory_order_relaxed);
+    target_samples_per_second_ = target_samples_per_second;
+    interval_start_us_.store(NowInMicroseconds(), std::memory_order_relaxed);
 
     ThreadLocalRandomBitGenerator::InitIfNeeded();
     TLS::InitIfNeeded();
@@ -67,12 +83,63 @@ class SamplingState : ThreadLocalState<SamplingState<PA>> {
   // Sample an allocation on every average one out of every
   // |sampling_frequency_| allocations.
   size_t NextSample() {
+    if (target_samples_per_second_) {
+      MaybeAdjustSamplingProbability();
+    }
     ThreadLocalRandomBitGenerator generator;
-    std::geometric_distribution<size_t> distribution(sampling_probability_);
+    std::geometric_distribution<size_t> distribution(
+        sampling_probability_.load(std::memory_order_relaxed));
     return distribution(generator) + 1;
   }
 
-  double sampling_probability_ = 0;
+  // Counts a sample, and once per adjustment interval scales the sampling
+  // probability by the ratio of the target to the observed sample rate.
+  void MaybeAdjustSamplingProbability() {
+    samples_in_interval_.fetch_add(1, std::memory_order_relaxed);
+    const int64_t now = NowInMicroseconds();
+    int64_t interval_start = interval_start_us_.load(std::memory_order_relaxed);
+    const int64_t elapsed = now - interval_start;
+    if (elapsed < kAdjustmentIntervalUs) {
+      return;
+    }
+    // Only one thread adjusts per interval.
+    if (!interval_start_us_.compare_exchange_strong(
+            interval_start, now, std::memory_order_relaxed)) {
+      return;
+    }
+    const size_t samples =
+        samples_in_interval_.exchange(0, std::memory_order_relaxed);
+    const double samples_per_second =
+        samples * static_cast<double>(base::Time::kMicrosecondsPerSecond) /
+        elapsed;
+    const double scale = std::clamp(
+        target_samples_per_second_ / samples_per_second, 1.0 / kMaxStep,
+        kMaxStep);
+    const double probability = std::clamp(
+        sampling_probability_.load(std::memory_order_relaxed) * scale,
+        initial_sampling_probability_ / kMaxDecrease,
+        std::min(initial_sampling_probability_ * kMaxIncrease, 1.0));
+    sampling_probability_.store(probability, std::memory_order_relaxed);
+  }
+
+  static int64_t NowInMicroseconds() {
+    return (base::TimeTicks::Now() - base::TimeTicks()).InMicroseconds();
+  }
+
+  static constexpr int64_t kAdjustmentIntervalUs =
+      base::Time::kMicrosecondsPerSecond;
+  // Bounds on a single adjustment, and on the overall change from the initial
+  // sampling probability.
+  static constexpr double kMaxStep = 2;
+  static constexpr double kMaxIncrease = 4;
+  static constexpr double kMaxDecrease = 1000;
+
+  double initial_sampling_probability_ = 0;
+  std::atomic<double> sampling_probability_{0};
+
+  size_t target_samples_per_second_ = 0;
+  std::atomic<int64_t> interval_start_us_{0};
+  std::atomic<size_t> samples_in_interval_{0};
 };
 
 }  // namespace internal
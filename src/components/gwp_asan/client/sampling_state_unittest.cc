@@ -0,0 +1,71 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/gwp_asan/client/sampling_state.h"
+
+#include "base/time/time.h"
+#include "base/time/time_override.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace gwp_asan::internal {
+namespace {
+
+constexpr size_t kSamplingFrequency = 10;
+
+base::TimeTicks g_now = base::TimeTicks() + base::Seconds(1);
+
+base::TimeTicks FakeTimeTicksNow() {
+  return g_now;
+}
+
+// Makes `allocations_per_second` allocations in each of `seconds` seconds of
+// mock time, and returns the number sampled in the last second.
+size_t RunAllocations(SamplingState<MALLOC>& state,
+                      size_t allocations_per_second,
+                      int seconds) {
+  size_t samples = 0;
+  for (int i = 0; i < seconds; ++i) {
+    samples = 0;
+    for (size_t j = 0; j < allocations_per_second; ++j) {
+      if (state.Sample()) {
+        ++samples;
+      }
+    }
+    g_now += base::Seconds(1);
+  }
+  return samples;
+}
+
+class SamplingStateTest : public testing::Test {
+ protected:
+  base::subtle::ScopedTimeClockOverrides time_override_{
+      nullptr, &FakeTimeTicksNow, nullptr};
+};
+
+TEST_F(SamplingStateTest, FixedProbability) {
+  SamplingState<MALLOC> state;
+  state.Init(kSamplingFrequency);
+  // About 10,000 samples per second, unaffected by the rate.
+  EXPECT_GT(RunAllocations(state, 100'000, 20), 9'000u);
+}
+
+TEST_F(SamplingStateTest, AdaptiveSamplingReducesRate) {
+  SamplingState<MALLOC> state;
+  state.Init(kSamplingFrequency, /*target_samples_per_second=*/100);
+  const size_t samples = RunAllocations(state, 100'000, 20);
+  EXPECT_GT(samples, 0u);
+  EXPECT_LT(samples, 500u);
+}
+
+TEST_F(SamplingStateTest, AdaptiveSamplingIncreaseIsBounded) {
+  SamplingState<MALLOC> state;
+  state.Init(kSamplingFrequency, /*target_samples_per_second=*/10'000);
+  // 100 samples per second at the initial probability, and at most 4x that.
+  const size_t samples = RunAllocations(state, 1'000, 20);
+  EXPECT_GT(samples, 250u);
+  EXPECT_LT(samples, 550u);
+}
+
+}  // namespace
+}  // namespace gwp_asan::internal
@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -18,10 +19,12 @@
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
 #include "base/location.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/ranges/algorithm.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/timer/elapsed_timer.h"
 #include "build/build_config.h"
 #include "components/favicon/core/favicon_database.h"
 #include "components/history/core/browser/features.h"
@@ -652,8 +655,11 @@ void ExpireHistoryBackend::DoExpireIteration() {
   }
 
   const ExpiringVisitsReader* reader = work_queue_.front();
-  bool more_to_expire = ExpireSomeOldHistory(
-      GetCurrentExpirationTime(), reader, kNumExpirePerIteration);
+  bool more_to_expire =
+      base::FeatureList::IsEnabled(kTimeSlicedExpiration)
+          ? ExpireOldHistorySlice(GetCurrentExpirationTime(), reader)
+          : ExpireSomeOldHistory(GetCurrentExpirationTime(), reader,
+                                 kNumExpirePerIteration);
 
   work_queue_.pop();
   if (more_to_expire) {
@@ -700,6 +706,25 @@ bool ExpireHistoryBackend::ExpireSomeOldHistory(
   return more_to_expire;
 }
 
+bool ExpireHistoryBackend::ExpireOldHistorySlice(
+    base::Time end_time,
+    const ExpiringVisitsReader* reader) {
+  const int batch_size = std::max(1, kTimeSlicedExpirationBatchSize.Get());
+  const base::TimeDelta budget = kTimeSlicedExpirationBudget.Get();
+
+  // The readers only return the oldest visits left, so the next batch, or the
+  // next slice, picks up after the visits deleted so far, even after a restart.
+  base::ElapsedTimer timer;
+  bool more_to_expire;
+  do {
+    more_to_expire = ExpireSomeOldHistory(end_time, reader, batch_size);
+  } while (more_to_expire && timer.Elapsed() < budget);
+
+  base::UmaHistogramTimes("History.ExpireOldHistorySliceDuration",
+                          timer.Elapsed());
+  return more_to_expire;
+}
+
 void ExpireHistoryBackend::ExpireOldSegmentData(base::Time end_time) {
   if (main_db_) {
     main_db_->DeleteSegmentDataOlderThan(end_time);
@@ -124,6 +124,7 @@ class ExpireHistoryBackend {
   FRIEND_TEST_ALL_PREFIXES(HistoryBackendTest, ExpireSegmentData);
   FRIEND_TEST_ALL_PREFIXES(ExpireHistoryTest, DeleteFaviconsIfPossible);
   FRIEND_TEST_ALL_PREFIXES(ExpireHistoryTest, ExpireSomeOldHistory);
+  FRIEND_TEST_ALL_PREFIXES(ExpireHistoryTest, ExpireOldHistorySlice);
   FRIEND_TEST_ALL_PREFIXES(ExpireHistoryTest, ExpiringVisitsReader);
   FRIEND_TEST_ALL_PREFIXES(ExpireHistoryTest, ExpireSomeOldHistoryWithSource);
   FRIEND_TEST_ALL_PREFIXES(ExpireHistoryTest,
@@ -263,6 +264,13 @@ class ExpireHistoryBackend {
                              const ExpiringVisitsReader* reader,
                              int max_visits);
 
+  // Expires the visits older than `end_time` from `reader` in batches, until
+  // either there are none left or `kTimeSlicedExpirationBudget` has elapsed,
+  // and records how long that took. The return value is as for
+  // ExpireSomeOldHistory(). The visits left are expired by the next slice.
+  bool ExpireOldHistorySlice(base::Time end_time,
+                             const ExpiringVisitsReader* reader);
+
   // Expire segment data older than `end_time`.
   void ExpireOldSegmentData(base::Time end_time);
 
@@ -20,9 +20,12 @@
 #include "base/scoped_observation.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/current_thread.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/task_environment.h"
 #include "base/time/time.h"
 #include "components/favicon/core/favicon_database.h"
+#include "components/history/core/browser/features.h"
 #include "components/history/core/browser/history_backend_client.h"
 #include "components/history/core/browser/history_backend_notifier.h"
 #include "components/history/core/browser/history_constants.h"
@@ -1147,6 +1150,43 @@ TEST_F(ExpireHistoryTest, ExpireSomeOldHistory) {
               UnorderedElementsAre(2));
 }
 
+TEST_F(ExpireHistoryTest, ExpireOldHistorySlice) {
+  URLID url_ids[3];
+  base::Time visit_times[4];
+  AddExampleData(url_ids, visit_times);
+  const ExpiringVisitsReader* reader = expirer_.GetAllVisitsReader();
+  base::HistogramTester histogram_tester;
+
+  // An exhausted budget still expires a batch, so that expiration progresses.
+  {
+    base::test::ScopedFeatureList feature_list;
+    feature_list.InitAndEnableFeatureWithParameters(
+        kTimeSlicedExpiration, {{"TimeSlicedExpirationBatchSize", "1"},
+                                {"TimeSlicedExpirationBudget", "0s"}});
+    EXPECT_TRUE(expirer_.ExpireOldHistorySlice(visit_times[2], reader));
+    ASSERT_TRUE(GetLastDeletionInfo());
+    EXPECT_THAT(GetLastDeletionInfo()->deleted_visit_ids(),
+                UnorderedElementsAre(1));
+  }
+  ClearLastNotifications();
+
+  // Otherwise, batches are expired until there are no old visits left.
+  {
+    base::test::ScopedFeatureList feature_list;
+    feature_list.InitAndEnableFeatureWithParameters(
+        kTimeSlicedExpiration, {{"TimeSlicedExpirationBatchSize", "1"},
+                                {"TimeSlicedExpirationBudget", "1h"}});
+    EXPECT_FALSE(expirer_.ExpireOldHistorySlice(visit_times[2], reader));
+    ASSERT_EQ(2U, urls_deleted_notifications_.size());
+    EXPECT_THAT(urls_deleted_notifications_[0].deleted_visit_ids(),
+                UnorderedElementsAre(2));
+    EXPECT_THAT(urls_deleted_notifications_[1].deleted_visit_ids(),
+                UnorderedElementsAre(3));
+  }
+  histogram_tester.ExpectTotalCount("History.ExpireOldHistorySliceDuration",
+                                    2);
+}
+
 TEST_F(ExpireHistoryTest, ExpiringVisitsReader) {
   URLID url_ids[3];
   base::Time visit_times[4];
@@ -80,6 +80,26 @@ BASE_FEATURE(kPopulateVisitedLinkDatabase,
              "PopulateVisitedLinkDatabase",
              base::FEATURE_ENABLED_BY_DEFAULT);
 
+BASE_FEATURE(kTimeSlicedExpiration,
+             "HistoryTimeSlicedExpiration",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+// The number of visits expired at a time, between checks of the slice budget.
+const base::FeatureParam<int> kTimeSlicedExpirationBatchSize(
+    &kTimeSlicedExpiration,
+    "TimeSlicedExpirationBatchSize",
+    8);
+
+// How long an expiration iteration may keep expiring batches of visits.
+const base::FeatureParam<base::TimeDelta> kTimeSlicedExpirationBudget(
+    &kTimeSlicedExpiration,
+    "TimeSlicedExpirationBudget",
+    base::Milliseconds(10));
+
+BASE_FEATURE(kVisitOriginStats,
+             "HistoryVisitOriginStats",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 BASE_FEATURE(kSyncSegmentsData,
              "SyncSegmentsData",
              base::FEATURE_ENABLED_BY_DEFAULT);
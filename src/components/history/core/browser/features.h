@@ -24,6 +24,20 @@ extern const base::FeatureParam<int> kMaxNumNewTabPageDisplays;
 // with data.
 BASE_DECLARE_FEATURE(kPopulateVisitedLinkDatabase);
 
+// When enabled, the periodic expiration of old history deletes the visits in
+// batches of `kTimeSlicedExpirationBatchSize`, for as long as a slice of
+// `kTimeSlicedExpirationBudget` allows, instead of a fixed number of visits per
+// iteration whatever that takes.
+BASE_DECLARE_FEATURE(kTimeSlicedExpiration);
+extern const base::FeatureParam<int> kTimeSlicedExpirationBatchSize;
+extern const base::FeatureParam<base::TimeDelta> kTimeSlicedExpirationBudget;
+
+// When enabled, the history database maintains the number of user-visible
+// visits to each origin, and the time of the earliest one, in a table updated
+// along with the visits, so that `VisitDatabase::GetVisibleVisitCountToHost()`
+// looks them up instead of scanning the visits to the origin.
+BASE_DECLARE_FEATURE(kVisitOriginStats);
+
 // Synced Segments Data
 // NOTE: Use `IsSyncSegmentsDataEnabled()` below to check if `kSyncSegmentsData`
 // is enabled; do not check `kSyncSegmentsData` directly.
@@ -2877,8 +2877,11 @@ MostVisitedURLList HistoryBackend::QueryMostVisitedURLs(int result_count) {
           ? base::BindRepeating(&HistoryBackendClient::IsWebSafe,
                                 base::Unretained(backend_client_.get()))
           : base::NullCallback();
+  const base::ElapsedTimer query_timer;
   std::vector<std::unique_ptr<PageUsageData>> data =
       db_->QuerySegmentUsage(result_count, url_filter);
+  base::UmaHistogramTimes("History.QueryMostVisitedURLsTime",
+                          query_timer.Elapsed());
 
   MostVisitedURLList result;
   for (const std::unique_ptr<PageUsageData>& current_data : data) {
@@ -14,10 +14,12 @@
 #include <string>
 #include <utility>
 
+#include "base/feature_list.h"
 #include "base/logging.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/time/time.h"
 #include "components/google/core/common/google_util.h"
+#include "components/history/core/browser/features.h"
 #include "components/history/core/browser/history_backend.h"
 #include "components/history/core/browser/history_types.h"
 #include "components/history/core/browser/url_database.h"
@@ -107,6 +109,14 @@ bool TransitionIsVisible(int32_t transition) {
                                        ui::PAGE_TRANSITION_KEYWORD_GENERATED);
 }
 
+// Returns the origin of `url` as keyed in the visit_origin_stats table, or an
+// empty string if the visits to `url` aren't counted there.
+std::string VisitOriginStatsKey(const GURL& url) {
+  if (!url.SchemeIs(url::kHttpScheme) && !url.SchemeIs(url::kHttpsScheme))
+    return std::string();
+  return url.DeprecatedGetOriginAsURL().spec();
+}
+
 VisitSource VisitSourceFromInt(int value) {
   auto converted = static_cast<VisitSource>(value);
   // Verify that `converted` is actually a valid enum value.
@@ -245,12 +255,66 @@ bool VisitDatabase::InitVisitTable() {
       return false;
   }
 
+  return InitVisitOriginStatsTable();
+}
+
+bool VisitDatabase::InitVisitOriginStatsTable() {
+  use_visit_origin_stats_ = false;
+  // The table isn't maintained while the feature is disabled, so it's dropped
+  // and rebuilt from the visits if the feature is enabled again.
+  if (!base::FeatureList::IsEnabled(kVisitOriginStats))
+    return GetDB().Execute("DROP TABLE IF EXISTS visit_origin_stats");
+  if (GetDB().DoesTableExist("visit_origin_stats")) {
+    use_visit_origin_stats_ = true;
+    return true;
+  }
+
+  if (!GetDB().Execute("CREATE TABLE visit_origin_stats("
+                       "origin TEXT PRIMARY KEY,"
+                       "visible_visit_count INTEGER NOT NULL,"
+                       "first_visible_visit_time INTEGER NOT NULL)")) {
+    return false;
+  }
+
+  // Fill the table from the existing visits, in a single pass over them.
+  std::map<std::string, std::pair<int, base::Time>> stats;
+  sql::Statement visits(GetDB().GetUniqueStatement(
+      "SELECT u.url,v.visit_time,v.transition "
+      "FROM visits v INNER JOIN urls u ON v.url=u.id"));
+  while (visits.Step()) {
+    if (!TransitionIsVisible(visits.ColumnInt(2)))
+      continue;
+    std::string origin = VisitOriginStatsKey(GURL(visits.ColumnString(0)));
+    if (origin.empty())
+      continue;
+    auto it =
+        stats.try_emplace(std::move(origin), 0, base::Time::Max()).first;
+    ++it->second.first;
+    it->second.second = std::min(it->second.second, visits.ColumnTime(1));
+  }
+  if (!visits.Succeeded())
+    return false;
+
+  sql::Statement insert(GetDB().GetUniqueStatement(
+      "INSERT INTO visit_origin_stats "
+      "(origin,visible_visit_count,first_visible_visit_time) VALUES (?,?,?)"));
+  for (const auto& [origin, origin_stats] : stats) {
+    insert.BindString(0, origin);
+    insert.BindInt(1, origin_stats.first);
+    insert.BindTime(2, origin_stats.second);
+    if (!insert.Run())
+      return false;
+    insert.Reset(/*clear_bound_vars=*/true);
+  }
+
+  use_visit_origin_stats_ = true;
   return true;
 }
 
 bool VisitDatabase::DropVisitTable() {
   // This will also drop the indices over the table.
   return GetDB().Execute("DROP TABLE IF EXISTS visit_source") &&
+         GetDB().Execute("DROP TABLE IF EXISTS visit_origin_stats") &&
          GetDB().Execute("DROP TABLE visits");
 }
 
@@ -384,6 +448,9 @@ VisitID VisitDatabase::AddVisit(VisitRow* visit, VisitSource source) {
     }
   }
 
+  if (TransitionIsVisible(visit->transition))
+    AddVisitToOriginStats(*visit);
+
   return visit->visit_id;
 }
 
@@ -404,6 +471,9 @@ void VisitDatabase::DeleteVisit(const VisitRow& visit) {
   if (!del.Run())
     return;
 
+  if (TransitionIsVisible(visit.transition))
+    RemoveVisitFromOriginStats(visit);
+
   // Try to delete the entry in visit_source table as well.
   // If the visit was browsed, there is no corresponding entry in visit_source
   // table, and nothing will be deleted.
@@ -508,7 +578,15 @@ bool VisitDatabase::UpdateVisitRow(const VisitRow& visit) {
   statement.BindString(14, visit.app_id ? *visit.app_id : "");
   statement.BindInt64(15, visit.visit_id);
 
-  return statement.Run();
+  // The stats depend on the previous URL, time and transition of the visit.
+  VisitRow old_visit;
+  const bool update_stats =
+      use_visit_origin_stats_ && GetRowForVisit(visit.visit_id, &old_visit);
+  if (!statement.Run())
+    return false;
+  if (update_stats)
+    UpdateVisitInOriginStats(old_visit, visit);
+  return true;
 }
 
 bool VisitDatabase::SetAllVisitsAsNotKnownToSync() {
@@ -836,47 +914,25 @@ bool VisitDatabase::GetRedirectToVisit(VisitID to_visit,
 bool VisitDatabase::GetVisibleVisitCountToHost(const GURL& url,
                                                int* count,
                                                base::Time* first_visit) {
-  if (!url.SchemeIs(url::kHttpScheme) && !url.SchemeIs(url::kHttpsScheme))
-    return false;
-
-  // We need to search for URLs with a matching host/port. One way to query for
-  // this is to use the LIKE operator, eg 'url LIKE http://google.com/%'. This
-  // is inefficient though in that it doesn't use the index and each entry must
-  // be visited. The same query can be executed by using >= and < operator.
-  // The query becomes:
-  // 'url >= http://google.com/' and url < http://google.com0'.
-  // 0 is used as it is one character greater than '/'.
-  const std::string host_query_min = url.DeprecatedGetOriginAsURL().spec();
-  if (host_query_min.empty())
+  const std::string origin = VisitOriginStatsKey(url);
+  if (origin.empty())
     return false;
+  if (!use_visit_origin_stats_)
+    return ScanVisibleVisitsToOrigin(origin, count, first_visit);
 
-  // We also want to restrict ourselves to main frame navigations that are not
-  // in the middle of redirect chains, hence the transition checks.
   sql::Statement statement(GetDB().GetCachedStatement(
       SQL_FROM_HERE,
-      "SELECT v.visit_time,transition "
-      "FROM visits v INNER JOIN urls u ON v.url = u.id "
-      "WHERE u.url >= ? AND u.url < ?"));
-  statement.BindString(0, host_query_min);
-  statement.BindString(
-      1, host_query_min.substr(0, host_query_min.size() - 1) + '0');
-
-  int visit_count = 0;
-  base::Time min_visit_time = base::Time::Max();
-  while (statement.Step()) {
-    if (!TransitionIsVisible(statement.ColumnInt(1)))
-      continue;
-    ++visit_count;
-    min_visit_time = std::min(statement.ColumnTime(0), min_visit_time);
+      "SELECT visible_visit_count,first_visible_visit_time "
+      "FROM visit_origin_stats WHERE origin=?"));
+  statement.BindString(0, origin);
+  if (!statement.Step()) {
+    if (!statement.Succeeded())
+      return false;
+    *count = 0;
+    return true;
   }
-
-  if (!statement.Succeeded())
-    return false;
-
-  *count = visit_count;
-  if (visit_count > 0)
-    *first_visit = min_visit_time;
-
+  *count = statement.ColumnInt(0);
+  *first_visit = statement.ColumnTime(1);
   return true;
 }
 
@@ -1074,6 +1130,153 @@ DailyVisitsResult VisitDatabase::GetDailyVisitsToHost(const GURL& host,
   return result;
 }
 
+std::string VisitDatabase::GetVisitOriginStatsKey(URLID url_id) {
+  sql::Statement statement(GetDB().GetCachedStatement(
+      SQL_FROM_HERE, "SELECT url FROM urls WHERE id=?"));
+  statement.BindInt64(0, url_id);
+  if (!statement.Step())
+    return std::string();
+  return VisitOriginStatsKey(GURL(statement.ColumnString(0)));
+}
+
+void VisitDatabase::AddVisitToOriginStats(const VisitRow& visit) {
+  if (!use_visit_origin_stats_)
+    return;
+  const std::string origin = GetVisitOriginStatsKey(visit.url_id);
+  if (origin.empty())
+    return;
+
+  sql::Statement statement(GetDB().GetCachedStatement(
+      SQL_FROM_HERE,
+      "INSERT INTO visit_origin_stats "
+      "(origin,visible_visit_count,first_visible_visit_time) VALUES (?,1,?) "
+      "ON CONFLICT(origin) DO UPDATE SET "
+      "visible_visit_count=visible_visit_count+1,"
+      "first_visible_visit_time="
+      "MIN(first_visible_visit_time,excluded.first_visible_visit_time)"));
+  statement.BindString(0, origin);
+  statement.BindTime(1, visit.visit_time);
+  statement.Run();
+}
+
+void VisitDatabase::RemoveVisitFromOriginStats(const VisitRow& visit) {
+  if (!use_visit_origin_stats_)
+    return;
+  const std::string origin = GetVisitOriginStatsKey(visit.url_id);
+  if (origin.empty())
+    return;
+
+  sql::Statement statement(GetDB().GetCachedStatement(
+      SQL_FROM_HERE,
+      "SELECT visible_visit_count,first_visible_visit_time "
+      "FROM visit_origin_stats WHERE origin=?"));
+  statement.BindString(0, origin);
+  if (!statement.Step())
+    return;
+  const int count = statement.ColumnInt(0);
+  const base::Time first_visit = statement.ColumnTime(1);
+
+  // Only the visits table knows the earliest of the remaining visits, so
+  // removing the earliest visit to an origin falls back to a scan.
+  if (count <= 1 || visit.visit_time <= first_visit) {
+    RecomputeVisitOriginStats(origin);
+    return;
+  }
+  sql::Statement update(GetDB().GetCachedStatement(
+      SQL_FROM_HERE,
+      "UPDATE visit_origin_stats SET visible_visit_count=? WHERE origin=?"));
+  update.BindInt(0, count - 1);
+  update.BindString(1, origin);
+  update.Run();
+}
+
+void VisitDatabase::UpdateVisitInOriginStats(const VisitRow& old_visit,
+                                             const VisitRow& new_visit) {
+  const bool old_visible = TransitionIsVisible(old_visit.transition);
+  const bool new_visible = TransitionIsVisible(new_visit.transition);
+  if (old_visible && new_visible) {
+    if (old_visit.url_id == new_visit.url_id &&
+        old_visit.visit_time == new_visit.visit_time) {
+      return;
+    }
+    // The visits table already has the new visit, so rescan the origins.
+    const std::string old_origin = GetVisitOriginStatsKey(old_visit.url_id);
+    const std::string new_origin = GetVisitOriginStatsKey(new_visit.url_id);
+    if (!old_origin.empty())
+      RecomputeVisitOriginStats(old_origin);
+    if (!new_origin.empty() && new_origin != old_origin)
+      RecomputeVisitOriginStats(new_origin);
+  } else if (old_visible) {
+    RemoveVisitFromOriginStats(old_visit);
+  } else if (new_visible) {
+    AddVisitToOriginStats(new_visit);
+  }
+}
+
+void VisitDatabase::RecomputeVisitOriginStats(const std::string& origin) {
+  int count = 0;
+  base::Time first_visit;
+  if (!ScanVisibleVisitsToOrigin(origin, &count, &first_visit))
+    return;
+
+  if (count == 0) {
+    sql::Statement statement(GetDB().GetCachedStatement(
+        SQL_FROM_HERE, "DELETE FROM visit_origin_stats WHERE origin=?"));
+    statement.BindString(0, origin);
+    statement.Run();
+    return;
+  }
+  sql::Statement statement(GetDB().GetCachedStatement(
+      SQL_FROM_HERE,
+      "INSERT OR REPLACE INTO visit_origin_stats "
+      "(origin,visible_visit_count,first_visible_visit_time) VALUES (?,?,?)"));
+  statement.BindString(0, origin);
+  statement.BindInt(1, count);
+  statement.BindTime(2, first_visit);
+  statement.Run();
+}
+
+bool VisitDatabase::ScanVisibleVisitsToOrigin(const std::string& origin,
+                                              int* count,
+                                              base::Time* first_visit) {
+  // We need to search for URLs with a matching host/port. One way to query for
+  // this is to use the LIKE operator, eg 'url LIKE http://google.com/%'. This
+  // is inefficient though in that it doesn't use the index and each entry must
+  // be visited. The same query can be executed by using >= and < operator.
+  // The query becomes:
+  // 'url >= http://google.com/' and url < http://google.com0'.
+  // 0 is used as it is one character greater than '/'.
+  DCHECK(!origin.empty());
+
+  // We also want to restrict ourselves to main frame navigations that are not
+  // in the middle of redirect chains, hence the transition checks.
+  sql::Statement statement(GetDB().GetCachedStatement(
+      SQL_FROM_HERE,
+      "SELECT v.visit_time,transition "
+      "FROM visits v INNER JOIN urls u ON v.url = u.id "
+      "WHERE u.url >= ? AND u.url < ?"));
+  statement.BindString(0, origin);
+  statement.BindString(1, origin.substr(0, origin.size() - 1) + '0');
+
+  int visit_count = 0;
+  base::Time min_visit_time = base::Time::Max();
+  while (statement.Step()) {
+    if (!TransitionIsVisible(statement.ColumnInt(1)))
+      continue;
+    ++visit_count;
+    min_visit_time = std::min(statement.ColumnTime(0), min_visit_time);
+  }
+
+  if (!statement.Succeeded())
+    return false;
+
+  *count = visit_count;
+  if (visit_count > 0)
+    *first_visit = min_visit_time;
+
+  return true;
+}
+
 bool VisitDatabase::GetStartDate(base::Time* first_visit) {
   sql::Statement statement(GetDB().GetCachedStatement(
       SQL_FROM_HERE,
@@ -285,6 +285,12 @@ class VisitDatabase {
   // and indices are properly set up. Must be called before anything else.
   bool InitVisitTable();
 
+  // Creates the visit_origin_stats table if `kVisitOriginStats` is enabled, and
+  // fills it from the visits. Otherwise, drops it so that it's rebuilt if the
+  // feature is enabled again, since the visits changed in the meantime aren't
+  // counted. Called by `InitVisitTable()`.
+  bool InitVisitOriginStatsTable();
+
   // Convenience to fill a VisitRow. Assumes the visit values are bound starting
   // at index 0.
   static void FillVisitRow(sql::Statement& statement, VisitRow* visit);
@@ -361,6 +367,35 @@ class VisitDatabase {
   // Called by the derived classes to migrate the older visits table which
   // doesn't have the `app_id` column.
   bool MigrateVisitsAddAppId();
+
+ private:
+  // Returns the origin of the URL `url_id` as keyed in visit_origin_stats, or
+  // an empty string if the visits to the URL aren't counted there.
+  std::string GetVisitOriginStatsKey(URLID url_id);
+
+  // Counts the user-visible `visit` in visit_origin_stats.
+  void AddVisitToOriginStats(const VisitRow& visit);
+
+  // Uncounts the user-visible `visit` from visit_origin_stats, once it has been
+  // deleted or made invisible in the visits table.
+  void RemoveVisitFromOriginStats(const VisitRow& visit);
+
+  // Updates visit_origin_stats after `old_visit` was updated to `new_visit`.
+  void UpdateVisitInOriginStats(const VisitRow& old_visit,
+                                const VisitRow& new_visit);
+
+  // Sets the stats of `origin` in visit_origin_stats to those scanned from the
+  // visits table.
+  void RecomputeVisitOriginStats(const std::string& origin);
+
+  // Scans the visits table for the user-visible visits to `origin`, as keyed in
+  // visit_origin_stats. Sets `first_visit` only if `count` is positive.
+  bool ScanVisibleVisitsToOrigin(const std::string& origin,
+                                 int* count,
+                                 base::Time* first_visit);
+
+  // Whether visit_origin_stats is maintained, see `kVisitOriginStats`.
+  bool use_visit_origin_stats_ = false;
 };
 
 // Columns, in order, of the visit table.
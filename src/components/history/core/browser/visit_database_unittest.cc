@@ -8,7 +8,9 @@
 #include <vector>
 
 #include "base/strings/string_util.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/time/time.h"
+#include "components/history/core/browser/features.h"
 #include "components/history/core/browser/url_database.h"
 #include "components/history/core/browser/visit_database.h"
 #include "components/history/core/browser/visited_link_database.h"
@@ -793,6 +795,77 @@ TEST_F(VisitDatabaseTest, GetHistoryCount) {
   }
 }
 
+TEST_F(VisitDatabaseTest, GetVisibleVisitCountToHost_OriginStats) {
+  // Visits added before the feature is enabled are counted when the table is
+  // created.
+  const base::Time now = base::Time::Now();
+  const auto visible = ui::PageTransitionFromInt(
+      ui::PAGE_TRANSITION_TYPED | ui::PAGE_TRANSITION_CHAIN_START |
+      ui::PAGE_TRANSITION_CHAIN_END);
+  const URLID url_id = AddURL(URLRow(GURL("https://www.chromium.org/a")));
+  const URLID other_url_id = AddURL(URLRow(GURL("https://www.chromium.org/b")));
+  const URLID other_origin_url_id =
+      AddURL(URLRow(GURL("http://www.chromium.org/")));
+  VisitRow first_visit(url_id, now, 0, visible, 0, false, 0);
+  AddVisit(&first_visit, SOURCE_BROWSED);
+
+  base::test::ScopedFeatureList feature_list(kVisitOriginStats);
+  ASSERT_TRUE(InitVisitTable());
+
+  int count = 0;
+  base::Time first_visit_time;
+  EXPECT_TRUE(GetVisibleVisitCountToHost(GURL("https://www.chromium.org/c"),
+                                         &count, &first_visit_time));
+  EXPECT_EQ(1, count);
+  EXPECT_EQ(now, first_visit_time);
+
+  // Only the visible visits to the origin are counted.
+  VisitRow second_visit(other_url_id, now + base::Minutes(1), 0, visible, 0,
+                        false, 0);
+  AddVisit(&second_visit, SOURCE_BROWSED);
+  VisitRow redirect_visit(other_url_id, now - base::Minutes(1), 0,
+                          ui::PAGE_TRANSITION_TYPED, 0, false, 0);
+  AddVisit(&redirect_visit, SOURCE_BROWSED);
+  VisitRow other_origin_visit(other_origin_url_id, now - base::Minutes(2), 0,
+                              visible, 0, false, 0);
+  AddVisit(&other_origin_visit, SOURCE_BROWSED);
+  EXPECT_TRUE(GetVisibleVisitCountToHost(GURL("https://www.chromium.org"),
+                                         &count, &first_visit_time));
+  EXPECT_EQ(2, count);
+  EXPECT_EQ(now, first_visit_time);
+
+  // Deleting the earliest visit moves the first visit time.
+  DeleteVisit(first_visit);
+  EXPECT_TRUE(GetVisibleVisitCountToHost(GURL("https://www.chromium.org"),
+                                         &count, &first_visit_time));
+  EXPECT_EQ(1, count);
+  EXPECT_EQ(now + base::Minutes(1), first_visit_time);
+
+  // Updates that make a visit visible, or not, are counted too.
+  redirect_visit.transition = visible;
+  EXPECT_TRUE(UpdateVisitRow(redirect_visit));
+  EXPECT_TRUE(GetVisibleVisitCountToHost(GURL("https://www.chromium.org"),
+                                         &count, &first_visit_time));
+  EXPECT_EQ(2, count);
+  EXPECT_EQ(now - base::Minutes(1), first_visit_time);
+
+  second_visit.transition = ui::PAGE_TRANSITION_TYPED;
+  EXPECT_TRUE(UpdateVisitRow(second_visit));
+  redirect_visit.transition = ui::PAGE_TRANSITION_TYPED;
+  EXPECT_TRUE(UpdateVisitRow(redirect_visit));
+  count = -1;
+  EXPECT_TRUE(GetVisibleVisitCountToHost(GURL("https://www.chromium.org"),
+                                         &count, &first_visit_time));
+  EXPECT_EQ(0, count);
+
+  EXPECT_TRUE(GetVisibleVisitCountToHost(GURL("http://www.chromium.org"),
+                                         &count, &first_visit_time));
+  EXPECT_EQ(1, count);
+  EXPECT_EQ(now - base::Minutes(2), first_visit_time);
+  EXPECT_FALSE(GetVisibleVisitCountToHost(GURL("file:///tmp"), &count,
+                                          &first_visit_time));
+}
+
 TEST_F(VisitDatabaseTest, GetLastVisitToOrigin_BadURL) {
   base::Time last_visit;
   EXPECT_FALSE(GetLastVisitToOrigin(url::Origin(), base::Time::Min(),
@@ -145,6 +145,19 @@ bool VisitedLinkDatabase::InitVisitedLinkEnumeratorForEverything(
   return enumerator.statement_.is_valid();
 }
 
+bool VisitedLinkDatabase::InitVisitedLinkEnumeratorForRowsAfter(
+    VisitedLinkID id,
+    VisitedLinkEnumerator& enumerator) {
+  DCHECK(!enumerator.initialized_);
+  // `id` is the INTEGER PRIMARY KEY, so this seeks in the table's b-tree.
+  enumerator.statement_.Assign(GetDB().GetUniqueStatement(
+      "SELECT " HISTORY_VISITED_LINK_ROW_FIELDS
+      " FROM visited_links WHERE id>? ORDER BY id"));
+  enumerator.statement_.BindInt64(0, id);
+  enumerator.initialized_ = enumerator.statement_.is_valid();
+  return enumerator.statement_.is_valid();
+}
+
 bool VisitedLinkDatabase::CreateVisitedLinkTable() {
   if (GetDB().DoesTableExist("visited_links")) {
     return true;
@@ -107,6 +107,15 @@ class VisitedLinkDatabase {
   bool InitVisitedLinkEnumeratorForEverything(
       VisitedLinkEnumerator& enumerator);
 
+  // Initializes the given enumerator to enumerate, in order of ID, the visited
+  // links added after the one with the given `id`. IDs are never reused, so
+  // this lets a VisitedLinks hash table built from the database be updated
+  // incrementally with the rows added since it was built, without reading the
+  // whole table again.
+  bool InitVisitedLinkEnumeratorForRowsAfter(
+      VisitedLinkID id,
+      VisitedLinkEnumerator& enumerator);
+
  protected:
   friend class VisitDatabase;
 
@@ -143,4 +143,36 @@ TEST_F(VisitedLinkDatabaseTest, UpdateVisitedLink) {
   EXPECT_FALSE(GetVisitedLinkRow(row_id, nonexistent_row));
 }
 
+TEST_F(VisitedLinkDatabaseTest, EnumerateRowsAfter) {
+  const GURL top_level_url("http://mail.google.com/");
+  VisitedLinkID row1_id =
+      AddVisitedLink(GetLinkURLID(), top_level_url,
+                     GURL("http://docs.google.com/"), /*visit_count=*/1);
+  VisitedLinkID row2_id =
+      AddVisitedLink(GetLinkURLID(), top_level_url,
+                     GURL("http://maps.google.com/"), /*visit_count=*/2);
+  VisitedLinkID row3_id =
+      AddVisitedLink(GetLinkURLID(), top_level_url,
+                     GURL("http://meet.google.com/"), /*visit_count=*/3);
+  ASSERT_TRUE(row1_id && row2_id && row3_id);
+
+  // Deleting a row does not affect the rows after it.
+  EXPECT_TRUE(DeleteVisitedLinkRow(row2_id));
+
+  VisitedLinkEnumerator enumerator;
+  ASSERT_TRUE(InitVisitedLinkEnumeratorForRowsAfter(row1_id - 1, enumerator));
+  VisitedLinkRow row;
+  ASSERT_TRUE(enumerator.GetNextVisitedLink(row));
+  EXPECT_EQ(row1_id, row.id);
+  ASSERT_TRUE(enumerator.GetNextVisitedLink(row));
+  EXPECT_EQ(row3_id, row.id);
+  EXPECT_EQ(GURL("http://meet.google.com/"), row.frame_url);
+  EXPECT_FALSE(enumerator.GetNextVisitedLink(row));
+
+  VisitedLinkEnumerator up_to_date_enumerator;
+  ASSERT_TRUE(
+      InitVisitedLinkEnumeratorForRowsAfter(row3_id, up_to_date_enumerator));
+  EXPECT_FALSE(up_to_date_enumerator.GetNextVisitedLink(row));
+}
+
 }  // namespace history
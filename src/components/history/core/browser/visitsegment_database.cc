@@ -215,24 +215,32 @@ VisitSegmentDatabase::QuerySegmentUsage(
   if (!statement.is_valid())
     return std::vector<std::unique_ptr<PageUsageData>>();
 
-  std::vector<std::unique_ptr<PageUsageData>> segments;
+  // Aggregate the scores in plain structs: there is one per segment ever
+  // visited, but only the top few become PageUsageData.
+  struct SegmentScore {
+    SegmentID id;
+    int visit_count = 0;
+    base::Time last_visit_timeslot = base::Time::Min();
+    double score = 0.0;
+  };
+  std::vector<SegmentScore> segments;
   base::Time now = base::Time::Now();
   SegmentID previous_segment_id = 0;
   while (statement.Step()) {
     SegmentID segment_id = statement.ColumnInt64(0);
     if (segment_id != previous_segment_id) {
-      segments.push_back(std::make_unique<PageUsageData>(segment_id));
+      segments.push_back({.id = segment_id});
       previous_segment_id = segment_id;
     }
+    SegmentScore& segment = segments.back();
 
     base::Time timeslot = statement.ColumnTime(1);
-    if (timeslot > segments.back()->GetLastVisitTimeslot()) {
-      segments.back()->SetLastVisitTimeslot(timeslot);
+    if (timeslot > segment.last_visit_timeslot) {
+      segment.last_visit_timeslot = timeslot;
     }
 
     int visit_count = statement.ColumnInt(2);
-    segments.back()->SetVisitCount(segments.back()->GetVisitCount() +
-                                   visit_count);
+    segment.visit_count += visit_count;
 
     // Score for this day in isolation.
     float day_visits_score = visit_count <= 0.0f
@@ -246,15 +254,15 @@ VisitSegmentDatabase::QuerySegmentUsage(
     int days_ago = (now - timeslot).InDays();
     float recency_boost = 1.0f + (2.0f * (1.0f / (1.0f + days_ago/7.0f)));
     float score = recency_boost * day_visits_score;
-    segments.back()->SetScore(segments.back()->GetScore() + score);
+    segment.score += score;
   }
 
-  // Order by descending scores.
-  std::sort(segments.begin(), segments.end(),
-            [](const std::unique_ptr<PageUsageData>& lhs,
-               const std::unique_ptr<PageUsageData>& rhs) {
-              return lhs->GetScore() > rhs->GetScore();
-            });
+  // Visit the segments by descending score. Only as many as needed to fill the
+  // results are popped off the heap, rather than sorting every segment.
+  auto by_score = [](const SegmentScore& lhs, const SegmentScore& rhs) {
+    return lhs.score < rhs.score;
+  };
+  std::make_heap(segments.begin(), segments.end(), by_score);
 
   // Now fetch the details about the entries we care about.
   sql::Statement statement2(GetDB().GetCachedStatement(SQL_FROM_HERE,
@@ -267,16 +275,23 @@ VisitSegmentDatabase::QuerySegmentUsage(
 
   std::vector<std::unique_ptr<PageUsageData>> results;
   DCHECK_GE(max_result_count, 0);
-  for (std::unique_ptr<PageUsageData>& pud : segments) {
-    statement2.BindInt64(0, pud->GetID());
+  for (auto heap_end = segments.end();
+       heap_end != segments.begin() &&
+       results.size() < static_cast<size_t>(max_result_count);
+       --heap_end) {
+    std::pop_heap(segments.begin(), heap_end, by_score);
+    const SegmentScore& segment = *(heap_end - 1);
+    statement2.BindInt64(0, segment.id);
     if (statement2.Step()) {
       GURL url(statement2.ColumnString(0));
       if (url_filter.is_null() || url_filter.Run(url)) {
+        auto pud = std::make_unique<PageUsageData>(segment.id);
         pud->SetURL(url);
         pud->SetTitle(statement2.ColumnString16(1));
+        pud->SetVisitCount(segment.visit_count);
+        pud->SetLastVisitTimeslot(segment.last_visit_timeslot);
+        pud->SetScore(segment.score);
         results.push_back(std::move(pud));
-        if (results.size() >= static_cast<size_t>(max_result_count))
-          break;
       }
     }
     statement2.Reset(true);
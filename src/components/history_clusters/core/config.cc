@@ -245,6 +245,22 @@ Config::Config() {
     DCHECK_GE(has_url_keyed_image_ranking_weight, 0.0f);
   }
 
+  // The `kOnDeviceClusteringIncremental` feature and child params.
+  {
+    use_incremental_clustering =
+        base::FeatureList::IsEnabled(features::kOnDeviceClusteringIncremental);
+  }
+
+  // The `kOnDeviceClusteringParallelFinalization` feature and child params.
+  {
+    finalize_clusters_in_parallel = base::FeatureList::IsEnabled(
+        features::kOnDeviceClusteringParallelFinalization);
+    min_clusters_for_parallel_finalization = GetFieldTrialParamByFeatureAsInt(
+        features::kOnDeviceClusteringParallelFinalization,
+        "min_clusters_for_parallel_finalization",
+        min_clusters_for_parallel_finalization);
+  }
+
   // The `kHistoryClustersNavigationContextClustering` feature and child params.
   {
     use_navigation_context_clusters = base::FeatureList::IsEnabled(
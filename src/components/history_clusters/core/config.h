@@ -232,6 +232,23 @@ struct Config {
   // visits within a cluster. Will always be greater than or equal to 0.
   float has_url_keyed_image_ranking_weight = 1.5;
 
+  // The `kOnDeviceClusteringIncremental` feature and child params.
+
+  // Whether the update clusters task reuses the finalized clusters of its
+  // previous pass for clusters whose visits did not change, instead of running
+  // every cluster finalizer over all of them again.
+  bool use_incremental_clustering = false;
+
+  // The `kOnDeviceClusteringParallelFinalization` feature and child params.
+
+  // Whether the cluster finalizers run over clusters concurrently on ThreadPool
+  // workers. The order of the clusters is unaffected.
+  bool finalize_clusters_in_parallel = false;
+
+  // The minimum number of clusters to finalize in parallel. Fewer clusters are
+  // finalized serially, since posting the job would cost more than it saves.
+  size_t min_clusters_for_parallel_finalization = 64;
+
   // The `kHistoryClustersNavigationContextClustering` feature and child params.
 
   // Whether to use the new clustering path that does context clustering at
@@ -0,0 +1,126 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/history_clusters/core/incremental_clustering_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/ranges/algorithm.h"
+
+namespace history_clusters {
+
+namespace {
+
+// Returns the visits of `cluster` sorted by visit ID.
+std::vector<const history::ClusterVisit*> GetSortedVisits(
+    const history::Cluster& cluster) {
+  std::vector<const history::ClusterVisit*> visits;
+  visits.reserve(cluster.visits.size());
+  for (const auto& visit : cluster.visits) {
+    visits.push_back(&visit);
+  }
+  base::ranges::sort(visits, {}, [](const history::ClusterVisit* visit) {
+    return visit->annotated_visit.visit_row.visit_id;
+  });
+  return visits;
+}
+
+std::vector<history::VisitID> GetKey(
+    const std::vector<const history::ClusterVisit*>& sorted_visits) {
+  std::vector<history::VisitID> key;
+  key.reserve(sorted_visits.size());
+  for (const history::ClusterVisit* visit : sorted_visits) {
+    key.push_back(visit->annotated_visit.visit_row.visit_id);
+  }
+  return key;
+}
+
+// Whether the cluster processors and finalizers would see the same data for
+// `a` and `b`.
+bool HasSameClusteringInputs(const history::ClusterVisit& a,
+                             const history::ClusterVisit& b) {
+  const history::AnnotatedVisit& visit_a = a.annotated_visit;
+  const history::AnnotatedVisit& visit_b = b.annotated_visit;
+  const history::VisitContentAnnotations& content_a =
+      visit_a.content_annotations;
+  const history::VisitContentAnnotations& content_b =
+      visit_b.content_annotations;
+  return visit_a.visit_row.visit_id == visit_b.visit_row.visit_id &&
+         visit_a.visit_row.visit_time == visit_b.visit_row.visit_time &&
+         visit_a.visit_row.visit_duration == visit_b.visit_row.visit_duration &&
+         visit_a.visit_row.is_known_to_sync ==
+             visit_b.visit_row.is_known_to_sync &&
+         visit_a.url_row.url() == visit_b.url_row.url() &&
+         visit_a.url_row.title() == visit_b.url_row.title() &&
+         visit_a.context_annotations == visit_b.context_annotations &&
+         content_a.search_terms == content_b.search_terms &&
+         content_a.search_normalized_url == content_b.search_normalized_url &&
+         content_a.related_searches == content_b.related_searches &&
+         content_a.has_url_keyed_image == content_b.has_url_keyed_image &&
+         content_a.model_annotations.visibility_score ==
+             content_b.model_annotations.visibility_score &&
+         content_a.model_annotations.categories ==
+             content_b.model_annotations.categories &&
+         content_a.model_annotations.entities ==
+             content_b.model_annotations.entities &&
+         a.interaction_state == b.interaction_state &&
+         a.engagement_score == b.engagement_score &&
+         a.normalized_url == b.normalized_url &&
+         a.url_for_deduping == b.url_for_deduping &&
+         a.url_for_display == b.url_for_display;
+}
+
+}  // namespace
+
+IncrementalClusteringCache::Entry::Entry() = default;
+IncrementalClusteringCache::Entry::Entry(Entry&&) = default;
+IncrementalClusteringCache::Entry& IncrementalClusteringCache::Entry::operator=(
+    Entry&&) = default;
+IncrementalClusteringCache::Entry::~Entry() = default;
+
+IncrementalClusteringCache::IncrementalClusteringCache() = default;
+IncrementalClusteringCache::~IncrementalClusteringCache() = default;
+
+bool IncrementalClusteringCache::ReuseFinalizedCluster(
+    history::Cluster& cluster) {
+  const std::vector<const history::ClusterVisit*> visits =
+      GetSortedVisits(cluster);
+  auto it = previous_pass_clusters_.find(GetKey(visits));
+  if (it == previous_pass_clusters_.end()) {
+    return false;
+  }
+
+  const Entry& entry = it->second;
+  for (size_t i = 0; i < visits.size(); ++i) {
+    if (!HasSameClusteringInputs(*visits[i], entry.visits[i])) {
+      return false;
+    }
+  }
+
+  cluster = entry.finalized_cluster;
+  current_pass_clusters_.insert(previous_pass_clusters_.extract(it));
+  return true;
+}
+
+void IncrementalClusteringCache::AddFinalizedCluster(
+    const history::Cluster& cluster,
+    history::Cluster finalized_cluster) {
+  const std::vector<const history::ClusterVisit*> visits =
+      GetSortedVisits(cluster);
+  Entry entry;
+  entry.visits.reserve(visits.size());
+  for (const history::ClusterVisit* visit : visits) {
+    entry.visits.push_back(*visit);
+  }
+  entry.finalized_cluster = std::move(finalized_cluster);
+  current_pass_clusters_.insert_or_assign(GetKey(visits), std::move(entry));
+}
+
+void IncrementalClusteringCache::FinishPass() {
+  previous_pass_clusters_ = std::move(current_pass_clusters_);
+  current_pass_clusters_.clear();
+}
+
+}  // namespace history_clusters
@@ -0,0 +1,68 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_HISTORY_CLUSTERS_CORE_INCREMENTAL_CLUSTERING_CACHE_H_
+#define COMPONENTS_HISTORY_CLUSTERS_CORE_INCREMENTAL_CLUSTERING_CACHE_H_
+
+#include <map>
+#include <vector>
+
+#include "components/history/core/browser/history_types.h"
+
+namespace history_clusters {
+
+// Remembers the clusters finalized by the previous clustering pass, so that a
+// pass over mostly the same visits only has to run the cluster finalizers over
+// the clusters that gained, lost or changed visits since.
+//
+// Clusters are matched by their set of visits. A cluster is only reused if
+// every visit still has the same inputs the finalizers look at, e.g. its
+// durations, annotations and engagement score.
+class IncrementalClusteringCache {
+ public:
+  IncrementalClusteringCache();
+  IncrementalClusteringCache(const IncrementalClusteringCache&) = delete;
+  IncrementalClusteringCache& operator=(const IncrementalClusteringCache&) =
+      delete;
+  ~IncrementalClusteringCache();
+
+  // If the previous pass finalized a cluster from the same visits as
+  // `cluster`, replaces `cluster` with that finalized cluster, keeps it for the
+  // next pass and returns true. Returns false otherwise.
+  bool ReuseFinalizedCluster(history::Cluster& cluster);
+
+  // Keeps `finalized_cluster`, the result of finalizing `cluster`, for the next
+  // pass.
+  void AddFinalizedCluster(const history::Cluster& cluster,
+                           history::Cluster finalized_cluster);
+
+  // Ends the current pass. Clusters of the previous pass that were not reused
+  // are dropped.
+  void FinishPass();
+
+  // The number of clusters that can be reused by the next pass.
+  size_t size() const { return previous_pass_clusters_.size(); }
+
+ private:
+  struct Entry {
+    Entry();
+    Entry(Entry&&);
+    Entry& operator=(Entry&&);
+    ~Entry();
+
+    // The visits of the cluster before finalizing, sorted by visit ID.
+    std::vector<history::ClusterVisit> visits;
+    history::Cluster finalized_cluster;
+  };
+
+  // The sorted IDs of the visits in a cluster.
+  using Key = std::vector<history::VisitID>;
+
+  std::map<Key, Entry> previous_pass_clusters_;
+  std::map<Key, Entry> current_pass_clusters_;
+};
+
+}  // namespace history_clusters
+
+#endif  // COMPONENTS_HISTORY_CLUSTERS_CORE_INCREMENTAL_CLUSTERING_CACHE_H_
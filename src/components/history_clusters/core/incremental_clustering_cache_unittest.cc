@@ -0,0 +1,94 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/history_clusters/core/incremental_clustering_cache.h"
+
+#include <vector>
+
+#include "components/history_clusters/core/clustering_test_utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace history_clusters {
+namespace {
+
+history::Cluster CreateCluster(const std::vector<int>& visit_ids) {
+  std::vector<history::ClusterVisit> visits;
+  for (int visit_id : visit_ids) {
+    visits.push_back(
+        testing::CreateClusterVisit(testing::CreateDefaultAnnotatedVisit(
+            visit_id, GURL("https://example.com/"))));
+  }
+  return testing::CreateCluster(visits);
+}
+
+history::Cluster CreateFinalizedCluster(const std::vector<int>& visit_ids,
+                                        const std::u16string& label) {
+  history::Cluster cluster = CreateCluster(visit_ids);
+  cluster.label = label;
+  cluster.triggerability_calculated = true;
+  return cluster;
+}
+
+TEST(IncrementalClusteringCacheTest, ReusesUnchangedClusters) {
+  IncrementalClusteringCache cache;
+
+  history::Cluster cluster = CreateCluster({1, 2});
+  EXPECT_FALSE(cache.ReuseFinalizedCluster(cluster));
+  cache.AddFinalizedCluster(cluster, CreateFinalizedCluster({1, 2}, u"label"));
+  cache.FinishPass();
+  EXPECT_EQ(1u, cache.size());
+
+  // The order of the visits does not matter.
+  history::Cluster reordered_cluster = CreateCluster({2, 1});
+  ASSERT_TRUE(cache.ReuseFinalizedCluster(reordered_cluster));
+  EXPECT_EQ(u"label", reordered_cluster.label);
+  EXPECT_TRUE(reordered_cluster.triggerability_calculated);
+  cache.FinishPass();
+
+  // Reused clusters are kept for the next pass.
+  history::Cluster same_cluster = CreateCluster({1, 2});
+  EXPECT_TRUE(cache.ReuseFinalizedCluster(same_cluster));
+}
+
+TEST(IncrementalClusteringCacheTest, DoesNotReuseChangedClusters) {
+  IncrementalClusteringCache cache;
+
+  history::Cluster cluster = CreateCluster({1, 2});
+  cache.AddFinalizedCluster(cluster, CreateFinalizedCluster({1, 2}, u"label"));
+  cache.FinishPass();
+
+  // A visit was added.
+  history::Cluster grown_cluster = CreateCluster({1, 2, 3});
+  EXPECT_FALSE(cache.ReuseFinalizedCluster(grown_cluster));
+  EXPECT_FALSE(grown_cluster.label);
+
+  // A visit was updated.
+  history::Cluster updated_cluster = CreateCluster({1, 2});
+  updated_cluster.visits[1].annotated_visit.visit_row.visit_duration +=
+      base::Seconds(1);
+  EXPECT_FALSE(cache.ReuseFinalizedCluster(updated_cluster));
+
+  history::Cluster engaged_cluster = CreateCluster({1, 2});
+  engaged_cluster.visits[0].engagement_score = 50;
+  EXPECT_FALSE(cache.ReuseFinalizedCluster(engaged_cluster));
+}
+
+TEST(IncrementalClusteringCacheTest, DropsClustersNotSeenInPass) {
+  IncrementalClusteringCache cache;
+
+  history::Cluster cluster = CreateCluster({1});
+  history::Cluster other_cluster = CreateCluster({2});
+  cache.AddFinalizedCluster(cluster, CreateFinalizedCluster({1}, u"one"));
+  cache.AddFinalizedCluster(other_cluster, CreateFinalizedCluster({2}, u"two"));
+  cache.FinishPass();
+  EXPECT_EQ(2u, cache.size());
+
+  EXPECT_TRUE(cache.ReuseFinalizedCluster(cluster));
+  cache.FinishPass();
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_FALSE(cache.ReuseFinalizedCluster(other_cluster));
+}
+
+}  // namespace
+}  // namespace history_clusters
@@ -9,6 +9,8 @@
 #include <set>
 
 #include "base/containers/flat_map.h"
+#include "base/containers/span.h"
+#include "base/functional/bind.h"
 #include "base/i18n/case_conversion.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/strings/string_util.h"
@@ -26,11 +28,13 @@
 #include "components/history_clusters/core/features.h"
 #include "components/history_clusters/core/filter_cluster_processor.h"
 #include "components/history_clusters/core/history_clusters_util.h"
+#include "components/history_clusters/core/incremental_clustering_cache.h"
 #include "components/history_clusters/core/keyword_cluster_finalizer.h"
 #include "components/history_clusters/core/label_cluster_finalizer.h"
 #include "components/history_clusters/core/noisy_cluster_finalizer.h"
 #include "components/history_clusters/core/on_device_clustering_features.h"
 #include "components/history_clusters/core/on_device_clustering_util.h"
+#include "components/history_clusters/core/parallel_cluster_finalizer.h"
 #include "components/history_clusters/core/ranking_cluster_finalizer.h"
 #include "components/history_clusters/core/similar_visit_deduper_cluster_finalizer.h"
 #include "components/history_clusters/core/single_visit_cluster_finalizer.h"
@@ -47,6 +51,92 @@ void RecordBatchUpdateProcessingTime(base::TimeDelta time_delta) {
       "History.Clusters.Backend.ProcessBatchOfVisits.ThreadTime", time_delta);
 }
 
+// Returns the cluster finalizers that affect the appearance of a cluster on the
+// UI surface associated with `clustering_request_source`.
+std::vector<std::unique_ptr<ClusterFinalizer>> CreateUIClusterFinalizers(
+    ClusteringRequestSource clustering_request_source) {
+  std::vector<std::unique_ptr<ClusterFinalizer>> cluster_finalizers;
+  cluster_finalizers.push_back(
+      std::make_unique<SimilarVisitDeduperClusterFinalizer>());
+  cluster_finalizers.push_back(
+      std::make_unique<RankingClusterFinalizer>(clustering_request_source));
+  cluster_finalizers.push_back(std::make_unique<LabelClusterFinalizer>());
+  return cluster_finalizers;
+}
+
+// Appends the cluster finalizers that determine the triggerability of a
+// cluster to `cluster_finalizers`.
+void AddTriggerabilityClusterFinalizers(
+    bool engagement_score_provider_is_valid,
+    std::vector<std::unique_ptr<ClusterFinalizer>>& cluster_finalizers) {
+  // Cluster finalizers that affect the keywords for a cluster.
+  cluster_finalizers.push_back(std::make_unique<KeywordClusterFinalizer>());
+
+  // Cluster finalizers that affect the visibility of a cluster.
+  cluster_finalizers.push_back(
+      std::make_unique<ContentVisibilityClusterFinalizer>());
+  cluster_finalizers.push_back(std::make_unique<SingleVisitClusterFinalizer>());
+  if (engagement_score_provider_is_valid) {
+    cluster_finalizers.push_back(std::make_unique<NoisyClusterFinalizer>());
+  }
+}
+
+// Runs the finalizers that affect the appearance of a cluster on the UI surface
+// associated with `clustering_request_source` over `clusters`.
+void FinalizeClustersForUI(ClusteringRequestSource clustering_request_source,
+                           base::span<history::Cluster> clusters) {
+  std::vector<std::unique_ptr<ClusterFinalizer>> cluster_finalizers =
+      CreateUIClusterFinalizers(clustering_request_source);
+  for (auto& cluster : clusters) {
+    for (const auto& finalizer : cluster_finalizers) {
+      finalizer->FinalizeCluster(cluster);
+    }
+  }
+}
+
+// Runs the finalizers that determine the triggerability of a cluster over
+// `clusters`, preceded by the UI finalizers if `from_ui` is false.
+void FinalizeClustersForTriggerability(bool engagement_score_provider_is_valid,
+                                       bool from_ui,
+                                       base::span<history::Cluster> clusters) {
+  // The cluster finalizers to be run.
+  std::vector<std::unique_ptr<ClusterFinalizer>> cluster_finalizers;
+
+  if (!from_ui) {
+    // Cluster finalizers to run that affect the appearance of a cluster on a UI
+    // surface and are run here in case a user goes in and out of the new
+    // context clustering path so that the user will have presentable clusters
+    // when they swap back.
+    // TODO(b/259466296): Remove this block once that path is fully launched.
+    cluster_finalizers =
+        CreateUIClusterFinalizers(ClusteringRequestSource::kJourneysPage);
+  }
+  AddTriggerabilityClusterFinalizers(engagement_score_provider_is_valid,
+                                     cluster_finalizers);
+
+  for (auto& cluster : clusters) {
+    // Initially set this default to true since the finalizers will only set the
+    // visibility to false.
+    cluster.should_show_on_prominent_ui_surfaces = true;
+    for (const auto& finalizer : cluster_finalizers) {
+      finalizer->FinalizeCluster(cluster);
+    }
+    cluster.triggerability_calculated = true;
+  }
+}
+
+// Runs `finalize_clusters` over all of `clusters`, on ThreadPool workers if
+// parallel finalization is enabled and there are enough clusters to benefit.
+void RunClusterFinalizers(std::vector<history::Cluster>& clusters,
+                          const FinalizeClustersCallback& finalize_clusters) {
+  if (GetConfig().finalize_clusters_in_parallel &&
+      clusters.size() >= GetConfig().min_clusters_for_parallel_finalization) {
+    FinalizeClustersInParallel(clusters, finalize_clusters);
+  } else {
+    finalize_clusters.Run(clusters);
+  }
+}
+
 }  // namespace
 
 OnDeviceClusteringBackend::OnDeviceClusteringBackend(
@@ -74,7 +164,13 @@ OnDeviceClusteringBackend::OnDeviceClusteringBackend(
                   ? continue_on_shutdown_best_effort_task_traits_
                   : best_effort_task_traits_)),
       engagement_score_cache_last_refresh_timestamp_(base::TimeTicks::Now()),
-      engagement_score_cache_(GetConfig().engagement_score_cache_size) {
+      engagement_score_cache_(GetConfig().engagement_score_cache_size),
+      incremental_clustering_cache_(
+          GetConfig().use_incremental_clustering
+              ? new IncrementalClusteringCache()
+              : nullptr,
+          base::OnTaskRunnerDeleter(
+              best_effort_priority_background_task_runner_)) {
   if (GetConfig().should_check_hosts_to_skip_clustering_for &&
       optimization_guide_decider) {
     optimization_guide_decider_ = optimization_guide_decider;
@@ -208,11 +304,22 @@ void OnDeviceClusteringBackend::OnAllVisitsFinishedProcessing(
   // Post the actual clustering work onto the thread pool, then reply on the
   // calling sequence. This is to prevent UI jank.
 
+  // Only the update clusters task clusters mostly the same visits over and
+  // over. It runs on `best_effort_priority_background_task_runner_`, where
+  // `incremental_clustering_cache_` is also deleted, so it outlives the task.
+  IncrementalClusteringCache* incremental_clustering_cache =
+      clustering_request_source ==
+                  ClusteringRequestSource::kAllKeywordCacheRefresh &&
+              requires_ui_and_triggerability
+          ? incremental_clustering_cache_.get()
+          : nullptr;
+
   base::OnceCallback<std::vector<history::Cluster>()> clustering_callback =
       base::BindOnce(
           &OnDeviceClusteringBackend::ClusterVisitsOnBackgroundThread,
           clustering_request_source, engagement_score_provider_ != nullptr,
-          std::move(cluster_visits), requires_ui_and_triggerability);
+          std::move(cluster_visits), requires_ui_and_triggerability,
+          base::Unretained(incremental_clustering_cache));
 
   if (IsUIRequestSource(clustering_request_source)) {
     user_visible_priority_background_task_runner_->PostTaskAndReplyWithResult(
@@ -264,7 +371,8 @@ OnDeviceClusteringBackend::ClusterVisitsOnBackgroundThread(
     ClusteringRequestSource clustering_request_source,
     bool engagement_score_provider_is_valid,
     std::vector<history::ClusterVisit> visits,
-    bool requires_ui_and_triggerability) {
+    bool requires_ui_and_triggerability,
+    IncrementalClusteringCache* incremental_clustering_cache) {
   base::ElapsedThreadTimer compute_clusters_timer;
 
   // 1. Group visits into clusters.
@@ -276,7 +384,21 @@ OnDeviceClusteringBackend::ClusterVisitsOnBackgroundThread(
       "History.Clusters.Backend.ContextClusterer.ThreadTime",
       context_clusterer_timer.Elapsed());
 
-  if (requires_ui_and_triggerability) {
+  if (requires_ui_and_triggerability && incremental_clustering_cache) {
+    // 2. Determine how the clusters should be displayed and their
+    // triggerability, reusing the clusters that did not change.
+    base::ElapsedThreadTimer incremental_timer;
+    clusters = FinalizeClustersIncrementallyOnBackgroundThread(
+        clustering_request_source, engagement_score_provider_is_valid,
+        std::move(clusters), *incremental_clustering_cache);
+    base::UmaHistogramTimes(
+        "History.Clusters.Backend.IncrementalClustering.ThreadTime",
+        incremental_timer.Elapsed());
+
+    base::UmaHistogramTimes(
+        "History.Clusters.Backend.ComputeClusters.ThreadTime",
+        compute_clusters_timer.Elapsed());
+  } else if (requires_ui_and_triggerability) {
     // 2. Determine how the clusters should be displayed.
     base::ElapsedThreadTimer compute_clusters_for_ui_timer;
     clusters = GetClustersForUIOnBackgroundThread(
@@ -319,15 +441,6 @@ OnDeviceClusteringBackend::GetClustersForUIOnBackgroundThread(
   cluster_processors.push_back(
       std::make_unique<ClusterSimilarityHeuristicsProcessor>());
 
-  // The cluster finalizers to run that affect the appearance of a cluster on a
-  // UI surface.
-  std::vector<std::unique_ptr<ClusterFinalizer>> cluster_finalizers;
-  cluster_finalizers.push_back(
-      std::make_unique<SimilarVisitDeduperClusterFinalizer>());
-  cluster_finalizers.push_back(
-      std::make_unique<RankingClusterFinalizer>(clustering_request_source));
-  cluster_finalizers.push_back(std::make_unique<LabelClusterFinalizer>());
-
   // Process clusters.
   for (const auto& processor : cluster_processors) {
     processor->ProcessClusters(&clusters);
@@ -335,11 +448,9 @@ OnDeviceClusteringBackend::GetClustersForUIOnBackgroundThread(
 
   // Run finalizers that dedupe and score visits within a cluster and
   // log several metrics about the result.
-  for (auto& cluster : clusters) {
-    for (const auto& finalizer : cluster_finalizers) {
-      finalizer->FinalizeCluster(cluster);
-    }
-  }
+  RunClusterFinalizers(clusters,
+                       base::BindRepeating(&FinalizeClustersForUI,
+                                           clustering_request_source));
 
   // Apply any filtering after we've decided how to score clusters.
   std::unique_ptr<FilterClusterProcessor> filterer =
@@ -361,42 +472,64 @@ OnDeviceClusteringBackend::GetClusterTriggerabilityOnBackgroundThread(
     bool engagement_score_provider_is_valid,
     std::vector<history::Cluster> clusters,
     bool from_ui) {
-  // The cluster finalizers to be run.
-  std::vector<std::unique_ptr<ClusterFinalizer>> cluster_finalizers;
-
-  if (!from_ui) {
-    // Cluster finalizers to run that affect the appearance of a cluster on a UI
-    // surface and are run here in case a user goes in and out of the new
-    // context clustering path so that the user will have presentable clusters
-    // when they swap back.
-    // TODO(b/259466296): Remove this block once that path is fully launched.
-    cluster_finalizers.push_back(
-        std::make_unique<SimilarVisitDeduperClusterFinalizer>());
-    cluster_finalizers.push_back(std::make_unique<RankingClusterFinalizer>(
-        ClusteringRequestSource::kJourneysPage));
-    cluster_finalizers.push_back(std::make_unique<LabelClusterFinalizer>());
-  }
-
-  // Cluster finalizers that affect the keywords for a cluster.
-  cluster_finalizers.push_back(std::make_unique<KeywordClusterFinalizer>());
-
-  // Cluster finalizers that affect the visibility of a cluster.
-  cluster_finalizers.push_back(
-      std::make_unique<ContentVisibilityClusterFinalizer>());
-  cluster_finalizers.push_back(std::make_unique<SingleVisitClusterFinalizer>());
-  if (engagement_score_provider_is_valid) {
-    cluster_finalizers.push_back(std::make_unique<NoisyClusterFinalizer>());
-  }
+  RunClusterFinalizers(
+      clusters,
+      base::BindRepeating(&FinalizeClustersForTriggerability,
+                          engagement_score_provider_is_valid, from_ui));
+  return clusters;
+}
 
+// static
+std::vector<history::Cluster>
+OnDeviceClusteringBackend::FinalizeClustersIncrementallyOnBackgroundThread(
+    ClusteringRequestSource clustering_request_source,
+    bool engagement_score_provider_is_valid,
+    std::vector<history::Cluster> clusters,
+    IncrementalClusteringCache& incremental_clustering_cache) {
+  // The cluster processors still run over all clusters: they are what assigns
+  // the new visits to existing clusters.
+  QueryClustersFilterParams filter_params;
+  ClusterInteractionStateProcessor(filter_params).ProcessClusters(&clusters);
+  ClusterSimilarityHeuristicsProcessor().ProcessClusters(&clusters);
+
+  // The same finalizers, in the same order, as
+  // `GetClustersForUIOnBackgroundThread()` followed by
+  // `GetClusterTriggerabilityOnBackgroundThread()`. The filter run in between
+  // is a no-op with the default filter params.
+  std::vector<std::unique_ptr<ClusterFinalizer>> ui_cluster_finalizers =
+      CreateUIClusterFinalizers(clustering_request_source);
+  std::vector<std::unique_ptr<ClusterFinalizer>>
+      triggerability_cluster_finalizers;
+  AddTriggerabilityClusterFinalizers(engagement_score_provider_is_valid,
+                                     triggerability_cluster_finalizers);
+
+  size_t num_reused_clusters = 0;
   for (auto& cluster : clusters) {
-    // Initially set this default to true since the finalizers will only set the
-    // visibility to false.
+    if (incremental_clustering_cache.ReuseFinalizedCluster(cluster)) {
+      num_reused_clusters++;
+      continue;
+    }
+
+    history::Cluster processed_cluster = cluster;
+    for (const auto& finalizer : ui_cluster_finalizers) {
+      finalizer->FinalizeCluster(cluster);
+    }
     cluster.should_show_on_prominent_ui_surfaces = true;
-    for (const auto& finalizer : cluster_finalizers) {
+    for (const auto& finalizer : triggerability_cluster_finalizers) {
       finalizer->FinalizeCluster(cluster);
     }
     cluster.triggerability_calculated = true;
+    incremental_clustering_cache.AddFinalizedCluster(processed_cluster,
+                                                     cluster);
   }
+  incremental_clustering_cache.FinishPass();
+
+  base::UmaHistogramCounts1000(
+      "History.Clusters.Backend.IncrementalClustering.NumClustersReused",
+      static_cast<int>(num_reused_clusters));
+  base::UmaHistogramCounts1000(
+      "History.Clusters.Backend.IncrementalClustering.NumClustersFinalized",
+      static_cast<int>(clusters.size() - num_reused_clusters));
 
   return clusters;
 }
@@ -5,6 +5,8 @@
 #ifndef COMPONENTS_HISTORY_CLUSTERS_CORE_ON_DEVICE_CLUSTERING_BACKEND_H_
 #define COMPONENTS_HISTORY_CLUSTERS_CORE_ON_DEVICE_CLUSTERING_BACKEND_H_
 
+#include <memory>
+
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/containers/lru_cache.h"
@@ -28,6 +30,8 @@ class SiteEngagementScoreProvider;
 
 namespace history_clusters {
 
+class IncrementalClusteringCache;
+
 // A clustering backend that clusters visits on device.
 class OnDeviceClusteringBackend : public ClusteringBackend {
  public:
@@ -78,12 +82,26 @@ class OnDeviceClusteringBackend : public ClusteringBackend {
       ClustersCallback callback,
       std::vector<history::Cluster> clusters);
 
-  // Clusters `visits` on background thread.
+  // Clusters `visits` on background thread. If `incremental_clustering_cache`
+  // is non-null, clusters that did not change since the previous call with the
+  // same cache are reused from it.
   static std::vector<history::Cluster> ClusterVisitsOnBackgroundThread(
       ClusteringRequestSource clustering_request_source,
       bool engagement_score_provider_is_valid,
       std::vector<history::ClusterVisit> visits,
-      bool requires_ui_and_triggerability);
+      bool requires_ui_and_triggerability,
+      IncrementalClusteringCache* incremental_clustering_cache);
+
+  // Determines how `clusters` should be displayed and their triggerability,
+  // like `GetClustersForUIOnBackgroundThread()` followed by
+  // `GetClusterTriggerabilityOnBackgroundThread()`, but only finalizes the
+  // clusters that cannot be reused from `incremental_clustering_cache`.
+  static std::vector<history::Cluster>
+  FinalizeClustersIncrementallyOnBackgroundThread(
+      ClusteringRequestSource clustering_request_source,
+      bool engagement_score_provider_is_valid,
+      std::vector<history::Cluster> clusters,
+      IncrementalClusteringCache& incremental_clustering_cache);
 
   // Gets the displayable variant of `clusters` that will be shown on the UI
   // surface associated with `clustering_request_source` on background thread.
@@ -141,6 +159,11 @@ class OnDeviceClusteringBackend : public ClusteringBackend {
   // URL host to score mapping.
   base::HashingLRUCache<std::string, float> engagement_score_cache_;
 
+  // The clusters of the previous update, if incremental clustering is enabled.
+  // Only used and deleted on `best_effort_priority_background_task_runner_`.
+  std::unique_ptr<IncrementalClusteringCache, base::OnTaskRunnerDeleter>
+      incremental_clustering_cache_;
+
   SEQUENCE_CHECKER(sequence_checker_);
 
   base::WeakPtrFactory<OnDeviceClusteringBackend> weak_ptr_factory_{this};
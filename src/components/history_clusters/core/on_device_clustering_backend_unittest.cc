@@ -513,6 +513,86 @@ TEST_F(OnDeviceClusteringWithoutContentBackendTest,
                                       testing::VisitResult(1, 1.0))));
 }
 
+class OnDeviceClusteringIncrementalBackendTest
+    : public OnDeviceClusteringWithoutContentBackendTest {
+ public:
+  OnDeviceClusteringIncrementalBackendTest() {
+    Config config = GetConfig();
+    config.use_incremental_clustering = true;
+    SetConfigForTesting(config);
+  }
+};
+
+TEST_F(OnDeviceClusteringIncrementalBackendTest, ReusesUnchangedClusters) {
+  std::vector<history::AnnotatedVisit> visits;
+  history::AnnotatedVisit visit = testing::CreateDefaultAnnotatedVisit(
+      1, GURL("https://github.com/"), base::Time::FromTimeT(1));
+  visits.push_back(visit);
+  history::AnnotatedVisit visit2 = testing::CreateDefaultAnnotatedVisit(
+      2, GURL("https://google.com/"), base::Time::FromTimeT(2));
+  visit2.referring_visit_of_redirect_chain_start = 1;
+  visits.push_back(visit2);
+  history::AnnotatedVisit visit3 = testing::CreateDefaultAnnotatedVisit(
+      3, GURL("https://example.com/"), base::Time::FromTimeT(3));
+  visits.push_back(visit3);
+
+  std::vector<history::Cluster> first_clusters;
+  {
+    base::HistogramTester histogram_tester;
+    first_clusters =
+        ClusterVisits(ClusteringRequestSource::kAllKeywordCacheRefresh, visits);
+    histogram_tester.ExpectUniqueSample(
+        "History.Clusters.Backend.IncrementalClustering.NumClustersReused", 0,
+        1);
+    histogram_tester.ExpectUniqueSample(
+        "History.Clusters.Backend.IncrementalClustering.NumClustersFinalized",
+        2, 1);
+  }
+
+  // Clustering the same visits again reuses both clusters.
+  {
+    base::HistogramTester histogram_tester;
+    std::vector<history::Cluster> clusters =
+        ClusterVisits(ClusteringRequestSource::kAllKeywordCacheRefresh, visits);
+    histogram_tester.ExpectUniqueSample(
+        "History.Clusters.Backend.IncrementalClustering.NumClustersReused", 2,
+        1);
+    EXPECT_EQ(testing::ToVisitResults(first_clusters),
+              testing::ToVisitResults(clusters));
+    ASSERT_EQ(first_clusters.size(), clusters.size());
+    for (size_t i = 0; i < clusters.size(); ++i) {
+      EXPECT_EQ(first_clusters[i].label, clusters[i].label);
+      EXPECT_TRUE(clusters[i].triggerability_calculated);
+    }
+  }
+
+  // A new visit joining the second cluster only finalizes that cluster.
+  history::AnnotatedVisit visit4 = testing::CreateDefaultAnnotatedVisit(
+      4, GURL("https://example.com/next"), base::Time::FromTimeT(4));
+  visit4.referring_visit_of_redirect_chain_start = 3;
+  visits.push_back(visit4);
+  {
+    base::HistogramTester histogram_tester;
+    std::vector<history::Cluster> clusters =
+        ClusterVisits(ClusteringRequestSource::kAllKeywordCacheRefresh, visits);
+    histogram_tester.ExpectUniqueSample(
+        "History.Clusters.Backend.IncrementalClustering.NumClustersReused", 1,
+        1);
+    histogram_tester.ExpectUniqueSample(
+        "History.Clusters.Backend.IncrementalClustering.NumClustersFinalized",
+        1, 1);
+    EXPECT_EQ(clusters.size(), 2u);
+  }
+
+  // UI requests never use the cache.
+  {
+    base::HistogramTester histogram_tester;
+    ClusterVisits(ClusteringRequestSource::kJourneysPage, visits);
+    histogram_tester.ExpectTotalCount(
+        "History.Clusters.Backend.IncrementalClustering.NumClustersReused", 0);
+  }
+}
+
 class OnDeviceClusteringWithAllTheBackendsTest
     : public OnDeviceClusteringWithoutContentBackendTest {
  public:
@@ -34,5 +34,13 @@ BASE_FEATURE(kOnDeviceClusteringVisitRanking,
              "JourneysOnDeviceClusteringVisitRanking",
              base::FEATURE_DISABLED_BY_DEFAULT);
 
+BASE_FEATURE(kOnDeviceClusteringIncremental,
+             "JourneysOnDeviceClusteringIncremental",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+BASE_FEATURE(kOnDeviceClusteringParallelFinalization,
+             "JourneysOnDeviceClusteringParallelFinalization",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 }  // namespace features
 }  // namespace history_clusters
@@ -29,6 +29,14 @@ BASE_DECLARE_FEATURE(kOnDeviceClusteringKeywordFiltering);
 // Specifies how visits within clusters are ranked.
 BASE_DECLARE_FEATURE(kOnDeviceClusteringVisitRanking);
 
+// Reuses the finalized clusters of the previous update for clusters whose
+// visits did not change.
+BASE_DECLARE_FEATURE(kOnDeviceClusteringIncremental);
+
+// Runs the cluster finalizers over chunks of clusters on ThreadPool workers
+// instead of one cluster at a time on the clustering sequence.
+BASE_DECLARE_FEATURE(kOnDeviceClusteringParallelFinalization);
+
 }  // namespace features
 }  // namespace history_clusters
 
@@ -0,0 +1,84 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/history_clusters/core/parallel_cluster_finalizer.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "base/functional/bind.h"
+#include "base/memory/raw_ref.h"
+#include "base/task/post_job.h"
+#include "base/task/task_traits.h"
+#include "base/trace_event/trace_event.h"
+
+namespace history_clusters {
+
+namespace {
+
+// Number of clusters each job worker claims at a time. Large enough to
+// amortize creating the finalizers, small enough to balance clusters of very
+// different sizes across workers.
+constexpr size_t kClustersPerParallelChunk = 16;
+
+class ParallelClusterFinalizer {
+ public:
+  ParallelClusterFinalizer(std::vector<history::Cluster>& clusters,
+                           const FinalizeClustersCallback& finalize_clusters)
+      : clusters_(clusters), finalize_clusters_(finalize_clusters) {}
+  ParallelClusterFinalizer(const ParallelClusterFinalizer&) = delete;
+  ParallelClusterFinalizer& operator=(const ParallelClusterFinalizer&) =
+      delete;
+
+  void Run() {
+    // Join() raises the priority of the job to that of the calling thread.
+    base::CreateJob(
+        FROM_HERE, {base::TaskPriority::BEST_EFFORT},
+        base::BindRepeating(&ParallelClusterFinalizer::RunChunks,
+                            base::Unretained(this)),
+        base::BindRepeating(&ParallelClusterFinalizer::GetMaxConcurrency,
+                            base::Unretained(this)))
+        .Join();
+  }
+
+ private:
+  void RunChunks(base::JobDelegate* delegate) {
+    TRACE_EVENT0("browser", "ParallelClusterFinalizer::RunChunks");
+    const size_t num_clusters = clusters_->size();
+    while (!delegate->ShouldYield()) {
+      size_t begin = next_cluster_.fetch_add(kClustersPerParallelChunk,
+                                             std::memory_order_relaxed);
+      if (begin >= num_clusters) {
+        return;
+      }
+      size_t end = std::min(begin + kClustersPerParallelChunk, num_clusters);
+      finalize_clusters_->Run(
+          base::span(*clusters_).subspan(begin, end - begin));
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const {
+    size_t next_cluster = next_cluster_.load(std::memory_order_relaxed);
+    size_t num_clusters = clusters_->size();
+    if (next_cluster >= num_clusters) {
+      return 0;
+    }
+    return (num_clusters - next_cluster + kClustersPerParallelChunk - 1) /
+           kClustersPerParallelChunk;
+  }
+
+  const raw_ref<std::vector<history::Cluster>> clusters_;
+  const raw_ref<const FinalizeClustersCallback> finalize_clusters_;
+  std::atomic<size_t> next_cluster_{0};
+};
+
+}  // namespace
+
+void FinalizeClustersInParallel(
+    std::vector<history::Cluster>& clusters,
+    const FinalizeClustersCallback& finalize_clusters) {
+  ParallelClusterFinalizer(clusters, finalize_clusters).Run();
+}
+
+}  // namespace history_clusters
@@ -0,0 +1,32 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_HISTORY_CLUSTERS_CORE_PARALLEL_CLUSTER_FINALIZER_H_
+#define COMPONENTS_HISTORY_CLUSTERS_CORE_PARALLEL_CLUSTER_FINALIZER_H_
+
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/functional/callback.h"
+#include "components/history/core/browser/history_types.h"
+
+namespace history_clusters {
+
+// Called with a contiguous chunk of clusters to finalize in place.
+using FinalizeClustersCallback =
+    base::RepeatingCallback<void(base::span<history::Cluster>)>;
+
+// Runs `finalize_clusters` over chunks of `clusters` on ThreadPool workers,
+// with the calling thread participating, and returns once every cluster has
+// been finalized. Clusters are finalized in place, so their order is
+// unchanged. `finalize_clusters` is run concurrently on disjoint chunks, so it
+// must not share mutable state between calls; creating the finalizers within
+// the callback guarantees this.
+void FinalizeClustersInParallel(
+    std::vector<history::Cluster>& clusters,
+    const FinalizeClustersCallback& finalize_clusters);
+
+}  // namespace history_clusters
+
+#endif  // COMPONENTS_HISTORY_CLUSTERS_CORE_PARALLEL_CLUSTER_FINALIZER_H_
@@ -0,0 +1,152 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/containers/span.h"
+#include "base/functional/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/test/task_environment.h"
+#include "base/timer/elapsed_timer.h"
+#include "components/history_clusters/core/cluster_finalizer.h"
+#include "components/history_clusters/core/clustering_test_utils.h"
+#include "components/history_clusters/core/content_visibility_cluster_finalizer.h"
+#include "components/history_clusters/core/keyword_cluster_finalizer.h"
+#include "components/history_clusters/core/label_cluster_finalizer.h"
+#include "components/history_clusters/core/noisy_cluster_finalizer.h"
+#include "components/history_clusters/core/parallel_cluster_finalizer.h"
+#include "components/history_clusters/core/ranking_cluster_finalizer.h"
+#include "components/history_clusters/core/similar_visit_deduper_cluster_finalizer.h"
+#include "components/history_clusters/core/single_visit_cluster_finalizer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// This file compares running the cluster finalizers over the clusters one at
+// a time with running them over chunks of clusters on ThreadPool workers.
+
+namespace history_clusters {
+
+namespace {
+
+constexpr char kMetricPrefixClusterFinalizer[] = "ClusterFinalizer.";
+constexpr char kMetricFinalizeTime[] = "finalize_time";
+
+constexpr size_t kVisitsPerCluster = 10u;
+constexpr size_t kNumHosts = 200u;
+constexpr size_t kNumEntities = 500u;
+constexpr size_t kNumIterations = 10u;
+
+// Debug builds can be quite slow. Use fewer visits to test.
+#if defined(NDEBUG)
+constexpr size_t kNumVisits = 10000u;
+#else
+constexpr size_t kNumVisits = 1000u;
+#endif
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story_name) {
+  perf_test::PerfResultReporter reporter(kMetricPrefixClusterFinalizer,
+                                         story_name);
+  reporter.RegisterImportantMetric(kMetricFinalizeTime, "ms");
+  return reporter;
+}
+
+// Runs the finalizers of a full clustering pass, in the order the
+// OnDeviceClusteringBackend runs them, over `clusters`.
+void FinalizeClusters(base::span<history::Cluster> clusters) {
+  std::vector<std::unique_ptr<ClusterFinalizer>> cluster_finalizers;
+  cluster_finalizers.push_back(
+      std::make_unique<SimilarVisitDeduperClusterFinalizer>());
+  cluster_finalizers.push_back(std::make_unique<RankingClusterFinalizer>(
+      ClusteringRequestSource::kJourneysPage));
+  cluster_finalizers.push_back(std::make_unique<LabelClusterFinalizer>());
+  cluster_finalizers.push_back(std::make_unique<KeywordClusterFinalizer>());
+  cluster_finalizers.push_back(
+      std::make_unique<ContentVisibilityClusterFinalizer>());
+  cluster_finalizers.push_back(std::make_unique<SingleVisitClusterFinalizer>());
+  cluster_finalizers.push_back(std::make_unique<NoisyClusterFinalizer>());
+
+  for (auto& cluster : clusters) {
+    cluster.should_show_on_prominent_ui_surfaces = true;
+    for (const auto& finalizer : cluster_finalizers) {
+      finalizer->FinalizeCluster(cluster);
+    }
+    cluster.triggerability_calculated = true;
+  }
+}
+
+class ParallelClusterFinalizerPerfTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    std::vector<history::ClusterVisit> cluster_visits;
+    for (size_t i = 0; i < kNumVisits; ++i) {
+      const std::string host = "site" + base::NumberToString(i % kNumHosts);
+      history::ClusterVisit visit =
+          testing::CreateClusterVisit(testing::CreateDefaultAnnotatedVisit(
+              i + 1, GURL("https://" + host + ".com/page" +
+                          base::NumberToString(i / 3))));
+      visit.engagement_score = i % 20;
+      visit.annotated_visit.visit_row.visit_duration =
+          base::Seconds(i % 60 + 1);
+      auto& model_annotations =
+          visit.annotated_visit.content_annotations.model_annotations;
+      model_annotations.entities = {
+          {"entity" + base::NumberToString(i % kNumEntities), 90},
+          {"entity" + base::NumberToString((i * 7) % kNumEntities), 60}};
+      model_annotations.categories = {{"category", 80}};
+      model_annotations.visibility_score = 0.9;
+      if (i % 5 == 0) {
+        visit.annotated_visit.content_annotations.search_terms =
+            base::UTF8ToUTF16(host);
+      }
+      cluster_visits.push_back(std::move(visit));
+
+      if (cluster_visits.size() == kVisitsPerCluster) {
+        clusters_.push_back(testing::CreateCluster(cluster_visits));
+        cluster_visits.clear();
+      }
+    }
+  }
+
+  // Finalizes copies of the clusters with `finalize` and reports the average
+  // time taken.
+  template <typename Finalize>
+  void RunFinalizePerfTest(const std::string& story_name, Finalize finalize) {
+    base::TimeDelta finalize_time;
+    for (size_t i = 0; i < kNumIterations; ++i) {
+      std::vector<history::Cluster> clusters = clusters_;
+      base::ElapsedTimer timer;
+      finalize(clusters);
+      finalize_time += timer.Elapsed();
+      EXPECT_TRUE(clusters.back().triggerability_calculated);
+    }
+
+    auto reporter = SetUpReporter(story_name);
+    reporter.AddResult(kMetricFinalizeTime,
+                       finalize_time.InMillisecondsF() / kNumIterations);
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  std::vector<history::Cluster> clusters_;
+};
+
+}  // namespace
+
+TEST_F(ParallelClusterFinalizerPerfTest, Serial) {
+  RunFinalizePerfTest("Serial", [](std::vector<history::Cluster>& clusters) {
+    FinalizeClusters(clusters);
+  });
+}
+
+TEST_F(ParallelClusterFinalizerPerfTest, Parallel) {
+  RunFinalizePerfTest("Parallel", [](std::vector<history::Cluster>& clusters) {
+    FinalizeClustersInParallel(clusters,
+                               base::BindRepeating(&FinalizeClusters));
+  });
+}
+
+}  // namespace history_clusters
@@ -0,0 +1,60 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/history_clusters/core/parallel_cluster_finalizer.h"
+
+#include <atomic>
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace history_clusters {
+namespace {
+
+class ParallelClusterFinalizerTest : public ::testing::Test {
+ private:
+  base::test::TaskEnvironment task_environment_;
+};
+
+TEST_F(ParallelClusterFinalizerTest, FinalizesEveryClusterOnceInOrder) {
+  constexpr size_t kNumClusters = 1000;
+  std::vector<history::Cluster> clusters(kNumClusters);
+  for (size_t i = 0; i < kNumClusters; ++i) {
+    clusters[i].cluster_id = i;
+  }
+
+  std::atomic<size_t> num_finalized{0};
+  FinalizeClustersInParallel(
+      clusters, base::BindRepeating(
+                    [](std::atomic<size_t>* num_finalized,
+                       base::span<history::Cluster> chunk) {
+                      for (auto& cluster : chunk) {
+                        EXPECT_FALSE(cluster.triggerability_calculated);
+                        cluster.triggerability_calculated = true;
+                      }
+                      num_finalized->fetch_add(chunk.size());
+                    },
+                    &num_finalized));
+
+  EXPECT_EQ(num_finalized.load(), kNumClusters);
+  ASSERT_EQ(clusters.size(), kNumClusters);
+  for (size_t i = 0; i < kNumClusters; ++i) {
+    EXPECT_EQ(clusters[i].cluster_id, static_cast<int64_t>(i));
+    EXPECT_TRUE(clusters[i].triggerability_calculated);
+  }
+}
+
+TEST_F(ParallelClusterFinalizerTest, NoClusters) {
+  std::vector<history::Cluster> clusters;
+  FinalizeClustersInParallel(
+      clusters, base::BindRepeating([](base::span<history::Cluster> chunk) {
+        ADD_FAILURE() << "Called without clusters";
+      }));
+  EXPECT_TRUE(clusters.empty());
+}
+
+}  // namespace
+}  // namespace history_clusters
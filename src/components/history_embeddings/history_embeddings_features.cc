@@ -59,4 +59,12 @@ const base::FeatureParam<int> kEmbedderNumThreads(&kHistoryEmbeddings,
                                                   "EmbeddingsNumThreads",
                                                   4);
 
+const base::FeatureParam<bool> kUseIvfIndex(&kHistoryEmbeddings,
+                                            "UseIvfIndex",
+                                            false);
+
+const base::FeatureParam<int> kIvfIndexProbeCount(&kHistoryEmbeddings,
+                                                  "IvfIndexProbeCount",
+                                                  8);
+
 }  // namespace history_embeddings
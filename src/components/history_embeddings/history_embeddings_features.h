@@ -52,6 +52,14 @@ extern const base::FeatureParam<bool> kSendQualityLog;
 // to use the default number of threads.
 extern const base::FeatureParam<int> kEmbedderNumThreads;
 
+// Whether the database maintains an inverted file index over the embeddings,
+// and uses it to only search the URLs near the query instead of all of them.
+extern const base::FeatureParam<bool> kUseIvfIndex;
+
+// The number of index clusters searched per query. More clusters find more of
+// the exact nearest URLs, at the cost of searching more of them.
+extern const base::FeatureParam<int> kIvfIndexProbeCount;
+
 }  // namespace history_embeddings
 
 #endif  // COMPONENTS_HISTORY_EMBEDDINGS_HISTORY_EMBEDDINGS_FEATURES_H_
@@ -0,0 +1,137 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/history_embeddings/ivf_index.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "base/check_op.h"
+
+namespace history_embeddings {
+
+namespace {
+
+// Lloyd iterations of k-means. A coarse quantizer doesn't need to converge, as
+// searches probe several clusters anyway.
+constexpr size_t kTrainingIterations = 8;
+
+}  // namespace
+
+// static
+std::vector<Embedding> IvfIndex::TrainCentroids(
+    const std::vector<Embedding>& sample,
+    size_t cluster_count) {
+  cluster_count = std::min(cluster_count, sample.size());
+  if (cluster_count == 0) {
+    return {};
+  }
+
+  // Start from embeddings far apart: each one is the least similar to all of
+  // the ones before it.
+  std::vector<Embedding> centroids;
+  centroids.reserve(cluster_count);
+  centroids.push_back(sample[0]);
+  std::vector<float> best_scores(sample.size(),
+                                 std::numeric_limits<float>::lowest());
+  while (centroids.size() < cluster_count) {
+    size_t farthest = 0;
+    for (size_t i = 0; i < sample.size(); i++) {
+      best_scores[i] =
+          std::max(best_scores[i], centroids.back().ScoreWith(sample[i]));
+      if (best_scores[i] < best_scores[farthest]) {
+        farthest = i;
+      }
+    }
+    centroids.push_back(sample[farthest]);
+  }
+
+  const size_t dimensions = sample[0].Dimensions();
+  std::vector<size_t> assignments(sample.size());
+  for (size_t iteration = 0; iteration < kTrainingIterations; iteration++) {
+    IvfIndex index(std::move(centroids));
+    bool changed = false;
+    for (size_t i = 0; i < sample.size(); i++) {
+      const size_t cluster = index.NearestCluster(sample[i]);
+      changed |= iteration == 0 || cluster != assignments[i];
+      assignments[i] = cluster;
+    }
+    centroids = std::move(index.centroids_);
+    if (!changed) {
+      break;
+    }
+
+    std::vector<std::vector<float>> sums(cluster_count,
+                                         std::vector<float>(dimensions, 0.0f));
+    std::vector<size_t> sizes(cluster_count, 0u);
+    for (size_t i = 0; i < sample.size(); i++) {
+      const std::vector<float>& data = sample[i].GetData();
+      std::vector<float>& sum = sums[assignments[i]];
+      for (size_t d = 0; d < dimensions; d++) {
+        sum[d] += data[d];
+      }
+      sizes[assignments[i]]++;
+    }
+    for (size_t cluster = 0; cluster < cluster_count; cluster++) {
+      // An empty cluster keeps its previous centroid.
+      if (sizes[cluster] == 0) {
+        continue;
+      }
+      Embedding centroid(std::move(sums[cluster]));
+      if (centroid.Magnitude() > 0.0f) {
+        centroid.Normalize();
+        centroids[cluster] = std::move(centroid);
+      }
+    }
+  }
+  return centroids;
+}
+
+IvfIndex::IvfIndex(std::vector<Embedding> centroids)
+    : centroids_(std::move(centroids)) {
+  CHECK(!centroids_.empty());
+}
+
+IvfIndex::~IvfIndex() = default;
+IvfIndex::IvfIndex(IvfIndex&&) = default;
+IvfIndex& IvfIndex::operator=(IvfIndex&&) = default;
+
+size_t IvfIndex::NearestCluster(const Embedding& embedding) const {
+  CHECK_EQ(embedding.Dimensions(), centroids_[0].Dimensions());
+  size_t nearest = 0;
+  float best_score = std::numeric_limits<float>::lowest();
+  for (size_t i = 0; i < centroids_.size(); i++) {
+    const float score = centroids_[i].ScoreWith(embedding);
+    if (score > best_score) {
+      best_score = score;
+      nearest = i;
+    }
+  }
+  return nearest;
+}
+
+std::vector<size_t> IvfIndex::NearestClusters(const Embedding& query,
+                                              size_t count) const {
+  CHECK_EQ(query.Dimensions(), centroids_[0].Dimensions());
+  std::vector<std::pair<float, size_t>> scored;
+  scored.reserve(centroids_.size());
+  for (size_t i = 0; i < centroids_.size(); i++) {
+    scored.emplace_back(centroids_[i].ScoreWith(query), i);
+  }
+  count = std::min(count, scored.size());
+  std::partial_sort(scored.begin(), scored.begin() + count, scored.end(),
+                    [](const auto& a, const auto& b) {
+                      return a.first > b.first;
+                    });
+
+  std::vector<size_t> clusters;
+  clusters.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    clusters.push_back(scored[i].second);
+  }
+  return clusters;
+}
+
+}  // namespace history_embeddings
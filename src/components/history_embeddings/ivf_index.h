@@ -0,0 +1,51 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_HISTORY_EMBEDDINGS_IVF_INDEX_H_
+#define COMPONENTS_HISTORY_EMBEDDINGS_IVF_INDEX_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "components/history_embeddings/vector_database.h"
+
+namespace history_embeddings {
+
+// The coarse quantizer of an inverted file (IVF) index. Embeddings are
+// partitioned into clusters around a set of centroids, and each cluster keeps a
+// list of the items with an embedding in it. An approximate search then only
+// scores the items in the few clusters whose centroids are nearest to the
+// query. The lists themselves are kept by the storage, see `SqlDatabase`.
+class IvfIndex {
+ public:
+  // Trains `cluster_count` centroids on `sample` with spherical k-means, so
+  // that all centroids have unit length like the embeddings. Returns fewer
+  // centroids if `sample` has fewer embeddings than `cluster_count`.
+  static std::vector<Embedding> TrainCentroids(
+      const std::vector<Embedding>& sample,
+      size_t cluster_count);
+
+  explicit IvfIndex(std::vector<Embedding> centroids);
+  ~IvfIndex();
+  IvfIndex(IvfIndex&&);
+  IvfIndex& operator=(IvfIndex&&);
+
+  // Returns the cluster of `embedding`, the one with the nearest centroid.
+  size_t NearestCluster(const Embedding& embedding) const;
+
+  // Returns the clusters of the `count` centroids nearest to `query`, nearest
+  // first.
+  std::vector<size_t> NearestClusters(const Embedding& query,
+                                      size_t count) const;
+
+  const std::vector<Embedding>& centroids() const { return centroids_; }
+
+ private:
+  std::vector<Embedding> centroids_;
+};
+
+}  // namespace history_embeddings
+
+#endif  // COMPONENTS_HISTORY_EMBEDDINGS_IVF_INDEX_H_
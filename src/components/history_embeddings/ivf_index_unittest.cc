@@ -0,0 +1,92 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/history_embeddings/ivf_index.h"
+
+#include <vector>
+
+#include "base/rand_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace history_embeddings {
+
+namespace {
+
+constexpr size_t kSize = 64u;
+
+Embedding RandomEmbedding() {
+  std::vector<float> random_vector(kSize, 0.0f);
+  for (float& v : random_vector) {
+    v = base::RandFloat() * 2.0f - 1.0f;
+  }
+  Embedding embedding(std::move(random_vector));
+  embedding.Normalize();
+  return embedding;
+}
+
+// Returns `center` moved slightly in a random direction.
+Embedding NearbyEmbedding(const Embedding& center) {
+  std::vector<float> data = center.GetData();
+  for (float& v : data) {
+    v += (base::RandFloat() * 2.0f - 1.0f) * 0.02f;
+  }
+  Embedding embedding(std::move(data));
+  embedding.Normalize();
+  return embedding;
+}
+
+}  // namespace
+
+TEST(HistoryEmbeddingsIvfIndexTest, TrainsOneClusterPerGroup) {
+  constexpr size_t kClusterCount = 8u;
+  std::vector<Embedding> centers;
+  for (size_t i = 0; i < kClusterCount; i++) {
+    centers.push_back(RandomEmbedding());
+  }
+  std::vector<Embedding> sample;
+  for (size_t i = 0; i < 50 * kClusterCount; i++) {
+    sample.push_back(NearbyEmbedding(centers[i % kClusterCount]));
+  }
+
+  IvfIndex index(IvfIndex::TrainCentroids(sample, kClusterCount));
+  ASSERT_EQ(index.centroids().size(), kClusterCount);
+  for (const Embedding& centroid : index.centroids()) {
+    EXPECT_NEAR(centroid.Magnitude(), 1.0f, 0.001f);
+  }
+
+  // Embeddings near the same center share a cluster, which is the nearest to
+  // its center.
+  for (size_t i = 0; i < sample.size(); i++) {
+    const size_t cluster = index.NearestCluster(sample[i]);
+    EXPECT_EQ(cluster, index.NearestCluster(sample[i % kClusterCount]));
+    EXPECT_EQ(cluster,
+              index.NearestClusters(centers[i % kClusterCount], 1).front());
+  }
+}
+
+TEST(HistoryEmbeddingsIvfIndexTest, SmallSample) {
+  std::vector<Embedding> sample = {RandomEmbedding(), RandomEmbedding()};
+  EXPECT_EQ(IvfIndex::TrainCentroids(sample, 16).size(), 2u);
+  EXPECT_TRUE(IvfIndex::TrainCentroids({}, 16).empty());
+}
+
+TEST(HistoryEmbeddingsIvfIndexTest, NearestClustersInOrder) {
+  std::vector<Embedding> centroids;
+  for (size_t i = 0; i < 20; i++) {
+    centroids.push_back(RandomEmbedding());
+  }
+  const Embedding query = RandomEmbedding();
+  IvfIndex index(centroids);
+
+  const std::vector<size_t> clusters = index.NearestClusters(query, 5);
+  ASSERT_EQ(clusters.size(), 5u);
+  EXPECT_EQ(clusters[0], index.NearestCluster(query));
+  for (size_t i = 1; i < clusters.size(); i++) {
+    EXPECT_GE(centroids[clusters[i - 1]].ScoreWith(query),
+              centroids[clusters[i]].ScoreWith(query));
+  }
+  EXPECT_EQ(index.NearestClusters(query, 100).size(), centroids.size());
+}
+
+}  // namespace history_embeddings
@@ -0,0 +1,157 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifdef UNSAFE_BUFFERS_BUILD
+// TODO(crbug.com/40284755): Remove this and spanify to fix the errors.
+#pragma allow_unsafe_buffers
+#endif
+
+#include "components/history_embeddings/quantized_embeddings.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/check_op.h"
+#include "build/build_config.h"
+#include "components/history_embeddings/vector_database.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <immintrin.h>
+
+#include "base/cpu.h"
+#elif defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#endif
+
+namespace history_embeddings {
+
+namespace {
+
+constexpr float kMaxQuantizedValue = 127.0f;
+
+// Dot product of `size` elements, for any CPU.
+int32_t DotProduct(const int8_t* a, const int8_t* b, size_t size) {
+  int32_t sum = 0;
+  for (size_t i = 0; i < size; i++) {
+    sum += int32_t{a[i]} * int32_t{b[i]};
+  }
+  return sum;
+}
+
+#if defined(ARCH_CPU_X86_FAMILY)
+// Same as DotProduct(), for CPUs with AVX2, which Chrome doesn't otherwise
+// require on x86.
+__attribute__((target("avx2"))) int32_t DotProductAvx2(const int8_t* a,
+                                                       const int8_t* b,
+                                                       size_t size) {
+  __m256i sum = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    // Widen 16 elements to 16 bits, then multiply and add adjacent pairs into
+    // 8 32-bit sums. The products can't overflow, as the values are within
+    // [-127, 127].
+    const __m256i a16 = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+    const __m256i b16 = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a16, b16));
+  }
+  __m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                                 _mm256_extracti128_si256(sum, 1));
+  sum128 = _mm_hadd_epi32(sum128, sum128);
+  sum128 = _mm_hadd_epi32(sum128, sum128);
+  return _mm_cvtsi128_si32(sum128) + DotProduct(a + i, b + i, size - i);
+}
+#elif defined(ARCH_CPU_ARM64)
+// Same as DotProduct(), with NEON, which all ARM64 CPUs have.
+int32_t DotProductNeon(const int8_t* a, const int8_t* b, size_t size) {
+  int32x4_t sum = vdupq_n_s32(0);
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const int8x16_t a8 = vld1q_s8(a + i);
+    const int8x16_t b8 = vld1q_s8(b + i);
+    // Multiply into 16-bit products, then add adjacent pairs into the 32-bit
+    // sums.
+    sum = vpadalq_s16(sum, vmull_s8(vget_low_s8(a8), vget_low_s8(b8)));
+    sum = vpadalq_s16(sum, vmull_high_s8(a8, b8));
+  }
+  return vaddvq_s32(sum) + DotProduct(a + i, b + i, size - i);
+}
+#endif
+
+int32_t FastDotProduct(const int8_t* a, const int8_t* b, size_t size) {
+#if defined(ARCH_CPU_X86_FAMILY)
+  static const bool has_avx2 = base::CPU().has_avx2();
+  if (has_avx2) {
+    return DotProductAvx2(a, b, size);
+  }
+  return DotProduct(a, b, size);
+#elif defined(ARCH_CPU_ARM64)
+  return DotProductNeon(a, b, size);
+#else
+  return DotProduct(a, b, size);
+#endif
+}
+
+// Quantizes `data` into `values`, returning the scale.
+float QuantizeInto(const std::vector<float>& data, int8_t* values) {
+  float max_magnitude = 0.0f;
+  for (float s : data) {
+    max_magnitude = std::max(max_magnitude, std::abs(s));
+  }
+  if (max_magnitude == 0.0f) {
+    std::fill_n(values, data.size(), 0);
+    return 0.0f;
+  }
+  const float scale = max_magnitude / kMaxQuantizedValue;
+  for (size_t i = 0; i < data.size(); i++) {
+    values[i] = static_cast<int8_t>(std::lround(data[i] / scale));
+  }
+  return scale;
+}
+
+}  // namespace
+
+QuantizedEmbeddings::Query::Query() = default;
+QuantizedEmbeddings::Query::~Query() = default;
+QuantizedEmbeddings::Query::Query(Query&&) = default;
+QuantizedEmbeddings::Query& QuantizedEmbeddings::Query::operator=(Query&&) =
+    default;
+
+QuantizedEmbeddings::QuantizedEmbeddings() = default;
+QuantizedEmbeddings::~QuantizedEmbeddings() = default;
+
+// static
+QuantizedEmbeddings::Query QuantizedEmbeddings::Quantize(
+    const Embedding& embedding) {
+  Query query;
+  query.values.resize(embedding.Dimensions());
+  query.scale = QuantizeInto(embedding.GetData(), query.values.data());
+  return query;
+}
+
+void QuantizedEmbeddings::Append(const Embedding& embedding) {
+  if (scales_.empty()) {
+    dimensions_ = embedding.Dimensions();
+  }
+  CHECK_EQ(embedding.Dimensions(), dimensions_);
+  values_.resize(values_.size() + dimensions_);
+  scales_.push_back(QuantizeInto(embedding.GetData(),
+                                 values_.data() + values_.size() - dimensions_));
+}
+
+void QuantizedEmbeddings::Clear() {
+  values_.clear();
+  scales_.clear();
+}
+
+float QuantizedEmbeddings::Score(const Query& query, size_t index) const {
+  CHECK_EQ(query.values.size(), dimensions_);
+  CHECK_LT(index, scales_.size());
+  return FastDotProduct(query.values.data(),
+                        values_.data() + index * dimensions_, dimensions_) *
+         query.scale * scales_[index];
+}
+
+}  // namespace history_embeddings
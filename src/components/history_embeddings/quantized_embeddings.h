@@ -0,0 +1,66 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_HISTORY_EMBEDDINGS_QUANTIZED_EMBEDDINGS_H_
+#define COMPONENTS_HISTORY_EMBEDDINGS_QUANTIZED_EMBEDDINGS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace history_embeddings {
+
+class Embedding;
+
+// Embeddings quantized to 8 bits per element and stored in one contiguous
+// matrix, so that many of them can be scored against a query much faster than
+// with Embedding::ScoreWith(), at the cost of some precision. Each row has its
+// own scale, which maps the largest magnitude among its elements to 127.
+class QuantizedEmbeddings {
+ public:
+  // A query quantized the same way, to be scored against the rows.
+  struct Query {
+    Query();
+    ~Query();
+    Query(Query&&);
+    Query& operator=(Query&&);
+
+    std::vector<int8_t> values;
+    float scale = 0.0f;
+  };
+
+  QuantizedEmbeddings();
+  QuantizedEmbeddings(const QuantizedEmbeddings&) = delete;
+  QuantizedEmbeddings& operator=(const QuantizedEmbeddings&) = delete;
+  ~QuantizedEmbeddings();
+
+  static Query Quantize(const Embedding& embedding);
+
+  // The number of rows.
+  size_t size() const { return scales_.size(); }
+
+  // Appends `embedding` as the last row. All rows have the same dimensions.
+  void Append(const Embedding& embedding);
+
+  // Removes all rows.
+  void Clear();
+
+  // Returns the approximate score of `query` with the row at `index`, as
+  // Embedding::ScoreWith() would compute with the original embeddings.
+  float Score(const Query& query, size_t index) const;
+
+ private:
+  size_t dimensions_ = 0u;
+
+  // The rows, one after the other.
+  std::vector<int8_t> values_;
+
+  // The scale of each row.
+  std::vector<float> scales_;
+};
+
+}  // namespace history_embeddings
+
+#endif  // COMPONENTS_HISTORY_EMBEDDINGS_QUANTIZED_EMBEDDINGS_H_
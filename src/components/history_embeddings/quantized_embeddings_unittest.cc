@@ -0,0 +1,62 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/history_embeddings/quantized_embeddings.h"
+
+#include <vector>
+
+#include "base/rand_util.h"
+#include "components/history_embeddings/vector_database.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace history_embeddings {
+
+namespace {
+
+Embedding RandomEmbedding(size_t size) {
+  std::vector<float> random_vector(size, 0.0f);
+  for (float& v : random_vector) {
+    v = base::RandFloat() * 2.0f - 1.0f;
+  }
+  Embedding embedding(std::move(random_vector));
+  embedding.Normalize();
+  return embedding;
+}
+
+}  // namespace
+
+TEST(HistoryEmbeddingsQuantizedEmbeddingsTest, ScoresCloseToExact) {
+  // Not a multiple of the SIMD width, to also cover the remainder.
+  constexpr size_t kSize = 771u;
+  std::vector<Embedding> embeddings;
+  QuantizedEmbeddings quantized;
+  for (size_t i = 0; i < 100; i++) {
+    embeddings.push_back(RandomEmbedding(kSize));
+    quantized.Append(embeddings.back());
+  }
+  ASSERT_EQ(quantized.size(), embeddings.size());
+
+  const Embedding query = RandomEmbedding(kSize);
+  const QuantizedEmbeddings::Query quantized_query =
+      QuantizedEmbeddings::Quantize(query);
+  for (size_t i = 0; i < embeddings.size(); i++) {
+    EXPECT_NEAR(quantized.Score(quantized_query, i),
+                query.ScoreWith(embeddings[i]), 0.01f);
+  }
+  // An embedding scores almost 1 with itself.
+  EXPECT_NEAR(quantized.Score(QuantizedEmbeddings::Quantize(embeddings[7]), 7),
+              1.0f, 0.01f);
+
+  quantized.Clear();
+  EXPECT_EQ(quantized.size(), 0u);
+}
+
+TEST(HistoryEmbeddingsQuantizedEmbeddingsTest, ZeroEmbedding) {
+  QuantizedEmbeddings quantized;
+  quantized.Append(Embedding({0.0f, 0.0f, 0.0f}));
+  Embedding query({1.0f, 2.0f, 3.0f});
+  EXPECT_EQ(quantized.Score(QuantizedEmbeddings::Quantize(query), 0), 0.0f);
+}
+
+}  // namespace history_embeddings
@@ -4,18 +4,42 @@
 
 #include "components/history_embeddings/scheduling_embedder.h"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "base/check_op.h"
+#include "base/functional/bind.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/power_monitor/power_monitor.h"
 #include "base/time/time.h"
 #include "components/history_embeddings/vector_database.h"
 
 namespace history_embeddings {
 
+namespace {
+
+bool IsOnBatteryPower() {
+  return base::PowerMonitor::IsInitialized() &&
+         base::PowerMonitor::IsOnBatteryPower();
+}
+
+}  // namespace
+
+SchedulingEmbedder::Job::Job(PassageKind kind,
+                             std::vector<std::string> passages,
+                             ComputePassagesEmbeddingsCallback callback)
+    : kind(kind),
+      passages(std::move(passages)),
+      callback(std::move(callback)) {}
+SchedulingEmbedder::Job::~Job() = default;
+SchedulingEmbedder::Job::Job(Job&&) = default;
+SchedulingEmbedder::Job& SchedulingEmbedder::Job::operator=(Job&&) = default;
+
 SchedulingEmbedder::SchedulingEmbedder(std::unique_ptr<Embedder> embedder,
                                        size_t scheduled_min,
                                        size_t scheduled_max)
@@ -32,8 +56,6 @@ void SchedulingEmbedder::ComputePassagesEmbeddings(
   if (kind == PassageKind::QUERY) {
     CHECK_EQ(passages.size(), 1u);
     std::string& query = passages[0];
-    // Only submit this query if there's none in progress.
-    bool submit = !query_submission_time_.has_value();
     if (next_query_.has_value()) {
       VLOG(2) << "Dropped pending query '" << next_query_.value()
               << "'. Next query: '" << query << "'";
@@ -46,15 +68,31 @@ void SchedulingEmbedder::ComputePassagesEmbeddings(
     next_query_callback_ =
         base::BindOnce(&SchedulingEmbedder::OnQueryEmbeddingComputed,
                        weak_ptr_factory_.GetWeakPtr(), std::move(callback));
+  } else {
+    if (passages.empty()) {
+      std::move(callback).Run({}, {});
+      return;
+    }
+
+    // Queue after the jobs of the same or higher priority, but never before
+    // the ones in the in-flight batch.
+    auto it = std::upper_bound(
+        jobs_.begin() + batch_job_passage_counts_.size(), jobs_.end(), kind,
+        [](PassageKind new_kind, const Job& job) {
+          return new_kind < job.kind;
+        });
+    jobs_.emplace(it, kind, std::move(passages), std::move(callback));
 
-    if (submit) {
-      SubmitQueryToEmbedder();
+    size_t queued_passage_count = 0;
+    for (const Job& job : jobs_) {
+      queued_passage_count += job.passages.size() - job.embeddings.size();
     }
-  } else {
-    // Immediate pass-through for other passage kinds.
-    embedder_->ComputePassagesEmbeddings(kind, std::move(passages),
-                                         std::move(callback));
+    base::UmaHistogramCounts10000(
+        "History.Embeddings.Scheduler.QueuedPassageCount",
+        queued_passage_count);
   }
+
+  SubmitWorkToEmbedder();
 }
 
 void SchedulingEmbedder::SetOnEmbedderReady(OnEmbedderReadyCallback callback) {
@@ -65,18 +103,146 @@ void SchedulingEmbedder::OnQueryEmbeddingComputed(
     ComputePassagesEmbeddingsCallback callback,
     std::vector<std::string> query_passages,
     std::vector<Embedding> query_embeddings) {
+  base::UmaHistogramTimes("History.Embeddings.Scheduler.QueryDuration",
+                          base::Time::Now() - query_submission_time_.value());
   std::move(callback).Run(std::move(query_passages),
                           std::move(query_embeddings));
 
   // If another query is pending, submit it for embedding.
   query_submission_time_.reset();
-  SubmitQueryToEmbedder();
+  SubmitWorkToEmbedder();
 }
 
-void SchedulingEmbedder::SubmitQueryToEmbedder() {
-  if (!next_query_.has_value()) {
+void SchedulingEmbedder::OnBatchEmbeddingsComputed(
+    std::vector<std::string> passages,
+    std::vector<Embedding> embeddings) {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const base::TimeDelta duration = now - batch_submission_time_.value();
+  batch_submission_time_.reset();
+  base::UmaHistogramMediumTimes("History.Embeddings.Scheduler.BatchDuration",
+                                duration);
+
+  const bool succeeded = embeddings.size() == passages.size();
+  if (succeeded) {
+    const base::TimeDelta passage_duration = duration / passages.size();
+    passage_duration_ =
+        passage_duration_.has_value()
+            ? (passage_duration_.value() * 3 + passage_duration) / 4
+            : passage_duration;
+  }
+  if (IsOnBatteryPower()) {
+    // Keep the embedder idle for as long as it was busy.
+    next_batch_time_ = now + duration;
+  }
+
+  // Hand the embeddings out to the jobs of the batch, and take out the ones
+  // that are done. Only the last one may need more batches.
+  std::vector<Job> done_jobs;
+  auto embedding = embeddings.begin();
+  for (size_t count : batch_job_passage_counts_) {
+    Job& job = jobs_.front();
+    if (succeeded) {
+      std::move(embedding, embedding + count,
+                std::back_inserter(job.embeddings));
+      embedding += count;
+      if (job.embeddings.size() < job.passages.size()) {
+        // Higher priority jobs may have been queued after this one while it
+        // was in flight, so move it back ahead of the jobs of its priority
+        // only.
+        Job partial_job = std::move(job);
+        jobs_.pop_front();
+        auto it = std::lower_bound(
+            jobs_.begin(), jobs_.end(), partial_job.kind,
+            [](const Job& queued_job, PassageKind kind) {
+              return queued_job.kind < kind;
+            });
+        jobs_.insert(it, std::move(partial_job));
+        break;
+      }
+    } else {
+      // Failed jobs report the original passages with no embeddings.
+      job.embeddings.clear();
+    }
+    done_jobs.push_back(std::move(job));
+    jobs_.pop_front();
+  }
+  batch_job_passage_counts_.clear();
+
+  for (Job& job : done_jobs) {
+    std::move(job.callback)
+        .Run(std::move(job.passages), std::move(job.embeddings));
+  }
+
+  SubmitWorkToEmbedder();
+}
+
+void SchedulingEmbedder::SubmitWorkToEmbedder() {
+  if (query_submission_time_.has_value() ||
+      batch_submission_time_.has_value()) {
+    return;
+  }
+
+  if (next_query_.has_value()) {
+    SubmitQueryToEmbedder();
     return;
   }
+
+  if (jobs_.empty()) {
+    return;
+  }
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (now < next_batch_time_) {
+    // base::Unretained is safe because `this` owns the timer.
+    next_batch_timer_.Start(
+        FROM_HERE, next_batch_time_ - now,
+        base::BindOnce(&SchedulingEmbedder::SubmitWorkToEmbedder,
+                       base::Unretained(this)));
+    return;
+  }
+  SubmitBatchToEmbedder();
+}
+
+void SchedulingEmbedder::SubmitBatchToEmbedder() {
+  CHECK(batch_job_passage_counts_.empty());
+
+  // A batch only holds passages of the same kind, from consecutive jobs.
+  const PassageKind kind = jobs_.front().kind;
+  const size_t batch_size = GetBatchSize();
+  std::vector<std::string> passages;
+  for (const Job& job : jobs_) {
+    if (job.kind != kind || passages.size() == batch_size) {
+      break;
+    }
+    const size_t start = job.embeddings.size();
+    const size_t count =
+        std::min(job.passages.size() - start, batch_size - passages.size());
+    passages.insert(passages.end(), job.passages.begin() + start,
+                    job.passages.begin() + start + count);
+    batch_job_passage_counts_.push_back(count);
+  }
+  VLOG(2) << "Submitting batch of " << passages.size()
+          << " passages to embedder";
+
+  batch_submission_time_ = base::TimeTicks::Now();
+  embedder_->ComputePassagesEmbeddings(
+      kind, std::move(passages),
+      base::BindOnce(&SchedulingEmbedder::OnBatchEmbeddingsComputed,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+size_t SchedulingEmbedder::GetBatchSize() const {
+  const size_t min_size = std::max<size_t>(scheduled_min_, 1u);
+  const size_t max_size = std::max(scheduled_max_, min_size);
+  if (IsOnBatteryPower() || !passage_duration_.has_value() ||
+      !passage_duration_->is_positive()) {
+    return min_size;
+  }
+  const size_t size =
+      static_cast<size_t>(kTargetBatchDuration.IntDiv(*passage_duration_));
+  return std::clamp(size, min_size, max_size);
+}
+
+void SchedulingEmbedder::SubmitQueryToEmbedder() {
   VLOG(2) << "Submitting query to embedder: '" << next_query_.value() << "'";
 
   // The embedder could call back synchronously and immediately, so be ready.
@@ -5,6 +5,7 @@
 #ifndef COMPONENTS_HISTORY_EMBEDDINGS_SCHEDULING_EMBEDDER_H_
 #define COMPONENTS_HISTORY_EMBEDDINGS_SCHEDULING_EMBEDDER_H_
 
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
@@ -12,6 +13,7 @@
 
 #include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/history_embeddings/embedder.h"
 
 namespace history_embeddings {
@@ -23,6 +25,12 @@ namespace history_embeddings {
 // when the model changes, all existing passages need their embeddings
 // recomputed, which can take a very long time and should be done at lower
 // priority.
+//
+// Only one request is submitted to the primary embedder at a time. Queries
+// preempt queued passages, which are submitted in batches sized so that a
+// batch takes about `kTargetBatchDuration` given the measured speed of the
+// embedder, and so that a query never waits long behind one. On battery power,
+// the embedder is left idle between batches of passages.
 class SchedulingEmbedder : public Embedder {
  public:
   SchedulingEmbedder(std::unique_ptr<Embedder> embedder,
@@ -38,20 +46,76 @@ class SchedulingEmbedder : public Embedder {
 
   void SetOnEmbedderReady(OnEmbedderReadyCallback callback) override;
 
+  // The duration the batches of passages are sized to take.
+  static constexpr base::TimeDelta kTargetBatchDuration =
+      base::Milliseconds(250);
+
  private:
+  // A request for passage embeddings, which may be split across batches.
+  struct Job {
+    Job(PassageKind kind,
+        std::vector<std::string> passages,
+        ComputePassagesEmbeddingsCallback callback);
+    ~Job();
+    Job(Job&&);
+    Job& operator=(Job&&);
+
+    PassageKind kind;
+    std::vector<std::string> passages;
+    // The embeddings of the first passages, computed so far.
+    std::vector<Embedding> embeddings;
+    ComputePassagesEmbeddingsCallback callback;
+  };
+
   // Invoked after the embedding for the original search query has been
   // computed. Continues processing next query if one is pending.
   void OnQueryEmbeddingComputed(ComputePassagesEmbeddingsCallback callback,
                                 std::vector<std::string> query_passages,
                                 std::vector<Embedding> query_embedding);
 
-  // Requests the embedder to embed the next query if one is pending.
+  // Invoked after the embeddings for a batch of passages from the front of
+  // `jobs_` have been computed.
+  void OnBatchEmbeddingsComputed(std::vector<std::string> passages,
+                                 std::vector<Embedding> embeddings);
+
+  // Requests the embedder to embed the next query if one is pending, or else
+  // the next batch of passages, unless a request is already submitted.
+  void SubmitWorkToEmbedder();
+
+  // Requests the embedder to embed `next_query_`, which must be set.
   void SubmitQueryToEmbedder();
 
+  // Submits a batch of passages from the front of `jobs_`.
+  void SubmitBatchToEmbedder();
+
+  // Returns the number of passages to submit in the next batch.
+  size_t GetBatchSize() const;
+
   // Time when last query was submitted, if awaiting an embedder response;
   // or nullopt if no query is currently submitted.
   std::optional<base::Time> query_submission_time_;
 
+  // Time when last batch of passages was submitted, if awaiting an embedder
+  // response; or nullopt if no batch is currently submitted.
+  std::optional<base::TimeTicks> batch_submission_time_;
+
+  // The jobs for passages other than queries, highest priority first, and
+  // first come first served within a priority. The in-flight batch, if any,
+  // holds the next passages of the jobs at the front.
+  std::deque<Job> jobs_;
+
+  // The number of passages in the in-flight batch from each job at the front
+  // of `jobs_`.
+  std::vector<size_t> batch_job_passage_counts_;
+
+  // The measured embedder duration per passage, smoothed over batches. Not set
+  // until the first batch completes.
+  std::optional<base::TimeDelta> passage_duration_;
+
+  // On battery power, batches of passages aren't submitted before this time.
+  base::TimeTicks next_batch_time_;
+  base::OneShotTimer next_batch_timer_;
+
   // The next query to submit for embedding. Empty query strings are allowed,
   // so optional is used to determine whether a query is pending.
   std::optional<std::string> next_query_;
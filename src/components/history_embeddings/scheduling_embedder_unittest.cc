@@ -0,0 +1,232 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/history_embeddings/scheduling_embedder.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/memory/raw_ptr.h"
+#include "base/test/power_monitor_test.h"
+#include "base/test/task_environment.h"
+#include "base/test/test_future.h"
+#include "components/history_embeddings/vector_database.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace history_embeddings {
+
+namespace {
+
+using EmbeddingsFuture =
+    base::test::TestFuture<std::vector<std::string>, std::vector<Embedding>>;
+
+// Holds the requests until the test completes them, in order.
+class FakeEmbedder : public Embedder {
+ public:
+  struct Request {
+    PassageKind kind;
+    std::vector<std::string> passages;
+    ComputePassagesEmbeddingsCallback callback;
+  };
+
+  // Embedder:
+  void ComputePassagesEmbeddings(
+      PassageKind kind,
+      std::vector<std::string> passages,
+      ComputePassagesEmbeddingsCallback callback) override {
+    requests_.push_back({kind, std::move(passages), std::move(callback)});
+  }
+  void SetOnEmbedderReady(OnEmbedderReadyCallback callback) override {}
+
+  // Completes the oldest request, with an embedding per passage if `succeed`.
+  void CompleteRequest(bool succeed = true) {
+    Request request = std::move(requests_.front());
+    requests_.pop_front();
+    std::vector<Embedding> embeddings;
+    if (succeed) {
+      for (size_t i = 0; i < request.passages.size(); i++) {
+        embeddings.emplace_back(std::vector<float>{1.0f});
+      }
+    }
+    std::move(request.callback)
+        .Run(std::move(request.passages), std::move(embeddings));
+  }
+
+  std::deque<Request>& requests() { return requests_; }
+
+ private:
+  std::deque<Request> requests_;
+};
+
+}  // namespace
+
+class HistoryEmbeddingsSchedulingEmbedderTest : public testing::Test {
+ protected:
+  void CreateEmbedder(size_t scheduled_min, size_t scheduled_max) {
+    auto embedder = std::make_unique<FakeEmbedder>();
+    fake_embedder_ = embedder.get();
+    scheduling_embedder_ = std::make_unique<SchedulingEmbedder>(
+        std::move(embedder), scheduled_min, scheduled_max);
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  std::unique_ptr<SchedulingEmbedder> scheduling_embedder_;
+  raw_ptr<FakeEmbedder> fake_embedder_;
+};
+
+TEST_F(HistoryEmbeddingsSchedulingEmbedderTest, QueryPreemptsPassages) {
+  CreateEmbedder(1, 1);
+  EmbeddingsFuture rebuild_future;
+  EmbeddingsFuture visit_future;
+  EmbeddingsFuture query_future;
+  scheduling_embedder_->ComputePassagesEmbeddings(
+      PassageKind::REBUILD_PASSAGE, {"a", "b"}, rebuild_future.GetCallback());
+  scheduling_embedder_->ComputePassagesEmbeddings(
+      PassageKind::PAGE_VISIT_PASSAGE, {"c"}, visit_future.GetCallback());
+  scheduling_embedder_->ComputePassagesEmbeddings(
+      PassageKind::QUERY, {"query"}, query_future.GetCallback());
+
+  // Only one request is submitted at a time.
+  ASSERT_EQ(fake_embedder_->requests().size(), 1u);
+  EXPECT_EQ(fake_embedder_->requests()[0].passages,
+            std::vector<std::string>({"a"}));
+  fake_embedder_->CompleteRequest();
+
+  // The query goes next, then the page visit passages.
+  ASSERT_EQ(fake_embedder_->requests().size(), 1u);
+  EXPECT_EQ(fake_embedder_->requests()[0].kind, PassageKind::QUERY);
+  fake_embedder_->CompleteRequest();
+  EXPECT_TRUE(query_future.IsReady());
+
+  ASSERT_EQ(fake_embedder_->requests().size(), 1u);
+  EXPECT_EQ(fake_embedder_->requests()[0].kind,
+            PassageKind::PAGE_VISIT_PASSAGE);
+  fake_embedder_->CompleteRequest();
+  EXPECT_EQ(visit_future.Get<1>().size(), 1u);
+
+  ASSERT_EQ(fake_embedder_->requests().size(), 1u);
+  EXPECT_EQ(fake_embedder_->requests()[0].passages,
+            std::vector<std::string>({"b"}));
+  EXPECT_FALSE(rebuild_future.IsReady());
+  fake_embedder_->CompleteRequest();
+  EXPECT_EQ(rebuild_future.Get<0>(), std::vector<std::string>({"a", "b"}));
+  EXPECT_EQ(rebuild_future.Get<1>().size(), 2u);
+  EXPECT_TRUE(fake_embedder_->requests().empty());
+}
+
+TEST_F(HistoryEmbeddingsSchedulingEmbedderTest, BatchSizeFollowsDuration) {
+  CreateEmbedder(1, 8);
+  EmbeddingsFuture first_future;
+  EmbeddingsFuture second_future;
+  EmbeddingsFuture third_future;
+  scheduling_embedder_->ComputePassagesEmbeddings(
+      PassageKind::PAGE_VISIT_PASSAGE, {"a", "b"}, first_future.GetCallback());
+  scheduling_embedder_->ComputePassagesEmbeddings(
+      PassageKind::PAGE_VISIT_PASSAGE, {"c", "d", "e", "f", "g"},
+      second_future.GetCallback());
+  scheduling_embedder_->ComputePassagesEmbeddings(
+      PassageKind::PAGE_VISIT_PASSAGE, {"h", "i", "j", "k"},
+      third_future.GetCallback());
+
+  // The first batch has the minimum size, as the duration isn't known yet.
+  ASSERT_EQ(fake_embedder_->requests().size(), 1u);
+  EXPECT_EQ(fake_embedder_->requests()[0].passages.size(), 1u);
+  task_environment_.FastForwardBy(SchedulingEmbedder::kTargetBatchDuration /
+                                  4);
+  fake_embedder_->CompleteRequest();
+
+  // Four passages fit in the target duration. They come from several jobs.
+  ASSERT_EQ(fake_embedder_->requests().size(), 1u);
+  EXPECT_EQ(fake_embedder_->requests()[0].passages,
+            std::vector<std::string>({"b", "c", "d", "e"}));
+  task_environment_.FastForwardBy(SchedulingEmbedder::kTargetBatchDuration /
+                                  16);
+  fake_embedder_->CompleteRequest();
+  EXPECT_EQ(first_future.Get<1>().size(), 2u);
+  EXPECT_FALSE(second_future.IsReady());
+
+  // Faster passages make for larger batches. The duration is smoothed over
+  // batches, so the batch doesn't grow fourfold at once.
+  ASSERT_EQ(fake_embedder_->requests().size(), 1u);
+  EXPECT_EQ(fake_embedder_->requests()[0].passages,
+            std::vector<std::string>({"f", "g", "h", "i", "j"}));
+  fake_embedder_->CompleteRequest();
+  EXPECT_EQ(second_future.Get<1>().size(), 5u);
+  EXPECT_FALSE(third_future.IsReady());
+
+  ASSERT_EQ(fake_embedder_->requests().size(), 1u);
+  EXPECT_EQ(fake_embedder_->requests()[0].passages,
+            std::vector<std::string>({"k"}));
+  fake_embedder_->CompleteRequest();
+  EXPECT_EQ(third_future.Get<1>().size(), 4u);
+}
+
+TEST_F(HistoryEmbeddingsSchedulingEmbedderTest, FailedBatchFailsItsJobs) {
+  CreateEmbedder(4, 4);
+  EmbeddingsFuture first_future;
+  EmbeddingsFuture second_future;
+  EmbeddingsFuture third_future;
+  EmbeddingsFuture fourth_future;
+  scheduling_embedder_->ComputePassagesEmbeddings(
+      PassageKind::PAGE_VISIT_PASSAGE, {"a"}, first_future.GetCallback());
+  // Queued while the first batch is in flight.
+  scheduling_embedder_->ComputePassagesEmbeddings(
+      PassageKind::PAGE_VISIT_PASSAGE, {"b"}, second_future.GetCallback());
+  scheduling_embedder_->ComputePassagesEmbeddings(
+      PassageKind::PAGE_VISIT_PASSAGE, {"c"}, third_future.GetCallback());
+  fake_embedder_->CompleteRequest();
+  EXPECT_EQ(first_future.Get<1>().size(), 1u);
+
+  // Both jobs are in the failed batch.
+  ASSERT_EQ(fake_embedder_->requests().size(), 1u);
+  EXPECT_EQ(fake_embedder_->requests()[0].passages,
+            std::vector<std::string>({"b", "c"}));
+  scheduling_embedder_->ComputePassagesEmbeddings(
+      PassageKind::PAGE_VISIT_PASSAGE, {"d"}, fourth_future.GetCallback());
+  fake_embedder_->CompleteRequest(/*succeed=*/false);
+  EXPECT_EQ(second_future.Get<0>(), std::vector<std::string>({"b"}));
+  EXPECT_TRUE(second_future.Get<1>().empty());
+  EXPECT_TRUE(third_future.Get<1>().empty());
+
+  ASSERT_EQ(fake_embedder_->requests().size(), 1u);
+  fake_embedder_->CompleteRequest();
+  EXPECT_EQ(fourth_future.Get<1>().size(), 1u);
+}
+
+TEST_F(HistoryEmbeddingsSchedulingEmbedderTest, ThrottledOnBattery) {
+  base::test::ScopedPowerMonitorTestSource power_monitor_source;
+  power_monitor_source.GeneratePowerStateEvent(/*on_battery_power=*/true);
+  CreateEmbedder(1, 8);
+  EmbeddingsFuture future;
+  scheduling_embedder_->ComputePassagesEmbeddings(
+      PassageKind::PAGE_VISIT_PASSAGE, {"a", "b", "c"}, future.GetCallback());
+
+  ASSERT_EQ(fake_embedder_->requests().size(), 1u);
+  task_environment_.FastForwardBy(base::Milliseconds(100));
+  fake_embedder_->CompleteRequest();
+
+  // The embedder stays idle for as long as the batch took, and batches keep
+  // the minimum size.
+  task_environment_.FastForwardBy(base::Milliseconds(99));
+  EXPECT_TRUE(fake_embedder_->requests().empty());
+
+  // Queries aren't throttled.
+  EmbeddingsFuture query_future;
+  scheduling_embedder_->ComputePassagesEmbeddings(
+      PassageKind::QUERY, {"query"}, query_future.GetCallback());
+  ASSERT_EQ(fake_embedder_->requests().size(), 1u);
+  fake_embedder_->CompleteRequest();
+  EXPECT_TRUE(query_future.IsReady());
+
+  task_environment_.FastForwardBy(base::Milliseconds(1));
+  ASSERT_EQ(fake_embedder_->requests().size(), 1u);
+  EXPECT_EQ(fake_embedder_->requests()[0].passages,
+            std::vector<std::string>({"b"}));
+}
+
+}  // namespace history_embeddings
@@ -4,8 +4,17 @@
 
 #include "components/history_embeddings/sql_database.h"
 
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "base/files/file_path.h"
 #include "base/sequence_checker.h"
+#include "components/history_embeddings/history_embeddings_features.h"
 #include "components/history_embeddings/passages_util.h"
 #include "components/history_embeddings/proto/history_embeddings.pb.h"
 #include "sql/init_status.h"
@@ -20,6 +29,58 @@ constexpr int kCurrentDatabaseVersion = 1;
 
 namespace {
 
+constexpr char kKeyModelVersion[] = "model_version";
+constexpr char kKeyIvfIndexUrlCount[] = "ivf_index_url_count";
+
+// Below this number of URLs, searching all of them is fast enough.
+constexpr size_t kIvfIndexMinUrlCount = 10000;
+
+// The index is rebuilt when the number of URLs grows by this factor.
+constexpr size_t kIvfIndexRebuildFactor = 4;
+
+// The index has about as many clusters as the square root of the number of
+// URLs, within these bounds. More clusters make searches faster but building
+// the index slower.
+constexpr size_t kIvfIndexMinClusterCount = 16;
+constexpr size_t kIvfIndexMaxClusterCount = 256;
+
+// The number of sampled URLs the centroids are trained on, per cluster.
+constexpr size_t kIvfIndexTrainingUrlsPerCluster = 32;
+
+std::string EmbeddingToBlob(const Embedding& embedding) {
+  proto::EmbeddingVector vector;
+  for (float f : embedding.GetData()) {
+    vector.add_floats(f);
+  }
+  return vector.SerializeAsString();
+}
+
+std::string EmbeddingsToBlob(const std::vector<Embedding>& embeddings) {
+  proto::EmbeddingsValue value;
+  for (const Embedding& embedding : embeddings) {
+    proto::EmbeddingVector* vector = value.add_vectors();
+    for (float f : embedding.GetData()) {
+      vector->add_floats(f);
+    }
+  }
+  return value.SerializeAsString();
+}
+
+// Returns false if `blob` isn't a serialized proto::EmbeddingsValue.
+[[nodiscard]] bool AppendEmbeddingsFromBlob(
+    base::span<const uint8_t> blob,
+    std::vector<Embedding>& embeddings) {
+  proto::EmbeddingsValue value;
+  if (!value.ParseFromArray(blob.data(), blob.size())) {
+    return false;
+  }
+  for (const proto::EmbeddingVector& vector : value.vectors()) {
+    embeddings.emplace_back(
+        std::vector(vector.floats().cbegin(), vector.floats().cend()));
+  }
+  return true;
+}
+
 [[nodiscard]] bool InitSchema(sql::Database& db) {
   static constexpr char kSqlCreateTablePassages[] =
       "CREATE TABLE IF NOT EXISTS passages("
@@ -72,13 +133,46 @@ namespace {
     return false;
   }
 
+  // The centroids of the inverted file index, see `IvfIndex`. Empty if the
+  // index isn't used or wasn't built yet.
+  static constexpr char kSqlCreateTableIvfCentroids[] =
+      "CREATE TABLE IF NOT EXISTS ivf_centroids("
+      "cluster_id INTEGER PRIMARY KEY NOT NULL,"
+      // A serialized proto::EmbeddingVector message.
+      "centroid_blob BLOB NOT NULL);";
+  if (!db.Execute(kSqlCreateTableIvfCentroids)) {
+    return false;
+  }
+
+  static constexpr char kSqlCreateTableIvfLists[] =
+      "CREATE TABLE IF NOT EXISTS ivf_lists("
+      "cluster_id INTEGER NOT NULL,"
+      // A URL in the `embeddings` table with an embedding in this cluster.
+      "url_id INTEGER NOT NULL,"
+      // The visit time of the embeddings, so that searches within a time range
+      // can skip the URLs outside of it without reading their embeddings.
+      "visit_time INTEGER NOT NULL,"
+      "PRIMARY KEY(cluster_id, url_id)) WITHOUT ROWID;";
+  if (!db.Execute(kSqlCreateTableIvfLists)) {
+    return false;
+  }
+
+  // Create an index over url_id so we can quickly delete the list entries of
+  // URLs that get deleted or replaced.
+  if (!db.Execute("CREATE INDEX IF NOT EXISTS index_ivf_lists_url_id ON "
+                  "ivf_lists(url_id)")) {
+    return false;
+  }
+
   return true;
 }
 
 }  // namespace
 
 SqlDatabase::SqlDatabase(const base::FilePath& storage_dir)
-    : storage_dir_(storage_dir), weak_ptr_factory_(this) {}
+    : storage_dir_(storage_dir),
+      ivf_index_min_url_count_(kIvfIndexMinUrlCount),
+      weak_ptr_factory_(this) {}
 
 SqlDatabase::~SqlDatabase() = default;
 
@@ -125,12 +219,11 @@ sql::InitStatus SqlDatabase::InitInternal(const base::FilePath& storage_dir) {
   // Initialize the current version meta table. Safest to leave the compatible
   // version equal to the current version - unless we know we're making a very
   // safe backwards-compatible schema change.
-  sql::MetaTable meta_table;
-  if (!meta_table.Init(&db_, kCurrentDatabaseVersion,
+  if (!meta_table_.Init(&db_, kCurrentDatabaseVersion,
                        /*compatible_version=*/kCurrentDatabaseVersion)) {
     return sql::InitStatus::INIT_FAILURE;
   }
-  if (meta_table.GetCompatibleVersionNumber() > kCurrentDatabaseVersion) {
+  if (meta_table_.GetCompatibleVersionNumber() > kCurrentDatabaseVersion) {
     LOG(ERROR) << "HistoryEmbeddings database is too new.";
     return sql::INIT_TOO_NEW;
   }
@@ -143,23 +236,174 @@ sql::InitStatus SqlDatabase::InitInternal(const base::FilePath& storage_dir) {
     return sql::INIT_FAILURE;
   }
 
-  constexpr char kKeyModelVersion[] = "model_version";
   int model_version = 0;
-  meta_table.GetValue(kKeyModelVersion, &model_version);
+  meta_table_.GetValue(kKeyModelVersion, &model_version);
   if (model_version != embedder_metadata_->model_version) {
     // Old version embeddings can't be used with new model. Simply delete them
     // all and set new version. Passages can be used for reconstruction later.
     constexpr char kSqlDeleteFromEmbeddings[] = "DELETE FROM embeddings;";
-    if (!db_.Execute(kSqlDeleteFromEmbeddings) ||
-        !meta_table.SetValue(kKeyModelVersion,
-                             embedder_metadata_->model_version)) {
+    if (!db_.Execute(kSqlDeleteFromEmbeddings) || !ClearIvfIndex() ||
+        !meta_table_.SetValue(kKeyModelVersion,
+                              embedder_metadata_->model_version)) {
       return sql::InitStatus::INIT_FAILURE;
     }
   }
 
+  if (!InitIvfIndex()) {
+    return sql::InitStatus::INIT_FAILURE;
+  }
+
   return sql::InitStatus::INIT_OK;
 }
 
+bool SqlDatabase::InitIvfIndex() {
+  if (!kUseIvfIndex.Get()) {
+    // The lists would get out of date, as they are only maintained while the
+    // index is used.
+    return ClearIvfIndex();
+  }
+
+  {
+    sql::Statement statement(
+        db_.GetUniqueStatement("SELECT COUNT(*) FROM embeddings"));
+    if (!statement.Step()) {
+      return false;
+    }
+    url_count_ = static_cast<size_t>(statement.ColumnInt64(0));
+  }
+
+  std::vector<Embedding> centroids;
+  {
+    sql::Statement statement(db_.GetUniqueStatement(
+        "SELECT centroid_blob FROM ivf_centroids ORDER BY cluster_id"));
+    while (statement.Step()) {
+      base::span<const uint8_t> blob = statement.ColumnBlob(0);
+      proto::EmbeddingVector vector;
+      if (!vector.ParseFromArray(blob.data(), blob.size()) ||
+          static_cast<size_t>(vector.floats_size()) !=
+              GetEmbeddingDimensions()) {
+        // Rebuilt once more URLs have embeddings.
+        return ClearIvfIndex();
+      }
+      centroids.emplace_back(
+          std::vector(vector.floats().cbegin(), vector.floats().cend()));
+    }
+    if (!statement.Succeeded()) {
+      return false;
+    }
+  }
+  if (!centroids.empty()) {
+    ivf_index_.emplace(std::move(centroids));
+    int64_t ivf_index_url_count = 0;
+    meta_table_.GetValue(kKeyIvfIndexUrlCount, &ivf_index_url_count);
+    ivf_index_url_count_ = static_cast<size_t>(ivf_index_url_count);
+  }
+  return true;
+}
+
+bool SqlDatabase::BuildIvfIndex() {
+  const size_t cluster_count = std::clamp(
+      static_cast<size_t>(std::sqrt(static_cast<double>(url_count_))),
+      kIvfIndexMinClusterCount, kIvfIndexMaxClusterCount);
+
+  std::vector<Embedding> sample;
+  {
+    constexpr char kSqlSelectEmbeddingsSample[] =
+        "SELECT embeddings_blob FROM embeddings ORDER BY RANDOM() LIMIT ?";
+    DCHECK(db_.IsSQLValid(kSqlSelectEmbeddingsSample));
+    sql::Statement statement(
+        db_.GetCachedStatement(SQL_FROM_HERE, kSqlSelectEmbeddingsSample));
+    statement.BindInt64(0, cluster_count * kIvfIndexTrainingUrlsPerCluster);
+    while (statement.Step()) {
+      if (!AppendEmbeddingsFromBlob(statement.ColumnBlob(0), sample)) {
+        return false;
+      }
+    }
+  }
+  std::vector<Embedding> centroids =
+      IvfIndex::TrainCentroids(sample, cluster_count);
+  if (centroids.empty()) {
+    return false;
+  }
+  IvfIndex index(std::move(centroids));
+
+  // Until this commits, the previous index remains in use.
+  sql::Transaction transaction(&db_);
+  if (!transaction.Begin() || !db_.Execute("DELETE FROM ivf_lists;") ||
+      !db_.Execute("DELETE FROM ivf_centroids;")) {
+    return false;
+  }
+  {
+    constexpr char kSqlInsertIvfCentroid[] =
+        "INSERT INTO ivf_centroids (cluster_id, centroid_blob) VALUES (?,?)";
+    DCHECK(db_.IsSQLValid(kSqlInsertIvfCentroid));
+    sql::Statement statement(
+        db_.GetCachedStatement(SQL_FROM_HERE, kSqlInsertIvfCentroid));
+    for (size_t i = 0; i < index.centroids().size(); i++) {
+      statement.Reset(/*clear_bound_vars=*/true);
+      statement.BindInt64(0, i);
+      statement.BindBlob(1, EmbeddingToBlob(index.centroids()[i]));
+      if (!statement.Run()) {
+        return false;
+      }
+    }
+  }
+  {
+    sql::Statement statement(db_.GetUniqueStatement(
+        "SELECT url_id, visit_time, embeddings_blob FROM embeddings"));
+    while (statement.Step()) {
+      std::vector<Embedding> embeddings;
+      if (!AppendEmbeddingsFromBlob(statement.ColumnBlob(2), embeddings) ||
+          !InsertIvfListEntries(index, statement.ColumnInt64(0),
+                                statement.ColumnTime(1), embeddings)) {
+        return false;
+      }
+    }
+    if (!statement.Succeeded()) {
+      return false;
+    }
+  }
+  if (!meta_table_.SetValue(kKeyIvfIndexUrlCount,
+                            static_cast<int64_t>(url_count_)) ||
+      !transaction.Commit()) {
+    return false;
+  }
+
+  ivf_index_ = std::move(index);
+  ivf_index_url_count_ = url_count_;
+  return true;
+}
+
+bool SqlDatabase::InsertIvfListEntries(
+    const IvfIndex& index,
+    history::URLID url_id,
+    base::Time visit_time,
+    const std::vector<Embedding>& embeddings) {
+  constexpr char kSqlInsertIvfListEntry[] =
+      "INSERT OR IGNORE INTO ivf_lists (cluster_id, url_id, visit_time) "
+      "VALUES (?,?,?)";
+  DCHECK(db_.IsSQLValid(kSqlInsertIvfListEntry));
+  sql::Statement statement(
+      db_.GetCachedStatement(SQL_FROM_HERE, kSqlInsertIvfListEntry));
+  for (const Embedding& embedding : embeddings) {
+    statement.Reset(/*clear_bound_vars=*/true);
+    statement.BindInt64(0, index.NearestCluster(embedding));
+    statement.BindInt64(1, url_id);
+    statement.BindTime(2, visit_time);
+    if (!statement.Run()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SqlDatabase::ClearIvfIndex() {
+  ivf_index_.reset();
+  ivf_index_url_count_ = 0;
+  return db_.Execute("DELETE FROM ivf_lists;") &&
+         db_.Execute("DELETE FROM ivf_centroids;");
+}
+
 bool SqlDatabase::InsertOrReplacePassages(const UrlPassages& url_passages) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   if (!LazyInit()) {
@@ -236,17 +480,61 @@ bool SqlDatabase::AddUrlEmbeddings(const UrlEmbeddings& url_embeddings) {
   statement.BindInt64(1, url_embeddings.visit_id);
   statement.BindTime(2, url_embeddings.visit_time);
 
-  proto::EmbeddingsValue value;
   for (const Embedding& embedding : url_embeddings.embeddings) {
     CHECK_EQ(GetEmbeddingDimensions(), embedding.Dimensions());
-    proto::EmbeddingVector* vector = value.add_vectors();
-    for (float f : embedding.GetData()) {
-      vector->add_floats(f);
+  }
+  statement.BindBlob(3, EmbeddingsToBlob(url_embeddings.embeddings));
+
+  if (!kUseIvfIndex.Get()) {
+    return statement.Run();
+  }
+
+  // Keep the index lists in sync with the embeddings.
+  sql::Transaction transaction(&db_);
+  if (!transaction.Begin()) {
+    return false;
+  }
+  {
+    constexpr char kSqlDeleteFromIvfListsByUrl[] =
+        "DELETE FROM ivf_lists WHERE url_id=?";
+    DCHECK(db_.IsSQLValid(kSqlDeleteFromIvfListsByUrl));
+    sql::Statement delete_statement(
+        db_.GetCachedStatement(SQL_FROM_HERE, kSqlDeleteFromIvfListsByUrl));
+    delete_statement.BindInt64(0, url_embeddings.url_id);
+    if (!delete_statement.Run()) {
+      return false;
     }
   }
-  statement.BindBlob(3, value.SerializeAsString());
+  bool is_new_url = false;
+  {
+    constexpr char kSqlSelectEmbeddingsExist[] =
+        "SELECT 1 FROM embeddings WHERE url_id=?";
+    DCHECK(db_.IsSQLValid(kSqlSelectEmbeddingsExist));
+    sql::Statement select_statement(
+        db_.GetCachedStatement(SQL_FROM_HERE, kSqlSelectEmbeddingsExist));
+    select_statement.BindInt64(0, url_embeddings.url_id);
+    is_new_url = !select_statement.Step();
+  }
+  if (!statement.Run() ||
+      (ivf_index_ &&
+       !InsertIvfListEntries(*ivf_index_, url_embeddings.url_id,
+                             url_embeddings.visit_time,
+                             url_embeddings.embeddings)) ||
+      !transaction.Commit()) {
+    return false;
+  }
 
-  return statement.Run();
+  if (is_new_url) {
+    url_count_++;
+  }
+  if (url_count_ >= ivf_index_min_url_count_ &&
+      (!ivf_index_ ||
+       url_count_ >= ivf_index_url_count_ * kIvfIndexRebuildFactor)) {
+    // On failure, searches go on using the previous index if any, or all URLs,
+    // and this is attempted again for the next URL.
+    BuildIvfIndex();
+  }
+  return true;
 }
 
 constexpr char kSqlSelectEmbeddings[] =
@@ -300,16 +588,10 @@ SqlDatabase::MakeEmbeddingsIterator(
         data = UrlEmbeddings(/*url_id=*/statement->ColumnInt64(0),
                              /*visit_id=*/statement->ColumnInt64(1),
                              /*visit_time=*/statement->ColumnTime(2));
-        base::span<const uint8_t> blob = statement->ColumnBlob(3);
-
-        proto::EmbeddingsValue value;
-        if (!value.ParseFromArray(blob.data(), blob.size())) {
+        if (!AppendEmbeddingsFromBlob(statement->ColumnBlob(3),
+                                      data.embeddings)) {
           return nullptr;
         }
-        for (const proto::EmbeddingVector& vector : value.vectors()) {
-          data.embeddings.emplace_back(
-              std::vector(vector.floats().cbegin(), vector.floats().cend()));
-        }
 
         return &data;
       } else {
@@ -325,6 +607,95 @@ SqlDatabase::MakeEmbeddingsIterator(
                                                  time_range_start);
 }
 
+SearchInfo SqlDatabase::FindNearest(
+    std::optional<base::Time> time_range_start,
+    size_t count,
+    const Embedding& query,
+    base::RepeatingCallback<bool()> is_search_halted) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!LazyInit() || !ivf_index_) {
+    return VectorDatabase::FindNearest(time_range_start, count, query,
+                                       std::move(is_search_halted));
+  }
+  if (count == 0) {
+    return {};
+  }
+
+  // Dimensions are always equal.
+  CHECK_EQ(query.Dimensions(), GetEmbeddingDimensions());
+
+  constexpr char kSqlSelectEmbeddingsInIvfList[] =
+      "SELECT embeddings.url_id, embeddings.visit_id, embeddings.visit_time, "
+      "embeddings.embeddings_blob FROM ivf_lists "
+      "JOIN embeddings ON embeddings.url_id = ivf_lists.url_id "
+      "WHERE ivf_lists.cluster_id = ? AND ivf_lists.visit_time >= ?";
+  DCHECK(db_.IsSQLValid(kSqlSelectEmbeddingsInIvfList));
+  sql::Statement statement(
+      db_.GetCachedStatement(SQL_FROM_HERE, kSqlSelectEmbeddingsInIvfList));
+
+  // The best URLs found so far, worst on top.
+  struct Compare {
+    bool operator()(const ScoredUrl& a, const ScoredUrl& b) const {
+      return a.score > b.score;
+    }
+  };
+  std::priority_queue<ScoredUrl, std::vector<ScoredUrl>, Compare> q;
+
+  SearchInfo search_info;
+  search_info.completed = true;
+
+  // A URL is in the list of each cluster of its embeddings, and only needs to
+  // be scored once.
+  std::set<history::URLID> searched_url_ids;
+  const size_t probe_count =
+      static_cast<size_t>(std::max(1, kIvfIndexProbeCount.Get()));
+  for (size_t cluster : ivf_index_->NearestClusters(query, probe_count)) {
+    statement.Reset(/*clear_bound_vars=*/true);
+    statement.BindInt64(0, cluster);
+    statement.BindTime(1, time_range_start.value_or(base::Time()));
+    while (search_info.completed && statement.Step()) {
+      if (is_search_halted.Run()) {
+        search_info.completed = false;
+        break;
+      }
+      if (!searched_url_ids.insert(statement.ColumnInt64(0)).second) {
+        continue;
+      }
+      UrlEmbeddings item(/*url_id=*/statement.ColumnInt64(0),
+                         /*visit_id=*/statement.ColumnInt64(1),
+                         /*visit_time=*/statement.ColumnTime(2));
+      if (!AppendEmbeddingsFromBlob(statement.ColumnBlob(3),
+                                    item.embeddings) ||
+          item.embeddings.empty()) {
+        continue;
+      }
+      search_info.searched_url_count++;
+      search_info.searched_embedding_count += item.embeddings.size();
+
+      const auto [score, score_index] = item.BestScoreWith(query);
+      if (q.size() == count && score <= q.top().score) {
+        continue;
+      }
+      q.emplace(item.url_id, item.visit_id, item.visit_time, score, score_index,
+                std::move(item.embeddings[score_index]));
+      if (q.size() > count) {
+        q.pop();
+      }
+    }
+    if (!search_info.completed) {
+      break;
+    }
+  }
+
+  // Empty queue into vector, best first.
+  for (; !q.empty(); q.pop()) {
+    search_info.scored_urls.push_back(q.top());
+  }
+  std::reverse(search_info.scored_urls.begin(), search_info.scored_urls.end());
+  return search_info;
+}
+
 bool SqlDatabase::DeleteDataForUrlId(history::URLID url_id) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -351,9 +722,21 @@ bool SqlDatabase::DeleteDataForUrlId(history::URLID url_id) {
         db_.GetCachedStatement(SQL_FROM_HERE, kSqlDeleteFromEmbeddingsByUrl));
     statement.BindInt64(0, url_id);
     delete_embeddings_success = statement.Run();
+    url_count_ -= std::min<size_t>(url_count_, db_.GetLastChangeCount());
+  }
+  bool delete_ivf_lists_success = false;
+  {
+    constexpr char kSqlDeleteFromIvfListsByUrl[] =
+        "DELETE FROM ivf_lists WHERE url_id=?";
+    DCHECK(db_.IsSQLValid(kSqlDeleteFromIvfListsByUrl));
+    sql::Statement statement(
+        db_.GetCachedStatement(SQL_FROM_HERE, kSqlDeleteFromIvfListsByUrl));
+    statement.BindInt64(0, url_id);
+    delete_ivf_lists_success = statement.Run();
   }
 
-  return delete_passages_success && delete_embeddings_success;
+  return delete_passages_success && delete_embeddings_success &&
+         delete_ivf_lists_success;
 }
 
 bool SqlDatabase::DeleteDataForVisitId(history::VisitID visit_id) {
@@ -373,6 +756,19 @@ bool SqlDatabase::DeleteDataForVisitId(history::VisitID visit_id) {
     statement.BindInt64(0, visit_id);
     delete_passages_success = statement.Run();
   }
+  // The list entries are deleted first, as they are found by the URLs of the
+  // embeddings.
+  bool delete_ivf_lists_success = false;
+  {
+    constexpr char kSqlDeleteFromIvfListsByVisit[] =
+        "DELETE FROM ivf_lists WHERE url_id IN "
+        "(SELECT url_id FROM embeddings WHERE visit_id=?)";
+    DCHECK(db_.IsSQLValid(kSqlDeleteFromIvfListsByVisit));
+    sql::Statement statement(
+        db_.GetCachedStatement(SQL_FROM_HERE, kSqlDeleteFromIvfListsByVisit));
+    statement.BindInt64(0, visit_id);
+    delete_ivf_lists_success = statement.Run();
+  }
   bool delete_embeddings_success = false;
   {
     constexpr char kSqlDeleteFromEmbeddingsByVisit[] =
@@ -382,9 +778,11 @@ bool SqlDatabase::DeleteDataForVisitId(history::VisitID visit_id) {
         db_.GetCachedStatement(SQL_FROM_HERE, kSqlDeleteFromEmbeddingsByVisit));
     statement.BindInt64(0, visit_id);
     delete_embeddings_success = statement.Run();
+    url_count_ -= std::min<size_t>(url_count_, db_.GetLastChangeCount());
   }
 
-  return delete_passages_success && delete_embeddings_success;
+  return delete_passages_success && delete_ivf_lists_success &&
+         delete_embeddings_success;
 }
 
 bool SqlDatabase::DeleteAllData() {
@@ -396,8 +794,12 @@ bool SqlDatabase::DeleteAllData() {
 
   bool delete_passages_success = db_.Execute("DELETE FROM passages;");
   bool delete_embeddings_success = db_.Execute("DELETE FROM embeddings;");
+  url_count_ = 0;
+  // The index is rebuilt once enough URLs have embeddings again.
+  bool delete_ivf_index_success = ClearIvfIndex();
 
-  return delete_passages_success && delete_embeddings_success;
+  return delete_passages_success && delete_embeddings_success &&
+         delete_ivf_index_success;
 }
 
 void SqlDatabase::DatabaseErrorCallback(int extended_error,
@@ -15,10 +15,12 @@
 #include "components/history/core/browser/history_types.h"
 #include "components/history/core/browser/url_row.h"
 #include "components/history_embeddings/embedder.h"
+#include "components/history_embeddings/ivf_index.h"
 #include "components/history_embeddings/proto/history_embeddings.pb.h"
 #include "components/history_embeddings/vector_database.h"
 #include "sql/database.h"
 #include "sql/init_status.h"
+#include "sql/meta_table.h"
 
 namespace history_embeddings {
 
@@ -55,6 +57,14 @@ class SqlDatabase : public VectorDatabase {
   bool AddUrlEmbeddings(const UrlEmbeddings& url_embeddings) override;
   std::unique_ptr<EmbeddingsIterator> MakeEmbeddingsIterator(
       std::optional<base::Time> time_range_start) override;
+  // Uses the inverted file index when there is one, see `kUseIvfIndex`. The
+  // result is approximate then, as only the URLs in the clusters nearest to
+  // `query` are searched.
+  SearchInfo FindNearest(
+      std::optional<base::Time> time_range_start,
+      size_t count,
+      const Embedding& query,
+      base::RepeatingCallback<bool()> is_search_halted) override;
 
   // These three methods are used to keep the on-disk persistence in sync with
   // History deletions, either from user action or time-based expiration.
@@ -62,6 +72,13 @@ class SqlDatabase : public VectorDatabase {
   bool DeleteDataForVisitId(history::VisitID visit_id);
   bool DeleteAllData();
 
+  // Whether the inverted file index was built, which happens once enough URLs
+  // have embeddings.
+  bool HasIvfIndexForTesting() const { return ivf_index_.has_value(); }
+  void SetIvfIndexMinUrlCountForTesting(size_t count) {
+    ivf_index_min_url_count_ = count;
+  }
+
  private:
   // Initializes the database, if it's not already initialized. Returns true if
   // the initialization was successful (or already succeeded in the past).
@@ -69,6 +86,23 @@ class SqlDatabase : public VectorDatabase {
   // Helper function for LazyInit(). Should only be called by LazyInit().
   sql::InitStatus InitInternal(const base::FilePath& storage_dir);
 
+  // Loads the inverted file index if it's used and was built, and otherwise
+  // clears it. Should only be called by InitInternal().
+  bool InitIvfIndex();
+
+  // Trains new centroids on a sample of the stored embeddings, and assigns all
+  // of them to the new clusters. The previous index is kept on failure.
+  bool BuildIvfIndex();
+
+  // Adds `url_id` to the list of each cluster of `embeddings`.
+  bool InsertIvfListEntries(const IvfIndex& index,
+                            history::URLID url_id,
+                            base::Time visit_time,
+                            const std::vector<Embedding>& embeddings);
+
+  // Removes the whole inverted file index.
+  bool ClearIvfIndex();
+
   // Callback for database errors.
   void DatabaseErrorCallback(int extended_error, sql::Statement* statement);
 
@@ -81,6 +115,22 @@ class SqlDatabase : public VectorDatabase {
   // The underlying SQL database.
   sql::Database db_ GUARDED_BY_CONTEXT(sequence_checker_);
 
+  // Holds the model version and the inverted file index state.
+  sql::MetaTable meta_table_;
+
+  // The centroids of the inverted file index, if it was built. The lists are
+  // in the `ivf_lists` table.
+  std::optional<IvfIndex> ivf_index_;
+
+  // The number of URLs with embeddings, only tracked if `kUseIvfIndex` is
+  // enabled. The index is built once there are `ivf_index_min_url_count_`,
+  // and rebuilt whenever their number grows by `kIvfIndexRebuildFactor` since
+  // it was built, tracked by `ivf_index_url_count_`, as the clusters would
+  // grow too large to be searched quickly otherwise.
+  size_t url_count_ = 0;
+  size_t ivf_index_url_count_ = 0;
+  size_t ivf_index_min_url_count_;
+
   // An iteration statement with lifetime bounded by above `db_`.
   // Only one iterator can be used at a time.
   std::unique_ptr<sql::Statement> iteration_statement_;
@@ -7,6 +7,9 @@
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/rand_util.h"
+#include "base/test/scoped_feature_list.h"
+#include "components/history_embeddings/history_embeddings_features.h"
 #include "components/history_embeddings/proto/history_embeddings.pb.h"
 #include "components/os_crypt/sync/os_crypt_mocker.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -24,6 +27,16 @@ Embedding FakeEmbedding() {
   return embedding;
 }
 
+Embedding RandomEmbedding() {
+  std::vector<float> random_vector(kEmbeddingsSize, 0.0f);
+  for (float& v : random_vector) {
+    v = base::RandFloat() * 2.0f - 1.0f;
+  }
+  Embedding embedding(std::move(random_vector));
+  embedding.Normalize();
+  return embedding;
+}
+
 }  // namespace
 
 class HistoryEmbeddingsSqlDatabaseTest : public testing::Test {
@@ -326,4 +339,80 @@ TEST_F(HistoryEmbeddingsSqlDatabaseTest, DeleteAllData) {
   EXPECT_EQ(GetEmbeddingCount(sql_database.get()), 0U);
 }
 
+TEST_F(HistoryEmbeddingsSqlDatabaseTest, IvfIndexSearch) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeatureWithParameters(kHistoryEmbeddings,
+                                                  {{"UseIvfIndex", "true"}});
+  constexpr size_t kUrlCount = 64;
+  auto sql_database = std::make_unique<SqlDatabase>(history_dir_.GetPath());
+  sql_database->SetEmbedderMetadata({kEmbeddingsVersion, kEmbeddingsSize});
+  sql_database->SetIvfIndexMinUrlCountForTesting(kUrlCount / 2);
+
+  const base::Time now = base::Time::Now();
+  std::vector<Embedding> embeddings;
+  for (size_t i = 0; i < kUrlCount; i++) {
+    UrlEmbeddings url_embeddings(i + 1, i + 1, now + base::Minutes(i));
+    embeddings.push_back(RandomEmbedding());
+    url_embeddings.embeddings.push_back(embeddings.back());
+    ASSERT_TRUE(sql_database->AddUrlEmbeddings(url_embeddings));
+    // The index is built once enough URLs have embeddings, and the URLs
+    // added after that are added to it.
+    EXPECT_EQ(sql_database->HasIvfIndexForTesting(), i + 1 >= kUrlCount / 2);
+  }
+
+  auto find_nearest = [&](SqlDatabase& database,
+                          std::optional<base::Time> time_range_start,
+                          const Embedding& query) {
+    return database
+        .FindNearest(time_range_start, 3, query,
+                     base::BindRepeating([]() { return false; }))
+        .scored_urls;
+  };
+
+  // URLs added before and after the index was built are found with their own
+  // embeddings, without searching all URLs.
+  for (size_t i : {10u, 50u}) {
+    SearchInfo search_info = sql_database->FindNearest(
+        {}, 3, embeddings[i], base::BindRepeating([]() { return false; }));
+    ASSERT_FALSE(search_info.scored_urls.empty());
+    EXPECT_EQ(search_info.scored_urls[0].url_id, static_cast<int64_t>(i + 1));
+    EXPECT_NEAR(search_info.scored_urls[0].score, 1.0f, 0.001f);
+    EXPECT_LT(search_info.searched_url_count, kUrlCount);
+    EXPECT_TRUE(search_info.completed);
+  }
+
+  // URLs outside of the time range are skipped.
+  for (const ScoredUrl& scored_url :
+       find_nearest(*sql_database, now + base::Minutes(20), embeddings[10])) {
+    EXPECT_GE(scored_url.visit_time, now + base::Minutes(20));
+  }
+
+  // Deleted URLs are no longer found, and replaced ones are found with their
+  // new embeddings.
+  ASSERT_TRUE(sql_database->DeleteDataForUrlId(51));
+  std::vector<ScoredUrl> scored_urls =
+      find_nearest(*sql_database, {}, embeddings[50]);
+  for (const ScoredUrl& scored_url : scored_urls) {
+    EXPECT_NE(scored_url.url_id, 51);
+  }
+  UrlEmbeddings replaced(11, 11, now);
+  replaced.embeddings.push_back(embeddings[50]);
+  ASSERT_TRUE(sql_database->AddUrlEmbeddings(replaced));
+  scored_urls = find_nearest(*sql_database, {}, embeddings[50]);
+  ASSERT_FALSE(scored_urls.empty());
+  EXPECT_EQ(scored_urls[0].url_id, 11);
+
+  // The index is persisted.
+  sql_database.reset();
+  sql_database = std::make_unique<SqlDatabase>(history_dir_.GetPath());
+  sql_database->SetEmbedderMetadata({kEmbeddingsVersion, kEmbeddingsSize});
+  scored_urls = find_nearest(*sql_database, {}, embeddings[30]);
+  EXPECT_TRUE(sql_database->HasIvfIndexForTesting());
+  ASSERT_FALSE(scored_urls.empty());
+  EXPECT_EQ(scored_urls[0].url_id, 31);
+
+  EXPECT_TRUE(sql_database->DeleteAllData());
+  EXPECT_FALSE(sql_database->HasIvfIndexForTesting());
+}
+
 }  // namespace history_embeddings
@@ -4,6 +4,9 @@
 
 #include "components/history_embeddings/vector_database.h"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
 #include <queue>
 
 #include "base/timer/elapsed_timer.h"
@@ -16,6 +19,11 @@ constexpr float kUnitLength = 1.0f;
 // Close enough to be considered near zero.
 constexpr float kEpsilon = 0.01f;
 
+// How many more candidates than asked for a search of quantized embeddings
+// keeps before rescoring them exactly, so that quantization errors rarely drop
+// one of the best results.
+constexpr size_t kQuantizedCandidatesFactor = 4u;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 UrlPassages::UrlPassages(history::URLID url_id,
@@ -207,6 +215,8 @@ void VectorDatabaseInMemory::SaveTo(VectorDatabase* database) {
     database->AddUrlEmbeddings(std::move(url_embeddings));
   }
   data_.clear();
+  quantized_embeddings_.Clear();
+  first_quantized_indices_.clear();
 }
 
 size_t VectorDatabaseInMemory::GetEmbeddingDimensions() const {
@@ -225,6 +235,10 @@ bool VectorDatabaseInMemory::AddUrlEmbeddings(
   }
 
   data_.push_back(url_embeddings);
+  first_quantized_indices_.push_back(quantized_embeddings_.size());
+  for (const Embedding& embedding : url_embeddings.embeddings) {
+    quantized_embeddings_.Append(embedding);
+  }
   return true;
 }
 
@@ -268,4 +282,93 @@ VectorDatabaseInMemory::MakeEmbeddingsIterator(
   return std::make_unique<SimpleEmbeddingsIterator>(data_, time_range_start);
 }
 
+SearchInfo VectorDatabaseInMemory::FindNearest(
+    std::optional<base::Time> time_range_start,
+    size_t count,
+    const Embedding& query,
+    base::RepeatingCallback<bool()> is_search_halted) {
+  if (count == 0 || data_.empty()) {
+    return {};
+  }
+
+  // Dimensions are always equal.
+  CHECK_EQ(query.Dimensions(), GetEmbeddingDimensions());
+
+  // Magnitudes are also assumed equal; they are provided normalized by design.
+  CHECK_LT(std::abs(query.Magnitude() - kUnitLength), kEpsilon);
+
+  const QuantizedEmbeddings::Query quantized_query =
+      QuantizedEmbeddings::Quantize(query);
+
+  // The best candidates by approximate score, worst on top.
+  struct Candidate {
+    bool operator>(const Candidate& other) const {
+      return score > other.score;
+    }
+
+    float score;
+    size_t data_index;
+    size_t embedding_index;
+  };
+  std::priority_queue<Candidate, std::vector<Candidate>,
+                      std::greater<Candidate>>
+      candidates;
+  const size_t candidate_count = count * kQuantizedCandidatesFactor;
+
+  SearchInfo search_info;
+  search_info.completed = true;
+
+  for (size_t i = 0; i < data_.size(); i++) {
+    const UrlEmbeddings& item = data_[i];
+    if (time_range_start.has_value() &&
+        item.visit_time < time_range_start.value()) {
+      continue;
+    }
+    if (is_search_halted.Run()) {
+      search_info.completed = false;
+      break;
+    }
+    search_info.searched_url_count++;
+    search_info.searched_embedding_count += item.embeddings.size();
+    if (item.embeddings.empty()) {
+      continue;
+    }
+
+    Candidate best{std::numeric_limits<float>::lowest(), i, 0};
+    for (size_t j = 0; j < item.embeddings.size(); j++) {
+      const float score = quantized_embeddings_.Score(
+          quantized_query, first_quantized_indices_[i] + j);
+      if (score > best.score) {
+        best.score = score;
+        best.embedding_index = j;
+      }
+    }
+    if (candidates.size() < candidate_count) {
+      candidates.push(best);
+    } else if (best > candidates.top()) {
+      candidates.pop();
+      candidates.push(best);
+    }
+  }
+
+  // Rescore the candidates exactly and keep the best.
+  std::vector<ScoredUrl>& scored_urls = search_info.scored_urls;
+  for (; !candidates.empty(); candidates.pop()) {
+    const Candidate& candidate = candidates.top();
+    const UrlEmbeddings& item = data_[candidate.data_index];
+    const Embedding& embedding = item.embeddings[candidate.embedding_index];
+    scored_urls.emplace_back(item.url_id, item.visit_id, item.visit_time,
+                             query.ScoreWith(embedding),
+                             candidate.embedding_index, embedding);
+  }
+  std::sort(scored_urls.begin(), scored_urls.end(),
+            [](const ScoredUrl& a, const ScoredUrl& b) {
+              return a.score > b.score;
+            });
+  if (scored_urls.size() > count) {
+    scored_urls.erase(scored_urls.begin() + count, scored_urls.end());
+  }
+  return search_info;
+}
+
 }  // namespace history_embeddings
@@ -11,6 +11,7 @@
 #include "base/time/time.h"
 #include "components/history/core/browser/history_types.h"
 #include "components/history_embeddings/proto/history_embeddings.pb.h"
+#include "components/history_embeddings/quantized_embeddings.h"
 #include "components/keyed_service/core/keyed_service.h"
 
 namespace history_embeddings {
@@ -165,14 +166,16 @@ class VectorDatabase {
 
   // Searches the database for embeddings near given `query` and returns
   // information about where they were found and how nearly the query matched.
-  SearchInfo FindNearest(std::optional<base::Time> time_range_start,
-                         size_t count,
-                         const Embedding& query,
-                         base::RepeatingCallback<bool()> is_search_halted);
+  virtual SearchInfo FindNearest(
+      std::optional<base::Time> time_range_start,
+      size_t count,
+      const Embedding& query,
+      base::RepeatingCallback<bool()> is_search_halted);
 };
 
 // This is an in-memory vector store that supports searching and saving to
-// another persistent backing store.
+// another persistent backing store. Searches score quantized copies of the
+// embeddings, then rescore the best candidates with the original embeddings.
 class VectorDatabaseInMemory : public VectorDatabase {
  public:
   VectorDatabaseInMemory();
@@ -188,9 +191,21 @@ class VectorDatabaseInMemory : public VectorDatabase {
   bool AddUrlEmbeddings(const UrlEmbeddings& url_embeddings) override;
   std::unique_ptr<EmbeddingsIterator> MakeEmbeddingsIterator(
       std::optional<base::Time> time_range_start) override;
+  SearchInfo FindNearest(
+      std::optional<base::Time> time_range_start,
+      size_t count,
+      const Embedding& query,
+      base::RepeatingCallback<bool()> is_search_halted) override;
 
  private:
   std::vector<UrlEmbeddings> data_;
+
+  // The embeddings of all of `data_`, in order.
+  QuantizedEmbeddings quantized_embeddings_;
+
+  // The index in `quantized_embeddings_` of the first embedding of each item in
+  // `data_`.
+  std::vector<size_t> first_quantized_indices_;
 };
 
 }  // namespace history_embeddings
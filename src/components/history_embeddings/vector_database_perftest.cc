@@ -0,0 +1,141 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "base/rand_util.h"
+#include "base/timer/elapsed_timer.h"
+#include "components/history_embeddings/vector_database.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// This file compares searching VectorDatabaseInMemory, which scores quantized
+// embeddings, with the generic VectorDatabase::FindNearest(), which scores
+// each Embedding in turn.
+
+namespace history_embeddings {
+
+namespace {
+
+constexpr char kMetricPrefixVectorDatabase[] = "VectorDatabase.";
+constexpr char kMetricSearchTime[] = "search_time";
+constexpr char kMetricRecall[] = "recall";
+
+constexpr size_t kDimensions = 768u;
+constexpr size_t kEmbeddingsPerUrl = 3u;
+constexpr size_t kResultCount = 10u;
+constexpr size_t kNumQueries = 10u;
+
+// Debug builds can be quite slow. Use fewer URLs to test.
+#if defined(NDEBUG)
+constexpr size_t kNumUrls = 100000u;
+#else
+constexpr size_t kNumUrls = 5000u;
+#endif
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story_name) {
+  perf_test::PerfResultReporter reporter(kMetricPrefixVectorDatabase,
+                                         story_name);
+  reporter.RegisterImportantMetric(kMetricSearchTime, "ms");
+  reporter.RegisterImportantMetric(kMetricRecall, "%");
+  return reporter;
+}
+
+Embedding RandomEmbedding() {
+  std::vector<float> random_vector(kDimensions, 0.0f);
+  for (float& v : random_vector) {
+    v = base::RandFloat() * 2.0f - 1.0f;
+  }
+  Embedding embedding(std::move(random_vector));
+  embedding.Normalize();
+  return embedding;
+}
+
+class VectorDatabasePerfTest : public testing::Test {
+ public:
+  void SetUp() override {
+    for (size_t i = 0; i < kNumUrls; i++) {
+      UrlEmbeddings url_embeddings(i + 1, i + 1, base::Time::Now());
+      for (size_t j = 0; j < kEmbeddingsPerUrl; j++) {
+        url_embeddings.embeddings.push_back(RandomEmbedding());
+      }
+      database_.AddUrlEmbeddings(url_embeddings);
+      url_embeddings_.push_back(std::move(url_embeddings));
+    }
+    for (size_t i = 0; i < kNumQueries; i++) {
+      queries_.push_back(RandomEmbedding());
+    }
+  }
+
+  // Returns the best `kResultCount` URLs for `query`, by exact score.
+  std::set<history::URLID> ExpectedUrls(const Embedding& query) const {
+    std::vector<std::pair<float, history::URLID>> scores;
+    for (const UrlEmbeddings& url_embeddings : url_embeddings_) {
+      scores.emplace_back(url_embeddings.BestScoreWith(query).first,
+                          url_embeddings.url_id);
+    }
+    std::partial_sort(scores.begin(), scores.begin() + kResultCount,
+                      scores.end(), std::greater<>());
+    std::set<history::URLID> urls;
+    for (size_t i = 0; i < kResultCount; i++) {
+      urls.insert(scores[i].second);
+    }
+    return urls;
+  }
+
+  // Runs the queries with `find_nearest` and reports the average time and the
+  // share of the expected URLs that were found.
+  template <typename FindNearest>
+  void RunSearchPerfTest(const std::string& story_name,
+                         FindNearest find_nearest) {
+    base::TimeDelta search_time;
+    size_t found_urls = 0u;
+    for (const Embedding& query : queries_) {
+      base::ElapsedTimer timer;
+      SearchInfo search_info = find_nearest(query);
+      search_time += timer.Elapsed();
+      EXPECT_TRUE(search_info.completed);
+
+      const std::set<history::URLID> expected_urls = ExpectedUrls(query);
+      for (const ScoredUrl& scored_url : search_info.scored_urls) {
+        found_urls += expected_urls.count(scored_url.url_id);
+      }
+    }
+
+    auto reporter = SetUpReporter(story_name);
+    reporter.AddResult(kMetricSearchTime,
+                       search_time.InMillisecondsF() / kNumQueries);
+    reporter.AddResult(kMetricRecall,
+                       100.0 * found_urls / (kNumQueries * kResultCount));
+  }
+
+ protected:
+  VectorDatabaseInMemory database_;
+  std::vector<UrlEmbeddings> url_embeddings_;
+  std::vector<Embedding> queries_;
+};
+
+}  // namespace
+
+TEST_F(VectorDatabasePerfTest, FindNearest) {
+  RunSearchPerfTest("FindNearest", [this](const Embedding& query) {
+    return database_.VectorDatabase::FindNearest(
+        {}, kResultCount, query, base::BindRepeating([]() { return false; }));
+  });
+}
+
+TEST_F(VectorDatabasePerfTest, FindNearestQuantized) {
+  RunSearchPerfTest("FindNearestQuantized", [this](const Embedding& query) {
+    return database_.FindNearest({}, kResultCount, query,
+                                 base::BindRepeating([]() { return false; }));
+  });
+}
+
+}  // namespace history_embeddings
@@ -4,8 +4,11 @@
 
 #include "components/history_embeddings/vector_database.h"
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/memory/weak_ptr.h"
@@ -152,6 +155,45 @@ TEST(HistoryEmbeddingsVectorDatabaseTest, TimeRangeNarrowsSearchResult) {
   }
 }
 
+// The in-memory database finds the same best results as exact scoring would.
+TEST(HistoryEmbeddingsVectorDatabaseTest, InMemorySearchMatchesExactScores) {
+  VectorDatabaseInMemory database;
+  std::vector<UrlEmbeddings> all_url_embeddings;
+  for (size_t i = 0; i < 200; i++) {
+    UrlEmbeddings url_embeddings(i + 1, i + 1, base::Time::Now());
+    for (size_t j = 0; j < 3; j++) {
+      url_embeddings.embeddings.push_back(RandomEmbedding());
+    }
+    database.AddUrlEmbeddings(url_embeddings);
+    all_url_embeddings.push_back(std::move(url_embeddings));
+  }
+  Embedding query = all_url_embeddings[42].embeddings[1];
+
+  std::vector<std::pair<float, history::URLID>> expected;
+  for (const UrlEmbeddings& url_embeddings : all_url_embeddings) {
+    expected.emplace_back(url_embeddings.BestScoreWith(query).first,
+                          url_embeddings.url_id);
+  }
+  std::sort(expected.rbegin(), expected.rend());
+
+  SearchInfo search_info = database.FindNearest(
+      {}, 3, query, base::BindRepeating([]() { return false; }));
+  EXPECT_TRUE(search_info.completed);
+  EXPECT_EQ(search_info.searched_url_count, 200u);
+  EXPECT_EQ(search_info.searched_embedding_count, 600u);
+  ASSERT_EQ(search_info.scored_urls.size(), 3u);
+
+  // The query is one of the embeddings, so it's found first.
+  EXPECT_EQ(search_info.scored_urls[0].url_id, 43);
+  EXPECT_EQ(search_info.scored_urls[0].index, 1u);
+  EXPECT_NEAR(search_info.scored_urls[0].score, 1.0f, 1e-5f);
+  EXPECT_EQ(search_info.scored_urls[0].passage_embedding, query);
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_EQ(search_info.scored_urls[i].url_id, expected[i].second);
+    EXPECT_FLOAT_EQ(search_info.scored_urls[i].score, expected[i].first);
+  }
+}
+
 // Note: Disabled by default so as to not burden the bots. Enable when needed.
 TEST(HistoryEmbeddingsVectorDatabaseTest, DISABLED_ManyVectorsAreFastEnough) {
   VectorDatabaseInMemory database;
@@ -4,16 +4,20 @@
 
 #include "components/image_fetcher/core/cached_image_fetcher.h"
 
+#include <iterator>
 #include <utility>
 
 #include "base/functional/bind.h"
 #include "base/functional/callback_helpers.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/strings/strcat.h"
 #include "base/task/sequenced_task_runner.h"
 #include "base/task/thread_pool.h"
 #include "base/time/time.h"
 #include "base/timer/elapsed_timer.h"
 #include "components/image_fetcher/core/cache/image_cache.h"
+#include "components/image_fetcher/core/features.h"
 #include "components/image_fetcher/core/image_decoder.h"
 #include "components/image_fetcher/core/image_fetcher_metrics_reporter.h"
 #include "components/image_fetcher/core/request_metadata.h"
@@ -41,6 +45,14 @@ struct CachedImageFetcherRequest {
 
 namespace {
 
+// The most memory that decoded images may use in the memory cache.
+constexpr size_t kMaxMemoryCacheBytes = 8 * 1024 * 1024;
+
+// Decoded images are stored as 32-bit bitmaps.
+size_t EstimateImageBytes(const gfx::Image& image) {
+  return static_cast<size_t>(image.Width()) * image.Height() * 4;
+}
+
 void DataCallbackIfPresent(ImageDataFetcherCallback data_callback,
                            const std::string& image_data,
                            const image_fetcher::RequestMetadata& metadata) {
@@ -84,7 +96,8 @@ CachedImageFetcher::CachedImageFetcher(ImageFetcher* image_fetcher,
                                        bool read_only)
     : image_fetcher_(image_fetcher),
       image_cache_(image_cache),
-      read_only_(read_only) {
+      read_only_(read_only),
+      memory_cache_(base::LRUCache<std::string, gfx::Image>::NO_AUTO_EVICT) {
   DCHECK(image_fetcher_);
   DCHECK(image_cache_);
 }
@@ -111,6 +124,13 @@ void CachedImageFetcher::FetchImageAndData(
   ImageFetcherMetricsReporter::ReportEvent(request.params.uma_client_name(),
                                            ImageFetcherEvent::kImageRequest);
 
+  // The memory cache only has decoded images, so it can't serve requests for
+  // the image data.
+  if (!request.params.skip_disk_cache_read() && image_data_callback.is_null() &&
+      MaybeFetchImageFromMemory(request, image_callback)) {
+    return;
+  }
+
   if (request.params.skip_disk_cache_read()) {
     EnqueueFetchImageFromNetwork(std::move(request),
                                  std::move(image_data_callback),
@@ -126,6 +146,67 @@ void CachedImageFetcher::FetchImageAndData(
   }
 }
 
+// static
+std::string CachedImageFetcher::GetMemoryCacheKey(
+    const CachedImageFetcherRequest& request) {
+  return base::StrCat(
+      {request.url.spec(), " ", request.params.frame_size().ToString()});
+}
+
+bool CachedImageFetcher::MaybeFetchImageFromMemory(
+    const CachedImageFetcherRequest& request,
+    ImageFetcherCallback& image_callback) {
+  if (!base::FeatureList::IsEnabled(features::kDecodedImageMemoryCache)) {
+    return false;
+  }
+
+  auto it = memory_cache_.Get(GetMemoryCacheKey(request));
+  base::UmaHistogramBoolean("ImageFetcher.MemoryCacheHit",
+                            it != memory_cache_.end());
+  if (it == memory_cache_.end()) {
+    return false;
+  }
+
+  // Callers expect the image asynchronously, as it is from the other caches.
+  if (image_callback) {
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE, base::BindOnce(std::move(image_callback), it->second,
+                                  RequestMetadata()));
+  }
+  return true;
+}
+
+void CachedImageFetcher::StoreImageInMemory(
+    const CachedImageFetcherRequest& request,
+    const gfx::Image& image) {
+  if (image.IsEmpty() ||
+      !base::FeatureList::IsEnabled(features::kDecodedImageMemoryCache)) {
+    return;
+  }
+
+  const size_t image_bytes = EstimateImageBytes(image);
+  if (image_bytes > kMaxMemoryCacheBytes / 4) {
+    return;
+  }
+
+  const std::string key = GetMemoryCacheKey(request);
+  auto it = memory_cache_.Peek(key);
+  if (it != memory_cache_.end()) {
+    memory_cache_bytes_ -= EstimateImageBytes(it->second);
+    memory_cache_.Erase(it);
+  }
+  while (!memory_cache_.empty() &&
+         memory_cache_bytes_ + image_bytes > kMaxMemoryCacheBytes) {
+    auto oldest = std::prev(memory_cache_.end());
+    memory_cache_bytes_ -= EstimateImageBytes(oldest->second);
+    memory_cache_.Erase(oldest);
+  }
+  memory_cache_.Put(key, image);
+  memory_cache_bytes_ += image_bytes;
+  base::UmaHistogramMemoryKB("ImageFetcher.MemoryCacheSize",
+                             memory_cache_bytes_ / 1024);
+}
+
 void CachedImageFetcher::OnImageFetchedFromCache(
     CachedImageFetcherRequest request,
     ImageDataFetcherCallback image_data_callback,
@@ -179,6 +260,7 @@ void CachedImageFetcher::OnImageDecodedFromCache(
                                  std::move(image_data_callback),
                                  std::move(image_callback));
   } else {
+    StoreImageInMemory(request, image);
     ImageCallbackIfPresent(std::move(image_callback), image, RequestMetadata());
     ImageFetcherMetricsReporter::ReportImageLoadFromCacheTime(
         request.params.uma_client_name(), request.start_time);
@@ -265,6 +347,7 @@ void CachedImageFetcher::OnImageFetchedForTranscoding(
     ImageFetcherCallback image_callback,
     const gfx::Image& image,
     const RequestMetadata& request_metadata) {
+  StoreImageInMemory(request, image);
   ImageCallbackIfPresent(std::move(image_callback), image, request_metadata);
 
   // Report to different histograms depending upon if there was a cache hit.
@@ -8,6 +8,7 @@
 #include <memory>
 #include <string>
 
+#include "base/containers/lru_cache.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
@@ -16,6 +17,7 @@
 #include "components/image_fetcher/core/image_fetcher_types.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 #include "ui/gfx/geometry/size.h"
+#include "ui/gfx/image/image.h"
 #include "url/gurl.h"
 
 namespace image_fetcher {
@@ -49,6 +51,17 @@ class CachedImageFetcher : public ImageFetcher {
   ImageDecoder* GetImageDecoder() override;
 
  private:
+  // Memory cache, with kDecodedImageMemoryCache. Keyed by URL and requested
+  // frame size.
+  static std::string GetMemoryCacheKey(
+      const CachedImageFetcherRequest& request);
+  // Returns true and runs |image_callback| with the image if it is in
+  // |memory_cache_|.
+  bool MaybeFetchImageFromMemory(const CachedImageFetcherRequest& request,
+                                 ImageFetcherCallback& image_callback);
+  void StoreImageInMemory(const CachedImageFetcherRequest& request,
+                          const gfx::Image& image);
+
   // Cache
   void OnImageFetchedFromCache(CachedImageFetcherRequest request,
                                ImageDataFetcherCallback image_data_callback,
@@ -110,6 +123,10 @@ class CachedImageFetcher : public ImageFetcher {
   // when only read only CachedImageFetchers are using it.
   bool read_only_;
 
+  // Recently decoded images, and the approximate number of bytes they use.
+  base::LRUCache<std::string, gfx::Image> memory_cache_;
+  size_t memory_cache_bytes_ = 0u;
+
   // Used to ensure that operations are performed on the sequence that this
   // object was created on.
   SEQUENCE_CHECKER(sequence_checker_);
@@ -16,6 +16,7 @@
 #include "base/task/sequenced_task_runner.h"
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/mock_callback.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/simple_test_clock.h"
 #include "base/test/task_environment.h"
 #include "components/image_fetcher/core/cache/image_cache.h"
@@ -23,6 +24,7 @@
 #include "components/image_fetcher/core/cache/image_metadata_store_leveldb.h"
 #include "components/image_fetcher/core/cache/proto/cached_image_metadata.pb.h"
 #include "components/image_fetcher/core/fake_image_decoder.h"
+#include "components/image_fetcher/core/features.h"
 #include "components/image_fetcher/core/image_fetcher_impl.h"
 #include "components/image_fetcher/core/image_fetcher_metrics_reporter.h"
 #include "components/image_fetcher/core/image_fetcher_types.h"
@@ -397,4 +399,37 @@ TEST_F(CachedImageFetcherTest, FetchImageWithSkipDiskCache) {
   RunUntilIdle();
 }
 
+TEST_F(CachedImageFetcherTest, FetchImageFromMemoryCache) {
+  base::test::ScopedFeatureList feature_list(
+      features::kDecodedImageMemoryCache);
+  const GURL kImageUrl("http://gstatic.img.com/foo.jpg");
+  test_url_loader_factory()->AddResponse(kImageUrl.spec(), kImageData);
+  {
+    base::MockCallback<ImageFetcherCallback> image_callback;
+    EXPECT_CALL(image_callback, Run(NonEmptyImage(), _));
+    cached_image_fetcher()->FetchImageAndData(
+        kImageUrl, ImageDataFetcherCallback(), image_callback.Get(),
+        ImageFetcherParams(TRAFFIC_ANNOTATION_FOR_TESTS, kUmaClientName));
+    db()->LoadCallback(true);
+    RunUntilIdle();
+  }
+
+  // The second request is served from memory, without the disk cache or the
+  // decoder.
+  test_url_loader_factory()->ClearResponses();
+  image_decoder()->SetDecodingValid(false);
+  base::MockCallback<ImageFetcherCallback> image_callback;
+  EXPECT_CALL(image_callback, Run(NonEmptyImage(), _));
+  cached_image_fetcher()->FetchImageAndData(
+      kImageUrl, ImageDataFetcherCallback(), image_callback.Get(),
+      ImageFetcherParams(TRAFFIC_ANNOTATION_FOR_TESTS, kUmaClientName));
+  RunUntilIdle();
+
+  histogram_tester().ExpectBucketCount("ImageFetcher.MemoryCacheHit", false,
+                                       1);
+  histogram_tester().ExpectBucketCount("ImageFetcher.MemoryCacheHit", true, 1);
+  histogram_tester().ExpectBucketCount(kImageFetcherEventHistogramName,
+                                       ImageFetcherEvent::kCacheHit, 0);
+}
+
 }  // namespace image_fetcher
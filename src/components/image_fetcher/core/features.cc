@@ -14,5 +14,9 @@ BASE_FEATURE(kBatchImageDecoding,
              base::FEATURE_ENABLED_BY_DEFAULT);
 #endif
 
+BASE_FEATURE(kDecodedImageMemoryCache,
+             "DecodedImageMemoryCache",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 }  // namespace features
 }  // namespace image_fetcher
@@ -15,6 +15,10 @@ namespace features {
 BASE_DECLARE_FEATURE(kBatchImageDecoding);
 #endif
 
+// Keeps recently decoded images in memory in CachedImageFetcher, so that
+// repeated requests for the same image skip the disk cache and the decoder.
+BASE_DECLARE_FEATURE(kDecodedImageMemoryCache);
+
 }  // namespace features
 }  // namespace image_fetcher
 
@@ -10,11 +10,17 @@
 #include "base/check.h"
 #include "base/debug/crash_logging.h"
 #include "base/debug/dump_without_crashing.h"
+#include "base/feature_list.h"
 #include "base/functional/bind.h"
 #include "base/logging.h"
 #include "base/memory/raw_ptr.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/notreached.h"
 #include "base/supports_user_data.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/timer/elapsed_timer.h"
+#include "base/trace_event/trace_event.h"
+#include "components/keyed_service/core/features.h"
 #include "components/keyed_service/core/keyed_service_base_factory.h"
 #include "components/keyed_service/core/keyed_service_factory.h"
 #include "components/keyed_service/core/refcounted_keyed_service_factory.h"
@@ -103,6 +109,11 @@ void DependencyManager::CreateContextServices(void* context,
   DumpContextDependencies(context);
 #endif
 
+  const bool defer_creation =
+      base::FeatureList::IsEnabled(keyed_service::kDeferKeyedServiceCreation) &&
+      base::SequencedTaskRunner::HasCurrentDefault();
+  std::vector<raw_ptr<KeyedServiceBaseFactory, VectorExperimental>>
+      deferred_factories;
   for (DependencyNode* dependency_node : construction_order) {
     KeyedServiceBaseFactory* factory =
         static_cast<KeyedServiceBaseFactory*>(dependency_node);
@@ -110,9 +121,61 @@ void DependencyManager::CreateContextServices(void* context,
         !factory->HasTestingFactory(context)) {
       factory->SetEmptyTestingFactory(context);
     } else if (factory->ServiceIsCreatedWithContext()) {
-      factory->CreateServiceNow(context);
+      if (defer_creation && factory->ServiceCreationCanBeDeferred()) {
+        deferred_factories.push_back(factory);
+      } else {
+        factory->CreateServiceNow(context);
+      }
     }
   }
+
+  if (deferred_factories.empty()) {
+    return;
+  }
+  TRACE_EVENT_INSTANT1("browser,startup",
+                       "DependencyManager::DeferredContextServices",
+                       TRACE_EVENT_SCOPE_THREAD, "count",
+                       deferred_factories.size());
+  deferred_factories_[context] = std::move(deferred_factories);
+  base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&DependencyManager::CreateDeferredContextServices,
+                     weak_ptr_factory_.GetWeakPtr(), context));
+}
+
+void DependencyManager::CreateDeferredContextServices(void* context) {
+  // The context may have been destroyed in the meantime.
+  auto it = deferred_factories_.find(context);
+  if (it == deferred_factories_.end()) {
+    return;
+  }
+  std::vector<raw_ptr<KeyedServiceBaseFactory, VectorExperimental>>
+      factories = std::move(it->second);
+  deferred_factories_.erase(it);
+
+  TRACE_EVENT0("browser,startup",
+               "DependencyManager::CreateDeferredContextServices");
+  base::ElapsedTimer timer;
+  int accessed_count = 0;
+  for (KeyedServiceBaseFactory* factory : factories) {
+    if (factory->IsServiceCreated(context)) {
+      // Records which of the deferred services were needed before the
+      // context creation settled, i.e. which deferrals saved nothing.
+      TRACE_EVENT_INSTANT1("browser,startup",
+                           "DependencyManager::DeferredServiceAccessed",
+                           TRACE_EVENT_SCOPE_THREAD, "name", factory->name());
+      ++accessed_count;
+      continue;
+    }
+    factory->CreateServiceNow(context);
+  }
+  // The time spent here was moved off the context creation path.
+  base::UmaHistogramTimes("KeyedService.DeferredServicesCreationTime",
+                          timer.Elapsed());
+  base::UmaHistogramCounts100("KeyedService.DeferredServicesCount",
+                              factories.size());
+  base::UmaHistogramCounts100("KeyedService.DeferredServicesAccessedCount",
+                              accessed_count);
 }
 
 void DependencyManager::DestroyContextServices(void* context) {
@@ -206,6 +269,7 @@ void DependencyManager::MarkContextLive(void* context) {
 
 void DependencyManager::MarkContextDead(void* context) {
   dead_context_pointers_.insert(context);
+  deferred_factories_.erase(context);
 }
 
 #ifndef NDEBUG
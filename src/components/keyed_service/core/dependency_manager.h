@@ -5,11 +5,14 @@
 #ifndef COMPONENTS_KEYED_SERVICE_CORE_DEPENDENCY_MANAGER_H_
 #define COMPONENTS_KEYED_SERVICE_CORE_DEPENDENCY_MANAGER_H_
 
+#include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "base/dcheck_is_on.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "components/keyed_service/core/dependency_graph.h"
 #include "components/keyed_service/core/keyed_service_export.h"
 
@@ -80,6 +83,11 @@ class KEYED_SERVICE_EXPORT DependencyManager {
   //
   // If |is_testing_context| then the service will not be started unless the
   // method KeyedServiceBaseFactory::ServiceIsNULLWhileTesting() return false.
+  //
+  // With keyed_service::kDeferKeyedServiceCreation enabled, services whose
+  // KeyedServiceBaseFactory::ServiceCreationCanBeDeferred() returns true are
+  // created from a task posted to the current sequence instead, unless they
+  // are accessed before it runs.
   void CreateContextServices(void* context, bool is_testing_context);
 
   // Called upon destruction of |context| to destroy all services associated
@@ -127,6 +135,10 @@ class KEYED_SERVICE_EXPORT DependencyManager {
       void* context,
       std::vector<raw_ptr<DependencyNode, VectorExperimental>>& order);
 
+  // Creates the services of |context| deferred by CreateContextServices() that
+  // were not accessed in the meantime.
+  void CreateDeferredContextServices(void* context);
+
   DependencyGraph dependency_graph_;
 
   // A list of context objects that have gone through the Shutdown() phase.
@@ -135,11 +147,19 @@ class KEYED_SERVICE_EXPORT DependencyManager {
   // with them.
   std::set<raw_ptr<void, SetExperimental>> dead_context_pointers_;
 
+  // The factories whose service creation was deferred, in construction order,
+  // for each context whose deferred services were not created yet.
+  std::map<void*,
+           std::vector<raw_ptr<KeyedServiceBaseFactory, VectorExperimental>>>
+      deferred_factories_;
+
 #if DCHECK_IS_ON()
   bool context_services_created_ = false;
 #endif
   bool disallow_factory_registration_ = false;
   std::string registration_function_name_error_message_;
+
+  base::WeakPtrFactory<DependencyManager> weak_ptr_factory_{this};
 };
 
 #endif  // COMPONENTS_KEYED_SERVICE_CORE_DEPENDENCY_MANAGER_H_
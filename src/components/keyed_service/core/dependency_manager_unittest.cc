@@ -0,0 +1,140 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/keyed_service/core/dependency_manager.h"
+
+#include <memory>
+
+#include "base/run_loop.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/test/task_environment.h"
+#include "components/keyed_service/core/features.h"
+#include "components/keyed_service/core/keyed_service.h"
+#include "components/keyed_service/core/keyed_service_factory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+class TestDependencyManager : public DependencyManager {
+ public:
+  TestDependencyManager() = default;
+  ~TestDependencyManager() override = default;
+
+  using DependencyManager::CreateContextServices;
+  using DependencyManager::DestroyContextServices;
+
+ private:
+#ifndef NDEBUG
+  void DumpContextDependencies(void* context) const override {}
+#endif  // NDEBUG
+};
+
+class TestFactory : public KeyedServiceFactory {
+ public:
+  TestFactory(const char* name,
+              DependencyManager* manager,
+              bool created_with_context,
+              bool can_be_deferred)
+      : KeyedServiceFactory(name, manager, SIMPLE),
+        created_with_context_(created_with_context),
+        can_be_deferred_(can_be_deferred) {}
+
+  KeyedService* GetService(void* context, bool create) {
+    return GetServiceForContext(context, create);
+  }
+
+ private:
+  // KeyedServiceFactory:
+  std::unique_ptr<KeyedService> BuildServiceInstanceFor(
+      void* context) const override {
+    return std::make_unique<KeyedService>();
+  }
+  bool IsOffTheRecord(void* context) const override { return false; }
+
+  // KeyedServiceBaseFactory:
+  void* GetContextToUse(void* context) const override { return context; }
+  bool ServiceIsCreatedWithContext() const override {
+    return created_with_context_;
+  }
+  bool ServiceCreationCanBeDeferred() const override {
+    return can_be_deferred_;
+  }
+  void CreateServiceNow(void* context) override {
+    GetServiceForContext(context, true);
+  }
+
+  const bool created_with_context_;
+  const bool can_be_deferred_;
+};
+
+class DependencyManagerTest : public testing::Test {
+ protected:
+  base::test::SingleThreadTaskEnvironment task_environment_;
+  TestDependencyManager manager_;
+  int context_ = 0;
+};
+
+TEST_F(DependencyManagerTest, CreatesServicesWithContext) {
+  TestFactory eager("Eager", &manager_, /*created_with_context=*/true,
+                    /*can_be_deferred=*/false);
+  TestFactory deferrable("Deferrable", &manager_,
+                         /*created_with_context=*/true,
+                         /*can_be_deferred=*/true);
+  TestFactory lazy("Lazy", &manager_, /*created_with_context=*/false,
+                   /*can_be_deferred=*/false);
+
+  manager_.CreateContextServices(&context_, /*is_testing_context=*/false);
+  EXPECT_TRUE(eager.IsServiceCreated(&context_));
+  EXPECT_TRUE(deferrable.IsServiceCreated(&context_));
+  EXPECT_FALSE(lazy.IsServiceCreated(&context_));
+
+  manager_.DestroyContextServices(&context_);
+}
+
+TEST_F(DependencyManagerTest, DefersServiceCreation) {
+  base::test::ScopedFeatureList feature_list(
+      keyed_service::kDeferKeyedServiceCreation);
+  base::HistogramTester histogram_tester;
+  TestFactory eager("Eager", &manager_, /*created_with_context=*/true,
+                    /*can_be_deferred=*/false);
+  TestFactory deferred("Deferred", &manager_, /*created_with_context=*/true,
+                       /*can_be_deferred=*/true);
+  TestFactory accessed("Accessed", &manager_, /*created_with_context=*/true,
+                       /*can_be_deferred=*/true);
+
+  manager_.CreateContextServices(&context_, /*is_testing_context=*/false);
+  EXPECT_TRUE(eager.IsServiceCreated(&context_));
+  EXPECT_FALSE(deferred.IsServiceCreated(&context_));
+  EXPECT_FALSE(accessed.IsServiceCreated(&context_));
+
+  // Accessing a deferred service creates it right away.
+  EXPECT_TRUE(accessed.GetService(&context_, /*create=*/true));
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(deferred.IsServiceCreated(&context_));
+  histogram_tester.ExpectUniqueSample("KeyedService.DeferredServicesCount", 2,
+                                      1);
+  histogram_tester.ExpectUniqueSample(
+      "KeyedService.DeferredServicesAccessedCount", 1, 1);
+
+  manager_.DestroyContextServices(&context_);
+}
+
+TEST_F(DependencyManagerTest, DeferredServicesNotCreatedAfterDestruction) {
+  base::test::ScopedFeatureList feature_list(
+      keyed_service::kDeferKeyedServiceCreation);
+  base::HistogramTester histogram_tester;
+  TestFactory deferred("Deferred", &manager_, /*created_with_context=*/true,
+                       /*can_be_deferred=*/true);
+
+  manager_.CreateContextServices(&context_, /*is_testing_context=*/false);
+  manager_.DestroyContextServices(&context_);
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(deferred.IsServiceCreated(&context_));
+  histogram_tester.ExpectTotalCount("KeyedService.DeferredServicesCount", 0);
+}
+
+}  // namespace
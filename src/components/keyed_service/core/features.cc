@@ -0,0 +1,13 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/keyed_service/core/features.h"
+
+namespace keyed_service {
+
+BASE_FEATURE(kDeferKeyedServiceCreation,
+             "DeferKeyedServiceCreation",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+}  // namespace keyed_service
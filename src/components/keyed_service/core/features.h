@@ -0,0 +1,21 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_KEYED_SERVICE_CORE_FEATURES_H_
+#define COMPONENTS_KEYED_SERVICE_CORE_FEATURES_H_
+
+#include "base/feature_list.h"
+#include "components/keyed_service/core/keyed_service_export.h"
+
+namespace keyed_service {
+
+// When enabled, the services of factories that are created with their context
+// and allow it (see KeyedServiceBaseFactory::ServiceCreationCanBeDeferred())
+// are no longer built while the context is created, but on first access or
+// from a task posted once the context is created, whichever comes first.
+KEYED_SERVICE_EXPORT BASE_DECLARE_FEATURE(kDeferKeyedServiceCreation);
+
+}  // namespace keyed_service
+
+#endif  // COMPONENTS_KEYED_SERVICE_CORE_FEATURES_H_
@@ -58,6 +58,10 @@ bool KeyedServiceBaseFactory::ServiceIsCreatedWithContext() const {
   return false;
 }
 
+bool KeyedServiceBaseFactory::ServiceCreationCanBeDeferred() const {
+  return false;
+}
+
 bool KeyedServiceBaseFactory::ServiceIsNULLWhileTesting() const {
   return false;
 }
@@ -82,6 +82,12 @@ class KEYED_SERVICE_EXPORT KeyedServiceBaseFactory : public DependencyNode {
   // context is created and should override this method to return true.
   virtual bool ServiceIsCreatedWithContext() const;
 
+  // Services created with the context may override this method to return true
+  // if nothing relies on them existing before they are first accessed. With
+  // keyed_service::kDeferKeyedServiceCreation enabled, they are then built on
+  // first access or once the context creation is over, instead of eagerly.
+  virtual bool ServiceCreationCanBeDeferred() const;
+
   // By default, testing contexts will be treated like normal contexts. If this
   // method is overridden to return true, then the service associated with the
   // testing context will be null.
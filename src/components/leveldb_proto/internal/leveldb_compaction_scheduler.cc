@@ -0,0 +1,136 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/leveldb_proto/internal/leveldb_compaction_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/functional/bind.h"
+#include "base/location.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/no_destructor.h"
+#include "base/process/process.h"
+#include "base/task/thread_pool.h"
+
+namespace leveldb_proto {
+
+namespace {
+
+// How long after the process started compactions are deferred.
+constexpr base::TimeDelta kStartupDeferral = base::Seconds(60);
+
+base::TimeTicks GetStartupEnd() {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const base::Time creation_time = base::Process::Current().CreationTime();
+  if (creation_time.is_null())
+    return now + kStartupDeferral;
+  return now - (base::Time::Now() - creation_time) + kStartupDeferral;
+}
+
+}  // namespace
+
+LevelDBCompactionScheduler::Request::Request(
+    scoped_refptr<base::SequencedTaskRunner> db_task_runner,
+    CompactCallback compact)
+    : db_task_runner(std::move(db_task_runner)),
+      compact(std::move(compact)),
+      request_time(base::TimeTicks::Now()) {}
+
+LevelDBCompactionScheduler::Request::Request(Request&&) = default;
+
+LevelDBCompactionScheduler::Request&
+LevelDBCompactionScheduler::Request::operator=(Request&&) = default;
+
+LevelDBCompactionScheduler::Request::~Request() = default;
+
+// static
+LevelDBCompactionScheduler* LevelDBCompactionScheduler::GetInstance() {
+  static base::NoDestructor<LevelDBCompactionScheduler> instance(
+      base::ThreadPool::CreateSequencedTaskRunner(
+          {base::TaskPriority::BEST_EFFORT,
+           base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN}),
+      GetStartupEnd());
+  return instance.get();
+}
+
+LevelDBCompactionScheduler::LevelDBCompactionScheduler(
+    scoped_refptr<base::SequencedTaskRunner> task_runner,
+    base::TimeTicks startup_end)
+    : task_runner_(std::move(task_runner)), startup_end_(startup_end) {
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
+LevelDBCompactionScheduler::~LevelDBCompactionScheduler() = default;
+
+void LevelDBCompactionScheduler::RequestCompaction(
+    scoped_refptr<base::SequencedTaskRunner> db_task_runner,
+    CompactCallback compact) {
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&LevelDBCompactionScheduler::AddRequest,
+                     base::Unretained(this),
+                     Request(std::move(db_task_runner), std::move(compact))));
+}
+
+void LevelDBCompactionScheduler::NotifyActivity() {
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&LevelDBCompactionScheduler::OnActivity,
+                     base::Unretained(this), base::TimeTicks::Now()));
+}
+
+void LevelDBCompactionScheduler::AddRequest(Request request) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  requests_.push(std::move(request));
+  MaybeRunNextCompaction();
+}
+
+void LevelDBCompactionScheduler::OnActivity(base::TimeTicks time) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  last_activity_ = std::max(last_activity_, time);
+  // If the timer is running, it now fires too early, and is started again.
+}
+
+void LevelDBCompactionScheduler::MaybeRunNextCompaction() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (compaction_running_ || requests_.empty())
+    return;
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  base::TimeTicks deferred_until = startup_end_;
+  if (!last_activity_.is_null()) {
+    deferred_until =
+        std::max(deferred_until, last_activity_ + kActivityQuietPeriod);
+  }
+  if (now < deferred_until) {
+    if (!timer_.IsRunning()) {
+      timer_.Start(FROM_HERE, deferred_until - now,
+                   base::BindOnce(
+                       &LevelDBCompactionScheduler::MaybeRunNextCompaction,
+                       base::Unretained(this)));
+    }
+    return;
+  }
+
+  Request request = std::move(requests_.front());
+  requests_.pop();
+  base::UmaHistogramLongTimes("ProtoDB.Compaction.DeferredTime",
+                              now - request.request_time);
+  compaction_running_ = true;
+  request.db_task_runner->PostTaskAndReplyWithResult(
+      FROM_HERE, std::move(request.compact),
+      base::BindOnce(&LevelDBCompactionScheduler::OnCompactionDone,
+                     base::Unretained(this)));
+}
+
+void LevelDBCompactionScheduler::OnCompactionDone(uint64_t compacted_bytes) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  compaction_running_ = false;
+  base::UmaHistogramMemoryKB("ProtoDB.Compaction.CompactedKB",
+                             static_cast<int>(compacted_bytes / 1024));
+  MaybeRunNextCompaction();
+}
+
+}  // namespace leveldb_proto
@@ -0,0 +1,93 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_LEVELDB_PROTO_INTERNAL_LEVELDB_COMPACTION_SCHEDULER_H_
+#define COMPONENTS_LEVELDB_PROTO_INTERNAL_LEVELDB_COMPACTION_SCHEDULER_H_
+
+#include <stdint.h>
+
+#include "base/component_export.h"
+#include "base/containers/queue.h"
+#include "base/functional/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/sequence_checker.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace leveldb_proto {
+
+// Coordinates the explicit compactions of the LevelDB databases of the
+// process, so that they neither compete with each other nor with startup and
+// navigations. The compactions run one at a time, once the process has been up
+// for a while and no activity has been reported for a quiet period. The
+// scheduler itself runs on a BEST_EFFORT sequence, so it also waits for the
+// rest of the process to be idle.
+//
+// Can be called from any sequence.
+class COMPONENT_EXPORT(LEVELDB_PROTO) LevelDBCompactionScheduler {
+ public:
+  // Returns a callback compacting a database, which returns the size of the
+  // data it compacted, in bytes.
+  using CompactCallback = base::OnceCallback<uint64_t()>;
+
+  // How long activity defers compactions.
+  static constexpr base::TimeDelta kActivityQuietPeriod = base::Seconds(10);
+
+  static LevelDBCompactionScheduler* GetInstance();
+
+  // Compactions are deferred until `startup_end`. Runs on `task_runner`.
+  LevelDBCompactionScheduler(
+      scoped_refptr<base::SequencedTaskRunner> task_runner,
+      base::TimeTicks startup_end);
+  ~LevelDBCompactionScheduler();
+
+  LevelDBCompactionScheduler(const LevelDBCompactionScheduler&) = delete;
+  LevelDBCompactionScheduler& operator=(const LevelDBCompactionScheduler&) =
+      delete;
+
+  // Runs `compact` on `db_task_runner`, the sequence of the database, once
+  // compactions are no longer deferred.
+  void RequestCompaction(
+      scoped_refptr<base::SequencedTaskRunner> db_task_runner,
+      CompactCallback compact);
+
+  // Defers the pending compactions for `kActivityQuietPeriod`, e.g. while
+  // navigations are in progress.
+  void NotifyActivity();
+
+ private:
+  struct Request {
+    Request(scoped_refptr<base::SequencedTaskRunner> db_task_runner,
+            CompactCallback compact);
+    Request(Request&&);
+    Request& operator=(Request&&);
+    ~Request();
+
+    scoped_refptr<base::SequencedTaskRunner> db_task_runner;
+    CompactCallback compact;
+    base::TimeTicks request_time;
+  };
+
+  void AddRequest(Request request);
+  void OnActivity(base::TimeTicks time);
+  // Starts the next compaction if it isn't deferred, or waits until it isn't.
+  void MaybeRunNextCompaction();
+  void OnCompactionDone(uint64_t compacted_bytes);
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  const base::TimeTicks startup_end_;
+
+  // Accessed on `task_runner_` only.
+  base::queue<Request> requests_;
+  base::TimeTicks last_activity_;
+  bool compaction_running_ = false;
+  base::OneShotTimer timer_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+};
+
+}  // namespace leveldb_proto
+
+#endif  // COMPONENTS_LEVELDB_PROTO_INTERNAL_LEVELDB_COMPACTION_SCHEDULER_H_
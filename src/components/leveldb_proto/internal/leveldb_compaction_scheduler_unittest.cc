@@ -0,0 +1,85 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/leveldb_proto/internal/leveldb_compaction_scheduler.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace leveldb_proto {
+
+class LevelDBCompactionSchedulerTest : public testing::Test {
+ protected:
+  // Returns a compaction of `size` bytes, which records `id` once run.
+  LevelDBCompactionScheduler::CompactCallback Compaction(int id,
+                                                         uint64_t size) {
+    return base::BindOnce(
+        [](std::vector<int>* compacted, int id, uint64_t size) {
+          compacted->push_back(id);
+          return size;
+        },
+        &compacted_, id, size);
+  }
+
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+  base::HistogramTester histogram_tester_;
+  std::vector<int> compacted_;
+};
+
+TEST_F(LevelDBCompactionSchedulerTest, DefersCompactionsUntilAfterStartup) {
+  constexpr base::TimeDelta kStartup = base::Seconds(60);
+  LevelDBCompactionScheduler scheduler(
+      base::SequencedTaskRunner::GetCurrentDefault(),
+      base::TimeTicks::Now() + kStartup);
+  scheduler.RequestCompaction(base::SequencedTaskRunner::GetCurrentDefault(),
+                              Compaction(1, 2048));
+  scheduler.RequestCompaction(base::SequencedTaskRunner::GetCurrentDefault(),
+                              Compaction(2, 4096));
+
+  task_environment_.FastForwardBy(kStartup - base::Seconds(1));
+  EXPECT_TRUE(compacted_.empty());
+
+  task_environment_.FastForwardBy(base::Seconds(1));
+  EXPECT_EQ(compacted_, std::vector<int>({1, 2}));
+  histogram_tester_.ExpectUniqueTimeSample("ProtoDB.Compaction.DeferredTime",
+                                           kStartup, 2);
+  histogram_tester_.ExpectBucketCount("ProtoDB.Compaction.CompactedKB", 2, 1);
+  histogram_tester_.ExpectBucketCount("ProtoDB.Compaction.CompactedKB", 4, 1);
+}
+
+TEST_F(LevelDBCompactionSchedulerTest, DefersCompactionsDuringActivity) {
+  LevelDBCompactionScheduler scheduler(
+      base::SequencedTaskRunner::GetCurrentDefault(), base::TimeTicks::Now());
+  scheduler.NotifyActivity();
+  scheduler.RequestCompaction(base::SequencedTaskRunner::GetCurrentDefault(),
+                              Compaction(1, 0));
+
+  // Activity during the quiet period extends it.
+  task_environment_.FastForwardBy(
+      LevelDBCompactionScheduler::kActivityQuietPeriod / 2);
+  scheduler.NotifyActivity();
+  task_environment_.FastForwardBy(
+      LevelDBCompactionScheduler::kActivityQuietPeriod / 2);
+  EXPECT_TRUE(compacted_.empty());
+
+  task_environment_.FastForwardBy(
+      LevelDBCompactionScheduler::kActivityQuietPeriod / 2);
+  EXPECT_EQ(compacted_, std::vector<int>({1}));
+
+  // Without activity, compactions run right away.
+  scheduler.RequestCompaction(base::SequencedTaskRunner::GetCurrentDefault(),
+                              Compaction(2, 0));
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(compacted_, std::vector<int>({1, 2}));
+}
+
+}  // namespace leveldb_proto
@@ -336,6 +336,17 @@ leveldb::Status LevelDB::Destroy() {
   return status;
 }
 
+uint64_t LevelDB::CompactAll() {
+  DFAKE_SCOPED_LOCK(thread_checker_);
+  if (!db_)
+    return 0;
+
+  const int64_t size =
+      database_dir_.empty() ? 0 : base::ComputeDirectorySize(database_dir_);
+  db_->CompactRange(nullptr, nullptr);
+  return size > 0 ? static_cast<uint64_t>(size) : 0;
+}
+
 bool LevelDB::GetApproximateMemoryUse(uint64_t* approx_mem) {
   std::string usage_string;
   return (db_->GetProperty("leveldb.approximate-memory-usage", &usage_string) &&
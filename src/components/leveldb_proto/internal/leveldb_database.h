@@ -127,6 +127,10 @@ class COMPONENT_EXPORT(LEVELDB_PROTO) LevelDB {
   // directory.
   virtual leveldb::Status Destroy();
 
+  // Compacts the whole database, and returns the size of its files before the
+  // compaction, in bytes.
+  virtual uint64_t CompactAll();
+
   // Returns true if we successfully read the approximate memory usage property
   // from the LevelDB.
   bool GetApproximateMemoryUse(uint64_t* approx_mem);
@@ -10,4 +10,8 @@ BASE_FEATURE(kProtoDBSharedMigration,
              "ProtoDBSharedMigration",
              base::FEATURE_ENABLED_BY_DEFAULT);
 
+BASE_FEATURE(kProtoDBScheduledCompaction,
+             "ProtoDBScheduledCompaction",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 }  // namespace leveldb_proto
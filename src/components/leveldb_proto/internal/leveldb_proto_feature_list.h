@@ -13,6 +13,11 @@ namespace leveldb_proto {
 extern const COMPONENT_EXPORT(LEVELDB_PROTO) base::Feature
     kProtoDBSharedMigration;
 
+// Compacts the shared database once the data of obsolete clients has been
+// removed from it, through the LevelDBCompactionScheduler.
+extern const COMPONENT_EXPORT(LEVELDB_PROTO) base::Feature
+    kProtoDBScheduledCompaction;
+
 }  // namespace leveldb_proto
 
 #endif  // COMPONENTS_LEVELDB_PROTO_INTERNAL_LEVELDB_PROTO_FEATURE_LIST_H_
@@ -12,9 +12,12 @@
 #include <utility>
 #include <vector>
 
+#include "base/check_op.h"
 #include "base/files/file_path.h"
 #include "base/functional/bind.h"
 #include "base/logging.h"
+#include "base/memory/weak_ptr.h"
+#include "base/strings/string_util.h"
 #include "base/task/sequenced_task_runner.h"
 #include "components/leveldb_proto/internal/proto_database_selector.h"
 #include "components/leveldb_proto/internal/shared_proto_database.h"
@@ -59,6 +62,9 @@ void COMPONENT_EXPORT(LEVELDB_PROTO) RunDestroyCallback(
 template <typename P, typename T = P>
 class ProtoDatabaseImpl : public ProtoDatabase<P, T> {
  public:
+  using LoadBatchCallback = base::RepeatingCallback<void(
+      std::unique_ptr<std::map<std::string, T>> keys_entries)>;
+
   // Force usage of unique db.
   ProtoDatabaseImpl(
       ProtoDbType db_type,
@@ -132,6 +138,17 @@ class ProtoDatabaseImpl : public ProtoDatabase<P, T> {
       typename Callbacks::Internal<T>::LoadKeysAndEntriesCallback callback)
       override;
 
+  // Internal only api. Loads the entries with keys starting with
+  // |target_prefix| in key order, in batches of at most |batch_size| entries.
+  // |batch_callback| runs with each non-empty batch, and |done_callback| runs
+  // once all batches were delivered, or with false if a load failed. A batch
+  // is only read and parsed once the previous one was delivered, so unlike
+  // LoadKeysAndEntriesWithFilter(), the whole prefix is never held in memory.
+  void LoadKeysAndEntriesInBatches(const std::string& target_prefix,
+                                   size_t batch_size,
+                                   LoadBatchCallback batch_callback,
+                                   Callbacks::UpdateCallback done_callback);
+
   void LoadKeys(Callbacks::LoadKeysCallback callback) override;
 
   void GetEntry(const std::string& key,
@@ -157,12 +174,27 @@ class ProtoDatabaseImpl : public ProtoDatabase<P, T> {
 
   void PostTransaction(base::OnceClosure task);
 
+  // Loads the batch starting at |start_key| for LoadKeysAndEntriesInBatches().
+  void LoadNextBatch(const std::string& target_prefix,
+                     const std::string& start_key,
+                     size_t batch_size,
+                     LoadBatchCallback batch_callback,
+                     Callbacks::UpdateCallback done_callback);
+  void OnBatchLoaded(const std::string& target_prefix,
+                     size_t batch_size,
+                     LoadBatchCallback batch_callback,
+                     Callbacks::UpdateCallback done_callback,
+                     bool success,
+                     std::unique_ptr<std::map<std::string, T>> keys_entries);
+
   ProtoDbType db_type_;
   scoped_refptr<ProtoDatabaseSelector> db_wrapper_;
   const bool force_unique_db_;
   const scoped_refptr<base::SequencedTaskRunner> task_runner_;
 
   base::FilePath db_dir_;
+
+  base::WeakPtrFactory<ProtoDatabaseImpl> weak_ptr_factory_{this};
 };
 
 namespace {
@@ -525,6 +557,80 @@ void ProtoDatabaseImpl<P, T>::LoadKeysAndEntriesWhile(
   PostTransaction(std::move(load_task));
 }
 
+template <typename P, typename T>
+void ProtoDatabaseImpl<P, T>::LoadKeysAndEntriesInBatches(
+    const std::string& target_prefix,
+    size_t batch_size,
+    LoadBatchCallback batch_callback,
+    Callbacks::UpdateCallback done_callback) {
+  DCHECK_GT(batch_size, 0u);
+  LoadNextBatch(target_prefix, target_prefix, batch_size,
+                std::move(batch_callback), std::move(done_callback));
+}
+
+template <typename P, typename T>
+void ProtoDatabaseImpl<P, T>::LoadNextBatch(
+    const std::string& target_prefix,
+    const std::string& start_key,
+    size_t batch_size,
+    LoadBatchCallback batch_callback,
+    Callbacks::UpdateCallback done_callback) {
+  // Stops at the first key out of the prefix, or after |batch_size| entries.
+  KeyIteratorController controller = base::BindRepeating(
+      [](const std::string& target_prefix, size_t batch_size, size_t* loaded,
+         const std::string& key) {
+        if (!base::StartsWith(key, target_prefix,
+                              base::CompareCase::SENSITIVE)) {
+          return Enums::kSkipAndStop;
+        }
+        return ++*loaded < batch_size ? Enums::kLoadAndContinue
+                                      : Enums::kLoadAndStop;
+      },
+      target_prefix, batch_size, base::Owned(std::make_unique<size_t>(0)));
+  base::OnceClosure load_task = base::BindOnce(
+      &ProtoDatabaseSelector::LoadKeysAndEntriesWhile, db_wrapper_, start_key,
+      std::move(controller),
+      base::BindOnce(
+          &ParseLoadedKeysAndEntries<P, T>,
+          base::SequencedTaskRunner::GetCurrentDefault(),
+          base::BindOnce(&ProtoDatabaseImpl<P, T>::OnBatchLoaded,
+                         weak_ptr_factory_.GetWeakPtr(), target_prefix,
+                         batch_size, std::move(batch_callback),
+                         std::move(done_callback))));
+  PostTransaction(std::move(load_task));
+}
+
+template <typename P, typename T>
+void ProtoDatabaseImpl<P, T>::OnBatchLoaded(
+    const std::string& target_prefix,
+    size_t batch_size,
+    LoadBatchCallback batch_callback,
+    Callbacks::UpdateCallback done_callback,
+    bool success,
+    std::unique_ptr<std::map<std::string, T>> keys_entries) {
+  if (!success || !keys_entries) {
+    std::move(done_callback).Run(false);
+    return;
+  }
+  if (keys_entries->size() < batch_size) {
+    if (!keys_entries->empty())
+      batch_callback.Run(std::move(keys_entries));
+    std::move(done_callback).Run(true);
+    return;
+  }
+
+  // The next batch starts right after the last key of this one.
+  std::string next_key = keys_entries->rbegin()->first;
+  next_key.push_back('\0');
+  // The client may destroy the database from |batch_callback|.
+  base::WeakPtr<ProtoDatabaseImpl> weak_this = weak_ptr_factory_.GetWeakPtr();
+  batch_callback.Run(std::move(keys_entries));
+  if (!weak_this)
+    return;
+  LoadNextBatch(target_prefix, next_key, batch_size, std::move(batch_callback),
+                std::move(done_callback));
+}
+
 template <typename P, typename T>
 void ProtoDatabaseImpl<P, T>::LoadKeys(Callbacks::LoadKeysCallback callback) {
   base::OnceClosure load_task = base::BindOnce(
@@ -1078,6 +1078,49 @@ TYPED_TEST(ProtoDatabaseImplTest, InitWithOptions) {
   run_init.Run();
 }
 
+TYPED_TEST(ProtoDatabaseImplTest, LoadKeysAndEntriesInBatches) {
+  auto data_set = std::make_unique<std::vector<std::string>>();
+  for (const char* key : {"a1", "a2", "a3", "a4", "a5", "b1"})
+    data_set->emplace_back(key);
+
+  auto db_provider = this->CreateProviderNoSharedDB();
+  auto db_impl = this->CreateDBImpl(
+      ProtoDbType::TEST_DATABASE1, this->temp_dir(),
+      this->GetTestThreadTaskRunner(),
+      this->CreateSharedProvider(db_provider.get()));
+  this->InitDBImplAndWait(db_impl.get(), kDefaultClientName, false,
+                          Enums::InitStatus::kOK);
+  this->AddDataToDBImpl(db_impl.get(), data_set.get());
+
+  std::vector<std::vector<std::string>> batches;
+  base::RunLoop load_loop;
+  db_impl->LoadKeysAndEntriesInBatches(
+      "a", 2,
+      base::BindRepeating(
+          [](std::vector<std::vector<std::string>>* batches,
+             std::unique_ptr<std::map<std::string, TypeParam>> keys_entries) {
+            std::vector<std::string> keys;
+            for (const auto& pair : *keys_entries) {
+              EXPECT_EQ(pair.first + pair.first, pair.second.id());
+              keys.push_back(pair.first);
+            }
+            batches->push_back(std::move(keys));
+          },
+          &batches),
+      base::BindOnce(
+          [](base::OnceClosure closure, bool success) {
+            EXPECT_TRUE(success);
+            std::move(closure).Run();
+          },
+          load_loop.QuitClosure()));
+  load_loop.Run();
+
+  // The entries out of the prefix aren't loaded.
+  std::vector<std::vector<std::string>> expected_batches = {
+      {"a1", "a2"}, {"a3", "a4"}, {"a5"}};
+  EXPECT_EQ(expected_batches, batches);
+}
+
 TYPED_TEST(ProtoDatabaseImplTest, InitUniqueTwiceShouldSucceed) {
   base::ScopedTempDir temp_dir_profile;
   ASSERT_TRUE(temp_dir_profile.CreateUniqueTempDir());
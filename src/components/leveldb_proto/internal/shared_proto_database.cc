@@ -12,7 +12,9 @@
 #include "base/synchronization/lock.h"
 #include "base/task/sequenced_task_runner.h"
 #include "base/task/thread_pool.h"
+#include "components/leveldb_proto/internal/leveldb_compaction_scheduler.h"
 #include "components/leveldb_proto/internal/leveldb_database.h"
+#include "components/leveldb_proto/internal/leveldb_proto_feature_list.h"
 #include "components/leveldb_proto/internal/proto_database_selector.h"
 #include "components/leveldb_proto/internal/proto_leveldb_wrapper.h"
 #include "components/leveldb_proto/public/proto_database.h"
@@ -473,11 +475,12 @@ void SharedProtoDatabase::OnDatabaseInit(bool create_if_missing,
   if (init_state_ == InitState::kSuccess) {
     // Hold on to shared db until the remove operation is done or Shutdown()
     // clears the task.
-    Callbacks::UpdateCallback keep_shared_db_alive =
-        base::DoNothingWithBoundArgs(base::WrapRefCounted<>(this));
+    Callbacks::UpdateCallback on_done = base::BindOnce(
+        &SharedProtoDatabase::OnDestroyObsoleteSharedProtoDatabaseClients,
+        this);
     delete_obsolete_task_.Reset(base::BindOnce(
         &SharedProtoDatabase::DestroyObsoleteSharedProtoDatabaseClients, this,
-        std::move(keep_shared_db_alive)));
+        std::move(on_done)));
     base::AutoLock lock(delete_obsolete_delay_lock_);
     task_runner_->PostDelayedTask(FROM_HERE, delete_obsolete_task_.callback(),
                                   delete_obsolete_delay_);
@@ -606,6 +609,21 @@ void SharedProtoDatabase::DestroyObsoleteSharedProtoDatabaseClients(
       std::move(db_wrapper), std::move(done));
 }
 
+void SharedProtoDatabase::OnDestroyObsoleteSharedProtoDatabaseClients(
+    bool success) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(on_task_runner_);
+  // The removed data is only reclaimed by compactions.
+  if (!success || !base::FeatureList::IsEnabled(kProtoDBScheduledCompaction))
+    return;
+  LevelDBCompactionScheduler::GetInstance()->RequestCompaction(
+      task_runner_,
+      base::BindOnce(
+          [](scoped_refptr<SharedProtoDatabase> db) {
+            return db->db_->CompactAll();
+          },
+          base::WrapRefCounted(this)));
+}
+
 void SharedProtoDatabase::SetDeleteObsoleteDelayForTesting(
     base::TimeDelta delay) {
   base::AutoLock lock(delete_obsolete_delay_lock_);
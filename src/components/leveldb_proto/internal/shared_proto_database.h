@@ -164,6 +164,10 @@ class COMPONENT_EXPORT(LEVELDB_PROTO) SharedProtoDatabase
   virtual void DestroyObsoleteSharedProtoDatabaseClients(
       Callbacks::UpdateCallback done);
 
+  // Requests a compaction of the database, once the obsolete clients' data has
+  // been removed.
+  void OnDestroyObsoleteSharedProtoDatabaseClients(bool success);
+
   LevelDB* GetLevelDBForTesting() const;
 
   void SetDeleteObsoleteDelayForTesting(base::TimeDelta delay);
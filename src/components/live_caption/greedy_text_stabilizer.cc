@@ -4,6 +4,7 @@
 
 #include "components/live_caption/greedy_text_stabilizer.h"
 
+#include <algorithm>
 #include <regex>
 #include <string>
 #include <unordered_map>
@@ -28,6 +29,16 @@ GreedyTextStabilizer::GreedyTextStabilizer(int min_token_frequency)
 
 GreedyTextStabilizer::~GreedyTextStabilizer() = default;
 
+GreedyTextStabilizer::TokenHistogram::TokenHistogram() = default;
+
+GreedyTextStabilizer::TokenHistogram::TokenHistogram(TokenHistogram&&) =
+    default;
+
+GreedyTextStabilizer::TokenHistogram&
+GreedyTextStabilizer::TokenHistogram::operator=(TokenHistogram&&) = default;
+
+GreedyTextStabilizer::TokenHistogram::~TokenHistogram() = default;
+
 std::string GreedyTextStabilizer::UpdateText(const std::string& input_text,
                                              const bool is_final) {
   // For final recognition results, we use all tokens even if they are unstable.
@@ -48,37 +59,31 @@ std::string GreedyTextStabilizer::UpdateText(const std::string& input_text,
     return input_text;
   }
 
-  // Add each token to the correct position in the tokens dictionary.
-  for (unsigned long i = 0; i < tokens.size(); ++i) {
-    const std::string token = RemoveTrailingSpace(tokens[i]);
-    // If this location in the sentence does not yet exist, we need to extend
-    // the vector to include this location.
-    if (i >= tokens_histograms_.size()) {
-      std::unordered_map<std::string, int> token_histogram = {{token, 1}};
-      tokens_histograms_.push_back(token_histogram);
-    } else {
-      // Increment the count of the token in the dictionary at this location.
-      tokens_histograms_[i][token]++;
-    }
+  if (tokens_histograms_.size() < tokens.size()) {
+    tokens_histograms_.resize(tokens.size());
   }
 
-  // Now compare the input tokens to those in the distributions.
-  // As we consider the token at each location, we determine it to be stable if
-  // it is the mode in the token dictionary for that location and its token
-  // frequency is high enough. Otherwise, it is considered unstable, and we exit
-  // early.
+  // Add each token to the correct position in the tokens dictionary, and
+  // compare it to the distribution at that position in the same pass.
+  // A token is stable if it is the mode in the token dictionary for its
+  // location and its token frequency is high enough. The stable tokens are the
+  // ones before the first unstable token.
   stable_token_count_ = 0;
   int stable_character_count = 0;
-  for (unsigned long i = 0; i < tokens.size(); i++) {
-    const std::string token = RemoveTrailingSpace(tokens[i]);
-    if (i < tokens_histograms_.size() &&
-        tokens_histograms_[i][token] >= min_token_frequency_ &&
-        IsMode(token, tokens_histograms_[i])) {
+  bool is_stable = true;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    TokenHistogram& histogram = tokens_histograms_[i];
+    const int token_count = ++histogram.counts[RemoveTrailingSpace(tokens[i])];
+    histogram.max_count = std::max(histogram.max_count, token_count);
+
+    // There could be multiple modes in the histogram, and we only need to
+    // ensure that the token is one of them.
+    is_stable = is_stable && token_count >= min_token_frequency_ &&
+                token_count == histogram.max_count;
+    if (is_stable) {
       // Use the size of the unstripped token.
       stable_character_count += tokens[i].size();
       stable_token_count_++;
-    } else {
-      break;
     }
   }
 
@@ -125,22 +130,4 @@ std::vector<std::string> GreedyTextStabilizer::Tokenize(
   return tokens;
 }
 
-bool GreedyTextStabilizer::IsMode(
-    const std::string& token,
-    const std::unordered_map<std::string, int>& token_histogram) {
-  const int token_count = token_histogram.at(token);
-
-  // There could be multiple modes in the histogram, and we only need to ensure
-  // that the given token is one of the modes.  Thus, the given token is a mode
-  // only if no other token has a higher count than the given token.
-  for (const auto& element : token_histogram) {
-    if (element.second > token_count) {
-      // If we have found a token with a higher count, we exit early and
-      // indicate that the given token is not a mode.
-      return false;
-    }
-  }
-  return true;
-}
-
 }  // namespace captions
@@ -33,8 +33,21 @@ class GreedyTextStabilizer {
   // Minimum number of times a token must appear to be counted.
   const int min_token_frequency_ = 0;
 
+  // The counts of the tokens seen at one location in the sequence.
+  struct TokenHistogram {
+    TokenHistogram();
+    TokenHistogram(TokenHistogram&&);
+    TokenHistogram& operator=(TokenHistogram&&);
+    ~TokenHistogram();
+
+    std::unordered_map<std::string, int> counts;
+    // The highest value in `counts`, so that whether a token is a mode of the
+    // histogram can be checked without scanning it.
+    int max_count = 0;
+  };
+
   // List of token counts at different locations in the sequence.
-  std::vector<std::unordered_map<std::string, int>> tokens_histograms_;
+  std::vector<TokenHistogram> tokens_histograms_;
   std::string stable_text_ = "";
   int max_stable_token_count_ = 0;
   int stable_token_count_ = 0;
@@ -43,10 +56,6 @@ class GreedyTextStabilizer {
 
   // Divides a string of text into individual tokens independent of language.
   std::vector<std::string> Tokenize(const std::string& input_text);
-
-  // Checks whether the input token is a mode of the token histogram.
-  bool IsMode(const std::string& token,
-              const std::unordered_map<std::string, int>& token_histogram);
 };
 
 }  // namespace captions
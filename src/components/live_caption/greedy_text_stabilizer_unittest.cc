@@ -259,4 +259,23 @@ TEST_F(GreedyTextStabilizerTest, KoreanTokensAreStabilized) {
   }
 }
 
+// A token that ties with another for the highest count at its location is a
+// mode, and so is stable.
+TEST_F(GreedyTextStabilizerTest, TiedTokensAreStable) {
+  GreedyTextStabilizer stabilizer(1);
+  EXPECT_EQ(stabilizer.UpdateText("a b"), "a b");
+  EXPECT_EQ(stabilizer.GetStableTokenCount(), 3);
+
+  // "c" ties with "b", and both stay stable.
+  EXPECT_EQ(stabilizer.UpdateText("a c"), "a c");
+  EXPECT_EQ(stabilizer.GetStableTokenCount(), 3);
+  EXPECT_EQ(stabilizer.UpdateText("a b"), "a b");
+  EXPECT_EQ(stabilizer.UpdateText("a b"), "a b");
+
+  // "b" now has the highest count, so "c" isn't stable and the previous stable
+  // text is kept.
+  EXPECT_EQ(stabilizer.UpdateText("a c"), "a b");
+  EXPECT_EQ(stabilizer.GetStableTokenCount(), 2);
+}
+
 }  // namespace captions
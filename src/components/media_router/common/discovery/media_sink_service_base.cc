@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "components/media_router/common/discovery/media_sink_service_base.h"
+#include "base/containers/contains.h"
 #include "base/functional/bind.h"
 #include "base/logging.h"
 #include "base/observer_list.h"
@@ -13,10 +14,16 @@
 namespace {
 // Timeout amount for |discovery_timer_|.
 const constexpr base::TimeDelta kDiscoveryTimeout = base::Seconds(3);
+// Delay for |new_sink_timer_|.
+const constexpr base::TimeDelta kNewSinkDelay = base::Milliseconds(200);
 }  // namespace
 
 namespace media_router {
 
+BASE_FEATURE(kEarlySinkListUpdates,
+             "EarlySinkListUpdates",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 MediaSinkServiceBase::MediaSinkServiceBase(
     const OnSinksDiscoveredCallback& callback)
     : discovery_timer_(std::make_unique<base::OneShotTimer>()),
@@ -58,11 +65,21 @@ const MediaSinkInternal* MediaSinkServiceBase::GetSinkByRoute(
 
 void MediaSinkServiceBase::AddOrUpdateSink(const MediaSinkInternal& sink) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  const bool is_new_sink = !base::Contains(sinks_, sink.sink().id());
   sinks_.insert_or_assign(sink.sink().id(), sink);
   for (auto& observer : observers_)
     observer.OnSinkAddedOrUpdated(sink);
 
   StartTimer();
+
+  // Don't make the user wait for the rest of discovery to see a new sink.
+  if (is_new_sink && base::FeatureList::IsEnabled(kEarlySinkListUpdates) &&
+      !new_sink_timer_.IsRunning()) {
+    new_sink_timer_.Start(
+        FROM_HERE, kNewSinkDelay,
+        base::BindOnce(&MediaSinkServiceBase::SendSinksIfChanged,
+                       base::Unretained(this)));
+  }
 }
 
 void MediaSinkServiceBase::RemoveSink(const MediaSinkInternal& sink) {
@@ -108,6 +125,12 @@ void MediaSinkServiceBase::OnDiscoveryComplete() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   discovery_timer_->Stop();
   RecordDeviceCounts();
+  SendSinksIfChanged();
+}
+
+void MediaSinkServiceBase::SendSinksIfChanged() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  new_sink_timer_.Stop();
 
   // Only send discovered sinks back to MediaRouter if the list changed.
   if (sinks_ == previous_sinks_) {
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/feature_list.h"
 #include "base/gtest_prod_util.h"
 #include "base/observer_list.h"
 #include "base/sequence_checker.h"
@@ -20,6 +21,10 @@ namespace media_router {
 
 class MediaRoute;
 
+// When enabled, newly discovered sinks are sent out shortly after they are
+// found instead of waiting for the discovery timer.
+BASE_DECLARE_FEATURE(kEarlySinkListUpdates);
+
 // Base class for discovering MediaSinks. Responsible for bookkeeping of
 // current set of discovered sinks, and notifying observers when there are
 // updates.
@@ -105,6 +110,10 @@ class MediaSinkServiceBase {
   // Overriden by subclass to report device counts.
   virtual void RecordDeviceCounts() {}
 
+  // Sends |sinks_| to observers and |on_sinks_discovered_cb_| if they changed
+  // since they were last sent.
+  void SendSinksIfChanged();
+
   // The current set of discovered sinks keyed by MediaSink ID.
   base::flat_map<MediaSink::Id, MediaSinkInternal> sinks_;
 
@@ -117,6 +126,10 @@ class MediaSinkServiceBase {
   // state before the metrics are recorded.
   std::unique_ptr<base::OneShotTimer> discovery_timer_;
 
+  // Timer for sending the sink list soon after a new sink is added, with
+  // kEarlySinkListUpdates. The short delay batches sinks discovered together.
+  base::OneShotTimer new_sink_timer_;
+
   // The following fields exist temporarily for sending back discovered sinks to
   // the Media Router extension.
   // TODO(crbug.com/40561499): Remove once the extension no longer need
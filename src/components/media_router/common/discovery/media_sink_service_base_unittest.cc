@@ -6,6 +6,8 @@
 
 #include "base/memory/ptr_util.h"
 #include "base/test/mock_callback.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/test/task_environment.h"
 #include "base/timer/mock_timer.h"
 #include "components/media_router/common/test/test_helper.h"
 #include "testing/gmock/include/gmock/gmock.h"
@@ -75,6 +77,8 @@ class MediaSinkServiceBaseTest : public ::testing::Test {
   }
 
  protected:
+  base::test::TaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
   base::MockCallback<OnSinksDiscoveredCallback> mock_sink_discovered_cb_;
   TestMediaSinkService media_sink_service_;
 };
@@ -142,4 +146,31 @@ TEST_F(MediaSinkServiceBaseTest, TestOnDiscoveryComplete_Mixed) {
   TestOnDiscoveryComplete(old_sinks, new_sinks);
 }
 
+TEST_F(MediaSinkServiceBaseTest, NewSinksSentBeforeDiscoveryComplete) {
+  base::test::ScopedFeatureList feature_list(kEarlySinkListUpdates);
+  std::vector<MediaSinkInternal> sinks = CreateDialMediaSinks();
+
+  EXPECT_CALL(mock_sink_discovered_cb_, Run(_)).Times(0);
+  media_sink_service_.AddOrUpdateSink(sinks[0]);
+  media_sink_service_.AddOrUpdateSink(sinks[1]);
+  ::testing::Mock::VerifyAndClearExpectations(&mock_sink_discovered_cb_);
+
+  // Both sinks are sent together shortly after they are added, while the
+  // discovery timer is still running.
+  EXPECT_CALL(mock_sink_discovered_cb_, Run(sinks));
+  task_environment_.FastForwardBy(base::Seconds(1));
+  ::testing::Mock::VerifyAndClearExpectations(&mock_sink_discovered_cb_);
+  EXPECT_TRUE(media_sink_service_.timer()->IsRunning());
+
+  // Updating a known sink doesn't send the list early.
+  sinks[0].sink().set_name("sink_name_3");
+  EXPECT_CALL(mock_sink_discovered_cb_, Run(_)).Times(0);
+  media_sink_service_.AddOrUpdateSink(sinks[0]);
+  task_environment_.FastForwardBy(base::Seconds(1));
+  ::testing::Mock::VerifyAndClearExpectations(&mock_sink_discovered_cb_);
+
+  EXPECT_CALL(mock_sink_discovered_cb_, Run(sinks));
+  media_sink_service_.timer()->Fire();
+}
+
 }  // namespace media_router
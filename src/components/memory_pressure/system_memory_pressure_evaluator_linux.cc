@@ -4,9 +4,18 @@
 
 #include "components/memory_pressure/system_memory_pressure_evaluator_linux.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/functional/bind.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/process/process_metrics.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
 #include "base/task/single_thread_task_runner.h"
 #include "base/task/task_traits.h"
 #include "base/time/time.h"
@@ -28,6 +37,20 @@ int GetAvailableSystemMemoryMiB(const base::SystemMemoryInfoKB& mem_info) {
   return mem_available / kKiBperMiB;
 }
 
+// Parses the avg10 field of a line of /proc/pressure/memory, e.g.
+// "some avg10=0.00 avg60=0.00 avg300=0.00 total=0".
+std::optional<double> ParseStallAvg10(std::string_view line) {
+  for (std::string_view field : base::SplitStringPiece(
+           line, " ", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    double value = 0;
+    if (base::StartsWith(field, "avg10=") &&
+        base::StringToDouble(field.substr(6), &value)) {
+      return value;
+    }
+  }
+  return std::nullopt;
+}
+
 }  // namespace
 
 namespace memory_pressure {
@@ -42,6 +65,29 @@ const base::TimeDelta SystemMemoryPressureEvaluator::kModeratePressureCooldown =
 const int SystemMemoryPressureEvaluator::kDefaultModerateThresholdPc = 75;
 const int SystemMemoryPressureEvaluator::kDefaultCriticalThresholdPc = 85;
 
+const double SystemMemoryPressureEvaluator::kModerateSomeStallThresholdPc = 10;
+const double SystemMemoryPressureEvaluator::kCriticalFullStallThresholdPc = 10;
+
+// static
+std::optional<SystemMemoryPressureEvaluator::MemoryStallInfo>
+SystemMemoryPressureEvaluator::ParseMemoryStallInfo(std::string_view contents) {
+  std::optional<double> some_avg10;
+  std::optional<double> full_avg10;
+  for (std::string_view line : base::SplitStringPiece(
+           contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    if (base::StartsWith(line, "some ")) {
+      some_avg10 = ParseStallAvg10(line);
+    } else if (base::StartsWith(line, "full ")) {
+      full_avg10 = ParseStallAvg10(line);
+    }
+  }
+  if (!some_avg10.has_value() || !full_avg10.has_value()) {
+    return std::nullopt;
+  }
+  return MemoryStallInfo{.some_avg10 = some_avg10.value(),
+                         .full_avg10 = full_avg10.value()};
+}
+
 SystemMemoryPressureEvaluator::SystemMemoryPressureEvaluator(
     std::unique_ptr<MemoryPressureVoter> voter)
     : memory_pressure::SystemMemoryPressureEvaluator(std::move(voter)),
@@ -83,6 +129,26 @@ bool SystemMemoryPressureEvaluator::GetSystemMemoryInfo(
   return base::GetSystemMemoryInfo(mem_info);
 }
 
+std::optional<SystemMemoryPressureEvaluator::MemoryStallInfo>
+SystemMemoryPressureEvaluator::GetMemoryStallInfo() {
+  // procfs is backed by memory, so this doesn't block on I/O.
+  std::string contents;
+  if (!base::ReadFileToString(base::FilePath("/proc/pressure/memory"),
+                              &contents)) {
+    return std::nullopt;
+  }
+  return ParseMemoryStallInfo(contents);
+}
+
+std::optional<int> SystemMemoryPressureEvaluator::GetAvailableHeadroomMb() {
+  base::SystemMemoryInfoKB mem_info;
+  if (!GetSystemMemoryInfo(&mem_info)) {
+    return std::nullopt;
+  }
+  return std::max(
+      GetAvailableSystemMemoryMiB(mem_info) - critical_threshold_mb_, 0);
+}
+
 void SystemMemoryPressureEvaluator::CheckMemoryPressure() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -149,6 +215,15 @@ bool SystemMemoryPressureEvaluator::InferThresholds() {
 
 base::MemoryPressureListener::MemoryPressureLevel
 SystemMemoryPressureEvaluator::CalculateCurrentPressureLevel() {
+  // Tasks stall waiting for memory when the kernel has to reclaim it, which
+  // can happen before the available memory reaches the thresholds, for
+  // example when the page cache is thrashing.
+  const std::optional<MemoryStallInfo> stall_info = GetMemoryStallInfo();
+  if (stall_info.has_value() &&
+      stall_info->full_avg10 >= kCriticalFullStallThresholdPc) {
+    return base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL;
+  }
+
   base::SystemMemoryInfoKB mem_info;
   if (GetSystemMemoryInfo(&mem_info)) {
     // How much system memory is actively available for use right now, in MBs.
@@ -164,6 +239,10 @@ SystemMemoryPressureEvaluator::CalculateCurrentPressureLevel() {
       return base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE;
     }
   }
+  if (stall_info.has_value() &&
+      stall_info->some_avg10 >= kModerateSomeStallThresholdPc) {
+    return base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE;
+  }
   // No memory pressure was detected.
   return base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE;
 }
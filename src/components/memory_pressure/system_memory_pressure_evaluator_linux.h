@@ -5,6 +5,9 @@
 #ifndef COMPONENTS_MEMORY_PRESSURE_SYSTEM_MEMORY_PRESSURE_EVALUATOR_LINUX_H_
 #define COMPONENTS_MEMORY_PRESSURE_SYSTEM_MEMORY_PRESSURE_EVALUATOR_LINUX_H_
 
+#include <optional>
+#include <string_view>
+
 #include "base/memory/memory_pressure_listener.h"
 #include "base/process/process_metrics.h"
 #include "base/sequence_checker.h"
@@ -17,9 +20,10 @@ namespace memory_pressure {
 namespace os_linux {
 
 // Linux memory pressure voter. Because there is no OS provided signal this
-// polls at a low frequency, and applies internal hysteresis.
-// TODO(crbug.com/40714150): use Pressure Stall Information (PSI) on
-// kernels >4.20.
+// polls at a low frequency, and applies internal hysteresis. On kernels that
+// provide Pressure Stall Information (PSI), the time that tasks stall waiting
+// for memory raises the pressure level before the available memory reaches the
+// thresholds, as an early warning.
 class SystemMemoryPressureEvaluator
     : public memory_pressure::SystemMemoryPressureEvaluator {
  public:
@@ -37,6 +41,24 @@ class SystemMemoryPressureEvaluator
   static const int kDefaultModerateThresholdPc;
   static const int kDefaultCriticalThresholdPc;
 
+  // Percentages of time over the last 10 seconds during which some tasks
+  // (moderate) or all tasks (critical) stalled waiting for memory, above which
+  // the applicable memory pressure state engages.
+  static const double kModerateSomeStallThresholdPc;
+  static const double kCriticalFullStallThresholdPc;
+
+  // The memory stall times reported by /proc/pressure/memory, as percentages
+  // of the last 10 seconds.
+  struct MemoryStallInfo {
+    double some_avg10 = 0;
+    double full_avg10 = 0;
+  };
+
+  // Parses the contents of /proc/pressure/memory. Returns nullopt if they are
+  // malformed.
+  static std::optional<MemoryStallInfo> ParseMemoryStallInfo(
+      std::string_view contents);
+
   // Default constructor. Will choose thresholds automatically based on the
   // actual amount of system memory.
   explicit SystemMemoryPressureEvaluator(
@@ -60,6 +82,11 @@ class SystemMemoryPressureEvaluator
   // Returns the critical pressure level free memory threshold, in MB.
   int critical_threshold_mb() const { return critical_threshold_mb_; }
 
+  // Returns the amount of available memory above the critical threshold, in
+  // MB, or nullopt if it can't be read. Unlike the pressure levels, this is a
+  // continuous signal that lets consumers scale their caches smoothly.
+  std::optional<int> GetAvailableHeadroomMb();
+
  protected:
   // Internals are exposed for unittests.
 
@@ -92,6 +119,10 @@ class SystemMemoryPressureEvaluator
   // declared as virtual for unit testing
   virtual bool GetSystemMemoryInfo(base::SystemMemoryInfoKB* mem_info);
 
+  // Reads /proc/pressure/memory. Returns nullopt if PSI isn't supported by the
+  // kernel. Virtual for unit testing.
+  virtual std::optional<MemoryStallInfo> GetMemoryStallInfo();
+
  private:
   // Threshold amounts of available memory that trigger pressure levels
   int moderate_threshold_mb_;
@@ -87,8 +87,17 @@ class TestSystemMemoryPressureEvaluator : public SystemMemoryPressureEvaluator {
     return true;
   }
 
+  void SetMemoryStallInfo(std::optional<MemoryStallInfo> stall_info) {
+    stall_info_ = stall_info;
+  }
+
+  std::optional<MemoryStallInfo> GetMemoryStallInfo() override {
+    return stall_info_;
+  }
+
  private:
   base::SystemMemoryInfoKB mem_status_;
+  std::optional<MemoryStallInfo> stall_info_;
 };
 
 class LinuxSystemMemoryPressureEvaluatorTest : public testing::Test {
@@ -255,5 +264,52 @@ TEST_F(LinuxSystemMemoryPressureEvaluatorTest, CheckMemoryPressure) {
   testing::Mock::VerifyAndClearExpectations(&evaluator);
 }
 
+TEST_F(LinuxSystemMemoryPressureEvaluatorTest, ParseMemoryStallInfo) {
+  std::optional<SystemMemoryPressureEvaluator::MemoryStallInfo> stall_info =
+      SystemMemoryPressureEvaluator::ParseMemoryStallInfo(
+          "some avg10=12.50 avg60=3.00 avg300=1.00 total=123456\n"
+          "full avg10=2.25 avg60=0.50 avg300=0.10 total=23456\n");
+  ASSERT_TRUE(stall_info.has_value());
+  EXPECT_DOUBLE_EQ(12.5, stall_info->some_avg10);
+  EXPECT_DOUBLE_EQ(2.25, stall_info->full_avg10);
+
+  EXPECT_FALSE(SystemMemoryPressureEvaluator::ParseMemoryStallInfo(
+                   "some avg10=12.50 avg60=3.00 avg300=1.00 total=123456\n")
+                   .has_value());
+  EXPECT_FALSE(
+      SystemMemoryPressureEvaluator::ParseMemoryStallInfo("").has_value());
+}
+
+// Tests that memory stalls raise the pressure level before the available
+// memory reaches the thresholds.
+TEST_F(LinuxSystemMemoryPressureEvaluatorTest, MemoryStallEarlyWarning) {
+  TestSystemMemoryPressureEvaluator evaluator(512, 256, 128);
+  evaluator.SetNone();
+
+  evaluator.SetMemoryStallInfo(
+      SystemMemoryPressureEvaluator::MemoryStallInfo{.some_avg10 = 1,
+                                                     .full_avg10 = 0});
+  EXPECT_EQ(base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE,
+            evaluator.CalculateCurrentPressureLevel());
+
+  evaluator.SetMemoryStallInfo(
+      SystemMemoryPressureEvaluator::MemoryStallInfo{.some_avg10 = 20,
+                                                     .full_avg10 = 1});
+  EXPECT_EQ(base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE,
+            evaluator.CalculateCurrentPressureLevel());
+
+  evaluator.SetMemoryStallInfo(
+      SystemMemoryPressureEvaluator::MemoryStallInfo{.some_avg10 = 40,
+                                                     .full_avg10 = 15});
+  EXPECT_EQ(base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL,
+            evaluator.CalculateCurrentPressureLevel());
+
+  // The headroom is the available memory above the critical threshold.
+  evaluator.SetMemoryFree(200);
+  EXPECT_EQ(72, evaluator.GetAvailableHeadroomMb());
+  evaluator.SetMemoryFree(100);
+  EXPECT_EQ(0, evaluator.GetAvailableHeadroomMb());
+}
+
 }  // namespace os_linux
 }  // namespace memory_pressure
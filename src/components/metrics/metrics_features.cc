@@ -30,4 +30,8 @@ BASE_FEATURE(kMetricsLogTrimming,
              "MetricsLogTrimming",
              base::FEATURE_ENABLED_BY_DEFAULT);
 
+BASE_FEATURE(kMetricsLogFilePersistence,
+             "MetricsLogFilePersistence",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 }  // namespace metrics::features
@@ -41,6 +41,10 @@ BASE_DECLARE_FEATURE(kReportingServiceAlwaysFlush);
 // components/metrics/unsent_log_store.cc.
 BASE_DECLARE_FEATURE(kMetricsLogTrimming);
 
+// Persists the unsent UMA logs in files in the directory given by
+// MetricsServiceClient::GetUnsentLogsDirectory() instead of in Local State.
+BASE_DECLARE_FEATURE(kMetricsLogFilePersistence);
+
 }  // namespace metrics::features
 
 #endif  // COMPONENTS_METRICS_METRICS_FEATURES_H_
@@ -6,6 +6,7 @@
 
 #include <string_view>
 
+#include "base/files/file_path.h"
 #include "components/metrics/metrics_pref_names.h"
 #include "components/metrics/metrics_service_client.h"
 #include "components/metrics/unsent_log_store_metrics_impl.h"
@@ -13,6 +14,15 @@
 
 namespace metrics {
 
+namespace {
+
+// The directories of the logs of |initial_log_queue_| and |ongoing_log_queue_|
+// under the unsent logs directory.
+constexpr char kInitialLogsDirectoryName[] = "Initial";
+constexpr char kOngoingLogsDirectoryName[] = "Ongoing";
+
+}  // namespace
+
 // static
 void MetricsLogStore::RegisterPrefs(PrefRegistrySimple* registry) {
   registry->RegisterListPref(prefs::kMetricsInitialLogs);
@@ -71,6 +81,15 @@ void MetricsLogStore::LoadPersistedUnsentLogs() {
   unsent_logs_loaded_ = true;
 }
 
+void MetricsLogStore::SetUnsentLogsDirectory(const base::FilePath& directory) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(!unsent_logs_loaded_);
+  initial_log_queue_.SetPersistentLogsDirectory(
+      directory.AppendASCII(kInitialLogsDirectoryName));
+  ongoing_log_queue_.SetPersistentLogsDirectory(
+      directory.AppendASCII(kOngoingLogsDirectoryName));
+}
+
 void MetricsLogStore::StoreLog(const std::string& log_data,
                                MetricsLog::LogType log_type,
                                const LogMetadata& log_metadata,
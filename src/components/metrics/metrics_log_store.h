@@ -20,6 +20,10 @@
 class PrefService;
 class PrefRegistrySimple;
 
+namespace base {
+class FilePath;
+}
+
 namespace metrics {
 
 class MetricsServiceClient;
@@ -91,6 +95,10 @@ class MetricsLogStore : public LogStore {
   // Deletes all logs, in memory and on disk.
   void Purge();
 
+  // Persists the initial and ongoing logs in files under |directory| instead
+  // of in Local State. Must be called before |LoadPersistedUnsentLogs()|.
+  void SetUnsentLogsDirectory(const base::FilePath& directory);
+
   // Returns the signing key that should be used to create a signature for a
   // log of the given |log_type|. We don't "simply" return the signing key that
   // was passed during the construction of this object, because although
@@ -12,6 +12,7 @@
 #include "base/functional/callback.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
+#include "components/metrics/metrics_features.h"
 #include "components/metrics/metrics_logs_event_manager.h"
 #include "components/metrics/metrics_pref_names.h"
 #include "components/metrics/metrics_service_client.h"
@@ -39,7 +40,15 @@ MetricsReportingService::MetricsReportingService(
       metrics_log_store_(local_state,
                          client->GetStorageLimits(),
                          client->GetUploadSigningKey(),
-                         logs_event_manager_) {}
+                         logs_event_manager_) {
+  if (base::FeatureList::IsEnabled(features::kMetricsLogFilePersistence)) {
+    const base::FilePath unsent_logs_directory =
+        client->GetUnsentLogsDirectory();
+    if (!unsent_logs_directory.empty()) {
+      metrics_log_store_.SetUnsentLogsDirectory(unsent_logs_directory);
+    }
+  }
+}
 
 MetricsReportingService::~MetricsReportingService() {}
 
@@ -183,6 +183,10 @@ MetricsServiceClient::AddOnClonedInstallDetectedCallback(
   return base::CallbackListSubscription();
 }
 
+base::FilePath MetricsServiceClient::GetUnsentLogsDirectory() const {
+  return base::FilePath();
+}
+
 MetricsLogStore::StorageLimits MetricsServiceClient::GetStorageLimits() const {
   return {
       .initial_log_queue_limits =
@@ -12,6 +12,7 @@
 #include <string_view>
 
 #include "base/callback_list.h"
+#include "base/files/file_path.h"
 #include "base/functional/callback.h"
 #include "base/metrics/field_trial_params.h"
 #include "base/time/time.h"
@@ -193,6 +194,11 @@ class MetricsServiceClient {
   // Specifies local log storage requirements and restrictions.
   virtual MetricsLogStore::StorageLimits GetStorageLimits() const;
 
+  // Returns the directory where the unsent logs are persisted when
+  // features::kMetricsLogFilePersistence is enabled. The logs are persisted in
+  // Local State if empty, which is the default.
+  virtual base::FilePath GetUnsentLogsDirectory() const;
+
   // Sets the callback to run MetricsServiceManager::UpdateRunningServices.
   void SetUpdateRunningServicesCallback(const base::RepeatingClosure& callback);
 
@@ -0,0 +1,225 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/metrics/unsent_log_files.h"
+
+#include <inttypes.h>
+
+#include <algorithm>
+
+#include "base/containers/span.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback.h"
+#include "base/logging.h"
+#include "base/pickle.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/time/time.h"
+
+namespace metrics {
+
+namespace {
+
+// Version of the format of the files. Files with another version are deleted.
+constexpr int kFormatVersion = 1;
+
+constexpr char kLogFileExtension[] = ".log";
+
+// Logs larger than this are not read back, in case of corruption.
+constexpr size_t kMaxLogFileSize = 64 * 1024 * 1024;
+
+std::string SerializeLog(const UnsentLogStore::LogInfo& log) {
+  base::Pickle pickle;
+  pickle.WriteInt(kFormatVersion);
+  pickle.WriteString(log.hash);
+  pickle.WriteString(log.signature);
+  pickle.WriteString(log.timestamp);
+  pickle.WriteString(log.compressed_log_data);
+  pickle.WriteBool(log.log_metadata.log_source_type.has_value());
+  if (log.log_metadata.log_source_type.has_value()) {
+    pickle.WriteInt(static_cast<int>(*log.log_metadata.log_source_type));
+  }
+  pickle.WriteBool(log.log_metadata.user_id.has_value());
+  if (log.log_metadata.user_id.has_value()) {
+    pickle.WriteUInt64(*log.log_metadata.user_id);
+  }
+  return std::string(
+      base::as_string_view(base::make_span(pickle.data(), pickle.size())));
+}
+
+std::unique_ptr<UnsentLogStore::LogInfo> DeserializeLog(
+    const std::string& contents) {
+  base::Pickle pickle =
+      base::Pickle::WithUnownedBuffer(base::as_byte_span(contents));
+  base::PickleIterator iter(pickle);
+  auto log = std::make_unique<UnsentLogStore::LogInfo>();
+  int version = 0;
+  bool has_log_source_type = false;
+  if (!iter.ReadInt(&version) || version != kFormatVersion ||
+      !iter.ReadString(&log->hash) || !iter.ReadString(&log->signature) ||
+      !iter.ReadString(&log->timestamp) ||
+      !iter.ReadString(&log->compressed_log_data) ||
+      !iter.ReadBool(&has_log_source_type)) {
+    return nullptr;
+  }
+  if (has_log_source_type) {
+    int log_source_type = 0;
+    if (!iter.ReadInt(&log_source_type)) {
+      return nullptr;
+    }
+    log->log_metadata.log_source_type =
+        static_cast<UkmLogSourceType>(log_source_type);
+  }
+  bool has_user_id = false;
+  if (!iter.ReadBool(&has_user_id)) {
+    return nullptr;
+  }
+  if (has_user_id) {
+    uint64_t user_id = 0;
+    if (!iter.ReadUInt64(&user_id)) {
+      return nullptr;
+    }
+    log->log_metadata.user_id = user_id;
+  }
+  return log;
+}
+
+// Reads the logs in |directory|, ordered by file name, which is the order in
+// which they were persisted.
+std::pair<UnsentLogFiles::LogInfoList, std::vector<std::string>> ReadLogs(
+    const base::FilePath& directory) {
+  std::vector<base::FilePath> paths;
+  base::FileEnumerator enumerator(directory, /*recursive=*/false,
+                                  base::FileEnumerator::FILES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    paths.push_back(std::move(path));
+  }
+  std::sort(paths.begin(), paths.end());
+
+  std::pair<UnsentLogFiles::LogInfoList, std::vector<std::string>> result;
+  for (const base::FilePath& path : paths) {
+    std::string contents;
+    std::unique_ptr<UnsentLogStore::LogInfo> log;
+    if (path.MatchesExtension(FILE_PATH_LITERAL(".log")) &&
+        base::ReadFileToStringWithMaxSize(path, &contents, kMaxLogFileSize)) {
+      log = DeserializeLog(contents);
+    }
+    if (!log) {
+      DVLOG(1) << "Deleting corrupted unsent log file " << path;
+      base::DeleteFile(path);
+      continue;
+    }
+    result.first.push_back(std::move(log));
+    result.second.push_back(path.BaseName().AsUTF8Unsafe());
+  }
+  return result;
+}
+
+void WriteLogs(const base::FilePath& directory,
+               const std::vector<std::pair<std::string, std::string>>& files) {
+  if (!base::CreateDirectory(directory)) {
+    return;
+  }
+  for (const auto& [file_name, contents] : files) {
+    base::ImportantFileWriter::WriteFileAtomically(
+        directory.AppendASCII(file_name), contents, "UnsentLogs");
+  }
+}
+
+void DeleteLogs(const base::FilePath& directory,
+                const std::vector<std::string>& file_names) {
+  for (const std::string& file_name : file_names) {
+    base::DeleteFile(directory.AppendASCII(file_name));
+  }
+}
+
+}  // namespace
+
+UnsentLogFiles::UnsentLogFiles(const base::FilePath& directory)
+    : directory_(directory),
+      task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+           base::TaskShutdownBehavior::BLOCK_SHUTDOWN})) {}
+
+UnsentLogFiles::~UnsentLogFiles() = default;
+
+void UnsentLogFiles::Load(base::OnceCallback<void(LogInfoList)> callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE, base::BindOnce(&ReadLogs, directory_),
+      base::BindOnce(&UnsentLogFiles::OnLoaded, weak_ptr_factory_.GetWeakPtr(),
+                     std::move(callback)));
+}
+
+void UnsentLogFiles::Persist(
+    const std::vector<const UnsentLogStore::LogInfo*>& logs) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  std::map<std::string, std::string> file_names_by_hash;
+  std::vector<std::pair<std::string, std::string>> files_to_write;
+  // The file names start with the time at which the logs are first persisted,
+  // then their position, so that sorting them gives the order of the logs.
+  const int64_t now =
+      base::Time::Now().ToDeltaSinceWindowsEpoch().InMicroseconds();
+  for (size_t i = 0; i < logs.size(); ++i) {
+    const UnsentLogStore::LogInfo& log = *logs[i];
+    auto it = file_names_by_hash_.find(log.hash);
+    if (it != file_names_by_hash_.end()) {
+      file_names_by_hash.insert(*it);
+      file_names_by_hash_.erase(it);
+      continue;
+    }
+    std::string file_name =
+        base::StringPrintf("%016" PRIx64 "-%04zx-", now, i) +
+        base::HexEncode(log.hash) + kLogFileExtension;
+    files_to_write.emplace_back(file_name, SerializeLog(log));
+    file_names_by_hash.emplace(log.hash, std::move(file_name));
+  }
+
+  // The remaining files are those of the logs that were sent or trimmed.
+  std::vector<std::string> files_to_delete;
+  for (auto& [hash, file_name] : file_names_by_hash_) {
+    files_to_delete.push_back(std::move(file_name));
+  }
+  file_names_by_hash_ = std::move(file_names_by_hash);
+
+  if (!files_to_delete.empty()) {
+    task_runner_->PostTask(FROM_HERE,
+                           base::BindOnce(&DeleteLogs, directory_,
+                                          std::move(files_to_delete)));
+  }
+  if (!files_to_write.empty()) {
+    task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&WriteLogs, directory_, std::move(files_to_write)));
+  }
+}
+
+void UnsentLogFiles::DeleteAll() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  file_names_by_hash_.clear();
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(base::IgnoreResult(&base::DeletePathRecursively),
+                     directory_));
+}
+
+void UnsentLogFiles::OnLoaded(
+    base::OnceCallback<void(LogInfoList)> callback,
+    std::pair<LogInfoList, std::vector<std::string>> result) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto& [logs, file_names] = result;
+  for (size_t i = 0; i < logs.size(); ++i) {
+    file_names_by_hash_.emplace(logs[i]->hash, std::move(file_names[i]));
+  }
+  std::move(callback).Run(std::move(logs));
+}
+
+}  // namespace metrics
@@ -0,0 +1,80 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_METRICS_UNSENT_LOG_FILES_H_
+#define COMPONENTS_METRICS_UNSENT_LOG_FILES_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/functional/callback_forward.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "components/metrics/unsent_log_store.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace metrics {
+
+// Persists the logs of an UnsentLogStore in a directory, one file per log,
+// instead of in a list pref. This keeps the logs out of Local State, which is
+// otherwise rewritten with all the unsent logs encoded in base64 at every log
+// rotation.
+//
+// The files are written once and only deleted afterwards, so persisting the
+// logs only writes the logs created since the last time. The file I/O happens
+// on a background sequence. The log data is already compressed by
+// UnsentLogStore::LogInfo, so it is stored as is.
+class UnsentLogFiles {
+ public:
+  using LogInfoList = std::vector<std::unique_ptr<UnsentLogStore::LogInfo>>;
+
+  explicit UnsentLogFiles(const base::FilePath& directory);
+
+  UnsentLogFiles(const UnsentLogFiles&) = delete;
+  UnsentLogFiles& operator=(const UnsentLogFiles&) = delete;
+
+  ~UnsentLogFiles();
+
+  // Reads the logs persisted in the directory, from the oldest to the newest,
+  // and runs |callback| with them. Corrupted files are deleted.
+  void Load(base::OnceCallback<void(LogInfoList)> callback);
+
+  // Makes |logs|, ordered from the oldest to the newest, the persisted logs:
+  // writes the files of the logs that were not persisted yet and deletes the
+  // files of the persisted logs that are not in |logs| anymore.
+  void Persist(const std::vector<const UnsentLogStore::LogInfo*>& logs);
+
+  // Deletes all the persisted logs.
+  void DeleteAll();
+
+ private:
+  // Called with the logs read by Load(), and the names of their files.
+  void OnLoaded(base::OnceCallback<void(LogInfoList)> callback,
+                std::pair<LogInfoList, std::vector<std::string>> result);
+
+  const base::FilePath directory_;
+
+  // The sequence where the files are read and written.
+  const scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  // The names of the files of the persisted logs, by log hash.
+  std::map<std::string, std::string> file_names_by_hash_
+      GUARDED_BY_CONTEXT(sequence_checker_);
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<UnsentLogFiles> weak_ptr_factory_{this};
+};
+
+}  // namespace metrics
+
+#endif  // COMPONENTS_METRICS_UNSENT_LOG_FILES_H_
@@ -0,0 +1,141 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/metrics/unsent_log_files.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/task_environment.h"
+#include "base/test/test_future.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace metrics {
+
+namespace {
+
+const char kTestSigningKey[] = "signing key";
+
+std::unique_ptr<UnsentLogStore::LogInfo> CreateLog(const std::string& data) {
+  auto log = std::make_unique<UnsentLogStore::LogInfo>();
+  log->Init(data, kTestSigningKey, LogMetadata());
+  return log;
+}
+
+class UnsentLogFilesTest : public testing::Test {
+ public:
+  void SetUp() override { ASSERT_TRUE(temp_dir_.CreateUniqueTempDir()); }
+
+  base::FilePath GetDirectory() const {
+    return temp_dir_.GetPath().AppendASCII("Logs");
+  }
+
+  UnsentLogFiles::LogInfoList Load(UnsentLogFiles& files) {
+    base::test::TestFuture<UnsentLogFiles::LogInfoList> future;
+    files.Load(future.GetCallback());
+    return future.Take();
+  }
+
+  size_t CountFiles() const {
+    size_t count = 0;
+    base::FileEnumerator enumerator(GetDirectory(), /*recursive=*/false,
+                                    base::FileEnumerator::FILES);
+    while (!enumerator.Next().empty()) {
+      ++count;
+    }
+    return count;
+  }
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  base::ScopedTempDir temp_dir_;
+};
+
+}  // namespace
+
+TEST_F(UnsentLogFilesTest, PersistsAndLoadsLogsInOrder) {
+  std::unique_ptr<UnsentLogStore::LogInfo> log1 = CreateLog("log 1");
+  std::unique_ptr<UnsentLogStore::LogInfo> log2 = CreateLog("log 2");
+  LogMetadata metadata;
+  metadata.user_id = 12345;
+  auto log3 = std::make_unique<UnsentLogStore::LogInfo>();
+  log3->Init("log 3", kTestSigningKey, metadata);
+
+  {
+    UnsentLogFiles files(GetDirectory());
+    files.Persist({log1.get(), log2.get()});
+    // Only the new log is written.
+    files.Persist({log1.get(), log2.get(), log3.get()});
+    task_environment_.RunUntilIdle();
+  }
+  EXPECT_EQ(3u, CountFiles());
+
+  UnsentLogFiles files(GetDirectory());
+  UnsentLogFiles::LogInfoList logs = Load(files);
+  ASSERT_EQ(3u, logs.size());
+  EXPECT_EQ(log1->hash, logs[0]->hash);
+  EXPECT_EQ(log2->hash, logs[1]->hash);
+  EXPECT_EQ(log3->hash, logs[2]->hash);
+  EXPECT_EQ(log3->compressed_log_data, logs[2]->compressed_log_data);
+  EXPECT_EQ(log3->signature, logs[2]->signature);
+  EXPECT_EQ(log3->timestamp, logs[2]->timestamp);
+  EXPECT_EQ(12345u, logs[2]->log_metadata.user_id);
+  EXPECT_FALSE(logs[0]->log_metadata.user_id.has_value());
+}
+
+TEST_F(UnsentLogFilesTest, DeletesFilesOfRemovedLogs) {
+  std::unique_ptr<UnsentLogStore::LogInfo> log1 = CreateLog("log 1");
+  std::unique_ptr<UnsentLogStore::LogInfo> log2 = CreateLog("log 2");
+
+  {
+    UnsentLogFiles files(GetDirectory());
+    files.Persist({log1.get(), log2.get()});
+    task_environment_.RunUntilIdle();
+  }
+
+  // The files of the loaded logs are known, so that they can be deleted.
+  UnsentLogFiles files(GetDirectory());
+  EXPECT_EQ(2u, Load(files).size());
+  files.Persist({log2.get()});
+  task_environment_.RunUntilIdle();
+
+  UnsentLogFiles::LogInfoList logs = Load(files);
+  ASSERT_EQ(1u, logs.size());
+  EXPECT_EQ(log2->hash, logs[0]->hash);
+}
+
+TEST_F(UnsentLogFilesTest, DeletesCorruptedFiles) {
+  std::unique_ptr<UnsentLogStore::LogInfo> log = CreateLog("log");
+  {
+    UnsentLogFiles files(GetDirectory());
+    files.Persist({log.get()});
+    task_environment_.RunUntilIdle();
+  }
+  ASSERT_TRUE(
+      base::WriteFile(GetDirectory().AppendASCII("corrupted.log"), "garbage"));
+  ASSERT_EQ(2u, CountFiles());
+
+  UnsentLogFiles files(GetDirectory());
+  UnsentLogFiles::LogInfoList logs = Load(files);
+  ASSERT_EQ(1u, logs.size());
+  EXPECT_EQ(log->hash, logs[0]->hash);
+  EXPECT_EQ(1u, CountFiles());
+}
+
+TEST_F(UnsentLogFilesTest, DeleteAll) {
+  std::unique_ptr<UnsentLogStore::LogInfo> log = CreateLog("log");
+  UnsentLogFiles files(GetDirectory());
+  files.Persist({log.get()});
+  files.DeleteAll();
+  task_environment_.RunUntilIdle();
+
+  EXPECT_FALSE(base::PathExists(GetDirectory()));
+  EXPECT_TRUE(Load(files).empty());
+}
+
+}  // namespace metrics
@@ -5,6 +5,7 @@
 #include "components/metrics/unsent_log_store.h"
 
 #include <cmath>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -17,6 +18,7 @@
 #include "base/strings/string_util.h"
 #include "base/timer/elapsed_timer.h"
 #include "components/metrics/metrics_features.h"
+#include "components/metrics/unsent_log_files.h"
 #include "components/metrics/unsent_log_store_metrics.h"
 #include "components/prefs/pref_service.h"
 #include "components/prefs/scoped_user_pref_update.h"
@@ -53,11 +55,12 @@ class LogsPrefWriter {
  public:
   // Create a writer that will write unsent logs to |list_value|. |list_value|
   // should be a base::Value::List representing a pref. Clears the contents of
-  // |list_value|.
+  // |list_value|. If |list_value| is null, the writer only counts the logs.
   explicit LogsPrefWriter(base::Value::List* list_value)
       : list_value_(list_value) {
-    DCHECK(list_value);
-    list_value->clear();
+    if (list_value) {
+      list_value->clear();
+    }
   }
 
   LogsPrefWriter(const LogsPrefWriter&) = delete;
@@ -69,22 +72,9 @@ class LogsPrefWriter {
   void WriteLogEntry(UnsentLogStore::LogInfo* log) {
     DCHECK(!finished_);
 
-    base::Value::Dict dict_value;
-    dict_value.Set(kLogHashKey, EncodeToBase64(log->hash));
-    dict_value.Set(kLogSignatureKey, EncodeToBase64(log->signature));
-    dict_value.Set(kLogDataKey, EncodeToBase64(log->compressed_log_data));
-    dict_value.Set(kLogTimestampKey, log->timestamp);
-    if (log->log_metadata.log_source_type.has_value()) {
-      dict_value.Set(
-          kLogSourceType,
-          static_cast<int>(log->log_metadata.log_source_type.value()));
+    if (list_value_) {
+      AppendLogEntry(log);
     }
-    auto user_id = log->log_metadata.user_id;
-    if (user_id.has_value()) {
-      dict_value.Set(kLogUserIdKey,
-                     EncodeToBase64(base::NumberToString(user_id.value())));
-    }
-    list_value_->Append(std::move(dict_value));
 
     auto samples_count = log->log_metadata.samples_count;
     if (samples_count.has_value()) {
@@ -100,7 +90,9 @@ class LogsPrefWriter {
   void Finish() {
     DCHECK(!finished_);
     finished_ = true;
-    std::reverse(list_value_->begin(), list_value_->end());
+    if (list_value_) {
+      std::reverse(list_value_->begin(), list_value_->end());
+    }
   }
 
   base::HistogramBase::Count unsent_samples_count() const {
@@ -112,7 +104,27 @@ class LogsPrefWriter {
   size_t unsent_logs_count() const { return unsent_logs_count_; }
 
  private:
+  void AppendLogEntry(UnsentLogStore::LogInfo* log) {
+    base::Value::Dict dict_value;
+    dict_value.Set(kLogHashKey, EncodeToBase64(log->hash));
+    dict_value.Set(kLogSignatureKey, EncodeToBase64(log->signature));
+    dict_value.Set(kLogDataKey, EncodeToBase64(log->compressed_log_data));
+    dict_value.Set(kLogTimestampKey, log->timestamp);
+    if (log->log_metadata.log_source_type.has_value()) {
+      dict_value.Set(
+          kLogSourceType,
+          static_cast<int>(log->log_metadata.log_source_type.value()));
+    }
+    auto user_id = log->log_metadata.user_id;
+    if (user_id.has_value()) {
+      dict_value.Set(kLogUserIdKey,
+                     EncodeToBase64(base::NumberToString(user_id.value())));
+    }
+    list_value_->Append(std::move(dict_value));
+  }
+
   // The list where the logs will be written to. This should represent a pref.
+  // Null if the logs are persisted elsewhere.
   raw_ptr<base::Value::List> list_value_;
 
   // Whether or not this writer has finished writing to pref.
@@ -281,8 +293,13 @@ void UnsentLogStore::MarkStagedLogAsSent() {
 }
 
 void UnsentLogStore::TrimAndPersistUnsentLogs(bool overwrite_in_memory_store) {
-  ScopedListPrefUpdate update(local_state_, log_data_pref_name_);
-  LogsPrefWriter writer(&update.Get());
+  // When the logs are persisted in files, the writer only selects them.
+  std::optional<ScopedListPrefUpdate> update;
+  if (!log_files_) {
+    update.emplace(local_state_, log_data_pref_name_);
+  }
+  LogsPrefWriter writer(update ? &update->Get() : nullptr);
+  std::vector<const LogInfo*> persisted_logs;
 
   std::vector<std::unique_ptr<LogInfo>> trimmed_list;
   size_t bytes_used = 0;
@@ -333,6 +350,7 @@ void UnsentLogStore::TrimAndPersistUnsentLogs(bool overwrite_in_memory_store) {
 
     // Append log to prefs.
     writer.WriteLogEntry(list_[i].get());
+    persisted_logs.push_back(list_[i].get());
     if (overwrite_in_memory_store) {
       trimmed_list.emplace_back(std::move(list_[i]));
     }
@@ -340,6 +358,13 @@ void UnsentLogStore::TrimAndPersistUnsentLogs(bool overwrite_in_memory_store) {
 
   writer.Finish();
 
+  if (log_files_) {
+    std::reverse(persisted_logs.begin(), persisted_logs.end());
+    log_files_->Persist(persisted_logs);
+    // Logs loaded from the pref by previous versions are now in files.
+    local_state_->ClearPref(log_data_pref_name_);
+  }
+
   if (overwrite_in_memory_store) {
     // We went in reverse order, but appended entries. So reverse list to
     // correct.
@@ -372,6 +397,10 @@ void UnsentLogStore::TrimAndPersistUnsentLogs(bool overwrite_in_memory_store) {
 void UnsentLogStore::LoadPersistedUnsentLogs() {
   ReadLogsFromPrefList(local_state_->GetList(log_data_pref_name_));
   RecordMetaDataMetrics();
+  if (log_files_) {
+    log_files_->Load(base::BindOnce(&UnsentLogStore::OnLogFilesLoaded,
+                                    weak_ptr_factory_.GetWeakPtr()));
+  }
 }
 
 void UnsentLogStore::StoreLog(const std::string& log_data,
@@ -389,6 +418,7 @@ void UnsentLogStore::StoreLogInfo(
   DCHECK(log_info);
   metrics_->RecordCompressionRatio(log_info->compressed_log_data.size(),
                                    uncompressed_log_size);
+  metrics_->RecordStoredLogSize(log_info->compressed_log_data.size());
   NotifyLogCreated(*log_info, reason);
   list_.emplace_back(std::move(log_info));
 }
@@ -437,12 +467,21 @@ void UnsentLogStore::Purge() {
   }
   list_.clear();
   local_state_->ClearPref(log_data_pref_name_);
+  if (log_files_) {
+    log_files_->DeleteAll();
+  }
   // The |total_samples_sent_| isn't cleared intentionally because it is still
   // meaningful.
   if (metadata_pref_name_)
     local_state_->ClearPref(metadata_pref_name_);
 }
 
+void UnsentLogStore::SetPersistentLogsDirectory(
+    const base::FilePath& directory) {
+  DCHECK(list_.empty());
+  log_files_ = std::make_unique<UnsentLogFiles>(directory);
+}
+
 void UnsentLogStore::SetLogsEventManager(
     MetricsLogsEventManager* logs_event_manager) {
   logs_event_manager_ = logs_event_manager;
@@ -510,6 +549,21 @@ void UnsentLogStore::ReadLogsFromPrefList(const base::Value::List& list_value) {
   metrics_->RecordLogReadStatus(UnsentLogStoreMetrics::RECALL_SUCCESS);
 }
 
+void UnsentLogStore::OnLogFilesLoaded(
+    std::vector<std::unique_ptr<LogInfo>> logs) {
+  if (logs.empty()) {
+    return;
+  }
+  NotifyLogsCreated(
+      logs, MetricsLogsEventManager::CreateReason::kLoadFromPreviousSession);
+  // The loaded logs are older than the ones stored since the load started.
+  if (has_staged_log()) {
+    staged_log_index_ += static_cast<int>(logs.size());
+  }
+  list_.insert(list_.begin(), std::make_move_iterator(logs.begin()),
+               std::make_move_iterator(logs.end()));
+}
+
 void UnsentLogStore::WriteToMetricsPref(
     base::HistogramBase::Count unsent_samples_count,
     base::HistogramBase::Count sent_samples_count,
@@ -16,6 +16,7 @@
 #include "base/gtest_prod_util.h"
 #include "base/logging.h"
 #include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
 #include "base/metrics/histogram_base.h"
 #include "base/values.h"
 #include "components/metrics/log_store.h"
@@ -24,8 +25,13 @@
 
 class PrefService;
 
+namespace base {
+class FilePath;
+}
+
 namespace metrics {
 
+class UnsentLogFiles;
 class UnsentLogStoreMetrics;
 
 // Maintains a list of unsent logs that are written and restored from disk.
@@ -181,6 +187,13 @@ class UnsentLogStore : public LogStore {
   // Deletes all logs, in memory and on disk.
   void Purge();
 
+  // Persists the logs as files in |directory| instead of in the
+  // |log_data_pref_name| preference. Must be called before
+  // LoadPersistedUnsentLogs(), which then loads the logs of the files
+  // asynchronously, in addition to the logs left in the preference by previous
+  // versions. These are moved to the files the next time logs are persisted.
+  void SetPersistentLogsDirectory(const base::FilePath& directory);
+
   // Sets |logs_event_manager_|.
   void SetLogsEventManager(MetricsLogsEventManager* logs_event_manager);
 
@@ -211,6 +224,9 @@ class UnsentLogStore : public LogStore {
   // Reads the list of logs from |list|.
   void ReadLogsFromPrefList(const base::Value::List& list);
 
+  // Adds the logs loaded by |log_files_| before the logs stored since.
+  void OnLogFilesLoaded(std::vector<std::unique_ptr<LogInfo>> logs);
+
   // Writes the unsent log info to the |metadata_pref_name_| preference.
   void WriteToMetricsPref(base::HistogramBase::Count unsent_samples_count,
                           base::HistogramBase::Count sent_samples_count,
@@ -265,6 +281,11 @@ class UnsentLogStore : public LogStore {
 
   // The total number of samples that have been sent from this LogStore.
   base::HistogramBase::Count total_samples_sent_ = 0;
+
+  // Where the logs are persisted if not in |log_data_pref_name_|.
+  std::unique_ptr<UnsentLogFiles> log_files_;
+
+  base::WeakPtrFactory<UnsentLogStore> weak_ptr_factory_{this};
 };
 
 }  // namespace metrics
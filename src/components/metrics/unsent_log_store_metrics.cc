@@ -21,6 +21,8 @@ void UnsentLogStoreMetrics::RecordCompressionRatio(size_t compressed_size,
 
 void UnsentLogStoreMetrics::RecordDroppedLogSize(size_t size) {}
 
+void UnsentLogStoreMetrics::RecordStoredLogSize(size_t compressed_size) {}
+
 void UnsentLogStoreMetrics::RecordDroppedLogsNum(int dropped_logs_num) {}
 
 void UnsentLogStoreMetrics::RecordLastUnsentLogMetadataMetrics(
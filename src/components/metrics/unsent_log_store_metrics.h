@@ -49,6 +49,10 @@ class UnsentLogStoreMetrics {
 
   virtual void RecordDroppedLogSize(size_t size);
 
+  // Records the compressed size of a log added to the store, which is the
+  // number of bytes it will take to upload.
+  virtual void RecordStoredLogSize(size_t compressed_size);
+
   virtual void RecordDroppedLogsNum(int dropped_logs_num);
 
   virtual void RecordLastUnsentLogMetadataMetrics(int unsent_samples_count,
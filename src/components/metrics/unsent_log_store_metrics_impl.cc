@@ -20,6 +20,11 @@ void UnsentLogStoreMetricsImpl::RecordDroppedLogSize(size_t size) {
                              static_cast<int>(size));
 }
 
+void UnsentLogStoreMetricsImpl::RecordStoredLogSize(size_t compressed_size) {
+  base::UmaHistogramCounts1M("UMA.UnsentLogs.StoredLogSize",
+                             static_cast<int>(compressed_size));
+}
+
 void UnsentLogStoreMetricsImpl::RecordDroppedLogsNum(int dropped_logs_num) {
   base::UmaHistogramCounts1M("UMA.UnsentLogs.Dropped", dropped_logs_num);
 }
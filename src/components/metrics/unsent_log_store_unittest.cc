@@ -10,6 +10,7 @@
 #include "base/base64.h"
 #include "base/hash/sha1.h"
 #include "base/rand_util.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/values.h"
 #include "components/metrics/unsent_log_store_metrics_impl.h"
 #include "components/prefs/pref_registry_simple.h"
@@ -176,6 +177,19 @@ TEST_F(UnsentLogStoreTest, SingleElementLogList) {
             result_unsent_log_store.staged_log_timestamp());
 }
 
+// The compressed size of each stored log is recorded.
+TEST_F(UnsentLogStoreTest, StoredLogSizeMetric) {
+  base::HistogramTester histogram_tester;
+  TestUnsentLogStore unsent_log_store(&prefs_, kLogByteLimit);
+
+  LogMetadata log_metadata;
+  unsent_log_store.StoreLog("Hello world!", log_metadata,
+                            MetricsLogsEventManager::CreateReason::kUnknown);
+  histogram_tester.ExpectUniqueSample(
+      "UMA.UnsentLogs.StoredLogSize",
+      static_cast<int>(Compress("Hello world!").size()), 1);
+}
+
 // Store a set of logs over the length limit, but smaller than the min number of
 // bytes. This should leave the logs unchanged.
 TEST_F(UnsentLogStoreTest, LongButTinyLogList) {
@@ -27,6 +27,13 @@ BASE_FEATURE(kCastDisableModelNameCheck,
 //
 // This feature is enabled by the Chrome command line flag
 // --enable-cast-streaming-with-hidpi.
+// Drops captured video frames that are already older than the target playout
+// delay instead of encoding and sending frames the receiver can't play out in
+// time.
+BASE_FEATURE(kCastDropLateVideoFrames,
+             "CastDropLateVideoFrames",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 BASE_FEATURE(kCastEnableStreamingWithHiDPI,
              "CastEnableStreamingWithHiDPI",
              base::FEATURE_DISABLED_BY_DEFAULT);
@@ -21,6 +21,9 @@ BASE_DECLARE_FEATURE(kCastDisableLetterboxing);
 COMPONENT_EXPORT(MIRRORING_SERVICE)
 BASE_DECLARE_FEATURE(kCastDisableModelNameCheck);
 
+COMPONENT_EXPORT(MIRRORING_SERVICE)
+BASE_DECLARE_FEATURE(kCastDropLateVideoFrames);
+
 // TODO(crbug.com/40255351): Should be removed once working properly.
 COMPONENT_EXPORT(MIRRORING_SERVICE)
 BASE_DECLARE_FEATURE(kCastEnableStreamingWithHiDPI);
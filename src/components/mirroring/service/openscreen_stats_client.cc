@@ -6,8 +6,14 @@
 
 #include <stdint.h>
 
+#include <cmath>
+#include <initializer_list>
+#include <optional>
+
 #include "base/format_macros.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/strings/stringprintf.h"
+#include "base/time/time.h"
 #include "media/cast/logging/stats_event_subscriber.h"
 
 namespace mirroring {
@@ -90,6 +96,23 @@ media::cast::StatsEventSubscriber::CastStat HistogramTypeToCastStat(
           UNKNOWN_OPEN_SCREEN_HISTO;
   }
 }
+
+// Returns the sum of the latencies of |types| in |stats_list|, or null if any
+// of them is not available.
+std::optional<base::TimeDelta> SumLatencies(
+    const openscreen::cast::SenderStats::StatisticsList& stats_list,
+    std::initializer_list<openscreen::cast::StatisticType> types) {
+  double sum_ms = 0;
+  for (openscreen::cast::StatisticType type : types) {
+    const double value_ms = stats_list[static_cast<std::size_t>(type)];
+    if (!std::isfinite(value_ms) || value_ms < 0) {
+      return std::nullopt;
+    }
+    sum_ms += value_ms;
+  }
+  return base::Milliseconds(sum_ms);
+}
+
 }  // namespace
 
 OpenscreenStatsClient::OpenscreenStatsClient() = default;
@@ -187,6 +210,23 @@ base::Value::List OpenscreenStatsClient::ConvertOpenscreenHistogramToList(
 
 void OpenscreenStatsClient::OnStatisticsUpdated(
     const openscreen::cast::SenderStats& updated_stats) {
+  using openscreen::cast::StatisticType;
+  // The time from capture to the frame being sent, and the part of it spent
+  // waiting to be sent, which grows when the network is congested.
+  if (std::optional<base::TimeDelta> latency = SumLatencies(
+          updated_stats.video_statistics,
+          {StatisticType::kAvgCaptureLatencyMs, StatisticType::kAvgEncodeTimeMs,
+           StatisticType::kAvgQueueingLatencyMs})) {
+    base::UmaHistogramTimes(
+        "CastStreaming.Sender.Video.AvgCaptureToSendLatency", *latency);
+  }
+  if (std::optional<base::TimeDelta> latency =
+          SumLatencies(updated_stats.video_statistics,
+                       {StatisticType::kAvgQueueingLatencyMs})) {
+    base::UmaHistogramTimes("CastStreaming.Sender.Video.AvgQueueingLatency",
+                            *latency);
+  }
+
   most_recent_stats_ = ConvertSenderStatsToDict(std::move(updated_stats));
 }
 
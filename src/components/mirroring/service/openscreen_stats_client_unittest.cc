@@ -5,6 +5,8 @@
 #include "components/mirroring/service/openscreen_stats_client.h"
 
 #include "base/logging.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/time/time.h"
 #include "media/cast/logging/stats_event_subscriber.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -171,4 +173,24 @@ TEST_F(OpenscreenStatsClientTest, OnStatisticsUpdatedEmptyValues) {
   EXPECT_FALSE(video_dict->FindList("NETWORK_LATENCY_MS_HISTO")->size());
 }
 
+TEST_F(OpenscreenStatsClientTest, OnStatisticsUpdatedRecordsLatency) {
+  using openscreen::cast::StatisticType;
+  base::HistogramTester histogram_tester;
+  openscreen_stats_client_->OnStatisticsUpdated(test_sender_stats_);
+
+  // The test statistics are their own index.
+  const auto index = [](StatisticType type) {
+    return static_cast<int>(type);
+  };
+  histogram_tester.ExpectUniqueTimeSample(
+      "CastStreaming.Sender.Video.AvgCaptureToSendLatency",
+      base::Milliseconds(index(StatisticType::kAvgCaptureLatencyMs) +
+                         index(StatisticType::kAvgEncodeTimeMs) +
+                         index(StatisticType::kAvgQueueingLatencyMs)),
+      1);
+  histogram_tester.ExpectUniqueTimeSample(
+      "CastStreaming.Sender.Video.AvgQueueingLatency",
+      base::Milliseconds(index(StatisticType::kAvgQueueingLatencyMs)), 1);
+}
+
 }  // namespace mirroring
@@ -4,10 +4,13 @@
 
 #include "components/mirroring/service/rtp_stream.h"
 
+#include "base/feature_list.h"
 #include "base/functional/bind.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/trace_event/trace_event.h"
 #include "base/values.h"
+#include "components/mirroring/service/mirroring_features.h"
 #include "media/base/video_frame.h"
 #include "media/cast/cast_config.h"
 #include "media/cast/sender/audio_sender.h"
@@ -73,6 +76,24 @@ void VideoRtpStream::InsertVideoFrame(
     return;
   }
 
+  const base::TimeDelta capture_latency =
+      base::TimeTicks::Now() - reference_time;
+  // A frame older than the target playout delay can't be played out in time,
+  // so don't spend encoder time and bandwidth on it. The capturer keeps
+  // delivering newer frames.
+  if (base::FeatureList::IsEnabled(features::kCastDropLateVideoFrames)) {
+    const base::TimeDelta playout_delay = GetTargetPlayoutDelay();
+    const bool is_late =
+        playout_delay.is_positive() && capture_latency > playout_delay;
+    base::UmaHistogramBoolean("CastStreaming.Sender.Video.LateFrameDropped",
+                              is_late);
+    if (is_late) {
+      return;
+    }
+  }
+  base::UmaHistogramTimes("CastStreaming.Sender.Video.CaptureToEncodeLatency",
+                          capture_latency);
+
   // Used by chrome/browser/media/cast_mirroring_performance_browsertest.cc
   TRACE_EVENT_INSTANT2("cast_perf_test", "ConsumeVideoFrame",
                        TRACE_EVENT_SCOPE_THREAD, "timestamp",
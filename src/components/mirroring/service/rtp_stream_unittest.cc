@@ -8,6 +8,7 @@
 #include "base/logging.h"
 #include "base/memory/raw_ptr.h"
 #include "base/run_loop.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/mock_callback.h"
 #include "base/test/simple_test_tick_clock.h"
 #include "base/test/task_environment.h"
@@ -144,6 +145,7 @@ class RtpStreamTest : public ::testing::Test {
 
 // Test the video streaming pipeline.
 TEST_F(RtpStreamTest, VideoStreaming) {
+  base::HistogramTester histogram_tester;
   auto video_sender = std::make_unique<MockVideoSender>();
   EXPECT_CALL(*video_sender, InsertRawVideoFrame(_, _)).Times(1);
   VideoRtpStream video_stream(std::move(video_sender), client_.GetWeakPtr(),
@@ -152,6 +154,8 @@ TEST_F(RtpStreamTest, VideoStreaming) {
   video_stream.InsertVideoFrame(client_.CreateVideoFrame());
   ExpectTimerRunning(video_stream);
   client_.SetVideoRtpStream(nullptr);
+  histogram_tester.ExpectTotalCount(
+      "CastStreaming.Sender.Video.CaptureToEncodeLatency", 1);
 }
 
 TEST_F(RtpStreamTest, VideoStreamEmitsFramesWhenNoUpdates) {
@@ -15,6 +15,7 @@
 #include "base/functional/bind.h"
 #include "base/functional/callback.h"
 #include "base/functional/callback_helpers.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/observer_list.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/sequenced_task_runner.h"
@@ -176,6 +177,31 @@ void NetExportFileWriter::StartNetLogAfterCreateFile(
   if (!net_log_exporter_)
     return;
 
+  // Stream the log through a pipe to compress or buffer it on the way to the
+  // file. The copy runs on its own sequence since it blocks until the log is
+  // complete, and must not block shutdown.
+  NetExportStreamWriter::Options stream_options = stream_options_;
+  base::File read_end;
+  base::File write_end;
+  if (stream_options.IsStreaming() &&
+      NetExportStreamWriter::CreatePipe(&read_end, &write_end)) {
+    if (!stream_options.max_event_bytes && max_file_size != kNoLimit) {
+      stream_options.max_event_bytes = max_file_size;
+    }
+    max_file_size = kNoLimit;
+    stream_copy_in_progress_ = true;
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE,
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+        base::BindOnce(&NetExportStreamWriter::CopyFromPipe,
+                       std::move(read_end), std::move(output_file),
+                       stream_options),
+        base::BindOnce(&NetExportFileWriter::OnStreamCopyDone,
+                       weak_ptr_factory_.GetWeakPtr()));
+    output_file = std::move(write_end);
+  }
+
   // base::Unretained(this) is safe here since |net_log_exporter_| is owned by
   // |this| and is a mojo InterfacePtr, which guarantees callback cancellation
   // upon its destruction.
@@ -226,6 +252,23 @@ void NetExportFileWriter::OnConnectionError() {
   ResetExporterThenSetStateNotLogging();
 }
 
+void NetExportFileWriter::SetStreamOptions(
+    const NetExportStreamWriter::Options& options) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  stream_options_ = options;
+}
+
+void NetExportFileWriter::OnStreamCopyDone(bool success) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  base::UmaHistogramBoolean("Net.NetExport.StreamWriteSuccess", success);
+  stream_copy_in_progress_ = false;
+  if (waiting_for_stream_copy_) {
+    waiting_for_stream_copy_ = false;
+    state_ = STATE_NOT_LOGGING;
+    NotifyStateObservers();
+  }
+}
+
 base::Value::Dict NetExportFileWriter::GetState() const {
   DCHECK(thread_checker_.CalledOnValidThread());
 
@@ -342,6 +385,12 @@ void NetExportFileWriter::SetStateAfterSetUpDefaultLogPath(
 void NetExportFileWriter::ResetExporterThenSetStateNotLogging() {
   DCHECK(thread_checker_.CalledOnValidThread());
   net_log_exporter_.reset();
+  // The exporter closes its end of the pipe when it's done, but the log is
+  // only complete once the copy drained the pipe.
+  if (stream_copy_in_progress_) {
+    waiting_for_stream_copy_ = true;
+    return;
+  }
   state_ = STATE_NOT_LOGGING;
 
   NotifyStateObservers();
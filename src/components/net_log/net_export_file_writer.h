@@ -18,6 +18,7 @@
 #include "base/observer_list.h"
 #include "base/threading/thread_checker.h"
 #include "base/values.h"
+#include "components/net_log/net_export_stream_writer.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "net/log/net_log_capture_mode.h"
 #include "services/network/public/mojom/network_service.mojom.h"
@@ -118,6 +119,13 @@ class NetExportFileWriter {
                    const std::string& channel_string,
                    network::mojom::NetworkContext* network_context);
 
+  // Sets how the logs started by the following StartNetLog() calls are written.
+  // If |options| compress the log or bound its events, and the platform
+  // supports it, the network service writes the log through a pipe, and it is
+  // compressed or buffered before reaching the file. In that case, a bounded
+  // |max_file_size| is the size of the kept events unless |options| set it.
+  void SetStreamOptions(const NetExportStreamWriter::Options& options);
+
   // Stops collecting NetLog data into the file. It is a no-op if
   // NetExportFileWriter is currently not logging.
   //
@@ -191,6 +199,9 @@ class NetExportFileWriter {
 
   void OnConnectionError();
 
+  // Called when the log streamed through a pipe is completely written.
+  void OnStreamCopyDone(bool success);
+
   // Contains tasks to be done after |net_log_exporter_| has completely
   // stopped writing.
   void ResetExporterThenSetStateNotLogging();
@@ -215,6 +226,13 @@ class NetExportFileWriter {
 
   base::FilePath log_path_;  // base::FilePath to the NetLog file.
 
+  NetExportStreamWriter::Options stream_options_;
+  // Whether the log is streamed through a pipe that isn't drained yet.
+  bool stream_copy_in_progress_ = false;
+  // Whether the exporter stopped, and the state changes to STATE_NOT_LOGGING
+  // once the pipe is drained.
+  bool waiting_for_stream_copy_ = false;
+
   // Used to ask the network service to do the actual exporting.
   mojo::Remote<network::mojom::NetLogExporter> net_log_exporter_;
 
@@ -0,0 +1,227 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/net_log/net_export_stream_writer.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "base/check_op.h"
+#include "base/containers/span.h"
+#include "base/logging.h"
+#include "base/strings/string_util.h"
+#include "base/threading/scoped_blocking_call.h"
+#include "build/build_config.h"
+#include "third_party/zlib/zlib.h"
+
+#if BUILDFLAG(IS_POSIX)
+#include "base/files/file_util.h"
+#include "base/files/scoped_file.h"
+#endif
+
+namespace net_log {
+
+namespace {
+
+// The size of the buffers used to read from the pipe and to compress.
+constexpr size_t kBufferSize = 64 * 1024;
+
+}  // namespace
+
+// Compresses a stream with gzip, see
+// https://www.zlib.net/manual.html#Advanced.
+class NetExportStreamWriter::GzipCompressor {
+ public:
+  GzipCompressor() {
+    memset(&stream_, 0, sizeof(stream_));
+    // Using (MAX_WBITS + 16) creates a gzip header.
+    initialized_ = deflateInit2(&stream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                                MAX_WBITS + 16, /*memLevel=*/8,
+                                Z_DEFAULT_STRATEGY) == Z_OK;
+  }
+
+  GzipCompressor(const GzipCompressor&) = delete;
+  GzipCompressor& operator=(const GzipCompressor&) = delete;
+
+  ~GzipCompressor() {
+    if (initialized_) {
+      deflateEnd(&stream_);
+    }
+  }
+
+  // Compresses `input` and appends the result to `output`. `finish` ends the
+  // stream.
+  bool Compress(std::string_view input, bool finish, std::string* output) {
+    if (!initialized_) {
+      return false;
+    }
+    stream_.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream_.avail_in = static_cast<uInt>(input.size());
+    const int flush = finish ? Z_FINISH : Z_NO_FLUSH;
+    char buffer[kBufferSize];
+    int result;
+    do {
+      stream_.next_out = reinterpret_cast<Bytef*>(buffer);
+      stream_.avail_out = sizeof(buffer);
+      result = deflate(&stream_, flush);
+      if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+        DLOG(ERROR) << "deflate() failed: " << result;
+        return false;
+      }
+      output->append(buffer, sizeof(buffer) - stream_.avail_out);
+    } while (stream_.avail_out == 0 ||
+             (finish && result != Z_STREAM_END));
+    DCHECK_EQ(stream_.avail_in, 0u);
+    return true;
+  }
+
+ private:
+  z_stream stream_;
+  bool initialized_ = false;
+};
+
+NetExportStreamWriter::NetExportStreamWriter(base::File output_file,
+                                             const Options& options)
+    : output_file_(std::move(output_file)), options_(options) {
+  if (options_.gzip) {
+    compressor_ = std::make_unique<GzipCompressor>();
+  }
+}
+
+NetExportStreamWriter::~NetExportStreamWriter() = default;
+
+bool NetExportStreamWriter::Append(std::string_view data) {
+  if (!options_.max_event_bytes) {
+    return Write(data);
+  }
+
+  while (!data.empty()) {
+    const size_t line_end = data.find('\n');
+    if (line_end == std::string_view::npos) {
+      partial_line_.append(data);
+      break;
+    }
+    std::string line = std::exchange(partial_line_, std::string());
+    line.append(data.substr(0, line_end + 1));
+    data.remove_prefix(line_end + 1);
+    BufferLine(std::move(line));
+  }
+  return true;
+}
+
+bool NetExportStreamWriter::Finish() {
+  if (options_.max_event_bytes) {
+    if (!partial_line_.empty()) {
+      BufferLine(std::exchange(partial_line_, std::string()));
+    }
+    if (!Write(header_)) {
+      return false;
+    }
+    for (const std::string& event : events_) {
+      if (!Write(event)) {
+        return false;
+      }
+    }
+    if (!Write(footer_)) {
+      return false;
+    }
+    header_.clear();
+    events_.clear();
+    event_bytes_ = 0;
+    footer_.clear();
+  }
+  return Write(std::string_view(), /*finish=*/true);
+}
+
+// static
+bool NetExportStreamWriter::CreatePipe(base::File* read_end,
+                                       base::File* write_end) {
+#if BUILDFLAG(IS_POSIX)
+  base::ScopedFD read_fd;
+  base::ScopedFD write_fd;
+  if (!base::CreatePipe(&read_fd, &write_fd)) {
+    return false;
+  }
+  *read_end = base::File(read_fd.release());
+  *write_end = base::File(write_fd.release());
+  return true;
+#else
+  return false;
+#endif
+}
+
+// static
+bool NetExportStreamWriter::CopyFromPipe(base::File read_end,
+                                         base::File output_file,
+                                         const Options& options) {
+  NetExportStreamWriter writer(std::move(output_file), options);
+  char buffer[kBufferSize];
+  bool success = true;
+  while (true) {
+    int bytes_read;
+    {
+      base::ScopedBlockingCall scoped_blocking_call(
+          FROM_HERE, base::BlockingType::WILL_BLOCK);
+      bytes_read = read_end.ReadAtCurrentPosNoBestEffort(buffer, kBufferSize);
+    }
+    if (bytes_read <= 0) {
+      // 0 means that the network service closed the file.
+      success = bytes_read == 0;
+      break;
+    }
+    // Keep reading after a write error, so that the network service doesn't
+    // block on a full pipe.
+    if (success) {
+      success = writer.Append(
+          std::string_view(buffer, static_cast<size_t>(bytes_read)));
+    }
+  }
+  return writer.Finish() && success;
+}
+
+void NetExportStreamWriter::BufferLine(std::string line) {
+  const std::string_view content =
+      base::TrimWhitespaceASCII(line, base::TRIM_ALL);
+  switch (section_) {
+    case Section::kHeader:
+      header_.append(line);
+      if (base::StartsWith(content, "\"events\"")) {
+        section_ = Section::kEvents;
+      }
+      return;
+    case Section::kEvents:
+      if (base::StartsWith(content, "]")) {
+        section_ = Section::kFooter;
+        footer_.append(line);
+        return;
+      }
+      event_bytes_ += line.size();
+      events_.push_back(std::move(line));
+      // The most recent event is always kept.
+      while (event_bytes_ > options_.max_event_bytes && events_.size() > 1) {
+        event_bytes_ -= events_.front().size();
+        events_.pop_front();
+      }
+      return;
+    case Section::kFooter:
+      footer_.append(line);
+      return;
+  }
+}
+
+bool NetExportStreamWriter::Write(std::string_view data, bool finish) {
+  std::string compressed;
+  if (compressor_) {
+    if (!compressor_->Compress(data, finish, &compressed)) {
+      return false;
+    }
+    data = compressed;
+  }
+  return data.empty() ||
+         output_file_.WriteAtCurrentPosAndCheck(base::as_byte_span(data));
+}
+
+}  // namespace net_log
@@ -0,0 +1,100 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_NET_LOG_NET_EXPORT_STREAM_WRITER_H_
+#define COMPONENTS_NET_LOG_NET_EXPORT_STREAM_WRITER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "base/containers/circular_deque.h"
+#include "base/files/file.h"
+
+namespace net_log {
+
+// Writes a NetLog file as the network service produces it, optionally
+// compressing it on the fly and keeping only its most recent events.
+//
+// The network service writes the log as a JSON dictionary whose "events" list
+// has one event per line. In ring buffer mode, the lines before the events,
+// i.e. the constants, and the lines after them, i.e. the polled data, are
+// always kept, but only the most recent events that fit in the buffer are. They
+// are kept in memory, and written when the log is complete, so nothing is
+// written to disk during the capture.
+//
+// All methods do blocking file I/O.
+class NetExportStreamWriter {
+ public:
+  struct Options {
+    // Compresses the log with gzip.
+    bool gzip = false;
+    // If not 0, the maximum total size of the events that are kept.
+    size_t max_event_bytes = 0;
+
+    bool IsStreaming() const { return gzip || max_event_bytes; }
+  };
+
+  NetExportStreamWriter(base::File output_file, const Options& options);
+
+  NetExportStreamWriter(const NetExportStreamWriter&) = delete;
+  NetExportStreamWriter& operator=(const NetExportStreamWriter&) = delete;
+
+  ~NetExportStreamWriter();
+
+  // Appends the next `data` of the log. Returns false if the output can't be
+  // written.
+  bool Append(std::string_view data);
+
+  // Writes the buffered events and the end of the compressed stream. Returns
+  // false if the output can't be written.
+  bool Finish();
+
+  // Creates a pipe whose write end can be passed to the network service as
+  // the destination of the log. Returns false if the platform doesn't support
+  // logging through a pipe.
+  static bool CreatePipe(base::File* read_end, base::File* write_end);
+
+  // Reads the log from `read_end` until the write end is closed, and writes
+  // it to `output_file`. Blocks for the whole capture.
+  static bool CopyFromPipe(base::File read_end,
+                           base::File output_file,
+                           const Options& options);
+
+ private:
+  class GzipCompressor;
+
+  enum class Section {
+    kHeader,
+    kEvents,
+    kFooter,
+  };
+
+  // Adds a complete line, including its line break, to the ring buffer.
+  void BufferLine(std::string line);
+
+  // Writes `data` to the file, compressed if needed. `finish` ends the
+  // compressed stream.
+  bool Write(std::string_view data, bool finish = false);
+
+  base::File output_file_;
+  const Options options_;
+
+  // Set when the log is compressed.
+  std::unique_ptr<GzipCompressor> compressor_;
+
+  // Ring buffer mode state.
+  Section section_ = Section::kHeader;
+  std::string partial_line_;
+  std::string header_;
+  base::circular_deque<std::string> events_;
+  size_t event_bytes_ = 0;
+  std::string footer_;
+};
+
+}  // namespace net_log
+
+#endif  // COMPONENTS_NET_LOG_NET_EXPORT_STREAM_WRITER_H_
@@ -0,0 +1,136 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/net_log/net_export_stream_writer.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "base/containers/span.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_reader.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+#include "build/build_config.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/zlib/google/compression_utils.h"
+
+namespace net_log {
+
+namespace {
+
+// Returns a log in the format written by the network service, with events
+// whose ids go from 0 to `event_count` - 1.
+std::string MakeLog(int event_count) {
+  std::string log = "{\"constants\": {\"a\": 1},\n\"events\": [\n";
+  for (int i = 0; i < event_count; ++i) {
+    log += "{\"id\": " + base::NumberToString(i) + "},\n";
+  }
+  log += "],\n\"polledData\": {\"b\": 2}}\n";
+  return log;
+}
+
+class NetExportStreamWriterTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("log.json");
+  }
+
+  base::File CreateOutputFile() {
+    return base::File(path_,
+                      base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  }
+
+  // Writes `log` in chunks of `chunk_size` bytes, and returns the contents of
+  // the file.
+  std::string WriteLog(std::string_view log,
+                       const NetExportStreamWriter::Options& options,
+                       size_t chunk_size) {
+    {
+      NetExportStreamWriter writer(CreateOutputFile(), options);
+      for (size_t i = 0; i < log.size(); i += chunk_size) {
+        EXPECT_TRUE(writer.Append(log.substr(i, chunk_size)));
+      }
+      EXPECT_TRUE(writer.Finish());
+    }
+    std::string contents;
+    EXPECT_TRUE(base::ReadFileToString(path_, &contents));
+    return contents;
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+}  // namespace
+
+TEST_F(NetExportStreamWriterTest, Gzip) {
+  const std::string log = MakeLog(1000);
+  const std::string compressed =
+      WriteLog(log, {.gzip = true}, /*chunk_size=*/1000);
+  EXPECT_LT(compressed.size(), log.size());
+
+  std::string uncompressed;
+  ASSERT_TRUE(compression::GzipUncompress(compressed, &uncompressed));
+  EXPECT_EQ(log, uncompressed);
+}
+
+TEST_F(NetExportStreamWriterTest, RingBuffer) {
+  // Keep the 3 last events, which are 11 bytes long.
+  const std::string contents =
+      WriteLog(MakeLog(10), {.max_event_bytes = 36}, /*chunk_size=*/7);
+
+  std::optional<base::Value::Dict> log =
+      base::JSONReader::ReadDict(contents, base::JSON_ALLOW_TRAILING_COMMAS);
+  ASSERT_TRUE(log);
+  EXPECT_EQ(1, log->FindIntByDottedPath("constants.a"));
+  EXPECT_EQ(2, log->FindIntByDottedPath("polledData.b"));
+  const base::Value::List* events = log->FindList("events");
+  ASSERT_TRUE(events);
+  ASSERT_EQ(3u, events->size());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(7 + i, (*events)[i].GetDict().FindInt("id"));
+  }
+}
+
+TEST_F(NetExportStreamWriterTest, RingBufferWithGzip) {
+  const std::string compressed = WriteLog(
+      MakeLog(10), {.gzip = true, .max_event_bytes = 24}, /*chunk_size=*/5);
+
+  std::string uncompressed;
+  ASSERT_TRUE(compression::GzipUncompress(compressed, &uncompressed));
+  EXPECT_EQ(
+      "{\"constants\": {\"a\": 1},\n\"events\": [\n{\"id\": 8},\n{\"id\": 9},\n"
+      "],\n\"polledData\": {\"b\": 2}}\n",
+      uncompressed);
+}
+
+#if BUILDFLAG(IS_POSIX)
+TEST_F(NetExportStreamWriterTest, CopyFromPipe) {
+  base::File read_end;
+  base::File write_end;
+  ASSERT_TRUE(NetExportStreamWriter::CreatePipe(&read_end, &write_end));
+
+  // The log fits in the pipe buffer, so it can be written before reading.
+  const std::string log = MakeLog(10);
+  ASSERT_TRUE(write_end.WriteAtCurrentPosAndCheck(base::as_byte_span(log)));
+  write_end.Close();
+  EXPECT_TRUE(NetExportStreamWriter::CopyFromPipe(
+      std::move(read_end), CreateOutputFile(), {.gzip = true}));
+
+  std::string compressed;
+  ASSERT_TRUE(base::ReadFileToString(path_, &compressed));
+  std::string uncompressed;
+  ASSERT_TRUE(compression::GzipUncompress(compressed, &uncompressed));
+  EXPECT_EQ(log, uncompressed);
+}
+#endif
+
+}  // namespace net_log
@@ -634,6 +634,15 @@ void AutocompleteController::Start(const AutocompleteInput& input) {
   // arithmetic mean.
   base::TimeTicks start_time = base::TimeTicks::Now();
 
+  // Past the deadline, the sync pass of the remaining providers is deferred to
+  // later tasks, so that the matches so far are shown without waiting for
+  // them. A sync request needs all the matches at once, so it has no deadline.
+  CancelDeferredProviders();
+  deferred_minimal_changes_ = minimal_changes;
+  const auto& deadline_config =
+      omnibox_feature_configs::SyncPassDeadline::Get();
+  const bool has_deadline =
+      deadline_config.enabled && !input.omit_asynchronous_matches();
   for (const auto& provider : providers_) {
     // Starter Pack engines in keyword mode only run a subset of the providers,
     // so call `ShouldRunProvider()` to determine which ones should run.
@@ -641,20 +650,19 @@ void AutocompleteController::Start(const AutocompleteInput& input) {
       continue;
     }
 
-    base::TimeTicks provider_start_time = base::TimeTicks::Now();
-    provider->Start(input_, minimal_changes);
-
-    // `UmaHistogramTimes()` uses 1ms - 10s buckets, whereas this uses 1ms - 5s
-    // buckets.
-    // TODO(crbug.com/1340291|manukh): This isn't handled by `metrics_` yet. It
-    //   will "automatically" move to `metrics_` if we make all providers async.
-    //   Otherwise, if we decide not to make all providers async, move this
-    //   there.
-    base::TimeTicks provider_end_time = base::TimeTicks::Now();
-    base::UmaHistogramCustomTimes(
-        std::string("Omnibox.ProviderTime2.") + provider->GetName(),
-        provider_end_time - provider_start_time, base::Milliseconds(1),
-        base::Seconds(5), 20);
+    if (has_deadline && (!deferred_providers_.empty() ||
+                         base::TimeTicks::Now() - start_time >=
+                             deadline_config.deadline)) {
+      deferred_providers_.push_back(provider.get());
+      continue;
+    }
+    StartProvider(provider.get(), minimal_changes);
+  }
+  if (!deferred_providers_.empty()) {
+    base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&AutocompleteController::StartDeferredProviders,
+                       deferred_providers_weak_ptr_factory_.GetWeakPtr()));
   }
   if (!input.omit_asynchronous_matches()) {
     auto elapsed_time = base::TimeTicks::Now() - start_time;
@@ -696,6 +704,42 @@ void AutocompleteController::Start(const AutocompleteInput& input) {
   }
 }
 
+void AutocompleteController::StartProvider(AutocompleteProvider* provider,
+                                           bool minimal_changes) {
+  base::TimeTicks provider_start_time = base::TimeTicks::Now();
+  provider->Start(input_, minimal_changes);
+  metrics_.OnProviderSyncPass(*provider, provider_start_time,
+                              base::TimeTicks::Now());
+}
+
+void AutocompleteController::StartDeferredProviders() {
+  TRACE_EVENT0("omnibox", "AutocompleteController::StartDeferredProviders");
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  const base::TimeDelta deadline =
+      omnibox_feature_configs::SyncPassDeadline::Get().deadline;
+  // At least one provider runs per task, however slow.
+  do {
+    AutocompleteProvider* provider = deferred_providers_.front();
+    deferred_providers_.erase(deferred_providers_.begin());
+    StartProvider(provider, deferred_minimal_changes_);
+  } while (!deferred_providers_.empty() &&
+           base::TimeTicks::Now() - start_time < deadline);
+
+  if (!deferred_providers_.empty()) {
+    base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&AutocompleteController::StartDeferredProviders,
+                       deferred_providers_weak_ptr_factory_.GetWeakPtr()));
+  }
+  // Merges the new matches, like an async update of the providers.
+  OnProviderUpdate(true, nullptr);
+}
+
+void AutocompleteController::CancelDeferredProviders() {
+  deferred_providers_weak_ptr_factory_.InvalidateWeakPtrs();
+  deferred_providers_.clear();
+}
+
 void AutocompleteController::StartPrefetch(const AutocompleteInput& input) {
   TRACE_EVENT1("omnibox", "AutocompleteController::StartPrefetch", "text",
                base::UTF16ToUTF8(input.text()));
@@ -729,6 +773,7 @@ void AutocompleteController::Stop(bool clear_result,
   // logged yet, will log them now.
   metrics_.OnStop();
 
+  CancelDeferredProviders();
   for (const auto& provider : providers_) {
     if (!ShouldRunProvider(provider.get()))
       continue;
@@ -1233,8 +1278,10 @@ void AutocompleteController::UpdateResult(UpdateType update_type) {
 
 void AutocompleteController::AggregateNewMatches() {
   for (const auto& provider : providers_) {
-    if (!ShouldRunProvider(provider.get()))
+    if (!ShouldRunProvider(provider.get()) ||
+        base::Contains(deferred_providers_, provider.get())) {
       continue;
+    }
 
     // Append the new matches and conditionally set a swap bit. This logic
     // was previously within `AppendMatches` but here is the only place
@@ -1730,6 +1777,8 @@ void AutocompleteController::CancelNotifyChangedRequest() {
 
 AutocompleteController::ProviderDoneState
 AutocompleteController::GetProviderDoneState() {
+  if (!deferred_providers_.empty())
+    return ProviderDoneState::kNotDone;
   bool doc_not_done = false;
   for (const auto& provider : providers_) {
     if (!ShouldRunProvider(provider.get()) || provider->done())
@@ -14,6 +14,7 @@
 #include "base/gtest_prod_util.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
 #include "base/task/cancelable_task_tracker.h"
@@ -351,6 +352,17 @@ class AutocompleteController : public AutocompleteProviderListener,
   void InitializeAsyncProviders(int provider_types);
   void InitializeSyncProviders(int provider_types);
 
+  // Runs the sync pass of `provider` and logs how long it took.
+  void StartProvider(AutocompleteProvider* provider, bool minimal_changes);
+
+  // Runs the sync pass of the providers which were deferred because `Start()`
+  // ran past the sync pass deadline, in order, until the deadline passes again.
+  // The rest are posted to another task.
+  void StartDeferredProviders();
+
+  // Drops the deferred providers of the previous input, if any.
+  void CancelDeferredProviders();
+
   // Updates `internal_result_` to reflect the current provider state and fires
   // notifications.
   void UpdateResult(UpdateType update_type);
@@ -559,6 +571,15 @@ class AutocompleteController : public AutocompleteProviderListener,
   // Tab provider always (CrOS launcher) or just in keyword mode (!launcher).
   bool is_cros_launcher_;
 
+  // The providers whose sync pass was deferred past the sync pass deadline for
+  // the current input, in the order they should run. Their matches are ignored
+  // until they run, as they are those of the previous input.
+  std::vector<raw_ptr<AutocompleteProvider>> deferred_providers_;
+
+  // The `minimal_changes` argument of the `Start()` which deferred
+  // `deferred_providers_`.
+  bool deferred_minimal_changes_ = false;
+
   // Logs stability and timing metrics for updates.
   AutocompleteControllerMetrics metrics_{*this};
 
@@ -576,6 +597,10 @@ class AutocompleteController : public AutocompleteProviderListener,
 
   // The preferred steady state (unfocused) omnibox position.
   metrics::OmniboxEventProto::OmniboxPosition steady_state_omnibox_position_;
+
+  // Invalidated along with `deferred_providers_`.
+  base::WeakPtrFactory<AutocompleteController>
+      deferred_providers_weak_ptr_factory_{this};
 };
 
 #endif  // COMPONENTS_OMNIBOX_BROWSER_AUTOCOMPLETE_CONTROLLER_H_
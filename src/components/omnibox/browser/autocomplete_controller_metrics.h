@@ -14,7 +14,7 @@
 class AutocompleteController;
 class AutocompleteProvider;
 
-// Used to track and log timing metrics for `AutocompleteController`. Logs 3
+// Used to track and log timing metrics for `AutocompleteController`. Logs 4
 // sets of metrics:
 // 1) How long until each async provider completes.
 //    - Does not track intermediate updates if an async provider updates results
@@ -35,6 +35,10 @@ class AutocompleteProvider;
 //    - Tracks both sync and async updates.
 //    - Does not track suggestion removals.
 //    - Tracks suggestion additions and changes.
+// 4) How long the sync pass of each provider takes, and how long after the
+//    start of the request it runs.
+//    - Tracks both sync and async requests.
+//    - Tracks sync passes deferred past the sync pass deadline.
 class AutocompleteControllerMetrics {
  public:
   explicit AutocompleteControllerMetrics(
@@ -64,6 +68,14 @@ class AutocompleteControllerMetrics {
   // provider took.
   void OnProviderUpdate(const AutocompleteProvider& provider) const;
 
+  // Called when the sync pass of `provider`, i.e.
+  // `AutocompleteProvider::Start()`, ran from `start_time` to `end_time`. Logs
+  // 'Omnibox.ProviderTime2.<provider name>' and
+  // 'Omnibox.ProviderStartDelay.<provider name>'.
+  void OnProviderSyncPass(const AutocompleteProvider& provider,
+                          base::TimeTicks start_time,
+                          base::TimeTicks end_time) const;
+
   // Called when either `AutocompleteController::StopHelper()` or `OnStart()`
   // are called; i.e., when the ongoing request, if incomplete, will be
   // interrupted, e.g., because the input was updated, the popup was closed, or
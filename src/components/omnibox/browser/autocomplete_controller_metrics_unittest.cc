@@ -20,6 +20,7 @@
 #include "components/omnibox/browser/autocomplete_result.h"
 #include "components/omnibox/browser/fake_autocomplete_controller.h"
 #include "components/omnibox/browser/fake_autocomplete_provider.h"
+#include "components/omnibox/browser/omnibox_feature_configs.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -55,6 +56,29 @@ class FakeAutocompleteProviderDelayed : public FakeAutocompleteProvider {
  protected:
   ~FakeAutocompleteProviderDelayed() override = default;
 };
+
+// A fake provider whose sync pass consumes 1ms without running other tasks, so
+// that it can run from a posted task, and which counts its sync passes.
+class FakeAutocompleteProviderSlow : public FakeAutocompleteProvider {
+ public:
+  FakeAutocompleteProviderSlow(
+      Type type,
+      raw_ptr<base::test::SingleThreadTaskEnvironment> task_environment)
+      : FakeAutocompleteProvider(type), task_environment_(task_environment) {}
+
+  void Start(const AutocompleteInput& input, bool minimal_changes) override {
+    task_environment_->AdvanceClock(base::Milliseconds(1));
+    FakeAutocompleteProvider::Start(input, minimal_changes);
+    done_ = true;
+    start_count_++;
+  }
+
+  raw_ptr<base::test::SingleThreadTaskEnvironment> task_environment_ = nullptr;
+  int start_count_ = 0;
+
+ protected:
+  ~FakeAutocompleteProviderSlow() override = default;
+};
 }  // namespace
 
 class AutocompleteControllerMetricsTest : public testing::Test {
@@ -513,6 +537,54 @@ TEST_F(AutocompleteControllerMetricsTest, Provider_Interrupted) {
   ExpectSingleCountSuggestionFinalizationMetrics(3, 0, 0, false);
 }
 
+TEST_F(AutocompleteControllerMetricsTest, Provider_SyncPassDeadline) {
+  omnibox_feature_configs::ScopedConfigForTesting<
+      omnibox_feature_configs::SyncPassDeadline>
+      scoped_config;
+  scoped_config.Get().enabled = true;
+  scoped_config.Get().deadline = base::Milliseconds(1);
+  controller_.providers_ = {
+      base::MakeRefCounted<FakeAutocompleteProviderSlow>(
+          AutocompleteProvider::Type::TYPE_BOOKMARK, &task_environment_),
+      base::MakeRefCounted<FakeAutocompleteProviderSlow>(
+          AutocompleteProvider::Type::TYPE_KEYWORD, &task_environment_),
+      base::MakeRefCounted<FakeAutocompleteProviderSlow>(
+          AutocompleteProvider::Type::TYPE_BUILTIN, &task_environment_),
+  };
+  auto start_count = [&](size_t i) {
+    return controller_.GetFakeProvider<FakeAutocompleteProviderSlow>(i)
+        .start_count_;
+  };
+
+  // The 1st provider uses up the deadline, so the others are deferred.
+  controller_.Start(controller_.input_);
+  EXPECT_EQ(start_count(0), 1);
+  EXPECT_EQ(start_count(1), 0);
+  EXPECT_EQ(start_count(2), 0);
+  EXPECT_FALSE(controller_.done());
+
+  // Each deferred provider uses up the deadline of its own task.
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(start_count(1), 1);
+  EXPECT_EQ(start_count(2), 1);
+  EXPECT_TRUE(controller_.done());
+
+  for (size_t i = 0; i < 3; ++i) {
+    const std::string name = controller_.GetFakeProvider(i).GetName();
+    SCOPED_TRACE(name);
+    histogram_tester_->ExpectUniqueTimeSample("Omnibox.ProviderTime2." + name,
+                                              base::Milliseconds(1), 1);
+    histogram_tester_->ExpectUniqueTimeSample(
+        "Omnibox.ProviderStartDelay." + name, base::Milliseconds(i), 1);
+  }
+
+  // A sync request has no deadline.
+  SetInputSync(true);
+  controller_.Start(controller_.input_);
+  EXPECT_EQ(start_count(2), 2);
+  EXPECT_TRUE(controller_.done());
+}
+
 TEST_F(AutocompleteControllerMetricsTest, MatchStability) {
   auto create_result = [&](std::vector<int> ids) {
     std::vector<AutocompleteMatch> matches;
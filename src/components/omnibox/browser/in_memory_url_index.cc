@@ -6,10 +6,13 @@
 
 #include <cinttypes>
 #include <memory>
+#include <optional>
+#include <set>
 
 #include "base/feature_list.h"
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
+#include "base/functional/callback_helpers.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/no_destructor.h"
 #include "base/strings/stringprintf.h"
@@ -22,10 +25,26 @@
 #include "components/history/core/browser/history_service.h"
 #include "components/history/core/browser/url_database.h"
 #include "components/keep_alive_registry/keep_alive_registry.h"
+#include "components/omnibox/browser/omnibox_feature_configs.h"
 #include "components/omnibox/browser/omnibox_triggered_feature_service.h"
 #include "components/omnibox/browser/url_index_private_data.h"
 #include "components/omnibox/common/omnibox_features.h"
 
+namespace {
+
+// The name of the snapshot file in the history directory.
+constexpr base::FilePath::CharType kSnapshotFileName[] =
+    FILE_PATH_LITERAL("History Quick Provider Index");
+
+// The snapshot is saved this long after the last of a burst of deletions.
+constexpr base::TimeDelta kSnapshotSaveDelay = base::Seconds(30);
+
+// URLs visited shortly before a snapshot is taken may not have been indexed
+// yet, so the snapshot is caught up from this long before it was taken.
+constexpr base::TimeDelta kSnapshotCatchUpMargin = base::Minutes(1);
+
+}  // namespace
+
 // Initializes a allowlist of URL schemes.
 void InitializeSchemeAllowlist(SchemeSet* allowlist,
                                const SchemeSet& client_schemes_to_allowlist) {
@@ -69,6 +88,40 @@ void InMemoryURLIndex::RebuildPrivateDataFromHistoryDBTask::
 InMemoryURLIndex::RebuildPrivateDataFromHistoryDBTask::
     ~RebuildPrivateDataFromHistoryDBTask() = default;
 
+// CatchUpPrivateDataFromHistoryDBTask -----------------------------------------
+
+InMemoryURLIndex::CatchUpPrivateDataFromHistoryDBTask::
+    CatchUpPrivateDataFromHistoryDBTask(InMemoryURLIndex* index,
+                                        base::Time index_time)
+    : index_(index), index_time_(index_time) {}
+
+bool InMemoryURLIndex::CatchUpPrivateDataFromHistoryDBTask::RunOnDBThread(
+    history::HistoryBackend* backend,
+    history::HistoryDatabase* db) {
+  history::VisitVector visits;
+  if (!db->GetAllVisitsInRange(index_time_ - kSnapshotCatchUpMargin,
+                               base::Time(), std::nullopt, 0, &visits)) {
+    return true;
+  }
+  std::set<history::URLID> url_ids;
+  for (const auto& visit : visits)
+    url_ids.insert(visit.url_id);
+  for (history::URLID url_id : url_ids) {
+    history::URLRow row;
+    if (db->GetURLRow(url_id, &row))
+      visited_rows_.push_back(std::move(row));
+  }
+  return true;
+}
+
+void InMemoryURLIndex::CatchUpPrivateDataFromHistoryDBTask::
+    DoneRunOnMainThread() {
+  index_->DoneCatchingUpPrivateDataFromHistoryDB(visited_rows_);
+}
+
+InMemoryURLIndex::CatchUpPrivateDataFromHistoryDBTask::
+    ~CatchUpPrivateDataFromHistoryDBTask() = default;
+
 // InMemoryURLIndex ------------------------------------------------------------
 
 InMemoryURLIndex::InMemoryURLIndex(bookmarks::CoreBookmarkModel* bookmark_model,
@@ -81,7 +134,13 @@ InMemoryURLIndex::InMemoryURLIndex(bookmarks::CoreBookmarkModel* bookmark_model,
       template_url_service_(template_url_service),
       private_data_(new URLIndexPrivateData),
       task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
-          {base::MayBlock(), base::TaskPriority::BEST_EFFORT})) {
+          {base::MayBlock(), base::TaskPriority::BEST_EFFORT})),
+      snapshot_path_(
+          !history_dir.empty() &&
+                  omnibox_feature_configs::HistoryQuickProviderSnapshot::Get()
+                      .enabled
+              ? history_dir.Append(kSnapshotFileName)
+              : base::FilePath()) {
   InitializeSchemeAllowlist(&scheme_allowlist_, client_schemes_to_allowlist);
   // TODO(mrossetti): Register for language change notifications.
   if (history_service_)
@@ -107,6 +166,20 @@ void InMemoryURLIndex::Init() {
   if (!history_service_)
     return;
 
+  if (snapshot_path_.empty()) {
+    ScheduleRebuildFromHistory();
+    return;
+  }
+  base::Time* index_time = new base::Time;
+  task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&URLIndexPrivateData::RestoreFromFile, snapshot_path_,
+                     base::Unretained(index_time)),
+      base::BindOnce(&InMemoryURLIndex::DoneRestoringPrivateDataFromSnapshot,
+                     weak_ptr_factory_.GetWeakPtr(), base::Owned(index_time)));
+}
+
+void InMemoryURLIndex::ScheduleRebuildFromHistory() {
   // If the HistoryService backend is not initialized yet, that's okay. We're
   // scheduled to process our task once it's initialized.
   history_service_->ScheduleDBTask(
@@ -169,6 +242,17 @@ void InMemoryURLIndex::OnHistoryDeletions(
     for (const auto& row : deletion_info.deleted_rows())
       private_data_->DeleteURL(row.url());
   }
+
+  if (!snapshot_path_.empty()) {
+    // The deleted URLs must not come back from the snapshot, so it's deleted
+    // right away, and saved again later.
+    if (!restored_)
+      snapshot_invalidated_ = true;
+    task_runner_->PostTask(FROM_HERE,
+                           base::GetDeleteFileCallback(snapshot_path_));
+    snapshot_save_timer_.Start(FROM_HERE, kSnapshotSaveDelay, this,
+                               &InMemoryURLIndex::SaveSnapshot);
+  }
 }
 
 bool InMemoryURLIndex::OnMemoryDump(
@@ -200,6 +284,7 @@ void InMemoryURLIndex::Shutdown() {
   }
   shutdown_ = true;
   private_data_tracker_.TryCancelAll();
+  snapshot_save_timer_.Stop();
 
 #if !defined(LEAK_SANITIZER) && !BUILDFLAG(IS_ANDROID)
   // Intentionally create and then leak a scoped_refptr to private_data_. This
@@ -233,4 +318,56 @@ void InMemoryURLIndex::DoneRebuildingPrivateDataFromHistoryDB(
     private_data_->Clear();
   }
   restored_ = true;
+  if (succeeded)
+    SaveSnapshot();
+}
+
+// Restoring from the snapshot -------------------------------------------------
+
+void InMemoryURLIndex::DoneRestoringPrivateDataFromSnapshot(
+    const base::Time* index_time,
+    scoped_refptr<URLIndexPrivateData> private_data) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  if (shutdown_)
+    return;
+  const bool succeeded = private_data && !snapshot_invalidated_;
+  UMA_HISTOGRAM_BOOLEAN("Omnibox.HistoryQuickProvider.SnapshotRestored",
+                        succeeded);
+  if (!succeeded) {
+    ScheduleRebuildFromHistory();
+    return;
+  }
+
+  TRACE_EVENT_NESTABLE_ASYNC_END0("omnibox", "InMemoryURLIndex::Init",
+                                  TRACE_ID_LOCAL(this));
+  private_data_tracker_.TryCancelAll();
+  private_data_ = std::move(private_data);
+  restored_ = true;
+  history_service_->ScheduleDBTask(
+      FROM_HERE,
+      std::make_unique<CatchUpPrivateDataFromHistoryDBTask>(this, *index_time),
+      &private_data_tracker_);
+}
+
+void InMemoryURLIndex::DoneCatchingUpPrivateDataFromHistoryDB(
+    const history::URLRows& visited_rows) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  for (const auto& row : visited_rows) {
+    private_data_->UpdateURL(history_service_, row, scheme_allowlist_,
+                             &private_data_tracker_);
+  }
+  SaveSnapshot();
+}
+
+void InMemoryURLIndex::SaveSnapshot() {
+  // Until the index is restored, it's only partly built.
+  if (snapshot_path_.empty() || shutdown_ || !restored_)
+    return;
+  snapshot_save_timer_.Stop();
+  // The index is written from a copy, so that it can keep being updated.
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(base::IgnoreResult(&URLIndexPrivateData::SaveToFile),
+                     private_data_->Duplicate(), snapshot_path_,
+                     base::Time::Now()));
 }
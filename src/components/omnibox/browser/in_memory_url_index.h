@@ -16,9 +16,12 @@
 #include "base/gtest_prod_util.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
 #include "base/scoped_observation.h"
 #include "base/task/cancelable_task_tracker.h"
 #include "base/threading/thread_checker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "base/trace_event/memory_dump_provider.h"
 #include "components/history/core/browser/history_db_task.h"
 #include "components/history/core/browser/history_service.h"
@@ -82,8 +85,8 @@ class InMemoryURLIndex : public KeyedService,
   InMemoryURLIndex(const InMemoryURLIndex&) = delete;
   InMemoryURLIndex& operator=(const InMemoryURLIndex&) = delete;
 
-  // Opens and prepares the index of historical URL visits. Rebuilds the index
-  // from History.
+  // Opens and prepares the index of historical URL visits. Restores the index
+  // from its snapshot if there is one, or else rebuilds it from History.
   void Init();
 
   // Scans the history index and returns a vector with all scored, matching
@@ -115,6 +118,7 @@ class InMemoryURLIndex : public KeyedService,
   friend class history::HQPPerfTestOnePopularURL;
   friend class InMemoryURLIndexTest;
   FRIEND_TEST_ALL_PREFIXES(InMemoryURLIndexTest, ExpireRow);
+  FRIEND_TEST_ALL_PREFIXES(InMemoryURLIndexTest, RestoreFromSnapshot);
   FRIEND_TEST_ALL_PREFIXES(LimitedInMemoryURLIndexTest, Initialization);
 
   // HistoryDBTask used to rebuild our private data from the history database.
@@ -141,6 +145,28 @@ class InMemoryURLIndex : public KeyedService,
     scoped_refptr<URLIndexPrivateData> data_;  // The rebuilt private data.
   };
 
+  // HistoryDBTask used to bring private data restored from a snapshot up to
+  // date, by reading the URLs visited since the snapshot was taken.
+  class CatchUpPrivateDataFromHistoryDBTask : public history::HistoryDBTask {
+   public:
+    CatchUpPrivateDataFromHistoryDBTask(InMemoryURLIndex* index,
+                                        base::Time index_time);
+    CatchUpPrivateDataFromHistoryDBTask(
+        const CatchUpPrivateDataFromHistoryDBTask&) = delete;
+    CatchUpPrivateDataFromHistoryDBTask& operator=(
+        const CatchUpPrivateDataFromHistoryDBTask&) = delete;
+    ~CatchUpPrivateDataFromHistoryDBTask() override;
+
+    bool RunOnDBThread(history::HistoryBackend* backend,
+                       history::HistoryDatabase* db) override;
+    void DoneRunOnMainThread() override;
+
+   private:
+    raw_ptr<InMemoryURLIndex, AcrossTasksDanglingUntriaged> index_;
+    const base::Time index_time_;  // The time the snapshot was taken.
+    history::URLRows visited_rows_;  // The URLs visited since.
+  };
+
   // Clears the in-memory cache entirely. Called when History is cleared.
   void ClearPrivateData();
 
@@ -156,6 +182,22 @@ class InMemoryURLIndex : public KeyedService,
       bool succeeded,
       scoped_refptr<URLIndexPrivateData> private_data);
 
+  // Callback for restoring our private data from the snapshot, taken at
+  // |*index_time|. |private_data| is null if there was no usable snapshot, in
+  // which case the private data is rebuilt from the history database instead.
+  void DoneRestoringPrivateDataFromSnapshot(
+      const base::Time* index_time,
+      scoped_refptr<URLIndexPrivateData> private_data);
+
+  // Callback used by CatchUpPrivateDataFromHistoryDBTask to update the
+  // restored private data with the URLs visited since the snapshot.
+  void DoneCatchingUpPrivateDataFromHistoryDB(
+      const history::URLRows& visited_rows);
+
+  // Writes a snapshot of our private data in the background, if snapshots are
+  // enabled.
+  void SaveSnapshot();
+
   // KeyedService:
   // Signals that any outstanding initialization should be canceled.
   void Shutdown() override;
@@ -205,6 +247,18 @@ class InMemoryURLIndex : public KeyedService,
   // Task runner used for operations which require disk access.
   const scoped_refptr<base::SequencedTaskRunner> task_runner_;
 
+  // The file holding the snapshot of the private data. Empty if snapshots are
+  // disabled, or when testing without a history directory.
+  const base::FilePath snapshot_path_;
+
+  // Delays saving the snapshot after history deletions, which often come in
+  // bursts. The outdated snapshot is deleted meanwhile.
+  base::OneShotTimer snapshot_save_timer_;
+
+  // Set when history is deleted while the snapshot is being restored, in
+  // which case it can't be used.
+  bool snapshot_invalidated_ = false;
+
   base::CancelableTaskTracker private_data_tracker_;
 
   // Set to true once the shutdown process has begun.
@@ -218,6 +272,8 @@ class InMemoryURLIndex : public KeyedService,
       history_service_observation_{this};
 
   base::ThreadChecker thread_checker_;
+
+  base::WeakPtrFactory<InMemoryURLIndex> weak_ptr_factory_{this};
 };
 
 #endif  // COMPONENTS_OMNIBOX_BROWSER_IN_MEMORY_URL_INDEX_H_
@@ -14,6 +14,7 @@
 
 #include "base/containers/flat_set.h"
 #include "components/history/core/browser/history_types.h"
+#include "components/omnibox/browser/posting_list.h"
 #include "url/gurl.h"
 
 // Convenience Types -----------------------------------------------------------
@@ -128,14 +129,17 @@ typedef std::map<std::u16string, WordID> WordMap;
 
 // A map from character to the word_ids of words containing that character.
 typedef base::flat_set<WordID> WordIDSet;  // An index into the WordList.
-typedef std::map<char16_t, WordIDSet> CharWordIDMap;
+// The lists of the index are kept compact, see PostingList.
+typedef PostingList<WordID> WordIDPostingList;
+typedef std::map<char16_t, WordIDPostingList> CharWordIDMap;
 
 // A map from word (by word_id) to history items containing that word.
 typedef history::URLID HistoryID;
 typedef base::flat_set<HistoryID> HistoryIDSet;
 typedef std::vector<HistoryID> HistoryIDVector;
-typedef std::map<WordID, HistoryIDSet> WordIDHistoryMap;
-typedef std::map<HistoryID, WordIDSet> HistoryIDWordMap;
+typedef PostingList<HistoryID> HistoryIDPostingList;
+typedef std::map<WordID, HistoryIDPostingList> WordIDHistoryMap;
+typedef std::map<HistoryID, WordIDPostingList> HistoryIDWordMap;
 
 
 // Information used in scoring a particular URL.
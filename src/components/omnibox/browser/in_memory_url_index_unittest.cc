@@ -33,6 +33,7 @@
 #include "components/history/core/browser/history_service.h"
 #include "components/history/core/test/history_service_test_util.h"
 #include "components/omnibox/browser/in_memory_url_index_types.h"
+#include "components/omnibox/browser/omnibox_feature_configs.h"
 #include "components/omnibox/browser/omnibox_triggered_feature_service.h"
 #include "components/omnibox/browser/url_index_private_data.h"
 #include "components/search_engines/template_url_service.h"
@@ -988,6 +989,83 @@ TEST_F(InMemoryURLIndexTest, ExpireRow) {
                   .empty());
 }
 
+TEST_F(InMemoryURLIndexTest, SaveAndRestoreSnapshot) {
+  ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  const base::FilePath path = temp_dir_.GetPath().AppendASCII("snapshot");
+  const base::Time index_time = base::Time::Now();
+  ASSERT_TRUE(GetPrivateData()->SaveToFile(path, index_time));
+
+  base::Time restored_index_time;
+  scoped_refptr<URLIndexPrivateData> restored_data =
+      URLIndexPrivateData::RestoreFromFile(path, &restored_index_time);
+  ASSERT_TRUE(restored_data);
+  EXPECT_EQ(index_time, restored_index_time);
+  ExpectPrivateDataEqual(*GetPrivateData(), *restored_data);
+
+  // A truncated snapshot isn't restored.
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(path, &contents));
+  ASSERT_TRUE(base::WriteFile(path, contents.substr(0, contents.size() / 2)));
+  EXPECT_FALSE(
+      URLIndexPrivateData::RestoreFromFile(path, &restored_index_time));
+
+  // Nor is a missing one.
+  ASSERT_TRUE(base::DeleteFile(path));
+  EXPECT_FALSE(
+      URLIndexPrivateData::RestoreFromFile(path, &restored_index_time));
+}
+
+TEST_F(InMemoryURLIndexTest, RestoreFromSnapshot) {
+  omnibox_feature_configs::ScopedConfigForTesting<
+      omnibox_feature_configs::HistoryQuickProviderSnapshot>
+      scoped_config;
+  scoped_config.Get().enabled = true;
+  ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+
+  // Without a snapshot, the index is rebuilt from History, then saved.
+  auto rebuilt_index = std::make_unique<InMemoryURLIndex>(
+      nullptr, history_service_.get(), template_url_service_.get(),
+      temp_dir_.GetPath(), SchemeSet());
+  rebuilt_index->Init();
+  BlockUntilHistoryProcessesPendingRequests(history_service_.get());
+  task_environment_.RunUntilIdle();
+  ASSERT_TRUE(rebuilt_index->restored());
+  EXPECT_TRUE(base::PathExists(rebuilt_index->snapshot_path_));
+
+  // The next index is restored from the snapshot, and catches up with the
+  // URLs visited since.
+  history_service_->AddPageWithDetails(GURL("http://www.snapshot.com/"),
+                                       u"Caught up", 1, 1, base::Time::Now(),
+                                       false, history::SOURCE_BROWSED);
+  BlockUntilHistoryProcessesPendingRequests(history_service_.get());
+  task_environment_.RunUntilIdle();
+  auto restored_index = std::make_unique<InMemoryURLIndex>(
+      nullptr, history_service_.get(), template_url_service_.get(),
+      temp_dir_.GetPath(), SchemeSet());
+  restored_index->Init();
+  task_environment_.RunUntilIdle();
+  BlockUntilHistoryProcessesPendingRequests(history_service_.get());
+  task_environment_.RunUntilIdle();
+  ASSERT_TRUE(restored_index->restored());
+  EXPECT_FALSE(restored_index->private_data()->Empty());
+  OmniboxTriggeredFeatureService triggered_feature_service;
+  EXPECT_EQ(restored_index
+                ->HistoryItemsForTerms(u"DrudgeReport", std::u16string::npos,
+                                       "", kProviderMaxMatches,
+                                       &triggered_feature_service)
+                .size(),
+            1u);
+  EXPECT_EQ(restored_index
+                ->HistoryItemsForTerms(u"snapshot", std::u16string::npos, "",
+                                       kProviderMaxMatches,
+                                       &triggered_feature_service)
+                .size(),
+            1u);
+
+  rebuilt_index->Shutdown();
+  restored_index->Shutdown();
+}
+
 TEST_F(InMemoryURLIndexTest, AllowlistedURLs) {
   std::string client_allowlisted_url =
       base::StringPrintf("%s://foo", kClientAllowlistedScheme);
@@ -61,6 +61,14 @@ ForceAllowedToBeDefault::ForceAllowedToBeDefault() {
   enabled = base::FeatureList::IsEnabled(kForceAllowedToBeDefault);
 }
 
+// static
+BASE_FEATURE(HistoryQuickProviderSnapshot::kHistoryQuickProviderSnapshot,
+             "OmniboxHistoryQuickProviderSnapshot",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+HistoryQuickProviderSnapshot::HistoryQuickProviderSnapshot() {
+  enabled = base::FeatureList::IsEnabled(kHistoryQuickProviderSnapshot);
+}
+
 // static
 BASE_FEATURE(LimitKeywordModeSuggestions::kLimitKeywordModeSuggestions,
              "OmniboxLimitKeywordModeSuggestions",
@@ -152,6 +160,17 @@ SuggestionAnswerMigration::SuggestionAnswerMigration() {
   enabled = base::FeatureList::IsEnabled(kOmniboxSuggestionAnswerMigration);
 }
 
+// static
+BASE_FEATURE(SyncPassDeadline::kSyncPassDeadline,
+             "OmniboxSyncPassDeadline",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+SyncPassDeadline::SyncPassDeadline() {
+  enabled = base::FeatureList::IsEnabled(kSyncPassDeadline);
+  deadline = base::Milliseconds(
+      base::FeatureParam<int>(&kSyncPassDeadline, "SyncPassDeadlineMs", 16)
+          .Get());
+}
+
 // static
 BASE_FEATURE(VitalizeAutocompletedKeywords::kVitalizeAutocompletedKeywords,
              "OmniboxVitalizeAutocompletedKeywords",
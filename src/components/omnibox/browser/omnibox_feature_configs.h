@@ -6,6 +6,7 @@
 #define COMPONENTS_OMNIBOX_BROWSER_OMNIBOX_FEATURE_CONFIGS_H_
 
 #include "base/feature_list.h"
+#include "base/time/time.h"
 
 namespace omnibox_feature_configs {
 
@@ -135,6 +136,15 @@ struct ForceAllowedToBeDefault : Config<ForceAllowedToBeDefault> {
   bool enabled;
 };
 
+// If enabled, the HistoryQuickProvider index is saved to a snapshot file in the
+// profile, and restored from it at startup instead of being rebuilt from the
+// history database.
+struct HistoryQuickProviderSnapshot : Config<HistoryQuickProviderSnapshot> {
+  DECLARE_FEATURE(kHistoryQuickProviderSnapshot);
+  HistoryQuickProviderSnapshot();
+  bool enabled;
+};
+
 // If enabled, only suggestions from the keyword mode provider and historical
 // keyword mode suggestions will be shown in keyword mode.
 struct LimitKeywordModeSuggestions : Config<LimitKeywordModeSuggestions> {
@@ -212,6 +222,18 @@ struct ShortcutBoosting : Config<ShortcutBoosting> {
   bool group_with_searches;
 };
 
+// If enabled, the sync passes of the providers that would start after
+// `deadline` has passed since `AutocompleteController::Start()` are deferred to
+// later tasks, so that slow providers don't delay input handling and painting.
+// The deferred providers' matches are merged in as they complete, as for async
+// passes.
+struct SyncPassDeadline : Config<SyncPassDeadline> {
+  DECLARE_FEATURE(kSyncPassDeadline);
+  SyncPassDeadline();
+  bool enabled;
+  base::TimeDelta deadline;
+};
+
 // If enabled, affects autocompleted keywords (e.g. input 'youtu Ispiryan' ->
 // match 'Ispiryan - Search YouTube').
 // 1) These autocompleted keywords will be scored `score` instead of the default
@@ -0,0 +1,251 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_OMNIBOX_BROWSER_POSTING_LIST_H_
+#define COMPONENTS_OMNIBOX_BROWSER_POSTING_LIST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+#include "base/check.h"
+#include "base/check_op.h"
+#include "third_party/abseil-cpp/absl/container/inlined_vector.h"
+
+// A set of non-negative integer IDs, such as the IDs of the history items
+// containing a word in the InMemoryURLIndex. The IDs are stored in ascending
+// order as the varint-encoded differences between consecutive IDs, which takes
+// one or two bytes per ID for the dense IDs of the index, instead of eight in a
+// base::flat_set. Short lists are stored inline, without a heap allocation.
+//
+// Iteration visits the IDs in ascending order, like a base::flat_set, so the
+// set algorithms for sorted ranges work as is. As the IDs mostly come in
+// ascending order when the index is built, inserting an ID greater than all
+// others is constant time. Other insertions and removals are linear.
+template <typename T>
+class PostingList {
+ public:
+  static_assert(std::is_integral_v<T>);
+
+  using value_type = T;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    const_iterator() = default;
+
+    reference operator*() const { return value_; }
+    pointer operator->() const { return &value_; }
+
+    const_iterator& operator++() {
+      if (position_ == end_) {
+        // Past the last ID.
+        position_ = nullptr;
+      } else {
+        value_ += static_cast<T>(ReadVarint(position_));
+      }
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator previous = *this;
+      ++*this;
+      return previous;
+    }
+
+    friend bool operator==(const const_iterator& a, const const_iterator& b) {
+      return a.position_ == b.position_;
+    }
+
+   private:
+    friend class PostingList;
+
+    // `position` is the start of the encoding of the ID after `value`, or
+    // `end` if `value` is the last ID. `position` is null for the end
+    // iterator.
+    const_iterator(const uint8_t* position, const uint8_t* end, T value)
+        : position_(position), end_(end), value_(value) {}
+
+    const uint8_t* position_ = nullptr;
+    const uint8_t* end_ = nullptr;
+    T value_ = 0;
+  };
+
+  PostingList() = default;
+  PostingList(const PostingList&) = default;
+  PostingList(PostingList&&) = default;
+  PostingList& operator=(const PostingList&) = default;
+  PostingList& operator=(PostingList&&) = default;
+  ~PostingList() = default;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  const_iterator begin() const {
+    if (empty()) {
+      return end();
+    }
+    const uint8_t* position = bytes_.data();
+    T first = static_cast<T>(ReadVarint(position));
+    return const_iterator(position, bytes_.data() + bytes_.size(), first);
+  }
+  const_iterator end() const { return const_iterator(); }
+
+  // Inserts `id` if it isn't in the list yet, and returns whether it was.
+  bool insert(T id) {
+    if constexpr (std::is_signed_v<T>) {
+      DCHECK_GE(id, 0);
+    }
+    if (empty() || id > last_) {
+      AppendVarint(static_cast<uint64_t>(id - last_), bytes_);
+      last_ = id;
+      ++size_;
+      return true;
+    }
+
+    // Split the difference between the neighbors of `id` in two.
+    Position position = Find(id);
+    if (position.value == id) {
+      return false;
+    }
+    Bytes replacement;
+    AppendVarint(static_cast<uint64_t>(id - position.previous_value),
+                 replacement);
+    AppendVarint(static_cast<uint64_t>(position.value - id), replacement);
+    Replace(position, replacement);
+    ++size_;
+    return true;
+  }
+
+  // Removes `id` if it's in the list, and returns the number of IDs removed.
+  size_t erase(T id) {
+    if (empty() || id > last_) {
+      return 0;
+    }
+    Position position = Find(id);
+    if (position.value != id) {
+      return 0;
+    }
+
+    // Merge the differences on both sides of `id`.
+    Bytes replacement;
+    if (position.end == bytes_.size()) {
+      last_ = position.previous_value;
+    } else {
+      const uint8_t* next = bytes_.data() + position.end;
+      const T next_value = id + static_cast<T>(ReadVarint(next));
+      AppendVarint(static_cast<uint64_t>(next_value - position.previous_value),
+                   replacement);
+      position.end = static_cast<size_t>(next - bytes_.data());
+    }
+    Replace(position, replacement);
+    --size_;
+    if (empty()) {
+      clear();
+    }
+    return 1;
+  }
+
+  // Linear, unlike in a base::flat_set.
+  size_t count(T id) const { return contains(id) ? 1 : 0; }
+  bool contains(T id) const {
+    if (empty() || id > last_) {
+      return false;
+    }
+    return Find(id).value == id;
+  }
+
+  void clear() {
+    bytes_.clear();
+    bytes_.shrink_to_fit();
+    size_ = 0;
+    last_ = 0;
+  }
+
+  // Estimates dynamic memory usage.
+  // See base/trace_event/memory_usage_estimator.h for more info.
+  size_t EstimateMemoryUsage() const {
+    return bytes_.capacity() > kInlineBytes ? bytes_.capacity() : 0;
+  }
+
+ private:
+  // The inline capacity keeps `bytes_` as small as a std::vector.
+  static constexpr size_t kInlineBytes = 16;
+  using Bytes = absl::InlinedVector<uint8_t, kInlineBytes>;
+
+  // The location of the encoding of `value`, the first ID not less than the
+  // one looked for, in `bytes_[start, end)`.
+  struct Position {
+    size_t start;
+    size_t end;
+    T value;
+    T previous_value;
+  };
+
+  static void AppendVarint(uint64_t value, Bytes& bytes) {
+    while (value >= 0x80) {
+      bytes.push_back(static_cast<uint8_t>(value) | 0x80);
+      value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+  }
+
+  static uint64_t ReadVarint(const uint8_t*& position) {
+    uint64_t value = 0;
+    for (int shift = 0;; shift += 7) {
+      const uint8_t byte = *position++;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+  }
+
+  // `id` must not be greater than `last_`.
+  Position Find(T id) const {
+    DCHECK(!empty());
+    DCHECK_LE(id, last_);
+    const uint8_t* const data = bytes_.data();
+    const uint8_t* position = data;
+    T previous_value = 0;
+    T value = 0;
+    while (true) {
+      const uint8_t* start = position;
+      value = previous_value + static_cast<T>(ReadVarint(position));
+      if (value >= id) {
+        return {static_cast<size_t>(start - data),
+                static_cast<size_t>(position - data), value, previous_value};
+      }
+      previous_value = value;
+    }
+  }
+
+  // Replaces `bytes_[position.start, position.end)` with `replacement`.
+  void Replace(const Position& position, const Bytes& replacement) {
+    const size_t replaced = position.end - position.start;
+    const auto start = bytes_.begin() + position.start;
+    if (replacement.size() >= replaced) {
+      std::copy(replacement.begin(), replacement.begin() + replaced, start);
+      bytes_.insert(start + replaced, replacement.begin() + replaced,
+                    replacement.end());
+    } else {
+      std::copy(replacement.begin(), replacement.end(), start);
+      bytes_.erase(start + replacement.size(), start + replaced);
+    }
+  }
+
+  Bytes bytes_;
+  uint32_t size_ = 0;
+  // The greatest ID, to append without decoding the list.
+  T last_ = 0;
+};
+
+#endif  // COMPONENTS_OMNIBOX_BROWSER_POSTING_LIST_H_
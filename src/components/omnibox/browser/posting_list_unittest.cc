@@ -0,0 +1,90 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/omnibox/browser/posting_list.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "base/rand_util.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+TEST(PostingListTest, InsertAndErase) {
+  PostingList<int64_t> list;
+  EXPECT_TRUE(list.empty());
+  EXPECT_THAT(list, IsEmpty());
+
+  EXPECT_TRUE(list.insert(5));
+  EXPECT_TRUE(list.insert(300));
+  EXPECT_TRUE(list.insert(1));
+  EXPECT_TRUE(list.insert(200));
+  EXPECT_FALSE(list.insert(5));
+  EXPECT_EQ(list.size(), 4u);
+  EXPECT_THAT(list, ElementsAre(1, 5, 200, 300));
+  EXPECT_TRUE(list.contains(200));
+  EXPECT_FALSE(list.contains(201));
+  EXPECT_EQ(list.count(300), 1u);
+  EXPECT_EQ(list.count(301), 0u);
+
+  EXPECT_EQ(list.erase(5), 1u);
+  EXPECT_EQ(list.erase(5), 0u);
+  EXPECT_EQ(list.erase(1000), 0u);
+  EXPECT_THAT(list, ElementsAre(1, 200, 300));
+
+  // Erasing the last ID updates the append fast path.
+  EXPECT_EQ(list.erase(300), 1u);
+  EXPECT_TRUE(list.insert(250));
+  EXPECT_THAT(list, ElementsAre(1, 200, 250));
+
+  EXPECT_EQ(list.erase(1), 1u);
+  EXPECT_EQ(list.erase(200), 1u);
+  EXPECT_EQ(list.erase(250), 1u);
+  EXPECT_TRUE(list.empty());
+  EXPECT_TRUE(list.insert(0));
+  EXPECT_THAT(list, ElementsAre(0));
+}
+
+TEST(PostingListTest, MatchesSet) {
+  PostingList<size_t> list;
+  std::set<size_t> expected;
+  for (int i = 0; i < 10000; ++i) {
+    // Mix small and large gaps, so that differences take one to three bytes.
+    const size_t id = base::RandInt(0, i % 2 ? 500 : 1000000);
+    if (base::RandInt(0, 2)) {
+      EXPECT_EQ(list.insert(id), expected.insert(id).second);
+    } else {
+      EXPECT_EQ(list.erase(id), expected.erase(id));
+    }
+    ASSERT_EQ(list.size(), expected.size());
+  }
+  EXPECT_EQ(std::vector<size_t>(list.begin(), list.end()),
+            std::vector<size_t>(expected.begin(), expected.end()));
+}
+
+TEST(PostingListTest, Compact) {
+  // Short lists fit inline.
+  PostingList<int64_t> short_list;
+  for (int64_t id = 1000; id < 1010; ++id) {
+    short_list.insert(id);
+  }
+  EXPECT_EQ(short_list.EstimateMemoryUsage(), 0u);
+
+  // Dense IDs take a byte each.
+  PostingList<int64_t> long_list;
+  for (int64_t id = 0; id < 10000; ++id) {
+    long_list.insert(id);
+  }
+  EXPECT_LT(long_list.EstimateMemoryUsage(), 10000 * 2u);
+
+  PostingList<int64_t> copy = long_list;
+  EXPECT_EQ(copy.size(), long_list.size());
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), long_list.begin()));
+}
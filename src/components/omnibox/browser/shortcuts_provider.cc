@@ -250,6 +250,55 @@ void ShortcutsProvider::OnShortcutsLoaded() {
   initialized_ = true;
 }
 
+void ShortcutsProvider::OnShortcutsChanged() {
+  // The candidates may point to shortcuts which were removed.
+  candidates_.clear();
+  candidates_lower_input_.clear();
+}
+
+const std::vector<ShortcutsProvider::Candidate>&
+ShortcutsProvider::GetCandidates(const AutocompleteInput& input,
+                                 const std::u16string& lower_input) {
+  const bool input_has_ref = !input.parts().ref.is_empty();
+  if (!candidates_lower_input_.empty() &&
+      base::StartsWith(lower_input, candidates_lower_input_,
+                       base::CompareCase::SENSITIVE) &&
+      input.terms_prefixed_by_http_or_https() ==
+          candidates_terms_prefixed_by_http_or_https_ &&
+      input_has_ref == candidates_input_has_ref_) {
+    if (lower_input.length() > candidates_lower_input_.length()) {
+      std::erase_if(candidates_, [&](const Candidate& candidate) {
+        return !base::StartsWith(candidate.it->first, lower_input,
+                                 base::CompareCase::SENSITIVE);
+      });
+      candidates_lower_input_ = lower_input;
+    }
+    return candidates_;
+  }
+
+  TemplateURLService* template_url_service = client_->GetTemplateURLService();
+  candidates_.clear();
+  for (auto it = FindFirstMatch(lower_input, backend_.get());
+       it != backend_->shortcuts_map().end() &&
+       base::StartsWith(it->first, lower_input, base::CompareCase::SENSITIVE);
+       ++it) {
+    const ShortcutsDatabase::Shortcut& shortcut = it->second;
+    candidates_.push_back(
+        {it,
+         AutocompleteMatch::GURLToStrippedGURL(
+             shortcut.match_core.destination_url, input, template_url_service,
+             shortcut.match_core.keyword,
+             /*keep_search_intent_params=*/false, /*normalize_search_terms=*/
+             base::FeatureList::IsEnabled(
+                 omnibox::kNormalizeSearchSuggestions))});
+  }
+  candidates_lower_input_ = lower_input;
+  candidates_terms_prefixed_by_http_or_https_ =
+      input.terms_prefixed_by_http_or_https();
+  candidates_input_has_ref_ = input_has_ref;
+  return candidates_;
+}
+
 void ShortcutsProvider::DoAutocomplete(const AutocompleteInput& input,
                                        bool populate_scoring_signals) {
   if (!backend_) {
@@ -261,7 +310,6 @@ void ShortcutsProvider::DoAutocomplete(const AutocompleteInput& input,
   DCHECK(!lower_input.empty());
 
   int max_relevance = kShortcutsProviderDefaultMaxRelevance;
-  TemplateURLService* template_url_service = client_->GetTemplateURLService();
   const std::u16string fixed_up_input(FixupUserInput(input).second);
 
   // Get the shortcuts from the database with keys that partially or completely
@@ -275,18 +323,9 @@ void ShortcutsProvider::DoAutocomplete(const AutocompleteInput& input,
   // together, and create a single `ShortcutMatch`.
   std::map<GURL, std::vector<const ShortcutsDatabase::Shortcut*>>
       shortcuts_by_url;
-  for (auto it = FindFirstMatch(lower_input, backend_.get());
-       it != backend_->shortcuts_map().end() &&
-       base::StartsWith(it->first, lower_input, base::CompareCase::SENSITIVE);
-       ++it) {
-    const ShortcutsDatabase::Shortcut& shortcut = it->second;
-
-    const GURL stripped_destination_url(AutocompleteMatch::GURLToStrippedGURL(
-        shortcut.match_core.destination_url, input, template_url_service,
-        shortcut.match_core.keyword,
-        /*keep_search_intent_params=*/false, /*normalize_search_terms=*/
-        base::FeatureList::IsEnabled(omnibox::kNormalizeSearchSuggestions)));
-    shortcuts_by_url[stripped_destination_url].push_back(&shortcut);
+  for (const Candidate& candidate : GetCandidates(input, lower_input)) {
+    shortcuts_by_url[candidate.stripped_destination_url].push_back(
+        &candidate.it->second);
   }
 
   if (!input.omit_asynchronous_matches()) {
@@ -7,6 +7,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "base/gtest_prod_util.h"
 #include "base/memory/raw_ptr.h"
@@ -72,8 +73,24 @@ class ShortcutsProvider : public AutocompleteProvider,
 
   ~ShortcutsProvider() override;
 
+  // A shortcut matching the input, along with its stripped destination URL.
+  struct Candidate {
+    ShortcutsBackend::ShortcutMap::const_iterator it;
+    GURL stripped_destination_url;
+  };
+
   // ShortcutsBackendObserver:
   void OnShortcutsLoaded() override;
+  void OnShortcutsChanged() override;
+
+  // Returns the shortcuts with text starting with `lower_input`, in the order
+  // of `ShortcutsBackend::shortcuts_map()`. While typing, each input extends
+  // the previous one, so the candidates are narrowed down from those of the
+  // previous input instead of being looked up again, which also saves
+  // stripping their destination URLs again.
+  const std::vector<Candidate>& GetCandidates(
+      const AutocompleteInput& input,
+      const std::u16string& lower_input);
 
   // Performs the autocomplete matching and scoring. Populates matches results
   // with scoring signals for ML models if enabled. Only populates signals for
@@ -117,6 +134,14 @@ class ShortcutsProvider : public AutocompleteProvider,
   raw_ptr<AutocompleteProviderClient> client_ = nullptr;
   scoped_refptr<ShortcutsBackend> backend_;
   bool initialized_{};
+
+  // The candidates for `candidates_lower_input_`, cleared when the shortcuts
+  // change. The stripped destination URLs also depend on the parts of the
+  // input below.
+  std::vector<Candidate> candidates_;
+  std::u16string candidates_lower_input_;
+  std::vector<std::u16string> candidates_terms_prefixed_by_http_or_https_;
+  bool candidates_input_has_ref_ = false;
 };
 
 #endif  // COMPONENTS_OMNIBOX_BROWSER_SHORTCUTS_PROVIDER_H_
@@ -611,6 +611,39 @@ TEST_F(ShortcutsProviderTest, MultiMatch) {
                          });
 }
 
+TEST_F(ShortcutsProviderTest, IncrementalInput) {
+  TestShortcutData shortcut_data[] = {
+      MakeShortcutData("typed-a", 2),
+      MakeShortcutData("typed-b", 1),
+  };
+  scoped_refptr<ShortcutsBackend> backend = client_->GetShortcutsBackend();
+  PopulateShortcutsBackendWithTestData(backend, shortcut_data,
+                                       std::size(shortcut_data));
+  auto start = [&](const std::u16string& text) {
+    AutocompleteInput input(text, metrics::OmniboxEventProto::OTHER,
+                            TestSchemeClassifier());
+    provider_->Start(input, false);
+    return provider_->matches();
+  };
+
+  VerifyMatches(start(u"typed"),
+                {"https://typed-a.com/2", "https://typed-b.com/1"});
+  // Narrowed down from the candidates of 'typed'.
+  VerifyMatches(start(u"typed-a"), {"https://typed-a.com/2"});
+
+  // Changed shortcuts aren't missed.
+  TestShortcutData new_shortcut_data[] = {MakeShortcutData("typed-ab", 3)};
+  PopulateShortcutsBackendWithTestData(backend, new_shortcut_data,
+                                       std::size(new_shortcut_data));
+  VerifyMatches(start(u"typed-a"),
+                {"https://typed-ab.com/3", "https://typed-a.com/2"});
+
+  // Nor are the shortcuts which the previous input excluded.
+  VerifyMatches(start(u"typed"),
+                {"https://typed-ab.com/3", "https://typed-a.com/2",
+                 "https://typed-b.com/1"});
+}
+
 TEST_F(ShortcutsProviderTest, RemoveDuplicates) {
   std::u16string text(u"dupl");
   ExpectedURLs expected_urls;
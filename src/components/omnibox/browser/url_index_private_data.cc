@@ -13,15 +13,19 @@
 #include <numeric>
 #include <set>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
 #include "base/containers/flat_set.h"
 #include "base/containers/stack.h"
 #include "base/feature_list.h"
+#include "base/files/important_file_writer.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/i18n/case_conversion.h"
 #include "base/memory/raw_ptr.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/pickle.h"
 #include "base/ranges/algorithm.h"
 #include "base/stl_util.h"
 #include "base/strings/string_split.h"
@@ -41,9 +45,48 @@
 #include "components/omnibox/common/omnibox_features.h"
 #include "components/search_engines/template_url_service.h"
 #include "third_party/metrics_proto/omnibox_event.pb.h"
+#include "ui/base/page_transition_types.h"
 
 namespace {
 
+// Identifies snapshot files, followed by the version of their format, which
+// must be incremented whenever the format changes. Snapshots of other versions
+// are discarded.
+constexpr uint32_t kSnapshotMagic = 0x49505148;  // 'HQPI'
+constexpr int kSnapshotVersion = 1;
+
+void WriteTime(base::Pickle* pickle, base::Time time) {
+  pickle->WriteInt64(time.ToDeltaSinceWindowsEpoch().InMicroseconds());
+}
+
+bool ReadTime(base::PickleIterator* iterator, base::Time* time) {
+  int64_t microseconds;
+  if (!iterator->ReadInt64(&microseconds))
+    return false;
+  *time =
+      base::Time::FromDeltaSinceWindowsEpoch(base::Microseconds(microseconds));
+  return true;
+}
+
+void WriteWordStarts(base::Pickle* pickle, const WordStarts& word_starts) {
+  pickle->WriteUInt64(word_starts.size());
+  for (size_t word_start : word_starts)
+    pickle->WriteUInt64(word_start);
+}
+
+bool ReadWordStarts(base::PickleIterator* iterator, WordStarts* word_starts) {
+  uint64_t count;
+  if (!iterator->ReadUInt64(&count))
+    return false;
+  for (uint64_t i = 0; i < count; ++i) {
+    uint64_t word_start;
+    if (!iterator->ReadUInt64(&word_start))
+      return false;
+    word_starts->push_back(word_start);
+  }
+  return true;
+}
+
 GURL ClearUsernameAndPassword(const GURL& url) {
   GURL::Replacements r;
   r.ClearUsername();
@@ -407,6 +450,48 @@ scoped_refptr<URLIndexPrivateData> URLIndexPrivateData::RebuildFromHistory(
   return rebuilt_data;
 }
 
+// static
+scoped_refptr<URLIndexPrivateData> URLIndexPrivateData::RestoreFromFile(
+    const base::FilePath& path,
+    base::Time* index_time) {
+  base::MemoryMappedFile file;
+  if (!file.Initialize(path))
+    return nullptr;
+  // The snapshot is parsed in order.
+  file.Advise(base::MemoryMappedFile::Advice::kSequential);
+
+  base::Pickle pickle = base::Pickle::WithUnownedBuffer(file.bytes());
+  base::PickleIterator iterator(pickle);
+  uint32_t magic;
+  int version;
+  if (!iterator.ReadUInt32(&magic) || magic != kSnapshotMagic ||
+      !iterator.ReadInt(&version) || version != kSnapshotVersion ||
+      !ReadTime(&iterator, index_time)) {
+    return nullptr;
+  }
+
+  scoped_refptr<URLIndexPrivateData> restored_data(new URLIndexPrivateData);
+  if (!restored_data->ReadFromPickle(&iterator) || restored_data->Empty())
+    return nullptr;
+
+  UMA_HISTOGRAM_COUNTS_1M("History.InMemoryURLHistoryItems",
+                          restored_data->history_id_word_map_.size());
+  return restored_data;
+}
+
+bool URLIndexPrivateData::SaveToFile(const base::FilePath& path,
+                                     base::Time index_time) const {
+  base::Pickle pickle;
+  pickle.WriteUInt32(kSnapshotMagic);
+  pickle.WriteInt(kSnapshotVersion);
+  WriteTime(&pickle, index_time);
+  WriteToPickle(&pickle);
+  return base::ImportantFileWriter::WriteFileAtomically(
+      path,
+      std::string_view(static_cast<const char*>(pickle.data()), pickle.size()),
+      "HistoryQuickProviderSnapshot");
+}
+
 scoped_refptr<URLIndexPrivateData> URLIndexPrivateData::Duplicate() const {
   scoped_refptr<URLIndexPrivateData> data_copy = new URLIndexPrivateData;
   data_copy->word_list_ = word_list_;
@@ -596,9 +681,10 @@ HistoryIDSet URLIndexPrivateData::HistoryIDsForTerm(
   for (WordID word_id : word_id_set) {
     auto word_iter = word_id_history_map_.find(word_id);
     if (word_iter != word_id_history_map_.end()) {
-      HistoryIDSet& word_history_id_set(word_iter->second);
-      buffer.insert(buffer.end(), word_history_id_set.begin(),
-                    word_history_id_set.end());
+      const HistoryIDPostingList& word_history_ids(word_iter->second);
+      buffer.reserve(buffer.size() + word_history_ids.size());
+      buffer.insert(buffer.end(), word_history_ids.begin(),
+                    word_history_ids.end());
     }
   }
   HistoryIDSet history_id_set(buffer.begin(), buffer.end());
@@ -622,17 +708,20 @@ WordIDSet URLIndexPrivateData::WordIDSetForTermChars(
     if (char_iter == char_word_map_.end())
       return WordIDSet();
 
-    const WordIDSet& char_word_id_set(char_iter->second);
+    const WordIDPostingList& char_word_ids(char_iter->second);
     // It is possible for there to no longer be any words associated with
     // a particular character. Give up in that case.
-    if (char_word_id_set.empty())
+    if (char_word_ids.empty())
       return WordIDSet();
 
     if (c_iter == term_chars.begin()) {
-      word_id_set = char_word_id_set;
+      // The posting list is sorted, so there is nothing to sort here.
+      word_id_set = WordIDSet(base::sorted_unique, char_word_ids.begin(),
+                              char_word_ids.end());
     } else {
       // set-intersection
-      base::EraseIf(word_id_set, base::IsNotIn<WordIDSet>(char_word_id_set));
+      base::EraseIf(word_id_set,
+                    base::IsNotIn<WordIDPostingList>(char_word_ids));
     }
   }
   return word_id_set;
@@ -792,20 +881,168 @@ bool URLIndexPrivateData::IndexRow(
     ScheduleUpdateRecentVisits(history_service, row_id, tracker);
   }
 
+  AddRowToHostVisits(row);
+
+  return true;
+}
+
+void URLIndexPrivateData::AddRowToHostVisits(const history::URLRow& row) {
   // Increment `host_visits_` for and possibly add the host to
   // `highly_visited_hosts`.
   static const bool domain_suggestions_enabled =
       base::FeatureList::IsEnabled(omnibox::kDomainSuggestions);
   if (domain_suggestions_enabled) {
-    auto& host_info = host_visits_[gurl.host()];
+    const std::string& host = row.url().host();
+    auto& host_info = host_visits_[host];
     const bool was_highly_visited = host_info.IsHighlyVisited();
     host_info.AddUrl(row);
     // If the host was already added to `highly_visited_hosts_`, no need to
     // re-add it.
     if (!was_highly_visited && host_info.IsHighlyVisited())
-      highly_visited_hosts_.push_back(gurl.host());
+      highly_visited_hosts_.push_back(host);
   }
+}
 
+void URLIndexPrivateData::WriteToPickle(base::Pickle* pickle) const {
+  pickle->WriteUInt64(history_info_map_.size());
+  for (const auto& [history_id, info] : history_info_map_) {
+    const history::URLRow& row = info.url_row;
+    pickle->WriteInt64(history_id);
+    pickle->WriteString(row.url().spec());
+    pickle->WriteString16(row.title());
+    pickle->WriteInt(row.visit_count());
+    pickle->WriteInt(row.typed_count());
+    WriteTime(pickle, row.last_visit());
+    pickle->WriteUInt64(info.visits.size());
+    for (const auto& [visit_time, transition] : info.visits) {
+      WriteTime(pickle, visit_time);
+      pickle->WriteUInt32(transition);
+    }
+  }
+
+  // Unused words are written as empty strings, so that the IDs of the others
+  // don't change.
+  pickle->WriteUInt64(word_list_.size());
+  for (const std::u16string& word : word_list_)
+    pickle->WriteString16(word);
+
+  pickle->WriteUInt64(word_id_history_map_.size());
+  for (const auto& [word_id, history_ids] : word_id_history_map_) {
+    pickle->WriteUInt64(word_id);
+    pickle->WriteUInt64(history_ids.size());
+    for (HistoryID history_id : history_ids)
+      pickle->WriteInt64(history_id);
+  }
+
+  pickle->WriteUInt64(word_starts_map_.size());
+  for (const auto& [history_id, word_starts] : word_starts_map_) {
+    pickle->WriteInt64(history_id);
+    WriteWordStarts(pickle, word_starts.url_word_starts_);
+    WriteWordStarts(pickle, word_starts.title_word_starts_);
+  }
+}
+
+bool URLIndexPrivateData::ReadFromPickle(base::PickleIterator* iterator) {
+  uint64_t row_count;
+  if (!iterator->ReadUInt64(&row_count))
+    return false;
+  for (uint64_t i = 0; i < row_count; ++i) {
+    HistoryID history_id;
+    std::string url;
+    std::u16string title;
+    int visit_count;
+    int typed_count;
+    base::Time last_visit;
+    uint64_t visit_count_in_cache;
+    if (!iterator->ReadInt64(&history_id) || !iterator->ReadString(&url) ||
+        !iterator->ReadString16(&title) || !iterator->ReadInt(&visit_count) ||
+        !iterator->ReadInt(&typed_count) || !ReadTime(iterator, &last_visit) ||
+        !iterator->ReadUInt64(&visit_count_in_cache) ||
+        visit_count_in_cache > kMaxVisitsToStoreInCache) {
+      return false;
+    }
+    GURL gurl(url);
+    if (!gurl.is_valid())
+      return false;
+    HistoryInfoMapValue& info = history_info_map_[history_id];
+    info.url_row = history::URLRow(gurl, history_id);
+    info.url_row.set_title(title);
+    info.url_row.set_visit_count(visit_count);
+    info.url_row.set_typed_count(typed_count);
+    info.url_row.set_last_visit(last_visit);
+    for (uint64_t j = 0; j < visit_count_in_cache; ++j) {
+      base::Time visit_time;
+      uint32_t transition;
+      if (!ReadTime(iterator, &visit_time) ||
+          !iterator->ReadUInt32(&transition) ||
+          !ui::IsValidPageTransitionType(transition)) {
+        return false;
+      }
+      info.visits.emplace_back(visit_time,
+                               ui::PageTransitionFromInt(transition));
+    }
+    AddRowToHostVisits(info.url_row);
+  }
+
+  // The word map, the character map and the available word slots are derived
+  // from the word list.
+  uint64_t word_count;
+  if (!iterator->ReadUInt64(&word_count))
+    return false;
+  for (uint64_t word_id = 0; word_id < word_count; ++word_id) {
+    std::u16string word;
+    if (!iterator->ReadString16(&word))
+      return false;
+    if (word.empty()) {
+      available_words_.push(word_id);
+    } else {
+      if (!word_map_.emplace(word, word_id).second)
+        return false;
+      for (char16_t uni_char : Char16SetFromString16(word))
+        char_word_map_[uni_char].insert(word_id);
+    }
+    word_list_.push_back(std::move(word));
+  }
+
+  // The map from history items to words is the inverse of the one from words
+  // to history items. The words come in ascending order, so each is appended
+  // to the lists of its history items.
+  uint64_t posting_list_count;
+  if (!iterator->ReadUInt64(&posting_list_count))
+    return false;
+  for (uint64_t i = 0; i < posting_list_count; ++i) {
+    uint64_t word_id;
+    uint64_t history_id_count;
+    if (!iterator->ReadUInt64(&word_id) || word_id >= word_list_.size() ||
+        word_list_[word_id].empty() ||
+        !iterator->ReadUInt64(&history_id_count)) {
+      return false;
+    }
+    HistoryIDPostingList& history_ids = word_id_history_map_[word_id];
+    for (uint64_t j = 0; j < history_id_count; ++j) {
+      HistoryID history_id;
+      if (!iterator->ReadInt64(&history_id) ||
+          !history_info_map_.contains(history_id)) {
+        return false;
+      }
+      history_ids.insert(history_id);
+      history_id_word_map_[history_id].insert(word_id);
+    }
+  }
+
+  uint64_t word_starts_count;
+  if (!iterator->ReadUInt64(&word_starts_count))
+    return false;
+  for (uint64_t i = 0; i < word_starts_count; ++i) {
+    HistoryID history_id;
+    if (!iterator->ReadInt64(&history_id))
+      return false;
+    RowWordStarts& word_starts = word_starts_map_[history_id];
+    if (!ReadWordStarts(iterator, &word_starts.url_word_starts_) ||
+        !ReadWordStarts(iterator, &word_starts.title_word_starts_)) {
+      return false;
+    }
+  }
   return true;
 }
 
@@ -870,11 +1107,14 @@ void URLIndexPrivateData::RemoveRowWordsFromIndex(const history::URLRow& row) {
   // Remove the entries in history_id_word_map_ and word_id_history_map_ for
   // this row.
   HistoryID history_id = static_cast<HistoryID>(row.id());
-  WordIDSet word_id_set = history_id_word_map_[history_id];
-  history_id_word_map_.erase(history_id);
+  auto history_id_word_map_iter = history_id_word_map_.find(history_id);
+  if (history_id_word_map_iter == history_id_word_map_.end())
+    return;
+  WordIDPostingList word_ids = std::move(history_id_word_map_iter->second);
+  history_id_word_map_.erase(history_id_word_map_iter);
 
   // Reconcile any changes to word usage.
-  for (WordID word_id : word_id_set) {
+  for (WordID word_id : word_ids) {
     auto word_id_history_map_iter = word_id_history_map_.find(word_id);
     DCHECK(word_id_history_map_iter != word_id_history_map_.end());
 
@@ -25,6 +25,11 @@ class HistoryQuickProviderTest;
 class OmniboxTriggeredFeatureService;
 class TemplateURLService;
 
+namespace base {
+class Pickle;
+class PickleIterator;
+}  // namespace base
+
 namespace bookmarks {
 class CoreBookmarkModel;
 }
@@ -118,6 +123,21 @@ class URLIndexPrivateData
       history::HistoryDatabase* history_db,
       const std::set<std::string>& scheme_allowlist);
 
+  // Constructs a new object by restoring its contents from the snapshot file
+  // at `path`, written by SaveToFile(), and sets `index_time` to the time the
+  // snapshot was taken. Returns null if there is no snapshot, or if it is
+  // corrupt or of another version, in which case the index must be rebuilt
+  // from the history database. Blocks on disk IO.
+  static scoped_refptr<URLIndexPrivateData> RestoreFromFile(
+      const base::FilePath& path,
+      base::Time* index_time);
+
+  // Writes the index to a snapshot file at `path`, replacing any previous one,
+  // and returns true on success. `index_time` is the time up to which the
+  // index reflects the history database. Blocks on disk IO, so this is called
+  // on a duplicate of the index.
+  bool SaveToFile(const base::FilePath& path, base::Time index_time) const;
+
   // Creates a copy of ourself.
   scoped_refptr<URLIndexPrivateData> Duplicate() const;
 
@@ -148,6 +168,7 @@ class URLIndexPrivateData
 
   friend class ::HistoryQuickProviderTest;
   friend class InMemoryURLIndexTest;
+  friend class URLIndexPrivateDataPerfTest;
   FRIEND_TEST_ALL_PREFIXES(InMemoryURLIndexTest, CalculateWordStartsOffsets);
   FRIEND_TEST_ALL_PREFIXES(InMemoryURLIndexTest,
                            CalculateWordStartsOffsetsUnderscore);
@@ -291,6 +312,15 @@ class URLIndexPrivateData
   // available.
   WordID AddNewWordToWordList(const std::u16string& term);
 
+  // Adds the visits of |row| to |host_visits_|, if domain suggestions are
+  // enabled.
+  void AddRowToHostVisits(const history::URLRow& row);
+
+  // Snapshot support functions. Only the data which can't be derived from the
+  // rest of the index is written; ReadFromPickle() derives the rest.
+  void WriteToPickle(base::Pickle* pickle) const;
+  bool ReadFromPickle(base::PickleIterator* iterator);
+
   // Removes |row| and all associated words and characters from the index.
   void RemoveRowFromIndex(const history::URLRow& row);
 
@@ -0,0 +1,107 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/omnibox/browser/url_index_private_data.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "base/memory/scoped_refptr.h"
+#include "base/rand_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
+#include "base/trace_event/memory_usage_estimator.h"
+#include "components/history/core/browser/url_row.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+
+namespace {
+
+constexpr char kMetricPrefix[] = "URLIndexPrivateData.";
+constexpr char kMetricPostingListsMemory[] = "posting_lists_memory";
+constexpr char kMetricTotalMemory[] = "total_memory";
+constexpr char kMetricLookup[] = "lookup";
+
+constexpr size_t kUrlCount = 100000;
+// Words are drawn from a vocabulary skewed toward the first words, so that
+// some posting lists are long, and most are short.
+constexpr int kVocabularySize = 20000;
+constexpr size_t kWordsPerUrl = 8;
+
+std::string RandomWord() {
+  const int rank = base::RandInt(0, kVocabularySize - 1);
+  return "w" + base::NumberToString(rank * rank / kVocabularySize);
+}
+
+history::URLRow RandomURLRow(history::URLID id) {
+  std::string path;
+  std::string title;
+  for (size_t i = 0; i < kWordsPerUrl; ++i) {
+    path += "/" + RandomWord();
+    title += " " + RandomWord();
+  }
+  history::URLRow row(
+      GURL("https://site" + base::NumberToString(id % 1000) + ".com" + path),
+      id);
+  row.set_title(base::UTF8ToUTF16(title));
+  return row;
+}
+
+}  // namespace
+
+class URLIndexPrivateDataPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    data_ = base::MakeRefCounted<URLIndexPrivateData>();
+    for (size_t i = 1; i <= kUrlCount; ++i) {
+      data_->AddRowWordsToIndex(RandomURLRow(i), nullptr);
+    }
+  }
+
+  size_t PostingListsMemoryUsage() const {
+    return base::trace_event::EstimateMemoryUsage(data_->char_word_map_) +
+           base::trace_event::EstimateMemoryUsage(
+               data_->word_id_history_map_) +
+           base::trace_event::EstimateMemoryUsage(data_->history_id_word_map_);
+  }
+
+  HistoryIDVector HistoryIDsFromWords(const String16Vector& words) {
+    // Lookups must not be served from the cache of a previous one.
+    data_->search_term_cache_.clear();
+    return data_->HistoryIDsFromWords(words);
+  }
+
+  scoped_refptr<URLIndexPrivateData> data_;
+};
+
+TEST_F(URLIndexPrivateDataPerfTest, SyntheticHistory) {
+  perf_test::PerfResultReporter reporter(kMetricPrefix, "SyntheticHistory");
+  reporter.RegisterImportantMetric(kMetricPostingListsMemory, "bytes");
+  reporter.RegisterImportantMetric(kMetricTotalMemory, "bytes");
+  reporter.RegisterImportantMetric(kMetricLookup, "us");
+  reporter.AddResult(kMetricPostingListsMemory, PostingListsMemoryUsage());
+  reporter.AddResult(kMetricTotalMemory, data_->EstimateMemoryUsage());
+
+  // Prefixes of common words, which intersect long lists, and of rarer ones.
+  const std::vector<String16Vector> queries = {
+      {u"w1"}, {u"w1", u"site"}, {u"w12", u"w3"}, {u"w19", u"w2", u"https"},
+      {u"w1999"}};
+  constexpr int kIterations = 20;
+  base::ElapsedTimer timer;
+  size_t matches = 0;
+  for (int i = 0; i < kIterations; ++i) {
+    for (const String16Vector& query : queries) {
+      matches += HistoryIDsFromWords(query).size();
+    }
+  }
+  EXPECT_GT(matches, 0u);
+  reporter.AddResult(kMetricLookup,
+                     timer.Elapsed().InMicrosecondsF() /
+                         (kIterations * queries.size()));
+}
@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "base/feature_list.h"
+#include "base/location.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/ranges/algorithm.h"
 #include "base/trace_event/memory_usage_estimator.h"
@@ -53,6 +54,8 @@ ZeroSuggestCacheService::ZeroSuggestCacheService(
       StoreZeroSuggestResponse(page_url, *response_json_ptr);
     }
   }
+  // The loaded responses are already in prefs.
+  persist_timer_.Stop();
 }
 
 ZeroSuggestCacheService::~ZeroSuggestCacheService() {
@@ -60,19 +63,7 @@ ZeroSuggestCacheService::~ZeroSuggestCacheService() {
     return;
   }
 
-  // Dump cached ZPS response for NTP to prefs.
-  omnibox::SetUserPreferenceForZeroSuggestCachedResponse(
-      prefs_, /*page_url=*/"", /*response=*/ntp_entry_.response_json);
-
-  // Dump cached ZPS responses for SRP/Web to prefs.
-  base::Value::Dict prefs_dict;
-  for (const auto& item : cache_) {
-    const auto& page_url = item.first;
-    const auto& response_json = item.second.response_json;
-    prefs_dict.Set(page_url, response_json);
-  }
-  prefs_->SetDict(omnibox::kZeroSuggestCachedResultsWithURL,
-                  std::move(prefs_dict));
+  PersistToPrefs();
 }
 
 CacheEntry ZeroSuggestCacheService::ReadZeroSuggestResponse(
@@ -109,6 +100,14 @@ void ZeroSuggestCacheService::StoreZeroSuggestResponse(
         "Omnibox.ZeroSuggestProvider.CacheMemoryUsage",
         base::trace_event::EstimateMemoryUsage(cache_) +
             base::trace_event::EstimateMemoryUsage(ntp_entry_));
+
+    // Don't wait for shutdown to persist the response. Shutdown never comes if
+    // the browser is killed, e.g. in the background on mobile, which would
+    // leave the first focus of the next session with no cached response.
+    if (!persist_timer_.IsRunning()) {
+      persist_timer_.Start(FROM_HERE, kPersistToPrefsDelay, this,
+                           &ZeroSuggestCacheService::PersistToPrefs);
+    }
   } else {
     omnibox::SetUserPreferenceForZeroSuggestCachedResponse(prefs_, page_url,
                                                            response_json);
@@ -124,6 +123,7 @@ void ZeroSuggestCacheService::ClearCache() {
     // Clear current contents of in-memory cache.
     ntp_entry_.response_json.clear();
     cache_.Clear();
+    persist_timer_.Stop();
   }
 
   // Clear user prefs used for cross-session persistence.
@@ -136,6 +136,24 @@ bool ZeroSuggestCacheService::IsInMemoryCacheEmptyForTesting() const {
   return ntp_entry_.response_json.empty() && cache_.empty();
 }
 
+void ZeroSuggestCacheService::PersistToPrefs() {
+  persist_timer_.Stop();
+
+  // Dump cached ZPS response for NTP to prefs.
+  omnibox::SetUserPreferenceForZeroSuggestCachedResponse(
+      prefs_, /*page_url=*/"", /*response=*/ntp_entry_.response_json);
+
+  // Dump cached ZPS responses for SRP/Web to prefs.
+  base::Value::Dict prefs_dict;
+  for (const auto& item : cache_) {
+    const auto& page_url = item.first;
+    const auto& response_json = item.second.response_json;
+    prefs_dict.Set(page_url, response_json);
+  }
+  prefs_->SetDict(omnibox::kZeroSuggestCachedResultsWithURL,
+                  std::move(prefs_dict));
+}
+
 void ZeroSuggestCacheService::AddObserver(Observer* observer) {
   observers_.AddObserver(observer);
 }
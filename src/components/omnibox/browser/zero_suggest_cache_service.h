@@ -11,6 +11,8 @@
 #include "base/containers/lru_cache.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "build/build_config.h"
 #include "components/keyed_service/core/keyed_service.h"
 #include "components/omnibox/browser/search_suggestion_parser.h"
@@ -22,6 +24,10 @@ class AutocompleteSchemeClassifier;
 class ZeroSuggestCacheService : public ZeroSuggestCacheServiceInterface,
                                 public KeyedService {
  public:
+  // When using the in-memory cache, how long after a response is stored the
+  // cache is written to prefs, so that it survives the browser being killed.
+  static constexpr base::TimeDelta kPersistToPrefsDelay = base::Seconds(5);
+
   ZeroSuggestCacheService(
       std::unique_ptr<AutocompleteSchemeClassifier> scheme_classifier,
       PrefService* prefs,
@@ -51,6 +57,9 @@ class ZeroSuggestCacheService : public ZeroSuggestCacheServiceInterface,
   void RemoveObserver(Observer* observer) override;
 
  private:
+  // Writes the contents of the in-memory cache to prefs.
+  void PersistToPrefs();
+
   std::unique_ptr<AutocompleteSchemeClassifier> scheme_classifier_;
   // Pref service used for in-memory cache data persistence. Not owned.
   const raw_ptr<PrefService> prefs_;
@@ -62,6 +71,8 @@ class ZeroSuggestCacheService : public ZeroSuggestCacheServiceInterface,
   // Dedicated cache entry for "ZPS on NTP" data in order to minimize any
   // negative impact due to cache eviction policy.
   CacheEntry ntp_entry_;
+  // Batches writing stored responses to prefs.
+  base::OneShotTimer persist_timer_;
   base::ObserverList<Observer> observers_;
 };
 
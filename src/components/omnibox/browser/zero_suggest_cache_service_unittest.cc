@@ -10,6 +10,7 @@
 
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
+#include "base/test/task_environment.h"
 #include "base/values.h"
 #include "components/omnibox/browser/autocomplete_input.h"
 #include "components/omnibox/browser/fake_autocomplete_provider_client.h"
@@ -73,6 +74,10 @@ class ZeroSuggestCacheServiceTest : public testing::TestWithParam<bool> {
 
   PrefService* GetPrefs() { return prefs_.get(); }
 
+ protected:
+  base::test::SingleThreadTaskEnvironment task_environment_{
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME};
+
  private:
   std::unique_ptr<TestingPrefServiceSimple> prefs_;
   base::test::ScopedFeatureList scoped_feature_list_;
@@ -347,6 +352,36 @@ TEST_P(ZeroSuggestCacheServiceTest, CacheDumpsToPrefsOnShutdown) {
             web_entry.response);
 }
 
+TEST_P(ZeroSuggestCacheServiceTest, CacheDumpsToPrefsAfterStore) {
+  // Persistence logic only executes when using in-memory cache.
+  if (!GetParam()) {
+    return;
+  }
+
+  TestCacheEntry ntp_entry = {"", "foo"};
+  TestCacheEntry web_entry = {"https://www.example.com", "eggs"};
+
+  PrefService* prefs = GetPrefs();
+  ZeroSuggestCacheService cache_svc(std::make_unique<TestSchemeClassifier>(),
+                                    prefs, 3);
+  cache_svc.StoreZeroSuggestResponse(ntp_entry.url, ntp_entry.response);
+  cache_svc.StoreZeroSuggestResponse(web_entry.url, web_entry.response);
+
+  // Writes are batched.
+  EXPECT_EQ(omnibox::GetUserPreferenceForZeroSuggestCachedResponse(
+                prefs, web_entry.url),
+            "");
+
+  task_environment_.FastForwardBy(
+      ZeroSuggestCacheService::kPersistToPrefsDelay);
+  EXPECT_EQ(omnibox::GetUserPreferenceForZeroSuggestCachedResponse(
+                prefs, ntp_entry.url),
+            ntp_entry.response);
+  EXPECT_EQ(omnibox::GetUserPreferenceForZeroSuggestCachedResponse(
+                prefs, web_entry.url),
+            web_entry.response);
+}
+
 TEST_P(ZeroSuggestCacheServiceTest, ClearCacheResultsInEmptyPersistencePrefs) {
   PrefService* prefs = GetPrefs();
 
@@ -0,0 +1,97 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/optimization_guide/core/blocked_bloom_filter.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/check_op.h"
+#include "base/numerics/checked_math.h"
+#include "third_party/smhasher/src/MurmurHash3.h"
+
+namespace optimization_guide {
+
+namespace {
+
+// The size of a block in bytes, which is also its alignment.
+constexpr size_t kBlockSize = BlockedBloomFilter::kBitsPerBlock / 8;
+
+}  // namespace
+
+BlockedBloomFilter::BlockedBloomFilter(uint32_t num_hash_functions,
+                                       uint32_t num_bits)
+    : num_hash_functions_(num_hash_functions),
+      num_blocks_(std::max(
+          base::CheckAdd(num_bits, kBitsPerBlock - 1).ValueOrDie() /
+              kBitsPerBlock,
+          1u)),
+      words_(static_cast<uint64_t*>(
+          base::AlignedAlloc(num_blocks_ * kBlockSize, kBlockSize))) {
+  CHECK_GT(num_hash_functions_, 0u);
+  CHECK_LE(num_hash_functions_, kBitsPerBlock);
+  memset(words_.get(), 0, num_blocks_ * kBlockSize);
+}
+
+BlockedBloomFilter::~BlockedBloomFilter() = default;
+
+// static
+std::unique_ptr<BlockedBloomFilter> BlockedBloomFilter::CreateWithEntries(
+    const std::vector<std::string_view>& strs,
+    uint32_t bits_per_entry,
+    uint32_t num_hash_functions) {
+  auto filter = std::make_unique<BlockedBloomFilter>(
+      num_hash_functions,
+      base::CheckMul(strs.size(), bits_per_entry).ValueOrDie<uint32_t>());
+  for (std::string_view str : strs) {
+    filter->Add(str);
+  }
+  return filter;
+}
+
+bool BlockedBloomFilter::Contains(std::string_view str) const {
+  const Probe probe = ComputeProbe(str);
+  const uint64_t* block = words_.get() + probe.block * kWordsPerBlock;
+  // Test all the words without branching, which lets the compiler vectorize
+  // the loop.
+  uint64_t missing_bits = 0;
+  for (size_t i = 0; i < kWordsPerBlock; ++i) {
+    missing_bits |= probe.masks[i] & ~block[i];
+  }
+  return missing_bits == 0;
+}
+
+void BlockedBloomFilter::Add(std::string_view str) {
+  const Probe probe = ComputeProbe(str);
+  uint64_t* block = words_.get() + probe.block * kWordsPerBlock;
+  for (size_t i = 0; i < kWordsPerBlock; ++i) {
+    block[i] |= probe.masks[i];
+  }
+}
+
+BlockedBloomFilter::Probe BlockedBloomFilter::ComputeProbe(
+    std::string_view str) const {
+  uint64_t hash[2];
+  MurmurHash3_x64_128(str.data(), static_cast<int>(str.size()), /*seed=*/0,
+                      &hash);
+
+  Probe probe = {};
+  // Maps the high bits of the first half to a block without a division.
+  probe.block = static_cast<uint32_t>(
+      ((hash[0] >> 32) * static_cast<uint64_t>(num_blocks_)) >> 32);
+
+  // Double hashing over the bits of the block. An odd step goes through all
+  // the bits of the block before repeating one.
+  uint32_t bit = static_cast<uint32_t>(hash[1]);
+  const uint32_t step = static_cast<uint32_t>(hash[1] >> 32) | 1;
+  for (uint32_t i = 0; i < num_hash_functions_; ++i) {
+    const uint32_t bit_in_block = bit % kBitsPerBlock;
+    probe.masks[bit_in_block / 64] |= uint64_t{1} << (bit_in_block % 64);
+    bit += step;
+  }
+  return probe;
+}
+
+}  // namespace optimization_guide
@@ -0,0 +1,83 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_OPTIMIZATION_GUIDE_CORE_BLOCKED_BLOOM_FILTER_H_
+#define COMPONENTS_OPTIMIZATION_GUIDE_CORE_BLOCKED_BLOOM_FILTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "base/memory/aligned_memory.h"
+
+namespace optimization_guide {
+
+// BlockedBloomFilter is a Bloom filter whose bits for a string all fall in a
+// single cache line, so that a lookup touches one cache line instead of one
+// per hash function. The bits are derived by double hashing from a single
+// MurmurHash3 pass, and a lookup tests all the words of the block at once,
+// without a branch per bit.
+//
+// It is not compatible with the filters sent by the server in the
+// OptimizationGuide hints.proto, whose bits are spread over the whole filter by
+// independent hashes and can only be looked up by BloomFilter. Use it for sets
+// whose strings are available on the client.
+class BlockedBloomFilter {
+ public:
+  // The number of bits in a block, i.e. in a cache line.
+  static constexpr uint32_t kBitsPerBlock = 512;
+
+  // Constructs a filter of at least |num_bits| bits, zero-ed, that sets
+  // |num_hash_functions| bits per entry.
+  BlockedBloomFilter(uint32_t num_hash_functions, uint32_t num_bits);
+
+  BlockedBloomFilter(const BlockedBloomFilter&) = delete;
+  BlockedBloomFilter& operator=(const BlockedBloomFilter&) = delete;
+
+  ~BlockedBloomFilter();
+
+  // Returns a filter containing |strs|, sized for |bits_per_entry| bits per
+  // string. 10 bits per entry with 7 hash functions gives a false positive
+  // rate close to 1%.
+  static std::unique_ptr<BlockedBloomFilter> CreateWithEntries(
+      const std::vector<std::string_view>& strs,
+      uint32_t bits_per_entry,
+      uint32_t num_hash_functions);
+
+  // Returns whether this Bloom filter contains |str|.
+  bool Contains(std::string_view str) const;
+
+  // Adds |str| to this Bloom filter.
+  void Add(std::string_view str);
+
+  // Returns the number of bits in the filter.
+  size_t num_bits() const { return num_blocks_ * kBitsPerBlock; }
+
+ private:
+  static constexpr size_t kWordsPerBlock = kBitsPerBlock / 64;
+
+  // The block of |str| and the bits to set or test in each word of the block.
+  struct Probe {
+    uint32_t block;
+    uint64_t masks[kWordsPerBlock];
+  };
+
+  Probe ComputeProbe(std::string_view str) const;
+
+  // Number of bits to set for each added string.
+  const uint32_t num_hash_functions_;
+
+  // Number of cache line sized blocks in the filter.
+  const uint32_t num_blocks_;
+
+  // The words of the filter, aligned on cache lines.
+  std::unique_ptr<uint64_t, base::AlignedFreeDeleter> words_;
+};
+
+}  // namespace optimization_guide
+
+#endif  // COMPONENTS_OPTIMIZATION_GUIDE_CORE_BLOCKED_BLOOM_FILTER_H_
@@ -0,0 +1,102 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/timer/elapsed_timer.h"
+#include "components/optimization_guide/core/blocked_bloom_filter.h"
+#include "components/optimization_guide/core/bloom_filter.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+// This file compares lookups in BloomFilter, the format of the filters sent by
+// the server, with BlockedBloomFilter, for filters larger than the CPU caches.
+
+namespace optimization_guide {
+
+namespace {
+
+constexpr char kMetricPrefixBloomFilter[] = "BloomFilter.";
+constexpr char kMetricLookupTime[] = "lookup_time";
+
+constexpr uint32_t kBitsPerEntry = 10;
+constexpr uint32_t kNumHashFunctions = 7;
+constexpr int kNumLookups = 100000;
+
+// Debug builds can be quite slow. Use fewer entries to test.
+#if defined(NDEBUG)
+constexpr int kNumEntries = 1000000;
+#else
+constexpr int kNumEntries = 50000;
+#endif
+
+perf_test::PerfResultReporter SetUpReporter(const std::string& story_name) {
+  perf_test::PerfResultReporter reporter(kMetricPrefixBloomFilter,
+                                         story_name);
+  reporter.RegisterImportantMetric(kMetricLookupTime, "ns");
+  return reporter;
+}
+
+std::string GetHost(int index) {
+  return "host" + base::NumberToString(index) + ".example.org";
+}
+
+class BloomFilterPerfTest : public testing::Test {
+ public:
+  void SetUp() override {
+    for (int i = 0; i < kNumEntries; ++i) {
+      entries_.push_back(GetHost(i));
+    }
+    // Half of the lookups are for entries of the filter, like hosts that have
+    // the optimization.
+    for (int i = 0; i < kNumLookups; ++i) {
+      lookups_.push_back(
+          GetHost(i % 2 ? i % kNumEntries : kNumEntries + i));
+    }
+  }
+
+  template <typename Filter>
+  void ReportLookupTime(const Filter& filter, const std::string& story_name) {
+    int found = 0;
+    base::ElapsedTimer timer;
+    for (const std::string& lookup : lookups_) {
+      if (filter.Contains(lookup)) {
+        ++found;
+      }
+    }
+    const base::TimeDelta elapsed = timer.Elapsed();
+    EXPECT_GE(found, kNumLookups / 2);
+    SetUpReporter(story_name)
+        .AddResult(kMetricLookupTime,
+                   elapsed.InNanosecondsF() / static_cast<double>(kNumLookups));
+  }
+
+ protected:
+  std::vector<std::string> entries_;
+  std::vector<std::string> lookups_;
+};
+
+}  // namespace
+
+TEST_F(BloomFilterPerfTest, Lookup) {
+  BloomFilter bloom_filter(kNumHashFunctions, kNumEntries * kBitsPerEntry);
+  for (const std::string& entry : entries_) {
+    bloom_filter.Add(entry);
+  }
+  ReportLookupTime(bloom_filter, "BloomFilter");
+
+  std::unique_ptr<BlockedBloomFilter> blocked_bloom_filter =
+      BlockedBloomFilter::CreateWithEntries(
+          std::vector<std::string_view>(entries_.begin(), entries_.end()),
+          kBitsPerEntry, kNumHashFunctions);
+  ReportLookupTime(*blocked_bloom_filter, "BlockedBloomFilter");
+}
+
+}  // namespace optimization_guide
@@ -0,0 +1,367 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/optimization_guide/core/component_hint_index.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/contains.h"
+#include "base/containers/span.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/memory/ptr_util.h"
+#include "base/numerics/byte_conversions.h"
+#include "base/numerics/checked_math.h"
+
+namespace optimization_guide {
+
+namespace {
+
+// The file starts with a header of kHeaderFieldCount uint32_t, followed by
+// |bucket_count| uint32_t seeds, |slot_count| slots of kSlotFieldCount
+// uint32_t and the data section. The data section starts with the component
+// version, and then has the host and the serialized hint of each slot, which
+// refer to them by their offset in the data section.
+constexpr uint32_t kMagic = 0x4f474849;  // "OGHI"
+constexpr uint32_t kFormatVersion = 1;
+
+enum HeaderField {
+  kMagicField,
+  kFormatVersionField,
+  kHostCountField,
+  kBucketCountField,
+  kSlotCountField,
+  kVersionLengthField,
+  kDataSizeField,
+  kHeaderFieldCount,
+};
+
+enum SlotField {
+  kHostOffsetField,
+  kHostLengthField,
+  kHintOffsetField,
+  kHintLengthField,
+  kSlotFieldCount,
+};
+
+// The average number of hosts per bucket, and the number of slots per host, of
+// the perfect hash. Lower values make the index smaller, but make it slower to
+// find the seed of each bucket when writing it.
+constexpr uint32_t kHostsPerBucket = 4;
+constexpr double kSlotsPerHost = 1.25;
+
+// The maximum number of seeds tried for a bucket, after which writing the
+// index fails.
+constexpr uint32_t kMaxSeed = 1 << 16;
+
+// Hashes |host| with |seed|. This must be stable across sessions, since the
+// index is persisted.
+uint64_t HashHost(std::string_view host, uint32_t seed) {
+  // FNV-1a, followed by the MurmurHash3 finalizer to mix the high bits that
+  // are used to pick the bucket and slot.
+  uint64_t hash = 0xcbf29ce484222325ull ^ (seed * 0x9e3779b97f4a7c15ull);
+  for (char c : host) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3ull;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb3fe1a85ec53ull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+uint32_t GetBucket(std::string_view host, uint32_t bucket_count) {
+  return HashHost(host, /*seed=*/0) % bucket_count;
+}
+
+uint32_t GetSlot(std::string_view host, uint32_t seed, uint32_t slot_count) {
+  return HashHost(host, seed) % slot_count;
+}
+
+void AppendUint32(uint32_t value, std::string* out) {
+  const std::array<uint8_t, 4u> bytes = base::U32ToNativeEndian(value);
+  out->append(bytes.begin(), bytes.end());
+}
+
+// Returns whether |hint| is one that HintCache caches by host.
+bool IsIndexedHint(const proto::Hint& hint) {
+  return !hint.key().empty() && hint.key_representation() == proto::HOST &&
+         (!hint.page_hints().empty() ||
+          !hint.allowlisted_optimizations().empty());
+}
+
+// Assigns a seed to each bucket so that the hosts of all buckets go to
+// different slots. Returns the seeds and the host of each slot, or
+// std::nullopt if no seed was found for a bucket.
+std::optional<std::pair<std::vector<uint32_t>, std::vector<size_t>>>
+BuildPerfectHash(const std::vector<std::string_view>& hosts,
+                 uint32_t bucket_count,
+                 uint32_t slot_count) {
+  constexpr size_t kEmptySlot = std::numeric_limits<size_t>::max();
+
+  std::vector<std::vector<size_t>> buckets(bucket_count);
+  for (size_t i = 0; i < hosts.size(); ++i) {
+    buckets[GetBucket(hosts[i], bucket_count)].push_back(i);
+  }
+
+  // Place the largest buckets first, while most slots are free.
+  std::vector<uint32_t> bucket_order(bucket_count);
+  for (uint32_t i = 0; i < bucket_count; ++i) {
+    bucket_order[i] = i;
+  }
+  std::stable_sort(bucket_order.begin(), bucket_order.end(),
+                   [&buckets](uint32_t a, uint32_t b) {
+                     return buckets[a].size() > buckets[b].size();
+                   });
+
+  std::vector<uint32_t> seeds(bucket_count, 0);
+  std::vector<size_t> slot_hosts(slot_count, kEmptySlot);
+  std::vector<uint32_t> bucket_slots;
+  for (uint32_t bucket : bucket_order) {
+    if (buckets[bucket].empty()) {
+      break;
+    }
+    bool placed = false;
+    for (uint32_t seed = 1; seed < kMaxSeed && !placed; ++seed) {
+      bucket_slots.clear();
+      placed = true;
+      for (size_t host : buckets[bucket]) {
+        const uint32_t slot = GetSlot(hosts[host], seed, slot_count);
+        if (slot_hosts[slot] != kEmptySlot ||
+            base::Contains(bucket_slots, slot)) {
+          placed = false;
+          break;
+        }
+        bucket_slots.push_back(slot);
+      }
+      if (placed) {
+        seeds[bucket] = seed;
+        for (size_t i = 0; i < bucket_slots.size(); ++i) {
+          slot_hosts[bucket_slots[i]] = buckets[bucket][i];
+        }
+      }
+    }
+    if (!placed) {
+      return std::nullopt;
+    }
+  }
+  return std::make_pair(std::move(seeds), std::move(slot_hosts));
+}
+
+}  // namespace
+
+ComponentHintIndex::ComponentHintIndex(
+    std::unique_ptr<base::MemoryMappedFile> file,
+    base::Version version,
+    uint32_t host_count,
+    uint32_t bucket_count,
+    uint32_t slot_count)
+    : file_(std::move(file)),
+      version_(std::move(version)),
+      host_count_(host_count),
+      bucket_count_(bucket_count),
+      slot_count_(slot_count) {}
+
+ComponentHintIndex::~ComponentHintIndex() = default;
+
+// static
+bool ComponentHintIndex::Write(
+    const base::FilePath& path,
+    const base::Version& version,
+    const google::protobuf::RepeatedPtrField<proto::Hint>& hints) {
+  if (!version.IsValid()) {
+    return false;
+  }
+
+  // Like the store, keep the last hint of a host that has several.
+  std::map<std::string_view, const proto::Hint*> hints_by_host;
+  for (const proto::Hint& hint : hints) {
+    if (IsIndexedHint(hint)) {
+      hints_by_host[hint.key()] = &hint;
+    }
+  }
+
+  std::vector<std::string_view> hosts;
+  hosts.reserve(hints_by_host.size());
+  for (const auto& [host, hint] : hints_by_host) {
+    hosts.push_back(host);
+  }
+
+  base::CheckedNumeric<uint32_t> checked_host_count = hosts.size();
+  const uint32_t host_count = checked_host_count.ValueOrDefault(0);
+  if (!checked_host_count.IsValid()) {
+    return false;
+  }
+  const uint32_t bucket_count = std::max(host_count / kHostsPerBucket, 1u);
+  const uint32_t slot_count =
+      std::max(static_cast<uint32_t>(host_count * kSlotsPerHost), 1u);
+  auto perfect_hash = BuildPerfectHash(hosts, bucket_count, slot_count);
+  if (!perfect_hash) {
+    return false;
+  }
+  const auto& [seeds, slot_hosts] = *perfect_hash;
+
+  const std::string version_string = version.GetString();
+  std::string data = version_string;
+  std::vector<uint32_t> slots(slot_count * kSlotFieldCount, 0);
+  for (uint32_t slot = 0; slot < slot_count; ++slot) {
+    if (slot_hosts[slot] >= hosts.size()) {
+      continue;
+    }
+    const std::string_view host = hosts[slot_hosts[slot]];
+    const std::string hint = hints_by_host[host]->SerializeAsString();
+    const size_t host_offset = data.size();
+    data.append(host);
+    const size_t hint_offset = data.size();
+    data.append(hint);
+    if (!base::IsValueInRangeForNumericType<uint32_t>(data.size())) {
+      return false;
+    }
+    uint32_t* slot_fields = &slots[slot * kSlotFieldCount];
+    slot_fields[kHostOffsetField] = static_cast<uint32_t>(host_offset);
+    slot_fields[kHostLengthField] = static_cast<uint32_t>(host.size());
+    slot_fields[kHintOffsetField] = static_cast<uint32_t>(hint_offset);
+    slot_fields[kHintLengthField] = static_cast<uint32_t>(hint.size());
+  }
+
+  std::string contents;
+  contents.reserve((kHeaderFieldCount + seeds.size() + slots.size()) *
+                       sizeof(uint32_t) +
+                   data.size());
+  AppendUint32(kMagic, &contents);
+  AppendUint32(kFormatVersion, &contents);
+  AppendUint32(host_count, &contents);
+  AppendUint32(bucket_count, &contents);
+  AppendUint32(slot_count, &contents);
+  AppendUint32(static_cast<uint32_t>(version_string.size()), &contents);
+  AppendUint32(static_cast<uint32_t>(data.size()), &contents);
+  for (uint32_t seed : seeds) {
+    AppendUint32(seed, &contents);
+  }
+  for (uint32_t slot_field : slots) {
+    AppendUint32(slot_field, &contents);
+  }
+  contents.append(data);
+  return base::CreateDirectory(path.DirName()) &&
+         base::ImportantFileWriter::WriteFileAtomically(path, contents);
+}
+
+// static
+std::unique_ptr<ComponentHintIndex> ComponentHintIndex::Load(
+    const base::FilePath& path) {
+  auto file = std::make_unique<base::MemoryMappedFile>();
+  if (!file->Initialize(path)) {
+    return nullptr;
+  }
+
+  const base::span<const uint8_t> bytes = file->bytes();
+  if (bytes.size() < kHeaderFieldCount * sizeof(uint32_t)) {
+    return nullptr;
+  }
+  auto read_header_field = [&bytes](HeaderField field) {
+    return base::U32FromNativeEndian(
+        bytes.subspan(field * sizeof(uint32_t)).first<4u>());
+  };
+  if (read_header_field(kMagicField) != kMagic ||
+      read_header_field(kFormatVersionField) != kFormatVersion) {
+    return nullptr;
+  }
+  const uint32_t host_count = read_header_field(kHostCountField);
+  const uint32_t bucket_count = read_header_field(kBucketCountField);
+  const uint32_t slot_count = read_header_field(kSlotCountField);
+  const uint32_t version_length = read_header_field(kVersionLengthField);
+  const uint32_t data_size = read_header_field(kDataSizeField);
+  if (bucket_count == 0 || slot_count < host_count ||
+      version_length > data_size) {
+    return nullptr;
+  }
+
+  base::CheckedNumeric<size_t> expected_size = slot_count;
+  expected_size *= kSlotFieldCount;
+  expected_size += kHeaderFieldCount;
+  expected_size += bucket_count;
+  expected_size *= sizeof(uint32_t);
+  expected_size += data_size;
+  if (!expected_size.IsValid() || expected_size.ValueOrDie() != bytes.size()) {
+    return nullptr;
+  }
+
+  const base::span<const uint8_t> version_bytes =
+      bytes.last(data_size).first(version_length);
+  base::Version version(std::string(base::as_string_view(version_bytes)));
+  if (!version.IsValid()) {
+    return nullptr;
+  }
+
+  return base::WrapUnique(new ComponentHintIndex(
+      std::move(file), std::move(version), host_count, bucket_count,
+      slot_count));
+}
+
+std::optional<std::string_view> ComponentHintIndex::FindSerializedHint(
+    std::string_view host) const {
+  if (host.empty() || host_count_ == 0) {
+    return std::nullopt;
+  }
+
+  const uint32_t bucket = GetBucket(host, bucket_count_);
+  const uint32_t seed = ReadUint32(kHeaderFieldCount + bucket);
+  const uint32_t slot = GetSlot(host, seed, slot_count_);
+  const size_t slot_index =
+      kHeaderFieldCount + bucket_count_ + slot * kSlotFieldCount;
+
+  // A perfect hash maps every host of the index to its own slot, but maps other
+  // hosts to any slot, so the host of the slot has to be compared.
+  const std::optional<std::string_view> slot_host =
+      GetData(ReadUint32(slot_index + kHostOffsetField),
+              ReadUint32(slot_index + kHostLengthField));
+  if (!slot_host || slot_host->empty() || *slot_host != host) {
+    return std::nullopt;
+  }
+  return GetData(ReadUint32(slot_index + kHintOffsetField),
+                 ReadUint32(slot_index + kHintLengthField));
+}
+
+std::unique_ptr<proto::Hint> ComponentHintIndex::FindHint(
+    std::string_view host) const {
+  const std::optional<std::string_view> serialized_hint =
+      FindSerializedHint(host);
+  if (!serialized_hint) {
+    return nullptr;
+  }
+  auto hint = std::make_unique<proto::Hint>();
+  if (!hint->ParseFromArray(serialized_hint->data(),
+                            static_cast<int>(serialized_hint->size()))) {
+    return nullptr;
+  }
+  return hint;
+}
+
+std::optional<std::string_view> ComponentHintIndex::GetData(
+    uint32_t offset,
+    uint32_t length) const {
+  const base::span<const uint8_t> data = file_->bytes().subspan(
+      (kHeaderFieldCount + bucket_count_ + slot_count_ * kSlotFieldCount) *
+      sizeof(uint32_t));
+  if (offset > data.size() || length > data.size() - offset) {
+    return std::nullopt;
+  }
+  return base::as_string_view(data.subspan(offset, length));
+}
+
+uint32_t ComponentHintIndex::ReadUint32(size_t index) const {
+  return base::U32FromNativeEndian(
+      file_->bytes().subspan(index * sizeof(uint32_t)).first<4u>());
+}
+
+}  // namespace optimization_guide
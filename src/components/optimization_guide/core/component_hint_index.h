@@ -0,0 +1,91 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_OPTIMIZATION_GUIDE_CORE_COMPONENT_HINT_INDEX_H_
+#define COMPONENTS_OPTIMIZATION_GUIDE_CORE_COMPONENT_HINT_INDEX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "base/files/memory_mapped_file.h"
+#include "base/version.h"
+#include "components/optimization_guide/proto/hints.pb.h"
+
+namespace base {
+class FilePath;
+}  // namespace base
+
+namespace optimization_guide {
+
+// A read-only index of the host-keyed hints of an Optimization Hints
+// component, stored in a file that is memory-mapped when it is loaded. Looking
+// up a host hashes it with a minimal perfect hash built when the index is
+// written, so it doesn't touch the disk beyond the mapped pages and doesn't
+// allocate.
+//
+// The file is only meant to be read on the device that wrote it, so it uses
+// the native byte order.
+class ComponentHintIndex {
+ public:
+  ComponentHintIndex(const ComponentHintIndex&) = delete;
+  ComponentHintIndex& operator=(const ComponentHintIndex&) = delete;
+
+  ~ComponentHintIndex();
+
+  // Writes an index of the host-keyed hints in |hints| for the component
+  // |version| to |path|, replacing any existing file. Hints that would not be
+  // cached by HintCache are skipped. Returns whether the index was written.
+  // Does blocking file I/O.
+  static bool Write(
+      const base::FilePath& path,
+      const base::Version& version,
+      const google::protobuf::RepeatedPtrField<proto::Hint>& hints);
+
+  // Maps the index at |path|. Returns nullptr if the file does not exist or is
+  // not a valid index. Does blocking file I/O.
+  static std::unique_ptr<ComponentHintIndex> Load(const base::FilePath& path);
+
+  // Returns the version of the component that the index was written for.
+  const base::Version& version() const { return version_; }
+
+  // Returns the number of hosts in the index.
+  size_t size() const { return host_count_; }
+
+  // Returns the serialized proto::Hint for |host|, if the index has one. The
+  // returned bytes are valid as long as |this| is.
+  std::optional<std::string_view> FindSerializedHint(
+      std::string_view host) const;
+
+  // Returns the parsed hint for |host|, or nullptr if the index has none.
+  std::unique_ptr<proto::Hint> FindHint(std::string_view host) const;
+
+ private:
+  ComponentHintIndex(std::unique_ptr<base::MemoryMappedFile> file,
+                     base::Version version,
+                     uint32_t host_count,
+                     uint32_t bucket_count,
+                     uint32_t slot_count);
+
+  // Returns the bytes at [offset, offset + length) of the data section of the
+  // file, if they are in range.
+  std::optional<std::string_view> GetData(uint32_t offset,
+                                          uint32_t length) const;
+
+  // Returns the |index|-th uint32_t of the file, which must be in range.
+  uint32_t ReadUint32(size_t index) const;
+
+  const std::unique_ptr<base::MemoryMappedFile> file_;
+  const base::Version version_;
+  const uint32_t host_count_;
+  const uint32_t bucket_count_;
+  const uint32_t slot_count_;
+};
+
+}  // namespace optimization_guide
+
+#endif  // COMPONENTS_OPTIMIZATION_GUIDE_CORE_COMPONENT_HINT_INDEX_H_
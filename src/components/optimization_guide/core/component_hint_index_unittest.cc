@@ -0,0 +1,122 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/optimization_guide/core/component_hint_index.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/version.h"
+#include "components/optimization_guide/proto/hints.pb.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace optimization_guide {
+namespace {
+
+std::string GetHost(int index) {
+  return "host" + base::NumberToString(index) + ".example.org";
+}
+
+void AddHint(const std::string& key,
+             proto::KeyRepresentation key_representation,
+             const std::string& page_pattern,
+             google::protobuf::RepeatedPtrField<proto::Hint>* hints) {
+  proto::Hint* hint = hints->Add();
+  hint->set_key(key);
+  hint->set_key_representation(key_representation);
+  hint->add_page_hints()->set_page_pattern(page_pattern);
+}
+
+class ComponentHintIndexTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("index");
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+}  // namespace
+
+TEST_F(ComponentHintIndexTest, FindHints) {
+  constexpr int kHostCount = 1000;
+  google::protobuf::RepeatedPtrField<proto::Hint> hints;
+  for (int i = 0; i < kHostCount; ++i) {
+    AddHint(GetHost(i), proto::HOST, "page" + base::NumberToString(i), &hints);
+  }
+  ASSERT_TRUE(ComponentHintIndex::Write(path_, base::Version("1.2.3"), hints));
+
+  std::unique_ptr<ComponentHintIndex> index = ComponentHintIndex::Load(path_);
+  ASSERT_TRUE(index);
+  EXPECT_EQ(base::Version("1.2.3"), index->version());
+  EXPECT_EQ(static_cast<size_t>(kHostCount), index->size());
+  for (int i = 0; i < kHostCount; ++i) {
+    std::unique_ptr<proto::Hint> hint = index->FindHint(GetHost(i));
+    ASSERT_TRUE(hint) << GetHost(i);
+    EXPECT_EQ(GetHost(i), hint->key());
+    ASSERT_EQ(1, hint->page_hints_size());
+    EXPECT_EQ("page" + base::NumberToString(i),
+              hint->page_hints(0).page_pattern());
+  }
+  EXPECT_FALSE(index->FindHint(GetHost(kHostCount)));
+  EXPECT_FALSE(index->FindHint("example.org"));
+  EXPECT_FALSE(index->FindHint(""));
+}
+
+TEST_F(ComponentHintIndexTest, SkipsHintsNotCachedByHost) {
+  google::protobuf::RepeatedPtrField<proto::Hint> hints;
+  AddHint("host.example.org", proto::HOST, "first", &hints);
+  AddHint("https://url.example.org/", proto::FULL_URL, "url", &hints);
+  AddHint("suffix.example.org", proto::HOST_SUFFIX, "suffix", &hints);
+  hints.Add()->set_key("empty.example.org");
+  // The last hint of a host wins, like in the store.
+  AddHint("host.example.org", proto::HOST, "second", &hints);
+  ASSERT_TRUE(ComponentHintIndex::Write(path_, base::Version("1.0"), hints));
+
+  std::unique_ptr<ComponentHintIndex> index = ComponentHintIndex::Load(path_);
+  ASSERT_TRUE(index);
+  EXPECT_EQ(1u, index->size());
+  std::unique_ptr<proto::Hint> hint = index->FindHint("host.example.org");
+  ASSERT_TRUE(hint);
+  EXPECT_EQ("second", hint->page_hints(0).page_pattern());
+  EXPECT_FALSE(index->FindHint("https://url.example.org/"));
+  EXPECT_FALSE(index->FindHint("suffix.example.org"));
+  EXPECT_FALSE(index->FindHint("empty.example.org"));
+}
+
+TEST_F(ComponentHintIndexTest, Empty) {
+  ASSERT_TRUE(ComponentHintIndex::Write(
+      path_, base::Version("1.0"),
+      google::protobuf::RepeatedPtrField<proto::Hint>()));
+
+  std::unique_ptr<ComponentHintIndex> index = ComponentHintIndex::Load(path_);
+  ASSERT_TRUE(index);
+  EXPECT_EQ(0u, index->size());
+  EXPECT_FALSE(index->FindHint("host.example.org"));
+}
+
+TEST_F(ComponentHintIndexTest, InvalidFile) {
+  EXPECT_FALSE(ComponentHintIndex::Load(path_));
+
+  ASSERT_TRUE(base::WriteFile(path_, "not an index"));
+  EXPECT_FALSE(ComponentHintIndex::Load(path_));
+
+  // A truncated index is rejected.
+  google::protobuf::RepeatedPtrField<proto::Hint> hints;
+  AddHint("host.example.org", proto::HOST, "page", &hints);
+  ASSERT_TRUE(ComponentHintIndex::Write(path_, base::Version("1.0"), hints));
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(path_, &contents));
+  contents.pop_back();
+  ASSERT_TRUE(base::WriteFile(path_, contents));
+  EXPECT_FALSE(ComponentHintIndex::Load(path_));
+}
+
+}  // namespace optimization_guide
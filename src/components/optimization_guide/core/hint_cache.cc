@@ -5,9 +5,13 @@
 #include "components/optimization_guide/core/hint_cache.h"
 
 #include <algorithm>
+#include <optional>
 
+#include "base/files/file_path.h"
 #include "base/functional/bind.h"
+#include "base/task/thread_pool.h"
 #include "base/time/default_clock.h"
+#include "components/optimization_guide/core/component_hint_index.h"
 #include "components/optimization_guide/core/hints_processing_util.h"
 #include "components/optimization_guide/core/optimization_guide_features.h"
 #include "components/optimization_guide/core/store_update_data.h"
@@ -15,12 +19,32 @@
 
 namespace optimization_guide {
 
+namespace {
+
+std::unique_ptr<ComponentHintIndex, base::OnTaskRunnerDeleter>
+LoadComponentHintIndex(
+    const base::FilePath& path,
+    scoped_refptr<base::SequencedTaskRunner> task_runner) {
+  return std::unique_ptr<ComponentHintIndex, base::OnTaskRunnerDeleter>(
+      ComponentHintIndex::Load(path).release(),
+      base::OnTaskRunnerDeleter(std::move(task_runner)));
+}
+
+}  // namespace
+
 HintCache::HintCache(
     base::WeakPtr<OptimizationGuideStore> optimization_guide_store,
     int max_memory_cache_host_keyed_hints)
     : optimization_guide_store_(optimization_guide_store),
       host_keyed_cache_(max_memory_cache_host_keyed_hints),
       url_keyed_hint_cache_(features::MaxURLKeyedHintCacheSize()),
+      component_hint_index_task_runner_(
+          base::ThreadPool::CreateSequencedTaskRunner(
+              {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+               base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      component_hint_index_(
+          nullptr,
+          base::OnTaskRunnerDeleter(component_hint_index_task_runner_)),
       clock_(base::DefaultClock::GetInstance()) {}
 
 HintCache::~HintCache() = default;
@@ -67,8 +91,12 @@ void HintCache::UpdateComponentHints(
 
   if (optimization_guide_store_) {
     DCHECK(component_data);
-    optimization_guide_store_->UpdateComponentHints(std::move(component_data),
-                                                    std::move(callback));
+    // The index is for the version being replaced.
+    component_hint_index_.reset();
+    optimization_guide_store_->UpdateComponentHints(
+        std::move(component_data),
+        base::BindOnce(&HintCache::OnStoreComponentHintsUpdated,
+                       weak_ptr_factory_.GetWeakPtr(), std::move(callback)));
     return;
   }
   std::move(callback).Run();
@@ -200,6 +228,24 @@ void HintCache::LoadHint(const std::string& host, HintLoadedCallback callback) {
       std::move(callback).Run(nullptr);
       return;
     }
+
+    // Component hints are read from the index when there is one, rather than
+    // waiting for the store.
+    if (component_hint_index_ &&
+        optimization_guide_store_->component_version() ==
+            component_hint_index_->version() &&
+        optimization_guide_store_->IsComponentHintEntryKey(hint_entry_key)) {
+      std::unique_ptr<proto::Hint> hint =
+          component_hint_index_->FindHint(host);
+      if (hint) {
+        hint_it = host_keyed_cache_.Put(
+            host, std::make_unique<MemoryHint>(
+                      /*expiry_time=*/std::nullopt, std::move(hint)));
+        std::move(callback).Run(hint_it->second->hint());
+        return;
+      }
+    }
+
     optimization_guide_store_->LoadHint(
         hint_entry_key, base::BindOnce(&HintCache::OnLoadStoreHint,
                                        weak_ptr_factory_.GetWeakPtr(), host,
@@ -291,6 +337,13 @@ bool HintCache::HasURLKeyedEntryForURL(const GURL& url) {
   return false;
 }
 
+base::FilePath HintCache::GetComponentHintIndexPath() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!optimization_guide_store_ || !features::ShouldUseComponentHintIndex())
+    return base::FilePath();
+  return optimization_guide_store_->component_hint_index_path();
+}
+
 base::Time HintCache::GetFetchedHintsUpdateTime() const {
   if (optimization_guide_store_)
     return optimization_guide_store_->GetFetchedHintsUpdateTime();
@@ -305,9 +358,46 @@ void HintCache::OnStoreInitialized(base::OnceClosure callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   DCHECK(optimization_guide_store_);
 
+  MaybeLoadComponentHintIndex();
+  std::move(callback).Run();
+}
+
+void HintCache::OnStoreComponentHintsUpdated(base::OnceClosure callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  MaybeLoadComponentHintIndex();
   std::move(callback).Run();
 }
 
+void HintCache::MaybeLoadComponentHintIndex() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  const base::FilePath path = GetComponentHintIndexPath();
+  if (path.empty() || !optimization_guide_store_->component_version())
+    return;
+
+  component_hint_index_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&LoadComponentHintIndex, path,
+                     component_hint_index_task_runner_),
+      base::BindOnce(&HintCache::OnComponentHintIndexLoaded,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+void HintCache::OnComponentHintIndexLoaded(
+    ComponentHintIndexPtr component_hint_index) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // The index may be from a previous version whose processing did not finish,
+  // or the store may have been updated while it was loading.
+  if (!component_hint_index || !optimization_guide_store_ ||
+      optimization_guide_store_->component_version() !=
+          component_hint_index->version()) {
+    return;
+  }
+  component_hint_index_ = std::move(component_hint_index);
+}
+
 void HintCache::OnLoadStoreHint(
     const std::string& host,
     HintLoadedCallback callback,
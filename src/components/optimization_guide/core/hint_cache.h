@@ -12,6 +12,7 @@
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/time/clock.h"
 #include "components/optimization_guide/core/memory_hint.h"
 #include "components/optimization_guide/core/optimization_guide_store.h"
@@ -19,7 +20,12 @@
 
 class GURL;
 
+namespace base {
+class FilePath;
+}  // namespace base
+
 namespace optimization_guide {
+class ComponentHintIndex;
 class StoreUpdateData;
 
 using HintLoadedCallback = base::OnceCallback<void(const proto::Hint*)>;
@@ -30,7 +36,9 @@ using HintLoadedCallback = base::OnceCallback<void(const proto::Hint*)>;
 // via host name and full URL. The cache itself consists of a backing store,
 // which allows for asynchronous loading of any available host-keyed hint, and
 // an MRU host-keyed cache and a url-keyed cache, which can be used to
-// synchronously retrieve recently loaded hints keyed by URL or host.
+// synchronously retrieve recently loaded hints keyed by URL or host. Hints from
+// the component are loaded synchronously from a ComponentHintIndex when the
+// store has one for its component version.
 class HintCache {
  public:
   // Construct the HintCache with an optional backing store and max host-keyed
@@ -104,10 +112,16 @@ class HintCache {
   // in the host-keyed cache or persisted on disk).
   bool HasHint(const std::string& host);
 
-  // Requests that hint data for |host| be loaded asynchronously and passed to
-  // |callback| if/when loaded.
+  // Requests that hint data for |host| be loaded and passed to |callback|
+  // if/when loaded. The callback is run synchronously if the hint is in the
+  // host-keyed cache or in the component hint index, and asynchronously if it
+  // is loaded from the store.
   void LoadHint(const std::string& host, HintLoadedCallback callback);
 
+  // Returns the path where the component hint index should be written when
+  // processing a new component, or an empty path if it should not be.
+  base::FilePath GetComponentHintIndexPath() const;
+
   // Returns the update time provided by |hint_store_|, which specifies when the
   // fetched hints within the store are ready to be updated. If |hint_store_| is
   // not initialized, base::Time() is returned.
@@ -170,6 +184,10 @@ class HintCache {
   using URLKeyedHintCache =
       base::HashingLRUCache<std::string, std::unique_ptr<MemoryHint>>;
 
+  // The index unmaps its file when destroyed, which may block.
+  using ComponentHintIndexPtr =
+      std::unique_ptr<ComponentHintIndex, base::OnTaskRunnerDeleter>;
+
   // Gets the cache key for the URL-keyed hint cache for the URL.
   std::string GetURLKeyedHintCacheKey(const GURL& url) const;
 
@@ -177,6 +195,18 @@ class HintCache {
   // the callback initially provided by the Initialize() call.
   void OnStoreInitialized(base::OnceClosure callback);
 
+  // The callback run after the store finishes updating its component hints.
+  // This then runs the callback provided by the UpdateComponentHints() call.
+  void OnStoreComponentHintsUpdated(base::OnceClosure callback);
+
+  // Loads the component hint index of the store's component version, if the
+  // store has one.
+  void MaybeLoadComponentHintIndex();
+
+  // Sets |component_hint_index_| to |component_hint_index| if it is still for
+  // the store's component version.
+  void OnComponentHintIndexLoaded(ComponentHintIndexPtr component_hint_index);
+
   // The callback run after the store finishes loading a hint. This adds the
   // loaded hint to |host_keyed_cache_|, potentially purging the least recently
   // used element, and then runs the callback initially provided by the
@@ -204,6 +234,14 @@ class HintCache {
   // maintained within the cache and are not persisted to disk.
   URLKeyedHintCache url_keyed_hint_cache_;
 
+  // The task runner used to load and destroy |component_hint_index_|.
+  scoped_refptr<base::SequencedTaskRunner> component_hint_index_task_runner_;
+
+  // The index of the hints of the store's component version, from which they
+  // are loaded without going through the store. Null until it is loaded, or if
+  // there is no index for the store's component version.
+  ComponentHintIndexPtr component_hint_index_;
+
   // The clock used to determine if hints have expired.
   raw_ptr<const base::Clock> clock_;
 
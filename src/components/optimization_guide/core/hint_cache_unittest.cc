@@ -7,6 +7,7 @@
 #include <optional>
 #include <string>
 
+#include "base/files/file_path.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/functional/bind.h"
 #include "base/memory/raw_ptr.h"
@@ -14,6 +15,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/task_environment.h"
+#include "components/optimization_guide/core/component_hint_index.h"
 #include "components/optimization_guide/core/optimization_guide_features.h"
 #include "components/optimization_guide/core/optimization_guide_store.h"
 #include "components/optimization_guide/core/proto_database_provider_test_base.h"
@@ -382,6 +384,57 @@ TEST_P(HintCacheTest, ComponentHintsAvailableAfterRestart) {
   }
 }
 
+TEST_P(HintCacheTest, ComponentHintsLoadedSynchronouslyFromIndex) {
+  if (!IsBackedByPersistentStore())
+    return;
+
+  for (int i = 0; i < 2; ++i) {
+    const int kMemoryCacheSize = 5;
+    CreateAndInitializeHintCache(kMemoryCacheSize,
+                                 false /*=purge_existing_data*/);
+
+    base::Version version("2.0.0");
+    std::unique_ptr<StoreUpdateData> update_data =
+        hint_cache()->MaybeCreateUpdateDataForComponentHints(version);
+    if (i == 0) {
+      ASSERT_TRUE(update_data);
+
+      // Like HintsManager, write the index before updating the store.
+      google::protobuf::RepeatedPtrField<proto::Hint> hints;
+      proto::Hint* hint = hints.Add();
+      hint->set_key("host.domain.org");
+      hint->set_key_representation(proto::HOST);
+      hint->add_page_hints()->set_page_pattern("page/*");
+      const base::FilePath index_path =
+          hint_cache()->GetComponentHintIndexPath();
+      ASSERT_FALSE(index_path.empty());
+      ASSERT_TRUE(ComponentHintIndex::Write(index_path, version, hints));
+
+      update_data->MoveHintIntoUpdateData(std::move(*hint));
+      UpdateComponentHints(std::move(update_data));
+    } else {
+      EXPECT_FALSE(update_data);
+    }
+    // Let the index load.
+    RunUntilIdle();
+
+    bool callback_called = false;
+    hint_cache()->LoadHint(
+        "host.domain.org",
+        base::BindOnce(
+            [](bool* callback_called, const proto::Hint* hint) {
+              *callback_called = true;
+              ASSERT_TRUE(hint);
+              EXPECT_EQ("page/*", hint->page_hints(0).page_pattern());
+            },
+            &callback_called));
+    EXPECT_TRUE(callback_called);
+    EXPECT_TRUE(hint_cache()->GetHostKeyedHintIfLoaded("host.domain.org"));
+
+    DestroyHintCache();
+  }
+}
+
 TEST_P(HintCacheTest, ComponentHintsUpdatableAfterRestartWithPurge) {
   if (!IsBackedByPersistentStore())
     return;
@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "base/command_line.h"
+#include "base/files/file_path.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback_helpers.h"
 #include "base/memory/raw_ptr.h"
@@ -27,6 +28,7 @@
 #include "build/build_config.h"
 #include "components/optimization_guide/core/access_token_helper.h"
 #include "components/optimization_guide/core/bloom_filter.h"
+#include "components/optimization_guide/core/component_hint_index.h"
 #include "components/optimization_guide/core/hint_cache.h"
 #include "components/optimization_guide/core/hints_component_util.h"
 #include "components/optimization_guide/core/hints_fetcher_factory.h"
@@ -224,10 +226,12 @@ class ScopedCanApplyOptimizationLogger {
   raw_ptr<OptimizationGuideLogger> optimization_guide_logger_;
 };
 
-// Reads component file and parses it into a Configuration proto. Should not be
-// called on the UI thread.
+// Reads component file and parses it into a Configuration proto. If
+// |component_hint_index_path| is not empty, also writes an index of the hints
+// there. Should not be called on the UI thread.
 std::unique_ptr<proto::Configuration> ReadComponentFile(
-    const HintsComponentInfo& info) {
+    const HintsComponentInfo& info,
+    const base::FilePath& component_hint_index_path) {
   ProcessHintsComponentResult out_result;
   std::unique_ptr<proto::Configuration> config =
       ProcessHintsComponent(info, &out_result);
@@ -236,6 +240,12 @@ std::unique_ptr<proto::Configuration> ReadComponentFile(
     return nullptr;
   }
 
+  // If the index can't be written, the hints are loaded from the store.
+  if (!component_hint_index_path.empty()) {
+    ComponentHintIndex::Write(component_hint_index_path, info.version,
+                              config->hints());
+  }
+
   // Do not record the process hints component result for success cases until
   // we processed all of the hints and filters in it.
   return config;
@@ -476,8 +486,12 @@ void HintsManager::OnHintsComponentAvailable(const HintsComponentInfo& info) {
                             optimization_guide_logger_)
       << "Processing OptimizationHints component version: "
       << currently_processing_component_version_->GetString();
+  // The index is only needed when the store gets the component's hints.
+  const base::FilePath component_hint_index_path =
+      update_data ? hint_cache_->GetComponentHintIndexPath() : base::FilePath();
   background_task_runner_->PostTaskAndReplyWithResult(
-      FROM_HERE, base::BindOnce(&ReadComponentFile, info),
+      FROM_HERE,
+      base::BindOnce(&ReadComponentFile, info, component_hint_index_path),
       base::BindOnce(&HintsManager::UpdateComponentHints,
                      weak_ptr_factory_.GetWeakPtr(),
                      std::move(next_update_closure_), std::move(update_data)));
@@ -0,0 +1,92 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/optimization_guide/core/model_warm_pool.h"
+
+#include <utility>
+#include <vector>
+
+#include "base/no_destructor.h"
+#include "components/optimization_guide/core/optimization_guide_features.h"
+
+namespace optimization_guide {
+
+ModelWarmPool::Entry::Entry(size_t size_bytes,
+                            base::OnceClosure unload_closure)
+    : size_bytes(size_bytes), unload_closure(std::move(unload_closure)) {}
+
+ModelWarmPool::Entry::Entry(Entry&&) = default;
+
+ModelWarmPool::Entry& ModelWarmPool::Entry::operator=(Entry&&) = default;
+
+ModelWarmPool::Entry::~Entry() = default;
+
+ModelWarmPool::ModelWarmPool(size_t memory_budget_bytes)
+    : memory_budget_bytes_(memory_budget_bytes),
+      entries_(base::LRUCache<ModelId, Entry>::NO_AUTO_EVICT) {}
+
+ModelWarmPool::~ModelWarmPool() = default;
+
+// static
+ModelWarmPool* ModelWarmPool::GetInstance() {
+  static const size_t memory_budget_bytes =
+      features::ModelWarmPoolMemoryBudgetBytes();
+  if (!memory_budget_bytes) {
+    return nullptr;
+  }
+  static base::NoDestructor<ModelWarmPool> instance(memory_budget_bytes);
+  return instance.get();
+}
+
+bool ModelWarmPool::MarkUsed(ModelId id,
+                             size_t size_bytes,
+                             base::OnceClosure unload_closure) {
+  std::vector<base::OnceClosure> evicted_closures;
+  bool kept = false;
+  {
+    base::AutoLock lock(lock_);
+    auto it = entries_.Peek(id);
+    if (it != entries_.end()) {
+      used_bytes_ -= it->second.size_bytes;
+      entries_.Erase(it);
+    }
+
+    if (size_bytes <= memory_budget_bytes_) {
+      kept = true;
+      // Evict from the least recently used end until the model fits.
+      while (used_bytes_ + size_bytes > memory_budget_bytes_) {
+        auto oldest = entries_.rbegin();
+        used_bytes_ -= oldest->second.size_bytes;
+        evicted_closures.push_back(std::move(oldest->second.unload_closure));
+        entries_.Erase(oldest);
+      }
+      entries_.Put(id, Entry(size_bytes, std::move(unload_closure)));
+      used_bytes_ += size_bytes;
+    }
+  }
+
+  // The closures post to other sequences, but run them without the lock in
+  // case they don't.
+  for (base::OnceClosure& closure : evicted_closures) {
+    std::move(closure).Run();
+  }
+  return kept;
+}
+
+void ModelWarmPool::Remove(ModelId id) {
+  base::AutoLock lock(lock_);
+  auto it = entries_.Peek(id);
+  if (it == entries_.end()) {
+    return;
+  }
+  used_bytes_ -= it->second.size_bytes;
+  entries_.Erase(it);
+}
+
+size_t ModelWarmPool::GetUsedBytes() const {
+  base::AutoLock lock(lock_);
+  return used_bytes_;
+}
+
+}  // namespace optimization_guide
@@ -0,0 +1,78 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_OPTIMIZATION_GUIDE_CORE_MODEL_WARM_POOL_H_
+#define COMPONENTS_OPTIMIZATION_GUIDE_CORE_MODEL_WARM_POOL_H_
+
+#include <stddef.h>
+
+#include "base/containers/lru_cache.h"
+#include "base/functional/callback.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+
+namespace optimization_guide {
+
+// Keeps the most recently used models loaded after their execution, within a
+// memory budget shared by all the model executors, so that bursts of
+// executions don't pay the model loading time for each of them.
+//
+// The model executors live on different sequences, so this class is
+// thread-safe. Each executor gives the pool a closure that unloads its model,
+// which is run when the model is evicted to make room for another one. The
+// closure is run on the sequence that evicts it, so it must post to the
+// executor's sequence.
+class ModelWarmPool {
+ public:
+  // An opaque identifier of the model, usually its executor.
+  using ModelId = const void*;
+
+  explicit ModelWarmPool(size_t memory_budget_bytes);
+
+  ModelWarmPool(const ModelWarmPool&) = delete;
+  ModelWarmPool& operator=(const ModelWarmPool&) = delete;
+
+  ~ModelWarmPool();
+
+  // Returns the pool shared by all the model executors, or nullptr if models
+  // should not be kept loaded.
+  static ModelWarmPool* GetInstance();
+
+  // Marks the model |id|, which uses |size_bytes|, as the most recently used,
+  // and evicts the least recently used models that don't fit in the budget
+  // anymore. |unload_closure| replaces the previous closure of the model.
+  // Returns false if the model alone doesn't fit in the budget, in which case
+  // it is not kept and the caller should unload it.
+  bool MarkUsed(ModelId id,
+                size_t size_bytes,
+                base::OnceClosure unload_closure);
+
+  // Removes the model |id| without running its unload closure, e.g. when its
+  // executor unloads it. No-op if the model is not in the pool.
+  void Remove(ModelId id);
+
+  // Returns the number of bytes used by the models in the pool.
+  size_t GetUsedBytes() const;
+
+ private:
+  struct Entry {
+    Entry(size_t size_bytes, base::OnceClosure unload_closure);
+    Entry(Entry&&);
+    Entry& operator=(Entry&&);
+    ~Entry();
+
+    size_t size_bytes;
+    base::OnceClosure unload_closure;
+  };
+
+  const size_t memory_budget_bytes_;
+
+  mutable base::Lock lock_;
+  base::LRUCache<ModelId, Entry> entries_ GUARDED_BY(lock_);
+  size_t used_bytes_ GUARDED_BY(lock_) = 0;
+};
+
+}  // namespace optimization_guide
+
+#endif  // COMPONENTS_OPTIMIZATION_GUIDE_CORE_MODEL_WARM_POOL_H_
@@ -0,0 +1,80 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/optimization_guide/core/model_warm_pool.h"
+
+#include <string>
+#include <vector>
+
+#include "base/functional/bind.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace optimization_guide {
+
+namespace {
+
+class ModelWarmPoolTest : public testing::Test {
+ public:
+  base::OnceClosure UnloadClosure(const std::string& name) {
+    return base::BindOnce(
+        [](std::vector<std::string>* unloaded, const std::string& name) {
+          unloaded->push_back(name);
+        },
+        &unloaded_, name);
+  }
+
+ protected:
+  std::vector<std::string> unloaded_;
+};
+
+// Distinct values so that the models have distinct addresses.
+constexpr int kModelA = 0;
+constexpr int kModelB = 1;
+constexpr int kModelC = 2;
+
+}  // namespace
+
+TEST_F(ModelWarmPoolTest, EvictsLeastRecentlyUsed) {
+  ModelWarmPool pool(/*memory_budget_bytes=*/100);
+
+  EXPECT_TRUE(pool.MarkUsed(&kModelA, 40, UnloadClosure("a")));
+  EXPECT_TRUE(pool.MarkUsed(&kModelB, 40, UnloadClosure("b")));
+  EXPECT_EQ(80u, pool.GetUsedBytes());
+
+  // Using A again makes B the least recently used.
+  EXPECT_TRUE(pool.MarkUsed(&kModelA, 40, UnloadClosure("a")));
+  EXPECT_TRUE(pool.MarkUsed(&kModelC, 40, UnloadClosure("c")));
+  EXPECT_EQ(std::vector<std::string>({"b"}), unloaded_);
+  EXPECT_EQ(80u, pool.GetUsedBytes());
+}
+
+TEST_F(ModelWarmPoolTest, UpdatesModelSize) {
+  ModelWarmPool pool(/*memory_budget_bytes=*/100);
+
+  EXPECT_TRUE(pool.MarkUsed(&kModelA, 40, UnloadClosure("a")));
+  EXPECT_TRUE(pool.MarkUsed(&kModelA, 70, UnloadClosure("a")));
+  EXPECT_EQ(70u, pool.GetUsedBytes());
+  EXPECT_TRUE(unloaded_.empty());
+}
+
+TEST_F(ModelWarmPoolTest, RejectsModelLargerThanBudget) {
+  ModelWarmPool pool(/*memory_budget_bytes=*/100);
+
+  EXPECT_TRUE(pool.MarkUsed(&kModelA, 40, UnloadClosure("a")));
+  EXPECT_FALSE(pool.MarkUsed(&kModelB, 101, UnloadClosure("b")));
+  EXPECT_EQ(40u, pool.GetUsedBytes());
+  EXPECT_TRUE(unloaded_.empty());
+}
+
+TEST_F(ModelWarmPoolTest, RemoveDoesNotRunUnloadClosure) {
+  ModelWarmPool pool(/*memory_budget_bytes=*/100);
+
+  EXPECT_TRUE(pool.MarkUsed(&kModelA, 40, UnloadClosure("a")));
+  pool.Remove(&kModelA);
+  pool.Remove(&kModelB);
+  EXPECT_EQ(0u, pool.GetUsedBytes());
+  EXPECT_TRUE(unloaded_.empty());
+}
+
+}  // namespace optimization_guide
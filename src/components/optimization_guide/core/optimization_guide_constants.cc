@@ -29,6 +29,9 @@ const char kLoadedHintLocalHistogramString[] =
 const base::FilePath::CharType kOptimizationGuideHintStore[] =
     FILE_PATH_LITERAL("optimization_guide_hint_cache_store");
 
+const base::FilePath::CharType kOptimizationGuideComponentHintIndex[] =
+    FILE_PATH_LITERAL("component_hint_index");
+
 const base::FilePath::CharType
     kOldOptimizationGuidePredictionModelMetadataStore[] =
         FILE_PATH_LITERAL("optimization_guide_model_metadata_store");
@@ -43,6 +43,11 @@ extern const char kLoadedHintLocalHistogramString[];
 COMPONENT_EXPORT(OPTIMIZATION_GUIDE_FEATURES)
 extern const base::FilePath::CharType kOptimizationGuideHintStore[];
 
+// The file within the hint store folder where the index of the component hints
+// is stored.
+COMPONENT_EXPORT(OPTIMIZATION_GUIDE_FEATURES)
+extern const base::FilePath::CharType kOptimizationGuideComponentHintIndex[];
+
 // The folder where the old prediction model and associated metadata are
 // currently stored on disk. This is per profile.
 COMPONENT_EXPORT(OPTIMIZATION_GUIDE_FEATURES)
@@ -4,6 +4,7 @@
 
 #include "components/optimization_guide/core/optimization_guide_features.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "base/command_line.h"
@@ -509,6 +510,14 @@ base::TimeDelta ModelExecutionWatchdogDefaultTimeout() {
       ));
 }
 
+size_t ModelWarmPoolMemoryBudgetBytes() {
+  return static_cast<size_t>(std::max(
+             0, GetFieldTrialParamByFeatureAsInt(kOptimizationTargetPrediction,
+                                                 "model_warm_pool_budget_kb",
+                                                 0))) *
+         1024;
+}
+
 bool IsModelDownloadingEnabled() {
   return base::FeatureList::IsEnabled(kOptimizationGuideModelDownloading);
 }
@@ -571,6 +580,11 @@ bool ShouldCheckFailedComponentVersionPref() {
       false);
 }
 
+bool ShouldUseComponentHintIndex() {
+  return GetFieldTrialParamByFeatureAsBool(
+      kOptimizationHintsComponent, "use_component_hint_index", true);
+}
+
 std::map<proto::OptimizationTarget, std::set<int64_t>>
 GetPredictionModelVersionsInKillSwitch() {
   if (!base::FeatureList::IsEnabled(
@@ -295,6 +295,12 @@ bool IsModelExecutionWatchdogEnabled();
 COMPONENT_EXPORT(OPTIMIZATION_GUIDE_FEATURES)
 base::TimeDelta ModelExecutionWatchdogDefaultTimeout();
 
+// The memory budget in bytes of the models that are kept loaded after their
+// execution, shared by all the optimization targets. Models are unloaded after
+// each execution if 0.
+COMPONENT_EXPORT(OPTIMIZATION_GUIDE_FEATURES)
+size_t ModelWarmPoolMemoryBudgetBytes();
+
 // Whether the ability to download models is enabled.
 COMPONENT_EXPORT(OPTIMIZATION_GUIDE_FEATURES)
 bool IsModelDownloadingEnabled();
@@ -333,6 +339,11 @@ bool TFLiteXNNPACKDelegateEnabled();
 COMPONENT_EXPORT(OPTIMIZATION_GUIDE_FEATURES)
 bool ShouldCheckFailedComponentVersionPref();
 
+// Whether component hints should also be written to a memory-mapped index, so
+// that they can be loaded synchronously instead of from the store.
+COMPONENT_EXPORT(OPTIMIZATION_GUIDE_FEATURES)
+bool ShouldUseComponentHintIndex();
+
 // Whether logging of model quality is enabled.
 COMPONENT_EXPORT(OPTIMIZATION_GUIDE_FEATURES)
 bool IsModelQualityLoggingEnabled();
@@ -25,6 +25,7 @@
 #include "components/leveldb_proto/public/shared_proto_database_client_list.h"
 #include "components/optimization_guide/core/memory_hint.h"
 #include "components/optimization_guide/core/model_util.h"
+#include "components/optimization_guide/core/optimization_guide_constants.h"
 #include "components/optimization_guide/core/optimization_guide_features.h"
 #include "components/optimization_guide/core/optimization_guide_prefs.h"
 #include "components/optimization_guide/core/optimization_guide_util.h"
@@ -113,7 +114,10 @@ OptimizationGuideStore::OptimizationGuideStore(
     const base::FilePath& database_dir,
     scoped_refptr<base::SequencedTaskRunner> store_task_runner,
     PrefService* pref_service)
-    : store_task_runner_(store_task_runner), pref_service_(pref_service) {
+    : component_hint_index_path_(
+          database_dir.Append(kOptimizationGuideComponentHintIndex)),
+      store_task_runner_(store_task_runner),
+      pref_service_(pref_service) {
   database_ = database_provider->GetDB<proto::StoreEntry>(
       leveldb_proto::ProtoDbType::HINT_CACHE_STORE, database_dir,
       store_task_runner_);
@@ -513,6 +517,14 @@ bool OptimizationGuideStore::IsAvailable() const {
   return status_ == Status::kAvailable;
 }
 
+bool OptimizationGuideStore::IsComponentHintEntryKey(
+    const EntryKey& hint_entry_key) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return !component_hint_entry_key_prefix_.empty() &&
+         base::StartsWith(hint_entry_key, component_hint_entry_key_prefix_,
+                          base::CompareCase::SENSITIVE);
+}
+
 void OptimizationGuideStore::PurgeDatabase(base::OnceClosure callback) {
   // When purging the database, update the schema version to the current one.
   EntryKey schema_entry_key = GetMetadataTypeEntryKey(MetadataType::kSchema);
@@ -10,6 +10,7 @@
 #include <string>
 
 #include "base/containers/flat_set.h"
+#include "base/files/file_path.h"
 #include "base/functional/callback.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
@@ -179,6 +180,21 @@ class OptimizationGuideStore {
   // Returns true if the current status is Status::kAvailable.
   bool IsAvailable() const;
 
+  // Returns the version of the component hints within the store, if any.
+  const std::optional<base::Version>& component_version() const {
+    return component_version_;
+  }
+
+  // Returns whether |hint_entry_key| is the key of a hint from the current
+  // component.
+  bool IsComponentHintEntryKey(const EntryKey& hint_entry_key) const;
+
+  // Returns the path of the index of the current component hints, see
+  // ComponentHintIndex. This is empty if the store has no directory.
+  const base::FilePath& component_hint_index_path() const {
+    return component_hint_index_path_;
+  }
+
   // Returns the weak ptr of |this|.
   base::WeakPtr<OptimizationGuideStore> AsWeakPtr() {
     return weak_ptr_factory_.GetWeakPtr();
@@ -347,6 +363,9 @@ class OptimizationGuideStore {
   // Proto database used by the store.
   std::unique_ptr<StoreEntryProtoDatabase> database_;
 
+  // The path of the component hint index within the store directory.
+  const base::FilePath component_hint_index_path_;
+
   // The current status of the store. It should only be updated through
   // UpdateStatus(), which validates status transitions and triggers
   // accompanying logic.
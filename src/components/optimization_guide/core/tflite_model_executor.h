@@ -11,9 +11,11 @@
 #include "base/functional/bind.h"
 #include "base/functional/callback_forward.h"
 #include "base/logging.h"
+#include "base/memory/raw_ptr.h"
 #include "base/metrics/histogram.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/sequence_checker.h"
+#include "base/task/bind_post_task.h"
 #include "base/task/sequenced_task_runner.h"
 #include "base/task/thread_pool.h"
 #include "base/time/time.h"
@@ -25,6 +27,7 @@
 #include "components/optimization_guide/core/model_execution_timeout_watchdog.h"
 #include "components/optimization_guide/core/model_executor.h"
 #include "components/optimization_guide/core/model_util.h"
+#include "components/optimization_guide/core/model_warm_pool.h"
 #include "components/optimization_guide/core/optimization_guide_features.h"
 #include "components/optimization_guide/machine_learning_tflite_buildflags.h"
 #include "third_party/tflite/src/tensorflow/lite/c/common.h"
@@ -74,7 +77,9 @@ class ScopedExecutionStatusResultRecorder {
 // unloaded from memory after every execution (e.g.: "OnComplete"). This helps
 // to keep memory usage of the browser process down, but does delay model
 // execution by the time it takes to load the model (about 50ms in practice).
-// See |SetShouldUnloadModelOnComplete| to override this behavior.
+// See |SetShouldUnloadModelOnComplete| to override this behavior. When
+// |ModelWarmPool| has a memory budget, the most recently used models are kept
+// loaded within that budget instead of being unloaded after every execution.
 //
 // Note that when built with the MediaPipe backend (non-default), task
 // cancellation is not supported.
@@ -92,6 +97,10 @@ class TFLiteModelExecutor : public ModelExecutor<OutputType, InputType> {
   ~TFLiteModelExecutor() override {
     DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
+    if (warm_pool_) {
+      warm_pool_->Remove(this);
+    }
+
     // Ensure the memory mapped file is deleted on a blockable sequence since
     // the current sequence is not guaranteed to be blockable.
     //
@@ -119,6 +128,7 @@ class TFLiteModelExecutor : public ModelExecutor<OutputType, InputType> {
     reply_task_runner_ = reply_task_runner;
     model_loading_task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
         {base::MayBlock(), base::TaskPriority::BEST_EFFORT});
+    warm_pool_ = ModelWarmPool::GetInstance();
 
     if (features::IsModelExecutionWatchdogEnabled()) {
       // The sequence |watchdog_sequence| is used to run watchdog's task. The
@@ -211,6 +221,9 @@ class TFLiteModelExecutor : public ModelExecutor<OutputType, InputType> {
     DCHECK(execution_task_runner_->RunsTasksInCurrentSequence());
     DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
+    if (warm_pool_) {
+      warm_pool_->Remove(this);
+    }
     loaded_model_.reset();
     // Ensure the memory mapped file is deleted on a blockable sequence.
     model_loading_task_runner_->DeleteSoon(FROM_HERE, std::move(model_fb_));
@@ -292,6 +305,15 @@ class TFLiteModelExecutor : public ModelExecutor<OutputType, InputType> {
     return outputs;
   }
 
+  // Overrides the pool that keeps the model loaded after its executions. Must
+  // outlive |this|. |warm_pool| may be null to always unload the model.
+  void SetModelWarmPoolForTesting(ModelWarmPool* warm_pool) {
+    DCHECK(execution_task_runner_->RunsTasksInCurrentSequence());
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    UnloadModel();
+    warm_pool_ = warm_pool;
+  }
+
   // IMPORTANT: These WeakPointers must only be dereferenced on the
   // |execution_task_runner| thread.
   base::WeakPtr<TFLiteModelExecutor> GetWeakPtrForExecutionThread() {
@@ -426,6 +448,13 @@ class TFLiteModelExecutor : public ModelExecutor<OutputType, InputType> {
     DCHECK(execution_task_runner_->RunsTasksInCurrentSequence());
     DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
+    // Whether the model was still loaded from a previous execution, either
+    // because it is never unloaded or because it was kept in the warm pool.
+    base::UmaHistogramBoolean(
+        "OptimizationGuide.ModelExecutor.ModelWasLoaded." +
+            GetStringNameForOptimizationTarget(optimization_target_),
+        !!loaded_model_);
+
     if (!loaded_model_) {
       LoadModelFile(base::BindOnce(
           &TFLiteModelExecutor::BatchExecuteLoadedModelAndRunCallback,
@@ -455,6 +484,12 @@ class TFLiteModelExecutor : public ModelExecutor<OutputType, InputType> {
     }
     last_execution_time_ = base::TimeTicks::Now();
 
+    base::UmaHistogramCounts1000(
+        "OptimizationGuide.ModelExecutor.BatchSize." +
+            GetStringNameForOptimizationTarget(optimization_target_),
+        inputs.size());
+    base::ElapsedTimer batch_timer;
+
     for (const InputType& input : inputs) {
       ScopedExecutionStatusResultRecorder status_recorder(optimization_target_);
       // IMPORTANT: Once the arm method is called, disarm must be called when
@@ -493,6 +528,23 @@ class TFLiteModelExecutor : public ModelExecutor<OutputType, InputType> {
         watchdog_->DisarmOnExecutionComplete();
       }
     }
+
+    if (inputs.empty()) {
+      return;
+    }
+    const base::TimeDelta batch_latency = batch_timer.Elapsed();
+    base::UmaHistogramLongTimes(
+        "OptimizationGuide.ModelExecutor.BatchExecutionLatency." +
+            GetStringNameForOptimizationTarget(optimization_target_),
+        batch_latency);
+    // The number of inputs executed per second, which shows how much batching
+    // amortizes the per-execution overhead.
+    if (batch_latency.is_positive()) {
+      base::UmaHistogramCounts100000(
+          "OptimizationGuide.ModelExecutor.BatchThroughput." +
+              GetStringNameForOptimizationTarget(optimization_target_),
+          static_cast<int>(inputs.size() / batch_latency.InSecondsF()));
+    }
   }
 
   // Batch executes the loaded model and runs callback on the reply thread.
@@ -534,9 +586,21 @@ class TFLiteModelExecutor : public ModelExecutor<OutputType, InputType> {
   void OnExecutionComplete() {
     DCHECK(execution_task_runner_->RunsTasksInCurrentSequence());
     DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-    if (should_unload_model_on_complete_) {
-      UnloadModel();
+    if (!should_unload_model_on_complete_ || !model_fb_) {
+      return;
+    }
+    // Keep the model loaded if it fits in the warm pool. The pool unloads it
+    // when it is evicted for more recently used models.
+    if (warm_pool_ &&
+        warm_pool_->MarkUsed(
+            this, model_fb_->length(),
+            base::BindPostTask(
+                execution_task_runner_,
+                base::BindOnce(&TFLiteModelExecutor::UnloadModel,
+                               GetWeakPtrForExecutionThread())))) {
+      return;
     }
+    UnloadModel();
   }
 
   base::OnceClosure MakeCancelClosure() {
@@ -562,6 +626,10 @@ class TFLiteModelExecutor : public ModelExecutor<OutputType, InputType> {
   std::unique_ptr<ModelExecutionTimeoutWatchdog, base::OnTaskRunnerDeleter>
       watchdog_;
 
+  // The pool that keeps the model loaded after its executions, or null if the
+  // model is unloaded after every execution. Shared with other executors.
+  raw_ptr<ModelWarmPool> warm_pool_ = nullptr;
+
   // Main thread for model execution. For synchronous model execution, this
   // needs to be the same caller thread.
   scoped_refptr<base::SequencedTaskRunner> execution_task_runner_;
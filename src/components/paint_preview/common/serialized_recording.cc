@@ -4,8 +4,10 @@
 
 #include "components/paint_preview/common/serialized_recording.h"
 
+#include <algorithm>
 #include <optional>
 
+#include "base/check.h"
 #include "base/notreached.h"
 #include "base/task/task_traits.h"
 #include "base/task/thread_pool.h"
@@ -21,6 +23,52 @@ namespace paint_preview {
 
 namespace {
 
+// An in-memory SkWStream that drops all data once more than |max_size| bytes
+// are written so an oversized capture doesn't stay in memory until the end of
+// serialization. As with FileWStream, bytesWritten() includes dropped bytes as
+// Skia requires serialization to succeed.
+class BoundedMemoryWStream : public SkWStream {
+ public:
+  explicit BoundedMemoryWStream(size_t max_size) : max_size_(max_size) {}
+  ~BoundedMemoryWStream() override = default;
+
+  BoundedMemoryWStream(const BoundedMemoryWStream&) = delete;
+  BoundedMemoryWStream& operator=(const BoundedMemoryWStream&) = delete;
+
+  // SkWStream impl.
+  bool write(const void* buffer, size_t size) override {
+    fake_bytes_written_ += size;
+    if (exceeded_max_size_) {
+      return false;
+    }
+    if (size > max_size_ - stream_.bytesWritten()) {
+      exceeded_max_size_ = true;
+      stream_.reset();
+      return false;
+    }
+    return stream_.write(buffer, size);
+  }
+  size_t bytesWritten() const override { return fake_bytes_written_; }
+
+  bool ExceededMaxSize() const { return exceeded_max_size_; }
+
+  // Copies the data directly from the stream's blocks to |buffer| without
+  // first making it contiguous.
+  mojo_base::BigBuffer TakeBuffer() {
+    DCHECK(!exceeded_max_size_);
+    mojo_base::BigBuffer buffer(stream_.bytesWritten());
+    stream_.copyTo(buffer.data());
+    stream_.reset();
+    return buffer;
+  }
+
+ private:
+  const size_t max_size_;
+  SkDynamicMemoryWStream stream_;
+  size_t fake_bytes_written_ = 0;
+  bool exceeded_max_size_ = false;
+};
+
 // Serializes |skp| to |out_stream| as an SkPicture of size |dimensions|.
 // |tracker| supplies metadata required during serialization.
 bool SerializeSkPicture(sk_sp<const SkPicture> skp,
@@ -115,6 +163,22 @@ std::optional<SkpResult> SerializedRecording::Deserialize() && {
   return {std::move(result)};
 }
 
+std::optional<SkpResult> SerializedRecording::DeserializeWithoutConsuming()
+    const {
+  TRACE_EVENT0("paint_preview",
+               "SerializedRecording::DeserializeWithoutConsuming");
+  if (!is_buffer()) {
+    return std::nullopt;
+  }
+
+  CHECK(buffer_.has_value());
+  SkpResult result;
+  SkDeserialProcs procs = MakeDeserialProcs(&result.ctx);
+  SkMemoryStream stream(buffer_->data(), buffer_->size(), /*copyData=*/false);
+  result.skp = SkPicture::MakeFromStream(&stream, &procs);
+  return {std::move(result)};
+}
+
 sk_sp<SkPicture> SerializedRecording::DeserializeWithContext(
     LoadedFramesDeserialContext* ctx) && {
   TRACE_EVENT0("paint_preview", "SerializedRecording::DeserializeWithContext");
@@ -160,22 +224,19 @@ std::optional<mojo_base::BigBuffer> RecordToBuffer(
     PaintPreviewTracker* tracker,
     std::optional<size_t> maybe_max_capture_size,
     size_t* serialized_size) {
-  SkDynamicMemoryWStream memory_stream;
-  if (!SerializeSkPicture(skp, tracker, &memory_stream))
-    return std::nullopt;
-
   size_t max_capture_size = maybe_max_capture_size.value_or(SIZE_MAX);
   if (max_capture_size == 0)
     return std::nullopt;
 
-  sk_sp<SkData> data = memory_stream.detachAsData();
-  *serialized_size = std::min(data->size(), max_capture_size);
-  mojo_base::BigBuffer buffer(
-      base::span<const uint8_t>(data->bytes(), *serialized_size));
-  if (data->size() > max_capture_size)
+  BoundedMemoryWStream memory_stream(max_capture_size);
+  if (!SerializeSkPicture(skp, tracker, &memory_stream))
+    return std::nullopt;
+
+  *serialized_size = std::min(memory_stream.bytesWritten(), max_capture_size);
+  if (memory_stream.ExceededMaxSize())
     return std::nullopt;
 
-  return {std::move(buffer)};
+  return {memory_stream.TakeBuffer()};
 }
 
 }  // namespace paint_preview
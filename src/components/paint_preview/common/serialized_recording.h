@@ -112,6 +112,13 @@ class SerializedRecording {
   // This is not safe to call in the browser process.
   std::optional<SkpResult> Deserialize() &&;
 
+  // Same as |Deserialize|, but leaves the recording intact so that it can be
+  // deserialized again later. Only memory buffer variants can be deserialized
+  // repeatedly, returns |std::nullopt| for other variants.
+  //
+  // This is not safe to call in the browser process.
+  std::optional<SkpResult> DeserializeWithoutConsuming() const;
+
   // Deserialize into an |SkPicture|. |ctx| should contain entries for any
   // subframes that should be included in the output.
   //
@@ -182,12 +182,46 @@ TEST_F(PaintPreviewSerializedRecordingTest, RoundtripWithMemoryBufferBacking) {
       SerializedRecording(std::move(buffer.value()));
   ASSERT_TRUE(recording.IsValid());
 
+  // Memory buffers can be deserialized repeatedly.
+  for (int i = 0; i < 2; ++i) {
+    std::optional<SkpResult> result = recording.DeserializeWithoutConsuming();
+    ASSERT_TRUE(result.has_value());
+    ExpectPicturesEqual(result->skp, pic);
+  }
+
   std::optional<SkpResult> result = std::move(recording).Deserialize();
   ASSERT_TRUE(result.has_value());
   ASSERT_TRUE(result->ctx.empty());
   ExpectPicturesEqual(result->skp, pic);
 }
 
+TEST_F(PaintPreviewSerializedRecordingTest, MemoryBufferExceedsMaxSize) {
+  sk_sp<const SkPicture> pic = PaintPictureSingleGrayPixel();
+
+  PaintPreviewTracker tracker(base::UnguessableToken::Create(), std::nullopt,
+                              /*is_main_frame=*/true);
+  size_t serialized_size = 0;
+  std::optional<mojo_base::BigBuffer> buffer =
+      RecordToBuffer(pic, &tracker, std::nullopt, &serialized_size);
+  ASSERT_TRUE(buffer.has_value());
+  const size_t full_size = serialized_size;
+  ASSERT_EQ(buffer->size(), full_size);
+
+  // Exactly the serialized size fits.
+  PaintPreviewTracker exact_tracker(base::UnguessableToken::Create(),
+                                    std::nullopt, /*is_main_frame=*/true);
+  buffer = RecordToBuffer(pic, &exact_tracker, full_size, &serialized_size);
+  ASSERT_TRUE(buffer.has_value());
+  EXPECT_EQ(serialized_size, full_size);
+
+  PaintPreviewTracker capped_tracker(base::UnguessableToken::Create(),
+                                     std::nullopt, /*is_main_frame=*/true);
+  buffer = RecordToBuffer(pic, &capped_tracker, full_size - 1,
+                          &serialized_size);
+  EXPECT_FALSE(buffer.has_value());
+  EXPECT_EQ(serialized_size, full_size - 1);
+}
+
 TEST_F(PaintPreviewSerializedRecordingTest, ImageDiscardingTolerated) {
   sk_sp<const SkPicture> pic = PaintPictureLargeImage(gfx::Size(200, 200));
 
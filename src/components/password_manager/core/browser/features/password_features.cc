@@ -72,6 +72,10 @@ BASE_FEATURE(kLocalStateEnterprisePasswordHashes,
              "LocalStateEnterprisePasswordHashes",
              base::FEATURE_DISABLED_BY_DEFAULT);
 
+BASE_FEATURE(kLoginDatabaseInMemoryIndex,
+             "LoginDatabaseInMemoryIndex",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 #if !BUILDFLAG(IS_ANDROID) && !BUILDFLAG(IS_IOS)  // Desktop
 BASE_FEATURE(kPasswordGenerationExperiment,
              "PasswordGenerationExperiment",
@@ -61,6 +61,10 @@ BASE_DECLARE_FEATURE(kIosDetectUsernameInUff);
 // Enables saving enterprise password hashes to a local state preference.
 BASE_DECLARE_FEATURE(kLocalStateEnterprisePasswordHashes);
 
+// Serves matching logins of the built-in backend from an in-memory index of
+// all logins instead of querying the login database for every form.
+BASE_DECLARE_FEATURE(kLoginDatabaseInMemoryIndex);
+
 #if !BUILDFLAG(IS_ANDROID) && !BUILDFLAG(IS_IOS)  // Desktop
 // Enables different experiments that modify content and behavior of the
 // existing generated password suggestion dropdown.
@@ -4,12 +4,14 @@
 
 #include "components/password_manager/core/browser/leak_detection/bulk_leak_check_impl.h"
 
+#include <algorithm>
 #include <optional>
 #include <utility>
 
 #include "base/check.h"
 #include "base/ranges/algorithm.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/system/sys_info.h"
 #include "base/task/thread_pool.h"
 #include "components/password_manager/core/browser/leak_detection/encryption_utils.h"
 #include "components/password_manager/core/browser/leak_detection/leak_detection_delegate_interface.h"
@@ -22,6 +24,18 @@
 namespace password_manager {
 namespace {
 
+// The maximum number of payloads prepared in parallel. Hashing a credential
+// takes a few megabytes of memory.
+constexpr int kMaxParallelPayloads = 4;
+
+// Returns the number of sequences on which payloads are prepared.
+int GetPayloadSequenceCount() {
+  if (base::SysInfo::IsLowEndDevice())
+    return 1;
+  return std::clamp(base::SysInfo::NumberOfProcessors() - 1, 1,
+                    kMaxParallelPayloads);
+}
+
 using HolderPtr = std::unique_ptr<BulkLeakCheckImpl::CredentialHolder>;
 HolderPtr RemoveFromQueue(BulkLeakCheckImpl::CredentialHolder* weak_holder,
                           base::circular_deque<HolderPtr>* queue) {
@@ -73,14 +87,17 @@ BulkLeakCheckImpl::BulkLeakCheckImpl(
     : delegate_(delegate),
       identity_manager_(identity_manager),
       url_loader_factory_(std::move(url_loader_factory)),
-      encryption_key_(CreateNewKey().value_or("")),
-      payload_task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
-          {base::TaskPriority::USER_VISIBLE,
-           base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN})) {
+      encryption_key_(CreateNewKey().value_or("")) {
   DCHECK(delegate_);
   DCHECK(identity_manager_);
   DCHECK(url_loader_factory_);
   DCHECK(!encryption_key_.empty());
+  const int sequence_count = GetPayloadSequenceCount();
+  for (int i = 0; i < sequence_count; ++i) {
+    payload_task_runners_.push_back(base::ThreadPool::CreateSequencedTaskRunner(
+        {base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN}));
+  }
 }
 
 BulkLeakCheckImpl::~BulkLeakCheckImpl() = default;
@@ -93,8 +110,12 @@ void BulkLeakCheckImpl::CheckCredentials(
         std::make_unique<CredentialHolder>(std::move(c)));
     const LeakCheckCredential& credential =
         waiting_encryption_.back()->credential;
+    base::SequencedTaskRunner& payload_task_runner =
+        *payload_task_runners_[next_payload_task_runner_];
+    next_payload_task_runner_ =
+        (next_payload_task_runner_ + 1) % payload_task_runners_.size();
     PrepareSingleLeakRequestData(
-        task_tracker_, *payload_task_runner_, initiator, encryption_key_,
+        task_tracker_, payload_task_runner, initiator, encryption_key_,
         base::UTF16ToUTF8(credential.username()),
         base::UTF16ToUTF8(credential.password()),
         base::BindOnce(&BulkLeakCheckImpl::OnPayloadReady,
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "base/containers/circular_deque.h"
 #include "base/memory/raw_ptr.h"
@@ -38,8 +39,9 @@ struct SingleLookupResponse;
 // - get the access token.
 // - make a network request.
 // - decrypt the response.
-// Encryption/decryption part is expensive and, therefore, done only on one
-// background sequence.
+// Encryption/decryption part is expensive and, therefore, done on background
+// sequences. Payloads are prepared on a few sequences in parallel, bounded
+// because every hash takes a lot of memory.
 class BulkLeakCheckImpl : public BulkLeakCheck {
  public:
   struct CredentialHolder;
@@ -120,9 +122,14 @@ class BulkLeakCheckImpl : public BulkLeakCheck {
   // The queue of the requests waiting for server response decoding.
   base::circular_deque<std::unique_ptr<CredentialHolder>> waiting_decryption_;
 
-  // Task runner for preparing the payload. It takes a lot of memory. Therefore,
-  // those tasks aren't parallelized.
-  scoped_refptr<base::SequencedTaskRunner> payload_task_runner_;
+  // Task runners for preparing the payloads, which are used in turn. Preparing
+  // a payload takes a lot of memory. Therefore, the parallelism is bounded by
+  // the number of task runners.
+  std::vector<scoped_refptr<base::SequencedTaskRunner>> payload_task_runners_;
+
+  // The index of the task runner in |payload_task_runners_| that prepares the
+  // next payload.
+  size_t next_payload_task_runner_ = 0;
 
   // Cancels pending encryption tasks when destructing.
   base::CancelableTaskTracker task_tracker_;
@@ -6,21 +6,20 @@
 
 #include <memory>
 
+#include "base/feature_list.h"
 #include "base/functional/bind.h"
 #include "base/task/sequenced_task_runner.h"
 #include "components/os_crypt/sync/os_crypt.h"
+#include "components/password_manager/core/browser/features/password_features.h"
 #include "components/password_manager/core/browser/password_manager_buildflags.h"
 #include "components/password_manager/core/browser/password_store/login_database.h"
+#include "components/password_manager/core/browser/password_store/matching_logins_index.h"
 #include "components/password_manager/core/browser/sync/password_proto_utils.h"
 #include "components/password_manager/core/browser/sync/password_sync_bridge.h"
 #include "components/sync/base/model_type.h"
 #include "components/sync/model/client_tag_based_model_type_processor.h"
 #include "components/sync/model/model_type_controller_delegate.h"
 
-#if !BUILDFLAG(USE_LOGIN_DATABASE_AS_BACKEND)
-#include "components/password_manager/core/browser/features/password_features.h"
-#endif
-
 namespace password_manager {
 
 namespace {
@@ -144,6 +143,18 @@ LoginsResultOrError LoginDatabaseAsyncHelper::FillMatchingLogins(
     const std::vector<PasswordFormDigest>& forms,
     bool include_psl) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (MatchingLoginsIndex* index = GetOrCreateLoginsIndex()) {
+    std::vector<PasswordForm> results;
+    for (const auto& form : forms) {
+      std::vector<PasswordForm> matched_forms =
+          index->GetLogins(form, include_psl);
+      results.insert(results.end(),
+                     std::make_move_iterator(matched_forms.begin()),
+                     std::make_move_iterator(matched_forms.end()));
+    }
+    return results;
+  }
+
   std::vector<PasswordForm> results;
   for (const auto& form : forms) {
     std::vector<PasswordForm> matched_forms;
@@ -215,6 +226,7 @@ PasswordChangesOrError LoginDatabaseAsyncHelper::RemoveLogin(
     const PasswordForm& form) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   BeginTransaction();
+  logins_index_.reset();
   PasswordStoreChangeList changes;
   if (login_db_ && login_db_->RemoveLogin(form, &changes)) {
     if (password_sync_bridge_ && !changes.empty()) {
@@ -235,6 +247,7 @@ PasswordChangesOrError LoginDatabaseAsyncHelper::RemoveLoginsCreatedBetween(
     base::Time delete_end) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   BeginTransaction();
+  logins_index_.reset();
   PasswordStoreChangeList changes;
   bool success = login_db_ && login_db_->RemoveLoginsCreatedBetween(
                                   delete_begin, delete_end, &changes);
@@ -260,6 +273,7 @@ PasswordChangesOrError LoginDatabaseAsyncHelper::RemoveLoginsByURLAndTime(
     base::OnceCallback<void(bool)> sync_completion) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   BeginTransaction();
+  logins_index_.reset();
   std::vector<PasswordForm> forms;
   PasswordStoreChangeList changes;
   bool success = login_db_ && login_db_->GetLoginsCreatedBetween(
@@ -308,6 +322,7 @@ PasswordChangesOrError LoginDatabaseAsyncHelper::RemoveLoginsByURLAndTime(
 PasswordStoreChangeList LoginDatabaseAsyncHelper::DisableAutoSignInForOrigins(
     const base::RepeatingCallback<bool(const GURL&)>& origin_filter) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  logins_index_.reset();
   std::vector<PasswordForm> forms;
   PasswordStoreChangeList changes;
   if (!login_db_ || !login_db_->GetAutoSignInLogins(&forms))
@@ -433,6 +448,7 @@ bool LoginDatabaseAsyncHelper::BeginTransaction() {
 
 void LoginDatabaseAsyncHelper::RollbackTransaction() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  logins_index_.reset();
   if (login_db_)
     login_db_->RollbackTransaction();
 }
@@ -466,6 +482,7 @@ PasswordStoreChangeList
 LoginDatabaseAsyncHelper::RemoveCredentialByPrimaryKeySync(
     FormPrimaryKey primary_key) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  logins_index_.reset();
   PasswordStoreChangeList changes;
   if (login_db_ && login_db_->RemoveLoginByPrimaryKey(primary_key, &changes)) {
     return changes;
@@ -485,12 +502,14 @@ bool LoginDatabaseAsyncHelper::IsAccountStore() const {
 
 bool LoginDatabaseAsyncHelper::DeleteAndRecreateDatabaseFile() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  logins_index_.reset();
   return login_db_ && login_db_->DeleteAndRecreateDatabaseFile();
 }
 
 DatabaseCleanupResult
 LoginDatabaseAsyncHelper::DeleteUndecryptableCredentials() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  logins_index_.reset();
   if (!login_db_)
     return DatabaseCleanupResult::kDatabaseUnavailable;
   return login_db_->DeleteUndecryptableLogins();
@@ -500,6 +519,7 @@ PasswordStoreChangeList LoginDatabaseAsyncHelper::AddLoginImpl(
     const PasswordForm& form,
     AddCredentialError* error) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  logins_index_.reset();
   if (!login_db_) {
     if (error) {
       *error = AddCredentialError::kDbNotAvailable;
@@ -513,6 +533,7 @@ PasswordStoreChangeList LoginDatabaseAsyncHelper::UpdateLoginImpl(
     const PasswordForm& form,
     UpdateCredentialError* error) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  logins_index_.reset();
   if (!login_db_) {
     if (error) {
       *error = UpdateCredentialError::kDbNotAvailable;
@@ -522,6 +543,23 @@ PasswordStoreChangeList LoginDatabaseAsyncHelper::UpdateLoginImpl(
   return login_db_->UpdateLogin(form, error);
 }
 
+MatchingLoginsIndex* LoginDatabaseAsyncHelper::GetOrCreateLoginsIndex() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!login_db_ ||
+      !base::FeatureList::IsEnabled(features::kLoginDatabaseInMemoryIndex)) {
+    return nullptr;
+  }
+  if (!logins_index_) {
+    std::vector<PasswordForm> forms;
+    // On errors, keep querying the database, which handles them per request.
+    if (login_db_->GetAllLogins(&forms) != FormRetrievalResult::kSuccess) {
+      return nullptr;
+    }
+    logins_index_.emplace(std::move(forms));
+  }
+  return &*logins_index_;
+}
+
 // Reports password store metrics that aren't reported by the
 // StoreMetricsReporter. Namely, metrics related to inaccessible passwords,
 // and bubble statistics.
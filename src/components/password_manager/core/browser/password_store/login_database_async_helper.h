@@ -5,10 +5,13 @@
 #ifndef COMPONENTS_PASSWORD_MANAGER_CORE_BROWSER_PASSWORD_STORE_LOGIN_DATABASE_ASYNC_HELPER_H_
 #define COMPONENTS_PASSWORD_MANAGER_CORE_BROWSER_PASSWORD_STORE_LOGIN_DATABASE_ASYNC_HELPER_H_
 
+#include <optional>
+
 #include "base/cancelable_callback.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "base/task/sequenced_task_runner.h"
+#include "components/password_manager/core/browser/password_store/matching_logins_index.h"
 #include "components/password_manager/core/browser/password_store/password_store_backend.h"
 #include "components/password_manager/core/browser/sync/password_store_sync.h"
 #include "components/sync/model/wipe_model_upon_sync_disabled_behavior.h"
@@ -114,6 +117,10 @@ class LoginDatabaseAsyncHelper : private PasswordStoreSync {
   PasswordStoreChangeList UpdateLoginImpl(const PasswordForm& form,
                                           UpdateCredentialError* error);
 
+  // Returns the index of all logins, creating it if needed, or null if the
+  // index is disabled or the logins can't be read.
+  MatchingLoginsIndex* GetOrCreateLoginsIndex();
+
   // Reports password store metrics that aren't reported by the
   // StoreMetricsReporter. Namely, metrics related to inaccessible passwords,
   // and bubble statistics.
@@ -130,6 +137,12 @@ class LoginDatabaseAsyncHelper : private PasswordStoreSync {
   std::unique_ptr<LoginDatabase> login_db_
       GUARDED_BY_CONTEXT(sequence_checker_);
 
+  // In-memory copy of the logins in |login_db_| that answers
+  // FillMatchingLogins(). It is reset whenever the logins are modified and
+  // recreated on the next lookup.
+  std::optional<MatchingLoginsIndex> logins_index_
+      GUARDED_BY_CONTEXT(sequence_checker_);
+
   const syncer::WipeModelUponSyncDisabledBehavior
       wipe_model_upon_sync_disabled_behavior_;
   std::unique_ptr<PasswordSyncBridge> password_sync_bridge_
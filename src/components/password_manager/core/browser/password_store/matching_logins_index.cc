@@ -0,0 +1,112 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/password_manager/core/browser/password_store/matching_logins_index.h"
+
+#include <string_view>
+
+#include "base/ranges/algorithm.h"
+#include "base/strings/string_util.h"
+#include "components/password_manager/core/browser/password_store/psl_matching_helper.h"
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "url/gurl.h"
+
+namespace password_manager {
+
+namespace {
+
+using DomainAndLogin = std::pair<std::string, PasswordForm>;
+
+// Returns the registry-controlled domain of |host|, or |host| itself if it has
+// none, e.g., for IP addresses.
+std::string GetDomainOfHost(std::string_view host) {
+  std::string lower_host = base::ToLowerASCII(host);
+  std::string domain = net::registry_controlled_domains::GetDomainAndRegistry(
+      lower_host,
+      net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+  return domain.empty() ? lower_host : domain;
+}
+
+// Returns the domain of the host in |signon_realm|. Signon realms are not
+// necessarily valid URLs (e.g. "federation://example.com/idp.com"), so the
+// host is extracted by hand.
+std::string GetDomainOfSignonRealm(std::string_view signon_realm) {
+  size_t host_begin = signon_realm.find("://");
+  if (host_begin == std::string_view::npos) {
+    return std::string(signon_realm);
+  }
+  std::string_view authority = signon_realm.substr(host_begin + 3);
+  authority = authority.substr(0, authority.find_first_of("/?#"));
+  size_t userinfo_end = authority.rfind('@');
+  if (userinfo_end != std::string_view::npos) {
+    authority = authority.substr(userinfo_end + 1);
+  }
+  return GetDomainOfHost(authority.substr(0, authority.rfind(':')));
+}
+
+// Mirrors the SQL queries and the filtering in LoginDatabase::GetLogins().
+bool IsMatchingLogin(const PasswordForm& login,
+                     const PasswordFormDigest& form,
+                     bool should_PSL_matching_apply) {
+  switch (GetMatchResult(login, form)) {
+    case MatchResult::NO_MATCH:
+      return false;
+    case MatchResult::EXACT_MATCH:
+      return true;
+    case MatchResult::PSL_MATCH:
+      return should_PSL_matching_apply;
+    case MatchResult::FEDERATED_MATCH:
+    case MatchResult::FEDERATED_PSL_MATCH:
+      return login.type == PasswordForm::Type::kApi &&
+             (should_PSL_matching_apply ||
+              IsFederatedRealm(login.signon_realm, form.url));
+  }
+}
+
+}  // namespace
+
+MatchingLoginsIndex::MatchingLoginsIndex(std::vector<PasswordForm> logins) {
+  logins_.reserve(logins.size());
+  for (PasswordForm& login : logins) {
+    std::string domain = GetDomainOfSignonRealm(login.signon_realm);
+    logins_.emplace_back(std::move(domain), std::move(login));
+  }
+  // Stable, so that the logins of a domain keep the order of the database.
+  base::ranges::stable_sort(logins_, {}, &DomainAndLogin::first);
+}
+
+MatchingLoginsIndex::MatchingLoginsIndex(MatchingLoginsIndex&&) = default;
+MatchingLoginsIndex& MatchingLoginsIndex::operator=(MatchingLoginsIndex&&) =
+    default;
+
+MatchingLoginsIndex::~MatchingLoginsIndex() = default;
+
+std::vector<PasswordForm> MatchingLoginsIndex::GetLogins(
+    const PasswordFormDigest& form,
+    bool should_PSL_matching_apply) const {
+  std::vector<std::string> domains = {
+      GetDomainOfSignonRealm(form.signon_realm)};
+  // Federated matches are found by the host of the form's URL, which usually
+  // shares the domain with the signon realm.
+  if (form.scheme == PasswordForm::Scheme::kHtml) {
+    std::string url_domain = GetDomainOfHost(form.url.host_piece());
+    if (url_domain != domains[0]) {
+      domains.push_back(std::move(url_domain));
+    }
+  }
+
+  std::vector<PasswordForm> results;
+  for (const std::string& domain : domains) {
+    auto [begin, end] = base::ranges::equal_range(logins_, domain, {},
+                                                  &DomainAndLogin::first);
+    for (auto it = begin; it != end; ++it) {
+      if (IsMatchingLogin(it->second, form, should_PSL_matching_apply)) {
+        results.push_back(it->second);
+      }
+    }
+  }
+  return results;
+}
+
+}  // namespace password_manager
@@ -0,0 +1,47 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_PASSWORD_MANAGER_CORE_BROWSER_PASSWORD_STORE_MATCHING_LOGINS_INDEX_H_
+#define COMPONENTS_PASSWORD_MANAGER_CORE_BROWSER_PASSWORD_STORE_MATCHING_LOGINS_INDEX_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "components/password_manager/core/browser/password_form.h"
+#include "components/password_manager/core/browser/password_form_digest.h"
+
+namespace password_manager {
+
+// An in-memory copy of all logins of a LoginDatabase, which answers the same
+// queries as LoginDatabase::GetLogins() without a database round trip.
+//
+// The logins are sorted by the registry-controlled domain of their signon
+// realm. Exact, PSL and federated matches of a form share that domain, so a
+// lookup only needs to check the logins of a single domain.
+class MatchingLoginsIndex {
+ public:
+  // |logins| should be in the order in which the database returns them.
+  explicit MatchingLoginsIndex(std::vector<PasswordForm> logins);
+
+  MatchingLoginsIndex(const MatchingLoginsIndex&) = delete;
+  MatchingLoginsIndex& operator=(const MatchingLoginsIndex&) = delete;
+  MatchingLoginsIndex(MatchingLoginsIndex&&);
+  MatchingLoginsIndex& operator=(MatchingLoginsIndex&&);
+
+  ~MatchingLoginsIndex();
+
+  // Returns the logins matching |form| like LoginDatabase::GetLogins() does.
+  std::vector<PasswordForm> GetLogins(const PasswordFormDigest& form,
+                                      bool should_PSL_matching_apply) const;
+
+ private:
+  // Pairs of the domain of a login's signon realm and the login, sorted by
+  // domain.
+  std::vector<std::pair<std::string, PasswordForm>> logins_;
+};
+
+}  // namespace password_manager
+
+#endif  // COMPONENTS_PASSWORD_MANAGER_CORE_BROWSER_PASSWORD_STORE_MATCHING_LOGINS_INDEX_H_
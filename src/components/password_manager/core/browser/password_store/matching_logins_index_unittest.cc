@@ -0,0 +1,111 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/password_manager/core/browser/password_store/matching_logins_index.h"
+
+#include <string>
+#include <vector>
+
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+#include "url/origin.h"
+
+namespace password_manager {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+PasswordForm CreateLogin(const std::string& signon_realm,
+                         const std::string& url,
+                         const std::u16string& username) {
+  PasswordForm form;
+  form.signon_realm = signon_realm;
+  form.url = GURL(url);
+  form.username_value = username;
+  form.password_value = u"password";
+  form.scheme = PasswordForm::Scheme::kHtml;
+  return form;
+}
+
+PasswordForm CreateFederatedLogin(const std::string& url,
+                                  const std::u16string& username) {
+  PasswordForm form = CreateLogin(
+      "federation://" + GURL(url).host() + "/accounts.federated.com", url,
+      username);
+  form.type = PasswordForm::Type::kApi;
+  form.federation_origin =
+      url::Origin::Create(GURL("https://accounts.federated.com/"));
+  return form;
+}
+
+std::vector<std::u16string> GetUsernames(const MatchingLoginsIndex& index,
+                                         const PasswordFormDigest& form,
+                                         bool should_PSL_matching_apply) {
+  std::vector<std::u16string> usernames;
+  for (const PasswordForm& login :
+       index.GetLogins(form, should_PSL_matching_apply)) {
+    usernames.push_back(login.username_value);
+  }
+  return usernames;
+}
+
+MatchingLoginsIndex CreateIndex() {
+  std::vector<PasswordForm> logins;
+  logins.push_back(CreateLogin("https://www.example.com/",
+                               "https://www.example.com/login", u"exact"));
+  logins.push_back(CreateLogin("https://other.com/", "https://other.com/",
+                               u"other"));
+  logins.push_back(CreateLogin("https://mobile.example.com/",
+                               "https://mobile.example.com/", u"psl"));
+  logins.push_back(CreateLogin("http://www.example.com/",
+                               "http://www.example.com/", u"http"));
+  logins.push_back(
+      CreateFederatedLogin("https://www.example.com/", u"federated"));
+  logins.push_back(
+      CreateFederatedLogin("https://mobile.example.com/", u"federated_psl"));
+  logins.push_back(CreateLogin("https://www.example.com/",
+                               "https://www.example.com/", u"exact2"));
+  return MatchingLoginsIndex(std::move(logins));
+}
+
+TEST(MatchingLoginsIndexTest, ExactAndFederatedMatches) {
+  MatchingLoginsIndex index = CreateIndex();
+  PasswordFormDigest form(PasswordForm::Scheme::kHtml,
+                          "https://www.example.com/",
+                          GURL("https://www.example.com/"));
+  EXPECT_THAT(GetUsernames(index, form, /*should_PSL_matching_apply=*/false),
+              ElementsAre(u"exact", u"federated", u"exact2"));
+}
+
+TEST(MatchingLoginsIndexTest, PSLMatches) {
+  MatchingLoginsIndex index = CreateIndex();
+  PasswordFormDigest form(PasswordForm::Scheme::kHtml,
+                          "https://www.example.com/",
+                          GURL("https://www.example.com/"));
+  EXPECT_THAT(GetUsernames(index, form, /*should_PSL_matching_apply=*/true),
+              ElementsAre(u"exact", u"psl", u"federated", u"federated_psl",
+                          u"exact2"));
+}
+
+TEST(MatchingLoginsIndexTest, NonHtmlFormsOnlyMatchExactly) {
+  MatchingLoginsIndex index = CreateIndex();
+  PasswordFormDigest form(PasswordForm::Scheme::kBasic,
+                          "https://www.example.com/",
+                          GURL("https://www.example.com/"));
+  EXPECT_THAT(GetUsernames(index, form, /*should_PSL_matching_apply=*/true),
+              ElementsAre(u"exact", u"exact2"));
+}
+
+TEST(MatchingLoginsIndexTest, NoMatches) {
+  MatchingLoginsIndex index = CreateIndex();
+  PasswordFormDigest form(PasswordForm::Scheme::kHtml, "https://unknown.com/",
+                          GURL("https://unknown.com/"));
+  EXPECT_THAT(GetUsernames(index, form, /*should_PSL_matching_apply=*/true),
+              IsEmpty());
+}
+
+}  // namespace
+}  // namespace password_manager
@@ -763,6 +763,39 @@ TEST_F(PasswordStoreBuiltInBackendTest,
   histogram_tester.ExpectBucketCount(kSuccessMetric, true, 1);
 }
 
+TEST_F(PasswordStoreBuiltInBackendTest, FillMatchingLoginsFromInMemoryIndex) {
+  base::test::ScopedFeatureList feature_list(
+      features::kLoginDatabaseInMemoryIndex);
+  PasswordStoreBackend* backend = Initialize();
+  PasswordForm form = *FillPasswordFormWithData(CreateTestPasswordFormData());
+  backend->AddLoginAsync(form, base::DoNothing());
+  RunUntilIdle();
+
+  const PasswordFormDigest digest(PasswordForm::Scheme::kHtml,
+                                  form.signon_realm, form.url);
+  base::MockCallback<LoginsOrErrorReply> mock_reply;
+  EXPECT_CALL(mock_reply, Run(VariantWith<LoginsResult>(ElementsAre(form))));
+  backend->FillMatchingLoginsAsync(mock_reply.Get(), /*include_psl=*/false,
+                                   {digest});
+  RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&mock_reply);
+
+  // Modifications are reflected by subsequent lookups.
+  form.password_value = u"a different password";
+  backend->UpdateLoginAsync(form, base::DoNothing());
+  EXPECT_CALL(mock_reply, Run(VariantWith<LoginsResult>(ElementsAre(form))));
+  backend->FillMatchingLoginsAsync(mock_reply.Get(), /*include_psl=*/false,
+                                   {digest});
+  RunUntilIdle();
+  testing::Mock::VerifyAndClearExpectations(&mock_reply);
+
+  backend->RemoveLoginAsync(FROM_HERE, form, base::DoNothing());
+  EXPECT_CALL(mock_reply, Run(VariantWith<LoginsResult>(testing::IsEmpty())));
+  backend->FillMatchingLoginsAsync(mock_reply.Get(), /*include_psl=*/false,
+                                   {digest});
+  RunUntilIdle();
+}
+
 TEST_F(PasswordStoreBuiltInBackendTest, GetLoginsWithAffiliations) {
   affiliations::FakeAffiliationService fake_affiliation_service;
   MockAffiliatedMatchHelper mock_affiliated_match_helper(
@@ -53,10 +53,18 @@
 
 namespace pdf {
 
+BASE_FEATURE(kPdfIncrementalAccessibilityTree,
+             "PdfIncrementalAccessibilityTree",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 namespace ranges = base::ranges;
 
 namespace {
 
+// With `kPdfIncrementalAccessibilityTree`, the number of pages whose nodes are
+// grafted onto the tree at once while the rest of the PDF is still arriving.
+constexpr uint32_t kPagesPerIncrementalUpdate = 10;
+
 // Delay before loading all the PDF content into the accessibility tree and
 // resetting the banner and status nodes in an accessibility tree.
 constexpr base::TimeDelta kDelayBeforeResettingStatusNode = base::Seconds(1);
@@ -612,6 +620,17 @@ void PdfAccessibilityTree::DoSetAccessibilityPageInfo(
     } else {
       UnserializeNodes();
     }
+    return;
+  }
+
+  // Let assistive technology reach the first pages of a long PDF without
+  // waiting for the rest, and avoid unserializing every page in one go. OCR
+  // expects the nodes to stay in `nodes_` until the last page, so only do this
+  // when it can't run.
+  if (base::FeatureList::IsEnabled(kPdfIncrementalAccessibilityTree) &&
+      !features::IsPdfOcrEnabled() &&
+      next_page_index_ % kPagesPerIncrementalUpdate == 0) {
+    UnserializePendingNodes();
   }
 }
 
@@ -636,10 +655,10 @@ void PdfAccessibilityTree::AddPageContent(
   tree_builder.BuildPageTree();
 }
 
-void PdfAccessibilityTree::UnserializeNodes() {
+bool PdfAccessibilityTree::UnserializePendingNodes() {
   auto obj = GetPluginContainerAXObject();
   if (!obj) {
-    return;
+    return false;
   }
 
   doc_node_->relative_bounds.transform = MakeTransformFromViewInfo();
@@ -662,6 +681,13 @@ void PdfAccessibilityTree::UnserializeNodes() {
   MarkPluginContainerDirty();
 
   nodes_.clear();
+  return true;
+}
+
+void PdfAccessibilityTree::UnserializeNodes() {
+  if (!UnserializePendingNodes()) {
+    return;
+  }
 
   if (!sent_metrics_once_) {
     // If the user turns on PDF OCR after opening a PDF, its PDF a11y tree gets
@@ -10,6 +10,7 @@
 #include <optional>
 #include <vector>
 
+#include "base/feature_list.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
 #include "content/public/renderer/plugin_ax_tree_action_target_adapter.h"
@@ -56,6 +57,10 @@ struct AXTreeUpdate;
 
 namespace pdf {
 
+// When enabled, the nodes of a large PDF are grafted onto the tree in batches
+// of pages as they arrive, instead of all at once after the last page.
+BASE_DECLARE_FEATURE(kPdfIncrementalAccessibilityTree);
+
 class PdfAccessibilityTree : public ui::AXTreeSource<const ui::AXNode*,
                                                      ui::AXTreeData*,
                                                      ui::AXNodeData>,
@@ -198,6 +203,10 @@ class PdfAccessibilityTree : public ui::AXTreeSource<const ui::AXNode*,
   // onto the host tree.
   void UnserializeNodes();
 
+  // Grafts the nodes of the pages received since the last call onto the
+  // tree. Returns false if there is no plugin container to graft onto.
+  bool UnserializePendingNodes();
+
 #if BUILDFLAG(ENABLE_SCREEN_AI_SERVICE)
   // Called after the OCR data for all images in the PDF have been received.
   // Set the status node with the OCR completion message.
@@ -31,6 +31,7 @@
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_settings.h"
 #include "third_party/blink/public/web/web_view.h"
+#include "ui/accessibility/accessibility_features.h"
 #include "ui/accessibility/ax_action_data.h"
 #include "ui/accessibility/ax_enums.mojom.h"
 #include "ui/accessibility/ax_event_generator.h"
@@ -487,6 +488,49 @@ TEST_F(PdfAccessibilityTreeTest, TestPdfAccessibilityTreeReload) {
   }
 }
 
+TEST_F(PdfAccessibilityTreeTest, TestIncrementalTreeCreation) {
+  base::test::ScopedFeatureList scoped_feature_list;
+  scoped_feature_list.InitWithFeatures(
+      /*enabled_features=*/{kPdfIncrementalAccessibilityTree},
+      /*disabled_features=*/{::features::kPdfOcr});
+
+  // More pages than fit in a single incremental update.
+  constexpr uint32_t kPageCount = 12;
+  doc_info_.page_count = kPageCount;
+  CreatePdfAccessibilityTree();
+  pdf_accessibility_tree_->SetAccessibilityViewportInfo(viewport_info_);
+  pdf_accessibility_tree_->SetAccessibilityDocInfo(doc_info_);
+  WaitForThreadTasks();
+
+  auto send_page = [&](uint32_t page_index) {
+    page_info_.page_index = page_index;
+    pdf_accessibility_tree_->SetAccessibilityPageInfo(page_info_, text_runs_,
+                                                      chars_, page_objects_);
+    WaitForThreadTasks();
+  };
+
+  ui::AXNode* root_node = pdf_accessibility_tree_->GetRoot();
+  ASSERT_TRUE(root_node);
+  for (uint32_t i = 0; i < 9; ++i) {
+    send_page(i);
+  }
+  // Only the status node wrapper until the first batch is complete.
+  EXPECT_EQ(1u, root_node->GetChildCount());
+
+  send_page(9);
+  EXPECT_EQ(11u, root_node->GetChildCount());
+  send_page(10);
+  EXPECT_EQ(11u, root_node->GetChildCount());
+
+  send_page(11);
+  WaitForThreadDelayedTasks();
+  EXPECT_EQ(kPageCount + 1, root_node->GetChildCount());
+  for (size_t i = 1; i < root_node->GetChildCount(); ++i) {
+    EXPECT_EQ(ax::mojom::Role::kRegion,
+              root_node->GetChildAtIndex(i)->GetRole());
+  }
+}
+
 TEST_F(PdfAccessibilityTreeTest, TestPdfAccessibilityTreeCreation) {
   static const char kTestAltText[] = "Alternate text for image";
 
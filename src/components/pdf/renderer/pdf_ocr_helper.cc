@@ -12,6 +12,15 @@
 
 namespace pdf {
 
+namespace {
+
+// The number of images sent to the OCR service before its first result comes
+// back. Fetching and sending the next image while the service works on the
+// previous one keeps it busy on scanned PDFs with many pages.
+constexpr size_t kMaxRequestsInFlight = 3u;
+
+}  // namespace
+
 //
 // PdfOcrRequest
 //
@@ -71,6 +80,12 @@ void PdfOcrHelper::Reset(ui::AXNodeID root_node_id, uint32_t page_count) {
     all_requests_.pop();
   }
 
+  // Drop the results of requests that are still with the OCR service.
+  weak_ptr_factory_.InvalidateWeakPtrs();
+  requests_in_flight_ = 0u;
+  pending_results_.clear();
+  next_result_sequence_number_ = next_sequence_number_;
+
   is_ocr_in_progress_ = false;
 }
 
@@ -92,10 +107,8 @@ void PdfOcrHelper::OcrPage(base::queue<PdfOcrRequest> page_requests) {
     all_requests_.push(page_requests.front());
     page_requests.pop();
   }
-  if (!is_ocr_in_progress_) {
-    is_ocr_in_progress_ = true;
-    OcrNextImage();
-  }
+  is_ocr_in_progress_ = true;
+  OcrNextImages();
 }
 
 bool PdfOcrHelper::AreAllPagesOcred() const {
@@ -119,32 +132,37 @@ void PdfOcrHelper::ResetRemainingPageCountForTesting() {
   remaining_page_count_ = 0;
 }
 
-void PdfOcrHelper::OcrNextImage() {
+void PdfOcrHelper::OcrNextImages() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
-  if (all_requests_.empty()) {
-    return;
-  }
-  PdfOcrRequest request = all_requests_.front();
-  all_requests_.pop();
-
-  SkBitmap bitmap = image_fetcher_->GetImageForOcr(
-      request.page_index, request.image.page_object_index);
-  request.image_pixel_size = gfx::SizeF(bitmap.width(), bitmap.height());
-  if (bitmap.drawsNothing()) {
-    ReceiveOcrResultsForImage(std::move(request), ui::AXTreeUpdate());
-    return;
-  }
+  while (!all_requests_.empty() &&
+         requests_in_flight_ < kMaxRequestsInFlight) {
+    PdfOcrRequest request = all_requests_.front();
+    all_requests_.pop();
+    const uint64_t sequence_number = next_sequence_number_++;
+    ++requests_in_flight_;
+
+    SkBitmap bitmap = image_fetcher_->GetImageForOcr(
+        request.page_index, request.image.page_object_index);
+    request.image_pixel_size = gfx::SizeF(bitmap.width(), bitmap.height());
+    if (bitmap.drawsNothing()) {
+      ReceiveOcrResultsForImage(sequence_number, std::move(request),
+                                ui::AXTreeUpdate());
+      return;
+    }
 
-  screen_ai_annotator_->PerformOcrAndReturnAXTreeUpdate(
-      std::move(bitmap),
-      base::BindOnce(&PdfOcrHelper::ReceiveOcrResultsForImage,
-                     weak_ptr_factory_.GetWeakPtr(), std::move(request)));
+    screen_ai_annotator_->PerformOcrAndReturnAXTreeUpdate(
+        std::move(bitmap),
+        base::BindOnce(&PdfOcrHelper::ReceiveOcrResultsForImage,
+                       weak_ptr_factory_.GetWeakPtr(), sequence_number,
+                       std::move(request)));
 
-  base::UmaHistogramEnumeration("Accessibility.PdfOcr.PDFImages",
-                                PdfOcrRequestStatus::kRequested);
+    base::UmaHistogramEnumeration("Accessibility.PdfOcr.PDFImages",
+                                  PdfOcrRequestStatus::kRequested);
+  }
 }
 
 void PdfOcrHelper::ReceiveOcrResultsForImage(
+    uint64_t sequence_number,
     PdfOcrRequest request,
     const ui::AXTreeUpdate& tree_update) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
@@ -152,6 +170,28 @@ void PdfOcrHelper::ReceiveOcrResultsForImage(
   base::UmaHistogramEnumeration("Accessibility.PdfOcr.PDFImages",
                                 PdfOcrRequestStatus::kPerformed);
 
+  CHECK_GT(requests_in_flight_, 0u);
+  --requests_in_flight_;
+  pending_results_.emplace(sequence_number,
+                           std::make_pair(std::move(request), tree_update));
+  while (!pending_results_.empty() &&
+         pending_results_.begin()->first == next_result_sequence_number_) {
+    auto result = pending_results_.extract(pending_results_.begin());
+    ++next_result_sequence_number_;
+    AddResultToBatch(std::move(result.mapped().first), result.mapped().second);
+  }
+
+  if (all_requests_.empty() && requests_in_flight_ == 0u) {
+    is_ocr_in_progress_ = false;
+  } else {
+    OcrNextImages();
+  }
+}
+
+void PdfOcrHelper::AddResultToBatch(PdfOcrRequest request,
+                                    const ui::AXTreeUpdate& tree_update) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
   // Ignore the result if the tree has changed.
   if (request.root_node_id != root_node_id_) {
     VLOG(1) << "Tree update for stale tree ignored.";
@@ -171,11 +211,6 @@ void PdfOcrHelper::ReceiveOcrResultsForImage(
                                          std::move(batch_tree_updates_));
     }
   }
-  if (all_requests_.empty()) {
-    is_ocr_in_progress_ = false;
-  } else {
-    OcrNextImage();
-  }
 }
 
 }  // namespace pdf
@@ -5,6 +5,8 @@
 #ifndef COMPONENTS_PDF_RENDERER_PDF_OCR_HELPER_H_
 #define COMPONENTS_PDF_RENDERER_PDF_OCR_HELPER_H_
 
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "base/containers/queue.h"
@@ -96,9 +98,14 @@ class PdfOcrHelper final {
 
  private:
   static uint32_t ComputePagesPerBatch(uint32_t page_count);
-  void OcrNextImage();
-  void ReceiveOcrResultsForImage(PdfOcrRequest request,
+  // Sends queued requests to the OCR service until `kMaxRequestsInFlight` are
+  // outstanding, so that the service doesn't idle between images.
+  void OcrNextImages();
+  void ReceiveOcrResultsForImage(uint64_t sequence_number,
+                                 PdfOcrRequest request,
                                  const ui::AXTreeUpdate& tree_update);
+  void AddResultToBatch(PdfOcrRequest request,
+                        const ui::AXTreeUpdate& tree_update);
 
   // `image_fetcher_` owns `this`.
   const raw_ptr<chrome_pdf::PdfAccessibilityImageFetcher> image_fetcher_;
@@ -107,12 +114,17 @@ class PdfOcrHelper final {
   uint32_t remaining_page_count_;
   ui::AXNodeID root_node_id_;
 
-  // True if there are pending OCR requests. Used to determine if `OcrPage`
-  // should call `OcrNextImage` or if the next call to
-  // `ReceiveOcrResultsForImage` should do it instead. This avoids the
-  // possibility of processing requests in the wrong order.
+  // True if there are queued or outstanding OCR requests.
   bool is_ocr_in_progress_ = false;
 
+  // Requests are numbered as they are sent to the OCR service, and their
+  // results are batched in that order even if they arrive out of order.
+  size_t requests_in_flight_ = 0u;
+  uint64_t next_sequence_number_ = 0u;
+  uint64_t next_result_sequence_number_ = 0u;
+  std::map<uint64_t, std::pair<PdfOcrRequest, ui::AXTreeUpdate>>
+      pending_results_;
+
   // A PDF is made up of a number of pages, and each page might have one or
   // more inaccessible images that need to be OCRed. This queue could contain
   // the OCR requests for all the images on several pages, so the requests
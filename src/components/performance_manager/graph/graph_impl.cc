@@ -13,6 +13,7 @@
 #include "base/containers/map_util.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback_helpers.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/notreached.h"
 #include "components/performance_manager/graph/frame_node_impl.h"
 #include "components/performance_manager/graph/node_base.h"
@@ -120,6 +121,22 @@ base::Value::Dict NodeDataDescriberRegistryImpl::DescribeNodeData(
 
 }  // namespace
 
+GraphImpl::ScopedNotificationBatch::ScopedNotificationBatch(GraphImpl* graph)
+    : graph_(graph) {
+  graph_->BeginNotificationBatch();
+}
+
+GraphImpl::ScopedNotificationBatch::~ScopedNotificationBatch() {
+  graph_->EndNotificationBatch();
+}
+
+GraphImpl::DeferredNotifications::DeferredNotifications() = default;
+GraphImpl::DeferredNotifications::~DeferredNotifications() = default;
+GraphImpl::DeferredNotifications::DeferredNotifications(
+    DeferredNotifications&& other) = default;
+GraphImpl::DeferredNotifications& GraphImpl::DeferredNotifications::operator=(
+    DeferredNotifications&& other) = default;
+
 GraphImpl::GraphImpl() {
   DETACH_FROM_SEQUENCE(sequence_checker_);
 }
@@ -130,6 +147,7 @@ GraphImpl::~GraphImpl() {
 
   // All graph registered and owned objects should have been cleaned up.
   DCHECK(graph_owned_.empty());
+  DCHECK_EQ(notification_batch_depth_, 0);
   DCHECK(registered_objects_.empty());
 
   // All process and frame nodes should have been removed already.
@@ -435,6 +453,9 @@ void GraphImpl::RemoveNode(NodeBase* node) {
   DCHECK_EQ(this, node->graph());
   DCHECK(!node_in_transition_);
 
+  // Observers hear about the changes of the node before it leaves the graph.
+  DispatchDeferredNotificationsForNode(node);
+
   // Walk the node through the latter half of its lifecycle. See NodeBase and
   // NodeState for full details of the lifecycle.
   node->OnBeforeLeavingGraph();
@@ -462,6 +483,33 @@ void GraphImpl::NotifyFrameNodeTearingDown(const FrameNode* frame_node) {
       frame_node);
 }
 
+void GraphImpl::DeferNotification(const NodeBase* node,
+                                  const void* property,
+                                  base::OnceClosure notification) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(IsBatchingNotifications());
+
+  // Start a new entry if the node has none yet, or if its entry was already
+  // dispatched by a node removal or by the end of the batch.
+  auto [it, inserted] = deferred_notifications_index_.try_emplace(
+      node, deferred_notifications_.size());
+  if (inserted || !deferred_notifications_[it->second].node) {
+    it->second = deferred_notifications_.size();
+    deferred_notifications_.emplace_back().node = node;
+  }
+
+  auto& notifications = deferred_notifications_[it->second].notifications;
+  for (const auto& [pending_property, pending_notification] : notifications) {
+    // The pending notification checks the value of the property when it runs,
+    // so it covers this change as well.
+    if (pending_property == property && pending_notification) {
+      ++coalesced_notification_count_;
+      return;
+    }
+  }
+  notifications.emplace_back(property, std::move(notification));
+}
+
 size_t GraphImpl::NodeDataDescriberCountForTesting() const {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   if (!describer_registry_)
@@ -613,6 +661,73 @@ void GraphImpl::RemoveNodeAttachedData(NodeBase* node) {
   node_attached_data_map_.erase(lower, upper);
 }
 
+void GraphImpl::BeginNotificationBatch() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (notification_batch_depth_++ == 0 &&
+      !is_dispatching_deferred_notifications_) {
+    notification_batch_start_time_ = base::TimeTicks::Now();
+  }
+}
+
+void GraphImpl::EndNotificationBatch() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK_GT(notification_batch_depth_, 0);
+  // The notifications deferred by a batch nested in an observer called while
+  // dispatching are picked up by the loop below.
+  if (--notification_batch_depth_ > 0 ||
+      is_dispatching_deferred_notifications_) {
+    return;
+  }
+  if (deferred_notifications_.empty()) {
+    return;
+  }
+
+  // Observers can defer more notifications, which grows the list, so it's
+  // indexed rather than iterated.
+  is_dispatching_deferred_notifications_ = true;
+  for (size_t i = 0; i < deferred_notifications_.size(); ++i) {
+    DispatchDeferredNotifications(i);
+  }
+  is_dispatching_deferred_notifications_ = false;
+
+  // The time the graph sequence spent on the batched changes, notifications
+  // included.
+  base::UmaHistogramMicrosecondsTimes(
+      "PerformanceManager.Graph.NotificationBatch.Duration",
+      base::TimeTicks::Now() - notification_batch_start_time_);
+  base::UmaHistogramCounts1000(
+      "PerformanceManager.Graph.NotificationBatch.CoalescedNotifications",
+      coalesced_notification_count_);
+
+  deferred_notifications_.clear();
+  deferred_notifications_index_.clear();
+  coalesced_notification_count_ = 0;
+}
+
+void GraphImpl::DispatchDeferredNotifications(size_t index) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // The entry is looked up on each iteration, as observers can grow the list
+  // or remove the node, which dispatches its remaining notifications.
+  for (size_t i = 0; deferred_notifications_[index].node &&
+                     i < deferred_notifications_[index].notifications.size();
+       ++i) {
+    base::OnceClosure notification =
+        std::move(deferred_notifications_[index].notifications[i].second);
+    if (notification) {
+      std::move(notification).Run();
+    }
+  }
+  deferred_notifications_[index].node = nullptr;
+}
+
+void GraphImpl::DispatchDeferredNotificationsForNode(const NodeBase* node) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto it = deferred_notifications_index_.find(node);
+  if (it != deferred_notifications_index_.end()) {
+    DispatchDeferredNotifications(it->second);
+  }
+}
+
 int64_t GraphImpl::GetNextNodeSerializationId() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   return ++current_node_serialization_id_;
@@ -13,11 +13,13 @@
 #include <utility>
 #include <vector>
 
+#include "base/functional/callback.h"
 #include "base/functional/function_ref.h"
 #include "base/memory/raw_ptr.h"
 #include "base/observer_list.h"
 #include "base/process/process_handle.h"
 #include "base/sequence_checker.h"
+#include "base/time/time.h"
 #include "components/performance_manager/execution_context/execution_context_registry_impl.h"
 #include "components/performance_manager/graph/initializing_frame_node_observer.h"
 #include "components/performance_manager/owned_objects.h"
@@ -51,6 +53,25 @@ class GraphImpl : public Graph {
 
   using NodeSet = std::unordered_set<raw_ptr<NodeBase, CtnExperimental>>;
 
+  // Batches the notifications of node property changes made while it is
+  // alive. When the outermost batch ends, each property that changed gets a
+  // single notification, or none if it changed back to its value from before
+  // the batch. The notifications are sent node by node, in the order in which
+  // the nodes first changed. The notifications of a node that is removed from
+  // the graph during the batch are sent before it's removed. Node addition and
+  // removal notifications are never deferred.
+  class ScopedNotificationBatch {
+   public:
+    explicit ScopedNotificationBatch(GraphImpl* graph);
+    ~ScopedNotificationBatch();
+
+    ScopedNotificationBatch(const ScopedNotificationBatch&) = delete;
+    ScopedNotificationBatch& operator=(const ScopedNotificationBatch&) = delete;
+
+   private:
+    const raw_ptr<GraphImpl> graph_;
+  };
+
   // An ObserverList that DCHECK's if any observers are still in it when the
   // graph is deleted. `allow_reentrancy` is true because some observers update
   // node properties that also trigger observers. (For example
@@ -162,6 +183,19 @@ class GraphImpl : public Graph {
   void NotifyFrameNodeInitializing(const FrameNode* frame_node);
   void NotifyFrameNodeTearingDown(const FrameNode* frame_node);
 
+  // Returns true while a ScopedNotificationBatch is alive.
+  bool IsBatchingNotifications() const {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    return notification_batch_depth_ > 0;
+  }
+
+  // Defers the |notification| of a change of |property| of |node| to the end
+  // of the current batch. Only the first notification deferred for a given
+  // |property| is kept, later ones are dropped.
+  void DeferNotification(const NodeBase* node,
+                         const void* property,
+                         base::OnceClosure notification);
+
   // A |key| of nullptr counts all instances associated with the |node|. A
   // |node| of null counts all instances associated with the |key|. If both are
   // null then the entire map size is provided.
@@ -215,8 +249,24 @@ class GraphImpl : public Graph {
   using ProcessByPidMap = std::map<base::ProcessId, ProcessNodeImpl*>;
   using FrameById = std::map<ProcessAndFrameId, FrameNodeImpl*>;
 
+  // The notifications deferred for a node during a batch.
+  struct DeferredNotifications {
+    DeferredNotifications();
+    ~DeferredNotifications();
+    DeferredNotifications(DeferredNotifications&& other);
+    DeferredNotifications& operator=(DeferredNotifications&& other);
+
+    // Null once the notifications have been dispatched.
+    raw_ptr<const NodeBase> node;
+    std::vector<std::pair<const void*, base::OnceClosure>> notifications;
+  };
+
   void DispatchNodeAddedNotifications(NodeBase* node);
   void DispatchNodeRemovedNotifications(NodeBase* node);
+  void BeginNotificationBatch();
+  void EndNotificationBatch();
+  void DispatchDeferredNotifications(size_t index);
+  void DispatchDeferredNotificationsForNode(const NodeBase* node);
   void RemoveNodeAttachedData(NodeBase* node);
 
   // Returns a new serialization ID.
@@ -319,6 +369,29 @@ class GraphImpl : public Graph {
   // explicitly in transition is automatically in the kActiveInGraph state.
   NodeState node_in_transition_state_ = NodeState::kNotInGraph;
 
+  // The number of nested ScopedNotificationBatch alive, and the time at which
+  // the outermost one was created.
+  int notification_batch_depth_ GUARDED_BY_CONTEXT(sequence_checker_) = 0;
+  base::TimeTicks notification_batch_start_time_
+      GUARDED_BY_CONTEXT(sequence_checker_);
+
+  // True while the notifications deferred by the outermost batch are being
+  // dispatched.
+  bool is_dispatching_deferred_notifications_
+      GUARDED_BY_CONTEXT(sequence_checker_) = false;
+
+  // The notifications deferred by the current batch, in the order in which
+  // the nodes first changed, and the index of each node in that list.
+  std::vector<DeferredNotifications> deferred_notifications_
+      GUARDED_BY_CONTEXT(sequence_checker_);
+  std::map<const NodeBase*, size_t> deferred_notifications_index_
+      GUARDED_BY_CONTEXT(sequence_checker_);
+
+  // The number of notifications dropped by the current batch because the
+  // property they notify was already pending.
+  size_t coalesced_notification_count_ GUARDED_BY_CONTEXT(sequence_checker_) =
+      0;
+
   SEQUENCE_CHECKER(sequence_checker_);
 };
 
@@ -11,6 +11,7 @@
 #include "base/process/process.h"
 #include "base/time/time.h"
 #include "components/performance_manager/graph/frame_node_impl.h"
+#include "components/performance_manager/graph/page_node_impl.h"
 #include "components/performance_manager/graph/process_node_impl.h"
 #include "components/performance_manager/graph/system_node_impl.h"
 #include "components/performance_manager/public/graph/node_data_describer.h"
@@ -349,6 +350,78 @@ void AssertDictValueContainsListKey(const base::Value::Dict& descr,
 
 }  // namespace
 
+namespace {
+
+class VisibilityChangeCounter : public PageNode::ObserverDefaultImpl {
+ public:
+  // PageNodeObserver:
+  void OnIsVisibleChanged(const PageNode* page_node) override { ++count_; }
+
+  int count() const { return count_; }
+
+ private:
+  int count_ = 0;
+};
+
+}  // namespace
+
+TEST_F(GraphImplTest, NotificationBatch) {
+  auto page = CreateNode<PageNodeImpl>();
+  page->SetIsVisible(false);
+  VisibilityChangeCounter counter;
+  graph()->AddPageNodeObserver(&counter);
+
+  {
+    GraphImpl::ScopedNotificationBatch batch(graph());
+    page->SetIsVisible(true);
+    page->SetIsVisible(false);
+    {
+      GraphImpl::ScopedNotificationBatch nested_batch(graph());
+      page->SetIsVisible(true);
+    }
+    // The property changes right away, the notification waits for the end of
+    // the outermost batch.
+    EXPECT_TRUE(page->IsVisible());
+    EXPECT_EQ(0, counter.count());
+  }
+  EXPECT_EQ(1, counter.count());
+
+  // A property that changes back to its initial value isn't notified.
+  {
+    GraphImpl::ScopedNotificationBatch batch(graph());
+    page->SetIsVisible(false);
+    page->SetIsVisible(true);
+  }
+  EXPECT_EQ(1, counter.count());
+
+  // Outside of a batch, each change is notified.
+  page->SetIsVisible(false);
+  page->SetIsVisible(true);
+  EXPECT_EQ(3, counter.count());
+
+  graph()->RemovePageNodeObserver(&counter);
+}
+
+TEST_F(GraphImplTest, NotificationBatchNodeRemoved) {
+  auto page = CreateNode<PageNodeImpl>();
+  page->SetIsVisible(false);
+  VisibilityChangeCounter counter;
+  graph()->AddPageNodeObserver(&counter);
+
+  {
+    GraphImpl::ScopedNotificationBatch batch(graph());
+    page->SetIsVisible(true);
+    EXPECT_EQ(0, counter.count());
+
+    // The pending notifications are sent before the node leaves the graph.
+    page.reset();
+    EXPECT_EQ(1, counter.count());
+  }
+  EXPECT_EQ(1, counter.count());
+
+  graph()->RemovePageNodeObserver(&counter);
+}
+
 TEST_F(GraphImplTest, NodeDataDescribers) {
   MockSinglePageInSingleProcessGraph mock_graph(graph());
   NodeDataDescriberRegistry* registry = graph()->GetNodeDataDescriberRegistry();
@@ -4,6 +4,9 @@
 
 #include "components/performance_manager/graph/node_base.h"
 
+#include <utility>
+
+#include "base/functional/callback.h"
 #include "components/performance_manager/graph/graph_impl.h"
 #include "components/performance_manager/public/graph/node.h"
 
@@ -45,6 +48,17 @@ bool NodeBase::CanSetAndNotifyProperty() const {
   return GetNodeState() == NodeState::kActiveInGraph;
 }
 
+bool NodeBase::ShouldDeferNotifications() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return graph_->IsBatchingNotifications();
+}
+
+void NodeBase::DeferNotification(const void* property,
+                                 base::OnceClosure notification) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  graph_->DeferNotification(this, property, std::move(notification));
+}
+
 void NodeBase::JoinGraph(GraphImpl* graph) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   DCHECK(!graph_);
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include "base/check_op.h"
+#include "base/functional/callback_forward.h"
 #include "base/memory/raw_ptr.h"
 #include "base/sequence_checker.h"
 #include "components/performance_manager/graph/graph_impl.h"
@@ -74,6 +75,8 @@ class NodeBase {
   // GetObservers is implemented by TypedNodeImpl.
   bool CanSetProperty() const;
   bool CanSetAndNotifyProperty() const;
+  bool ShouldDeferNotifications() const;
+  void DeferNotification(const void* property, base::OnceClosure notification);
 
  protected:
   friend class GraphImpl;
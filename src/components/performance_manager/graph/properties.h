@@ -8,6 +8,8 @@
 #include <utility>
 
 #include "base/check.h"
+#include "base/functional/bind.h"
+#include "base/functional/callback.h"
 #include "components/performance_manager/public/graph/node_state.h"
 
 namespace performance_manager {
@@ -21,14 +23,23 @@ namespace performance_manager {
 //   IterableCollection GetObservers() const;
 //   bool NodeImplType::CanSetProperty() const;
 //   bool NodeImplType::CanSetAndNotifyProperty() const;
+//   bool NodeImplType::ShouldDeferNotifications() const;
+//   void NodeImplType::DeferNotification(const void* property,
+//                                        base::OnceClosure notification);
 //
-// These are used in DCHECKs to assert that properties are only being modified
-// at appropriate moments. If your code is blowing up in one of these DCHECKS
+// CanSetProperty() and CanSetAndNotifyProperty() are used in DCHECKs to assert
+// that properties are only being modified at appropriate moments. If your code is blowing up in one of these DCHECKS
 // you are trying to change a property while a node is being added or removed
 // from the graph. When adding to the graph property changes should be done in a
 // separate posted task. When removing from the graph, they should simply not be
 // done. See class comments on node observers, NodeState, and NodeBase for full
 // details.
+//
+// While ShouldDeferNotifications() returns true, the properties that only
+// notify on changes hand their notification to DeferNotification() instead of
+// sending it. The node is expected to run only the first notification it gets
+// for a given |property|, which checks whether the value still differs from
+// the value before the first change.
 template <typename NodeImplType, typename NodeType, typename ObserverType>
 class ObservedPropertyImpl {
  public:
@@ -89,13 +100,21 @@ class ObservedPropertyImpl {
     ~NotifiesOnlyOnChanges() = default;
 
     // Sets the property and sends a notification if needed. Returns true if a
-    // notification was sent, false otherwise.
+    // notification was sent or deferred, false otherwise.
     template <typename U = PropertyType>
     bool SetAndMaybeNotify(NodeImplType* node, U&& value) {
       // If your code is blowing up here see the class comment!
       DCHECK(node->CanSetAndNotifyProperty());
       if (value_ == value)
         return false;
+      if (node->ShouldDeferNotifications()) {
+        node->DeferNotification(
+            this, base::BindOnce(&NotifiesOnlyOnChanges::NotifyIfChanged,
+                                 base::Unretained(this), base::Unretained(node),
+                                 value_));
+        value_ = std::forward<U>(value);
+        return true;
+      }
       value_ = std::forward<U>(value);
       for (auto& observer : node->GetObservers()) {
         (observer.*NotifyFunctionPtr)(node);
@@ -114,6 +133,16 @@ class ObservedPropertyImpl {
     const PropertyType& value() const { return value_; }
 
    private:
+    // Sends a deferred notification, unless the property went back to
+    // |initial_value| since it was deferred.
+    void NotifyIfChanged(NodeImplType* node, const PropertyType& initial_value) {
+      if (value_ == initial_value)
+        return;
+      for (auto& observer : node->GetObservers()) {
+        (observer.*NotifyFunctionPtr)(node);
+      }
+    }
+
     PropertyType value_;
   };
 
@@ -137,13 +166,21 @@ class ObservedPropertyImpl {
     ~NotifiesOnlyOnChangesWithPreviousValue() = default;
 
     // Sets the property and sends a notification if needed. Returns true if a
-    // notification was sent, false otherwise.
+    // notification was sent or deferred, false otherwise.
     template <typename U = PropertyType>
     bool SetAndMaybeNotify(NodeImplType* node, U&& value) {
       // If your code is blowing up here see the class comment!
       DCHECK(node->CanSetAndNotifyProperty());
       if (value_ == value)
         return false;
+      if (node->ShouldDeferNotifications()) {
+        node->DeferNotification(
+            this, base::BindOnce(
+                      &NotifiesOnlyOnChangesWithPreviousValue::NotifyIfChanged,
+                      base::Unretained(this), base::Unretained(node), value_));
+        value_ = std::forward<U>(value);
+        return true;
+      }
       PropertyType previous_value = std::move(value_);
       value_ = std::forward<U>(value);
       for (auto& observer : node->GetObservers()) {
@@ -163,6 +200,17 @@ class ObservedPropertyImpl {
     const PropertyType& value() const { return value_; }
 
    private:
+    // Sends a deferred notification with the value before the first deferred
+    // change, unless the property went back to that value since.
+    void NotifyIfChanged(NodeImplType* node,
+                         const PropertyType& previous_value) {
+      if (value_ == previous_value)
+        return;
+      for (auto& observer : node->GetObservers()) {
+        (observer.*NotifyFunctionPtr)(node, previous_value);
+      }
+    }
+
     PropertyType value_;
   };
 };
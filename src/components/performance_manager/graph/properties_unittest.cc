@@ -4,6 +4,8 @@
 
 #include "components/performance_manager/graph/properties.h"
 
+#include "base/functional/callback.h"
+#include "base/notreached.h"
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
 #include "base/test/gtest_util.h"
@@ -43,6 +45,10 @@ class DummyNode {
   const base::ObserverList<DummyObserver>& GetObservers() { return observers_; }
   bool CanSetProperty() const { return can_set_; }
   bool CanSetAndNotifyProperty() const { return can_set_; }
+  bool ShouldDeferNotifications() const { return false; }
+  void DeferNotification(const void* property, base::OnceClosure notification) {
+    NOTREACHED_IN_MIGRATION();
+  }
 
   void set_can_set(bool can_set) { can_set_ = can_set; }
 
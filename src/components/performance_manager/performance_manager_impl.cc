@@ -6,6 +6,7 @@
 
 #include <atomic>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "base/check_op.h"
@@ -51,6 +52,12 @@ bool g_pm_is_available = false;
 
 constexpr base::TaskPriority kPmTaskPriority = base::TaskPriority::USER_VISIBLE;
 
+// Coalesces the node property change notifications sent by each task run on
+// the graph, see GraphImpl::ScopedNotificationBatch.
+BASE_FEATURE(kBatchGraphNotifications,
+             "BatchGraphNotifications",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 // Task traits appropriate for the PM task runner.
 // NOTE: The PM task runner has to block shutdown as some of the tasks posted to
 // it should be guaranteed to run before shutdown (e.g. removing some entries
@@ -188,6 +195,11 @@ PerformanceManagerImpl::~PerformanceManagerImpl() {
 void PerformanceManagerImpl::CallOnGraphImpl(const base::Location& from_here,
                                              base::OnceClosure callback) {
   DCHECK(callback);
+  if (base::FeatureList::IsEnabled(kBatchGraphNotifications)) {
+    callback =
+        base::BindOnce(&PerformanceManagerImpl::RunCallbackInNotificationBatch,
+                       std::move(callback));
+  }
   GetTaskRunner()->PostTask(from_here, std::move(callback));
 }
 
@@ -484,8 +496,27 @@ void PerformanceManagerImpl::RunCallbackWithGraphImpl(
     GraphImplCallback graph_callback) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
 
-  if (g_performance_manager)
-    std::move(graph_callback).Run(&g_performance_manager->graph_);
+  if (!g_performance_manager)
+    return;
+  GraphImpl* graph = &g_performance_manager->graph_;
+  std::optional<GraphImpl::ScopedNotificationBatch> notification_batch;
+  if (base::FeatureList::IsEnabled(kBatchGraphNotifications))
+    notification_batch.emplace(graph);
+  std::move(graph_callback).Run(graph);
+}
+
+// static
+void PerformanceManagerImpl::RunCallbackInNotificationBatch(
+    base::OnceClosure callback) {
+  DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+
+  if (!g_performance_manager) {
+    std::move(callback).Run();
+    return;
+  }
+  GraphImpl::ScopedNotificationBatch notification_batch(
+      &g_performance_manager->graph_);
+  std::move(callback).Run();
 }
 
 // static
@@ -183,6 +183,7 @@ class PerformanceManagerImpl : public PerformanceManager {
 
   void OnStartImpl(GraphImplCallback graph_callback);
   static void RunCallbackWithGraphImpl(GraphImplCallback graph_callback);
+  static void RunCallbackInNotificationBatch(base::OnceClosure callback);
   static void RunCallbackWithGraph(GraphCallback graph_callback);
 
   template <typename TaskReturnType>
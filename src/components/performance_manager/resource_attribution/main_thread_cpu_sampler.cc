@@ -0,0 +1,274 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/performance_manager/resource_attribution/main_thread_cpu_sampler.h"
+
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "base/functional/bind.h"
+#include "base/process/process_handle.h"
+#include "base/task/task_traits.h"
+#include "build/build_config.h"
+#include "components/performance_manager/public/graph/frame_node.h"
+#include "components/performance_manager/public/graph/graph.h"
+#include "content/public/common/process_type.h"
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string_view>
+
+#include "base/files/scoped_file.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#endif
+
+namespace resource_attribution::internal {
+
+BASE_FEATURE(kResourceAttributionMainThreadCPUSampling,
+             "ResourceAttributionMainThreadCPUSampling",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+const base::FeatureParam<base::TimeDelta> kMainThreadCPUSamplingInterval{
+    &kResourceAttributionMainThreadCPUSampling, "sampling_interval",
+    base::Milliseconds(100)};
+
+namespace {
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+
+// Reads the time a thread spent on CPU from /proc/<pid>/task/<tid>/schedstat,
+// whose first field is in nanoseconds. The file is kept open between samples,
+// so each sample costs a single pread() syscall. Since the file descriptor
+// refers to the thread and not to its pid, it starts failing when the process
+// exits instead of reading another process if the pid is reused.
+class ProcSchedStatReader final : public MainThreadCPUSampler::Reader {
+ public:
+  explicit ProcSchedStatReader(base::ScopedFD fd) : fd_(std::move(fd)) {}
+  ~ProcSchedStatReader() final = default;
+
+  // The main thread of a process has the same id as the process.
+  static std::unique_ptr<ProcSchedStatReader> Create(base::ProcessId pid) {
+    // procfs is backed by memory, so this doesn't block on I/O.
+    base::ScopedFD fd(HANDLE_EINTR(
+        open(base::StringPrintf("/proc/%d/task/%d/schedstat", pid, pid).c_str(),
+             O_RDONLY | O_CLOEXEC)));
+    if (!fd.is_valid()) {
+      return nullptr;
+    }
+    return std::make_unique<ProcSchedStatReader>(std::move(fd));
+  }
+
+  std::optional<base::TimeDelta> GetCumulativeCPUUsage() final {
+    char buffer[128];
+    const ssize_t length =
+        HANDLE_EINTR(pread(fd_.get(), buffer, sizeof(buffer), 0));
+    if (length <= 0) {
+      return std::nullopt;
+    }
+    std::string_view contents(buffer, static_cast<size_t>(length));
+    const size_t end = contents.find(' ');
+    if (end == std::string_view::npos) {
+      return std::nullopt;
+    }
+    int64_t on_cpu_ns = 0;
+    if (!base::StringToInt64(contents.substr(0, end), &on_cpu_ns) ||
+        on_cpu_ns < 0) {
+      return std::nullopt;
+    }
+    return base::Nanoseconds(on_cpu_ns);
+  }
+
+ private:
+  base::ScopedFD fd_;
+};
+
+#endif
+
+std::unique_ptr<MainThreadCPUSampler::Reader> CreateDefaultReader(
+    const ProcessNode* process_node) {
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  return ProcSchedStatReader::Create(process_node->GetProcessId());
+#else
+  return nullptr;
+#endif
+}
+
+}  // namespace
+
+MainThreadCPUSampler::ProcessState::ProcessState() = default;
+MainThreadCPUSampler::ProcessState::~ProcessState() = default;
+MainThreadCPUSampler::ProcessState::ProcessState(ProcessState&&) = default;
+MainThreadCPUSampler::ProcessState&
+MainThreadCPUSampler::ProcessState::operator=(ProcessState&&) = default;
+
+MainThreadCPUSampler::MainThreadCPUSampler()
+    : reader_factory_(base::BindRepeating(&CreateDefaultReader)) {}
+
+MainThreadCPUSampler::~MainThreadCPUSampler() {
+  if (graph_) {
+    StopSampling();
+  }
+  CHECK(!graph_);
+}
+
+// static
+bool MainThreadCPUSampler::IsSupported() {
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void MainThreadCPUSampler::SetReaderFactoryForTesting(ReaderFactory factory) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  CHECK(!graph_);
+  CHECK(factory);
+  reader_factory_ = std::move(factory);
+}
+
+void MainThreadCPUSampler::StartSampling(Graph* graph) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  CHECK(!graph_);
+  CHECK(process_states_.empty());
+  CHECK(frame_results_.empty());
+  graph_ = graph;
+  graph_->AddProcessNodeObserver(this);
+  graph_->VisitAllProcessNodes([this](const ProcessNode* process_node) {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    MaybeStartReading(process_node);
+    return true;
+  });
+  // Unretained is safe because the timer is owned by `this`.
+  sampling_timer_.Start(FROM_HERE, kMainThreadCPUSamplingInterval.Get(),
+                        base::BindRepeating(&MainThreadCPUSampler::TakeSample,
+                                            base::Unretained(this)));
+}
+
+void MainThreadCPUSampler::StopSampling() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  CHECK(graph_);
+  sampling_timer_.Stop();
+  process_states_.clear();
+  frame_results_.clear();
+  graph_->RemoveProcessNodeObserver(this);
+  graph_ = nullptr;
+}
+
+bool MainThreadCPUSampler::IsSampling() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return graph_;
+}
+
+QueryResultMap MainThreadCPUSampler::GetResults() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  QueryResultMap results;
+  for (const auto& [frame_context, result] : frame_results_) {
+    results.emplace(frame_context, QueryResults{.cpu_time_result = result});
+  }
+  return results;
+}
+
+void MainThreadCPUSampler::TakeSampleForTesting() {
+  TakeSample();
+}
+
+void MainThreadCPUSampler::OnProcessLifetimeChange(
+    const ProcessNode* process_node) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // A new process may have been launched for the node, in which case its main
+  // thread is read from scratch.
+  process_states_.erase(process_node);
+  MaybeStartReading(process_node);
+}
+
+void MainThreadCPUSampler::OnBeforeProcessNodeRemoved(
+    const ProcessNode* process_node) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  process_states_.erase(process_node);
+}
+
+void MainThreadCPUSampler::MaybeStartReading(const ProcessNode* process_node) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // Only renderer main threads run frame tasks.
+  if (process_node->GetProcessType() != content::PROCESS_TYPE_RENDERER ||
+      process_node->GetProcessId() == base::kNullProcessId) {
+    return;
+  }
+  std::unique_ptr<Reader> reader = reader_factory_.Run(process_node);
+  if (!reader) {
+    return;
+  }
+  ProcessState state;
+  state.last_cpu_usage = reader->GetCumulativeCPUUsage();
+  state.last_sample_time = base::TimeTicks::Now();
+  state.reader = std::move(reader);
+  process_states_.insert_or_assign(process_node, std::move(state));
+}
+
+void MainThreadCPUSampler::TakeSample() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  CHECK(graph_);
+
+  // Forget the frames that were deleted since the last sample.
+  std::erase_if(frame_results_, [](const auto& entry) {
+    return !entry.first.GetFrameNode();
+  });
+
+  const base::TimeTicks now = base::TimeTicks::Now();
+  for (auto& [process_node, state] : process_states_) {
+    const std::optional<base::TimeDelta> cpu_usage =
+        state.reader->GetCumulativeCPUUsage();
+    if (!cpu_usage.has_value()) {
+      continue;
+    }
+    const base::TimeTicks interval_start = state.last_sample_time;
+    const std::optional<base::TimeDelta> last_cpu_usage =
+        std::exchange(state.last_cpu_usage, cpu_usage);
+    state.last_sample_time = now;
+    if (!last_cpu_usage.has_value() || interval_start >= now ||
+        cpu_usage.value() <= last_cpu_usage.value()) {
+      continue;
+    }
+
+    std::vector<const FrameNode*> frame_nodes;
+    for (const FrameNode* frame_node : process_node->GetFrameNodes()) {
+      frame_nodes.push_back(frame_node);
+    }
+    if (frame_nodes.empty()) {
+      continue;
+    }
+
+    // The renderer scheduler doesn't report which frame each main thread task
+    // ran for, so split the main thread time evenly among the frames that
+    // share it.
+    const base::TimeDelta cpu_delta =
+        (cpu_usage.value() - last_cpu_usage.value()) /
+        static_cast<int64_t>(frame_nodes.size());
+    const bool is_background =
+        process_node->GetPriority() == base::TaskPriority::BEST_EFFORT;
+    for (const FrameNode* frame_node : frame_nodes) {
+      auto [it, inserted] = frame_results_.try_emplace(
+          frame_node->GetResourceContext(),
+          CPUTimeResult{.metadata = ResultMetadata(now,
+                                                   MeasurementAlgorithm::kSplit),
+                        .start_time = interval_start});
+      CPUTimeResult& result = it->second;
+      result.metadata.measurement_time = now;
+      result.cumulative_cpu += cpu_delta;
+      if (is_background) {
+        result.cumulative_background_cpu += cpu_delta;
+      }
+    }
+  }
+}
+
+}  // namespace resource_attribution::internal
@@ -0,0 +1,126 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_PERFORMANCE_MANAGER_RESOURCE_ATTRIBUTION_MAIN_THREAD_CPU_SAMPLER_H_
+#define COMPONENTS_PERFORMANCE_MANAGER_RESOURCE_ATTRIBUTION_MAIN_THREAD_CPU_SAMPLER_H_
+
+#include <map>
+#include <memory>
+#include <optional>
+
+#include "base/feature_list.h"
+#include "base/functional/callback.h"
+#include "base/memory/raw_ptr.h"
+#include "base/metrics/field_trial_params.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "components/performance_manager/public/graph/process_node.h"
+#include "components/performance_manager/public/resource_attribution/query_results.h"
+#include "components/performance_manager/public/resource_attribution/resource_contexts.h"
+#include "components/performance_manager/resource_attribution/performance_manager_aliases.h"
+
+namespace resource_attribution::internal {
+
+// When enabled, the main thread of each renderer is sampled at a high
+// frequency while CPU queries exist, to find the frames that cause jank.
+BASE_DECLARE_FEATURE(kResourceAttributionMainThreadCPUSampling);
+
+// The time between two samples of the renderer main threads.
+extern const base::FeatureParam<base::TimeDelta> kMainThreadCPUSamplingInterval;
+
+// Samples the CPU usage of the main thread of every renderer process at a high
+// frequency, and attributes it to the frames hosted in the process. Unlike the
+// process-wide measurements of CPUMeasurementMonitor, this doesn't attribute
+// the time spent on worker and compositor threads to frames, so a frame that
+// blocks its main thread stands out.
+class MainThreadCPUSampler : public ProcessNode::ObserverDefaultImpl {
+ public:
+  // Reads the CPU usage of the main thread of a process.
+  class Reader {
+   public:
+    virtual ~Reader() = default;
+
+    // Returns the CPU time used by the main thread since it started, or
+    // nullopt if it can't be read, for example because the process exited.
+    virtual std::optional<base::TimeDelta> GetCumulativeCPUUsage() = 0;
+  };
+
+  // Returns a Reader for the main thread of the given process, or nullptr if
+  // it can't be sampled.
+  using ReaderFactory =
+      base::RepeatingCallback<std::unique_ptr<Reader>(const ProcessNode*)>;
+
+  MainThreadCPUSampler();
+  ~MainThreadCPUSampler() override;
+
+  MainThreadCPUSampler(const MainThreadCPUSampler&) = delete;
+  MainThreadCPUSampler& operator=(const MainThreadCPUSampler&) = delete;
+
+  // Returns true if the main thread CPU usage can be read on this platform.
+  static bool IsSupported();
+
+  // Sets a factory that will be used to create Readers for processes. Must be
+  // called while not sampling.
+  void SetReaderFactoryForTesting(ReaderFactory factory);
+
+  // Starts sampling the renderer processes in `graph` every
+  // kMainThreadCPUSamplingInterval.
+  void StartSampling(Graph* graph);
+
+  // Stops sampling and forgets all results.
+  void StopSampling();
+
+  bool IsSampling() const;
+
+  // Returns the main thread CPU time attributed to each live frame since the
+  // sampling started or the frame was created, as of the last sample.
+  QueryResultMap GetResults() const;
+
+  // Takes a sample immediately instead of waiting for the timer.
+  void TakeSampleForTesting();
+
+  // ProcessNode::ObserverDefaultImpl:
+  void OnProcessLifetimeChange(const ProcessNode* process_node) override;
+  void OnBeforeProcessNodeRemoved(const ProcessNode* process_node) override;
+
+ private:
+  struct ProcessState {
+    ProcessState();
+    ~ProcessState();
+    ProcessState(ProcessState&&);
+    ProcessState& operator=(ProcessState&&);
+
+    std::unique_ptr<Reader> reader;
+    std::optional<base::TimeDelta> last_cpu_usage;
+    base::TimeTicks last_sample_time;
+  };
+
+  // Starts reading the main thread of `process_node` if it's a renderer with
+  // a pid.
+  void MaybeStartReading(const ProcessNode* process_node);
+
+  // Reads the main thread CPU usage of all processes, and splits the usage
+  // since the previous sample among their frames.
+  void TakeSample();
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  raw_ptr<Graph> graph_ GUARDED_BY_CONTEXT(sequence_checker_) = nullptr;
+
+  ReaderFactory reader_factory_ GUARDED_BY_CONTEXT(sequence_checker_);
+
+  std::map<const ProcessNode*, ProcessState> process_states_
+      GUARDED_BY_CONTEXT(sequence_checker_);
+
+  // Results for the frames that were alive at the last sample.
+  std::map<FrameContext, CPUTimeResult> frame_results_
+      GUARDED_BY_CONTEXT(sequence_checker_);
+
+  base::RepeatingTimer sampling_timer_ GUARDED_BY_CONTEXT(sequence_checker_);
+};
+
+}  // namespace resource_attribution::internal
+
+#endif  // COMPONENTS_PERFORMANCE_MANAGER_RESOURCE_ATTRIBUTION_MAIN_THREAD_CPU_SAMPLER_H_
@@ -0,0 +1,174 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/performance_manager/resource_attribution/main_thread_cpu_sampler.h"
+
+#include <map>
+#include <memory>
+#include <optional>
+
+#include "base/containers/contains.h"
+#include "base/functional/bind.h"
+#include "base/memory/raw_ptr.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/time/time.h"
+#include "components/performance_manager/graph/frame_node_impl.h"
+#include "components/performance_manager/graph/process_node_impl.h"
+#include "components/performance_manager/public/resource_attribution/query_results.h"
+#include "components/performance_manager/resource_attribution/performance_manager_aliases.h"
+#include "components/performance_manager/test_support/graph_test_harness.h"
+#include "components/performance_manager/test_support/mock_graphs.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace resource_attribution::internal {
+
+namespace {
+
+constexpr base::TimeDelta kSamplingInterval = base::Milliseconds(100);
+
+// A Reader that returns the CPU usage that the test sets for a process.
+class FakeReader final : public MainThreadCPUSampler::Reader {
+ public:
+  explicit FakeReader(std::optional<base::TimeDelta>* cpu_usage)
+      : cpu_usage_(cpu_usage) {}
+  ~FakeReader() final = default;
+
+  std::optional<base::TimeDelta> GetCumulativeCPUUsage() final {
+    return *cpu_usage_;
+  }
+
+ private:
+  raw_ptr<std::optional<base::TimeDelta>> cpu_usage_;
+};
+
+}  // namespace
+
+class ResourceAttrMainThreadCPUSamplerTest
+    : public performance_manager::GraphTestHarness {
+ protected:
+  using Super = performance_manager::GraphTestHarness;
+
+  ResourceAttrMainThreadCPUSamplerTest() {
+    scoped_feature_list_.InitAndEnableFeatureWithParameters(
+        kResourceAttributionMainThreadCPUSampling,
+        {{"sampling_interval", "100ms"}});
+  }
+
+  void SetUp() override {
+    Super::SetUp();
+    sampler_.SetReaderFactoryForTesting(base::BindRepeating(
+        &ResourceAttrMainThreadCPUSamplerTest::CreateReader,
+        base::Unretained(this)));
+  }
+
+  void TearDown() override {
+    if (sampler_.IsSampling()) {
+      sampler_.StopSampling();
+    }
+    Super::TearDown();
+  }
+
+  std::unique_ptr<MainThreadCPUSampler::Reader> CreateReader(
+      const ProcessNode* process_node) {
+    return std::make_unique<FakeReader>(&cpu_usage_[process_node]);
+  }
+
+  base::TimeDelta GetFrameCPU(const FrameNodeImpl* frame_node) const {
+    const QueryResultMap results = sampler_.GetResults();
+    const auto it = results.find(frame_node->GetResourceContext());
+    if (it == results.end() || !it->second.cpu_time_result.has_value()) {
+      return base::TimeDelta();
+    }
+    return it->second.cpu_time_result->cumulative_cpu;
+  }
+
+  base::test::ScopedFeatureList scoped_feature_list_;
+  std::map<const ProcessNode*, std::optional<base::TimeDelta>> cpu_usage_;
+  MainThreadCPUSampler sampler_;
+};
+
+TEST_F(ResourceAttrMainThreadCPUSamplerTest, SplitAmongFrames) {
+  performance_manager::MockMultiplePagesInSingleProcessGraph mock_graph(
+      graph());
+  cpu_usage_[mock_graph.process.get()] = base::Milliseconds(500);
+  sampler_.StartSampling(graph());
+
+  // The browser process isn't sampled.
+  EXPECT_FALSE(
+      base::Contains(cpu_usage_, static_cast<const ProcessNode*>(
+                                     mock_graph.browser_process.get())));
+
+  cpu_usage_[mock_graph.process.get()] = base::Milliseconds(580);
+  task_env().FastForwardBy(kSamplingInterval);
+  EXPECT_EQ(GetFrameCPU(mock_graph.frame.get()), base::Milliseconds(40));
+  EXPECT_EQ(GetFrameCPU(mock_graph.other_frame.get()), base::Milliseconds(40));
+
+  // The results accumulate between samples.
+  cpu_usage_[mock_graph.process.get()] = base::Milliseconds(600);
+  task_env().FastForwardBy(kSamplingInterval);
+  EXPECT_EQ(GetFrameCPU(mock_graph.frame.get()), base::Milliseconds(50));
+  EXPECT_EQ(GetFrameCPU(mock_graph.other_frame.get()), base::Milliseconds(50));
+
+  const QueryResultMap results = sampler_.GetResults();
+  const auto it = results.find(mock_graph.frame->GetResourceContext());
+  ASSERT_NE(it, results.end());
+  EXPECT_EQ(it->second.cpu_time_result->metadata.algorithm,
+            MeasurementAlgorithm::kSplit);
+  EXPECT_EQ(it->second.cpu_time_result->metadata.measurement_time -
+                it->second.cpu_time_result->start_time,
+            2 * kSamplingInterval);
+}
+
+TEST_F(ResourceAttrMainThreadCPUSamplerTest, ReadFailure) {
+  performance_manager::MockSinglePageInSingleProcessGraph mock_graph(graph());
+  cpu_usage_[mock_graph.process.get()] = base::Milliseconds(100);
+  sampler_.StartSampling(graph());
+
+  // Samples that can't be read are skipped, and the usage during them is
+  // attributed on the next successful sample.
+  cpu_usage_[mock_graph.process.get()] = std::nullopt;
+  task_env().FastForwardBy(kSamplingInterval);
+  EXPECT_EQ(GetFrameCPU(mock_graph.frame.get()), base::TimeDelta());
+
+  cpu_usage_[mock_graph.process.get()] = base::Milliseconds(150);
+  task_env().FastForwardBy(kSamplingInterval);
+  EXPECT_EQ(GetFrameCPU(mock_graph.frame.get()), base::Milliseconds(50));
+}
+
+TEST_F(ResourceAttrMainThreadCPUSamplerTest, FrameRemoved) {
+  performance_manager::MockMultiplePagesInSingleProcessGraph mock_graph(
+      graph());
+  cpu_usage_[mock_graph.process.get()] = base::TimeDelta();
+  sampler_.StartSampling(graph());
+
+  cpu_usage_[mock_graph.process.get()] = base::Milliseconds(20);
+  task_env().FastForwardBy(kSamplingInterval);
+  EXPECT_EQ(sampler_.GetResults().size(), 2u);
+
+  // The remaining frame gets all the main thread time after the other frame
+  // is removed.
+  const FrameContext removed_frame_context =
+      mock_graph.other_frame->GetResourceContext();
+  mock_graph.other_frame.reset();
+  cpu_usage_[mock_graph.process.get()] = base::Milliseconds(50);
+  task_env().FastForwardBy(kSamplingInterval);
+  EXPECT_EQ(GetFrameCPU(mock_graph.frame.get()), base::Milliseconds(40));
+  EXPECT_FALSE(base::Contains(sampler_.GetResults(),
+                              ResourceContext(removed_frame_context)));
+}
+
+TEST_F(ResourceAttrMainThreadCPUSamplerTest, StopSampling) {
+  performance_manager::MockSinglePageInSingleProcessGraph mock_graph(graph());
+  cpu_usage_[mock_graph.process.get()] = base::TimeDelta();
+  sampler_.StartSampling(graph());
+
+  cpu_usage_[mock_graph.process.get()] = base::Milliseconds(10);
+  task_env().FastForwardBy(kSamplingInterval);
+  EXPECT_EQ(GetFrameCPU(mock_graph.frame.get()), base::Milliseconds(10));
+
+  sampler_.StopSampling();
+  EXPECT_TRUE(sampler_.GetResults().empty());
+}
+
+}  // namespace resource_attribution::internal
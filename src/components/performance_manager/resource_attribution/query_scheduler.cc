@@ -12,6 +12,7 @@
 #include "base/barrier_callback.h"
 #include "base/check_op.h"
 #include "base/containers/enum_set.h"
+#include "base/feature_list.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback.h"
 #include "base/memory/scoped_refptr.h"
@@ -260,6 +261,9 @@ void QueryScheduler::OnTakenFromGraph(Graph* graph) {
   if (cpu_query_count_ > 0) {
     cpu_monitor_.StopMonitoring();
   }
+  if (main_thread_cpu_sampler_.IsSampling()) {
+    main_thread_cpu_sampler_.StopSampling();
+  }
   graph->GetNodeDataDescriberRegistry()->UnregisterDescriber(
       base::OptionalToPtr(memory_provider_));
   memory_provider_.reset();
@@ -270,6 +274,11 @@ CPUMeasurementMonitor& QueryScheduler::GetCPUMonitorForTesting() {
   return cpu_monitor_;
 }
 
+MainThreadCPUSampler& QueryScheduler::GetMainThreadCPUSamplerForTesting() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  return main_thread_cpu_sampler_;
+}
+
 MemoryMeasurementProvider& QueryScheduler::GetMemoryProviderForTesting() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   return memory_provider_.value();
@@ -287,6 +296,14 @@ uint32_t QueryScheduler::GetQueryCountForTesting(
   NOTREACHED_NORETURN();
 }
 
+QueryResultMap QueryScheduler::GetMainThreadCPUResults() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!main_thread_cpu_sampler_.IsSampling()) {
+    return {};
+  }
+  return main_thread_cpu_sampler_.GetResults();
+}
+
 void QueryScheduler::RecordMemoryMetrics() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   cpu_monitor_.RecordMemoryMetrics();
@@ -301,6 +318,11 @@ void QueryScheduler::AddCPUQuery() {
   if (cpu_query_count_ == 1) {
     CHECK(!cpu_monitor_.IsMonitoring());
     cpu_monitor_.StartMonitoring(graph_);
+    if (base::FeatureList::IsEnabled(
+            kResourceAttributionMainThreadCPUSampling) &&
+        MainThreadCPUSampler::IsSupported()) {
+      main_thread_cpu_sampler_.StartSampling(graph_);
+    }
   }
 }
 
@@ -312,6 +334,9 @@ void QueryScheduler::RemoveCPUQuery() {
   if (cpu_query_count_ == 0) {
     CHECK(cpu_monitor_.IsMonitoring());
     cpu_monitor_.StopMonitoring();
+    if (main_thread_cpu_sampler_.IsSampling()) {
+      main_thread_cpu_sampler_.StopSampling();
+    }
   }
 }
 
@@ -20,6 +20,7 @@
 #include "components/performance_manager/public/resource_attribution/resource_contexts.h"
 #include "components/performance_manager/public/resource_attribution/resource_types.h"
 #include "components/performance_manager/resource_attribution/cpu_measurement_monitor.h"
+#include "components/performance_manager/resource_attribution/main_thread_cpu_sampler.h"
 #include "components/performance_manager/resource_attribution/memory_measurement_provider.h"
 #include "components/performance_manager/resource_attribution/performance_manager_aliases.h"
 
@@ -76,6 +77,15 @@ class QueryScheduler
   // Gives tests direct access to `cpu_monitor_`.
   CPUMeasurementMonitor& GetCPUMonitorForTesting();
 
+  // Returns the renderer main thread CPU time attributed to each frame by the
+  // high frequency sampler. This is empty unless
+  // kResourceAttributionMainThreadCPUSampling is enabled and there are CPU
+  // queries.
+  QueryResultMap GetMainThreadCPUResults() const;
+
+  // Gives tests direct access to `main_thread_cpu_sampler_`.
+  MainThreadCPUSampler& GetMainThreadCPUSamplerForTesting();
+
   // Gives tests direct access to `memory_provider_`.
   MemoryMeasurementProvider& GetMemoryProviderForTesting();
 
@@ -87,7 +97,8 @@ class QueryScheduler
 
  private:
   // Increases the CPU query count. `cpu_monitor_` will start monitoring CPU
-  // usage when the count > 0.
+  // usage when the count > 0, and so will `main_thread_cpu_sampler_` if it's
+  // enabled.
   void AddCPUQuery();
 
   // Decreases the CPU query count. `cpu_monitor_` will stop monitoring CPU
@@ -116,6 +127,10 @@ class QueryScheduler
   CPUMeasurementMonitor cpu_monitor_ GUARDED_BY_CONTEXT(sequence_checker_);
   uint32_t cpu_query_count_ GUARDED_BY_CONTEXT(sequence_checker_) = 0;
 
+  // Samples renderer main threads while `cpu_monitor_` is monitoring.
+  MainThreadCPUSampler main_thread_cpu_sampler_
+      GUARDED_BY_CONTEXT(sequence_checker_);
+
   // Memory measurement machinery.
   std::optional<MemoryMeasurementProvider> memory_provider_
       GUARDED_BY_CONTEXT(sequence_checker_);
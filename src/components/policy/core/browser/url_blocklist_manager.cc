@@ -15,12 +15,20 @@
 #include "base/check.h"
 #include "base/files/file_path.h"
 #include "base/functional/bind.h"
+#include "base/json/json_writer.h"
 #include "base/location.h"
+#include "base/memory/ptr_util.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/synchronization/lock.h"
 #include "base/task/sequenced_task_runner.h"
 #include "base/task/single_thread_task_runner.h"
 #include "base/task/thread_pool.h"
+#include "base/thread_annotations.h"
+#include "base/time/time.h"
+#include "base/timer/elapsed_timer.h"
 #include "base/values.h"
 #include "build/build_config.h"
 #include "components/policy/core/browser/url_blocklist_policy_handler.h"
@@ -78,12 +86,18 @@ constexpr char kIosNtpHost[] = "newtab";
 // Returns a blocklist based on the given |block| and |allow| pattern lists.
 std::unique_ptr<URLBlocklist> BuildBlocklist(const base::Value::List* block,
                                              const base::Value::List* allow) {
-  auto blocklist = std::make_unique<URLBlocklist>();
-  if (block)
-    blocklist->Block(*block);
-  if (allow)
-    blocklist->Allow(*allow);
-  return blocklist;
+  return URLBlocklist::CreateShared(block, allow);
+}
+
+// Returns a string that identifies the blocklist built from |block| and
+// |allow|.
+std::string GetFiltersKey(const base::Value::List* block,
+                          const base::Value::List* allow) {
+  const base::Value::List empty;
+  std::string key = base::WriteJson(block ? *block : empty).value_or("");
+  key.push_back('\n');
+  key.append(base::WriteJson(allow ? *allow : empty).value_or(""));
+  return key;
 }
 
 const base::Value::List* GetPrefList(const PrefService* pref_service,
@@ -171,18 +185,109 @@ class DefaultBlocklistSource : public BlocklistSource {
   PrefChangeRegistrar pref_change_registrar_;
 };
 
-URLBlocklist::URLBlocklist() : url_matcher_(new URLMatcher) {}
+struct URLBlocklist::Index : public base::RefCountedThreadSafe<Index> {
+  Index() : url_matcher(std::make_unique<URLMatcher>()) {}
+  Index(const Index&) = delete;
+  Index& operator=(const Index&) = delete;
+
+  // Returns the shared index built from the filters identified by |key|, or
+  // null if there is none.
+  static scoped_refptr<Index> FindShared(const std::string& key);
+
+  // Shares |index| as built from the filters identified by |key|. If another
+  // index was shared for |key| in the meantime, returns that one instead.
+  static scoped_refptr<Index> Share(const std::string& key,
+                                    scoped_refptr<Index> index);
+
+  // Drops |index|, and stops sharing it if no blocklist uses it anymore.
+  static void Release(scoped_refptr<Index> index);
+
+  base::MatcherStringPattern::ID id = 0;
+  std::map<base::MatcherStringPattern::ID, FilterComponents> filters;
+  std::unique_ptr<URLMatcher> url_matcher;
+
+  // The key this index is shared under, or empty if it is not shared. Set
+  // before the index is shared, and not modified afterwards.
+  std::string shared_key;
+
+ private:
+  friend class base::RefCountedThreadSafe<Index>;
+  ~Index() = default;
+
+  // The shared indices. Each one holds a reference, so an index is destroyed
+  // on the sequence that removes it from here.
+  struct SharedIndices {
+    base::Lock lock;
+    std::map<std::string, scoped_refptr<Index>> indices GUARDED_BY(lock);
+  };
+  static SharedIndices& GetSharedIndices();
+};
+
+// static
+URLBlocklist::Index::SharedIndices& URLBlocklist::Index::GetSharedIndices() {
+  static base::NoDestructor<SharedIndices> shared_indices;
+  return *shared_indices;
+}
+
+// static
+scoped_refptr<URLBlocklist::Index> URLBlocklist::Index::FindShared(
+    const std::string& key) {
+  SharedIndices& shared_indices = GetSharedIndices();
+  base::AutoLock auto_lock(shared_indices.lock);
+  auto it = shared_indices.indices.find(key);
+  return it != shared_indices.indices.end() ? it->second : nullptr;
+}
+
+// static
+scoped_refptr<URLBlocklist::Index> URLBlocklist::Index::Share(
+    const std::string& key,
+    scoped_refptr<Index> index) {
+  DCHECK(index->HasOneRef());
+  index->shared_key = key;
+  SharedIndices& shared_indices = GetSharedIndices();
+  base::AutoLock auto_lock(shared_indices.lock);
+  return shared_indices.indices.emplace(key, std::move(index)).first->second;
+}
 
-URLBlocklist::~URLBlocklist() = default;
+// static
+void URLBlocklist::Index::Release(scoped_refptr<Index> index) {
+  if (!index || index->shared_key.empty())
+    return;
+
+  // Destroy the index, if it was the last reference, after releasing the lock.
+  scoped_refptr<Index> unused_index;
+  SharedIndices& shared_indices = GetSharedIndices();
+  base::AutoLock auto_lock(shared_indices.lock);
+  auto it = shared_indices.indices.find(index->shared_key);
+  // Only the shared index is removed, not one that lost a race in Share().
+  const bool is_shared = it != shared_indices.indices.end() &&
+                         it->second.get() == index.get();
+  index.reset();
+  if (is_shared && it->second->HasOneRef()) {
+    unused_index = std::move(it->second);
+    shared_indices.indices.erase(it);
+  }
+}
+
+URLBlocklist::URLBlocklist() : index_(base::MakeRefCounted<Index>()) {}
+
+URLBlocklist::URLBlocklist(scoped_refptr<Index> index)
+    : index_(std::move(index)) {}
+
+URLBlocklist::~URLBlocklist() {
+  Index::Release(std::move(index_));
+}
 
 void URLBlocklist::Block(const base::Value::List& filters) {
-  url_matcher::util::AddFilters(url_matcher_.get(), false, &id_, filters,
-                                &filters_);
+  DCHECK(index_->shared_key.empty());
+  url_matcher::util::AddFilters(index_->url_matcher.get(), false, &index_->id,
+                                filters, &index_->filters);
 }
 
 void URLBlocklist::Allow(const base::Value::List& filters) {
-  url_matcher::util::AddFilters(url_matcher_.get(), true, &id_, filters,
-                                &filters_);
+  DCHECK(index_->shared_key.empty());
+  url_matcher::util::AddFilters(index_->url_matcher.get(), true, &index_->id,
+                                filters, &index_->filters);
 }
 
 bool URLBlocklist::IsURLBlocked(const GURL& url) const {
@@ -192,13 +297,21 @@ bool URLBlocklist::IsURLBlocked(const GURL& url) const {
 
 URLBlocklist::URLBlocklistState URLBlocklist::GetURLBlocklistState(
     const GURL& url) const {
+  // Empty blocklists are common, and not worth timing.
+  if (index_->filters.empty())
+    return URLBlocklist::URLBlocklistState::URL_NEUTRAL_STATE;
+
+  const base::TimeTicks start_time = base::TimeTicks::Now();
   std::set<base::MatcherStringPattern::ID> matching_ids =
-      url_matcher_->MatchURL(url);
+      index_->url_matcher->MatchURL(url);
+  UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+      "Enterprise.UrlBlocklist.LookupTime", base::TimeTicks::Now() - start_time,
+      base::Microseconds(1), base::Milliseconds(100), 50);
 
   const FilterComponents* max = nullptr;
   for (auto id = matching_ids.begin(); id != matching_ids.end(); ++id) {
-    auto it = filters_.find(*id);
-    DCHECK(it != filters_.end());
+    auto it = index_->filters.find(*id);
+    DCHECK(it != index_->filters.end());
     const FilterComponents& filter = it->second;
     if (!max || FilterTakesPrecedence(filter, *max))
       max = &filter;
@@ -219,7 +332,31 @@ URLBlocklist::URLBlocklistState URLBlocklist::GetURLBlocklistState(
 }
 
 size_t URLBlocklist::Size() const {
-  return filters_.size();
+  return index_->filters.size();
+}
+
+// static
+std::unique_ptr<URLBlocklist> URLBlocklist::CreateShared(
+    const base::Value::List* block,
+    const base::Value::List* allow) {
+  const std::string key = GetFiltersKey(block, allow);
+  if (scoped_refptr<Index> index = Index::FindShared(key))
+    return base::WrapUnique(new URLBlocklist(std::move(index)));
+
+  // Build outside of the lock, so that lookups of other filters don't wait.
+  // If two sequences build the same filters at once, both blocklists end up
+  // with the index that was shared first.
+  base::ElapsedTimer build_timer;
+  auto blocklist = std::make_unique<URLBlocklist>();
+  if (block)
+    blocklist->Block(*block);
+  if (allow)
+    blocklist->Allow(*allow);
+  UMA_HISTOGRAM_TIMES("Enterprise.UrlBlocklist.BuildTime",
+                      build_timer.Elapsed());
+
+  return base::WrapUnique(
+      new URLBlocklist(Index::Share(key, std::move(blocklist->index_))));
 }
 
 // static
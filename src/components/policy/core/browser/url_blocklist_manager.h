@@ -10,6 +10,8 @@
 
 #include <map>
 #include <memory>
+#include <optional>
+#include <string>
 
 #include "base/compiler_specific.h"
 #include "base/functional/callback_forward.h"
@@ -70,16 +72,29 @@ class POLICY_EXPORT URLBlocklist {
   // Returns the number of items in the list.
   size_t Size() const;
 
+  // Returns a blocklist that blocks |block| and allows |allow|. Its filters and
+  // matcher are shared with every other blocklist created from the same lists
+  // while any of them is alive, so that profiles with the same policies only
+  // build and keep one copy. The returned blocklist must not be modified with
+  // Block() or Allow(). Can be called on any sequence.
+  static std::unique_ptr<URLBlocklist> CreateShared(
+      const base::Value::List* block,
+      const base::Value::List* allow);
+
  private:
+  // The filters and the matcher built from them.
+  struct Index;
+
+  explicit URLBlocklist(scoped_refptr<Index> index);
+
+
   // Returns true if |lhs| takes precedence over |rhs|.
   static bool FilterTakesPrecedence(
       const url_matcher::util::FilterComponents& lhs,
       const url_matcher::util::FilterComponents& rhs);
 
-  base::MatcherStringPattern::ID id_ = 0;
-  std::map<base::MatcherStringPattern::ID, url_matcher::util::FilterComponents>
-      filters_;
-  std::unique_ptr<url_matcher::URLMatcher> url_matcher_;
+  // Only modified while no other blocklist shares it.
+  scoped_refptr<Index> index_;
 };
 
 // Interface definition for specifying sources (e.g. preferences) for the URL
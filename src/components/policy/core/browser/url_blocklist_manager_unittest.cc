@@ -14,6 +14,7 @@
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "base/run_loop.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/test/task_environment.h"
 #include "base/values.h"
@@ -506,6 +507,38 @@ TEST_F(URLBlocklistManagerTest, BlockAllWithExceptions) {
   EXPECT_FALSE(blocklist.IsURLBlocked(GURL("https://very.safe/path")));
 }
 
+TEST_F(URLBlocklistManagerTest, CreateSharedBuildsOncePerFilters) {
+  base::HistogramTester histogram_tester;
+  base::Value::List blocked;
+  base::Value::List allowed;
+  blocked.Append("*");
+  allowed.Append("www.google.com");
+
+  std::unique_ptr<URLBlocklist> blocklist_1 =
+      URLBlocklist::CreateShared(&blocked, &allowed);
+  std::unique_ptr<URLBlocklist> blocklist_2 =
+      URLBlocklist::CreateShared(&blocked, &allowed);
+  histogram_tester.ExpectTotalCount("Enterprise.UrlBlocklist.BuildTime", 1);
+  EXPECT_EQ(2u, blocklist_2->Size());
+  EXPECT_TRUE(blocklist_2->IsURLBlocked(GURL("http://random.com")));
+  EXPECT_FALSE(blocklist_2->IsURLBlocked(GURL("http://www.google.com")));
+  histogram_tester.ExpectTotalCount("Enterprise.UrlBlocklist.LookupTime", 2);
+
+  // Other filters get their own index.
+  std::unique_ptr<URLBlocklist> blocklist_3 =
+      URLBlocklist::CreateShared(&blocked, nullptr);
+  histogram_tester.ExpectTotalCount("Enterprise.UrlBlocklist.BuildTime", 2);
+  EXPECT_TRUE(blocklist_3->IsURLBlocked(GURL("http://www.google.com")));
+
+  // The index is built again once no blocklist uses it anymore.
+  blocklist_1.reset();
+  blocklist_2.reset();
+  std::unique_ptr<URLBlocklist> blocklist_4 =
+      URLBlocklist::CreateShared(&blocked, &allowed);
+  histogram_tester.ExpectTotalCount("Enterprise.UrlBlocklist.BuildTime", 3);
+  EXPECT_FALSE(blocklist_4->IsURLBlocked(GURL("http://www.google.com")));
+}
+
 TEST_P(URLBlocklistManagerParamTest, DefaultBlocklistExceptions) {
   URLBlocklist blocklist;
   base::Value::List blocked;
@@ -10,6 +10,7 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "base/feature_list.h"
 #include "base/files/file_path.h"
@@ -22,6 +23,7 @@
 #include "base/json/json_writer.h"
 #include "base/logging.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/metrics/histogram.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/notreached.h"
@@ -29,6 +31,7 @@
 #include "base/ranges/algorithm.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
+#include "base/task/bind_post_task.h"
 #include "base/task/sequenced_task_runner.h"
 #include "base/time/default_clock.h"
 #include "base/values.h"
@@ -150,6 +153,50 @@ std::optional<std::string> DoSerialize(base::ValueView value,
   return output;
 }
 
+// A top-level entry of the prefs to write. |value| is set if the entry has no
+// cached serialization, in which case |json| is null.
+struct EntryToSerialize {
+  std::string key;
+  std::optional<base::Value> value;
+  scoped_refptr<base::RefCountedString> json;
+};
+
+// Serializes the entries that have no |json| and joins all the entries into
+// the same output as DoSerialize() on the whole prefs. The new serializations
+// are handed to |on_entries_serialized| so that the next write can reuse them.
+std::optional<std::string> DoSerializeEntries(
+    std::vector<EntryToSerialize> entries,
+    const base::FilePath& path,
+    JsonPrefStore::SerializedEntriesCallback on_entries_serialized) {
+  JsonPrefStore::SerializedEntries new_entries;
+  size_t output_size = 2;
+  for (EntryToSerialize& entry : entries) {
+    if (!entry.json) {
+      entry.json = base::MakeRefCounted<base::RefCountedString>(
+          *DoSerialize(entry.key, path) + ':' +
+          *DoSerialize(*entry.value, path));
+      new_entries.emplace_back(std::move(entry.key), entry.json);
+    }
+    output_size += entry.json->as_string().size() + 1;
+  }
+
+  std::string output;
+  output.reserve(output_size);
+  output += '{';
+  for (const EntryToSerialize& entry : entries) {
+    if (output.size() > 1) {
+      output += ',';
+    }
+    output += entry.json->as_string();
+  }
+  output += '}';
+
+  if (!new_entries.empty()) {
+    std::move(on_entries_serialized).Run(std::move(new_entries));
+  }
+  return output;
+}
+
 }  // namespace
 
 JsonPrefStore::JsonPrefStore(
@@ -220,6 +267,8 @@ bool JsonPrefStore::GetMutableValue(const std::string& key,
   if (!tmp)
     return false;
 
+  // The caller may modify the value without reporting it.
+  InvalidateSerializedEntry(key);
   if (result)
     *result = tmp;
   return true;
@@ -246,6 +295,7 @@ void JsonPrefStore::SetValueSilently(const std::string& key,
   base::Value* old_value = prefs_.FindByDottedPath(key);
   if (!old_value || value != *old_value) {
     prefs_.SetByDottedPath(key, std::move(value));
+    InvalidateSerializedEntry(key);
     ScheduleWrite(flags);
     ReportKeyChangedToUMA(key);
   }
@@ -264,6 +314,7 @@ void JsonPrefStore::RemoveValueSilently(const std::string& key,
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   prefs_.RemoveByDottedPath(key);
+  InvalidateSerializedEntry(key);
   ScheduleWrite(flags);
 }
 
@@ -341,6 +392,8 @@ void JsonPrefStore::SchedulePendingLossyWrites() {
 void JsonPrefStore::ReportValueChanged(const std::string& key, uint32_t flags) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
+  InvalidateSerializedEntry(key);
+
   if (pref_filter_)
     pref_filter_->FilterUpdate(key);
 
@@ -357,6 +410,8 @@ void JsonPrefStore::PerformPreserializationTasks() {
     OnWriteCallbackPair callbacks = pref_filter_->FilterSerializeData(prefs_);
     if (!callbacks.first.is_null() || !callbacks.second.is_null())
       RegisterOnNextWriteSynchronousCallbacks(std::move(callbacks));
+    // The filter may have modified any of the prefs.
+    InvalidateSerializedEntries();
   }
 }
 
@@ -504,7 +559,49 @@ std::optional<std::string> JsonPrefStore::SerializeData() {
 base::ImportantFileWriter::BackgroundDataProducerCallback
 JsonPrefStore::GetSerializedDataProducerForBackgroundSequence() {
   PerformPreserializationTasks();
-  return base::BindOnce(&DoSerialize, prefs_.Clone(), path_);
+
+  // Only the entries that changed since they were last serialized are cloned
+  // here and serialized in the background.
+  std::vector<EntryToSerialize> entries;
+  entries.reserve(prefs_.size());
+  for (const auto [key, value] : prefs_) {
+    EntryToSerialize& entry = entries.emplace_back();
+    auto it = serialized_entries_.find(key);
+    if (it != serialized_entries_.end()) {
+      entry.json = it->second;
+    } else {
+      entry.key = key;
+      entry.value = value.Clone();
+    }
+  }
+
+  return base::BindOnce(
+      &DoSerializeEntries, std::move(entries), path_,
+      base::BindPostTaskToCurrentDefault(base::BindOnce(
+          &JsonPrefStore::OnEntriesSerialized, weak_ptr_factory_.GetWeakPtr(),
+          serialized_entries_invalidation_count_)));
+}
+
+void JsonPrefStore::OnEntriesSerialized(uint64_t invalidation_count,
+                                        SerializedEntries entries) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // Some of the entries may have changed since they were cloned.
+  if (invalidation_count != serialized_entries_invalidation_count_) {
+    return;
+  }
+  for (auto& [key, json] : entries) {
+    serialized_entries_.insert_or_assign(std::move(key), std::move(json));
+  }
+}
+
+void JsonPrefStore::InvalidateSerializedEntry(std::string_view key) {
+  serialized_entries_.erase(key.substr(0, key.find('.')));
+  ++serialized_entries_invalidation_count_;
+}
+
+void JsonPrefStore::InvalidateSerializedEntries() {
+  serialized_entries_.clear();
+  ++serialized_entries_invalidation_count_;
 }
 
 void JsonPrefStore::FinalizeFileRead(bool initialization_successful,
@@ -521,6 +618,7 @@ void JsonPrefStore::FinalizeFileRead(bool initialization_successful,
   }
 
   prefs_ = std::move(prefs);
+  InvalidateSerializedEntries();
 
   initialized_ = true;
 
@@ -12,12 +12,16 @@
 #include <set>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "base/compiler_specific.h"
+#include "base/containers/flat_map.h"
 #include "base/files/file_path.h"
 #include "base/files/important_file_writer.h"
 #include "base/functional/callback_forward.h"
 #include "base/gtest_prod_util.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "base/sequence_checker.h"
@@ -50,6 +54,12 @@ class COMPONENTS_PREFS_EXPORT JsonPrefStore final
   using OnWriteCallbackPair =
       std::pair<base::OnceClosure, base::OnceCallback<void(bool success)>>;
 
+  // Top-level pref names with their value serialized as `"name":value` JSON.
+  using SerializedEntries = std::vector<
+      std::pair<std::string, scoped_refptr<base::RefCountedString>>>;
+  using SerializedEntriesCallback =
+      base::OnceCallback<void(SerializedEntries entries)>;
+
   // |pref_filename| is the path to the file to read prefs from. It is incorrect
   // to create multiple JsonPrefStore with the same |pref_filename|.
   // |file_task_runner| is used for asynchronous reads and writes. It must
@@ -191,11 +201,31 @@ class COMPONENTS_PREFS_EXPORT JsonPrefStore final
   // WriteablePrefStore::LOSSY_PREF_WRITE_FLAG.
   void ScheduleWrite(uint32_t flags);
 
+  // Caches the |entries| serialized by a background write, unless a pref
+  // changed since the write cloned them, per |invalidation_count|.
+  void OnEntriesSerialized(uint64_t invalidation_count,
+                           SerializedEntries entries);
+
+  // Drops the cached serialization of the top-level entry containing the pref
+  // at the dotted path |key|, as it might be modified.
+  void InvalidateSerializedEntry(std::string_view key);
+  // Drops all the cached serializations.
+  void InvalidateSerializedEntries();
+
   const base::FilePath path_;
   const scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
 
   base::Value::Dict prefs_;
 
+  // The serialization of the top-level entries of |prefs_| that did not change
+  // since a background write serialized them, so that writes only serialize
+  // the entries that changed. The strings are immutable and shared with the
+  // write tasks.
+  base::flat_map<std::string, scoped_refptr<base::RefCountedString>>
+      serialized_entries_;
+  // Incremented whenever an entry of |serialized_entries_| is invalidated.
+  uint64_t serialized_entries_invalidation_count_ = 0;
+
   bool read_only_;
 
   // Helper for safely writing pref data.
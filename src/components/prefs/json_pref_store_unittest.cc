@@ -14,6 +14,7 @@
 #include "base/files/scoped_temp_dir.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback.h"
+#include "base/json/json_writer.h"
 #include "base/location.h"
 #include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_samples.h"
@@ -558,6 +559,47 @@ TEST_P(JsonPrefStoreTest, RemoveValuesByPrefix) {
   EXPECT_TRUE(pref_store->GetValue(other_name, &value));
 }
 
+// Writes only reserialize the top-level entries that changed, and must still
+// write the same JSON as serializing all the prefs.
+TEST_P(JsonPrefStoreTest, IncrementalWrites) {
+  FilePath pref_file = temp_dir_.GetPath().AppendASCII("write.json");
+  auto pref_store = base::MakeRefCounted<JsonPrefStore>(pref_file);
+
+  auto expect_file_matches_prefs = [&]() {
+    CommitPendingWrite(pref_store.get(), commit_pending_write_mode_,
+                       &task_environment_);
+    std::string expected;
+    ASSERT_TRUE(base::JSONWriter::Write(pref_store->GetValues(), &expected));
+    std::string contents;
+    ASSERT_TRUE(base::ReadFileToString(pref_file, &contents));
+    EXPECT_EQ(expected, contents);
+  };
+
+  const uint32_t flags = WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS;
+  pref_store->SetValue("a.b", base::Value(1), flags);
+  pref_store->SetValue("a.c", base::Value("x"), flags);
+  pref_store->SetValue("d", base::Value(2.5), flags);
+  pref_store->SetValue("quote\"key", base::Value(true), flags);
+  expect_file_matches_prefs();
+
+  pref_store->SetValue("a.b", base::Value(3), flags);
+  expect_file_matches_prefs();
+
+  pref_store->RemoveValue("d", flags);
+  pref_store->SetValue("e", base::Value(base::Value::List()), flags);
+  expect_file_matches_prefs();
+
+  base::Value* mutable_value;
+  ASSERT_TRUE(pref_store->GetMutableValue("e", &mutable_value));
+  mutable_value->GetList().Append(4);
+  pref_store->ReportValueChanged("e", flags);
+  pref_store->SetValueSilently("a.c", base::Value("y"), flags);
+  expect_file_matches_prefs();
+
+  pref_store->RemoveValuesByPrefixSilently("a");
+  expect_file_matches_prefs();
+}
+
 TEST_P(JsonPrefStoreTest, HasReadErrorDelegate) {
   base::FilePath bogus_input_file = temp_dir_.GetPath().AppendASCII("read.txt");
   ASSERT_FALSE(PathExists(bogus_input_file));
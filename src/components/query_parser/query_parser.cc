@@ -93,12 +93,18 @@ class QueryNodeWord : public QueryNode {
  private:
   std::u16string word_;
   bool literal_;
-  const MatchingAlgorithm matching_algorithm_;
+  // Whether `word_` is long enough to match words it is a prefix of, which is
+  // checked for every word matched against.
+  const bool prefix_search_;
 };
 
 QueryNodeWord::QueryNodeWord(const std::u16string& word,
                              MatchingAlgorithm matching_algorithm)
-    : word_(word), literal_(false), matching_algorithm_(matching_algorithm) {}
+    : word_(word),
+      literal_(false),
+      prefix_search_(
+          QueryParser::IsWordLongEnoughForPrefixSearch(word_,
+                                                       matching_algorithm)) {}
 
 QueryNodeWord::~QueryNodeWord() {}
 
@@ -106,8 +112,7 @@ int QueryNodeWord::AppendToSQLiteQuery(std::u16string* query) const {
   query->append(word_);
 
   // Use prefix search if we're not literal and long enough.
-  if (!literal_ &&
-      QueryParser::IsWordLongEnoughForPrefixSearch(word_, matching_algorithm_))
+  if (!literal_ && prefix_search_)
     *query += L'*';
   return 1;
 }
@@ -117,8 +122,7 @@ bool QueryNodeWord::IsWord() const {
 }
 
 bool QueryNodeWord::Matches(const std::u16string& word, bool exact) const {
-  if (exact ||
-      !QueryParser::IsWordLongEnoughForPrefixSearch(word_, matching_algorithm_))
+  if (exact || !prefix_search_)
     return word == word_;
   return word.size() >= word_.size() &&
          (word_.compare(0, word_.size(), word, 0, word_.size()) == 0);
@@ -0,0 +1,84 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/query_parser/query_word_index.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "base/ranges/algorithm.h"
+#include "base/strings/string_util.h"
+
+namespace query_parser {
+
+QueryWordIndex::QueryWordIndex(std::vector<QueryWordVector> candidates)
+    : candidates_(std::move(candidates)) {
+  for (size_t i = 0; i < candidates_.size(); ++i) {
+    for (const QueryWord& word : candidates_[i]) {
+      words_.emplace_back(word.word, i);
+    }
+  }
+  base::ranges::sort(words_);
+  words_.erase(std::unique(words_.begin(), words_.end()), words_.end());
+}
+
+QueryWordIndex::~QueryWordIndex() = default;
+
+std::vector<size_t> QueryWordIndex::FindMatches(
+    const QueryNodeVector& find_nodes,
+    bool exact) const {
+  std::vector<size_t> matches;
+  for (size_t i = 0; i < find_nodes.size(); ++i) {
+    std::vector<size_t> node_matches = FindNodeMatches(*find_nodes[i], exact);
+    if (i == 0) {
+      matches = std::move(node_matches);
+    } else {
+      std::vector<size_t> intersection;
+      base::ranges::set_intersection(matches, node_matches,
+                                     std::back_inserter(intersection));
+      matches = std::move(intersection);
+    }
+    if (matches.empty()) {
+      break;
+    }
+  }
+  return matches;
+}
+
+std::vector<size_t> QueryWordIndex::FindNodeMatches(const QueryNode& node,
+                                                    bool exact) const {
+  std::vector<std::u16string> node_words;
+  node.AppendWords(&node_words);
+  if (node_words.empty()) {
+    return {};
+  }
+
+  // Every word a node matches starts with the node's first word: a word node
+  // matches its word either exactly or as a prefix, and a phrase only matches
+  // its words exactly.
+  const std::u16string& prefix = node_words.front();
+  std::vector<size_t> matches;
+  for (auto it = base::ranges::lower_bound(
+           words_, prefix, {},
+           &std::pair<std::u16string, size_t>::first);
+       it != words_.end() && base::StartsWith(it->first, prefix); ++it) {
+    if (node.IsWord() && node.Matches(it->first, exact)) {
+      matches.push_back(it->second);
+    } else if (!node.IsWord() && it->first == prefix) {
+      matches.push_back(it->second);
+    }
+  }
+  base::ranges::sort(matches);
+  matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+
+  if (!node.IsWord()) {
+    // The words of a phrase must also be adjacent and in order.
+    std::erase_if(matches, [&](size_t candidate) {
+      return !node.HasMatchIn(candidates_[candidate], exact);
+    });
+  }
+  return matches;
+}
+
+}  // namespace query_parser
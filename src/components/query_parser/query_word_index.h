@@ -0,0 +1,58 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_QUERY_PARSER_QUERY_WORD_INDEX_H_
+#define COMPONENTS_QUERY_PARSER_QUERY_WORD_INDEX_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "components/query_parser/query_parser.h"
+
+namespace query_parser {
+
+// An inverted index over the words of many candidate texts, for matching one
+// parsed query against all of them at once. Instead of matching every node of
+// the query against every word of every candidate, each node is looked up in
+// the sorted words of all candidates and the matching candidates are
+// intersected.
+class QueryWordIndex {
+ public:
+  // `candidates` are the words of the candidate texts, as extracted by
+  // QueryParser::ExtractQueryWords().
+  explicit QueryWordIndex(std::vector<QueryWordVector> candidates);
+
+  QueryWordIndex(const QueryWordIndex&) = delete;
+  QueryWordIndex& operator=(const QueryWordIndex&) = delete;
+
+  ~QueryWordIndex();
+
+  size_t size() const { return candidates_.size(); }
+  const QueryWordVector& candidate(size_t index) const {
+    return candidates_[index];
+  }
+
+  // Returns the indices of the candidates for which
+  // QueryParser::DoesQueryMatch(candidate, `find_nodes`, `exact`) is true, in
+  // increasing order.
+  std::vector<size_t> FindMatches(const QueryNodeVector& find_nodes,
+                                  bool exact = false) const;
+
+ private:
+  // Returns the sorted indices of the candidates that `node` matches.
+  std::vector<size_t> FindNodeMatches(const QueryNode& node, bool exact) const;
+
+  std::vector<QueryWordVector> candidates_;
+
+  // The distinct words of each candidate, paired with the candidate's index and
+  // sorted by word so that all the words starting with a prefix are adjacent.
+  std::vector<std::pair<std::u16string, size_t>> words_;
+};
+
+}  // namespace query_parser
+
+#endif  // COMPONENTS_QUERY_PARSER_QUERY_WORD_INDEX_H_
@@ -0,0 +1,91 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/query_parser/query_word_index.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include "base/strings/utf_string_conversions.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace query_parser {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+constexpr const char16_t* kTexts[] = {
+    u"the quick brown fox",
+    u"brown bread and butter",
+    u"quickly jumping foxes",
+    u"",
+    u"a fox, quick and brown",
+};
+
+QueryWordIndex CreateIndex() {
+  std::vector<QueryWordVector> candidates;
+  for (const char16_t* text : kTexts) {
+    QueryWordVector words;
+    QueryParser::ExtractQueryWords(text, &words);
+    candidates.push_back(std::move(words));
+  }
+  return QueryWordIndex(std::move(candidates));
+}
+
+std::vector<size_t> FindMatches(const QueryWordIndex& index,
+                                const std::u16string& query,
+                                bool exact = false) {
+  QueryNodeVector nodes;
+  QueryParser::ParseQueryNodes(query, MatchingAlgorithm::DEFAULT, &nodes);
+  return index.FindMatches(nodes, exact);
+}
+
+TEST(QueryWordIndexTest, FindMatches) {
+  QueryWordIndex index = CreateIndex();
+  EXPECT_THAT(FindMatches(index, u"brown"), ElementsAre(0, 1, 4));
+  EXPECT_THAT(FindMatches(index, u"Quick Brown"), ElementsAre(0, 4));
+  EXPECT_THAT(FindMatches(index, u"quick"), ElementsAre(0, 2, 4));
+  EXPECT_THAT(FindMatches(index, u"quick", /*exact=*/true), ElementsAre(0, 4));
+  // Short words are only matched exactly.
+  EXPECT_THAT(FindMatches(index, u"fo"), IsEmpty());
+  EXPECT_THAT(FindMatches(index, u"fox"), ElementsAre(0, 2, 4));
+  EXPECT_THAT(FindMatches(index, u"zebra brown"), IsEmpty());
+  EXPECT_THAT(FindMatches(index, u""), IsEmpty());
+}
+
+TEST(QueryWordIndexTest, FindPhraseMatches) {
+  QueryWordIndex index = CreateIndex();
+  EXPECT_THAT(FindMatches(index, u"\"brown fox\""), ElementsAre(0));
+  EXPECT_THAT(FindMatches(index, u"\"quick brown\" fox"), ElementsAre(0));
+  EXPECT_THAT(FindMatches(index, u"\"brown bread\""), ElementsAre(1));
+  EXPECT_THAT(FindMatches(index, u"\"fox quick\""), ElementsAre(4));
+  EXPECT_THAT(FindMatches(index, u"\"bread brown\""), IsEmpty());
+}
+
+// The index must agree with matching every candidate on its own.
+TEST(QueryWordIndexTest, MatchesDoesQueryMatch) {
+  QueryWordIndex index = CreateIndex();
+  for (const char16_t* query :
+       {u"brown", u"qui", u"quick fox", u"\"and brown\"", u"a", u"butter x"}) {
+    for (bool exact : {false, true}) {
+      QueryNodeVector nodes;
+      QueryParser::ParseQueryNodes(query, MatchingAlgorithm::DEFAULT, &nodes);
+      std::vector<size_t> expected;
+      for (size_t i = 0; i < index.size(); ++i) {
+        if (QueryParser::DoesQueryMatch(index.candidate(i), nodes, exact)) {
+          expected.push_back(i);
+        }
+      }
+      EXPECT_EQ(expected, index.FindMatches(nodes, exact))
+          << base::UTF16ToUTF8(query);
+    }
+  }
+}
+
+}  // namespace
+}  // namespace query_parser
@@ -6,10 +6,12 @@
 
 #include <string_view>
 
+#include "base/containers/span.h"
 #include "base/debug/crash_logging.h"
 #include "base/files/file_util.h"
 #include "base/memory/ptr_util.h"
 #include "base/memory/raw_ref.h"
+#include "base/numerics/byte_conversions.h"
 #include "base/run_loop.h"
 #include "base/strings/strcat.h"
 #include "base/threading/scoped_blocking_call.h"
@@ -32,12 +34,75 @@ std::string GenerateExtension(PrefixSize size) {
            base::Time::Now().ToDeltaSinceWindowsEpoch().InMicroseconds())});
 }
 
+// Ranges of at most this many prefixes are scanned rather than searched.
+constexpr size_t kLinearScanThreshold = 16;
+
+// After this many interpolation steps, the search bisects instead, so that a
+// skewed list can't make it linear.
+constexpr int kMaxInterpolationSteps = 4;
+
+// Returns the first four bytes of |prefix| as a number that sorts like it.
+uint32_t GetPrefixKey(std::string_view prefix) {
+  return base::U32FromBigEndian(base::as_byte_span(prefix).first<4u>());
+}
+
+// Returns the key of the prefix at |index| of |prefixes|.
+uint32_t GetPrefixKeyAt(HashPrefixesView prefixes,
+                        PrefixSize size,
+                        size_t index) {
+  return GetPrefixKey(prefixes.substr(index * size, kMinHashPrefixLength));
+}
+
 // Returns true if |hash_prefix| with PrefixSize |size| exists in |prefixes|.
+//
+// Hash prefixes are uniformly distributed, so interpolating on their leading
+// four bytes narrows the range down in a couple of probes, where a binary
+// search over a large mapped file would touch a page per step. The range that
+// is left is scanned in a loop without branches, which the compiler
+// vectorizes.
 bool HashPrefixMatches(std::string_view prefix,
                        HashPrefixesView prefixes,
                        PrefixSize size,
                        size_t start,
                        size_t end) {
+  if (size < kMinHashPrefixLength || prefix.size() != size) {
+    return std::binary_search(PrefixIterator(prefixes, start, size),
+                              PrefixIterator(prefixes, end, size), prefix);
+  }
+
+  // Invariant: |prefix| is in [start, end) if it is in |prefixes|.
+  const uint32_t key = GetPrefixKey(prefix);
+  for (int step = 0; end - start > kLinearScanThreshold; ++step) {
+    const uint32_t start_key = GetPrefixKeyAt(prefixes, size, start);
+    const uint32_t last_key = GetPrefixKeyAt(prefixes, size, end - 1);
+    if (key < start_key || key > last_key)
+      return false;
+    if (start_key == last_key)
+      break;
+
+    size_t probe = start + (end - start) / 2;
+    if (step < kMaxInterpolationSteps) {
+      probe = start + static_cast<size_t>(uint64_t{key - start_key} *
+                                          (end - 1 - start) /
+                                          (last_key - start_key));
+    }
+    const uint32_t probe_key = GetPrefixKeyAt(prefixes, size, probe);
+    if (probe_key < key) {
+      start = probe + 1;
+    } else if (probe_key > key) {
+      end = probe;
+    } else {
+      // Longer prefixes can share their leading bytes, so compare them fully.
+      break;
+    }
+  }
+
+  if (size == kMinHashPrefixLength && end - start <= kLinearScanThreshold) {
+    bool found = false;
+    for (size_t i = start; i < end; ++i)
+      found |= GetPrefixKeyAt(prefixes, size, i) == key;
+    return found;
+  }
   return std::binary_search(PrefixIterator(prefixes, start, size),
                             PrefixIterator(prefixes, end, size), prefix);
 }
@@ -6,8 +6,10 @@
 
 #include <type_traits>
 
+#include "base/containers/span.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/numerics/byte_conversions.h"
 #include "base/ranges/algorithm.h"
 #include "base/strings/string_util.h"
 #include "base/test/scoped_feature_list.h"
@@ -504,5 +506,46 @@ TYPED_TEST(HashPrefixMapTypedTest, ValidAfterWrite) {
   EXPECT_EQ(view[4], "fooo");
 }
 
+// Tests lookups in lists that are long enough to be searched rather than
+// scanned, including prefixes that share their leading bytes.
+TYPED_TEST(HashPrefixMapTypedTest, MatchesInLongLists) {
+  auto make_prefix = [](uint32_t n) {
+    std::string prefix(4, '\0');
+    base::as_writable_byte_span(prefix).copy_from(base::U32ToBigEndian(n));
+    return prefix;
+  };
+
+  auto& hash_prefix_map = this->hash_prefix_map();
+  for (uint32_t i = 1; i <= 1000; ++i)
+    hash_prefix_map.Append(4, make_prefix(i * 4000037u));
+  for (uint32_t i = 1; i <= 1000; ++i) {
+    hash_prefix_map.Append(8, make_prefix(i * 4000037u + 1) + "abcd");
+    hash_prefix_map.Append(8, make_prefix(i * 4000037u + 1) + "abcf");
+  }
+
+  V4StoreFileFormat file_format;
+  ASSERT_TRUE(hash_prefix_map.WriteToDisk(&file_format));
+
+  for (uint32_t i = 1; i <= 1000; ++i) {
+    std::string prefix = make_prefix(i * 4000037u);
+    EXPECT_EQ(hash_prefix_map.GetMatchingHashPrefix(prefix + "zzzz"), prefix);
+
+    prefix = make_prefix(i * 4000037u + 1);
+    EXPECT_EQ(hash_prefix_map.GetMatchingHashPrefix(prefix + "abcd"),
+              prefix + "abcd");
+    EXPECT_EQ(hash_prefix_map.GetMatchingHashPrefix(prefix + "abcf"),
+              prefix + "abcf");
+    EXPECT_EQ(hash_prefix_map.GetMatchingHashPrefix(prefix + "abce"), "");
+
+    prefix = make_prefix(i * 4000037u + 2);
+    EXPECT_EQ(hash_prefix_map.GetMatchingHashPrefix(prefix + "abcd"), "");
+  }
+  EXPECT_EQ(hash_prefix_map.GetMatchingHashPrefix(make_prefix(0) + "abcd"),
+            "");
+  EXPECT_EQ(
+      hash_prefix_map.GetMatchingHashPrefix(make_prefix(0xffffffff) + "abcd"),
+      "");
+}
+
 }  // namespace
 }  // namespace safe_browsing
@@ -7,6 +7,7 @@
 #include <memory>
 #include <utility>
 
+#include "base/containers/contains.h"
 #include "base/debug/crash_logging.h"
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
@@ -15,6 +16,7 @@
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/ranges/algorithm.h"
 #include "base/task/sequenced_task_runner.h"
 #include "base/time/time.h"
 #include "build/build_config.h"
@@ -38,6 +40,10 @@ constexpr base::TimeDelta kUmaMinTime = base::Milliseconds(1);
 constexpr base::TimeDelta kUmaMaxTime = base::Hours(5);
 constexpr int kUmaNumBuckets = 50;
 
+// The maximum number of full hashes in the negative result cache. A page load
+// checks a handful of full hashes per URL.
+constexpr size_t kMaxNegativeResults = 1000;
+
 // The factory that controls the creation of the V4Database object.
 base::LazyInstance<std::unique_ptr<V4DatabaseFactory>>::Leaky g_db_factory =
     LAZY_INSTANCE_INITIALIZER;
@@ -170,7 +176,8 @@ V4Database::V4Database(
     std::unique_ptr<StoreMap> store_map)
     : store_map_(std::move(store_map)),
       db_task_runner_(db_task_runner),
-      pending_store_updates_(0) {
+      pending_store_updates_(0),
+      negative_result_cache_(kMaxNegativeResults) {
   DCHECK(db_task_runner->RunsTasksInCurrentSequence());
   // This method executes on the DB sequence, whereas |sb_sequence_checker_|
   // is meant to verify methods that should execute on the IO sequence (or UI
@@ -247,6 +254,7 @@ void V4Database::UpdatedStoreReady(ListIdentifier identifier,
   if (new_store) {
     if (auto it = store_map_->find(identifier); it != store_map_->end()) {
       it->second.swap(new_store);
+      ClearNegativeResultCache();
     }
   }
 
@@ -292,8 +300,8 @@ void V4Database::GetStoresMatchingFullHash(
     const std::vector<FullHashStr>& full_hashes,
     const StoresToCheck& stores_to_check,
     base::OnceCallback<void(FullHashToStoreAndHashPrefixesMap)> callback) {
-  FullHashToStoreAndHashPrefixesMap results;
   DCHECK_CALLED_ON_VALID_SEQUENCE(sb_sequence_checker_);
+  const base::TimeTicks start_time = base::TimeTicks::Now();
 
   std::vector<std::pair<ListIdentifier, V4Store*>> stores;
   for (const ListIdentifier& identifier : stores_to_check) {
@@ -305,8 +313,20 @@ void V4Database::GetStoresMatchingFullHash(
     stores.emplace_back(identifier, store_pair->second.get());
   }
 
+  std::vector<FullHashStr> full_hashes_to_check;
+  full_hashes_to_check.reserve(full_hashes.size());
+  for (const FullHashStr& full_hash : full_hashes) {
+    if (!IsKnownNotToMatch(full_hash, stores_to_check)) {
+      full_hashes_to_check.push_back(full_hash);
+    }
+  }
+
   auto check_stores =
-      base::BindOnce(CheckStores, full_hashes, std::move(stores));
+      base::BindOnce(CheckStores, full_hashes_to_check, std::move(stores));
+  callback = base::BindOnce(
+      &V4Database::OnStoresChecked, weak_factory_on_io_.GetWeakPtr(),
+      std::move(full_hashes_to_check), stores_to_check,
+      negative_result_cache_generation_, start_time, std::move(callback));
 
   if (base::FeatureList::IsEnabled(kMmapSafeBrowsingDatabase) &&
       kMmapSafeBrowsingDatabaseAsync.Get()) {
@@ -325,6 +345,63 @@ void V4Database::ResetStores(
   for (const ListIdentifier& identifier : stores_to_reset) {
     store_map_->at(identifier)->Reset();
   }
+  ClearNegativeResultCache();
+}
+
+bool V4Database::IsKnownNotToMatch(const FullHashStr& full_hash,
+                                   const StoresToCheck& stores_to_check) {
+  if (!base::FeatureList::IsEnabled(kSafeBrowsingNegativeResultCache)) {
+    return false;
+  }
+
+  bool hit = false;
+  auto it = negative_result_cache_.Get(full_hash);
+  if (it != negative_result_cache_.end()) {
+    if (base::TimeTicks::Now() - it->second.time >
+        base::Seconds(kSafeBrowsingNegativeResultCacheTtlSeconds.Get())) {
+      negative_result_cache_.Erase(it);
+    } else {
+      hit = base::ranges::all_of(
+          stores_to_check, [&](const ListIdentifier& identifier) {
+            return base::Contains(it->second.stores, identifier);
+          });
+    }
+  }
+  base::UmaHistogramBoolean("SafeBrowsing.V4Database.NegativeResultCacheHit",
+                            hit);
+  return hit;
+}
+
+// static
+void V4Database::OnStoresChecked(
+    base::WeakPtr<V4Database> database,
+    std::vector<FullHashStr> full_hashes,
+    StoresToCheck stores_to_check,
+    int cache_generation,
+    base::TimeTicks start_time,
+    base::OnceCallback<void(FullHashToStoreAndHashPrefixesMap)> callback,
+    FullHashToStoreAndHashPrefixesMap results) {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  base::UmaHistogramMicrosecondsTimes(
+      "SafeBrowsing.V4Database.GetStoresMatchingFullHashDuration",
+      now - start_time);
+
+  if (database &&
+      cache_generation == database->negative_result_cache_generation_ &&
+      base::FeatureList::IsEnabled(kSafeBrowsingNegativeResultCache)) {
+    for (FullHashStr& full_hash : full_hashes) {
+      if (!base::Contains(results, full_hash)) {
+        database->negative_result_cache_.Put(
+            std::move(full_hash), NegativeResult{stores_to_check, now});
+      }
+    }
+  }
+  std::move(callback).Run(std::move(results));
+}
+
+void V4Database::ClearNegativeResultCache() {
+  negative_result_cache_.Clear();
+  negative_result_cache_generation_++;
 }
 
 void V4Database::VerifyChecksum(
@@ -10,6 +10,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "base/containers/lru_cache.h"
 #include "base/files/file_path.h"
 #include "base/functional/callback.h"
 #include "base/gtest_prod_util.h"
@@ -154,6 +155,8 @@ class V4Database {
   // database, filtered by |stores_to_check|. The callback is run synchronously,
   // or asynchronously if MmapSafeBrowsingDatabaseAsync is enabled, with the
   // identifier of the stores along with the matching hash prefixes.
+  // Full hashes that recently matched none of |stores_to_check| are not looked
+  // up again until the stores are updated.
   virtual void GetStoresMatchingFullHash(
       const std::vector<FullHashStr>& full_hashes,
       const StoresToCheck& stores_to_check,
@@ -212,6 +215,8 @@ class V4Database {
   FRIEND_TEST_ALL_PREFIXES(V4DatabaseTest, TestApplyUpdateWithEmptyUpdate);
   FRIEND_TEST_ALL_PREFIXES(V4DatabaseTest, TestApplyUpdateWithInvalidUpdate);
   FRIEND_TEST_ALL_PREFIXES(V4DatabaseTest, TestSomeStoresMatchFullHash);
+  FRIEND_TEST_ALL_PREFIXES(V4DatabaseTest,
+                           TestNegativeResultsAreCachedUntilStoresChange);
 
   // Factory method to create a V4Database. When the database creation is
   // complete, it calls the NewDatabaseReadyCallback on |callback_task_runner|.
@@ -244,6 +249,31 @@ class V4Database {
 
   bool IsStoreAvailable(const ListIdentifier& identifier) const;
 
+  // A full hash that matched none of |stores| when it was looked up at |time|.
+  struct NegativeResult {
+    StoresToCheck stores;
+    base::TimeTicks time;
+  };
+
+  // Returns true if |full_hash| recently matched none of |stores_to_check|.
+  bool IsKnownNotToMatch(const FullHashStr& full_hash,
+                         const StoresToCheck& stores_to_check);
+
+  // Adds the |full_hashes| that have no entry in |results| to the negative
+  // result cache of |database|, unless its stores changed since the lookup
+  // started, and then runs |callback| with |results|.
+  static void OnStoresChecked(
+      base::WeakPtr<V4Database> database,
+      std::vector<FullHashStr> full_hashes,
+      StoresToCheck stores_to_check,
+      int cache_generation,
+      base::TimeTicks start_time,
+      base::OnceCallback<void(FullHashToStoreAndHashPrefixesMap)> callback,
+      FullHashToStoreAndHashPrefixesMap results);
+
+  // Drops the negative results, which may no longer hold once stores change.
+  void ClearNegativeResultCache();
+
   // Log the difference in time between database updates in a UMA histogram.
   void RecordDatabaseUpdateLatency();
 
@@ -264,6 +294,14 @@ class V4Database {
   // Variable used to keep track of latency of database updates.
   base::Time last_update_;
 
+  // Full hashes that recently matched no store, keyed by full hash. Only
+  // accessed on the SB sequence.
+  base::HashingLRUCache<FullHashStr, NegativeResult> negative_result_cache_;
+
+  // Incremented whenever the negative results are dropped, so that lookups
+  // that were in flight at that point don't add theirs.
+  int negative_result_cache_generation_ = 0;
+
   // Only meant to be dereferenced and invalidated on the IO thread and hence
   // named. For details, see the comment at the top of weak_ptr.h
   base::WeakPtrFactory<V4Database> weak_factory_on_io_{this};
@@ -452,6 +452,43 @@ TEST_F(V4DatabaseTest, TestSomeStoresMatchFullHashBecauseOfStoresToMatch) {
   EXPECT_FALSE(store_and_hash_prefixes.begin()->hash_prefix.empty());
 }
 
+// Test to ensure that a full hash that matched no store isn't looked up again
+// until the stores change, unless other stores are checked.
+TEST_F(V4DatabaseTest, TestNegativeResultsAreCachedUntilStoresChange) {
+  bool hash_prefix_matches = false;
+  RegisterFactory(hash_prefix_matches);
+
+  V4Database::Create(task_runner_, database_dirname_, list_infos_,
+                     std::move(callback_db_ready_));
+  created_but_not_called_back_ = true;
+  WaitForTasksOnTaskRunner();
+  EXPECT_EQ(true, created_and_called_back_);
+
+  auto get_matches = [this](const StoresToCheck& stores_to_check) {
+    base::test::TestFuture<FullHashToStoreAndHashPrefixesMap> results;
+    v4_database_->GetStoresMatchingFullHash({"anything"}, stores_to_check,
+                                            results.GetCallback());
+    WaitForTasksOnTaskRunner();
+    return results.Take()["anything"].size();
+  };
+
+  EXPECT_EQ(0u, get_matches({linux_malware_id_}));
+
+  // Stores are only changed by updates outside of tests, so the cached result
+  // is returned.
+  for (const ListIdentifier& id : {linux_malware_id_, win_malware_id_}) {
+    static_cast<FakeV4Store*>(v4_database_->store_map_->at(id).get())
+        ->set_hash_prefix_matches(true);
+  }
+  EXPECT_EQ(0u, get_matches({linux_malware_id_}));
+
+  // A store that wasn't checked is looked up.
+  EXPECT_EQ(2u, get_matches({linux_malware_id_, win_malware_id_}));
+
+  v4_database_->ResetStores({});
+  EXPECT_EQ(1u, get_matches({linux_malware_id_}));
+}
+
 TEST_F(V4DatabaseTest, VerifyChecksumCalledAsync) {
   bool hash_prefix_matches = true;
   RegisterFactory(hash_prefix_matches);
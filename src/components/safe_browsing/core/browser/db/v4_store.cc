@@ -51,6 +51,8 @@ const char kAdditionsHashesCountPartialUpdate[] = ".AdditionsHashesCount";
 const char kAdditionsHashesCountFullUpdate[] = ".AdditionsHashesCount2";
 const char kRemovalsHashesCount[] = ".RemovalsHashesCount";
 const char kApplyUpdateDuration[] = ".ApplyUpdateDuration";
+const char kDecodeAdditionsDuration[] = ".DecodeAdditionsDuration";
+const char kMergeUpdateDuration[] = ".MergeUpdateDuration";
 const char kVerifyChecksumDuration[] = ".VerifyChecksumDuration";
 // Part 3: Represent the unit of value being measured and logged.
 const char kResult[] = ".Result";
@@ -159,6 +161,20 @@ void RecordApplyUpdateDuration(const std::string& base_metric,
                                  file_path);
 }
 
+void RecordDecodeAdditionsDuration(const std::string& base_metric,
+                                   base::TimeDelta duration,
+                                   const base::FilePath& file_path) {
+  RecordTimeWithAndWithoutSuffix(base_metric + kDecodeAdditionsDuration,
+                                 duration, file_path);
+}
+
+void RecordMergeUpdateDuration(const std::string& base_metric,
+                               base::TimeDelta duration,
+                               const base::FilePath& file_path) {
+  RecordTimeWithAndWithoutSuffix(base_metric + kMergeUpdateDuration, duration,
+                                 file_path);
+}
+
 void RecordVerifyChecksumDuration(const std::string& base_metric,
                                   base::TimeDelta duration,
                                   const base::FilePath& file_path) {
@@ -529,11 +545,13 @@ ApplyUpdateResult V4Store::ProcessUpdate(
     // reset the store.
     expected_checksum_ = expected_checksum;
   } else {
+    base::ElapsedThreadTimer merge_timer;
     apply_update_result = MergeUpdate(hash_prefix_map_old, hash_prefix_map,
                                       raw_removals, expected_checksum);
     if (apply_update_result != APPLY_UPDATE_SUCCESS) {
       return apply_update_result;
     }
+    RecordMergeUpdateDuration(metric, merge_timer.Elapsed(), store_path_);
   }
 
   state_ = response->new_client_state();
@@ -609,10 +627,15 @@ ApplyUpdateResult V4Store::UpdateHashPrefixMapFromAdditions(
 
       const RiceDeltaEncoding& rice_hashes = addition.rice_hashes();
       std::vector<uint32_t> raw_hashes;
+      base::ElapsedThreadTimer decode_timer;
       V4DecodeResult decode_result = V4RiceDecoder::DecodePrefixes(
           rice_hashes.first_value(), rice_hashes.rice_parameter(),
           rice_hashes.num_entries(), rice_hashes.encoded_data(), &raw_hashes);
       RecordDecodeAdditionsResult(metric, decode_result, store_path_);
+      if (decode_result == DECODE_SUCCESS) {
+        RecordDecodeAdditionsDuration(metric, decode_timer.Elapsed(),
+                                      store_path_);
+      }
       if (decode_result != DECODE_SUCCESS) {
         return RICE_DECODING_FAILURE;
       } else {
@@ -678,8 +701,7 @@ ApplyUpdateResult V4Store::AddUnlumpedHashes(PrefixSize prefix_size,
 bool V4Store::GetNextSmallestUnmergedPrefix(
     const HashPrefixMap& hash_prefix_map,
     const IteratorMap& iterator_map,
-    HashPrefixStr* smallest_hash_prefix) {
-  HashPrefixStr current_hash_prefix;
+    HashPrefixesView* smallest_hash_prefix) {
   bool has_unmerged = false;
 
   for (const auto& iterator_pair : iterator_map) {
@@ -690,10 +712,11 @@ bool V4Store::GetNextSmallestUnmergedPrefix(
     PrefixSize distance = std::distance(start, hash_prefixes.end());
     CHECK_EQ(0u, distance % prefix_size);
     if (prefix_size <= distance) {
-      current_hash_prefix = HashPrefixStr(start, start + prefix_size);
+      HashPrefixesView current_hash_prefix = hash_prefixes.substr(
+          std::distance(hash_prefixes.begin(), start), prefix_size);
       if (!has_unmerged || *smallest_hash_prefix > current_hash_prefix) {
         has_unmerged = true;
-        smallest_hash_prefix->swap(current_hash_prefix);
+        *smallest_hash_prefix = current_hash_prefix;
       }
     }
   }
@@ -748,13 +771,13 @@ ApplyUpdateResult V4Store::MergeUpdate(const HashPrefixMap& old_prefixes_map,
                           hash_prefix_map_.get());
 
   IteratorMap old_iterator_map;
-  HashPrefixStr next_smallest_prefix_old;
+  HashPrefixesView next_smallest_prefix_old;
   InitializeIteratorMap(old_prefixes_map, &old_iterator_map);
   bool old_has_unmerged = GetNextSmallestUnmergedPrefix(
       old_prefixes_map, old_iterator_map, &next_smallest_prefix_old);
 
   IteratorMap additions_iterator_map;
-  HashPrefixStr next_smallest_prefix_additions;
+  HashPrefixesView next_smallest_prefix_additions;
   InitializeIteratorMap(additions_map, &additions_iterator_map);
   bool additions_has_unmerged = GetNextSmallestUnmergedPrefix(
       additions_map, additions_iterator_map, &next_smallest_prefix_additions);
@@ -283,11 +283,12 @@ class V4Store {
   // Get the next unmerged hash prefix in dictionary order from
   // |hash_prefix_map|. |iterator_map| is used to determine which hash prefixes
   // have been merged already. Returns true if there are any unmerged hash
-  // prefixes in the list.
+  // prefixes in the list. |smallest_hash_prefix| points into |hash_prefix_map|,
+  // so that merging doesn't copy each prefix.
   static bool GetNextSmallestUnmergedPrefix(
       const HashPrefixMap& hash_prefix_map,
       const IteratorMap& iterator_map,
-      HashPrefixStr* smallest_hash_prefix);
+      HashPrefixesView* smallest_hash_prefix);
 
   // For each key in |hash_prefix_map|, sets the iterator at that key
   // |iterator_map| to hash_prefix_map[key].begin().
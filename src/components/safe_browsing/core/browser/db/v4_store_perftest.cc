@@ -8,11 +8,17 @@
 #include <utility>
 #include <vector>
 
+#include "base/files/scoped_temp_dir.h"
 #include "base/memory/ref_counted.h"
 #include "base/numerics/checked_math.h"
+#include "base/process/process_metrics.h"
+#include "base/ranges/algorithm.h"
 #include "base/strings/stringprintf.h"
+#include "base/test/task_environment.h"
 #include "base/test/test_simple_task_runner.h"
 #include "base/timer/elapsed_timer.h"
+#include "build/build_config.h"
+#include "components/safe_browsing/core/browser/db/hash_prefix_map.h"
 #include "components/safe_browsing/core/browser/db/v4_protocol_manager_util.h"
 #include "components/safe_browsing/core/browser/db/v4_test_util.h"
 #include "crypto/sha2.h"
@@ -25,6 +31,8 @@ namespace {
 
 constexpr char kMetricPrefixV4Store[] = "V4Store.";
 constexpr char kMetricGetMatchingHashPrefixMs[] = "get_matching_hash_prefix";
+constexpr char kMetricPrefixHashPrefixMap[] = "HashPrefixMap.";
+constexpr char kMetricResidentSetSizeDeltaKb[] = "resident_set_size_delta";
 
 perf_test::PerfResultReporter SetUpV4StoreReporter(const std::string& story) {
   perf_test::PerfResultReporter reporter(kMetricPrefixV4Store, story);
@@ -32,6 +40,25 @@ perf_test::PerfResultReporter SetUpV4StoreReporter(const std::string& story) {
   return reporter;
 }
 
+perf_test::PerfResultReporter SetUpHashPrefixMapReporter(
+    const std::string& story) {
+  perf_test::PerfResultReporter reporter(kMetricPrefixHashPrefixMap, story);
+  reporter.RegisterImportantMetric(kMetricGetMatchingHashPrefixMs, "ms");
+  reporter.RegisterImportantMetric(kMetricResidentSetSizeDeltaKb, "KB");
+  return reporter;
+}
+
+#if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_CHROMEOS) || BUILDFLAG(IS_ANDROID)
+size_t GetResidentSetSize() {
+  return base::ProcessMetrics::CreateCurrentProcessMetrics()
+      ->GetResidentSetSize();
+}
+#else
+size_t GetResidentSetSize() {
+  return 0;
+}
+#endif
+
 }  // namespace
 
 class V4StorePerftest : public testing::Test {};
@@ -80,4 +107,71 @@ TEST_F(V4StorePerftest, StressTest) {
   EXPECT_EQ(kNumPrefixes, matches);
 }
 
+// Compares the lookup latency of the HashPrefixMap implementations, and the
+// memory they keep resident once the prefixes have been written out.
+TEST_F(V4StorePerftest, HashPrefixMapLookup) {
+#if defined(NDEBUG)
+  const size_t kNumPrefixes = 2000000;
+#else
+  const size_t kNumPrefixes = 20000;
+#endif
+
+  std::string full_hashes(kNumPrefixes * kMaxHashPrefixLength, 0);
+  for (size_t i = 0; i < kNumPrefixes; i++) {
+    crypto::SHA256HashString(base::StringPrintf("%zu", i),
+                             &full_hashes[i * kMaxHashPrefixLength],
+                             kMaxHashPrefixLength);
+  }
+  std::vector<std::string_view> prefixes;
+  for (size_t i = 0; i < kNumPrefixes; i++) {
+    prefixes.push_back(std::string_view(full_hashes)
+                           .substr(i * kMaxHashPrefixLength,
+                                   kMinHashPrefixLength));
+  }
+  base::ranges::sort(prefixes);
+
+  base::test::SingleThreadTaskEnvironment task_environment;
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+
+  auto run_story = [&](const std::string& story, HashPrefixMap& map) {
+    const size_t rss_before = GetResidentSetSize();
+    for (std::string_view prefix : prefixes)
+      map.Append(kMinHashPrefixLength, prefix);
+    V4StoreFileFormat file_format;
+    std::unique_ptr<HashPrefixMap::WriteSession> session =
+        map.WriteToDisk(&file_format);
+    ASSERT_TRUE(session);
+    session.reset();
+
+    size_t matches = 0;
+    auto reporter = SetUpHashPrefixMapReporter(story);
+    base::ElapsedTimer timer;
+    for (size_t i = 0; i < kNumPrefixes; i++) {
+      matches += !map.GetMatchingHashPrefix(
+                         std::string_view(full_hashes)
+                             .substr(i * kMaxHashPrefixLength,
+                                     kMaxHashPrefixLength))
+                      .empty();
+    }
+    reporter.AddResult(kMetricGetMatchingHashPrefixMs,
+                       timer.Elapsed().InMillisecondsF());
+    const size_t rss_after = GetResidentSetSize();
+    reporter.AddResult(kMetricResidentSetSizeDeltaKb,
+                       rss_after > rss_before
+                           ? static_cast<double>(rss_after - rss_before) / 1024
+                           : 0.0);
+    EXPECT_EQ(kNumPrefixes, matches);
+  };
+
+  {
+    InMemoryHashPrefixMap map;
+    run_story("in_memory", map);
+  }
+  {
+    MmapHashPrefixMap map(temp_dir.GetPath().AppendASCII("Mmap"));
+    run_story("mmap", map);
+  }
+}
+
 }  // namespace safe_browsing
@@ -209,7 +209,7 @@ TEST_F(V4StoreTest, TestGetNextSmallestUnmergedPrefixWithEmptyPrefixMap) {
   IteratorMap iterator_map;
   V4Store::InitializeIteratorMap(prefix_map, &iterator_map);
 
-  HashPrefixStr prefix;
+  HashPrefixesView prefix;
   EXPECT_FALSE(V4Store::GetNextSmallestUnmergedPrefix(prefix_map, iterator_map,
                                                       &prefix));
 }
@@ -223,7 +223,7 @@ TEST_F(V4StoreTest, TestGetNextSmallestUnmergedPrefix) {
   IteratorMap iterator_map;
   V4Store::InitializeIteratorMap(prefix_map, &iterator_map);
 
-  HashPrefixStr prefix;
+  HashPrefixesView prefix;
   EXPECT_TRUE(V4Store::GetNextSmallestUnmergedPrefix(prefix_map, iterator_map,
                                                      &prefix));
   EXPECT_EQ("****", prefix);
@@ -258,6 +258,13 @@ BASE_FEATURE(kSafeBrowsingNewGmsApiForSubresourceFilterCheck,
              base::FEATURE_DISABLED_BY_DEFAULT);
 #endif
 
+BASE_FEATURE(kSafeBrowsingNegativeResultCache,
+             "SafeBrowsingNegativeResultCache",
+             base::FEATURE_ENABLED_BY_DEFAULT);
+
+constexpr base::FeatureParam<int> kSafeBrowsingNegativeResultCacheTtlSeconds{
+    &kSafeBrowsingNegativeResultCache, "ttl_seconds", 60};
+
 BASE_FEATURE(kSafeBrowsingOnUIThread,
              "SafeBrowsingOnUIThread",
 // TODO(crbug.com/40061554): Fix iOS tests with this enabled.
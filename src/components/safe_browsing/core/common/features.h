@@ -209,6 +209,14 @@ BASE_DECLARE_FEATURE(kSafeBrowsingNewGmsApiForBrowseUrlDatabaseCheck);
 BASE_DECLARE_FEATURE(kSafeBrowsingNewGmsApiForSubresourceFilterCheck);
 #endif
 
+// Enables a short-lived cache of the full hashes that matched no local
+// Safe Browsing list, so that URLs checked again soon after skip the lookup.
+BASE_DECLARE_FEATURE(kSafeBrowsingNegativeResultCache);
+
+// The number of seconds for which a full hash stays in the cache of
+// kSafeBrowsingNegativeResultCache.
+extern const base::FeatureParam<int> kSafeBrowsingNegativeResultCacheTtlSeconds;
+
 // Run Safe Browsing code on UI thread.
 BASE_DECLARE_FEATURE(kSafeBrowsingOnUIThread);
 
@@ -8,8 +8,11 @@
 #include <cstddef>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
+#include "base/check_op.h"
+#include "base/containers/contains.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/user_metrics.h"
 #include "base/metrics/user_metrics_action.h"
@@ -67,8 +70,35 @@ bool ShouldPlaceBefore(const SavedTabGroup& group1,
 
 }  // anonymous namespace
 
+SavedTabGroupModel::ScopedSyncUpdateBatch::ScopedSyncUpdateBatch(
+    SavedTabGroupModel* model)
+    : model_(model) {
+  ++model_->sync_update_batch_depth_;
+}
+
+SavedTabGroupModel::ScopedSyncUpdateBatch::~ScopedSyncUpdateBatch() {
+  CHECK_GT(model_->sync_update_batch_depth_, 0);
+  if (--model_->sync_update_batch_depth_ > 0) {
+    return;
+  }
+
+  const std::vector<base::Uuid> group_ids =
+      std::exchange(model_->groups_updated_from_sync_, {});
+  for (const base::Uuid& group_id : group_ids) {
+    // Observers were already notified of the groups removed since.
+    if (!model_->Contains(group_id)) {
+      continue;
+    }
+    for (auto& observer : model_->observers_) {
+      observer.SavedTabGroupUpdatedFromSync(group_id);
+    }
+  }
+}
+
 SavedTabGroupModel::SavedTabGroupModel() = default;
-SavedTabGroupModel::~SavedTabGroupModel() = default;
+SavedTabGroupModel::~SavedTabGroupModel() {
+  DCHECK_EQ(sync_update_batch_depth_, 0);
+}
 
 std::optional<int> SavedTabGroupModel::GetIndexOf(
     LocalTabGroupID tab_group_id) const {
@@ -240,9 +270,7 @@ void SavedTabGroupModel::UpdatedVisualDataFromSync(
   const std::optional<int> index = GetIndexOf(tab_group_id);
   UpdateVisualDataImpl(index.value(), visual_data);
   base::Uuid updated_guid = Get(tab_group_id)->saved_guid();
-  for (auto& observer : observers_) {
-    observer.SavedTabGroupUpdatedFromSync(updated_guid);
-  }
+  NotifyUpdatedFromSync(updated_guid);
 }
 
 void SavedTabGroupModel::UpdatedVisualDataFromSync(
@@ -253,9 +281,7 @@ void SavedTabGroupModel::UpdatedVisualDataFromSync(
 
   const std::optional<int> index = GetIndexOf(id);
   UpdateVisualDataImpl(index.value(), visual_data);
-  for (auto& observer : observers_) {
-    observer.SavedTabGroupUpdatedFromSync(id);
-  }
+  NotifyUpdatedFromSync(id);
 }
 
 SavedTabGroup* SavedTabGroupModel::GetGroupContainingTab(
@@ -312,9 +338,7 @@ void SavedTabGroupModel::AddTabToGroupFromSync(const base::Uuid& group_id,
     saved_tab_groups_[group_index.value()].AddTabFromSync(tab);
   }
 
-  for (auto& observer : observers_) {
-    observer.SavedTabGroupUpdatedFromSync(group_id, tab_id);
-  }
+  NotifyUpdatedFromSync(group_id, tab_id);
 }
 
 void SavedTabGroupModel::UpdateTabInGroup(const base::Uuid& group_id,
@@ -353,7 +377,7 @@ void SavedTabGroupModel::RemoveTabFromGroupLocally(const base::Uuid& group_id,
   }
 
   std::optional<int> index = GetIndexOf(group_id);
-  SavedTabGroup group = saved_tab_groups_[index.value()];
+  const SavedTabGroup& group = saved_tab_groups_[index.value()];
 
   if (!group.ContainsTab(tab_id)) {
     return;
@@ -387,7 +411,7 @@ void SavedTabGroupModel::RemoveTabFromGroupFromSync(const base::Uuid& group_id,
   }
 
   std::optional<int> index = GetIndexOf(group_id);
-  SavedTabGroup group = saved_tab_groups_[index.value()];
+  const SavedTabGroup& group = saved_tab_groups_[index.value()];
 
   if (!group.ContainsTab(tab_id)) {
     return;
@@ -405,9 +429,7 @@ void SavedTabGroupModel::RemoveTabFromGroupFromSync(const base::Uuid& group_id,
 
   // TODO(dljames): Update to use SavedTabGroupRemoveFromSync and update the API
   // to pass a group_id and an optional tab_id.
-  for (auto& observer : observers_) {
-    observer.SavedTabGroupUpdatedFromSync(group_id, copy_tab_id);
-  }
+  NotifyUpdatedFromSync(group_id, copy_tab_id);
 }
 
 void SavedTabGroupModel::MoveTabInGroupTo(const base::Uuid& group_id,
@@ -465,9 +487,7 @@ std::unique_ptr<sync_pb::SavedTabGroupSpecifics> SavedTabGroupModel::MergeGroup(
                          std::min(std::max(new_index, 0), Count() - 1));
   }
 
-  for (auto& observer : observers_) {
-    observer.SavedTabGroupUpdatedFromSync(group_id);
-  }
+  NotifyUpdatedFromSync(group_id);
 
   return Get(group_id)->ToSpecifics();
 }
@@ -493,9 +513,7 @@ std::unique_ptr<sync_pb::SavedTabGroupSpecifics> SavedTabGroupModel::MergeTab(
     group->MoveTabFromSync(tab_guid, std::max(new_index, 0));
   }
 
-  for (auto& observer : observers_) {
-    observer.SavedTabGroupUpdatedFromSync(group_guid, tab_guid);
-  }
+  NotifyUpdatedFromSync(group_guid, tab_guid);
 
   return group->GetTab(tab_guid)->ToSpecifics();
 }
@@ -536,13 +554,17 @@ SavedTabGroupModel::LoadStoredEntries(
 
   UpdateGroupPositionsImpl();
 
-  for (const SavedTabGroupTab& tab : tabs) {
-    std::optional<int> index = GetIndexOf(tab.saved_group_guid());
-    if (!index.has_value()) {
-      tabs_missing_groups.emplace_back(std::move(*tab.ToSpecifics()));
-    } else {
-      base::Uuid group_id = tab.saved_group_guid();
-      AddTabToGroupFromSync(group_id, std::move(tab));
+  {
+    // Notify observers of each group once, rather than once per tab.
+    ScopedSyncUpdateBatch update_batch(this);
+    for (const SavedTabGroupTab& tab : tabs) {
+      std::optional<int> index = GetIndexOf(tab.saved_group_guid());
+      if (!index.has_value()) {
+        tabs_missing_groups.emplace_back(std::move(*tab.ToSpecifics()));
+      } else {
+        base::Uuid group_id = tab.saved_group_guid();
+        AddTabToGroupFromSync(group_id, std::move(tab));
+      }
     }
   }
 
@@ -656,6 +678,21 @@ std::unique_ptr<SavedTabGroup> SavedTabGroupModel::RemoveImpl(int index) {
   return removed_group;
 }
 
+void SavedTabGroupModel::NotifyUpdatedFromSync(
+    const base::Uuid& group_id,
+    const std::optional<base::Uuid>& tab_id) {
+  if (sync_update_batch_depth_ > 0) {
+    if (!base::Contains(groups_updated_from_sync_, group_id)) {
+      groups_updated_from_sync_.push_back(group_id);
+    }
+    return;
+  }
+
+  for (auto& observer : observers_) {
+    observer.SavedTabGroupUpdatedFromSync(group_id, tab_id);
+  }
+}
+
 void SavedTabGroupModel::UpdateVisualDataImpl(
     int index,
     const tab_groups::TabGroupVisualData* visual_data) {
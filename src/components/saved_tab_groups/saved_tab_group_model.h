@@ -27,6 +27,22 @@ class SavedTabGroup;
 // session.
 class SavedTabGroupModel {
  public:
+  // While alive, defers the SavedTabGroupUpdatedFromSync() notifications of
+  // `model` and coalesces them into one per updated group, without a tab id,
+  // sent when the outermost batch is destroyed. Used when applying many sync
+  // changes at once, e.g. on initial sync, so that observers refresh a large
+  // group once rather than once per tab.
+  class ScopedSyncUpdateBatch {
+   public:
+    explicit ScopedSyncUpdateBatch(SavedTabGroupModel* model);
+    ScopedSyncUpdateBatch(const ScopedSyncUpdateBatch&) = delete;
+    ScopedSyncUpdateBatch& operator=(const ScopedSyncUpdateBatch&) = delete;
+    ~ScopedSyncUpdateBatch();
+
+   private:
+    const raw_ptr<SavedTabGroupModel> model_;
+  };
+
   SavedTabGroupModel();
   SavedTabGroupModel(const SavedTabGroupModel&) = delete;
   SavedTabGroupModel& operator=(const SavedTabGroupModel& other) = delete;
@@ -176,6 +192,12 @@ class SavedTabGroupModel {
   // work as intended. To do this, UpdatePositionsImpl() can be called.
   void InsertGroupImpl(const SavedTabGroup& group);
 
+  // Notifies observers that the group `group_id` was updated from sync, or
+  // defers the notification while a ScopedSyncUpdateBatch is alive.
+  void NotifyUpdatedFromSync(
+      const base::Uuid& group_id,
+      const std::optional<base::Uuid>& tab_id = std::nullopt);
+
   // Implementations of CRUD operations.
   std::unique_ptr<SavedTabGroup> RemoveImpl(int index);
   void UpdateVisualDataImpl(int index,
@@ -184,6 +206,13 @@ class SavedTabGroupModel {
   // Obsevers of the model.
   base::ObserverList<SavedTabGroupModelObserver>::Unchecked observers_;
 
+  // Number of live ScopedSyncUpdateBatch objects.
+  int sync_update_batch_depth_ = 0;
+
+  // Groups updated from sync during the current batch, in the order of their
+  // first update.
+  std::vector<base::Uuid> groups_updated_from_sync_;
+
   // True when SavedTabGroupModel::LoadStoredEntries has finished, false
   // otherwise.
   bool is_loaded_ = false;
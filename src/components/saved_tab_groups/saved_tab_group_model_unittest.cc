@@ -1107,6 +1107,54 @@ TEST_P(SavedTabGroupModelObserverTest, UpdatedElementFromSync) {
             retrieved_index_);
 }
 
+// Tests that updates from sync made during a ScopedSyncUpdateBatch are
+// coalesced into one notification per group once the batch ends.
+TEST_P(SavedTabGroupModelObserverTest, UpdatesFromSyncAreBatched) {
+  SavedTabGroup group_1(test::CreateTestSavedTabGroup());
+  SavedTabGroup group_2(test::CreateTestSavedTabGroup());
+  SavedTabGroup group_3(test::CreateTestSavedTabGroup());
+  saved_tab_group_model_->Add(group_1);
+  saved_tab_group_model_->Add(group_2);
+  saved_tab_group_model_->Add(group_3);
+  ClearSignals();
+
+  {
+    SavedTabGroupModel::ScopedSyncUpdateBatch batch(
+        saved_tab_group_model_.get());
+    for (int i = 0; i < 3; ++i) {
+      saved_tab_group_model_->AddTabToGroupFromSync(
+          group_1.saved_guid(),
+          test::CreateSavedTabGroupTab(base_path_ + "1", u"Tab",
+                                       group_1.saved_guid()));
+    }
+    saved_tab_group_model_->AddTabToGroupFromSync(
+        group_2.saved_guid(),
+        test::CreateSavedTabGroupTab(base_path_ + "2", u"Tab",
+                                     group_2.saved_guid()));
+    saved_tab_group_model_->AddTabToGroupFromSync(
+        group_3.saved_guid(),
+        test::CreateSavedTabGroupTab(base_path_ + "3", u"Tab",
+                                     group_3.saved_guid()));
+    saved_tab_group_model_->RemovedFromSync(group_3.saved_guid());
+    EXPECT_TRUE(retrieved_group_.empty());
+  }
+
+  // The removed group is not notified of as updated.
+  ASSERT_EQ(2u, retrieved_group_.size());
+  EXPECT_EQ(group_1.saved_guid(), retrieved_group_[0].saved_guid());
+  EXPECT_EQ(group_1.saved_tabs().size() + 3,
+            retrieved_group_[0].saved_tabs().size());
+  EXPECT_EQ(group_2.saved_guid(), retrieved_group_[1].saved_guid());
+
+  // Updates are notified right away again.
+  ClearSignals();
+  saved_tab_group_model_->AddTabToGroupFromSync(
+      group_2.saved_guid(),
+      test::CreateSavedTabGroupTab(base_path_ + "2", u"Tab",
+                                   group_2.saved_guid()));
+  EXPECT_EQ(1u, retrieved_group_.size());
+}
+
 // Verify that SavedTabGroupModel::OnGroupClosedInTabStrip passes the correct
 // index.
 TEST_P(SavedTabGroupModelObserverTest, OnGroupClosedInTabStrip) {
@@ -74,6 +74,8 @@ SavedTabGroupSyncBridge::CreateMetadataChangeList() {
 std::optional<syncer::ModelError> SavedTabGroupSyncBridge::MergeFullSyncData(
     std::unique_ptr<syncer::MetadataChangeList> metadata_change_list,
     syncer::EntityChangeList entity_changes) {
+  // Notify observers of each updated group once, after all the changes.
+  SavedTabGroupModel::ScopedSyncUpdateBatch update_batch(model_);
   std::unique_ptr<syncer::ModelTypeStore::WriteBatch> write_batch =
       store_->CreateWriteBatch();
   std::set<std::string> synced_items;
@@ -113,6 +115,8 @@ std::optional<syncer::ModelError>
 SavedTabGroupSyncBridge::ApplyIncrementalSyncChanges(
     std::unique_ptr<syncer::MetadataChangeList> metadata_change_list,
     syncer::EntityChangeList entity_changes) {
+  // Notify observers of each updated group once, after all the changes.
+  SavedTabGroupModel::ScopedSyncUpdateBatch update_batch(model_);
   std::unique_ptr<syncer::ModelTypeStore::WriteBatch> write_batch =
       store_->CreateWriteBatch();
 
@@ -212,30 +212,6 @@ TemplateURL MergeEnterpriseSiteSearchEngines(const TemplateURL& existing_turl,
 
 }  // namespace
 
-// TemplateURLService::LessWithPrefix -----------------------------------------
-
-class TemplateURLService::LessWithPrefix {
- public:
-  // We want to find the set of keywords that begin with a prefix.  The STL
-  // algorithms will return the set of elements that are "equal to" the
-  // prefix, where "equal(x, y)" means "!(cmp(x, y) || cmp(y, x))".  When
-  // cmp() is the typical std::less<>, this results in lexicographic equality;
-  // we need to extend this to mark a prefix as "not less than" a keyword it
-  // begins, which will cause the desired elements to be considered "equal to"
-  // the prefix.  Note: this is still a strict weak ordering, as required by
-  // equal_range() (though I will not prove that here).
-  //
-  // Unfortunately the calling convention is not "prefix and element" but
-  // rather "two elements", so we pass the prefix as a fake "element" which has
-  // a NULL KeywordDataElement pointer.
-  bool operator()(const KeywordToTURL::value_type& elem1,
-                  const KeywordToTURL::value_type& elem2) const {
-    return (elem1.second == nullptr)
-               ? (elem2.first.compare(0, elem1.first.length(), elem1.first) > 0)
-               : (elem1.first < elem2.first);
-  }
-};
-
 // TemplateURLService::Scoper -------------------------------------------------
 
 class TemplateURLService::Scoper {
@@ -337,6 +313,33 @@ class TemplateURLService::PreLoadingProviders {
         guid));
   }
 
+  // Adds to `matches` the providers whose keywords begin with `prefix`, sorted
+  // by keyword. If `supports_replacement_only` is true, only providers that
+  // support replacement are added.
+  void AddMatchingKeywords(const std::u16string& prefix,
+                           bool supports_replacement_only,
+                           const SearchTermsData& search_terms_data,
+                           TemplateURLVector* matches) {
+    const size_t first_match = matches->size();
+    auto add_if_matching = [&](TemplateURL* turl) {
+      if (base::StartsWith(turl->keyword(), prefix) &&
+          (!supports_replacement_only ||
+           turl->url_ref().SupportsReplacement(search_terms_data))) {
+        matches->push_back(turl);
+      }
+    };
+    if (default_search_provider_) {
+      add_if_matching(default_search_provider_.get());
+    }
+    for (auto& site_search_engine : site_search_engines_) {
+      add_if_matching(site_search_engine.get());
+    }
+    std::stable_sort(matches->begin() + first_match, matches->end(),
+                     [](const TemplateURL* a, const TemplateURL* b) {
+                       return a->keyword() < b->keyword();
+                     });
+  }
+
   // Returns the best `TemplateURL` found with a URL using the specified `host`,
   // or nullptr if no such URL can be found.
   const TemplateURL* GetTemplateURLForHost(
@@ -619,6 +622,13 @@ bool TemplateURLService::FeaturedOverridesNonFeatured(
 void TemplateURLService::AddMatchingKeywords(const std::u16string& prefix,
                                              bool supports_replacement_only,
                                              TemplateURLVector* matches) {
+  if (!loaded_) {
+    if (!prefix.empty()) {
+      pre_loading_providers_->AddMatchingKeywords(
+          prefix, supports_replacement_only, search_terms_data(), matches);
+    }
+    return;
+  }
   AddMatchingKeywordsHelper(keyword_to_turl_, prefix, supports_replacement_only,
                             matches);
 }
@@ -2935,9 +2945,8 @@ void TemplateURLService::MaybeSetIsActiveSearchEngines(
   }
 }
 
-template <typename Container>
 void TemplateURLService::AddMatchingKeywordsHelper(
-    const Container& keyword_to_turl,
+    const KeywordToTURL& keyword_to_turl,
     const std::u16string& prefix,
     bool supports_replacement_only,
     TemplateURLVector* matches) {
@@ -2946,16 +2955,11 @@ void TemplateURLService::AddMatchingKeywordsHelper(
     return;
   DCHECK(matches);
 
-  // Find matching keyword range.  Searches the element map for keywords
-  // beginning with |prefix| and stores the endpoints of the resulting set in
-  // |match_range|.
-  const auto match_range(std::equal_range(
-      keyword_to_turl.begin(), keyword_to_turl.end(),
-      typename Container::value_type(prefix, nullptr), LessWithPrefix()));
-
-  // Add to vector of matching keywords.
-  for (typename Container::const_iterator i(match_range.first);
-    i != match_range.second; ++i) {
+  // The keywords beginning with |prefix| are contiguous in the map, starting at
+  // the first keyword not less than |prefix|. Seek to it instead of running
+  // std::equal_range(), which walks the map's iterators linearly.
+  for (auto i = keyword_to_turl.lower_bound(prefix);
+       i != keyword_to_turl.end() && base::StartsWith(i->first, prefix); ++i) {
     if (!supports_replacement_only ||
         i->second->url_ref().SupportsReplacement(search_terms_data())) {
       matches->push_back(i->second);
@@ -207,7 +207,9 @@ class TemplateURLService final : public WebDataServiceConsumer,
   // Adds to |matches| all TemplateURLs whose keywords begin with |prefix|,
   // sorted shortest-keyword-first. If |supports_replacement_only| is true, only
   // TemplateURLs that support replacement are returned. This method must be
-  // efficient, since it's run roughly once per omnibox keystroke.
+  // efficient, since it's run roughly once per omnibox keystroke. Before the
+  // keywords table is loaded, only the default search provider and the site
+  // search engines set by policy are matched.
   void AddMatchingKeywords(const std::u16string& prefix,
                            bool supports_replacement_only,
                            TemplateURLVector* matches);
@@ -678,10 +680,6 @@ class TemplateURLService final : public WebDataServiceConsumer,
     DSP_CHANGE_MAX,
   };
 
-  // Helper functor for FindMatchingKeywords(), for finding the range of
-  // keywords which begin with a prefix.
-  class LessWithPrefix;
-
   // Used to defer notifications until the last Scoper is destroyed by leaving
   // the scope of a code block.
   class Scoper;
@@ -832,9 +830,8 @@ class TemplateURLService final : public WebDataServiceConsumer,
   // Adds to |matches| all TemplateURLs stored in |keyword_to_turl|
   // whose keywords begin with |prefix|, sorted shortest-keyword-first.  If
   // |supports_replacement_only| is true, only TemplateURLs that support
-  // replacement are returned.
-  template <typename Container>
-  void AddMatchingKeywordsHelper(const Container& keyword_to_turl,
+  // replacement are returned. Takes O(log n) plus the number of matches.
+  void AddMatchingKeywordsHelper(const KeywordToTURL& keyword_to_turl,
                                  const std::u16string& prefix,
                                  bool supports_replacement_only,
                                  TemplateURLVector* matches);
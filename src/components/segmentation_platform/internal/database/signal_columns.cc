@@ -0,0 +1,37 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/segmentation_platform/internal/database/signal_columns.h"
+
+#include "base/check_op.h"
+
+namespace segmentation_platform {
+
+SignalColumns::Column::Column() = default;
+SignalColumns::Column::~Column() = default;
+SignalColumns::Column::Column(Column&&) = default;
+SignalColumns::Column& SignalColumns::Column::operator=(Column&&) = default;
+
+SignalColumns::SignalColumns() = default;
+SignalColumns::~SignalColumns() = default;
+
+void SignalColumns::AddNewSamples(
+    const std::vector<SignalDatabase::DbEntry>& samples) {
+  CHECK_GE(samples.size(), num_samples_);
+  for (size_t i = num_samples_; i < samples.size(); ++i) {
+    const SignalDatabase::DbEntry& sample = samples[i];
+    Column& column = columns_[{sample.type, sample.name_hash}];
+    column.times.push_back(sample.time);
+    column.values.push_back(sample.value);
+  }
+  num_samples_ = samples.size();
+}
+
+const SignalColumns::Column* SignalColumns::Find(proto::SignalType type,
+                                                 uint64_t name_hash) const {
+  auto it = columns_.find({type, name_hash});
+  return it != columns_.end() ? &it->second : nullptr;
+}
+
+}  // namespace segmentation_platform
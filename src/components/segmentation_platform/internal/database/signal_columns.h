@@ -0,0 +1,60 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_SEGMENTATION_PLATFORM_INTERNAL_DATABASE_SIGNAL_COLUMNS_H_
+#define COMPONENTS_SEGMENTATION_PLATFORM_INTERNAL_DATABASE_SIGNAL_COLUMNS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "base/time/time.h"
+#include "components/segmentation_platform/internal/database/signal_database.h"
+#include "components/segmentation_platform/public/proto/types.pb.h"
+
+namespace segmentation_platform {
+
+// A columnar copy of the signal database samples, grouped by signal. The times
+// and values of the samples of each signal are stored in contiguous arrays, in
+// the order of the samples, so that aggregating a signal only visits its own
+// samples.
+class SignalColumns {
+ public:
+  // The samples of a single signal. `times` and `values` have the same size.
+  struct Column {
+    Column();
+    ~Column();
+    Column(Column&&);
+    Column& operator=(Column&&);
+
+    std::vector<base::Time> times;
+    std::vector<int32_t> values;
+  };
+
+  SignalColumns();
+  ~SignalColumns();
+
+  SignalColumns(const SignalColumns&) = delete;
+  SignalColumns& operator=(const SignalColumns&) = delete;
+
+  // Adds the entries of `samples` that were not added before. `samples` must
+  // only have grown since the previous call, like the list returned by
+  // SignalDatabase::GetAllSamples().
+  void AddNewSamples(const std::vector<SignalDatabase::DbEntry>& samples);
+
+  // Returns the samples of the given signal, or null if there are none.
+  const Column* Find(proto::SignalType type, uint64_t name_hash) const;
+
+ private:
+  std::map<std::pair<proto::SignalType, uint64_t>, Column> columns_;
+
+  // The number of samples added so far.
+  size_t num_samples_ = 0;
+};
+
+}  // namespace segmentation_platform
+
+#endif  // COMPONENTS_SEGMENTATION_PLATFORM_INTERNAL_DATABASE_SIGNAL_COLUMNS_H_
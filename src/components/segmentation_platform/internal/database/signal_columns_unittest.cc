@@ -0,0 +1,77 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/segmentation_platform/internal/database/signal_columns.h"
+
+#include <vector>
+
+#include "base/time/time.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace segmentation_platform {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr uint64_t kUserActionHash = 1;
+constexpr uint64_t kHistogramHash = 2;
+
+SignalDatabase::DbEntry CreateEntry(proto::SignalType type,
+                                    uint64_t name_hash,
+                                    int hours,
+                                    int32_t value) {
+  return SignalDatabase::DbEntry{
+      .type = type,
+      .name_hash = name_hash,
+      .time = base::Time::UnixEpoch() + base::Hours(hours),
+      .value = value};
+}
+
+TEST(SignalColumnsTest, GroupsSamplesBySignal) {
+  std::vector<SignalDatabase::DbEntry> samples{
+      CreateEntry(proto::SignalType::USER_ACTION, kUserActionHash, 1, 0),
+      CreateEntry(proto::SignalType::HISTOGRAM_VALUE, kHistogramHash, 2, 5),
+      CreateEntry(proto::SignalType::USER_ACTION, kUserActionHash, 3, 0),
+  };
+  SignalColumns columns;
+  columns.AddNewSamples(samples);
+
+  const SignalColumns::Column* user_actions =
+      columns.Find(proto::SignalType::USER_ACTION, kUserActionHash);
+  ASSERT_TRUE(user_actions);
+  EXPECT_THAT(user_actions->times,
+              ElementsAre(base::Time::UnixEpoch() + base::Hours(1),
+                          base::Time::UnixEpoch() + base::Hours(3)));
+  EXPECT_THAT(user_actions->values, ElementsAre(0, 0));
+
+  const SignalColumns::Column* histogram =
+      columns.Find(proto::SignalType::HISTOGRAM_VALUE, kHistogramHash);
+  ASSERT_TRUE(histogram);
+  EXPECT_THAT(histogram->values, ElementsAre(5));
+
+  // The type is part of the key.
+  EXPECT_FALSE(columns.Find(proto::SignalType::HISTOGRAM_ENUM, kHistogramHash));
+}
+
+TEST(SignalColumnsTest, AddsOnlyNewSamples) {
+  std::vector<SignalDatabase::DbEntry> samples{
+      CreateEntry(proto::SignalType::HISTOGRAM_VALUE, kHistogramHash, 1, 1),
+  };
+  SignalColumns columns;
+  columns.AddNewSamples(samples);
+
+  samples.push_back(
+      CreateEntry(proto::SignalType::HISTOGRAM_VALUE, kHistogramHash, 2, 2));
+  columns.AddNewSamples(samples);
+  columns.AddNewSamples(samples);
+
+  const SignalColumns::Column* histogram =
+      columns.Find(proto::SignalType::HISTOGRAM_VALUE, kHistogramHash);
+  ASSERT_TRUE(histogram);
+  EXPECT_THAT(histogram->values, ElementsAre(1, 2));
+}
+
+}  // namespace
+}  // namespace segmentation_platform
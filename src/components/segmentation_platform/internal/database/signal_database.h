@@ -18,6 +18,8 @@
 
 namespace segmentation_platform {
 
+class SignalColumns;
+
 // Responsible for storing histogram signals and user action events in a
 // database. The signal samples are lazily bucketed into daily buckets for
 // efficient storage and retrieval. A periodic job is responsible for running
@@ -56,6 +58,10 @@ class SignalDatabase {
   // memory. The caller should filter signals in time range as needed.
   virtual const std::vector<DbEntry>* GetAllSamples() = 0;
 
+  // Returns the samples of GetAllSamples() grouped by signal, or null if the
+  // database doesn't keep them. The same caveat applies.
+  virtual const SignalColumns* GetAllSampleColumns() { return nullptr; }
+
   // Called to delete database entries having end time earlier than |end_time|.
   virtual void DeleteSamples(proto::SignalType signal_type,
                              uint64_t name_hash,
@@ -234,6 +234,15 @@ SignalDatabaseImpl::GetAllSamples() {
   return &all_signals_;
 }
 
+const SignalColumns* SignalDatabaseImpl::GetAllSampleColumns() {
+  TRACE_EVENT("segmentation_platform",
+              "SignalDatabaseImpl::GetAllSampleColumns");
+  DCHECK(initialized_);
+  CHECK(enable_signal_cache_);
+  all_signal_columns_.AddNewSamples(all_signals_);
+  return &all_signal_columns_;
+}
+
 void SignalDatabaseImpl::OnGetAllSamples(
     SuccessCallback callback,
     bool success,
@@ -16,6 +16,7 @@
 #include "base/task/sequenced_task_runner.h"
 #include "base/time/time.h"
 #include "components/leveldb_proto/public/proto_database.h"
+#include "components/segmentation_platform/internal/database/signal_columns.h"
 #include "components/segmentation_platform/internal/database/signal_database.h"
 #include "components/segmentation_platform/internal/database/signal_key.h"
 
@@ -55,6 +56,7 @@ class SignalDatabaseImpl : public SignalDatabase {
                   base::Time end_time,
                   EntriesCallback callback) override;
   const std::vector<DbEntry>* GetAllSamples() override;
+  const SignalColumns* GetAllSampleColumns() override;
   void DeleteSamples(proto::SignalType signal_type,
                      uint64_t name_hash,
                      base::Time end_time,
@@ -108,6 +110,8 @@ class SignalDatabaseImpl : public SignalDatabase {
 
   const bool enable_signal_cache_;
   std::vector<DbEntry> all_signals_;
+  // Column-wise copy of `all_signals_`, which is appended to lazily.
+  SignalColumns all_signal_columns_;
 
   // A cache of recently added signals. Used for avoiding collisions between two
   // signals if they end up generating the same signal key, which can happen if
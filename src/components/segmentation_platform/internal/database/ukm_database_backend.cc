@@ -4,12 +4,18 @@
 
 #include "components/segmentation_platform/internal/database/ukm_database_backend.h"
 
+#include <map>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 #include "base/check_is_test.h"
 #include "base/files/file_util.h"
 #include "base/functional/bind.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/rand_util.h"
+#include "base/ranges/algorithm.h"
 #include "base/strings/stringprintf.h"
 #include "base/task/sequenced_task_runner.h"
 #include "components/segmentation_platform/internal/database/ukm_metrics_table.h"
@@ -33,6 +39,10 @@ BASE_FEATURE(kSqlWALModeOnSegmentationDatabase,
 // if the metric count increases in the future.
 static constexpr int kChangeCountToCommit = 10;
 
+// Number of prepared read only statements kept around. Large enough for the
+// SQL features of all the models.
+static constexpr size_t kMaxCachedReadonlyStatements = 64;
+
 bool SanityCheckUrl(const GURL& url, UrlId url_id) {
   return url.is_valid() && !url.is_empty() && !url_id.is_null();
 }
@@ -117,7 +127,8 @@ UkmDatabaseBackend::UkmDatabaseBackend(
                                    kSqlWALModeOnSegmentationDatabase)}),
       metrics_table_(&db_),
       url_table_(&db_),
-      uma_metrics_table_(&db_) {
+      uma_metrics_table_(&db_),
+      readonly_statements_(kMaxCachedReadonlyStatements) {
   DETACH_FROM_SEQUENCE(sequence_checker_);
   db_.set_histogram_tag("UKMMetrics");
   db_.set_error_callback(base::BindRepeating(&ErrorCallback));
@@ -294,26 +305,41 @@ void UkmDatabaseBackend::RunReadOnlyQueries(QueryList&& queries,
 
   bool success = true;
   processing::IndexedTensors result;
+  // Indexes of the queries run so far, by query. Identical queries, e.g. the
+  // same feature used twice by a model, are only run once.
+  std::map<std::string_view, std::vector<processing::FeatureIndex>> run_queries;
   for (const auto& index_and_query : queries) {
     const processing::FeatureIndex index = index_and_query.first;
     const UkmDatabase::CustomSqlQuery& query = index_and_query.second;
-    std::string debug_query = query.query;
 
-    sql::Statement statement(db_.GetReadonlyStatement(query.query.c_str()));
-    debug_query +=
-        " Bind values: " + BindValuesToStatement(query.bind_values, statement);
+    std::vector<processing::FeatureIndex>& same_sql = run_queries[query.query];
+    auto duplicate = base::ranges::find_if(
+        same_sql, [&](processing::FeatureIndex run_index) {
+          return queries.at(run_index).bind_values == query.bind_values;
+        });
+    if (duplicate != same_sql.end()) {
+      processing::Tensor duplicate_result = result.at(*duplicate);
+      result[index] = std::move(duplicate_result);
+      continue;
+    }
+    same_sql.push_back(index);
 
-    if (!statement.is_valid()) {
+    std::string debug_query = query.query;
+    sql::Statement* statement = GetCachedReadonlyStatement(query.query);
+    if (!statement) {
       VLOG(1) << "Failed to run SQL query " << debug_query;
       success = false;
       break;
     }
-    while (statement.Step()) {
-      float output = GetSingleFloatOutput(statement);
+    debug_query +=
+        " Bind values: " + BindValuesToStatement(query.bind_values, *statement);
+
+    while (statement->Step()) {
+      float output = GetSingleFloatOutput(*statement);
       result[index].push_back(processing::ProcessedValue::FromFloat(output));
     }
     if (!result.count(index) || result.at(index).empty() ||
-        !statement.Succeeded()) {
+        !statement->Succeeded()) {
       VLOG(1) << "Failed to run SQL query " << debug_query;
       success = false;
       break;
@@ -370,6 +396,8 @@ void UkmDatabaseBackend::DeleteAllUrls() {
   // TODO(ssid): sqlite uses truncate optimization on DELETE statements without
   // WHERE clause. Maybe replace the DROP and CREATE with DELETE if the
   // performance is better.
+  // The cached statements may refer to the dropped table.
+  readonly_statements_.Clear();
   success = success && db_.Execute("DROP TABLE urls");
   success = success && url_table_.InitTable();
   DCHECK(success);
@@ -409,4 +437,21 @@ void UkmDatabaseBackend::RestartTransaction() {
   }
 }
 
+sql::Statement* UkmDatabaseBackend::GetCachedReadonlyStatement(
+    const std::string& query) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  auto it = readonly_statements_.Get(query);
+  if (it != readonly_statements_.end()) {
+    it->second->Reset(/*clear_bound_args=*/true);
+    return it->second.get();
+  }
+
+  auto statement =
+      std::make_unique<sql::Statement>(db_.GetReadonlyStatement(query.c_str()));
+  if (!statement->is_valid()) {
+    return nullptr;
+  }
+  return readonly_statements_.Put(query, std::move(statement))->second.get();
+}
+
 }  // namespace segmentation_platform
@@ -7,9 +7,11 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "base/containers/flat_map.h"
+#include "base/containers/lru_cache.h"
 #include "base/files/file_path.h"
 #include "base/functional/callback.h"
 #include "base/memory/weak_ptr.h"
@@ -23,6 +25,7 @@
 #include "services/metrics/public/cpp/ukm_source_id.h"
 #include "services/metrics/public/mojom/ukm_interface.mojom.h"
 #include "sql/database.h"
+#include "sql/statement.h"
 #include "sql/transaction.h"
 #include "url/gurl.h"
 
@@ -85,6 +88,10 @@ class UkmDatabaseBackend : public UkmDatabase {
   // Commit current transaction and begin a new one.
   void RestartTransaction();
 
+  // Returns a prepared read only statement for `query`, reusing the cached one
+  // if available, with no bound values. Returns null if the query is invalid.
+  sql::Statement* GetCachedReadonlyStatement(const std::string& query);
+
   const base::FilePath database_path_;
   const bool in_memory_;
   scoped_refptr<base::SequencedTaskRunner> callback_task_runner_
@@ -96,6 +103,12 @@ class UkmDatabaseBackend : public UkmDatabase {
   UkmMetricsTable metrics_table_ GUARDED_BY_CONTEXT(sequence_checker_);
   UkmUrlTable url_table_ GUARDED_BY_CONTEXT(sequence_checker_);
   UmaMetricsTable uma_metrics_table_ GUARDED_BY_CONTEXT(sequence_checker_);
+
+  // Prepared statements of recently run read only queries, keyed by query.
+  // Models run the same feature queries on every execution, so this saves
+  // compiling them each time.
+  base::HashingLRUCache<std::string, std::unique_ptr<sql::Statement>>
+      readonly_statements_ GUARDED_BY_CONTEXT(sequence_checker_);
   enum class Status { CREATED, INIT_FAILED, INIT_SUCCESS };
   Status status_ = Status::CREATED;
 
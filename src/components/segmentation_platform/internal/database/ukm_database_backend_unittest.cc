@@ -631,6 +631,35 @@ TEST_F(UkmDatabaseBackendTest, ReadOnlyQueries) {
   EXPECT_TRUE(backend_->has_transaction_for_testing());
 }
 
+TEST_F(UkmDatabaseBackendTest, RunDuplicateAndRepeatedQueries) {
+  backend_->StoreUkmEntry(GetSampleUkmEntry());
+
+  const char kQuery[] = "SELECT COUNT(*) FROM metrics WHERE metric_value>=?";
+  UkmDatabase::QueryList queries;
+  queries.emplace(0, UkmDatabase::CustomSqlQuery(
+                         kQuery, {processing::ProcessedValue(100)}));
+  queries.emplace(1, UkmDatabase::CustomSqlQuery(
+                         kQuery, {processing::ProcessedValue(101)}));
+  // Same as the first query.
+  queries.emplace(2, UkmDatabase::CustomSqlQuery(
+                         kQuery, {processing::ProcessedValue(100)}));
+  ExpectQueryResult(std::move(queries), true,
+                    {{0, {ProcessedValue::FromFloat(3)}},
+                     {1, {ProcessedValue::FromFloat(2)}},
+                     {2, {ProcessedValue::FromFloat(3)}}});
+
+  // The cached statement is reused without the previous bind values.
+  UkmDatabase::QueryList missing_bind_values;
+  missing_bind_values.emplace(0, UkmDatabase::CustomSqlQuery(kQuery, {}));
+  ExpectQueryResult(std::move(missing_bind_values), false, {});
+
+  UkmDatabase::QueryList repeated;
+  repeated.emplace(0, UkmDatabase::CustomSqlQuery(
+                          kQuery, {processing::ProcessedValue(102)}));
+  ExpectQueryResult(std::move(repeated), true,
+                    {{0, {ProcessedValue::FromFloat(1)}}});
+}
+
 class FailedUkmDatabaseTest : public UkmDatabaseBackendTest {
  public:
   void SetUp() override {
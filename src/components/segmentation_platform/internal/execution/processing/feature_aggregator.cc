@@ -0,0 +1,33 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/segmentation_platform/internal/execution/processing/feature_aggregator.h"
+
+namespace segmentation_platform::processing {
+
+std::optional<std::vector<float>> FeatureAggregator::ProcessColumn(
+    proto::SignalType signal_type,
+    uint64_t name_hash,
+    proto::Aggregation aggregation,
+    uint64_t bucket_count,
+    const base::Time& start_time,
+    const base::Time& end_time,
+    const base::TimeDelta& bucket_duration,
+    const std::vector<int32_t>& accepted_enum_ids,
+    const SignalColumns::Column* column) const {
+  std::vector<SignalDatabase::DbEntry> samples;
+  if (column) {
+    samples.reserve(column->times.size());
+    for (size_t i = 0; i < column->times.size(); ++i) {
+      samples.push_back(SignalDatabase::DbEntry{.type = signal_type,
+                                                .name_hash = name_hash,
+                                                .time = column->times[i],
+                                                .value = column->values[i]});
+    }
+  }
+  return Process(signal_type, name_hash, aggregation, bucket_count, start_time,
+                 end_time, bucket_duration, accepted_enum_ids, samples);
+}
+
+}  // namespace segmentation_platform::processing
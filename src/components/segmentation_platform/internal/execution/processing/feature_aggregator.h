@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "base/time/time.h"
+#include "components/segmentation_platform/internal/database/signal_columns.h"
 #include "components/segmentation_platform/internal/database/signal_database.h"
 #include "components/segmentation_platform/public/proto/aggregation.pb.h"
 #include "components/segmentation_platform/public/proto/types.pb.h"
@@ -35,6 +36,20 @@ class FeatureAggregator {
       const base::TimeDelta& bucket_duration,
       const std::vector<int32_t>& accepted_enum_ids,
       const std::vector<SignalDatabase::DbEntry>& all_samples) const = 0;
+
+  // Same as Process(), but takes the samples of the given signal only, from
+  // SignalColumns. `column` is null if the signal has no samples. The default
+  // implementation converts the column back to database entries.
+  virtual std::optional<std::vector<float>> ProcessColumn(
+      proto::SignalType signal_type,
+      uint64_t name_hash,
+      proto::Aggregation aggregation,
+      uint64_t bucket_count,
+      const base::Time& start_time,
+      const base::Time& end_time,
+      const base::TimeDelta& bucket_duration,
+      const std::vector<int32_t>& accepted_enum_ids,
+      const SignalColumns::Column* column) const;
 };
 
 }  // namespace segmentation_platform::processing
@@ -8,10 +8,12 @@
 #include <optional>
 #include <vector>
 
+#include "base/containers/contains.h"
 #include "base/notreached.h"
 #include "base/numerics/clamped_math.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/time/time.h"
+#include "components/segmentation_platform/internal/database/signal_columns.h"
 #include "components/segmentation_platform/internal/database/signal_database.h"
 #include "components/segmentation_platform/internal/database/signal_sample_view.h"
 #include "components/segmentation_platform/public/proto/aggregation.pb.h"
@@ -219,6 +221,124 @@ std::vector<float> BucketedCumulativeSumAggregation(
   return tensor_data;
 }
 
+bool IsBucketed(proto::Aggregation aggregation) {
+  switch (aggregation) {
+    case proto::Aggregation::BUCKETED_COUNT:
+    case proto::Aggregation::BUCKETED_COUNT_BOOLEAN:
+    case proto::Aggregation::BUCKETED_COUNT_BOOLEAN_TRUE_COUNT:
+    case proto::Aggregation::BUCKETED_CUMULATIVE_COUNT:
+    case proto::Aggregation::BUCKETED_SUM:
+    case proto::Aggregation::BUCKETED_SUM_BOOLEAN:
+    case proto::Aggregation::BUCKETED_SUM_BOOLEAN_TRUE_COUNT:
+    case proto::Aggregation::BUCKETED_CUMULATIVE_SUM:
+      return true;
+    case proto::Aggregation::UNKNOWN:
+    case proto::Aggregation::COUNT:
+    case proto::Aggregation::COUNT_BOOLEAN:
+    case proto::Aggregation::SUM:
+    case proto::Aggregation::SUM_BOOLEAN:
+    case proto::Aggregation::LATEST_OR_DEFAULT:
+      return false;
+  }
+}
+
+// Counts and sums of the matching samples of a column, computed in a single
+// pass over its arrays.
+struct ColumnTotals {
+  int64_t count = 0;
+  int64_t sum = 0;
+  std::optional<int32_t> latest;
+  // Per bucket, only filled for bucketed aggregations.
+  std::vector<int64_t> bucket_counts;
+  std::vector<int64_t> bucket_sums;
+};
+
+ColumnTotals ComputeColumnTotals(proto::SignalType signal_type,
+                                 bool bucketed,
+                                 uint64_t bucket_count,
+                                 const base::Time& start_time,
+                                 const base::Time& end_time,
+                                 const base::TimeDelta& bucket_duration,
+                                 const std::vector<int32_t>& accepted_enum_ids,
+                                 const SignalColumns::Column& column) {
+  ColumnTotals totals;
+  if (bucketed) {
+    totals.bucket_counts.resize(bucket_count);
+    totals.bucket_sums.resize(bucket_count);
+  }
+  // Values of user actions are counted as 1, see SumValues().
+  const bool is_user_action = signal_type == proto::SignalType::USER_ACTION;
+  const size_t size = column.times.size();
+  for (size_t i = 0; i < size; ++i) {
+    const base::Time& timestamp = column.times[i];
+    if (timestamp < start_time || timestamp > end_time) {
+      continue;
+    }
+    const int32_t value = column.values[i];
+    if (!accepted_enum_ids.empty() &&
+        !base::Contains(accepted_enum_ids, value)) {
+      continue;
+    }
+    const int32_t summed_value = is_user_action ? 1 : value;
+    totals.count++;
+    totals.sum = base::ClampAdd(totals.sum, summed_value);
+    totals.latest = value;
+    if (!bucketed) {
+      continue;
+    }
+
+    // Same bucketing as Bucketize().
+    int bucket_index = (end_time - timestamp) / bucket_duration;
+    if (bucket_index < 0 || base::saturated_cast<uint32_t>(bucket_index) >=
+                                totals.bucket_counts.size()) {
+      continue;
+    }
+    totals.bucket_counts[bucket_index]++;
+    totals.bucket_sums[bucket_index] =
+        base::ClampAdd(totals.bucket_sums[bucket_index], summed_value);
+  }
+  return totals;
+}
+
+std::vector<float> ToFloats(const std::vector<int64_t>& values) {
+  std::vector<float> tensor_data;
+  tensor_data.reserve(values.size());
+  for (int64_t value : values) {
+    tensor_data.emplace_back(static_cast<float>(value));
+  }
+  return tensor_data;
+}
+
+std::vector<float> ToBooleans(const std::vector<int64_t>& values) {
+  std::vector<float> tensor_data;
+  tensor_data.reserve(values.size());
+  for (int64_t value : values) {
+    tensor_data.emplace_back(static_cast<float>(value > 0 ? 1 : 0));
+  }
+  return tensor_data;
+}
+
+float CountPositive(const std::vector<int64_t>& values) {
+  int64_t true_count = 0;
+  for (int64_t value : values) {
+    if (value > 0) {
+      true_count = base::ClampAdd(true_count, 1);
+    }
+  }
+  return static_cast<float>(true_count);
+}
+
+std::vector<float> Accumulate(const std::vector<int64_t>& values) {
+  int64_t cumulative = 0;
+  std::vector<float> tensor_data;
+  tensor_data.reserve(values.size());
+  for (int64_t value : values) {
+    cumulative = base::ClampAdd(cumulative, value);
+    tensor_data.emplace_back(static_cast<float>(cumulative));
+  }
+  return tensor_data;
+}
+
 }  // namespace
 
 FeatureAggregatorImpl::FeatureAggregatorImpl() = default;
@@ -284,4 +404,62 @@ std::optional<std::vector<float>> FeatureAggregatorImpl::Process(
   }
 }
 
+std::optional<std::vector<float>> FeatureAggregatorImpl::ProcessColumn(
+    proto::SignalType signal_type,
+    uint64_t name_hash,
+    proto::Aggregation aggregation,
+    uint64_t bucket_count,
+    const base::Time& start_time,
+    const base::Time& end_time,
+    const base::TimeDelta& bucket_duration,
+    const std::vector<int32_t>& accepted_enum_ids,
+    const SignalColumns::Column* column) const {
+  const bool bucketed = IsBucketed(aggregation);
+  ColumnTotals totals;
+  if (column) {
+    totals = ComputeColumnTotals(signal_type, bucketed, bucket_count,
+                                 start_time, end_time, bucket_duration,
+                                 accepted_enum_ids, *column);
+  } else if (bucketed) {
+    totals.bucket_counts.resize(bucket_count);
+    totals.bucket_sums.resize(bucket_count);
+  }
+
+  switch (aggregation) {
+    case proto::Aggregation::UNKNOWN:
+      NOTREACHED_IN_MIGRATION();
+      return std::vector<float>();
+    case proto::Aggregation::COUNT:
+      return std::vector<float>{static_cast<float>(totals.count)};
+    case proto::Aggregation::COUNT_BOOLEAN:
+      return std::vector<float>{static_cast<float>(totals.count > 0 ? 1 : 0)};
+    case proto::Aggregation::BUCKETED_COUNT:
+      return ToFloats(totals.bucket_counts);
+    case proto::Aggregation::BUCKETED_COUNT_BOOLEAN:
+      return ToBooleans(totals.bucket_counts);
+    case proto::Aggregation::BUCKETED_COUNT_BOOLEAN_TRUE_COUNT:
+      return std::vector<float>{CountPositive(totals.bucket_counts)};
+    case proto::Aggregation::BUCKETED_CUMULATIVE_COUNT:
+      return Accumulate(totals.bucket_counts);
+    case proto::Aggregation::SUM:
+      return std::vector<float>{static_cast<float>(totals.sum)};
+    case proto::Aggregation::SUM_BOOLEAN:
+      return std::vector<float>{static_cast<float>(totals.sum > 0 ? 1 : 0)};
+    case proto::Aggregation::BUCKETED_SUM:
+      return ToFloats(totals.bucket_sums);
+    case proto::Aggregation::BUCKETED_SUM_BOOLEAN:
+      return ToBooleans(totals.bucket_sums);
+    case proto::Aggregation::BUCKETED_SUM_BOOLEAN_TRUE_COUNT:
+      return std::vector<float>{CountPositive(totals.bucket_sums)};
+    case proto::Aggregation::BUCKETED_CUMULATIVE_SUM:
+      return Accumulate(totals.bucket_sums);
+    case proto::Aggregation::LATEST_OR_DEFAULT:
+      if (!totals.latest) {
+        // If empty, then latest data cannot be found.
+        return std::nullopt;
+      }
+      return std::vector<float>({static_cast<float>(*totals.latest)});
+  }
+}
+
 }  // namespace segmentation_platform::processing
@@ -37,6 +37,16 @@ class FeatureAggregatorImpl : public FeatureAggregator {
       const base::TimeDelta& bucket_duration,
       const std::vector<int32_t>& accepted_enum_ids,
       const std::vector<SignalDatabase::DbEntry>& all_samples) const override;
+  std::optional<std::vector<float>> ProcessColumn(
+      proto::SignalType signal_type,
+      uint64_t name_hash,
+      proto::Aggregation aggregation,
+      uint64_t bucket_count,
+      const base::Time& start_time,
+      const base::Time& end_time,
+      const base::TimeDelta& bucket_duration,
+      const std::vector<int32_t>& accepted_enum_ids,
+      const SignalColumns::Column* column) const override;
 };
 
 }  // namespace segmentation_platform::processing
@@ -12,6 +12,7 @@
 #include "base/metrics/metrics_hashes.h"
 #include "base/test/simple_test_clock.h"
 #include "base/time/time.h"
+#include "components/segmentation_platform/internal/database/signal_columns.h"
 #include "components/segmentation_platform/internal/database/signal_database.h"
 #include "components/segmentation_platform/public/proto/aggregation.pb.h"
 #include "components/segmentation_platform/public/proto/types.pb.h"
@@ -92,8 +93,8 @@ class FeatureAggregatorImplTest : public testing::Test {
     return samples;
   }
 
-  // Verifies the result of a single invocation of Process(...), comparing to
-  // the expected output.
+  // Verifies the result of a single invocation of Process(...) and of
+  // ProcessColumn(...), comparing to the expected output.
   void Verify(SignalType signal_type,
               Aggregation aggregation,
               uint64_t bucket_count,
@@ -115,6 +116,13 @@ class FeatureAggregatorImplTest : public testing::Test {
         signal_type, 123, aggregation, bucket_count, start_time, clock_.Now(),
         bucket_duration, {}, entries);
     EXPECT_EQ(expected, res);
+
+    SignalColumns columns;
+    columns.AddNewSamples(entries);
+    res = feature_aggregator_->ProcessColumn(
+        signal_type, 123, aggregation, bucket_count, start_time, clock_.Now(),
+        bucket_duration, {}, columns.Find(signal_type, 123));
+    EXPECT_EQ(expected, res);
   }
 
   // Verifies the result of a multiple invocations of Process(...), comparing to
@@ -330,4 +338,46 @@ TEST_F(FeatureAggregatorImplTest, BucketsOutOfBounds) {
          base::Days(1), samples, std::optional<std::vector<float>>({2, 3, 4}));
 }
 
+TEST_F(FeatureAggregatorImplTest, ProcessColumnFiltersEnumsAndTime) {
+  std::vector<SignalDatabase::DbEntry> entries;
+  for (const auto& sample : value_samples()) {
+    entries.push_back(
+        SignalDatabase::DbEntry{.type = SignalType::HISTOGRAM_ENUM,
+                                .name_hash = 123,
+                                .time = sample.first,
+                                .value = sample.second});
+  }
+  // Samples of another histogram are not part of the column.
+  entries.push_back(SignalDatabase::DbEntry{.type = SignalType::HISTOGRAM_ENUM,
+                                            .name_hash = 456,
+                                            .time = clock_.Now(),
+                                            .value = 2});
+  SignalColumns columns;
+  columns.AddNewSamples(entries);
+  const SignalColumns::Column* column =
+      columns.Find(SignalType::HISTOGRAM_ENUM, 123);
+  ASSERT_TRUE(column);
+
+  // Only the first 3 buckets are in the time range.
+  const base::Time start_time = clock_.Now() - kDefaultBucketDuration * 3;
+  const std::vector<int32_t> accepted_enum_ids{2, 4, 10, 12};
+  for (Aggregation aggregation :
+       {Aggregation::COUNT, Aggregation::SUM, Aggregation::BUCKETED_SUM,
+        Aggregation::LATEST_OR_DEFAULT}) {
+    EXPECT_EQ(feature_aggregator_->Process(
+                  SignalType::HISTOGRAM_ENUM, 123, aggregation,
+                  kDefaultBucketCount, start_time, clock_.Now(),
+                  kDefaultBucketDuration, accepted_enum_ids, entries),
+              feature_aggregator_->ProcessColumn(
+                  SignalType::HISTOGRAM_ENUM, 123, aggregation,
+                  kDefaultBucketCount, start_time, clock_.Now(),
+                  kDefaultBucketDuration, accepted_enum_ids, column));
+  }
+  EXPECT_EQ(std::optional<std::vector<float>>({16}),
+            feature_aggregator_->ProcessColumn(
+                SignalType::HISTOGRAM_ENUM, 123, Aggregation::SUM,
+                kDefaultBucketCount, start_time, clock_.Now(),
+                kDefaultBucketDuration, accepted_enum_ids, column));
+}
+
 }  // namespace segmentation_platform::processing
@@ -9,9 +9,11 @@
 #include "base/functional/bind.h"
 #include "base/memory/weak_ptr.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
 #include "components/segmentation_platform/internal/execution/processing/custom_input_processor.h"
 #include "components/segmentation_platform/internal/execution/processing/feature_processor_state.h"
 #include "components/segmentation_platform/internal/metadata/metadata_utils.h"
+#include "components/segmentation_platform/internal/stats.h"
 #include "components/segmentation_platform/public/proto/model_metadata.pb.h"
 #include "components/segmentation_platform/public/types/processed_value.h"
 
@@ -135,13 +137,20 @@ void SqlFeatureProcessor::OnCustomInputProcessed(
   ukm_database_->RunReadOnlyQueries(
       std::move(processed_queries_),
       base::BindOnce(&SqlFeatureProcessor::OnQueriesRun,
-                     weak_ptr_factory_.GetWeakPtr(), feature_processor_state));
+                     weak_ptr_factory_.GetWeakPtr(), feature_processor_state,
+                     base::TimeTicks::Now()));
 }
 
 void SqlFeatureProcessor::OnQueriesRun(
     base::WeakPtr<FeatureProcessorState> feature_processor_state,
+    base::TimeTicks queries_start_time,
     bool success,
     IndexedTensors result) {
+  if (feature_processor_state) {
+    stats::RecordModelExecutionDurationSqlQueries(
+        feature_processor_state->segment_id(),
+        base::TimeTicks::Now() - queries_start_time);
+  }
   if (!success) {
     feature_processor_state->SetError(
         stats::FeatureProcessingError::kSqlQueryRunError);
@@ -10,6 +10,7 @@
 
 #include "base/containers/flat_map.h"
 #include "base/functional/callback_forward.h"
+#include "base/time/time.h"
 #include "components/segmentation_platform/internal/database/ukm_database.h"
 #include "components/segmentation_platform/internal/execution/processing/query_processor.h"
 #include "components/segmentation_platform/public/proto/model_metadata.pb.h"
@@ -51,6 +52,7 @@ class SqlFeatureProcessor : public QueryProcessor {
   // database.
   void OnQueriesRun(
       base::WeakPtr<FeatureProcessorState> feature_processor_state,
+      base::TimeTicks queries_start_time,
       bool success,
       IndexedTensors result);
 
@@ -14,6 +14,7 @@
 #include "base/strings/stringprintf.h"
 #include "base/task/sequenced_task_runner.h"
 #include "base/timer/elapsed_timer.h"
+#include "components/segmentation_platform/internal/database/signal_columns.h"
 #include "components/segmentation_platform/internal/database/signal_database.h"
 #include "components/segmentation_platform/internal/database/storage_service.h"
 #include "components/segmentation_platform/internal/database/ukm_database.h"
@@ -40,6 +41,19 @@ proto::UMAFeature* GetAsUMA(Data& data) {
   return data.output_feature->mutable_uma_output()->mutable_uma_feature();
 }
 
+// Enum histograms can optionally only accept some of the enum values. While the
+// proto::UMAFeature is available, capture a vector of the accepted enum values.
+// An empty vector is ignored (all values are considered accepted).
+std::vector<int32_t> GetAcceptedEnumIds(const proto::UMAFeature& feature) {
+  std::vector<int32_t> accepted_enum_ids{};
+  if (feature.type() == proto::SignalType::HISTOGRAM_ENUM) {
+    for (int i = 0; i < feature.enum_ids_size(); ++i) {
+      accepted_enum_ids.emplace_back(feature.enum_ids(i));
+    }
+  }
+  return accepted_enum_ids;
+}
+
 // Create an SQL query based on the aggregation type for the UMA feature.
 UkmDatabase::CustomSqlQuery MakeSqlQuery(
     proto::SignalType signal_type,
@@ -230,8 +244,16 @@ void UmaFeatureProcessor::Process(
     CHECK(GetUkmDatabase());
     ProcessUsingSqlDatabase(feature_processor_state);
   } else if (is_batch_processing_enabled_) {
-    ProcessOnGotAllSamples(feature_processor_state,
-                           *GetSignalDatabase()->GetAllSamples());
+    // The database keeps the samples grouped by signal, so that every feature
+    // only visits its own samples. Group them here otherwise.
+    const SignalColumns* columns = GetSignalDatabase()->GetAllSampleColumns();
+    if (columns) {
+      ProcessOnGotAllSamples(feature_processor_state, *columns);
+    } else {
+      SignalColumns all_columns;
+      all_columns.AddNewSamples(*GetSignalDatabase()->GetAllSamples());
+      ProcessOnGotAllSamples(feature_processor_state, all_columns);
+    }
   } else {
     ProcessNextFeature();
   }
@@ -295,7 +317,7 @@ void UmaFeatureProcessor::GetStartAndEndTime(size_t bucket_count,
 
 void UmaFeatureProcessor::ProcessOnGotAllSamples(
     FeatureProcessorState& feature_processor_state,
-    const std::vector<SignalDatabase::DbEntry>& samples) {
+    const SignalColumns& columns) {
   while (!uma_features_.empty()) {
     if (feature_processor_state.error()) {
       break;
@@ -306,7 +328,7 @@ void UmaFeatureProcessor::ProcessOnGotAllSamples(
     FeatureIndex index = it->first;
     uma_features_.erase(it);
 
-    ProcessSingleUmaFeature(samples, index, next_feature);
+    ProcessSingleUmaFeatureColumn(columns, index, next_feature);
   }
 
   base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
@@ -352,12 +374,16 @@ void UmaFeatureProcessor::ProcessUsingSqlDatabase(
             feature.default_values_size() > 0 ? feature.default_values(0) : 0));
   }
   GetUkmDatabase()->RunReadOnlyQueries(
-      std::move(queries), base::BindOnce(&UmaFeatureProcessor::OnSqlQueriesRun,
-                                         weak_ptr_factory_.GetWeakPtr()));
+      std::move(queries),
+      base::BindOnce(&UmaFeatureProcessor::OnSqlQueriesRun,
+                     weak_ptr_factory_.GetWeakPtr(), base::TimeTicks::Now()));
 }
 
-void UmaFeatureProcessor::OnSqlQueriesRun(bool success,
+void UmaFeatureProcessor::OnSqlQueriesRun(base::TimeTicks queries_start_time,
+                                          bool success,
                                           processing::IndexedTensors tensor) {
+  stats::RecordModelExecutionDurationSqlQueries(
+      segment_id_, base::TimeTicks::Now() - queries_start_time);
   if (success) {
     for (const auto& it : tensor) {
       result_[it.first] = std::move(it.second);
@@ -371,17 +397,7 @@ void UmaFeatureProcessor::ProcessSingleUmaFeature(
     const std::vector<SignalDatabase::DbEntry>& samples,
     FeatureIndex index,
     const proto::UMAFeature& feature) {
-  // Enum histograms can optionally only accept some of the enum values.
-  // While the proto::UMAFeature is available, capture a vector of the
-  // accepted enum values. An empty vector is ignored (all values are
-  // considered accepted).
-  std::vector<int32_t> accepted_enum_ids{};
-  if (feature.type() == proto::SignalType::HISTOGRAM_ENUM) {
-    for (int i = 0; i < feature.enum_ids_size(); ++i) {
-      accepted_enum_ids.emplace_back(feature.enum_ids(i));
-    }
-  }
-
+  std::vector<int32_t> accepted_enum_ids = GetAcceptedEnumIds(feature);
   base::Time start_time;
   base::Time end_time;
   GetStartAndEndTime(feature.bucket_count(), start_time, end_time);
@@ -395,7 +411,38 @@ void UmaFeatureProcessor::ProcessSingleUmaFeature(
       feature.type(), feature.name_hash(), feature.aggregation(),
       feature.bucket_count(), start_time, end_time, bucket_duration_,
       accepted_enum_ids, samples);
+  SetFeatureResult(index, feature, result);
+
+  stats::RecordModelExecutionDurationFeatureProcessing(segment_id_,
+                                                       timer.Elapsed());
+}
+
+void UmaFeatureProcessor::ProcessSingleUmaFeatureColumn(
+    const SignalColumns& columns,
+    FeatureIndex index,
+    const proto::UMAFeature& feature) {
+  std::vector<int32_t> accepted_enum_ids = GetAcceptedEnumIds(feature);
+  base::Time start_time;
+  base::Time end_time;
+  GetStartAndEndTime(feature.bucket_count(), start_time, end_time);
+  base::ElapsedTimer timer;
+
+  std::optional<std::vector<float>> result =
+      feature_aggregator_->ProcessColumn(
+          feature.type(), feature.name_hash(), feature.aggregation(),
+          feature.bucket_count(), start_time, end_time, bucket_duration_,
+          accepted_enum_ids,
+          columns.Find(feature.type(), feature.name_hash()));
+  SetFeatureResult(index, feature, result);
 
+  stats::RecordModelExecutionDurationFeatureProcessing(segment_id_,
+                                                       timer.Elapsed());
+}
+
+void UmaFeatureProcessor::SetFeatureResult(
+    FeatureIndex index,
+    const proto::UMAFeature& feature,
+    const std::optional<std::vector<float>>& result) {
   // If no feature data is available, use the default values specified instead.
   if (result.has_value()) {
     const std::vector<float>& feature_data = result.value();
@@ -412,9 +459,6 @@ void UmaFeatureProcessor::ProcessSingleUmaFeature(
     result_[index] = std::vector<ProcessedValue>(
         feature.default_values().begin(), feature.default_values().end());
   }
-
-  stats::RecordModelExecutionDurationFeatureProcessing(segment_id_,
-                                                       timer.Elapsed());
 }
 
 SignalDatabase* UmaFeatureProcessor::GetSignalDatabase() {
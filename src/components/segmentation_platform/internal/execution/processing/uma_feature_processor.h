@@ -6,10 +6,13 @@
 #define COMPONENTS_SEGMENTATION_PLATFORM_INTERNAL_EXECUTION_PROCESSING_UMA_FEATURE_PROCESSOR_H_
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "components/segmentation_platform/internal/database/signal_columns.h"
 #include "components/segmentation_platform/internal/database/signal_database.h"
 #include "components/segmentation_platform/internal/database/storage_service.h"
 #include "components/segmentation_platform/internal/database/ukm_database.h"
@@ -50,12 +53,13 @@ class UmaFeatureProcessor : public QueryProcessor {
                                  std::vector<SignalDatabase::DbEntry> samples);
 
   void ProcessUsingSqlDatabase(FeatureProcessorState& feature_processor_state);
-  void OnSqlQueriesRun(bool success, processing::IndexedTensors tensor);
+  void OnSqlQueriesRun(base::TimeTicks queries_start_time,
+                       bool success,
+                       processing::IndexedTensors tensor);
 
   // Function for processing the next UMAFeature type of input for ML model.
-  void ProcessOnGotAllSamples(
-      FeatureProcessorState& feature_processor_state,
-      const std::vector<SignalDatabase::DbEntry>& samples);
+  void ProcessOnGotAllSamples(FeatureProcessorState& feature_processor_state,
+                              const SignalColumns& columns);
 
   void GetStartAndEndTime(size_t bucket_count,
                           base::Time& start_time,
@@ -67,6 +71,18 @@ class UmaFeatureProcessor : public QueryProcessor {
       FeatureIndex index,
       const proto::UMAFeature& feature);
 
+  // Same as ProcessSingleUmaFeature(), but takes the samples of the feature
+  // from `columns`.
+  void ProcessSingleUmaFeatureColumn(const SignalColumns& columns,
+                                     FeatureIndex index,
+                                     const proto::UMAFeature& feature);
+
+  // Stores the aggregated `result` of the feature, or its default values if
+  // there is no result.
+  void SetFeatureResult(FeatureIndex index,
+                        const proto::UMAFeature& feature,
+                        const std::optional<std::vector<float>>& result);
+
   SignalDatabase* GetSignalDatabase();
 
   UkmDatabase* GetUkmDatabase();
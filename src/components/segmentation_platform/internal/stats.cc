@@ -409,6 +409,14 @@ void RecordModelExecutionDurationFeatureProcessing(SegmentId segment_id,
       duration);
 }
 
+void RecordModelExecutionDurationSqlQueries(SegmentId segment_id,
+                                            base::TimeDelta duration) {
+  base::UmaHistogramTimes(
+      "SegmentationPlatform.ModelExecution.Duration.SqlQueries." +
+          SegmentIdToHistogramVariant(segment_id),
+      duration);
+}
+
 void RecordModelExecutionDurationModel(SegmentId segment_id,
                                        bool success,
                                        base::TimeDelta duration) {
@@ -136,6 +136,10 @@ void RecordModelDeliverySegmentIdMatches(SegmentId segment_id,
 // enum histograms.
 void RecordModelExecutionDurationFeatureProcessing(SegmentId segment_id,
                                                    base::TimeDelta duration);
+// Records the duration of running the SQL queries for the features of a model
+// in the UKM database, including the time the queries wait for the database.
+void RecordModelExecutionDurationSqlQueries(SegmentId segment_id,
+                                            base::TimeDelta duration);
 // Records the duration of executing an ML model. This only takes into account
 // the time it takes to invoke and wait for a result from the underlying ML
 // infrastructure from //components/optimization_guide, and not fetching the
@@ -12,6 +12,7 @@
 #include "base/containers/adapters.h"
 #include "base/json/json_writer.h"
 #include "base/json/string_escape.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
 #include "base/trace_event/traced_value.h"
 #include "base/values.h"
@@ -186,71 +187,118 @@ int AppendBacktraceStrings(const AllocationSite& alloc,
   return parent;  // Last item is the top of this stack.
 }
 
-base::Value::List BuildStrings(const StringTable& string_table) {
-  base::Value::List strings;
-  strings.reserve(string_table.size());
+// The sections below hold an entry per allocation site and per stack frame,
+// so they are written straight to the output rather than built up as a
+// base::Value tree first, which for large dumps would need several times the
+// memory of the resulting JSON.
+
+void AppendStrings(const StringTable& string_table, std::string* out) {
+  out->push_back('[');
+  bool first = true;
   for (const auto& string_pair : string_table) {
-    base::Value::Dict item;
-    item.Set("id", string_pair.second);
-    item.Set("string", string_pair.first);
-    strings.Append(std::move(item));
+    if (!first)
+      out->push_back(',');
+    first = false;
+    base::StringAppendF(out, "{\"id\":%d,\"string\":", string_pair.second);
+    base::EscapeJSONString(string_pair.first, /*put_in_quotes=*/true, out);
+    out->push_back('}');
   }
-  return strings;
+  out->push_back(']');
 }
 
-base::Value::List BuildMapNodes(const BacktraceTable& nodes) {
-  base::Value::List items;
-  items.reserve(nodes.size());
+void AppendMapNodes(const BacktraceTable& nodes, std::string* out) {
+  out->push_back('[');
+  bool first = true;
   for (const auto& node_pair : nodes) {
-    base::Value::Dict item;
-    item.Set("id", node_pair.second);
-    item.Set("name_sid", node_pair.first.string_id());
+    if (!first)
+      out->push_back(',');
+    first = false;
+    base::StringAppendF(out, "{\"id\":%d,\"name_sid\":%d", node_pair.second,
+                        node_pair.first.string_id());
     if (node_pair.first.parent() != BacktraceNode::kNoParent)
-      item.Set("parent", node_pair.first.parent());
-    items.Append(std::move(item));
+      base::StringAppendF(out, ",\"parent\":%d", node_pair.first.parent());
+    out->push_back('}');
   }
-  return items;
+  out->push_back(']');
 }
 
-base::Value::List BuildTypeNodes(const std::map<int, int>& type_to_string) {
-  base::Value::List items;
-  items.reserve(type_to_string.size());
+void AppendTypeNodes(const std::map<int, int>& type_to_string,
+                     std::string* out) {
+  out->push_back('[');
+  bool first = true;
   for (const auto& pair : type_to_string) {
-    base::Value::Dict item;
-    item.Set("id", pair.first);
-    item.Set("name_sid", pair.second);
-    items.Append(std::move(item));
+    if (!first)
+      out->push_back(',');
+    first = false;
+    base::StringAppendF(out, "{\"id\":%d,\"name_sid\":%d}", pair.first,
+                        pair.second);
   }
-  return items;
+  out->push_back(']');
 }
 
-base::Value::Dict BuildAllocations(const AllocationMap& allocations,
-                                   const AllocationToNodeId& alloc_to_node_id) {
-  base::Value::List counts[kAllocatorCount];
-  base::Value::List sizes[kAllocatorCount];
-  base::Value::List types[kAllocatorCount];
-  base::Value::List nodes[kAllocatorCount];
-
+// Appends a list with `get_value(alloc)` for each allocation made by
+// `allocator`.
+template <typename GetValue>
+void AppendAllocationList(const AllocationMap& allocations,
+                          int allocator,
+                          GetValue get_value,
+                          std::string* out) {
+  out->push_back('[');
+  bool first = true;
   for (const auto& alloc : allocations) {
-    int allocator = static_cast<int>(alloc.first.allocator);
-    // We use double to store size and count, as it can precisely represent
-    // values up to 2^52 ~ 4.5 petabytes.
-    counts[allocator].Append(static_cast<double>(round(alloc.second.count)));
-    sizes[allocator].Append(static_cast<double>(alloc.second.size));
-    types[allocator].Append(alloc.first.context_id);
-    nodes[allocator].Append(alloc_to_node_id.at(&alloc.first));
+    if (static_cast<int>(alloc.first.allocator) != allocator)
+      continue;
+    if (!first)
+      out->push_back(',');
+    first = false;
+    out->append(base::NumberToString(get_value(alloc)));
   }
+  out->push_back(']');
+}
 
-  base::Value::Dict allocators;
-  for (uint32_t i = 0; i < kAllocatorCount; i++) {
-    base::Value::Dict allocator;
-    allocator.Set("counts", std::move(counts[i]));
-    allocator.Set("sizes", std::move(sizes[i]));
-    allocator.Set("types", std::move(types[i]));
-    allocator.Set("nodes", std::move(nodes[i]));
-    allocators.Set(StringForAllocatorType(i), std::move(allocator));
+void AppendAllocations(const AllocationMap& allocations,
+                       const AllocationToNodeId& alloc_to_node_id,
+                       std::string* out) {
+  out->push_back('{');
+  for (int i = 0; i < kAllocatorCount; i++) {
+    if (i > 0)
+      out->push_back(',');
+    base::StringAppendF(out, "\"%s\":{\"counts\":", StringForAllocatorType(i));
+    // Counts are scaled by the sampling rate, so round them to whole
+    // allocations.
+    AppendAllocationList(
+        allocations, i,
+        [](const auto& alloc) {
+          return static_cast<uint64_t>(round(alloc.second.count));
+        },
+        out);
+    out->append(",\"sizes\":");
+    AppendAllocationList(
+        allocations, i,
+        [](const auto& alloc) {
+          return static_cast<uint64_t>(alloc.second.size);
+        },
+        out);
+    out->append(",\"types\":");
+    AppendAllocationList(
+        allocations, i,
+        [](const auto& alloc) { return alloc.first.context_id; }, out);
+    out->append(",\"nodes\":");
+    AppendAllocationList(
+        allocations, i,
+        [&](const auto& alloc) { return alloc_to_node_id.at(&alloc.first); },
+        out);
+    out->push_back('}');
   }
-  return allocators;
+  out->push_back('}');
+}
+
+void AppendValue(base::ValueView value, std::string* out) {
+  std::string json;
+  bool ok = base::JSONWriter::WriteWithOptions(
+      value, base::JSONWriter::OPTIONS_OMIT_DOUBLE_TYPE_PRESERVATION, &json);
+  DCHECK(ok);
+  out->append(json);
 }
 
 }  // namespace
@@ -259,16 +307,15 @@ ExportParams::ExportParams() = default;
 ExportParams::~ExportParams() = default;
 
 std::string ExportMemoryMapsAndV2StackTraceToJSON(ExportParams* params) {
-  base::Value::Dict result;
-
-  result.Set("level_of_detail", "detailed");
-  result.Set("process_mmaps", BuildMemoryMaps(*params));
-  result.Set("allocators", BuildAllocatorsSummary(params->allocs));
+  std::string result;
 
-  base::Value::Dict heaps_v2;
+  result.append("{\"level_of_detail\":\"detailed\",\"process_mmaps\":");
+  AppendValue(BuildMemoryMaps(*params), &result);
+  result.append(",\"allocators\":");
+  AppendValue(BuildAllocatorsSummary(params->allocs), &result);
 
   // Output Heaps_V2 format version. Currently "1" is the only valid value.
-  heaps_v2.Set("version", 1);
+  result.append(",\"heaps_v2\":{\"version\":1");
 
   // Put all required context strings in the string table and generate a
   // mapping from allocation context_id to string ID.
@@ -287,23 +334,19 @@ std::string ExportMemoryMapsAndV2StackTraceToJSON(ExportParams* params) {
   }
 
   // Maps section.
-  base::Value::Dict maps;
-  maps.Set("strings", BuildStrings(string_table));
-  maps.Set("nodes", BuildMapNodes(nodes));
-  maps.Set("types", BuildTypeNodes(context_to_string_id_map));
-  heaps_v2.Set("maps", std::move(maps));
-
-  heaps_v2.Set("allocators",
-               BuildAllocations(params->allocs, alloc_to_node_id));
-
-  result.Set("heaps_v2", std::move(heaps_v2));
-
-  std::string result_json;
-  bool ok = base::JSONWriter::WriteWithOptions(
-      result, base::JSONWriter::OPTIONS_OMIT_DOUBLE_TYPE_PRESERVATION,
-      &result_json);
-  DCHECK(ok);
-  return result_json;
+  result.append(",\"maps\":{\"strings\":");
+  AppendStrings(string_table, &result);
+  result.append(",\"nodes\":");
+  AppendMapNodes(nodes, &result);
+  result.append(",\"types\":");
+  AppendTypeNodes(context_to_string_id_map, &result);
+  result.push_back('}');
+
+  result.append(",\"allocators\":");
+  AppendAllocations(params->allocs, alloc_to_node_id, &result);
+
+  result.append("}}");
+  return result;
 }
 
 }  // namespace heap_profiling
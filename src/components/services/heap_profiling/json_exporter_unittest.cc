@@ -417,6 +417,26 @@ TEST(ProfilingJsonExporterTest, Context) {
   ASSERT_TRUE(found_no_context);
 }
 
+TEST(ProfilingJsonExporterTest, EscapedStrings) {
+  std::vector<Address> stack{Address(0x1234)};
+  AllocationMap allocs;
+  InsertAllocation(&allocs, AllocatorType::kMalloc, 16, stack, 0);
+
+  ExportParams params;
+  params.allocs = std::move(allocs);
+  params.mapped_strings[0x1234] = "Foo<\"bar\\baz\">";
+  params.context_map["context\n"] = 1;
+  std::string json = ExportMemoryMapsAndV2StackTraceToJSON(&params);
+
+  std::optional<base::Value> root = base::JSONReader::Read(json);
+  ASSERT_TRUE(root);
+  const base::Value::List* strings =
+      root->GetDict().FindListByDottedPath("heaps_v2.maps.strings");
+  ASSERT_TRUE(strings);
+  EXPECT_NE(-1, GetIdFromStringTable(*strings, "Foo<\"bar\\baz\">"));
+  EXPECT_NE(-1, GetIdFromStringTable(*strings, "context\n"));
+}
+
 #if defined(ARCH_CPU_64_BITS)
 TEST(ProfilingJsonExporterTest, LargeAllocation) {
   std::vector<Address> stack1{Address(0x5678), Address(0x1234)};
@@ -22,11 +22,14 @@
 #include "components/services/paint_preview_compositor/public/mojom/paint_preview_compositor.mojom.h"
 #include "mojo/public/cpp/base/proto_wrapper.h"
 #include "skia/ext/legacy_display_globals.h"
+#include "third_party/skia/include/core/SkBBHFactory.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkPictureRecorder.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkScalar.h"
 #include "third_party/skia/include/core/SkStream.h"
 
@@ -34,44 +37,22 @@ namespace paint_preview {
 
 namespace {
 
-std::optional<PaintPreviewFrame> BuildFrame(
-    const base::UnguessableToken& token,
-    const PaintPreviewFrameProto& frame_proto,
-    const base::flat_map<base::UnguessableToken, SkpResult>& results) {
-  TRACE_EVENT0("paint_preview", "PaintPreviewCompositorImpl::BuildFrame");
-  auto it = results.find(token);
-  if (it == results.end())
-    return std::nullopt;
-
-  const SkpResult& result = it->second;
-  PaintPreviewFrame frame;
-  frame.skp = result.skp;
-
-  for (const auto& id_pair : frame_proto.content_id_to_embedding_tokens()) {
-    // It is possible that subframes recorded in this map were not captured
-    // (e.g. renderer crash, closed, etc.). Missing subframes are allowable
-    // since having just the main frame is sufficient to create a preview.
-    auto rect_it = result.ctx.find(id_pair.content_id());
-    if (rect_it == result.ctx.end())
-      continue;
+// The number of pictures of separated frames kept deserialized. Scrolling a
+// preview rasters the same few frames over and over, the others are
+// deserialized again on demand.
+constexpr size_t kMaxCachedFrames = 4;
 
-    mojom::SubframeClipRect rect;
-    std::optional<base::UnguessableToken> maybe_deserialized_token =
-        base::UnguessableToken::Deserialize(id_pair.embedding_token_high(),
-                                            id_pair.embedding_token_low());
-    if (!maybe_deserialized_token.has_value()) {
-      continue;
-    }
-    rect.frame_guid = maybe_deserialized_token.value();
-
-    rect.clip_rect = rect_it->second;
-
-    if (!results.count(rect.frame_guid))
-      continue;
-
-    frame.subframe_clip_rects.push_back(rect);
-  }
-  return frame;
+// Re-records `skp` with an R-tree of the bounds of its draw ops, including
+// those of embedded subframes. Deserialized pictures don't have one, so
+// rastering a tile of them plays back every op. With it, rastering a tile only
+// plays back the ops that intersect the tile.
+sk_sp<SkPicture> AddBoundingBoxHierarchy(sk_sp<SkPicture> skp) {
+  TRACE_EVENT0("paint_preview",
+               "PaintPreviewCompositorImpl::AddBoundingBoxHierarchy");
+  SkRTreeFactory factory;
+  SkPictureRecorder recorder;
+  skp->playback(recorder.beginRecording(skp->cullRect(), &factory));
+  return recorder.finishRecordingAsPicture();
 }
 
 // Adjusts `clip_rect` to be bounded by `picture_rectf` when scaled by
@@ -116,16 +97,18 @@ gfx::Rect AdjustClipRect(const gfx::Rect& clip_rect,
 }
 
 // Holds a ref to the discardable_shared_memory_manager so it sticks around
-// until at least after skia is finished with it.
+// until at least after skia is finished with it. `cull_rect` is the bounds of
+// `skp` as recorded.
 std::optional<SkBitmap> CreateBitmap(
     scoped_refptr<discardable_memory::ClientDiscardableSharedMemoryManager>
         discardable_shared_memory_manager,
     sk_sp<SkPicture> skp,
+    const SkRect& cull_rect,
     const gfx::Rect& raw_clip_rect,
     float scale_factor) {
   TRACE_EVENT0("paint_preview", "PaintPreviewCompositorImpl::CreateBitmap");
   const gfx::Rect clip_rect =
-      AdjustClipRect(raw_clip_rect, skp->cullRect(), scale_factor);
+      AdjustClipRect(raw_clip_rect, cull_rect, scale_factor);
   SkBitmap bitmap;
   if (!bitmap.tryAllocPixels(
           SkImageInfo::MakeN32Premul(clip_rect.width(), clip_rect.height()))) {
@@ -142,12 +125,21 @@ std::optional<SkBitmap> CreateBitmap(
 
 }  // namespace
 
+struct PaintPreviewCompositorImpl::DeserializedFrame {
+  // Null if the picture is only cached in |frame_cache_|.
+  sk_sp<SkPicture> skp;
+  SkRect cull_rect;
+  DeserializationContext ctx;
+  std::optional<SerializedRecording> recording;
+};
+
 PaintPreviewCompositorImpl::PaintPreviewCompositorImpl(
     mojo::PendingReceiver<mojom::PaintPreviewCompositor> receiver,
     scoped_refptr<discardable_memory::ClientDiscardableSharedMemoryManager>
         discardable_shared_memory_manager,
     base::OnceClosure disconnect_handler)
-    : discardable_shared_memory_manager_(discardable_shared_memory_manager) {
+    : frame_cache_(kMaxCachedFrames),
+      discardable_shared_memory_manager_(discardable_shared_memory_manager) {
   if (receiver) {
     receiver_.Bind(std::move(receiver));
     receiver_.set_disconnect_handler(std::move(disconnect_handler));
@@ -168,6 +160,7 @@ void PaintPreviewCompositorImpl::BeginSeparatedFrameComposite(
   // is called multiple times.
   root_frame_ = nullptr;
   frames_.clear();
+  frame_cache_.Clear();
 
   auto response = mojom::PaintPreviewBeginCompositeResponse::New();
   auto paint_preview = request->preview.As<PaintPreviewProto>();
@@ -198,7 +191,7 @@ void PaintPreviewCompositorImpl::BeginSeparatedFrameComposite(
   auto frames = DeserializeAllFrames(std::move(request->recording_map));
 
   // Adding the root frame must succeed.
-  if (!AddFrame(paint_preview->root_frame(), frames, &response)) {
+  if (!AddFrame(paint_preview->root_frame(), &frames, &response)) {
     DVLOG(1) << "Root frame not found.";
     std::move(callback).Run(mojom::PaintPreviewCompositor::
                                 BeginCompositeStatus::kCompositingFailure,
@@ -209,7 +202,7 @@ void PaintPreviewCompositorImpl::BeginSeparatedFrameComposite(
   bool subframe_failed = false;
   // Adding subframes is optional.
   for (const auto& subframe_proto : paint_preview->subframes()) {
-    if (!AddFrame(subframe_proto, frames, &response))
+    if (!AddFrame(subframe_proto, &frames, &response))
       subframe_failed = true;
   }
 
@@ -234,13 +227,21 @@ void PaintPreviewCompositorImpl::BitmapForSeparatedFrame(
         mojom::PaintPreviewCompositor::BitmapStatus::kMissingFrame, SkBitmap());
     return;
   }
+  sk_sp<SkPicture> skp = GetFramePicture(frame_guid, frame_it->second);
+  if (!skp) {
+    DVLOG(1) << "Frame could not be deserialized " << frame_guid.ToString();
+    std::move(callback).Run(
+        mojom::PaintPreviewCompositor::BitmapStatus::kMissingFrame, SkBitmap());
+    return;
+  }
 
   base::ThreadPool::PostTaskAndReplyWithResult(
       FROM_HERE,
       {base::TaskPriority::USER_VISIBLE, base::WithBaseSyncPrimitives(),
        base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
       base::BindOnce(&CreateBitmap, discardable_shared_memory_manager_,
-                     frame_it->second.skp, clip_rect, scale_factor),
+                     std::move(skp), frame_it->second.cull_rect, clip_rect,
+                     scale_factor),
       base::BindOnce(
           [](BitmapForSeparatedFrameCallback callback,
              const std::optional<SkBitmap>& maybe_bitmap) {
@@ -263,6 +264,7 @@ void PaintPreviewCompositorImpl::BeginMainFrameComposite(
   TRACE_EVENT0("paint_preview",
                "PaintPreviewCompositorImpl::BeginMainFrameComposite");
   frames_.clear();
+  frame_cache_.Clear();
   auto response = mojom::PaintPreviewBeginCompositeResponse::New();
   auto paint_preview = request->preview.As<PaintPreviewProto>();
   if (!paint_preview.has_value()) {
@@ -303,10 +305,13 @@ void PaintPreviewCompositorImpl::BeginMainFrameComposite(
     return;
   }
 
+  root_frame_cull_rect_ = root_frame_->cullRect();
+  root_frame_ = AddBoundingBoxHierarchy(std::move(root_frame_));
+
   response->root_frame_guid = root_frame_guid;
   auto frame_data = mojom::FrameData::New();
-  SkRect sk_rect = root_frame_->cullRect();
-  frame_data->scroll_extents = gfx::Size(sk_rect.width(), sk_rect.height());
+  frame_data->scroll_extents = gfx::Size(root_frame_cull_rect_.width(),
+                                         root_frame_cull_rect_.height());
   frame_data->scroll_offsets =
       gfx::Size(paint_preview->root_frame().has_scroll_offset_x()
                     ? paint_preview->root_frame().scroll_offset_x()
@@ -341,7 +346,8 @@ void PaintPreviewCompositorImpl::BitmapForMainFrame(
       {base::TaskPriority::USER_VISIBLE, base::WithBaseSyncPrimitives(),
        base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
       base::BindOnce(&CreateBitmap, discardable_shared_memory_manager_,
-                     root_frame_, clip_rect, scale_factor),
+                     root_frame_, root_frame_cull_rect_, clip_rect,
+                     scale_factor),
       base::BindOnce(
           [](BitmapForMainFrameCallback callback,
              const std::optional<SkBitmap>& maybe_bitmap) {
@@ -364,7 +370,7 @@ void PaintPreviewCompositorImpl::SetRootFrameUrl(const GURL& url) {
 
 bool PaintPreviewCompositorImpl::AddFrame(
     const PaintPreviewFrameProto& frame_proto,
-    const base::flat_map<base::UnguessableToken, SkpResult>& skp_map,
+    DeserializedFrameMap* deserialized_frames,
     mojom::PaintPreviewBeginCompositeResponsePtr* response) {
   std::optional<base::UnguessableToken> maybe_guid =
       base::UnguessableToken::Deserialize(frame_proto.embedding_token_high(),
@@ -373,16 +379,20 @@ bool PaintPreviewCompositorImpl::AddFrame(
     return false;
   }
   base::UnguessableToken guid = maybe_guid.value();
+  // The recording of the frame was consumed when it was first added.
+  if (frames_.contains(guid)) {
+    return true;
+  }
 
   std::optional<PaintPreviewFrame> maybe_frame =
-      BuildFrame(guid, frame_proto, skp_map);
+      BuildFrame(guid, frame_proto, deserialized_frames);
   if (!maybe_frame.has_value())
     return false;
   const PaintPreviewFrame& frame = maybe_frame.value();
 
   auto frame_data = mojom::FrameData::New();
-  SkRect sk_rect = frame.skp->cullRect();
-  frame_data->scroll_extents = gfx::Size(sk_rect.width(), sk_rect.height());
+  frame_data->scroll_extents =
+      gfx::Size(frame.cull_rect.width(), frame.cull_rect.height());
   frame_data->scroll_offsets = gfx::Size(
       frame_proto.has_scroll_offset_x() ? frame_proto.scroll_offset_x() : 0,
       frame_proto.has_scroll_offset_y() ? frame_proto.scroll_offset_y() : 0);
@@ -395,16 +405,19 @@ bool PaintPreviewCompositorImpl::AddFrame(
   return true;
 }
 
-// static
-base::flat_map<base::UnguessableToken, SkpResult>
+PaintPreviewCompositorImpl::DeserializedFrameMap
 PaintPreviewCompositorImpl::DeserializeAllFrames(RecordingMap&& recording_map) {
   TRACE_EVENT0("paint_preview",
                "PaintPreviewCompositorImpl::DeserializeAllFrames");
-  std::vector<std::pair<base::UnguessableToken, SkpResult>> results;
+  std::vector<std::pair<base::UnguessableToken, DeserializedFrame>> results;
   results.reserve(recording_map.size());
 
   for (auto& it : recording_map) {
-    std::optional<SkpResult> maybe_result = std::move(it.second).Deserialize();
+    SerializedRecording& recording = it.second;
+    const bool retain_recording = recording.is_buffer();
+    std::optional<SkpResult> maybe_result =
+        retain_recording ? recording.DeserializeWithoutConsuming()
+                         : std::move(recording).Deserialize();
     if (!maybe_result.has_value())
       continue;
 
@@ -414,10 +427,84 @@ PaintPreviewCompositorImpl::DeserializeAllFrames(RecordingMap&& recording_map) {
       continue;
     }
 
-    results.emplace_back(it.first, std::move(result));
+    DeserializedFrame frame;
+    frame.cull_rect = result.skp->cullRect();
+    frame.ctx = std::move(result.ctx);
+    sk_sp<SkPicture> skp = AddBoundingBoxHierarchy(std::move(result.skp));
+    if (retain_recording) {
+      frame.recording = std::move(recording);
+      frame_cache_.Put(it.first, std::move(skp));
+    } else {
+      frame.skp = std::move(skp);
+    }
+    results.emplace_back(it.first, std::move(frame));
+  }
+
+  return DeserializedFrameMap(std::move(results));
+}
+
+// static
+std::optional<PaintPreviewFrame> PaintPreviewCompositorImpl::BuildFrame(
+    const base::UnguessableToken& token,
+    const PaintPreviewFrameProto& frame_proto,
+    DeserializedFrameMap* deserialized_frames) {
+  TRACE_EVENT0("paint_preview", "PaintPreviewCompositorImpl::BuildFrame");
+  auto it = deserialized_frames->find(token);
+  if (it == deserialized_frames->end())
+    return std::nullopt;
+
+  DeserializedFrame& deserialized_frame = it->second;
+  PaintPreviewFrame frame;
+  frame.skp = deserialized_frame.skp;
+  frame.cull_rect = deserialized_frame.cull_rect;
+  frame.recording = std::move(deserialized_frame.recording);
+
+  for (const auto& id_pair : frame_proto.content_id_to_embedding_tokens()) {
+    // It is possible that subframes recorded in this map were not captured
+    // (e.g. renderer crash, closed, etc.). Missing subframes are allowable
+    // since having just the main frame is sufficient to create a preview.
+    auto rect_it = deserialized_frame.ctx.find(id_pair.content_id());
+    if (rect_it == deserialized_frame.ctx.end())
+      continue;
+
+    mojom::SubframeClipRect rect;
+    std::optional<base::UnguessableToken> maybe_deserialized_token =
+        base::UnguessableToken::Deserialize(id_pair.embedding_token_high(),
+                                            id_pair.embedding_token_low());
+    if (!maybe_deserialized_token.has_value()) {
+      continue;
+    }
+    rect.frame_guid = maybe_deserialized_token.value();
+
+    rect.clip_rect = rect_it->second;
+
+    if (!deserialized_frames->count(rect.frame_guid))
+      continue;
+
+    frame.subframe_clip_rects.push_back(rect);
   }
+  return frame;
+}
+
+sk_sp<SkPicture> PaintPreviewCompositorImpl::GetFramePicture(
+    const base::UnguessableToken& frame_guid,
+    const PaintPreviewFrame& frame) {
+  if (frame.skp)
+    return frame.skp;
 
-  return base::flat_map<base::UnguessableToken, SkpResult>(std::move(results));
+  auto it = frame_cache_.Get(frame_guid);
+  if (it != frame_cache_.end())
+    return it->second;
+
+  if (!frame.recording.has_value())
+    return nullptr;
+  std::optional<SkpResult> result =
+      frame.recording->DeserializeWithoutConsuming();
+  if (!result.has_value() || !result->skp)
+    return nullptr;
+  sk_sp<SkPicture> skp = AddBoundingBoxHierarchy(std::move(result->skp));
+  frame_cache_.Put(frame_guid, skp);
+  return skp;
 }
 
 // static
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include "base/containers/flat_map.h"
+#include "base/containers/lru_cache.h"
 #include "base/functional/callback.h"
 #include "components/discardable_memory/client/client_discardable_shared_memory_manager.h"
 #include "components/paint_preview/common/proto/paint_preview.pb.h"
@@ -17,6 +18,7 @@
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/receiver.h"
 #include "ui/gfx/geometry/rect.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "url/gurl.h"
 
 namespace paint_preview {
@@ -62,16 +64,37 @@ class PaintPreviewCompositorImpl : public mojom::PaintPreviewCompositor {
                           BitmapForMainFrameCallback callback) override;
   void SetRootFrameUrl(const GURL& url) override;
 
+  // Drops the cached pictures of frames that can be deserialized again.
+  void ClearFrameCacheForTesting() { frame_cache_.Clear(); }
+
  private:
+  // A frame recording deserialized by |DeserializeAllFrames|.
+  struct DeserializedFrame;
+  using DeserializedFrameMap =
+      base::flat_map<base::UnguessableToken, DeserializedFrame>;
+
   // Adds |frame_proto| to |frames_| and copies required data into |response|.
-  // Consumes the corresponding file in |file_map|. Returns true on success.
-  bool AddFrame(
+  // Consumes the corresponding recording in |deserialized_frames|. Returns true
+  // on success.
+  bool AddFrame(const PaintPreviewFrameProto& frame_proto,
+                DeserializedFrameMap* deserialized_frames,
+                mojom::PaintPreviewBeginCompositeResponsePtr* response);
+
+  // Deserializes the recordings of all the frames. Recordings that can be
+  // deserialized again are kept in the result and their pictures are only
+  // cached in |frame_cache_|, so that the pictures of large captures aren't
+  // all held in memory at once.
+  DeserializedFrameMap DeserializeAllFrames(RecordingMap&& recording_map);
+
+  static std::optional<PaintPreviewFrame> BuildFrame(
+      const base::UnguessableToken& token,
       const PaintPreviewFrameProto& frame_proto,
-      const base::flat_map<base::UnguessableToken, SkpResult>& skp_map,
-      mojom::PaintPreviewBeginCompositeResponsePtr* response);
+      DeserializedFrameMap* deserialized_frames);
 
-  static base::flat_map<base::UnguessableToken, SkpResult> DeserializeAllFrames(
-      RecordingMap&& recording_map);
+  // Returns the picture of |frame|, deserializing it again if it is not in
+  // |frame_cache_|. Returns |nullptr| on failure.
+  sk_sp<SkPicture> GetFramePicture(const base::UnguessableToken& frame_guid,
+                                   const PaintPreviewFrame& frame);
 
   // Deserialize a the recording of the frame specified by |frame_proto|.
   // Subframes are recursed into and loaded into |loaded_frames| so the current
@@ -97,10 +120,16 @@ class PaintPreviewCompositorImpl : public mojom::PaintPreviewCompositor {
   // Must be modified only by |BeginSeparatedFrameComposite|.
   base::flat_map<base::UnguessableToken, PaintPreviewFrame> frames_;
 
+  // The most recently used pictures of the |frames_| that are deserialized on
+  // demand.
+  base::LRUCache<base::UnguessableToken, sk_sp<SkPicture>> frame_cache_;
+
   // Contains the root frame, including content from subframes. |nullptr| until
   // |BeginMainFrameComposite| succeeds.
   // Must be modified only by |BeginMainFrameComposite|.
   sk_sp<SkPicture> root_frame_;
+  // The bounds of |root_frame_| as recorded.
+  SkRect root_frame_cull_rect_ = SkRect::MakeEmpty();
 
   scoped_refptr<discardable_memory::ClientDiscardableSharedMemoryManager>
       discardable_shared_memory_manager_;
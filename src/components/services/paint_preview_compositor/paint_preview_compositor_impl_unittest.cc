@@ -700,6 +700,62 @@ TEST_F(PaintPreviewCompositorTest, TestCompositeWithMemoryBuffer) {
   task_environment_.RunUntilIdle();
 }
 
+TEST_F(PaintPreviewCompositorTest, TestCompositeTilesWithMemoryBuffer) {
+  const base::UnguessableToken kRootFrameID = base::UnguessableToken::Create();
+  gfx::Size root_frame_scroll_extent(100, 200);
+  PaintPreviewProto proto;
+  proto.mutable_metadata()->set_url("https://www.chromium.org");
+
+  PaintPreviewFrameProto* root_frame = proto.mutable_root_frame();
+  root_frame->set_embedding_token_low(kRootFrameID.GetLowForSerialization());
+  root_frame->set_embedding_token_high(kRootFrameID.GetHighForSerialization());
+  root_frame->set_is_main_frame(true);
+
+  mojo_base::BigBuffer buffer;
+  {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas =
+        recorder.beginRecording(ToSkRect(root_frame_scroll_extent));
+    DrawDummyTestPicture(canvas, SK_ColorDKGRAY, root_frame_scroll_extent);
+    PaintPreviewTracker tracker(base::UnguessableToken::Create(), kRootFrameID,
+                                /*is_main_frame=*/true);
+    size_t serialized_size = 0;
+    auto result = RecordToBuffer(recorder.finishRecordingAsPicture(), &tracker,
+                                 std::nullopt, &serialized_size);
+    ASSERT_TRUE(result.has_value());
+    buffer = std::move(result.value());
+  }
+
+  mojom::PaintPreviewBeginCompositeRequestPtr request =
+      mojom::PaintPreviewBeginCompositeRequest::New();
+  request->recording_map.insert(
+      {kRootFrameID, SerializedRecording(std::move(buffer))});
+  request->preview = mojo_base::ProtoWrapper(proto);
+  compositor_.BeginSeparatedFrameComposite(std::move(request),
+                                           base::DoNothing());
+
+  // The bottom half of the frame, at twice the scale.
+  float scale_factor = 2;
+  gfx::Rect tile(0, 200, 200, 200);
+  SkBitmap bitmap;
+  bitmap.allocPixels(SkImageInfo::MakeN32Premul(tile.width(), tile.height()));
+  SkCanvas canvas(bitmap, SkSurfaceProps{});
+  canvas.translate(-tile.x(), -tile.y());
+  canvas.scale(scale_factor, scale_factor);
+  DrawDummyTestPicture(&canvas, SK_ColorDKGRAY, root_frame_scroll_extent);
+
+  // The frame is deserialized again once evicted, then served from the cache.
+  compositor_.ClearFrameCacheForTesting();
+  for (int i = 0; i < 2; ++i) {
+    compositor_.BitmapForSeparatedFrame(
+        kRootFrameID, tile, scale_factor,
+        base::BindOnce(&BitmapCallbackImpl,
+                       mojom::PaintPreviewCompositor::BitmapStatus::kSuccess,
+                       bitmap));
+    task_environment_.RunUntilIdle();
+  }
+}
+
 TEST_F(PaintPreviewCompositorTest, TestCompositeMainFrameNoDependencies) {
   GURL url("https://www.chromium.org");
   const base::UnguessableToken kRootFrameID = base::UnguessableToken::Create();
@@ -5,10 +5,13 @@
 #ifndef COMPONENTS_SERVICES_PAINT_PREVIEW_COMPOSITOR_PAINT_PREVIEW_FRAME_H_
 #define COMPONENTS_SERVICES_PAINT_PREVIEW_COMPOSITOR_PAINT_PREVIEW_FRAME_H_
 
+#include <optional>
 #include <vector>
 
+#include "components/paint_preview/common/serialized_recording.h"
 #include "components/services/paint_preview_compositor/public/mojom/paint_preview_compositor.mojom.h"
 #include "third_party/skia/include/core/SkPicture.h"
+#include "third_party/skia/include/core/SkRect.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 
 namespace paint_preview {
@@ -23,7 +26,12 @@ struct PaintPreviewFrame {
   PaintPreviewFrame(PaintPreviewFrame&& other);
   PaintPreviewFrame& operator=(PaintPreviewFrame&& other);
 
+  // Null if the picture is deserialized on demand from |recording|.
   sk_sp<SkPicture> skp;
+  // The bounds of the picture as recorded.
+  SkRect cull_rect = SkRect::MakeEmpty();
+  // Set if the picture can be deserialized again from the recording.
+  std::optional<SerializedRecording> recording;
   std::vector<mojom::SubframeClipRect> subframe_clip_rects;
 
  private:
@@ -4,14 +4,19 @@
 
 #include "components/services/print_compositor/print_compositor_impl.h"
 
+#include <optional>
 #include <tuple>
 #include <utility>
 
 #include "base/containers/contains.h"
+#include "base/functional/bind.h"
 #include "base/logging.h"
 #include "base/memory/discardable_memory.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/ranges/algorithm.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/task/thread_pool.h"
 #include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
 #include "components/crash/core/common/crash_key.h"
@@ -46,6 +51,10 @@ using MojoDiscardableSharedMemoryManager =
 
 namespace printing {
 
+BASE_FEATURE(kParallelPageComposition,
+             "ParallelPageComposition",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 namespace {
 
 sk_sp<SkDocument> MakeDocument(
@@ -67,6 +76,57 @@ sk_sp<SkDocument> MakeDocument(
       generate_document_outline, &stream);
 }
 
+void DrawPage(SkDocument& doc, const SkDocumentPage& page) {
+  SkCanvas* canvas = doc.beginPage(page.fSize.width(), page.fSize.height());
+  canvas->drawPicture(page.fPicture);
+  doc.endPage();
+}
+
+// Returns an invalid region on failure.
+base::ReadOnlySharedMemoryRegion CopyToRegion(SkDynamicMemoryWStream& stream) {
+  base::MappedReadOnlyRegion region_mapping =
+      base::ReadOnlySharedMemoryRegion::Create(stream.bytesWritten());
+  if (!region_mapping.IsValid()) {
+    return base::ReadOnlySharedMemoryRegion();
+  }
+  stream.copyToAndReset(region_mapping.mapping.memory());
+  return std::move(region_mapping.region);
+}
+
+// Draws `pages` into a new PDF. Runs on a worker thread.
+base::ReadOnlySharedMemoryRegion DrawPdfBlocking(
+    const std::string& creator,
+    const std::string& title,
+    std::optional<ui::AXTreeUpdate> accessibility_tree,
+    mojom::GenerateDocumentOutline generate_document_outline,
+    const std::vector<SkDocumentPage>& pages) {
+  TRACE_EVENT0("print", "PrintCompositorImpl DrawPdfBlocking");
+  SkDynamicMemoryWStream wstream;
+  sk_sp<SkDocument> doc = MakeDocument(
+      creator, title, accessibility_tree ? &*accessibility_tree : nullptr,
+      generate_document_outline, mojom::PrintCompositor::DocumentType::kPDF,
+      wstream);
+  for (const auto& page : pages) {
+    DrawPage(*doc, page);
+  }
+  doc->close();
+  return CopyToRegion(wstream);
+}
+
+void OnPdfDrawn(base::OnceCallback<void(mojom::PrintCompositor::Status,
+                                        base::ReadOnlySharedMemoryRegion)>
+                    callback,
+                base::ReadOnlySharedMemoryRegion region) {
+  if (!region.IsValid()) {
+    DLOG(ERROR) << "CompositePages: Cannot create new shared memory region.";
+    std::move(callback).Run(mojom::PrintCompositor::Status::kHandleMapError,
+                            base::ReadOnlySharedMemoryRegion());
+    return;
+  }
+  std::move(callback).Run(mojom::PrintCompositor::Status::kSuccess,
+                          std::move(region));
+}
+
 }  // namespace
 
 PrintCompositorImpl::PrintCompositorImpl(
@@ -374,6 +434,42 @@ mojom::PrintCompositor::Status PrintCompositorImpl::CompositePages(
     mojom::PrintCompositor::DocumentType document_type) {
   TRACE_EVENT0("print", "PrintCompositorImpl::CompositePages");
 
+  std::vector<SkDocumentPage> pages;
+  mojom::PrintCompositor::Status status =
+      ReadPages(serialized_content, subframe_content_map, &pages);
+  if (status != mojom::PrintCompositor::Status::kSuccess) {
+    return status;
+  }
+
+  // Create PDF document providing accessibility data early if concurrent
+  // document composition is not in effect, i.e. when handling
+  // CompositeDocumentToPdf() call.
+  SkDynamicMemoryWStream wstream;
+  sk_sp<SkDocument> doc =
+      MakeDocument(creator_, title_, docinfo_ ? nullptr : &accessibility_tree_,
+                   generate_document_outline_, document_type, wstream);
+
+  for (const auto& page : pages) {
+    TRACE_EVENT0("print", "PrintCompositorImpl::CompositePages draw page");
+    DrawPage(*doc, page);
+    if (docinfo_) {
+      AddPageToDocument(page);
+    }
+  }
+  doc->close();
+
+  *region = CopyToRegion(wstream);
+  if (!region->IsValid()) {
+    DLOG(ERROR) << "CompositePages: Cannot create new shared memory region.";
+    return mojom::PrintCompositor::Status::kHandleMapError;
+  }
+  return mojom::PrintCompositor::Status::kSuccess;
+}
+
+mojom::PrintCompositor::Status PrintCompositorImpl::ReadPages(
+    base::span<const uint8_t> serialized_content,
+    const ContentToFrameMap& subframe_content_map,
+    std::vector<SkDocumentPage>* pages) {
   PictureDeserializationContext subframes =
       GetPictureDeserializationContext(subframe_content_map);
 
@@ -385,55 +481,64 @@ mojom::PrintCompositor::Status PrintCompositorImpl::CompositePages(
     return mojom::PrintCompositor::Status::kContentFormatError;
   }
 
-  std::vector<SkDocumentPage> pages(page_count);
+  pages->resize(page_count);
   SkDeserialProcs procs = DeserializationProcs(&subframes, &typefaces_);
-  if (!SkMultiPictureDocument::Read(&stream, pages.data(), page_count,
+  if (!SkMultiPictureDocument::Read(&stream, pages->data(), page_count,
                                     &procs)) {
     DLOG(ERROR) << "CompositePages: Page reading failed.";
     return mojom::PrintCompositor::Status::kContentFormatError;
   }
+  return mojom::PrintCompositor::Status::kSuccess;
+}
 
-  // Create PDF document providing accessibility data early if concurrent
-  // document composition is not in effect, i.e. when handling
-  // CompositeDocumentToPdf() call.
-  SkDynamicMemoryWStream wstream;
-  sk_sp<SkDocument> doc =
-      MakeDocument(creator_, title_, docinfo_ ? nullptr : &accessibility_tree_,
-                   generate_document_outline_, document_type, wstream);
+void PrintCompositorImpl::AddPageToDocument(const SkDocumentPage& page) {
+  // Create full document if needed.
+  if (!docinfo_->doc) {
+    docinfo_->doc = MakeDocument(
+        creator_, title_, &accessibility_tree_, generate_document_outline_,
+        docinfo_->document_type, docinfo_->compositor_stream);
+  }
 
-  for (const auto& page : pages) {
-    TRACE_EVENT0("print", "PrintCompositorImpl::CompositePages draw page");
-    SkCanvas* canvas = doc->beginPage(page.fSize.width(), page.fSize.height());
-    canvas->drawPicture(page.fPicture);
-    doc->endPage();
-    if (docinfo_) {
-      // Create full document if needed.
-      if (!docinfo_->doc) {
-        docinfo_->doc = MakeDocument(
-            creator_, title_, &accessibility_tree_, generate_document_outline_,
-            docinfo_->document_type, docinfo_->compositor_stream);
-      }
+  // Collect this page into full document.
+  DrawPage(*docinfo_->doc, page);
+  docinfo_->pages_written++;
+}
 
-      // Collect this page into full document.
-      SkCanvas* canvas_doc =
-          docinfo_->doc->beginPage(page.fSize.width(), page.fSize.height());
-      canvas_doc->drawPicture(page.fPicture);
-      docinfo_->doc->endPage();
-      docinfo_->pages_written++;
-    }
+void PrintCompositorImpl::CompositePagesInParallel(
+    base::span<const uint8_t> serialized_content,
+    const ContentToFrameMap& subframe_content_map,
+    CompositePagesCallback callback) {
+  TRACE_EVENT0("print", "PrintCompositorImpl::CompositePagesInParallel");
+
+  // Deserialization shares the typefaces across requests, so it has to happen
+  // here, in request order.
+  std::vector<SkDocumentPage> pages;
+  mojom::PrintCompositor::Status status =
+      ReadPages(serialized_content, subframe_content_map, &pages);
+  if (status != mojom::PrintCompositor::Status::kSuccess) {
+    std::move(callback).Run(status, base::ReadOnlySharedMemoryRegion());
+    return;
   }
-  doc->close();
 
-  base::MappedReadOnlyRegion region_mapping =
-      base::ReadOnlySharedMemoryRegion::Create(wstream.bytesWritten());
-  if (!region_mapping.IsValid()) {
-    DLOG(ERROR) << "CompositePages: Cannot create new shared memory region.";
-    return mojom::PrintCompositor::Status::kHandleMapError;
+  // Pages are streamed into the full document in order.
+  if (docinfo_) {
+    for (const auto& page : pages) {
+      AddPageToDocument(page);
+    }
   }
 
-  wstream.copyToAndReset(region_mapping.mapping.memory());
-  *region = std::move(region_mapping.region);
-  return mojom::PrintCompositor::Status::kSuccess;
+  // The pictures are immutable, so the request's own PDF can be drawn
+  // elsewhere while the following requests are composited.
+  std::optional<ui::AXTreeUpdate> accessibility_tree;
+  if (!docinfo_) {
+    accessibility_tree = accessibility_tree_;
+  }
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+      base::BindOnce(&DrawPdfBlocking, creator_, title_,
+                     std::move(accessibility_tree), generate_document_outline_,
+                     std::move(pages)),
+      base::BindOnce(&OnPdfDrawn, std::move(callback)));
 }
 
 void PrintCompositorImpl::CompositeSubframe(FrameInfo* frame_info) {
@@ -475,6 +580,14 @@ void PrintCompositorImpl::FulfillRequest(
     const ContentToFrameMap& subframe_content_map,
     mojom::PrintCompositor::DocumentType document_type,
     CompositePagesCallback callback) {
+  // XPS documents need COM to be initialized on the thread they are drawn on.
+  if (base::FeatureList::IsEnabled(kParallelPageComposition) &&
+      document_type == mojom::PrintCompositor::DocumentType::kPDF) {
+    CompositePagesInParallel(serialized_content, subframe_content_map,
+                             std::move(callback));
+    return;
+  }
+
   base::ReadOnlySharedMemoryRegion region;
   auto status = CompositePages(serialized_content, subframe_content_map,
                                &region, document_type);
@@ -488,12 +601,15 @@ void PrintCompositorImpl::FinishDocumentRequest(
 
   docinfo_->doc->close();
 
-  base::MappedReadOnlyRegion region_mapping =
-      base::ReadOnlySharedMemoryRegion::Create(
-          docinfo_->compositor_stream.bytesWritten());
-  if (region_mapping.IsValid()) {
-    docinfo_->compositor_stream.copyToAndReset(region_mapping.mapping.memory());
-    region = std::move(region_mapping.region);
+  const base::TimeDelta elapsed = base::TimeTicks::Now() - docinfo_->start_time;
+  if (elapsed.is_positive()) {
+    base::UmaHistogramCounts1000(
+        "Printing.PrintCompositor.PagesPerSecond",
+        base::ClampRound(docinfo_->page_count / elapsed.InSecondsF()));
+  }
+
+  region = CopyToRegion(docinfo_->compositor_stream);
+  if (region.IsValid()) {
     status = mojom::PrintCompositor::Status::kSuccess;
   } else {
     DLOG(ERROR) << "FinishDocumentRequest: "
@@ -518,7 +634,7 @@ PrintCompositorImpl::FrameContentInfo::~FrameContentInfo() = default;
 // `MakeXpsDocument()` is available.
 PrintCompositorImpl::DocumentInfo::DocumentInfo(
     mojom::PrintCompositor::DocumentType document_type)
-    : document_type(document_type) {}
+    : document_type(document_type), start_time(base::TimeTicks::Now()) {}
 
 PrintCompositorImpl::DocumentInfo::~DocumentInfo() = default;
 
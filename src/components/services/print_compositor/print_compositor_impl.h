@@ -13,10 +13,12 @@
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
 #include "base/containers/span.h"
+#include "base/feature_list.h"
 #include "base/gtest_prod_util.h"
 #include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/memory/scoped_refptr.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 #include "components/services/print_compositor/public/cpp/print_service_mojo_types.h"
 #include "components/services/print_compositor/public/mojom/print_compositor.mojom.h"
@@ -30,6 +32,7 @@
 #include "ui/accessibility/ax_tree_update.h"
 
 class SkDocument;
+struct SkDocumentPage;
 
 namespace base {
 class SingleThreadTaskRunner;
@@ -45,6 +48,10 @@ namespace printing {
 class ScopedXPSInitializer;
 #endif
 
+// Draws the PDF of each composited request on a worker thread, so that the
+// pages of a document are drawn in parallel.
+BASE_DECLARE_FEATURE(kParallelPageComposition);
+
 class PrintCompositorImpl : public mojom::PrintCompositor {
  public:
   // Creates an instance with an optional Mojo receiver (may be null) and
@@ -206,6 +213,8 @@ class PrintCompositorImpl : public mojom::PrintCompositor {
     uint32_t pages_written = 0;
     uint32_t page_count = 0;
     FinishDocumentCompositionCallback callback;
+    // When the document composition was prepared.
+    const base::TimeTicks start_time;
   };
 
   // Check whether any request is waiting for the specific subframe, if so,
@@ -240,6 +249,23 @@ class PrintCompositorImpl : public mojom::PrintCompositor {
   // Composite the content of a subframe.
   void CompositeSubframe(FrameInfo* frame_info);
 
+  // Deserializes the pages of |serialized_content| into |pages|.
+  mojom::PrintCompositor::Status ReadPages(
+      base::span<const uint8_t> serialized_content,
+      const ContentToFrameMap& subframe_content_map,
+      std::vector<SkDocumentPage>* pages);
+
+  // Appends |page| to the document of the concurrent document composition.
+  void AddPageToDocument(const SkDocumentPage& page);
+
+  // Like CompositePages(), but the pages are only added to the document of the
+  // concurrent document composition here, in order. Their own PDF is drawn on
+  // a worker thread, and `callback` is run once it is done.
+  void CompositePagesInParallel(
+      base::span<const uint8_t> serialized_content,
+      const ContentToFrameMap& subframe_content_map,
+      CompositePagesCallback callback);
+
   PictureDeserializationContext GetPictureDeserializationContext(
       const ContentToFrameMap& subframe_content_map);
 
@@ -9,12 +9,19 @@
 #include "base/functional/callback.h"
 #include "base/run_loop.h"
 #include "base/test/gtest_util.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/task_environment.h"
+#include "base/test/test_future.h"
 #include "components/crash/core/common/crash_key.h"
 #include "components/services/print_compositor/print_compositor_impl.h"
 #include "components/services/print_compositor/public/cpp/print_service_mojo_types.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkDocument.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/docs/SkMultiPictureDocument.h"
 
 namespace printing {
 
@@ -112,6 +119,22 @@ class PrintCompositorImplTest : public testing::Test {
     status_ = status;
   }
 
+  // Returns `page_count` blank pages serialized the way renderers do.
+  static base::ReadOnlySharedMemoryRegion CreateTestPages(int page_count) {
+    SkDynamicMemoryWStream stream;
+    sk_sp<SkDocument> doc = SkMultiPictureDocument::Make(&stream);
+    for (int i = 0; i < page_count; ++i) {
+      SkCanvas* canvas = doc->beginPage(612, 792);
+      canvas->clear(SK_ColorWHITE);
+      doc->endPage();
+    }
+    doc->close();
+    auto region =
+        base::ReadOnlySharedMemoryRegion::Create(stream.bytesWritten());
+    stream.copyToAndReset(region.mapping.memory());
+    return std::move(region.region);
+  }
+
   static base::ReadOnlySharedMemoryRegion CreateTestData(uint64_t frame_guid,
                                                          int page_num) {
     static constexpr size_t kSize = sizeof(TestRequestData);
@@ -421,4 +444,40 @@ TEST_F(PrintCompositorImplTest, MultiRequestsBasicFinishDocument) {
   EXPECT_EQ(GetStatus(), mojom::PrintCompositor::Status::kSuccess);
 }
 
+TEST_F(PrintCompositorImplTest, ParallelPageComposition) {
+  base::test::ScopedFeatureList feature_list(kParallelPageComposition);
+  base::HistogramTester histogram_tester;
+  PrintCompositorImpl impl(mojo::NullReceiver(),
+                           /*initialize_environment=*/false,
+                           /*io_task_runner=*/nullptr);
+  impl.PrepareToCompositeDocument(
+      mojom::PrintCompositor::DocumentType::kPDF,
+      base::BindOnce(
+          &PrintCompositorImplTest::OnPrepareToCompositeDocumentCallback));
+
+  // Each page's own PDF is drawn on a worker thread.
+  base::test::TestFuture<mojom::PrintCompositor::Status,
+                         base::ReadOnlySharedMemoryRegion>
+      page_futures[3];
+  for (auto& page_future : page_futures) {
+    impl.CompositePage(1, CreateTestPages(1), ContentToFrameMap(),
+                       page_future.GetCallback());
+  }
+  for (auto& page_future : page_futures) {
+    EXPECT_EQ(mojom::PrintCompositor::Status::kSuccess,
+              page_future.Get<0>());
+    EXPECT_TRUE(page_future.Get<1>().IsValid());
+  }
+
+  base::test::TestFuture<mojom::PrintCompositor::Status,
+                         base::ReadOnlySharedMemoryRegion>
+      document_future;
+  impl.FinishDocumentComposition(3, document_future.GetCallback());
+  EXPECT_EQ(mojom::PrintCompositor::Status::kSuccess,
+            document_future.Get<0>());
+  EXPECT_TRUE(document_future.Get<1>().IsValid());
+  histogram_tester.ExpectTotalCount("Printing.PrintCompositor.PagesPerSecond",
+                                    1);
+}
+
 }  // namespace printing
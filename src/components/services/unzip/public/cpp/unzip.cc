@@ -16,6 +16,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/metrics/histogram_functions.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/synchronization/atomic_flag.h"
 #include "base/task/bind_post_task.h"
 #include "base/task/sequenced_task_runner.h"
@@ -40,12 +41,20 @@ class UnzipParams : public base::RefCounted<UnzipParams>,
   mojo::Remote<mojom::Unzipper>& unzipper() { return unzipper_; }
 
   void InvokeCallback(bool result) {
-    if (callback_)
+    if (callback_) {
+      base::UmaHistogramBoolean("Unzipper.Unzip.Result", result);
+      if (result)
+        RecordTimeAndThroughput();
+
       std::move(callback_).Run(result);
+    }
 
     unzipper_.reset();
   }
 
+  // Sets the size of the ZIP archive, used to report the unzip throughput.
+  void set_archive_size(int64_t archive_size) { archive_size_ = archive_size; }
+
   void SetFilter(
       mojo::PendingReceiver<unzip::mojom::UnzipFilter> filter_receiver,
       UnzipFilterCallback filter_callback) {
@@ -71,6 +80,16 @@ class UnzipParams : public base::RefCounted<UnzipParams>,
 
   ~UnzipParams() override = default;
 
+  void RecordTimeAndThroughput() {
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start_time_;
+    base::UmaHistogramMediumTimes("Unzipper.Unzip.Time", elapsed);
+    if (archive_size_ > 0 && elapsed.is_positive()) {
+      base::UmaHistogramCounts1M(
+          "Unzipper.Unzip.ThroughputKBPerSecond",
+          base::ClampRound(archive_size_ / 1024.0 / elapsed.InSecondsF()));
+    }
+  }
+
   // unzip::mojom::UnzipFilter implementation:
   void ShouldUnzipFile(const base::FilePath& path,
                        ShouldUnzipFileCallback callback) override {
@@ -92,6 +111,8 @@ class UnzipParams : public base::RefCounted<UnzipParams>,
   mojo::Receiver<unzip::mojom::UnzipListener> listener_receiver_{this};
   UnzipListenerCallback listener_callback_;
   UnzipCallback callback_;
+  const base::TimeTicks start_time_ = base::TimeTicks::Now();
+  int64_t archive_size_ = -1;
 };
 
 namespace {
@@ -219,6 +240,7 @@ void DoUnzip(mojo::PendingRemote<mojom::Unzipper> unzipper,
   // |result_callback|.
   auto unzip_params = base::MakeRefCounted<UnzipParams>(
       std::move(unzipper), std::move(result_callback));
+  unzip_params->set_archive_size(zip_file.GetLength());
 
   mojo::PendingRemote<storage::mojom::Directory> directory_remote;
   mojo::PendingRemote<unzip::mojom::UnzipFilter> filter_remote;
@@ -384,6 +406,7 @@ void DoUnzipWithParams(mojo::PendingRemote<mojom::Unzipper> unzipper,
   // |result_callback|.
   unzip_params = base::MakeRefCounted<UnzipParams>(std::move(unzipper),
                                                    std::move(result_callback));
+  unzip_params->set_archive_size(zip_file.GetLength());
 
   mojo::PendingRemote<storage::mojom::Directory> directory_remote;
   mojo::PendingRemote<unzip::mojom::UnzipFilter> filter_remote;
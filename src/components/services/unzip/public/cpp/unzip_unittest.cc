@@ -15,6 +15,7 @@
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/task_environment.h"
 #include "components/services/unzip/unzipper_impl.h"
 #include "mojo/public/cpp/bindings/receiver_set.h"
@@ -219,6 +220,18 @@ TEST_F(UnzipTest, UnzipGoodArchive) {
   EXPECT_FALSE(some_files_empty);
 }
 
+TEST_F(UnzipTest, UnzipRecordsMetrics) {
+  base::HistogramTester histogram_tester;
+  EXPECT_TRUE(DoUnzip(GetArchivePath("good_archive.zip"), unzip_dir_));
+  histogram_tester.ExpectUniqueSample("Unzipper.Unzip.Result", true, 1);
+  histogram_tester.ExpectTotalCount("Unzipper.Unzip.Time", 1);
+
+  EXPECT_FALSE(DoUnzip(GetArchivePath("bad_archive.zip"), unzip_dir_));
+  histogram_tester.ExpectBucketCount("Unzipper.Unzip.Result", false, 1);
+  // Only successful unzips report their time.
+  histogram_tester.ExpectTotalCount("Unzipper.Unzip.Time", 1);
+}
+
 TEST_F(UnzipTest, UnzipWithFilter) {
   EXPECT_TRUE(DoUnzip(GetArchivePath("good_archive.zip"), unzip_dir_,
                       base::BindRepeating([](const base::FilePath& path) {
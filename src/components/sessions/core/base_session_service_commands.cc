@@ -176,6 +176,16 @@ bool RestoreUpdateTabNavigationCommand(
          navigation->ReadFromPickle(&iterator);
 }
 
+bool RestoreUpdateTabNavigationCommandIndex(const SessionCommand& command,
+                                            SessionID* tab_id,
+                                            int* index) {
+  base::Pickle pickle = command.PayloadAsPickle();
+  base::PickleIterator iterator(pickle);
+
+  // SerializedNavigationEntry::WriteToPickle() writes the index first.
+  return ReadSessionIdFromPickle(&iterator, tab_id) && iterator.ReadInt(index);
+}
+
 bool RestoreSetTabExtensionAppIDCommand(const SessionCommand& command,
                                         SessionID* tab_id,
                                         std::string* extension_app_id) {
@@ -68,6 +68,13 @@ bool RestoreUpdateTabNavigationCommand(
     sessions::SerializedNavigationEntry* navigation,
     SessionID* tab_id);
 
+// Reads the tab id and the navigation index of a SessionCommand previously
+// created by CreateUpdateTabNavigationCommand, without deserializing the rest
+// of the navigation. Returns true on success.
+bool RestoreUpdateTabNavigationCommandIndex(const SessionCommand& command,
+                                            SessionID* tab_id,
+                                            int* index);
+
 // Extracts a SessionCommand as previously created by
 // CreateSetTabExtensionAppIDCommand into the tab id and application
 // extension id.
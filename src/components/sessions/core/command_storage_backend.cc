@@ -17,13 +17,16 @@
 #include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/logging.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/task/sequenced_task_runner.h"
 #include "base/task/single_thread_task_runner.h"
 #include "base/time/default_clock.h"
+#include "base/timer/elapsed_timer.h"
 #include "build/build_config.h"
 #include "components/sessions/core/session_constants.h"
 #include "components/sessions/core/session_service_commands.h"
@@ -57,6 +60,14 @@ BASE_FEATURE(kFlushAfterAppending,
              "SessionStorageFlushAfterAppendingCommands",
              base::FEATURE_DISABLED_BY_DEFAULT);
 
+// Reads session files through a memory mapping, instead of copying them into a
+// buffer a kilobyte at a time. Session files of heavy users are several
+// megabytes, and are read twice on startup: once to find the marker, and once
+// to restore the commands.
+BASE_FEATURE(kMemoryMappedSessionFileReads,
+             "SessionStorageMemoryMappedFileReads",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 // The file header is the first bytes written to the file,
 // and is used to identify the file as one written by us.
 struct FileHeader {
@@ -135,6 +146,10 @@ class SessionFileReader {
     file_ = std::make_unique<base::File>(
         path, base::File::FLAG_OPEN | base::File::FLAG_READ);
     is_header_valid_ = ReadHeader();
+    if (is_header_valid_ &&
+        base::FeatureList::IsEnabled(kMemoryMappedSessionFileReads)) {
+      MapFile();
+    }
   }
 
   // Returns true if the file has a valid header.
@@ -155,8 +170,9 @@ class SessionFileReader {
   bool ReadToMarker();
 
   // Reads a single command. If the command returned in the structure is null,
-  // there are no more commands.
-  ReadResult ReadCommand();
+  // there are no more commands. If `id_only` is true, the contents of the
+  // command may be left out, when that saves copying them.
+  ReadResult ReadCommand(bool id_only = false);
 
   // Decrypts a previously encrypted command. Returns the new command on
   // success.
@@ -173,11 +189,24 @@ class SessionFileReader {
   // couldn't be filled or there was an error reading the file.
   bool FillBuffer();
 
+  // Maps the rest of the file after the header. On success, commands are read
+  // from `mapped_file_` rather than `buffer_`.
+  void MapFile();
+
+  // Returns the data commands are read from.
+  const char* data() const {
+    return mapped_file_ ? reinterpret_cast<const char*>(mapped_file_->data())
+                        : buffer_.data();
+  }
+
   bool is_header_valid_ = false;
 
   // As we read from the file, data goes here.
   std::string buffer_;
 
+  // The whole file, if it could be mapped. `buffer_` is unused in this case.
+  std::unique_ptr<base::MemoryMappedFile> mapped_file_;
+
   const std::vector<uint8_t> crypto_key_;
 
   std::unique_ptr<crypto::Aead> aead_;
@@ -263,15 +292,15 @@ bool SessionFileReader::ReadHeader() {
 bool SessionFileReader::ReadToMarker() {
   // It's expected this is only called if the marker is supported.
   DCHECK(IsHeaderValid() && SupportsMarker());
-  for (ReadResult result = ReadCommand(); result.command;
-       result = ReadCommand()) {
+  for (ReadResult result = ReadCommand(/*id_only=*/true); result.command;
+       result = ReadCommand(/*id_only=*/true)) {
     if (result.command->id() == kInitialStateMarkerCommandId)
       return true;
   }
   return false;
 }
 
-SessionFileReader::ReadResult SessionFileReader::ReadCommand() {
+SessionFileReader::ReadResult SessionFileReader::ReadCommand(bool id_only) {
   SessionFileReader::ReadResult result;
   // Make sure there is enough in the buffer for the size of the next command.
   if (available_count_ < sizeof(size_type)) {
@@ -287,7 +316,7 @@ SessionFileReader::ReadResult SessionFileReader::ReadCommand() {
   }
   // Get the size of the command.
   size_type command_size;
-  memcpy(&command_size, &(buffer_[buffer_position_]), sizeof(command_size));
+  memcpy(&command_size, data() + buffer_position_, sizeof(command_size));
   buffer_position_ += sizeof(command_size);
   available_count_ -= sizeof(command_size);
 
@@ -300,7 +329,7 @@ SessionFileReader::ReadResult SessionFileReader::ReadCommand() {
 
   // Make sure buffer has the complete contents of the command.
   if (command_size > available_count_) {
-    if (command_size > buffer_.size())
+    if (!mapped_file_ && command_size > buffer_.size())
       buffer_.resize((command_size / 1024 + 1) * 1024, 0);
     if (!FillBuffer() || command_size > available_count_) {
       // Again, assume the file was ok, and just the last chunk was lost.
@@ -310,11 +339,12 @@ SessionFileReader::ReadResult SessionFileReader::ReadCommand() {
     }
   }
   if (aead_) {
-    result.command = CreateCommandFromEncrypted(
-        buffer_.c_str() + buffer_position_, command_size);
-  } else {
+    // The id is encrypted with the contents.
     result.command =
-        CreateCommand(buffer_.c_str() + buffer_position_, command_size);
+        CreateCommandFromEncrypted(data() + buffer_position_, command_size);
+  } else {
+    result.command = CreateCommand(data() + buffer_position_,
+                                   id_only ? sizeof(id_type) : command_size);
   }
   ++command_counter_;
   buffer_position_ += command_size;
@@ -367,6 +397,9 @@ std::unique_ptr<sessions::SessionCommand> SessionFileReader::CreateCommand(
 }
 
 bool SessionFileReader::FillBuffer() {
+  // The mapping already holds the whole file.
+  if (mapped_file_)
+    return false;
   if (available_count_ > 0 && buffer_position_ > 0) {
     // Shift buffer to beginning.
     memmove(&(buffer_[0]), &(buffer_[buffer_position_]), available_count_);
@@ -392,6 +425,23 @@ bool SessionFileReader::FillBuffer() {
   return true;
 }
 
+void SessionFileReader::MapFile() {
+  DCHECK(!mapped_file_);
+  DCHECK_EQ(0u, available_count_);
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  // Falls back to buffered reads if the file can't be mapped.
+  if (!mapped_file->Initialize(file_->Duplicate()) ||
+      mapped_file->length() < sizeof(FileHeader)) {
+    return;
+  }
+  mapped_file_ = std::move(mapped_file);
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  buffer_position_ = sizeof(FileHeader);
+  available_count_ = mapped_file_->length() - sizeof(FileHeader);
+  bytes_read_ = static_cast<int>(mapped_file_->length());
+}
+
 base::FilePath::StringType TimestampToString(const base::Time time) {
 #if BUILDFLAG(IS_POSIX) || BUILDFLAG(IS_FUCHSIA)
   return base::NumberToString(time.ToDeltaSinceWindowsEpoch().InMicroseconds());
@@ -602,8 +652,12 @@ CommandStorageBackend::ReadLastSessionCommands() {
     VLOG(1) << "CommandStorageBackend::ReadLastSessionCommands, reading "
                "commands from: "
             << last_session_info_->path;
-    return ReadCommandsFromFile(last_session_info_->path,
-                                initial_decryption_key_);
+    base::ElapsedTimer timer;
+    ReadCommandsResult result =
+        ReadCommandsFromFile(last_session_info_->path, initial_decryption_key_);
+    base::UmaHistogramTimes("Session.ReadLastSessionCommandsTime",
+                            timer.Elapsed());
+    return result;
   }
   return {};
 }
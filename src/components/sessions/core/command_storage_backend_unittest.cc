@@ -9,6 +9,7 @@
 #include <limits>
 #include <utility>
 
+#include "base/files/file.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/functional/bind.h"
@@ -18,6 +19,8 @@
 #include "base/run_loop.h"
 #include "base/strings/string_util.h"
 #include "base/test/bind.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/simple_test_clock.h"
 #include "base/test/task_environment.h"
 #include "base/time/time.h"
@@ -489,6 +492,65 @@ TEST_F(CommandStorageBackendTest, BigDataWithRestoreType) {
             reinterpret_cast<char*>(commands[1]->contents())[big_size - 1]);
 }
 
+TEST_F(CommandStorageBackendTest, MemoryMappedReadsWithRestoreType) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitFromCommandLine("SessionStorageMemoryMappedFileReads", "");
+  struct TestData data[] = {
+      {1, "a"},
+      {2, "ab"},
+      {3, "abc"},
+  };
+
+  // Write the initial state, with a command bigger than the read buffer, then
+  // more commands after it.
+  scoped_refptr<CommandStorageBackend> backend = CreateBackendWithRestoreType();
+  SessionCommands commands;
+  commands.push_back(CreateCommandFromData(data[0]));
+  const SessionCommand::size_type big_size =
+      CommandStorageBackend::kFileReadBufferSize + 100;
+  const SessionCommand::id_type big_id = 50;
+  std::unique_ptr<SessionCommand> big_command =
+      std::make_unique<SessionCommand>(big_id, big_size);
+  reinterpret_cast<char*>(big_command->contents())[big_size - 1] = 'z';
+  commands.push_back(std::move(big_command));
+  backend->AppendCommands(std::move(commands), true, base::DoNothing());
+  commands.clear();
+  commands.push_back(CreateCommandFromData(data[1]));
+  commands.push_back(CreateCommandFromData(data[2]));
+  backend->AppendCommands(std::move(commands), false, base::DoNothing());
+  const base::FilePath path = backend->current_path();
+
+  base::HistogramTester histogram_tester;
+  backend = nullptr;
+  backend = CreateBackendWithRestoreType();
+  CommandStorageBackend::ReadCommandsResult result =
+      backend->ReadLastSessionCommands();
+  EXPECT_FALSE(result.error_reading);
+  ASSERT_EQ(4U, result.commands.size());
+  AssertCommandEqualsData(data[0], result.commands[0].get());
+  EXPECT_EQ(big_id, result.commands[1]->id());
+  ASSERT_EQ(big_size, result.commands[1]->size());
+  const char* big_contents =
+      reinterpret_cast<char*>(result.commands[1]->contents());
+  EXPECT_EQ('z', big_contents[big_size - 1]);
+  AssertCommandEqualsData(data[1], result.commands[2].get());
+  AssertCommandEqualsData(data[2], result.commands[3].get());
+  histogram_tester.ExpectTotalCount("Session.ReadLastSessionCommandsTime", 1);
+
+  // Lose the end of the last command. The commands before it are still read.
+  backend = nullptr;
+  int64_t file_size = 0;
+  ASSERT_TRUE(base::GetFileSize(path, &file_size));
+  base::File file(path, base::File::FLAG_OPEN | base::File::FLAG_WRITE);
+  ASSERT_TRUE(file.SetLength(file_size - 1));
+  file.Close();
+  backend = CreateBackendWithRestoreType();
+  result = backend->ReadLastSessionCommands();
+  EXPECT_TRUE(result.error_reading);
+  ASSERT_EQ(3U, result.commands.size());
+  AssertCommandEqualsData(data[1], result.commands[2].get());
+}
+
 TEST_F(CommandStorageBackendTest, CommandWithRestoreType) {
   scoped_refptr<CommandStorageBackend> backend = CreateBackendWithRestoreType();
   SessionCommands commands;
@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 
+#include <string_view>
 #include <tuple>
 #include <utility>
 
@@ -115,6 +116,26 @@ enum TypeMask {
 
 void SerializedNavigationEntry::WriteToPickle(int max_size,
                                               base::Pickle* pickle) const {
+  const std::string encoded_page_state =
+      SerializedNavigationDriver::Get()->GetSanitizedPageStateForPickle(this);
+
+  // Reserve room for everything below at once, rather than growing the pickle
+  // repeatedly while writing the page state. Strings dropped for exceeding
+  // |max_size| make this an upper bound.
+  size_t reserved_size =
+      9 * sizeof(int) + 4 * sizeof(int64_t) +
+      base::Pickle::GetWriteDataSize(virtual_url_.spec().size()) +
+      base::Pickle::GetWriteDataSize(title_.size() * sizeof(char16_t)) +
+      base::Pickle::GetWriteDataSize(encoded_page_state.size()) +
+      base::Pickle::GetWriteDataSize(referrer_url_.spec().size()) +
+      base::Pickle::GetWriteDataSize(original_request_url_.spec().size()) +
+      base::Pickle::GetWriteDataSize(0);
+  for (const auto& entry : extended_info_map_) {
+    reserved_size += base::Pickle::GetWriteDataSize(entry.first.size()) +
+                     base::Pickle::GetWriteDataSize(entry.second.size());
+  }
+  pickle->Reserve(reserved_size);
+
   pickle->WriteInt(index_);
 
   int bytes_written = 0;
@@ -124,8 +145,6 @@ void SerializedNavigationEntry::WriteToPickle(int max_size,
 
   WriteString16ToPickle(pickle, &bytes_written, max_size, title_);
 
-  const std::string encoded_page_state =
-      SerializedNavigationDriver::Get()->GetSanitizedPageStateForPickle(this);
   WriteStringToPickle(pickle, &bytes_written, max_size, encoded_page_state);
 
   pickle->WriteInt(transition_type_);
@@ -172,10 +191,11 @@ void SerializedNavigationEntry::WriteToPickle(int max_size,
 
 bool SerializedNavigationEntry::ReadFromPickle(base::PickleIterator* iterator) {
   *this = SerializedNavigationEntry();
-  std::string virtual_url_spec;
+  // URL specs are read without copying, as they are parsed into GURLs anyway.
+  std::string_view virtual_url_spec;
   int transition_type_int = 0;
   if (!iterator->ReadInt(&index_) ||
-      !iterator->ReadString(&virtual_url_spec) ||
+      !iterator->ReadStringPiece(&virtual_url_spec) ||
       !iterator->ReadString16(&title_) ||
       !iterator->ReadString(&encoded_page_state_) ||
       !iterator->ReadInt(&transition_type_int))
@@ -197,9 +217,9 @@ bool SerializedNavigationEntry::ReadFromPickle(base::PickleIterator* iterator) {
     has_post_data_ = type_mask & HAS_POST_DATA;
     // the "referrer" property was added after type_mask to the written
     // stream. As such, we don't fail if it can't be read.
-    std::string referrer_spec;
-    if (!iterator->ReadString(&referrer_spec))
-      referrer_spec = std::string();
+    std::string_view referrer_spec;
+    if (!iterator->ReadStringPiece(&referrer_spec))
+      referrer_spec = std::string_view();
     referrer_url_ = GURL(referrer_spec);
 
     // Note: due to crbug.com/450589 the initial referrer policy is incorrect,
@@ -209,9 +229,9 @@ bool SerializedNavigationEntry::ReadFromPickle(base::PickleIterator* iterator) {
     std::ignore = iterator->ReadInt(&ignored_referrer_policy);
 
     // If the original URL can't be found, leave it empty.
-    std::string original_request_url_spec;
-    if (!iterator->ReadString(&original_request_url_spec))
-      original_request_url_spec = std::string();
+    std::string_view original_request_url_spec;
+    if (!iterator->ReadStringPiece(&original_request_url_spec))
+      original_request_url_spec = std::string_view();
     original_request_url_ = GURL(original_request_url_spec);
 
     // Default to not overriding the user agent if we don't have info.
@@ -227,8 +247,8 @@ bool SerializedNavigationEntry::ReadFromPickle(base::PickleIterator* iterator) {
 
     // The |search_terms_| field was removed, but it still exists in the binary
     // format to keep backwards compatibility. Just get rid of it.
-    std::u16string search_terms;
-    std::ignore = iterator->ReadString16(&search_terms);
+    std::u16string_view search_terms;
+    std::ignore = iterator->ReadStringPiece16(&search_terms);
 
     if (!iterator->ReadInt(&http_status_code_))
       http_status_code_ = 0;
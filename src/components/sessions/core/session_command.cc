@@ -18,10 +18,8 @@ SessionCommand::SessionCommand(id_type id, size_type size)
 }
 
 SessionCommand::SessionCommand(id_type id, const base::Pickle& pickle)
-    : id_(id),
-      contents_(pickle.size(), 0) {
+    : id_(id), contents_(pickle.data_as_char(), pickle.size()) {
   DCHECK(pickle.size() < std::numeric_limits<size_type>::max());
-  memcpy(contents(), pickle.data(), pickle.size());
 }
 
 SessionCommand::size_type SessionCommand::GetSerializedSize() const {
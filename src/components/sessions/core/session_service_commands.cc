@@ -15,6 +15,7 @@
 #include "base/containers/flat_set.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
+#include "base/memory/raw_ptr.h"
 #include "base/pickle.h"
 #include "base/token.h"
 #include "base/uuid.h"
@@ -24,6 +25,10 @@
 
 namespace sessions {
 
+BASE_FEATURE(kDeferTabNavigationDecoding,
+             "SessionDeferTabNavigationDecoding",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 // Identifier for commands written to file.
 static const SessionCommand::id_type kCommandSetTabWindow = 0;
 // OBSOLETE Superseded by kCommandSetWindowBounds3.
@@ -286,14 +291,45 @@ SessionTabGroup* GetTabGroup(tab_groups::TabGroupId group_id,
   return it->second.get();
 }
 
+// A navigation of a kCommandUpdateTabNavigation command, which is only
+// deserialized once all the commands are processed, if it is still in its tab
+// then. Most navigations in a long session log are replaced by a later command,
+// pruned, or in a tab that was closed.
+class DeferredNavigation {
+ public:
+  DeferredNavigation(int index, const SessionCommand* command)
+      : index_(index), command_(command) {}
+
+  int index() const { return index_; }
+  void set_index(int index) { index_ = index; }
+
+  // Deserializes the navigation, with the index it has now. Returns false if
+  // the command can't be read.
+  bool Decode(sessions::SerializedNavigationEntry* navigation) const {
+    SessionID tab_id = SessionID::InvalidValue();
+    if (!RestoreUpdateTabNavigationCommand(*command_, navigation, &tab_id))
+      return false;
+    navigation->set_index(index_);
+    return true;
+  }
+
+ private:
+  int index_;
+  // The commands outlive the restore.
+  raw_ptr<const SessionCommand> command_;
+};
+
+using IdToDeferredNavigations =
+    std::map<SessionID, std::vector<DeferredNavigation>>;
+
 // Returns an iterator into navigations pointing to the navigation whose
 // index matches |index|. If no navigation index matches |index|, the first
 // navigation with an index > |index| is returned.
 //
 // This assumes the navigations are ordered by index in ascending order.
-std::vector<sessions::SerializedNavigationEntry>::iterator
-  FindClosestNavigationWithIndex(
-    std::vector<sessions::SerializedNavigationEntry>* navigations,
+template <typename Navigation>
+typename std::vector<Navigation>::iterator FindClosestNavigationWithIndex(
+    std::vector<Navigation>* navigations,
     int index) {
   DCHECK(navigations);
   for (auto i = navigations->begin(); i != navigations->end(); ++i) {
@@ -416,9 +452,28 @@ void AddTabsToWindows(IdToSessionTab* tabs,
   tab_groups->clear();
 }
 
+// Removes the navigations pruned by |payload|, and updates the index of the
+// navigations after them.
+template <typename Navigation>
+void PruneNavigations(const TabNavigationPathPrunedPayload& payload,
+                      std::vector<Navigation>* navigations) {
+  navigations->erase(
+      FindClosestNavigationWithIndex(navigations, payload.index),
+      FindClosestNavigationWithIndex(navigations,
+                                     payload.index + payload.count));
+
+  // And update the index of existing navigations.
+  for (auto& entry : *navigations) {
+    if (entry.index() < payload.index)
+      continue;
+    entry.set_index(entry.index() - payload.count);
+  }
+}
+
 void ProcessTabNavigationPathPrunedCommand(
     TabNavigationPathPrunedPayload& payload,
-    SessionTab* tab) {
+    SessionTab* tab,
+    IdToDeferredNavigations* deferred_navigations) {
   // Update the selected navigation index.
   if (tab->current_navigation_index >= payload.index &&
       tab->current_navigation_index < payload.index + payload.count) {
@@ -428,17 +483,33 @@ void ProcessTabNavigationPathPrunedCommand(
         tab->current_navigation_index - payload.count;
   }  // Else no change if selected index is before payload.index
 
-  tab->navigations.erase(
-      FindClosestNavigationWithIndex(&(tab->navigations), payload.index),
-      FindClosestNavigationWithIndex(&(tab->navigations),
-                                     payload.index + payload.count));
+  if (deferred_navigations)
+    PruneNavigations(payload, &(*deferred_navigations)[tab->tab_id]);
+  else
+    PruneNavigations(payload, &(tab->navigations));
+}
 
-  // And update the index of existing navigations.
-  for (auto& entry : tab->navigations) {
-    if (entry.index() < payload.index)
+// Deserializes the deferred navigations of the tabs in |tabs| that are in a
+// window, the only ones AddTabsToWindows() keeps. A navigation that can't be
+// read is left out of its tab.
+void DecodeDeferredNavigations(IdToDeferredNavigations* deferred_navigations,
+                               IdToSessionTab* tabs) {
+  for (auto& [tab_id, tab] : *tabs) {
+    auto it = deferred_navigations->find(tab_id);
+    if (!tab->window_id.id() || it == deferred_navigations->end())
       continue;
-    entry.set_index(entry.index() - payload.count);
+    DCHECK(tab->navigations.empty());
+    tab->navigations.reserve(it->second.size());
+    for (const DeferredNavigation& deferred_navigation : it->second) {
+      sessions::SerializedNavigationEntry navigation;
+      if (!deferred_navigation.Decode(&navigation)) {
+        DVLOG(1) << "Failed reading deferred navigation";
+        continue;
+      }
+      tab->navigations.push_back(std::move(navigation));
+    }
   }
+  deferred_navigations->clear();
 }
 
 // Creates tabs and windows from the commands specified in |data|. The created
@@ -448,12 +519,16 @@ void ProcessTabNavigationPathPrunedCommand(
 //
 // This does NOT add any created SessionTabs to SessionWindow.tabs, that is
 // done by AddTabsToWindows.
+//
+// If |deferred_navigations| is non-null, the navigations of the tabs are added
+// to it instead of SessionTab.navigations, see DecodeDeferredNavigations().
 void CreateTabsAndWindows(
     const std::vector<std::unique_ptr<SessionCommand>>& data,
     IdToSessionTab* tabs,
     GroupIdToSessionTabGroup* tab_groups,
     IdToSessionWindow* windows,
-    SessionID* active_window_id) {
+    SessionID* active_window_id,
+    IdToDeferredNavigations* deferred_navigations) {
   // If the file is corrupt (command with wrong size, or unknown command), we
   // still return true and attempt to restore what we we can.
   DVLOG(1) << "CreateTabsAndWindows";
@@ -525,10 +600,14 @@ void CreateTabsAndWindows(
           DVLOG(1) << "Failed reading command " << command->id();
           return;
         }
-        if (command->id() == kCommandTabClosed)
-          tabs->erase(SessionID::FromSerializedValue(payload.id));
-        else
+        if (command->id() == kCommandTabClosed) {
+          const SessionID tab_id = SessionID::FromSerializedValue(payload.id);
+          tabs->erase(tab_id);
+          if (deferred_navigations)
+            deferred_navigations->erase(tab_id);
+        } else {
           windows->erase(SessionID::FromSerializedValue(payload.id));
+        }
 
         break;
       }
@@ -542,9 +621,18 @@ void CreateTabsAndWindows(
         SessionTab* tab =
             GetTab(SessionID::FromSerializedValue(payload.id), tabs);
 
-        tab->navigations.erase(
-            FindClosestNavigationWithIndex(&(tab->navigations), payload.index),
-            tab->navigations.end());
+        if (deferred_navigations) {
+          std::vector<DeferredNavigation>& navigations =
+              (*deferred_navigations)[tab->tab_id];
+          navigations.erase(
+              FindClosestNavigationWithIndex(&navigations, payload.index),
+              navigations.end());
+        } else {
+          tab->navigations.erase(
+              FindClosestNavigationWithIndex(&(tab->navigations),
+                                             payload.index),
+              tab->navigations.end());
+        }
         break;
       }
 
@@ -562,7 +650,8 @@ void CreateTabsAndWindows(
         TabNavigationPathPrunedPayload payload;
         payload.index = 0;
         payload.count = prune_front_payload.index;
-        ProcessTabNavigationPathPrunedCommand(payload, tab);
+        ProcessTabNavigationPathPrunedCommand(payload, tab,
+                                              deferred_navigations);
         break;
       }
 
@@ -576,11 +665,30 @@ void CreateTabsAndWindows(
         SessionTab* tab =
             GetTab(SessionID::FromSerializedValue(payload.id), tabs);
 
-        ProcessTabNavigationPathPrunedCommand(payload, tab);
+        ProcessTabNavigationPathPrunedCommand(payload, tab,
+                                              deferred_navigations);
         break;
       }
 
       case kCommandUpdateTabNavigation: {
+        if (deferred_navigations) {
+          SessionID tab_id = SessionID::InvalidValue();
+          int index = 0;
+          if (!RestoreUpdateTabNavigationCommandIndex(*command, &tab_id,
+                                                      &index)) {
+            DVLOG(1) << "Failed reading command " << command->id();
+            return;
+          }
+          SessionTab* tab = GetTab(tab_id, tabs);
+          std::vector<DeferredNavigation>& navigations =
+              (*deferred_navigations)[tab->tab_id];
+          auto i = FindClosestNavigationWithIndex(&navigations, index);
+          if (i != navigations.end() && i->index() == index)
+            *i = DeferredNavigation(index, command);
+          else
+            navigations.insert(i, DeferredNavigation(index, command));
+          break;
+        }
         sessions::SerializedNavigationEntry navigation;
         SessionID tab_id = SessionID::InvalidValue();
         if (!RestoreUpdateTabNavigationCommand(*command,
@@ -1270,8 +1378,15 @@ void RestoreSessionFromCommands(
   IdToSessionWindow windows;
 
   DVLOG(1) << "RestoreSessionFromCommands " << commands.size();
-  CreateTabsAndWindows(commands, &tabs, &tab_groups, &windows,
-                       active_window_id);
+  if (base::FeatureList::IsEnabled(kDeferTabNavigationDecoding)) {
+    IdToDeferredNavigations deferred_navigations;
+    CreateTabsAndWindows(commands, &tabs, &tab_groups, &windows,
+                         active_window_id, &deferred_navigations);
+    DecodeDeferredNavigations(&deferred_navigations, &tabs);
+  } else {
+    CreateTabsAndWindows(commands, &tabs, &tab_groups, &windows,
+                         active_window_id, /*deferred_navigations=*/nullptr);
+  }
   AddTabsToWindows(&tabs, &tab_groups, &windows);
   SortTabsBasedOnVisualOrderAndClear(&windows, valid_windows);
   UpdateSelectedTabIndex(valid_windows);
@@ -10,6 +10,7 @@
 #include <optional>
 #include <string>
 
+#include "base/feature_list.h"
 #include "components/sessions/core/command_storage_manager.h"
 #include "components/sessions/core/session_command.h"
 #include "components/sessions/core/session_types.h"
@@ -22,6 +23,11 @@ namespace sessions {
 
 class SessionCommand;
 
+// When enabled, RestoreSessionFromCommands() only deserializes the navigations
+// that end up in a restored tab, instead of every kCommandUpdateTabNavigation
+// command in the log.
+SESSIONS_EXPORT BASE_DECLARE_FEATURE(kDeferTabNavigationDecoding);
+
 // The following functions create sequentialized change commands which are
 // used to reconstruct the current/previous session state.
 SESSIONS_EXPORT std::unique_ptr<SessionCommand>
@@ -221,6 +221,18 @@ SiteEngagementScore::SiteEngagementScore(base::Clock* clock,
 
 SiteEngagementScore::SiteEngagementScore(SiteEngagementScore&& other) = default;
 
+// static
+mojom::SiteEngagementDetails SiteEngagementScore::GetDetailsFromSettingValue(
+    base::Clock* clock,
+    const GURL& origin,
+    const base::Value& setting_value) {
+  return SiteEngagementScore(clock, origin,
+                             setting_value.is_dict()
+                                 ? setting_value.GetDict().Clone()
+                                 : base::Value::Dict())
+      .GetDetails();
+}
+
 SiteEngagementScore::~SiteEngagementScore() {}
 
 SiteEngagementScore& SiteEngagementScore::operator=(
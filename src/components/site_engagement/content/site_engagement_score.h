@@ -147,6 +147,14 @@ class SiteEngagementScore {
   // values.
   double GetTotalScore() const;
 
+  // Returns the details of the score of |origin| stored as |setting_value| in
+  // the content settings. Used when enumerating all scores, to avoid looking
+  // up the setting of each origin again.
+  static mojom::SiteEngagementDetails GetDetailsFromSettingValue(
+      base::Clock* clock,
+      const GURL& origin,
+      const base::Value& setting_value);
+
   // Returns a structure containing the origin URL and score, and details
   // of the base and bonus scores. Note that the |score| is limited to
   // kMaxPoints, while the detailed scores are returned raw.
@@ -467,4 +467,28 @@ TEST_F(SiteEngagementScoreTest, GetDetails) {
   EXPECT_DOUBLE_EQ(0.0, details.base_score);
 }
 
+// Verify that GetDetailsFromSettingValue reads the score from the setting.
+TEST_F(SiteEngagementScoreTest, GetDetailsFromSettingValue) {
+  test_clock_.SetNow(GetReferenceTime());
+  GURL url("https://www.google.com/");
+
+  base::Value::Dict dict;
+  dict.Set(SiteEngagementScore::kRawScoreKey, 5.);
+  dict.Set(SiteEngagementScore::kLastEngagementTimeKey,
+           static_cast<double>(GetReferenceTime().ToInternalValue()));
+
+  mojom::SiteEngagementDetails details =
+      SiteEngagementScore::GetDetailsFromSettingValue(
+          &test_clock_, url, base::Value(std::move(dict)));
+  EXPECT_EQ(url, details.origin);
+  EXPECT_DOUBLE_EQ(5.0, details.base_score);
+  EXPECT_DOUBLE_EQ(5.0, details.total_score);
+
+  // Settings which are not dictionaries have no score.
+  details = SiteEngagementScore::GetDetailsFromSettingValue(&test_clock_, url,
+                                                            base::Value());
+  EXPECT_EQ(url, details.origin);
+  EXPECT_DOUBLE_EQ(0.0, details.total_score);
+}
+
 }  // namespace site_engagement
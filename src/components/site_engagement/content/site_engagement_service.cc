@@ -7,6 +7,7 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <map>
 #include <utility>
 
 #include "base/functional/bind.h"
@@ -84,21 +85,6 @@ ContentSettingsForOneType GetContentSettingsFromBrowserContext(
       ->GetSettingsForOneType(type);
 }
 
-// Returns the combined list of origins which either have site engagement
-// data stored, or have other settings that would provide a score bonus.
-std::set<GURL> GetEngagementOriginsFromContentSettings(
-    HostContentSettingsMap* map) {
-  std::set<GURL> urls;
-
-  // Fetch URLs of sites with engagement details stored.
-  for (const auto& site :
-       map->GetSettingsForOneType(ContentSettingsType::SITE_ENGAGEMENT)) {
-    urls.insert(GURL(site.primary_pattern.ToString()));
-  }
-
-  return urls;
-}
-
 SiteEngagementScore CreateEngagementScoreImpl(base::Clock* clock,
                                               const GURL& origin,
                                               HostContentSettingsMap* map) {
@@ -131,16 +117,26 @@ std::vector<mojom::SiteEngagementDetails> GetAllDetailsImpl(
     base::Clock* clock,
     HostContentSettingsMap* map,
     SiteEngagementService::URLSets::Type url_set) {
-  std::set<GURL> origins = GetEngagementOriginsFromContentSettings(map);
+  // Read the scores from the enumerated settings rather than looking up the
+  // setting of each origin, which walks all of the rules again. The settings
+  // are ordered by precedence, so the first one of each origin is the one
+  // GetWebsiteSetting() would return.
+  ContentSettingsForOneType settings =
+      map->GetSettingsForOneType(ContentSettingsType::SITE_ENGAGEMENT);
+  std::map<GURL, const base::Value*> origins;
+  for (const auto& site : settings) {
+    origins.emplace(GURL(site.primary_pattern.ToString()), &site.setting_value);
+  }
 
   std::vector<mojom::SiteEngagementDetails> details;
   details.reserve(origins.size());
 
-  for (const GURL& origin : origins) {
+  for (const auto& [origin, setting_value] : origins) {
     if (!origin.is_valid())
       continue;
     if (IsUrlInUrlSet(origin, url_set)) {
-      details.push_back(GetDetailsImpl(clock, origin, map));
+      details.push_back(SiteEngagementScore::GetDetailsFromSettingValue(
+          clock, origin, *setting_value));
     }
   }
 
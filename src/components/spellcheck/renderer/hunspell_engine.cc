@@ -30,6 +30,9 @@ namespace {
   // 24 is the observed limits for OSX system checker.
   const size_t kMaxSuggestLen = 24;
 
+  // Maximum number of words whose spelling is cached.
+  const size_t kCheckedWordsCacheSize = 1000;
+
   static_assert(kMaxCheckedLen <= size_t(MAXWORDLEN),
                 "MaxCheckedLen too long");
   static_assert(kMaxSuggestLen <= kMaxCheckedLen,
@@ -41,7 +44,8 @@ HunspellEngine::HunspellEngine(
     : hunspell_enabled_(false),
       initialized_(false),
       dictionary_requested_(false),
-      embedder_provider_(embedder_provider) {
+      embedder_provider_(embedder_provider),
+      checked_words_(kCheckedWordsCacheSize) {
   // Wait till we check the first word before doing any initializing.
 }
 
@@ -52,6 +56,7 @@ void HunspellEngine::Init(base::File file) {
   initialized_ = true;
   hunspell_.reset();
   bdict_file_.reset();
+  checked_words_.Clear();
   file_ = std::move(file);
   hunspell_enabled_ = file_.IsValid();
   // Delay the actual initialization of hunspell until it is needed.
@@ -83,8 +88,12 @@ bool HunspellEngine::CheckSpelling(const std::u16string& word_to_check,
     // If |hunspell_| is NULL here, an error has occurred, but it's better
     // to check rather than crash.
     if (hunspell_) {
+      auto it = checked_words_.Get(word_to_check_utf8);
+      if (it != checked_words_.end())
+        return it->second;
       // |hunspell_->spell| returns 0 if the word is misspelled.
       word_correct = (hunspell_->spell(word_to_check_utf8) != 0);
+      checked_words_.Put(word_to_check_utf8, word_correct);
     }
   }
 
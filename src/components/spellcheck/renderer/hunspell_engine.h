@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/lru_cache.h"
 #include "base/memory/raw_ptr.h"
 #include "base/strings/utf_string_conversions.h"
 #include "components/spellcheck/common/spellcheck_common.h"
@@ -63,6 +64,11 @@ class HunspellEngine : public SpellingEngine {
   bool dictionary_requested_;
 
   raw_ptr<service_manager::LocalInterfaceProvider> embedder_provider_;
+
+  // Results of |hunspell_->spell| for recently checked words, since the same
+  // words are checked again whenever text is edited. Cleared with the
+  // dictionary.
+  base::HashingLRUCache<std::string, bool> checked_words_;
 };
 
 #endif  // COMPONENTS_SPELLCHECK_RENDERER_HUNSPELL_ENGINE_H_
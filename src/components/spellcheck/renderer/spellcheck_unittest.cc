@@ -1509,6 +1509,17 @@ TEST_F(SpellCheckTest, SpellingEngine_CheckSpelling) {
   }
 }
 
+TEST_F(SpellCheckTest, RepeatedChecksReturnSameResult) {
+  InitializeIfNeeded();
+  ASSERT_FALSE(InitializeIfNeeded());
+
+  // The second check of each word is answered from the cache.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_TRUE(CheckSpelling("hello"));
+    EXPECT_FALSE(CheckSpelling("forglobantic"));
+  }
+}
+
 // Chrome should not suggest "Othello" for "hellllo" or "identically" for
 // "accidently".
 TEST_F(SpellCheckTest, LogicalSuggestions) {
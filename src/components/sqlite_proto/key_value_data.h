@@ -116,6 +116,13 @@ class KeyValueData {
 
   enum class DeferredOperation { kUpdate, kDelete };
 
+  // Writes the updates, then the deletes, of a flush to `backend_table`.
+  static void WriteDeferredUpdates(
+      base::WeakPtr<KeyValueTable<T>> backend_table,
+      std::vector<std::pair<std::string, T>> updates,
+      std::vector<std::string> keys_to_delete,
+      sql::Database* db);
+
   scoped_refptr<TableManager> manager_;
   base::WeakPtr<KeyValueTable<T>> backend_table_;
   std::unique_ptr<std::map<std::string, T>> data_cache_;
@@ -239,17 +246,15 @@ void KeyValueData<T, Compare>::FlushDataToDisk() {
   if (deferred_updates_.empty())
     return;
 
+  std::vector<std::pair<std::string, T>> updates;
   std::vector<std::string> keys_to_delete;
   for (const auto& entry : deferred_updates_) {
     const std::string& key = entry.first;
     switch (entry.second) {
       case DeferredOperation::kUpdate: {
         auto it = data_cache_->find(key);
-        if (it != data_cache_->end()) {
-          manager_->ScheduleDBTask(
-              FROM_HERE, base::BindOnce(&KeyValueTable<T>::UpdateData,
-                                        backend_table_, key, it->second));
-        }
+        if (it != data_cache_->end())
+          updates.emplace_back(key, it->second);
         break;
       }
       case DeferredOperation::kDelete:
@@ -257,15 +262,33 @@ void KeyValueData<T, Compare>::FlushDataToDisk() {
     }
   }
 
-  if (!keys_to_delete.empty()) {
-    manager_->ScheduleDBTask(
-        FROM_HERE, base::BindOnce(&KeyValueTable<T>::DeleteData, backend_table_,
-                                  keys_to_delete));
-  }
+  // The whole flush is written in the transaction of the manager's next group
+  // commit, along with the flushes of the other tables.
+  const size_t row_count = updates.size() + keys_to_delete.size();
+  manager_->ScheduleGroupedDBTask(
+      FROM_HERE,
+      base::BindOnce(&KeyValueData::WriteDeferredUpdates, backend_table_,
+                     std::move(updates), std::move(keys_to_delete)),
+      row_count);
 
   deferred_updates_.clear();
 }
 
+// static
+template <typename T, typename Compare>
+void KeyValueData<T, Compare>::WriteDeferredUpdates(
+    base::WeakPtr<KeyValueTable<T>> backend_table,
+    std::vector<std::pair<std::string, T>> updates,
+    std::vector<std::string> keys_to_delete,
+    sql::Database* db) {
+  if (!backend_table)
+    return;
+  for (const auto& [key, data] : updates)
+    backend_table->UpdateData(key, data, db);
+  if (!keys_to_delete.empty())
+    backend_table->DeleteData(keys_to_delete, db);
+}
+
 template <typename T, typename Compare>
 void KeyValueData<T, Compare>::FlushDataToDisk(base::OnceClosure on_done) {
   FlushDataToDisk();
@@ -24,8 +24,9 @@ const char kCreateProtoTableStatementTemplate[] =
 }  // namespace
 
 ProtoTableManager::ProtoTableManager(
-    scoped_refptr<base::SequencedTaskRunner> db_task_runner)
-    : TableManager(db_task_runner) {}
+    scoped_refptr<base::SequencedTaskRunner> db_task_runner,
+    base::TimeDelta group_commit_window)
+    : TableManager(db_task_runner, group_commit_window) {}
 
 ProtoTableManager::~ProtoTableManager() = default;
 
@@ -12,6 +12,7 @@
 #include "base/containers/span.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
 #include "components/sqlite_proto/table_manager.h"
 
 namespace sqlite_proto {
@@ -33,9 +34,12 @@ namespace sqlite_proto {
 class ProtoTableManager : public TableManager {
  public:
   // Constructor. |db_task_runner| must run tasks on the
-  // sequence that subsequently calls |InitializeOnDbSequence|.
+  // sequence that subsequently calls |InitializeOnDbSequence|. The writes of
+  // the KeyValueData instances on the tables are committed together, at most
+  // |group_commit_window| after the first of them.
   explicit ProtoTableManager(
-      scoped_refptr<base::SequencedTaskRunner> db_task_runner);
+      scoped_refptr<base::SequencedTaskRunner> db_task_runner,
+      base::TimeDelta group_commit_window = base::TimeDelta());
 
   // Initialization:
   // - |table_names| specifies the names of the tables to initialize.
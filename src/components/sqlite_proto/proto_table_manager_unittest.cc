@@ -4,11 +4,14 @@
 
 #include "components/sqlite_proto/proto_table_manager.h"
 
+#include <map>
+#include <string>
 #include <vector>
 
 #include "base/memory/scoped_refptr.h"
 #include "base/strings/strcat.h"
 #include "base/task/single_thread_task_runner.h"
+#include "base/test/metrics/histogram_tester.h"
 #include "base/test/task_environment.h"
 #include "components/sqlite_proto/key_value_data.h"
 #include "components/sqlite_proto/key_value_table.h"
@@ -32,6 +35,7 @@ MATCHER_P(EqualsProto,
 }
 
 constexpr char kTableName[] = "my_table";
+constexpr char kOtherTableName[] = "my_other_table";
 }  // namespace
 
 TEST(ProtoTableTest, PutReinitializeAndGet) {
@@ -269,4 +273,61 @@ TEST(ProtoTableTest, LoadingUnexpectedlyLargeVersionClearsTables) {
   }
 }
 
+TEST(ProtoTableTest, GroupCommitsWritesToAllTables) {
+  base::test::TaskEnvironment env(
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME);
+  base::HistogramTester histogram_tester;
+  sql::Database db;
+  CHECK(db.OpenInMemory());
+
+  constexpr base::TimeDelta kWindow = base::Seconds(1);
+  auto manager = base::MakeRefCounted<ProtoTableManager>(
+      base::SingleThreadTaskRunner::GetCurrentDefault(), kWindow);
+  manager->InitializeOnDbSequence(
+      &db, std::vector<std::string>{kTableName, kOtherTableName},
+      /*schema_version=*/1);
+
+  KeyValueTable<TestProto> table(kTableName);
+  KeyValueTable<TestProto> other_table(kOtherTableName);
+  KeyValueData<TestProto> data(manager, &table,
+                               /*max_num_entries=*/std::nullopt,
+                               /*flush_delay=*/base::TimeDelta());
+  KeyValueData<TestProto> other_data(manager, &other_table,
+                                     /*max_num_entries=*/std::nullopt,
+                                     /*flush_delay=*/base::TimeDelta());
+  // In these tests, we're using the current thread as the DB sequence.
+  data.InitializeOnDBSequence();
+  other_data.InitializeOnDBSequence();
+
+  TestProto entry;
+  entry.set_value(1);
+  data.UpdateData("a", entry);
+  data.UpdateData("b", entry);
+  other_data.UpdateData("c", entry);
+
+  // The writes wait for the end of the window, then are committed together.
+  env.FastForwardBy(kWindow / 2);
+  std::map<std::string, TestProto> stored;
+  table.GetAllData(&stored, &db);
+  EXPECT_TRUE(stored.empty());
+  histogram_tester.ExpectTotalCount("SqliteProto.GroupCommit.RowCount", 0);
+
+  env.FastForwardBy(kWindow / 2);
+  table.GetAllData(&stored, &db);
+  EXPECT_EQ(stored.size(), 2u);
+  stored.clear();
+  other_table.GetAllData(&stored, &db);
+  EXPECT_EQ(stored.size(), 1u);
+  histogram_tester.ExpectUniqueSample("SqliteProto.GroupCommit.RowCount", 3,
+                                      1);
+
+  // Other tasks commit the pending writes first, so they run in order.
+  data.UpdateData("d", entry);
+  data.DeleteAllData();
+  env.RunUntilIdle();
+  stored.clear();
+  table.GetAllData(&stored, &db);
+  EXPECT_TRUE(stored.empty());
+}
+
 }  // namespace sqlite_proto
@@ -4,17 +4,39 @@
 
 #include "components/sqlite_proto/table_manager.h"
 
+#include <optional>
 #include <utility>
 
 #include "base/check.h"
 #include "base/functional/bind.h"
+#include "base/location.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/task/sequenced_task_runner.h"
 #include "sql/database.h"
+#include "sql/transaction.h"
 
 namespace sqlite_proto {
 
 using DBTask = base::OnceCallback<void(sql::Database*)>;
 
+namespace {
+
+void RunDBTasksInTransaction(std::vector<DBTask> tasks, sql::Database* db) {
+  // Subclasses may run the tasks without a database, e.g. in tests.
+  std::optional<sql::Transaction> transaction;
+  if (db) {
+    transaction.emplace(db);
+    if (!transaction->Begin())
+      transaction.reset();
+  }
+  for (DBTask& task : tasks)
+    std::move(task).Run(db);
+  if (transaction)
+    transaction->Commit();
+}
+
+}  // namespace
+
 base::SequencedTaskRunner* TableManager::GetTaskRunner() {
   return db_task_runner_.get();
 }
@@ -36,8 +58,18 @@ void TableManager::ScheduleDBTaskWithReply(const base::Location& from_here,
       std::move(reply));
 }
 
+void TableManager::ScheduleGroupedDBTask(const base::Location& from_here,
+                                         DBTask task,
+                                         size_t row_count) {
+  GetTaskRunner()->PostTask(
+      from_here, base::BindOnce(&TableManager::AddGroupedDBTaskOnDBSequence,
+                                this, std::move(task), row_count));
+}
+
 void TableManager::ExecuteDBTaskOnDBSequence(DBTask task) {
   DCHECK(GetTaskRunner()->RunsTasksInCurrentSequence());
+  // The grouped tasks were scheduled first.
+  CommitGroupedDBTasks();
   if (CantAccessDatabase())
     return;
 
@@ -45,8 +77,11 @@ void TableManager::ExecuteDBTaskOnDBSequence(DBTask task) {
 }
 
 TableManager::TableManager(
-    scoped_refptr<base::SequencedTaskRunner> db_task_runner)
-    : db_task_runner_(std::move(db_task_runner)), db_(nullptr) {}
+    scoped_refptr<base::SequencedTaskRunner> db_task_runner,
+    base::TimeDelta group_commit_window)
+    : db_task_runner_(std::move(db_task_runner)),
+      db_(nullptr),
+      group_commit_window_(group_commit_window) {}
 
 TableManager::~TableManager() = default;
 
@@ -71,6 +106,7 @@ sql::Database* TableManager::DB() {
 
 void TableManager::ResetDB() {
   DCHECK(db_task_runner_->RunsTasksInCurrentSequence());
+  CommitGroupedDBTasks();
   db_ = nullptr;
 }
 
@@ -79,4 +115,32 @@ bool TableManager::CantAccessDatabase() {
   return cancelled_.IsSet() || !db_;
 }
 
+void TableManager::AddGroupedDBTaskOnDBSequence(DBTask task,
+                                                size_t row_count) {
+  DCHECK(db_task_runner_->RunsTasksInCurrentSequence());
+  grouped_tasks_.push_back(std::move(task));
+  grouped_row_count_ += row_count;
+  // The first task of a group bounds the latency of the whole group.
+  if (grouped_tasks_.size() == 1) {
+    db_task_runner_->PostDelayedTask(
+        FROM_HERE, base::BindOnce(&TableManager::CommitGroupedDBTasks, this),
+        group_commit_window_);
+  }
+}
+
+void TableManager::CommitGroupedDBTasks() {
+  DCHECK(db_task_runner_->RunsTasksInCurrentSequence());
+  if (grouped_tasks_.empty())
+    return;
+
+  std::vector<DBTask> tasks = std::move(grouped_tasks_);
+  grouped_tasks_.clear();
+  const size_t row_count = grouped_row_count_;
+  grouped_row_count_ = 0;
+  base::UmaHistogramCounts1000("SqliteProto.GroupCommit.RowCount",
+                               static_cast<int>(row_count));
+  ExecuteDBTaskOnDBSequence(
+      base::BindOnce(&RunDBTasksInTransaction, std::move(tasks)));
+}
+
 }  // namespace sqlite_proto
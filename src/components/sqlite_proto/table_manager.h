@@ -5,10 +5,15 @@
 #ifndef COMPONENTS_SQLITE_PROTO_TABLE_MANAGER_H_
 #define COMPONENTS_SQLITE_PROTO_TABLE_MANAGER_H_
 
+#include <stddef.h>
+
+#include <vector>
+
 #include "base/functional/callback.h"
 #include "base/memory/raw_ptr.h"
 #include "base/memory/ref_counted.h"
 #include "base/synchronization/atomic_flag.h"
+#include "base/time/time.h"
 
 namespace base {
 class Location;
@@ -29,6 +34,12 @@ namespace sqlite_proto {
 // thread in the browser process) but all database related functions need to
 // happen in the database sequence. The task runner for this sequence is
 // provided by the client to the constructor of this class.
+//
+// Writes can be grouped: the tasks scheduled with ScheduleGroupedDBTask(),
+// e.g. by all the KeyValueData instances flushing to the tables of this
+// manager, run in a single transaction at most `group_commit_window` after the
+// first of them. Any other task commits the pending group first, so the tasks
+// still run in the order they were scheduled.
 class TableManager : public base::RefCountedThreadSafe<TableManager> {
  public:
   // Returns a SequencedTaskRunner that is used to run tasks on the DB sequence.
@@ -44,12 +55,19 @@ class TableManager : public base::RefCountedThreadSafe<TableManager> {
       base::OnceCallback<void(sql::Database*)> task,
       base::OnceClosure reply);
 
+  // Schedules `task`, which writes `row_count` rows, to run along with the
+  // other grouped tasks in a single transaction.
+  void ScheduleGroupedDBTask(const base::Location& from_here,
+                             base::OnceCallback<void(sql::Database*)> task,
+                             size_t row_count);
+
   virtual void ExecuteDBTaskOnDBSequence(
       base::OnceCallback<void(sql::Database*)> task);
 
  protected:
   explicit TableManager(
-      scoped_refptr<base::SequencedTaskRunner> db_task_runner);
+      scoped_refptr<base::SequencedTaskRunner> db_task_runner,
+      base::TimeDelta group_commit_window = base::TimeDelta());
   virtual ~TableManager();
 
   // DB sequence functions.
@@ -68,12 +86,24 @@ class TableManager : public base::RefCountedThreadSafe<TableManager> {
   bool CantAccessDatabase();
 
  private:
+  // DB sequence functions.
+  void AddGroupedDBTaskOnDBSequence(
+      base::OnceCallback<void(sql::Database*)> task,
+      size_t row_count);
+  // Runs the pending grouped tasks, if any, in a single transaction.
+  void CommitGroupedDBTasks();
+
   base::AtomicFlag cancelled_;
 
   friend class base::RefCountedThreadSafe<TableManager>;
 
   scoped_refptr<base::SequencedTaskRunner> db_task_runner_;
   raw_ptr<sql::Database, AcrossTasksDanglingUntriaged> db_;
+
+  const base::TimeDelta group_commit_window_;
+  // Accessed on the DB sequence only.
+  std::vector<base::OnceCallback<void(sql::Database*)>> grouped_tasks_;
+  size_t grouped_row_count_ = 0;
 };
 
 }  // namespace sqlite_proto
@@ -228,15 +228,10 @@ AsyncDocumentSubresourceFilter::Core::~Core() {
 
 std::vector<LoadPolicy> AsyncDocumentSubresourceFilter::Core::GetLoadPolicies(
     const std::vector<GURL>& urls) {
-  std::vector<LoadPolicy> policies;
-  for (const auto& url : urls) {
-    auto policy =
-        filter() ? filter()->GetLoadPolicy(
-                       url, url_pattern_index::proto::ELEMENT_TYPE_SUBDOCUMENT)
-                 : LoadPolicy::ALLOW;
-    policies.push_back(policy);
-  }
-  return policies;
+  if (!filter())
+    return std::vector<LoadPolicy>(urls.size(), LoadPolicy::ALLOW);
+  return filter()->GetLoadPolicies(
+      urls, url_pattern_index::proto::ELEMENT_TYPE_SUBDOCUMENT);
 }
 
 void AsyncDocumentSubresourceFilter::Core::SetActivationState(
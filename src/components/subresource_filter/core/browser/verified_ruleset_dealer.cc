@@ -8,6 +8,7 @@
 
 #include "base/check.h"
 #include "base/files/file.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback_helpers.h"
 #include "base/location.h"
@@ -61,8 +62,12 @@ scoped_refptr<const MemoryMappedRuleset> VerifiedRulesetDealer::GetRuleset() {
     case RulesetVerificationStatus::kNotVerified: {
       auto ruleset = RulesetDealer::GetRuleset();
       if (ruleset) {
-        if (IndexedRulesetMatcher::Verify(ruleset->data(),
-                                          expected_checksum_)) {
+        // Verification reads the whole ruleset in order, unlike lookups.
+        ruleset->Advise(base::MemoryMappedFile::Advice::kSequential);
+        const bool verified =
+            IndexedRulesetMatcher::Verify(ruleset->data(), expected_checksum_);
+        ruleset->Advise(base::MemoryMappedFile::Advice::kRandom);
+        if (verified) {
           status_ = RulesetVerificationStatus::kIntact;
         } else {
           status_ = RulesetVerificationStatus::kCorrupt;
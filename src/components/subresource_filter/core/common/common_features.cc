@@ -8,6 +8,10 @@ namespace subresource_filter {
 
 BASE_FEATURE(kAdTagging, "AdTagging", base::FEATURE_ENABLED_BY_DEFAULT);
 
+BASE_FEATURE(kNGramFastReject,
+             "SubresourceFilterNGramFastReject",
+             base::FEATURE_ENABLED_BY_DEFAULT);
+
 BASE_FEATURE(kTPCDAdHeuristicSubframeRequestTagging,
              "TPCDAdHeuristicSubframeRequestTagging",
              base::FEATURE_DISABLED_BY_DEFAULT);
@@ -22,6 +22,10 @@ BASE_DECLARE_FEATURE(kDelayUnsafeAds);
 // start.
 BASE_DECLARE_FEATURE(kTPCDAdHeuristicSubframeRequestTagging);
 
+// Enables checking subresource URLs against a Bloom filter of the n-grams of
+// the blocklist rules, before looking them up in the indexed ruleset.
+BASE_DECLARE_FEATURE(kNGramFastReject);
+
 // Param which governs how much to delay non-secure (i.e. http) subresources for
 // DelayUnsafeAds.
 extern const char kInsecureDelayParam[];
@@ -4,17 +4,21 @@
 
 #include "components/subresource_filter/core/common/document_subresource_filter.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
 #include "base/check.h"
 #include "base/check_op.h"
+#include "base/feature_list.h"
 #include "base/not_fatal_until.h"
 #include "base/trace_event/trace_event.h"
+#include "components/subresource_filter/core/common/common_features.h"
 #include "components/subresource_filter/core/common/first_party_origin.h"
 #include "components/subresource_filter/core/common/memory_mapped_ruleset.h"
 #include "components/subresource_filter/core/common/scoped_timers.h"
 #include "components/subresource_filter/core/common/time_measurements.h"
+#include "components/subresource_filter/core/common/url_rule_ngram_filter.h"
 #include "url/gurl.h"
 #include "url/origin.h"
 
@@ -32,6 +36,8 @@ DocumentSubresourceFilter::DocumentSubresourceFilter(
   if (!activation_state_.filtering_disabled_for_document) {
     document_origin_ =
         std::make_unique<FirstPartyOrigin>(std::move(document_origin));
+    if (base::FeatureList::IsEnabled(kNGramFastReject))
+      blocklist_filter_ = &ruleset_->GetBlocklistFilter();
   }
 }
 
@@ -68,11 +74,78 @@ LoadPolicy DocumentSubresourceFilter::GetLoadPolicy(
             "SubresourceFilter.SubresourceLoad.Evaluation.CPUDuration", delta);
       });
 
+  return EvaluateLoadPolicy(subresource_url, subresource_type);
+}
+
+std::vector<LoadPolicy> DocumentSubresourceFilter::GetLoadPolicies(
+    base::span<const GURL> subresource_urls,
+    url_pattern_index::proto::ElementType subresource_type) {
+  TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("loading"),
+               "DocumentSubresourceFilter::GetLoadPolicies", "count",
+               subresource_urls.size());
+
+  statistics_.num_loads_total += subresource_urls.size();
+  std::vector<LoadPolicy> policies(subresource_urls.size(), LoadPolicy::ALLOW);
+  if (activation_state_.filtering_disabled_for_document)
+    return policies;
+
+  std::vector<size_t> order;
+  order.reserve(subresource_urls.size());
+  for (size_t i = 0; i < subresource_urls.size(); ++i) {
+    if (!subresource_urls[i].SchemeIs(url::kDataScheme))
+      order.push_back(i);
+  }
+  if (order.empty())
+    return policies;
+
+  // Evaluating the URLs of a host one after the other hits the one-entry cache
+  // of FirstPartyOrigin, and the parts of the ruleset that match that host.
+  std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    return subresource_urls[lhs].host_piece() <
+           subresource_urls[rhs].host_piece();
+  });
+
+  // Each URL is reported with the average duration of the batch, so that the
+  // histograms have one sample per load, as with GetLoadPolicy().
+  const size_t count = order.size();
+  auto wall_duration_timer = ScopedTimers::StartIf(
+      activation_state_.measure_performance &&
+          ScopedThreadTimers::IsSupported(),
+      [this, count](base::TimeDelta delta) {
+        statistics_.evaluation_total_wall_duration += delta;
+        for (size_t i = 0; i < count; ++i) {
+          UMA_HISTOGRAM_MICRO_TIMES(
+              "SubresourceFilter.SubresourceLoad.Evaluation.WallDuration",
+              delta / count);
+        }
+      });
+  auto cpu_duration_timer = ScopedThreadTimers::StartIf(
+      activation_state_.measure_performance,
+      [this, count](base::TimeDelta delta) {
+        statistics_.evaluation_total_cpu_duration += delta;
+        for (size_t i = 0; i < count; ++i) {
+          UMA_HISTOGRAM_MICRO_TIMES(
+              "SubresourceFilter.SubresourceLoad.Evaluation.CPUDuration",
+              delta / count);
+        }
+      });
+
+  for (size_t i : order)
+    policies[i] = EvaluateLoadPolicy(subresource_urls[i], subresource_type);
+  return policies;
+}
+
+LoadPolicy DocumentSubresourceFilter::EvaluateLoadPolicy(
+    const GURL& subresource_url,
+    url_pattern_index::proto::ElementType subresource_type) {
   ++statistics_.num_loads_evaluated;
   CHECK(document_origin_, base::NotFatalUntil::M129);
-  LoadPolicy result = ruleset_matcher_.GetLoadPolicyForResourceLoad(
-      subresource_url, *document_origin_, subresource_type,
-      activation_state_.generic_blocking_rules_disabled);
+  LoadPolicy result =
+      CanSkipRulesetLookup(subresource_url, subresource_type)
+          ? LoadPolicy::ALLOW
+          : ruleset_matcher_.GetLoadPolicyForResourceLoad(
+                subresource_url, *document_origin_, subresource_type,
+                activation_state_.generic_blocking_rules_disabled);
   CHECK_NE(LoadPolicy::WOULD_DISALLOW, result, base::NotFatalUntil::M129);
   if (result == LoadPolicy::DISALLOW) {
     ++statistics_.num_loads_matching_rules;
@@ -96,10 +169,24 @@ DocumentSubresourceFilter::FindMatchingUrlRule(
     return nullptr;
   if (subresource_url.SchemeIs(url::kDataScheme))
     return nullptr;
+  if (CanSkipRulesetLookup(subresource_url, subresource_type))
+    return nullptr;
 
   return ruleset_matcher_.MatchedUrlRule(
       subresource_url, *document_origin_, subresource_type,
       activation_state_.generic_blocking_rules_disabled);
 }
 
+bool DocumentSubresourceFilter::CanSkipRulesetLookup(
+    const GURL& subresource_url,
+    url_pattern_index::proto::ElementType subresource_type) const {
+  // Subdocuments are checked against the allowlist even if they match no
+  // blocklist rule, see IndexedRulesetMatcher::MatchedUrlRule().
+  if (!blocklist_filter_ ||
+      subresource_type == url_pattern_index::proto::ELEMENT_TYPE_SUBDOCUMENT) {
+    return false;
+  }
+  return !blocklist_filter_->MayMatch(subresource_url);
+}
+
 }  // namespace subresource_filter
@@ -5,6 +5,7 @@
 #include "components/subresource_filter/core/common/document_subresource_filter.h"
 
 #include <string_view>
+#include <vector>
 
 #include "base/files/file.h"
 #include "components/subresource_filter/core/common/memory_mapped_ruleset.h"
@@ -154,6 +155,29 @@ TEST_F(DocumentSubresourceFilterTest, Enabled) {
   test_impl(false /* measure_performance */);
 }
 
+TEST_F(DocumentSubresourceFilterTest, GetLoadPolicies) {
+  mojom::ActivationState activation_state;
+  activation_state.activation_level = kEnabled;
+  activation_state.measure_performance = true;
+  DocumentSubresourceFilter filter(url::Origin(), activation_state, ruleset());
+
+  const GURL urls[] = {GURL(kTestAlphaURL), GURL("http://other.com/beta"),
+                       GURL(kTestAlphaDataURI), GURL(kTestBetaURL),
+                       GURL("http://other.com/alpha")};
+  EXPECT_EQ(std::vector<LoadPolicy>({LoadPolicy::DISALLOW, LoadPolicy::ALLOW,
+                                     LoadPolicy::ALLOW, LoadPolicy::ALLOW,
+                                     LoadPolicy::DISALLOW}),
+            filter.GetLoadPolicies(urls, kImageType));
+
+  const auto& statistics = filter.statistics();
+  EXPECT_EQ(5, statistics.num_loads_total);
+  EXPECT_EQ(4, statistics.num_loads_evaluated);
+  EXPECT_EQ(2, statistics.num_loads_matching_rules);
+  EXPECT_EQ(2, statistics.num_loads_disallowed);
+
+  EXPECT_TRUE(filter.GetLoadPolicies({}, kImageType).empty());
+}
+
 TEST_F(DocumentSubresourceFilterTest, MatchingRuleEnabled) {
   mojom::ActivationState activation_state;
   activation_state.activation_level = kEnabled;
@@ -10,6 +10,7 @@
 #include "base/not_fatal_until.h"
 #include "base/trace_event/trace_event.h"
 #include "components/subresource_filter/core/common/first_party_origin.h"
+#include "components/subresource_filter/core/common/url_rule_ngram_filter.h"
 #include "url/gurl.h"
 #include "url/origin.h"
 
@@ -123,6 +124,13 @@ bool IndexedRulesetMatcher::Verify(base::span<const uint8_t> buffer,
          status == VerifyStatus::kPassChecksumZero;
 }
 
+// static
+std::unique_ptr<UrlRuleNGramFilter>
+IndexedRulesetMatcher::CreateBlocklistFilter(base::span<const uint8_t> buffer) {
+  return std::make_unique<UrlRuleNGramFilter>(
+      flat::GetIndexedRuleset(buffer.data())->blocklist_index());
+}
+
 IndexedRulesetMatcher::IndexedRulesetMatcher(base::span<const uint8_t> buffer)
     : root_(flat::GetIndexedRuleset(buffer.data())),
       blocklist_(root_->blocklist_index()),
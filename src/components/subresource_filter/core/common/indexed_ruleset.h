@@ -8,6 +8,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
+
 #include "base/compiler_specific.h"
 #include "base/containers/span.h"
 #include "base/memory/raw_ptr.h"
@@ -33,6 +35,7 @@ class UrlRule;
 namespace subresource_filter {
 
 class FirstPartyOrigin;
+class UrlRuleNGramFilter;
 
 // Detailed result of IndexedRulesetMatcher::Verify.
 // Note: Logged to UMA, keep in sync with SubresourceFilterVerifyStatus in
@@ -104,6 +107,11 @@ class IndexedRulesetMatcher {
   // flat::IndexedRuleset FlatBuffer.
   static bool Verify(base::span<const uint8_t> buffer, int expected_checksum);
 
+  // Returns a filter that rejects most URLs that match no blocklist rule of the
+  // flat::IndexedRuleset in |buffer|, which must be verified.
+  static std::unique_ptr<UrlRuleNGramFilter> CreateBlocklistFilter(
+      base::span<const uint8_t> buffer);
+
   // Creates an instance that matches URLs against the flat::IndexedRuleset
   // provided as the root object of serialized data in the |buffer|.
   explicit IndexedRulesetMatcher(base::span<const uint8_t> buffer);
@@ -8,6 +8,8 @@
 
 #include "base/check.h"
 #include "base/not_fatal_until.h"
+#include "components/subresource_filter/core/common/indexed_ruleset.h"
+#include "components/subresource_filter/core/common/url_rule_ngram_filter.h"
 
 namespace subresource_filter {
 
@@ -33,7 +35,19 @@ void MemoryMappedRuleset::SetMemoryMapFailuresForTesting(bool fail) {
   g_fail_memory_map_initialization_for_testing = fail;
 }
 
-MemoryMappedRuleset::MemoryMappedRuleset() = default;
+MemoryMappedRuleset::MemoryMappedRuleset() {
+  // The ruleset is used on the sequence of the first GetBlocklistFilter() call,
+  // which need not be the one that maps it.
+  DETACH_FROM_SEQUENCE(sequence_checker_);
+}
+
 MemoryMappedRuleset::~MemoryMappedRuleset() = default;
 
+const UrlRuleNGramFilter& MemoryMappedRuleset::GetBlocklistFilter() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!blocklist_filter_)
+    blocklist_filter_ = IndexedRulesetMatcher::CreateBlocklistFilter(data());
+  return *blocklist_filter_;
+}
+
 }  // namespace subresource_filter
@@ -8,15 +8,20 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
+
 #include "base/files/file.h"
 #include "base/files/memory_mapped_file.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/sequence_checker.h"
 #include "third_party/abseil-cpp/absl/base/attributes.h"
 
 namespace subresource_filter {
 
+class UrlRuleNGramFilter;
+
 // A reference-counted wrapper around base::MemoryMappedFile. The |ruleset_file|
 // supplied in the constructor is kept memory-mapped and is safe to access until
 // the last reference to this instance is dropped.
@@ -35,6 +40,17 @@ class MemoryMappedRuleset final : public base::RefCounted<MemoryMappedRuleset> {
     return ruleset_.bytes();
   }
 
+  // Hints how the ruleset is going to be accessed, see
+  // base::MemoryMappedFile::Advise().
+  void Advise(base::MemoryMappedFile::Advice advice) const {
+    ruleset_.Advise(advice);
+  }
+
+  // Returns a filter that rejects most URLs that match no blocklist rule of the
+  // indexed ruleset, which must have been verified. The filter is built on the
+  // first call, and shared by all the users of the ruleset afterwards.
+  const UrlRuleNGramFilter& GetBlocklistFilter() const;
+
   base::WeakPtr<MemoryMappedRuleset> AsWeakPtr() {
     return weak_ptr_factory_.GetWeakPtr();
   }
@@ -45,6 +61,11 @@ class MemoryMappedRuleset final : public base::RefCounted<MemoryMappedRuleset> {
   ~MemoryMappedRuleset();
 
   base::MemoryMappedFile ruleset_;
+
+  mutable std::unique_ptr<UrlRuleNGramFilter> blocklist_filter_
+      GUARDED_BY_CONTEXT(sequence_checker_);
+
+  SEQUENCE_CHECKER(sequence_checker_);
   base::WeakPtrFactory<MemoryMappedRuleset> weak_ptr_factory_{this};
 };
 
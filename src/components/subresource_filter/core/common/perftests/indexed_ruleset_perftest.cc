@@ -8,21 +8,29 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/json/json_reader.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_refptr.h"
 #include "base/path_service.h"
+#include "base/strings/string_split.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/time/time.h"
 #include "base/timer/elapsed_timer.h"
+#include "components/subresource_filter/core/common/common_features.h"
+#include "components/subresource_filter/core/common/document_subresource_filter.h"
 #include "components/subresource_filter/core/common/memory_mapped_ruleset.h"
 #include "components/subresource_filter/tools/filter_tool.h"
 #include "components/subresource_filter/tools/indexing_tool.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_result_reporter.h"
+#include "url/gurl.h"
+#include "url/origin.h"
 
 namespace subresource_filter {
 
@@ -31,6 +39,50 @@ namespace {
 static constexpr char kMetricIndexAndWriteTimeUs[] = "index_and_write_time";
 static constexpr char kMetricMedianMatchTimeUs[] = "median_match_time";
 
+// A subresource request of the trace.
+struct Request {
+  url::Origin document_origin;
+  GURL url;
+  url_pattern_index::proto::ElementType type;
+};
+
+url_pattern_index::proto::ElementType ParseType(const std::string& type) {
+  if (type == "script")
+    return url_pattern_index::proto::ELEMENT_TYPE_SCRIPT;
+  if (type == "image")
+    return url_pattern_index::proto::ELEMENT_TYPE_IMAGE;
+  if (type == "stylesheet")
+    return url_pattern_index::proto::ELEMENT_TYPE_STYLESHEET;
+  if (type == "xmlhttprequest")
+    return url_pattern_index::proto::ELEMENT_TYPE_XMLHTTPREQUEST;
+  if (type == "font")
+    return url_pattern_index::proto::ELEMENT_TYPE_FONT;
+  if (type == "media")
+    return url_pattern_index::proto::ELEMENT_TYPE_MEDIA;
+  if (type == "subdocument")
+    return url_pattern_index::proto::ELEMENT_TYPE_SUBDOCUMENT;
+  return url_pattern_index::proto::ELEMENT_TYPE_OTHER;
+}
+
+// Parses the requests of the trace, one JSON dictionary per line.
+std::vector<Request> ParseRequests(const std::string& requests) {
+  std::vector<Request> result;
+  for (const std::string& line : base::SplitString(
+           requests, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    std::optional<base::Value> value = base::JSONReader::Read(line);
+    if (!value || !value->is_dict())
+      continue;
+    const std::string* origin = value->GetDict().FindString("origin");
+    const std::string* url = value->GetDict().FindString("request_url");
+    const std::string* type = value->GetDict().FindString("request_type");
+    if (!origin || !url || !type)
+      continue;
+    result.push_back(
+        {url::Origin::Create(GURL(*origin)), GURL(*url), ParseType(*type)});
+  }
+  return result;
+}
+
 }  // namespace
 
 class IndexedRulesetPerftest : public testing::Test {
@@ -66,9 +118,9 @@ class IndexedRulesetPerftest : public testing::Test {
     base::File indexed_file =
         base::File(indexed_path, base::File::FLAG_OPEN | base::File::FLAG_READ);
     ASSERT_TRUE(indexed_file.IsValid());
-    auto ruleset = subresource_filter::MemoryMappedRuleset::CreateAndInitialize(
+    ruleset_ = subresource_filter::MemoryMappedRuleset::CreateAndInitialize(
         std::move(indexed_file));
-    filter_tool_ = std::make_unique<FilterTool>(std::move(ruleset), &output_);
+    filter_tool_ = std::make_unique<FilterTool>(ruleset_, &output_);
   }
 
   FilterTool* filter_tool() { return filter_tool_.get(); }
@@ -77,6 +129,30 @@ class IndexedRulesetPerftest : public testing::Test {
 
   const base::FilePath& unindexed_path() const { return unindexed_path_; }
 
+  // Gets the load policy of every request of the trace, five times, and
+  // reports the median time under |story_name|.
+  void RunGetLoadPolicyTest(const std::string& story_name) {
+    const std::vector<Request> parsed_requests = ParseRequests(requests());
+    ASSERT_FALSE(parsed_requests.empty());
+
+    mojom::ActivationState state;
+    state.activation_level = mojom::ActivationLevel::kEnabled;
+    std::vector<int64_t> results;
+    for (int i = 0; i < 5; ++i) {
+      base::ElapsedTimer timer;
+      for (const Request& request : parsed_requests) {
+        DocumentSubresourceFilter filter(request.document_origin, state,
+                                         ruleset_);
+        filter.GetLoadPolicy(request.url, request.type);
+      }
+      results.push_back(timer.Elapsed().InMicroseconds());
+    }
+    std::sort(results.begin(), results.end());
+    perf_test::PerfResultReporter reporter = SetUpReporter(story_name);
+    reporter.AddResult(kMetricMedianMatchTimeUs,
+                       static_cast<size_t>(results[2]));
+  }
+
   perf_test::PerfResultReporter SetUpReporter(const std::string& story_name) {
     perf_test::PerfResultReporter reporter("IndexedRuleset.", story_name);
     reporter.RegisterImportantMetric(kMetricIndexAndWriteTimeUs, "us");
@@ -94,6 +170,7 @@ class IndexedRulesetPerftest : public testing::Test {
   // fail so things should be a bit faster than writing to a string.
   std::ofstream output_;
 
+  scoped_refptr<const MemoryMappedRuleset> ruleset_;
   std::unique_ptr<FilterTool> filter_tool_;
 };
 
@@ -123,4 +200,16 @@ TEST_F(IndexedRulesetPerftest, MatchAll) {
   reporter.AddResult(kMetricMedianMatchTimeUs, static_cast<size_t>(results[2]));
 }
 
+// Measures DocumentSubresourceFilter::GetLoadPolicy() over the requests of the
+// trace, with and without the n-gram fast reject in front of the ruleset.
+TEST_F(IndexedRulesetPerftest, GetLoadPolicyAll) {
+  RunGetLoadPolicyTest("GetLoadPolicyAll");
+}
+
+TEST_F(IndexedRulesetPerftest, GetLoadPolicyAllWithoutFastReject) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndDisableFeature(kNGramFastReject);
+  RunGetLoadPolicyTest("GetLoadPolicyAllWithoutFastReject");
+}
+
 }  // namespace subresource_filter
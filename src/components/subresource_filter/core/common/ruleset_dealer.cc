@@ -5,6 +5,7 @@
 #include "components/subresource_filter/core/common/ruleset_dealer.h"
 
 #include "base/check.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/not_fatal_until.h"
 #include "components/subresource_filter/core/common/memory_mapped_ruleset.h"
 
@@ -40,6 +41,9 @@ scoped_refptr<const MemoryMappedRuleset> RulesetDealer::GetRuleset() {
   } else if (scoped_refptr<MemoryMappedRuleset> ruleset =
                  MemoryMappedRuleset::CreateAndInitialize(
                      ruleset_file_.Duplicate())) {
+    // Lookups only touch a few pages of the index, so reading ahead of them
+    // would be wasted.
+    ruleset->Advise(base::MemoryMappedFile::Advice::kRandom);
     weak_cached_ruleset_ = ruleset->AsWeakPtr();
     strong_ruleset_ref = std::move(ruleset);
   }
@@ -0,0 +1,156 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/subresource_filter/core/common/url_rule_ngram_filter.h"
+
+#include <algorithm>
+#include <bit>
+#include <optional>
+#include <utility>
+
+#include "components/url_pattern_index/flat/url_pattern_index_generated.h"
+#include "components/url_pattern_index/ngram_extractor.h"
+#include "url/gurl.h"
+
+namespace subresource_filter {
+
+namespace {
+
+namespace flat = url_pattern_index::flat;
+using url_pattern_index::CreateNGramExtractor;
+using url_pattern_index::NGramCaseExtraction;
+
+// The length of the n-grams that UrlPatternIndex indexes rules under. The
+// filter passes all URLs for an index that uses other n-grams.
+constexpr size_t kNGramSize = 5;
+
+// The length of the n-grams used for the rules that UrlPatternIndex does not
+// index by n-gram, because their patterns have no literal part of kNGramSize.
+constexpr size_t kShortNGramSize = 3;
+
+// Seeds that keep the two lengths of n-grams apart in the filter.
+constexpr uint64_t kNGramSeed = 0x9e3779b97f4a7c15;
+constexpr uint64_t kShortNGramSeed = 0xc2b2ae3d27d4eb4f;
+
+// Number of bits of the filter per n-gram, and number of bits set for each.
+// Each n-gram of a URL that is not in the filter passes it with a chance of
+// about 1/2000, so a few percent of the URLs that match no rule pass it.
+constexpr size_t kBitsPerNGram = 32;
+constexpr int kBitsPerKey = 4;
+
+// Minimum number of words of the filter, so that small rulesets don't get a
+// crowded filter.
+constexpr size_t kMinWords = 64;
+
+uint64_t Hash(uint64_t key, uint64_t seed) {
+  // The finalizer of SplitMix64.
+  uint64_t hash = key + seed;
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+  return hash ^ (hash >> 31);
+}
+
+// Returns the bits of a word of the filter that are set for |hash|.
+uint64_t GetMask(uint64_t hash) {
+  uint64_t mask = 0;
+  for (int i = 0; i < kBitsPerKey; ++i)
+    mask |= uint64_t{1} << ((hash >> (6 * i)) & 63);
+  return mask;
+}
+
+// Returns an n-gram of kShortNGramSize that occurs in every URL that |rule|
+// matches, or nullopt if there is none.
+std::optional<uint64_t> GetShortNGram(const flat::UrlRule& rule) {
+  if (rule.url_pattern_type() == flat::UrlPatternType_REGEXP ||
+      !rule.url_pattern()) {
+    return std::nullopt;
+  }
+  const std::string_view pattern(rule.url_pattern()->c_str(),
+                                 rule.url_pattern()->size());
+  auto extractor =
+      CreateNGramExtractor<kShortNGramSize, uint64_t,
+                           NGramCaseExtraction::kLowerCase>(
+          pattern, [](char c) { return c == '*' || c == '^'; });
+  auto it = extractor.begin();
+  if (it == extractor.end())
+    return std::nullopt;
+  return *it;
+}
+
+}  // namespace
+
+UrlRuleNGramFilter::UrlRuleNGramFilter(const flat::UrlPatternIndex* index) {
+  std::vector<std::pair<uint64_t, uint64_t>> keys;
+  if (index && index->n() != kNGramSize) {
+    pass_all_ = true;
+    return;
+  }
+
+  if (index && index->ngram_index()) {
+    for (const flat::NGramToRules* entry : *index->ngram_index()) {
+      // Empty slots of the hash table have no rules.
+      if (entry->rule_list() && entry->rule_list()->size())
+        keys.emplace_back(entry->ngram(), kNGramSeed);
+    }
+  }
+  if (index && index->fallback_rules()) {
+    for (const flat::UrlRule* rule : *index->fallback_rules()) {
+      std::optional<uint64_t> ngram = GetShortNGram(*rule);
+      if (!ngram) {
+        pass_all_ = true;
+        return;
+      }
+      keys.emplace_back(*ngram, kShortNGramSeed);
+      has_short_ngrams_ = true;
+    }
+  }
+
+  bits_.assign(
+      std::bit_ceil(std::max(kMinWords, keys.size() * kBitsPerNGram / 64)),
+      0);
+  for (const auto& [key, seed] : keys)
+    Add(key, seed);
+}
+
+UrlRuleNGramFilter::~UrlRuleNGramFilter() = default;
+
+bool UrlRuleNGramFilter::MayMatch(const GURL& url) const {
+  if (pass_all_)
+    return true;
+  return MayContainNGramOf(url.possibly_invalid_spec());
+}
+
+void UrlRuleNGramFilter::Add(uint64_t key, uint64_t seed) {
+  const uint64_t hash = Hash(key, seed);
+  bits_[(hash >> 32) & (bits_.size() - 1)] |= GetMask(hash);
+}
+
+bool UrlRuleNGramFilter::MayContain(uint64_t key, uint64_t seed) const {
+  const uint64_t hash = Hash(key, seed);
+  const uint64_t mask = GetMask(hash);
+  return (bits_[(hash >> 32) & (bits_.size() - 1)] & mask) == mask;
+}
+
+bool UrlRuleNGramFilter::MayContainNGramOf(std::string_view url_spec) const {
+  auto no_separator = [](char) { return false; };
+  for (uint64_t ngram :
+       CreateNGramExtractor<kNGramSize, uint64_t,
+                            NGramCaseExtraction::kLowerCase>(url_spec,
+                                                             no_separator)) {
+    if (MayContain(ngram, kNGramSeed))
+      return true;
+  }
+  if (!has_short_ngrams_)
+    return false;
+  for (uint64_t ngram :
+       CreateNGramExtractor<kShortNGramSize, uint64_t,
+                            NGramCaseExtraction::kLowerCase>(url_spec,
+                                                             no_separator)) {
+    if (MayContain(ngram, kShortNGramSeed))
+      return true;
+  }
+  return false;
+}
+
+}  // namespace subresource_filter
@@ -0,0 +1,77 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_SUBRESOURCE_FILTER_CORE_COMMON_URL_RULE_NGRAM_FILTER_H_
+#define COMPONENTS_SUBRESOURCE_FILTER_CORE_COMMON_URL_RULE_NGRAM_FILTER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string_view>
+#include <vector>
+
+class GURL;
+
+namespace url_pattern_index::flat {
+struct UrlPatternIndex;
+}  // namespace url_pattern_index::flat
+
+namespace subresource_filter {
+
+// A Bloom filter over the n-grams of the rules of a flat::UrlPatternIndex,
+// used to reject URLs that match none of the rules without looking them up in
+// the index. Most subresource URLs match no rule, and the filter is a small
+// fraction of the size of the index, so checking it first avoids touching most
+// of the memory-mapped ruleset.
+//
+// Every rule needs one of its n-grams to occur in a URL to match it: the n-gram
+// it is indexed under, or for the rules that the index always checks, an n-gram
+// of the shortest length from the literal parts of its pattern. If such a rule
+// has no literal part of that length, the filter passes all URLs.
+class UrlRuleNGramFilter {
+ public:
+  // Builds the filter for |index|, which must be verified. If |index| is null,
+  // the filter rejects all URLs.
+  explicit UrlRuleNGramFilter(
+      const url_pattern_index::flat::UrlPatternIndex* index);
+
+  UrlRuleNGramFilter(const UrlRuleNGramFilter&) = delete;
+  UrlRuleNGramFilter& operator=(const UrlRuleNGramFilter&) = delete;
+
+  ~UrlRuleNGramFilter();
+
+  // Returns false if no rule of the index can match |url|. May return true
+  // even if none does.
+  bool MayMatch(const GURL& url) const;
+
+  // Returns the size of the filter in bytes.
+  size_t GetMemoryUsage() const { return bits_.size() * sizeof(uint64_t); }
+
+ private:
+  // Adds |key|, of which |seed| tells the kind, to the filter.
+  void Add(uint64_t key, uint64_t seed);
+
+  // Returns false if |key| was not added with |seed|.
+  bool MayContain(uint64_t key, uint64_t seed) const;
+
+  // Returns false if no n-gram of |url_spec| was added.
+  bool MayContainNGramOf(std::string_view url_spec) const;
+
+  // Whether the filter passes all URLs.
+  bool pass_all_ = false;
+
+  // Whether some rules are only found through their short n-grams.
+  bool has_short_ngrams_ = false;
+
+  // The filter, with all the bits of a key in the same word, so that a lookup
+  // touches a single cache line. The size is a power of two.
+  std::vector<uint64_t> bits_;
+
+  // Shift that turns a hash into an index of |bits_|.
+  uint32_t word_shift_ = 0;
+};
+
+}  // namespace subresource_filter
+
+#endif  // COMPONENTS_SUBRESOURCE_FILTER_CORE_COMMON_URL_RULE_NGRAM_FILTER_H_
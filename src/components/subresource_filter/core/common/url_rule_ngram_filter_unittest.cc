@@ -0,0 +1,91 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/subresource_filter/core/common/url_rule_ngram_filter.h"
+
+#include <memory>
+#include <string_view>
+
+#include "components/subresource_filter/core/common/indexed_ruleset.h"
+#include "components/url_pattern_index/proto/rules.pb.h"
+#include "components/url_pattern_index/url_pattern.h"
+#include "components/url_pattern_index/url_rule_test_support.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace subresource_filter {
+
+namespace proto = url_pattern_index::proto;
+namespace testing = url_pattern_index::testing;
+using testing::MakeUrlRule;
+using url_pattern_index::UrlPattern;
+
+class UrlRuleNGramFilterTest : public ::testing::Test {
+ protected:
+  bool AddSimpleRule(std::string_view url_pattern) {
+    return indexer_.AddUrlRule(
+        MakeUrlRule(UrlPattern(url_pattern, testing::kSubstring)));
+  }
+
+  bool AddSimpleAllowlistRule(std::string_view url_pattern) {
+    auto rule = MakeUrlRule(UrlPattern(url_pattern, testing::kSubstring));
+    rule.set_semantics(proto::RULE_SEMANTICS_ALLOWLIST);
+    return indexer_.AddUrlRule(rule);
+  }
+
+  std::unique_ptr<UrlRuleNGramFilter> Finish() {
+    indexer_.Finish();
+    return IndexedRulesetMatcher::CreateBlocklistFilter(indexer_.data());
+  }
+
+ private:
+  RulesetIndexer indexer_;
+};
+
+TEST_F(UrlRuleNGramFilterTest, EmptyRuleset) {
+  std::unique_ptr<UrlRuleNGramFilter> filter = Finish();
+  EXPECT_FALSE(filter->MayMatch(GURL("http://example.com")));
+  EXPECT_FALSE(filter->MayMatch(GURL("http://example.com/ads/banner.js")));
+}
+
+TEST_F(UrlRuleNGramFilterTest, PassesMatchingUrls) {
+  ASSERT_TRUE(AddSimpleRule("/banner/ads/"));
+  ASSERT_TRUE(AddSimpleRule("?param="));
+  ASSERT_TRUE(AddSimpleRule("tracker.example"));
+  std::unique_ptr<UrlRuleNGramFilter> filter = Finish();
+
+  EXPECT_TRUE(filter->MayMatch(GURL("http://example.com/banner/ads/1.png")));
+  EXPECT_TRUE(filter->MayMatch(GURL("http://example.com/?param=1")));
+  EXPECT_TRUE(filter->MayMatch(GURL("https://TRACKER.example.org/t.js")));
+
+  EXPECT_FALSE(filter->MayMatch(GURL("http://example.com/index.html")));
+  EXPECT_FALSE(filter->MayMatch(GURL("https://cdn.example.org/app.js")));
+}
+
+// Rules that are too short to be indexed by n-gram are found through their
+// shorter n-grams.
+TEST_F(UrlRuleNGramFilterTest, ShortRules) {
+  ASSERT_TRUE(AddSimpleRule("/ad/"));
+  std::unique_ptr<UrlRuleNGramFilter> filter = Finish();
+
+  EXPECT_TRUE(filter->MayMatch(GURL("http://example.com/ad/1.png")));
+  EXPECT_FALSE(filter->MayMatch(GURL("http://example.com/index.html")));
+}
+
+TEST_F(UrlRuleNGramFilterTest, RuleWithoutNGramPassesAllUrls) {
+  ASSERT_TRUE(AddSimpleRule("ad"));
+  std::unique_ptr<UrlRuleNGramFilter> filter = Finish();
+
+  EXPECT_TRUE(filter->MayMatch(GURL("http://example.com/index.html")));
+}
+
+TEST_F(UrlRuleNGramFilterTest, IgnoresAllowlistRules) {
+  ASSERT_TRUE(AddSimpleRule("/banner/ads/"));
+  ASSERT_TRUE(AddSimpleAllowlistRule("index.html"));
+  std::unique_ptr<UrlRuleNGramFilter> filter = Finish();
+
+  EXPECT_FALSE(filter->MayMatch(GURL("http://example.com/index.html")));
+}
+
+}  // namespace subresource_filter
@@ -56,6 +56,18 @@ BASE_FEATURE(kSyncPersistInvalidations,
              "SyncPersistInvalidations",
              base::FEATURE_ENABLED_BY_DEFAULT);
 
+BASE_FEATURE(kSyncApplyIncrementalUpdatesImmediately,
+             "SyncApplyIncrementalUpdatesImmediately",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+BASE_FEATURE(kSyncParallelUpdateDecryption,
+             "SyncParallelUpdateDecryption",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
+BASE_FEATURE(kSyncBufferModelTypeStoreWrites,
+             "SyncBufferModelTypeStoreWrites",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 BASE_FEATURE(kSkipInvalidationOptimizationsWhenDeviceInfoUpdated,
              "SkipInvalidationOptimizationsWhenDeviceInfoUpdated",
              base::FEATURE_DISABLED_BY_DEFAULT);
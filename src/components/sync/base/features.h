@@ -63,6 +63,22 @@ BASE_DECLARE_FEATURE(kChromeOSSyncedSessionSharing);
 // upload/download invalidations support from ModelTypeState msg will be added.
 BASE_DECLARE_FEATURE(kSyncPersistInvalidations);
 
+// If enabled, incremental updates (i.e. after the initial sync) of all data
+// types except BOOKMARKS are passed to the processor as soon as each GetUpdates
+// response has been processed, like for ApplyUpdatesImmediatelyTypes(), rather
+// than at the end of the sync cycle. The model sequence then applies one batch
+// while the sync sequence downloads the next one.
+BASE_DECLARE_FEATURE(kSyncApplyIncrementalUpdatesImmediately);
+
+// If enabled, large GetUpdates responses are decrypted in parallel chunks on
+// the thread pool instead of one entity at a time on the sync sequence.
+BASE_DECLARE_FEATURE(kSyncParallelUpdateDecryption);
+
+// If enabled, ModelTypeStoreImpl merges write batches committed in short
+// succession and writes them to LevelDB together, to reduce the number of
+// small writes of high-churn data types.
+BASE_DECLARE_FEATURE(kSyncBufferModelTypeStoreWrites);
+
 // When enabled, optimization flags (single client and a list of FCM
 // registration tokens) will be disabled if during the current sync cycle
 // DeviceInfo has been updated.
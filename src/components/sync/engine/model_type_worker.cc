@@ -6,10 +6,12 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <map>
 #include <set>
 #include <utility>
 
+#include "base/barrier_closure.h"
 #include "base/containers/span.h"
 #include "base/feature_list.h"
 #include "base/format_macros.h"
@@ -22,7 +24,9 @@
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/synchronization/waitable_event.h"
+#include "base/system/sys_info.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/trace_event/memory_usage_estimator.h"
 #include "base/uuid.h"
@@ -299,6 +303,20 @@ bool DecryptIncomingPasswordSharingInvitationSpecifics(
   return true;
 }
 
+// Populates `populated_updates[i]` from `updates[i]`. Runs on the thread pool
+// for all but one chunk of a large GetUpdates response.
+void PopulateUpdateResponseDataChunk(
+    const Cryptographer* cryptographer,
+    ModelType model_type,
+    base::span<const sync_pb::SyncEntity* const> updates,
+    base::span<ModelTypeWorker::PopulatedUpdate> populated_updates) {
+  DCHECK_EQ(updates.size(), populated_updates.size());
+  for (size_t i = 0; i < updates.size(); ++i) {
+    populated_updates[i].first = ModelTypeWorker::PopulateUpdateResponseData(
+        *cryptographer, model_type, *updates[i], &populated_updates[i].second);
+  }
+}
+
 }  // namespace
 
 ModelTypeWorker::ModelTypeWorker(ModelType type,
@@ -499,6 +517,12 @@ void ModelTypeWorker::ProcessGetUpdatesResponse(
 
   const bool is_initial_sync =
       !IsInitialSyncDone(model_type_state_.initial_sync_state());
+  if (is_initial_sync) {
+    if (initial_sync_start_time_.is_null()) {
+      initial_sync_start_time_ = base::TimeTicks::Now();
+    }
+    initial_sync_num_updates_ += applicable_updates.size();
+  }
 
   // TODO(rlarocque): Handle data type context conflicts.
   *model_type_state_.mutable_type_context() = mutated_context;
@@ -537,7 +561,11 @@ void ModelTypeWorker::ProcessGetUpdatesResponse(
   *model_type_state_.mutable_progress_marker() = progress_marker;
   ExtractGcDirective();
 
-  for (const sync_pb::SyncEntity* update_entity : applicable_updates) {
+  std::vector<PopulatedUpdate> populated_updates =
+      PopulateUpdateResponseDataList(*cryptographer_, type_,
+                                     applicable_updates);
+  for (size_t i = 0; i < applicable_updates.size(); ++i) {
+    const sync_pb::SyncEntity* update_entity = applicable_updates[i];
     RecordEntityChangeMetrics(
         type_, is_initial_sync
                    ? ModelTypeEntityChange::kRemoteInitialUpdate
@@ -551,9 +579,8 @@ void ModelTypeWorker::ProcessGetUpdatesResponse(
       }
     }
 
-    UpdateResponseData response_data;
-    switch (PopulateUpdateResponseData(*cryptographer_, type_, *update_entity,
-                                       &response_data)) {
+    auto& [decryption_status, response_data] = populated_updates[i];
+    switch (decryption_status) {
       case SUCCESS:
         pending_updates_.push_back(std::move(response_data));
         // Override any previously undecryptable update for the same id.
@@ -615,11 +642,62 @@ void ModelTypeWorker::ProcessGetUpdatesResponse(
   // Data types that do not do an actual merge also don't have to download all
   // remote data first. Instead, apply updates as they come in. This saves the
   // need to accumulate all data in memory.
-  if (ApplyUpdatesImmediatelyTypes().Has(type_)) {
+  // Once the initial sync is done, the same holds for incremental updates of
+  // most types, so that the model sequence can apply them while the next batch
+  // is downloaded.
+  if (ShouldApplyUpdatesImmediately()) {
     ApplyUpdates(status, /*cycle_done=*/false);
   }
 }
 
+// static
+std::vector<ModelTypeWorker::PopulatedUpdate>
+ModelTypeWorker::PopulateUpdateResponseDataList(
+    const Cryptographer& cryptographer,
+    ModelType model_type,
+    const SyncEntityList& updates) {
+  std::vector<PopulatedUpdate> populated_updates(updates.size());
+  size_t num_chunks = 1;
+  if (base::FeatureList::IsEnabled(kSyncParallelUpdateDecryption)) {
+    num_chunks = std::clamp<size_t>(
+        updates.size() / kMinUpdatesPerDecryptionChunk, 1,
+        base::SysInfo::NumberOfProcessors());
+  }
+  const size_t chunk_size = (updates.size() + num_chunks - 1) / num_chunks;
+  base::span<const sync_pb::SyncEntity* const> remaining_updates(updates);
+  base::span<PopulatedUpdate> remaining_populated_updates(populated_updates);
+
+  // All chunks but the last one are populated on the thread pool, the last
+  // one on the current sequence while waiting.
+  base::WaitableEvent chunks_done;
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      num_chunks - 1, base::BindOnce(&base::WaitableEvent::Signal,
+                                     base::Unretained(&chunks_done)));
+  for (size_t i = 0; i + 1 < num_chunks; ++i) {
+    // BLOCK_SHUTDOWN, since this sequence waits for the task to run.
+    base::ThreadPool::PostTask(
+        FROM_HERE,
+        {base::TaskPriority::USER_BLOCKING,
+         base::TaskShutdownBehavior::BLOCK_SHUTDOWN},
+        base::BindOnce(&PopulateUpdateResponseDataChunk,
+                       base::Unretained(&cryptographer), model_type,
+                       remaining_updates.first(chunk_size),
+                       remaining_populated_updates.first(chunk_size))
+            .Then(barrier));
+    remaining_updates = remaining_updates.subspan(chunk_size);
+    remaining_populated_updates =
+        remaining_populated_updates.subspan(chunk_size);
+  }
+  PopulateUpdateResponseDataChunk(&cryptographer, model_type,
+                                  remaining_updates,
+                                  remaining_populated_updates);
+  if (num_chunks > 1) {
+    base::ScopedAllowBaseSyncPrimitives allow_wait;
+    chunks_done.Wait();
+  }
+  return populated_updates;
+}
+
 // static
 // |response_data| must be not null.
 ModelTypeWorker::DecryptionStatus ModelTypeWorker::PopulateUpdateResponseData(
@@ -733,14 +811,18 @@ void ModelTypeWorker::ApplyUpdates(StatusController* status, bool cycle_done) {
   // Indicate the new initial-sync state to the processor: If the current sync
   // cycle was completed, the initial sync must be done. Otherwise, it's started
   // now. The latter can only happen for ApplyUpdatesImmediatelyTypes(), since
-  // other types wait for the cycle to complete before applying any updates.
+  // other types wait for the cycle to complete before applying any updates
+  // during the initial sync.
   // Note that the initial sync technically isn't started/done yet but by the
   // time this value is persisted to disk on the model thread it will be.
   if (cycle_done) {
     model_type_state_.set_initial_sync_state(
         sync_pb::ModelTypeState_InitialSyncState_INITIAL_SYNC_DONE);
+    if (!initial_sync_start_time_.is_null()) {
+      LogInitialSyncMetrics();
+    }
   } else {
-    DCHECK(ApplyUpdatesImmediatelyTypes().Has(type_));
+    DCHECK(ShouldApplyUpdatesImmediately());
     if (model_type_state_.initial_sync_state() !=
         sync_pb::ModelTypeState_InitialSyncState_INITIAL_SYNC_DONE) {
       model_type_state_.set_initial_sync_state(
@@ -794,6 +876,28 @@ void ModelTypeWorker::ApplyUpdates(StatusController* status, bool cycle_done) {
   SendPendingUpdatesToProcessorIfReady();
 }
 
+bool ModelTypeWorker::ShouldApplyUpdatesImmediately() const {
+  if (ApplyUpdatesImmediatelyTypes().Has(type_)) {
+    return true;
+  }
+  // Bookmarks need all updates of a cycle at once to reconstruct the tree.
+  return type_ != BOOKMARKS &&
+         IsInitialSyncDone(model_type_state_.initial_sync_state()) &&
+         base::FeatureList::IsEnabled(kSyncApplyIncrementalUpdatesImmediately);
+}
+
+void ModelTypeWorker::LogInitialSyncMetrics() {
+  const char* suffix = ModelTypeToHistogramSuffix(type_);
+  base::UmaHistogramLongTimes(
+      base::StrCat({"Sync.InitialSyncDuration.", suffix}),
+      base::TimeTicks::Now() - initial_sync_start_time_);
+  base::UmaHistogramCounts1M(
+      base::StrCat({"Sync.InitialSyncUpdatesDownloaded.", suffix}),
+      initial_sync_num_updates_);
+  initial_sync_start_time_ = base::TimeTicks();
+  initial_sync_num_updates_ = 0;
+}
+
 void ModelTypeWorker::SendPendingUpdatesToProcessorIfReady() {
   DCHECK(model_type_processor_);
 
@@ -10,6 +10,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/memory/raw_ptr.h"
@@ -17,6 +18,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/waitable_event.h"
+#include "base/time/time.h"
 #include "components/sync/base/model_type.h"
 #include "components/sync/base/passphrase_enums.h"
 #include "components/sync/engine/cancelation_signal.h"
@@ -102,6 +104,7 @@ class ModelTypeWorker : public UpdateHandler,
  public:
   // Public for testing.
   enum DecryptionStatus { SUCCESS, DECRYPTION_PENDING, FAILED_TO_DECRYPT };
+  using PopulatedUpdate = std::pair<DecryptionStatus, UpdateResponseData>;
 
   // This enum reflects the processor's state of having local changes.
   enum HasLocalChangesState {
@@ -141,6 +144,17 @@ class ModelTypeWorker : public UpdateHandler,
       const sync_pb::SyncEntity& update_entity,
       UpdateResponseData* response_data);
 
+  // Public for testing.
+  // Calls PopulateUpdateResponseData() for all `updates` and returns the
+  // results in the same order. If kSyncParallelUpdateDecryption is enabled,
+  // large lists are split into chunks of at least
+  // `kMinUpdatesPerDecryptionChunk` updates, which are populated in parallel
+  // on the thread pool. Blocks until all chunks are done.
+  static std::vector<PopulatedUpdate> PopulateUpdateResponseDataList(
+      const Cryptographer& cryptographer,
+      ModelType model_type,
+      const SyncEntityList& updates);
+
   static void LogPendingInvalidationStatus(PendingInvalidationStatus status);
 
   // Initializes the two relevant communication channels: ModelTypeWorker ->
@@ -206,6 +220,7 @@ class ModelTypeWorker : public UpdateHandler,
   bool IsEncryptionEnabledForTest() const { return encryption_enabled_; }
 
   static constexpr size_t kMaxPendingInvalidations = 10u;
+  static constexpr size_t kMinUpdatesPerDecryptionChunk = 256u;
 
  private:
   struct UnknownEncryptionKeyInfo {
@@ -238,6 +253,13 @@ class ModelTypeWorker : public UpdateHandler,
   // pushing the data in such cases instead (the processor relies on this).
   void SendPendingUpdatesToProcessorIfReady();
 
+  // Returns whether updates should be passed to the processor after every
+  // GetUpdates response rather than only at the end of the sync cycle.
+  bool ShouldApplyUpdatesImmediately() const;
+
+  // Records how long the initial sync took and how many updates it downloaded.
+  void LogInitialSyncMetrics();
+
   // Returns true if this type is prepared to commit items. Currently, this
   // depends on having downloaded the initial data and having the encryption
   // settings in a good state.
@@ -380,6 +402,12 @@ class ModelTypeWorker : public UpdateHandler,
   // are several pending GC directives, the latest one will be stored.
   std::optional<sync_pb::GarbageCollectionDirective> pending_gc_directive_;
 
+  // When the first GetUpdates response of the initial sync was received, and
+  // the number of updates received during the initial sync so far. Reset once
+  // the initial sync is done.
+  base::TimeTicks initial_sync_start_time_;
+  size_t initial_sync_num_updates_ = 0;
+
   // Indicates if processor has local changes. Processor only nudges worker once
   // and worker might not be ready to commit entities at the time.
   HasLocalChangesState has_local_changes_state_ = kNoNudgedLocalChanges;
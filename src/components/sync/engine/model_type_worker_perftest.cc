@@ -0,0 +1,95 @@
+// Copyright 2024 The Chromium Authors
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/sync/engine/model_type_worker.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/test/task_environment.h"
+#include "base/timer/elapsed_timer.h"
+#include "components/sync/base/client_tag_hash.h"
+#include "components/sync/base/features.h"
+#include "components/sync/protocol/entity_specifics.pb.h"
+#include "components/sync/protocol/sync_entity.pb.h"
+#include "components/sync/test/fake_cryptographer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace syncer {
+
+namespace {
+
+constexpr char kMetricPrefix[] = "ModelTypeWorker.";
+constexpr char kMetricDecrypt[] = "decrypt";
+
+constexpr char kKeyName[] = "key";
+
+// The size of the initial sync of a large account.
+constexpr size_t kUpdateCount = 50000;
+
+}  // namespace
+
+class ModelTypeWorkerPerfTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    cryptographer_ = FakeCryptographer::FromSingleDefaultKey(kKeyName);
+    for (size_t i = 0; i < kUpdateCount; ++i) {
+      const std::string tag = "tag" + base::NumberToString(i);
+      sync_pb::EntitySpecifics specifics;
+      specifics.mutable_preference()->set_name(tag);
+      specifics.mutable_preference()->set_value(std::string(100, 'x'));
+      std::string plaintext;
+      specifics.SerializeToString(&plaintext);
+
+      sync_pb::SyncEntity& entity = entities_.emplace_back();
+      entity.set_id_string("id" + base::NumberToString(i));
+      entity.set_client_tag_hash(
+          ClientTagHash::FromUnhashed(PREFERENCES, tag).value());
+      entity.set_version(1);
+      entity.mutable_specifics()->mutable_preference();
+      cryptographer_->EncryptString(
+          plaintext, entity.mutable_specifics()->mutable_encrypted());
+    }
+    for (const sync_pb::SyncEntity& entity : entities_) {
+      updates_.push_back(&entity);
+    }
+  }
+
+  // Decrypts `updates_` and reports how long it took under `story`.
+  void RunStory(const std::string& story) {
+    perf_test::PerfResultReporter reporter(kMetricPrefix, story);
+    reporter.RegisterImportantMetric(kMetricDecrypt, "ms");
+
+    base::ElapsedTimer timer;
+    std::vector<ModelTypeWorker::PopulatedUpdate> populated_updates =
+        ModelTypeWorker::PopulateUpdateResponseDataList(
+            *cryptographer_, PREFERENCES, updates_);
+    reporter.AddResult(kMetricDecrypt, timer.Elapsed().InMillisecondsF());
+
+    ASSERT_EQ(kUpdateCount, populated_updates.size());
+    for (const ModelTypeWorker::PopulatedUpdate& update : populated_updates) {
+      EXPECT_EQ(ModelTypeWorker::SUCCESS, update.first);
+    }
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  std::unique_ptr<FakeCryptographer> cryptographer_;
+  std::vector<sync_pb::SyncEntity> entities_;
+  SyncEntityList updates_;
+};
+
+TEST_F(ModelTypeWorkerPerfTest, InitialSync) {
+  RunStory("InitialSync");
+}
+
+TEST_F(ModelTypeWorkerPerfTest, InitialSyncParallelDecryption) {
+  base::test::ScopedFeatureList feature_list(kSyncParallelUpdateDecryption);
+  RunStory("InitialSyncParallelDecryption");
+}
+
+}  // namespace syncer
@@ -545,7 +545,7 @@ class ModelTypeWorkerTest : public ::testing::Test {
   }
 
  private:
-  base::test::SingleThreadTaskEnvironment task_environment_;
+  base::test::TaskEnvironment task_environment_;
 
   const ModelType model_type_;
 
@@ -1123,6 +1123,57 @@ TEST_F(ModelTypeWorkerTest, ReceiveMultiPartUpdates) {
             updates[0]->entity.client_tag_hash);
 }
 
+TEST_F(ModelTypeWorkerTest, ReceiveMultiPartUpdatesImmediately) {
+  base::test::ScopedFeatureList feature;
+  feature.InitAndEnableFeature(kSyncApplyIncrementalUpdatesImmediately);
+
+  NormalInitialize();
+
+  // Each partial update response is passed to the processor right away.
+  TriggerPartialUpdateFromServer(10, kTag1, kValue1);
+  ASSERT_EQ(1U, processor()->GetNumUpdateResponses());
+  ASSERT_EQ(1U, processor()->GetNthUpdateResponse(0).size());
+  EXPECT_EQ(GeneratePreferenceTagHash(kTag1),
+            processor()->GetNthUpdateResponse(0)[0]->entity.client_tag_hash);
+
+  TriggerPartialUpdateFromServer(10, kTag2, kValue2);
+  ASSERT_EQ(2U, processor()->GetNumUpdateResponses());
+  ASSERT_EQ(1U, processor()->GetNthUpdateResponse(1).size());
+  EXPECT_EQ(GeneratePreferenceTagHash(kTag2),
+            processor()->GetNthUpdateResponse(1)[0]->entity.client_tag_hash);
+
+  // The end of the cycle doesn't pass the same entities again.
+  worker()->ApplyUpdates(status_controller(), /*cycle_done=*/true);
+  ASSERT_EQ(3U, processor()->GetNumUpdateResponses());
+  EXPECT_EQ(0U, processor()->GetNthUpdateResponse(2).size());
+}
+
+TEST_F(ModelTypeWorkerTest, ReceiveInitialSyncUpdatesAtEndOfCycle) {
+  base::test::ScopedFeatureList feature;
+  feature.InitAndEnableFeature(kSyncApplyIncrementalUpdatesImmediately);
+  base::HistogramTester histogram_tester;
+
+  FirstInitialize();
+
+  // During the initial sync, updates are still applied all at once.
+  TriggerPartialUpdateFromServer(10, kTag1, kValue1);
+  TriggerPartialUpdateFromServer(10, kTag2, kValue2);
+  EXPECT_EQ(0U, processor()->GetNumUpdateResponses());
+  histogram_tester.ExpectTotalCount("Sync.InitialSyncDuration.Preferences", 0);
+
+  worker()->ApplyUpdates(status_controller(), /*cycle_done=*/true);
+  ASSERT_EQ(1U, processor()->GetNumUpdateResponses());
+  EXPECT_EQ(2U, processor()->GetNthUpdateResponse(0).size());
+  histogram_tester.ExpectTotalCount("Sync.InitialSyncDuration.Preferences", 1);
+  histogram_tester.ExpectUniqueSample(
+      "Sync.InitialSyncUpdatesDownloaded.Preferences", 2, 1);
+
+  // Incremental updates don't record initial sync metrics.
+  TriggerUpdateFromServer(20, kTag3, kValue3);
+  EXPECT_EQ(3U, processor()->GetNumUpdateResponses());
+  histogram_tester.ExpectTotalCount("Sync.InitialSyncDuration.Preferences", 1);
+}
+
 // Test that updates with no entities behave correctly.
 TEST_F(ModelTypeWorkerTest, EmptyUpdates) {
   NormalInitialize();
@@ -1285,6 +1336,47 @@ TEST_F(ModelTypeWorkerTest, ReceiveDecryptableEntities) {
   EXPECT_FALSE(update2.encryption_key_name.empty());
 }
 
+TEST_F(ModelTypeWorkerTest, ReceiveManyDecryptableEntitiesInParallel) {
+  base::test::ScopedFeatureList feature;
+  feature.InitAndEnableFeature(kSyncParallelUpdateDecryption);
+
+  NormalInitialize();
+  AddPendingKey();
+  DecryptPendingKey();
+
+  // Enough updates to be split into several chunks.
+  const size_t kNumUpdates =
+      4 * ModelTypeWorker::kMinUpdatesPerDecryptionChunk + 1;
+  std::vector<SyncEntity> entities;
+  for (size_t i = 0; i < kNumUpdates; ++i) {
+    const std::string tag = "tag" + base::NumberToString(i);
+    entities.push_back(server()->UpdateFromServer(
+        10, GeneratePreferenceTagHash(tag), GenerateSpecifics(tag, kValue1)));
+    EncryptUpdateWithNthKey(1, entities.back().mutable_specifics());
+  }
+  SyncEntityList updates;
+  for (const SyncEntity& entity : entities) {
+    updates.push_back(&entity);
+  }
+  worker()->ProcessGetUpdatesResponse(server()->GetProgress(),
+                                      server()->GetContext(), updates,
+                                      status_controller());
+  worker()->ApplyUpdates(status_controller(), /*cycle_done=*/true);
+
+  // All updates were decrypted and kept their order.
+  ASSERT_EQ(1U, processor()->GetNumUpdateResponses());
+  std::vector<const UpdateResponseData*> received =
+      processor()->GetNthUpdateResponse(0);
+  ASSERT_EQ(kNumUpdates, received.size());
+  for (size_t i = 0; i < kNumUpdates; ++i) {
+    const std::string tag = "tag" + base::NumberToString(i);
+    EXPECT_EQ(GeneratePreferenceTagHash(tag),
+              received[i]->entity.client_tag_hash);
+    EXPECT_EQ(tag, received[i]->entity.specifics.preference().name());
+    EXPECT_FALSE(received[i]->encryption_key_name.empty());
+  }
+}
+
 // Test the receipt of decryptable entities, and that the worker will keep the
 // entities until the decryption key arrives.
 TEST_F(ModelTypeWorkerTest,
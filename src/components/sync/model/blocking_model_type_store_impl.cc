@@ -108,6 +108,16 @@ class LevelDbWriteBatch : public BlockingModelTypeStoreImpl::WriteBatch {
 
   ModelType GetModelType() const { return type_; }
 
+  void Append(std::unique_ptr<LevelDbWriteBatch> other) {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    DCHECK_EQ(other->GetModelType(), type_);
+    leveldb_write_batch_->Append(*other->leveldb_write_batch_);
+  }
+
+  size_t ApproximateSize() const {
+    return leveldb_write_batch_->ApproximateSize();
+  }
+
   // WriteBatch implementation.
   void WriteData(const std::string& id, const std::string& value) override {
     DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
@@ -296,6 +306,22 @@ BlockingModelTypeStoreImpl::CreateWriteBatch(ModelType model_type,
   return std::make_unique<LevelDbWriteBatch>(model_type, storage_type);
 }
 
+// static
+void BlockingModelTypeStoreImpl::AppendWriteBatch(
+    WriteBatch* dest,
+    std::unique_ptr<WriteBatch> src) {
+  DCHECK(dest);
+  DCHECK(src);
+  static_cast<LevelDbWriteBatch*>(dest)->Append(
+      base::WrapUnique(static_cast<LevelDbWriteBatch*>(src.release())));
+}
+
+// static
+size_t BlockingModelTypeStoreImpl::GetApproximateWriteBatchSize(
+    const WriteBatch& write_batch) {
+  return static_cast<const LevelDbWriteBatch&>(write_batch).ApproximateSize();
+}
+
 // static
 std::string BlockingModelTypeStoreImpl::FormatPrefixForModelTypeAndStorageType(
     ModelType model_type,
@@ -5,6 +5,8 @@
 #ifndef COMPONENTS_SYNC_MODEL_BLOCKING_MODEL_TYPE_STORE_IMPL_H_
 #define COMPONENTS_SYNC_MODEL_BLOCKING_MODEL_TYPE_STORE_IMPL_H_
 
+#include <stddef.h>
+
 #include <memory>
 #include <string>
 
@@ -63,6 +65,15 @@ class BlockingModelTypeStoreImpl : public BlockingModelTypeStore {
   static std::unique_ptr<WriteBatch> CreateWriteBatch(ModelType model_type,
                                                       StorageType storage_type);
 
+  // Appends the changes of |src| to |dest|. Both must have been created by
+  // CreateWriteBatch() for the same type.
+  static void AppendWriteBatch(WriteBatch* dest,
+                               std::unique_ptr<WriteBatch> src);
+
+  // Returns the approximate size in bytes of the changes in |write_batch|,
+  // which must have been created by CreateWriteBatch().
+  static size_t GetApproximateWriteBatchSize(const WriteBatch& write_batch);
+
   // Returns the common prefix for all records (data, metadata, and global
   // metadata aka model type state) with a given ModelType and StorageType. Can
   // be useful for data migrations; should not be required otherwise.
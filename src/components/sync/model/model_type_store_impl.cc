@@ -9,11 +9,15 @@
 #include <utility>
 
 #include "base/check_op.h"
+#include "base/feature_list.h"
 #include "base/functional/bind.h"
 #include "base/functional/callback_helpers.h"
 #include "base/location.h"
+#include "base/metrics/histogram_functions.h"
+#include "base/strings/strcat.h"
 #include "base/task/sequenced_task_runner.h"
 #include "base/trace_event/trace_event.h"
+#include "components/sync/base/features.h"
 #include "components/sync/model/blocking_model_type_store_impl.h"
 #include "components/sync/model/metadata_batch.h"
 #include "components/sync/model/model_error.h"
@@ -22,6 +26,11 @@ namespace syncer {
 
 namespace {
 
+// Buffered writes are written to the backend at the latest after this delay,
+// or as soon as they reach this size.
+constexpr base::TimeDelta kMaxBufferedWriteDelay = base::Seconds(1);
+constexpr size_t kMaxBufferedWriteSize = 256 * 1024;
+
 std::optional<ModelError> ReadAllDataAndPreprocessOnBackendSequence(
     BlockingModelTypeStoreImpl* blocking_store,
     ModelTypeStore::PreprocessCallback
@@ -57,6 +66,9 @@ ModelTypeStoreImpl::ModelTypeStoreImpl(
 
 ModelTypeStoreImpl::~ModelTypeStoreImpl() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // The write is posted before |backend_store_| gets deleted on the backend
+  // sequence. The callbacks won't run anymore.
+  FlushBufferedWrites();
 }
 
 // Note on pattern for communicating with backend:
@@ -74,6 +86,7 @@ void ModelTypeStoreImpl::ReadData(const IdList& id_list,
                                   ReadDataCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   DCHECK(!callback.is_null());
+  FlushBufferedWrites();
   std::unique_ptr<RecordList> record_list(new RecordList());
   std::unique_ptr<IdList> missing_id_list(new IdList());
 
@@ -100,6 +113,7 @@ void ModelTypeStoreImpl::ReadDataDone(ReadDataCallback callback,
 void ModelTypeStoreImpl::ReadAllData(ReadAllDataCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   DCHECK(!callback.is_null());
+  FlushBufferedWrites();
   std::unique_ptr<RecordList> record_list(new RecordList());
   auto task = base::BindOnce(&BlockingModelTypeStore::ReadAllData,
                              base::Unretained(backend_store_.get()),
@@ -123,6 +137,7 @@ void ModelTypeStoreImpl::ReadAllMetadata(ReadMetadataCallback callback) {
   TRACE_EVENT0("sync", "ModelTypeStoreImpl::ReadAllMetadata");
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   DCHECK(!callback.is_null());
+  FlushBufferedWrites();
 
   auto metadata_batch = std::make_unique<MetadataBatch>();
   auto task = base::BindOnce(&BlockingModelTypeStore::ReadAllMetadata,
@@ -156,6 +171,7 @@ void ModelTypeStoreImpl::ReadAllDataAndPreprocess(
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   DCHECK(!preprocess_on_backend_sequence_callback.is_null());
   DCHECK(!completion_on_frontend_sequence_callback.is_null());
+  FlushBufferedWrites();
   auto task =
       base::BindOnce(&ReadAllDataAndPreprocessOnBackendSequence,
                      base::Unretained(backend_store_.get()),
@@ -180,6 +196,7 @@ void ModelTypeStoreImpl::ReadAllDataAndPreprocessDone(
 void ModelTypeStoreImpl::DeleteAllDataAndMetadata(CallbackWithResult callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   DCHECK(!callback.is_null());
+  FlushBufferedWrites();
   auto task = base::BindOnce(&BlockingModelTypeStore::DeleteAllDataAndMetadata,
                              base::Unretained(backend_store_.get()));
   auto reply =
@@ -201,6 +218,24 @@ void ModelTypeStoreImpl::CommitWriteBatch(
     CallbackWithResult callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   DCHECK(!callback.is_null());
+  if (base::FeatureList::IsEnabled(kSyncBufferModelTypeStoreWrites)) {
+    if (buffered_write_batch_) {
+      BlockingModelTypeStoreImpl::AppendWriteBatch(buffered_write_batch_.get(),
+                                                   std::move(write_batch));
+    } else {
+      buffered_write_batch_ = std::move(write_batch);
+    }
+    buffered_write_callbacks_.push_back(std::move(callback));
+    if (BlockingModelTypeStoreImpl::GetApproximateWriteBatchSize(
+            *buffered_write_batch_) >= kMaxBufferedWriteSize) {
+      FlushBufferedWrites();
+    } else if (!buffered_write_timer_.IsRunning()) {
+      buffered_write_timer_.Start(FROM_HERE, kMaxBufferedWriteDelay, this,
+                                  &ModelTypeStoreImpl::FlushBufferedWrites);
+    }
+    return;
+  }
+
   auto task = base::BindOnce(&BlockingModelTypeStore::CommitWriteBatch,
                              base::Unretained(backend_store_.get()),
                              std::move(write_batch));
@@ -209,6 +244,7 @@ void ModelTypeStoreImpl::CommitWriteBatch(
                      weak_ptr_factory_.GetWeakPtr(), std::move(callback));
   backend_task_runner_->PostTaskAndReplyWithResult(FROM_HERE, std::move(task),
                                                    std::move(reply));
+  RecordBackendWrite();
 }
 
 void ModelTypeStoreImpl::WriteModificationsDone(
@@ -218,4 +254,47 @@ void ModelTypeStoreImpl::WriteModificationsDone(
   std::move(callback).Run(error);
 }
 
+void ModelTypeStoreImpl::BufferedWritesDone(
+    std::vector<CallbackWithResult> callbacks,
+    const std::optional<ModelError>& error) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  // The callbacks may destroy |this|, so only local state is used here.
+  for (CallbackWithResult& callback : callbacks) {
+    std::move(callback).Run(error);
+  }
+}
+
+void ModelTypeStoreImpl::FlushBufferedWrites() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  buffered_write_timer_.Stop();
+  if (!buffered_write_batch_) {
+    return;
+  }
+  auto task = base::BindOnce(&BlockingModelTypeStore::CommitWriteBatch,
+                             base::Unretained(backend_store_.get()),
+                             std::move(buffered_write_batch_));
+  auto reply = base::BindOnce(&ModelTypeStoreImpl::BufferedWritesDone,
+                              weak_ptr_factory_.GetWeakPtr(),
+                              std::move(buffered_write_callbacks_));
+  buffered_write_callbacks_.clear();
+  backend_task_runner_->PostTaskAndReplyWithResult(FROM_HERE, std::move(task),
+                                                   std::move(reply));
+  RecordBackendWrite();
+}
+
+void ModelTypeStoreImpl::RecordBackendWrite() {
+  const base::TimeTicks now = base::TimeTicks::Now();
+  if (write_window_start_.is_null()) {
+    write_window_start_ = now;
+  } else if (now - write_window_start_ >= base::Minutes(1)) {
+    base::UmaHistogramCounts1000(
+        base::StrCat({"Sync.ModelTypeStoreWritesPerMinute.",
+                      ModelTypeToHistogramSuffix(model_type_)}),
+        writes_in_window_);
+    write_window_start_ = now;
+    writes_in_window_ = 0;
+  }
+  ++writes_in_window_;
+}
+
 }  // namespace syncer
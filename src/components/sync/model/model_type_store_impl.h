@@ -6,11 +6,14 @@
 #define COMPONENTS_SYNC_MODEL_MODEL_TYPE_STORE_IMPL_H_
 
 #include <memory>
+#include <vector>
 
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "base/sequence_checker.h"
 #include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/sync/base/model_type.h"
 #include "components/sync/base/storage_type.h"
 #include "components/sync/model/model_type_store.h"
@@ -22,6 +25,11 @@ class BlockingModelTypeStoreImpl;
 // ModelTypeStoreImpl handles details of store initialization and threading.
 // Actual leveldb IO calls are performed in BlockingModelTypeStoreImpl (in the
 // underlying ModelTypeStoreBackend).
+//
+// If kSyncBufferModelTypeStoreWrites is enabled, committed write batches are
+// merged and written together once they get large or after a short delay. The
+// commit callbacks run once the merged batch has been written. Buffered writes
+// are issued before any read, and when the store is destroyed.
 class ModelTypeStoreImpl : public ModelTypeStore {
  public:
   // |backend_store| must not be null and must have been created in
@@ -66,6 +74,14 @@ class ModelTypeStoreImpl : public ModelTypeStore {
                                     const std::optional<ModelError>& error);
   void WriteModificationsDone(CallbackWithResult callback,
                               const std::optional<ModelError>& error);
+  void BufferedWritesDone(std::vector<CallbackWithResult> callbacks,
+                          const std::optional<ModelError>& error);
+
+  // Posts |buffered_write_batch_|, if any, to the backend.
+  void FlushBufferedWrites();
+
+  // Counts a write to the backend for the writes per minute metric.
+  void RecordBackendWrite();
 
   const ModelType model_type_;
   const StorageType storage_type_;
@@ -74,6 +90,17 @@ class ModelTypeStoreImpl : public ModelTypeStore {
   std::unique_ptr<BlockingModelTypeStoreImpl, base::OnTaskRunnerDeleter>
       backend_store_;
 
+  // Write batches committed since the last write to the backend, merged, and
+  // their callbacks. Only used if kSyncBufferModelTypeStoreWrites is enabled.
+  std::unique_ptr<WriteBatch> buffered_write_batch_;
+  std::vector<CallbackWithResult> buffered_write_callbacks_;
+  base::OneShotTimer buffered_write_timer_;
+
+  // Start of the current one minute window of the writes per minute metric,
+  // and the number of writes to the backend in it.
+  base::TimeTicks write_window_start_;
+  int writes_in_window_ = 0;
+
   SEQUENCE_CHECKER(sequence_checker_);
 
   base::WeakPtrFactory<ModelTypeStoreImpl> weak_ptr_factory_{this};
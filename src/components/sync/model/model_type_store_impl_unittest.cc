@@ -13,7 +13,10 @@
 #include "base/functional/callback_helpers.h"
 #include "base/run_loop.h"
 #include "base/test/bind.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "components/sync/base/features.h"
 #include "components/sync/base/model_type.h"
 #include "components/sync/base/storage_type.h"
 #include "components/sync/model/model_error.h"
@@ -514,4 +517,44 @@ TEST(ModelTypeStoreImplWithTwoStoreTest,
   }
 }
 
+TEST(ModelTypeStoreImplBufferedWritesTest, MergesWritesUntilDelayOrRead) {
+  base::test::ScopedFeatureList feature_list(kSyncBufferModelTypeStoreWrites);
+  base::test::SingleThreadTaskEnvironment task_environment(
+      base::test::TaskEnvironment::TimeSource::MOCK_TIME);
+
+  std::unique_ptr<ModelTypeStore> store =
+      ModelTypeStoreTestUtil::CreateInMemoryStoreForTest(
+          PREFERENCES, StorageType::kUnspecified);
+
+  int writes_done = 0;
+  for (const char* id : {"id1", "id2"}) {
+    std::unique_ptr<ModelTypeStore::WriteBatch> write_batch =
+        store->CreateWriteBatch();
+    write_batch->WriteData(id, "data");
+    store->CommitWriteBatch(
+        std::move(write_batch),
+        base::BindLambdaForTesting(
+            [&](const std::optional<ModelError>& error) {
+              EXPECT_FALSE(error);
+              ++writes_done;
+            }));
+  }
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0, writes_done);
+
+  task_environment.FastForwardBy(base::Seconds(1));
+  EXPECT_EQ(2, writes_done);
+
+  // Reads see the writes that are still buffered.
+  std::unique_ptr<ModelTypeStore::WriteBatch> write_batch =
+      store->CreateWriteBatch();
+  write_batch->WriteData("id3", "data");
+  store->CommitWriteBatch(std::move(write_batch), base::DoNothing());
+
+  std::unique_ptr<ModelTypeStore::RecordList> data_records;
+  std::unique_ptr<MetadataBatch> metadata_batch;
+  ReadStoreContents(store.get(), &data_records, &metadata_batch);
+  EXPECT_THAT(*data_records, SizeIs(3));
+}
+
 }  // namespace syncer
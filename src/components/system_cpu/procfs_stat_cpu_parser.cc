@@ -6,20 +6,26 @@
 
 #include <stdint.h>
 
+#include <array>
 #include <limits>
 #include <string_view>
 #include <utility>
 #include <vector>
 
 #include "base/files/file_path.h"
-#include "base/files/file_util.h"
 #include "base/sequence_checker.h"
 #include "base/strings/string_number_conversions.h"
-#include "base/strings/string_split.h"
 #include "base/system/sys_info.h"
 
 namespace system_cpu {
 
+namespace {
+
+// /proc/stat is read in chunks of this size until the end of the file.
+constexpr int kReadChunkSize = 4096;
+
+}  // namespace
+
 constexpr base::FilePath::CharType ProcfsStatCpuParser::kProcfsStatPath[];
 
 ProcfsStatCpuParser::ProcfsStatCpuParser(base::FilePath stat_path)
@@ -42,42 +48,56 @@ bool ProcfsStatCpuParser::Update() {
   // token has a small upper-bound on its size, because tokens are 64-bit
   // base-10 numbers.
   //
-  // This has the following consequences.
-  // 1) Reading the whole file in memory has a constant size/memory overhead,
-  //    relative to the class' usage of per-core CoreTime structs.
-  // 2) Splitting the entire file into lines and processing each line has a
-  //    constant size/memory overhead compared to a streaming parser that
-  //    ignores irrelevant data and stops after the last per-core line (cpuN).
-  std::string stat_bytes;
-
-  // This implementation could use base::ReadFileToStringWithMaxSize() to avoid
-  // the risk that a kernel bug leads to an OOM. The size limit depends on the
-  // maximum number of cores we'd want to support.
-  //
+  // So reading the whole file in memory has a constant size/memory overhead,
+  // relative to the class' usage of per-core CoreTime structs. The lines are
+  // parsed in place, without copying them.
+  if (!stat_file_.IsValid()) {
+    stat_file_ =
+        base::File(stat_path_, base::File::FLAG_OPEN | base::File::FLAG_READ);
+    if (!stat_file_.IsValid()) {
+      return false;
+    }
+  }
+
   // Each CPU line has ~220 bytes, and the other lines should amount to less
-  // than 10,000 bytes. So, for example, a limit of 2.3Mb should be sufficient
-  // to support systems up to 10,000 cores.
-  if (!base::ReadFileToString(stat_path_, &stat_bytes)) {
-    return false;
+  // than 10,000 bytes. So the buffer settles at a size proportional to the
+  // number of cores after the first update.
+  size_t stat_size = 0;
+  while (true) {
+    if (stat_buffer_.size() < stat_size + kReadChunkSize) {
+      stat_buffer_.resize(stat_size + kReadChunkSize);
+    }
+    int bytes_read = stat_file_.Read(
+        stat_size, stat_buffer_.data() + stat_size, kReadChunkSize);
+    if (bytes_read < 0) {
+      return false;
+    }
+    if (bytes_read == 0) {
+      break;
+    }
+    stat_size += bytes_read;
   }
 
-  static constexpr std::string_view kNewlineSeparator("\n", 1);
-  std::vector<std::string_view> stat_lines = base::SplitStringPiece(
-      stat_bytes, kNewlineSeparator, base::WhitespaceHandling::KEEP_WHITESPACE,
-      base::SplitResult::SPLIT_WANT_ALL);
-  for (std::string_view stat_line : stat_lines) {
+  std::string_view stat_bytes(stat_buffer_.data(), stat_size);
+  while (true) {
+    size_t newline_index = stat_bytes.find('\n');
+    std::string_view stat_line = stat_bytes.substr(0, newline_index);
+
     int core_id = CoreIdFromLine(stat_line);
-    if (core_id < 0) {
-      continue;
+    if (core_id >= 0) {
+      CHECK_LE(core_times_.size(), size_t{std::numeric_limits<int>::max()});
+      if (static_cast<int>(core_times_.size()) <= core_id) {
+        core_times_.resize(core_id + 1);
+      }
+
+      CoreTimes& current_core_times = core_times_[core_id];
+      UpdateCore(stat_line, current_core_times);
     }
 
-    CHECK_LE(core_times_.size(), size_t{std::numeric_limits<int>::max()});
-    if (static_cast<int>(core_times_.size()) <= core_id) {
-      core_times_.resize(core_id + 1);
+    if (newline_index == std::string_view::npos) {
+      break;
     }
-
-    CoreTimes& current_core_times = core_times_[core_id];
-    UpdateCore(stat_line, current_core_times);
+    stat_bytes.remove_prefix(newline_index + 1);
   }
 
   return true;
@@ -110,27 +130,35 @@ void ProcfsStatCpuParser::UpdateCore(std::string_view core_line,
                                      CoreTimes& core_times) {
   CHECK_GE(CoreIdFromLine(core_line), 0);
 
-  static constexpr std::string_view kSpaceSeparator(" ", 1);
-  std::vector<std::string_view> tokens = base::SplitStringPiece(
-      core_line, kSpaceSeparator, base::WhitespaceHandling::KEEP_WHITESPACE,
-      base::SplitResult::SPLIT_WANT_ALL);
-
   // Accept lines with more than 10 numbers, so the code keeps working if
   // /proc/stat is extended with new per-core metrics.
   //
   // The first token on the line is the "cpuN" core ID. One core ID plus 10
-  // numbers equals 11 tokens.
-  if (tokens.size() < 11) {
-    return;
-  }
-
-  std::vector<uint64_t> parsed_numbers(10, 0);
-  for (int i = 0; i < 10; ++i) {
-    uint64_t parsed_number;
-    if (!base::StringToUint64(tokens[i + 1], &parsed_number)) {
+  // numbers equals 11 tokens. Numbers after the first invalid one are left at
+  // 0, which CoreTimes ignores as a counter decrease.
+  static constexpr size_t kTokenCount = 11;
+  std::array<uint64_t, kTokenCount - 1> parsed_numbers = {};
+  bool parse_failed = false;
+  size_t token_count = 0;
+  while (true) {
+    size_t space_index = core_line.find(' ');
+    if (token_count > 0 && !parse_failed) {
+      uint64_t parsed_number;
+      if (base::StringToUint64(core_line.substr(0, space_index),
+                               &parsed_number)) {
+        parsed_numbers[token_count - 1] = parsed_number;
+      } else {
+        parse_failed = true;
+      }
+    }
+    ++token_count;
+    if (token_count == kTokenCount || space_index == std::string_view::npos) {
       break;
     }
-    parsed_numbers[i] = parsed_number;
+    core_line.remove_prefix(space_index + 1);
+  }
+  if (token_count < kTokenCount) {
+    return;
   }
 
   core_times.set_user(parsed_numbers[0]);
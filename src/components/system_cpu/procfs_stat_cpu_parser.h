@@ -7,9 +7,11 @@
 
 #include <stdint.h>
 
+#include <string>
 #include <string_view>
 #include <vector>
 
+#include "base/files/file.h"
 #include "base/files/file_path.h"
 #include "base/sequence_checker.h"
 #include "base/thread_annotations.h"
@@ -60,6 +62,14 @@ class ProcfsStatCpuParser {
 
   const base::FilePath stat_path_;
 
+  // Opened on the first Update() and kept open, so each update is a single
+  // pread() sequence. procfs regenerates the contents on every read.
+  base::File stat_file_ GUARDED_BY_CONTEXT(sequence_checker_);
+
+  // Reused across updates to avoid reallocating. Only the prefix filled by the
+  // last read is valid.
+  std::string stat_buffer_ GUARDED_BY_CONTEXT(sequence_checker_);
+
   std::vector<CoreTimes> core_times_ GUARDED_BY_CONTEXT(sequence_checker_);
 };
 
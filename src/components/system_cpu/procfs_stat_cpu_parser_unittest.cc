@@ -12,6 +12,7 @@
 #include "base/files/file.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
+#include "base/strings/stringprintf.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -428,4 +429,33 @@ softirq 900 901 902 903 904 905 906 907 908 909 910
   }
 }
 
+
+// The file is larger than a single read chunk, and shrinks between updates.
+TEST_F(ProcfsStatCpuParserTest, ManyCoresThenFewer) {
+  constexpr int kCoreCount = 200;
+  std::string stat = "cpu 1 2 3 4 5 6 7 8 9 10\n";
+  for (int i = 0; i < kCoreCount; ++i) {
+    stat += base::StringPrintf("cpu%d %d 11 12 13 14 15 16 17 18 19\n", i,
+                               i + 1000);
+  }
+  stat += "intr 200 201 202\n";
+  ASSERT_GT(stat.size(), 4096u);
+  ASSERT_TRUE(WriteFakeStat(stat));
+  EXPECT_TRUE(parser_->Update());
+
+  ASSERT_EQ(parser_->core_times().size(), static_cast<size_t>(kCoreCount));
+  for (int i = 0; i < kCoreCount; ++i) {
+    EXPECT_EQ(parser_->core_times()[i].user(), static_cast<uint64_t>(i + 1000));
+    EXPECT_EQ(parser_->core_times()[i].guest_nice(), 19u);
+  }
+
+  ASSERT_TRUE(WriteFakeStat("cpu0 2000 21 22 23 24 25 26 27 28 29"));
+  EXPECT_TRUE(parser_->Update());
+
+  ASSERT_EQ(parser_->core_times().size(), static_cast<size_t>(kCoreCount));
+  EXPECT_EQ(parser_->core_times()[0].user(), 2000u);
+  EXPECT_EQ(parser_->core_times()[0].guest_nice(), 29u);
+  EXPECT_EQ(parser_->core_times()[1].user(), 1001u);
+}
+
 }  // namespace system_cpu
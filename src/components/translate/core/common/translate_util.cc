@@ -38,6 +38,10 @@ BASE_FEATURE(kMmapLanguageDetectionModel,
              base::FEATURE_ENABLED_BY_DEFAULT);
 #endif
 
+BASE_FEATURE(kTFLiteLanguageDetectionSampling,
+             "TFLiteLanguageDetectionSampling",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 GURL GetTranslateSecurityOrigin() {
   std::string security_origin(kSecurityOrigin);
   base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
@@ -61,6 +65,18 @@ float GetTFLiteLanguageDetectionThreshold() {
       kTFLiteLanguageDetectionEnabled, "reliability_threshold", .7);
 }
 
+int GetTFLiteLanguageDetectionMaxSamples() {
+  static constexpr base::FeatureParam<int> max_samples{
+      &kTFLiteLanguageDetectionSampling, "max_samples", 5};
+  return max_samples.Get();
+}
+
+float GetTFLiteLanguageDetectionConvergedThreshold() {
+  static constexpr base::FeatureParam<double> converged_threshold{
+      &kTFLiteLanguageDetectionSampling, "converged_threshold", .9};
+  return converged_threshold.Get();
+}
+
 BASE_FEATURE(kTranslateAutoSnackbars,
              "TranslateAutoSnackbars",
              base::FEATURE_ENABLED_BY_DEFAULT);
@@ -23,6 +23,11 @@ BASE_DECLARE_FEATURE(kTFLiteLanguageDetectionIgnoreEnabled);
 BASE_DECLARE_FEATURE(kMmapLanguageDetectionModel);
 #endif
 
+// Controls whether the TFLite-based language detection samples bounded chunks
+// of the page content, stopping once the prediction converges, instead of
+// evaluating the model on the full contents.
+BASE_DECLARE_FEATURE(kTFLiteLanguageDetectionSampling);
+
 // Isolated world sets following security-origin by default.
 extern const char kSecurityOrigin[];
 
@@ -44,6 +49,14 @@ bool IsTFLiteLanguageDetectionIgnoreEnabled();
 // prediction is reliable.
 float GetTFLiteLanguageDetectionThreshold();
 
+// Return the maximum number of text samples evaluated by the TFLite language
+// detection model when kTFLiteLanguageDetectionSampling is enabled.
+int GetTFLiteLanguageDetectionMaxSamples();
+
+// Return the reliability score at which a sampled TFLite language detection
+// prediction is considered converged and no more samples are evaluated.
+float GetTFLiteLanguageDetectionConvergedThreshold();
+
 // Feature flag used to control the auto-always and auto-never snackbar
 // parameters (i.e. threshold and maximum-number-of).
 BASE_DECLARE_FEATURE(kTranslateAutoSnackbars);
@@ -4,10 +4,15 @@
 
 #include "components/translate/core/language_detection/language_detection_model.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "base/feature_list.h"
+#include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/metrics/histogram_macros_local.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/timer/elapsed_timer.h"
 #include "components/language/core/common/language_util.h"
 #include "components/optimization_guide/core/optimization_guide_features.h"
 #include "components/translate/core/common/translate_constants.h"
@@ -33,6 +38,31 @@ constexpr int kTextSampleLength = 256;
 // determining the language of the page content.
 constexpr int kNumTextSamples = 3;
 
+// The number of characters in the leading sample when sampling the page
+// content, which is kept as long as the window the model evaluates when given
+// the full contents.
+constexpr size_t kLeadingSampleLength = kNumTextSamples * kTextSampleLength;
+
+// Returns the offsets of up to |max_samples| samples of |kTextSampleLength|
+// characters in a text of |length| characters, in the order they should be
+// evaluated: the start and the end of the text first, then the midpoints of
+// the gaps between the samples taken so far, so that any prefix of the
+// offsets covers the text evenly.
+std::vector<size_t> GetSampleOffsets(size_t length, size_t max_samples) {
+  DCHECK_GT(length, kLeadingSampleLength);
+  const size_t last_offset = length - kTextSampleLength;
+  std::vector<size_t> offsets = {0, last_offset};
+  for (size_t parts = 2; offsets.size() < max_samples &&
+                         last_offset / parts >= kTextSampleLength;
+       parts *= 2) {
+    for (size_t i = 1; i < parts && offsets.size() < max_samples; i += 2) {
+      offsets.push_back(last_offset / parts * i);
+    }
+  }
+  offsets.resize(std::min(offsets.size(), max_samples));
+  return offsets;
+}
+
 }  // namespace
 
 namespace {
@@ -197,6 +227,15 @@ LanguageDetectionModel::Prediction LanguageDetectionModel::DetectLanguage(
     return Prediction{translate::kUnknownLanguageCode, 0.0f};
   }
 
+  base::ElapsedTimer timer;
+  if (base::FeatureList::IsEnabled(kTFLiteLanguageDetectionSampling)) {
+    Prediction prediction = DetectLanguageFromSamples(contents);
+    base::UmaHistogramMicrosecondsTimes(
+        "LanguageDetection.TFLite.DetectionDuration.Sampled",
+        timer.Elapsed());
+    return prediction;
+  }
+
   std::vector<std::pair<std::string, float>> model_predictions;
   // First evaluate the model on the entire contents based on the model's
   // implementation, for v1 it is the first 128 tokens that are unicode
@@ -220,9 +259,55 @@ LanguageDetectionModel::Prediction LanguageDetectionModel::DetectLanguage(
   const auto top_language_result = std::max_element(
       model_predictions.begin(), model_predictions.end(),
       [](auto& left, auto& right) { return left.second < right.second; });
+  base::UmaHistogramMicrosecondsTimes(
+      "LanguageDetection.TFLite.DetectionDuration.FullText", timer.Elapsed());
   return Prediction{top_language_result->first, top_language_result->second};
 }
 
+LanguageDetectionModel::Prediction
+LanguageDetectionModel::DetectLanguageFromSamples(
+    const std::u16string& contents) const {
+  if (contents.length() <= kLeadingSampleLength) {
+    const auto [language, reliability] = DetectTopLanguage(contents);
+    base::UmaHistogramCounts100("LanguageDetection.TFLite.SamplesEvaluated", 1);
+    return Prediction{language, reliability};
+  }
+
+  const float reliable_threshold = GetTFLiteLanguageDetectionThreshold();
+  const float converged_threshold =
+      GetTFLiteLanguageDetectionConvergedThreshold();
+  const std::vector<size_t> offsets = GetSampleOffsets(
+      contents.length(),
+      std::max(1, GetTFLiteLanguageDetectionMaxSamples()));
+
+  Prediction top_prediction{translate::kUnknownLanguageCode, 0.0f};
+  std::string previous_language;
+  size_t num_samples = 0;
+  for (size_t offset : offsets) {
+    // Like in DetectLanguage(), substr is performed on the UTF16 string so
+    // that samples are aligned to characters.
+    const auto [language, reliability] = DetectTopLanguage(contents.substr(
+        offset, offset == 0 ? kLeadingSampleLength : kTextSampleLength));
+    ++num_samples;
+    if (reliability > top_prediction.reliability) {
+      top_prediction = Prediction{language, reliability};
+    }
+    // Stop once a single sample is confident enough, or two consecutive
+    // samples reliably agree on the language.
+    if (reliability >= converged_threshold) {
+      break;
+    }
+    if (reliability > reliable_threshold && language == previous_language) {
+      break;
+    }
+    previous_language =
+        reliability > reliable_threshold ? language : std::string();
+  }
+  base::UmaHistogramCounts100("LanguageDetection.TFLite.SamplesEvaluated",
+                              num_samples);
+  return top_prediction;
+}
+
 std::string LanguageDetectionModel::GetModelVersion() const {
   // TODO(crbug.com/40748826): Return the model version provided
   // by the model itself.
@@ -6,6 +6,7 @@
 #define COMPONENTS_TRANSLATE_CORE_LANGUAGE_DETECTION_LANGUAGE_DETECTION_MODEL_H_
 
 #include <string>
+#include <utility>
 
 #include "base/files/file.h"
 
@@ -77,6 +78,11 @@ class LanguageDetectionModel {
   std::pair<std::string, float> DetectTopLanguage(
       const std::u16string& sampled_str) const;
 
+  // Evaluates the model on up to GetTFLiteLanguageDetectionMaxSamples() bounded
+  // chunks spread evenly over |contents|, stopping early once the prediction
+  // converges. Used when kTFLiteLanguageDetectionSampling is enabled.
+  Prediction DetectLanguageFromSamples(const std::u16string& contents) const;
+
   // The tflite classifier that can determine the language of text.
   std::unique_ptr<tflite::task::text::nlclassifier::NLClassifier>
       lang_detection_model_;
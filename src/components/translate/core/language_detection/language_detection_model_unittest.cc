@@ -9,7 +9,9 @@
 #include "base/path_service.h"
 #include "base/strings/utf_string_conversions.h"
 #include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_feature_list.h"
 #include "components/translate/core/common/translate_constants.h"
+#include "components/translate/core/common/translate_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace translate {
@@ -219,6 +221,63 @@ TEST(LanguageDetectionModelTest, LongTextLanguageDetemination) {
       "LanguageDetection.TFLite.DidAttemptDetection", true, 1);
 }
 
+// Sampling bounded chunks of the contents must detect the same language as
+// evaluating the model on the full contents.
+TEST(LanguageDetectionModelTest, SampledDetectionMatchesFullText) {
+  LanguageDetectionModel language_detection_model;
+  language_detection_model.UpdateWithFile(GetValidModelFile());
+  ASSERT_TRUE(language_detection_model.IsAvailable());
+
+  std::u16string en_contents;
+  std::u16string de_contents;
+  for (int i = 0; i < 50; ++i) {
+    en_contents += u"This is a page apparently written in English. ";
+    de_contents += u"Dies ist eine Seite, die auf Deutsch geschrieben ist. ";
+  }
+  const std::u16string contents_list[] = {
+      u"This is a short page written in English.",
+      en_contents,
+      de_contents,
+      de_contents + u"This is a page apparently written in English.",
+  };
+
+  for (const std::u16string& contents : contents_list) {
+    const LanguageDetectionModel::Prediction full_text =
+        language_detection_model.DetectLanguage(contents);
+
+    base::test::ScopedFeatureList feature_list(
+        kTFLiteLanguageDetectionSampling);
+    base::HistogramTester histogram_tester;
+    const LanguageDetectionModel::Prediction sampled =
+        language_detection_model.DetectLanguage(contents);
+    EXPECT_EQ(full_text.language, sampled.language)
+        << base::UTF16ToUTF8(contents);
+    histogram_tester.ExpectTotalCount(
+        "LanguageDetection.TFLite.DetectionDuration.Sampled", 1);
+    histogram_tester.ExpectTotalCount(
+        "LanguageDetection.TFLite.SamplesEvaluated", 1);
+  }
+}
+
+TEST(LanguageDetectionModelTest, SampledDetectionStopsOnceConverged) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeatureWithParameters(
+      kTFLiteLanguageDetectionSampling,
+      {{"max_samples", "5"}, {"converged_threshold", "0"}});
+  LanguageDetectionModel language_detection_model;
+  language_detection_model.UpdateWithFile(GetValidModelFile());
+  ASSERT_TRUE(language_detection_model.IsAvailable());
+
+  std::u16string contents;
+  for (int i = 0; i < 100; ++i) {
+    contents += u"This is a page apparently written in English. ";
+  }
+  base::HistogramTester histogram_tester;
+  EXPECT_EQ("en", language_detection_model.DetectLanguage(contents).language);
+  histogram_tester.ExpectUniqueSample(
+      "LanguageDetection.TFLite.SamplesEvaluated", 1, 1);
+}
+
 // Regression test for https://crbug.com/1414235. This test is expecting that
 // the code under test does not crash on ASan.
 TEST(LanguageDetectionModelTest, UnalignedString) {
@@ -4,8 +4,10 @@
 
 #include "components/ukm/ukm_recorder_impl.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -50,6 +52,10 @@ BASE_FEATURE(kUkmSamplingRateFeature,
              "UkmSamplingRate",
              base::FEATURE_DISABLED_BY_DEFAULT);
 
+BASE_FEATURE(kUkmEntryAggregationFeature,
+             "UkmEntryAggregation",
+             base::FEATURE_DISABLED_BY_DEFAULT);
+
 namespace {
 
 bool IsAllowlistedSourceId(SourceId source_id) {
@@ -108,6 +114,12 @@ void StoreEntryProto(const mojom::UkmEntry& in, Entry* out) {
   }
 }
 
+// Returns an estimate of the memory used by |entry|.
+size_t EstimateEntryBytes(const mojom::UkmEntry& entry) {
+  return sizeof(mojom::UkmEntry) +
+         entry.metrics.size() * sizeof(std::pair<uint64_t, int64_t>);
+}
+
 void StoreWebFeaturesProto(SourceId source_id,
                            const BitSet& in,
                            HighLevelWebFeatures* out) {
@@ -193,6 +205,18 @@ UkmRecorderImpl::UkmRecorderImpl()
   max_kept_sources_ =
       static_cast<size_t>(base::GetFieldTrialParamByFeatureAsInt(
           kUkmFeature, "MaxKeptSources", max_kept_sources_));
+
+  if (base::FeatureList::IsEnabled(kUkmEntryAggregationFeature)) {
+    for (std::string_view event_name : base::SplitStringPiece(
+             base::GetFieldTrialParamValueByFeature(
+                 kUkmEntryAggregationFeature, "aggregated_events"),
+             ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+      aggregated_event_hashes_.insert(base::HashMetricName(event_name));
+    }
+    max_entry_bytes_ = static_cast<size_t>(
+        std::max(0, base::GetFieldTrialParamByFeatureAsInt(
+                        kUkmEntryAggregationFeature, "max_entry_bytes", 0)));
+  }
 }
 
 UkmRecorderImpl::~UkmRecorderImpl() = default;
@@ -245,6 +269,13 @@ bool UkmRecorderImpl::ShouldDropEntryForTesting(mojom::UkmEntry* entry) {
   return ShouldDropEntry(entry);
 }
 
+void UkmRecorderImpl::SetEntryAggregationForTesting(
+    const base::flat_set<uint64_t>& aggregated_event_hashes,
+    size_t max_entry_bytes) {
+  aggregated_event_hashes_ = aggregated_event_hashes;
+  max_entry_bytes_ = max_entry_bytes;
+}
+
 bool UkmRecorderImpl::IsSamplingConfigured() const {
   return sampling_forced_for_testing_ ||
          base::FeatureList::IsEnabled(kUkmSamplingRateFeature);
@@ -321,9 +352,18 @@ void UkmRecorderImpl::PurgeDataBySourceIds(
 
   std::vector<mojom::UkmEntryPtr>& events = recordings_.entries;
   std::erase_if(events, [&](const auto& event) {
-    return source_ids.count(event->source_id);
+    if (!source_ids.count(event->source_id)) {
+      return false;
+    }
+    recordings_.entry_bytes -= EstimateEntryBytes(*event);
+    return true;
   });
 
+  std::erase_if(recordings_.source_event_aggregations,
+                [&](const auto& aggregation) {
+                  return source_ids.count(aggregation.first.first);
+                });
+
   std::map<SourceId, BitSet>& web_features = recordings_.web_features;
   std::erase_if(web_features, [&](const auto& features) {
     return source_ids.count(features.first);
@@ -398,6 +438,22 @@ void UkmRecorderImpl::StoreRecordingsInReport(Report* report) {
     source_ids_seen.insert(entry->source_id);
   }
 
+  // Aggregated entries keep their source in the report like the other entries.
+  size_t aggregation_bytes = 0;
+  for (const auto& [key, event_aggregate] :
+       recordings_.source_event_aggregations) {
+    const auto& [source_id, event_hash] = key;
+    Aggregate* proto_aggregate = report->add_aggregates();
+    proto_aggregate->set_event_hash(event_hash);
+    event_aggregate.FillProto(proto_aggregate);
+    proto_aggregate->set_source_id(source_id);
+    source_ids_seen.insert(source_id);
+    aggregation_bytes +=
+        sizeof(EventAggregate) +
+        event_aggregate.metrics.size() *
+            sizeof(std::pair<uint64_t, MetricAggregate>);
+  }
+
   for (const auto& [source_id, features_set] : recordings_.web_features) {
     HighLevelWebFeatures* features = report->add_web_features();
     StoreWebFeaturesProto(source_id, features_set, features);
@@ -472,6 +528,15 @@ void UkmRecorderImpl::StoreRecordingsInReport(Report* report) {
                             num_serialized_sources);
   UMA_HISTOGRAM_COUNTS_100000("UKM.Entries.SerializedCount2",
                               num_serialized_entries);
+  UMA_HISTOGRAM_COUNTS_100000("UKM.Entries.AggregatedCount",
+                              recordings_.aggregated_entries);
+  UMA_HISTOGRAM_MEMORY_KB(
+      "UKM.Entries.AggregationBytesSaved",
+      (recordings_.aggregated_entry_bytes -
+       std::min(aggregation_bytes, recordings_.aggregated_entry_bytes)) /
+          1024);
+  UMA_HISTOGRAM_COUNTS_100000("UKM.Entries.DroppedByMemoryCapCount",
+                              recordings_.entries_dropped_by_memory_cap);
   UMA_HISTOGRAM_COUNTS_1000("UKM.WebFeatureSets.SerializedCount",
                             recordings_.web_features.size());
   UMA_HISTOGRAM_COUNTS_1000("UKM.Sources.UnsentSourcesCount",
@@ -528,6 +593,12 @@ void UkmRecorderImpl::StoreRecordingsInReport(Report* report) {
   recordings_.entries.clear();
   recordings_.web_features.clear();
   recordings_.event_aggregations.clear();
+  recordings_.source_event_aggregations.clear();
+  recordings_.entry_bytes = 0;
+  recordings_.entries_seen_over_memory_cap = 0;
+  recordings_.entries_dropped_by_memory_cap = 0;
+  recordings_.aggregated_entries = 0;
+  recordings_.aggregated_entry_bytes = 0;
 
   report->set_is_continuous(recording_is_continuous_);
   recording_is_continuous_ = true;
@@ -807,6 +878,17 @@ UkmConsentType UkmRecorderImpl::GetConsentType(SourceIdType type) {
 UkmRecorderImpl::EventAggregate::EventAggregate() = default;
 UkmRecorderImpl::EventAggregate::~EventAggregate() = default;
 
+void UkmRecorderImpl::EventAggregate::Add(const mojom::UkmEntry& entry) {
+  total_count++;
+  for (const auto& metric : entry.metrics) {
+    MetricAggregate& aggregate = metrics[metric.first];
+    double value = metric.second;
+    aggregate.total_count++;
+    aggregate.value_sum += value;
+    aggregate.value_square_sum += value * value;
+  }
+}
+
 void UkmRecorderImpl::EventAggregate::FillProto(
     Aggregate* proto_aggregate) const {
   proto_aggregate->set_source_id(0);  // Across all sources.
@@ -997,14 +1079,7 @@ void UkmRecorderImpl::AddEntry(mojom::UkmEntryPtr entry) {
 
   EventAggregate& event_aggregate =
       recordings_.event_aggregations[entry->event_hash];
-  event_aggregate.total_count++;
-  for (const auto& metric : entry->metrics) {
-    MetricAggregate& aggregate = event_aggregate.metrics[metric.first];
-    double value = metric.second;
-    aggregate.total_count++;
-    aggregate.value_sum += value;
-    aggregate.value_square_sum += value * value;
-  }
+  event_aggregate.Add(*entry);
 
   if (!IsSamplingConfigured()) {
     RecordDroppedEntry(entry->event_hash,
@@ -1029,11 +1104,20 @@ void UkmRecorderImpl::AddEntry(mojom::UkmEntryPtr entry) {
     return;
   }
 
+  if (aggregated_event_hashes_.contains(entry->event_hash)) {
+    recordings_
+        .source_event_aggregations[{entry->source_id, entry->event_hash}]
+        .Add(*entry);
+    recordings_.aggregated_entries++;
+    recordings_.aggregated_entry_bytes += EstimateEntryBytes(*entry);
+    DVLOG(DebuggingLogLevel::Frequent)
+        << "AddEntry aggregated: [source_id=" << entry->source_id
+        << " event_hash=" << entry->event_hash << "]";
+    return;
+  }
+
   if (recordings_.entries.size() >= max_entries_) {
-    RecordDroppedEntry(entry->event_hash, DroppedDataReason::MAX_HIT);
-    event_aggregate.dropped_due_to_limits++;
-    for (auto& metric : entry->metrics)
-      event_aggregate.metrics[metric.first].dropped_due_to_limits++;
+    RecordEntryDroppedDueToLimits(*entry);
     return;
   }
 
@@ -1052,7 +1136,44 @@ void UkmRecorderImpl::AddEntry(mojom::UkmEntryPtr entry) {
       << " event_name=" << decode_map_.find(entry->event_hash)->second.name
       << "]";
 
-  recordings_.entries.push_back(std::move(entry));
+  StoreEntryWithinMemoryCap(std::move(entry));
+}
+
+void UkmRecorderImpl::RecordEntryDroppedDueToLimits(
+    const mojom::UkmEntry& entry) {
+  RecordDroppedEntry(entry.event_hash, DroppedDataReason::MAX_HIT);
+  EventAggregate& event_aggregate =
+      recordings_.event_aggregations[entry.event_hash];
+  event_aggregate.dropped_due_to_limits++;
+  for (auto& metric : entry.metrics)
+    event_aggregate.metrics[metric.first].dropped_due_to_limits++;
+}
+
+void UkmRecorderImpl::StoreEntryWithinMemoryCap(mojom::UkmEntryPtr entry) {
+  const size_t entry_bytes = EstimateEntryBytes(*entry);
+  if (!max_entry_bytes_ || recordings_.entries.empty() ||
+      recordings_.entry_bytes + entry_bytes <= max_entry_bytes_) {
+    recordings_.entry_bytes += entry_bytes;
+    recordings_.entries.push_back(std::move(entry));
+    return;
+  }
+
+  // Reservoir sampling: the n-th entry offered is kept with probability k/n,
+  // where k is the number of entries kept, in place of a random kept entry.
+  recordings_.entries_seen_over_memory_cap++;
+  recordings_.entries_dropped_by_memory_cap++;
+  const size_t index = static_cast<size_t>(base::RandGenerator(
+      recordings_.entries.size() + recordings_.entries_seen_over_memory_cap));
+  if (index >= recordings_.entries.size()) {
+    RecordEntryDroppedDueToLimits(*entry);
+    return;
+  }
+  mojom::UkmEntryPtr& replaced_entry = recordings_.entries[index];
+  RecordEntryDroppedDueToLimits(*replaced_entry);
+  recordings_.entry_bytes =
+      recordings_.entry_bytes - EstimateEntryBytes(*replaced_entry) +
+      entry_bytes;
+  replaced_entry = std::move(entry);
 }
 
 void UkmRecorderImpl::RecordWebFeatures(
@@ -12,6 +12,7 @@
 #include <string>
 #include <string_view>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "base/component_export.h"
@@ -46,6 +47,12 @@ class UkmUtilsForTest;
 
 COMPONENT_EXPORT(UKM_RECORDER) BASE_DECLARE_FEATURE(kUkmSamplingRateFeature);
 
+// Aggregates the entries of the events listed in the "aggregated_events" param
+// per source instead of keeping each of them, and caps the memory used by the
+// other entries to the "max_entry_bytes" param.
+COMPONENT_EXPORT(UKM_RECORDER)
+BASE_DECLARE_FEATURE(kUkmEntryAggregationFeature);
+
 // Convention for console debugging messages.
 // Example usage:
 // $ ./out/Default/chrome --force-enable-metrics-reporting
@@ -160,6 +167,11 @@ class COMPONENT_EXPORT(UKM_RECORDER) UkmRecorderImpl : public UkmRecorder {
 
   bool ShouldDropEntryForTesting(mojom::UkmEntry* entry);
 
+  // Overrides the configuration of kUkmEntryAggregationFeature.
+  void SetEntryAggregationForTesting(
+      const base::flat_set<uint64_t>& aggregated_event_hashes,
+      size_t max_entry_bytes);
+
  protected:
   // Calculates sampled in/out for a specific source/event based on internal
   // configuration. This function is guaranteed to always return the same
@@ -248,6 +260,8 @@ class COMPONENT_EXPORT(UKM_RECORDER) UkmRecorderImpl : public UkmRecorder {
                            ObserverNotifiedWhenNotRecording);
   FRIEND_TEST_ALL_PREFIXES(UkmRecorderImplTest, WebFeaturesConsent);
   FRIEND_TEST_ALL_PREFIXES(UkmRecorderImplTest, WebFeaturesSampling);
+  FRIEND_TEST_ALL_PREFIXES(UkmRecorderImplTest, AggregatesEntriesPerSource);
+  FRIEND_TEST_ALL_PREFIXES(UkmRecorderImplTest, SamplesEntriesOverMemoryCap);
 
   struct MetricAggregate {
     uint64_t total_count = 0;
@@ -263,6 +277,9 @@ class COMPONENT_EXPORT(UKM_RECORDER) UkmRecorderImpl : public UkmRecorder {
     EventAggregate();
     ~EventAggregate();
 
+    // Adds the metrics of |entry| to the aggregate.
+    void Add(const mojom::UkmEntry& entry);
+
     // Fills the proto message from the struct.
     void FillProto(Aggregate* proto_aggregate) const;
 
@@ -296,6 +313,15 @@ class COMPONENT_EXPORT(UKM_RECORDER) UkmRecorderImpl : public UkmRecorder {
   // Applies UkmEntryFilter if there is one registered.
   bool ApplyEntryFilter(mojom::UkmEntry* entry);
 
+  // Records that |entry| was dropped because of the entry limits.
+  void RecordEntryDroppedDueToLimits(const mojom::UkmEntry& entry);
+
+  // Keeps |entry| in the recordings if it fits in |max_entry_bytes_|. Once the
+  // cap is reached, entries are reservoir sampled so that every entry of the
+  // reporting cycle has the same chance of being kept, rather than only the
+  // earliest ones.
+  void StoreEntryWithinMemoryCap(mojom::UkmEntryPtr entry);
+
   // Loads sampling configurations from field-trial information.
   void LoadExperimentSamplingInfo();
 
@@ -346,6 +372,15 @@ class COMPONENT_EXPORT(UKM_RECORDER) UkmRecorderImpl : public UkmRecorder {
   // and the master are recorded here.
   base::flat_map<uint64_t, uint64_t> event_sampling_master_;
 
+  // Hashes of the events whose entries are aggregated per source instead of
+  // being kept, loaded from kUkmEntryAggregationFeature.
+  base::flat_set<uint64_t> aggregated_event_hashes_;
+
+  // The maximum number of bytes used by the entries in memory, or 0 for no
+  // limit other than |max_entries_|. The limit may be exceeded by the
+  // difference in size between two entries.
+  size_t max_entry_bytes_ = 0;
+
   // Contains data from various recordings which periodically get serialized
   // and cleared by StoreRecordingsInReport() and may be Purged().
   struct Recordings {
@@ -374,6 +409,26 @@ class COMPONENT_EXPORT(UKM_RECORDER) UkmRecorderImpl : public UkmRecorder {
     // Aggregate information for collected event metrics.
     std::map<uint64_t, EventAggregate> event_aggregations;
 
+    // Aggregates of the events in |aggregated_event_hashes_|, by source id and
+    // event hash. These replace the entries of these events.
+    std::map<std::pair<SourceId, uint64_t>, EventAggregate>
+        source_event_aggregations;
+
+    // Estimated number of bytes used by |entries|.
+    size_t entry_bytes = 0;
+
+    // Number of entries offered after |entry_bytes| reached the memory cap,
+    // which sets the probability of keeping the following ones.
+    size_t entries_seen_over_memory_cap = 0;
+
+    // Number of entries dropped because of the memory cap.
+    size_t entries_dropped_by_memory_cap = 0;
+
+    // Number of entries folded into |source_event_aggregations|, and their
+    // estimated size had they been kept.
+    size_t aggregated_entries = 0;
+    size_t aggregated_entry_bytes = 0;
+
     // Aggregated counters about Sources recorded in the current log.
     struct SourceCounts {
       // Count of URLs recorded for all sources.
@@ -4,7 +4,9 @@
 
 #include "components/ukm/ukm_recorder_impl.h"
 
+#include <algorithm>
 #include <string_view>
+#include <utility>
 
 #include "base/functional/bind.h"
 #include "base/metrics/metrics_hashes.h"
@@ -48,6 +50,13 @@ std::map<uint64_t, builders::EntryDecoder> CreateTestingDecodeMap() {
   };
 }
 
+// Builds a UkmEntry of the test event with the test metric set to |value|.
+mojom::UkmEntryPtr TestUkmEntry(SourceId source_id, int64_t value) {
+  return mojom::UkmEntry::New(
+      source_id, kTestEntryHash,
+      base::flat_map<uint64_t, int64_t>({{kTestMetricsHash, value}}));
+}
+
 // Helper class for testing UkmRecorderImpl observers.
 class TestUkmObserver : public UkmRecorderObserver {
  public:
@@ -566,4 +575,79 @@ TEST(UkmRecorderImplTest, WebFeaturesSampling) {
   EXPECT_FALSE(base::Contains(impl.web_features(), kSampledOutSourceId));
 }
 
+TEST(UkmRecorderImplTest, AggregatesEntriesPerSource) {
+  UkmRecorderImpl impl;
+  impl.decode_map_ = CreateTestingDecodeMap();
+  impl.EnableRecording();
+  impl.UpdateRecording({MSBB});
+  impl.SetSamplingForTesting(/*rate=*/1);
+  impl.SetEntryAggregationForTesting({kTestEntryHash}, /*max_entry_bytes=*/0);
+
+  const SourceId kSourceId1 = ConvertToSourceId(1, SourceIdType::NAVIGATION_ID);
+  const SourceId kSourceId2 = ConvertToSourceId(2, SourceIdType::NAVIGATION_ID);
+  impl.AddEntry(TestUkmEntry(kSourceId1, 1));
+  impl.AddEntry(TestUkmEntry(kSourceId1, 2));
+  impl.AddEntry(TestUkmEntry(kSourceId1, 3));
+  impl.AddEntry(TestUkmEntry(kSourceId2, 10));
+  EXPECT_TRUE(impl.entries().empty());
+
+  Report report;
+  impl.StoreRecordingsInReport(&report);
+  EXPECT_EQ(0, report.entries_size());
+
+  // The aggregates of each source come before the aggregate across sources.
+  ASSERT_EQ(3, report.aggregates_size());
+  const Aggregate& source1_aggregate = report.aggregates(0);
+  EXPECT_EQ(kSourceId1, source1_aggregate.source_id());
+  EXPECT_EQ(kTestEntryHash, source1_aggregate.event_hash());
+  EXPECT_EQ(3u, source1_aggregate.total_count());
+  ASSERT_EQ(1, source1_aggregate.metrics_size());
+  EXPECT_EQ(kTestMetricsHash, source1_aggregate.metrics(0).metric_hash());
+  EXPECT_EQ(6, source1_aggregate.metrics(0).value_sum());
+  EXPECT_EQ(14, source1_aggregate.metrics(0).value_square_sum());
+
+  EXPECT_EQ(kSourceId2, report.aggregates(1).source_id());
+  EXPECT_EQ(1u, report.aggregates(1).total_count());
+
+  EXPECT_EQ(0, report.aggregates(2).source_id());
+  EXPECT_EQ(4u, report.aggregates(2).total_count());
+}
+
+TEST(UkmRecorderImplTest, SamplesEntriesOverMemoryCap) {
+  UkmRecorderImpl impl;
+  impl.decode_map_ = CreateTestingDecodeMap();
+  impl.EnableRecording();
+  impl.UpdateRecording({MSBB});
+  impl.SetSamplingForTesting(/*rate=*/1);
+
+  // Room for 10 entries with one metric.
+  constexpr size_t kKeptEntries = 10;
+  constexpr int kAddedEntries = 1000;
+  impl.SetEntryAggregationForTesting(
+      {}, kKeptEntries * (sizeof(mojom::UkmEntry) +
+                          sizeof(std::pair<uint64_t, int64_t>)));
+
+  const SourceId kSourceId = ConvertToSourceId(1, SourceIdType::NAVIGATION_ID);
+  for (int i = 0; i < kAddedEntries; ++i) {
+    impl.AddEntry(TestUkmEntry(kSourceId, i));
+  }
+
+  // The kept entries are sampled across all the added ones instead of being
+  // the first ones. All of them being among the first is very unlikely.
+  ASSERT_EQ(kKeptEntries, impl.entries().size());
+  EXPECT_TRUE(std::ranges::any_of(impl.entries(), [&](const auto& entry) {
+    return entry->metrics.at(kTestMetricsHash) >=
+           static_cast<int64_t>(kKeptEntries);
+  }));
+
+  Report report;
+  impl.StoreRecordingsInReport(&report);
+  EXPECT_EQ(static_cast<int>(kKeptEntries), report.entries_size());
+  ASSERT_EQ(1, report.aggregates_size());
+  EXPECT_EQ(static_cast<uint64_t>(kAddedEntries),
+            report.aggregates(0).total_count());
+  EXPECT_EQ(kAddedEntries - kKeptEntries,
+            report.aggregates(0).dropped_due_to_limits());
+}
+
 }  // namespace ukm
@@ -29,6 +29,11 @@ void UnsentLogStoreMetricsImpl::RecordDroppedLogSize(size_t size) {
   UMA_HISTOGRAM_COUNTS_1M("UKM.UnsentLogs.DroppedSize", static_cast<int>(size));
 }
 
+void UnsentLogStoreMetricsImpl::RecordStoredLogSize(size_t compressed_size) {
+  UMA_HISTOGRAM_COUNTS_1M("UKM.UnsentLogs.StoredLogSize",
+                          static_cast<int>(compressed_size));
+}
+
 void UnsentLogStoreMetricsImpl::RecordDroppedLogsNum(int dropped_logs_num) {
   UMA_HISTOGRAM_COUNTS_10000("UKM.UnsentLogs.NumDropped", dropped_logs_num);
 }
@@ -26,6 +26,7 @@ class UnsentLogStoreMetricsImpl : public metrics::UnsentLogStoreMetrics {
   void RecordCompressionRatio(size_t compressed_size,
                               size_t original_size) override;
   void RecordDroppedLogSize(size_t size) override;
+  void RecordStoredLogSize(size_t compressed_size) override;
   void RecordDroppedLogsNum(int dropped_logs_num) override;
 };
 